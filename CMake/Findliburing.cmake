@@ -0,0 +1,38 @@
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# - Try to find liburing
+# Once done, this will define
+#
+# liburing_FOUND - system has liburing
+# liburing::liburing - imported target
+
+include(FindPackageHandleStandardArgs)
+
+find_library(LIBURING_LIBRARY uring PATHS ${LIBURING_LIBRARYDIR})
+find_path(LIBURING_INCLUDE_DIR liburing.h PATHS ${LIBURING_INCLUDEDIR})
+
+find_package_handle_standard_args(liburing DEFAULT_MSG LIBURING_LIBRARY
+                                  LIBURING_INCLUDE_DIR)
+
+mark_as_advanced(LIBURING_LIBRARY LIBURING_INCLUDE_DIR)
+
+if(liburing_FOUND AND NOT TARGET liburing::liburing)
+  add_library(liburing::liburing UNKNOWN IMPORTED)
+  set_target_properties(
+    liburing::liburing
+    PROPERTIES INTERFACE_INCLUDE_DIRECTORIES "${LIBURING_INCLUDE_DIR}"
+               IMPORTED_LINK_INTERFACE_LANGUAGES "C"
+               IMPORTED_LOCATION "${LIBURING_LIBRARY}")
+endif()
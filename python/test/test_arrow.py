@@ -17,7 +17,7 @@
 import unittest
 import pyarrow
 
-from pyvelox.arrow import to_velox, to_arrow
+from pyvelox.arrow import to_velox, to_arrow, to_arrow_stream
 from pyvelox.vector import Vector
 
 
@@ -40,6 +40,17 @@ class TestPyVeloxArrow(unittest.TestCase):
         self.assertTrue(isinstance(array2, pyarrow.Array))
         self.assertEqual(array, array2)
 
+    def test_stream(self):
+        batches = [
+            pyarrow.record_batch({"a": [1, 2, 3], "b": ["x", "y", None]}),
+            pyarrow.record_batch({"a": [4, 5], "b": ["hello", "world"]}),
+        ]
+        reader = to_arrow_stream(to_velox(batch) for batch in batches)
+
+        self.assertTrue(isinstance(reader, pyarrow.RecordBatchReader))
+        self.assertEqual(reader.schema, batches[0].schema)
+        self.assertEqual(reader.read_all(), pyarrow.Table.from_batches(batches))
+
     def test_empty(self):
         # TODO: Velox's arrow bridge does not allow missing buffers (even if
         # there are no rows):
@@ -19,6 +19,8 @@ import tempfile
 import unittest
 
 import pyarrow
+import pyarrow.dataset
+import pyarrow.parquet
 from pyvelox.arrow import to_velox
 from pyvelox.file import DWRF
 from pyvelox.plan_builder import PlanBuilder
@@ -296,6 +298,41 @@ class TestPyVeloxRunner(unittest.TestCase):
                 output_rows += vector.size()
             self.assertEqual(output_rows, 6005)
 
+    def test_runner_with_dataset(self):
+        register_hive("hive")
+        num_files = 4
+        batch_size = 10
+
+        with tempfile.TemporaryDirectory() as temp_dir:
+            for i in range(num_files):
+                table = pyarrow.table(
+                    {"c0": list(range(i * batch_size, (i + 1) * batch_size))}
+                )
+                pyarrow.parquet.write_table(table, f"{temp_dir}/file_{i}.parquet")
+            dataset = pyarrow.dataset.dataset(temp_dir, format="parquet")
+
+            plan_builder = PlanBuilder().table_scan(
+                output_schema=ROW(["c0"], [BIGINT()]),
+                connector_id="hive",
+            )
+            scan_id = plan_builder.get_plan_node().id()
+
+            runner = LocalRunner(plan_builder.get_plan_node())
+            runner.add_dataset_splits(dataset, plan_id=scan_id, connector_id="hive")
+            values = []
+            for vector in runner.execute(max_drivers=num_files):
+                values.extend(
+                    int(vector.child_at(0)[i]) for i in range(vector.size())
+                )
+            self.assertEqual(sorted(values), list(range(num_files * batch_size)))
+
+    def test_runner_dataset_unsupported(self):
+        plan_builder = PlanBuilder().values()
+        runner = LocalRunner(plan_builder.get_plan_node())
+        self.assertRaises(
+            RuntimeError, runner.add_dataset_splits, object(), plan_id="0"
+        )
+
     def extract_file(self, output_vector):
         # Parse and return the output file name from the writer's output.
         output_json = json.loads(output_vector.child_at(1)[1])
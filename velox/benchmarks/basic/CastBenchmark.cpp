@@ -87,6 +87,12 @@ int main(int argc, char** argv) {
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
   auto invalidDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("2024-05...{}", row); });
+  auto bigintStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return std::to_string(row * 1'234'567'891); });
+  auto shortDoubleStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return fmt::format("-{}.25", row * 1'791); });
+  auto largeBigintInput = vectorMaker.flatVector<int64_t>(
+      vectorSize, [](auto row) { return row * 123'456'789'012'345; });
 
   benchmarkBuilder
       .addBenchmarkSet(
@@ -125,6 +131,22 @@ int main(int argc, char** argv) {
           vectorMaker.rowVector({"timestamp"}, {timestampInput}))
       .addExpression("cast", "cast (timestamp as varchar)");
 
+  // Strings in the formats of the fast paths and integers to string.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_numbers",
+          vectorMaker.rowVector(
+              {"bigint_string", "double_string", "integer", "bigint"},
+              {bigintStrings,
+               shortDoubleStrings,
+               integerInput,
+               largeBigintInput}))
+      .addExpression("cast_varchar_as_bigint", "cast(bigint_string as bigint)")
+      .addExpression("cast_varchar_as_double", "cast(double_string as double)")
+      .addExpression("cast_integer_as_varchar", "cast(integer as varchar)")
+      .addExpression("cast_bigint_as_varchar", "cast(bigint as varchar)")
+      .disableTesting();
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_varchar_as_double",
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
@@ -112,10 +113,55 @@ int main(int argc, char** argv) {
           "relaxed_suffix_unicode_2", R"(like(col1, '%_\__\_啊', '\'))")
       .addExpression("ends_with", R"(ends_with(col0, 'a_b_c'))");
 
+  // The escape character disables the substrings fast path, so that the
+  // patterns are matched with RE2.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "substrings", vectorMaker.rowVector({"col0"}, {substringInput}))
+      .addExpression("substrings", R"(like(col0, '%a%b%c%'))")
+      .addExpression("substrings_re2", R"(like(col0, '%a%b%c%', '!'))");
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "anchored_substrings",
+          vectorMaker.rowVector({"col0"}, {substringInput}))
+      .addExpression("anchored_substrings", R"(like(col0, 'xxx%b%xxx'))")
+      .addExpression(
+          "anchored_substrings_re2", R"(like(col0, 'xxx%b%xxx', '!'))");
+
+  // A disjunction of likes over the same column is rewritten to one call that
+  // matches all the patterns. The escape character disables the rewrite.
+  auto anyInput = makeInput(vectorSize, true, true, "abc");
+  std::vector<std::string> literals = {
+      "abc", "zzz", "yyy", "cba", "xyx", "bcd", "xxa", "ccc"};
+  std::vector<std::string> likeAny;
+  std::vector<std::string> likeOr;
+  for (const auto& literal : literals) {
+    likeAny.push_back(fmt::format("col0 like '%{}%'", literal));
+    likeOr.push_back(fmt::format("like(col0, '%{}%', '!')", literal));
+  }
+  benchmarkBuilder
+      .addBenchmarkSet("like_any", vectorMaker.rowVector({"col0"}, {anyInput}))
+      .addExpression("like_any_8", folly::join(" or ", likeAny))
+      .addExpression("like_or_8", folly::join(" or ", likeOr));
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "like_any_mixed", vectorMaker.rowVector({"col0"}, {anyInput}))
+      .addExpression(
+          "like_any_mixed",
+          "col0 like '%zzz%' or col0 like '%yyy%' or col0 like 'abc%' or "
+          "col0 like '%abc' or col0 like 'x%c%x'")
+      .addExpression(
+          "like_or_mixed",
+          "like(col0, '%zzz%', '!') or like(col0, '%yyy%', '!') or "
+          "like(col0, 'abc%', '!') or like(col0, '%abc', '!') or "
+          "like(col0, 'x%c%x', '!')");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "generic", vectorMaker.rowVector({"col0"}, {substringInput}))
-      .addExpression("generic", R"(like(col0, '%a%b%c'))");
+      .addExpression("generic", R"(like(col0, '%a%b_c'))");
 
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
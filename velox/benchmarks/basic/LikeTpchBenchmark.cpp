@@ -15,6 +15,7 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/functions/lib/Re2Functions.h"
@@ -133,10 +134,31 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
   }
 
   size_t run(const TpchBenchmarkCase tpchCase, const StringView patternString) {
+    return runExpression(
+        tpchCase, fmt::format("like(c0, '{}')", patternString));
+  }
+
+  // Runs 'c0 LIKE pattern1 OR c0 LIKE pattern2 ...'. If 'escape' is true, the
+  // likes have an escape character, so that they are not evaluated together.
+  size_t run(
+      const TpchBenchmarkCase tpchCase,
+      const std::vector<std::string>& patterns,
+      bool escape) {
+    std::vector<std::string> likes;
+    for (const auto& pattern : patterns) {
+      likes.push_back(
+          escape ? fmt::format("like(c0, '{}', '!')", pattern)
+                 : fmt::format("like(c0, '{}')", pattern));
+    }
+    return runExpression(tpchCase, folly::join(" or ", likes));
+  }
+
+  size_t runExpression(
+      const TpchBenchmarkCase tpchCase,
+      const std::string& likeExpression) {
     folly::BenchmarkSuspender kSuspender;
     const auto input = getTpchData(tpchCase);
     const auto data = makeRowVector({input});
-    auto likeExpression = fmt::format("like(c0, '{}')", patternString);
     auto rowType = std::dynamic_pointer_cast<const RowType>(data->type());
     exec::ExprSet exprSet =
         FunctionBenchmarkBase::compileExpression(likeExpression, rowType);
@@ -239,6 +261,47 @@ BENCHMARK(tpchQuery20) {
   benchmark->run(TpchBenchmarkCase::TpchQuery20, "forest%");
 }
 
+BENCHMARK_DRAW_LINE();
+
+// Part names, as in TPC-H query 9, with anchored literals.
+BENCHMARK(anchoredSubstringsRe2) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery9, {"forest%green%"}, true);
+}
+
+BENCHMARK_RELATIVE(anchoredSubstrings) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery9, {"forest%green%"}, false);
+}
+
+const std::vector<std::string> kColorPatterns = {
+    "%green%",
+    "%ivory%",
+    "%khaki%",
+    "%lemon%",
+    "%maroon%",
+    "%navy%",
+    "%orchid%",
+    "%peru%"};
+
+BENCHMARK(likeOrSubstrings) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery9, kColorPatterns, true);
+}
+
+BENCHMARK_RELATIVE(likeAnySubstrings) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery9, kColorPatterns, false);
+}
+
+// Part types, as in TPC-H query 16, with mixed pattern kinds.
+const std::vector<std::string> kTypePatterns = {
+    "MEDIUM POLISHED%", "%BRASS", "%TIN", "%ANODIZED%", "PROMO%COPPER"};
+
+BENCHMARK(likeOrMixed) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery16Part, kTypePatterns, true);
+}
+
+BENCHMARK_RELATIVE(likeAnyMixed) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery16Part, kTypePatterns, false);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
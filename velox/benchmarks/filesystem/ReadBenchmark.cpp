@@ -16,7 +16,9 @@
 
 #include "velox/benchmarks/filesystem/ReadBenchmark.h"
 
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/config/Config.h"
+#include "velox/common/io/CoalescingController.h"
 #include "velox/connectors/hive/storage_adapters/abfs/RegisterAbfsFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/gcs/RegisterGcsFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/RegisterHdfsFileSystem.h"
@@ -49,6 +51,11 @@ DEFINE_int32(
     "Total reads per thread when throughput for a --bytes/--gap/--/gap/"
     "--num_in_run combination");
 DEFINE_string(config, "", "Path of the config file");
+DEFINE_bool(
+    calibrate_coalescing,
+    false,
+    "Fits the latency and throughput of reads from --path and prints the "
+    "resulting coalescing thresholds instead of running the read patterns");
 
 namespace {
 static bool notEmpty(const char* /*flagName*/, const std::string& value) {
@@ -134,7 +141,45 @@ void ReadBenchmark::finalize() {
   filesystems::finalizeS3FileSystem();
 }
 
+void ReadBenchmark::calibrateCoalescing() {
+  auto& controller = io::CoalescingController::forPath(FLAGS_path);
+  controller.testingClear();
+  constexpr int32_t kMaxSize = 64 << 20;
+  const int32_t maxSize = std::min<int64_t>(kMaxSize, fileSize_);
+  auto& scratch = getScratch(maxSize);
+  for (auto repeat = 0; repeat < 3; ++repeat) {
+    for (int32_t size = 4 << 10; size <= maxSize; size *= 2) {
+      const int64_t offset =
+          folly::Random::rand64(rng_) % (fileSize_ - size + 1);
+      uint64_t usec = 0;
+      {
+        MicrosecondTimer timer(&usec);
+        readFile_->pread(offset, size, scratch.buffer.data());
+      }
+      controller.recordRead(size, usec);
+    }
+  }
+  const auto model = controller.model();
+  if (!model.has_value()) {
+    std::cout << "Could not fit a read cost model for " << FLAGS_path
+              << std::endl;
+    return;
+  }
+  std::cout << fmt::format(
+                   "Request latency: {:.0f}us Throughput: {:.1f}MB/s "
+                   "Max coalesce distance: {} Max coalesce bytes: {}",
+                   model->requestLatencyUs,
+                   1 / model->transferUsPerByte,
+                   succinctBytes(controller.maxCoalesceDistance(0)),
+                   succinctBytes(controller.maxCoalesceBytes(0)))
+            << std::endl;
+}
+
 void ReadBenchmark::run() {
+  if (FLAGS_calibrate_coalescing) {
+    calibrateCoalescing();
+    return;
+  }
   if (FLAGS_bytes) {
     modes(FLAGS_bytes, FLAGS_gap, FLAGS_num_in_run);
     return;
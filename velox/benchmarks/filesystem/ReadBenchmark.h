@@ -44,6 +44,7 @@ DECLARE_int32(num_in_run);
 
 DECLARE_int32(measurement_size);
 DECLARE_string(config);
+DECLARE_bool(calibrate_coalescing);
 
 namespace facebook::velox {
 
@@ -255,6 +256,11 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
   }
 
+  // Times single reads of sizes from 4KB to 64MB and prints the coalescing
+  // thresholds that io::CoalescingController picks for the file system of
+  // --path from them.
+  void calibrateCoalescing();
+
   void run();
 
  protected:
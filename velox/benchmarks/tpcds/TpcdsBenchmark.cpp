@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/tpcds/TpcdsBenchmark.h"
+
+#include <folly/String.h>
+#include <folly/json.h>
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+DEFINE_double(scale_factor, 1, "TPC-DS scale factor of the generated data");
+DEFINE_string(
+    queries,
+    "",
+    "Comma separated list of the TPC-DS queries to run with "
+    "--output_json, e.g. '3,42,98'. Runs all supported queries if empty");
+DEFINE_int32(
+    num_splits,
+    16,
+    "Number of splits each table is divided in. Each split generates its "
+    "rows independently");
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+DEFINE_string(
+    output_json,
+    "",
+    "If set, runs the queries selected by --queries --num_repeats times and "
+    "writes wall and CPU time, output rows and per plan node operator "
+    "statistics of each query to this file as JSON");
+
+namespace {
+
+class TpcdsBenchmark : public QueryBenchmarkBase {
+ public:
+  void initialize() override {
+    QueryBenchmarkBase::initialize();
+    window::prestosql::registerAllWindowFunctions();
+    connector::registerConnectorFactory(
+        std::make_shared<connector::tpcds::TpcdsConnectorFactory>());
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                std::string(PlanBuilder::kTpcdsDefaultConnectorId),
+                std::make_shared<config::ConfigBase>(
+                    std::unordered_map<std::string, std::string>()));
+    connector::registerConnector(tpcdsConnector);
+  }
+
+  void shutdown() {
+    connector::unregisterConnector(
+        std::string(PlanBuilder::kTpcdsDefaultConnectorId));
+    QueryBenchmarkBase::shutdown();
+  }
+
+  /// Runs 'tpcdsPlan' once. Feeds FLAGS_num_splits splits to each of its
+  /// table scans. Returns a null cursor if the query failed.
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>>
+  runTpcds(const TpcdsPlan& tpcdsPlan) {
+    CursorParameters params;
+    params.maxDrivers = FLAGS_num_drivers;
+    params.planNode = tpcdsPlan.plan;
+    bool noMoreSplits = false;
+    auto addSplits = [&](exec::Task* task) {
+      if (noMoreSplits) {
+        return;
+      }
+      for (const auto& scanNodeId : tpcdsPlan.scanNodeIds) {
+        for (auto i = 0; i < FLAGS_num_splits; ++i) {
+          task->addSplit(
+              scanNodeId,
+              exec::Split(
+                  std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+                      std::string(PlanBuilder::kTpcdsDefaultConnectorId),
+                      FLAGS_num_splits,
+                      i)));
+        }
+        task->noMoreSplits(scanNodeId);
+      }
+      noMoreSplits = true;
+    };
+    try {
+      auto result = readCursor(params, addSplits);
+      ensureTaskCompletion(result.first->task().get());
+      return result;
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Query terminated with: " << e.what();
+      return {nullptr, std::vector<RowVectorPtr>()};
+    }
+  }
+
+  void runMain(std::ostream& out, RunStats& /*runStats*/) override {
+    if (!FLAGS_output_json.empty()) {
+      writeJson();
+    } else if (FLAGS_run_query_verbose == -1) {
+      folly::runBenchmarks();
+    } else {
+      runVerbose(out, FLAGS_run_query_verbose);
+    }
+  }
+
+  std::shared_ptr<TpcdsQueryBuilder> queryBuilder;
+
+ private:
+  void runVerbose(std::ostream& out, int queryId) {
+    const auto tpcdsPlan = queryBuilder->getQueryPlan(queryId);
+    auto [cursor, actualResults] = runTpcds(tpcdsPlan);
+    if (!cursor) {
+      LOG(ERROR) << "Query terminated with error. Exiting";
+      exit(1);
+    }
+    if (FLAGS_include_results) {
+      printResults(actualResults, out);
+      out << std::endl;
+    }
+    const auto stats = cursor->task()->taskStats();
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << printPlanWithStats(
+               *tpcdsPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+  }
+
+  std::vector<int> selectedQueries() const {
+    if (FLAGS_queries.empty()) {
+      return TpcdsQueryBuilder::getQueryIds();
+    }
+    std::vector<int> queryIds;
+    folly::split(',', FLAGS_queries, queryIds);
+    return queryIds;
+  }
+
+  // Runs each selected query FLAGS_num_repeats times and writes a JSON array
+  // with one object per query to FLAGS_output_json. The operator statistics
+  // are those of the last run.
+  void writeJson() {
+    folly::dynamic results = folly::dynamic::array;
+    for (auto queryId : selectedQueries()) {
+      const auto tpcdsPlan = queryBuilder->getQueryPlan(queryId);
+      folly::dynamic query = folly::dynamic::object;
+      query["query"] = queryId;
+      query["scaleFactor"] = FLAGS_scale_factor;
+      query["numDrivers"] = FLAGS_num_drivers;
+      query["numSplits"] = FLAGS_num_splits;
+      folly::dynamic runs = folly::dynamic::array;
+      for (auto repeat = 0; repeat < FLAGS_num_repeats; ++repeat) {
+        const auto startNanos = getCurrentTimeNano();
+        auto [cursor, results] = runTpcds(tpcdsPlan);
+        const auto wallNanos = getCurrentTimeNano() - startNanos;
+        if (!cursor) {
+          query["error"] = true;
+          break;
+        }
+        const auto stats = cursor->task()->taskStats();
+        int64_t cpuNanos = 0;
+        for (const auto& [_, planNodeStats] : toPlanStats(stats)) {
+          cpuNanos += planNodeStats.cpuWallTiming.cpuNanos;
+        }
+        int64_t outputRows = 0;
+        for (const auto& vector : results) {
+          outputRows += vector->size();
+        }
+        folly::dynamic run = folly::dynamic::object;
+        run["wallNanos"] = static_cast<int64_t>(wallNanos);
+        run["cpuNanos"] = cpuNanos;
+        run["outputRows"] = outputRows;
+        runs.push_back(std::move(run));
+        if (repeat == FLAGS_num_repeats - 1) {
+          query["operators"] = toPlanStatsJson(stats);
+        }
+      }
+      query["runs"] = std::move(runs);
+      LOG(INFO) << "Finished TPC-DS Q" << queryId;
+      results.push_back(std::move(query));
+    }
+    std::ofstream file(FLAGS_output_json);
+    VELOX_CHECK(file.good(), "Cannot open {}", FLAGS_output_json);
+    file << folly::toPrettyJson(results) << std::endl;
+  }
+};
+
+TpcdsBenchmark benchmark;
+
+void runQuery(int queryId) {
+  const auto tpcdsPlan = benchmark.queryBuilder->getQueryPlan(queryId);
+  for (auto repeat = 0; repeat < FLAGS_num_repeats; ++repeat) {
+    benchmark.runTpcds(tpcdsPlan);
+  }
+}
+
+BENCHMARK(q3) {
+  runQuery(3);
+}
+
+BENCHMARK(q7) {
+  runQuery(7);
+}
+
+BENCHMARK(q19) {
+  runQuery(19);
+}
+
+BENCHMARK(q27) {
+  runQuery(27);
+}
+
+BENCHMARK(q36) {
+  runQuery(36);
+}
+
+BENCHMARK(q42) {
+  runQuery(42);
+}
+
+BENCHMARK(q89) {
+  runQuery(89);
+}
+
+BENCHMARK(q98) {
+  runQuery(98);
+}
+
+} // namespace
+
+int tpcdsBenchmarkMain() {
+  benchmark.initialize();
+  benchmark.queryBuilder =
+      std::make_shared<TpcdsQueryBuilder>(FLAGS_scale_factor);
+  RunStats ignore;
+  benchmark.runMain(std::cout, ignore);
+  benchmark.queryBuilder.reset();
+  benchmark.shutdown();
+  return 0;
+}
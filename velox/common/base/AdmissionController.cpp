@@ -16,13 +16,15 @@
 
 #include "velox/common/base/AdmissionController.h"
 
+#include <algorithm>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/time/Timer.h"
 
 namespace facebook::velox::common {
 
-void AdmissionController::accept(uint64_t resourceUnits) {
+void AdmissionController::accept(uint64_t resourceUnits, int32_t priority) {
   ContinueFuture future;
   uint64_t updatedValue = 0;
   VELOX_CHECK_LE(
@@ -35,8 +37,16 @@ void AdmissionController::accept(uint64_t resourceUnits) {
       auto [unblockPromise, unblockFuture] = makeVeloxContinuePromiseContract();
       Request req;
       req.unitsRequested = resourceUnits;
+      req.priority = priority;
       req.promise = std::move(unblockPromise);
-      queue_.push_back(std::move(req));
+      auto it = std::upper_bound(
+          queue_.begin(),
+          queue_.end(),
+          priority,
+          [](int32_t value, const Request& request) {
+            return value < request.priority;
+          });
+      queue_.insert(it, std::move(req));
       future = std::move(unblockFuture);
     } else {
       updatedValue = unitsUsed_ += resourceUnits;
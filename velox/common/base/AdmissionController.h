@@ -24,9 +24,10 @@ namespace facebook::velox::common {
 /// A generic admission controller that can be used to limit the number of
 /// resources in use and can log metrics like resource usage, queued count,
 /// queued wait times. When a calling thread's request for resources surpasses
-/// the set limit, it will be placed in a FIFO queue. The thread must then wait
-/// until sufficient resources are freed by other threads, addressing all
-/// preceding requests in the queue, before its own request can be granted.
+/// the set limit, it will be placed in a queue ordered by request priority,
+/// and in FIFO order within the same priority. The thread must then wait until
+/// sufficient resources are freed by other threads, addressing all preceding
+/// requests in the queue, before its own request can be granted.
 class AdmissionController {
  public:
   struct Config {
@@ -46,7 +47,10 @@ class AdmissionController {
   explicit AdmissionController(const Config& config) : config_(config) {}
 
   // Accept can block until sufficient resources are freed by other threads.
-  void accept(uint64_t resourceUnits);
+  // A queued request with a smaller 'priority' number is granted before the
+  // queued requests with larger numbers, and after the earlier queued requests
+  // with the same or a smaller number.
+  void accept(uint64_t resourceUnits, int32_t priority = 0);
   void release(uint64_t resourceUnits);
 
   uint64_t currentResourceUsage() const {
@@ -57,6 +61,7 @@ class AdmissionController {
  private:
   struct Request {
     uint64_t unitsRequested;
+    int32_t priority;
     ContinuePromise promise;
   };
   Config config_;
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -61,6 +62,41 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Sets bit i of 'result' if hashes[i] may be in the filter and clears it
+  // otherwise, for i in [0, size). 'result' must have space for
+  // bits::nwords(size) words. Tests a batch of hashes at a time with a SIMD
+  // gather of their filter words. Input is hashed uint64_t values as for
+  // mayContain(uint64_t). The filter must be set.
+  void mayContain(const uint64_t* hashes, int32_t size, uint64_t* result)
+      const {
+    using Batch = xsimd::batch<uint64_t>;
+    constexpr int32_t kBatchSize = Batch::size;
+    static_assert(64 % kBatchSize == 0);
+    std::fill(result, result + bits::nwords(size), 0);
+    const Batch one(1);
+    const Batch bitMask(63);
+    const Batch indexMask(bits_.size() - 1);
+    int32_t i = 0;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      const auto hashCode = Batch::load_unaligned(hashes + i);
+      const auto mask = (one << (hashCode & bitMask)) |
+          (one << ((hashCode >> 6) & bitMask)) |
+          (one << ((hashCode >> 12) & bitMask)) |
+          (one << ((hashCode >> 18) & bitMask));
+      const auto indices =
+          simd::reinterpretBatch<int64_t>((hashCode >> 24) & indexMask);
+      const auto words = simd::maskGather(
+          Batch(0), xsimd::batch_bool<uint64_t>(true), bits_.data(), indices);
+      const uint64_t hits = simd::toBitMask((words & mask) == mask);
+      result[i / 64] |= hits << (i % 64);
+    }
+    for (; i < size; ++i) {
+      if (test(bits_.data(), bits_.size(), hashes[i])) {
+        bits::setBit(result, i);
+      }
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
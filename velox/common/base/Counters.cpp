@@ -39,6 +39,16 @@ void registerVeloxMetrics() {
   // sequential task execution mode.
   DEFINE_METRIC(kMetricTaskBatchProcessTimeMs, facebook::velox::StatType::AVG);
 
+  // Tracks the number of calls of scalar functions that were compiled with the
+  // function they resolve to from the function resolution cache.
+  DEFINE_METRIC(
+      kMetricFunctionResolutionCacheHits, facebook::velox::StatType::COUNT);
+
+  // Tracks the number of calls of scalar functions that were resolved because
+  // they were not in the function resolution cache.
+  DEFINE_METRIC(
+      kMetricFunctionResolutionCacheMisses, facebook::velox::StatType::COUNT);
+
   /// ================== Cache Counters =================
 
   // Tracks hive handle generation latency in range of [0, 100s] and reports
@@ -182,6 +192,10 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryCacheNumStaleEntries, facebook::velox::StatType::COUNT);
 
+  // Total bytes of AsyncDataCache entries that are not admitted for retention
+  // by the admission filter.
+  DEFINE_METRIC(kMetricMemoryCacheBypassBytes, facebook::velox::StatType::SUM);
+
   /// ================== SsdCache Counters ==================
 
   // Number of regions currently cached by SSD.
@@ -441,6 +455,19 @@ void registerVeloxMetrics() {
       99,
       100);
 
+  // The used memory bytes reclaimed by spilling at the background when the
+  // used arbitrator capacity exceeds the soft watermark.
+  DEFINE_METRIC(
+      kMetricArbitratorSoftWatermarkReclaimedBytes,
+      facebook::velox::StatType::SUM);
+
+  // The time spent on the background memory reclaim above the soft watermark.
+  // This is the spill time taken off the critical path of the capacity growth
+  // requests.
+  DEFINE_METRIC(
+      kMetricArbitratorSoftWatermarkReclaimTimeMs,
+      facebook::velox::StatType::SUM);
+
   // The distribution of the amount of time it takes to complete a single
   // arbitration operation in range of [0, 600s] with 20 buckets. It is
   // configured to report the latency at P50, P90, P99, and P100 percentiles.
@@ -653,5 +680,36 @@ void registerVeloxMetrics() {
   // The number of times that storage IOs get throttled in a storage cluster.
   DEFINE_METRIC(
       kMetricStorageGlobalThrottled, facebook::velox::StatType::COUNT);
+
+  // The latency distribution of the reads served from the memory cache,
+  // including the waits for loads in progress, in range of [0, 1ms] with 100
+  // buckets. It is configured to report the latency at P50, P90, P99, and
+  // P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricIoRamHitLatencyUs, 10, 0, 1'000, 50, 90, 99, 100);
+
+  // The latency distribution of the reads served from the SSD cache in range
+  // of [0, 10ms] with 100 buckets. It is configured to report the latency at
+  // P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricIoSsdHitLatencyUs, 100, 0, 10'000, 50, 90, 99, 100);
+
+  // The latency distribution of the reads from storage in range of [0, 2s]
+  // with 100 buckets. It is configured to report the latency at P50, P90, P99,
+  // and P100 percentiles. The reads of each storage type are also reported as
+  // "velox.io_storage_latency_ms.<storage type>", e.g.
+  // "velox.io_storage_latency_ms.s3a".
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricIoStorageLatencyMs, 20, 0, 2'000, 50, 90, 99, 100);
+
+  // The compressed bytes decompressed by a DecompressionAccelerator.
+  DEFINE_METRIC(
+      kMetricDecompressionOffloadedBytes, facebook::velox::StatType::SUM);
+
+  // The number of blocks a DecompressionAccelerator failed on that were then
+  // decompressed in software.
+  DEFINE_METRIC(
+      kMetricDecompressionOffloadFallbackCount,
+      facebook::velox::StatType::COUNT);
 }
 } // namespace facebook::velox
@@ -110,6 +110,12 @@ constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationWaitCount{
 constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationWaitTimeMs{
     "velox.arbitrator_global_arbitration_wait_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorSoftWatermarkReclaimedBytes{
+    "velox.arbitrator_soft_watermark_reclaimed_bytes"};
+
+constexpr folly::StringPiece kMetricArbitratorSoftWatermarkReclaimTimeMs{
+    "velox.arbitrator_soft_watermark_reclaim_time_ms"};
+
 constexpr folly::StringPiece kMetricArbitratorAbortedCount{
     "velox.arbitrator_aborted_count"};
 
@@ -255,6 +261,9 @@ constexpr folly::StringPiece kMetricMemoryCacheNumAgedOutEntries{
 constexpr folly::StringPiece kMetricMemoryCacheNumStaleEntries{
     "velox.memory_cache_num_stale_entries"};
 
+constexpr folly::StringPiece kMetricMemoryCacheBypassBytes{
+    "velox.memory_cache_bypass_bytes"};
+
 constexpr folly::StringPiece kMetricSsdCacheCachedRegions{
     "velox.ssd_cache_cached_regions"};
 
@@ -363,6 +372,21 @@ constexpr folly::StringPiece kMetricStorageGlobalThrottled{
 constexpr folly::StringPiece kMetricStorageNetworkThrottled{
     "velox.storage_network_throttled_count"};
 
+constexpr folly::StringPiece kMetricIoRamHitLatencyUs{
+    "velox.io_ram_hit_latency_us"};
+
+constexpr folly::StringPiece kMetricIoSsdHitLatencyUs{
+    "velox.io_ssd_hit_latency_us"};
+
+constexpr folly::StringPiece kMetricIoStorageLatencyMs{
+    "velox.io_storage_latency_ms"};
+
+constexpr folly::StringPiece kMetricDecompressionOffloadedBytes{
+    "velox.decompression_offloaded_bytes"};
+
+constexpr folly::StringPiece kMetricDecompressionOffloadFallbackCount{
+    "velox.decompression_offload_fallback_count"};
+
 constexpr folly::StringPiece kMetricIndexLookupResultRawBytes{
     "velox.index_lookup_result_raw_bytes"};
 
@@ -386,4 +410,10 @@ constexpr folly::StringPiece kMetricTableScanBatchBytes{
 
 constexpr folly::StringPiece kMetricTaskBatchProcessTimeMs{
     "velox.task_batch_process_time_ms"};
+
+constexpr folly::StringPiece kMetricFunctionResolutionCacheHits{
+    "velox.function_resolution_cache_hits"};
+
+constexpr folly::StringPiece kMetricFunctionResolutionCacheMisses{
+    "velox.function_resolution_cache_misses"};
 } // namespace facebook::velox
@@ -169,6 +169,8 @@ void PeriodicStatsReporter::reportCacheStats() {
       kMetricMemoryCacheNumAllocClocks, deltaCacheStats.allocClocks);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheNumAgedOutEntries, deltaCacheStats.numAgedOut);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheBypassBytes, deltaCacheStats.bypassBytes);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheSumEvictScore, deltaCacheStats.sumEvictScore);
 
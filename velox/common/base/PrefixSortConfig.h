@@ -43,5 +43,11 @@ struct PrefixSortConfig {
   /// Maximum number of bytes to be stored in prefix-sort buffer for a string
   /// column.
   uint32_t maxStringPrefixLength{16};
+
+  /// Maximum bytes of normalized keys per entry to sort with radix sort
+  /// instead of quick sort. Applies only if all the sort keys are fully
+  /// normalized, e.g. one nullable TIMESTAMP key or up to two nullable BIGINT
+  /// keys. Zero disables radix sort.
+  uint32_t maxRadixSortKeyBytes{24};
 };
 } // namespace facebook::velox::common
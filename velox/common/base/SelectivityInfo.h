@@ -47,6 +47,10 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  uint64_t timeClocks() const {
+    return timeClocks_;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/ShardedStatsReporter.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+namespace {
+uint64_t nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+} // namespace
+
+ShardedStatsReporter::ShardedStatsReporter() : lastFetchMicros_(nowMicros()) {}
+
+// static
+int32_t ShardedStatsReporter::shardIndex() {
+  static std::atomic<int32_t> nextShard{0};
+  thread_local const int32_t index =
+      nextShard.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return index;
+}
+
+void ShardedStatsReporter::registerMetric(
+    folly::StringPiece key,
+    StatType type,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  auto metric = std::make_unique<Metric>();
+  metric->type = type;
+  if (type == StatType::HISTOGRAM) {
+    VELOX_CHECK_GT(bucketWidth, 0, "Bad bucket width of histogram {}", key);
+    VELOX_CHECK_LT(min, max, "Bad range of histogram {}", key);
+    metric->bucketWidth = bucketWidth;
+    metric->min = min;
+    metric->max = max;
+    metric->pcts = pcts;
+    metric->numBuckets = (max - min + bucketWidth - 1) / bucketWidth + 2;
+    metric->buckets = std::make_unique<std::atomic<int64_t>[]>(
+        kNumShards * metric->numBuckets);
+  }
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  // The first registration of a key is kept.
+  metrics_.emplace(key.str(), std::move(metric));
+}
+
+void ShardedStatsReporter::addValue(folly::StringPiece key, size_t value)
+    const {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = metrics_.find(key);
+  if (it == metrics_.end()) {
+    return;
+  }
+  auto& metric = *it->second;
+  const auto shard = shardIndex();
+  metric.shards[shard].sum.fetch_add(value, std::memory_order_relaxed);
+  metric.shards[shard].count.fetch_add(1, std::memory_order_relaxed);
+  if (metric.type == StatType::HISTOGRAM) {
+    const int64_t signedValue = value;
+    int32_t bucket;
+    if (signedValue < metric.min) {
+      bucket = 0;
+    } else if (signedValue >= metric.max) {
+      bucket = metric.numBuckets - 1;
+    } else {
+      bucket = 1 + (signedValue - metric.min) / metric.bucketWidth;
+    }
+    metric.buckets[shard * metric.numBuckets + bucket].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+// static
+int64_t ShardedStatsReporter::percentile(const Metric& metric, int32_t pct) {
+  std::vector<int64_t> counts(metric.numBuckets);
+  int64_t total = 0;
+  for (auto shard = 0; shard < kNumShards; ++shard) {
+    for (auto bucket = 0; bucket < metric.numBuckets; ++bucket) {
+      const auto count =
+          metric.buckets[shard * metric.numBuckets + bucket].load(
+              std::memory_order_relaxed);
+      counts[bucket] += count;
+      total += count;
+    }
+  }
+  if (total == 0) {
+    return 0;
+  }
+  const auto target = std::max<int64_t>(1, (total * pct + 99) / 100);
+  int64_t sum = 0;
+  for (auto bucket = 0; bucket < metric.numBuckets; ++bucket) {
+    sum += counts[bucket];
+    if (sum >= target) {
+      if (bucket == 0) {
+        return metric.min;
+      }
+      return std::min(metric.min + bucket * metric.bucketWidth, metric.max);
+    }
+  }
+  return metric.max;
+}
+
+std::string ShardedStatsReporter::fetchMetrics() {
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  const auto now = nowMicros();
+  const auto elapsedMicros = now - lastFetchMicros_;
+  lastFetchMicros_ = now;
+
+  std::vector<std::pair<std::string, Metric*>> sorted;
+  sorted.reserve(metrics_.size());
+  for (const auto& [key, metric] : metrics_) {
+    sorted.emplace_back(key, metric.get());
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+
+  std::string result;
+  for (auto& [key, metric] : sorted) {
+    int64_t sum = 0;
+    int64_t count = 0;
+    for (const auto& shard : metric->shards) {
+      sum += shard.sum.load(std::memory_order_relaxed);
+      count += shard.count.load(std::memory_order_relaxed);
+    }
+    switch (metric->type) {
+      case StatType::AVG:
+        result += fmt::format("{} {}\n", key, count == 0 ? 0 : sum / count);
+        break;
+      case StatType::SUM:
+        result += fmt::format("{} {}\n", key, sum);
+        break;
+      case StatType::RATE: {
+        const auto delta = sum - metric->lastSum;
+        metric->lastSum = sum;
+        result += fmt::format(
+            "{} {}\n",
+            key,
+            elapsedMicros == 0 ? 0 : delta * 1'000'000 / elapsedMicros);
+        break;
+      }
+      case StatType::COUNT:
+        // RECORD_METRIC_VALUE adds its value to a count like to a sum.
+        result += fmt::format("{} {}\n", key, sum);
+        break;
+      case StatType::HISTOGRAM:
+        for (auto pct : metric->pcts) {
+          result +=
+              fmt::format("{}.p{} {}\n", key, pct, percentile(*metric, pct));
+        }
+        break;
+    }
+  }
+  return result;
+}
+
+} // namespace facebook::velox
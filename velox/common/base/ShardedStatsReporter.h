@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/SharedMutex.h>
+#include <folly/container/F14Map.h>
+
+#include <atomic>
+
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox {
+
+/// StatsReporter that keeps the metrics in memory with lock-free updates, so
+/// that metrics recorded from hot paths do not contend between threads. Each
+/// metric has 'kNumShards' cache line aligned slots. A thread adds to the slot
+/// it was assigned on its first update with relaxed atomics. fetchMetrics()
+/// adds up the slots. The registry of metrics is only locked exclusively on
+/// registration. Values of metrics that are not registered are dropped.
+///
+/// An application that has no reporter of its own can register it with:
+///
+///   folly::Singleton<facebook::velox::BaseStatsReporter> reporter([]() {
+///     return new facebook::velox::ShardedStatsReporter();
+///   });
+///
+/// and set BaseStatsReporter::registered to true.
+class ShardedStatsReporter : public BaseStatsReporter {
+ public:
+  static constexpr int32_t kNumShards = 64;
+
+  ShardedStatsReporter();
+
+  void registerMetricExportType(const char* key, StatType statType)
+      const override {
+    registerMetric(key, statType, 0, 0, 0, {});
+  }
+
+  void registerMetricExportType(folly::StringPiece key, StatType statType)
+      const override {
+    registerMetric(key, statType, 0, 0, 0, {});
+  }
+
+  void registerHistogramMetricExportType(
+      const char* key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override {
+    registerMetric(key, StatType::HISTOGRAM, bucketWidth, min, max, pcts);
+  }
+
+  void registerHistogramMetricExportType(
+      folly::StringPiece key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override {
+    registerMetric(key, StatType::HISTOGRAM, bucketWidth, min, max, pcts);
+  }
+
+  void addMetricValue(const std::string& key, size_t value = 1)
+      const override {
+    addValue(key, value);
+  }
+
+  void addMetricValue(const char* key, size_t value = 1) const override {
+    addValue(key, value);
+  }
+
+  void addMetricValue(folly::StringPiece key, size_t value = 1)
+      const override {
+    addValue(key, value);
+  }
+
+  void addHistogramMetricValue(const std::string& key, size_t value)
+      const override {
+    addValue(key, value);
+  }
+
+  void addHistogramMetricValue(const char* key, size_t value) const override {
+    addValue(key, value);
+  }
+
+  void addHistogramMetricValue(folly::StringPiece key, size_t value)
+      const override {
+    addValue(key, value);
+  }
+
+  /// Returns one 'name value' line per metric ordered by name. AVG, SUM and
+  /// COUNT are over all values added so far, where COUNT adds up the values
+  /// like SUM. RATE is the sum per second since the previous call. A histogram
+  /// has a line per percentile named '<name>.p<percentile>', where the value
+  /// is the upper bound of the bucket of the percentile.
+  std::string fetchMetrics() override;
+
+ private:
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    std::atomic<int64_t> sum{0};
+    std::atomic<int64_t> count{0};
+  };
+
+  struct Metric {
+    StatType type;
+    Shard shards[kNumShards];
+
+    // Set for a histogram.
+    int64_t bucketWidth{0};
+    int64_t min{0};
+    int64_t max{0};
+    std::vector<int32_t> pcts;
+    // The buckets below 'min', between 'min' and 'max' and above 'max' of each
+    // shard.
+    int32_t numBuckets{0};
+    std::unique_ptr<std::atomic<int64_t>[]> buckets;
+
+    // The sum at the end of the previous fetchMetrics() for RATE.
+    int64_t lastSum{0};
+  };
+
+  // Returns the slot of the calling thread.
+  static int32_t shardIndex();
+
+  void registerMetric(
+      folly::StringPiece key,
+      StatType type,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const;
+
+  void addValue(folly::StringPiece key, size_t value) const;
+
+  // Returns the value of percentile 'pct' of the histogram 'metric'.
+  static int64_t percentile(const Metric& metric, int32_t pct);
+
+  mutable folly::SharedMutex mutex_;
+  mutable folly::F14FastMap<std::string, std::unique_ptr<Metric>> metrics_;
+  // The time of the previous fetchMetrics() for RATE.
+  uint64_t lastFetchMicros_;
+};
+
+} // namespace facebook::velox
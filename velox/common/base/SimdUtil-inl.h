@@ -1530,7 +1530,9 @@ simdStrstr(const char* s, size_t n, const char* needle, size_t k) {
       return 0;
 
     case 1: {
-      const char* res = strchr(s, needle[0]);
+      // 's' is not null-terminated.
+      const auto* res =
+          static_cast<const char*>(std::memchr(s, needle[0], n));
 
       return (res != nullptr) ? res - s : std::string::npos;
     }
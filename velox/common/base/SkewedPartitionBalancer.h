@@ -25,7 +25,8 @@ class SkewedPartitionRebalancerTestHelper;
 
 /// This class is used to auto-scale partition processing by assigning more
 /// tasks to busy partition measured by processed data size. This is used by
-/// local partition to scale table writers for now.
+/// local partition to scale table writers and by partitioned output to spread
+/// skewed partitions over more destinations.
 class SkewedPartitionRebalancer {
  public:
   /// 'numPartitions' is the number of partitions to process. 'numTasks' is
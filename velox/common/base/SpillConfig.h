@@ -72,7 +72,10 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _columnarFormat = false,
+      bool _readAheadEnabled = false,
+      uint32_t _mergeFanIn = 0);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -157,5 +160,18 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, writes spill files in the columnar spill format with per column
+  /// encodings and an adaptive compression codec per batch.
+  bool columnarFormat{false};
+
+  /// If true and 'executor' is set, reads the next batch of each sorted spill
+  /// run on 'executor' while the current one is merged.
+  bool readAheadEnabled{false};
+
+  /// The max number of sorted spill runs merged at once. Larger sets of runs
+  /// are first merged into fewer runs in parallel on 'executor'. 0 means no
+  /// limit.
+  uint32_t mergeFanIn{0};
 };
 } // namespace facebook::velox::common
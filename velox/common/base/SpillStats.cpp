@@ -49,6 +49,8 @@ SpillStats::SpillStats(
     uint64_t _spillWrites,
     uint64_t _spillFlushTimeNanos,
     uint64_t _spillWriteTimeNanos,
+    uint64_t _spillEncodingSavedBytes,
+    uint64_t _spillCompressionSavedBytes,
     uint64_t _spillMaxLevelExceededCount,
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
@@ -67,6 +69,8 @@ SpillStats::SpillStats(
       spillWrites(_spillWrites),
       spillFlushTimeNanos(_spillFlushTimeNanos),
       spillWriteTimeNanos(_spillWriteTimeNanos),
+      spillEncodingSavedBytes(_spillEncodingSavedBytes),
+      spillCompressionSavedBytes(_spillCompressionSavedBytes),
       spillMaxLevelExceededCount(_spillMaxLevelExceededCount),
       spillReadBytes(_spillReadBytes),
       spillReads(_spillReads),
@@ -87,6 +91,8 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillWrites += other.spillWrites;
   spillFlushTimeNanos += other.spillFlushTimeNanos;
   spillWriteTimeNanos += other.spillWriteTimeNanos;
+  spillEncodingSavedBytes += other.spillEncodingSavedBytes;
+  spillCompressionSavedBytes += other.spillCompressionSavedBytes;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
   spillReadBytes += other.spillReadBytes;
   spillReads += other.spillReads;
@@ -114,6 +120,10 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWrites = spillWrites - other.spillWrites;
   result.spillFlushTimeNanos = spillFlushTimeNanos - other.spillFlushTimeNanos;
   result.spillWriteTimeNanos = spillWriteTimeNanos - other.spillWriteTimeNanos;
+  result.spillEncodingSavedBytes =
+      spillEncodingSavedBytes - other.spillEncodingSavedBytes;
+  result.spillCompressionSavedBytes =
+      spillCompressionSavedBytes - other.spillCompressionSavedBytes;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
   result.spillReadBytes = spillReadBytes - other.spillReadBytes;
@@ -149,6 +159,8 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillWrites);
   UPDATE_COUNTER(spillFlushTimeNanos);
   UPDATE_COUNTER(spillWriteTimeNanos);
+  UPDATE_COUNTER(spillEncodingSavedBytes);
+  UPDATE_COUNTER(spillCompressionSavedBytes);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
   UPDATE_COUNTER(spillReadBytes);
   UPDATE_COUNTER(spillReads);
@@ -190,6 +202,8 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillWrites,
              spillFlushTimeNanos,
              spillWriteTimeNanos,
+             spillEncodingSavedBytes,
+             spillCompressionSavedBytes,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -209,6 +223,8 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillWrites,
              other.spillFlushTimeNanos,
              other.spillWriteTimeNanos,
+             other.spillEncodingSavedBytes,
+             other.spillCompressionSavedBytes,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -230,6 +246,8 @@ void SpillStats::reset() {
   spillWrites = 0;
   spillFlushTimeNanos = 0;
   spillWriteTimeNanos = 0;
+  spillEncodingSavedBytes = 0;
+  spillCompressionSavedBytes = 0;
   spillMaxLevelExceededCount = 0;
   spillReadBytes = 0;
   spillReads = 0;
@@ -242,7 +260,9 @@ std::string SpillStats::toString() const {
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
       "spilledPartitions[{}] spilledFiles[{}] spillFillTimeNanos[{}] "
       "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
-      "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[{}] "
+      "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] "
+      "spillEncodingSavedBytes[{}] spillCompressionSavedBytes[{}] "
+      "maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
       "spillReadDeserializationTimeNanos[{}]",
       spillRuns,
@@ -258,6 +278,8 @@ std::string SpillStats::toString() const {
       spillWrites,
       succinctNanos(spillFlushTimeNanos),
       succinctNanos(spillWriteTimeNanos),
+      succinctBytes(spillEncodingSavedBytes),
+      succinctBytes(spillCompressionSavedBytes),
       spillMaxLevelExceededCount,
       succinctBytes(spillReadBytes),
       spillReads,
@@ -56,6 +56,12 @@ struct SpillStats {
   uint64_t spillFlushTimeNanos{0};
   /// The time spent on writing spilled rows to disk.
   uint64_t spillWriteTimeNanos{0};
+  /// The number of bytes saved by dictionary and run-length encoding the
+  /// columns of the spilled rows in the columnar spill format.
+  uint64_t spillEncodingSavedBytes{0};
+  /// The number of bytes saved by compressing the spilled rows in the columnar
+  /// spill format.
+  uint64_t spillCompressionSavedBytes{0};
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
@@ -83,6 +89,8 @@ struct SpillStats {
       uint64_t _spillWrites,
       uint64_t _spillFlushTimeNanos,
       uint64_t _spillWriteTimeNanos,
+      uint64_t _spillEncodingSavedBytes,
+      uint64_t _spillCompressionSavedBytes,
       uint64_t _spillMaxLevelExceededCount,
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
@@ -17,6 +17,7 @@
 #include "velox/common/base/AdmissionController.h"
 #include <gtest/gtest.h>
 #include <atomic>
+#include <thread>
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 
@@ -47,6 +48,42 @@ TEST(AdmissionController, basic) {
       "A single request cannot exceed the max limit");
 }
 
+TEST(AdmissionController, priority) {
+  AdmissionController::Config config;
+  config.maxLimit = 10;
+  AdmissionController admissionController(config);
+  admissionController.accept(10);
+
+  std::mutex mutex;
+  std::vector<int> grantOrder;
+  std::vector<std::thread> threads;
+  std::atomic_int numStarted{0};
+  // Queues the requests one by one as 'accept' only returns after grant.
+  const std::vector<int32_t> priorities{1, 0, 1, 0};
+  for (int i = 0; i < priorities.size(); ++i) {
+    threads.push_back(std::thread([&, i]() {
+      ++numStarted;
+      admissionController.accept(10, priorities[i]);
+      {
+        std::lock_guard<std::mutex> l(mutex);
+        grantOrder.push_back(i);
+      }
+      admissionController.release(10);
+    }));
+    while (numStarted <= i) {
+      std::this_thread::yield();
+    }
+    // Waits for the request to be queued.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  admissionController.release(10);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(grantOrder, (std::vector<int>{1, 3, 0, 2}));
+  EXPECT_EQ(admissionController.currentResourceUsage(), 0);
+}
+
 TEST(AdmissionController, multiThreaded) {
   // Ensure that resource usage never exceeds the limit set in the admission
   // controller.
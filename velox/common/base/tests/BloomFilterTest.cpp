@@ -90,3 +90,29 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batchMayContain) {
+  constexpr int32_t kSize = 1000;
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i * 2));
+  }
+  // Half of the values were inserted. The sizes include partial batches and
+  // partial words.
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < 2 * kSize; ++i) {
+    hashes.push_back(folly::hasher<int32_t>()(i));
+  }
+  for (auto size : {0, 1, 3, 64, 67, 2 * kSize}) {
+    std::vector<uint64_t> result(bits::nwords(size), ~0UL);
+    bloom.mayContain(hashes.data(), size, result.data());
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(bits::isBitSet(result.data(), i), bloom.mayContain(hashes[i]))
+          << i;
+      if (i % 2 == 0) {
+        ASSERT_TRUE(bits::isBitSet(result.data(), i));
+      }
+    }
+  }
+}
@@ -572,6 +572,15 @@ TEST_F(SimdUtilTest, basicSimdStrStr) {
   checkOne(mikhailCorpus, mikhailPattern);
 }
 
+TEST_F(SimdUtilTest, singleCharSimdStrStr) {
+  // The text is not null-terminated and the needle follows the searched range.
+  const std::string text = "abcdefxyzx";
+  ASSERT_EQ(simd::simdStrstr(text.data(), 6, "x", 1), std::string::npos);
+  ASSERT_EQ(simd::simdStrstr(text.data(), 7, "x", 1), 6);
+  ASSERT_EQ(simd::simdStrstr(text.data() + 1, 5, "a", 1), std::string::npos);
+  ASSERT_EQ(simd::simdStrstr(text.data(), 6, "a", 1), 0);
+}
+
 TEST_F(SimdUtilTest, variableNeedleSize) {
   std::string s1 = "aabbccddeeffgghhiijjkkllmmnnooppqqrrssttuuvvwwxxyyzz";
   std::string s2 = "aabbccddeeffgghhiijjkkllmmnnooppqqrrssttuuvvwwxxyyzz";
@@ -37,6 +37,8 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spillFillTimeNanos = 1023;
   stats1.spilledRows = 1023;
   stats1.spillSerializationTimeNanos = 1023;
+  stats1.spillEncodingSavedBytes = 512;
+  stats1.spillCompressionSavedBytes = 256;
   stats1.spillMaxLevelExceededCount = 3;
   stats1.spillReadBytes = 1024;
   stats1.spillReads = 10;
@@ -57,6 +59,8 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spillFillTimeNanos = 1030;
   stats2.spilledRows = 1031;
   stats2.spillSerializationTimeNanos = 1032;
+  stats2.spillEncodingSavedBytes = 1024;
+  stats2.spillCompressionSavedBytes = 512;
   stats2.spillMaxLevelExceededCount = 4;
   stats2.spillReadBytes = 2048;
   stats2.spillReads = 10;
@@ -89,6 +93,8 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillFillTimeNanos, 7);
   ASSERT_EQ(delta.spilledRows, 8);
   ASSERT_EQ(delta.spillSerializationTimeNanos, 9);
+  ASSERT_EQ(delta.spillEncodingSavedBytes, 512);
+  ASSERT_EQ(delta.spillCompressionSavedBytes, 256);
   ASSERT_EQ(delta.spillReadBytes, 1024);
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeNanos, 0);
@@ -106,6 +112,8 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillFillTimeNanos, -7);
   ASSERT_EQ(delta.spilledRows, -8);
   ASSERT_EQ(delta.spillSerializationTimeNanos, -9);
+  ASSERT_EQ(delta.spillEncodingSavedBytes, -512);
+  ASSERT_EQ(delta.spillCompressionSavedBytes, -256);
   ASSERT_EQ(delta.spillMaxLevelExceededCount, -1);
   ASSERT_EQ(delta.spillReadBytes, -1024);
   ASSERT_EQ(delta.spillReads, 0);
@@ -129,7 +137,8 @@ TEST(SpillStatsTest, spillStats) {
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
       "spillFillTimeNanos[1.03us] spillSortTimeNanos[1.03us] spillExtractVectorTime[1.03us] "
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] spillFlushTimeNanos[1.03us] "
-      "spillWriteTimeNanos[1.03us] maxSpillExceededLimitCount[4] "
+      "spillWriteTimeNanos[1.03us] spillEncodingSavedBytes[1.00KB] "
+      "spillCompressionSavedBytes[512B] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
   ASSERT_EQ(
@@ -139,6 +148,7 @@ TEST(SpillStatsTest, spillStats) {
       "spillFillTimeNanos[1.03us] spillSortTimeNanos[1.03us] spillExtractVectorTime[1.03us] "
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] "
       "spillFlushTimeNanos[1.03us] spillWriteTimeNanos[1.03us] "
+      "spillEncodingSavedBytes[1.00KB] spillCompressionSavedBytes[512B] "
       "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
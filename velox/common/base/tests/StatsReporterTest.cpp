@@ -19,10 +19,12 @@
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/PeriodicStatsReporter.h"
+#include "velox/common/base/ShardedStatsReporter.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/CacheTTLController.h"
@@ -610,6 +612,51 @@ TEST_F(PeriodicStatsReporterTest, allNullOption) {
   ASSERT_NO_THROW(stopPeriodicStatsReporter());
 }
 
+TEST(ShardedStatsReporterTest, basic) {
+  ShardedStatsReporter reporter;
+  reporter.registerMetricExportType("avg", StatType::AVG);
+  reporter.registerMetricExportType("count", StatType::COUNT);
+  reporter.registerMetricExportType(folly::StringPiece("sum"), StatType::SUM);
+  reporter.registerMetricExportType("rate", StatType::RATE);
+  reporter.registerHistogramMetricExportType(
+      "histogram", 10, 0, 100, {50, 100});
+
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumValues = 1'000;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto value = 0; value < kNumValues; ++value) {
+        reporter.addMetricValue("avg", value);
+        reporter.addMetricValue("count");
+        reporter.addMetricValue(std::string("sum"), 2);
+        reporter.addMetricValue(folly::StringPiece("rate"), 1);
+        reporter.addHistogramMetricValue("histogram", value % 100);
+        reporter.addMetricValue("unregistered", 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto metrics = reporter.fetchMetrics();
+  ASSERT_NE(metrics.find("avg 499\n"), std::string::npos) << metrics;
+  ASSERT_NE(metrics.find("count 8000\n"), std::string::npos) << metrics;
+  ASSERT_NE(metrics.find("sum 16000\n"), std::string::npos) << metrics;
+  ASSERT_NE(metrics.find("histogram.p50 50\n"), std::string::npos) << metrics;
+  ASSERT_NE(metrics.find("histogram.p100 100\n"), std::string::npos)
+      << metrics;
+  ASSERT_NE(metrics.find("rate "), std::string::npos) << metrics;
+  ASSERT_EQ(metrics.find("unregistered"), std::string::npos) << metrics;
+  // The names are ordered.
+  ASSERT_LT(metrics.find("avg"), metrics.find("count"));
+  ASSERT_LT(metrics.find("histogram"), metrics.find("sum"));
+
+  // The rate is over the values added since the previous fetch.
+  ASSERT_NE(reporter.fetchMetrics().find("rate 0\n"), std::string::npos);
+}
+
 // Registering to folly Singleton with intended reporter type
 folly::Singleton<BaseStatsReporter> reporter([]() {
   return new TestReporter();
@@ -16,6 +16,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/SsdFile.h"
 
@@ -70,7 +71,7 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
     hook(*this);
   }
 
-  if (!ssdSavable) {
+  if (!ssdSavable || bypassed_) {
     return;
   }
 
@@ -151,6 +152,26 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+CacheShard::CacheShard(
+    AsyncDataCache* cache,
+    double maxWriteRatio,
+    int32_t minAdmissionFrequency)
+    : cache_(cache),
+      maxWriteRatio_(maxWriteRatio),
+      minAdmissionFrequency_(minAdmissionFrequency) {
+  if (minAdmissionFrequency_ > 0) {
+    admissionSketch_ = std::make_unique<FrequencySketch>(kAdmissionSketchWidth);
+  }
+}
+
+bool CacheShard::admitLocked(RawFileCacheKey key) {
+  if (admissionSketch_ == nullptr) {
+    return true;
+  }
+  return admissionSketch_->add(std::hash<RawFileCacheKey>()(key)) >=
+      minAdmissionFrequency_;
+}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -170,6 +191,8 @@ CachePin CacheShard::findOrCreate(
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    // Hits count as references for admission.
+    const bool admitted = admitLocked(key);
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* foundEntry = it->second;
@@ -230,6 +253,15 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    // A reused entry must not inherit the access stats of its previous key.
+    entryToInit->accessStats_.reset();
+    entryToInit->bypassed_ = !admitted;
+    entryToInit->decompressed_ = false;
+    if (!admitted) {
+      ++numBypass_;
+      bypassBytes_ += size;
+      entryToInit->makeEvictable();
+    }
   }
   return initEntry(key, entryToInit);
 }
@@ -253,6 +285,12 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+int32_t CacheShard::numUses(RawFileCacheKey key) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  return it == entryMap_.end() ? 0 : it->second->numUses();
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -552,6 +590,8 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
+  stats.numBypass += numBypass_;
+  stats.bypassBytes += bypassBytes_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
 }
@@ -643,6 +683,8 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numBypass = numBypass - other.numBypass;
+  result.bypassBytes = bypassBytes - other.bypassBytes;
   if (ssdStats != nullptr) {
     if (other.ssdStats != nullptr) {
       result.ssdStats =
@@ -651,6 +693,14 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
       result.ssdStats = std::make_shared<SsdCacheStats>(*ssdStats);
     }
   }
+  if (peerStats != nullptr) {
+    if (other.peerStats != nullptr) {
+      result.peerStats =
+          std::make_shared<PeerCacheStats>(*peerStats - *other.peerStats);
+    } else {
+      result.peerStats = std::make_shared<PeerCacheStats>(*peerStats);
+    }
+  }
   return result;
 }
 
@@ -668,12 +718,17 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this, opts_.maxWriteRatio, opts_.minAdmissionFrequency));
   }
 }
 
 AsyncDataCache::~AsyncDataCache() = default;
 
+void AsyncDataCache::setPeerCache(std::unique_ptr<PeerCache> peerCache) {
+  peerCache_ = std::move(peerCache);
+}
+
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
@@ -733,6 +788,11 @@ bool AsyncDataCache::exists(RawFileCacheKey key) const {
   return shards_[shard]->exists(key);
 }
 
+int32_t AsyncDataCache::numUses(RawFileCacheKey key) const {
+  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  return shards_[shard]->numUses(key);
+}
+
 bool AsyncDataCache::makeSpace(
     MachinePageCount numPages,
     std::function<bool(memory::Allocation& allocation)> allocate) {
@@ -960,6 +1020,9 @@ CacheStats AsyncDataCache::refreshStats() const {
   if (ssdCache_ != nullptr) {
     stats.ssdStats = std::make_shared<SsdCacheStats>(ssdCache_->stats());
   }
+  if (peerCache_ != nullptr) {
+    stats.peerStats = std::make_shared<PeerCacheStats>(peerCache_->stats());
+  }
   return stats;
 }
 
@@ -1008,14 +1071,21 @@ std::string CacheStats::toString() const {
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " savable eviction: " << numSavableEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
-      << " stales: " << numStales
-      << "\n"
+      << " stales: " << numStales;
+  if (numBypass > 0) {
+    out << " bypass: " << numBypass
+        << " bypass bytes: " << succinctBytes(bypassBytes);
+  }
+  out << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
       << "\n"
       // Cache timing stats.
       << "Alloc Megaclocks " << (allocClocks >> 20);
+  if (peerStats != nullptr) {
+    out << "\n" << peerStats->toString();
+  }
   return out.str();
 }
 
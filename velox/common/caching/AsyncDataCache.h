@@ -29,6 +29,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -44,6 +45,8 @@ namespace facebook::velox::cache {
 
 class AsyncDataCache;
 class CacheShard;
+class PeerCache;
+struct PeerCacheStats;
 class SsdCache;
 struct SsdCacheStats;
 class SsdFile;
@@ -156,6 +159,9 @@ class AsyncDataCacheEntry {
  public:
   static constexpr int32_t kExclusive = -10000;
   static constexpr int32_t kTinyDataSize = 2048;
+  /// The multiplier of the score of entries with decompressed data, so that
+  /// these are evicted before file data that was accessed alike.
+  static constexpr int32_t kDecompressedScoreMultiplier = 4;
 
   explicit AsyncDataCacheEntry(CacheShard* shard);
   ~AsyncDataCacheEntry();
@@ -198,7 +204,18 @@ class AsyncDataCacheEntry {
   }
 
   int32_t score(AccessTime now) const {
-    return accessStats_.score(now, size_);
+    const auto score = accessStats_.score(now, size_);
+    if (decompressed_) {
+      return score > std::numeric_limits<int32_t>::max() /
+                  kDecompressedScoreMultiplier
+          ? std::numeric_limits<int32_t>::max()
+          : score * kDecompressedScoreMultiplier;
+    }
+    return score;
+  }
+
+  int32_t numUses() const {
+    return accessStats_.numUses;
   }
 
   bool isShared() const {
@@ -260,6 +277,16 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  /// Marks 'this' as holding decompressed data made from file data instead
+  /// of file data. Such entries are evicted first, see score().
+  void setDecompressed() {
+    decompressed_ = true;
+  }
+
+  bool isDecompressed() const {
+    return decompressed_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -310,6 +337,14 @@ class AsyncDataCacheEntry {
   // hit.
   bool isPrefetch_{false};
 
+  // True if the admission filter of the shard did not admit 'this'. The entry
+  // serves the readers that pin it while loaded but is first in line for
+  // eviction and is not saved to SSD.
+  bool bypassed_{false};
+
+  // True if the entry holds decompressed data. See setDecompressed().
+  bool decompressed_{false};
+
   // Sets after first use of a prefetched entry. Cleared by
   // getAndClearFirstUseFlag(). Does not require synchronization since used for
   // statistics only.
@@ -541,10 +576,18 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of new entries not admitted for retention by the admission
+  /// filter.
+  int64_t numBypass{0};
+  /// Sum of sizes of entries counted in 'numBypass'.
+  int64_t bypassBytes{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
+  /// Stats of reads from peers if a peer cache is set.
+  std::shared_ptr<PeerCacheStats> peerStats = nullptr;
+
   CacheStats operator-(const CacheStats& other) const;
 
   std::string toString() const;
@@ -556,8 +599,10 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      int32_t minAdmissionFrequency = 0);
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -571,6 +616,10 @@ class CacheShard {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Returns the number of uses of the entry for 'key', 0 if there is none.
+  /// Does not update access time.
+  int32_t numUses(RawFileCacheKey key) const;
+
   AsyncDataCache* cache() const {
     return cache_;
   }
@@ -628,6 +677,8 @@ class CacheShard {
 
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
+  // Counters per row of 'admissionSketch_'.
+  static constexpr int32_t kAdmissionSketchWidth = 1 << 16;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
   void calibrateThreshold();
@@ -646,8 +697,16 @@ class CacheShard {
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
+  // Counts a reference to 'key' and returns true if a new entry for 'key'
+  // should be retained.
+  bool admitLocked(RawFileCacheKey key);
+
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  const int32_t minAdmissionFrequency_;
+
+  // Recent reference counts of keys if there is an admission filter.
+  std::unique_ptr<FrequencySketch> admissionSketch_;
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -684,6 +743,9 @@ class CacheShard {
   uint64_t numAgedOut_{0};
   // Cumulative count of stale entries because of cache request size mismatch.
   uint64_t numStales_{0};
+  // Cumulative count and bytes of new entries not admitted for retention.
+  uint64_t numBypass_{0};
+  uint64_t bypassBytes_{0};
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
@@ -700,10 +762,12 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        int32_t _minAdmissionFrequency = 0)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          minAdmissionFrequency(_minAdmissionFrequency){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -722,6 +786,15 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// If greater than 0, enables a TinyLFU style admission filter. Each
+    /// shard counts the recent references to its keys in a frequency sketch.
+    /// A new entry whose key was referenced fewer than this many times,
+    /// counting the current reference, is loaded for its readers but is
+    /// evicted first and not saved to SSD. This keeps one-off scans from
+    /// pushing out data that is reused. 2 admits data on its second recent
+    /// reference.
+    int32_t minAdmissionFrequency;
   };
 
   AsyncDataCache(
@@ -787,6 +860,10 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Returns the number of uses of the entry for 'key', 0 if there is none.
+  /// Does not update access time.
+  int32_t numUses(RawFileCacheKey key) const;
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
   __attribute__((__no_sanitize__("thread")))
@@ -815,6 +892,14 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Sets the tier that is consulted after a miss in memory and SSD before
+  /// reading from storage. Must be set before the cache is used for reads.
+  void setPeerCache(std::unique_ptr<PeerCache> peerCache);
+
+  PeerCache* peerCache() const {
+    return peerCache_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -893,6 +978,7 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  std::unique_ptr<PeerCache> peerCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+FrequencySketch::FrequencySketch(int32_t width)
+    : widthMask_(bits::nextPowerOfTwo(std::max<int32_t>(width, 16)) - 1),
+      samplePeriod_((widthMask_ + 1) * 10),
+      counters_(kDepth * (widthMask_ + 1), 0) {
+  VELOX_CHECK_GT(width, 0);
+}
+
+uint64_t FrequencySketch::index(uint64_t hash, int32_t row) const {
+  return row * (widthMask_ + 1) + (bits::hashMix(hash, row) & widthMask_);
+}
+
+int32_t FrequencySketch::add(uint64_t hash) {
+  uint64_t indices[kDepth];
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    indices[row] = index(hash, row);
+    count = std::min<int32_t>(count, counters_[indices[row]]);
+  }
+  if (count < kMaxCount) {
+    // Conservative update: Only the counters at the minimum are incremented,
+    // which reduces the overestimation from collisions.
+    for (auto row = 0; row < kDepth; ++row) {
+      if (counters_[indices[row]] == count) {
+        ++counters_[indices[row]];
+      }
+    }
+    ++count;
+  }
+  if (++numSamples_ >= samplePeriod_) {
+    age();
+  }
+  return count;
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    count = std::min<int32_t>(count, counters_[index(hash, row)]);
+  }
+  return count;
+}
+
+void FrequencySketch::age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  numSamples_ /= 2;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate counts of recent occurrences of hashes in a count-min sketch
+/// with small saturating counters, as used by TinyLFU cache admission. The
+/// counts age: after a number of additions proportional to the width, all
+/// counts are halved so that the sketch reflects recent history. Not thread
+/// safe.
+class FrequencySketch {
+ public:
+  /// Max count of a hash.
+  static constexpr int32_t kMaxCount = 15;
+
+  /// 'width' is the number of counters per row, rounded up to a power of two.
+  /// It should be in the order of the number of distinct hashes that are
+  /// expected to be hot at the same time.
+  explicit FrequencySketch(int32_t width);
+
+  /// Records an occurrence of 'hash'. Returns the estimated count of 'hash'
+  /// including this occurrence.
+  int32_t add(uint64_t hash);
+
+  /// Returns the estimated count of 'hash'.
+  int32_t estimate(uint64_t hash) const;
+
+ private:
+  static constexpr int32_t kDepth = 4;
+
+  // Returns the index in 'counters_' of the counter for 'hash' in 'row'.
+  uint64_t index(uint64_t hash, int32_t row) const;
+
+  // Halves all counts.
+  void age();
+
+  const uint64_t widthMask_;
+  // Number of additions after which the counts are halved.
+  const uint64_t samplePeriod_;
+  uint64_t numSamples_{0};
+  // 'kDepth' rows of counters.
+  std::vector<uint8_t> counters_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/PeerCache.h"
+
+#include <folly/hash/SpookyHashV2.h>
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// The hash must be the same on all workers, so it does not use a hash that
+// may be seeded per process.
+uint64_t hashBytes(std::string_view bytes, uint64_t seed) {
+  return folly::hash::SpookyHashV2::Hash64(bytes.data(), bytes.size(), seed);
+}
+} // namespace
+
+PeerCacheStats PeerCacheStats::operator-(const PeerCacheStats& other) const {
+  PeerCacheStats result;
+  result.numHit = numHit - other.numHit;
+  result.hitBytes = hitBytes - other.hitBytes;
+  result.numMiss = numMiss - other.numMiss;
+  result.numError = numError - other.numError;
+  result.readLatencyUs = readLatencyUs - other.readLatencyUs;
+  return result;
+}
+
+std::string PeerCacheStats::toString() const {
+  return fmt::format(
+      "Peer cache hit: {} hit bytes: {} miss: {} error: {} read time: {}",
+      numHit,
+      succinctBytes(hitBytes),
+      numMiss,
+      numError,
+      succinctMicros(readLatencyUs));
+}
+
+PeerCache::PeerCache(
+    std::string self,
+    std::vector<std::string> peers,
+    std::shared_ptr<PeerCacheTransport> transport,
+    int32_t numVirtualNodes)
+    : self_(std::move(self)),
+      transport_(std::move(transport)),
+      numVirtualNodes_(numVirtualNodes) {
+  VELOX_CHECK_NOT_NULL(transport_);
+  VELOX_CHECK_GT(numVirtualNodes_, 0);
+  ring_ = makeRing(std::move(peers));
+}
+
+void PeerCache::setPeers(std::vector<std::string> peers) {
+  auto ring = makeRing(std::move(peers));
+  std::lock_guard<std::mutex> l(mutex_);
+  ring_ = std::move(ring);
+}
+
+std::shared_ptr<const PeerCache::Ring> PeerCache::makeRing(
+    std::vector<std::string> peers) const {
+  auto ring = std::make_shared<Ring>();
+  ring->peers = std::move(peers);
+  ring->points.reserve(ring->peers.size() * numVirtualNodes_);
+  for (auto i = 0; i < ring->peers.size(); ++i) {
+    for (auto node = 0; node < numVirtualNodes_; ++node) {
+      ring->points.emplace_back(hashBytes(ring->peers[i], node), i);
+    }
+  }
+  std::sort(ring->points.begin(), ring->points.end());
+  return ring;
+}
+
+std::optional<std::string> PeerCache::owner(
+    const std::string& fileName,
+    uint64_t offset) const {
+  const auto ring = this->ring();
+  if (ring->points.empty()) {
+    return std::nullopt;
+  }
+  const auto hash = hashBytes(fileName, offset);
+  auto it = std::lower_bound(
+      ring->points.begin(),
+      ring->points.end(),
+      std::make_pair(hash, std::numeric_limits<int32_t>::min()));
+  if (it == ring->points.end()) {
+    it = ring->points.begin();
+  }
+  const auto& peer = ring->peers[it->second];
+  if (peer == self_) {
+    return std::nullopt;
+  }
+  return peer;
+}
+
+bool PeerCache::read(
+    const std::string& fileName,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  const auto peer = owner(fileName, offset);
+  if (!peer.has_value()) {
+    return false;
+  }
+  uint64_t readUs{0};
+  bool hit{false};
+  try {
+    MicrosecondTimer timer(&readUs);
+    hit = transport_->read(*peer, fileName, offset, buffers);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "IOERR: Failed peer cache read of " << fileName << " at "
+                 << offset << " from " << *peer << ": " << e.what();
+    ++numError_;
+    readLatencyUs_ += readUs;
+    return false;
+  }
+  readLatencyUs_ += readUs;
+  if (!hit) {
+    ++numMiss_;
+    return false;
+  }
+  uint64_t bytes = 0;
+  for (const auto& buffer : buffers) {
+    bytes += buffer.size();
+  }
+  ++numHit_;
+  hitBytes_ += bytes;
+  return true;
+}
+
+bool PeerCache::load(AsyncDataCacheEntry& entry) {
+  VELOX_CHECK(entry.isExclusive());
+  std::vector<folly::Range<char*>> buffers;
+  const uint64_t size = entry.size();
+  auto& data = entry.data();
+  if (data.numPages() == 0) {
+    buffers.emplace_back(entry.tinyData(), size);
+  } else {
+    uint64_t offsetInRuns = 0;
+    for (int i = 0; i < data.numRuns() && offsetInRuns < size; ++i) {
+      const auto run = data.runAt(i);
+      const uint64_t bytes = std::min(run.numBytes(), size - offsetInRuns);
+      buffers.emplace_back(run.data<char>(), bytes);
+      offsetInRuns += bytes;
+    }
+  }
+  return read(
+      fileIds().string(entry.key().fileNum.id()), entry.offset(), buffers);
+}
+
+PeerCacheStats PeerCache::stats() const {
+  PeerCacheStats stats;
+  stats.numHit = numHit_;
+  stats.hitBytes = hitBytes_;
+  stats.numMiss = numMiss_;
+  stats.numError = numError_;
+  stats.readLatencyUs = readLatencyUs_;
+  return stats;
+}
+
+} // namespace facebook::velox::cache
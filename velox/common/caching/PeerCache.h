@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+
+namespace facebook::velox::cache {
+
+class AsyncDataCacheEntry;
+
+/// Moves cached file ranges between workers. Implemented by the embedding
+/// engine on top of its own RPC layer. The serving side looks up the range in
+/// its local cache and does not go to storage on a miss.
+class PeerCacheTransport {
+ public:
+  virtual ~PeerCacheTransport() = default;
+
+  /// Reads the cached bytes of 'fileName' starting at 'offset' from 'peer'
+  /// into 'buffers'. The bytes to read are the total size of 'buffers'.
+  /// Returns false if 'peer' does not have the range cached, in which case
+  /// the contents of 'buffers' are unspecified. May throw on transport
+  /// errors.
+  virtual bool read(
+      const std::string& peer,
+      const std::string& fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) = 0;
+};
+
+/// Cumulative stats of reads of cache entries from peers.
+struct PeerCacheStats {
+  /// Number of entries read from peers.
+  uint64_t numHit{0};
+  /// Sum of sizes of entries counted in 'numHit'.
+  uint64_t hitBytes{0};
+  /// Number of entries the owning peer did not have.
+  uint64_t numMiss{0};
+  /// Number of reads that failed with an error in the transport. These are
+  /// not counted in 'numMiss'.
+  uint64_t numError{0};
+  /// Total time spent in reads from peers, including misses and errors.
+  uint64_t readLatencyUs{0};
+
+  PeerCacheStats operator-(const PeerCacheStats& other) const;
+
+  std::string toString() const;
+};
+
+/// Optional tier between AsyncDataCache and SSD cache on one side and the
+/// storage on the other. The ranges of each file are assigned to the workers
+/// of a cluster by consistent hashing. A worker that misses its own caches on
+/// a range owned by another worker reads the range from that worker before
+/// going to storage. Changing the set of peers moves only the ranges of the
+/// peers that were added or removed.
+class PeerCache {
+ public:
+  /// 'self' is the name of this worker and is expected in 'peers'. Ranges it
+  /// owns are not looked up remotely. Each peer is placed on the hash ring
+  /// 'numVirtualNodes' times to even out the load.
+  PeerCache(
+      std::string self,
+      std::vector<std::string> peers,
+      std::shared_ptr<PeerCacheTransport> transport,
+      int32_t numVirtualNodes = kDefaultVirtualNodes);
+
+  /// Replaces the set of peers, e.g. when workers join or leave the cluster.
+  /// Safe to call concurrently with reads.
+  void setPeers(std::vector<std::string> peers);
+
+  /// Returns the peer that owns the range of 'fileName' at 'offset', or
+  /// std::nullopt if this worker owns it or there are no peers.
+  std::optional<std::string> owner(
+      const std::string& fileName,
+      uint64_t offset) const;
+
+  /// Reads the range of 'fileName' at 'offset' into 'buffers' from the peer
+  /// that owns it. Returns false if this worker owns the range, the peer does
+  /// not have it or the read fails. Errors are counted and not thrown so that
+  /// the caller falls back to storage.
+  bool read(
+      const std::string& fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+  /// Reads the data of exclusively pinned 'entry' from the owning peer. Does
+  /// not change the state of 'entry'.
+  bool load(AsyncDataCacheEntry& entry);
+
+  PeerCacheStats stats() const;
+
+  static constexpr int32_t kDefaultVirtualNodes = 64;
+
+ private:
+  // Points on the hash ring in increasing order of hash. A range belongs to
+  // the first point at or after its hash, wrapping around.
+  struct Ring {
+    std::vector<std::string> peers;
+    std::vector<std::pair<uint64_t, int32_t>> points;
+  };
+
+  std::shared_ptr<const Ring> makeRing(std::vector<std::string> peers) const;
+
+  std::shared_ptr<const Ring> ring() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return ring_;
+  }
+
+  const std::string self_;
+  const std::shared_ptr<PeerCacheTransport> transport_;
+  const int32_t numVirtualNodes_;
+
+  mutable std::mutex mutex_;
+  std::shared_ptr<const Ring> ring_;
+
+  std::atomic<uint64_t> numHit_{0};
+  std::atomic<uint64_t> hitBytes_{0};
+  std::atomic<uint64_t> numMiss_{0};
+  std::atomic<uint64_t> numError_{0};
+  std::atomic<uint64_t> readLatencyUs_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -16,7 +16,9 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
@@ -58,6 +60,10 @@ SsdCache::SsdCache(const Config& config)
   const uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   const int32_t fileMaxRegions =
       bits::roundUp(config.maxBytes, sizeQuantum) / sizeQuantum;
+  // The shards recover from their checkpoints in parallel on 'executor_'. A
+  // shard that has not started on the executor is made on this thread.
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> shards;
+  shards.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
     const auto fileConfig = SsdFile::Config(
         fmt::format("{}{}", filePrefix_, i),
@@ -68,8 +74,29 @@ SsdCache::SsdCache(const Config& config)
         config.checksumEnabled,
         checksumReadVerificationEnabled,
         executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+    shards.push_back(std::make_shared<AsyncSource<SsdFile>>(
+        [fileConfig]() { return std::make_unique<SsdFile>(fileConfig); }));
+    executor_->add([shard = shards.back()]() { shard->prepare(); });
   }
+  // All the shards are consumed before rethrowing an error.
+  std::exception_ptr error;
+  for (auto& shard : shards) {
+    try {
+      files_.push_back(shard->move());
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  const auto recovered = stats();
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "SSD cache ready in {} with {} recovered entries",
+      succinctMicros(tsanAtomicValue(recovered.recoveryTimeUs)),
+      tsanAtomicValue(recovered.entriesRecovered));
 }
 
 SsdFile& SsdCache::file(uint64_t fileId) {
@@ -77,6 +104,18 @@ SsdFile& SsdCache::file(uint64_t fileId) {
   return *files_[index];
 }
 
+std::optional<std::pair<int32_t, int32_t>> SsdCache::reserveRegion() {
+  const uint32_t first = nextReserveShard_++;
+  for (auto i = 0; i < numShards_; ++i) {
+    const int32_t shard = (first + i) % numShards_;
+    auto region = files_[shard]->reserveRegion();
+    if (region.has_value()) {
+      return std::make_pair(shard, region.value());
+    }
+  }
+  return std::nullopt;
+}
+
 bool SsdCache::startWrite() {
   std::lock_guard<std::mutex> l(mutex_);
   checkNotShutdownLocked();
@@ -102,6 +102,26 @@ class SsdCache {
   /// e.g. FileCacheKey.
   SsdFile& file(uint64_t fileId);
 
+  /// Returns the shard with index 'shard'.
+  SsdFile& shard(int32_t shard) {
+    return *files_[shard];
+  }
+
+  int32_t numShards() const {
+    return numShards_;
+  }
+
+  /// Reserves a region of one of the shards, see SsdFile::reserveRegion(). The
+  /// shards are tried in turn, starting after the shard of the previous
+  /// reservation. Returns the shard and the region, or std::nullopt if no
+  /// shard has a region to give.
+  std::optional<std::pair<int32_t, int32_t>> reserveRegion();
+
+  /// Returns 'region' of 'shard' from reserveRegion() to the cache.
+  void releaseRegion(int32_t shard, int32_t region) {
+    files_[shard]->releaseRegion(region);
+  }
+
   /// Returns the maximum capacity, rounded up from the capacity passed to the
   /// constructor.
   uint64_t maxBytes() const {
@@ -185,6 +205,8 @@ class SsdCache {
 
   // Count of shards with unfinished writes.
   std::atomic_int32_t writesInProgress_{0};
+  // The shard to try first in the next reserveRegion().
+  std::atomic_int32_t nextReserveShard_{0};
   bool shutdown_{false};
 
   friend class test::SsdCacheTestHelper;
@@ -35,6 +35,7 @@
 #include <numeric>
 
 DECLARE_bool(velox_ssd_odirect);
+DECLARE_bool(velox_io_uring);
 DECLARE_bool(velox_ssd_verify_write);
 
 namespace facebook::velox::cache {
@@ -116,9 +117,11 @@ SsdFile::SsdFile(const Config& config)
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
   process::TraceContext trace("SsdFile::SsdFile");
+  const auto startUs = getCurrentTimeMicro();
   filesystems::FileOptions fileOptions;
   fileOptions.shouldThrowOnFileAlreadyExists = false;
   fileOptions.bufferIo = !FLAGS_velox_ssd_odirect;
+  fileOptions.useIoUring = FLAGS_velox_io_uring;
   writeFile_ = fs_->openFileForWrite(fileName_, fileOptions);
   readFile_ = fs_->openFileForRead(fileName_, fileOptions);
 
@@ -135,6 +138,7 @@ SsdFile::SsdFile(const Config& config)
   regionSizes_.resize(maxRegions_, 0);
   erasedRegionSizes_.resize(maxRegions_, 0);
   regionPins_.resize(maxRegions_, 0);
+  reservedRegions_.resize(maxRegions_, false);
   if (checkpointEnabled()) {
     initializeCheckpoint();
   }
@@ -142,6 +146,7 @@ SsdFile::SsdFile(const Config& config)
   if (disableFileCow_) {
     disableFileCow();
   }
+  stats_.recoveryTimeUs = getCurrentTimeMicro() - startUs;
 }
 
 void SsdFile::pinRegion(uint64_t offset) {
@@ -184,6 +189,9 @@ bool SsdFile::erase(RawFileCacheKey key) {
   if (it == entries_.end()) {
     return false;
   }
+  if (hasUnverifiedRuns_) {
+    unverifiedRuns_.erase(it->second.offset());
+  }
   entries_.erase(it);
   return true;
 }
@@ -322,6 +330,75 @@ bool SsdFile::growOrEvictLocked() {
   return true;
 }
 
+std::optional<int32_t> SsdFile::reserveRegion() {
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  for (;;) {
+    for (auto it = writableRegions_.begin(); it != writableRegions_.end();
+         ++it) {
+      const auto region = *it;
+      if (regionSizes_[region] != 0) {
+        continue;
+      }
+      writableRegions_.erase(it);
+      ++regionPins_[region];
+      reservedRegions_[region] = true;
+      ++numReservedRegions_;
+      return region;
+    }
+    // The partially written regions are left as filled, so that new entries
+    // go to the regions made writable below.
+    for (const auto region : writableRegions_) {
+      tracker_.regionFilled(region);
+    }
+    writableRegions_.clear();
+    if (!growOrEvictLocked()) {
+      return std::nullopt;
+    }
+  }
+}
+
+void SsdFile::releaseRegion(int32_t region) {
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  VELOX_CHECK(reservedRegions_[region], "Region {} is not reserved", region);
+  reservedRegions_[region] = false;
+  --numReservedRegions_;
+  --regionPins_[region];
+  VELOX_CHECK_GE(regionPins_[region], 0);
+  regionSizes_[region] = 0;
+  erasedRegionSizes_[region] = 0;
+  tracker_.regionCleared(region);
+  writableRegions_.push_back(region);
+  suspended_ = false;
+}
+
+void SsdFile::writeReserved(
+    int32_t region,
+    uint64_t offset,
+    const std::vector<iovec>& iovecs,
+    int64_t length) {
+  VELOX_CHECK_LE(offset + length, kRegionSize);
+  {
+    tsan_lock_guard<std::shared_mutex> l(mutex_);
+    VELOX_CHECK(reservedRegions_[region], "Region {} is not reserved", region);
+  }
+  VELOX_CHECK(
+      write(region * kRegionSize + offset, length, iovecs),
+      "Failed to write reserved region {} of {}",
+      region,
+      fileName_);
+}
+
+void SsdFile::readReserved(
+    int32_t region,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  {
+    tsan_lock_guard<std::shared_mutex> l(mutex_);
+    VELOX_CHECK(reservedRegions_[region], "Region {} is not reserved", region);
+  }
+  read(region * kRegionSize + offset, buffers);
+}
+
 void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
   std::unordered_set<int32_t> regionSet{regions.begin(), regions.end()};
   // Remove all 'entries_' where the dependent points one of 'regionIndices'.
@@ -329,6 +406,9 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
   while (it != entries_.end()) {
     const auto region = regionIndex(it->second.offset());
     if (regionSet.count(region) != 0) {
+      if (hasUnverifiedRuns_) {
+        unverifiedRuns_.erase(it->second.offset());
+      }
       it = entries_.erase(it);
     } else {
       ++it;
@@ -502,6 +582,9 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.entriesRead += stats_.entriesRead;
   stats.bytesRead += stats_.bytesRead;
   stats.checkpointsRead += stats_.checkpointsRead;
+  stats.entriesRecovered += stats_.entriesRecovered;
+  stats.recoveryTimeUs = std::max<uint64_t>(
+      stats.recoveryTimeUs, tsanAtomicValue(stats_.recoveryTimeUs));
   stats.entriesCached += entries_.size();
   stats.regionsCached += numRegions_;
   for (auto i = 0; i < numRegions_; i++) {
@@ -513,6 +596,9 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   for (auto pins : regionPins_) {
     stats.numPins += pins;
   }
+  // The pins of the reserved regions are not pins of entries.
+  stats.numPins -= numReservedRegions_;
+  stats.regionsReserved += numReservedRegions_;
 
   stats.openFileErrors += stats_.openFileErrors;
   stats.openCheckpointErrors += stats_.openCheckpointErrors;
@@ -530,10 +616,16 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
+  unverifiedRuns_.clear();
+  hasUnverifiedRuns_ = false;
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
-  writableRegions_.resize(numRegions_);
-  std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
+  writableRegions_.clear();
+  for (auto region = 0; region < numRegions_; ++region) {
+    if (!reservedRegions_[region]) {
+      writableRegions_.push_back(region);
+    }
+  }
   tracker_.clear();
 }
 
@@ -573,6 +665,9 @@ bool SsdFile::removeFileEntries(
 
     ++entriesAgedOut;
     erasedRegionSizes_[region] += ssdRun.size();
+    if (hasUnverifiedRuns_) {
+      unverifiedRuns_.erase(ssdRun.offset());
+    }
 
     it = entries_.erase(it);
   }
@@ -867,6 +962,8 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      unverifiedRuns_.clear();
+      hasUnverifiedRuns_ = false;
       deleteCheckpoint(true);
     } catch (const std::exception&) {
     }
@@ -894,7 +991,8 @@ uint32_t SsdFile::checksumEntry(const AsyncDataCacheEntry& entry) const {
 void SsdFile::maybeVerifyChecksum(
     const AsyncDataCacheEntry& entry,
     const SsdRun& ssdRun) {
-  if (!checksumReadVerificationEnabled_) {
+  if (!checksumReadVerificationEnabled_ &&
+      !takeUnverifiedRun(ssdRun.offset())) {
     return;
   }
   VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
@@ -919,6 +1017,20 @@ void SsdFile::maybeVerifyChecksum(
   }
 }
 
+bool SsdFile::takeUnverifiedRun(uint64_t offset) {
+  if (!hasUnverifiedRuns_) {
+    return false;
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  if (unverifiedRuns_.erase(offset) == 0) {
+    return false;
+  }
+  if (unverifiedRuns_.empty()) {
+    hasUnverifiedRuns_ = false;
+  }
+  return true;
+}
+
 void SsdFile::disableFileCow() {
 #ifdef linux
   const std::unordered_map<std::string, std::string> attributes = {
@@ -948,6 +1060,15 @@ std::string readString(common::FileInputStream* stream, int32_t length) {
   return data;
 }
 
+// Returns field 'index' of a checkpoint entry record. The fields are 8 bytes,
+// except for the trailing 4 byte checksum.
+template <typename T>
+T loadRecordField(const char* record, int32_t index) {
+  T data;
+  std::memcpy(&data, record + index * sizeof(uint64_t), sizeof(T));
+  return data;
+}
+
 template <typename T>
 std::vector<T> readVector(common::FileInputStream* stream, int32_t size) {
   std::vector<T> dataVector(size);
@@ -1022,33 +1143,62 @@ void SsdFile::readCheckpoint() {
     evictedMap.insert(region);
   }
 
+  // The entries are fixed size records followed by the end marker. They are
+  // read in batches of records instead of field by field since they are most
+  // of the checkpoint.
+  const int32_t entrySize =
+      3 * sizeof(uint64_t) + (checkpoinHasChecksum ? sizeof(uint32_t) : 0);
+  entries_.reserve(stream->remainingSize() / entrySize);
+  // Entries with checksums are verified on first read unless all reads are.
+  const bool verifyOnFirstRead =
+      checkpoinHasChecksum && !checksumReadVerificationEnabled_;
   std::vector<uint32_t> regionCacheSizes(numRegions_, 0);
-  for (;;) {
-    const auto fileNum = readNumber<uint64_t>(stream.get());
-    if (fileNum == kCheckpointEndMarker) {
+  std::vector<char> records;
+  bool atEnd = false;
+  while (!atEnd) {
+    const auto numRecords = std::min<uint64_t>(
+        stream->remainingSize() / entrySize, kCheckpointEntriesPerRead);
+    if (numRecords == 0) {
+      VELOX_CHECK_EQ(
+          readNumber<uint64_t>(stream.get()),
+          kCheckpointEndMarker,
+          "Missing end marker in checkpoint");
       break;
     }
-    const auto offset = readNumber<uint64_t>(stream.get());
-    const auto fileBits = readNumber<uint64_t>(stream.get());
-    uint32_t checksum = 0;
-    if (checkpoinHasChecksum) {
-      checksum = readNumber<uint32_t>(stream.get());
-    }
-    const auto run = SsdRun(fileBits, checksum);
-    const auto region = regionIndex(run.offset());
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(region) != evictedMap.end()) {
-      continue;
+    records.resize(numRecords * entrySize);
+    stream->readBytes(
+        reinterpret_cast<uint8_t*>(records.data()), records.size());
+    for (auto i = 0; i < numRecords; ++i) {
+      const char* record = records.data() + i * entrySize;
+      const auto fileNum = loadRecordField<uint64_t>(record, 0);
+      if (fileNum == kCheckpointEndMarker) {
+        atEnd = true;
+        break;
+      }
+      const auto offset = loadRecordField<uint64_t>(record, 1);
+      const auto fileBits = loadRecordField<uint64_t>(record, 2);
+      const uint32_t checksum =
+          checkpoinHasChecksum ? loadRecordField<uint32_t>(record, 3) : 0;
+      const auto run = SsdRun(fileBits, checksum);
+      const auto region = regionIndex(run.offset());
+      // Check that the recovered entry does not fall in an evicted region.
+      if (evictedMap.find(region) != evictedMap.end()) {
+        continue;
+      }
+      // The file may have a different id on restore.
+      const auto it = idMap.find(fileNum);
+      VELOX_CHECK(it != idMap.end());
+      FileCacheKey key{it->second, offset};
+      entries_[std::move(key)] = run;
+      if (verifyOnFirstRead) {
+        unverifiedRuns_.insert(run.offset());
+      }
+      regionCacheSizes[region] += run.size();
+      regionSizes_[region] = std::max<uint32_t>(
+          regionSizes_[region], regionOffset(run.offset()) + run.size());
     }
-    // The file may have a different id on restore.
-    const auto it = idMap.find(fileNum);
-    VELOX_CHECK(it != idMap.end());
-    FileCacheKey key{it->second, offset};
-    entries_[std::move(key)] = run;
-    regionCacheSizes[region] += run.size();
-    regionSizes_[region] = std::max<uint32_t>(
-        regionSizes_[region], regionOffset(run.offset()) + run.size());
   }
+  hasUnverifiedRuns_ = !unverifiedRuns_.empty();
 
   // NOTE: we might erase entries from a region for TTL eviction, so we need to
   // set the region size to the max offset of the recovered cache entry from the
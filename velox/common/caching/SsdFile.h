@@ -157,6 +157,8 @@ struct SsdCacheStats {
     regionsAgedOut = tsanAtomicValue(other.regionsAgedOut);
     regionsEvicted = tsanAtomicValue(other.regionsEvicted);
     numPins = tsanAtomicValue(other.numPins);
+    regionsReserved = tsanAtomicValue(other.regionsReserved);
+    recoveryTimeUs = tsanAtomicValue(other.recoveryTimeUs);
 
     openFileErrors = tsanAtomicValue(other.openFileErrors);
     openCheckpointErrors = tsanAtomicValue(other.openCheckpointErrors);
@@ -175,6 +177,7 @@ struct SsdCacheStats {
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
     SsdCacheStats result;
+    result.recoveryTimeUs = recoveryTimeUs;
     result.entriesWritten = entriesWritten - other.entriesWritten;
     result.bytesWritten = bytesWritten - other.bytesWritten;
     result.checkpointsWritten = checkpointsWritten - other.checkpointsWritten;
@@ -214,6 +217,12 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> regionsCached{0};
   tsan_atomic<uint64_t> bytesCached{0};
   tsan_atomic<int32_t> numPins{0};
+  /// Regions that are lent out by reserveRegion(), e.g. for spilling.
+  tsan_atomic<uint64_t> regionsReserved{0};
+  /// Time from opening the cache files to being ready to serve reads,
+  /// including the recovery from checkpoint. The shards of a cache recover in
+  /// parallel, so for a cache this is the time of the slowest shard.
+  tsan_atomic<uint64_t> recoveryTimeUs{0};
 
   /// Cumulative stats
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -338,6 +347,32 @@ class SsdFile {
     return shardId_;
   }
 
+  /// Takes a whole region out of the cache for a user like spilling, so that
+  /// the file space is shared between caching and the user. Prefers a region
+  /// that holds no entries, then grows the file or evicts the coldest regions
+  /// like a write to the cache does. The region is not evicted or written by
+  /// the cache until releaseRegion(). Returns std::nullopt if all regions are
+  /// pinned or reserved.
+  std::optional<int32_t> reserveRegion();
+
+  /// Returns 'region' from reserveRegion() to the cache as an empty writable
+  /// region.
+  void releaseRegion(int32_t region);
+
+  /// Writes 'length' bytes from 'iovecs' at 'offset' in the reserved
+  /// 'region'. Throws if the write fails.
+  void writeReserved(
+      int32_t region,
+      uint64_t offset,
+      const std::vector<iovec>& iovecs,
+      int64_t length);
+
+  /// Reads from 'offset' in the reserved 'region' into 'buffers'.
+  void readReserved(
+      int32_t region,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
@@ -386,6 +421,10 @@ class SsdFile {
   // Magic number at end of completed checkpoint file.
   static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
 
+  // Number of checkpoint entries read from the checkpoint file at a time on
+  // recovery.
+  static constexpr int32_t kCheckpointEntriesPerRead = 64 << 10;
+
   static constexpr int kMaxErasedSizePct = 50;
 
   // Updates the read count of a region.
@@ -437,6 +476,10 @@ class SsdFile {
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Returns true if the entry at 'offset' is recovered from checkpoint and has
+  // not been read since. Such an entry is verified on its first read.
+  bool takeUnverifiedRun(uint64_t offset);
+
   // Reads a checkpoint file and sets 'this' accordingly if read succeeds. A
   // failed read deletes the checkpoint and leaves the truncated log open.
   void readCheckpoint();
@@ -575,9 +618,22 @@ class SsdFile {
   // Pin count for each region.
   std::vector<int32_t> regionPins_;
 
+  // True for the regions taken by reserveRegion(). These have a pin each, so
+  // that they are not evicted.
+  std::vector<bool> reservedRegions_;
+  int32_t numReservedRegions_{0};
+
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
+  // Offsets of the entries recovered from a checkpoint with checksums that
+  // have not been read yet. A crash may have left the data of an entry torn
+  // or overwritten after the checkpoint, so these are verified on first read
+  // even if 'checksumReadVerificationEnabled_' is false. This defers the cost
+  // of validation from the restart to the reads.
+  folly::F14FastSet<uint64_t> unverifiedRuns_;
+  std::atomic<bool> hasUnverifiedRuns_{false};
+
   // File system.
   std::shared_ptr<filesystems::FileSystem> fs_;
 
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdSpillFileSystem.h"
+
+#include <folly/synchronization/CallOnce.h>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+struct SsdSpillFileSystem::File {
+  File(SsdCache* _cache, std::string _path)
+      : cache(_cache), path(std::move(_path)) {}
+
+  ~File() {
+    for (const auto& [shard, region] : regions) {
+      cache->releaseRegion(shard, region);
+    }
+  }
+
+  SsdCache* const cache;
+  const std::string path;
+  // The shard and region of each kRegionSize bytes of the file.
+  std::vector<std::pair<int32_t, int32_t>> regions;
+  // The size without the padding to kAlignment. Set on close.
+  uint64_t size{0};
+  bool closed{false};
+};
+
+namespace {
+using File = SsdSpillFileSystem::File;
+
+std::unique_ptr<char, decltype(&std::free)> allocateAligned(uint64_t size) {
+  auto* data = reinterpret_cast<char*>(
+      ::aligned_alloc(SsdSpillFileSystem::kAlignment, size));
+  VELOX_CHECK_NOT_NULL(data, "Failed to allocate {} bytes", size);
+  return {data, &std::free};
+}
+
+// Buffers the appended bytes and writes them to the regions of the file
+// kWriteBufferSize bytes at a time. A region is a multiple of the buffer size,
+// so a write never spans regions.
+class SsdSpillWriteFile : public WriteFile {
+ public:
+  explicit SsdSpillWriteFile(std::shared_ptr<File> file)
+      : file_(std::move(file)),
+        buffer_(allocateAligned(SsdSpillFileSystem::kWriteBufferSize)) {}
+
+  void append(std::string_view data) override {
+    VELOX_CHECK(!file_->closed, "Append to closed file {}", file_->path);
+    while (!data.empty()) {
+      const auto bytes = std::min<uint64_t>(
+          data.size(), SsdSpillFileSystem::kWriteBufferSize - bufferSize_);
+      ::memcpy(buffer_.get() + bufferSize_, data.data(), bytes);
+      bufferSize_ += bytes;
+      size_ += bytes;
+      data.remove_prefix(bytes);
+      if (bufferSize_ == SsdSpillFileSystem::kWriteBufferSize) {
+        writeBuffer();
+      }
+    }
+  }
+
+  void append(std::unique_ptr<folly::IOBuf> data) override {
+    for (auto range : *data) {
+      append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+    }
+  }
+
+  // The data is readable after close().
+  void flush() override {}
+
+  void close() override {
+    if (file_->closed) {
+      return;
+    }
+    writeBuffer();
+    file_->size = size_;
+    file_->closed = true;
+  }
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+  const std::string getName() const override {
+    return file_->path;
+  }
+
+ private:
+  void writeBuffer() {
+    if (bufferSize_ == 0) {
+      return;
+    }
+    const auto offset = writtenBytes_ % SsdFile::kRegionSize;
+    if (offset == 0) {
+      auto region = file_->cache->reserveRegion();
+      VELOX_CHECK(
+          region.has_value(),
+          "No space in SSD cache {} for spill file {}",
+          file_->cache->filePrefix(),
+          file_->path);
+      file_->regions.push_back(region.value());
+    }
+    const auto [shard, region] = file_->regions.back();
+    const auto length =
+        bits::roundUp(bufferSize_, SsdSpillFileSystem::kAlignment);
+    ::memset(buffer_.get() + bufferSize_, 0, length - bufferSize_);
+    std::vector<iovec> iovecs{{buffer_.get(), length}};
+    file_->cache->shard(shard).writeReserved(region, offset, iovecs, length);
+    writtenBytes_ += length;
+    bufferSize_ = 0;
+  }
+
+  const std::shared_ptr<File> file_;
+  const std::unique_ptr<char, decltype(&std::free)> buffer_;
+  uint64_t bufferSize_{0};
+  // Bytes written to the regions, including the padding of the last write.
+  uint64_t writtenBytes_{0};
+  uint64_t size_{0};
+};
+
+class SsdSpillReadFile : public ReadFile {
+ public:
+  explicit SsdSpillReadFile(std::shared_ptr<File> file)
+      : file_(std::move(file)) {}
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* /*stats*/ = nullptr) const override {
+    VELOX_CHECK_LE(
+        offset + length, file_->size, "Read past end of {}", file_->path);
+    auto* output = reinterpret_cast<char*>(buf);
+    uint64_t numRead = 0;
+    while (numRead < length) {
+      const auto position = offset + numRead;
+      const auto offsetInRegion = position % SsdFile::kRegionSize;
+      const auto bytes = std::min<uint64_t>(
+          length - numRead, SsdFile::kRegionSize - offsetInRegion);
+      // The writes were padded, so the aligned range was written.
+      const auto begin = offsetInRegion / SsdSpillFileSystem::kAlignment *
+          SsdSpillFileSystem::kAlignment;
+      const auto end = bits::roundUp(
+          offsetInRegion + bytes, SsdSpillFileSystem::kAlignment);
+      auto buffer = allocateAligned(end - begin);
+      const auto [shard, region] =
+          file_->regions[position / SsdFile::kRegionSize];
+      file_->cache->shard(shard).readReserved(
+          region, begin, {folly::Range<char*>(buffer.get(), end - begin)});
+      ::memcpy(
+          output + numRead, buffer.get() + offsetInRegion - begin, bytes);
+      numRead += bytes;
+    }
+    bytesRead_ += length;
+    return {output, length};
+  }
+
+  bool shouldCoalesce() const override {
+    return false;
+  }
+
+  uint64_t size() const override {
+    return file_->size;
+  }
+
+  uint64_t memoryUsage() const override {
+    return 0;
+  }
+
+  std::string getName() const override {
+    return file_->path;
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return SsdSpillFileSystem::kWriteBufferSize;
+  }
+
+ private:
+  const std::shared_ptr<File> file_;
+};
+
+bool isUnder(const std::string& path, std::string_view directory) {
+  return path.size() > directory.size() &&
+      path.compare(0, directory.size(), directory) == 0 &&
+      (directory.back() == '/' || path[directory.size()] == '/');
+}
+} // namespace
+
+SsdSpillFileSystem::SsdSpillFileSystem(SsdCache* cache)
+    : FileSystem(nullptr), cache_(cache) {
+  VELOX_CHECK_NOT_NULL(cache_);
+}
+
+std::unique_ptr<ReadFile> SsdSpillFileSystem::openFileForRead(
+    std::string_view path,
+    const filesystems::FileOptions& /*options*/) {
+  auto file = files_.withRLock([&](const auto& files) {
+    auto it = files.find(std::string(path));
+    VELOX_CHECK(it != files.end(), "No SSD spill file {}", path);
+    return it->second;
+  });
+  VELOX_CHECK(file->closed, "SSD spill file {} is being written", path);
+  return std::make_unique<SsdSpillReadFile>(std::move(file));
+}
+
+std::unique_ptr<WriteFile> SsdSpillFileSystem::openFileForWrite(
+    std::string_view path,
+    const filesystems::FileOptions& /*options*/) {
+  auto file = std::make_shared<File>(cache_, std::string(path));
+  std::shared_ptr<File> replaced;
+  files_.withWLock([&](auto& files) {
+    auto& entry = files[std::string(path)];
+    replaced = std::move(entry);
+    entry = file;
+  });
+  return std::make_unique<SsdSpillWriteFile>(std::move(file));
+}
+
+void SsdSpillFileSystem::remove(std::string_view path) {
+  // The regions are released outside of the lock.
+  std::shared_ptr<File> removed;
+  files_.withWLock([&](auto& files) {
+    auto it = files.find(std::string(path));
+    VELOX_CHECK(it != files.end(), "No SSD spill file {}", path);
+    removed = std::move(it->second);
+    files.erase(it);
+  });
+}
+
+void SsdSpillFileSystem::rename(
+    std::string_view oldPath,
+    std::string_view newPath,
+    bool overwrite) {
+  std::shared_ptr<File> replaced;
+  files_.withWLock([&](auto& files) {
+    auto it = files.find(std::string(oldPath));
+    VELOX_CHECK(it != files.end(), "No SSD spill file {}", oldPath);
+    VELOX_USER_CHECK(
+        overwrite || files.count(std::string(newPath)) == 0,
+        "Failed to rename {} to {}: the file exists",
+        oldPath,
+        newPath);
+    auto file = std::move(it->second);
+    files.erase(it);
+    auto& entry = files[std::string(newPath)];
+    replaced = std::move(entry);
+    entry = std::move(file);
+  });
+}
+
+bool SsdSpillFileSystem::exists(std::string_view path) {
+  return files_.withRLock([&](const auto& files) {
+    if (files.count(std::string(path)) != 0) {
+      return true;
+    }
+    for (const auto& [filePath, _] : files) {
+      if (isUnder(filePath, path)) {
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
+bool SsdSpillFileSystem::isDirectory(std::string_view path) const {
+  return files_.rlock()->count(std::string(path)) == 0;
+}
+
+std::vector<std::string> SsdSpillFileSystem::list(std::string_view path) {
+  std::vector<std::string> paths;
+  files_.withRLock([&](const auto& files) {
+    for (const auto& [filePath, _] : files) {
+      if (isUnder(filePath, path)) {
+        paths.push_back(filePath);
+      }
+    }
+  });
+  return paths;
+}
+
+void SsdSpillFileSystem::rmdir(std::string_view path) {
+  std::vector<std::shared_ptr<File>> removed;
+  files_.withWLock([&](auto& files) {
+    for (auto it = files.begin(); it != files.end();) {
+      if (isUnder(it->first, path)) {
+        removed.push_back(std::move(it->second));
+        it = files.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  });
+}
+
+namespace {
+folly::once_flag ssdSpillFileSystemInitOnceFlag;
+
+folly::Synchronized<std::shared_ptr<SsdSpillFileSystem>>&
+registeredSsdSpillFileSystem() {
+  static folly::Synchronized<std::shared_ptr<SsdSpillFileSystem>> fileSystem;
+  return fileSystem;
+}
+} // namespace
+
+void registerSsdSpillFileSystem(SsdCache* cache) {
+  *registeredSsdSpillFileSystem().wlock() =
+      std::make_shared<SsdSpillFileSystem>(cache);
+  folly::call_once(ssdSpillFileSystemInitOnceFlag, []() {
+    filesystems::registerFileSystem(
+        [](std::string_view path) {
+          return path.find(SsdSpillFileSystem::scheme()) == 0;
+        },
+        [](std::shared_ptr<const config::ConfigBase> /*config*/,
+           std::string_view /*path*/) {
+          std::shared_ptr<filesystems::FileSystem> fileSystem =
+              *registeredSsdSpillFileSystem().rlock();
+          VELOX_CHECK_NOT_NULL(fileSystem);
+          return fileSystem;
+        });
+  });
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+
+namespace facebook::velox::cache {
+
+/// File system that keeps its files in regions reserved from the shards of an
+/// SsdCache, so that spilling and caching share the space of one SSD. Spilling
+/// uses it with a spill directory under scheme(), e.g. 'ssdspill:/spill'. A
+/// file takes regions as it grows, which may evict the coldest cache regions.
+/// The regions go back to the cache when the file is removed, e.g. after its
+/// spilled data is restored. The files do not survive a restart.
+///
+/// A file is written once by one writer and can then be read by any number of
+/// readers. The IO is aligned to kAlignment so that the cache files can be
+/// opened with O_DIRECT.
+class SsdSpillFileSystem : public filesystems::FileSystem {
+ public:
+  static constexpr uint64_t kAlignment = 4096;
+  static constexpr uint64_t kWriteBufferSize = 1 << 20;
+
+  explicit SsdSpillFileSystem(SsdCache* cache);
+
+  static inline std::string scheme() {
+    return "ssdspill:";
+  }
+
+  std::string name() const override {
+    return "SsdSpill FS";
+  }
+
+  std::unique_ptr<ReadFile> openFileForRead(
+      std::string_view path,
+      const filesystems::FileOptions& options = {}) override;
+
+  std::unique_ptr<WriteFile> openFileForWrite(
+      std::string_view path,
+      const filesystems::FileOptions& options = {}) override;
+
+  void remove(std::string_view path) override;
+
+  void rename(
+      std::string_view oldPath,
+      std::string_view newPath,
+      bool overwrite = false) override;
+
+  bool exists(std::string_view path) override;
+
+  bool isDirectory(std::string_view path) const override;
+
+  std::vector<std::string> list(std::string_view path) override;
+
+  /// Directories exist as the prefixes of file paths, so this does nothing.
+  void mkdir(
+      std::string_view /*path*/,
+      const filesystems::DirectoryOptions& /*options*/ = {}) override {}
+
+  /// Removes the files under 'path'.
+  void rmdir(std::string_view path) override;
+
+  struct File;
+
+ private:
+  SsdCache* const cache_;
+  folly::Synchronized<folly::F14FastMap<std::string, std::shared_ptr<File>>>
+      files_;
+};
+
+/// Registers an SsdSpillFileSystem over 'cache' for the paths that start with
+/// SsdSpillFileSystem::scheme(). 'cache' must outlive the use of the files.
+/// A later call replaces the file system, e.g. for a new cache.
+void registerSsdSpillFileSystem(SsdCache* cache);
+
+} // namespace facebook::velox::cache
@@ -1442,6 +1442,48 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, admissionFilter) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr uint64_t kSsdBytes = 128UL << 20;
+  constexpr int kDataSize = 4096;
+  // Admits an entry on the second recent reference to its key.
+  initializeCache(kRamBytes, kSsdBytes, 0, true, {0.7, 0.125, 1 << 24, 2});
+  const auto entryHelper = [](const CachePin& pin) {
+    return test::AsyncDataCacheEntryTestHelper(pin.checkedEntry());
+  };
+
+  // The first reference loads the data but the entry is not retained.
+  auto pin = newEntry(0, kDataSize);
+  ASSERT_EQ(entryHelper(pin).accessStats().lastUse, 0);
+  pin.entry()->setExclusiveToShared();
+  ASSERT_FALSE(pin.entry()->ssdSaveable());
+  pin.clear();
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numBypass, 1);
+  ASSERT_EQ(stats.bypassBytes, kDataSize);
+  ASSERT_NE(stats.toString().find("bypass: 1"), std::string::npos);
+
+  // A new entry on a second reference is admitted.
+  pin = newEntry(kDataSize, kDataSize);
+  // Dropping the exclusive pin removes the entry.
+  pin.clear();
+  pin = newEntry(kDataSize, kDataSize);
+  ASSERT_NE(entryHelper(pin).accessStats().lastUse, 0);
+  pin.entry()->setExclusiveToShared();
+  ASSERT_EQ(pin.entry()->ssdSaveable(), cache_->ssdCache() != nullptr);
+  pin.clear();
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numNew, 3);
+  ASSERT_EQ(stats.numBypass, 2);
+  ASSERT_EQ(stats.bypassBytes, 2 * kDataSize);
+
+  // Without a filter all entries are admitted.
+  initializeCache(kRamBytes, kSsdBytes, 0, true);
+  pin = newEntry(0, kDataSize);
+  pin.clear();
+  ASSERT_EQ(cache_->refreshStats().numBypass, 0);
+}
+
 TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::cache {
+namespace {
+
+TEST(FrequencySketchTest, counts) {
+  FrequencySketch sketch(1'024);
+  EXPECT_EQ(sketch.estimate(1), 0);
+  for (auto i = 1; i <= FrequencySketch::kMaxCount + 5; ++i) {
+    EXPECT_EQ(sketch.add(1), std::min(i, FrequencySketch::kMaxCount));
+  }
+  EXPECT_EQ(sketch.estimate(1), FrequencySketch::kMaxCount);
+
+  // Hashes seen once are mostly estimated at 1 in a sketch that is not full.
+  int32_t numOverestimated = 0;
+  for (uint64_t hash = 100; hash < 300; ++hash) {
+    EXPECT_GE(sketch.add(hash), 1);
+    numOverestimated += sketch.estimate(hash) > 1;
+  }
+  EXPECT_LT(numOverestimated, 10);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(16);
+  for (auto i = 0; i < 8; ++i) {
+    sketch.add(1);
+  }
+  EXPECT_EQ(sketch.estimate(1), 8);
+
+  // After the sample period of 10 times the width, the counts are halved.
+  // Hashes that are not seen again are forgotten.
+  for (uint64_t hash = 1'000; hash < 1'000 + 160 - 8; ++hash) {
+    sketch.add(hash);
+  }
+  EXPECT_GE(sketch.estimate(1), 4);
+  EXPECT_LT(sketch.estimate(1), 8);
+}
+
+} // namespace
+} // namespace facebook::velox::cache
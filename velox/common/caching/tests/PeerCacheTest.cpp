@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/PeerCache.h"
+
+#include <map>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+
+namespace facebook::velox::cache {
+namespace {
+
+// Serves the files in 'files_' with byte i of a file being (i % 251). Throws
+// for peers in 'failing_'.
+class FakeTransport : public PeerCacheTransport {
+ public:
+  bool read(
+      const std::string& peer,
+      const std::string& fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) override {
+    requests_.push_back(peer);
+    if (failing_.count(peer) > 0) {
+      VELOX_FAIL("Peer {} is down", peer);
+    }
+    if (files_.count(fileName) == 0) {
+      return false;
+    }
+    for (const auto& buffer : buffers) {
+      for (auto i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<char>((offset++) % 251);
+      }
+    }
+    return true;
+  }
+
+  std::set<std::string> files_;
+  std::set<std::string> failing_;
+  std::vector<std::string> requests_;
+};
+
+class PeerCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    transport_ = std::make_shared<FakeTransport>();
+    peerCache_ = std::make_unique<PeerCache>(
+        "self", std::vector<std::string>{"self", "w1", "w2"}, transport_);
+  }
+
+  // Returns the owner of each of 'numRanges' ranges of 'fileName', with "self"
+  // for the ranges this worker owns.
+  std::vector<std::string> owners(
+      const std::string& fileName,
+      int32_t numRanges) {
+    std::vector<std::string> result;
+    for (auto i = 0; i < numRanges; ++i) {
+      result.push_back(
+          peerCache_->owner(fileName, offset(i)).value_or("self"));
+    }
+    return result;
+  }
+
+  static uint64_t offset(int32_t range) {
+    return static_cast<uint64_t>(range) << 23;
+  }
+
+  std::shared_ptr<FakeTransport> transport_;
+  std::unique_ptr<PeerCache> peerCache_;
+};
+
+TEST_F(PeerCacheTest, owner) {
+  const auto result = owners("file", 3'000);
+  std::map<std::string, int32_t> counts;
+  for (const auto& owner : result) {
+    ++counts[owner];
+  }
+  ASSERT_EQ(counts.size(), 3);
+  for (const auto& [peer, count] : counts) {
+    EXPECT_GT(count, 700) << peer;
+  }
+
+  // The owner of a range is the same in every PeerCache with the same peers.
+  PeerCache other(
+      "w1", std::vector<std::string>{"self", "w2", "w1"}, transport_);
+  for (auto i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(other.owner("file", offset(i)).value_or("w1"), result[i]);
+  }
+
+  // Removing a peer moves only the ranges it owned.
+  peerCache_->setPeers({"self", "w1"});
+  const auto afterRemove = owners("file", 3'000);
+  for (auto i = 0; i < result.size(); ++i) {
+    if (result[i] != "w2") {
+      EXPECT_EQ(afterRemove[i], result[i]);
+    } else {
+      EXPECT_NE(afterRemove[i], "w2");
+    }
+  }
+
+  // Only this worker is left.
+  peerCache_->setPeers({"self"});
+  EXPECT_FALSE(peerCache_->owner("file", 0).has_value());
+  peerCache_->setPeers({});
+  EXPECT_FALSE(peerCache_->owner("file", 0).has_value());
+}
+
+TEST_F(PeerCacheTest, read) {
+  transport_->files_.insert("file");
+  transport_->failing_.insert("w2");
+
+  std::vector<char> data(1'000);
+  std::vector<folly::Range<char*>> buffers{
+      {data.data(), 100}, {data.data() + 100, 900}};
+  int32_t numRemote = 0;
+  int32_t numHit = 0;
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t offset = i * 1'000;
+    const auto owner = peerCache_->owner("file", offset);
+    numRemote += owner.has_value();
+    const bool hit = peerCache_->read("file", offset, buffers);
+    EXPECT_EQ(hit, owner.has_value() && owner.value() == "w1");
+    if (hit) {
+      ++numHit;
+      for (auto j = 0; j < data.size(); ++j) {
+        ASSERT_EQ(data[j], static_cast<char>((offset + j) % 251));
+      }
+    }
+  }
+  // Ranges this worker owns are not requested.
+  EXPECT_EQ(transport_->requests_.size(), numRemote);
+  ASSERT_GT(numHit, 0);
+  ASSERT_LT(numHit, numRemote);
+
+  auto stats = peerCache_->stats();
+  EXPECT_EQ(stats.numHit, numHit);
+  EXPECT_EQ(stats.hitBytes, numHit * data.size());
+  EXPECT_EQ(stats.numError, numRemote - numHit);
+  EXPECT_EQ(stats.numMiss, 0);
+
+  // A file the peers do not have is a miss without an error.
+  transport_->failing_.clear();
+  uint64_t offset = 0;
+  while (!peerCache_->owner("other", offset).has_value()) {
+    offset += 1'000;
+  }
+  EXPECT_FALSE(peerCache_->read("other", offset, buffers));
+  const auto delta = peerCache_->stats() - stats;
+  EXPECT_EQ(delta.numHit, 0);
+  EXPECT_EQ(delta.numMiss, 1);
+  EXPECT_EQ(delta.numError, 0);
+}
+
+TEST_F(PeerCacheTest, load) {
+  auto allocator = std::make_shared<memory::MmapAllocator>(
+      memory::MmapAllocator::Options{.capacity = 64L << 20});
+  auto cache = AsyncDataCache::create(allocator.get());
+  transport_->files_.insert("peerFile");
+  cache->setPeerCache(std::move(peerCache_));
+  auto* peerCache = cache->peerCache();
+
+  StringIdLease file(fileIds(), "peerFile");
+  // A tiny entry and one that spans several runs.
+  for (const int32_t size : {100, 1 << 20}) {
+    uint64_t offset = 0;
+    while (!peerCache->owner("peerFile", offset).has_value()) {
+      offset += 1'000;
+    }
+    auto pin = cache->findOrCreate(RawFileCacheKey{file.id(), offset}, size);
+    auto* entry = pin.checkedEntry();
+    ASSERT_TRUE(entry->isExclusive());
+    ASSERT_TRUE(peerCache->load(*entry));
+    if (entry->tinyData() != nullptr) {
+      for (auto i = 0; i < size; ++i) {
+        ASSERT_EQ(entry->tinyData()[i], static_cast<char>((offset + i) % 251));
+      }
+    } else {
+      uint64_t position = offset;
+      for (auto run = 0; run < entry->data().numRuns(); ++run) {
+        const auto pages = entry->data().runAt(run);
+        const auto bytes =
+            std::min<uint64_t>(pages.numBytes(), offset + size - position);
+        for (auto i = 0; i < bytes; ++i) {
+          ASSERT_EQ(
+              pages.data<char>()[i], static_cast<char>((position++) % 251));
+        }
+      }
+      EXPECT_EQ(position, offset + size);
+    }
+    entry->setExclusiveToShared();
+  }
+
+  const auto stats = cache->refreshStats();
+  ASSERT_NE(stats.peerStats, nullptr);
+  EXPECT_EQ(stats.peerStats->numHit, 2);
+  EXPECT_EQ(stats.peerStats->hitBytes, 100 + (1 << 20));
+  EXPECT_NE(stats.toString().find("Peer cache hit: 2"), std::string::npos);
+  cache->shutdown();
+}
+
+} // namespace
+} // namespace facebook::velox::cache
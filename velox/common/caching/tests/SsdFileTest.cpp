@@ -16,6 +16,7 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdSpillFileSystem.h"
 #include "velox/common/caching/tests/CacheTestUtil.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
@@ -533,10 +534,16 @@ TEST_F(SsdFileTest, fileCorruption) {
   ssdFile_->checkpoint(true);
   corruptSsdFile(fmt::format("{}/ssdtest", tempDirectory_->getPath()));
   initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, false);
-  // Cache can be loaded but the data of the last part is corrupted.
+  // Cache can be loaded but the data of the last part is corrupted. The
+  // recovered entries are verified on first read even without read
+  // verification.
   EXPECT_EQ(checkEntries({allEntries.begin(), allEntries.begin() + 100}), 100);
-  EXPECT_EQ(
-      checkEntries({allEntries.end() - 100, allEntries.end()}, false), 100);
+  VELOX_ASSERT_THROW(
+      checkEntries({allEntries.end() - 100, allEntries.end()}),
+      "Corrupt SSD cache entry");
+  stats.clear();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(stats.readSsdCorruptions, 1);
   // Corrupt the SSD file, initialize the cache from checkpoint with read
   // verification enabled.
   ssdFile_->checkpoint(true);
@@ -691,6 +698,39 @@ TEST_F(SsdFileTest, recoverFromCheckpointWithChecksum) {
   }
 }
 
+TEST_F(SsdFileTest, verifyRecoveredEntriesOnFirstRead) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
+  initializeCache(kSsdSize, checkpointIntervalBytes, true, false);
+  std::vector<TestEntry> entries;
+  {
+    auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      entries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  }
+  ssdFile_->checkpoint(true);
+
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, false);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(stats.entriesRecovered, entries.size());
+  EXPECT_GT(stats.recoveryTimeUs, 0);
+
+  // The last entry is verified on its first read. It is in the part that is
+  // corrupted next.
+  const std::vector<TestEntry> lastEntry{entries.back()};
+  EXPECT_EQ(checkEntries(lastEntry), 1);
+  corruptSsdFile(fmt::format("{}/ssdtest", tempDirectory_->getPath()));
+  // Later reads are not verified.
+  EXPECT_EQ(checkEntries(lastEntry, false), 1);
+  stats.clear();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(stats.readSsdCorruptions, 0);
+}
+
 TEST_F(SsdFileTest, recoverWithEvictedEntries) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -954,6 +994,114 @@ TEST_F(SsdFileTest, evictlogFileErrorInjection) {
   ASSERT_GT(statsAfterRecovery.readCheckpointErrors, 0);
 }
 
+TEST_F(SsdFileTest, reserveRegion) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(kSsdSize);
+  // Fills the cache, so that the reservations evict cached regions.
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, kSsdSize);
+  ssdFile_->write(pins);
+  pins.clear();
+
+  std::vector<int32_t> regions;
+  for (auto i = 0; i < kSsdSize / SsdFile::kRegionSize; ++i) {
+    auto region = ssdFile_->reserveRegion();
+    ASSERT_TRUE(region.has_value());
+    regions.push_back(region.value());
+  }
+  ASSERT_FALSE(ssdFile_->reserveRegion().has_value());
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.regionsReserved, regions.size());
+  ASSERT_EQ(stats.numPins, 0);
+  ASSERT_EQ(stats.entriesCached, 0);
+
+  // The cache does not write into reserved regions.
+  pins = makePins(fileName_.id(), 2 * kSsdSize, 4096, 4096, 1 * kMB);
+  ssdFile_->write(pins);
+  for (const auto& pin : pins) {
+    ASSERT_EQ(pin.entry()->ssdFile(), nullptr);
+  }
+  pins.clear();
+
+  std::string data(1 * kMB, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i % 251;
+  }
+  std::vector<iovec> iovecs{{data.data(), data.size()}};
+  ssdFile_->writeReserved(regions[1], 2 * kMB, iovecs, data.size());
+  std::string read(data.size(), 0);
+  ssdFile_->readReserved(
+      regions[1], 2 * kMB, {folly::Range<char*>(read.data(), read.size())});
+  ASSERT_EQ(read, data);
+
+  for (auto region : regions) {
+    ssdFile_->releaseRegion(region);
+  }
+  SsdCacheStats statsAfterRelease;
+  ssdFile_->updateStats(statsAfterRelease);
+  ASSERT_EQ(statsAfterRelease.regionsReserved, 0);
+  pins = makePins(fileName_.id(), 3 * kSsdSize, 4096, 4096, 1 * kMB);
+  ssdFile_->write(pins);
+  readAndCheckPins(pins);
+}
+
+TEST_F(SsdFileTest, ssdSpillFileSystem) {
+  constexpr int64_t kSsdSize = 8 * SsdFile::kRegionSize;
+  constexpr int32_t kNumShards = 2;
+  initializeCache();
+  SsdCache ssdCache(SsdCache::Config(
+      fmt::format("{}/spillcache", tempDirectory_->getPath()),
+      kSsdSize,
+      kNumShards,
+      ssdExecutor()));
+  registerSsdSpillFileSystem(&ssdCache);
+  const std::string directory = SsdSpillFileSystem::scheme() + "/spill";
+  auto fs = filesystems::getFileSystem(directory, nullptr);
+  fs->mkdir(directory);
+
+  // The file spans two regions and ends in the middle of an aligned block.
+  const uint64_t size = SsdFile::kRegionSize + 3 * kMB + 123;
+  std::string data(size, 0);
+  for (auto i = 0; i < size; ++i) {
+    data[i] = (i * 7) % 253;
+  }
+  const auto path = directory + "/file";
+  {
+    auto file = fs->openFileForWrite(path);
+    file->append(std::string_view(data).substr(0, 1000));
+    file->append(std::string_view(data).substr(1000));
+    file->close();
+    ASSERT_EQ(file->size(), size);
+  }
+  ASSERT_EQ(ssdCache.stats().regionsReserved, 2);
+  ASSERT_TRUE(fs->exists(path));
+  ASSERT_TRUE(fs->exists(directory));
+  ASSERT_FALSE(fs->isDirectory(path));
+  ASSERT_EQ(fs->list(directory), std::vector<std::string>{path});
+
+  auto file = fs->openFileForRead(path);
+  ASSERT_EQ(file->size(), size);
+  ASSERT_EQ(file->pread(0, size), data);
+  for (const uint64_t offset :
+       {uint64_t{1}, SsdFile::kRegionSize - 10, size - 200}) {
+    ASSERT_EQ(file->pread(offset, 100), data.substr(offset, 100));
+  }
+  VELOX_ASSERT_THROW(file->pread(size - 10, 20), "Read past end");
+
+  const auto renamed = directory + "/renamed";
+  fs->rename(path, renamed);
+  ASSERT_FALSE(fs->exists(path));
+  ASSERT_EQ(fs->openFileForRead(renamed)->pread(0, size), data);
+
+  // The regions are released when the last reader goes away.
+  fs->rmdir(directory);
+  ASSERT_FALSE(fs->exists(renamed));
+  ASSERT_EQ(ssdCache.stats().regionsReserved, 2);
+  file.reset();
+  ASSERT_EQ(ssdCache.stats().regionsReserved, 0);
+  ssdCache.shutdown();
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
@@ -19,6 +19,7 @@
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 
@@ -27,6 +28,7 @@
 #include <linux/fs.h>
 #endif // linux
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 
 namespace facebook::velox {
 
@@ -143,7 +145,8 @@ uint64_t InMemoryWriteFile::size() const {
 LocalReadFile::LocalReadFile(
     std::string_view path,
     folly::Executor* executor,
-    bool bufferIo)
+    bool bufferIo,
+    bool mmap)
     : executor_(executor), path_(path) {
   int32_t flags = O_RDONLY;
 #ifdef linux
@@ -172,12 +175,25 @@ LocalReadFile::LocalReadFile(
       path,
       folly::errnoStr(errno));
   size_ = ret;
+  if (mmap && size_ > 0) {
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    VELOX_CHECK(
+        mapped != MAP_FAILED,
+        "mmap failure in LocalReadFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+    mapped_ = static_cast<char*>(mapped);
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd, folly::Executor* executor)
     : executor_(executor), fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
+  if (mapped_ != nullptr && munmap(mapped_, size_) < 0) {
+    LOG(WARNING) << "munmap failure in LocalReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
   const int ret = close(fd_);
   if (ret < 0) {
     LOG(WARNING) << "close failure in LocalReadFile destructor: " << ret << ", "
@@ -188,6 +204,11 @@ LocalReadFile::~LocalReadFile() {
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   bytesRead_ += length;
+  if (mapped_ != nullptr) {
+    VELOX_CHECK_LE(offset + length, size_, "Read past the end of {}", path_);
+    std::memcpy(pos, mapped_ + offset, length);
+    return;
+  }
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
       bytesRead,
@@ -211,6 +232,16 @@ uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     filesystems::File::IoStats* stats) const {
+  if (mapped_ != nullptr) {
+    uint64_t totalBytesRead = 0;
+    for (auto& range : buffers) {
+      if (range.data()) {
+        preadInternal(offset + totalBytesRead, range.size(), range.data());
+      }
+      totalBytesRead += range.size();
+    }
+    return totalBytesRead;
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -287,6 +318,15 @@ uint64_t LocalReadFile::size() const {
   return size_;
 }
 
+std::string_view LocalReadFile::mappedRange(uint64_t offset, uint64_t length)
+    const {
+  if (mapped_ == nullptr) {
+    return {};
+  }
+  VELOX_CHECK_LE(offset + length, size_, "Read past the end of {}", path_);
+  return {mapped_ + offset, length};
+}
+
 uint64_t LocalReadFile::memoryUsage() const {
   // TODO: does FILE really not use any more memory? From the stdio.h
   // source code it looks like it has only a single integer? Probably
@@ -128,6 +128,14 @@ class ReadFile {
     return false;
   }
 
+  // Returns the data at [offset, offset + length) without copying if the file
+  // is mapped into memory. The returned view stays valid for the lifetime of
+  // *this. Returns an empty view if the file is not mapped.
+  virtual std::string_view mappedRange(uint64_t /*offset*/, uint64_t /*length*/)
+      const {
+    return {};
+  }
+
   // Whether preads should be coalesced where possible. E.g. remote disk would
   // set to true, in-memory to false.
   virtual bool shouldCoalesce() const = 0;
@@ -294,31 +302,35 @@ class InMemoryWriteFile final : public WriteFile {
 /// Current implementation for the local version is quite simple (e.g. no
 /// internal arenaing), as local disk writes are expected to be cheap. Local
 /// files match against any filepath starting with '/'.
-class LocalReadFile final : public ReadFile {
+class LocalReadFile : public ReadFile {
  public:
+  /// If 'mmap' is true, the file is mapped into memory and read from the
+  /// mapping. The reads then copy from the kernel page cache without a system
+  /// call and mappedRange() returns the mapped bytes without copying.
   LocalReadFile(
       std::string_view path,
       folly::Executor* executor = nullptr,
-      bool bufferIo = true);
+      bool bufferIo = true,
+      bool mmap = false);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
   LocalReadFile(int32_t fd, folly::Executor* executor = nullptr);
 
-  ~LocalReadFile();
+  ~LocalReadFile() override;
 
   std::string_view pread(
       uint64_t offset,
       uint64_t length,
       void* buf,
-      filesystems::File::IoStats* stats = nullptr) const final;
+      filesystems::File::IoStats* stats = nullptr) const override;
 
   uint64_t size() const final;
 
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers,
-      filesystems::File::IoStats* stats = nullptr) const final;
+      filesystems::File::IoStats* stats = nullptr) const override;
 
   folly::SemiFuture<uint64_t> preadvAsync(
       uint64_t offset,
@@ -329,6 +341,9 @@ class LocalReadFile final : public ReadFile {
     return executor_ != nullptr;
   }
 
+  std::string_view mappedRange(uint64_t offset, uint64_t length)
+      const override;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -346,6 +361,11 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+ protected:
+  int32_t fd() const {
+    return fd_;
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
@@ -353,9 +373,11 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  // The file mapped into memory. Null if not mapped.
+  char* mapped_{nullptr};
 };
 
-class LocalWriteFile final : public WriteFile {
+class LocalWriteFile : public WriteFile {
  public:
   struct Attributes {
     // If set to true, the file will not be subject to copy-on-write updates.
@@ -376,14 +398,14 @@ class LocalWriteFile final : public WriteFile {
       bool shouldThrowOnFileAlreadyExists = true,
       bool bufferIo = true);
 
-  ~LocalWriteFile();
+  ~LocalWriteFile() override;
 
   void append(std::string_view data) final;
 
   void append(std::unique_ptr<folly::IOBuf> data) final;
 
   void write(const std::vector<iovec>& iovecs, int64_t offset, int64_t length)
-      final;
+      override;
 
   void truncate(int64_t newSize) final;
 
@@ -404,6 +426,20 @@ class LocalWriteFile final : public WriteFile {
     return path_;
   }
 
+ protected:
+  int32_t fd() const {
+    return fd_;
+  }
+
+  void checkIsOpen() const {
+    VELOX_CHECK(!closed_, "file is closed");
+  }
+
+  // Records a positional write of 'bytesWritten' bytes at 'offset'.
+  void updateSize(int64_t offset, int64_t bytesWritten) {
+    size_ = std::max<uint64_t>(size_, offset + bytesWritten);
+  }
+
  private:
   // File descriptor.
   int32_t fd_{-1};
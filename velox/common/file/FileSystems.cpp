@@ -19,6 +19,9 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringFile.h"
+#endif
 
 #include <cstdio>
 #include <filesystem>
@@ -116,6 +119,16 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
       const FileOptions& options) override {
+    if (options.useMmap) {
+      return std::make_unique<LocalReadFile>(
+          extractPath(path), executor_.get(), /*bufferIo=*/true, /*mmap=*/true);
+    }
+#ifdef VELOX_ENABLE_IO_URING
+    if (options.useIoUring && IoUring::isSupported()) {
+      return std::make_unique<IoUringReadFile>(
+          extractPath(path), executor_.get(), options.bufferIo);
+    }
+#endif
     return std::make_unique<LocalReadFile>(
         extractPath(path), executor_.get(), options.bufferIo);
   }
@@ -123,6 +136,15 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<WriteFile> openFileForWrite(
       std::string_view path,
       const FileOptions& options) override {
+#ifdef VELOX_ENABLE_IO_URING
+    if (options.useIoUring && IoUring::isSupported()) {
+      return std::make_unique<IoUringWriteFile>(
+          extractPath(path),
+          options.shouldCreateParentDirectories,
+          options.shouldThrowOnFileAlreadyExists,
+          options.bufferIo);
+    }
+#endif
     return std::make_unique<LocalWriteFile>(
         extractPath(path),
         options.shouldCreateParentDirectories,
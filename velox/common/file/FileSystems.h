@@ -32,6 +32,9 @@ class WriteFile;
 namespace filesystems::File {
 class IoStats;
 }
+namespace io {
+class IoStatistics;
+}
 } // namespace facebook::velox
 
 namespace facebook::velox::filesystems {
@@ -67,6 +70,17 @@ struct FileOptions {
   /// IO mode if set.
   bool bufferIo{true};
 
+  /// Whether to use io_uring for reads and positional writes. Only the local
+  /// file system built with VELOX_ENABLE_IO_URING respects this option. It is
+  /// ignored otherwise.
+  bool useIoUring{false};
+
+  /// Whether to map the file into memory for reads. Only the local file system
+  /// respects this option. This avoids copying the data from the kernel page
+  /// cache for the readers that use ReadFile::mappedRange(). Takes precedence
+  /// over 'useIoUring'.
+  bool useMmap{false};
+
   /// Property bag to set onto files/directories. Think something similar to
   /// ioctl(2). For other remote filesystems, this can be PutObjectTagging in
   /// S3.
@@ -75,6 +89,11 @@ struct FileOptions {
 
   File::IoStats* stats{nullptr};
 
+  /// IO statistics of the writer that opens a file for write. File systems
+  /// that write in the background report their upload time and the time the
+  /// writer stalls on them here.
+  io::IoStatistics* writeStats{nullptr};
+
   /// A raw string that client can encode as anything they want to describe the
   /// file. For example, extraFileInfo can contain serialized file descriptors
   /// or other specific backend filesystem metadata can be used during for a
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringFile.h"
+
+#include <chrono>
+
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <liburing.h>
+
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+namespace {
+
+uint64_t iovecsSize(const iovec* iovecs, uint32_t numIovecs) {
+  uint64_t size = 0;
+  for (auto i = 0; i < numIovecs; ++i) {
+    size += iovecs[i].iov_len;
+  }
+  return size;
+}
+
+// Splits 'iovecs' into requests of at most IOV_MAX iovecs each at consecutive
+// offsets starting at 'offset'.
+std::vector<IoUring::Request> makeRequests(
+    int32_t fd,
+    bool write,
+    const std::vector<iovec>& iovecs,
+    uint64_t offset) {
+  std::vector<IoUring::Request> requests;
+  for (size_t begin = 0; begin < iovecs.size(); begin += IOV_MAX) {
+    const auto numIovecs =
+        static_cast<uint32_t>(std::min<size_t>(IOV_MAX, iovecs.size() - begin));
+    requests.push_back(
+        {.fd = fd,
+         .write = write,
+         .iovecs = iovecs.data() + begin,
+         .numIovecs = numIovecs,
+         .offset = offset});
+    offset += iovecsSize(iovecs.data() + begin, numIovecs);
+  }
+  return requests;
+}
+
+} // namespace
+
+IoUring::IoUring(uint32_t queueDepth)
+    : queueDepth_(queueDepth), ring_(std::make_unique<io_uring>()) {
+  VELOX_CHECK_GT(queueDepth_, 0);
+  const auto ret = io_uring_queue_init(queueDepth_, ring_.get(), 0);
+  VELOX_CHECK_EQ(
+      ret, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-ret));
+}
+
+IoUring::~IoUring() {
+  io_uring_queue_exit(ring_.get());
+}
+
+// static
+IoUring& IoUring::threadInstance() {
+  thread_local std::unique_ptr<IoUring> ring;
+  if (ring == nullptr) {
+    ring = std::make_unique<IoUring>(FLAGS_velox_io_uring_queue_depth);
+  }
+  return *ring;
+}
+
+// static
+bool IoUring::isSupported() {
+  static const bool supported = [] {
+    io_uring ring;
+    if (io_uring_queue_init(1, &ring, 0) != 0) {
+      return false;
+    }
+    io_uring_queue_exit(&ring);
+    return true;
+  }();
+  return supported;
+}
+
+void IoUring::submit(
+    std::vector<Request>& requests,
+    filesystems::File::IoStats* stats) {
+  for (size_t begin = 0; begin < requests.size(); begin += queueDepth_) {
+    const auto end = std::min<size_t>(requests.size(), begin + queueDepth_);
+    for (auto i = begin; i < end; ++i) {
+      auto& request = requests[i];
+      auto* sqe = io_uring_get_sqe(ring_.get());
+      VELOX_CHECK_NOT_NULL(sqe, "io_uring submission queue is full");
+      if (request.write) {
+        io_uring_prep_writev(
+            sqe, request.fd, request.iovecs, request.numIovecs, request.offset);
+      } else {
+        io_uring_prep_readv(
+            sqe, request.fd, request.iovecs, request.numIovecs, request.offset);
+      }
+      io_uring_sqe_set_data(sqe, &request);
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const int32_t numSubmitted = io_uring_submit(ring_.get());
+    VELOX_CHECK_EQ(
+        numSubmitted,
+        end - begin,
+        "io_uring_submit failed: {}",
+        numSubmitted < 0 ? folly::errnoStr(-numSubmitted) : "");
+    for (auto i = begin; i < end; ++i) {
+      io_uring_cqe* cqe;
+      int32_t ret;
+      do {
+        ret = io_uring_wait_cqe(ring_.get(), &cqe);
+      } while (ret == -EINTR);
+      VELOX_CHECK_EQ(
+          ret, 0, "io_uring_wait_cqe failed: {}", folly::errnoStr(-ret));
+      static_cast<Request*>(io_uring_cqe_get_data(cqe))->result = cqe->res;
+      io_uring_cqe_seen(ring_.get(), cqe);
+    }
+    const auto latency = std::chrono::steady_clock::now() - startTime;
+
+    const auto queueDepth = end - begin;
+    const auto latencyUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    ioUringStatistics().ioUringQueueDepth().increment(queueDepth);
+    ioUringStatistics().ioUringLatencyUs().increment(latencyUs);
+    if (stats != nullptr) {
+      stats->addCounter("ioUringQueueDepth", RuntimeCounter(queueDepth));
+      stats->addCounter(
+          "ioUringLatency",
+          RuntimeCounter(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(latency)
+                  .count(),
+              RuntimeCounter::Unit::kNanos));
+    }
+  }
+}
+
+io::IoStatistics& ioUringStatistics() {
+  static io::IoStatistics stats;
+  return stats;
+}
+
+std::string_view IoUringReadFile::pread(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    filesystems::File::IoStats* stats) const {
+  bytesRead_ += length;
+  iovec iov{buf, length};
+  std::vector<IoUring::Request> requests{
+      {.fd = fd(), .iovecs = &iov, .numIovecs = 1, .offset = offset}};
+  IoUring::threadInstance().submit(requests, stats);
+  VELOX_CHECK_EQ(
+      requests[0].result,
+      length,
+      "io_uring read failure in IoUringReadFile::pread, {} vs {}: {}",
+      requests[0].result,
+      length,
+      requests[0].result < 0 ? folly::errnoStr(-requests[0].result) : "");
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t IoUringReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  // Dropped bytes sized so that a typical dropped range of 50K is not
+  // too many iovecs. The content is never used so the buffer is shared by all
+  // requests in flight.
+  static thread_local std::vector<char> droppedBytes(16 * 1024);
+  std::vector<iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for (auto& range : buffers) {
+    if (!range.data()) {
+      auto skipSize = range.size();
+      while (skipSize) {
+        const auto bytes = std::min<size_t>(droppedBytes.size(), skipSize);
+        iovecs.push_back({droppedBytes.data(), bytes});
+        skipSize -= bytes;
+      }
+    } else {
+      iovecs.push_back({range.data(), range.size()});
+    }
+  }
+
+  auto requests = makeRequests(fd(), false, iovecs, offset);
+  IoUring::threadInstance().submit(requests, stats);
+
+  // Like LocalReadFile::preadv, returns the bytes read up to the first failed
+  // or short read.
+  uint64_t totalBytesRead = 0;
+  for (const auto& request : requests) {
+    if (request.result < 0) {
+      LOG(ERROR) << "io_uring readv failed with error: "
+                 << folly::errnoStr(-request.result);
+      break;
+    }
+    totalBytesRead += request.result;
+    if (request.result < iovecsSize(request.iovecs, request.numIovecs)) {
+      break;
+    }
+  }
+  return totalBytesRead;
+}
+
+uint64_t IoUringReadFile::preadv(
+    folly::Range<const common::Region*> regions,
+    folly::Range<folly::IOBuf*> iobufs,
+    filesystems::File::IoStats* stats) const {
+  VELOX_CHECK_EQ(regions.size(), iobufs.size());
+  std::vector<iovec> iovecs(regions.size());
+  std::vector<IoUring::Request> requests;
+  requests.reserve(regions.size());
+  uint64_t length = 0;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    const auto& region = regions[i];
+    iobufs[i] = folly::IOBuf(folly::IOBuf::CREATE, region.length);
+    iovecs[i] = {iobufs[i].writableData(), region.length};
+    requests.push_back(
+        {.fd = fd(),
+         .iovecs = &iovecs[i],
+         .numIovecs = 1,
+         .offset = region.offset});
+    length += region.length;
+  }
+  bytesRead_ += length;
+
+  IoUring::threadInstance().submit(requests, stats);
+  for (size_t i = 0; i < regions.size(); ++i) {
+    VELOX_CHECK_EQ(
+        requests[i].result,
+        regions[i].length,
+        "io_uring read failure in IoUringReadFile::preadv, {} vs {}: {}",
+        requests[i].result,
+        regions[i].length,
+        requests[i].result < 0 ? folly::errnoStr(-requests[i].result) : "");
+    iobufs[i].append(regions[i].length);
+  }
+  return length;
+}
+
+void IoUringWriteFile::write(
+    const std::vector<iovec>& iovecs,
+    int64_t offset,
+    int64_t length) {
+  checkIsOpen();
+  VELOX_CHECK_GE(offset, 0, "Offset cannot be negative.");
+  auto requests = makeRequests(fd(), true, iovecs, offset);
+  IoUring::threadInstance().submit(requests);
+
+  int64_t bytesWritten = 0;
+  for (const auto& request : requests) {
+    VELOX_CHECK_EQ(
+        request.result,
+        iovecsSize(request.iovecs, request.numIovecs),
+        "io_uring write failure in IoUringWriteFile::write: {}",
+        request.result < 0 ? folly::errnoStr(-request.result) : "");
+    bytesWritten += request.result;
+  }
+  VELOX_CHECK_EQ(
+      bytesWritten,
+      length,
+      "Failure in IoUringWriteFile::write, {} vs {}",
+      bytesWritten,
+      length);
+  updateSize(offset, bytesWritten);
+}
+
+} // namespace facebook::velox
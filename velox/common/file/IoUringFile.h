@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include "velox/common/file/File.h"
+
+struct io_uring;
+
+namespace facebook::velox {
+
+/// Wrapper around an io_uring submission and completion queue pair. An
+/// instance is not thread safe. Use threadInstance() to get the ring of the
+/// calling thread.
+class IoUring {
+ public:
+  /// A single readv or writev request at a file offset.
+  struct Request {
+    int32_t fd;
+    bool write{false};
+    const iovec* iovecs;
+    uint32_t numIovecs;
+    uint64_t offset;
+
+    /// Number of bytes transferred or -errno. Set by submit().
+    int64_t result{0};
+  };
+
+  explicit IoUring(uint32_t queueDepth);
+
+  ~IoUring();
+
+  /// Returns the ring of the calling thread, created on first use with a queue
+  /// depth of FLAGS_velox_io_uring_queue_depth.
+  static IoUring& threadInstance();
+
+  /// Returns true if io_uring is supported by the running kernel.
+  static bool isSupported();
+
+  /// Submits 'requests' in batches of up to 'queueDepth' and waits for all of
+  /// them to complete. Records the batch sizes and latencies in
+  /// ioUringStatistics() and in 'stats' if not null.
+  void submit(
+      std::vector<Request>& requests,
+      filesystems::File::IoStats* stats = nullptr);
+
+  uint32_t queueDepth() const {
+    return queueDepth_;
+  }
+
+ private:
+  const uint32_t queueDepth_;
+  std::unique_ptr<io_uring> ring_;
+};
+
+/// Process wide statistics of io_uring submissions. Only the io_uring
+/// counters are set.
+io::IoStatistics& ioUringStatistics();
+
+/// LocalReadFile that submits its reads to the io_uring of the calling thread.
+/// The vectorized reads are split into one request per IOV_MAX buffers or per
+/// region and are submitted as a single batch, so that the device sees them
+/// at the same time instead of one preadv at a time.
+class IoUringReadFile final : public LocalReadFile {
+ public:
+  using LocalReadFile::LocalReadFile;
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  uint64_t preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs,
+      filesystems::File::IoStats* stats = nullptr) const final;
+};
+
+/// LocalWriteFile that submits positional writes to the io_uring of the
+/// calling thread. Appends use the base class.
+class IoUringWriteFile final : public LocalWriteFile {
+ public:
+  using LocalWriteFile::LocalWriteFile;
+
+  void write(const std::vector<iovec>& iovecs, int64_t offset, int64_t length)
+      final;
+};
+
+} // namespace facebook::velox
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/file/Utils.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox::file::utils {
@@ -34,4 +35,76 @@ bool CoalesceIfDistanceLE::operator()(
   }
   return shouldCoalesce;
 }
+
+uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  return length;
+}
+
+std::vector<ReadPart> makeReadParts(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t minPartSize,
+    int32_t maxParts) {
+  VELOX_CHECK_GT(maxParts, 0);
+  const uint64_t partSize = std::max<uint64_t>(
+      std::max<uint64_t>(minPartSize, 1),
+      bits::divRoundUp(totalLength(buffers), maxParts));
+  std::vector<ReadPart> parts;
+  uint64_t position = offset;
+  for (const auto& range : buffers) {
+    uint64_t offsetInRange = 0;
+    while (offsetInRange < range.size()) {
+      if (parts.empty() || parts.back().length >= partSize) {
+        if (range.data() == nullptr) {
+          position += range.size() - offsetInRange;
+          break;
+        }
+        parts.push_back(ReadPart{position, 0, {}});
+      }
+      auto& part = parts.back();
+      const uint64_t bytes =
+          std::min(range.size() - offsetInRange, partSize - part.length);
+      if (range.data() == nullptr) {
+        part.buffers.emplace_back(nullptr, reinterpret_cast<char*>(bytes));
+      } else {
+        part.buffers.emplace_back(range.data() + offsetInRange, bytes);
+      }
+      part.length += bytes;
+      offsetInRange += bytes;
+      position += bytes;
+    }
+  }
+  for (auto& part : parts) {
+    while (part.buffers.back().data() == nullptr) {
+      part.length -= part.buffers.back().size();
+      part.buffers.pop_back();
+    }
+  }
+  return parts;
+}
+
+folly::SemiFuture<folly::Unit> readPartsAsync(
+    std::vector<ReadPart> parts,
+    folly::Executor* executor,
+    std::function<void(const ReadPart&)> read) {
+  VELOX_CHECK_NOT_NULL(executor);
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(parts.size());
+  for (auto& part : parts) {
+    futures.push_back(
+        folly::via(executor, [read, part = std::move(part)]() {
+          read(part);
+        }).semi());
+  }
+  return folly::collectAll(std::move(futures))
+      .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+        for (auto& result : results) {
+          result.throwUnlessValue();
+        }
+      });
+}
 } // namespace facebook::velox::file::utils
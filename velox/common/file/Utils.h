@@ -17,7 +17,13 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
 
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
 #include "folly/io/Cursor.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
@@ -165,4 +171,53 @@ class ReadToIOBufs {
   OutputIter output_;
   Reader reader_;
 };
+
+/// A range of a file that is read with one request and the destination of its
+/// bytes. Gaps in 'buffers' have no data and are skipped after the read.
+struct ReadPart {
+  uint64_t offset;
+  uint64_t length;
+  std::vector<folly::Range<char*>> buffers;
+};
+
+/// Returns the number of bytes covered by 'buffers', including the gaps.
+uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers);
+
+/// Splits the read of 'buffers' at 'offset' into parts of about the same size,
+/// at least 'minPartSize' bytes and at most 'maxParts' of them, so that a large
+/// read that is split over parallel requests takes about the time of one part.
+/// Gaps at the start or end of a part are not read.
+std::vector<ReadPart> makeReadParts(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t minPartSize,
+    int32_t maxParts);
+
+/// Reads 'part' with 'read(offset, length, destination)'. A part with more
+/// than one buffer is read into a temporary buffer and copied to its buffers.
+template <typename Read>
+void readPart(const ReadPart& part, Read read) {
+  if (part.buffers.size() == 1) {
+    read(part.offset, part.length, part.buffers[0].data());
+    return;
+  }
+  std::string result(part.length, 0);
+  read(part.offset, part.length, result.data());
+  size_t resultOffset = 0;
+  for (const auto& range : part.buffers) {
+    if (range.data()) {
+      memcpy(range.data(), result.data() + resultOffset, range.size());
+    }
+    resultOffset += range.size();
+  }
+}
+
+/// Reads 'parts' in parallel on 'executor' with 'read'. The result is
+/// ready after all parts are read, also if some fail, so that no read is in
+/// progress into the buffers of the caller after an error. Throws the first
+/// error.
+folly::SemiFuture<folly::Unit> readPartsAsync(
+    std::vector<ReadPart> parts,
+    folly::Executor* executor,
+    std::function<void(const ReadPart&)> read);
 } // namespace facebook::velox::file::utils
@@ -20,6 +20,9 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringFile.h"
+#endif
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -471,6 +474,85 @@ TEST_P(LocalFileTest, attributes) {
   writeFile->close();
 }
 
+#ifdef VELOX_ENABLE_IO_URING
+TEST_P(LocalFileTest, ioUring) {
+  if (useFaultyFs_ || !IoUring::isSupported()) {
+    GTEST_SKIP() << "io_uring is not supported";
+  }
+  for (bool withOffset : {false, true}) {
+    SCOPED_TRACE(fmt::format("withOffset {}", withOffset));
+    auto tempFile = exec::test::TempFilePath::create();
+    const auto& filename = tempFile->getPath();
+    auto fs = filesystems::getFileSystem(filename, {});
+    fs->remove(filename);
+    filesystems::FileOptions options;
+    options.useIoUring = true;
+    {
+      auto writeFile = fs->openFileForWrite(filename, options);
+      ASSERT_NE(dynamic_cast<IoUringWriteFile*>(writeFile.get()), nullptr);
+      if (withOffset) {
+        writeDataWithOffset(writeFile.get());
+      } else {
+        writeData(writeFile.get());
+      }
+      writeFile->close();
+      ASSERT_EQ(writeFile->size(), 15 + kOneMB);
+    }
+
+    const auto numBatches = ioUringStatistics().ioUringQueueDepth().count();
+    auto readFile = fs->openFileForRead(filename, options);
+    ASSERT_NE(dynamic_cast<IoUringReadFile*>(readFile.get()), nullptr);
+    readData(readFile.get());
+    ASSERT_GT(ioUringStatistics().ioUringQueueDepth().count(), numBatches);
+
+    // All regions are submitted in one batch.
+    std::vector<Region> regions = {{0, 5}, {10 + kOneMB, 5}, {5, 10}};
+    std::vector<folly::IOBuf> iobufs(regions.size());
+    filesystems::File::IoStats stats;
+    ASSERT_EQ(
+        readFile->preadv(regions, {iobufs.data(), iobufs.size()}, &stats), 20);
+    auto toString = [](const folly::IOBuf& iobuf) {
+      return std::string(
+          reinterpret_cast<const char*>(iobuf.data()), iobuf.length());
+    };
+    ASSERT_EQ(toString(iobufs[0]), "aaaaa");
+    ASSERT_EQ(toString(iobufs[1]), "ddddd");
+    ASSERT_EQ(toString(iobufs[2]), "bbbbbccccc");
+    ASSERT_EQ(stats.stats().at("ioUringQueueDepth").max, regions.size());
+  }
+}
+#endif
+
+TEST_P(LocalFileTest, mmap) {
+  if (useFaultyFs_) {
+    GTEST_SKIP() << "The faulty file system does not map files";
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+
+  auto readFile = fs->openFileForRead(filename);
+  ASSERT_TRUE(readFile->mappedRange(0, 5).empty());
+
+  filesystems::FileOptions options;
+  options.useMmap = true;
+  readFile = fs->openFileForRead(filename, options);
+  readData(readFile.get());
+  ASSERT_EQ(readFile->mappedRange(0, 10), "aaaaabbbbb");
+  ASSERT_EQ(readFile->mappedRange(10 + kOneMB, 5), "ddddd");
+  // The mapped bytes are not copied.
+  ASSERT_EQ(
+      readFile->mappedRange(5, 5).data(), readFile->mappedRange(0, 5).end());
+  VELOX_ASSERT_THROW(
+      readFile->mappedRange(10 + kOneMB, 6), "Read past the end of");
+}
+
 INSTANTIATE_TEST_SUITE_P(
     LocalFileTestSuite,
     LocalFileTest,
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/Utils.h"
 #include "velox/common/file/tests/TestUtils.h"
 
@@ -289,3 +291,67 @@ INSTANTIATE_TEST_SUITE_P(
     ReadToIOBufsTest,
     ValuesIn(
         std::vector<bool /* Should generated chained IOBuf */>({false, true})));
+
+TEST(MakeReadPartsTest, SplitsAndTrimsGaps) {
+  char buffer1[10];
+  char buffer2[20];
+  char buffer3[30];
+  const std::vector<folly::Range<char*>> buffers = {
+      {buffer1, 10},
+      {nullptr, 20},
+      {buffer2, 20},
+      {nullptr, 30},
+      {buffer3, 30}};
+  EXPECT_EQ(totalLength(buffers), 110);
+
+  // The parts are 28 bytes. The gaps at their ends are not read.
+  auto parts = makeReadParts(0, buffers, 16, 4);
+  ASSERT_EQ(parts.size(), 4);
+  EXPECT_EQ(parts[0].offset, 0);
+  EXPECT_EQ(parts[0].length, 10);
+  EXPECT_EQ(parts[1].offset, 30);
+  EXPECT_EQ(parts[1].length, 20);
+  EXPECT_EQ(parts[2].offset, 80);
+  EXPECT_EQ(parts[2].length, 28);
+  EXPECT_EQ(parts[2].buffers[0].data(), buffer3);
+  EXPECT_EQ(parts[3].offset, 108);
+  EXPECT_EQ(parts[3].length, 2);
+  EXPECT_EQ(parts[3].buffers[0].data(), buffer3 + 28);
+
+  // A large minimum part size reads the gaps in one part.
+  parts = makeReadParts(100, buffers, 1'000, 4);
+  ASSERT_EQ(parts.size(), 1);
+  EXPECT_EQ(parts[0].offset, 100);
+  EXPECT_EQ(parts[0].length, 110);
+  EXPECT_EQ(parts[0].buffers.size(), 5);
+}
+
+TEST(MakeReadPartsTest, ReadPartsAsync) {
+  std::string data(1'000, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  std::string result(900, 0);
+  const std::vector<folly::Range<char*>> buffers = {
+      {result.data(), 300}, {nullptr, 100}, {result.data() + 300, 600}};
+  auto parts = makeReadParts(0, buffers, 100, 4);
+  ASSERT_GT(parts.size(), 1);
+  folly::CPUThreadPoolExecutor executor(4);
+  readPartsAsync(std::move(parts), &executor, [&](const ReadPart& part) {
+    readPart(part, [&](uint64_t offset, uint64_t length, char* destination) {
+      memcpy(destination, data.data() + offset, length);
+    });
+  }).get();
+  EXPECT_EQ(result, data.substr(0, 300) + data.substr(400));
+
+  parts = makeReadParts(0, buffers, 100, 4);
+  VELOX_ASSERT_THROW(
+      readPartsAsync(
+          std::move(parts),
+          &executor,
+          [](const ReadPart& part) {
+            VELOX_CHECK_NE(part.offset, 0, "Failed read");
+          })
+          .get(),
+      "Failed read");
+}
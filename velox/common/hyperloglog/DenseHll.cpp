@@ -143,6 +143,29 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  constexpr int32_t kChunkSize = 64;
+  int32_t indices[kChunkSize];
+  int8_t values[kChunkSize];
+  for (size_t offset = 0; offset < hashes.size(); offset += kChunkSize) {
+    const auto numHashes =
+        std::min<size_t>(kChunkSize, hashes.size() - offset);
+    const auto* chunk = hashes.data() + offset;
+    for (auto i = 0; i < numHashes; ++i) {
+      indices[i] = computeIndex(chunk[i], indexBitLength_);
+      values[i] = numberOfLeadingZeros(chunk[i], indexBitLength_) + 1;
+    }
+    for (auto i = 0; i < numHashes; ++i) {
+      // Most hashes of a large input do not raise their bucket. The check
+      // below is the first one in insert(). 'baseline_' may change inside the
+      // loop, so it is read for every hash.
+      if (values[i] - baseline_ > getDelta(indices[i])) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
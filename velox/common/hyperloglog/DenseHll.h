@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include <folly/Range.h>
 #include "velox/common/memory/HashStringAllocator.h"
 
 namespace facebook::velox::common::hll {
@@ -48,6 +49,12 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Inserts a batch of hashes. Same result as calling insertHash for each
+  /// hash. Computes the buckets and values of a chunk of hashes in a loop
+  /// without branches first, then skips the hashes that do not raise their
+  /// bucket without going through insert().
+  void insertHashes(folly::Range<const uint64_t*> hashes);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
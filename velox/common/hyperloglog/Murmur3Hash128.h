@@ -38,6 +38,18 @@ class Murmur3Hash128 {
     return static_cast<int64_t>(mix64(h1) + mix64(h1 + h2));
   }
 
+  /// Computes hash64ForLong(data[i], seed) into hashes[i] for 'size' values.
+  /// The loop has no branches, so the compiler can vectorize it.
+  static void hash64ForLong(
+      const int64_t* data,
+      int32_t size,
+      int64_t seed,
+      uint64_t* hashes) {
+    for (int32_t i = 0; i < size; ++i) {
+      hashes[i] = hash64ForLong(data[i], seed);
+    }
+  }
+
   static void
   hash(const void* key, const int32_t len, const uint32_t seed, void* out);
 
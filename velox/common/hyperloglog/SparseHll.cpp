@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +91,50 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+size_t SparseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  // Below this many hashes, inserting them one by one is cheaper than a merge
+  // pass over all entries.
+  constexpr size_t kMinMergeSize = 16;
+
+  std::vector<uint32_t> newEntries;
+  size_t numInserted = 0;
+  while (numInserted < hashes.size() && !overLimit()) {
+    // Each hash adds at most one entry, so the chunk cannot go over the limit.
+    const auto chunkSize = std::min<size_t>(
+        hashes.size() - numInserted, softNumEntriesLimit_ - entries_.size());
+    if (chunkSize < kMinMergeSize) {
+      for (auto i = 0; i < chunkSize; ++i) {
+        insertHash(hashes[numInserted + i]);
+      }
+      numInserted += chunkSize;
+      continue;
+    }
+
+    newEntries.resize(chunkSize);
+    for (auto i = 0; i < chunkSize; ++i) {
+      const auto hash = hashes[numInserted + i];
+      newEntries[i] = encode(
+          computeIndex(hash, kIndexBitLength),
+          numberOfLeadingZeros(hash, kIndexBitLength));
+    }
+    std::sort(newEntries.begin(), newEntries.end());
+
+    // Keeps the last entry of each index, which has the largest value.
+    size_t numEntries = 0;
+    for (auto entry : newEntries) {
+      if (numEntries > 0 &&
+          decodeIndex(newEntries[numEntries - 1]) == decodeIndex(entry)) {
+        newEntries[numEntries - 1] = entry;
+      } else {
+        newEntries[numEntries++] = entry;
+      }
+    }
+    mergeWith(numEntries, newEntries.data());
+    numInserted += chunkSize;
+  }
+  return numInserted;
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
@@ -187,39 +234,46 @@ void SparseHll::mergeWith(const char* serialized) {
 void SparseHll::mergeWith(size_t otherSize, const uint32_t* otherEntries) {
   VELOX_CHECK_GT(otherSize, 0);
 
-  auto size = entries_.size();
-  std::vector<uint32_t> merged(size + otherSize);
+  // Merges from the back into the grown 'entries_'. The write position stays
+  // ahead of the unread entries of 'entries_', so no temporary buffer is
+  // needed.
+  const int64_t size = entries_.size();
+  const int64_t totalSize = size + otherSize;
+  entries_.resize(totalSize);
+  auto* entries = entries_.data();
 
-  int pos = 0;
-  int leftPos = 0;
-  int rightPos = 0;
+  int64_t pos = totalSize;
+  int64_t leftPos = size - 1;
+  int64_t rightPos = otherSize - 1;
 
-  while (leftPos < size && rightPos < otherSize) {
-    auto left = decodeIndex(entries_[leftPos]);
+  while (leftPos >= 0 && rightPos >= 0) {
+    auto left = decodeIndex(entries[leftPos]);
     auto right = decodeIndex(otherEntries[rightPos]);
-    if (left < right) {
-      merged[pos++] = entries_[leftPos++];
-    } else if (left > right) {
-      merged[pos++] = otherEntries[rightPos++];
+    if (left > right) {
+      entries[--pos] = entries[leftPos--];
+    } else if (left < right) {
+      entries[--pos] = otherEntries[rightPos--];
     } else {
       auto value = std::max(
-          decodeValue(entries_[leftPos++]),
-          decodeValue(otherEntries[rightPos++]));
-      merged[pos++] = encode(left, value);
+          decodeValue(entries[leftPos--]),
+          decodeValue(otherEntries[rightPos--]));
+      entries[--pos] = encode(left, value);
     }
   }
 
-  while (leftPos < size) {
-    merged[pos++] = entries_[leftPos++];
-  }
-
-  while (rightPos < otherSize) {
-    merged[pos++] = otherEntries[rightPos++];
+  while (rightPos >= 0) {
+    entries[--pos] = otherEntries[rightPos--];
   }
 
-  entries_.resize(pos);
-  for (auto i = 0; i < pos; i++) {
-    entries_[i] = merged[i];
+  // The remaining entries of 'entries_' are in place at the front. Closes the
+  // gap left by the entries that were present in both.
+  const int64_t numLeft = leftPos + 1;
+  if (pos > numLeft) {
+    memmove(
+        entries + numLeft,
+        entries + pos,
+        (totalSize - pos) * sizeof(uint32_t));
+    entries_.resize(numLeft + totalSize - pos);
   }
 }
 
@@ -238,22 +292,36 @@ void SparseHll::verify() const {
 
 void SparseHll::toDense(DenseHll& denseHll) const {
   auto indexBitLength = denseHll.indexBitLength();
+  auto bits = kIndexBitLength - indexBitLength;
 
+  // 'entries_' are sorted by index, so the entries of a dense bucket are
+  // adjacent. Only the max value of each bucket is inserted.
+  int64_t runIndex = -1;
+  int8_t runValue = 0;
   for (auto i = 0; i < entries_.size(); i++) {
     auto entry = entries_[i];
-    auto index = entry >> (32 - indexBitLength);
+    int64_t index = entry >> (32 - indexBitLength);
     auto shiftedValue = entry << indexBitLength;
     auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
 
     // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
     // were zeros, so look at the entry value, which contains the number of
     // leading 0 *after* kIndexBitLength.
-    auto bits = kIndexBitLength - indexBitLength;
     if (zeros >= bits) {
       zeros = bits + decodeValue(entry);
     }
 
-    denseHll.insert(index, zeros + 1);
+    if (index != runIndex) {
+      if (runIndex >= 0) {
+        denseHll.insert(runIndex, runValue);
+      }
+      runIndex = index;
+      runValue = 0;
+    }
+    runValue = std::max<int8_t>(runValue, zeros + 1);
+  }
+  if (runIndex >= 0) {
+    denseHll.insert(runIndex, runValue);
   }
 }
 
@@ -40,6 +40,13 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Inserts hashes from the start of 'hashes' until the soft memory limit is
+  /// reached. Returns the number of hashes inserted. The caller converts to
+  /// the dense layout and inserts the rest there if the limit is reached.
+  /// Sorts the entries of the hashes and merges them with the existing entries
+  /// in one pass instead of inserting them one by one into the sorted list.
+  size_t insertHashes(folly::Range<const uint64_t*> hashes);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
@@ -16,6 +16,7 @@
 #include "velox/common/hyperloglog/DenseHll.h"
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include "velox/common/hyperloglog/SparseHll.h"
 #include "velox/common/memory/HashStringAllocator.h"
 
 #define XXH_INLINE_ALL
@@ -45,6 +46,52 @@ class DenseHllBenchmark {
     }
   }
 
+  // Inserts 'numHashes' hashes into a dense HLL, one by one or in a batch.
+  void insert(int hashBits, int32_t numHashes, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(hashBits, &allocator);
+    const auto& hashes = makeHashes(numHashes);
+
+    suspender.dismiss();
+
+    if (batch) {
+      hll.insertHashes(
+          folly::Range<const uint64_t*>(hashes.data(), hashes.size()));
+    } else {
+      for (auto hash : hashes) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
+  // Inserts 'numHashes' hashes into a sparse HLL that stays below its memory
+  // limit, then converts it to a dense HLL.
+  void insertSparse(int hashBits, int32_t numHashes, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::SparseHll sparseHll(&allocator);
+    sparseHll.setSoftMemoryLimit(numHashes * sizeof(uint32_t) + 1);
+    common::hll::DenseHll denseHll(hashBits, &allocator);
+    const auto& hashes = makeHashes(numHashes);
+
+    suspender.dismiss();
+
+    if (batch) {
+      sparseHll.insertHashes(
+          folly::Range<const uint64_t*>(hashes.data(), hashes.size()));
+    } else {
+      for (auto hash : hashes) {
+        sparseHll.insertHash(hash);
+      }
+    }
+    sparseHll.toDense(denseHll);
+    folly::doNotOptimizeAway(denseHll.cardinality());
+  }
+
   void run(int hashBits) {
     folly::BenchmarkSuspender suspender;
 
@@ -69,6 +116,17 @@ class DenseHllBenchmark {
     return serialize(hll);
   }
 
+  const std::vector<uint64_t>& makeHashes(int32_t numHashes) {
+    auto& hashes = hashes_[numHashes];
+    if (hashes.empty()) {
+      hashes.reserve(numHashes);
+      for (int32_t i = 0; i < numHashes; ++i) {
+        hashes.push_back(hashOne(i));
+      }
+    }
+    return hashes;
+  }
+
   static std::string serialize(common::hll::DenseHll& denseHll) {
     auto size = denseHll.serializedSize();
     std::string serialized;
@@ -82,6 +140,9 @@ class DenseHllBenchmark {
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  // Hashes of 0, 1, 2..., keyed by their number.
+  std::unordered_map<int32_t, std::vector<uint64_t>> hashes_;
 };
 
 } // namespace
@@ -100,6 +161,38 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK(insertHash11) {
+  benchmark->insert(11, 1'000'000, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes11) {
+  benchmark->insert(11, 1'000'000, true);
+}
+
+BENCHMARK(insertHash16) {
+  benchmark->insert(16, 1'000'000, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes16) {
+  benchmark->insert(16, 1'000'000, true);
+}
+
+BENCHMARK(insertSparseHash) {
+  benchmark->insertSparse(11, 500, false);
+}
+
+BENCHMARK_RELATIVE(insertSparseHashes) {
+  benchmark->insertSparse(11, 500, true);
+}
+
+BENCHMARK(insertSparseHash8K) {
+  benchmark->insertSparse(16, 8'000, false);
+}
+
+BENCHMARK_RELATIVE(insertSparseHashes8K) {
+  benchmark->insertSparse(16, 8'000, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
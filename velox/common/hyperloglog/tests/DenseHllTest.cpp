@@ -225,6 +225,30 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 100'000; i++) {
+    hashes.push_back(hashOne(i));
+  }
+  // Hashes with many leading zeros after the index bits add overflow entries.
+  for (int i = 0; i < 64 - indexBitLength; ++i) {
+    hashes.push_back(1ull << i);
+  }
+
+  DenseHll expected{indexBitLength, &allocator_};
+  for (auto hash : hashes) {
+    expected.insertHash(hash);
+  }
+
+  DenseHll denseHll{indexBitLength, &allocator_};
+  denseHll.insertHashes(
+      folly::Range<const uint64_t*>(hashes.data(), hashes.size()));
+  ASSERT_EQ(denseHll.cardinality(), expected.cardinality());
+  ASSERT_EQ(serialize(denseHll), serialize(expected));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
@@ -173,6 +173,45 @@ TEST_F(SparseHllTest, mergeWith) {
   testMergeWith({}, sequence(100, 300));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 3'000; i++) {
+    // Repeats some values to insert duplicate entries.
+    hashes.push_back(hashOne(i % 2'000));
+  }
+
+  SparseHll expected{&allocator_};
+  for (auto hash : hashes) {
+    expected.insertHash(hash);
+  }
+
+  // Inserts the hashes in batches of several sizes, including batches that are
+  // inserted one by one.
+  for (auto batchSize : {1, 7, 100, 3'000}) {
+    SparseHll sparseHll{&allocator_};
+    sparseHll.setSoftMemoryLimit(1 << 20);
+    for (auto i = 0; i < hashes.size(); i += batchSize) {
+      auto size = std::min<size_t>(batchSize, hashes.size() - i);
+      ASSERT_EQ(
+          size,
+          sparseHll.insertHashes(
+              folly::Range<const uint64_t*>(hashes.data() + i, size)));
+    }
+    sparseHll.verify();
+    ASSERT_EQ(serialize(11, sparseHll), serialize(11, expected));
+  }
+
+  // Stops at the soft memory limit of 1'000 entries.
+  SparseHll sparseHll{&allocator_};
+  sparseHll.setSoftMemoryLimit(1'000 * 4);
+  auto numInserted = sparseHll.insertHashes(
+      folly::Range<const uint64_t*>(hashes.data(), hashes.size()));
+  ASSERT_TRUE(sparseHll.overLimit());
+  ASSERT_EQ(1'000, numInserted);
+  sparseHll.verify();
+  ASSERT_EQ(1'000, sparseHll.cardinality());
+}
+
 class SparseHllToDenseTest : public ::testing::TestWithParam<int8_t> {
  protected:
   static void SetUpTestCase() {
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/CoalescingController.h"
+
+#include <folly/Synchronized.h>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace facebook::velox::io {
+namespace {
+constexpr double kBytesPerMB = 1 << 20;
+} // namespace
+
+// static
+std::string CoalescingController::scheme(std::string_view path) {
+  const auto pos = path.find("://");
+  if (pos == std::string_view::npos || pos == 0) {
+    return "file";
+  }
+  return std::string(path.substr(0, pos));
+}
+
+// static
+CoalescingController& CoalescingController::forPath(std::string_view path) {
+  // The controllers are never freed, so that readers can keep references.
+  static folly::Synchronized<std::unordered_map<
+      std::string,
+      std::unique_ptr<CoalescingController>>>
+      controllers;
+  auto key = scheme(path);
+  {
+    auto locked = controllers.rlock();
+    auto it = locked->find(key);
+    if (it != locked->end()) {
+      return *it->second;
+    }
+  }
+  auto locked = controllers.wlock();
+  auto& controller = (*locked)[key];
+  if (controller == nullptr) {
+    controller = std::make_unique<CoalescingController>();
+  }
+  return *controller;
+}
+
+void CoalescingController::recordRead(uint64_t bytes, uint64_t latencyUs) {
+  const double x = bytes / kBytesPerMB;
+  const double y = latencyUs;
+  std::lock_guard<std::mutex> l(mutex_);
+  weight_ = weight_ * kDecay + 1;
+  sumX_ = sumX_ * kDecay + x;
+  sumY_ = sumY_ * kDecay + y;
+  sumXX_ = sumXX_ * kDecay + x * x;
+  sumXY_ = sumXY_ * kDecay + x * y;
+  ++numSamples_;
+}
+
+std::optional<CoalescingController::Model> CoalescingController::model()
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return modelLocked();
+}
+
+std::optional<CoalescingController::Model> CoalescingController::modelLocked()
+    const {
+  if (numSamples_ < kMinSamples) {
+    return std::nullopt;
+  }
+  const double meanX = sumX_ / weight_;
+  const double meanY = sumY_ / weight_;
+  const double varianceX = sumXX_ / weight_ - meanX * meanX;
+  // Sizes that are all about the same do not tell latency from transfer time.
+  if (varianceX <= 0.01 * meanX * meanX + 1e-12) {
+    return std::nullopt;
+  }
+  const double covariance = sumXY_ / weight_ - meanX * meanY;
+  const double usPerMB = covariance / varianceX;
+  const double latencyUs = meanY - usPerMB * meanX;
+  if (usPerMB <= 0 || latencyUs <= 0) {
+    return std::nullopt;
+  }
+  return Model{latencyUs, usPerMB / kBytesPerMB};
+}
+
+int32_t CoalescingController::maxCoalesceDistance(
+    int32_t defaultDistance) const {
+  const auto model = this->model();
+  if (!model.has_value()) {
+    return defaultDistance;
+  }
+  const double breakEven = model->requestLatencyUs / model->transferUsPerByte;
+  return std::clamp<double>(
+      breakEven, kMinCoalesceDistance, kMaxCoalesceDistance);
+}
+
+int64_t CoalescingController::maxCoalesceBytes(int64_t defaultBytes) const {
+  const auto model = this->model();
+  if (!model.has_value()) {
+    return defaultBytes;
+  }
+  const double breakEven = model->requestLatencyUs / model->transferUsPerByte;
+  return std::clamp<double>(
+      breakEven * kSizeToGapRatio, kMinCoalesceBytes, kMaxCoalesceBytes);
+}
+
+void CoalescingController::testingClear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  weight_ = 0;
+  sumX_ = 0;
+  sumY_ = 0;
+  sumXX_ = 0;
+  sumXY_ = 0;
+  numSamples_ = 0;
+}
+
+} // namespace facebook::velox::io
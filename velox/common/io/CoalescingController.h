@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace facebook::velox::io {
+
+/// Learns the cost of reads from one storage backend and picks the thresholds
+/// for coalescing reads that minimize the expected read time. The time of a
+/// read is modeled as a fixed latency per request plus a transfer time per
+/// byte, fitted by least squares over recent reads. Coalescing two ranges
+/// pays off while reading the gap between them takes less time than making
+/// another request, so the break-even gap is the request latency divided by
+/// the transfer time per byte. Thread safe.
+class CoalescingController {
+ public:
+  /// Number of reads before the thresholds are adapted.
+  static constexpr int32_t kMinSamples = 20;
+  /// Weight of the past samples relative to a new one. Gives an effective
+  /// window of about 100 reads.
+  static constexpr double kDecay = 0.99;
+  /// Coalesced reads are made large enough that the request latency is at
+  /// most 1 / kSizeToGapRatio of the read time.
+  static constexpr int32_t kSizeToGapRatio = 20;
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 64 << 20;
+  static constexpr int64_t kMinCoalesceBytes = 1 << 20;
+  static constexpr int64_t kMaxCoalesceBytes = 1LL << 30;
+
+  /// Estimated cost of reads.
+  struct Model {
+    double requestLatencyUs;
+    double transferUsPerByte;
+  };
+
+  /// Returns the controller shared by the files of the scheme of 'path', e.g.
+  /// "s3" for "s3://bucket/key". Paths without a scheme are local files.
+  static CoalescingController& forPath(std::string_view path);
+
+  /// Returns the scheme of 'path', "file" if it has none.
+  static std::string scheme(std::string_view path);
+
+  /// Records a read of 'bytes' that took 'latencyUs'. Gaps that are read
+  /// and dropped count in 'bytes'.
+  void recordRead(uint64_t bytes, uint64_t latencyUs);
+
+  /// Returns the fitted model, or std::nullopt if there are too few reads or
+  /// their sizes do not vary enough to separate latency from transfer time.
+  std::optional<Model> model() const;
+
+  /// Returns the gap up to which ranges are coalesced into one read, or
+  /// 'defaultDistance' if there is no model.
+  int32_t maxCoalesceDistance(int32_t defaultDistance) const;
+
+  /// Returns the max size of a coalesced read, or 'defaultBytes' if there is
+  /// no model.
+  int64_t maxCoalesceBytes(int64_t defaultBytes) const;
+
+  void testingClear();
+
+ private:
+  std::optional<Model> modelLocked() const;
+
+  mutable std::mutex mutex_;
+  // Decayed sums for the least squares fit of latency over bytes, in MB and
+  // microseconds to keep the magnitudes of the sums moderate.
+  double weight_{0};
+  double sumX_{0};
+  double sumY_{0};
+  double sumXX_{0};
+  double sumXY_{0};
+  int64_t numSamples_{0};
+};
+
+} // namespace facebook::velox::io
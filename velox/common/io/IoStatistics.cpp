@@ -14,14 +14,96 @@
  * limitations under the License.
  */
 
+#include <fmt/format.h>
 #include <glog/logging.h>
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <unordered_set>
 #include <utility>
 
 #include "velox/common/io/IoStatistics.h"
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
 namespace facebook::velox::io {
 
+namespace {
+
+// Returns the StatsReporter histogram of the storage reads of 'storageType',
+// registered on first use.
+std::string storageLatencyMetric(std::string_view storageType) {
+  static std::mutex mutex;
+  static std::unordered_set<std::string> registered;
+  auto metric = fmt::format("{}.{}", kMetricIoStorageLatencyMs, storageType);
+  std::lock_guard<std::mutex> l(mutex);
+  if (registered.insert(metric).second) {
+    DEFINE_HISTOGRAM_METRIC(
+        folly::StringPiece(metric), 20, 0, 2'000, 50, 90, 99, 100);
+  }
+  return metric;
+}
+
+} // namespace
+
+void IoLatencyHistogram::add(uint64_t latencyUs) {
+  const int32_t bucket = latencyUs == 0 ? 0 : 64 - __builtin_clzll(latencyUs);
+  ++buckets_[std::min(bucket, kNumBuckets - 1)];
+  ++count_;
+  sumUs_ += latencyUs;
+  maxUs_ = std::max(maxUs_, latencyUs);
+}
+
+void IoLatencyHistogram::merge(const IoLatencyHistogram& other) {
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  sumUs_ += other.sumUs_;
+  maxUs_ = std::max(maxUs_, other.maxUs_);
+}
+
+uint64_t IoLatencyHistogram::percentileUs(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto rank = static_cast<uint64_t>(
+      std::ceil(std::clamp(percentile, 0.0, 100.0) / 100 * count_));
+  uint64_t numBelow{0};
+  for (auto i = 0; i < kNumBuckets - 1; ++i) {
+    numBelow += buckets_[i];
+    if (numBelow >= rank) {
+      return std::min<uint64_t>(1ULL << i, maxUs_);
+    }
+  }
+  return maxUs_;
+}
+
+std::string IoLatencyHistogram::toString() const {
+  return fmt::format(
+      "count: {}, p50: {}, p90: {}, p99: {}, max: {}",
+      count_,
+      succinctMicros(percentileUs(50)),
+      succinctMicros(percentileUs(90)),
+      succinctMicros(percentileUs(99)),
+      succinctMicros(maxUs_));
+}
+
+// static
+std::string_view IoStatistics::tierName(IoTier tier) {
+  switch (tier) {
+    case IoTier::kRamHit:
+      return "ramHit";
+    case IoTier::kSsdHit:
+      return "ssdHit";
+    case IoTier::kStorage:
+      return "storage";
+  }
+  return "unknown";
+}
+
 uint64_t IoStatistics::rawBytesRead() const {
   return rawBytesRead_.load(std::memory_order_relaxed);
 }
@@ -50,6 +132,14 @@ uint64_t IoStatistics::writeIOTimeUs() const {
   return writeIOTimeUs_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::writeStallTimeUs() const {
+  return writeStallTimeUs_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::backgroundWriteTimeUs() const {
+  return backgroundWriteTimeUs_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incRawBytesRead(int64_t v) {
   return rawBytesRead_.fetch_add(v, std::memory_order_relaxed);
 }
@@ -78,6 +168,14 @@ uint64_t IoStatistics::incWriteIOTimeUs(int64_t v) {
   return writeIOTimeUs_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incWriteStallTimeUs(int64_t v) {
+  return writeStallTimeUs_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incBackgroundWriteTimeUs(int64_t v) {
+  return backgroundWriteTimeUs_.fetch_add(v, std::memory_order_relaxed);
+}
+
 void IoStatistics::incOperationCounters(
     const std::string& operation,
     const uint64_t resourceThrottleCount,
@@ -108,6 +206,66 @@ IoStatistics::operationStats() const {
   return operationStats_;
 }
 
+void IoStatistics::setStorageType(std::string_view storageType) {
+  std::lock_guard<std::mutex> l(latencyMutex_);
+  if (storageType_ != storageType) {
+    storageType_ = storageType;
+    storageLatencyMetric_.clear();
+  }
+}
+
+void IoStatistics::recordLatency(
+    IoTier tier,
+    uint64_t latencyUs,
+    bool queryThread) {
+  switch (tier) {
+    case IoTier::kRamHit:
+      RECORD_HISTOGRAM_METRIC_VALUE(kMetricIoRamHitLatencyUs, latencyUs);
+      break;
+    case IoTier::kSsdHit:
+      RECORD_HISTOGRAM_METRIC_VALUE(kMetricIoSsdHitLatencyUs, latencyUs);
+      break;
+    case IoTier::kStorage:
+      RECORD_HISTOGRAM_METRIC_VALUE(
+          kMetricIoStorageLatencyMs, latencyUs / 1000);
+      break;
+  }
+  std::lock_guard<std::mutex> l(latencyMutex_);
+  tierLatencies_[static_cast<int32_t>(tier)].add(latencyUs);
+  if (tier != IoTier::kStorage) {
+    return;
+  }
+  storageLatencies_[storageType_].add(latencyUs);
+  if (storageLatencyMetric_.empty()) {
+    storageLatencyMetric_ = storageLatencyMetric(storageType_);
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(storageLatencyMetric_, latencyUs / 1000);
+  if (queryThread) {
+    storageWaitUs_[storageType_] += latencyUs;
+  }
+}
+
+std::unordered_map<std::string, IoLatencyHistogram>
+IoStatistics::latencyHistograms() const {
+  std::unordered_map<std::string, IoLatencyHistogram> histograms;
+  std::lock_guard<std::mutex> l(latencyMutex_);
+  for (size_t i = 0; i < tierLatencies_.size(); ++i) {
+    if (!tierLatencies_[i].empty()) {
+      histograms.emplace(tierName(static_cast<IoTier>(i)), tierLatencies_[i]);
+    }
+  }
+  for (const auto& [storageType, histogram] : storageLatencies_) {
+    histograms.emplace(fmt::format("storage.{}", storageType), histogram);
+  }
+  return histograms;
+}
+
+std::unordered_map<std::string, uint64_t> IoStatistics::storageWaitUs()
+    const {
+  std::lock_guard<std::mutex> l(latencyMutex_);
+  return storageWaitUs_;
+}
+
 void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
@@ -119,6 +277,8 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  ioUringQueueDepth_.merge(other.ioUringQueueDepth_);
+  ioUringLatencyUs_.merge(other.ioUringLatencyUs_);
   {
     const auto& otherOperationStats = other.operationStats();
     std::lock_guard<std::mutex> l(operationStatsMutex_);
@@ -126,6 +286,26 @@ void IoStatistics::merge(const IoStatistics& other) {
       operationStats_[item.first].merge(item.second);
     }
   }
+  {
+    std::unordered_map<std::string, IoLatencyHistogram> otherStorageLatencies;
+    std::array<IoLatencyHistogram, 3> otherTierLatencies;
+    {
+      std::lock_guard<std::mutex> l(other.latencyMutex_);
+      otherTierLatencies = other.tierLatencies_;
+      otherStorageLatencies = other.storageLatencies_;
+    }
+    const auto otherStorageWaitUs = other.storageWaitUs();
+    std::lock_guard<std::mutex> l(latencyMutex_);
+    for (size_t i = 0; i < tierLatencies_.size(); ++i) {
+      tierLatencies_[i].merge(otherTierLatencies[i]);
+    }
+    for (const auto& [storageType, histogram] : otherStorageLatencies) {
+      storageLatencies_[storageType].merge(histogram);
+    }
+    for (const auto& [storageType, waitUs] : otherStorageWaitUs) {
+      storageWaitUs_[storageType] += waitUs;
+    }
+  }
 }
 
 void OperationCounters::merge(const OperationCounters& other) {
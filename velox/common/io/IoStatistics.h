@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <folly/dynamic.h>
@@ -89,8 +91,65 @@ class IoCounter {
   std::atomic<uint64_t> max_{0};
 };
 
+/// Histogram of I/O latencies in microseconds with log2 buckets: bucket 0
+/// counts the latencies under 1us, bucket i the latencies in [2^(i-1), 2^i)
+/// us and the last bucket the longer ones. Not thread-safe.
+class IoLatencyHistogram {
+ public:
+  static constexpr int32_t kNumBuckets = 28;
+
+  void add(uint64_t latencyUs);
+
+  void merge(const IoLatencyHistogram& other);
+
+  uint64_t count() const {
+    return count_;
+  }
+
+  bool empty() const {
+    return count_ == 0;
+  }
+
+  uint64_t sumUs() const {
+    return sumUs_;
+  }
+
+  uint64_t maxUs() const {
+    return maxUs_;
+  }
+
+  const std::array<uint64_t, kNumBuckets>& buckets() const {
+    return buckets_;
+  }
+
+  /// Returns an upper bound of the 'percentile' (0-100] latency, i.e. the
+  /// upper bound of its bucket capped at the max latency.
+  uint64_t percentileUs(double percentile) const;
+
+  /// Returns the count with the p50, p90, p99 and max latencies.
+  std::string toString() const;
+
+ private:
+  std::array<uint64_t, kNumBuckets> buckets_{};
+  uint64_t count_{0};
+  uint64_t sumUs_{0};
+  uint64_t maxUs_{0};
+};
+
 class IoStatistics {
  public:
+  /// The tier of the cache hierarchy a read is served from.
+  enum class IoTier {
+    /// The memory cache, including the waits for loads by other threads.
+    kRamHit,
+    /// The SSD cache.
+    kSsdHit,
+    /// The storage of the file, e.g. S3 or HDFS.
+    kStorage,
+  };
+
+  static std::string_view tierName(IoTier tier);
+
   uint64_t rawBytesRead() const;
   uint64_t rawOverreadBytes() const;
   uint64_t rawBytesWritten() const;
@@ -98,6 +157,8 @@ class IoStatistics {
   uint64_t outputBatchSize() const;
   uint64_t totalScanTime() const;
   uint64_t writeIOTimeUs() const;
+  uint64_t writeStallTimeUs() const;
+  uint64_t backgroundWriteTimeUs() const;
 
   uint64_t incRawBytesRead(int64_t);
   uint64_t incRawOverreadBytes(int64_t);
@@ -106,6 +167,11 @@ class IoStatistics {
   uint64_t incOutputBatchSize(int64_t);
   uint64_t incTotalScanTime(int64_t);
   uint64_t incWriteIOTimeUs(int64_t);
+  /// Time the writer waits for background writes to finish, e.g. when the
+  /// number of writes in flight reaches its limit.
+  uint64_t incWriteStallTimeUs(int64_t);
+  /// Time spent in writes on background threads.
+  uint64_t incBackgroundWriteTimeUs(int64_t);
 
   IoCounter& prefetch() {
     return prefetch_;
@@ -127,6 +193,14 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& ioUringQueueDepth() {
+    return ioUringQueueDepth_;
+  }
+
+  IoCounter& ioUringLatencyUs() {
+    return ioUringLatencyUs_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -141,6 +215,26 @@ class IoStatistics {
 
   std::unordered_map<std::string, OperationCounters> operationStats() const;
 
+  /// Sets the storage type of the files read next, i.e. the scheme of their
+  /// file system like "s3a" or "hdfs", see CoalescingController::scheme().
+  void setStorageType(std::string_view storageType);
+
+  /// Records the latency of a read served from 'tier' in the histogram of the
+  /// tier and, for storage reads, in the histogram of the current storage
+  /// type. Also reported to the StatsReporter. If 'queryThread', the read is
+  /// waited for by a query thread and its latency is added to the I/O wait of
+  /// the storage type.
+  void recordLatency(IoTier tier, uint64_t latencyUs, bool queryThread);
+
+  /// Returns the latency histograms keyed by the tier names, and by
+  /// "storage.<storage type>" for the storage reads of each storage type.
+  std::unordered_map<std::string, IoLatencyHistogram> latencyHistograms()
+      const;
+
+  /// Returns the time in microseconds query threads waited for storage reads
+  /// per storage type.
+  std::unordered_map<std::string, uint64_t> storageWaitUs() const;
+
   void merge(const IoStatistics& other);
 
   folly::dynamic getOperationStatsSnapshot() const;
@@ -153,6 +247,8 @@ class IoStatistics {
   std::atomic<uint64_t> rawOverreadBytes_{0};
   std::atomic<uint64_t> totalScanTime_{0};
   std::atomic<uint64_t> writeIOTimeUs_{0};
+  std::atomic<uint64_t> writeStallTimeUs_{0};
+  std::atomic<uint64_t> backgroundWriteTimeUs_{0};
 
   // Planned read from storage or SSD.
   IoCounter prefetch_;
@@ -171,8 +267,22 @@ class IoStatistics {
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Number of requests in flight in each io_uring submission batch.
+  IoCounter ioUringQueueDepth_;
+
+  // Time from io_uring submission to the completion of a batch.
+  IoCounter ioUringLatencyUs_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
+
+  mutable std::mutex latencyMutex_;
+  std::string storageType_{"file"};
+  // The StatsReporter histogram of 'storageType_', set on first use.
+  std::string storageLatencyMetric_;
+  std::array<IoLatencyHistogram, 3> tierLatencies_;
+  std::unordered_map<std::string, IoLatencyHistogram> storageLatencies_;
+  std::unordered_map<std::string, uint64_t> storageWaitUs_;
 };
 
 } // namespace facebook::velox::io
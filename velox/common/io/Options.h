@@ -62,6 +62,7 @@ class ReaderOptions {
   static constexpr int32_t kDefaultCoalesceDistance = 512 << 10; // 512K
   static constexpr int32_t kDefaultCoalesceBytes = 128 << 20; // 128M
   static constexpr int32_t kDefaultPrefetchRowGroups = 1;
+  static constexpr int64_t kDefaultDecompressedCacheMaxBytes = 4 << 20; // 4M
 
   explicit ReaderOptions(velox::memory::MemoryPool* pool)
       : memoryPool_(pool),
@@ -104,6 +105,30 @@ class ReaderOptions {
     return *this;
   }
 
+  /// If true, the coalescing thresholds are picked by the
+  /// CoalescingController of the file system of the file and
+  /// 'maxCoalesceDistance' and 'maxCoalesceBytes' are used only until the
+  /// controller has a model.
+  ReaderOptions& setAdaptiveCoalescing(bool adaptive) {
+    adaptiveCoalescing_ = adaptive;
+    return *this;
+  }
+
+  /// Sets the number of uses of the cached compressed bytes of a stream after
+  /// which the decompressed stream is also cached. 0 disables caching
+  /// decompressed streams.
+  ReaderOptions& setDecompressedCacheMinUses(int32_t minUses) {
+    decompressedCacheMinUses_ = minUses;
+    return *this;
+  }
+
+  /// Sets the max size of a compressed stream whose decompressed bytes may be
+  /// cached.
+  ReaderOptions& setDecompressedCacheMaxStreamBytes(int64_t bytes) {
+    decompressedCacheMaxStreamBytes_ = bytes;
+    return *this;
+  }
+
   /// Modifies the number of row groups to prefetch.
   ReaderOptions& setPrefetchRowGroups(int32_t numPrefetch) {
     prefetchRowGroups_ = numPrefetch;
@@ -135,6 +160,18 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  bool adaptiveCoalescing() const {
+    return adaptiveCoalescing_;
+  }
+
+  int32_t decompressedCacheMinUses() const {
+    return decompressedCacheMinUses_;
+  }
+
+  int64_t decompressedCacheMaxStreamBytes() const {
+    return decompressedCacheMaxStreamBytes_;
+  }
+
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
@@ -154,6 +191,9 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  bool adaptiveCoalescing_{false};
+  int32_t decompressedCacheMinUses_{0};
+  int64_t decompressedCacheMaxStreamBytes_{kDefaultDecompressedCacheMaxBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool noCacheRetention_{false};
 };
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/CoalescingController.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::io {
+namespace {
+
+// Records reads of varying sizes that take 'latencyUs' plus 'usPerByte' per
+// byte.
+void recordReads(
+    CoalescingController& controller,
+    double latencyUs,
+    double usPerByte,
+    int32_t numReads) {
+  for (auto i = 0; i < numReads; ++i) {
+    const uint64_t bytes = (4 << 10) << (i % 12);
+    controller.recordRead(bytes, latencyUs + bytes * usPerByte);
+  }
+}
+
+TEST(CoalescingControllerTest, scheme) {
+  EXPECT_EQ(CoalescingController::scheme("s3://bucket/key"), "s3");
+  EXPECT_EQ(CoalescingController::scheme("hdfs://host:9000/a"), "hdfs");
+  EXPECT_EQ(CoalescingController::scheme("/tmp/file"), "file");
+  EXPECT_EQ(CoalescingController::scheme("://x"), "file");
+  EXPECT_EQ(
+      &CoalescingController::forPath("s3://a/b"),
+      &CoalescingController::forPath("s3://c/d"));
+  EXPECT_NE(
+      &CoalescingController::forPath("s3://a/b"),
+      &CoalescingController::forPath("/a/b"));
+}
+
+TEST(CoalescingControllerTest, defaults) {
+  CoalescingController controller;
+  EXPECT_FALSE(controller.model().has_value());
+  EXPECT_EQ(controller.maxCoalesceDistance(512 << 10), 512 << 10);
+  EXPECT_EQ(controller.maxCoalesceBytes(128 << 20), 128 << 20);
+
+  // Too few reads.
+  recordReads(controller, 1'000, 0.001, CoalescingController::kMinSamples - 1);
+  EXPECT_FALSE(controller.model().has_value());
+
+  // Reads of the same size do not separate latency from transfer time.
+  controller.testingClear();
+  for (auto i = 0; i < 100; ++i) {
+    controller.recordRead(1 << 20, 2'000);
+  }
+  EXPECT_FALSE(controller.model().has_value());
+  EXPECT_EQ(controller.maxCoalesceDistance(512 << 10), 512 << 10);
+}
+
+TEST(CoalescingControllerTest, fit) {
+  CoalescingController controller;
+  // 1ms per request and 1GB/s.
+  recordReads(controller, 1'000, 0.001, 100);
+  const auto model = controller.model();
+  ASSERT_TRUE(model.has_value());
+  EXPECT_NEAR(model->requestLatencyUs, 1'000, 1);
+  EXPECT_NEAR(model->transferUsPerByte, 0.001, 1e-6);
+  // Reading 1MB takes as long as a request.
+  EXPECT_NEAR(controller.maxCoalesceDistance(0), 1'000'000, 1'000);
+  EXPECT_NEAR(
+      controller.maxCoalesceBytes(0),
+      1'000'000 * CoalescingController::kSizeToGapRatio,
+      20'000);
+
+  // A backend with a higher latency gets larger thresholds.
+  recordReads(controller, 20'000, 0.001, 1'000);
+  EXPECT_GT(controller.maxCoalesceDistance(0), 10'000'000);
+}
+
+TEST(CoalescingControllerTest, clamp) {
+  CoalescingController controller;
+  recordReads(controller, 1, 0.01, 100);
+  EXPECT_EQ(
+      controller.maxCoalesceDistance(0),
+      CoalescingController::kMinCoalesceDistance);
+  EXPECT_EQ(
+      controller.maxCoalesceBytes(0), CoalescingController::kMinCoalesceBytes);
+
+  controller.testingClear();
+  recordReads(controller, 1'000'000, 0.0001, 100);
+  EXPECT_EQ(
+      controller.maxCoalesceDistance(0),
+      CoalescingController::kMaxCoalesceDistance);
+  EXPECT_EQ(
+      controller.maxCoalesceBytes(0), CoalescingController::kMaxCoalesceBytes);
+}
+
+} // namespace
+} // namespace facebook::velox::io
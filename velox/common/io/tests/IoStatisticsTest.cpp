@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoStatistics.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::io {
+namespace {
+
+TEST(IoStatisticsTest, latencyHistogram) {
+  IoLatencyHistogram histogram;
+  ASSERT_TRUE(histogram.empty());
+  ASSERT_EQ(histogram.percentileUs(50), 0);
+
+  histogram.add(0);
+  histogram.add(1);
+  histogram.add(3);
+  histogram.add(1'000);
+  ASSERT_EQ(histogram.count(), 4);
+  ASSERT_EQ(histogram.sumUs(), 1'004);
+  ASSERT_EQ(histogram.maxUs(), 1'000);
+  ASSERT_EQ(histogram.buckets()[0], 1);
+  ASSERT_EQ(histogram.buckets()[1], 1);
+  ASSERT_EQ(histogram.buckets()[2], 1);
+  // 1000us is in [512, 1024).
+  ASSERT_EQ(histogram.buckets()[10], 1);
+
+  // The percentiles are the upper bounds of their buckets, capped at the max.
+  ASSERT_EQ(histogram.percentileUs(25), 1);
+  ASSERT_EQ(histogram.percentileUs(50), 2);
+  ASSERT_EQ(histogram.percentileUs(75), 4);
+  ASSERT_EQ(histogram.percentileUs(99), 1'000);
+
+  // Latencies past the last bucket are counted in it.
+  IoLatencyHistogram other;
+  other.add(1ULL << 40);
+  ASSERT_EQ(other.buckets()[IoLatencyHistogram::kNumBuckets - 1], 1);
+  histogram.merge(other);
+  ASSERT_EQ(histogram.count(), 5);
+  ASSERT_EQ(histogram.maxUs(), 1ULL << 40);
+  ASSERT_EQ(histogram.percentileUs(100), 1ULL << 40);
+  ASSERT_EQ(histogram.toString().find("count: 5"), 0);
+}
+
+TEST(IoStatisticsTest, recordLatency) {
+  IoStatistics stats;
+  stats.recordLatency(IoStatistics::IoTier::kRamHit, 2, true);
+  stats.recordLatency(IoStatistics::IoTier::kSsdHit, 100, true);
+  stats.recordLatency(IoStatistics::IoTier::kStorage, 1'000, true);
+  stats.setStorageType("s3a");
+  stats.recordLatency(IoStatistics::IoTier::kStorage, 20'000, true);
+  // Prefetches are not waited for by the query threads.
+  stats.recordLatency(IoStatistics::IoTier::kStorage, 30'000, false);
+
+  auto histograms = stats.latencyHistograms();
+  ASSERT_EQ(histograms.size(), 5);
+  ASSERT_EQ(histograms.at("ramHit").count(), 1);
+  ASSERT_EQ(histograms.at("ssdHit").count(), 1);
+  ASSERT_EQ(histograms.at("storage").count(), 3);
+  ASSERT_EQ(histograms.at("storage.file").count(), 1);
+  ASSERT_EQ(histograms.at("storage.s3a").count(), 2);
+  ASSERT_EQ(histograms.at("storage.s3a").sumUs(), 50'000);
+
+  auto waits = stats.storageWaitUs();
+  ASSERT_EQ(waits.size(), 2);
+  ASSERT_EQ(waits.at("file"), 1'000);
+  ASSERT_EQ(waits.at("s3a"), 20'000);
+
+  IoStatistics merged;
+  merged.recordLatency(IoStatistics::IoTier::kStorage, 10, true);
+  merged.merge(stats);
+  histograms = merged.latencyHistograms();
+  ASSERT_EQ(histograms.at("storage").count(), 4);
+  ASSERT_EQ(histograms.at("storage.file").count(), 2);
+  ASSERT_EQ(merged.storageWaitUs().at("file"), 1'010);
+  ASSERT_EQ(merged.storageWaitUs().at("s3a"), 20'000);
+}
+
+} // namespace
+} // namespace facebook::velox::io
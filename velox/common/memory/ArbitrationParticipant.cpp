@@ -170,6 +170,11 @@ uint64_t ArbitrationParticipant::maxReclaimableCapacity() const {
   return capacityBytes - config_->minCapacity;
 }
 
+int32_t ArbitrationParticipant::priority() const {
+  const auto* reclaimer = pool_->reclaimer();
+  return reclaimer == nullptr ? 0 : reclaimer->priority();
+}
+
 uint64_t ArbitrationParticipant::reclaimableUsedCapacity() const {
   const auto maxReclaimableBytes = maxReclaimableCapacity();
   const auto reclaimableBytes = pool_->reclaimableBytes();
@@ -418,6 +423,7 @@ ArbitrationCandidate::ArbitrationCandidate(
     ScopedArbitrationParticipant&& _participant,
     bool freeCapacityOnly)
     : participant(std::move(_participant)),
+      priority(participant->priority()),
       currentCapacity(participant->capacity()),
       reclaimableUsedCapacity(
           freeCapacityOnly ? 0 : participant->reclaimableUsedCapacity()),
@@ -425,8 +431,9 @@ ArbitrationCandidate::ArbitrationCandidate(
 
 std::string ArbitrationCandidate::toString() const {
   return fmt::format(
-      "{} RECLAIMABLE_USED_CAPACITY {} RECLAIMABLE_FREE_CAPACITY {}",
+      "{} PRIORITY {} RECLAIMABLE_USED_CAPACITY {} RECLAIMABLE_FREE_CAPACITY {}",
       participant->name(),
+      priority,
       succinctBytes(reclaimableUsedCapacity),
       succinctBytes(reclaimableFreeCapacity));
 }
@@ -194,6 +194,12 @@ class ArbitrationParticipant
     return pool_;
   }
 
+  /// Returns the priority of the memory reclaimer of the participant's root
+  /// memory pool, or zero if it has no reclaimer. The smaller the number, the
+  /// higher the priority. Used by the arbitrator to reclaim from and abort the
+  /// participants of lower priority first.
+  int32_t priority() const;
+
   /// Returns the current capacity of the query memory pool.
   uint64_t capacity() const {
     return pool_->capacity();
@@ -411,6 +417,7 @@ class ScopedArbitrationParticipant {
 /// decisions.
 struct ArbitrationCandidate {
   ScopedArbitrationParticipant participant;
+  int32_t priority{0};
   int64_t currentCapacity{0};
   int64_t reclaimableUsedCapacity{0};
   int64_t reclaimableFreeCapacity{0};
@@ -293,6 +293,10 @@ void ByteOutputStream::seekp(std::streampos position) {
 
 void ByteOutputStream::flush(OutputStream* out) {
   updateEnd();
+  // The ranges are referenced instead of copied if 'out' keeps 'arena_' alive.
+  auto* iobufOut = dynamic_cast<IOBufOutputStream*>(out);
+  const bool reference = iobufOut != nullptr && arena_ != nullptr &&
+      iobufOut->sourceArena().get() == arena_;
   for (int32_t i = 0; i < ranges_.size(); ++i) {
     int32_t count = i == ranges_.size() - 1 ? lastRangeEnd_ : ranges_[i].size;
     int32_t bytes = isBits_ ? bits::nbytes(count) : count;
@@ -302,7 +306,12 @@ void ByteOutputStream::flush(OutputStream* out) {
     if (isBits_ && isReverseBitOrder_ && !isReversed_) {
       bits::reverseBits(ranges_[i].buffer, bytes);
     }
-    out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    if (reference && bytes >= IOBufOutputStream::kMinReferencedRangeBytes) {
+      iobufOut->appendSourceRange(
+          reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    } else {
+      out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    }
   }
   if (isBits_ && isNegateBits_) {
     isNegated_ = true;
@@ -430,33 +439,100 @@ void freeFunc(void* /*data*/, void* userData) {
 }
 } // namespace
 
+void IOBufOutputStream::append(std::unique_ptr<folly::IOBuf> iobuf) {
+  const int64_t offset = out_->tellp();
+  VELOX_CHECK(appended_.empty() || appended_.back().offset <= offset);
+  int64_t size = 0;
+  for (auto range : *iobuf) {
+    if (listener_) {
+      listener_->onWrite(
+          reinterpret_cast<const char*>(range.data()), range.size());
+    }
+    size += range.size();
+  }
+  appendedBytes_ += size;
+  appended_.push_back({offset, size, std::move(iobuf)});
+}
+
+void IOBufOutputStream::appendSourceRange(char* data, int32_t size) {
+  VELOX_CHECK_NOT_NULL(sourceArena_);
+  append(folly::IOBuf::takeOwnership(
+      data, size, freeFunc, newFreeData(sourceArena_, nullptr)));
+}
+
 std::unique_ptr<folly::IOBuf> IOBufOutputStream::getIOBuf(
     const std::function<void()>& releaseFn) {
-  // Make an IOBuf for each range. The IOBufs keep shared ownership of
-  // 'arena_'.
+  // Make an IOBuf for each range and for each piece of a range between
+  // appended IOBufs. The IOBufs keep shared ownership of 'arena_'.
   std::unique_ptr<folly::IOBuf> iobuf;
-  auto& ranges = out_->ranges();
-  for (auto& range : ranges) {
-    auto numValues =
-        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
-    auto userData = newFreeData(arena_, releaseFn);
-    auto newBuf = folly::IOBuf::takeOwnership(
-        reinterpret_cast<char*>(range.buffer), numValues, freeFunc, userData);
+  auto addToChain = [&](std::unique_ptr<folly::IOBuf> newBuf) {
     if (iobuf) {
       iobuf->prev()->appendChain(std::move(newBuf));
     } else {
       iobuf = std::move(newBuf);
     }
+  };
+  auto addRange = [&](uint8_t* data, int64_t size) {
+    auto userData = newFreeData(arena_, releaseFn);
+    addToChain(folly::IOBuf::takeOwnership(
+        reinterpret_cast<char*>(data), size, freeFunc, userData));
+  };
+  auto appendedIt = appended_.begin();
+  int64_t rangeOffset = 0;
+  auto& ranges = out_->ranges();
+  for (auto& range : ranges) {
+    const int64_t numValues =
+        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+    int64_t begin = 0;
+    for (; appendedIt != appended_.end() &&
+         appendedIt->offset <= rangeOffset + numValues;
+         ++appendedIt) {
+      const auto end = appendedIt->offset - rangeOffset;
+      if (end > begin) {
+        addRange(range.buffer + begin, end - begin);
+      }
+      begin = end;
+      addToChain(std::move(appendedIt->iobuf));
+    }
+    if (numValues > begin || (begin == 0 && !iobuf)) {
+      addRange(range.buffer + begin, numValues - begin);
+    }
+    rangeOffset += numValues;
+  }
+  for (; appendedIt != appended_.end(); ++appendedIt) {
+    addToChain(std::move(appendedIt->iobuf));
   }
+  appended_.clear();
+  appendedBytes_ = 0;
   return iobuf;
 }
 
 std::streampos IOBufOutputStream::tellp() const {
-  return out_->tellp();
+  const int64_t position = out_->tellp();
+  if (appended_.empty() || appended_.back().offset <= position) {
+    return position + appendedBytes_;
+  }
+  int64_t appendedBefore = 0;
+  for (const auto& appended : appended_) {
+    if (appended.offset > position) {
+      break;
+    }
+    appendedBefore += appended.size;
+  }
+  return position + appendedBefore;
 }
 
 void IOBufOutputStream::seekp(std::streampos pos) {
-  out_->seekp(pos);
+  int64_t appendedBefore = 0;
+  for (const auto& appended : appended_) {
+    const int64_t start = appended.offset + appendedBefore;
+    if (pos < start + appended.size) {
+      VELOX_CHECK_LE(pos, start, "Cannot seek into appended bytes");
+      break;
+    }
+    appendedBefore += appended.size;
+  }
+  out_->seekp(static_cast<int64_t>(pos) - appendedBefore);
 }
 
 } // namespace facebook::velox
@@ -559,13 +559,22 @@ class AppendWindow {
 
 class IOBufOutputStream : public OutputStream {
  public:
+  /// Ranges smaller than this are copied even if they could be referenced.
+  static constexpr int32_t kMinReferencedRangeBytes = 1'024;
+
+  /// If 'sourceArena' is set, ByteOutputStream::flush() of a stream allocated
+  /// from 'sourceArena' references its ranges from the resulting IOBuf instead
+  /// of copying them. The IOBufs keep shared ownership of 'sourceArena', which
+  /// must not be cleared or written to after the flush.
   explicit IOBufOutputStream(
       memory::MemoryPool& pool,
       OutputStreamListener* listener = nullptr,
-      int32_t initialSize = memory::AllocationTraits::kPageSize)
+      int32_t initialSize = memory::AllocationTraits::kPageSize,
+      std::shared_ptr<StreamArena> sourceArena = nullptr)
       : OutputStream(listener),
         arena_(std::make_shared<StreamArena>(&pool)),
-        out_(std::make_unique<ByteOutputStream>(arena_.get())) {
+        out_(std::make_unique<ByteOutputStream>(arena_.get())),
+        sourceArena_(std::move(sourceArena)) {
     out_->startWrite(initialSize);
   }
 
@@ -580,13 +589,36 @@ class IOBufOutputStream : public OutputStream {
 
   void seekp(std::streampos pos) override;
 
+  /// Appends the bytes of 'iobuf' at the current position without copying
+  /// them. The bytes are reported to the listener. A later seekp() may not go
+  /// into the appended bytes.
+  void append(std::unique_ptr<folly::IOBuf> iobuf);
+
+  const std::shared_ptr<StreamArena>& sourceArena() const {
+    return sourceArena_;
+  }
+
+  /// Appends 'size' bytes at 'data' in 'sourceArena()' without copying them.
+  void appendSourceRange(char* data, int32_t size);
+
   /// 'releaseFn' is executed on iobuf destruction if not null.
   std::unique_ptr<folly::IOBuf> getIOBuf(
       const std::function<void()>& releaseFn = nullptr);
 
  private:
+  // An IOBuf inserted at 'offset' of 'out_'.
+  struct Appended {
+    int64_t offset;
+    int64_t size;
+    std::unique_ptr<folly::IOBuf> iobuf;
+  };
+
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteOutputStream> out_;
+  const std::shared_ptr<StreamArena> sourceArena_;
+  // In order of 'offset'.
+  std::vector<Appended> appended_;
+  int64_t appendedBytes_{0};
 };
 
 } // namespace facebook::velox
@@ -370,6 +370,17 @@ void HashStringAllocator::removeFromFreeList(Header* header) {
   }
 }
 
+void HashStringAllocator::allocateFreeBlock(Header* header) {
+  --state_.numFree();
+  state_.freeBytes() -= blockBytes(header);
+  removeFromFreeList(header);
+  auto* next = header->next();
+  if (next != nullptr) {
+    next->clearPreviousFree();
+  }
+  state_.currentBytes() += blockBytes(header);
+}
+
 HashStringAllocator::Header* HashStringAllocator::allocate(
     int32_t size,
     bool exactSize) {
@@ -425,14 +436,7 @@ HashStringAllocator::Header* HashStringAllocator::allocateFromFreeList(
   auto* found = headerOf(item);
   VELOX_CHECK(
       found->isFree() && (!mustHaveSize || found->size() >= preferredSize));
-  --state_.numFree();
-  state_.freeBytes() -= blockBytes(found);
-  removeFromFreeList(found);
-  auto* next = found->next();
-  if (next != nullptr) {
-    next->clearPreviousFree();
-  }
-  state_.currentBytes() += blockBytes(found);
+  allocateFreeBlock(found);
   if (isFinalSize) {
     freeRestOfBlock(found, preferredSize);
   }
@@ -765,6 +769,187 @@ int64_t HashStringAllocator::checkConsistency() const {
   return allocatedBytes;
 }
 
+int64_t HashStringAllocator::compact(
+    const std::function<void(Relocator&)>& relocateReferences,
+    int64_t maxBytes) {
+  if (state_.currentHeader() != nullptr || state_.numFree() == 0) {
+    return 0;
+  }
+  static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
+
+  struct Arena {
+    folly::Range<char*> range;
+    int64_t freeBytes{0};
+    int64_t liveBytes{0};
+  };
+  // Arenas that are at least half free, in the same layout as in
+  // checkConsistency().
+  std::vector<Arena> candidates;
+  for (auto i = 0; i < state_.pool().numRanges(); ++i) {
+    const auto topRange = state_.pool().rangeAt(i);
+    const auto topRangeSize = topRange.size();
+    for (int64_t subRangeStart = 0; subRangeStart < topRangeSize;
+         subRangeStart += kHugePageSize) {
+      Arena arena;
+      arena.range = folly::Range<char*>(
+          topRange.data() + subRangeStart,
+          std::min<int64_t>(topRangeSize, kHugePageSize));
+      auto* end = castToHeader(arena.range.end() - simd::kPadding);
+      for (auto* header = castToHeader(arena.range.data()); header != end;
+           header = castToHeader(header->end())) {
+        (header->isFree() ? arena.freeBytes : arena.liveBytes) +=
+            blockBytes(header);
+      }
+      if (arena.liveBytes > 0 && arena.freeBytes >= arena.liveBytes) {
+        candidates.push_back(arena);
+      }
+    }
+  }
+  // Moves the fewest bytes for the most coalesced free space first. The moved
+  // blocks must fit in the free space outside of the compacted arenas. Leaves
+  // half of that free space for rounding and to not fill up the other arenas.
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const auto& lhs, const auto& rhs) {
+        return lhs.liveBytes < rhs.liveBytes;
+      });
+  std::vector<folly::Range<char*>> arenas;
+  int64_t liveBytes = 0;
+  int64_t freeBytes = 0;
+  for (const auto& arena : candidates) {
+    const auto outsideFreeBytes =
+        state_.freeBytes() - freeBytes - arena.freeBytes;
+    if (liveBytes + arena.liveBytes > maxBytes ||
+        2 * (liveBytes + arena.liveBytes) > outsideFreeBytes) {
+      break;
+    }
+    liveBytes += arena.liveBytes;
+    freeBytes += arena.freeBytes;
+    arenas.push_back(arena.range);
+  }
+  if (arenas.empty()) {
+    return 0;
+  }
+  std::sort(arenas.begin(), arenas.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.data() < rhs.data();
+  });
+
+  Relocator relocator(this, std::move(arenas));
+  for (const auto& arena : relocator.arenas_) {
+    auto* end = castToHeader(arena.end() - simd::kPadding);
+    for (auto* header = castToHeader(arena.data()); header != end;
+         header = castToHeader(header->end())) {
+      if (header->isFree()) {
+        allocateFreeBlock(header);
+        relocator.freeBlocks_.push_back(header);
+      }
+    }
+  }
+  relocateReferences(relocator);
+  relocator.finish();
+  return relocator.movedBytes();
+}
+
+bool HashStringAllocator::Relocator::isCompacted(const Header* header) const {
+  const auto* address = reinterpret_cast<const char*>(header);
+  auto it = std::upper_bound(
+      arenas_.begin(),
+      arenas_.end(),
+      address,
+      [](const char* ptr, const auto& arena) { return ptr < arena.data(); });
+  return it != arenas_.begin() && address < (--it)->end();
+}
+
+HashStringAllocator::Header* HashStringAllocator::Relocator::move(
+    Header* header) {
+  if (!isCompacted(header)) {
+    return header;
+  }
+  auto it = moved_.find(header);
+  if (it != moved_.end()) {
+    return it->second;
+  }
+  // Larger blocks can't be allocated with an exact size from the free lists.
+  if (header->size() > kMaxAlloc) {
+    return header;
+  }
+  auto* newHeader =
+      allocator_->allocateFromFreeLists(header->size(), true, true);
+  if (newHeader == nullptr) {
+    return header;
+  }
+  if (newHeader->size() != header->size()) {
+    // The rest of the free block was too small to split off.
+    allocator_->free(newHeader);
+    return header;
+  }
+  ::memcpy(newHeader->begin(), header->begin(), header->size());
+  if (header->isContinued()) {
+    newHeader->setContinued();
+  }
+  moved_.emplace(header, newHeader);
+  movedBytes_ += allocator_->blockBytes(header);
+  return newHeader;
+}
+
+void HashStringAllocator::Relocator::relocate(Header*& header) {
+  Header** reference = &header;
+  for (;;) {
+    auto* part = move(*reference);
+    *reference = part;
+    if (!part->isContinued()) {
+      break;
+    }
+    reference = reinterpret_cast<Header**>(
+        part->end() - Header::kContinuedPtrSize);
+  }
+}
+
+void HashStringAllocator::Relocator::relocate(Position& position) {
+  if (!position.isSet()) {
+    return;
+  }
+  auto it = moved_.find(position.header);
+  if (it != moved_.end()) {
+    position = Position::atOffset(it->second, position.offset());
+  }
+}
+
+void HashStringAllocator::Relocator::relocate(StringView& view) {
+  if (view.isInline()) {
+    return;
+  }
+  auto* header = headerOf(view.data());
+  relocate(header);
+  if (header->begin() != view.data()) {
+    view = StringView(header->begin(), view.size());
+  }
+}
+
+void HashStringAllocator::Relocator::relocate(std::string_view& view) {
+  if (view.empty()) {
+    return;
+  }
+  auto* header = headerOf(view.data());
+  relocate(header);
+  if (header->begin() != view.data()) {
+    view = std::string_view(header->begin(), view.size());
+  }
+}
+
+void HashStringAllocator::Relocator::finish() {
+  for (const auto& entry : moved_) {
+    auto* header = entry.first;
+    // The continued parts are freed separately if moved.
+    header->clearContinued();
+    allocator_->free(header);
+  }
+  for (auto* header : freeBlocks_) {
+    allocator_->free(header);
+  }
+}
+
 bool HashStringAllocator::isEmpty() const {
   return state_.sizeFromPool() == 0 && checkConsistency() == 0;
 }
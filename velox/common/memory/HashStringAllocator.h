@@ -332,6 +332,20 @@ class HashStringAllocator : public StreamArena {
 
   std::string toString() const;
 
+  class Relocator;
+
+  /// Moves the live blocks out of the arenas with the most free space into the
+  /// free space of the other arenas, so that the space left behind coalesces
+  /// into large free blocks. 'relocateReferences' is called with a Relocator
+  /// and must pass to it the references to the allocations of 'this' that may
+  /// be moved. Blocks that are not passed to the Relocator stay in place. At
+  /// most 'maxBytes' of blocks are moved, so that repeated calls compact
+  /// incrementally. Does not allocate new memory from pool(). Returns the
+  /// number of bytes moved.
+  int64_t compact(
+      const std::function<void(Relocator&)>& relocateReferences,
+      int64_t maxBytes);
+
   /// Effectively makes this immutable while executing f, any attempt to access
   /// state_ in a mutable way while f is executing will cause an exception to be
   /// thrown.
@@ -365,6 +379,10 @@ class HashStringAllocator : public StreamArena {
 
   void removeFromFreeList(Header* header);
 
+  // Takes the free block 'header' out of the free lists and marks it
+  // allocated.
+  void allocateFreeBlock(Header* header);
+
   // Allocates a block of specified size. If exactSize is false, the block may
   // be smaller or larger. Checks free list before allocating new memory.
   Header* allocate(int32_t size, bool exactSize);
@@ -644,6 +662,59 @@ class HashStringAllocator::InputStream : public ByteInputStream {
   ByteRange range_;
 };
 
+/// Moves the blocks of the arenas that are compacted by
+/// HashStringAllocator::compact() and updates the references to them. A block
+/// is moved at most once. The moved blocks are freed after all references have
+/// been passed.
+class HashStringAllocator::Relocator {
+ public:
+  /// Moves the parts of the allocation starting at 'header' and updates
+  /// 'header' and the continue pointers of the allocation to the moved parts.
+  void relocate(Header*& header);
+
+  /// Updates 'position' if the part it points into has been moved. Must be
+  /// called after relocate() of the allocation that contains 'position'.
+  void relocate(Position& position);
+
+  /// Relocates a string written by copyMultipart().
+  void relocate(StringView& view);
+
+  /// Relocates 'view' that starts at the beginning of an allocation.
+  void relocate(std::string_view& view);
+
+  int64_t movedBytes() const {
+    return movedBytes_;
+  }
+
+ private:
+  Relocator(
+      HashStringAllocator* allocator,
+      std::vector<folly::Range<char*>> arenas)
+      : allocator_(allocator), arenas_(std::move(arenas)) {}
+
+  // Returns true if 'header' is in one of 'arenas_'.
+  bool isCompacted(const Header* header) const;
+
+  // Returns the new location of 'header'. Moves 'header' if it is in one of
+  // 'arenas_' and there is free space outside of them.
+  Header* move(Header* header);
+
+  // Frees the moved blocks and the free space of 'arenas_'.
+  void finish();
+
+  HashStringAllocator* const allocator_;
+  // The compacted arenas, sorted by address.
+  const std::vector<folly::Range<char*>> arenas_;
+  // The free blocks of 'arenas_', allocated so that no block is moved into
+  // them.
+  std::vector<Header*> freeBlocks_;
+  // Map from moved block to its new location.
+  folly::F14FastMap<Header*, Header*> moved_;
+  int64_t movedBytes_{0};
+
+  friend class HashStringAllocator;
+};
+
 /// Utility for keeping track of allocation between two points in time. A
 /// counter on a row supplied at construction is incremented by the change in
 /// allocation between construction and destruction. This is a scoped guard to
@@ -52,6 +52,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.hugePageSizeClassPages = options.hugePageSizeClassPages;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -95,6 +96,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      poolReservationRetainBytes_(options.poolReservationRetainBytes),
       disableMemoryPoolTracking_(options.disableMemoryPoolTracking),
       getPreferredSize_(options.getPreferredSize),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
@@ -247,6 +249,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.maxCapacity = maxCapacity;
   options.trackUsage = true;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.reservationRetainBytes = poolReservationRetainBytes_;
   options.getPreferredSize = getPreferredSize_;
   options.debugOptions = poolDebugOpts;
 
@@ -76,6 +76,11 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// Max number of unused reservation bytes each leaf memory pool keeps on
+  /// memory free instead of returning them to the query memory pool. See
+  /// MemoryPool::Options::reservationRetainBytes.
+  uint64_t poolReservationRetainBytes{0};
+
   /// Disables the memory manager's tracking on memory pools.
   bool disableMemoryPoolTracking{false};
 
@@ -107,6 +112,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If not zero, the size classes with at least this many machine pages per
+  /// unit are backed by transparent huge pages.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t hugePageSizeClassPages{0};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -308,6 +319,7 @@ class MemoryManager {
   const uint16_t alignment_;
   const bool checkUsageLeak_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t poolReservationRetainBytes_;
   const bool disableMemoryPoolTracking_;
   const std::function<size_t(size_t)> getPreferredSize_;
 
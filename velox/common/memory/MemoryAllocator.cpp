@@ -373,6 +373,8 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numAllocatedPages = numAllocatedPages - other.numAllocatedPages;
+  result.numHugePages = numHugePages - other.numHugePages;
   return result;
 }
 
@@ -387,11 +389,13 @@ std::string Stats::toString() const {
     totalAllocations += sizes[i].numAllocations;
   }
   out << fmt::format(
-      "Alloc: {}MB {} Gigaclocks Allocations={}, advised={} MB\n",
+      "Alloc: {}MB {} Gigaclocks Allocations={}, advised={} MB, "
+      "huge pages={}%\n",
       totalBytes >> 20,
       totalClocks >> 30,
       totalAllocations,
-      numAdvise >> 8);
+      numAdvise >> 8,
+      numAllocatedPages == 0 ? 0 : numHugePages * 100 / numAllocatedPages);
 
   // Sort the size classes by decreasing clocks.
   std::vector<int32_t> indices(sizes.size());
@@ -414,16 +418,16 @@ std::string Stats::toString() const {
   return out.str();
 }
 
-void MemoryAllocator::useHugePages(
+uint64_t MemoryAllocator::useHugePages(
     const ContiguousAllocation& data,
     bool enable) {
 #ifdef linux
   if (!FLAGS_velox_memory_use_hugepages) {
-    return;
+    return 0;
   }
   auto maybeRange = data.hugePageRange();
   if (!maybeRange.has_value()) {
-    return;
+    return 0;
   }
   auto rc = ::madvise(
       maybeRange.value().data(),
@@ -432,7 +436,11 @@ void MemoryAllocator::useHugePages(
   if (rc != 0) {
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
+    return 0;
   }
+  return maybeRange.value().size();
+#else
+  return 0;
 #endif
 }
 
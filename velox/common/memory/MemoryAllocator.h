@@ -136,6 +136,14 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Cumulative count of allocated pages, if the allocator exposes this.
+  int64_t numAllocatedPages{0};
+
+  /// Cumulative count of allocated pages in address ranges advised for
+  /// transparent huge pages. The ratio to 'numAllocatedPages' is the huge page
+  /// hit rate. The kernel may still back some of these with small pages.
+  int64_t numHugePages{0};
 };
 
 class MemoryAllocator;
@@ -481,8 +489,8 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   }
 
   // If 'data' is sufficiently large, enables/disables adaptive  huge pages
-  // for the address range.
-  void useHugePages(const ContiguousAllocation& data, bool enable);
+  // for the address range. Returns the number of bytes advised.
+  uint64_t useHugePages(const ContiguousAllocation& data, bool enable);
 
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
@@ -228,6 +228,7 @@ MemoryPool::MemoryPool(
       threadSafe_(options.threadSafe),
       debugOptions_(options.debugOptions),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationRetainBytes_(options.reservationRetainBytes),
       getPreferredSize_(
           options.getPreferredSize == nullptr
               ? [](size_t size) { return MemoryPool::getPreferredSize(size); }
@@ -452,6 +453,13 @@ MemoryPoolImpl::MemoryPoolImpl(
 
 MemoryPoolImpl::~MemoryPoolImpl() {
   DEBUG_LEAK_CHECK();
+  if (isLeaf() && usedReservationBytes_ == 0 && minReservationBytes_ == 0 &&
+      reservationBytes_ > 0) {
+    // Returns the reservation retained on memory free.
+    VELOX_DCHECK_GT(reservationRetainBytes_, 0);
+    toImpl(parent_)->decrementReservation(reservationBytes_);
+    reservationBytes_ = 0;
+  }
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
   }
@@ -771,6 +779,7 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .reservationRetainBytes = reservationRetainBytes_,
           .getPreferredSize = getPreferredSize,
           .debugOptions = debugOptions_});
 }
@@ -951,7 +960,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationRetainBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -960,7 +969,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = quantizedSize(newCap + reservationRetainBytes_);
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -984,6 +993,32 @@ void MemoryPoolImpl::decrementReservation(uint64_t size) noexcept {
   sanityCheckLocked();
 }
 
+void MemoryPoolImpl::releaseRetainedReservation() {
+  if (!isLeaf()) {
+    visitChildren([](MemoryPool* pool) {
+      toImpl(pool)->releaseRetainedReservation();
+      return true;
+    });
+    return;
+  }
+  // A non thread-safe leaf pool can't be updated from the arbitration thread.
+  if (!trackUsage_ || !threadSafe_) {
+    return;
+  }
+  int64_t freeable;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    freeable = reservationBytes_ -
+        quantizedSize(std::max(minReservationBytes_, usedReservationBytes_));
+    if (freeable > 0) {
+      reservationBytes_ -= freeable;
+    }
+  }
+  if (freeable > 0) {
+    toImpl(parent_)->decrementReservation(freeable);
+  }
+}
+
 std::string MemoryPoolImpl::treeMemoryUsage(bool skipEmptyPool) const {
   if (parent_ != nullptr) {
     return parent_->treeMemoryUsage(skipEmptyPool);
@@ -1097,6 +1132,9 @@ uint64_t MemoryPoolImpl::shrink(uint64_t targetBytes) {
   if (parent_ != nullptr) {
     return toImpl(parent_)->shrink(targetBytes);
   }
+  if (reservationRetainBytes_ > 0) {
+    releaseRetainedReservation();
+  }
   std::lock_guard<std::mutex> l(mutex_);
   // We don't expect to shrink a memory pool without capacity limit.
   VELOX_CHECK_NE(capacity_, kMaxMemory);
@@ -146,6 +146,16 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// failure
     bool coreOnAllocationFailureEnabled{false};
 
+    /// Max number of unused reservation bytes a leaf memory pool keeps on
+    /// memory free instead of returning them to its parent. This avoids
+    /// updating the shared ancestor pools for every allocation that crosses a
+    /// reservation quantum, such as a buffer that is repeatedly allocated and
+    /// freed. The retained reservation is returned on release(), on capacity
+    /// shrink from the memory arbitrator and on pool destruction. Zero
+    /// returns all the unused reservation on free. This is set at the root
+    /// memory pool and applies to all its leaf pools.
+    uint64_t reservationRetainBytes{0};
+
     /// Provides the customized get preferred size function. If not set, uses
     /// the memory pool's default function.
     std::function<size_t(size_t)> getPreferredSize{nullptr};
@@ -547,6 +557,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const std::optional<DebugOptions> debugOptions_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t reservationRetainBytes_;
   std::function<size_t(size_t)> getPreferredSize_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
@@ -884,7 +895,7 @@ class MemoryPoolImpl : public MemoryPool {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationRetainBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -893,7 +904,7 @@ class MemoryPoolImpl : public MemoryPool {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = quantizedSize(newCap + reservationRetainBytes_);
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -907,6 +918,11 @@ class MemoryPoolImpl : public MemoryPool {
   // Decrements the reservation in 'this' and parents.
   void decrementReservation(uint64_t size) noexcept;
 
+  // Returns the reservation retained on memory free by the thread-safe leaf
+  // pools in the subtree of this pool to their parents. See
+  // Options::reservationRetainBytes.
+  void releaseRetainedReservation();
+
   FOLLY_ALWAYS_INLINE void sanityCheckLocked() const {
     if (FOLLY_UNLIKELY(
             (reservationBytes_ < usedReservationBytes_) ||
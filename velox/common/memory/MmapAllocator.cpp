@@ -37,7 +37,11 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size,
+        size,
+        options.hugePageSizeClassPages != 0 &&
+            size >= options.hugePageSizeClassPages));
   }
 
   if (useMmapArena_) {
@@ -107,6 +111,10 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
       // allocation series.
       success = false;
     }
+    if (success && sizeClasses_[sizeMix.sizeIndices[i]]->hugePages()) {
+      numHugePages_ +=
+          sizeClassSizes_[sizeMix.sizeIndices[i]] * sizeMix.sizeCounts[i];
+    }
     if (!success) {
       // This does not normally happen since any size class can accommodate
       // all the capacity. 'allocatedPages_' must be out of sync.
@@ -357,7 +365,10 @@ bool MmapAllocator::allocateContiguousImpl(
       data,
       AllocationTraits::pageBytes(numPages),
       AllocationTraits::pageBytes(maxPages));
-  useHugePages(allocation, true);
+  const auto hugePageBytes = useHugePages(allocation, true);
+  numAllocatedPages_ += numPages;
+  numHugePages_ +=
+      std::min(numPages, AllocationTraits::numPages(hugePageBytes));
   return true;
 }
 
@@ -509,10 +520,16 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool hugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      hugePages_(hugePages),
+      mapByteSize_(
+          byteSize_ + (hugePages_ ? AllocationTraits::kHugePageSize : 0)),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -523,25 +540,34 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
-  void* ptr = mmap(
+  mapAddress_ = mmap(
       nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
+      mapByteSize_,
       PROT_READ | PROT_WRITE,
       MAP_PRIVATE | MAP_ANONYMOUS,
       -1,
       0);
-  if (ptr == MAP_FAILED || ptr == nullptr) {
+  if (mapAddress_ == MAP_FAILED || mapAddress_ == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory "
         "mmap failed with {} for sizeClass {}",
         folly::errnoStr(errno),
         unitSize_);
   }
-  address_ = reinterpret_cast<uint8_t*>(ptr);
+  address_ = reinterpret_cast<uint8_t*>(bits::roundUp(
+      reinterpret_cast<uintptr_t>(mapAddress_),
+      hugePages_ ? AllocationTraits::kHugePageSize
+                 : AllocationTraits::kPageSize));
+#ifdef linux
+  if (hugePages_ && ::madvise(address_, byteSize_, MADV_HUGEPAGE) != 0) {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage for sizeClass " << unitSize_
+                           << " got errno " << folly::errnoStr(errno);
+  }
+#endif
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
-  munmap(address_, byteSize_);
+  munmap(mapAddress_, mapByteSize_);
 }
 ClassPageCount MmapAllocator::SizeClass::checkConsistency(
     ClassPageCount& numMapped,
@@ -66,6 +66,14 @@ class MmapAllocator : public MemoryAllocator {
     /// capacity to single MmapArena capacity ratio.
     int32_t mmapArenaCapacityRatio = 10;
 
+    /// If not zero, the address ranges of the size classes with at least this
+    /// many machine pages per unit are aligned to huge pages and advised for
+    /// transparent huge pages. This cuts the TLB misses on the large
+    /// non-contiguous allocations of hash tables and row containers.
+    /// Contiguous allocations use huge pages if 'velox_memory_use_hugepages'
+    /// is set.
+    int32_t hugePageSizeClassPages = 0;
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'capacity' for ad hoc small allocations. And those allocations are
     /// delegated to std::malloc.
@@ -156,6 +164,8 @@ class MmapAllocator : public MemoryAllocator {
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
+    stats.numAllocatedPages = numAllocatedPages_;
+    stats.numHugePages = numHugePages_;
     return stats;
   }
 
@@ -168,7 +178,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'hugePages' is true, the address range is aligned to huge pages and
+    // advised for transparent huge pages.
+    SizeClass(size_t capacity, MachinePageCount unitSize, bool hugePages);
 
     ~SizeClass();
 
@@ -176,6 +188,10 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    bool hugePages() const {
+      return hugePages_;
+    }
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -276,6 +292,12 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    const bool hugePages_;
+
+    // Size of the mapping that contains the address range. Larger than
+    // 'byteSize_' if the address range is aligned to huge pages.
+    const size_t mapByteSize_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -286,6 +308,9 @@ class MmapAllocator : public MemoryAllocator {
     // Start of address range.
     uint8_t* address_;
 
+    // Start of the mapping that contains the address range.
+    void* mapAddress_;
+
     // Index of last modified word in 'pageAllocated_'. Sweeps over
     // the bitmaps when looking for free pages.
     int32_t clockHand_ = 0;
@@ -414,6 +439,7 @@ class MmapAllocator : public MemoryAllocator {
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  std::atomic<uint64_t> numHugePages_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
@@ -18,6 +18,7 @@
 #include <folly/system/ThreadName.h>
 #include <pthread.h>
 #include <mutex>
+#include <set>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
@@ -236,6 +237,26 @@ double SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
       kDefaultGlobalArbitrationAbortTimeRatio);
 }
 
+uint32_t SharedArbitrator::ExtraConfig::globalArbitrationSoftWatermarkPct(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<uint32_t>(
+      configs,
+      kGlobalArbitrationSoftWatermarkPct,
+      kDefaultGlobalArbitrationSoftWatermarkPct);
+}
+
+uint64_t
+SharedArbitrator::ExtraConfig::globalArbitrationSoftWatermarkCheckIntervalNs(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             config::toDuration(getConfig<std::string>(
+                 configs,
+                 kGlobalArbitrationSoftWatermarkCheckInterval,
+                 std::string(
+                     kDefaultGlobalArbitrationSoftWatermarkCheckInterval))))
+      .count();
+}
+
 SharedArbitrator::SharedArbitrator(const Config& config)
     : MemoryArbitrator(config),
       capacity_(config.capacity),
@@ -265,6 +286,11 @@ SharedArbitrator::SharedArbitrator(const Config& config)
           ExtraConfig::globalArbitrationAbortTimeRatio(config.extraConfigs)),
       globalArbitrationWithoutSpill_(
           ExtraConfig::globalArbitrationWithoutSpill(config.extraConfigs)),
+      globalArbitrationSoftWatermarkPct_(
+          ExtraConfig::globalArbitrationSoftWatermarkPct(config.extraConfigs)),
+      globalArbitrationSoftWatermarkCheckIntervalNs_(
+          ExtraConfig::globalArbitrationSoftWatermarkCheckIntervalNs(
+              config.extraConfigs)),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -276,6 +302,16 @@ SharedArbitrator::SharedArbitrator(const Config& config)
       globalArbitrationMemoryReclaimPct_,
       100,
       "Invalid globalArbitrationMemoryReclaimPct");
+  VELOX_CHECK_LE(
+      globalArbitrationSoftWatermarkPct_,
+      100,
+      "Invalid globalArbitrationSoftWatermarkPct");
+  if (globalArbitrationSoftWatermarkPct_ != 0) {
+    VELOX_CHECK_GT(
+        globalArbitrationSoftWatermarkCheckIntervalNs_,
+        0,
+        "globalArbitrationSoftWatermarkCheckInterval can't be zero");
+  }
 
   VELOX_CHECK_GT(
       memoryReclaimThreadsHwMultiplier_,
@@ -305,7 +341,9 @@ SharedArbitrator::SharedArbitrator(const Config& config)
                         << ", global arbitration abort time ratio "
                         << globalArbitrationAbortTimeRatio_
                         << ", global arbitration skip spill "
-                        << globalArbitrationWithoutSpill_;
+                        << globalArbitrationWithoutSpill_
+                        << ", global arbitration soft watermark percentage "
+                        << globalArbitrationSoftWatermarkPct_;
   }
   VELOX_MEM_LOG(INFO) << "Memory pool participant config: "
                       << participantConfig_.toString();
@@ -538,6 +576,9 @@ void SharedArbitrator::sortCandidatesByReclaimableUsedCapacity(
       candidates.begin(),
       candidates.end(),
       [](const ArbitrationCandidate& lhs, const ArbitrationCandidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority > rhs.priority;
+        }
         return lhs.reclaimableUsedCapacity > rhs.reclaimableUsedCapacity;
       });
 
@@ -561,30 +602,41 @@ std::optional<ArbitrationCandidate> SharedArbitrator::findAbortCandidate(
     return std::nullopt;
   }
 
-  for (uint64_t capacityLimit : globalArbitrationAbortCapacityLimits_) {
-    int32_t candidateIdx{-1};
-    for (int32_t i = 0; i < candidates.size(); ++i) {
-      if (candidates[i].participant->aborted()) {
-        continue;
-      }
-      if (candidates[i].currentCapacity < capacityLimit ||
-          candidates[i].currentCapacity == 0) {
-        continue;
-      }
-      if (candidateIdx == -1) {
-        candidateIdx = i;
-        continue;
+  // Aborts from the lowest priority class first. A larger priority number
+  // means a lower priority.
+  std::set<int32_t, std::greater<int32_t>> priorities;
+  for (const auto& candidate : candidates) {
+    priorities.insert(candidate.priority);
+  }
+  for (const int32_t priority : priorities) {
+    for (uint64_t capacityLimit : globalArbitrationAbortCapacityLimits_) {
+      int32_t candidateIdx{-1};
+      for (int32_t i = 0; i < candidates.size(); ++i) {
+        if (candidates[i].priority != priority) {
+          continue;
+        }
+        if (candidates[i].participant->aborted()) {
+          continue;
+        }
+        if (candidates[i].currentCapacity < capacityLimit ||
+            candidates[i].currentCapacity == 0) {
+          continue;
+        }
+        if (candidateIdx == -1) {
+          candidateIdx = i;
+          continue;
+        }
+        // With the same capacity size bucket, we favor the old participant to
+        // not to be killed, to let long running query proceed first.
+        if (candidates[candidateIdx].participant->id() <
+            candidates[i].participant->id()) {
+          candidateIdx = i;
+        }
       }
-      // With the same capacity size bucket, we favor the old participant to not
-      // to be killed, to let long running query proceed first.
-      if (candidates[candidateIdx].participant->id() <
-          candidates[i].participant->id()) {
-        candidateIdx = i;
+      if (candidateIdx != -1) {
+        return candidates[candidateIdx];
       }
     }
-    if (candidateIdx != -1) {
-      return candidates[candidateIdx];
-    }
   }
 
   if (!force) {
@@ -593,11 +645,16 @@ std::optional<ArbitrationCandidate> SharedArbitrator::findAbortCandidate(
   }
 
   // Can't find an eligible abort candidate and then return the youngest
-  // candidate which has the largest participant id.
+  // candidate of the lowest priority class which has the largest participant
+  // id.
   int32_t candidateIdx{-1};
   for (auto i = 0; i < candidates.size(); ++i) {
     if (candidateIdx == -1) {
       candidateIdx = i;
+    } else if (candidates[i].priority != candidates[candidateIdx].priority) {
+      if (candidates[i].priority > candidates[candidateIdx].priority) {
+        candidateIdx = i;
+      }
     } else if (
         candidates[i].participant->id() >
         candidates[candidateIdx].participant->id()) {
@@ -896,18 +953,39 @@ void SharedArbitrator::updateGlobalArbitrationStats(
 void SharedArbitrator::globalArbitrationMain() {
   VELOX_MEM_LOG(INFO) << "Global arbitration controller started";
   while (true) {
+    bool softWatermarkReclaim{false};
     {
       std::unique_lock<std::mutex> l(stateMutex_);
-      globalArbitrationThreadCv_.wait(l, [&] {
+      const auto wakeup = [&] {
         return hasShutdownLocked() || !globalArbitrationWaiters_.empty();
-      });
+      };
+      if (globalArbitrationSoftWatermarkPct_ == 0) {
+        globalArbitrationThreadCv_.wait(l, wakeup);
+      } else {
+        // Wakes up periodically to check the soft watermark.
+        globalArbitrationThreadCv_.wait_for(
+            l,
+            std::chrono::nanoseconds(
+                globalArbitrationSoftWatermarkCheckIntervalNs_),
+            wakeup);
+      }
       if (hasShutdownLocked()) {
         VELOX_CHECK(globalArbitrationWaiters_.empty());
         break;
       }
+      if (globalArbitrationWaiters_.empty()) {
+        if (getSoftWatermarkReclaimTargetLocked() == 0) {
+          continue;
+        }
+        softWatermarkReclaim = true;
+      }
     }
     GlobalArbitrationSection section{this};
-    runGlobalArbitration();
+    if (softWatermarkReclaim) {
+      runSoftWatermarkReclaim();
+    } else {
+      runGlobalArbitration();
+    }
   }
   VELOX_MEM_LOG(INFO) << "Global arbitration controller stopped";
 }
@@ -975,6 +1053,53 @@ void SharedArbitrator::runGlobalArbitration() {
                       << " with " << round << " rounds";
 }
 
+uint64_t SharedArbitrator::getSoftWatermarkReclaimTargetLocked() const {
+  if (globalArbitrationSoftWatermarkPct_ == 0 ||
+      globalArbitrationWithoutSpill_) {
+    return 0;
+  }
+  const uint64_t usedCapacity =
+      capacity_ - freeNonReservedCapacity_ - freeReservedCapacity_;
+  const uint64_t softWatermark =
+      capacity_ * globalArbitrationSoftWatermarkPct_ / 100;
+  return usedCapacity > softWatermark ? usedCapacity - softWatermark : 0;
+}
+
+void SharedArbitrator::runSoftWatermarkReclaim() {
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::runSoftWatermarkReclaim",
+      this);
+
+  uint64_t reclaimTimeNs{0};
+  uint64_t reclaimedBytes{0};
+  {
+    NanosecondTimer timer(&reclaimTimeNs);
+    // Frees up the unused capacity first which doesn't need to spill.
+    reclaimUnusedCapacity();
+    uint64_t targetBytes;
+    {
+      std::lock_guard<std::mutex> l(stateMutex_);
+      targetBytes = getSoftWatermarkReclaimTargetLocked();
+    }
+    if (targetBytes != 0) {
+      reclaimedBytes = reclaimUsedMemoryBySpill(targetBytes);
+      reclaimUnusedCapacity();
+    }
+  }
+  if (reclaimedBytes == 0) {
+    return;
+  }
+  softWatermarkReclaimedBytes_ += reclaimedBytes;
+  softWatermarkReclaimTimeNs_ += reclaimTimeNs;
+  RECORD_METRIC_VALUE(
+      kMetricArbitratorSoftWatermarkReclaimedBytes, reclaimedBytes);
+  RECORD_METRIC_VALUE(
+      kMetricArbitratorSoftWatermarkReclaimTimeMs, reclaimTimeNs / 1'000'000);
+  VELOX_MEM_LOG(INFO) << "Soft watermark reclaim reclaimed "
+                      << succinctBytes(reclaimedBytes) << ", spent "
+                      << succinctNanos(reclaimTimeNs);
+}
+
 uint64_t SharedArbitrator::getGlobalArbitrationTarget() {
   uint64_t targetBytes{0};
   std::lock_guard<std::mutex> l(stateMutex_);
@@ -1127,7 +1252,8 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   for (auto& candidate : candidates) {
     if (candidate.reclaimableUsedCapacity <
         participantConfig_.minReclaimBytes) {
-      break;
+      // The candidates are only sorted by capacity within a priority class.
+      continue;
     }
     if (failedParticipants.count(candidate.participant->id()) != 0) {
       VELOX_CHECK_EQ(
@@ -1249,6 +1375,12 @@ uint64_t SharedArbitrator::reclaim(
 
   updateMemoryReclaimStats(
       reclaimedBytes, reclaimTimeNs, localArbitration, stats);
+  {
+    std::lock_guard<std::mutex> l(priorityStatsMutex_);
+    auto& priorityStats = priorityStats_[participant->priority()];
+    ++priorityStats.numReclaims;
+    priorityStats.reclaimedBytes += reclaimedBytes;
+  }
   VELOX_MEM_LOG(INFO) << "Reclaimed from memory pool " << participant->name()
                       << " with target of " << succinctBytes(targetBytes)
                       << ", reclaimed " << succinctBytes(reclaimedBytes)
@@ -1290,6 +1422,10 @@ uint64_t SharedArbitrator::abort(
     const std::exception_ptr& error) {
   RECORD_METRIC_VALUE(kMetricArbitratorAbortedCount);
   ++numAborted_;
+  {
+    std::lock_guard<std::mutex> l(priorityStatsMutex_);
+    ++priorityStats_[participant->priority()].numAborted;
+  }
   const uint64_t freedBytes = participant->abort(error);
   // NOTE: no matter memory pool abort throws or not, it should have been
   // marked as aborted to prevent any new memory arbitration triggered from
@@ -1396,6 +1532,12 @@ MemoryArbitrator::Stats SharedArbitrator::statsLocked() const {
   return stats;
 }
 
+std::map<int32_t, SharedArbitrator::PriorityStats>
+SharedArbitrator::priorityStats() const {
+  std::lock_guard<std::mutex> l(priorityStatsMutex_);
+  return priorityStats_;
+}
+
 std::string SharedArbitrator::toString() const {
   std::lock_guard<std::mutex> l(stateMutex_);
   return fmt::format(
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <map>
 #include <shared_mutex>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
@@ -226,6 +227,30 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If not zero, specifies the soft watermark of the used arbitrator
+    /// capacity as percentage of the total capacity. When the used capacity
+    /// exceeds the watermark, the global arbitration controller reclaims memory
+    /// at the background until the used capacity drops below it. This lets
+    /// most of the capacity growth requests be satisfied from the free capacity
+    /// without waiting for spilling. It is only in effect when
+    /// 'global-arbitration-enabled' is true and
+    /// 'global-arbitration-without-spill' is false.
+    static constexpr std::string_view kGlobalArbitrationSoftWatermarkPct{
+        "global-arbitration-soft-watermark-pct"};
+    static constexpr uint32_t kDefaultGlobalArbitrationSoftWatermarkPct{0};
+    static uint32_t globalArbitrationSoftWatermarkPct(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// The interval at which the global arbitration controller checks the used
+    /// capacity against 'global-arbitration-soft-watermark-pct'.
+    static constexpr std::string_view
+        kGlobalArbitrationSoftWatermarkCheckInterval{
+            "global-arbitration-soft-watermark-check-interval"};
+    static constexpr std::string_view
+        kDefaultGlobalArbitrationSoftWatermarkCheckInterval{"1s"};
+    static uint64_t globalArbitrationSoftWatermarkCheckIntervalNs(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -266,6 +291,25 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   std::string toString() const final;
 
+  /// The memory reclaim stats of the participants with the same priority.
+  struct PriorityStats {
+    /// The number of times memory is reclaimed by spilling.
+    uint64_t numReclaims{0};
+    /// The used memory bytes reclaimed by spilling.
+    uint64_t reclaimedBytes{0};
+    /// The number of aborted participants.
+    uint64_t numAborted{0};
+
+    bool operator==(const PriorityStats& other) const {
+      return numReclaims == other.numReclaims &&
+          reclaimedBytes == other.reclaimedBytes &&
+          numAborted == other.numAborted;
+    }
+  };
+
+  /// Returns the memory reclaim stats keyed by participant priority.
+  std::map<int32_t, PriorityStats> priorityStats() const;
+
   /// Operator level runtime stats reported for an arbitration operation
   /// execution.
   static inline const std::string kMemoryArbitrationWallNanos{
@@ -402,6 +446,16 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // Invoked by global arbitration control thread to run global arbitration.
   void runGlobalArbitration();
 
+  // Returns the used capacity in bytes above the soft watermark, or zero if the
+  // soft watermark is not set or not exceeded. The function must be called
+  // with 'stateMutex_' held.
+  uint64_t getSoftWatermarkReclaimTargetLocked() const;
+
+  // Invoked by global arbitration control thread to reclaim used memory by
+  // spilling when there is no arbitration waiter but the used capacity is above
+  // the soft watermark.
+  void runSoftWatermarkReclaim();
+
   // Helper method used by 'runGlobalArbitration()' to decide if current
   // iteration of global run should directly reclaim capacity by aborting
   // queries.
@@ -457,9 +511,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // if need to switch to abort to reclaim used memory in the next arbitration
   // round. The function returns the actually reclaimed used capacity in bytes.
   //
-  // NOTE: the function sorts participants based on their reclaimable used
-  // memory capacity, and reclaims from participants with larger reclaimable
-  // used memory first.
+  // NOTE: the function sorts participants based on their priority and
+  // reclaimable used memory capacity, and reclaims from participants with lower
+  // priority and larger reclaimable used memory first.
   uint64_t reclaimUsedMemoryBySpill(
       uint64_t targetBytes,
       std::unordered_set<uint64_t>& reclaimedParticipants,
@@ -468,7 +522,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   uint64_t reclaimUsedMemoryBySpill(uint64_t targetBytes);
 
-  // Sorts 'candidates' based on reclaimable used capacity in descending order.
+  // Sorts 'candidates' from the lowest to the highest priority, and based on
+  // reclaimable used capacity in descending order within the same priority.
   static void sortCandidatesByReclaimableUsedCapacity(
       std::vector<ArbitrationCandidate>& candidates);
 
@@ -481,9 +536,10 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   uint64_t reclaimUsedMemoryByAbort(bool force);
 
   // Finds the participant victim to abort to free used memory based on the
-  // participant's memory capacity and age. The function returns std::nullopt if
-  // there is no eligible candidate. If 'force' is true, it picks up the
-  // youngest participant to abort if there is no eligible one.
+  // participant's priority, memory capacity and age. Participants with lower
+  // priority are aborted first. The function returns std::nullopt if there is
+  // no eligible candidate. If 'force' is true, it picks up the youngest
+  // participant of the lowest priority to abort if there is no eligible one.
   std::optional<ArbitrationCandidate> findAbortCandidate(bool force);
 
   // Invoked to use free capacity from arbitrator to grow participant's
@@ -607,6 +663,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   const uint32_t globalArbitrationMemoryReclaimPct_;
   const double globalArbitrationAbortTimeRatio_;
   const bool globalArbitrationWithoutSpill_;
+  const uint32_t globalArbitrationSoftWatermarkPct_;
+  const uint64_t globalArbitrationSoftWatermarkCheckIntervalNs_;
 
   // The executor used to reclaim memory from multiple participants in parallel
   // at the background for global arbitration or external memory reclamation.
@@ -662,6 +720,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> globalArbitrationTimeNs_{0};
   tsan_atomic<uint64_t> globalArbitrationBytes_{0};
 
+  tsan_atomic<uint64_t> softWatermarkReclaimedBytes_{0};
+  tsan_atomic<uint64_t> softWatermarkReclaimTimeNs_{0};
+
   std::atomic_uint64_t numRequests_{0};
   std::atomic_uint32_t numRunning_{0};
   std::atomic_uint64_t numAborted_{0};
@@ -670,6 +731,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   std::atomic_uint64_t reclaimedUsedBytes_{0};
   std::atomic_uint64_t numNonReclaimableAttempts_{0};
 
+  mutable std::mutex priorityStatsMutex_;
+  std::map<int32_t, PriorityStats> priorityStats_;
+
   friend class GlobalArbitrationSection;
   friend class test::SharedArbitratorTestHelper;
 };
@@ -1581,7 +1581,7 @@ TEST_F(ArbitrationParticipantTest, arbitrationCandidate) {
   ASSERT_EQ(candidateWithFreeCapacityOnly.reclaimableFreeCapacity, 31 << 20);
   ASSERT_EQ(
       candidateWithFreeCapacityOnly.toString(),
-      "TaskPool-0 RECLAIMABLE_USED_CAPACITY 0B RECLAIMABLE_FREE_CAPACITY 31.00MB");
+      "TaskPool-0 PRIORITY 0 RECLAIMABLE_USED_CAPACITY 0B RECLAIMABLE_FREE_CAPACITY 31.00MB");
 
   ArbitrationCandidate candidate(
       participant->lock().value(), /*freeCapacityOnly=*/false);
@@ -1590,7 +1590,7 @@ TEST_F(ArbitrationParticipantTest, arbitrationCandidate) {
   ASSERT_EQ(candidate.reclaimableFreeCapacity, 31 << 20);
   ASSERT_EQ(
       candidate.toString(),
-      "TaskPool-0 RECLAIMABLE_USED_CAPACITY 1.00MB RECLAIMABLE_FREE_CAPACITY 31.00MB");
+      "TaskPool-0 PRIORITY 0 RECLAIMABLE_USED_CAPACITY 1.00MB RECLAIMABLE_FREE_CAPACITY 31.00MB");
 }
 
 TEST_F(ArbitrationParticipantTest, arbitrationOperation) {
@@ -137,6 +137,54 @@ TEST_F(ByteStreamTest, outputStream) {
   EXPECT_EQ(0, mmapAllocator_->numAllocated());
 }
 
+TEST_F(ByteStreamTest, sourceArenaOutputStream) {
+  std::shared_ptr<StreamArena> arena = newArena();
+  auto source = std::make_unique<ByteOutputStream>(arena.get());
+  source->startWrite(0);
+  std::string expected;
+  for (auto i = 0; i < 100; ++i) {
+    std::string data(1'000, 'a' + i % 26);
+    source->appendStringView(data);
+    expected += data;
+  }
+  const auto numPages = mmapAllocator_->numAllocated();
+
+  auto out = std::make_unique<IOBufOutputStream>(*pool_, nullptr, 1'000, arena);
+  const std::string header(8, 'h');
+  out->write(header.data(), header.size());
+  source->flush(out.get());
+  out->write(header.data(), header.size());
+  expected = header + expected + header;
+  EXPECT_EQ(expected.size(), out->tellp());
+
+  // Overwrites the first header and keeps writing at the end.
+  out->seekp(0);
+  out->write("H", 1);
+  expected[0] = 'H';
+  VELOX_ASSERT_THROW(out->seekp(100), "Cannot seek into appended bytes");
+  out->seekp(expected.size());
+  out->write("t", 1);
+  expected += 't';
+  EXPECT_EQ(expected.size(), out->tellp());
+
+  auto iobuf = out->getIOBuf();
+  // The ranges of 'arena' are referenced and not copied.
+  EXPECT_LT(
+      mmapAllocator_->numAllocated() - numPages,
+      expected.size() / AllocationTraits::kPageSize);
+  EXPECT_GT(iobuf->countChainElements(), 2);
+  source = nullptr;
+  out = nullptr;
+  arena = nullptr;
+  auto data = iobuf->clone()->coalesce();
+  EXPECT_EQ(
+      expected,
+      std::string(reinterpret_cast<const char*>(data.data()), data.size()));
+
+  iobuf = nullptr;
+  EXPECT_EQ(0, mmapAllocator_->numAllocated());
+}
+
 TEST_F(ByteStreamTest, bufferedOutputStream) {
   auto arena = newArena();
   auto out = std::make_unique<IOBufOutputStream>(*pool_, nullptr, 10000);
@@ -815,5 +815,60 @@ TEST_F(HashStringAllocatorTest, inputStream) {
   ASSERT_EQ(in.tellp(), in.size());
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  constexpr int32_t kNumStrings = 10'000;
+  std::vector<std::string> strings;
+  std::vector<StringView> views(kNumStrings + 1);
+  for (auto i = 0; i < kNumStrings; ++i) {
+    strings.push_back(std::string(20 + i % 50, 'a' + i % 26));
+  }
+  // A string that spans several arenas.
+  strings.push_back(std::string(200'000, 'z'));
+  for (auto i = 0; i < strings.size(); ++i) {
+    allocator_->copyMultipart(
+        StringView(strings[i]), reinterpret_cast<char*>(&views[i]), 0);
+  }
+  // Frees 9 out of 10 short strings.
+  std::vector<StringView> liveViews;
+  std::vector<std::string> liveStrings;
+  for (auto i = 0; i < views.size(); ++i) {
+    if (i % 10 == 0 || i == kNumStrings) {
+      liveViews.push_back(views[i]);
+      liveStrings.push_back(strings[i]);
+    } else {
+      allocator_->free(HSA::headerOf(views[i].data()));
+    }
+  }
+
+  const auto retainedSize = allocator_->retainedSize();
+  const auto freeSpace = allocator_->freeSpace();
+  const auto relocateAll = [&](HSA::Relocator& relocator) {
+    for (auto& view : liveViews) {
+      relocator.relocate(view);
+    }
+  };
+  // Only moves blocks that are passed to the relocator.
+  ASSERT_EQ(allocator_->compact([](HSA::Relocator&) {}, 1 << 20), 0);
+  ASSERT_EQ(allocator_->freeSpace(), freeSpace);
+
+  int64_t movedBytes = allocator_->compact(relocateAll, 10'000);
+  ASSERT_GT(movedBytes, 0);
+  ASSERT_LE(movedBytes, 10'000);
+  movedBytes += allocator_->compact(relocateAll, 1 << 20);
+  ASSERT_GT(movedBytes, 10'000);
+  ASSERT_GT(allocator_->freeSpace(), freeSpace);
+  ASSERT_EQ(allocator_->retainedSize(), retainedSize);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  std::string storage;
+  for (auto i = 0; i < liveViews.size(); ++i) {
+    ASSERT_EQ(
+        HSA::contiguousString(liveViews[i], storage),
+        StringView(liveStrings[i]));
+    allocator_->free(HSA::headerOf(liveViews[i].data()));
+  }
+  ASSERT_TRUE(allocator_->isEmpty());
+}
+
 } // namespace
 } // namespace facebook::velox
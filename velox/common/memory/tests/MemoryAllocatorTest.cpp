@@ -1991,4 +1991,36 @@ TEST_F(MmapConfigTest, sizeClasses) {
   }
 }
 
+TEST(MmapAllocatorHugePageTest, sizeClasses) {
+  MmapAllocator::Options options;
+  options.capacity = 64 << 20;
+  options.maxMallocBytes = 0;
+  options.hugePageSizeClassPages = 64;
+  MmapAllocator allocator(options);
+
+  Allocation large;
+  ASSERT_TRUE(allocator.allocateNonContiguous(256, large));
+  ASSERT_EQ(large.numRuns(), 1);
+  // The runs of a huge page size class are aligned to their size from the
+  // huge page aligned start of the class.
+  ASSERT_EQ(
+      reinterpret_cast<uintptr_t>(large.runAt(0).data()) %
+          AllocationTraits::pageBytes(256),
+      0);
+  auto stats = allocator.stats();
+  ASSERT_EQ(stats.numAllocatedPages, 256);
+  ASSERT_EQ(stats.numHugePages, 256);
+
+  Allocation small;
+  ASSERT_TRUE(allocator.allocateNonContiguous(3, small));
+  stats = allocator.stats();
+  ASSERT_EQ(stats.numAllocatedPages, 259);
+  ASSERT_EQ(stats.numHugePages, 256);
+  ASSERT_NE(stats.toString().find("huge pages=98%"), std::string::npos);
+
+  allocator.freeNonContiguous(large);
+  allocator.freeNonContiguous(small);
+  ASSERT_EQ((allocator.stats() - stats).numHugePages, 0);
+}
+
 } // namespace facebook::velox::memory
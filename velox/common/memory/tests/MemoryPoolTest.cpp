@@ -3554,6 +3554,64 @@ TEST_P(MemoryPoolTest, maybeReserveFailWithAbort) {
       child->maybeReserve(2 * kMaxSize), "Manual MemoryPool Abortion");
 }
 
+TEST_P(MemoryPoolTest, reservationRetain) {
+  constexpr int64_t kMaxSize = 1 * GB;
+  setupMemory(
+      {.poolReservationRetainBytes = 2 * MB,
+       .allocatorCapacity = kMaxSize,
+       .arbitratorCapacity = kMaxSize,
+       .extraArbitratorConfigs = {
+           {std::string(SharedArbitrator::ExtraConfig::kReservedCapacity),
+            folly::to<std::string>(kMaxSize / 8) + "B"}}});
+  auto root = getMemoryManager()->addRootPool("reservationRetain", kMaxSize);
+  auto child = root->addLeafChild("reservationRetain", isLeafThreadSafe_);
+
+  void* buffer = child->allocate(MB + 1);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  child->free(buffer, MB + 1);
+  // The reservation is kept on free.
+  ASSERT_EQ(child->usedBytes(), 0);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * MB);
+
+  // An allocation within the retained reservation doesn't reserve more.
+  buffer = child->allocate(2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  child->free(buffer, 2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+
+  // Only up to the retain bytes are kept on free.
+  buffer = child->allocate(8 * MB);
+  ASSERT_EQ(child->reservedBytes(), 8 * MB);
+  ASSERT_EQ(root->reservedBytes(), 8 * MB);
+  child->free(buffer, 8 * MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * MB);
+
+  buffer = child->allocate(2 * MB);
+  void* otherBuffer = child->allocate(MB);
+  ASSERT_EQ(child->reservedBytes(), 3 * MB);
+  child->free(otherBuffer, MB);
+  ASSERT_EQ(child->reservedBytes(), 3 * MB);
+  // release() returns the retained reservation.
+  child->release();
+  ASSERT_EQ(child->usedBytes(), 2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * MB);
+  child->free(buffer, 2 * MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+
+  // Capacity shrink returns the reservation retained by the thread-safe leaf
+  // pools.
+  root->shrink(0);
+  ASSERT_EQ(child->reservedBytes(), isLeafThreadSafe_ ? 0 : 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), isLeafThreadSafe_ ? 0 : 2 * MB);
+
+  // The pool destruction returns the retained reservation.
+  child.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 DEBUG_ONLY_TEST_P(MemoryPoolTest, raceBetweenFreeAndFailedAllocation) {
   if (!isLeafThreadSafe_) {
     return;
@@ -92,12 +92,13 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
-    MemoryReclaimer(const std::shared_ptr<MockTask>& task)
-        : memory::MemoryReclaimer(0), task_(task) {}
+    MemoryReclaimer(const std::shared_ptr<MockTask>& task, int32_t priority)
+        : memory::MemoryReclaimer(priority), task_(task) {}
 
     static std::unique_ptr<MemoryReclaimer> create(
-        const std::shared_ptr<MockTask>& task) {
-      return std::make_unique<MemoryReclaimer>(task);
+        const std::shared_ptr<MockTask>& task,
+        int32_t priority = 0) {
+      return std::make_unique<MemoryReclaimer>(task, priority);
     }
 
     void abort(MemoryPool* pool, const std::exception_ptr& error) override {
@@ -113,11 +114,14 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
     std::weak_ptr<MockTask> task_;
   };
 
-  void initTaskPool(MemoryManager* manager, uint64_t capacity) {
+  void initTaskPool(
+      MemoryManager* manager,
+      uint64_t capacity,
+      int32_t priority = 0) {
     root_ = manager->addRootPool(
         fmt::format("RootPool-{}", poolId_++),
         capacity,
-        MemoryReclaimer::create(shared_from_this()));
+        MemoryReclaimer::create(shared_from_this(), priority));
   }
 
   MemoryPool* pool() const {
@@ -452,7 +456,8 @@ class MockSharedArbitrationTest : public testing::Test {
       bool globalArbitrationWithoutSpill = false,
       // Set the globalArbitrationAbortTimeRatio to be very small so that the
       // query can be aborted sooner and the test would not timeout.
-      double globalArbitrationAbortTimeRatio = 0.005) {
+      double globalArbitrationAbortTimeRatio = 0.005,
+      uint32_t globalArbitrationSoftWatermarkPct = 0) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     std::string arbitratorKind = "SHARED";
@@ -491,7 +496,11 @@ class MockSharedArbitrationTest : public testing::Test {
         {std::string(ExtraConfig::kGlobalArbitrationWithoutSpill),
          folly::to<std::string>(globalArbitrationWithoutSpill)},
         {std::string(ExtraConfig::kGlobalArbitrationAbortTimeRatio),
-         folly::to<std::string>(globalArbitrationAbortTimeRatio)}};
+         folly::to<std::string>(globalArbitrationAbortTimeRatio)},
+        {std::string(ExtraConfig::kGlobalArbitrationSoftWatermarkPct),
+         folly::to<std::string>(globalArbitrationSoftWatermarkPct)},
+        {std::string(ExtraConfig::kGlobalArbitrationSoftWatermarkCheckInterval),
+         "10ms"}};
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
@@ -499,9 +508,11 @@ class MockSharedArbitrationTest : public testing::Test {
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
   }
 
-  std::shared_ptr<MockTask> addTask(int64_t capacity = kMaxMemory) {
+  std::shared_ptr<MockTask> addTask(
+      int64_t capacity = kMaxMemory,
+      int32_t priority = 0) {
     auto task = std::make_shared<MockTask>();
-    task->initTaskPool(manager_.get(), capacity);
+    task->initTaskPool(manager_.get(), capacity, priority);
     return task;
   }
 
@@ -666,6 +677,14 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
           emptyConfigs),
       SharedArbitrator::ExtraConfig::kDefaultGlobalArbitrationAbortTimeRatio);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::globalArbitrationSoftWatermarkPct(
+          emptyConfigs),
+      0);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::
+          globalArbitrationSoftWatermarkCheckIntervalNs(emptyConfigs),
+      1'000'000'000UL);
 
   // Testing custom values
   std::unordered_map<std::string, std::string> configs;
@@ -2074,6 +2093,50 @@ DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, multipleGlobalRuns) {
   ASSERT_EQ(waitTask->capacity(), memoryCapacity / 2);
 }
 
+TEST_F(MockSharedArbitrationTest, softWatermarkReclaim) {
+  const uint64_t memoryCapacity = 256 * MB;
+  setupMemory(
+      memoryCapacity,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      kMemoryReclaimThreadsHwMultiplier,
+      nullptr,
+      true,
+      5 * 60 * 1'000'000'000UL,
+      false,
+      0.005,
+      50);
+  test::SharedArbitratorTestHelper arbitratorHelper(arbitrator_);
+
+  auto* op = addMemoryOp(nullptr, true);
+  op->allocate(memoryCapacity / 4);
+  // Below the soft watermark.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
+  ASSERT_EQ(arbitratorHelper.softWatermarkReclaimedBytes(), 0);
+  ASSERT_EQ(op->pool()->usedBytes(), memoryCapacity / 4);
+
+  op->allocate(memoryCapacity / 2);
+  // The background reclaim spills the used memory above the soft watermark
+  // without any arbitration request.
+  while (arbitratorHelper.softWatermarkReclaimedBytes() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  arbitratorHelper.waitForGlobalArbitrationToFinish();
+  ASSERT_GE(arbitrator_->stats().freeCapacityBytes, memoryCapacity / 2);
+  ASSERT_EQ(arbitratorHelper.globalArbitrationRuns(), 0);
+  ASSERT_EQ(arbitrator_->stats().numAborted, 0);
+  ASSERT_EQ(op->reclaimer()->stats().numReclaims, 1);
+}
+
 TEST_F(MockSharedArbitrationTest, globalArbitrationEnableCheck) {
   for (bool globalArbitrationEnabled : {false, true}) {
     SCOPED_TRACE(
@@ -2823,6 +2886,35 @@ TEST_F(MockSharedArbitrationTest, memoryPoolAbortCapacityLimit) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, abortByPriority) {
+  const int64_t memoryCapacity = 256 << 20;
+  setupMemory(memoryCapacity, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64 << 20);
+
+  // The low priority task is aborted first even if it is older and smaller.
+  auto lowPriorityTask = addTask(kMaxMemory, 1);
+  addMemoryOp(lowPriorityTask, true)->allocate(32 << 20);
+  auto largeTask = addTask();
+  addMemoryOp(largeTask, true)->allocate(128 << 20);
+  auto youngTask = addTask();
+  addMemoryOp(youngTask, true)->allocate(64 << 20);
+
+  ASSERT_EQ(manager_->shrinkPools(16 << 20, false, true), 32 << 20);
+  ASSERT_NE(lowPriorityTask->error(), nullptr);
+  ASSERT_EQ(largeTask->error(), nullptr);
+  ASSERT_EQ(youngTask->error(), nullptr);
+  auto priorityStats = arbitrator_->priorityStats();
+  ASSERT_EQ(priorityStats.size(), 1);
+  ASSERT_EQ(priorityStats.at(1).numAborted, 1);
+
+  // The high priority tasks are aborted in the existing order after that.
+  ASSERT_EQ(manager_->shrinkPools(16 << 20, false, true), 64 << 20);
+  ASSERT_NE(youngTask->error(), nullptr);
+  ASSERT_EQ(largeTask->error(), nullptr);
+  priorityStats = arbitrator_->priorityStats();
+  ASSERT_EQ(priorityStats.at(0).numAborted, 1);
+  ASSERT_EQ(priorityStats.at(1).numAborted, 1);
+}
+
 DEBUG_ONLY_TEST_F(
     MockSharedArbitrationTest,
     globalArbitrationWaitReturnEarlyWithFreeCapacity) {
@@ -70,6 +70,10 @@ class SharedArbitratorTestHelper {
     return arbitrator_->globalArbitrationRuns_;
   }
 
+  uint64_t softWatermarkReclaimedBytes() const {
+    return arbitrator_->softWatermarkReclaimedBytes_;
+  }
+
   bool hasShutdown() const {
     std::lock_guard<std::mutex> l(arbitrator_->stateMutex_);
     return arbitrator_->hasShutdownLocked();
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace facebook::velox::process {
+
+namespace {
+
+double perKilo(uint64_t count, uint64_t instructions) {
+  return instructions == 0 ? 0 : count * 1000.0 / instructions;
+}
+
+#ifdef __linux__
+
+// The member of PerfCounters each counter of the group is added to.
+using CounterMember = uint64_t PerfCounters::*;
+
+struct CounterSpec {
+  uint32_t type;
+  uint64_t config;
+  CounterMember member;
+};
+
+constexpr uint64_t cacheReadMiss(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// The first counter is the group leader.
+const CounterSpec kCounters[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfCounters::cycles},
+    {PERF_TYPE_HARDWARE,
+     PERF_COUNT_HW_INSTRUCTIONS,
+     &PerfCounters::instructions},
+    {PERF_TYPE_HW_CACHE,
+     cacheReadMiss(PERF_COUNT_HW_CACHE_LL),
+     &PerfCounters::llcMisses},
+    {PERF_TYPE_HW_CACHE,
+     cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB),
+     &PerfCounters::dtlbMisses},
+    {PERF_TYPE_HARDWARE,
+     PERF_COUNT_HW_BRANCH_MISSES,
+     &PerfCounters::branchMisses},
+};
+
+constexpr size_t kNumCounters = sizeof(kCounters) / sizeof(kCounters[0]);
+
+int openCounter(const CounterSpec& spec, int groupFd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = spec.type;
+  attr.config = spec.config;
+  attr.disabled = groupFd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+      PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall(
+      __NR_perf_event_open, &attr, 0 /*pid*/, -1 /*cpu*/, groupFd, 0 /*flags*/);
+}
+
+// The counter group of a thread. The counters the CPU or the kernel does not
+// support are left out of the group.
+class ThreadCounters {
+ public:
+  ~ThreadCounters() {
+    for (auto fd : fds_) {
+      close(fd);
+    }
+  }
+
+  // Returns the counters of the calling thread, opened on first use, or
+  // nullptr if the group leader cannot be opened.
+  static ThreadCounters* get() {
+    thread_local std::unique_ptr<ThreadCounters> counters = open();
+    return counters.get();
+  }
+
+  bool read(uint64_t& timeEnabled, uint64_t& timeRunning, PerfCounters& out) {
+    // nr, time_enabled, time_running and a value per counter.
+    uint64_t buffer[3 + kNumCounters];
+    const auto size = (3 + members_.size()) * sizeof(uint64_t);
+    if (::read(fds_[0], buffer, size) != static_cast<ssize_t>(size) ||
+        buffer[0] != members_.size()) {
+      return false;
+    }
+    timeEnabled = buffer[1];
+    timeRunning = buffer[2];
+    for (size_t i = 0; i < members_.size(); ++i) {
+      out.*members_[i] = buffer[3 + i];
+    }
+    return true;
+  }
+
+ private:
+  static std::unique_ptr<ThreadCounters> open() {
+    auto counters = std::make_unique<ThreadCounters>();
+    for (const auto& spec : kCounters) {
+      const auto fd =
+          openCounter(spec, counters->fds_.empty() ? -1 : counters->fds_[0]);
+      if (fd < 0) {
+        if (counters->fds_.empty()) {
+          LOG_FIRST_N(WARNING, 1)
+              << "Hardware performance counters are not available: "
+              << strerror(errno);
+          return nullptr;
+        }
+        continue;
+      }
+      counters->fds_.push_back(fd);
+      counters->members_.push_back(spec.member);
+    }
+    if (ioctl(counters->fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) !=
+        0) {
+      return nullptr;
+    }
+    return counters;
+  }
+
+  std::vector<int> fds_;
+  std::vector<CounterMember> members_;
+};
+
+#endif
+
+} // namespace
+
+std::string PerfCounters::toString() const {
+  return fmt::format(
+      "count: {}, cycles: {}, instructions: {}, IPC: {:.2f}, "
+      "LLC MPKI: {:.2f}, dTLB MPKI: {:.2f}, branch MPKI: {:.2f}",
+      count,
+      cycles,
+      instructions,
+      cycles == 0 ? 0 : static_cast<double>(instructions) / cycles,
+      perKilo(llcMisses, instructions),
+      perKilo(dtlbMisses, instructions),
+      perKilo(branchMisses, instructions));
+}
+
+DeltaPerfCounterStopWatch::DeltaPerfCounterStopWatch()
+    : valid_(read(start_)) {}
+
+std::optional<PerfCounters> DeltaPerfCounterStopWatch::elapsed() const {
+  Reading end;
+  if (!valid_ || !read(end)) {
+    return std::nullopt;
+  }
+  // The counts are not comparable if the group was descheduled from the PMU
+  // for part of the interval.
+  if (end.timeEnabled - start_.timeEnabled !=
+      end.timeRunning - start_.timeRunning) {
+    return std::nullopt;
+  }
+  PerfCounters delta;
+  delta.count = 1;
+  delta.cycles = end.counters.cycles - start_.counters.cycles;
+  delta.instructions = end.counters.instructions - start_.counters.instructions;
+  delta.llcMisses = end.counters.llcMisses - start_.counters.llcMisses;
+  delta.dtlbMisses = end.counters.dtlbMisses - start_.counters.dtlbMisses;
+  delta.branchMisses = end.counters.branchMisses - start_.counters.branchMisses;
+  return delta;
+}
+
+// static
+bool DeltaPerfCounterStopWatch::available() {
+#ifdef __linux__
+  return ThreadCounters::get() != nullptr;
+#else
+  return false;
+#endif
+}
+
+// static
+bool DeltaPerfCounterStopWatch::read(Reading& reading) {
+#ifdef __linux__
+  auto* counters = ThreadCounters::get();
+  return counters != nullptr &&
+      counters->read(
+          reading.timeEnabled, reading.timeRunning, reading.counters);
+#else
+  static_cast<void>(reading);
+  return false;
+#endif
+}
+
+} // namespace facebook::velox::process
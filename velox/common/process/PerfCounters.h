@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Hardware performance counter totals of a set of measured calls. The counts
+/// are in user mode. Counters the CPU does not support stay zero.
+struct PerfCounters {
+  /// Number of measured calls.
+  uint64_t count{0};
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  /// Last level cache read misses.
+  uint64_t llcMisses{0};
+  /// Data TLB read misses.
+  uint64_t dtlbMisses{0};
+  uint64_t branchMisses{0};
+
+  void add(const PerfCounters& other) {
+    count += other.count;
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    dtlbMisses += other.dtlbMisses;
+    branchMisses += other.branchMisses;
+  }
+
+  void clear() {
+    *this = PerfCounters{};
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  /// Returns the totals with the instructions per cycle and the misses per
+  /// thousand instructions (MPKI).
+  std::string toString() const;
+};
+
+/// Reads the hardware performance counters of the calling thread with
+/// perf_event_open at construction and returns the counts since then from
+/// elapsed(). The counters are opened once per thread as a group, so that
+/// they count the same instructions, and read with a single read() call.
+class DeltaPerfCounterStopWatch {
+ public:
+  DeltaPerfCounterStopWatch();
+
+  /// Returns the counts of the thread since construction with a count of 1,
+  /// or std::nullopt if the counters are not available, e.g. because of the
+  /// perf_event_paranoid setting, or were multiplexed with other users of the
+  /// PMU in the meantime.
+  std::optional<PerfCounters> elapsed() const;
+
+  /// Returns true if the counters of the calling thread can be read.
+  static bool available();
+
+ private:
+  struct Reading {
+    uint64_t timeEnabled{0};
+    uint64_t timeRunning{0};
+    PerfCounters counters;
+  };
+
+  static bool read(Reading& reading);
+
+  Reading start_;
+  bool valid_;
+};
+
+} // namespace facebook::velox::process
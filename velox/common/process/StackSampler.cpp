@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/StackSampler.h"
+
+#include <signal.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <cerrno>
+
+#include <fmt/format.h>
+#include <folly/CPortability.h>
+#include <folly/String.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/StackTrace.h"
+
+namespace facebook::velox::process {
+
+namespace {
+
+// The frames of StackSampleBuffer::record(), the signal handler and the
+// signal trampoline at the top of the sampled stacks.
+constexpr int32_t kSkipFrames = 3;
+
+// The buffer and tag of the thread, read by the signal handler. Trivial
+// types so that the handler does not run any thread local initialization.
+thread_local StackSampleBuffer* threadSampleBuffer = nullptr;
+thread_local int32_t threadSampleTag = 0;
+
+std::mutex samplerMutex;
+bool samplerRunning{false};
+struct sigaction previousAction;
+
+void handleSignal(int /*signal*/, siginfo_t* /*info*/, void* /*context*/) {
+  auto* buffer = threadSampleBuffer;
+  if (buffer == nullptr) {
+    return;
+  }
+  const auto savedErrno = errno;
+  buffer->record(threadSampleTag);
+  errno = savedErrno;
+}
+
+void setTimer(uint64_t intervalUs) {
+  struct itimerval timer {};
+  timer.it_interval.tv_sec = intervalUs / 1'000'000;
+  timer.it_interval.tv_usec = intervalUs % 1'000'000;
+  timer.it_value = timer.it_interval;
+  VELOX_CHECK_EQ(
+      setitimer(ITIMER_PROF, &timer, nullptr),
+      0,
+      "Failed to set the profiling timer: {}",
+      folly::errnoStr(errno));
+}
+
+} // namespace
+
+StackSampleBuffer::StackSampleBuffer(int32_t capacity) : samples_(capacity) {
+  VELOX_CHECK_GT(capacity, 0);
+}
+
+FOLLY_NOINLINE void StackSampleBuffer::record(int32_t tag) {
+  const auto size = size_.load();
+  if (size >= static_cast<int32_t>(samples_.size())) {
+    ++numDropped_;
+    return;
+  }
+  auto& sample = samples_[size];
+  uintptr_t frames[kMaxFrames + kSkipFrames];
+  const auto numFrames =
+      folly::symbolizer::getStackTraceSafe(frames, kMaxFrames + kSkipFrames);
+  if (numFrames <= kSkipFrames) {
+    return;
+  }
+  sample.tag = tag;
+  sample.numFrames = numFrames - kSkipFrames;
+  std::copy(
+      frames + kSkipFrames, frames + numFrames, std::begin(sample.frames));
+  size_ = size + 1;
+}
+
+ScopedStackSampleTag::ScopedStackSampleTag(
+    StackSampleBuffer* buffer,
+    int32_t tag)
+    : prevBuffer_(threadSampleBuffer), prevTag_(threadSampleTag) {
+  // Sets the tag before the buffer so that a signal in between does not
+  // record a sample with the previous tag in 'buffer'.
+  threadSampleBuffer = nullptr;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  threadSampleTag = tag;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  threadSampleBuffer = buffer;
+}
+
+ScopedStackSampleTag::~ScopedStackSampleTag() {
+  threadSampleBuffer = nullptr;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  threadSampleTag = prevTag_;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  threadSampleBuffer = prevBuffer_;
+}
+
+// static
+void StackSampler::start(uint64_t intervalUs) {
+  VELOX_CHECK_GT(intervalUs, 0);
+  std::lock_guard<std::mutex> l(samplerMutex);
+  if (!samplerRunning) {
+    struct sigaction action {};
+    action.sa_sigaction = handleSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    VELOX_CHECK_EQ(
+        sigaction(SIGPROF, &action, &previousAction),
+        0,
+        "Failed to install the SIGPROF handler: {}",
+        folly::errnoStr(errno));
+    samplerRunning = true;
+  }
+  setTimer(intervalUs);
+}
+
+// static
+void StackSampler::stop() {
+  std::lock_guard<std::mutex> l(samplerMutex);
+  if (!samplerRunning) {
+    return;
+  }
+  setTimer(0);
+  // Keeps ignoring the signals that may still be pending.
+  struct sigaction ignore {};
+  ignore.sa_handler = SIG_IGN;
+  sigemptyset(&ignore.sa_mask);
+  sigaction(
+      SIGPROF,
+      previousAction.sa_handler == SIG_DFL ? &ignore : &previousAction,
+      nullptr);
+  samplerRunning = false;
+}
+
+// static
+bool StackSampler::isRunning() {
+  std::lock_guard<std::mutex> l(samplerMutex);
+  return samplerRunning;
+}
+
+void StackProfile::add(
+    const std::string& label,
+    const uintptr_t* frames,
+    int32_t numFrames) {
+  std::vector<uintptr_t> stack(frames, frames + numFrames);
+  std::reverse(stack.begin(), stack.end());
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stacks_[label][std::move(stack)];
+}
+
+bool StackProfile::empty() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stacks_.empty();
+}
+
+uint64_t StackProfile::numSamples(const std::string& label) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = stacks_.find(label);
+  if (it == stacks_.end()) {
+    return 0;
+  }
+  uint64_t numSamples{0};
+  for (const auto& [_, count] : it->second) {
+    numSamples += count;
+  }
+  return numSamples;
+}
+
+std::unordered_map<std::string, std::string> StackProfile::toFolded() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::unordered_map<std::string, std::string> folded;
+  for (const auto& [label, stacks] : stacks_) {
+    auto& out = folded[label];
+    for (const auto& [stack, count] : stacks) {
+      for (auto i = 0; i < stack.size(); ++i) {
+        if (i > 0) {
+          out.push_back(';');
+        }
+        // All but the innermost frame are return addresses, which may be past
+        // the end of the calling function.
+        out.append(
+            frameName(i + 1 < stack.size() ? stack[i] - 1 : stack[i]));
+      }
+      out.append(fmt::format(" {}\n", count));
+    }
+  }
+  return folded;
+}
+
+const std::string& StackProfile::frameName(uintptr_t address) const {
+  auto it = frameNames_.find(address);
+  if (it != frameNames_.end()) {
+    return it->second;
+  }
+  auto name = StackTrace::translateFrame(reinterpret_cast<void*>(address));
+  if (name.empty()) {
+    name = fmt::format("{:#x}", address);
+  }
+  // ';' separates the frames.
+  std::replace(name.begin(), name.end(), ';', ',');
+  return frameNames_.emplace(address, std::move(name)).first->second;
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Fixed capacity buffer of the stack samples taken by the StackSampler on
+/// the threads tagged with the buffer by a ScopedStackSampleTag. The buffer is
+/// written from the signal handler of the sampler, so it does not allocate
+/// and drops the samples that do not fit. The owner of the buffer drains it
+/// when no thread is tagged with it, e.g. between the operator calls of a
+/// Driver.
+class StackSampleBuffer {
+ public:
+  static constexpr int32_t kMaxFrames = 32;
+
+  struct Sample {
+    /// The tag of the thread when the sample was taken.
+    int32_t tag;
+    int32_t numFrames;
+    /// The return addresses from the innermost to the outermost frame.
+    uintptr_t frames[kMaxFrames];
+  };
+
+  explicit StackSampleBuffer(int32_t capacity);
+
+  /// Records a sample of the stack of the calling thread with 'tag'.
+  /// Async-signal-safe.
+  void record(int32_t tag);
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /// Number of samples dropped because the buffer was full.
+  uint64_t numDropped() const {
+    return numDropped_;
+  }
+
+  /// Calls 'func' with each recorded sample and clears the buffer. Must not be
+  /// called while a thread is tagged with 'this'.
+  template <typename F>
+  void drain(F func) {
+    const auto size = size_.load();
+    for (auto i = 0; i < size; ++i) {
+      func(samples_[i]);
+    }
+    size_ = 0;
+  }
+
+ private:
+  std::vector<Sample> samples_;
+  std::atomic<int32_t> size_{0};
+  std::atomic<uint64_t> numDropped_{0};
+};
+
+/// Tags the calling thread so that the samples of the StackSampler taken on
+/// it, if running, are recorded in 'buffer' with 'tag'. A nullptr 'buffer'
+/// disables the sampling of the thread in the scope. Restores the previous
+/// tag of the thread on destruction.
+class ScopedStackSampleTag {
+ public:
+  ScopedStackSampleTag(StackSampleBuffer* buffer, int32_t tag);
+
+  ~ScopedStackSampleTag();
+
+ private:
+  StackSampleBuffer* const prevBuffer_;
+  const int32_t prevTag_;
+};
+
+/// Process wide sampling profiler. Samples the stacks of the threads
+/// consuming CPU every 'intervalUs' of CPU time of the process with a SIGPROF
+/// timer and records the stack of the interrupted thread in the buffer it is
+/// tagged with by ScopedStackSampleTag. The samples of untagged threads are
+/// ignored, so the overhead is limited to the signal delivery. The timer is
+/// the ITIMER_PROF of the process, so this must not run together with other
+/// users of it, e.g. gperftools.
+class StackSampler {
+ public:
+  /// Starts sampling, or changes the interval if already running.
+  static void start(uint64_t intervalUs);
+
+  /// Stops sampling. The signals already pending may still record samples.
+  static void stop();
+
+  static bool isRunning();
+};
+
+/// Aggregates the stack samples of a set of labels, e.g. the plan nodes of a
+/// task, and renders them as folded stacks for flame graphs. Thread-safe.
+class StackProfile {
+ public:
+  /// Adds a sample with 'numFrames' 'frames' from the innermost to the
+  /// outermost frame to the profile of 'label'.
+  void add(
+      const std::string& label,
+      const uintptr_t* frames,
+      int32_t numFrames);
+
+  bool empty() const;
+
+  /// Returns the number of samples added to the profile of 'label'.
+  uint64_t numSamples(const std::string& label) const;
+
+  /// Returns the folded stacks of each label: one line per distinct stack with
+  /// the symbolized frames from the outermost to the innermost separated by
+  /// ';', followed by a space and the number of samples. This is the input
+  /// format of flamegraph.pl and most flame graph viewers. The frames are
+  /// printed as hex addresses if the build has no symbolizer.
+  std::unordered_map<std::string, std::string> toFolded() const;
+
+ private:
+  // Returns the name of the function at 'address', symbolized on first use.
+  const std::string& frameName(uintptr_t address) const;
+
+  mutable std::mutex mutex_;
+  // The number of samples per stack, outermost frame first, per label.
+  std::unordered_map<std::string, std::map<std::vector<uintptr_t>, uint64_t>>
+      stacks_;
+  mutable std::unordered_map<uintptr_t, std::string> frameNames_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/StackSampler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace facebook::velox::process {
+namespace {
+
+class StackSamplerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    StackSampler::start(1'000);
+  }
+
+  void TearDown() override {
+    StackSampler::stop();
+  }
+
+  // Burns CPU until 'done' returns true or a timeout.
+  template <typename F>
+  static void spin(F done) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    volatile uint64_t sum = 0;
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+      for (auto i = 0; i < 100'000; ++i) {
+        sum = sum + i;
+      }
+    }
+  }
+};
+
+TEST_F(StackSamplerTest, tag) {
+  ASSERT_TRUE(StackSampler::isRunning());
+  StackSampleBuffer buffer(16);
+  {
+    ScopedStackSampleTag tag(&buffer, 7);
+    {
+      ScopedStackSampleTag disabled(nullptr, 0);
+      spin([]() { return false; });
+    }
+    ASSERT_TRUE(buffer.empty());
+    spin([&]() { return !buffer.empty(); });
+  }
+  ASSERT_FALSE(buffer.empty());
+
+  int32_t numSamples{0};
+  buffer.drain([&](const StackSampleBuffer::Sample& sample) {
+    ++numSamples;
+    ASSERT_EQ(sample.tag, 7);
+    ASSERT_GT(sample.numFrames, 0);
+    ASSERT_LE(sample.numFrames, StackSampleBuffer::kMaxFrames);
+  });
+  ASSERT_GT(numSamples, 0);
+  ASSERT_TRUE(buffer.empty());
+
+  StackSampler::stop();
+  ASSERT_FALSE(StackSampler::isRunning());
+}
+
+TEST_F(StackSamplerTest, drop) {
+  StackSampleBuffer buffer(1);
+  {
+    ScopedStackSampleTag tag(&buffer, 1);
+    spin([&]() { return buffer.numDropped() > 0; });
+  }
+  ASSERT_GT(buffer.numDropped(), 0);
+  int32_t numSamples{0};
+  buffer.drain([&](const auto& /*sample*/) { ++numSamples; });
+  ASSERT_EQ(numSamples, 1);
+}
+
+TEST_F(StackSamplerTest, profile) {
+  StackProfile profile;
+  ASSERT_TRUE(profile.empty());
+  const uintptr_t stack1[] = {0x30, 0x20, 0x10};
+  const uintptr_t stack2[] = {0x40, 0x10};
+  profile.add("a", stack1, 3);
+  profile.add("a", stack1, 3);
+  profile.add("a", stack2, 2);
+  profile.add("b", stack2, 2);
+  ASSERT_FALSE(profile.empty());
+  ASSERT_EQ(profile.numSamples("a"), 3);
+  ASSERT_EQ(profile.numSamples("b"), 1);
+  ASSERT_EQ(profile.numSamples("c"), 0);
+
+  const auto folded = profile.toFolded();
+  ASSERT_EQ(folded.size(), 2);
+  std::vector<std::string> lines;
+  std::stringstream stream(folded.at("a"));
+  for (std::string line; std::getline(stream, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 2);
+  // The stacks are ordered by their outermost frames.
+  ASSERT_EQ(std::count(lines[0].begin(), lines[0].end(), ';'), 2);
+  ASSERT_EQ(lines[0].substr(lines[0].rfind(' ') + 1), "2");
+  ASSERT_EQ(std::count(lines[1].begin(), lines[1].end(), ';'), 1);
+  ASSERT_EQ(lines[1].substr(lines[1].rfind(' ') + 1), "1");
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -24,6 +24,7 @@
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/io/IoStatistics.h"
 #include "velox/core/ExpressionEvaluator.h"
 #include "velox/type/Subfield.h"
 #include "velox/vector/ComplexVector.h"
@@ -190,6 +191,11 @@ class DataSink {
     uint64_t numWrittenBytes{0};
     uint32_t numWrittenFiles{0};
     uint64_t writeIOTimeUs{0};
+    /// Time the writers waited for background writes, e.g. uploads of parts
+    /// of files to object storage.
+    uint64_t writeStallTimeUs{0};
+    /// Time spent in background writes.
+    uint64_t backgroundWriteTimeUs{0};
     uint64_t numCompressedBytes{0};
     uint64_t recodeTimeNs{0};
     uint64_t compressionTimeNs{0};
@@ -263,6 +269,13 @@ class DataSource {
 
   virtual std::unordered_map<std::string, RuntimeCounter> runtimeStats() = 0;
 
+  /// Returns the latency histograms of the reads of 'this' per cache tier and
+  /// storage type, see io::IoStatistics::latencyHistograms().
+  virtual std::unordered_map<std::string, io::IoLatencyHistogram>
+  ioLatencyHistograms() {
+    return {};
+  }
+
   /// Returns true if 'this' has initiated all the prefetch this will initiate.
   /// This means that the caller should schedule next splits to prefetch in the
   /// background. false if the source does not prefetch.
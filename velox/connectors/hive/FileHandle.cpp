@@ -22,6 +22,8 @@
 
 #include <atomic>
 
+DECLARE_bool(velox_local_file_mmap);
+
 namespace facebook::velox {
 
 uint64_t FileHandleSizer::operator()(const FileHandle& fileHandle) {
@@ -53,6 +55,7 @@ std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
     fileHandle = std::make_unique<FileHandle>();
     filesystems::FileOptions options;
     options.stats = stats;
+    options.useMmap = FLAGS_velox_local_file_mmap;
     if (properties) {
       options.fileSize = properties->fileSize;
       options.readRangeHint = properties->readRangeHint;
@@ -67,6 +67,13 @@ uint32_t HiveConfig::maxPartitionsPerWriters(
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 128));
 }
 
+uint32_t HiveConfig::maxOpenFileWriters(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenFileWritersSession,
+      config_->get<uint32_t>(kMaxOpenFileWriters, 0));
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -88,11 +95,65 @@ std::optional<std::string> HiveConfig::gcsMaxRetryTime() const {
       config_->get<std::string>(kGcsMaxRetryTime));
 }
 
+int32_t HiveConfig::gcsMaxReadConcurrency() const {
+  return config_->get<int32_t>(kGcsMaxReadConcurrency, 8);
+}
+
+uint64_t HiveConfig::gcsReadPartSize() const {
+  return config::toCapacity(
+      config_->get<std::string>(kGcsReadPartSize, "8MB"),
+      config::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::gcsUploadBufferSize() const {
+  return config::toCapacity(
+      config_->get<std::string>(kGcsUploadBufferSize, "256KB"),
+      config::CapacityUnit::BYTE);
+}
+
+std::optional<int32_t> HiveConfig::gcsConnectionPoolSize() const {
+  return config_->get<int32_t>(kGcsConnectionPoolSize);
+}
+
+bool HiveConfig::hdfsShortCircuitRead() const {
+  return config_->get<bool>(kHdfsShortCircuitRead, false);
+}
+
+std::string HiveConfig::hdfsDomainSocketPath() const {
+  return config_->get<std::string>(kHdfsDomainSocketPath, std::string(""));
+}
+
+uint32_t HiveConfig::hdfsHedgedReadThreads() const {
+  return config_->get<uint32_t>(kHdfsHedgedReadThreads, 0);
+}
+
+uint64_t HiveConfig::hdfsHedgedReadThresholdMs() const {
+  return config_->get<uint64_t>(kHdfsHedgedReadThresholdMs, 500);
+}
+
+uint32_t HiveConfig::hdfsAsyncReadThreads() const {
+  return config_->get<uint32_t>(kHdfsAsyncReadThreads, 0);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const config::ConfigBase* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
 }
 
+uint32_t HiveConfig::orcReaderMaxParallelStripes(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kOrcReaderMaxParallelStripesSession,
+      config_->get<uint32_t>(kOrcReaderMaxParallelStripes, 1));
+}
+
+double HiveConfig::orcReaderParallelStripesMemoryUsageRatio(
+    const config::ConfigBase* session) const {
+  return session->get<double>(
+      kOrcReaderParallelStripesMemoryUsageRatioSession,
+      config_->get<double>(kOrcReaderParallelStripesMemoryUsageRatio, 0.7));
+}
+
 bool HiveConfig::isParquetUseColumnNames(
     const config::ConfigBase* session) const {
   return session->get<bool>(
@@ -100,6 +161,20 @@ bool HiveConfig::isParquetUseColumnNames(
       config_->get<bool>(kParquetUseColumnNames, false));
 }
 
+bool HiveConfig::isParquetReadBloomFilters(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetReadBloomFiltersSession,
+      config_->get<bool>(kParquetReadBloomFilters, false));
+}
+
+uint64_t HiveConfig::parquetPageDecompressionAheadBytes(
+    const config::ConfigBase* session) const {
+  return session->get<uint64_t>(
+      kParquetPageDecompressionAheadBytesSession,
+      config_->get<uint64_t>(kParquetPageDecompressionAheadBytes, 0));
+}
+
 bool HiveConfig::isFileColumnNamesReadAsLowerCase(
     const config::ConfigBase* session) const {
   return session->get<bool>(
@@ -145,6 +220,25 @@ int32_t HiveConfig::maxCoalescedDistanceBytes(
   return int32_t(distance);
 }
 
+bool HiveConfig::adaptiveCoalescing(const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kAdaptiveCoalescingSession,
+      config_->get<bool>(kAdaptiveCoalescing, false));
+}
+
+int32_t HiveConfig::decompressedCacheMinUses(
+    const config::ConfigBase* session) const {
+  return session->get<int32_t>(
+      kDecompressedCacheMinUsesSession,
+      config_->get<int32_t>(kDecompressedCacheMinUses, 0));
+}
+
+int64_t HiveConfig::decompressedCacheMaxStreamBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kDecompressedCacheMaxStreamBytes, "4MB"),
+      config::CapacityUnit::BYTE);
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
@@ -166,6 +260,33 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+bool HiveConfig::fileMetadataCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kFileMetadataCacheEnabledSession,
+      config_->get<bool>(kFileMetadataCacheEnabled, true));
+}
+
+bool HiveConfig::icebergDeleteFileCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kIcebergDeleteFileCacheEnabledSession,
+      config_->get<bool>(kIcebergDeleteFileCacheEnabled, true));
+}
+
+uint64_t HiveConfig::splitResultCacheMaxBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kSplitResultCacheMaxBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
+bool HiveConfig::splitResultCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kSplitResultCacheEnabledSession,
+      config_->get<bool>(kSplitResultCacheEnabled, true));
+}
+
 std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
@@ -193,6 +314,13 @@ uint64_t HiveConfig::sortWriterFinishTimeSliceLimitMs(
       config_->get<uint64_t>(kSortWriterFinishTimeSliceLimitMs, 5'000));
 }
 
+bool HiveConfig::sortWriterZOrderEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kSortWriterZOrderEnabledSession,
+      config_->get<bool>(kSortWriterZOrderEnabled, false));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 256UL << 10);
 }
@@ -225,6 +353,12 @@ bool HiveConfig::readStatsBasedFilterReorderDisabled(
       config_->get<bool>(kReadStatsBasedFilterReorderDisabled, false));
 }
 
+bool HiveConfig::readRunLengthEncoded(const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kReadRunLengthEncodedSession,
+      config_->get<bool>(kReadRunLengthEncoded, false));
+}
+
 std::string HiveConfig::hiveLocalDataPath() const {
   return config_->get<std::string>(kLocalDataPath, "");
 }
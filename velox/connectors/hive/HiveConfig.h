@@ -49,6 +49,15 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of file writers a single table writer keeps open when
+  /// writing a partitioned, non-bucketed table. When a new partition needs a
+  /// writer beyond the limit, the least recently written one is closed and
+  /// its partition continues in a new file if it gets more rows. 0 keeps all
+  /// the writers open.
+  static constexpr const char* kMaxOpenFileWriters = "max-open-file-writers";
+  static constexpr const char* kMaxOpenFileWritersSession =
+      "max_open_file_writers";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -67,6 +76,48 @@ class HiveConfig {
   /// The GCS maximum time allowed to retry transient errors.
   static constexpr const char* kGcsMaxRetryTime = "hive.gcs.max-retry-time";
 
+  /// The maximum number of ranged GCS reads issued in parallel for a read. 1
+  /// reads the ranges one after another.
+  static constexpr const char* kGcsMaxReadConcurrency =
+      "hive.gcs.max-read-concurrency";
+
+  /// The minimum size of the parts of a parallel GCS read.
+  static constexpr const char* kGcsReadPartSize = "hive.gcs.read-part-size";
+
+  /// The size of the buffer a GCS write file fills before it uploads it as one
+  /// chunk of the resumable upload.
+  static constexpr const char* kGcsUploadBufferSize =
+      "hive.gcs.upload-buffer-size";
+
+  /// The maximum number of connections the GCS client keeps open.
+  static constexpr const char* kGcsConnectionPoolSize =
+      "hive.gcs.connection-pool-size";
+
+  /// Whether the HDFS client reads the blocks on the local DataNode from the
+  /// local disk through the domain socket at kHdfsDomainSocketPath instead of
+  /// through the DataNode.
+  static constexpr const char* kHdfsShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// The domain socket shared with the local DataNode for short-circuit reads.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// Number of threads of the HDFS client for hedged reads, which read a block
+  /// from another DataNode when the first read takes longer than
+  /// kHdfsHedgedReadThresholdMs. 0 disables hedged reads.
+  static constexpr const char* kHdfsHedgedReadThreads =
+      "hive.hdfs.hedged-read-threads";
+
+  /// The time after which a hedged read starts reading from another DataNode.
+  static constexpr const char* kHdfsHedgedReadThresholdMs =
+      "hive.hdfs.hedged-read-threshold-ms";
+
+  /// Number of threads that run HdfsReadFile::preadvAsync(), so that several
+  /// reads of a file can be in flight. 0 reads synchronously.
+  static constexpr const char* kHdfsAsyncReadThreads =
+      "hive.hdfs.async-read-threads";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -74,12 +125,41 @@ class HiveConfig {
   static constexpr const char* kOrcUseColumnNamesSession =
       "hive_orc_use_column_names";
 
+  /// Max number of stripes of a split to decode concurrently on the connector
+  /// executor. 1 reads the stripes one after the other.
+  static constexpr const char* kOrcReaderMaxParallelStripes =
+      "hive.orc.reader.max-parallel-stripes";
+  static constexpr const char* kOrcReaderMaxParallelStripesSession =
+      "orc_reader_max_parallel_stripes";
+
+  /// The query memory usage ratio below which another stripe of a split may be
+  /// decoded concurrently.
+  static constexpr const char* kOrcReaderParallelStripesMemoryUsageRatio =
+      "hive.orc.reader.parallel-stripes-memory-usage-ratio";
+  static constexpr const char*
+      kOrcReaderParallelStripesMemoryUsageRatioSession =
+          "orc_reader_parallel_stripes_memory_usage_ratio";
+
   /// Maps table field names to file field names using names, not indices.
   static constexpr const char* kParquetUseColumnNames =
       "hive.parquet.use-column-names";
   static constexpr const char* kParquetUseColumnNamesSession =
       "parquet_use_column_names";
 
+  /// Reads the column chunk Bloom filters of Parquet files to skip row groups
+  /// for equality and IN-list filters.
+  static constexpr const char* kParquetReadBloomFilters =
+      "hive.parquet.reader.bloom-filter-enabled";
+  static constexpr const char* kParquetReadBloomFiltersSession =
+      "parquet_reader_bloom_filter_enabled";
+
+  /// Max bytes of upcoming Parquet pages of each column chunk to decompress
+  /// ahead of decoding on the connector executor. 0 disables it.
+  static constexpr const char* kParquetPageDecompressionAheadBytes =
+      "hive.parquet.reader.page-decompression-ahead-bytes";
+  static constexpr const char* kParquetPageDecompressionAheadBytesSession =
+      "parquet_reader_page_decompression_ahead_bytes";
+
   /// Reads the source file column name as lower case.
   static constexpr const char* kFileColumnNamesReadAsLowerCase =
       "file-column-names-read-as-lower-case";
@@ -109,6 +189,27 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceSession =
       "orc_max_merge_distance";
 
+  /// If true, the coalescing thresholds are learned from the latency and
+  /// throughput of reads per file system, starting from the max coalesced
+  /// bytes and distance.
+  static constexpr const char* kAdaptiveCoalescing =
+      "adaptive-coalescing-enabled";
+  static constexpr const char* kAdaptiveCoalescingSession =
+      "adaptive_coalescing_enabled";
+
+  /// The number of uses of the cached compressed bytes of a DWRF or ORC
+  /// stream after which its decompressed bytes are also cached. 0 disables
+  /// caching decompressed streams.
+  static constexpr const char* kDecompressedCacheMinUses =
+      "decompressed-cache-min-uses";
+  static constexpr const char* kDecompressedCacheMinUsesSession =
+      "decompressed_cache_min_uses";
+
+  /// The max size of a compressed stream whose decompressed bytes may be
+  /// cached.
+  static constexpr const char* kDecompressedCacheMaxStreamBytes =
+      "decompressed-cache-max-stream-bytes";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
@@ -130,6 +231,33 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Whether the readers look up the parsed metadata of the files with a
+  /// known modification time in the dwio::common::FileMetadataCache, if one
+  /// is installed.
+  static constexpr const char* kFileMetadataCacheEnabled =
+      "file-metadata-cache-enabled";
+  static constexpr const char* kFileMetadataCacheEnabledSession =
+      "file_metadata_cache_enabled";
+
+  /// Whether the decoded Iceberg delete files are cached across splits and
+  /// queries. Should be disabled if the delete files are not immutable.
+  static constexpr const char* kIcebergDeleteFileCacheEnabled =
+      "iceberg-delete-file-cache-enabled";
+  static constexpr const char* kIcebergDeleteFileCacheEnabledSession =
+      "iceberg_delete_file_cache_enabled";
+
+  /// Capacity in bytes of the split result cache of the connector, which
+  /// caches the filtered and projected outputs of the splits of files with a
+  /// known modification time. 0 disables the cache.
+  static constexpr const char* kSplitResultCacheMaxBytes =
+      "split-result-cache-max-bytes";
+
+  /// Whether the scans use the split result cache if it is configured.
+  static constexpr const char* kSplitResultCacheEnabled =
+      "split-result-cache-enabled";
+  static constexpr const char* kSplitResultCacheEnabledSession =
+      "split_result_cache_enabled";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -164,6 +292,13 @@ class HiveConfig {
   static constexpr const char* kSortWriterFinishTimeSliceLimitMsSession =
       "sort_writer_finish_time_slice_limit_ms";
 
+  /// Whether sort writer clusters rows in Z-order of the sort columns instead
+  /// of sorting them lexicographically.
+  static constexpr const char* kSortWriterZOrderEnabled =
+      "sort-writer-z-order-enabled";
+  static constexpr const char* kSortWriterZOrderEnabledSession =
+      "sort_writer_z_order_enabled";
+
   // The unit for reading timestamps from files.
   static constexpr const char* kReadTimestampUnit =
       "hive.reader.timestamp-unit";
@@ -180,6 +315,13 @@ class HiveConfig {
   static constexpr const char* kReadStatsBasedFilterReorderDisabledSession =
       "stats_based_filter_reorder_disabled";
 
+  /// Whether scalar columns with long runs of equal values, e.g. sorted
+  /// columns, are read as dictionaries over one value per run.
+  static constexpr const char* kReadRunLengthEncoded =
+      "hive.reader.run-length-encoded";
+  static constexpr const char* kReadRunLengthEncodedSession =
+      "hive.reader.run_length_encoded";
+
   static constexpr const char* kLocalDataPath = "hive_local_data_path";
   static constexpr const char* kLocalFileFormat = "hive_local_file_format";
 
@@ -188,6 +330,8 @@ class HiveConfig {
 
   uint32_t maxPartitionsPerWriters(const config::ConfigBase* session) const;
 
+  uint32_t maxOpenFileWriters(const config::ConfigBase* session) const;
+
   bool immutablePartitions() const;
 
   std::string gcsEndpoint() const;
@@ -198,10 +342,38 @@ class HiveConfig {
 
   std::optional<std::string> gcsMaxRetryTime() const;
 
+  int32_t gcsMaxReadConcurrency() const;
+
+  uint64_t gcsReadPartSize() const;
+
+  uint64_t gcsUploadBufferSize() const;
+
+  std::optional<int32_t> gcsConnectionPoolSize() const;
+
+  bool hdfsShortCircuitRead() const;
+
+  std::string hdfsDomainSocketPath() const;
+
+  uint32_t hdfsHedgedReadThreads() const;
+
+  uint64_t hdfsHedgedReadThresholdMs() const;
+
+  uint32_t hdfsAsyncReadThreads() const;
+
   bool isOrcUseColumnNames(const config::ConfigBase* session) const;
 
+  uint32_t orcReaderMaxParallelStripes(const config::ConfigBase* session) const;
+
+  double orcReaderParallelStripesMemoryUsageRatio(
+      const config::ConfigBase* session) const;
+
   bool isParquetUseColumnNames(const config::ConfigBase* session) const;
 
+  bool isParquetReadBloomFilters(const config::ConfigBase* session) const;
+
+  uint64_t parquetPageDecompressionAheadBytes(
+      const config::ConfigBase* session) const;
+
   bool isFileColumnNamesReadAsLowerCase(
       const config::ConfigBase* session) const;
 
@@ -215,6 +387,12 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes(const config::ConfigBase* session) const;
 
+  bool adaptiveCoalescing(const config::ConfigBase* session) const;
+
+  int32_t decompressedCacheMinUses(const config::ConfigBase* session) const;
+
+  int64_t decompressedCacheMaxStreamBytes() const;
+
   int32_t prefetchRowGroups() const;
 
   int32_t loadQuantum(const config::ConfigBase* session) const;
@@ -225,6 +403,14 @@ class HiveConfig {
 
   bool isFileHandleCacheEnabled() const;
 
+  bool fileMetadataCacheEnabled(const config::ConfigBase* session) const;
+
+  bool icebergDeleteFileCacheEnabled(const config::ConfigBase* session) const;
+
+  uint64_t splitResultCacheMaxBytes() const;
+
+  bool splitResultCacheEnabled(const config::ConfigBase* session) const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   std::string writeFileCreateConfig() const;
@@ -236,6 +422,8 @@ class HiveConfig {
   uint64_t sortWriterFinishTimeSliceLimitMs(
       const config::ConfigBase* session) const;
 
+  bool sortWriterZOrderEnabled(const config::ConfigBase* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -252,6 +440,10 @@ class HiveConfig {
   bool readStatsBasedFilterReorderDisabled(
       const config::ConfigBase* session) const;
 
+  /// Returns true if long runs of equal scalar values are read as
+  /// dictionaries.
+  bool readRunLengthEncoded(const config::ConfigBase* session) const;
+
   /// Returns the file system path containing local data. If non-empty,
   /// initializes LocalHiveConnectorMetadata to provide metadata for the tables
   /// in the directory.
@@ -17,10 +17,14 @@
 #include "velox/connectors/hive/HiveConnector.h"
 
 #include "velox/common/base/Fs.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/connectors/hive/HiveIndexSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
 
@@ -62,6 +66,14 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (hiveConfig_->splitResultCacheMaxBytes() > 0) {
+    splitResultCache_ = std::make_unique<SplitResultCache>(
+        fmt::format("hive.splitResultCache.{}", connectorId()),
+        hiveConfig_->splitResultCacheMaxBytes());
+    LOG(INFO) << "Hive connector " << connectorId()
+              << " created with split result cache of "
+              << succinctBytes(hiveConfig_->splitResultCacheMaxBytes());
+  }
   for (auto& factory : hiveConnectorMetadataFactories()) {
     metadata_ = factory->create(this);
     if (metadata_ != nullptr) {
@@ -84,9 +96,76 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       executor_,
       connectorQueryCtx,
+      hiveConfig_,
+      splitResultCache_.get());
+}
+
+std::shared_ptr<IndexSource> HiveConnector::createIndexSource(
+    const RowTypePtr& inputType,
+    size_t numJoinKeys,
+    const std::vector<core::IndexLookupConditionPtr>& joinConditions,
+    const RowTypePtr& outputType,
+    const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    ConnectorQueryCtx* connectorQueryCtx) {
+  VELOX_USER_CHECK(
+      joinConditions.empty(),
+      "Hive index lookup does not support join conditions");
+  auto indexTableHandle =
+      std::dynamic_pointer_cast<HiveIndexTableHandle>(tableHandle);
+  VELOX_USER_CHECK_NOT_NULL(
+      indexTableHandle,
+      "Hive index lookup requires a HiveIndexTableHandle: {}",
+      tableHandle->toString());
+  return std::make_shared<HiveIndexSource>(
+      inputType,
+      numJoinKeys,
+      outputType,
+      indexTableHandle,
+      columnHandles,
+      &fileHandleFactory_,
+      executor_,
+      connectorQueryCtx,
       hiveConfig_);
 }
 
+void HiveConnector::prefetchFileMetadata(
+    const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits) {
+  auto* cache = dwio::common::FileMetadataCache::getInstance();
+  if (cache == nullptr || executor_ == nullptr) {
+    return;
+  }
+  dwio::common::ReaderOptions options(cache->pool());
+  options.setFooterEstimatedSize(hiveConfig_->footerEstimatedSize());
+  options.setFilePreloadThreshold(hiveConfig_->filePreloadThreshold());
+  for (const auto& split : splits) {
+    auto key = fileMetadataCacheKey(*split);
+    if (!key.has_value()) {
+      continue;
+    }
+    auto factory = dwio::common::getReaderFactory(split->fileFormat);
+    if (!factory->cachesFileMetadata()) {
+      continue;
+    }
+    // The file is opened here so that the loader does not refer to 'this'.
+    auto fileHandle =
+        std::make_shared<FileHandleCachedPtr>(fileHandleFactory_.generate(
+            split->filePath,
+            split->properties.has_value() ? &*split->properties : nullptr));
+    cache->prefetch(
+        *key,
+        [factory, fileHandle, options]() {
+          return factory->loadFileMetadata(
+              std::make_unique<dwio::common::BufferedInput>(
+                  (*fileHandle)->file, options.memoryPool()),
+              options);
+        },
+        executor_);
+  }
+}
+
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
     RowTypePtr inputType,
     std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
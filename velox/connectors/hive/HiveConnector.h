@@ -18,6 +18,8 @@
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/SplitResultCache.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -60,6 +62,22 @@ class HiveConnector : public Connector {
     return true;
   }
 
+  bool supportsIndexLookup() const override {
+    return true;
+  }
+
+  /// Creates a HiveIndexSource over the files of a HiveIndexTableHandle.
+  std::shared_ptr<IndexSource> createIndexSource(
+      const RowTypePtr& inputType,
+      size_t numJoinKeys,
+      const std::vector<core::IndexLookupConditionPtr>& joinConditions,
+      const RowTypePtr& outputType,
+      const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      ConnectorQueryCtx* connectorQueryCtx) override;
+
   std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -80,9 +98,24 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  /// Reads the metadata of the files of 'splits' into the
+  /// dwio::common::FileMetadataCache on the IO executor, so that the scans of
+  /// the splits opening the files later skip reading and parsing their
+  /// footers. Skips the splits without a modification time and of the formats
+  /// whose readers do not cache metadata. Does nothing without an installed
+  /// cache or an IO executor.
+  void prefetchFileMetadata(
+      const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits);
+
+  /// Returns the split result cache or nullptr if it is not configured.
+  SplitResultCache* splitResultCache() const {
+    return splitResultCache_.get();
+  }
+
  protected:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
+  std::unique_ptr<SplitResultCache> splitResultCache_;
   folly::Executor* executor_;
   std::shared_ptr<ConnectorMetadata> metadata_;
 };
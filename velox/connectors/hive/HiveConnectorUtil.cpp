@@ -20,6 +20,7 @@
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/DirectBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 
@@ -327,6 +328,7 @@ void processFieldSpec(
     const TypePtr& outputType,
     common::ScanSpec& fieldSpec) {
   fieldSpec.visit(*outputType, [](const Type& type, common::ScanSpec& spec) {
+    spec.setDecodeCost(type);
     if (type.isMap() && !spec.isConstant()) {
       auto* keys = spec.childByName(common::ScanSpec::kMapKeysFieldName);
       VELOX_CHECK_NOT_NULL(keys);
@@ -473,6 +475,9 @@ std::unique_ptr<dwio::common::SerDeOptions> parseSerdeParameters(
   auto escapeCharIt =
       serdeParameters.find(dwio::common::SerDeOptions::kEscapeChar);
 
+  auto quoteCharIt =
+      serdeParameters.find(dwio::common::SerDeOptions::kQuoteChar);
+
   auto nullStringIt = tableParameters.find(
       dwio::common::TableParameter::kSerializationNullFormat);
 
@@ -480,6 +485,7 @@ std::unique_ptr<dwio::common::SerDeOptions> parseSerdeParameters(
       collectionIt == serdeParameters.end() &&
       mapKeyIt == serdeParameters.end() &&
       escapeCharIt == serdeParameters.end() &&
+      quoteCharIt == serdeParameters.end() &&
       nullStringIt == tableParameters.end()) {
     return nullptr;
   }
@@ -518,6 +524,10 @@ std::unique_ptr<dwio::common::SerDeOptions> parseSerdeParameters(
             fieldDelim, collectionDelim, mapKeyDelim, escapeChar, true)
       : std::make_unique<dwio::common::SerDeOptions>(
             fieldDelim, collectionDelim, mapKeyDelim);
+  if (quoteCharIt != serdeParameters.end() && !quoteCharIt->second.empty()) {
+    serDeOptions->quoteChar = quoteCharIt->second[0];
+    serDeOptions->isQuoted = true;
+  }
   if (nullStringIt != tableParameters.end()) {
     serDeOptions->nullString = nullStringIt->second;
   }
@@ -552,6 +562,12 @@ void configureReaderOptions(
       hiveConfig->maxCoalescedBytes(sessionProperties));
   readerOptions.setMaxCoalesceDistance(
       hiveConfig->maxCoalescedDistanceBytes(sessionProperties));
+  readerOptions.setAdaptiveCoalescing(
+      hiveConfig->adaptiveCoalescing(sessionProperties));
+  readerOptions.setDecompressedCacheMinUses(
+      hiveConfig->decompressedCacheMinUses(sessionProperties));
+  readerOptions.setDecompressedCacheMaxStreamBytes(
+      hiveConfig->decompressedCacheMaxStreamBytes());
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   bool useColumnNamesForColumnMapping = false;
@@ -565,6 +581,8 @@ void configureReaderOptions(
     case dwio::common::FileFormat::PARQUET: {
       useColumnNamesForColumnMapping =
           hiveConfig->isParquetUseColumnNames(sessionProperties);
+      readerOptions.setReadBloomFilters(
+          hiveConfig->isParquetReadBloomFilters(sessionProperties));
       break;
     }
     default:
@@ -577,6 +595,10 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setFileMetadataCacheKey(
+      hiveConfig->fileMetadataCacheEnabled(sessionProperties)
+          ? fileMetadataCacheKey(*hiveSplit)
+          : std::nullopt);
   readerOptions.setNoCacheRetention(!hiveSplit->cacheable);
   const auto& sessionTzName = connectorQueryCtx->sessionTimezone();
   if (!sessionTzName.empty()) {
@@ -746,6 +768,117 @@ bool testFilters(
   return true;
 }
 
+namespace {
+// Returns true if all non-null values summarized by 'stats' pass 'filter'.
+bool allValuesPass(
+    const common::Filter& filter,
+    const dwio::common::ColumnStatistics& stats) {
+  if (filter.kind() == common::FilterKind::kIsNotNull) {
+    return true;
+  }
+  const auto* intStats =
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(&stats);
+  if (intStats == nullptr || !intStats->getMinimum().has_value() ||
+      !intStats->getMaximum().has_value()) {
+    return false;
+  }
+  const auto min = intStats->getMinimum().value();
+  const auto max = intStats->getMaximum().value();
+  if (filter.kind() == common::FilterKind::kBigintRange) {
+    const auto& range = static_cast<const common::BigintRange&>(filter);
+    return range.lower() <= min && max <= range.upper();
+  }
+  return min == max && filter.testInt64(min);
+}
+} // namespace
+
+bool allRowsPassFilters(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    bool asLocalTime) {
+  if (!scanSpec->multiColumnFilters().empty()) {
+    return false;
+  }
+  const auto totalRows = reader->numberOfRows();
+  const auto& fileTypeWithId = reader->typeWithId();
+  const auto& rowType = reader->rowType();
+  for (const auto& child : scanSpec->children()) {
+    if (!child->multiColumnFilters().empty()) {
+      return false;
+    }
+    for (const auto& grandchild : child->children()) {
+      if (grandchild->hasFilter()) {
+        return false;
+      }
+    }
+    auto* filter = child->filter();
+    if (filter == nullptr) {
+      continue;
+    }
+    if (!filter->isDeterministic()) {
+      return false;
+    }
+    const auto& name = child->fieldName();
+    auto iter = partitionKeys.find(name);
+    if (iter != partitionKeys.end()) {
+      if (!iter->second.has_value()) {
+        if (!filter->testNull()) {
+          return false;
+        }
+        continue;
+      }
+      const auto handlesIter = partitionKeysHandle.find(name);
+      VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+      if (!applyPartitionFilter(
+              handlesIter->second->dataType(),
+              iter->second.value(),
+              handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+              filter,
+              asLocalTime)) {
+        return false;
+      }
+      continue;
+    }
+    if (!rowType->containsChild(name)) {
+      // The column is missing from the file and is null.
+      if (!filter->testNull()) {
+        return false;
+      }
+      continue;
+    }
+    const auto& typeWithId = fileTypeWithId->childByName(name);
+    const auto columnStats = reader->columnStatistics(typeWithId->id());
+    if (columnStats == nullptr || !totalRows.has_value() ||
+        !columnStats->getNumberOfValues().has_value()) {
+      return false;
+    }
+    const auto numValues = columnStats->getNumberOfValues().value();
+    if (numValues < totalRows.value() && !filter->testNull()) {
+      return false;
+    }
+    if (numValues > 0 && !allValuesPass(*filter, *columnStats)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<std::string> fileMetadataCacheKey(
+    const HiveConnectorSplit& split) {
+  if (!split.properties.has_value() ||
+      !split.properties->modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  return dwio::common::FileMetadataCache::makeKey(
+      split.filePath,
+      *split.properties->modificationTime,
+      split.properties->fileSize.value_or(-1));
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -95,6 +95,24 @@ bool testFilters(
         partitionKeysHandle,
     bool asLocalTime);
 
+/// Returns true if all rows of the file of 'reader' pass the filters of
+/// 'scanSpec' as known from the partition key values and the file statistics.
+/// Returns false if some rows may not pass.
+bool allRowsPassFilters(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    bool asLocalTime);
+
+/// Returns the key of the file of 'split' in the
+/// dwio::common::FileMetadataCache, or std::nullopt if the split has no
+/// modification time to identify the version of the file.
+std::optional<std::string> fileMetadataCacheKey(
+    const HiveConnectorSplit& split);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
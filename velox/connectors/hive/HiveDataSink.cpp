@@ -400,6 +400,8 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      maxOpenFileWriters_(hiveConfig_->maxOpenFileWriters(
+          connectorQueryCtx->sessionProperties())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -510,6 +512,10 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
+  if (writers_[index] == nullptr) {
+    openWriter(index);
+  }
+  writerLastWrites_[index] = ++numWrites_;
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto dataInput = makeDataInput(dataChannels_, input);
 
@@ -567,21 +573,28 @@ DataSink::Stats HiveDataSink::stats() const {
 
   int64_t numWrittenBytes{0};
   int64_t writeIOTimeUs{0};
+  int64_t writeStallTimeUs{0};
+  int64_t backgroundWriteTimeUs{0};
   for (const auto& ioStats : ioStats_) {
     numWrittenBytes += ioStats->rawBytesWritten();
     writeIOTimeUs += ioStats->writeIOTimeUs();
+    writeStallTimeUs += ioStats->writeStallTimeUs();
+    backgroundWriteTimeUs += ioStats->backgroundWriteTimeUs();
   }
   stats.numWrittenBytes = numWrittenBytes;
   stats.writeIOTimeUs = writeIOTimeUs;
+  stats.writeStallTimeUs = writeStallTimeUs;
+  stats.backgroundWriteTimeUs = backgroundWriteTimeUs;
 
   if (state_ != State::kClosed) {
     return stats;
   }
 
-  stats.numWrittenFiles = writers_.size();
+  stats.numWrittenFiles = numOpenWriters_;
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
+    stats.numWrittenFiles += info->closedFiles.size();
     const auto spillStats = info->spillStats->rlock();
     if (!spillStats->empty()) {
       stats.spillStats += *spillStats;
@@ -653,6 +666,9 @@ bool HiveDataSink::finish() {
   // TODO: we might refactor to move the data sorting logic into hive data sink.
   const uint64_t startTimeMs = getCurrentTimeMs();
   for (auto i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] == nullptr) {
+      continue;
+    }
     WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
     if (!writers_[i]->finish()) {
       return false;
@@ -673,6 +689,24 @@ std::vector<std::string> HiveDataSink::close() {
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
+    auto fileWriteInfos = folly::dynamic::array();
+    for (const auto& file : info->closedFiles) {
+      // clang-format off
+      fileWriteInfos.push_back(folly::dynamic::object
+          ("writeFileName", file.writeFileName)
+          ("targetFileName", file.targetFileName)
+          ("fileSize", file.fileSize));
+      // clang-format on
+    }
+    if (writers_.at(i) != nullptr) {
+      // clang-format off
+      fileWriteInfos.push_back(folly::dynamic::object
+          ("writeFileName", info->writerParameters.writeFileName())
+          ("targetFileName", info->writerParameters.targetFileName())
+          ("fileSize",
+            ioStats_.at(i)->rawBytesWritten() - info->closedFilesBytes));
+      // clang-format on
+    }
     // clang-format off
       auto partitionUpdateJson = folly::toJson(
        folly::dynamic::object
@@ -682,11 +716,7 @@ std::vector<std::string> HiveDataSink::close() {
               info->writerParameters.updateMode()))
           ("writePath", info->writerParameters.writeDirectory())
           ("targetPath", info->writerParameters.targetDirectory())
-          ("fileWriteInfos", folly::dynamic::array(
-            folly::dynamic::object
-              ("writeFileName", info->writerParameters.writeFileName())
-              ("targetFileName", info->writerParameters.targetFileName())
-              ("fileSize", ioStats_.at(i)->rawBytesWritten())))
+          ("fileWriteInfos", std::move(fileWriteInfos))
           ("rowCount", info->numWrittenRows)
           ("inMemoryDataSizeInBytes", info->inputSizeInBytes)
           ("onDiskDataSizeInBytes", ioStats_.at(i)->rawBytesWritten())
@@ -711,11 +741,17 @@ void HiveDataSink::closeInternal() {
 
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -746,8 +782,6 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Without explicitly setting flush policy, the default memory based flush
   // policy is used.
   auto writerParameters = getWriterParameters(partitionName, id.bucketId);
-  const auto writePath = fs::path(writerParameters.writeDirectory()) /
-      writerParameters.writeFileName();
   auto writerPool = createWriterPool(id);
   auto sinkPool = createSinkPool(writerPool);
   std::shared_ptr<memory::MemoryPool> sortPool{nullptr};
@@ -761,6 +795,39 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       std::move(sortPool)));
   ioStats_.emplace_back(std::make_shared<io::IoStatistics>());
   setMemoryReclaimers(writerInfo_.back().get(), ioStats_.back().get());
+  writers_.emplace_back(nullptr);
+  writerLastWrites_.emplace_back(0);
+  // Extends the buffer used for partition rows calculations.
+  partitionSizes_.emplace_back(0);
+  partitionRows_.emplace_back(nullptr);
+  rawPartitionRows_.emplace_back(nullptr);
+
+  const uint32_t index = writers_.size() - 1;
+  writerIndexMap_.emplace(id, index);
+  // With writer pooling, the file writer is created on the first write to
+  // not exceed the open writer limit.
+  if (!writerPooling()) {
+    openWriter(index);
+  }
+  return index;
+}
+
+bool HiveDataSink::writerPooling() const {
+  return maxOpenFileWriters_ > 0 && isPartitioned() && !isBucketed() &&
+      insertTableHandle_->locationHandle()->targetFileName().empty();
+}
+
+void HiveDataSink::openWriter(uint32_t index) {
+  VELOX_CHECK_NULL(writers_[index]);
+  if (writerPooling()) {
+    while (numOpenWriters_ >= maxOpenFileWriters_) {
+      closeWriter(leastRecentlyWrittenWriter());
+    }
+  }
+  const auto& writerInfo = writerInfo_[index];
+  const auto writePath =
+      fs::path(writerInfo->writerParameters.writeDirectory()) /
+      writerInfo->writerParameters.writeFileName();
 
   // Take the writer options provided by the user as a starting point, or
   // allocate a new one.
@@ -778,7 +845,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   }
 
   if (options->memoryPool == nullptr) {
-    options->memoryPool = writerInfo_.back()->writerPool.get();
+    options->memoryPool = writerInfo->writerPool.get();
   }
 
   if (!options->compressionKind) {
@@ -791,7 +858,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
 
   if (options->nonReclaimableSection == nullptr) {
     options->nonReclaimableSection =
-        writerInfo_.back()->nonReclaimableSectionHolder.get();
+        writerInfo->nonReclaimableSectionHolder.get();
   }
 
   if (options->memoryReclaimerFactory == nullptr ||
@@ -813,7 +880,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   options->processConfigs(*hiveConfig_->config(), *connectorSessionProperties);
 
   // Prevents the memory allocation during the writer creation.
-  WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerInfo_.size() - 1);
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto writer = writerFactory_->createWriter(
       dwio::common::FileSink::create(
           writePath,
@@ -821,39 +888,90 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
               .bufferWrite = false,
               .connectorProperties = hiveConfig_->config(),
               .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
-              .pool = writerInfo_.back()->sinkPool.get(),
+              .pool = writerInfo->sinkPool.get(),
               .metricLogger = dwio::common::MetricsLog::voidLog(),
-              .stats = ioStats_.back().get(),
+              .stats = ioStats_[index].get(),
           }),
       options);
-  writer = maybeCreateBucketSortWriter(std::move(writer));
-  writers_.emplace_back(std::move(writer));
-  // Extends the buffer used for partition rows calculations.
-  partitionSizes_.emplace_back(0);
-  partitionRows_.emplace_back(nullptr);
-  rawPartitionRows_.emplace_back(nullptr);
+  writers_[index] = maybeCreateBucketSortWriter(index, std::move(writer));
+  ++numOpenWriters_;
+}
 
-  writerIndexMap_.emplace(id, writers_.size() - 1);
-  return writerIndexMap_[id];
+void HiveDataSink::closeWriter(uint32_t index) {
+  VELOX_CHECK_NOT_NULL(writers_[index]);
+  auto& writerInfo = *writerInfo_[index];
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    if (sortWrite()) {
+      while (!writers_[index]->finish()) {
+      }
+    }
+    writers_[index]->close();
+    writers_[index].reset();
+  }
+  --numOpenWriters_;
+
+  const auto fileSize =
+      ioStats_[index]->rawBytesWritten() - writerInfo.closedFilesBytes;
+  writerInfo.closedFiles.push_back(
+      {writerInfo.writerParameters.writeFileName(),
+       writerInfo.writerParameters.targetFileName(),
+       fileSize});
+  writerInfo.closedFilesBytes += fileSize;
+  // Writer pooling is not used for bucketed tables.
+  writerInfo.writerParameters = getWriterParameters(
+      writerInfo.writerParameters.partitionName(), std::nullopt);
+  addThreadLocalRuntimeStat(
+      kClosedPooledWriters, RuntimeCounter(1, RuntimeCounter::Unit::kNone));
+}
+
+uint32_t HiveDataSink::leastRecentlyWrittenWriter() const {
+  std::optional<uint32_t> lruIndex;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] != nullptr &&
+        (!lruIndex.has_value() ||
+         writerLastWrites_[i] < writerLastWrites_[lruIndex.value()])) {
+      lruIndex = i;
+    }
+  }
+  VELOX_CHECK(lruIndex.has_value(), "No open writer to close");
+  return lruIndex.value();
 }
 
 std::unique_ptr<facebook::velox::dwio::common::Writer>
 HiveDataSink::maybeCreateBucketSortWriter(
+    uint32_t index,
     std::unique_ptr<facebook::velox::dwio::common::Writer> writer) {
   if (!sortWrite()) {
     return writer;
   }
-  auto* sortPool = writerInfo_.back()->sortPool.get();
+  auto* sortPool = writerInfo_[index]->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
+  auto sortType = getNonPartitionTypes(dataChannels_, inputType_);
+  auto sortChannels = sortColumnIndices_;
+  auto sortCompareFlags = sortCompareFlags_;
+  std::unique_ptr<dwio::common::ZOrderEncoder> zOrderEncoder;
+  if (zOrderSortWrite(*sortType)) {
+    // Sorts by the Z-value column appended to the data columns.
+    zOrderEncoder = std::make_unique<dwio::common::ZOrderEncoder>(
+        sortType,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        connectorQueryCtx_->prefixSortConfig().maxStringPrefixLength);
+    sortChannels = {static_cast<column_index_t>(sortType->size())};
+    sortCompareFlags = {
+        {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue}};
+    sortType = zOrderEncoder->outputType();
+  }
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
-      getNonPartitionTypes(dataChannels_, inputType_),
-      sortColumnIndices_,
-      sortCompareFlags_,
+      sortType,
+      sortChannels,
+      sortCompareFlags,
       sortPool,
-      writerInfo_.back()->nonReclaimableSectionHolder.get(),
+      writerInfo_[index]->nonReclaimableSectionHolder.get(),
       connectorQueryCtx_->prefixSortConfig(),
       spillConfig_,
-      writerInfo_.back()->spillStats.get());
+      writerInfo_[index]->spillStats.get());
   return std::make_unique<dwio::common::SortingWriter>(
       std::move(writer),
       std::move(sortBuffer),
@@ -861,7 +979,23 @@ HiveDataSink::maybeCreateBucketSortWriter(
           connectorQueryCtx_->sessionProperties()),
       hiveConfig_->sortWriterMaxOutputBytes(
           connectorQueryCtx_->sessionProperties()),
-      sortWriterFinishTimeSliceLimitMs_);
+      sortWriterFinishTimeSliceLimitMs_,
+      std::move(zOrderEncoder));
+}
+
+bool HiveDataSink::zOrderSortWrite(const RowType& sortType) const {
+  if (sortColumnIndices_.size() < 2 ||
+      !hiveConfig_->sortWriterZOrderEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    return false;
+  }
+  return std::all_of(
+      sortColumnIndices_.begin(),
+      sortColumnIndices_.end(),
+      [&](column_index_t channel) {
+        return dwio::common::ZOrderEncoder::isSupported(
+            sortType.childAt(channel));
+      });
 }
 
 HiveWriterId HiveDataSink::getWriterId(size_t row) const {
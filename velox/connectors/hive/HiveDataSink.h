@@ -419,12 +419,12 @@ class HiveWriterParameters {
   }
 
  private:
-  const UpdateMode updateMode_;
-  const std::optional<std::string> partitionName_;
-  const std::string targetFileName_;
-  const std::string targetDirectory_;
-  const std::string writeFileName_;
-  const std::string writeDirectory_;
+  UpdateMode updateMode_;
+  std::optional<std::string> partitionName_;
+  std::string targetFileName_;
+  std::string targetDirectory_;
+  std::string writeFileName_;
+  std::string writeDirectory_;
 };
 
 struct HiveWriterInfo {
@@ -440,7 +440,20 @@ struct HiveWriterInfo {
         sinkPool(std::move(_sinkPool)),
         sortPool(std::move(_sortPool)) {}
 
-  const HiveWriterParameters writerParameters;
+  /// A file written by the writer and closed before the data sink is closed.
+  struct ClosedFile {
+    std::string writeFileName;
+    std::string targetFileName;
+    uint64_t fileSize;
+  };
+
+  /// The parameters of the file currently written, or of the next file to
+  /// write if the writer is closed by writer pooling.
+  HiveWriterParameters writerParameters;
+  /// The files closed by writer pooling. See HiveConfig::maxOpenFileWriters.
+  std::vector<ClosedFile> closedFiles;
+  /// Total size of 'closedFiles'.
+  uint64_t closedFilesBytes{0};
   const std::unique_ptr<tsan_atomic<bool>> nonReclaimableSectionHolder;
   /// Collects the spill stats from sort writer if the spilling has been
   /// triggered.
@@ -494,6 +507,7 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  static constexpr const char* kClosedPooledWriters = "closedPooledWriters";
 
   /// Defines the execution states of a hive data sink running internally.
   enum class State {
@@ -587,6 +601,17 @@ class HiveDataSink : public DataSink {
     return !sortColumnIndices_.empty();
   }
 
+  // Returns true if the sort writer clusters the rows in Z-order of the sort
+  // columns of 'sortType'. Needs at least two sort columns, all of types
+  // supported by ZOrderEncoder.
+  bool zOrderSortWrite(const RowType& sortType) const;
+
+  // Returns true if at most 'maxOpenFileWriters_' file writers are kept open,
+  // the others being closed and re-opened in new files on demand. Only
+  // applies to partitioned tables which are not bucketed and whose file names
+  // are generated, as the other tables have a single file per writer.
+  bool writerPooling() const;
+
   // Returns true if the table is partitioned.
   FOLLY_ALWAYS_INLINE bool isPartitioned() const {
     return partitionIdGenerator_ != nullptr;
@@ -629,8 +654,22 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Creates the file writer of 'writerInfo_[index]' and sets it in
+  // 'writers_[index]'. If writer pooling is enabled and 'maxOpenFileWriters_'
+  // writers are open, closes the least recently written ones first.
+  void openWriter(uint32_t index);
+
+  // Finishes and closes 'writers_[index]' to bound the number of open file
+  // writers. The closed file is recorded in 'writerInfo_[index]' and the
+  // partition continues in a new file when it gets more rows.
+  void closeWriter(uint32_t index);
+
+  // Returns the index of the open writer with the oldest last write.
+  uint32_t leastRecentlyWrittenWriter() const;
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
+      uint32_t index,
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
   HiveWriterParameters getWriterParameters(
@@ -665,6 +704,7 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  const uint32_t maxOpenFileWriters_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -692,6 +732,12 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // The sequence number of the last write to each writer, used to pick the
+  // writer to close with writer pooling.
+  std::vector<uint64_t> writerLastWrites_;
+  uint64_t numWrites_{0};
+  // The number of non-null 'writers_'.
+  uint32_t numOpenWriters_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
@@ -17,9 +17,11 @@
 #include "velox/connectors/hive/HiveDataSource.h"
 
 #include <fmt/ranges.h>
+#include <folly/json.h>
 #include <string>
 #include <unordered_map>
 
+#include "velox/common/io/CoalescingController.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/dwio/common/ReaderFactory.h"
@@ -54,6 +56,49 @@ bool shouldEagerlyMaterialize(
   return false;
 }
 
+bool hasIntegerStats(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal() && !type.isDate() &&
+          !type.isIntervalDayTime() && !type.isIntervalYearMonth();
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+VectorPtr makeConstant(const TypePtr& type, T value, memory::MemoryPool* pool) {
+  return std::make_shared<ConstantVector<T>>(pool, 1, false, type, T(value));
+}
+
+VectorPtr makeIntegerConstant(
+    const TypePtr& type,
+    int64_t value,
+    memory::MemoryPool* pool) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      return makeConstant<int8_t>(type, value, pool);
+    case TypeKind::SMALLINT:
+      return makeConstant<int16_t>(type, value, pool);
+    case TypeKind::INTEGER:
+      return makeConstant<int32_t>(type, value, pool);
+    case TypeKind::BIGINT:
+      return makeConstant<int64_t>(type, value, pool);
+    default:
+      VELOX_UNREACHABLE("Not an integer type: {}", type->toString());
+  }
+}
+
+void setRunLengthEncode(common::ScanSpec& spec) {
+  spec.setRunLengthEncode(true);
+  for (auto& child : spec.children()) {
+    setRunLengthEncode(*child);
+  }
+}
+
 } // namespace
 
 HiveDataSource::HiveDataSource(
@@ -65,14 +110,16 @@ HiveDataSource::HiveDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    SplitResultCache* splitResultCache)
     : fileHandleFactory_(fileHandleFactory),
       executor_(executor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       pool_(connectorQueryCtx->memoryPool()),
       outputType_(outputType),
-      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
+      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()),
+      splitResultCache_(splitResultCache) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
     auto handle = std::dynamic_pointer_cast<HiveColumnHandle>(columnHandle);
@@ -98,9 +145,87 @@ HiveDataSource::HiveDataSource(
     }
   }
 
+  hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
+  VELOX_CHECK_NOT_NULL(
+      hiveTableHandle_, "TableHandle must be an instance of HiveTableHandle");
+  const auto& projections = hiveTableHandle_->remainingFilterProjections();
+
+  const auto& statsAggregates = hiveTableHandle_->statsAggregates();
+  if (statsAggregates.empty()) {
+    scanOutputType_ = outputType_;
+  } else {
+    VELOX_USER_CHECK(
+        projections.empty(),
+        "Stats aggregates are not supported with remaining filter projections");
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < outputType_->size(); ++i) {
+      const auto& outputName = outputType_->nameOf(i);
+      auto aggregate = std::find_if(
+          statsAggregates.begin(),
+          statsAggregates.end(),
+          [&](const auto& candidate) { return candidate.name == outputName; });
+      VELOX_USER_CHECK(
+          aggregate != statsAggregates.end(),
+          "Output column {} is not a stats aggregate",
+          outputName);
+      statsAggregates_.push_back(*aggregate);
+      TypePtr type = BIGINT();
+      if (aggregate->column.empty()) {
+        VELOX_USER_CHECK(
+            aggregate->kind == HiveTableHandle::StatsAggregate::Kind::kCount,
+            "Stats aggregate {} needs a column",
+            outputName);
+        aggregateChannels_.push_back(kConstantChannel);
+      } else {
+        auto it = columnHandles.find(aggregate->column);
+        VELOX_USER_CHECK(
+            it != columnHandles.end(),
+            "ColumnHandle is missing for aggregated column: {}",
+            aggregate->column);
+        const auto& columnType =
+            static_cast<const HiveColumnHandle*>(it->second.get())->dataType();
+        auto channel = std::find(names.begin(), names.end(), aggregate->column);
+        aggregateChannels_.push_back(channel - names.begin());
+        if (channel == names.end()) {
+          names.push_back(aggregate->column);
+          types.push_back(columnType);
+        }
+        if (aggregate->kind == HiveTableHandle::StatsAggregate::Kind::kMin ||
+            aggregate->kind == HiveTableHandle::StatsAggregate::Kind::kMax) {
+          type = columnType;
+        }
+      }
+      VELOX_USER_CHECK(
+          type->equivalent(*outputType_->childAt(i)),
+          "Type mismatch for stats aggregate {}: {} vs. {}",
+          outputName,
+          type->toString(),
+          outputType_->childAt(i)->toString());
+    }
+    scanOutputType_ = ROW(std::move(names), std::move(types));
+    aggregateAccumulators_.resize(statsAggregates_.size());
+  }
+
   std::vector<std::string> readColumnNames;
-  auto readColumnTypes = outputType_->children();
-  for (const auto& outputName : outputType_->names()) {
+  std::vector<TypePtr> readColumnTypes;
+  for (auto i = 0; i < scanOutputType_->size(); ++i) {
+    const auto& outputName = scanOutputType_->nameOf(i);
+    auto projection = std::find_if(
+        projections.begin(), projections.end(), [&](const auto& candidate) {
+          return candidate.name == outputName;
+        });
+    if (projection != projections.end()) {
+      VELOX_USER_CHECK(
+          projection->expr->type()->equivalent(*outputType_->childAt(i)),
+          "Type mismatch for remaining filter projection {}: {} vs. {}",
+          outputName,
+          projection->expr->type()->toString(),
+          outputType_->childAt(i)->toString());
+      // Expression 0 of 'remainingFilterExprSet_' is the filter.
+      projectedOutputs_.emplace(i, 1 + (projection - projections.begin()));
+      continue;
+    }
     auto it = columnHandles.find(outputName);
     VELOX_CHECK(
         it != columnHandles.end(),
@@ -109,6 +234,7 @@ HiveDataSource::HiveDataSource(
 
     auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
     readColumnNames.push_back(handle->name());
+    readColumnTypes.push_back(scanOutputType_->childAt(i));
     for (auto& subfield : handle->requiredSubfields()) {
       VELOX_USER_CHECK_EQ(
           getColumnName(subfield),
@@ -118,12 +244,9 @@ HiveDataSource::HiveDataSource(
     }
   }
 
-  hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
-  VELOX_CHECK_NOT_NULL(
-      hiveTableHandle_, "TableHandle must be an instance of HiveTableHandle");
   if (hiveConfig_->isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->sessionProperties())) {
-    checkColumnNameLowerCase(outputType_);
+    checkColumnNameLowerCase(scanOutputType_);
     checkColumnNameLowerCase(hiveTableHandle_->subfieldFilters(), infoColumns_);
     checkColumnNameLowerCase(hiveTableHandle_->remainingFilter());
   }
@@ -142,28 +265,56 @@ HiveDataSource::HiveDataSource(
     randomSkip_ = std::make_shared<random::RandomSkipTracker>(sampleRate);
   }
 
+  const auto metadataFilterExpr = remainingFilter;
+  if (!remainingFilter && !projections.empty()) {
+    // The projections are evaluated after an always true filter.
+    remainingFilter =
+        std::make_shared<core::ConstantTypedExpr>(BOOLEAN(), variant(true));
+  }
+
   if (remainingFilter) {
-    remainingFilterExprSet_ = expressionEvaluator_->compile(remainingFilter);
+    if (projections.empty()) {
+      remainingFilterExprSet_ = expressionEvaluator_->compile(remainingFilter);
+    } else {
+      // The filter and the projections are compiled together so that their
+      // common subexpressions are computed once.
+      std::vector<core::TypedExprPtr> exprs{remainingFilter};
+      for (const auto& projection : projections) {
+        exprs.push_back(projection.expr);
+      }
+      remainingFilterExprSet_ = expressionEvaluator_->compile(exprs);
+    }
     auto& remainingFilterExpr = remainingFilterExprSet_->expr(0);
     folly::F14FastMap<std::string, column_index_t> columnNames;
     for (int i = 0; i < readColumnNames.size(); ++i) {
       columnNames[readColumnNames[i]] = i;
     }
-    for (auto& input : remainingFilterExpr->distinctFields()) {
-      auto it = columnNames.find(input->field());
-      if (it != columnNames.end()) {
-        if (shouldEagerlyMaterialize(*remainingFilterExpr, *input)) {
-          multiReferencedFields_.push_back(it->second);
+    for (const auto& expr : remainingFilterExprSet_->exprs()) {
+      for (auto& input : expr->distinctFields()) {
+        auto it = columnNames.find(input->field());
+        if (it != columnNames.end()) {
+          if (expr == remainingFilterExpr &&
+              shouldEagerlyMaterialize(*remainingFilterExpr, *input)) {
+            multiReferencedFields_.push_back(it->second);
+          }
+          continue;
         }
-        continue;
+        // Remaining filter may reference columns that are not used otherwise,
+        // e.g. are not being projected out and are not used in range filters.
+        // Make sure to add these columns to readerOutputType_.
+        columnNames[input->field()] = readColumnNames.size();
+        readColumnNames.push_back(input->field());
+        readColumnTypes.push_back(input->type());
       }
-      // Remaining filter may reference columns that are not used otherwise,
-      // e.g. are not being projected out and are not used in range filters.
-      // Make sure to add these columns to readerOutputType_.
-      readColumnNames.push_back(input->field());
-      readColumnTypes.push_back(input->type());
     }
     remainingFilterSubfields_ = remainingFilterExpr->extractSubfields();
+    for (auto i = 1; i < remainingFilterExprSet_->size(); ++i) {
+      auto subfields = remainingFilterExprSet_->expr(i)->extractSubfields();
+      std::move(
+          subfields.begin(),
+          subfields.end(),
+          std::back_inserter(remainingFilterSubfields_));
+    }
     if (VLOG_IS_ON(1)) {
       VLOG(1) << fmt::format(
           "Extracted subfields from remaining filter: [{}]",
@@ -197,13 +348,55 @@ HiveDataSource::HiveDataSource(
       hiveConfig_->readStatsBasedFilterReorderDisabled(
           connectorQueryCtx_->sessionProperties()),
       pool_);
-  if (remainingFilter) {
+  if (hiveConfig_->readRunLengthEncoded(
+          connectorQueryCtx_->sessionProperties())) {
+    setRunLengthEncode(*scanSpec_);
+  }
+  if (metadataFilterExpr) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
-        *scanSpec_, *remainingFilter, expressionEvaluator_);
+        *scanSpec_, *metadataFilterExpr, expressionEvaluator_);
   }
 
   ioStats_ = std::make_shared<io::IoStatistics>();
   fsStats_ = std::make_shared<filesystems::File::IoStats>();
+
+  if (splitResultCache_ != nullptr) {
+    // The filters are serialized since their toString() omits values. The
+    // maps are sorted so that equal scans have equal fingerprints.
+    std::vector<std::string> filters;
+    for (const auto& [subfield, filter] : filters_) {
+      filters.push_back(fmt::format(
+          "{}={}", subfield.toString(), folly::toJson(filter->serialize())));
+    }
+    std::sort(filters.begin(), filters.end());
+    std::vector<std::string> subfields;
+    for (const auto& [name, columnSubfields] : subfields_) {
+      for (const auto* subfield : columnSubfields) {
+        subfields.push_back(subfield->toString());
+      }
+    }
+    std::sort(subfields.begin(), subfields.end());
+    const auto* session = connectorQueryCtx_->sessionProperties();
+    const auto& dataColumns = hiveTableHandle_->dataColumns();
+    std::vector<std::string> aggregates;
+    for (const auto& aggregate : statsAggregates_) {
+      aggregates.push_back(fmt::format(
+          "{}({})",
+          HiveTableHandle::StatsAggregate::kindName(aggregate.kind),
+          aggregate.column));
+    }
+    scanFingerprint_ = fmt::format(
+        "{}\n{}\n{}\n{}\n{}\n{}\n{}\n{}\n{}",
+        outputType_->toString(),
+        fmt::join(aggregates, ","),
+        readerOutputType_->toString(),
+        dataColumns ? dataColumns->toString() : "",
+        fmt::join(subfields, ","),
+        fmt::join(filters, ","),
+        remainingFilterExprSet_ ? remainingFilterExprSet_->toString() : "",
+        hiveConfig_->isOrcUseColumnNames(session),
+        hiveConfig_->isParquetUseColumnNames(session));
+  }
 }
 
 std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
@@ -266,6 +459,10 @@ std::unique_ptr<HivePartitionFunction> HiveDataSource::setupBucketConversion() {
         hiveConfig_->readStatsBasedFilterReorderDisabled(
             connectorQueryCtx_->sessionProperties()),
         pool_);
+    if (hiveConfig_->readRunLengthEncoded(
+            connectorQueryCtx_->sessionProperties())) {
+      setRunLengthEncode(*newScanSpec);
+    }
     newScanSpec->moveAdaptationFrom(*scanSpec_);
     scanSpec_ = std::move(newScanSpec);
   }
@@ -304,12 +501,29 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   split_ = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
   VELOX_CHECK_NOT_NULL(split_, "Wrong type of split");
 
+  TestValue::adjust(
+      "facebook::velox::connector::hive::HiveDataSource::addSplit", this);
+
   VLOG(1) << "Adding split " << split_->toString();
 
   if (splitReader_) {
     splitReader_.reset();
   }
 
+  cachedResult_.reset();
+  collectedResult_.reset();
+  splitResultKey_ = splitResultKey();
+  if (splitResultKey_.has_value()) {
+    cachedResult_ = splitResultCache_->find(*splitResultKey_);
+    if (cachedResult_ != nullptr) {
+      // The split is served from the cache without reading the file.
+      cachedResultIndex_ = 0;
+      ++numSplitResultCacheHits_;
+      return;
+    }
+    collectedResult_ = std::make_shared<SplitResult>();
+  }
+
   if (split_->bucketConversion.has_value()) {
     partitionFunction_ = setupBucketConversion();
   } else {
@@ -319,12 +533,23 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     setupRowIdColumn();
   }
 
+  ioStats_->setStorageType(io::CoalescingController::scheme(split_->filePath));
   splitReader_ = createSplitReader();
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
   readerOutputType_ = splitReader_->readerOutputType();
+
+  if (!statsAggregates_.empty()) {
+    aggregatesFinished_ = false;
+    for (auto& accumulator : aggregateAccumulators_) {
+      accumulator = {};
+    }
+    if (!splitReader_->emptySplit() && canAggregateFromFileStats()) {
+      aggregateOutput_ = aggregatesFromFileStats();
+    }
+  }
 }
 
 vector_size_t HiveDataSource::applyBucketConversion(
@@ -369,7 +594,276 @@ vector_size_t HiveDataSource::applyBucketConversion(
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
     velox::ContinueFuture& /*future*/) {
-  VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  VELOX_CHECK(
+      split_ != nullptr || aggregatesFinished_,
+      "No split to process. Call addSplit first.");
+  if (cachedResult_ != nullptr) {
+    return nextCachedOutput();
+  }
+
+  const auto completedRows = completedRows_;
+  auto output =
+      statsAggregates_.empty() ? readNext(size) : readAggregates(size);
+  if (collectedResult_ != nullptr) {
+    collectedResult_->numRowsScanned += completedRows_ - completedRows;
+    if (output.value() == nullptr) {
+      splitResultCache_->add(*splitResultKey_, std::move(collectedResult_));
+      collectedResult_.reset();
+    } else {
+      collectOutput(output.value());
+    }
+  }
+  return output;
+}
+
+std::optional<std::string> HiveDataSource::splitResultKey() const {
+  if (splitResultCache_ == nullptr ||
+      !hiveConfig_->splitResultCacheEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    return std::nullopt;
+  }
+  // A file is identified by its path and modification time. The results
+  // depending on more than the file and the scan are not cached: row ids,
+  // random sampling and bucket conversion, and the table formats whose delete
+  // files change the result of an unchanged data file.
+  if (!split_->properties.has_value() ||
+      !split_->properties->modificationTime.has_value() ||
+      split_->bucketConversion.has_value() ||
+      specialColumns_.rowId.has_value() || randomSkip_ != nullptr ||
+      split_->customSplitInfo.count("table_format") > 0) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> values;
+  const auto addValues = [&](const char* kind, const auto& map) {
+    for (const auto& [name, value] : map) {
+      values.push_back(fmt::format("{}:{}={}", kind, name, value));
+    }
+  };
+  for (const auto& [name, value] : split_->partitionKeys) {
+    values.push_back(
+        value.has_value() ? fmt::format("partition:{}={}", name, *value)
+                          : fmt::format("partition:{}", name));
+  }
+  addValues("info", split_->infoColumns);
+  addValues("serde", split_->serdeParameters);
+  addValues("storage", split_->storageParameters);
+  std::sort(values.begin(), values.end());
+
+  return fmt::format(
+      "{}\n{}\n{}\n{}\n{}\n{}\n{}\n{}\n{}",
+      split_->filePath,
+      *split_->properties->modificationTime,
+      split_->properties->fileSize.value_or(-1),
+      split_->start,
+      split_->length,
+      dwio::common::toString(split_->fileFormat),
+      split_->tableBucketNumber.value_or(-1),
+      fmt::join(values, "\n"),
+      scanFingerprint_);
+}
+
+RowVectorPtr HiveDataSource::nextCachedOutput() {
+  if (cachedResultIndex_ < cachedResult_->vectors.size()) {
+    return cachedResult_->vectors[cachedResultIndex_++];
+  }
+  completedRows_ += cachedResult_->numRowsScanned;
+  cachedResult_.reset();
+  split_.reset();
+  return nullptr;
+}
+
+void HiveDataSource::collectOutput(const RowVectorPtr& output) {
+  if (output->size() == 0) {
+    return;
+  }
+  // The output may wrap vectors reused by the next batches, so the cache
+  // holds flat copies. Copying loads the lazy vectors.
+  try {
+    auto copy = std::static_pointer_cast<RowVector>(
+        BaseVector::copy(*output, splitResultCache_->pool()));
+    collectedResult_->bytes += copy->retainedSize();
+    collectedResult_->vectors.push_back(std::move(copy));
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kMemCapExceeded) {
+      throw;
+    }
+    collectedResult_.reset();
+    return;
+  }
+  if (collectedResult_->bytes > splitResultCache_->maxEntryBytes()) {
+    collectedResult_.reset();
+  }
+}
+
+std::optional<RowVectorPtr> HiveDataSource::readAggregates(uint64_t size) {
+  if (aggregatesFinished_) {
+    aggregatesFinished_ = false;
+    return nullptr;
+  }
+  if (aggregateOutput_ != nullptr) {
+    ++numFileStatsAggregateSplits_;
+    resetSplit();
+    aggregatesFinished_ = true;
+    return std::move(aggregateOutput_);
+  }
+  auto input = readNext(size);
+  if (input.value() != nullptr) {
+    addAggregateInput(input.value());
+    return getEmptyOutput();
+  }
+  // 'split_' was reset at its end.
+  aggregatesFinished_ = true;
+  return makeAggregateOutput();
+}
+
+bool HiveDataSource::canAggregateFromFileStats() const {
+  // The deletes of table formats, sampling, bucket conversion and the
+  // remaining filter drop rows that the file statistics count.
+  if (remainingFilterExprSet_ != nullptr || randomSkip_ != nullptr ||
+      partitionFunction_ != nullptr || specialColumns_.rowId.has_value() ||
+      split_->customSplitInfo.count("table_format") > 0) {
+    return false;
+  }
+  return splitReader_->fileStatsCoverSplit();
+}
+
+RowVectorPtr HiveDataSource::aggregatesFromFileStats() const {
+  const auto* reader = splitReader_->reader();
+  const auto numRows = reader->numberOfRows();
+  if (!numRows.has_value()) {
+    return nullptr;
+  }
+  const auto& fileType = reader->rowType();
+  std::vector<VectorPtr> columns;
+  columns.reserve(statsAggregates_.size());
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    const auto& aggregate = statsAggregates_[i];
+    const auto& type = outputType_->childAt(i);
+    if (aggregate.column.empty()) {
+      columns.push_back(makeConstant<int64_t>(BIGINT(), *numRows, pool_));
+      continue;
+    }
+    const auto& name = readerOutputType_->nameOf(aggregateChannels_[i]);
+    if (partitionKeys_.count(name) > 0 || infoColumns_.count(name) > 0) {
+      return nullptr;
+    }
+    if (!fileType->containsChild(name)) {
+      return nullptr;
+    }
+    const auto stats =
+        reader->columnStatistics(reader->typeWithId()->childByName(name)->id());
+    if (stats == nullptr || !stats->getNumberOfValues().has_value()) {
+      return nullptr;
+    }
+    const uint64_t numValues = stats->getNumberOfValues().value();
+    switch (aggregate.kind) {
+      case HiveTableHandle::StatsAggregate::Kind::kCount:
+        columns.push_back(makeConstant<int64_t>(BIGINT(), numValues, pool_));
+        break;
+      case HiveTableHandle::StatsAggregate::Kind::kNullCount:
+        columns.push_back(
+            makeConstant<int64_t>(BIGINT(), *numRows - numValues, pool_));
+        break;
+      case HiveTableHandle::StatsAggregate::Kind::kMin:
+      case HiveTableHandle::StatsAggregate::Kind::kMax: {
+        if (numValues == 0) {
+          columns.push_back(BaseVector::createNullConstant(type, 1, pool_));
+          break;
+        }
+        const auto* intStats =
+            dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+                stats.get());
+        if (!hasIntegerStats(*type) || intStats == nullptr) {
+          return nullptr;
+        }
+        const auto value =
+            aggregate.kind == HiveTableHandle::StatsAggregate::Kind::kMin
+            ? intStats->getMinimum()
+            : intStats->getMaximum();
+        if (!value.has_value()) {
+          return nullptr;
+        }
+        columns.push_back(makeIntegerConstant(type, *value, pool_));
+        break;
+      }
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(nullptr), 1, std::move(columns));
+}
+
+void HiveDataSource::addAggregateInput(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return;
+  }
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    const auto kind = statsAggregates_[i].kind;
+    auto& accumulator = aggregateAccumulators_[i];
+    if (aggregateChannels_[i] == kConstantChannel) {
+      accumulator.count += numRows;
+      continue;
+    }
+    aggregateDecoded_.decode(*input->childAt(aggregateChannels_[i]));
+    if (kind == HiveTableHandle::StatsAggregate::Kind::kCount ||
+        kind == HiveTableHandle::StatsAggregate::Kind::kNullCount) {
+      vector_size_t numNulls = 0;
+      if (aggregateDecoded_.mayHaveNulls()) {
+        for (vector_size_t row = 0; row < numRows; ++row) {
+          numNulls += aggregateDecoded_.isNullAt(row);
+        }
+      }
+      accumulator.count +=
+          kind == HiveTableHandle::StatsAggregate::Kind::kCount
+          ? numRows - numNulls
+          : numNulls;
+      continue;
+    }
+    const auto* base = aggregateDecoded_.base();
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      if (aggregateDecoded_.isNullAt(row)) {
+        continue;
+      }
+      const auto index = aggregateDecoded_.index(row);
+      if (accumulator.value == nullptr) {
+        accumulator.value = BaseVector::create(base->type(), 1, pool_);
+      } else {
+        const auto result = base->compare(
+            accumulator.value.get(), index, 0, CompareFlags{});
+        if (kind == HiveTableHandle::StatsAggregate::Kind::kMin
+                ? result.value() >= 0
+                : result.value() <= 0) {
+          continue;
+        }
+      }
+      accumulator.value->copy(base, 0, index, 1);
+    }
+  }
+}
+
+RowVectorPtr HiveDataSource::makeAggregateOutput() const {
+  std::vector<VectorPtr> columns;
+  columns.reserve(statsAggregates_.size());
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    const auto kind = statsAggregates_[i].kind;
+    const auto& accumulator = aggregateAccumulators_[i];
+    if (kind == HiveTableHandle::StatsAggregate::Kind::kCount ||
+        kind == HiveTableHandle::StatsAggregate::Kind::kNullCount) {
+      columns.push_back(
+          makeConstant<int64_t>(BIGINT(), accumulator.count, pool_));
+    } else if (accumulator.value == nullptr) {
+      columns.push_back(
+          BaseVector::createNullConstant(outputType_->childAt(i), 1, pool_));
+    } else {
+      columns.push_back(accumulator.value);
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(nullptr), 1, std::move(columns));
+}
+
+std::optional<RowVectorPtr> HiveDataSource::readNext(uint64_t size) {
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
   TestValue::adjust(
@@ -440,14 +934,22 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     }
   }
 
-  if (outputType_->size() == 0) {
+  if (scanOutputType_->size() == 0) {
     return exec::wrap(rowsRemaining, remainingIndices, rowVector);
   }
 
+  if (!projectedOutputs_.empty()) {
+    evaluateRemainingFilterProjections(rowVector, rowsRemaining);
+  }
+
   std::vector<VectorPtr> outputColumns;
-  outputColumns.reserve(outputType_->size());
-  for (int i = 0; i < outputType_->size(); ++i) {
-    auto& child = rowVector->childAt(i);
+  outputColumns.reserve(scanOutputType_->size());
+  column_index_t readChannel = 0;
+  for (int i = 0; i < scanOutputType_->size(); ++i) {
+    auto projected = projectedOutputs_.find(i);
+    auto& child = projected != projectedOutputs_.end()
+        ? projectionResults_[projected->second - 1]
+        : rowVector->childAt(readChannel++);
     if (remainingIndices) {
       // Disable dictionary values caching in expression eval so that we
       // don't need to reallocate the result for every batch.
@@ -458,7 +960,11 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   }
 
   return std::make_shared<RowVector>(
-      pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
+      pool_,
+      scanOutputType_,
+      BufferPtr(nullptr),
+      rowsRemaining,
+      outputColumns);
 }
 
 void HiveDataSource::addDynamicFilter(
@@ -470,6 +976,12 @@ void HiveDataSource::addDynamicFilter(
   if (splitReader_) {
     splitReader_->resetFilterCaches();
   }
+  if (splitResultCache_ != nullptr) {
+    scanFingerprint_ += fmt::format(
+        "\n{}={}", outputChannel, folly::toJson(filter->serialize()));
+    // The outputs collected so far were not filtered by 'filter'.
+    collectedResult_.reset();
+  }
 }
 
 std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
@@ -497,6 +1009,12 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"overreadBytes",
         RuntimeCounter(
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)}});
+  // The I/O wait per file system, e.g. ioWaitWallNanos.s3a.
+  for (const auto& [storageType, waitUs] : ioStats_->storageWaitUs()) {
+    res.insert(
+        {fmt::format("ioWaitWallNanos.{}", storageType),
+         RuntimeCounter(waitUs * 1000, RuntimeCounter::Unit::kNanos)});
+  }
   if (ioStats_->read().count() > 0) {
     res.insert({"numStorageRead", RuntimeCounter(ioStats_->read().count())});
     res.insert(
@@ -520,6 +1038,15 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numSplitResultCacheHits_ > 0) {
+    res.insert(
+        {"numSplitResultCacheHits", RuntimeCounter(numSplitResultCacheHits_)});
+  }
+  if (numFileStatsAggregateSplits_ > 0) {
+    res.insert(
+        {"numFileStatsAggregateSplits",
+         RuntimeCounter(numFileStatsAggregateSplits_)});
+  }
 
   const auto fsStats = fsStats_->stats();
   for (const auto& storageStats : fsStats) {
@@ -543,7 +1070,19 @@ void HiveDataSource::setFromDataSource(
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
-  splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  if (splitReader_ != nullptr) {
+    splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  }
+  scanFingerprint_ = std::move(source->scanFingerprint_);
+  splitResultKey_ = std::move(source->splitResultKey_);
+  cachedResult_ = std::move(source->cachedResult_);
+  cachedResultIndex_ = source->cachedResultIndex_;
+  collectedResult_ = std::move(source->collectedResult_);
+  numSplitResultCacheHits_ += source->numSplitResultCacheHits_;
+  aggregateAccumulators_ = std::move(source->aggregateAccumulators_);
+  aggregateOutput_ = std::move(source->aggregateOutput_);
+  aggregatesFinished_ = source->aggregatesFinished_;
+  numFileStatsAggregateSplits_ += source->numFileStatsAggregateSplits_;
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
@@ -584,6 +1123,32 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   return rowsRemaining;
 }
 
+void HiveDataSource::evaluateRemainingFilterProjections(
+    const RowVectorPtr& rowVector,
+    vector_size_t rowsRemaining) {
+  // 'filterEvalCtx_' has the passing rows only if some of 'filterRows_' did
+  // not pass.
+  projectionRows_ = filterRows_;
+  if (rowsRemaining < filterRows_.countSelected()) {
+    projectionRows_.setFromBits(
+        filterEvalCtx_.selectedBits->as<uint64_t>(), rowVector->size());
+  }
+  projectionResults_.resize(remainingFilterExprSet_->size() - 1);
+  uint64_t projectionTimeUs{0};
+  {
+    MicrosecondTimer timer(&projectionTimeUs);
+    expressionEvaluator_->evaluate(
+        remainingFilterExprSet_.get(),
+        1,
+        remainingFilterExprSet_->size(),
+        projectionRows_,
+        *rowVector,
+        projectionResults_);
+  }
+  totalRemainingFilterTime_.fetch_add(
+      projectionTimeUs * 1000, std::memory_order_relaxed);
+}
+
 void HiveDataSource::resetSplit() {
   split_.reset();
   splitReader_->resetSplit();
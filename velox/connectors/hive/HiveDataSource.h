@@ -24,6 +24,7 @@
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/SplitResultCache.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/exec/OperatorUtils.h"
@@ -44,7 +45,8 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      SplitResultCache* splitResultCache = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -65,6 +67,11 @@ class HiveDataSource : public DataSource {
 
   std::unordered_map<std::string, RuntimeCounter> runtimeStats() override;
 
+  std::unordered_map<std::string, io::IoLatencyHistogram> ioLatencyHistograms()
+      override {
+    return ioStats_->latencyHistograms();
+  }
+
   bool allPrefetchIssued() const override {
     return splitReader_ && splitReader_->allPrefetchIssued();
   }
@@ -140,10 +147,51 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Evaluates the remaining filter projections into 'projectionResults_' for
+  // the 'rowsRemaining' rows of 'rowVector' that passed the remaining filter.
+  void evaluateRemainingFilterProjections(
+      const RowVectorPtr& rowVector,
+      vector_size_t rowsRemaining);
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
 
+  // Reads the next output of 'split_' from 'splitReader_'.
+  std::optional<RowVectorPtr> readNext(uint64_t size);
+
+  // Returns the key of 'split_' in 'splitResultCache_' or std::nullopt if the
+  // result of the split is not cacheable.
+  std::optional<std::string> splitResultKey() const;
+
+  // Returns the next vector of 'cachedResult_' or nullptr at the end of the
+  // split.
+  RowVectorPtr nextCachedOutput();
+
+  // Adds a copy of 'output' to 'collectedResult_'. Gives up caching the result
+  // of the split if it gets too large or the cache is out of memory.
+  void collectOutput(const RowVectorPtr& output);
+
+  // Reads the next batch of 'split_' into the stats aggregates. Returns the
+  // row of the aggregates at the end of the split and nullptr on the next
+  // call.
+  std::optional<RowVectorPtr> readAggregates(uint64_t size);
+
+  // Returns true if the file statistics of 'split_' are exact for the rows of
+  // the split that pass the filters.
+  bool canAggregateFromFileStats() const;
+
+  // Returns the row of the stats aggregates of 'split_' computed from the
+  // file statistics, or nullptr if the statistics miss some of them.
+  RowVectorPtr aggregatesFromFileStats() const;
+
+  // Adds the rows of 'input', which has the columns of 'scanOutputType_', to
+  // 'aggregateAccumulators_'.
+  void addAggregateInput(const RowVectorPtr& input);
+
+  // Returns the row of the aggregates in 'aggregateAccumulators_'.
+  RowVectorPtr makeAggregateOutput() const;
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -153,6 +201,10 @@ class HiveDataSource : public DataSource {
 
   // The row type for the data source output, not including filter-only columns
   const RowTypePtr outputType_;
+  // The columns read from 'readerOutputType_' for the output. These are the
+  // columns of 'outputType_' except for the stats aggregates, where they are
+  // the aggregated columns.
+  RowTypePtr scanOutputType_;
   core::ExpressionEvaluator* const expressionEvaluator_;
 
   // Column handles for the Split info columns keyed on their column names.
@@ -164,7 +216,17 @@ class HiveDataSource : public DataSource {
       subfields_;
   common::SubfieldFilters filters_;
   std::shared_ptr<common::MetadataFilter> metadataFilter_;
+  // The remaining filter, followed by the remaining filter projections, if
+  // any.
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
+  // The channels of the output columns computed by remaining filter
+  // projections, mapped to the index of their expression in
+  // 'remainingFilterExprSet_'.
+  folly::F14FastMap<column_index_t, int32_t> projectedOutputs_;
+  // Reusable results of the remaining filter projections and the rows they
+  // are evaluated for.
+  std::vector<VectorPtr> projectionResults_;
+  SelectivityVector projectionRows_;
   RowVectorPtr emptyOutput_;
   dwio::common::RuntimeStatistics runtimeStats_;
   std::atomic<uint64_t> totalRemainingFilterTime_{0};
@@ -187,6 +249,42 @@ class HiveDataSource : public DataSource {
   SelectivityVector filterLazyBaseRows_;
   exec::FilterEvalCtx filterEvalCtx_;
 
+  SplitResultCache* const splitResultCache_;
+  // Fingerprint of the projection and the filters of the scan, part of the
+  // keys of the results in 'splitResultCache_'. Extended by the dynamic
+  // filters.
+  std::string scanFingerprint_;
+  // The key of 'split_' if its result is cacheable.
+  std::optional<std::string> splitResultKey_;
+  // The cached result 'split_' is served from and the index of its next
+  // vector.
+  std::shared_ptr<const SplitResult> cachedResult_;
+  size_t cachedResultIndex_{0};
+  // The result of 'split_' collected for the cache while reading the split.
+  std::shared_ptr<SplitResult> collectedResult_;
+  uint64_t numSplitResultCacheHits_{0};
+
+  struct AggregateAccumulator {
+    int64_t count{0};
+    // The min or max so far, nullptr if there was no non-null value.
+    VectorPtr value;
+  };
+
+  // The stats aggregates of the table handle in the order of 'outputType_'.
+  std::vector<HiveTableHandle::StatsAggregate> statsAggregates_;
+  // The channel in 'scanOutputType_' of the column of each aggregate. Not
+  // used for a count of rows.
+  std::vector<column_index_t> aggregateChannels_;
+  std::vector<AggregateAccumulator> aggregateAccumulators_;
+  DecodedVector aggregateDecoded_;
+  // The aggregates of 'split_' from the file statistics, returned by the next
+  // call to next().
+  RowVectorPtr aggregateOutput_;
+  // True after the aggregates of the last split were returned. The next call
+  // to next() returns nullptr.
+  bool aggregatesFinished_{false};
+  uint64_t numFileStatsAggregateSplits_{0};
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/HiveIndexSource.h"
+
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+// The number of rows read from the index files per DataSource::next() call.
+constexpr uint64_t kReadBatchRows = 1'024;
+
+bool isSupportedKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+common::SubfieldFilters cloneFilters(const common::SubfieldFilters& filters) {
+  common::SubfieldFilters copy;
+  for (const auto& [subfield, filter] : filters) {
+    copy.emplace(subfield.clone(), filter->clone());
+  }
+  return copy;
+}
+
+} // namespace
+
+HiveIndexTableHandle::HiveIndexTableHandle(
+    std::string connectorId,
+    const std::string& tableName,
+    bool filterPushdownEnabled,
+    common::SubfieldFilters subfieldFilters,
+    const core::TypedExprPtr& remainingFilter,
+    const RowTypePtr& dataColumns,
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    std::vector<std::shared_ptr<HiveConnectorSplit>> indexSplits)
+    : HiveTableHandle(
+          std::move(connectorId),
+          tableName,
+          filterPushdownEnabled,
+          std::move(subfieldFilters),
+          remainingFilter,
+          dataColumns,
+          tableParameters),
+      indexSplits_(std::move(indexSplits)) {}
+
+std::string HiveIndexTableHandle::toString() const {
+  return fmt::format(
+      "{}, index splits: {}", HiveTableHandle::toString(), indexSplits_.size());
+}
+
+folly::dynamic HiveIndexTableHandle::serialize() const {
+  auto obj = HiveTableHandle::serialize();
+  obj["name"] = "HiveIndexTableHandle";
+  folly::dynamic splits = folly::dynamic::array;
+  for (const auto& split : indexSplits_) {
+    splits.push_back(split->serialize());
+  }
+  obj["indexSplits"] = splits;
+  return obj;
+}
+
+// static
+ConnectorTableHandlePtr HiveIndexTableHandle::create(
+    const folly::dynamic& obj,
+    void* context) {
+  const auto table = std::dynamic_pointer_cast<const HiveTableHandle>(
+      HiveTableHandle::create(obj, context));
+  VELOX_CHECK_NOT_NULL(table);
+  std::vector<std::shared_ptr<HiveConnectorSplit>> indexSplits;
+  for (const auto& split : obj["indexSplits"]) {
+    indexSplits.push_back(HiveConnectorSplit::create(split));
+  }
+  return std::make_shared<const HiveIndexTableHandle>(
+      table->connectorId(),
+      table->tableName(),
+      table->isFilterPushdownEnabled(),
+      cloneFilters(table->subfieldFilters()),
+      table->remainingFilter(),
+      table->dataColumns(),
+      table->tableParameters(),
+      std::move(indexSplits));
+}
+
+// static
+void HiveIndexTableHandle::registerSerDe() {
+  auto& registry = DeserializationWithContextRegistryForSharedPtr();
+  registry.Register("HiveIndexTableHandle", create);
+}
+
+// Returns the rows of the index files matching the rows of a lookup request,
+// in the order of the input rows.
+class HiveIndexSource::ResultIterator : public LookupResultIterator {
+ public:
+  ResultIterator(
+      std::shared_ptr<HiveIndexSource> source,
+      RowVectorPtr matches,
+      std::vector<vector_size_t> inputRows,
+      std::vector<vector_size_t> matchRows)
+      : source_(std::move(source)),
+        matches_(std::move(matches)),
+        inputRows_(std::move(inputRows)),
+        matchRows_(std::move(matchRows)) {
+    VELOX_CHECK_EQ(inputRows_.size(), matchRows_.size());
+  }
+
+  std::optional<std::unique_ptr<LookupResult>> next(
+      vector_size_t size,
+      velox::ContinueFuture& /*future*/) override {
+    VELOX_CHECK_GT(size, 0);
+    if (offset_ == inputRows_.size()) {
+      return nullptr;
+    }
+    const vector_size_t numRows =
+        std::min<size_t>(size, inputRows_.size() - offset_);
+    auto* pool = source_->pool_;
+    auto inputHits = AlignedBuffer::allocate<vector_size_t>(numRows, pool);
+    auto indices = AlignedBuffer::allocate<vector_size_t>(numRows, pool);
+    std::copy_n(
+        inputRows_.data() + offset_,
+        numRows,
+        inputHits->asMutable<vector_size_t>());
+    std::copy_n(
+        matchRows_.data() + offset_,
+        numRows,
+        indices->asMutable<vector_size_t>());
+    offset_ += numRows;
+
+    const auto& outputType = source_->outputType_;
+    std::vector<VectorPtr> children;
+    children.reserve(outputType->size());
+    for (auto i = 0; i < outputType->size(); ++i) {
+      children.push_back(BaseVector::wrapInDictionary(
+          nullptr, indices, numRows, matches_->childAt(i)));
+    }
+    return std::make_unique<LookupResult>(
+        std::move(inputHits),
+        std::make_shared<RowVector>(
+            pool, outputType, nullptr, numRows, std::move(children)));
+  }
+
+ private:
+  const std::shared_ptr<HiveIndexSource> source_;
+  // The matching rows of the index files, with the columns of 'readType_'.
+  const RowVectorPtr matches_;
+  // The input row and row of 'matches_' of each output row.
+  const std::vector<vector_size_t> inputRows_;
+  const std::vector<vector_size_t> matchRows_;
+  size_t offset_{0};
+};
+
+HiveIndexSource::HiveIndexSource(
+    const RowTypePtr& inputType,
+    size_t numJoinKeys,
+    const RowTypePtr& outputType,
+    const std::shared_ptr<HiveIndexTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    FileHandleFactory* fileHandleFactory,
+    folly::Executor* executor,
+    ConnectorQueryCtx* connectorQueryCtx,
+    const std::shared_ptr<HiveConfig>& hiveConfig)
+    : inputType_(inputType),
+      numJoinKeys_(numJoinKeys),
+      outputType_(outputType),
+      tableHandle_(tableHandle),
+      columnHandles_(columnHandles),
+      fileHandleFactory_(fileHandleFactory),
+      executor_(executor),
+      connectorQueryCtx_(connectorQueryCtx),
+      hiveConfig_(hiveConfig),
+      pool_(connectorQueryCtx_->memoryPool()) {
+  VELOX_USER_CHECK_GT(numJoinKeys_, 0);
+  VELOX_USER_CHECK_EQ(
+      inputType_->size(),
+      numJoinKeys_,
+      "Hive index lookup does not support join conditions");
+
+  auto names = outputType_->names();
+  auto types = outputType_->children();
+  for (auto i = 0; i < numJoinKeys_; ++i) {
+    const auto& keyName = inputType_->nameOf(i);
+    const auto& keyType = inputType_->childAt(i);
+    VELOX_USER_CHECK(
+        isSupportedKeyType(keyType),
+        "Unsupported Hive index lookup key type: {}",
+        keyType->toString());
+    auto it = columnHandles_.find(keyName);
+    VELOX_USER_CHECK(
+        it != columnHandles_.end(),
+        "No column handle for the lookup key {}",
+        keyName);
+    const auto handle = std::dynamic_pointer_cast<HiveColumnHandle>(it->second);
+    VELOX_CHECK_NOT_NULL(handle);
+    VELOX_USER_CHECK(
+        handle->columnType() == HiveColumnHandle::ColumnType::kRegular,
+        "The lookup key {} must be a regular column",
+        keyName);
+    keyColumnNames_.push_back(handle->name());
+
+    if (auto channel = outputType_->getChildIdxIfExists(keyName)) {
+      keyChannels_.push_back(*channel);
+      continue;
+    }
+    keyChannels_.push_back(names.size());
+    names.push_back(keyName);
+    types.push_back(keyType);
+  }
+  readType_ = ROW(std::move(names), std::move(types));
+}
+
+// static
+HiveIndexSource::Key HiveIndexSource::keyAt(
+    const DecodedVector& decoded,
+    vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return static_cast<int64_t>(decoded.valueAt<int8_t>(row));
+    case TypeKind::SMALLINT:
+      return static_cast<int64_t>(decoded.valueAt<int16_t>(row));
+    case TypeKind::INTEGER:
+      return static_cast<int64_t>(decoded.valueAt<int32_t>(row));
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    case TypeKind::VARCHAR:
+      return std::string(decoded.valueAt<StringView>(row));
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::shared_ptr<IndexSource::LookupResultIterator> HiveIndexSource::lookup(
+    const LookupRequest& request) {
+  loadKeyRanges();
+
+  const auto& input = request.input;
+  const auto numInputRows = input->size();
+  SelectivityVector rows(numInputRows);
+  std::vector<DecodedVector> decodedKeys(numJoinKeys_);
+  for (auto i = 0; i < numJoinKeys_; ++i) {
+    decodedKeys[i].decode(*input->childAt(i), rows);
+  }
+
+  // The keys of the input rows, unset for the rows with a null key which
+  // match no rows. The distinct keys of each key column are sorted for the
+  // search of the files and the IN filters.
+  std::vector<std::optional<KeyTuple>> inputKeys(numInputRows);
+  std::vector<std::vector<Key>> distinctKeys(numJoinKeys_);
+  for (auto row = 0; row < numInputRows; ++row) {
+    bool hasNull = false;
+    for (const auto& decoded : decodedKeys) {
+      hasNull |= decoded.isNullAt(row);
+    }
+    if (hasNull) {
+      continue;
+    }
+    auto& keys = inputKeys[row].emplace();
+    keys.reserve(numJoinKeys_);
+    for (auto i = 0; i < numJoinKeys_; ++i) {
+      keys.push_back(keyAt(decodedKeys[i], row));
+      distinctKeys[i].push_back(keys.back());
+    }
+  }
+  for (auto& keys : distinctKeys) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  }
+
+  const auto splits = candidateSplits(distinctKeys[0]);
+  addRuntimeStat("numLookupSplits", splits.size());
+  addRuntimeStat(
+      "numSkippedLookupSplits",
+      tableHandle_->indexSplits().size() - splits.size());
+  if (splits.empty()) {
+    return std::make_shared<ResultIterator>(
+        shared_from_this(),
+        nullptr,
+        std::vector<vector_size_t>{},
+        std::vector<vector_size_t>{});
+  }
+  auto matches = readMatches(makeLookupTableHandle(distinctKeys), splits);
+
+  // The IN filters on the key columns pass the cross product of their values,
+  // so the rows read are matched to the input rows on all the keys.
+  std::map<KeyTuple, std::vector<vector_size_t>> matchRowsByKey;
+  if (matches != nullptr) {
+    SelectivityVector matchRows(matches->size());
+    std::vector<DecodedVector> decodedMatchKeys(numJoinKeys_);
+    for (auto i = 0; i < numJoinKeys_; ++i) {
+      decodedMatchKeys[i].decode(*matches->childAt(keyChannels_[i]), matchRows);
+    }
+    for (auto row = 0; row < matches->size(); ++row) {
+      KeyTuple keys;
+      keys.reserve(numJoinKeys_);
+      for (const auto& decoded : decodedMatchKeys) {
+        if (decoded.isNullAt(row)) {
+          break;
+        }
+        keys.push_back(keyAt(decoded, row));
+      }
+      if (keys.size() == numJoinKeys_) {
+        matchRowsByKey[std::move(keys)].push_back(row);
+      }
+    }
+  }
+
+  std::vector<vector_size_t> inputRows;
+  std::vector<vector_size_t> outputRows;
+  for (auto row = 0; row < numInputRows; ++row) {
+    if (!inputKeys[row].has_value()) {
+      continue;
+    }
+    auto it = matchRowsByKey.find(*inputKeys[row]);
+    if (it == matchRowsByKey.end()) {
+      continue;
+    }
+    for (auto matchRow : it->second) {
+      inputRows.push_back(row);
+      outputRows.push_back(matchRow);
+    }
+  }
+  addRuntimeStat("numLookupMatches", outputRows.size());
+  return std::make_shared<ResultIterator>(
+      shared_from_this(),
+      std::move(matches),
+      std::move(inputRows),
+      std::move(outputRows));
+}
+
+void HiveIndexSource::loadKeyRanges() {
+  if (keyRanges_.has_value()) {
+    return;
+  }
+  std::vector<KeyRange> keyRanges;
+  keyRanges.reserve(tableHandle_->indexSplits().size());
+  for (const auto& split : tableHandle_->indexSplits()) {
+    keyRanges.push_back(readKeyRange(split));
+  }
+  keyRanges_ = std::move(keyRanges);
+}
+
+HiveIndexSource::KeyRange HiveIndexSource::readKeyRange(
+    const std::shared_ptr<HiveConnectorSplit>& split) {
+  const auto fileHandle = fileHandleFactory_->generate(
+      split->filePath,
+      split->properties.has_value() ? &*split->properties : nullptr);
+  dwio::common::ReaderOptions options(pool_);
+  configureReaderOptions(
+      hiveConfig_, connectorQueryCtx_, tableHandle_, split, options);
+  auto input = createBufferedInput(
+      *fileHandle,
+      options,
+      connectorQueryCtx_,
+      std::make_shared<io::IoStatistics>(),
+      std::make_shared<filesystems::File::IoStats>(),
+      executor_);
+  const auto reader =
+      dwio::common::getReaderFactory(options.fileFormat())
+          ->createReader(std::move(input), options);
+
+  const auto channel =
+      reader->rowType()->getChildIdxIfExists(keyColumnNames_[0]);
+  if (!channel.has_value()) {
+    return {};
+  }
+  const auto stats =
+      reader->columnStatistics(reader->typeWithId()->childAt(*channel)->id());
+  if (const auto* integerStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+              stats.get())) {
+    if (integerStats->getMinimum().has_value() &&
+        integerStats->getMaximum().has_value()) {
+      return {*integerStats->getMinimum(), *integerStats->getMaximum()};
+    }
+  } else if (
+      const auto* stringStats =
+          dynamic_cast<const dwio::common::StringColumnStatistics*>(
+              stats.get())) {
+    if (stringStats->getMinimum().has_value() &&
+        stringStats->getMaximum().has_value()) {
+      return {*stringStats->getMinimum(), *stringStats->getMaximum()};
+    }
+  }
+  return {};
+}
+
+std::vector<std::shared_ptr<HiveConnectorSplit>>
+HiveIndexSource::candidateSplits(const std::vector<Key>& firstKeys) const {
+  VELOX_CHECK(keyRanges_.has_value());
+  const auto& splits = tableHandle_->indexSplits();
+  std::vector<std::shared_ptr<HiveConnectorSplit>> candidates;
+  if (firstKeys.empty()) {
+    return candidates;
+  }
+  for (auto i = 0; i < splits.size(); ++i) {
+    const auto& range = (*keyRanges_)[i];
+    if (range.min.has_value() && range.max.has_value()) {
+      auto it =
+          std::lower_bound(firstKeys.begin(), firstKeys.end(), *range.min);
+      if (it == firstKeys.end() || *range.max < *it) {
+        continue;
+      }
+    }
+    candidates.push_back(splits[i]);
+  }
+  return candidates;
+}
+
+std::shared_ptr<HiveTableHandle> HiveIndexSource::makeLookupTableHandle(
+    const std::vector<std::vector<Key>>& keys) const {
+  auto filters = cloneFilters(tableHandle_->subfieldFilters());
+  for (auto i = 0; i < numJoinKeys_; ++i) {
+    std::unique_ptr<common::Filter> filter;
+    if (inputType_->childAt(i)->kind() == TypeKind::VARCHAR) {
+      std::vector<std::string> values;
+      values.reserve(keys[i].size());
+      for (const auto& key : keys[i]) {
+        values.push_back(std::get<std::string>(key));
+      }
+      filter = std::make_unique<common::BytesValues>(values, false);
+    } else {
+      std::vector<int64_t> values;
+      values.reserve(keys[i].size());
+      for (const auto& key : keys[i]) {
+        values.push_back(std::get<int64_t>(key));
+      }
+      filter = common::createBigintValues(values, false);
+    }
+    common::Subfield subfield(keyColumnNames_[i]);
+    auto it = filters.find(subfield);
+    if (it != filters.end()) {
+      it->second = it->second->mergeWith(filter.get());
+    } else {
+      filters.emplace(std::move(subfield), std::move(filter));
+    }
+  }
+  return std::make_shared<HiveTableHandle>(
+      tableHandle_->connectorId(),
+      tableHandle_->tableName(),
+      true,
+      std::move(filters),
+      tableHandle_->remainingFilter(),
+      tableHandle_->dataColumns(),
+      tableHandle_->tableParameters());
+}
+
+RowVectorPtr HiveIndexSource::readMatches(
+    const std::shared_ptr<HiveTableHandle>& tableHandle,
+    const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits) {
+  HiveDataSource dataSource(
+      readType_,
+      tableHandle,
+      columnHandles_,
+      fileHandleFactory_,
+      executor_,
+      connectorQueryCtx_,
+      hiveConfig_);
+  RowVectorPtr matches;
+  for (const auto& split : splits) {
+    dataSource.addSplit(split);
+    for (;;) {
+      auto future = ContinueFuture::makeEmpty();
+      auto output = dataSource.next(kReadBatchRows, future);
+      if (!output.has_value()) {
+        std::move(future).wait();
+        continue;
+      }
+      if (output.value() == nullptr) {
+        break;
+      }
+      const auto& batch = output.value();
+      if (batch->size() == 0) {
+        continue;
+      }
+      // The columns not filtered on are lazy and must be loaded before the
+      // next batch is read.
+      batch->loadedVector();
+      if (matches == nullptr) {
+        matches = BaseVector::create<RowVector>(readType_, 0, pool_);
+      }
+      matches->append(batch.get());
+    }
+  }
+  addRuntimeStat("numLookupRowsRead", dataSource.getCompletedRows());
+  return matches;
+}
+
+void HiveIndexSource::addRuntimeStat(const std::string& name, int64_t value) {
+  std::lock_guard<std::mutex> l(mutex_);
+  runtimeStats_[name].addValue(value);
+}
+
+std::unordered_map<std::string, RuntimeMetric>
+HiveIndexSource::runtimeStats() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return runtimeStats_;
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <variant>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+class HiveConfig;
+
+/// The table handle of a Hive table used as the lookup side of an index
+/// lookup join. 'indexSplits' are the files of the table, which is expected to
+/// be sorted on the lookup keys so that the key ranges of the files, stripes
+/// and row groups do not overlap.
+class HiveIndexTableHandle : public HiveTableHandle {
+ public:
+  HiveIndexTableHandle(
+      std::string connectorId,
+      const std::string& tableName,
+      bool filterPushdownEnabled,
+      common::SubfieldFilters subfieldFilters,
+      const core::TypedExprPtr& remainingFilter,
+      const RowTypePtr& dataColumns,
+      const std::unordered_map<std::string, std::string>& tableParameters,
+      std::vector<std::shared_ptr<HiveConnectorSplit>> indexSplits);
+
+  const std::string& name() const override {
+    static const std::string kName{"HiveIndexTableHandle"};
+    return kName;
+  }
+
+  bool supportsIndexLookup() const override {
+    return true;
+  }
+
+  const std::vector<std::shared_ptr<HiveConnectorSplit>>& indexSplits()
+      const {
+    return indexSplits_;
+  }
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static ConnectorTableHandlePtr create(
+      const folly::dynamic& obj,
+      void* context);
+
+  static void registerSerDe();
+
+ private:
+  const std::vector<std::shared_ptr<HiveConnectorSplit>> indexSplits_;
+};
+
+/// Looks up the rows of a HiveIndexTableHandle matching the join keys of the
+/// lookup requests. A request is served by a single scan of the index files
+/// whose key ranges contain the keys of the request, with the distinct keys
+/// pushed down as IN filters on the key columns. The readers then skip the
+/// stripes and row groups of the files, and the row groups of the DWRF row
+/// index, whose statistics exclude the keys. The key ranges of the files are
+/// read from the file statistics on the first lookup and kept for the
+/// following ones.
+///
+/// The lookup keys must be regular columns of integer or VARCHAR types. Join
+/// conditions are not supported.
+class HiveIndexSource : public IndexSource,
+                        public std::enable_shared_from_this<HiveIndexSource> {
+ public:
+  HiveIndexSource(
+      const RowTypePtr& inputType,
+      size_t numJoinKeys,
+      const RowTypePtr& outputType,
+      const std::shared_ptr<HiveIndexTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      FileHandleFactory* fileHandleFactory,
+      folly::Executor* executor,
+      ConnectorQueryCtx* connectorQueryCtx,
+      const std::shared_ptr<HiveConfig>& hiveConfig);
+
+  std::shared_ptr<LookupResultIterator> lookup(
+      const LookupRequest& request) override;
+
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats() override;
+
+ private:
+  // The value of a lookup key column.
+  using Key = std::variant<int64_t, std::string>;
+
+  // The lookup key values of a row.
+  using KeyTuple = std::vector<Key>;
+
+  // The range of the first lookup key column in an index file, unset if the
+  // file has no statistics for the column.
+  struct KeyRange {
+    std::optional<Key> min;
+    std::optional<Key> max;
+  };
+
+  class ResultIterator;
+
+  static Key keyAt(const DecodedVector& decoded, vector_size_t row);
+
+  // Reads the key ranges of the index files, once.
+  void loadKeyRanges();
+
+  KeyRange readKeyRange(const std::shared_ptr<HiveConnectorSplit>& split);
+
+  // Returns the index files whose key ranges contain any of the sorted
+  // 'firstKeys'.
+  std::vector<std::shared_ptr<HiveConnectorSplit>> candidateSplits(
+      const std::vector<Key>& firstKeys) const;
+
+  // Returns a copy of the table handle with the filters of the table and IN
+  // filters on the key columns with 'keys'.
+  std::shared_ptr<HiveTableHandle> makeLookupTableHandle(
+      const std::vector<std::vector<Key>>& keys) const;
+
+  // Reads the rows of 'splits' matching the keys of the lookup with
+  // 'tableHandle'.
+  RowVectorPtr readMatches(
+      const std::shared_ptr<HiveTableHandle>& tableHandle,
+      const std::vector<std::shared_ptr<HiveConnectorSplit>>& splits);
+
+  void addRuntimeStat(const std::string& name, int64_t value);
+
+  const RowTypePtr inputType_;
+  const size_t numJoinKeys_;
+  const RowTypePtr outputType_;
+  const std::shared_ptr<HiveIndexTableHandle> tableHandle_;
+  const std::unordered_map<
+      std::string,
+      std::shared_ptr<connector::ColumnHandle>>
+      columnHandles_;
+  FileHandleFactory* const fileHandleFactory_;
+  folly::Executor* const executor_;
+  ConnectorQueryCtx* const connectorQueryCtx_;
+  const std::shared_ptr<HiveConfig> hiveConfig_;
+  memory::MemoryPool* const pool_;
+
+  // The columns read from the index files: 'outputType_' followed by the key
+  // columns not in it.
+  RowTypePtr readType_;
+  // The channels of the key columns in 'readType_'.
+  std::vector<column_index_t> keyChannels_;
+  // The names of the key columns in the files.
+  std::vector<std::string> keyColumnNames_;
+
+  // The key ranges of the index files, in the order of the index splits.
+  std::optional<std::vector<KeyRange>> keyRanges_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -277,6 +277,7 @@ void SplitReader::createReader() {
       fsStats_,
       executor_);
 
+  fileSize_ = fileHandleCachePtr->file->size();
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
 }
@@ -306,6 +307,20 @@ bool SplitReader::filterOnStats(
   return false;
 }
 
+bool SplitReader::fileStatsCoverSplit() const {
+  if (baseReader_ == nullptr || baseReaderOpts_.randomSkip() != nullptr ||
+      hiveSplit_->start != 0 || hiveSplit_->length < fileSize_) {
+    return false;
+  }
+  return allRowsPassFilters(
+      scanSpec_.get(),
+      baseReader_.get(),
+      hiveSplit_->partitionKeys,
+      *partitionKeys_,
+      hiveConfig_->readTimestampPartitionValueAsLocalTime(
+          connectorQueryCtx_->sessionProperties()));
+}
+
 bool SplitReader::checkIfSplitIsEmpty(
     dwio::common::RuntimeStatistics& runtimeStats) {
   // emptySplit_ may already be set if the data file is not found. In this case
@@ -333,6 +348,16 @@ void SplitReader::createRowReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       baseRowReaderOpts_);
+  baseRowReaderOpts_.setPageDecompressionAhead(
+      executor_,
+      hiveConfig_->parquetPageDecompressionAheadBytes(
+          connectorQueryCtx_->sessionProperties()));
+  baseRowReaderOpts_.setParallelUnitDecoding(
+      executor_,
+      hiveConfig_->orcReaderMaxParallelStripes(
+          connectorQueryCtx_->sessionProperties()),
+      hiveConfig_->orcReaderParallelStripesMemoryUsageRatio(
+          connectorQueryCtx_->sessionProperties()));
   baseRowReader_ = baseReader_->createRowReader(baseRowReaderOpts_);
 }
 
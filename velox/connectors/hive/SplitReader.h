@@ -101,6 +101,16 @@ class SplitReader {
     return readerOutputType_;
   }
 
+  /// The reader of the file of the split. nullptr if the split is empty
+  /// because the file is missing.
+  const dwio::common::Reader* reader() const {
+    return baseReader_.get();
+  }
+
+  /// Returns true if the split covers the whole file and all its rows pass the
+  /// filters, so that the file statistics describe the rows of the split.
+  bool fileStatsCoverSplit() const;
+
   std::string toString() const;
 
  protected:
@@ -179,6 +189,8 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+  // The size of the file of the split, set by createReader().
+  uint64_t fileSize_{0};
 };
 
 } // namespace facebook::velox::connector::hive
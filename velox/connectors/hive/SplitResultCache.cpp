@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/SplitResultCache.h"
+
+namespace facebook::velox::connector::hive {
+
+SplitResultCache::SplitResultCache(const std::string& name, uint64_t maxBytes)
+    : maxBytes_(maxBytes), cache_(maxBytes) {
+  VELOX_CHECK_GT(maxBytes_, 0);
+  rootPool_ = memory::memoryManager()->addRootPool(
+      name, maxBytes_, std::make_unique<MemoryReclaimer>(this));
+  pool_ = rootPool_->addLeafChild(name);
+}
+
+SplitResultCache::~SplitResultCache() {
+  clear();
+}
+
+std::shared_ptr<const SplitResult> SplitResultCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* entry = cache_.get(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  auto result = *entry;
+  cache_.release(key);
+  return result;
+}
+
+bool SplitResultCache::add(
+    const std::string& key,
+    std::shared_ptr<const SplitResult> result) {
+  VELOX_CHECK_NOT_NULL(result);
+  const auto size = result->bytes + key.size();
+  if (size > maxEntryBytes()) {
+    return false;
+  }
+  auto entry = std::make_unique<Entry>(std::move(result));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!cache_.add(key, entry.get(), size)) {
+    return false;
+  }
+  entry.release();
+  return true;
+}
+
+uint64_t SplitResultCache::evict(uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.free(bytes);
+}
+
+void SplitResultCache::clear() {
+  evict(maxBytes_);
+}
+
+SimpleLRUCacheStats SplitResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+bool SplitResultCache::MemoryReclaimer::reclaimableBytes(
+    const memory::MemoryPool& /*pool*/,
+    uint64_t& reclaimableBytes) const {
+  reclaimableBytes = cache_->stats().curSize;
+  return reclaimableBytes > 0;
+}
+
+uint64_t SplitResultCache::MemoryReclaimer::reclaim(
+    memory::MemoryPool* pool,
+    uint64_t targetBytes,
+    uint64_t /*maxWaitMs*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  // Results still referenced by running scans are freed when these release
+  // them, so the reclaimed bytes may be less than the evicted bytes.
+  int64_t reclaimedBytes{0};
+  {
+    memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
+    cache_->evict(targetBytes == 0 ? cache_->maxBytes_ : targetBytes);
+  }
+  stats.reclaimedBytes += reclaimedBytes;
+  return reclaimedBytes;
+}
+
+} // namespace facebook::velox::connector::hive
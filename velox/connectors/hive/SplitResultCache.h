@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// The output of a HiveDataSource for one split.
+struct SplitResult {
+  /// Deep copies of the output vectors, allocated from the pool of the
+  /// SplitResultCache.
+  std::vector<RowVectorPtr> vectors;
+
+  /// The number of rows read from the file, reported as the completed rows
+  /// of the scans served from the cache.
+  uint64_t numRowsScanned{0};
+
+  /// Retained bytes of 'vectors'.
+  uint64_t bytes{0};
+};
+
+/// Caches the outputs of the HiveDataSources of a connector, so repeated
+/// scans of the same splits with the same filters and projections skip
+/// reading, decoding and filtering. The entries are keyed by the file, its
+/// modification time, the split range and a fingerprint of the scan built by
+/// the HiveDataSource.
+///
+/// The cached vectors live in a root memory pool of the cache whose reclaimer
+/// evicts the least recently used results, so the memory arbitrator can take
+/// the memory of the cache back under memory pressure. The results already
+/// handed out to running scans are freed when these release them.
+class SplitResultCache {
+ public:
+  /// Results larger than 1 / kMaxEntryFraction of the capacity are not
+  /// cached, so a single split does not flush the cache.
+  static constexpr uint64_t kMaxEntryFraction = 8;
+
+  /// 'name' identifies the memory pool of the cache. 'maxBytes' is the
+  /// capacity of the cache and the memory pool.
+  SplitResultCache(const std::string& name, uint64_t maxBytes);
+
+  ~SplitResultCache();
+
+  /// The leaf pool to copy the vectors of a SplitResult into before adding
+  /// it.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// The largest SplitResult in bytes accepted by add().
+  uint64_t maxEntryBytes() const {
+    return maxBytes_ / kMaxEntryFraction;
+  }
+
+  /// Returns the result cached for 'key' or nullptr.
+  std::shared_ptr<const SplitResult> find(const std::string& key);
+
+  /// Caches 'result' for 'key'. Returns false if 'result' is larger than
+  /// maxEntryBytes() or 'key' is already cached.
+  bool add(const std::string& key, std::shared_ptr<const SplitResult> result);
+
+  /// Evicts the least recently used results until at least 'bytes' are
+  /// freed. Returns the bytes of the evicted results.
+  uint64_t evict(uint64_t bytes);
+
+  /// Evicts all the results.
+  void clear();
+
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  class MemoryReclaimer : public memory::MemoryReclaimer {
+   public:
+    explicit MemoryReclaimer(SplitResultCache* cache)
+        : memory::MemoryReclaimer(0), cache_(cache) {}
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    SplitResultCache* const cache_;
+  };
+
+  using Entry = std::shared_ptr<const SplitResult>;
+
+  const uint64_t maxBytes_;
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> cache_;
+};
+
+} // namespace facebook::velox::connector::hive
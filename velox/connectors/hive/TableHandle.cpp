@@ -29,6 +29,16 @@ columnTypeNames() {
   };
 }
 
+std::unordered_map<HiveTableHandle::StatsAggregate::Kind, std::string>
+statsAggregateKindNames() {
+  return {
+      {HiveTableHandle::StatsAggregate::Kind::kCount, "count"},
+      {HiveTableHandle::StatsAggregate::Kind::kNullCount, "null_count"},
+      {HiveTableHandle::StatsAggregate::Kind::kMin, "min"},
+      {HiveTableHandle::StatsAggregate::Kind::kMax, "max"},
+  };
+}
+
 template <typename K, typename V>
 std::unordered_map<V, K> invertMap(const std::unordered_map<K, V>& mapping) {
   std::unordered_map<V, K> inverted;
@@ -103,6 +113,26 @@ void HiveColumnHandle::registerSerDe() {
   registry.Register("HiveColumnHandle", HiveColumnHandle::create);
 }
 
+// static
+std::string HiveTableHandle::StatsAggregate::kindName(Kind kind) {
+  static const auto kNames = statsAggregateKindNames();
+  auto it = kNames.find(kind);
+  VELOX_CHECK(
+      it != kNames.end(),
+      "Invalid stats aggregate kind {}",
+      static_cast<int>(kind));
+  return it->second;
+}
+
+// static
+HiveTableHandle::StatsAggregate::Kind
+HiveTableHandle::StatsAggregate::kindFromName(const std::string& name) {
+  static const auto kKinds = invertMap(statsAggregateKindNames());
+  auto it = kKinds.find(name);
+  VELOX_CHECK(it != kKinds.end(), "Invalid stats aggregate kind {}", name);
+  return it->second;
+}
+
 HiveTableHandle::HiveTableHandle(
     std::string connectorId,
     const std::string& tableName,
@@ -110,14 +140,18 @@ HiveTableHandle::HiveTableHandle(
     common::SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
     const RowTypePtr& dataColumns,
-    const std::unordered_map<std::string, std::string>& tableParameters)
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    std::vector<Projection> remainingFilterProjections,
+    std::vector<StatsAggregate> statsAggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
       dataColumns_(dataColumns),
-      tableParameters_(tableParameters) {}
+      tableParameters_(tableParameters),
+      remainingFilterProjections_(std::move(remainingFilterProjections)),
+      statsAggregates_(std::move(statsAggregates)) {}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -142,6 +176,30 @@ std::string HiveTableHandle::toString() const {
   if (remainingFilter_) {
     out << ", remaining filter: (" << remainingFilter_->toString() << ")";
   }
+  if (!remainingFilterProjections_.empty()) {
+    out << ", remaining filter projections: [";
+    for (auto i = 0; i < remainingFilterProjections_.size(); ++i) {
+      if (i > 0) {
+        out << ", ";
+      }
+      out << remainingFilterProjections_[i].name << ": "
+          << remainingFilterProjections_[i].expr->toString();
+    }
+    out << "]";
+  }
+  if (!statsAggregates_.empty()) {
+    out << ", stats aggregates: [";
+    for (auto i = 0; i < statsAggregates_.size(); ++i) {
+      if (i > 0) {
+        out << ", ";
+      }
+      const auto& aggregate = statsAggregates_[i];
+      out << aggregate.name << ": "
+          << StatsAggregate::kindName(aggregate.kind) << "("
+          << aggregate.column << ")";
+    }
+    out << "]";
+  }
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
@@ -187,6 +245,27 @@ folly::dynamic HiveTableHandle::serialize() const {
     tableParameters[param.first] = param.second;
   }
   obj["tableParameters"] = tableParameters;
+  if (!remainingFilterProjections_.empty()) {
+    folly::dynamic projections = folly::dynamic::array;
+    for (const auto& projection : remainingFilterProjections_) {
+      folly::dynamic pair = folly::dynamic::object;
+      pair["name"] = projection.name;
+      pair["expr"] = projection.expr->serialize();
+      projections.push_back(std::move(pair));
+    }
+    obj["remainingFilterProjections"] = std::move(projections);
+  }
+  if (!statsAggregates_.empty()) {
+    folly::dynamic aggregates = folly::dynamic::array;
+    for (const auto& aggregate : statsAggregates_) {
+      folly::dynamic entry = folly::dynamic::object;
+      entry["name"] = aggregate.name;
+      entry["kind"] = StatsAggregate::kindName(aggregate.kind);
+      entry["column"] = aggregate.column;
+      aggregates.push_back(std::move(entry));
+    }
+    obj["statsAggregates"] = std::move(aggregates);
+  }
 
   return obj;
 }
@@ -226,6 +305,27 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     tableParameters.emplace(key.asString(), value.asString());
   }
 
+  std::vector<Projection> remainingFilterProjections;
+  if (auto it = obj.find("remainingFilterProjections");
+      it != obj.items().end()) {
+    for (const auto& projection : it->second) {
+      remainingFilterProjections.push_back(
+          {projection["name"].asString(),
+           ISerializable::deserialize<core::ITypedExpr>(
+               projection["expr"], context)});
+    }
+  }
+
+  std::vector<StatsAggregate> statsAggregates;
+  if (auto it = obj.find("statsAggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      statsAggregates.push_back(
+          {aggregate["name"].asString(),
+           StatsAggregate::kindFromName(aggregate["kind"].asString()),
+           aggregate["column"].asString()});
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
@@ -233,7 +333,9 @@ ConnectorTableHandlePtr HiveTableHandle::create(
       std::move(subfieldFilters),
       remainingFilter,
       dataColumns,
-      tableParameters);
+      tableParameters,
+      std::move(remainingFilterProjections),
+      std::move(statsAggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -134,6 +134,47 @@ class HiveColumnHandle : public ColumnHandle {
 
 class HiveTableHandle : public ConnectorTableHandle {
  public:
+  /// An output column computed by the data source from the table columns
+  /// together with the remaining filter.
+  struct Projection {
+    std::string name;
+    core::TypedExprPtr expr;
+  };
+
+  /// An aggregate of the rows of a split that pass the filters.
+  struct StatsAggregate {
+    enum class Kind {
+      /// Number of rows, or of non-null values of 'column'.
+      kCount,
+      /// Number of null values of 'column'.
+      kNullCount,
+      kMin,
+      kMax,
+    };
+
+    std::string name;
+    Kind kind;
+    /// The name of the aggregated column in the column handles of the scan.
+    /// Empty for a count of rows.
+    std::string column;
+
+    static std::string kindName(Kind kind);
+
+    static Kind kindFromName(const std::string& name);
+  };
+
+  /// @param remainingFilterProjections Output columns of the scan computed in
+  /// one ExprSet with 'remainingFilter' for the rows that pass the filters, so
+  /// that subexpressions shared with the filter are computed once instead of
+  /// again by a downstream FilterProject. The scan output type refers to them
+  /// by name, without a column handle.
+  /// @param statsAggregates If not empty, the scan returns one row per split
+  /// with these aggregates instead of the rows. The scan output type has one
+  /// column per aggregate, by name, BIGINT for the counts and the type of the
+  /// column for min and max. They are computed from the file statistics when
+  /// these cover the split and all its rows pass the filters, without reading
+  /// the data, and from the rows otherwise. The results of the splits are
+  /// combined downstream, e.g. the counts are summed.
   HiveTableHandle(
       std::string connectorId,
       const std::string& tableName,
@@ -141,7 +182,9 @@ class HiveTableHandle : public ConnectorTableHandle {
       common::SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
       const RowTypePtr& dataColumns = nullptr,
-      const std::unordered_map<std::string, std::string>& tableParameters = {});
+      const std::unordered_map<std::string, std::string>& tableParameters = {},
+      std::vector<Projection> remainingFilterProjections = {},
+      std::vector<StatsAggregate> statsAggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -163,6 +206,14 @@ class HiveTableHandle : public ConnectorTableHandle {
     return remainingFilter_;
   }
 
+  const std::vector<Projection>& remainingFilterProjections() const {
+    return remainingFilterProjections_;
+  }
+
+  const std::vector<StatsAggregate>& statsAggregates() const {
+    return statsAggregates_;
+  }
+
   // Schema of the table.  Need this for reading TEXTFILE.
   const RowTypePtr& dataColumns() const {
     return dataColumns_;
@@ -189,6 +240,8 @@ class HiveTableHandle : public ConnectorTableHandle {
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
+  const std::vector<Projection> remainingFilterProjections_;
+  const std::vector<StatsAggregate> statsAggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
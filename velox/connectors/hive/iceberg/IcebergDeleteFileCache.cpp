@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/IcebergDeleteFileCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+template <TypeKind Kind>
+void appendEqualityKeyValue(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto value = decoded.valueAt<T>(row);
+  if constexpr (std::is_same_v<T, StringView>) {
+    // The size makes the encodings of multi-column keys unambiguous.
+    const int32_t size = value.size();
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(value.data(), value.size());
+  } else {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+} // namespace
+
+int64_t PositionalDeletesSizer::operator()(
+    const PositionalDeletes& deletes) const {
+  return sizeof(PositionalDeletes) +
+      deletes.positions.capacity() * sizeof(int64_t);
+}
+
+int64_t EqualityDeletesSizer::operator()(const EqualityDeletes& deletes) const {
+  int64_t size =
+      sizeof(EqualityDeletes) + deletes.keys.getAllocatedMemorySize();
+  for (const auto& key : deletes.keys) {
+    size += key.capacity();
+  }
+  return size;
+}
+
+// static
+IcebergDeleteFileCache& IcebergDeleteFileCache::instance() {
+  static auto* cache = new IcebergDeleteFileCache();
+  return *cache;
+}
+
+IcebergDeleteFileCache::IcebergDeleteFileCache()
+    : positionalDeletes_(
+          std::make_unique<SimpleLRUCache<std::string, PositionalDeletes>>(
+              kMaxBytes),
+          std::make_unique<DeleteFileGenerator<PositionalDeletes>>()),
+      equalityDeletes_(
+          std::make_unique<SimpleLRUCache<std::string, EqualityDeletes>>(
+              kMaxBytes),
+          std::make_unique<DeleteFileGenerator<EqualityDeletes>>()) {}
+
+PositionalDeletesCachedPtr IcebergDeleteFileCache::positionalDeletes(
+    const std::string& deleteFilePath,
+    const std::string& dataFilePath,
+    const DeleteFileLoader<PositionalDeletes>& loader) {
+  return positionalDeletes_.generate(
+      fmt::format("{}\n{}", deleteFilePath, dataFilePath), &loader);
+}
+
+EqualityDeletesCachedPtr IcebergDeleteFileCache::equalityDeletes(
+    const std::string& deleteFilePath,
+    const DeleteFileLoader<EqualityDeletes>& loader) {
+  return equalityDeletes_.generate(deleteFilePath, &loader);
+}
+
+void IcebergDeleteFileCache::clear() {
+  positionalDeletes_.clearCache();
+  equalityDeletes_.clearCache();
+}
+
+void appendEqualityKey(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key) {
+  if (decoded.isNullAt(row)) {
+    key.push_back(0);
+    return;
+  }
+  key.push_back(1);
+  const auto& type = decoded.base()->type();
+  VELOX_USER_CHECK(
+      type->isPrimitiveType(),
+      "Unsupported Iceberg equality delete column type: {}",
+      type->toString());
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      appendEqualityKeyValue, type->kind(), decoded, row, key);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The positions of the rows of a data file deleted by a positional delete
+/// file, in ascending order.
+struct PositionalDeletes {
+  std::vector<int64_t> positions;
+};
+
+/// The rows deleted by an equality delete file. 'keyType' has the equality
+/// columns of the delete file and 'keys' the deleted values of these columns,
+/// each row encoded by appendEqualityKey().
+struct EqualityDeletes {
+  RowTypePtr keyType;
+  folly::F14FastSet<std::string> keys;
+};
+
+struct PositionalDeletesSizer {
+  int64_t operator()(const PositionalDeletes& deletes) const;
+};
+
+struct EqualityDeletesSizer {
+  int64_t operator()(const EqualityDeletes& deletes) const;
+};
+
+/// Reads a delete file on a cache miss.
+template <typename T>
+using DeleteFileLoader = std::function<std::unique_ptr<T>()>;
+
+/// The CachedFactory generator of the deletes, which are read by the
+/// DeleteFileLoader passed as the properties of the lookup.
+template <typename T>
+class DeleteFileGenerator {
+ public:
+  std::unique_ptr<T> operator()(
+      const std::string& /*key*/,
+      const DeleteFileLoader<T>* loader,
+      void* /*stats*/) {
+    return (*loader)();
+  }
+};
+
+using PositionalDeletesCachedPtr = CachedPtr<std::string, PositionalDeletes>;
+using EqualityDeletesCachedPtr = CachedPtr<std::string, EqualityDeletes>;
+
+/// Process wide cache of the decoded Iceberg delete files. Iceberg never
+/// rewrites a data or delete file in place, so the entries are keyed by file
+/// paths and shared by all the splits and queries reading the same files.
+/// Positional deletes are cached per delete file and data file, so the splits
+/// of a data file read its delete files once. Equality deletes are cached per
+/// delete file. Concurrent lookups of a missing entry read the delete file
+/// once.
+class IcebergDeleteFileCache {
+ public:
+  /// Capacity in bytes of the positional deletes and of the equality deletes.
+  static constexpr int64_t kMaxBytes = 256L << 20;
+
+  static IcebergDeleteFileCache& instance();
+
+  /// Returns the positions deleted by 'deleteFilePath' in 'dataFilePath',
+  /// read by 'loader' if not cached.
+  PositionalDeletesCachedPtr positionalDeletes(
+      const std::string& deleteFilePath,
+      const std::string& dataFilePath,
+      const DeleteFileLoader<PositionalDeletes>& loader);
+
+  /// Returns the rows deleted by 'deleteFilePath', read by 'loader' if not
+  /// cached.
+  EqualityDeletesCachedPtr equalityDeletes(
+      const std::string& deleteFilePath,
+      const DeleteFileLoader<EqualityDeletes>& loader);
+
+  SimpleLRUCacheStats positionalDeletesStats() {
+    return positionalDeletes_.cacheStats();
+  }
+
+  SimpleLRUCacheStats equalityDeletesStats() {
+    return equalityDeletes_.cacheStats();
+  }
+
+  /// Drops the entries not in use.
+  void clear();
+
+ private:
+  IcebergDeleteFileCache();
+
+  CachedFactory<
+      std::string,
+      PositionalDeletes,
+      DeleteFileGenerator<PositionalDeletes>,
+      DeleteFileLoader<PositionalDeletes>,
+      void,
+      PositionalDeletesSizer>
+      positionalDeletes_;
+  CachedFactory<
+      std::string,
+      EqualityDeletes,
+      DeleteFileGenerator<EqualityDeletes>,
+      DeleteFileLoader<EqualityDeletes>,
+      void,
+      EqualityDeletesSizer>
+      equalityDeletes_;
+};
+
+/// Appends the value at 'row' of 'decoded' to 'key'. The rows of a
+/// multi-column key are appended one column after the other. Equal values of
+/// the same type have the same encoding. Only primitive types are supported.
+void appendEqualityKey(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key);
+
+} // namespace facebook::velox::connector::hive::iceberg
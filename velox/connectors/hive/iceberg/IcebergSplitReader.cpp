@@ -16,14 +16,30 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/common/ReaderFactory.h"
 
 using namespace facebook::velox::dwio::common;
 
 namespace facebook::velox::connector::hive::iceberg {
 
+namespace {
+
+// The number of rows read from a delete file at a time.
+constexpr uint64_t kDeleteFileBatchSize = 10'000;
+
+// Sets the size of 'bitmap' to cover bit 'lastSetBit'.
+void extendBitmapSize(Buffer& bitmap, uint64_t lastSetBit) {
+  bitmap.setSize(
+      std::max<uint64_t>(bitmap.size(), bits::nbytes(lastSetBit + 1)));
+}
+
+} // namespace
+
 IcebergSplitReader::IcebergSplitReader(
     const std::shared_ptr<const hive::HiveConnectorSplit>& hiveSplit,
     const std::shared_ptr<const HiveTableHandle>& hiveTableHandle,
@@ -74,11 +90,26 @@ void IcebergSplitReader::prepareSplit(
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  cachedPositionalDeletes_.clear();
+  equalityDeletes_.clear();
+  equalityKeyReader_.reset();
+  equalityKeyFileReader_.reset();
 
+  const bool cacheDeleteFiles = hiveConfig_->icebergDeleteFileCacheEnabled(
+      connectorQueryCtx_->sessionProperties());
+  auto& deleteFileCache = IcebergDeleteFileCache::instance();
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.recordCount == 0) {
+      continue;
+    }
     if (deleteFile.content == FileContent::kPositionalDeletes) {
-      if (deleteFile.recordCount > 0) {
+      if (cacheDeleteFiles) {
+        cachedPositionalDeletes_.push_back({deleteFileCache.positionalDeletes(
+            deleteFile.filePath, hiveSplit_->filePath, [&]() {
+              return loadPositionalDeletes(deleteFile, runtimeStats);
+            })});
+      } else {
         positionalDeleteFileReaders_.push_back(
             std::make_unique<PositionalDeleteFileReader>(
                 deleteFile,
@@ -93,10 +124,308 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      const auto loader = [&]() {
+        return loadEqualityDeletes(deleteFile, runtimeStats);
+      };
+      equalityDeletes_.push_back(
+          cacheDeleteFiles
+              ? deleteFileCache.equalityDeletes(deleteFile.filePath, loader)
+              : EqualityDeletesCachedPtr(loader().release()));
     } else {
       VELOX_NYI();
     }
   }
+  if (!equalityDeletes_.empty()) {
+    createEqualityKeyReader();
+  }
+}
+
+std::unique_ptr<dwio::common::Reader>
+IcebergSplitReader::createDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    const RowTypePtr& fileSchema) const {
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      hiveSplit_->connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig_,
+      connectorQueryCtx_,
+      fileSchema,
+      deleteSplit,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+  auto deleteFileHandle = fileHandleFactory_->generate(deleteFile.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle,
+      deleteReaderOpts,
+      connectorQueryCtx_,
+      ioStats_,
+      fsStats_,
+      executor_);
+  return dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+      ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+}
+
+std::unique_ptr<dwio::common::RowReader>
+IcebergSplitReader::createDeleteFileRowReader(
+    const IcebergDeleteFile& deleteFile,
+    dwio::common::Reader& reader,
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    dwio::common::RuntimeStatistics& runtimeStats) const {
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      hiveSplit_->connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+  if (!testFilters(
+          scanSpec.get(),
+          &reader,
+          deleteSplit->filePath,
+          deleteSplit->partitionKeys,
+          {},
+          hiveConfig_->readTimestampPartitionValueAsLocalTime(
+              connectorQueryCtx_->sessionProperties()))) {
+    runtimeStats.skippedSplitBytes += deleteSplit->length;
+    return nullptr;
+  }
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      reader.rowType(),
+      deleteSplit,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  return reader.createRowReader(deleteRowReaderOpts);
+}
+
+std::unique_ptr<PositionalDeletes> IcebergSplitReader::loadPositionalDeletes(
+    const IcebergDeleteFile& deleteFile,
+    dwio::common::RuntimeStatistics& runtimeStats) const {
+  const auto filePathColumn =
+      IcebergMetadataColumn::icebergDeleteFilePathColumn();
+  const auto posColumn = IcebergMetadataColumn::icebergDeletePosColumn();
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField(posColumn->name, 0);
+  scanSpec->getOrCreateChild(filePathColumn->name)
+      ->setFilter(std::make_unique<common::BytesValues>(
+          std::vector<std::string>({hiveSplit_->filePath}), false));
+  auto reader = createDeleteFileReader(
+      deleteFile,
+      ROW({filePathColumn->name, posColumn->name},
+          {filePathColumn->type, posColumn->type}));
+  auto rowReader =
+      createDeleteFileRowReader(deleteFile, *reader, scanSpec, runtimeStats);
+
+  auto deletes = std::make_unique<PositionalDeletes>();
+  if (rowReader == nullptr) {
+    return deletes;
+  }
+  VectorPtr output =
+      BaseVector::create(ROW({posColumn->name}, {posColumn->type}), 0, pool_);
+  while (rowReader->next(kDeleteFileBatchSize, output) > 0) {
+    if (output->size() == 0) {
+      continue;
+    }
+    const auto* positions =
+        output->as<RowVector>()->childAt(0)->loadedVector();
+    VELOX_CHECK(
+        !positions->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    const auto* rawPositions =
+        positions->asFlatVector<int64_t>()->rawValues();
+    deletes->positions.insert(
+        deletes->positions.end(),
+        rawPositions,
+        rawPositions + positions->size());
+  }
+  // The positions of a data file are sorted in a delete file.
+  if (!std::is_sorted(deletes->positions.begin(), deletes->positions.end())) {
+    std::sort(deletes->positions.begin(), deletes->positions.end());
+  }
+  deletes->positions.shrink_to_fit();
+  return deletes;
+}
+
+std::unique_ptr<EqualityDeletes> IcebergSplitReader::loadEqualityDeletes(
+    const IcebergDeleteFile& deleteFile,
+    dwio::common::RuntimeStatistics& runtimeStats) const {
+  // An equality delete file has the equality columns of the table.
+  auto reader = createDeleteFileReader(deleteFile, nullptr);
+  auto deletes = std::make_unique<EqualityDeletes>();
+  deletes->keyType = reader->rowType();
+  const auto& keyType = deletes->keyType;
+  VELOX_USER_CHECK(
+      deleteFile.equalityFieldIds.empty() ||
+          deleteFile.equalityFieldIds.size() == keyType->size(),
+      "Iceberg equality delete file {} has {} columns for {} equality fields",
+      deleteFile.filePath,
+      keyType->size(),
+      deleteFile.equalityFieldIds.size());
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (column_index_t i = 0; i < keyType->size(); ++i) {
+    VELOX_USER_CHECK(
+        keyType->childAt(i)->isPrimitiveType(),
+        "Unsupported Iceberg equality delete column type: {}",
+        keyType->childAt(i)->toString());
+    scanSpec->addField(keyType->nameOf(i), i);
+  }
+  auto rowReader =
+      createDeleteFileRowReader(deleteFile, *reader, scanSpec, runtimeStats);
+  VELOX_CHECK_NOT_NULL(rowReader);
+
+  VectorPtr output = BaseVector::create(keyType, 0, pool_);
+  std::vector<DecodedVector> decoded(keyType->size());
+  std::string key;
+  while (rowReader->next(kDeleteFileBatchSize, output) > 0) {
+    const auto* keys = output->as<RowVector>();
+    for (column_index_t i = 0; i < keyType->size(); ++i) {
+      decoded[i].decode(*keys->childAt(i)->loadedVector());
+    }
+    for (vector_size_t row = 0; row < keys->size(); ++row) {
+      key.clear();
+      for (const auto& column : decoded) {
+        appendEqualityKey(column, row, key);
+      }
+      deletes->keys.insert(key);
+    }
+  }
+  return deletes;
+}
+
+void IcebergSplitReader::createEqualityKeyReader() {
+  // The equality columns of all the delete files, as typed in the table.
+  const auto fileType = getAdaptedRowType();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  equalityKeyChannels_.clear();
+  for (const auto& deletes : equalityDeletes_) {
+    std::vector<column_index_t> channels;
+    for (column_index_t i = 0; i < deletes->keyType->size(); ++i) {
+      const auto& name = deletes->keyType->nameOf(i);
+      auto it = std::find(names.begin(), names.end(), name);
+      if (it == names.end()) {
+        VELOX_USER_CHECK(
+            fileType->containsChild(name),
+            "Iceberg equality delete column {} not found in data file {}",
+            name,
+            hiveSplit_->filePath);
+        const auto& type = fileType->findChild(name);
+        VELOX_USER_CHECK(
+            type->equivalent(*deletes->keyType->childAt(i)),
+            "Iceberg equality delete column {} has type {} instead of {}",
+            name,
+            deletes->keyType->childAt(i)->toString(),
+            type->toString());
+        names.push_back(name);
+        types.push_back(type);
+        it = names.end() - 1;
+      }
+      channels.push_back(it - names.begin());
+    }
+    equalityKeyChannels_.push_back(std::move(channels));
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (column_index_t i = 0; i < names.size(); ++i) {
+    scanSpec->addField(names[i], i);
+  }
+  // A separate reader of the data file, so the key columns are loaded
+  // independently of 'baseRowReader_'.
+  auto fileHandle = fileHandleFactory_->generate(hiveSplit_->filePath);
+  auto fileInput = createBufferedInput(
+      *fileHandle,
+      baseReaderOpts_,
+      connectorQueryCtx_,
+      ioStats_,
+      fsStats_,
+      executor_);
+  equalityKeyFileReader_ =
+      dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
+          ->createReader(std::move(fileInput), baseReaderOpts_);
+  dwio::common::RowReaderOptions options;
+  configureRowReaderOptions(
+      hiveTableHandle_->tableParameters(),
+      scanSpec,
+      nullptr,
+      fileType,
+      hiveSplit_,
+      hiveConfig_,
+      connectorQueryCtx_->sessionProperties(),
+      options);
+  equalityKeyReader_ = equalityKeyFileReader_->createRowReader(options);
+  equalityKeys_ = BaseVector::create(
+      ROW(std::move(names), std::move(types)), 0, pool_);
+  decodedEqualityKeys_.resize(equalityKeys_->type()->size());
+}
+
+void IcebergSplitReader::applyPositionalDeletes(
+    CachedPositionalDeletes& deletes,
+    int64_t firstRow,
+    uint64_t numRows) {
+  const auto& positions = deletes.deletes->positions;
+  const auto begin = std::lower_bound(
+      positions.begin() + deletes.nextIndex, positions.end(), firstRow);
+  const auto end = std::lower_bound(begin, positions.end(), firstRow + numRows);
+  deletes.nextIndex = end - positions.begin();
+  if (begin == end) {
+    return;
+  }
+  auto* deleteBitmap = deleteBitmap_->asMutable<uint64_t>();
+  for (auto it = begin; it != end; ++it) {
+    bits::setBit(deleteBitmap, *it - firstRow);
+  }
+  extendBitmapSize(*deleteBitmap_, *(end - 1) - firstRow);
+}
+
+void IcebergSplitReader::applyEqualityDeletes(
+    int64_t firstRow,
+    uint64_t numRows) {
+  // Skips the rows skipped by 'baseRowReader_', e.g. on the stats of its
+  // filters.
+  while (equalityKeyReader_->nextRowNumber() < firstRow) {
+    const auto nextRow = equalityKeyReader_->nextRowNumber();
+    VELOX_CHECK_NE(nextRow, dwio::common::RowReader::kAtEnd);
+    VELOX_CHECK_GT(
+        equalityKeyReader_->next(firstRow - nextRow, equalityKeys_), 0);
+  }
+  VELOX_CHECK_EQ(equalityKeyReader_->nextRowNumber(), firstRow);
+
+  auto* deleteBitmap = deleteBitmap_->asMutable<uint64_t>();
+  std::string key;
+  uint64_t numRead = 0;
+  while (numRead < numRows) {
+    const auto rowsScanned =
+        equalityKeyReader_->next(numRows - numRead, equalityKeys_);
+    VELOX_CHECK_GT(rowsScanned, 0);
+    const auto* keys = equalityKeys_->as<RowVector>();
+    VELOX_CHECK_EQ(keys->size(), rowsScanned);
+    for (column_index_t i = 0; i < decodedEqualityKeys_.size(); ++i) {
+      decodedEqualityKeys_[i].decode(*keys->childAt(i)->loadedVector());
+    }
+    for (vector_size_t row = 0; row < keys->size(); ++row) {
+      for (auto i = 0; i < equalityDeletes_.size(); ++i) {
+        key.clear();
+        for (const auto channel : equalityKeyChannels_[i]) {
+          appendEqualityKey(decodedEqualityKeys_[channel], row, key);
+        }
+        if (equalityDeletes_[i]->keys.contains(key)) {
+          bits::setBit(deleteBitmap, numRead + row);
+          extendBitmapSize(*deleteBitmap_, numRead + row);
+          break;
+        }
+      }
+    }
+    numRead += rowsScanned;
+  }
 }
 
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
@@ -115,7 +444,8 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
     return 0;
   }
 
-  if (!positionalDeleteFileReaders_.empty()) {
+  if (!positionalDeleteFileReaders_.empty() ||
+      !cachedPositionalDeletes_.empty() || !equalityDeletes_.empty()) {
     auto numBytes = bits::nbytes(actualSize);
     dwio::common::ensureCapacity<int8_t>(
         deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool(), false, true);
@@ -130,6 +460,15 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
         ++iter;
       }
     }
+
+    // The cached deletes are applied by the row numbers in the data file.
+    const auto firstRow = baseRowReader_->nextRowNumber();
+    for (auto& deletes : cachedPositionalDeletes_) {
+      applyPositionalDeletes(deletes, firstRow, actualSize);
+    }
+    if (!equalityDeletes_.empty()) {
+      applyEqualityDeletes(firstRow, actualSize);
+    }
   }
 
   mutation.deletedRows = deleteBitmap_ && deleteBitmap_->size() > 0
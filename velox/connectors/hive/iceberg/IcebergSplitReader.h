@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFileCache.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -49,6 +50,54 @@ class IcebergSplitReader : public SplitReader {
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
  private:
+  // The positional deletes of the data file read from the
+  // IcebergDeleteFileCache, with the index of the first position after the
+  // rows read so far.
+  struct CachedPositionalDeletes {
+    PositionalDeletesCachedPtr deletes;
+    size_t nextIndex{0};
+  };
+
+  // Opens 'deleteFile' with 'fileSchema', or with the schema of the file if
+  // null.
+  std::unique_ptr<dwio::common::Reader> createDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      const RowTypePtr& fileSchema) const;
+
+  // Returns a row reader of the 'scanSpec' columns of 'reader', or null if
+  // the file stats show that no row passes the filters in 'scanSpec'.
+  std::unique_ptr<dwio::common::RowReader> createDeleteFileRowReader(
+      const IcebergDeleteFile& deleteFile,
+      dwio::common::Reader& reader,
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      dwio::common::RuntimeStatistics& runtimeStats) const;
+
+  // Reads the positions of the data file deleted by 'deleteFile'.
+  std::unique_ptr<PositionalDeletes> loadPositionalDeletes(
+      const IcebergDeleteFile& deleteFile,
+      dwio::common::RuntimeStatistics& runtimeStats) const;
+
+  // Reads the rows deleted by the equality delete file 'deleteFile'.
+  std::unique_ptr<EqualityDeletes> loadEqualityDeletes(
+      const IcebergDeleteFile& deleteFile,
+      dwio::common::RuntimeStatistics& runtimeStats) const;
+
+  // Creates 'equalityKeyReader_' reading the columns of 'equalityDeletes_'
+  // from the data file.
+  void createEqualityKeyReader();
+
+  // Sets the bits in 'deleteBitmap_' of the rows [firstRow, firstRow +
+  // numRows) of the data file deleted by 'deletes'.
+  void applyPositionalDeletes(
+      CachedPositionalDeletes& deletes,
+      int64_t firstRow,
+      uint64_t numRows);
+
+  // Reads the equality columns of rows [firstRow, firstRow + numRows) of the
+  // data file and sets the bits in 'deleteBitmap_' of the rows deleted by
+  // 'equalityDeletes_'.
+  void applyEqualityDeletes(int64_t firstRow, uint64_t numRows);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -56,6 +105,19 @@ class IcebergSplitReader : public SplitReader {
   uint64_t splitOffset_;
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
+  // Set instead of 'positionalDeleteFileReaders_' if the delete files are
+  // cached.
+  std::vector<CachedPositionalDeletes> cachedPositionalDeletes_;
+  std::vector<EqualityDeletesCachedPtr> equalityDeletes_;
+  // Reads the equality delete columns of the data file in the same batches as
+  // 'baseRowReader_', without filters.
+  std::unique_ptr<dwio::common::Reader> equalityKeyFileReader_;
+  std::unique_ptr<dwio::common::RowReader> equalityKeyReader_;
+  // The channels in the output of 'equalityKeyReader_' of the key columns of
+  // each of 'equalityDeletes_'.
+  std::vector<std::vector<column_index_t>> equalityKeyChannels_;
+  VectorPtr equalityKeys_;
+  std::vector<DecodedVector> decodedEqualityKeys_;
   BufferPtr deleteBitmap_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
@@ -16,11 +16,14 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFileCache.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -234,6 +237,55 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     ASSERT_TRUE(it->second.peakMemoryBytes > 0);
   }
 
+  /// Creates 1 base data file with 2 RowGroups of 10000 rows each and 1
+  /// equality delete file deleting the rows with c0 in 'deletedValues'. Reads
+  /// the base data file with 'filters', with and without the delete file
+  /// cache.
+  void assertEqualityDeletes(
+      const std::vector<int64_t>& deletedValues,
+      const std::vector<std::string>& filters = {}) {
+    const auto dataFilePaths =
+        writeDataFiles({{"data_file_1", {10000, 10000}}});
+    const auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(),
+        {makeRowVector({"c0"}, {makeFlatVector<int64_t>(deletedValues)})},
+        config_,
+        flushPolicyFactory_);
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        deleteFilePath->getPath(),
+        fileFomat_,
+        deletedValues.size(),
+        testing::internal::GetFileSize(
+            std::fopen(deleteFilePath->getPath().c_str(), "r")),
+        {1});
+    auto splits = makeIcebergSplits(
+        dataFilePaths.at("data_file_1")->getPath(), {deleteFile});
+
+    std::vector<std::string> conditions = filters;
+    if (!deletedValues.empty()) {
+      conditions.push_back(
+          fmt::format("c0 NOT IN ({})", makeNotInList(deletedValues)));
+    }
+    std::string duckdbSql = "SELECT * FROM tmp";
+    if (!conditions.empty()) {
+      duckdbSql += " WHERE " + folly::join(" AND ", conditions);
+    }
+    const auto plan =
+        PlanBuilder(pool_.get()).tableScan(rowType_, filters).planNode();
+    for (const bool cacheDeleteFiles : {true, false}) {
+      SCOPED_TRACE(fmt::format("cacheDeleteFiles: {}", cacheDeleteFiles));
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .connectorSessionProperty(
+              kHiveConnectorId,
+              HiveConfig::kIcebergDeleteFileCacheEnabledSession,
+              cacheDeleteFiles ? "true" : "false")
+          .splits(splits)
+          .assertResults(duckdbSql);
+    }
+  }
+
   const static int rowCount = 20000;
 
  protected:
@@ -695,6 +747,40 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
   assertMultipleSplits({1000, 9000, 20000}, 1, 0, 20000, 3);
 }
 
+TEST_F(HiveIcebergTest, positionalDeletesCache) {
+  auto& cache = IcebergDeleteFileCache::instance();
+  cache.clear();
+  const auto statsBefore = cache.positionalDeletesStats();
+
+  // The 3 splits of the data file read the delete file once.
+  assertPositionalDeletes(
+      {{"data_file_1", {10000, 10000}}},
+      {{"delete_file_1",
+        {{"data_file_1", makeRandomIncreasingValues(0, 20000)}}}},
+      0,
+      3);
+  const auto stats = cache.positionalDeletesStats();
+  ASSERT_EQ(stats.numElements, 1);
+  ASSERT_EQ(stats.numLookups - statsBefore.numLookups, 3);
+  ASSERT_EQ(stats.numHits - statsBefore.numHits, 2);
+  ASSERT_EQ(stats.pinnedSize, 0);
+
+  cache.clear();
+  ASSERT_EQ(cache.positionalDeletesStats().numElements, 0);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  assertEqualityDeletes({});
+  assertEqualityDeletes({0, 1, 2, 3});
+  assertEqualityDeletes({0, 9999, 10000, 19999});
+  assertEqualityDeletes(makeRandomIncreasingValues(0, 20000));
+  // Deleted values not in the data file.
+  assertEqualityDeletes({-1, 5, 30000});
+  // The filter skips the first RowGroup.
+  assertEqualityDeletes({5, 10005, 15000}, {"c0 >= 10000"});
+  assertEqualityDeletes({5, 10005, 15000}, {"c0 < 10000"});
+}
+
 TEST_F(HiveIcebergTest, testPartitionedRead) {
   RowTypePtr rowType{ROW({"c0", "ds"}, {BIGINT(), DateType::get()})};
   std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
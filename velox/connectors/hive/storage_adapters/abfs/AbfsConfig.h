@@ -55,6 +55,29 @@ static constexpr const char* kAzureAccountOAuth2ClientSecret =
 static constexpr const char* kAzureAccountOAuth2ClientEndpoint =
     "fs.azure.account.oauth2.client.endpoint";
 
+// The maximum number of ranged reads an ABFS file system issues in parallel for
+// a read. 1 reads the ranges one after another.
+static constexpr const char* kAzureReadMaxConcurrentRequests =
+    "fs.azure.read.max.concurrent.requests";
+
+// The minimum size of the parts of a parallel read.
+static constexpr const char* kAzureReadRequestSize =
+    "fs.azure.read.request.size";
+
+// The number of threads an ABFS file system appends the blocks of written files
+// with. 0 appends the blocks synchronously on the writer thread.
+static constexpr const char* kAzureWriteMaxConcurrentRequests =
+    "fs.azure.write.max.concurrent.requests";
+
+// The maximum number of blocks of one file that are appended in the background
+// at the same time.
+static constexpr const char* kAzureWriteMaxRequestsToQueue =
+    "fs.azure.write.max.requests.to.queue";
+
+// The size of the blocks a written file is appended in.
+static constexpr const char* kAzureWriteRequestSize =
+    "fs.azure.write.request.size";
+
 static constexpr const char* kAzureSharedKeyAuthType = "SharedKey";
 
 static constexpr const char* kAzureOAuthAuthType = "OAuth";
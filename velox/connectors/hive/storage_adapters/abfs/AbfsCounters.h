@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string_view>
+
+namespace facebook::velox::filesystems {
+
+// The number of ranged ABFS reads of parallel reads that are queued or running.
+constexpr std::string_view kMetricAbfsInflightReadRequests{
+    "velox.abfs_inflight_read_requests"};
+
+// The number of ABFS get properties (metadata) calls.
+constexpr std::string_view kMetricAbfsMetadataCalls{
+    "velox.abfs_metadata_calls"};
+
+// The number of ABFS ranged download calls.
+constexpr std::string_view kMetricAbfsReadCalls{"velox.abfs_read_calls"};
+
+// The number of ABFS ranged download calls that failed.
+constexpr std::string_view kMetricAbfsReadErrors{"velox.abfs_read_errors"};
+
+// The distribution of the latency of ABFS ranged downloads in range of [0, 10s]
+// with 100 buckets.
+constexpr std::string_view kMetricAbfsReadLatencyMs{
+    "velox.abfs_read_latency_ms"};
+
+// The number of ABFS appends of background writes that are queued or running.
+constexpr std::string_view kMetricAbfsInflightAppendRequests{
+    "velox.abfs_inflight_append_requests"};
+
+// The number of ABFS append calls.
+constexpr std::string_view kMetricAbfsAppendCalls{"velox.abfs_append_calls"};
+
+// The distribution of the latency of ABFS append calls in range of [0, 10s]
+// with 100 buckets.
+constexpr std::string_view kMetricAbfsAppendLatencyMs{
+    "velox.abfs_append_latency_ms"};
+
+} // namespace facebook::velox::filesystems
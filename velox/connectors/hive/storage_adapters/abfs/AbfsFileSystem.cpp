@@ -17,10 +17,18 @@
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsFileSystem.h"
 
 #include <fmt/format.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/config/Config.h"
+#include "velox/common/file/Utils.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsConfig.h"
+#include "velox/connectors/hive/storage_adapters/abfs/AbfsCounters.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
@@ -29,10 +37,18 @@ namespace facebook::velox::filesystems {
 
 class AbfsReadFile::Impl {
   constexpr static uint64_t kNaturalReadSize = 4 << 20; // 4M
-  constexpr static uint64_t kReadConcurrency = 8;
 
  public:
-  explicit Impl(std::string_view path, const config::ConfigBase& config) {
+  Impl(
+      std::string_view path,
+      const config::ConfigBase& config,
+      folly::Executor* executor,
+      uint64_t readRequestSize,
+      int32_t maxReadConcurrency)
+      : executor_(executor),
+        readRequestSize_(readRequestSize),
+        maxReadConcurrency_(maxReadConcurrency) {
+    VELOX_CHECK_GT(maxReadConcurrency_, 0);
     auto abfsConfig = AbfsConfig(path, config);
     filePath_ = abfsConfig.filePath();
     fileClient_ = abfsConfig.getReadFileClient();
@@ -50,6 +66,7 @@ class AbfsReadFile::Impl {
     }
 
     try {
+      RECORD_METRIC_VALUE(kMetricAbfsMetadataCalls);
       auto properties = fileClient_->GetProperties();
       length_ = properties.Value.BlobSize;
     } catch (Azure::Storage::StorageException& e) {
@@ -78,22 +95,36 @@ class AbfsReadFile::Impl {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers,
       File::IoStats* stats) const {
-    size_t length = 0;
-    auto size = buffers.size();
-    for (auto& range : buffers) {
-      length += range.size();
-    }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+    // A download spans all the ranges of a part. Only large reads are split
+    // into several parts, which are read in parallel.
+    auto parts = makeParts(offset, buffers);
+    if (executor_ != nullptr && parts.size() > 1) {
+      readParts(std::move(parts)).get();
+    } else {
+      for (const auto& part : parts) {
+        readPart(part);
       }
-      resultOffset += range.size();
     }
+    return file::utils::totalLength(buffers);
+  }
 
-    return length;
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      File::IoStats* stats) const {
+    VELOX_CHECK_NOT_NULL(executor_);
+    try {
+      return readParts(makeParts(offset, buffers))
+          .deferValue(
+              [length = file::utils::totalLength(buffers)](
+                  auto&& /*unused*/) { return length; });
+    } catch (const std::exception& e) {
+      return folly::makeSemiFuture<uint64_t>(e);
+    }
+  }
+
+  bool hasPreadvAsync() const {
+    return executor_ != nullptr;
   }
 
   uint64_t preadv(
@@ -135,6 +166,37 @@ class AbfsReadFile::Impl {
   }
 
  private:
+  using ReadPart = file::utils::ReadPart;
+
+  // Splits the read of 'buffers' at 'offset' into at most
+  // 'maxReadConcurrency_' parts of at least 'readRequestSize_' bytes, each
+  // read with one download.
+  std::vector<ReadPart> makeParts(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    return file::utils::makeReadParts(
+        offset, buffers, readRequestSize_, maxReadConcurrency_);
+  }
+
+  void readPart(const ReadPart& part) const {
+    file::utils::readPart(
+        part, [this](uint64_t offset, uint64_t length, char* position) {
+          preadInternal(offset, length, position);
+        });
+  }
+
+  // Reads 'parts' in parallel on 'executor_'.
+  folly::SemiFuture<folly::Unit> readParts(std::vector<ReadPart> parts) const {
+    RECORD_METRIC_VALUE(kMetricAbfsInflightReadRequests, parts.size());
+    return file::utils::readPartsAsync(
+        std::move(parts), executor_, [this](const ReadPart& part) {
+          SCOPE_EXIT {
+            RECORD_METRIC_VALUE(kMetricAbfsInflightReadRequests, -1);
+          };
+          readPart(part);
+        });
+  }
+
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Azure::Core::Http::HttpRange range;
@@ -143,20 +205,38 @@ class AbfsReadFile::Impl {
 
     Azure::Storage::Blobs::DownloadBlobOptions blob;
     blob.Range = range;
-    auto response = fileClient_->Download(blob);
-    response.Value.BodyStream->ReadToCount(
-        reinterpret_cast<uint8_t*>(position), length);
+    RECORD_METRIC_VALUE(kMetricAbfsReadCalls);
+    uint64_t readUs{0};
+    {
+      MicrosecondTimer timer(&readUs);
+      try {
+        auto response = fileClient_->Download(blob);
+        response.Value.BodyStream->ReadToCount(
+            reinterpret_cast<uint8_t*>(position), length);
+      } catch (...) {
+        RECORD_METRIC_VALUE(kMetricAbfsReadErrors);
+        throw;
+      }
+    }
+    RECORD_HISTOGRAM_METRIC_VALUE(kMetricAbfsReadLatencyMs, readUs / 1000);
   }
 
   std::string filePath_;
   std::unique_ptr<BlobClient> fileClient_;
   int64_t length_ = -1;
+  folly::Executor* const executor_;
+  const uint64_t readRequestSize_;
+  const int32_t maxReadConcurrency_;
 };
 
 AbfsReadFile::AbfsReadFile(
     std::string_view path,
-    const config::ConfigBase& config) {
-  impl_ = std::make_shared<Impl>(path, config);
+    const config::ConfigBase& config,
+    folly::Executor* executor,
+    uint64_t readRequestSize,
+    int32_t maxReadConcurrency) {
+  impl_ = std::make_shared<Impl>(
+      path, config, executor, readRequestSize, maxReadConcurrency);
 }
 
 void AbfsReadFile::initialize(const FileOptions& options) {
@@ -192,6 +272,20 @@ uint64_t AbfsReadFile::preadv(
   return impl_->preadv(regions, iobufs, stats);
 }
 
+folly::SemiFuture<uint64_t> AbfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    File::IoStats* stats) const {
+  if (!impl_->hasPreadvAsync()) {
+    return ReadFile::preadvAsync(offset, buffers, stats);
+  }
+  return impl_->preadvAsync(offset, buffers, stats);
+}
+
+bool AbfsReadFile::hasPreadvAsync() const {
+  return impl_->hasPreadvAsync();
+}
+
 uint64_t AbfsReadFile::size() const {
   return impl_->size();
 }
@@ -215,6 +309,55 @@ uint64_t AbfsReadFile::getNaturalReadSize() const {
 AbfsFileSystem::AbfsFileSystem(std::shared_ptr<const config::ConfigBase> config)
     : FileSystem(config) {
   VELOX_CHECK_NOT_NULL(config.get());
+  maxReadConcurrency_ =
+      config_->get<int32_t>(kAzureReadMaxConcurrentRequests, 8);
+  VELOX_USER_CHECK_GT(
+      maxReadConcurrency_,
+      0,
+      "Invalid configuration: '{}' must be > 0",
+      kAzureReadMaxConcurrentRequests);
+  readRequestSize_ = config::toCapacity(
+      config_->get<std::string>(kAzureReadRequestSize, "4MB"),
+      config::CapacityUnit::BYTE);
+  if (maxReadConcurrency_ > 1) {
+    readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        maxReadConcurrency_,
+        std::make_shared<folly::NamedThreadFactory>("AbfsRead"));
+  }
+
+  const auto writeConcurrency =
+      config_->get<int32_t>(kAzureWriteMaxConcurrentRequests, 8);
+  VELOX_USER_CHECK_GE(
+      writeConcurrency,
+      0,
+      "Invalid configuration: '{}' must be >= 0",
+      kAzureWriteMaxConcurrentRequests);
+  writeRequestSize_ = config::toCapacity(
+      config_->get<std::string>(kAzureWriteRequestSize, "8MB"),
+      config::CapacityUnit::BYTE);
+  maxInflightWriteRequests_ =
+      config_->get<int32_t>(kAzureWriteMaxRequestsToQueue, 2);
+  if (writeConcurrency > 0) {
+    VELOX_USER_CHECK_GT(
+        writeRequestSize_,
+        0,
+        "Invalid configuration: '{}' must be > 0",
+        kAzureWriteRequestSize);
+    VELOX_USER_CHECK_GT(
+        maxInflightWriteRequests_,
+        0,
+        "Invalid configuration: '{}' must be > 0",
+        kAzureWriteMaxRequestsToQueue);
+    writeExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        writeConcurrency,
+        std::make_shared<folly::NamedThreadFactory>("AbfsWrite"));
+  }
+}
+
+AbfsFileSystem::~AbfsFileSystem() {
+  // Joins the reads and appends in progress.
+  readExecutor_.reset();
+  writeExecutor_.reset();
 }
 
 std::string AbfsFileSystem::name() const {
@@ -224,7 +367,12 @@ std::string AbfsFileSystem::name() const {
 std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
-  auto abfsfile = std::make_unique<AbfsReadFile>(path, *config_);
+  auto abfsfile = std::make_unique<AbfsReadFile>(
+      path,
+      *config_,
+      readExecutor_.get(),
+      readRequestSize_,
+      maxReadConcurrency_);
   abfsfile->initialize(options);
   return abfsfile;
 }
@@ -232,6 +380,11 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
 std::unique_ptr<WriteFile> AbfsFileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& /*unused*/) {
-  return std::make_unique<AbfsWriteFile>(path, *config_);
+  return std::make_unique<AbfsWriteFile>(
+      path,
+      *config_,
+      writeExecutor_.get(),
+      writeRequestSize_,
+      maxInflightWriteRequests_);
 }
 } // namespace facebook::velox::filesystems
@@ -17,6 +17,10 @@
 
 #include "velox/common/file/FileSystems.h"
 
+namespace folly {
+class CPUThreadPoolExecutor;
+}
+
 namespace facebook::velox::filesystems {
 
 /// Implementation of the ABS (Azure Blob Storage) filesystem and file
@@ -36,6 +40,8 @@ class AbfsFileSystem : public FileSystem {
  public:
   explicit AbfsFileSystem(std::shared_ptr<const config::ConfigBase> config);
 
+  ~AbfsFileSystem() override;
+
   std::string name() const override;
 
   std::unique_ptr<ReadFile> openFileForRead(
@@ -74,6 +80,17 @@ class AbfsFileSystem : public FileSystem {
   void rmdir(std::string_view path) override {
     VELOX_UNSUPPORTED("rmdir for abfs not implemented");
   }
+
+ private:
+  int32_t maxReadConcurrency_{1};
+  uint64_t readRequestSize_{0};
+  // Executor for parallel ranged reads. Null if reads are not parallel.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+
+  uint64_t writeRequestSize_{0};
+  int32_t maxInflightWriteRequests_{0};
+  // Executor for background appends. Null if appends are synchronous.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> writeExecutor_;
 };
 
 void registerAbfsFileSystem();
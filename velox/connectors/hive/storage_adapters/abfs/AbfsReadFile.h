@@ -25,9 +25,15 @@ class ConfigBase;
 namespace facebook::velox::filesystems {
 class AbfsReadFile final : public ReadFile {
  public:
+  /// If 'executor' is set, reads larger than 'readRequestSize' are split into
+  /// parts that are fetched in parallel on 'executor'. The parts are at least
+  /// 'readRequestSize' bytes and as many as 'maxReadConcurrency'.
   explicit AbfsReadFile(
       std::string_view path,
-      const config::ConfigBase& config);
+      const config::ConfigBase& config,
+      folly::Executor* executor = nullptr,
+      uint64_t readRequestSize = 0,
+      int32_t maxReadConcurrency = 1);
 
   void initialize(const FileOptions& options);
 
@@ -52,6 +58,13 @@ class AbfsReadFile final : public ReadFile {
       folly::Range<folly::IOBuf*> iobufs,
       File::IoStats* stats = nullptr) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      File::IoStats* stats = nullptr) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -15,17 +15,36 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
+
+#include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
+
+#include <deque>
+
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsConfig.h"
+#include "velox/connectors/hive/storage_adapters/abfs/AbfsCounters.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 
 namespace facebook::velox::filesystems {
 
 class AbfsWriteFile::Impl {
  public:
-  explicit Impl(
+  Impl(
       std::string_view path,
-      std::unique_ptr<AzureDataLakeFileClient>& client)
-      : path_(path), client_(std::move(client)) {
+      std::unique_ptr<AzureDataLakeFileClient>& client,
+      folly::Executor* executor,
+      uint64_t writeRequestSize,
+      int32_t maxInflightRequests)
+      : path_(path),
+        client_(std::move(client)),
+        executor_(executor),
+        writeRequestSize_(writeRequestSize),
+        maxInflightRequests_(maxInflightRequests) {
+    VELOX_CHECK(
+        executor_ == nullptr ||
+        (writeRequestSize_ > 0 && maxInflightRequests_ > 0));
     // Make it a no-op if invoked twice.
     if (position_ != -1) {
       return;
@@ -35,6 +54,14 @@ class AbfsWriteFile::Impl {
     client_->create();
   }
 
+  ~Impl() {
+    // Waits for the appends in flight, which refer to 'this'. Their errors are
+    // ignored if the file was not flushed.
+    for (auto& append : inflightAppends_) {
+      std::move(append).wait();
+    }
+  }
+
   void close() {
     if (!closed_) {
       flush();
@@ -44,6 +71,12 @@ class AbfsWriteFile::Impl {
 
   void flush() {
     if (!closed_) {
+      if (executor_ != nullptr) {
+        if (!block_.empty()) {
+          appendCurrentBlock();
+        }
+        waitForAppends(0);
+      }
       client_->flush(position_);
     }
   }
@@ -61,11 +94,65 @@ class AbfsWriteFile::Impl {
   }
 
   void append(const char* buffer, size_t size) {
-    client_->append(reinterpret_cast<const uint8_t*>(buffer), size, position_);
-    position_ += size;
+    if (executor_ == nullptr) {
+      appendBlock(buffer, size, position_);
+      position_ += size;
+      return;
+    }
+    while (size > 0) {
+      const auto bytes =
+          std::min<uint64_t>(size, writeRequestSize_ - block_.size());
+      block_.append(buffer, bytes);
+      buffer += bytes;
+      size -= bytes;
+      if (block_.size() == writeRequestSize_) {
+        appendCurrentBlock();
+      }
+    }
   }
 
  private:
+  // Appends 'block_' at the end of the file in the background. Waits for the
+  // oldest append in flight if there are 'maxInflightRequests_' of them, which
+  // bounds the memory of the file.
+  void appendCurrentBlock() {
+    waitForAppends(maxInflightRequests_ - 1);
+    auto block = std::make_shared<std::string>(std::move(block_));
+    block_.clear();
+    const auto offset = position_;
+    position_ += block->size();
+    RECORD_METRIC_VALUE(kMetricAbfsInflightAppendRequests);
+    inflightAppends_.push_back(
+        folly::via(executor_, [this, block, offset]() {
+          SCOPE_EXIT {
+            RECORD_METRIC_VALUE(kMetricAbfsInflightAppendRequests, -1);
+          };
+          appendBlock(block->data(), block->size(), offset);
+        }).semi());
+  }
+
+  // Waits until at most 'maxInflight' appends are in flight. Throws the error
+  // of a failed append.
+  void waitForAppends(size_t maxInflight) {
+    while (inflightAppends_.size() > maxInflight) {
+      auto append = std::move(inflightAppends_.front());
+      inflightAppends_.pop_front();
+      std::move(append).get();
+    }
+  }
+
+  // Appends 'size' bytes of 'buffer' at 'offset'. Does not modify 'this', so
+  // it can run on any thread.
+  void appendBlock(const char* buffer, size_t size, uint64_t offset) const {
+    RECORD_METRIC_VALUE(kMetricAbfsAppendCalls);
+    uint64_t appendUs{0};
+    {
+      MicrosecondTimer timer(&appendUs);
+      client_->append(reinterpret_cast<const uint8_t*>(buffer), size, offset);
+    }
+    RECORD_HISTOGRAM_METRIC_VALUE(kMetricAbfsAppendLatencyMs, appendUs / 1000);
+  }
+
   bool checkIfFileExists() {
     try {
       client_->getProperties();
@@ -81,22 +168,38 @@ class AbfsWriteFile::Impl {
   const std::string path_;
   const std::unique_ptr<AzureDataLakeFileClient> client_;
 
+  folly::Executor* const executor_;
+  const uint64_t writeRequestSize_;
+  const int32_t maxInflightRequests_;
+
   uint64_t position_ = -1;
   bool closed_ = false;
+  // The data that is appended as the next block if there is an executor.
+  std::string block_;
+  // Appends in the background in order of offset.
+  std::deque<folly::SemiFuture<folly::Unit>> inflightAppends_;
 };
 
 AbfsWriteFile::AbfsWriteFile(
     std::string_view path,
-    const config::ConfigBase& config) {
+    const config::ConfigBase& config,
+    folly::Executor* executor,
+    uint64_t writeRequestSize,
+    int32_t maxInflightRequests) {
   auto abfsConfig = AbfsConfig(path, config);
   auto client = abfsConfig.getWriteFileClient();
-  impl_ = std::make_unique<Impl>(path, client);
+  impl_ = std::make_unique<Impl>(
+      path, client, executor, writeRequestSize, maxInflightRequests);
 }
 
 AbfsWriteFile::AbfsWriteFile(
     std::string_view path,
-    std::unique_ptr<AzureDataLakeFileClient>& client) {
-  impl_ = std::make_unique<Impl>(path, client);
+    std::unique_ptr<AzureDataLakeFileClient>& client,
+    folly::Executor* executor,
+    uint64_t writeRequestSize,
+    int32_t maxInflightRequests) {
+  impl_ = std::make_unique<Impl>(
+      path, client, executor, writeRequestSize, maxInflightRequests);
 }
 
 AbfsWriteFile::~AbfsWriteFile() {}
@@ -33,19 +33,33 @@ namespace facebook::velox::filesystems {
 
 /// Implementation of abfs write file. Nothing written to the file should be
 /// read back until it is closed.
+///
+/// If there is an executor, the data is appended in blocks of
+/// 'writeRequestSize' bytes in the background, at most 'maxInflightRequests'
+/// at a time. The appends go to the offsets of the blocks in the file, so they
+/// can complete in any order. flush() waits for all appends before it commits
+/// the data.
 class AbfsWriteFile : public WriteFile {
  public:
   constexpr static uint64_t kNaturalWriteSize = 8 << 20; // 8M
 
   /// @param path The file path to write.
   /// @param connectStr The connection string used to auth the storage account.
-  AbfsWriteFile(std::string_view path, const config::ConfigBase& config);
+  AbfsWriteFile(
+      std::string_view path,
+      const config::ConfigBase& config,
+      folly::Executor* executor = nullptr,
+      uint64_t writeRequestSize = kNaturalWriteSize,
+      int32_t maxInflightRequests = 1);
 
   /// @param path The file path to write.
   /// @param client The AdlsFileClient.
   AbfsWriteFile(
       std::string_view path,
-      std::unique_ptr<AzureDataLakeFileClient>& client);
+      std::unique_ptr<AzureDataLakeFileClient>& client,
+      folly::Executor* executor = nullptr,
+      uint64_t writeRequestSize = kNaturalWriteSize,
+      int32_t maxInflightRequests = 1);
 
   ~AbfsWriteFile();
 
@@ -15,7 +15,9 @@
  */
 
 #ifdef VELOX_ENABLE_ABFS
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/config/Config.h"
+#include "velox/connectors/hive/storage_adapters/abfs/AbfsCounters.h" // @manual
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsFileSystem.h" // @manual
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h" // @manual
 #include "velox/dwio/common/FileSink.h"
@@ -60,4 +62,19 @@ void registerAbfsFileSystem() {
 #endif
 }
 
+void registerAbfsMetrics() {
+#ifdef VELOX_ENABLE_ABFS
+  DEFINE_METRIC(kMetricAbfsInflightReadRequests, velox::StatType::SUM);
+  DEFINE_METRIC(kMetricAbfsMetadataCalls, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricAbfsReadCalls, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricAbfsReadErrors, velox::StatType::COUNT);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricAbfsReadLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+  DEFINE_METRIC(kMetricAbfsInflightAppendRequests, velox::StatType::SUM);
+  DEFINE_METRIC(kMetricAbfsAppendCalls, velox::StatType::COUNT);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricAbfsAppendLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+#endif
+}
+
 } // namespace facebook::velox::filesystems
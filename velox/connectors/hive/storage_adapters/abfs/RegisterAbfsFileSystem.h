@@ -21,4 +21,6 @@ namespace facebook::velox::filesystems {
 // Register the ABFS filesystem.
 void registerAbfsFileSystem();
 
+void registerAbfsMetrics();
+
 } // namespace facebook::velox::filesystems
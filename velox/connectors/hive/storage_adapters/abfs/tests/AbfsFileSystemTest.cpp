@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <atomic>
 #include <filesystem>
@@ -201,6 +202,29 @@ TEST_F(AbfsFileSystemTest, multipleThreadsWithReadFile) {
   }
 }
 
+TEST_F(AbfsFileSystemTest, parallelRead) {
+  auto abfs = std::make_unique<AbfsFileSystem>(azuriteServer_->hiveConfig(
+      {{kAzureReadMaxConcurrentRequests, "4"},
+       {kAzureReadRequestSize, "64KB"}}));
+  auto readFile = abfs->openFileForRead(azuriteServer_->fileURI());
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  std::string result(kOneMB + 5, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(result.data(), 100'000),
+      folly::Range<char*>(result.data() + 100'000, kOneMB + 5 - 100'000)};
+  ASSERT_EQ(readFile->preadvAsync(10, buffers).get(), kOneMB + 5);
+  ASSERT_EQ(result, std::string(kOneMB, 'c') + "ddddd");
+
+  auto sequentialAbfs = std::make_unique<AbfsFileSystem>(
+      azuriteServer_->hiveConfig({{kAzureReadMaxConcurrentRequests, "1"}}));
+  auto sequentialFile =
+      sequentialAbfs->openFileForRead(azuriteServer_->fileURI());
+  ASSERT_FALSE(sequentialFile->hasPreadvAsync());
+  readData(sequentialFile.get());
+}
+
 TEST_F(AbfsFileSystemTest, missingFile) {
   const std::string abfsFile = azuriteServer_->URI() + "test.txt";
   VELOX_ASSERT_RUNTIME_THROW_CODE(
@@ -252,6 +276,37 @@ TEST(AbfsWriteFileTest, openFileForWriteTest) {
   ASSERT_EQ(fileContent, dataContent);
 }
 
+TEST(AbfsWriteFileTest, backgroundAppends) {
+  std::string_view kAbfsFile =
+      "abfs://test@test.dfs.core.windows.net/test/backgroundwritetest.txt";
+  std::unique_ptr<AzureDataLakeFileClient> mockClient =
+      std::make_unique<MockDataLakeFileClient>();
+  auto mockClientPath =
+      reinterpret_cast<MockDataLakeFileClient*>(mockClient.get())->path();
+  folly::CPUThreadPoolExecutor executor(4);
+  AbfsWriteFile abfsWriteFile(kAbfsFile, mockClient, &executor, kOneMB, 3);
+  std::string dataContent;
+  // Appends that are smaller, larger and the same size as the blocks.
+  for (auto size : {1'000, 3 * kOneMB + 7, kOneMB, 10, 2 * kOneMB}) {
+    auto randomData = AbfsFileSystemTest::generateRandomData(size);
+    abfsWriteFile.append(randomData);
+    dataContent += randomData;
+  }
+  abfsWriteFile.flush();
+  EXPECT_EQ(abfsWriteFile.size(), dataContent.size());
+
+  auto randomData = AbfsFileSystemTest::generateRandomData(kOneMB / 2);
+  abfsWriteFile.append(randomData);
+  dataContent += randomData;
+  abfsWriteFile.close();
+  VELOX_ASSERT_THROW(abfsWriteFile.append("abc"), "File is not open");
+
+  MockDataLakeFileClient readClient(mockClientPath);
+  auto fileContent = readClient.readContent();
+  ASSERT_EQ(fileContent.size(), dataContent.size());
+  ASSERT_EQ(fileContent, dataContent);
+}
+
 TEST_F(AbfsFileSystemTest, renameNotImplemented) {
   VELOX_ASSERT_THROW(
       abfs_->rename("text", "text2"), "rename for abfs not implemented");
@@ -23,9 +23,10 @@
 namespace facebook::velox::filesystems {
 
 void MockDataLakeFileClient::create() {
+  // Not opened for appends, so that blocks can be written at their offsets in
+  // any order.
   fileStream_ = std::ofstream(
-      filePath_,
-      std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+      filePath_, std::ios_base::out | std::ios_base::binary);
 }
 
 PathProperties MockDataLakeFileClient::getProperties() {
@@ -45,11 +46,13 @@ void MockDataLakeFileClient::append(
     const uint8_t* buffer,
     size_t size,
     uint64_t offset) {
+  std::lock_guard<std::mutex> l(mutex_);
   fileStream_.seekp(offset);
   fileStream_.write(reinterpret_cast<const char*>(buffer), size);
 }
 
 void MockDataLakeFileClient::flush(uint64_t position) {
+  std::lock_guard<std::mutex> l(mutex_);
   fileStream_.flush();
 }
 
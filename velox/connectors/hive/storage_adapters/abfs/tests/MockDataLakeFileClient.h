@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <mutex>
+
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 #include "velox/connectors/hive/storage_adapters/abfs/AzureDataLakeFileClient.h"
@@ -65,6 +67,8 @@ class MockDataLakeFileClient : public AzureDataLakeFileClient {
 
  private:
   std::string filePath_;
+  // Serializes the appends of background writes.
+  std::mutex mutex_;
   std::ofstream fileStream_;
 };
 } // namespace facebook::velox::filesystems
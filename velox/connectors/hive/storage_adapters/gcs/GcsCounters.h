@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string_view>
+
+namespace facebook::velox::filesystems {
+
+// The number of ranged GCS reads of parallel reads that are queued or running.
+constexpr std::string_view kMetricGcsInflightReadRequests{
+    "velox.gcs_inflight_read_requests"};
+
+// The number of GCS object metadata calls.
+constexpr std::string_view kMetricGcsMetadataCalls{"velox.gcs_metadata_calls"};
+
+// The number of GCS object metadata calls that failed.
+constexpr std::string_view kMetricGcsGetMetadataErrors{
+    "velox.gcs_get_metadata_errors"};
+
+// The number of GCS ranged read calls.
+constexpr std::string_view kMetricGcsReadObjectCalls{
+    "velox.gcs_read_object_calls"};
+
+// The number of GCS ranged read calls that failed.
+constexpr std::string_view kMetricGcsReadObjectErrors{
+    "velox.gcs_read_object_errors"};
+
+// The distribution of the latency of GCS ranged reads in range of [0, 10s]
+// with 100 buckets.
+constexpr std::string_view kMetricGcsReadObjectLatencyMs{
+    "velox.gcs_read_object_latency_ms"};
+
+// The number of GCS uploads that started.
+constexpr std::string_view kMetricGcsStartedUploads{
+    "velox.gcs_started_uploads"};
+
+// The number of GCS uploads that were completed.
+constexpr std::string_view kMetricGcsSuccessfulUploads{
+    "velox.gcs_successful_uploads"};
+
+// The number of GCS uploads that failed.
+constexpr std::string_view kMetricGcsFailedUploads{"velox.gcs_failed_uploads"};
+
+} // namespace facebook::velox::filesystems
@@ -16,13 +16,20 @@
 
 #include "velox/connectors/hive/storage_adapters/gcs/GcsFileSystem.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/storage_adapters/gcs/GcsCounters.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GcsUtil.h"
 #include "velox/core/QueryConfig.h"
 
 #include <fmt/format.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -40,7 +47,8 @@ namespace gc = ::google::cloud;
 // memory before uploading makes sense.  With unformatted output (the only
 // choice given gcs::io::OutputStream's API) it is better to let the caller
 // provide as large a buffer as they want. The GCS C++ client library will
-// upload this buffer with zero copies if possible.
+// upload this buffer with zero copies if possible. This is the natural read
+// size. The upload buffer size is set by 'hive.gcs.upload-buffer-size'.
 auto constexpr kUploadBufferSize = 256 * 1024;
 
 inline void checkGcsStatus(
@@ -65,8 +73,20 @@ inline void checkGcsStatus(
 
 class GcsReadFile final : public ReadFile {
  public:
-  GcsReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  // If 'executor' is set, reads larger than 'readPartSize' are split into
+  // parts that are fetched in parallel on 'executor'. The parts are at least
+  // 'readPartSize' bytes and as many as 'maxReadConcurrency'.
+  GcsReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* executor = nullptr,
+      uint64_t readPartSize = 0,
+      int32_t maxReadConcurrency = 1)
+      : client_(std::move(client)),
+        executor_(executor),
+        readPartSize_(readPartSize),
+        maxReadConcurrency_(maxReadConcurrency) {
+    VELOX_CHECK_GT(maxReadConcurrency_, 0);
     // assumption it's a proper path
     setBucketAndKeyFromGcsPath(path, bucket_, key_);
   }
@@ -85,8 +105,10 @@ class GcsReadFile final : public ReadFile {
       return;
     }
     // get metadata and initialize length
+    RECORD_METRIC_VALUE(kMetricGcsMetadataCalls);
     auto metadata = client_->GetObjectMetadata(bucket_, key_);
     if (!metadata.ok()) {
+      RECORD_METRIC_VALUE(kMetricGcsGetMetadataErrors);
       checkGcsStatus(
           metadata.status(),
           "Failed to get metadata for GCS object",
@@ -123,21 +145,39 @@ class GcsReadFile final : public ReadFile {
     // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. If a range pointer is nullptr, the
-    // data from stream of size range.size() will be skipped.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
-    }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+    // data from stream of size range.size() will be skipped. A read spans all
+    // the ranges of a part. Only large reads are split into several parts,
+    // which are read in parallel.
+    auto parts = makeParts(offset, buffers);
+    if (executor_ != nullptr && parts.size() > 1) {
+      readParts(std::move(parts)).get();
+    } else {
+      for (const auto& part : parts) {
+        readPart(part);
       }
-      resultOffset += range.size();
     }
-    return length;
+    return file::utils::totalLength(buffers);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers, stats);
+    }
+    try {
+      return readParts(makeParts(offset, buffers))
+          .deferValue(
+              [length = file::utils::totalLength(buffers)](
+                  auto&& /*unused*/) { return length; });
+    } catch (const std::exception& e) {
+      return folly::makeSemiFuture<uint64_t>(e);
+    }
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
   }
 
   uint64_t size() const override {
@@ -163,28 +203,69 @@ class GcsReadFile final : public ReadFile {
   }
 
  private:
+  using ReadPart = file::utils::ReadPart;
+
+  // Splits the read of 'buffers' at 'offset' into at most
+  // 'maxReadConcurrency_' parts of at least 'readPartSize_' bytes, each read
+  // with one ranged read.
+  std::vector<ReadPart> makeParts(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    return file::utils::makeReadParts(
+        offset, buffers, readPartSize_, maxReadConcurrency_);
+  }
+
+  void readPart(const ReadPart& part) const {
+    file::utils::readPart(
+        part, [this](uint64_t offset, uint64_t length, char* position) {
+          preadInternal(offset, length, position);
+        });
+  }
+
+  // Reads 'parts' in parallel on 'executor_'.
+  folly::SemiFuture<folly::Unit> readParts(std::vector<ReadPart> parts) const {
+    RECORD_METRIC_VALUE(kMetricGcsInflightReadRequests, parts.size());
+    return file::utils::readPartsAsync(
+        std::move(parts), executor_, [this](const ReadPart& part) {
+          SCOPE_EXIT {
+            RECORD_METRIC_VALUE(kMetricGcsInflightReadRequests, -1);
+          };
+          readPart(part);
+        });
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    gcs::ObjectReadStream stream = client_->ReadObject(
-        bucket_, key_, gcs::ReadRange(offset, offset + length));
-    if (!stream) {
-      checkGcsStatus(
-          stream.status(), "Failed to get GCS object", bucket_, key_);
-    }
+    RECORD_METRIC_VALUE(kMetricGcsReadObjectCalls);
+    uint64_t readUs{0};
+    {
+      MicrosecondTimer timer(&readUs);
+      gcs::ObjectReadStream stream = client_->ReadObject(
+          bucket_, key_, gcs::ReadRange(offset, offset + length));
+      if (!stream) {
+        RECORD_METRIC_VALUE(kMetricGcsReadObjectErrors);
+        checkGcsStatus(
+            stream.status(), "Failed to get GCS object", bucket_, key_);
+      }
 
-    stream.read(position, length);
-    if (!stream) {
-      checkGcsStatus(
-          stream.status(), "Failed to get read object", bucket_, key_);
+      stream.read(position, length);
+      if (!stream) {
+        RECORD_METRIC_VALUE(kMetricGcsReadObjectErrors);
+        checkGcsStatus(
+            stream.status(), "Failed to get read object", bucket_, key_);
+      }
     }
-    bytesRead_ += length;
+    RECORD_HISTOGRAM_METRIC_VALUE(kMetricGcsReadObjectLatencyMs, readUs / 1000);
   }
 
   std::shared_ptr<gcs::Client> client_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
+  folly::Executor* const executor_;
+  const uint64_t readPartSize_;
+  const int32_t maxReadConcurrency_;
 };
 
 class GcsWriteFile final : public WriteFile {
@@ -210,7 +291,11 @@ class GcsWriteFile final : public WriteFile {
     auto object_metadata = client_->GetObjectMetadata(bucket_, key_);
     VELOX_CHECK(!object_metadata.ok(), "File already exists");
 
+    RECORD_METRIC_VALUE(kMetricGcsStartedUploads);
     auto stream = client_->WriteObject(bucket_, key_);
+    if (!stream.last_status().ok()) {
+      RECORD_METRIC_VALUE(kMetricGcsFailedUploads);
+    }
     checkGcsStatus(
         stream.last_status(),
         "Failed to open GCS object for writing",
@@ -237,6 +322,11 @@ class GcsWriteFile final : public WriteFile {
       stream_.flush();
       stream_.Close();
       closed_ = true;
+      if (stream_.metadata().ok()) {
+        RECORD_METRIC_VALUE(kMetricGcsSuccessfulUploads);
+      } else {
+        RECORD_METRIC_VALUE(kMetricGcsFailedUploads);
+      }
     }
   }
 
@@ -269,7 +359,10 @@ class GcsFileSystem::Impl {
       : hiveConfig_(std::make_shared<HiveConfig>(
             std::make_shared<config::ConfigBase>(config->rawConfigsCopy()))) {}
 
-  ~Impl() = default;
+  ~Impl() {
+    // Joins the reads in progress before the client goes away.
+    readExecutor_.reset();
+  }
 
   // Use the input Config parameters and initialize the GcsClient.
   void initializeClient() {
@@ -291,7 +384,17 @@ class GcsFileSystem::Impl {
       options.set<gc::UnifiedCredentialsOption>(
           gc::MakeGoogleDefaultCredentials());
     }
-    options.set<gcs::UploadBufferSizeOption>(kUploadBufferSize);
+    options.set<gcs::UploadBufferSizeOption>(
+        hiveConfig_->gcsUploadBufferSize());
+
+    const auto connectionPoolSize = hiveConfig_->gcsConnectionPoolSize();
+    if (connectionPoolSize.has_value()) {
+      VELOX_USER_CHECK_GT(
+          connectionPoolSize.value(),
+          0,
+          "Invalid configuration: 'hive.gcs.connection-pool-size' must be > 0");
+      options.set<gcs::ConnectionPoolSizeOption>(connectionPoolSize.value());
+    }
 
     auto max_retry_count = hiveConfig_->gcsMaxRetryCount();
     if (max_retry_count) {
@@ -325,15 +428,44 @@ class GcsFileSystem::Impl {
     }
 
     client_ = std::make_shared<gcs::Client>(options);
+
+    maxReadConcurrency_ = hiveConfig_->gcsMaxReadConcurrency();
+    VELOX_USER_CHECK_GT(
+        maxReadConcurrency_,
+        0,
+        "Invalid configuration: 'hive.gcs.max-read-concurrency' must be > 0");
+    readPartSize_ = hiveConfig_->gcsReadPartSize();
+    if (maxReadConcurrency_ > 1) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          maxReadConcurrency_,
+          std::make_shared<folly::NamedThreadFactory>("GcsRead"));
+    }
   }
 
   std::shared_ptr<gcs::Client> getClient() const {
     return client_;
   }
 
+  // Executor for parallel ranged reads of the files of this file system. Null
+  // if reads are not parallel.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint64_t readPartSize() const {
+    return readPartSize_;
+  }
+
+  int32_t maxReadConcurrency() const {
+    return maxReadConcurrency_;
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<gcs::Client> client_;
+  int32_t maxReadConcurrency_{1};
+  uint64_t readPartSize_{0};
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
 };
 
 GcsFileSystem::GcsFileSystem(std::shared_ptr<const config::ConfigBase> config)
@@ -349,7 +481,12 @@ std::unique_ptr<ReadFile> GcsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GcsReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GcsReadFile>(
+      gcspath,
+      impl_->getClient(),
+      impl_->readExecutor(),
+      impl_->readPartSize(),
+      impl_->maxReadConcurrency());
   gcsfile->initialize(options);
   return gcsfile;
 }
@@ -15,7 +15,9 @@
  */
 
 #ifdef VELOX_ENABLE_GCS
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/config/Config.h"
+#include "velox/connectors/hive/storage_adapters/gcs/GcsCounters.h" // @manual
 #include "velox/connectors/hive/storage_adapters/gcs/GcsFileSystem.h" // @manual
 #include "velox/connectors/hive/storage_adapters/gcs/GcsUtil.h" // @manual
 #include "velox/dwio/common/FileSink.h"
@@ -78,4 +80,19 @@ void registerGcsFileSystem() {
 #endif
 }
 
+void registerGcsMetrics() {
+#ifdef VELOX_ENABLE_GCS
+  DEFINE_METRIC(kMetricGcsInflightReadRequests, velox::StatType::SUM);
+  DEFINE_METRIC(kMetricGcsMetadataCalls, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricGcsGetMetadataErrors, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricGcsReadObjectCalls, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricGcsReadObjectErrors, velox::StatType::COUNT);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricGcsReadObjectLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+  DEFINE_METRIC(kMetricGcsStartedUploads, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricGcsSuccessfulUploads, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricGcsFailedUploads, velox::StatType::COUNT);
+#endif
+}
+
 } // namespace facebook::velox::filesystems
@@ -21,4 +21,6 @@ namespace facebook::velox::filesystems {
 // Register the GCS filesystem.
 void registerGcsFileSystem();
 
+void registerGcsMetrics();
+
 } // namespace facebook::velox::filesystems
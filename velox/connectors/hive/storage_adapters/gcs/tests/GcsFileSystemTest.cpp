@@ -73,6 +73,50 @@ TEST_F(GcsFileSystemTest, readFile) {
   ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
 }
 
+TEST_F(GcsFileSystemTest, parallelRead) {
+  const auto gcsFile = gcsURI(
+      emulator_->preexistingBucketName(), emulator_->preexistingObjectName());
+
+  filesystems::GcsFileSystem gcfs(emulator_->hiveConfig(
+      {{"hive.gcs.max-read-concurrency", "4"},
+       {"hive.gcs.read-part-size", "16B"},
+       {"hive.gcs.connection-pool-size", "8"}}));
+  gcfs.initializeClient();
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  // The read is split into parts of 28 bytes. Gaps at their ends are not read.
+  char buff1[10];
+  char buff2[20];
+  char buff3[30];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buff1, 10),
+      folly::Range<char*>(nullptr, 20),
+      folly::Range<char*>(buff2, 20),
+      folly::Range<char*>(nullptr, 30),
+      folly::Range<char*>(buff3, 30)};
+  ASSERT_EQ(10 + 20 + 20 + 30 + 30, readFile->preadv(0, buffers));
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), kLoremIpsum.substr(0, 10));
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), kLoremIpsum.substr(30, 20));
+  ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
+
+  std::string expected(kLoremIpsum.substr(5, 100));
+  std::string result(100, 0);
+  std::vector<folly::Range<char*>> asyncBuffers = {
+      folly::Range<char*>(result.data(), 61),
+      folly::Range<char*>(result.data() + 61, 39)};
+  ASSERT_EQ(readFile->preadvAsync(5, asyncBuffers).get(), 100);
+  ASSERT_EQ(result, expected);
+
+  filesystems::GcsFileSystem sequentialGcfs(
+      emulator_->hiveConfig({{"hive.gcs.max-read-concurrency", "1"}}));
+  sequentialGcfs.initializeClient();
+  auto sequentialFile = sequentialGcfs.openFileForRead(gcsFile);
+  ASSERT_FALSE(sequentialFile->hasPreadvAsync());
+  ASSERT_EQ(10 + 20 + 20 + 30 + 30, sequentialFile->preadv(0, buffers));
+  ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
+}
+
 TEST_F(GcsFileSystemTest, writeAndReadFile) {
   const std::string_view newFile = "readWriteFile.txt";
   const auto gcsFile = gcsURI(emulator_->preexistingBucketName(), newFile);
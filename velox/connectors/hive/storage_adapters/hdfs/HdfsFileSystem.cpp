@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/config/Config.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/external/hdfs/ArrowHdfsInternal.h"
@@ -26,7 +28,6 @@ std::string_view HdfsFileSystem::kViewfsScheme("viewfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(
       const config::ConfigBase* config,
       const HdfsServiceEndpoint& endpoint) {
@@ -47,6 +48,12 @@ class HdfsFileSystem::Impl {
       driver_->BuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
     }
     driver_->BuilderSetForceNewInstance(builder);
+    if (config != nullptr) {
+      setReadOptions(
+          builder,
+          connector::hive::HiveConfig(
+              std::make_shared<config::ConfigBase>(config->rawConfigsCopy())));
+    }
     hdfsClient_ = driver_->BuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
@@ -56,6 +63,9 @@ class HdfsFileSystem::Impl {
   }
 
   ~Impl() {
+    if (executor_) {
+      executor_->stop();
+    }
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = driver_->Disconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -72,9 +82,44 @@ class HdfsFileSystem::Impl {
     return driver_;
   }
 
+  folly::Executor* executor() {
+    return executor_.get();
+  }
+
  private:
+  // Sets the client options for short-circuit and hedged reads and creates
+  // the executor of asynchronous reads.
+  void setReadOptions(
+      hdfsBuilder* builder,
+      const connector::hive::HiveConfig& hiveConfig) {
+    if (hiveConfig.hdfsShortCircuitRead()) {
+      driver_->BuilderConfSetStr(
+          builder, "dfs.client.read.shortcircuit", "true");
+      const auto socketPath = hiveConfig.hdfsDomainSocketPath();
+      if (!socketPath.empty()) {
+        driver_->BuilderConfSetStr(
+            builder, "dfs.domain.socket.path", socketPath.c_str());
+      }
+    }
+    if (const auto threads = hiveConfig.hdfsHedgedReadThreads(); threads > 0) {
+      driver_->BuilderConfSetStr(
+          builder,
+          "dfs.client.hedged.read.threadpool.size",
+          std::to_string(threads).c_str());
+      driver_->BuilderConfSetStr(
+          builder,
+          "dfs.client.hedged.read.threshold.millis",
+          std::to_string(hiveConfig.hdfsHedgedReadThresholdMs()).c_str());
+    }
+    if (const auto threads = hiveConfig.hdfsAsyncReadThreads(); threads > 0) {
+      executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          threads, std::make_shared<folly::NamedThreadFactory>("HdfsRead"));
+    }
+  }
+
   hdfsFS hdfsClient_;
   filesystems::arrow::io::internal::LibHdfsShim* driver_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -99,7 +144,7 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     }
   }
   return std::make_unique<HdfsReadFile>(
-      impl_->hdfsShim(), impl_->hdfsClient(), path);
+      impl_->hdfsShim(), impl_->hdfsClient(), path, impl_->executor());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
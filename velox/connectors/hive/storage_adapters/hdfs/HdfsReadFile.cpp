@@ -58,6 +58,13 @@ struct HdfsFile {
     VELOX_CHECK(bytesRead >= 0, "Read failure in HDFSReadFile::preadInternal.");
     return bytesRead;
   }
+
+  int32_t pread(uint64_t offset, char* pos, uint64_t length) const {
+    auto bytesRead = driver_->Pread(client_, handle_, offset, pos, length);
+    VELOX_CHECK(
+        bytesRead >= 0, "Pread failure in HDFSReadFile::preadInternal.");
+    return bytesRead;
+  }
 };
 
 class HdfsReadFile::Impl {
@@ -66,7 +73,10 @@ class HdfsReadFile::Impl {
       filesystems::arrow::io::internal::LibHdfsShim* driver,
       hdfsFS hdfs,
       const std::string_view path)
-      : driver_(driver), hdfsClient_(hdfs), filePath_(path) {
+      : driver_(driver),
+        hdfsClient_(hdfs),
+        filePath_(path),
+        hasPread_(driver_->HasPread()) {
     fileInfo_ = driver_->GetPathInfo(hdfsClient_, filePath_.data());
     if (fileInfo_ == nullptr) {
       auto error = fmt::format(
@@ -94,8 +104,19 @@ class HdfsReadFile::Impl {
     if (!file_->handle_) {
       file_->open(driver_, hdfsClient_, filePath_);
     }
-    file_->seek(offset);
     uint64_t totalBytesRead = 0;
+    if (hasPread_) {
+      // Positional reads do not move the file position and are the reads that
+      // the client can hedge.
+      while (totalBytesRead < length) {
+        auto bytesRead = file_->pread(
+            offset + totalBytesRead, pos, length - totalBytesRead);
+        totalBytesRead += bytesRead;
+        pos += bytesRead;
+      }
+      return;
+    }
+    file_->seek(offset);
     while (totalBytesRead < length) {
       auto bytesRead = file_->read(pos, length - totalBytesRead);
       totalBytesRead += bytesRead;
@@ -147,6 +168,7 @@ class HdfsReadFile::Impl {
   filesystems::arrow::io::internal::LibHdfsShim* driver_;
   hdfsFS hdfsClient_;
   std::string filePath_;
+  const bool hasPread_;
   hdfsFileInfo* fileInfo_;
   folly::ThreadLocal<HdfsFile> file_;
 };
@@ -154,8 +176,9 @@ class HdfsReadFile::Impl {
 HdfsReadFile::HdfsReadFile(
     filesystems::arrow::io::internal::LibHdfsShim* driver,
     hdfsFS hdfs,
-    const std::string_view path)
-    : pImpl(std::make_unique<Impl>(driver, hdfs, path)) {}
+    const std::string_view path,
+    folly::Executor* executor)
+    : pImpl(std::make_unique<Impl>(driver, hdfs, path)), executor_(executor) {}
 
 HdfsReadFile::~HdfsReadFile() = default;
 
@@ -174,6 +197,25 @@ std::string HdfsReadFile::pread(
   return pImpl->pread(offset, length);
 }
 
+folly::SemiFuture<uint64_t> HdfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  if (!executor_) {
+    return ReadFile::preadvAsync(offset, buffers, stats);
+  }
+  auto [promise, future] = folly::makePromiseContract<uint64_t>();
+  executor_->add([this,
+                  _promise = std::move(promise),
+                  _offset = offset,
+                  _buffers = buffers,
+                  _stats = stats]() mutable {
+    auto delegateFuture = ReadFile::preadvAsync(_offset, _buffers, _stats);
+    _promise.setTry(std::move(delegateFuture).getTry());
+  });
+  return std::move(future);
+}
+
 uint64_t HdfsReadFile::size() const {
   return pImpl->size();
 }
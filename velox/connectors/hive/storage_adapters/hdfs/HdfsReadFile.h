@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include "velox/common/file/File.h"
 #include "velox/external/hdfs/hdfs.h"
 
@@ -24,14 +25,17 @@ class LibHdfsShim;
 }
 
 /**
- * Implementation of hdfs read file.
+ * Implementation of hdfs read file. Reads with positional reads if the client
+ * supports them, which allows hedged reads. preadvAsync() runs on 'executor'
+ * if set.
  */
 class HdfsReadFile final : public ReadFile {
  public:
   explicit HdfsReadFile(
       filesystems::arrow::io::internal::LibHdfsShim* driver,
       hdfsFS hdfs,
-      std::string_view path);
+      std::string_view path,
+      folly::Executor* executor = nullptr);
   ~HdfsReadFile() override;
 
   std::string_view pread(
@@ -45,6 +49,15 @@ class HdfsReadFile final : public ReadFile {
       uint64_t length,
       filesystems::File::IoStats* stats = nullptr) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr) const final;
+
+  bool hasPreadvAsync() const final {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -62,6 +75,7 @@ class HdfsReadFile final : public ReadFile {
 
   class Impl;
   std::unique_ptr<Impl> pImpl;
+  folly::Executor* const executor_;
 };
 
 } // namespace facebook::velox
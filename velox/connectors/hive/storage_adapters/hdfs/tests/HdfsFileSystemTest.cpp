@@ -15,12 +15,15 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <boost/format.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock-matchers.h>
 #include <atomic>
 #include <random>
 #include "gtest/gtest.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/RegisterHdfsFileSystem.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/tests/HdfsMiniCluster.h"
@@ -212,6 +215,42 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, preadvAsync) {
+  filesystems::arrow::io::internal::LibHdfsShim* driver;
+  auto hdfs = connectHdfsDriver(
+      &driver,
+      std::string(miniCluster->host()),
+      std::string(miniCluster->nameNodePort()));
+  folly::CPUThreadPoolExecutor executor(2);
+  HdfsReadFile readFile(driver, hdfs, kDestinationPath, &executor);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  char head[10];
+  char tail[5];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, 10),
+      folly::Range<char*>(nullptr, kOneMB),
+      folly::Range<char*>(tail, 5)};
+  ASSERT_EQ(readFile.preadvAsync(0, buffers).get(), 15 + kOneMB);
+  ASSERT_EQ(std::string_view(head, 10), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(tail, 5), "ddddd");
+}
+
+TEST_F(HdfsFileSystemTest, readOptions) {
+  auto values = configurationValues;
+  values[connector::hive::HiveConfig::kHdfsHedgedReadThreads] = "2";
+  values[connector::hive::HiveConfig::kHdfsHedgedReadThresholdMs] = "10";
+  values[connector::hive::HiveConfig::kHdfsAsyncReadThreads] = "2";
+  auto config = std::make_shared<const config::ConfigBase>(std::move(values));
+  filesystems::HdfsFileSystem hdfsFileSystem(
+      config,
+      filesystems::HdfsServiceEndpoint(
+          std::string(miniCluster->host()),
+          std::string(miniCluster->nameNodePort())));
+  auto readFile = hdfsFileSystem.openFileForRead(kDestinationPath);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto config = std::make_shared<const config::ConfigBase>(
       std::unordered_map<std::string, std::string>(configurationValues));
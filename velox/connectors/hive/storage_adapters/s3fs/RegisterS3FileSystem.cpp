@@ -98,8 +98,10 @@ std::unique_ptr<velox::dwio::common::FileSink> s3WriteFileSinkGenerator(
   if (isS3File(fileURI)) {
     auto fileSystem =
         filesystems::getFileSystem(fileURI, options.connectorProperties);
+    FileOptions fileOptions{{}, options.pool, std::nullopt};
+    fileOptions.writeStats = options.stats;
     return std::make_unique<dwio::common::WriteFileSink>(
-        fileSystem->openFileForWrite(fileURI, {{}, options.pool, std::nullopt}),
+        fileSystem->openFileForWrite(fileURI, fileOptions),
         fileURI,
         options.metricLogger,
         options.stats);
@@ -139,6 +141,7 @@ void finalizeS3FileSystem() {
 void registerS3Metrics() {
 #ifdef VELOX_ENABLE_S3
   DEFINE_METRIC(kMetricS3ActiveConnections, velox::StatType::SUM);
+  DEFINE_METRIC(kMetricS3InflightReadRequests, velox::StatType::SUM);
   DEFINE_METRIC(kMetricS3StartedUploads, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3FailedUploads, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3SuccessfulUploads, velox::StatType::COUNT);
@@ -87,4 +87,10 @@ std::optional<std::string> S3Config::endpointRegion() const {
   return region;
 }
 
+uint64_t S3Config::readPartSize() const {
+  return config::toCapacity(
+      config_.find(Keys::kReadPartSize)->second.value(),
+      config::CapacityUnit::BYTE);
+}
+
 } // namespace facebook::velox::filesystems
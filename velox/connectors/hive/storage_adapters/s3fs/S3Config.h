@@ -76,6 +76,10 @@ class S3Config {
     kRetryMode,
     kUseProxyFromEnv,
     kCredentialsProvider,
+    kMaxReadConcurrency,
+    kReadPartSize,
+    kUploadConcurrency,
+    kMaxInflightUploadParts,
     kEnd
   };
 
@@ -114,6 +118,13 @@ class S3Config {
              std::make_pair("use-proxy-from-env", "false")},
             {Keys::kCredentialsProvider,
              std::make_pair("aws-credentials-provider", std::nullopt)},
+            {Keys::kMaxReadConcurrency,
+             std::make_pair("max-read-concurrency", "8")},
+            {Keys::kReadPartSize, std::make_pair("read-part-size", "8MB")},
+            {Keys::kUploadConcurrency,
+             std::make_pair("upload-concurrency", "8")},
+            {Keys::kMaxInflightUploadParts,
+             std::make_pair("max-inflight-upload-parts", "2")},
         };
     return config;
   }
@@ -243,6 +254,33 @@ class S3Config {
     return config_.find(Keys::kCredentialsProvider)->second;
   }
 
+  /// Maximum number of ranged GET requests a file system issues in parallel
+  /// for the reads of all its files. 1 reads the ranges of a preadv one after
+  /// another on the calling thread.
+  int32_t maxReadConcurrency() const {
+    auto value = config_.find(Keys::kMaxReadConcurrency)->second.value();
+    return folly::to<int32_t>(value);
+  }
+
+  /// Minimum size of the parts a large read is split into for parallel
+  /// ranged GETs.
+  uint64_t readPartSize() const;
+
+  /// Number of threads a file system uploads the parts of its files with. 0
+  /// uploads the parts synchronously on the writer thread.
+  int32_t uploadConcurrency() const {
+    auto value = config_.find(Keys::kUploadConcurrency)->second.value();
+    return folly::to<int32_t>(value);
+  }
+
+  /// Maximum number of parts of a file that are uploaded in the background at
+  /// the same time. A writer that fills another part waits for the oldest
+  /// upload to finish.
+  int32_t maxInflightUploadParts() const {
+    auto value = config_.find(Keys::kMaxInflightUploadParts)->second.value();
+    return folly::to<int32_t>(value);
+  }
+
  private:
   std::unordered_map<Keys, std::optional<std::string>> config_;
   std::string payloadSigningPolicy_;
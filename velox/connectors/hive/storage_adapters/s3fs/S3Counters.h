@@ -21,6 +21,11 @@ namespace facebook::velox::filesystems {
 constexpr std::string_view kMetricS3ActiveConnections{
     "velox.s3_active_connections"};
 
+// The number of ranged S3 getObject calls of parallel reads that are queued or
+// running.
+constexpr std::string_view kMetricS3InflightReadRequests{
+    "velox.s3_inflight_read_requests"};
+
 // The number of S3 upload calls that started.
 constexpr std::string_view kMetricS3StartedUploads{"velox.s3_started_uploads"};
 
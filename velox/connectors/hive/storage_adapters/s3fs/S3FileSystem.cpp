@@ -15,9 +15,13 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Config.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Counters.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
@@ -25,7 +29,12 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -98,8 +107,20 @@ std::shared_ptr<Aws::Auth::AWSCredentialsProvider> getCredentialsProviderByName(
 
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(std::string_view path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // If 'executor' is set, reads larger than 'readPartSize' are split into
+  // parts that are fetched in parallel on 'executor'. The parts are at least
+  // 'readPartSize' bytes and as many as 'maxReadConcurrency'.
+  S3ReadFile(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      uint64_t readPartSize = 0,
+      int32_t maxReadConcurrency = 1)
+      : client_(client),
+        executor_(executor),
+        readPartSize_(readPartSize),
+        maxReadConcurrency_(maxReadConcurrency) {
+    VELOX_CHECK_GT(maxReadConcurrency_, 0);
     getBucketAndKeyFromPath(path, bucket_, key_);
   }
 
@@ -158,23 +179,39 @@ class S3ReadFile final : public ReadFile {
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. AWS S3 GetObject does not support
     // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
-    }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+    // The idea here is to use a single read spanning all the ranges of a part
+    // and then populate individual ranges. Only large reads are split into
+    // several parts, which are read in parallel.
+    auto parts = makeParts(offset, buffers);
+    if (executor_ != nullptr && parts.size() > 1) {
+      readParts(std::move(parts)).get();
+    } else {
+      for (const auto& part : parts) {
+        readPart(part);
       }
-      resultOffset += range.size();
     }
-    return length;
+    return totalLength(buffers);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      File::IoStats* stats) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers, stats);
+    }
+    try {
+      return readParts(makeParts(offset, buffers))
+          .deferValue([length = totalLength(buffers)](auto&& /*unused*/) {
+            return length;
+          });
+    } catch (const std::exception& e) {
+      return folly::makeSemiFuture<uint64_t>(e);
+    }
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
   }
 
   uint64_t size() const override {
@@ -200,6 +237,42 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  using ReadPart = file::utils::ReadPart;
+
+  static uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    return file::utils::totalLength(buffers);
+  }
+
+  // Splits the read of 'buffers' at 'offset' into at most
+  // 'maxReadConcurrency_' parts of at least 'readPartSize_' bytes, each read
+  // with one GET.
+  std::vector<ReadPart> makeParts(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    return file::utils::makeReadParts(
+        offset, buffers, readPartSize_, maxReadConcurrency_);
+  }
+
+  void readPart(const ReadPart& part) const {
+    // TODO: allocate from a memory pool
+    file::utils::readPart(
+        part, [this](uint64_t offset, uint64_t length, char* position) {
+          preadInternal(offset, length, position);
+        });
+  }
+
+  // Reads 'parts' in parallel on 'executor_'.
+  folly::SemiFuture<folly::Unit> readParts(std::vector<ReadPart> parts) const {
+    RECORD_METRIC_VALUE(kMetricS3InflightReadRequests, parts.size());
+    return file::utils::readPartsAsync(
+        std::move(parts), executor_, [this](const ReadPart& part) {
+          SCOPE_EXIT {
+            RECORD_METRIC_VALUE(kMetricS3InflightReadRequests, -1);
+          };
+          readPart(part);
+        });
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -226,6 +299,9 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* const executor_;
+  const uint64_t readPartSize_;
+  const int32_t maxReadConcurrency_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -277,10 +353,18 @@ class S3WriteFile::Impl {
   explicit Impl(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor,
+      int32_t maxInflightParts,
+      io::IoStatistics* ioStats)
+      : client_(client),
+        pool_(pool),
+        uploadExecutor_(uploadExecutor),
+        maxInflightParts_(maxInflightParts),
+        ioStats_(ioStats) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK(uploadExecutor_ == nullptr || maxInflightParts_ > 0);
     getBucketAndKeyFromPath(path, bucket_, key_);
     currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
     currentPart_->reserve(kPartUploadSize);
@@ -338,6 +422,14 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The uploads in flight reference the buffers of 'this'. They are waited
+    // for also if the file is not closed, e.g. when the write is aborted.
+    for (auto& part : inflightParts_) {
+      part.future.wait();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -350,12 +442,15 @@ class S3WriteFile::Impl {
     fileSize_ += data.size();
   }
 
-  // No-op.
+  // Waits for the parts in flight, which releases their memory. The
+  // current part is not uploaded since only the last part may be smaller
+  // than kPartUploadSize.
   void flush() {
     VELOX_CHECK(!closed(), "File is closed");
     /// currentPartSize must be less than kPartUploadSize since
     /// append() would have already flushed after reaching kUploadPartSize.
     VELOX_CHECK_LT(currentPart_->size(), kPartUploadSize);
+    waitForUploads(0);
   }
 
   // Complete the multipart upload and close the file.
@@ -364,6 +459,7 @@ class S3WriteFile::Impl {
       return;
     }
     RECORD_METRIC_VALUE(kMetricS3StartedUploads);
+    waitForUploads(0);
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
@@ -414,6 +510,12 @@ class S3WriteFile::Impl {
   };
   UploadState uploadState_;
 
+  // A part that is uploaded in the background from 'buffer'.
+  struct InflightPart {
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    folly::SemiFuture<Aws::S3::Model::CompletedPart> future;
+  };
+
   // Data can be smaller or larger than the kPartUploadSize.
   // Complete the currentPart_ and upload kPartUploadSize chunks of data.
   // Save the remaining into currentPart_.
@@ -423,11 +525,17 @@ class S3WriteFile::Impl {
     // Fill-up the remaining currentPart_.
     auto remainingBufferSize = currentPart_->capacity() - currentPart_->size();
     currentPart_->unsafeAppend(dataPtr, remainingBufferSize);
-    uploadPart({currentPart_->data(), currentPart_->size()});
+    uploadCurrentPart();
     dataPtr += remainingBufferSize;
     dataSize -= remainingBufferSize;
     while (dataSize > kPartUploadSize) {
-      uploadPart({dataPtr, kPartUploadSize});
+      if (uploadExecutor_ == nullptr) {
+        uploadPart({dataPtr, kPartUploadSize});
+      } else {
+        // A background upload can outlive 'data', so the part is copied.
+        currentPart_->unsafeAppend(dataPtr, kPartUploadSize);
+        uploadCurrentPart();
+      }
       dataPtr += kPartUploadSize;
       dataSize -= kPartUploadSize;
     }
@@ -435,16 +543,76 @@ class S3WriteFile::Impl {
     currentPart_->unsafeAppend(0, dataPtr, dataSize);
   }
 
+  // Uploads the full 'currentPart_'. If there is an upload executor, the part
+  // is uploaded in the background from its buffer and 'currentPart_' is
+  // replaced by a new buffer. Waits for the oldest part in flight if there are
+  // 'maxInflightParts_' of them, which bounds the memory of the file.
+  void uploadCurrentPart() {
+    if (uploadExecutor_ == nullptr) {
+      uploadPart({currentPart_->data(), currentPart_->size()});
+      return;
+    }
+    VELOX_CHECK_EQ(currentPart_->size(), kPartUploadSize);
+    waitForUploads(maxInflightParts_ - 1);
+    auto buffer = std::move(currentPart_);
+    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    currentPart_->reserve(kPartUploadSize);
+    const std::string_view part{buffer->data(), buffer->size()};
+    const auto partNumber = ++uploadState_.partNumber;
+    auto future =
+        folly::via(uploadExecutor_, [this, part, partNumber]() {
+          uint64_t uploadUs{0};
+          SCOPE_EXIT {
+            if (ioStats_ != nullptr) {
+              ioStats_->incBackgroundWriteTimeUs(uploadUs);
+            }
+          };
+          MicrosecondTimer timer(&uploadUs);
+          return uploadPartRequest(part, partNumber);
+        }).semi();
+    inflightParts_.push_back({std::move(buffer), std::move(future)});
+  }
+
+  // Waits until at most 'maxInflight' parts are in flight. Completes the
+  // uploads in order of part number and frees their buffers. Throws the
+  // error of a failed upload.
+  void waitForUploads(size_t maxInflight) {
+    if (inflightParts_.size() <= maxInflight) {
+      return;
+    }
+    uint64_t stallUs{0};
+    {
+      MicrosecondTimer timer(&stallUs);
+      while (inflightParts_.size() > maxInflight) {
+        auto part = std::move(inflightParts_.front());
+        inflightParts_.pop_front();
+        uploadState_.completedParts.push_back(std::move(part.future).get());
+      }
+    }
+    if (ioStats_ != nullptr) {
+      ioStats_->incWriteStallTimeUs(stallUs);
+    }
+  }
+
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
+    uploadState_.completedParts.push_back(
+        uploadPartRequest(part, ++uploadState_.partNumber));
+  }
+
+  // Uploads 'part' as part 'partNumber' and returns the completed part for
+  // the completion of the upload. Does not modify 'this', so it can run on
+  // any thread.
+  Aws::S3::Model::CompletedPart uploadPartRequest(
+      const std::string_view part,
+      int64_t partNumber) const {
     {
       Aws::S3::Model::UploadPartRequest request;
       request.SetBucket(bucket_);
       request.SetKey(key_);
       request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
+      request.SetPartNumber(partNumber);
       request.SetContentLength(part.size());
       request.SetBody(
           std::make_shared<StringViewStream>(part.data(), part.size()));
@@ -459,20 +627,25 @@ class S3WriteFile::Impl {
       auto result = outcome.GetResult();
       Aws::S3::Model::CompletedPart part;
 
-      part.SetPartNumber(uploadState_.partNumber);
+      part.SetPartNumber(partNumber);
       part.SetETag(result.GetETag());
       // Don't add the checksum to the part if the checksum is empty.
       // Some filesystems such as IBM COS require this to be not set.
       if (!result.GetChecksumCRC32().empty()) {
         part.SetChecksumCRC32(result.GetChecksumCRC32());
       }
-      uploadState_.completedParts.push_back(std::move(part));
+      return part;
     }
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  folly::Executor* const uploadExecutor_;
+  const int32_t maxInflightParts_;
+  io::IoStatistics* const ioStats_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
+  // Parts uploaded in the background in order of part number.
+  std::deque<InflightPart> inflightParts_;
   std::string bucket_;
   std::string key_;
   size_t fileSize_ = -1;
@@ -481,8 +654,12 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     std::string_view path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* uploadExecutor,
+    int32_t maxInflightParts,
+    io::IoStatistics* ioStats) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, uploadExecutor, maxInflightParts, ioStats);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -692,10 +869,40 @@ class S3FileSystem::Impl {
 
     client_ = std::make_shared<Aws::S3::S3Client>(
         credentialsProvider, nullptr /* endpointProvider */, clientConfig);
+
+    maxReadConcurrency_ = s3Config.maxReadConcurrency();
+    VELOX_USER_CHECK_GT(
+        maxReadConcurrency_,
+        0,
+        "Invalid configuration: 'hive.s3.max-read-concurrency' must be > 0");
+    readPartSize_ = s3Config.readPartSize();
+    if (maxReadConcurrency_ > 1) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          maxReadConcurrency_,
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+    }
+    const auto uploadConcurrency = s3Config.uploadConcurrency();
+    maxInflightUploadParts_ = s3Config.maxInflightUploadParts();
+    VELOX_USER_CHECK_GE(
+        uploadConcurrency,
+        0,
+        "Invalid configuration: 'hive.s3.upload-concurrency' must be >= 0");
+    if (uploadConcurrency > 0) {
+      VELOX_USER_CHECK_GT(
+          maxInflightUploadParts_,
+          0,
+          "Invalid configuration: 'hive.s3.max-inflight-upload-parts' <= 0");
+      uploadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          uploadConcurrency,
+          std::make_shared<folly::NamedThreadFactory>("S3Upload"));
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // Joins the reads and uploads in progress before the client goes away.
+    readExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -829,6 +1036,30 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // Executor for parallel ranged GETs of the files of this file system. Null
+  // if reads are not parallel.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint64_t readPartSize() const {
+    return readPartSize_;
+  }
+
+  int32_t maxReadConcurrency() const {
+    return maxReadConcurrency_;
+  }
+
+  // Executor for background part uploads of the files of this file system.
+  // Null if parts are uploaded on the writer thread.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t maxInflightUploadParts() const {
+    return maxInflightUploadParts_;
+  }
+
   std::string getLogLevelName() const {
     return getAwsInstance()->getLogLevelName();
   }
@@ -839,6 +1070,11 @@ class S3FileSystem::Impl {
 
  private:
   std::shared_ptr<Aws::S3::S3Client> client_;
+  int32_t maxReadConcurrency_;
+  uint64_t readPartSize_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  int32_t maxInflightUploadParts_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> uploadExecutor_;
 };
 
 S3FileSystem::S3FileSystem(
@@ -861,7 +1097,12 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file = std::make_unique<S3ReadFile>(path, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      path,
+      impl_->s3Client(),
+      impl_->readExecutor(),
+      impl_->readPartSize(),
+      impl_->maxReadConcurrency());
   s3file->initialize(options);
   return s3file;
 }
@@ -870,8 +1111,13 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(path, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      path,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->maxInflightUploadParts(),
+      options.writeStats);
   return s3file;
 }
 
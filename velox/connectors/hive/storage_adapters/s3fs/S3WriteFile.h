@@ -23,6 +23,14 @@ namespace Aws::S3 {
 class S3Client;
 }
 
+namespace folly {
+class Executor;
+}
+
+namespace facebook::velox::io {
+class IoStatistics;
+}
+
 namespace facebook::velox::filesystems {
 
 /// S3WriteFile uses the Apache Arrow implementation as a reference.
@@ -42,21 +50,29 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// If 'uploadExecutor' is set, full parts are uploaded on it in the background
+/// from buffers allocated from 'pool', with up to 'maxInflightParts' uploads in
+/// flight. Otherwise, UploadPart is synchronous during append. The last part
+/// is uploaded synchronously on close. The time the writer waits for uploads
+/// and the time of background uploads are added to 'ioStats' if set.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxInflightParts = 0,
+      io::IoStatistics* ioStats = nullptr);
 
   /// Appends data to the end of the file.
-  /// Uploads a part on reaching part size limit.
+  /// Uploads a part on reaching part size limit. Blocks if the maximum
+  /// number of parts is in flight.
   void append(std::string_view data) override;
 
-  /// No-op. Append handles the flush.
+  /// Waits for the parts in flight, which frees their buffers. Append handles
+  /// the upload of the data.
   void flush() override;
 
   /// Close the file. Any cleanup (disk flush, etc.) will be done here.
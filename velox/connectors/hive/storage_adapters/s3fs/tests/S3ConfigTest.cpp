@@ -37,6 +37,10 @@ TEST(S3ConfigTest, defaultConfig) {
   ASSERT_EQ(s3Config.payloadSigningPolicy(), "Never");
   ASSERT_EQ(s3Config.cacheKey("foo", config), "foo");
   ASSERT_EQ(s3Config.bucket(), "");
+  ASSERT_EQ(s3Config.maxReadConcurrency(), 8);
+  ASSERT_EQ(s3Config.readPartSize(), 8 << 20);
+  ASSERT_EQ(s3Config.uploadConcurrency(), 8);
+  ASSERT_EQ(s3Config.maxInflightUploadParts(), 2);
 }
 
 TEST(S3ConfigTest, overrideConfig) {
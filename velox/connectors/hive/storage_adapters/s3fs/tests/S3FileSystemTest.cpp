@@ -17,6 +17,7 @@
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 
+#include "velox/common/io/IoStatistics.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/RegisterS3FileSystem.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -76,6 +77,64 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelPreadv) {
+  const char* bucketName = "parallel";
+  const char* file = "test.txt";
+  const auto filename = localPath(bucketName) + "/" + file;
+  const auto s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  constexpr int32_t kSize = 4 << 20;
+  std::string data(kSize, 0);
+  for (auto i = 0; i < kSize; ++i) {
+    data[i] = 'a' + (i * 7 + i / 1'000) % 26;
+  }
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append(data);
+  }
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.max-read-concurrency", "4"},
+       {"hive.s3.read-part-size", "256kB"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  // Ranges with small and large gaps, so that the read is split into parts at
+  // and between buffers.
+  constexpr uint64_t kOffset = 100;
+  std::vector<std::string> expected;
+  std::vector<std::string> results;
+  std::vector<folly::Range<char*>> buffers;
+  uint64_t offset = kOffset;
+  for (auto i = 0; i < 8; ++i) {
+    const uint64_t size = (i % 2 == 0) ? 300'000 : 1'000;
+    const uint64_t gap = (i % 3 == 0) ? 700'000 : 10;
+    expected.push_back(data.substr(offset, size));
+    results.emplace_back(size, 0);
+    buffers.emplace_back(results.back().data(), size);
+    buffers.emplace_back(nullptr, reinterpret_cast<char*>(gap));
+    offset += size + gap;
+  }
+  ASSERT_LE(offset, kSize);
+  auto checkResults = [&]() {
+    for (auto i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(results[i], expected[i]) << i;
+      std::fill(results[i].begin(), results[i].end(), 0);
+    }
+  };
+  EXPECT_EQ(readFile->preadv(kOffset, buffers), offset - kOffset);
+  checkResults();
+  EXPECT_EQ(readFile->preadvAsync(kOffset, buffers).get(), offset - kOffset);
+  checkResults();
+
+  // Errors are returned after all parts are done.
+  const std::vector<folly::Range<char*>> pastEnd{
+      folly::Range<char*>(results[0].data(), results[0].size())};
+  VELOX_ASSERT_THROW(
+      readFile->preadvAsync(kSize + 10, pastEnd).get(),
+      "Failed to get S3 object");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     std::unordered_map<std::string, std::string> config(
@@ -292,6 +351,54 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, backgroundUpload) {
+  const auto bucketName = "backgroundupload";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+  constexpr int64_t kPartSize = 10 << 20;
+  for (const auto uploadConcurrency : {"0", "4"}) {
+    SCOPED_TRACE(fmt::format("uploadConcurrency {}", uploadConcurrency));
+    const auto s3FileName = fmt::format("{}.{}", s3File, uploadConcurrency);
+    auto hiveConfig = minioServer_->hiveConfig(
+        {{"hive.s3.upload-concurrency", uploadConcurrency},
+         {"hive.s3.max-inflight-upload-parts", "2"}});
+    filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+    auto pool = memory::memoryManager()->addLeafPool("backgroundUpload");
+    io::IoStatistics ioStats;
+    FileOptions options{{}, pool.get(), std::nullopt};
+    options.writeStats = &ioStats;
+    auto writeFile = s3fs.openFileForWrite(s3FileName, options);
+    auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+    std::string data(1 << 20, 0);
+    for (auto i = 0; i < 45; ++i) {
+      std::fill(data.begin(), data.end(), 'a' + i % 26);
+      writeFile->append(data);
+      // The buffers of the parts in flight and the current part are bounded.
+      ASSERT_LE(pool->usedBytes(), 4 * kPartSize);
+    }
+    EXPECT_EQ(s3WriteFile->numPartsUploaded(), 4);
+    writeFile->flush();
+    if (std::string(uploadConcurrency) != "0") {
+      // Only the current part is left after the uploads in flight finish.
+      EXPECT_LE(pool->usedBytes(), 2 * kPartSize);
+      EXPECT_GT(ioStats.backgroundWriteTimeUs(), 0);
+    } else {
+      EXPECT_EQ(ioStats.backgroundWriteTimeUs(), 0);
+      EXPECT_EQ(ioStats.writeStallTimeUs(), 0);
+    }
+    writeFile->close();
+    EXPECT_EQ(s3WriteFile->numPartsUploaded(), 5);
+
+    auto readFile = s3fs.openFileForRead(s3FileName);
+    ASSERT_EQ(readFile->size(), 45 << 20);
+    for (auto i = 0; i < 45; ++i) {
+      ASSERT_EQ(
+          readFile->pread((i << 20) + 100, 1), std::string(1, 'a' + i % 26));
+    }
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
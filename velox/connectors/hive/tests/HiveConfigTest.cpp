@@ -41,8 +41,12 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(emptySession.get()), 128 << 20);
   ASSERT_EQ(
       hiveConfig.maxCoalescedDistanceBytes(emptySession.get()), 512 << 10);
+  ASSERT_FALSE(hiveConfig.adaptiveCoalescing(emptySession.get()));
+  ASSERT_EQ(hiveConfig.decompressedCacheMinUses(emptySession.get()), 0);
+  ASSERT_EQ(hiveConfig.decompressedCacheMaxStreamBytes(), 4 << 20);
   ASSERT_FALSE(
       hiveConfig.readStatsBasedFilterReorderDisabled(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.readRunLengthEncoded(emptySession.get()));
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_TRUE(hiveConfig.isFileHandleCacheEnabled());
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 1024);
@@ -116,11 +120,14 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kSortWriterMaxOutputRowsSession, "20"},
       {HiveConfig::kSortWriterMaxOutputBytesSession, "20MB"},
       {HiveConfig::kMaxCoalescedDistanceSession, "3MB"},
+      {HiveConfig::kAdaptiveCoalescingSession, "true"},
+      {HiveConfig::kDecompressedCacheMinUsesSession, "3"},
       {HiveConfig::kSortWriterFinishTimeSliceLimitMsSession, "300"},
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
       {HiveConfig::kAllowNullPartitionKeysSession, "false"},
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kReadStatsBasedFilterReorderDisabledSession, "true"},
+      {HiveConfig::kReadRunLengthEncodedSession, "true"},
       {HiveConfig::kLoadQuantumSession, std::to_string(4 << 20)}};
   const auto session =
       std::make_unique<config::ConfigBase>(std::move(sessionOverride));
@@ -137,6 +144,8 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(session.get()), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(session.get()), 3 << 20);
+  ASSERT_TRUE(hiveConfig.adaptiveCoalescing(session.get()));
+  ASSERT_EQ(hiveConfig.decompressedCacheMinUses(session.get()), 3);
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_TRUE(hiveConfig.isFileHandleCacheEnabled());
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(session.get()), 20);
@@ -146,5 +155,6 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_FALSE(hiveConfig.allowNullPartitionKeys(session.get()));
   ASSERT_TRUE(hiveConfig.ignoreMissingFiles(session.get()));
   ASSERT_TRUE(hiveConfig.readStatsBasedFilterReorderDisabled(session.get()));
+  ASSERT_TRUE(hiveConfig.readRunLengthEncoded(session.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(session.get()), 4 << 20);
 }
@@ -144,6 +144,31 @@ TEST_F(HiveConnectorSerDeTest, hiveTableHandle) {
   testSerde(*tableHandle);
 }
 
+TEST_F(HiveConnectorSerDeTest, hiveTableHandleStatsAggregates) {
+  using Kind = HiveTableHandle::StatsAggregate::Kind;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto tableHandle = std::make_shared<HiveTableHandle>(
+      "test-hive",
+      "hive_table",
+      true,
+      common::SubfieldFilters{},
+      nullptr,
+      rowType,
+      std::unordered_map<std::string, std::string>{},
+      std::vector<HiveTableHandle::Projection>{},
+      std::vector<HiveTableHandle::StatsAggregate>{
+          {"a0", Kind::kCount, ""},
+          {"a1", Kind::kNullCount, "c0"},
+          {"a2", Kind::kMin, "c0"},
+          {"a3", Kind::kMax, "c1"}});
+  const auto clone =
+      ISerializable::deserialize<HiveTableHandle>(tableHandle->serialize());
+  ASSERT_EQ(clone->toString(), tableHandle->toString());
+  ASSERT_EQ(clone->statsAggregates().size(), 4);
+  ASSERT_EQ(clone->statsAggregates()[1].kind, Kind::kNullCount);
+  ASSERT_EQ(clone->statsAggregates()[3].column, "c1");
+}
+
 TEST_F(HiveConnectorSerDeTest, hiveColumnHandle) {
   auto columnType = ROW({
       {"c0c0", BIGINT()},
@@ -38,7 +38,8 @@ class HiveConnectorUtilTest : public exec::test::HiveConnectorTestBase {
       const SerDeOptions& r) {
     return l.isEscaped == r.isEscaped && l.escapeChar == r.escapeChar &&
         l.lastColumnTakesRest == r.lastColumnTakesRest &&
-        l.nullString == r.nullString && l.separators == r.separators;
+        l.nullString == r.nullString && l.separators == r.separators &&
+        l.isQuoted == r.isQuoted && l.quoteChar == r.quoteChar;
   }
 
   std::shared_ptr<memory::MemoryPool> pool_ =
@@ -209,6 +210,14 @@ TEST_F(HiveConnectorUtilTest, configureReaderOptions) {
   performConfigure();
   EXPECT_TRUE(compareSerDeOptions(readerOptions.serDeOptions(), expectedSerDe));
 
+  // CSV quote char.
+  clearDynamicParameters(FileFormat::TEXT);
+  serdeParameters[SerDeOptions::kQuoteChar] = "'";
+  expectedSerDe.quoteChar = '\'';
+  expectedSerDe.isQuoted = true;
+  performConfigure();
+  EXPECT_TRUE(compareSerDeOptions(readerOptions.serDeOptions(), expectedSerDe));
+
   // Modify all previous together.
   clearDynamicParameters(FileFormat::TEXT);
   serdeParameters[SerDeOptions::kFieldDelim] = '~';
@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1272,6 +1273,69 @@ TEST_F(HiveDataSinkTest, ensureFilesWithData) {
   verifyWrittenData(outputDirectory->getPath());
 }
 
+TEST_F(HiveDataSinkTest, writerPooling) {
+  const auto rowType = ROW({"c0", "c1"}, {INTEGER(), BIGINT()});
+  const int32_t numPartitions = 4;
+  const int32_t numBatches = 3 * numPartitions;
+  // Each batch goes to a single partition, in round robin.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < numBatches; ++i) {
+    vectors.push_back(makeRowVector({
+        makeConstant<int32_t>(i % numPartitions, 100),
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+    }));
+  }
+
+  for (const uint32_t maxOpenFileWriters : {0, 2, numPartitions}) {
+    SCOPED_TRACE(fmt::format("maxOpenFileWriters: {}", maxOpenFileWriters));
+    connectorSessionProperties_->set(
+        HiveConfig::kMaxOpenFileWritersSession,
+        std::to_string(maxOpenFileWriters));
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"c0"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_TRUE(dataSink->finish());
+    const auto partitionUpdates = dataSink->close();
+    ASSERT_EQ(partitionUpdates.size(), numPartitions);
+
+    // The partitions revisited after 'maxOpenFileWriters' other partitions
+    // continue in a new file.
+    const int32_t numFilesPerPartition =
+        maxOpenFileWriters == 2 ? numBatches / numPartitions : 1;
+    const auto stats = dataSink->stats();
+    ASSERT_EQ(stats.numWrittenFiles, numPartitions * numFilesPerPartition);
+    const auto filePaths = listFiles(outputDirectory->getPath());
+    ASSERT_EQ(filePaths.size(), stats.numWrittenFiles);
+    for (const auto& partitionUpdate : partitionUpdates) {
+      const auto update = folly::parseJson(partitionUpdate);
+      const auto& fileWriteInfos = update["fileWriteInfos"];
+      ASSERT_EQ(fileWriteInfos.size(), numFilesPerPartition);
+      for (const auto& fileWriteInfo : fileWriteInfos) {
+        const auto filePath = fs::path(update["writePath"].asString()) /
+            fileWriteInfo["writeFileName"].asString();
+        const int64_t fileSize = fs::file_size(filePath);
+        ASSERT_EQ(fileWriteInfo["fileSize"].asInt(), fileSize);
+      }
+    }
+
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(makeHiveConnectorSplit(filePath));
+    }
+    createDuckDbTable(vectors);
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(ROW({"c1"}, {BIGINT()})).planNode(),
+        splits,
+        "SELECT c1 FROM tmp");
+  }
+}
+
 TEST_F(HiveDataSinkTest, ensureFilesUnsupported) {
   VELOX_ASSERT_THROW(
       makeHiveInsertTableHandle(
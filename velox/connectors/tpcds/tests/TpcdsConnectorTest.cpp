@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include <folly/init/Init.h>
+#include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::connector::tpcds;
+
+using facebook::velox::exec::test::PlanBuilder;
+using facebook::velox::exec::test::TpcdsQueryBuilder;
+using facebook::velox::tpcds::Table;
+
+class TpcdsConnectorTest : public exec::test::OperatorTestBase {
+ public:
+  const std::string kTpcdsConnectorId = "test-tpcds";
+
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    window::prestosql::registerAllWindowFunctions();
+  }
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    connector::registerConnectorFactory(
+        std::make_shared<connector::tpcds::TpcdsConnectorFactory>());
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId,
+                std::make_shared<config::ConfigBase>(
+                    std::unordered_map<std::string, std::string>()));
+    connector::registerConnector(tpcdsConnector);
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpcdsConnectorId);
+    connector::unregisterConnectorFactory(
+        connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName);
+    OperatorTestBase::TearDown();
+  }
+
+  exec::Split makeTpcdsSplit(size_t totalParts = 1, size_t partNumber = 0)
+      const {
+    return exec::Split(std::make_shared<TpcdsConnectorSplit>(
+        kTpcdsConnectorId, /*cacheable=*/true, totalParts, partNumber));
+  }
+
+  RowVectorPtr getResults(
+      const core::PlanNodePtr& planNode,
+      std::vector<exec::Split>&& splits) {
+    return exec::test::AssertQueryBuilder(planNode)
+        .splits(std::move(splits))
+        .copyResults(pool());
+  }
+
+  // Runs TPC-DS query 'queryId' with 'numSplits' splits per scan.
+  RowVectorPtr runQuery(int queryId, int numDrivers, size_t numSplits) {
+    TpcdsQueryBuilder builder(0.01, kTpcdsConnectorId);
+    auto tpcdsPlan = builder.getQueryPlan(queryId);
+    exec::test::AssertQueryBuilder queryBuilder(tpcdsPlan.plan);
+    queryBuilder.maxDrivers(numDrivers);
+    for (const auto& scanNodeId : tpcdsPlan.scanNodeIds) {
+      std::vector<exec::Split> splits;
+      for (size_t i = 0; i < numSplits; ++i) {
+        splits.emplace_back(makeTpcdsSplit(numSplits, i));
+      }
+      queryBuilder.splits(scanNodeId, std::move(splits));
+    }
+    return queryBuilder.copyResults(pool());
+  }
+};
+
+// Simple scan of the first rows of "store".
+TEST_F(TpcdsConnectorTest, simple) {
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_STORE, {"s_store_sk", "s_store_id", "s_state"})
+                  .limit(0, 3, false)
+                  .planNode();
+
+  auto output = getResults(plan, {makeTpcdsSplit()});
+  ASSERT_EQ(3, output->size());
+  EXPECT_EQ(
+      *ROW({"s_store_sk", "s_store_id", "s_state"},
+           {BIGINT(), VARCHAR(), VARCHAR()}),
+      *output->type());
+  auto expectedKeys = makeFlatVector<int64_t>({1, 2, 3});
+  test::assertEqualVectors(expectedKeys, output->childAt(0));
+  EXPECT_EQ(
+      "AAAAAAAABAAAAAAA"_sv,
+      output->childAt(1)->asFlatVector<StringView>()->valueAt(0));
+}
+
+TEST_F(TpcdsConnectorTest, unknownColumn) {
+  EXPECT_THROW(
+      {
+        PlanBuilder()
+            .tpcdsTableScan(Table::TBL_STORE, {"does_not_exist"})
+            .planNode();
+      },
+      VeloxUserError);
+}
+
+// Read data from multiple splits.
+TEST_F(TpcdsConnectorTest, multipleSplits) {
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_STORE_SALES,
+                      {"ss_sold_date_sk", "ss_item_sk", "ss_ticket_number"},
+                      0.001)
+                  .planNode();
+
+  auto fullResult = getResults(plan, {makeTpcdsSplit()});
+  EXPECT_EQ(
+      tpcds::getRowCount(Table::TBL_STORE_SALES, 0.001), fullResult->size());
+
+  for (size_t totalParts : {2, 3, 7, 16}) {
+    std::vector<exec::Split> splits;
+    splits.reserve(totalParts);
+    for (size_t i = 0; i < totalParts; ++i) {
+      splits.emplace_back(makeTpcdsSplit(totalParts, i));
+    }
+
+    auto output = getResults(plan, std::move(splits));
+    test::assertEqualVectors(fullResult, output);
+  }
+}
+
+// Every query produces a result, which does not depend on the number of
+// drivers and splits.
+TEST_F(TpcdsConnectorTest, queries) {
+  for (auto queryId : TpcdsQueryBuilder::getQueryIds()) {
+    SCOPED_TRACE(fmt::format("Q{}", queryId));
+    auto expected = runQuery(queryId, 1, 1);
+    EXPECT_GT(expected->size(), 0);
+
+    auto output = runQuery(queryId, 4, 4);
+    EXPECT_EQ(expected->size(), output->size());
+  }
+  VELOX_ASSERT_THROW(
+      TpcdsQueryBuilder(1).getQueryPlan(1),
+      "TPC-DS query 1 is not supported yet");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::Init init{&argc, &argv, false};
+  return RUN_ALL_TESTS();
+}
@@ -23,11 +23,13 @@ using facebook::velox::tpch::Table;
 
 namespace {
 
+// Fills only 'columns' of the large tables.
 RowVectorPtr getTpchData(
     Table table,
     size_t maxRows,
     size_t offset,
     double scaleFactor,
+    const std::vector<column_index_t>& columns,
     memory::MemoryPool* pool) {
   switch (table) {
     case Table::TBL_PART:
@@ -39,9 +41,11 @@ RowVectorPtr getTpchData(
     case Table::TBL_CUSTOMER:
       return velox::tpch::genTpchCustomer(pool, maxRows, offset, scaleFactor);
     case Table::TBL_ORDERS:
-      return velox::tpch::genTpchOrders(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchOrders(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_LINEITEM:
-      return velox::tpch::genTpchLineItem(pool, maxRows, offset, scaleFactor);
+      return velox::tpch::genTpchLineItem(
+          pool, maxRows, offset, scaleFactor, columns);
     case Table::TBL_NATION:
       return velox::tpch::genTpchNation(pool, maxRows, offset, scaleFactor);
     case Table::TBL_REGION:
@@ -159,8 +163,13 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   }
 
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = getTpchData(
+      tpchTable_,
+      maxRows,
+      splitOffset_,
+      scaleFactor_,
+      outputColumnMappings_,
+      pool_);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
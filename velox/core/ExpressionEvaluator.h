@@ -49,6 +49,29 @@ class ExpressionEvaluator {
       const RowVector& input,
       VectorPtr& result) = 0;
 
+  // Compiles several expressions into one instance of exec::ExprSet. Their
+  // common subexpressions are evaluated once for the same input, also when
+  // the expressions are evaluated by separate calls to evaluate.
+  virtual std::unique_ptr<exec::ExprSet> compile(
+      const std::vector<std::shared_ptr<const ITypedExpr>>& /*expressions*/) {
+    VELOX_UNSUPPORTED("Compiling multiple expressions is not supported");
+  }
+
+  // Evaluates the expressions [begin, end) of a previously compiled
+  // exec::ExprSet on the specified rows. 'results' has one entry per
+  // expression. Re-uses the result vectors that are not null. If 'begin' is
+  // not 0, the common subexpressions computed by the last evaluation of the
+  // preceding expressions on the same input are not computed again.
+  virtual void evaluate(
+      exec::ExprSet* /*exprSet*/,
+      int32_t /*begin*/,
+      int32_t /*end*/,
+      const SelectivityVector& /*rows*/,
+      const RowVector& /*input*/,
+      std::vector<VectorPtr>& /*results*/) {
+    VELOX_UNSUPPORTED("Evaluating multiple expressions is not supported");
+  }
+
   // Memory pool used to construct input or output vectors.
   virtual memory::MemoryPool* pool() = 0;
 };
@@ -2041,13 +2041,15 @@ MarkDistinctNode::MarkDistinctNode(
     PlanNodeId id,
     std::string markerName,
     std::vector<FieldAccessTypedExprPtr> distinctKeys,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    bool preGrouped)
     : PlanNode(std::move(id)),
       markerName_(std::move(markerName)),
       distinctKeys_(std::move(distinctKeys)),
       sources_{std::move(source)},
       outputType_(
-          getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)) {
+          getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)),
+      preGrouped_(preGrouped) {
   VELOX_USER_CHECK_GT(markerName_.size(), 0);
   VELOX_USER_CHECK_GT(distinctKeys_.size(), 0);
 }
@@ -2056,6 +2058,7 @@ folly::dynamic MarkDistinctNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["distinctKeys"] = ISerializable::serialize(this->distinctKeys_);
   obj["markerName"] = this->markerName_;
+  obj["preGrouped"] = preGrouped_;
   return obj;
 }
 
@@ -2070,9 +2073,15 @@ PlanNodePtr MarkDistinctNode::create(const folly::dynamic& obj, void* context) {
   auto source = deserializeSingleSource(obj, context);
   auto distinctKeys = deserializeFields(obj["distinctKeys"], context);
   auto markerName = obj["markerName"].asString();
+  const bool preGrouped =
+      obj.count("preGrouped") && obj["preGrouped"].asBool();
 
   return std::make_shared<MarkDistinctNode>(
-      deserializePlanNodeId(obj), markerName, distinctKeys, source);
+      deserializePlanNodeId(obj),
+      markerName,
+      distinctKeys,
+      source,
+      preGrouped);
 }
 
 namespace {
@@ -2104,16 +2113,22 @@ RowNumberNode::RowNumberNode(
     std::vector<FieldAccessTypedExprPtr> partitionKeys,
     const std::optional<std::string>& rowNumberColumnName,
     std::optional<int32_t> limit,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    bool preGrouped)
     : PlanNode(std::move(id)),
       partitionKeys_{std::move(partitionKeys)},
       limit_{limit},
       sources_{std::move(source)},
       outputType_(getOptionalRowNumberOutputType(
           sources_[0]->outputType(),
-          rowNumberColumnName)) {}
+          rowNumberColumnName)),
+      preGrouped_(preGrouped) {}
 
 void RowNumberNode::addDetails(std::stringstream& stream) const {
+  if (preGrouped_) {
+    stream << "STREAMING ";
+  }
+
   if (!partitionKeys_.empty()) {
     stream << "partition by (";
     addFields(stream, partitionKeys_);
@@ -2137,6 +2152,7 @@ folly::dynamic RowNumberNode::serialize() const {
   if (limit_) {
     obj["limit"] = limit_.value();
   }
+  obj["preGrouped"] = preGrouped_;
 
   return obj;
 }
@@ -2162,12 +2178,16 @@ PlanNodePtr RowNumberNode::create(const folly::dynamic& obj, void* context) {
     rowNumberColumnName = obj["rowNumberColumnName"].asString();
   }
 
+  const bool preGrouped =
+      obj.count("preGrouped") && obj["preGrouped"].asBool();
+
   return std::make_shared<RowNumberNode>(
       deserializePlanNodeId(obj),
       partitionKeys,
       rowNumberColumnName,
       limit,
-      source);
+      source,
+      preGrouped);
 }
 
 TopNRowNumberNode::TopNRowNumberNode(
@@ -2519,7 +2539,8 @@ PartitionedOutputNode::PartitionedOutputNode(
     PartitionFunctionSpecPtr partitionFunctionSpec,
     RowTypePtr outputType,
     VectorSerde::Kind serdeKind,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    bool rebalanceSkewedPartitions)
     : PlanNode(id),
       kind_(kind),
       sources_{{std::move(source)}},
@@ -2528,8 +2549,18 @@ PartitionedOutputNode::PartitionedOutputNode(
       replicateNullsAndAny_(replicateNullsAndAny),
       partitionFunctionSpec_(std::move(partitionFunctionSpec)),
       serdeKind_(serdeKind),
-      outputType_(std::move(outputType)) {
+      outputType_(std::move(outputType)),
+      rebalanceSkewedPartitions_(rebalanceSkewedPartitions) {
   VELOX_USER_CHECK_GT(numPartitions_, 0);
+  if (rebalanceSkewedPartitions_) {
+    VELOX_USER_CHECK(
+        isPartitioned(),
+        "Only partitioned output can rebalance skewed partitions");
+    VELOX_USER_CHECK(
+        !replicateNullsAndAny_,
+        "Partitioned output that replicates nulls and any cannot rebalance "
+        "skewed partitions");
+  }
   if (numPartitions_ == 1) {
     VELOX_USER_CHECK(
         keys_.empty(),
@@ -2675,6 +2706,10 @@ void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
     stream << " replicate nulls and any";
   }
 
+  if (rebalanceSkewedPartitions_) {
+    stream << " rebalance skewed partitions";
+  }
+
   stream << " ";
   addVectorSerdeKind(serdeKind_, stream);
 }
@@ -2688,6 +2723,9 @@ folly::dynamic PartitionedOutputNode::serialize() const {
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
   obj["serdeKind"] = VectorSerde::kindName(serdeKind_);
   obj["outputType"] = outputType_->serialize();
+  if (rebalanceSkewedPartitions_) {
+    obj["rebalanceSkewedPartitions"] = true;
+  }
   return obj;
 }
 
@@ -2711,7 +2749,9 @@ PlanNodePtr PartitionedOutputNode::create(
           obj["partitionFunctionSpec"], context),
       deserializeRowType(obj["outputType"]),
       VectorSerde::kindByName(obj["serdeKind"].asString()),
-      deserializeSingleSource(obj, context));
+      deserializeSingleSource(obj, context),
+      obj.count("rebalanceSkewedPartitions") != 0 &&
+          obj["rebalanceSkewedPartitions"].asBool());
 }
 
 TopNNode::TopNNode(
@@ -2855,6 +2895,9 @@ PlanNodePtr OrderByNode::create(const folly::dynamic& obj, void* context) {
 }
 
 void MarkDistinctNode::addDetails(std::stringstream& stream) const {
+  if (preGrouped_) {
+    stream << "STREAMING ";
+  }
   addFields(stream, distinctKeys_);
 }
 
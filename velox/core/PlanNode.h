@@ -1419,6 +1419,9 @@ class PartitionedOutputNode : public PlanNode {
   static std::string kindString(Kind kind);
   static Kind stringToKind(const std::string& str);
 
+  /// If 'rebalanceSkewedPartitions' is true, the rows of a partition that
+  /// gets much more data than the others are spread over more destinations.
+  /// See rebalanceSkewedPartitions().
   PartitionedOutputNode(
       const PlanNodeId& id,
       Kind kind,
@@ -1428,7 +1431,8 @@ class PartitionedOutputNode : public PlanNode {
       PartitionFunctionSpecPtr partitionFunctionSpec,
       RowTypePtr outputType,
       VectorSerde::Kind serdeKind,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      bool rebalanceSkewedPartitions = false);
 
   static std::shared_ptr<PartitionedOutputNode> broadcast(
       const PlanNodeId& id,
@@ -1484,6 +1488,12 @@ class PartitionedOutputNode : public PlanNode {
     return kind_ == Kind::kArbitrary;
   }
 
+  /// Only the pages of partitioned output are owned by a single destination
+  /// and can be spilled from the output buffer.
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return isPartitioned() && queryConfig.partitionedOutputSpillEnabled();
+  }
+
   Kind kind() const {
     return kind_;
   }
@@ -1500,6 +1510,17 @@ class PartitionedOutputNode : public PlanNode {
     return replicateNullsAndAny_;
   }
 
+  /// Returns true if the rows of a partition that gets much more data than the
+  /// others are sent to more than one destination, as detected by
+  /// common::SkewedPartitionRebalancer from the processed bytes. The rows of a
+  /// key then no longer all go to the same destination, so this may only be
+  /// set when the consumers produce results that are merged again by key,
+  /// e.g. for the output of a partial aggregation that is consumed by an
+  /// intermediate aggregation.
+  bool rebalanceSkewedPartitions() const {
+    return rebalanceSkewedPartitions_;
+  }
+
   const PartitionFunctionSpecPtr& partitionFunctionSpecPtr() const {
     return partitionFunctionSpec_;
   }
@@ -1527,6 +1548,7 @@ class PartitionedOutputNode : public PlanNode {
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
   const VectorSerde::Kind serdeKind_;
   const RowTypePtr outputType_;
+  const bool rebalanceSkewedPartitions_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -2626,12 +2648,16 @@ class RowNumberNode : public PlanNode {
   /// @param limit Optional per-partition limit. If specified, the number of
   /// rows produced by this node will not exceed this value for any given
   /// partition. Extra rows will be dropped.
+  /// @param preGrouped Whether the input is grouped on 'partitionKeys', i.e.
+  /// the rows of each partition are adjacent. Partitions are then found by
+  /// comparing each row with the previous one instead of using a hash table.
   RowNumberNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
       const std::optional<std::string>& rowNumberColumnName,
       std::optional<int32_t> limit,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      bool preGrouped = false);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -2645,7 +2671,8 @@ class RowNumberNode : public PlanNode {
   }
 
   bool canSpill(const QueryConfig& queryConfig) const override {
-    return !partitionKeys_.empty() && queryConfig.rowNumberSpillEnabled();
+    return !partitionKeys_.empty() && !preGrouped_ &&
+        queryConfig.rowNumberSpillEnabled();
   }
 
   const std::vector<FieldAccessTypedExprPtr>& partitionKeys() const {
@@ -2656,6 +2683,10 @@ class RowNumberNode : public PlanNode {
     return limit_;
   }
 
+  bool preGrouped() const {
+    return preGrouped_;
+  }
+
   bool generateRowNumber() const {
     return outputType_->size() > sources_[0]->outputType()->size();
   }
@@ -2678,6 +2709,8 @@ class RowNumberNode : public PlanNode {
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
+
+  const bool preGrouped_;
 };
 
 /// The MarkDistinct operator marks unique rows based on distinctKeys.
@@ -2685,13 +2718,17 @@ class RowNumberNode : public PlanNode {
 /// @param markerName Name of the output mask channel.
 /// @param distinctKeys Names of grouping keys.
 /// column.
+/// @param preGrouped Whether the input is grouped on 'distinctKeys', i.e. rows
+/// with equal keys are adjacent. Distinct rows are then found by comparing
+/// each row with the previous one instead of using a hash table.
 class MarkDistinctNode : public PlanNode {
  public:
   MarkDistinctNode(
       PlanNodeId id,
       std::string markerName,
       std::vector<FieldAccessTypedExprPtr> distinctKeys,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      bool preGrouped = false);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -2718,6 +2755,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool preGrouped() const {
+    return preGrouped_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2732,6 +2773,8 @@ class MarkDistinctNode : public PlanNode {
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
+
+  const bool preGrouped_;
 };
 
 /// Optimized version of a WindowNode for a single row_number function with a
@@ -36,6 +36,11 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The priority class of the query in memory arbitration. The smaller the
+  /// number, the higher the priority. The memory arbitrator reclaims from and
+  /// aborts the queries of the lowest priority first.
+  static constexpr const char* kQueryPriority = "query_priority";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -64,11 +69,49 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of simple arithmetic, comparison and logical
+  /// functions over fixed-width columns in a single pass over each batch
+  /// instead of one pass per function. False by default.
+  static constexpr const char* kExprFusionEnabled =
+      "expression.fusion_enabled";
+
+  /// Whether to cache the functions that calls of scalar functions resolve to
+  /// across queries, keyed by the function name and the argument types, so
+  /// that queries of the same shape do not bind the calls to the function
+  /// signatures again. False by default.
+  static constexpr const char* kExprFunctionResolutionCacheEnabled =
+      "expression.function_resolution_cache_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to record the stack samples of the process::StackSampler taken
+  /// in the operators of the query. The samples are aggregated per plan node
+  /// and reported as folded stacks in TaskStats. False by default. Has no
+  /// effect unless the sampler has been started by the process.
+  static constexpr const char* kOperatorStackSamplingEnabled =
+      "operator_stack_sampling_enabled";
+
+  /// Whether to collect the hardware performance counters (cycles,
+  /// instructions, LLC, dTLB and branch misses) of the addInput and getOutput
+  /// calls of the operators into OperatorStats::perfCounters. False by
+  /// default. Has no effect if the counters are not available to the process.
+  static constexpr const char* kOperatorPerfCountersEnabled =
+      "operator_perf_counters_enabled";
+
+  /// If kOperatorPerfCountersEnabled, each driver measures one out of this
+  /// many addInput and getOutput calls to keep the overhead of reading the
+  /// counters low.
+  static constexpr const char* kOperatorPerfCountersSamplingInterval =
+      "operator_perf_counters_sampling_interval";
+
+  /// The number of the last Driver on thread, queued and blocked intervals
+  /// each task keeps for the timeline returned by Task::timelineTrace(). 0
+  /// disables the timeline.
+  static constexpr const char* kTaskTimelineCapacity = "task_timeline_capacity";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -103,6 +146,13 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangePartitionCount =
       "max_local_exchange_partition_count";
 
+  /// If true, a local partition copies the rows of each partition into a
+  /// per-partition batch across several input vectors and enqueues the batch
+  /// once it reaches the preferred output batch size, instead of enqueueing a
+  /// dictionary over every input vector for every partition.
+  static constexpr const char* kLocalExchangePartitionBatchingEnabled =
+      "local_exchange_partition_batching_enabled";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -134,12 +184,26 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, partial aggregation estimates the number of distinct grouping
+  /// keys of its input with a HyperLogLog sketch over windows of
+  /// 'abandon_partial_aggregation_min_rows' rows. It stops aggregating as soon
+  /// as a window is estimated to have no reduction, and resumes when a later
+  /// window of the input is estimated to aggregate well again.
+  static constexpr const char* kPartialAggregationCardinalityEstimation =
+      "partial_aggregation_cardinality_estimation_enabled";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
   static constexpr const char* kAbandonPartialTopNRowNumberMinPct =
       "abandon_partial_topn_row_number_min_pct";
 
+  /// If true, the TopN drivers of a pipeline share the cutoff on their first
+  /// sorting key and push it down as a dynamic filter into the table scan
+  /// feeding them.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
   /// The maximum number of bytes to buffer in PartitionedOutput operator to
   /// avoid creating tiny SerializedPages.
   ///
@@ -149,6 +213,24 @@ class QueryConfig {
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If true, the pages produced by PartitionedOutput operator reference the
+  /// memory the rows were serialized into instead of a copy of it. The memory
+  /// is released when the pages are freed. Only applies to the Presto serde.
+  static constexpr const char* kPartitionedOutputZeroCopyFlush =
+      "partitioned_output_zero_copy_flush";
+
+  /// Minimum amount of data processed by a partition of a PartitionedOutput
+  /// that rebalances skewed partitions before the partition can be spread
+  /// over more destinations.
+  static constexpr const char* kPartitionedOutputMinPartitionRebalanceBytes =
+      "partitioned_output_min_partition_rebalance_bytes";
+
+  /// Minimum amount of data processed by all the partitions of a
+  /// PartitionedOutput that rebalances skewed partitions before the partitions
+  /// are rebalanced.
+  static constexpr const char* kPartitionedOutputMinRebalanceBytes =
+      "partitioned_output_min_rebalance_bytes";
+
   /// The maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -175,6 +257,15 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If not zero, the number of rows returned by operators from
+  /// Operator::getOutput when no estimate of average row size is known is
+  /// adapted so that the output of all the operators of a pipeline for one
+  /// batch takes about this many bytes, e.g. the size of the L2 cache. The
+  /// bytes per row of each operator are observed while the pipeline runs. The
+  /// number of rows is capped at kMaxOutputBatchRows.
+  static constexpr const char* kAdaptiveOutputBatchCacheBytes =
+      "adaptive_output_batch_cache_bytes";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -186,6 +277,14 @@ class QueryConfig {
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
+  /// The max number of groups of a 'group by' whose raw input is accumulated
+  /// in dense per-aggregate arrays before being added to the group rows. Only
+  /// used while the hash table is in array mode, for the aggregates that
+  /// support dense accumulators, e.g. sum, count, min and max of numeric
+  /// types. 0 disables dense accumulators.
+  static constexpr const char* kDenseAggregationMaxGroups =
+      "dense_aggregation_max_groups";
+
   /// If true, the conjunction expression can reorder inputs based on the time
   /// taken to calculate them.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
@@ -207,6 +306,19 @@ class QueryConfig {
   /// Window spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
 
+  /// The max number of output batches of a single large window partition that
+  /// a Window operator computes concurrently on the query executor. Only used
+  /// when the operator sorts its input and all window functions are
+  /// aggregates. 1 disables parallel processing.
+  static constexpr const char* kWindowParallelism = "window_parallelism";
+
+  /// If true, a FilterProject that has both identity projections and computed
+  /// projections loads the lazy identity projected columns that no expression
+  /// reads on the query executor while it computes the projections. The
+  /// columns are loaded for the rows that pass the filter. False by default.
+  static constexpr const char* kFilterProjectPrefetchLazyColumns =
+      "filter_project_prefetch_lazy_columns";
+
   /// If true, the memory arbitrator will reclaim memory from table writer by
   /// flushing its buffered data to disk. only applies if "spill_enabled" flag
   /// is set.
@@ -220,6 +332,13 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// If true, the memory arbitrator can reclaim memory from a partitioned
+  /// output buffer by spilling the pages not yet fetched by the consumers. The
+  /// pages are read back when fetched. Only applies if "spill_enabled" flag is
+  /// set.
+  static constexpr const char* kPartitionedOutputSpillEnabled =
+      "partitioned_output_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -242,12 +361,40 @@ class QueryConfig {
   /// io and cpu resources.
   static constexpr const char* kMaxSpillLevel = "max_spill_level";
 
+  /// The max total spilled size of the hash join partitions at the same spill
+  /// level that are restored together in one round. Small partitions are
+  /// then built into one hash table and probed with all the drivers at once
+  /// instead of one by one. A merged round does not spill again. If it is
+  /// zero, then the partitions are always restored one by one.
+  static constexpr const char* kMaxMergedJoinSpillRestoreBytes =
+      "max_merged_join_spill_restore_bytes";
+
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// If true, writes spill files in the columnar spill format. Low cardinality
+  /// columns of each spilled batch are dictionary or run-length encoded, and
+  /// the compression codec of each batch is chosen between no compression,
+  /// lz4 and 'kSpillCompressionKind' from the measured compression ratio and
+  /// CPU cost against the measured disk write throughput.
+  static constexpr const char* kSpillColumnarFormatEnabled =
+      "spill_columnar_format_enabled";
+
+  /// If true, the sorted spill runs of order by and window operators are read
+  /// ahead on the spill executor while the previous batch of each run is
+  /// merged.
+  static constexpr const char* kSpillReadAheadEnabled =
+      "spill_read_ahead_enabled";
+
+  /// The max number of sorted spill runs merged at once. If an operator has
+  /// more runs, groups of this many runs are first merged in parallel on the
+  /// spill executor into fewer larger runs, repeatedly, before the final
+  /// merge. 0 means no limit.
+  static constexpr const char* kSpillMergeFanIn = "spill_merge_fan_in";
+
   /// Enable the prefix sort or fallback to timsort in spill. The prefix sort is
   /// faster than std::sort but requires the memory to build normalized prefix
   /// keys, which might have potential risk of running out of server memory.
@@ -352,11 +499,51 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The maximum number of distinct build side keys for which a hash probe
+  /// pushes a Bloom filter on an integer join key down to the probe side table
+  /// scan. Applies only when the keys have too many distinct values for a
+  /// range or IN-list filter. 0 disables Bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// If true, the tasks of a query that run on the same worker share one hash
+  /// join table instead of each building its own. Must only be set if the
+  /// build side of every hash join in the query is broadcast, i.e. all the
+  /// tasks of a join get the same build side input.
+  static constexpr const char* kHashJoinShareBroadcastBuild =
+      "hash_join_share_broadcast_build";
+
+  /// If true, a filter right after an inner hash join is evaluated by the
+  /// probe together with the join filter, on the candidate matches before the
+  /// output of the join is built.
+  static constexpr const char* kHashProbeFilterFusionEnabled =
+      "hash_probe_filter_fusion_enabled";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// If true, the probe input of a hash join is partitioned by the bits of
+  /// hash that select the part of the hash table to probe, so that each
+  /// partition probes a part of about 'hash_probe_partition_bytes'. Applies
+  /// only to tables of several times that size.
+  static constexpr const char* kHashProbePartitioningEnabled =
+      "hash_probe_partitioning_enabled";
+
+  /// The size of the part of the hash table probed by one partition of the
+  /// probe input. Should be about the size of the per core cache.
+  static constexpr const char* kHashProbePartitionBytes =
+      "hash_probe_partition_bytes";
+
+  /// Hash join tables with at least this many keys, all of fixed width
+  /// integer, boolean or timestamp types, keep the key columns of the probe
+  /// input as rows laid out like the keys of the table. The rows are hashed
+  /// in one pass over their bytes and compared to the table rows with memcmp
+  /// instead of column by column. 0 disables.
+  static constexpr const char* kHashJoinKeyRowsMinKeys =
+      "hash_join_key_rows_min_keys";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -367,9 +554,9 @@ class QueryConfig {
 
   /// If true, enable caches in expression evaluation for performance, including
   /// ExecCtx::vectorPool_, ExecCtx::decodedVectorPool_,
-  /// ExecCtx::selectivityVectorPool_, Expr::baseDictionary_,
-  /// Expr::dictionaryCache_, and Expr::cachedDictionaryIndices_. Otherwise,
-  /// disable the caches.
+  /// ExecCtx::selectivityVectorPool_, ExecCtx::bufferArena_,
+  /// Expr::baseDictionary_, Expr::dictionaryCache_, and
+  /// Expr::cachedDictionaryIndices_. Otherwise, disable the caches.
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
 
@@ -384,12 +571,31 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// If true, the number of splits a table scan preloads per driver adapts to
+  /// the observed time to open a split relative to the time to process one,
+  /// between 1 and 'max_split_preload_per_driver'. Otherwise, each driver
+  /// preloads 'max_split_preload_per_driver' splits.
+  static constexpr const char* kAdaptiveSplitPreloadEnabled =
+      "adaptive_split_preload_enabled";
+
+  /// The max estimated bytes of the splits a table scan preloads across the
+  /// drivers of a task. The bytes of a preloaded split are estimated by the
+  /// input bytes of the splits read so far. 0 means no limit.
+  static constexpr const char* kMaxSplitPreloadBytes =
+      "max_split_preload_bytes";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
-  /// limit.
+  /// limit. If set, OrderBy sorts its rows in steps and can yield in between.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// The share of the driver threads of the query relative to the other
+  /// queries on the same exec::FairShareExecutor. A query with twice the
+  /// shares of another gets twice the thread time while both have drivers to
+  /// run.
+  static constexpr const char* kQueryCpuShares = "query_cpu_shares";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -404,6 +610,12 @@ class QueryConfig {
   static constexpr const char* kPrefixSortMaxStringPrefixLength =
       "prefixsort_max_string_prefix_length";
 
+  /// Maximum number of bytes of the normalized keys to sort with radix sort
+  /// instead of quick sort in prefix-sort. Applies only if all the sort keys
+  /// are fully normalized. Use 0 to disable radix sort.
+  static constexpr const char* kPrefixSortMaxRadixSortKeyBytes =
+      "prefixsort_max_radix_sort_key_bytes";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -422,6 +634,18 @@ class QueryConfig {
   static constexpr const char* kQueryTraceTaskRegExp =
       "query_trace_task_reg_exp";
 
+  /// The compression codec of the traced operator input. 'none' makes the
+  /// capture cheaper and the replay faster at the cost of larger trace files.
+  static constexpr const char* kQueryTraceCompressionKind =
+      "query_trace_compression_codec";
+
+  /// If true, the traced operator input is serialized and written on a
+  /// background executor instead of the driver thread. A traced operator keeps
+  /// at most two batches in memory for the writer. The batches that arrive
+  /// while both are pending are dropped and counted in the trace summary.
+  static constexpr const char* kQueryTraceAsyncEnabled =
+      "query_trace_async_enabled";
+
   /// Config used to create operator trace directory. This config is provided to
   /// underlying file system and the config is free form. The form should be
   /// defined by the underlying file system.
@@ -516,6 +740,12 @@ class QueryConfig {
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// If true, the Presto serde writes the string columns of shuffled pages as
+  /// dictionaries of their distinct values per page, and the Exchange operator
+  /// returns a vector per page so that the dictionaries are kept.
+  static constexpr const char* kShuffleDictionaryEncodingEnabled =
+      "shuffle_dictionary_encoding_enabled";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -542,6 +772,42 @@ class QueryConfig {
   static constexpr const char* kStreamingAggregationEagerFlush =
       "streaming_aggregation_eager_flush";
 
+  /// Number of hash bits used to split the input of a final or single hash
+  /// aggregation with grouping keys into 2^bits partitions, each aggregated in
+  /// its own hash table. The bits start at 'kSpillStartPartitionBit' so that
+  /// each partition spills into a single spill partition. Smaller tables have
+  /// better cache and TLB locality when there are many groups and can be
+  /// spilled one at a time. 0 (the default) disables the partitioning.
+  static constexpr const char* kAggregationRadixPartitionBits =
+      "aggregation_radix_partition_bits";
+
+  /// If true, the drivers of a radix-partitioned final or single hash
+  /// aggregation merge their partitions in place after all of them have
+  /// received all input. Each driver then produces the groups of its share of
+  /// the partitions. This replaces a local exchange that partitions the input
+  /// by the grouping keys, so that a single aggregation can take the input of
+  /// its pipeline directly. Not used if the aggregation can spill.
+  static constexpr const char* kAggregationPartitionMergeEnabled =
+      "aggregation_partition_merge_enabled";
+
+  /// If true, a partial or single aggregation over a GroupIdNode aggregates
+  /// its input once by all the grouping keys and computes each grouping set
+  /// from these groups, instead of aggregating a copy of the input per
+  /// grouping set. Not used if the aggregation can spill.
+  static constexpr const char* kGroupingSetsRollupEnabled =
+      "grouping_sets_rollup_enabled";
+
+  /// The estimated number of groups from which a single hash aggregation
+  /// whose aggregates are all distinct over the same inputs, e.g.
+  /// count(DISTINCT x) and sum(DISTINCT x), runs in two phases: a hash table
+  /// on the grouping keys and the distinct inputs removes the duplicates, and
+  /// an aggregation without distinct aggregates groups the rows that are left.
+  /// This replaces a set of distinct values per group. The number of groups
+  /// is estimated by the number of distinct grouping keys in the first input.
+  /// 0 disables the two phases.
+  static constexpr const char* kTwoPhaseDistinctAggregationMinGroups =
+      "two_phase_distinct_aggregation_min_groups";
+
   bool selectiveNimbleReaderEnabled() const {
     return get<bool>(kSelectiveNimbleReaderEnabled, false);
   }
@@ -577,6 +843,10 @@ class QueryConfig {
         config::CapacityUnit::BYTE);
   }
 
+  int32_t queryPriority() const {
+    return get<int32_t>(kQueryPriority, 0);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -595,6 +865,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool partialAggregationCardinalityEstimation() const {
+    return get<bool>(kPartialAggregationCardinalityEstimation, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -603,6 +877,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinPct, 80);
   }
 
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, false);
+  }
+
   uint64_t maxSpillRunRows() const {
     static constexpr uint64_t kDefault = 12UL << 20;
     return get<uint64_t>(kMaxSpillRunRows, kDefault);
@@ -618,6 +896,19 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputZeroCopyFlush() const {
+    return get<bool>(kPartitionedOutputZeroCopyFlush, true);
+  }
+
+  uint64_t partitionedOutputMinPartitionRebalanceBytes() const {
+    return get<uint64_t>(
+        kPartitionedOutputMinPartitionRebalanceBytes, 64 << 20);
+  }
+
+  uint64_t partitionedOutputMinRebalanceBytes() const {
+    return get<uint64_t>(kPartitionedOutputMinRebalanceBytes, 128 << 20);
+  }
+
   uint64_t maxOutputBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
@@ -628,6 +919,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localExchangePartitionBatchingEnabled() const {
+    return get<bool>(kLocalExchangePartitionBatchingEnabled, false);
+  }
+
   uint32_t maxLocalExchangePartitionCount() const {
     // defaults to unlimited
     static constexpr uint32_t kDefault = std::numeric_limits<uint32_t>::max();
@@ -667,6 +962,10 @@ class QueryConfig {
     return maxBatchRows;
   }
 
+  uint64_t adaptiveOutputBatchCacheBytes() const {
+    return get<uint64_t>(kAdaptiveOutputBatchCacheBytes, 0);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -675,6 +974,10 @@ class QueryConfig {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
 
+  uint32_t denseAggregationMaxGroups() const {
+    return get<uint32_t>(kDenseAggregationMaxGroups, 0);
+  }
+
   uint32_t writeStrideSize() const {
     static constexpr uint32_t kDefault = 100'000;
     return kDefault;
@@ -737,6 +1040,17 @@ class QueryConfig {
     return get<bool>(kWindowSpillEnabled, true);
   }
 
+  uint32_t windowParallelism() const {
+    const auto parallelism = get<uint32_t>(kWindowParallelism, 1);
+    VELOX_USER_CHECK_GE(
+        parallelism, 1, "{} must be at least 1", kWindowParallelism);
+    return parallelism;
+  }
+
+  bool filterProjectPrefetchLazyColumns() const {
+    return get<bool>(kFilterProjectPrefetchLazyColumns, false);
+  }
+
   bool writerSpillEnabled() const {
     return get<bool>(kWriterSpillEnabled, true);
   }
@@ -749,10 +1063,18 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  bool partitionedOutputSpillEnabled() const {
+    return get<bool>(kPartitionedOutputSpillEnabled, false);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
 
+  uint64_t maxMergedJoinSpillRestoreBytes() const {
+    return get<uint64_t>(kMaxMergedJoinSpillRestoreBytes, 0);
+  }
+
   uint8_t spillStartPartitionBit() const {
     constexpr uint8_t kDefaultStartBit = 48;
     return get<uint8_t>(kSpillStartPartitionBit, kDefaultStartBit);
@@ -778,6 +1100,24 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  bool spillColumnarFormatEnabled() const {
+    return get<bool>(kSpillColumnarFormatEnabled, false);
+  }
+
+  bool spillReadAheadEnabled() const {
+    return get<bool>(kSpillReadAheadEnabled, false);
+  }
+
+  uint32_t spillMergeFanIn() const {
+    const auto fanIn = get<uint32_t>(kSpillMergeFanIn, 0);
+    VELOX_USER_CHECK(
+        fanIn == 0 || fanIn >= 2,
+        "{} must be 0 or at least 2: {}",
+        kSpillMergeFanIn,
+        fanIn);
+    return fanIn;
+  }
+
   bool spillPrefixSortEnabled() const {
     return get<bool>(kSpillPrefixSortEnabled, false);
   }
@@ -829,6 +1169,14 @@ class QueryConfig {
     return get<std::string>(kQueryTraceTaskRegExp, "");
   }
 
+  std::string queryTraceCompressionKind() const {
+    return get<std::string>(kQueryTraceCompressionKind, "zstd");
+  }
+
+  bool queryTraceAsyncEnabled() const {
+    return get<bool>(kQueryTraceAsyncEnabled, false);
+  }
+
   std::string opTraceDirectoryCreateConfig() const {
     return get<std::string>(kOpTraceDirectoryCreateConfig, "");
   }
@@ -880,10 +1228,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFusionEnabled() const {
+    return get<bool>(kExprFusionEnabled, false);
+  }
+
+  bool exprFunctionResolutionCacheEnabled() const {
+    return get<bool>(kExprFunctionResolutionCacheEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorStackSamplingEnabled() const {
+    return get<bool>(kOperatorStackSamplingEnabled, false);
+  }
+
+  bool operatorPerfCountersEnabled() const {
+    return get<bool>(kOperatorPerfCountersEnabled, false);
+  }
+
+  uint32_t operatorPerfCountersSamplingInterval() const {
+    return get<uint32_t>(kOperatorPerfCountersSamplingInterval, 16);
+  }
+
+  uint32_t taskTimelineCapacity() const {
+    return get<uint32_t>(kTaskTimelineCapacity, 0);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -897,10 +1269,34 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, false);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  bool hashJoinShareBroadcastBuild() const {
+    return get<bool>(kHashJoinShareBroadcastBuild, false);
+  }
+
+  bool hashProbeFilterFusionEnabled() const {
+    return get<bool>(kHashProbeFilterFusionEnabled, false);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  bool hashProbePartitioningEnabled() const {
+    return get<bool>(kHashProbePartitioningEnabled, true);
+  }
+
+  uint64_t hashProbePartitionBytes() const {
+    return get<uint64_t>(kHashProbePartitionBytes, 1 << 20);
+  }
+
+  int32_t hashJoinKeyRowsMinKeys() const {
+    return get<int32_t>(kHashJoinKeyRowsMinKeys, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -929,10 +1325,24 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  bool adaptiveSplitPreloadEnabled() const {
+    return get<bool>(kAdaptiveSplitPreloadEnabled, false);
+  }
+
+  uint64_t maxSplitPreloadBytes() const {
+    return get<uint64_t>(kMaxSplitPreloadBytes, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint32_t queryCpuShares() const {
+    const auto shares = get<uint32_t>(kQueryCpuShares, 1);
+    VELOX_USER_CHECK_GT(shares, 0, "{} must be positive", kQueryCpuShares);
+    return shares;
+  }
+
   uint32_t prefixSortNormalizedKeyMaxBytes() const {
     return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -945,6 +1355,10 @@ class QueryConfig {
     return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
   }
 
+  uint32_t prefixSortMaxRadixSortKeyBytes() const {
+    return get<uint32_t>(kPrefixSortMaxRadixSortKeyBytes, 24);
+  }
+
   double scaleWriterRebalanceMaxMemoryUsageRatio() const {
     return get<double>(kScaleWriterRebalanceMaxMemoryUsageRatio, 0.7);
   }
@@ -979,6 +1393,10 @@ class QueryConfig {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  bool shuffleDictionaryEncodingEnabled() const {
+    return get<bool>(kShuffleDictionaryEncodingEnabled, false);
+  }
+
   int32_t requestDataSizesMaxWaitSec() const {
     return get<int32_t>(kRequestDataSizesMaxWaitSec, 10);
   }
@@ -991,6 +1409,23 @@ class QueryConfig {
     return get<bool>(kStreamingAggregationEagerFlush, false);
   }
 
+  uint8_t aggregationRadixPartitionBits() const {
+    constexpr uint8_t kMaxBits = 8;
+    return std::min(kMaxBits, get<uint8_t>(kAggregationRadixPartitionBits, 0));
+  }
+
+  bool aggregationPartitionMergeEnabled() const {
+    return get<bool>(kAggregationPartitionMergeEnabled, false);
+  }
+
+  bool groupingSetsRollupEnabled() const {
+    return get<bool>(kGroupingSetsRollupEnabled, false);
+  }
+
+  uint32_t twoPhaseDistinctAggregationMinGroups() const {
+    return get<uint32_t>(kTwoPhaseDistinctAggregationMinGroups, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -17,10 +17,12 @@
 #pragma once
 
 #include <folly/Executor.h>
+#include <folly/Synchronized.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/vector/BufferArena.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
 
@@ -118,6 +120,31 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// memory arbitration finishes.
   bool checkUnderArbitration(ContinueFuture* future);
 
+  /// The counters of the drivers of the query run by a FairShareExecutor.
+  struct SchedulingStats {
+    /// The number of times a driver ran on a thread.
+    uint64_t numRuns{0};
+
+    /// The time the drivers ran on a thread.
+    uint64_t runNanos{0};
+
+    /// The time the drivers waited in the queue before running.
+    uint64_t queuedNanos{0};
+
+    /// 'runNanos' divided by the CPU shares of the query. The executor moves
+    /// it forward when the query had no driver to run, so that the query gets
+    /// no credit for the idle time.
+    uint64_t virtualRuntimeNanos{0};
+  };
+
+  folly::Synchronized<SchedulingStats>& schedulingStats() {
+    return schedulingStats_;
+  }
+
+  const folly::Synchronized<SchedulingStats>& schedulingStats() const {
+    return schedulingStats_;
+  }
+
   /// Updates the aggregated spill bytes of this query, and throws if exceeds
   /// the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
@@ -222,6 +249,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
   std::atomic<uint64_t> numTracedBytes_{0};
+  folly::Synchronized<SchedulingStats> schedulingStats_;
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
@@ -239,6 +267,10 @@ class ExecCtx {
         vectorPool_(
             optimizationParams_.exprEvalCacheEnabled
                 ? std::make_unique<VectorPool>(pool)
+                : nullptr),
+        bufferArena_(
+            optimizationParams_.exprEvalCacheEnabled
+                ? std::make_unique<BufferArena>(pool)
                 : nullptr) {}
 
   struct OptimizationParams {
@@ -386,6 +418,38 @@ class ExecCtx {
     return 0;
   }
 
+  /// Returns a nulls buffer for 'size' rows set to 'initValue'. The buffer
+  /// comes from the arena of temporary buffers which is rewound at the end of
+  /// each ExprSet::eval() if the expression evaluation caches are enabled.
+  BufferPtr allocateNulls(vector_size_t size, bool initValue = bits::kNotNull) {
+    if (bufferArena_) {
+      return bufferArena_->allocateNulls(size, initValue);
+    }
+    return velox::allocateNulls(size, pool_, initValue);
+  }
+
+  /// Returns an indices buffer for 'size' rows set to zero from the arena of
+  /// temporary buffers.
+  BufferPtr allocateIndices(vector_size_t size) {
+    if (bufferArena_) {
+      return bufferArena_->allocateIndices(size);
+    }
+    return velox::allocateIndices(size, pool_);
+  }
+
+  /// Rewinds the arena of temporary buffers for the next batch. The buffers
+  /// that are still referenced, e.g. by the results, are left to their
+  /// holders.
+  void resetBufferArena() {
+    if (bufferArena_) {
+      bufferArena_->reset();
+    }
+  }
+
+  BufferArena* bufferArena() {
+    return bufferArena_.get();
+  }
+
   const OptimizationParams& optimizationParams() const {
     return optimizationParams_;
   }
@@ -403,6 +467,8 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  // An arena of temporary nulls and indices buffers for use by expressions.
+  std::unique_ptr<BufferArena> bufferArena_;
 };
 
 } // namespace facebook::velox::core
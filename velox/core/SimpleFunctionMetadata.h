@@ -694,6 +694,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
@@ -713,6 +714,7 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - bool callBatch(out*, size, args*...)
   // - void initialize(...)
 
   // call():
@@ -829,6 +831,17 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): computes the results for 'size' rows of flat arguments
+  // without nulls from pointers to the raw values. Returns false if the batch
+  // must be processed again row by row, e.g. to report an error.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      bool,
+      exec_return_type*,
+      int32_t,
+      const exec_arg_type<TArgs>*...>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -978,6 +991,17 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      exec_return_type* out,
+      int32_t size,
+      const typename exec_resolver<TArgs>::in_type*... args) {
+    if constexpr (udf_has_callBatch) {
+      return instance_.callBatch(out, size, args...);
+    } else {
+      return false;
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status callNullFree(
       exec_return_type& out,
       bool& notNull,
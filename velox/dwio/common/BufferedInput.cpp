@@ -90,6 +90,7 @@ void BufferedInput::readToBuffer(
   if (auto* stats = input_->getStats()) {
     stats->read().increment(allocated.size());
     stats->queryThreadIoLatency().increment(usec);
+    stats->recordLatency(IoStatistics::IoTier::kStorage, usec, true);
   }
 }
 
@@ -79,6 +79,23 @@ class BufferedInput {
       velox::common::Region region,
       const StreamIdentifier* sid = nullptr);
 
+  /// Returns a stream over the cached decompressed bytes of the compressed
+  /// stream in 'region' or nullptr if these are not cached. The stream is read
+  /// without enqueue() and load().
+  virtual std::unique_ptr<SeekableInputStream> readDecompressed(
+      const velox::common::Region& /*region*/) {
+    return nullptr;
+  }
+
+  /// Returns a stream over 'decompressed', which decompresses the stream
+  /// enqueued for 'region'. The result may also add the decompressed bytes to
+  /// a cache for readDecompressed().
+  virtual std::unique_ptr<SeekableInputStream> cacheDecompressed(
+      const velox::common::Region& /*region*/,
+      std::unique_ptr<SeekableInputStream> decompressed) {
+    return decompressed;
+  }
+
   /// Returns true if load synchronously.
   virtual bool supportSyncLoad() const {
     return true;
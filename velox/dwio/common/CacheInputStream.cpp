@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -211,6 +212,7 @@ void CacheInputStream::loadSync(const Region& region) {
   // the individual parts are hit.
   ioStats_->incRawBytesRead(hitSize);
   prefetchStarted_ = false;
+  const auto lookupStartUs = getCurrentTimeMicro();
   do {
     folly::SemiFuture<bool> cacheLoadWait(false);
     cache::RawFileCacheKey key{fileNum_, region.offset};
@@ -233,18 +235,27 @@ void CacheInputStream::loadSync(const Region& region) {
     if (!entry->getAndClearFirstUseFlag()) {
       // Hit memory cache.
       ioStats_->ramHit().increment(hitSize);
+      ioStats_->recordLatency(
+          IoStatistics::IoTier::kRamHit,
+          getCurrentTimeMicro() - lookupStartUs,
+          true);
     }
     if (!entry->isExclusive()) {
       return;
     }
 
-    // Missed memory cache. Trying to load from ssd cache, and if again
-    // missed, fall back to remote fetching.
+    // Missed memory cache. Trying to load from ssd cache, then from the peer
+    // that owns the range, and if again missed, fall back to remote fetching.
     entry->setGroupId(groupId_);
     entry->setTrackingId(trackingId_);
     if (loadFromSsd(region, *entry)) {
       return;
     }
+    auto* peerCache = cache_->peerCache();
+    if (peerCache != nullptr && peerCache->load(*entry)) {
+      entry->setExclusiveToShared(!noCacheRetention_);
+      return;
+    }
     const auto ranges = makeRanges(entry, region.length);
     uint64_t storageReadUs{0};
     {
@@ -253,6 +264,8 @@ void CacheInputStream::loadSync(const Region& region) {
     }
     ioStats_->read().increment(region.length);
     ioStats_->queryThreadIoLatency().increment(storageReadUs);
+    ioStats_->recordLatency(
+        IoStatistics::IoTier::kStorage, storageReadUs, true);
     ioStats_->incTotalScanTime(storageReadUs * 1'000);
     entry->setExclusiveToShared(!noCacheRetention_);
   } while (pin_.empty());
@@ -319,6 +332,7 @@ bool CacheInputStream::loadFromSsd(
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(region.length);
   ioStats_->queryThreadIoLatency().increment(ssdLoadUs);
+  ioStats_->recordLatency(IoStatistics::IoTier::kSsdHit, ssdLoadUs, true);
   // Skip no-cache retention setting as data is loaded from ssd.
   entry.setExclusiveToShared();
   return true;
@@ -15,9 +15,15 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+
+#include <folly/futures/Future.h>
+#include "velox/common/caching/PeerCache.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/io/CoalescingController.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
+#include "velox/dwio/common/DecompressedCacheInputStream.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
 
@@ -67,6 +73,44 @@ std::unique_ptr<SeekableInputStream> CachedBufferedInput::enqueue(
   return stream;
 }
 
+std::unique_ptr<SeekableInputStream> CachedBufferedInput::readDecompressed(
+    const velox::common::Region& region) {
+  if (options_.decompressedCacheMinUses() == 0 || region.length == 0 ||
+      region.length > options_.decompressedCacheMaxStreamBytes()) {
+    return nullptr;
+  }
+  const auto key =
+      DecompressedCacheInputStream::cacheKey(fileNum_, region.offset);
+  if (!cache_->exists(key)) {
+    return nullptr;
+  }
+  auto pin = cache_->findOrCreate(key, 1);
+  if (pin.empty() || pin.checkedEntry()->isExclusive()) {
+    // Being made by another stream or evicted after exists(). An exclusive
+    // pin is released without content.
+    return nullptr;
+  }
+  return std::make_unique<DecompressedCacheInputStream>(
+      std::move(pin), fmt::format("{}:{}", fileNum_, region.offset));
+}
+
+std::unique_ptr<SeekableInputStream> CachedBufferedInput::cacheDecompressed(
+    const velox::common::Region& region,
+    std::unique_ptr<SeekableInputStream> decompressed) {
+  if (options_.decompressedCacheMinUses() == 0 || region.length == 0 ||
+      region.length > options_.decompressedCacheMaxStreamBytes() ||
+      !decompressed->lastBlockStart().has_value() ||
+      cache_->numUses(RawFileCacheKey{fileNum_, region.offset}) <
+          options_.decompressedCacheMinUses()) {
+    return decompressed;
+  }
+  return std::make_unique<DecompressedCacheInputStream>(
+      std::move(decompressed),
+      cache_,
+      DecompressedCacheInputStream::cacheKey(fileNum_, region.offset),
+      fmt::format("{}:{}", fileNum_, region.offset));
+}
+
 bool CachedBufferedInput::isBuffered(uint64_t /*offset*/, uint64_t /*length*/)
     const {
   return false;
@@ -229,6 +273,22 @@ void CachedBufferedInput::makeLoads(std::vector<CacheRequest*> requests[2]) {
   readRegions(requests[0], false, groupEnds[0]);
 }
 
+int32_t CachedBufferedInput::maxCoalesceDistance() const {
+  if (!options_.adaptiveCoalescing()) {
+    return options_.maxCoalesceDistance();
+  }
+  return io::CoalescingController::forPath(input_->getName())
+      .maxCoalesceDistance(options_.maxCoalesceDistance());
+}
+
+int64_t CachedBufferedInput::maxCoalesceBytes() const {
+  if (!options_.adaptiveCoalescing()) {
+    return options_.maxCoalesceBytes();
+  }
+  return io::CoalescingController::forPath(input_->getName())
+      .maxCoalesceBytes(options_.maxCoalesceBytes());
+}
+
 template <bool kSsd>
 std::vector<int32_t> CachedBufferedInput::groupRequests(
     const std::vector<CacheRequest*>& requests,
@@ -236,7 +296,8 @@ std::vector<int32_t> CachedBufferedInput::groupRequests(
   if (requests.empty() || (requests.size() < 2 && !prefetch)) {
     return {};
   }
-  const int32_t maxDistance = kSsd ? 20000 : options_.maxCoalesceDistance();
+  const int32_t maxDistance = kSsd ? 20000 : this->maxCoalesceDistance();
+  const int64_t maxCoalesceBytes = this->maxCoalesceBytes();
 
   // Combine adjacent short reads.
   int64_t coalescedBytes = 0;
@@ -254,7 +315,7 @@ std::vector<int32_t> CachedBufferedInput::groupRequests(
         return size;
       },
       [&](int32_t index) {
-        if (coalescedBytes > options_.maxCoalesceBytes()) {
+        if (coalescedBytes > maxCoalesceBytes) {
           coalescedBytes = 0;
           return kNoCoalesce;
         }
@@ -319,10 +380,18 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   }
 
  protected:
-  void updateStats(const CoalesceIoStats& stats, bool prefetch, bool ssd) {
+  void updateStats(
+      const CoalesceIoStats& stats,
+      bool prefetch,
+      bool ssd,
+      uint64_t latencyUs) {
     if (ioStats_ == nullptr) {
       return;
     }
+    ioStats_->recordLatency(
+        ssd ? IoStatistics::IoTier::kSsdHit : IoStatistics::IoTier::kStorage,
+        latencyUs,
+        !prefetch);
     ioStats_->incRawOverreadBytes(stats.extraBytes);
     if (ssd) {
       ioStats_->ssdRead().increment(stats.payloadBytes);
@@ -393,22 +462,56 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           }
           pins.push_back(std::move(pin));
         });
-    if (pins.empty()) {
-      return pins;
+    // Entries that the owning peer has are read from it. The rest are read
+    // from storage.
+    std::vector<CachePin> peerPins;
+    if (auto* peerCache = cache_.peerCache()) {
+      std::vector<CachePin> storagePins;
+      for (auto& pin : pins) {
+        if (peerCache->load(*pin.checkedEntry())) {
+          peerPins.push_back(std::move(pin));
+        } else {
+          storagePins.push_back(std::move(pin));
+        }
+      }
+      pins = std::move(storagePins);
+    }
+    if (!pins.empty()) {
+      // If the file reads asynchronously, the coalesced ranges are read in
+      // parallel.
+      const bool readAsync = input_->hasReadAsync();
+      std::vector<folly::SemiFuture<uint64_t>> reads;
+      const auto startUs = getCurrentTimeMicro();
+      auto stats = cache::readPins(
+          pins,
+          maxCoalesceDistance_,
+          1000,
+          [&](int32_t i) { return pins[i].entry()->offset(); },
+          [&](const std::vector<CachePin>& /*pins*/,
+              int32_t /*begin*/,
+              int32_t /*end*/,
+              uint64_t offset,
+              const std::vector<folly::Range<char*>>& buffers) {
+            if (readAsync) {
+              reads.push_back(
+                  input_->readAsync(buffers, offset, LogType::FILE));
+            } else {
+              input_->read(buffers, offset, LogType::FILE);
+            }
+          });
+      if (!reads.empty()) {
+        // All reads are waited for before throwing so that none is in
+        // progress after the pins are released.
+        auto results = folly::collectAll(std::move(reads)).get();
+        for (auto& result : results) {
+          result.throwUnlessValue();
+        }
+      }
+      updateStats(stats, prefetch, false, getCurrentTimeMicro() - startUs);
+    }
+    for (auto& pin : peerPins) {
+      pins.push_back(std::move(pin));
     }
-    auto stats = cache::readPins(
-        pins,
-        maxCoalesceDistance_,
-        1000,
-        [&](int32_t i) { return pins[i].entry()->offset(); },
-        [&](const std::vector<CachePin>& /*pins*/,
-            int32_t /*begin*/,
-            int32_t /*end*/,
-            uint64_t offset,
-            const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
-        });
-    updateStats(stats, prefetch, false);
     return pins;
   }
 
@@ -449,8 +552,13 @@ class SsdLoad : public DwioCoalescedLoadBase {
       return pins;
     }
     assert(!ssdPins.empty()); // for lint.
-    const auto stats = ssdPins[0].file()->load(ssdPins, pins);
-    updateStats(stats, prefetch, true);
+    uint64_t loadUs{0};
+    CoalesceIoStats stats;
+    {
+      MicrosecondTimer timer(&loadUs);
+      stats = ssdPins[0].file()->load(ssdPins, pins);
+    }
+    updateStats(stats, prefetch, true, loadUs);
     return pins;
   }
 };
@@ -476,7 +584,7 @@ void CachedBufferedInput::readRegion(
         fsStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
@@ -116,6 +116,16 @@ class CachedBufferedInput : public BufferedInput {
       velox::common::Region region,
       const StreamIdentifier* sid) override;
 
+  std::unique_ptr<SeekableInputStream> readDecompressed(
+      const velox::common::Region& region) override;
+
+  /// Caches the decompressed bytes if the compressed bytes in the cache were
+  /// used at least decompressedCacheMinUses() times. See
+  /// io::ReaderOptions::setDecompressedCacheMinUses().
+  std::unique_ptr<SeekableInputStream> cacheDecompressed(
+      const velox::common::Region& region,
+      std::unique_ptr<SeekableInputStream> decompressed) override;
+
   bool supportSyncLoad() const override {
     return false;
   }
@@ -176,6 +186,12 @@ class CachedBufferedInput : public BufferedInput {
   }
 
  private:
+  // Returns the max gap and the max size of coalesced reads. These are
+  // learned from the reads of the file system of 'input_' if adaptive
+  // coalescing is enabled in 'options_'.
+  int32_t maxCoalesceDistance() const;
+  int64_t maxCoalesceBytes() const;
+
   template <bool kSsd>
   std::vector<int32_t> groupRequests(
       const std::vector<CacheRequest*>& requests,
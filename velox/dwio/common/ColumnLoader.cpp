@@ -23,14 +23,18 @@ namespace facebook::velox::dwio::common {
 namespace {
 
 // Call the field reader `read` with the correct row set based on whether the
-// row set has been filtered or not after its parent is read.
+// row set has been filtered or not after its parent is read. If 'mayRebase',
+// the rows before the first selected row may be skipped by seeking to a later
+// row group, in which case the returned rows are relative to the row group
+// start.
 RowSet read(
     SelectiveStructColumnReaderBase* structReader,
     SelectiveColumnReader* fieldReader,
     uint64_t version,
     RowSet rows,
     raw_vector<vector_size_t>& selectedRows,
-    ValueHook* hook) {
+    ValueHook* hook,
+    bool mayRebase) {
   VELOX_CHECK_EQ(
       version,
       structReader->numReads(),
@@ -54,11 +58,30 @@ RowSet read(
     effectiveRows = selectedRows;
   }
 
-  structReader->advanceFieldReader(fieldReader, offset);
+  const bool isStruct = fieldReader->fileType().type()->isRow() ||
+      fieldReader->scanSpec()->isFlatMapAsStruct();
+  int64_t numSkipped = 0;
+  if (mayRebase && hook == nullptr && incomingNulls == nullptr && !isStruct &&
+      !effectiveRows.empty()) {
+    // Value hooks get the row numbers of the read, so rows are rebased only
+    // when there is no hook.
+    numSkipped = structReader->advanceFieldReaderToRow(
+        fieldReader, offset, effectiveRows.front());
+  } else {
+    structReader->advanceFieldReader(fieldReader, offset);
+  }
+  if (numSkipped > 0) {
+    VELOX_DCHECK_LE(numSkipped, effectiveRows.front());
+    // 'effectiveRows' may be 'selectedRows', which keeps its size.
+    selectedRows.resize(effectiveRows.size());
+    for (auto i = 0; i < effectiveRows.size(); ++i) {
+      selectedRows[i] = effectiveRows[i] - numSkipped;
+    }
+    effectiveRows = selectedRows;
+  }
   fieldReader->scanSpec()->setValueHook(hook);
-  fieldReader->read(offset, effectiveRows, incomingNulls);
-  if (fieldReader->fileType().type()->isRow() ||
-      fieldReader->scanSpec()->isFlatMapAsStruct()) {
+  fieldReader->read(offset + numSkipped, effectiveRows, incomingNulls);
+  if (isStruct) {
     // 'fieldReader_' may itself produce LazyVectors. For this it must have its
     // result row numbers set.
     static_cast<SelectiveStructColumnReaderBase*>(fieldReader)
@@ -157,8 +180,8 @@ void ColumnLoader::loadInternal(
        },
        structReader_});
   raw_vector<vector_size_t> selectedRows;
-  auto effectiveRows =
-      read(structReader_, fieldReader_, version_, rows, selectedRows, hook);
+  auto effectiveRows = read(
+      structReader_, fieldReader_, version_, rows, selectedRows, hook, true);
   if (!hook) {
     fieldReader_->getValues(effectiveRows, result);
     if (((rows.back() + 1) < resultSize) ||
@@ -191,8 +214,15 @@ void DeltaUpdateColumnLoader::loadInternal(
   scanSpec->setValueHook(nullptr);
   raw_vector<vector_size_t> selectedRows;
   RowSet effectiveRows;
-  effectiveRows =
-      read(structReader_, fieldReader_, version_, rows, selectedRows, nullptr);
+  // The delta update is applied by row numbers of the read.
+  effectiveRows = read(
+      structReader_,
+      fieldReader_,
+      version_,
+      rows,
+      selectedRows,
+      nullptr,
+      false);
   fieldReader_->getValues(effectiveRows, result);
   scanSpec->deltaUpdate()->update(effectiveRows, *result);
   if (hook) {
@@ -972,6 +972,29 @@ class DictionaryColumnVisitor
       int32_t* filterHits,
       T* values,
       int32_t& numValues) {
+    if constexpr (
+        DictionaryColumnVisitor::hasFilter() && !hasHook &&
+        TFilter::deterministic) {
+      if (delta == 0 && !inDict()) {
+        // All rows of the run have the same dictionary entry, so the filter
+        // is tested once and the run is taken or skipped as a whole.
+        auto& cached = filterCache()[value];
+        if (cached == FilterResult::kUnknown) {
+          cached = velox::common::applyFilter(super::filter_, dict()[value])
+              ? FilterResult::kSuccess
+              : FilterResult::kFailure;
+        }
+        processRepeatedRun<scatter>(
+            cached == FilterResult::kSuccess,
+            dict()[value],
+            numRows,
+            scatterRows,
+            filterHits,
+            values,
+            numValues);
+        return;
+      }
+    }
     auto indices = reinterpret_cast<typename make_index<T>::type*>(values);
     if (sizeof(T) == 8) {
       constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
@@ -1088,6 +1111,29 @@ class DictionaryColumnVisitor
   }
 
  protected:
+  // Processes a run of 'numRows' rows with the same value 'value'. If
+  // 'passed', adds the rows to 'filterHits' and 'value' to 'values' for each
+  // unless only filtering.
+  template <bool scatter, typename TValue>
+  void processRepeatedRun(
+      bool passed,
+      TValue value,
+      int32_t numRows,
+      const int32_t* scatterRows,
+      int32_t* filterHits,
+      TValue* values,
+      int32_t& numValues) {
+    if (passed) {
+      auto* begin = (scatter ? scatterRows : super::rows_) + super::rowIndex_;
+      std::copy(begin, begin + numRows, filterHits + numValues);
+      if constexpr (!super::kFilterOnly) {
+        std::fill(values + numValues, values + numValues + numRows, value);
+      }
+      numValues += numRows;
+    }
+    super::rowIndex_ += numRows;
+  }
+
   const uint64_t* inDict() const {
     return state_.inDictionary;
   }
@@ -1314,6 +1360,29 @@ class StringDictionaryColumnVisitor
       int32_t* filterHits,
       int32_t* values,
       int32_t& numValues) {
+    if constexpr (
+        DictSuper::hasFilter() && !hasHook && TFilter::deterministic) {
+      if (delta == 0 && !DictSuper::inDict()) {
+        // All rows of the run have the same dictionary entry, so the filter
+        // is tested once and the run is taken or skipped as a whole.
+        auto& cached = DictSuper::filterCache()[value];
+        if (cached == FilterResult::kUnknown) {
+          cached = velox::common::applyFilter(
+                       super::filter_, valueInDictionary(value))
+              ? FilterResult::kSuccess
+              : FilterResult::kFailure;
+        }
+        DictSuper::template processRepeatedRun<scatter>(
+            cached == FilterResult::kSuccess,
+            value,
+            numRows,
+            scatterRows,
+            filterHits,
+            values,
+            numValues);
+        return;
+      }
+    }
     constexpr int32_t kWidth = xsimd::batch<int32_t>::size;
     for (auto i = 0; i < numRows; i += kWidth) {
       ((xsimd::load_unaligned(super::rows_ + super::rowIndex_ + i) -
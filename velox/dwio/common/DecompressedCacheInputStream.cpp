@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/DecompressedCacheInputStream.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+// Returns the ranges of the first 'size' bytes of 'entry'.
+std::vector<folly::Range<char*>> entryRanges(
+    cache::AsyncDataCacheEntry& entry,
+    uint64_t size) {
+  std::vector<folly::Range<char*>> ranges;
+  if (entry.tinyData() != nullptr) {
+    ranges.emplace_back(entry.tinyData(), size);
+    return ranges;
+  }
+  auto& allocation = entry.data();
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < size; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto bytes = std::min<uint64_t>(
+        memory::AllocationTraits::pageBytes(run.numPages()), size - offset);
+    ranges.emplace_back(run.data<char>(), bytes);
+    offset += bytes;
+  }
+  return ranges;
+}
+
+// Copies 'size' bytes from 'ranges' starting at 'offset' into 'data'.
+// Returns the offset after the copied bytes.
+uint64_t copyFromRanges(
+    const std::vector<folly::Range<char*>>& ranges,
+    uint64_t offset,
+    void* data,
+    uint64_t size) {
+  auto* destination = reinterpret_cast<char*>(data);
+  uint64_t rangeOffset = 0;
+  for (const auto& range : ranges) {
+    if (size == 0) {
+      break;
+    }
+    if (offset < rangeOffset + range.size()) {
+      const auto begin = offset - rangeOffset;
+      const auto bytes = std::min<uint64_t>(size, range.size() - begin);
+      ::memcpy(destination, range.data() + begin, bytes);
+      destination += bytes;
+      offset += bytes;
+      size -= bytes;
+    }
+    rangeOffset += range.size();
+  }
+  VELOX_CHECK_EQ(size, 0);
+  return offset;
+}
+
+// Copies 'size' bytes from 'data' into 'ranges' starting at 'offset'.
+// Returns the offset after the copied bytes.
+uint64_t copyToRanges(
+    const void* data,
+    uint64_t size,
+    const std::vector<folly::Range<char*>>& ranges,
+    uint64_t offset) {
+  const auto* source = reinterpret_cast<const char*>(data);
+  uint64_t rangeOffset = 0;
+  for (const auto& range : ranges) {
+    if (size == 0) {
+      break;
+    }
+    if (offset < rangeOffset + range.size()) {
+      const auto begin = offset - rangeOffset;
+      const auto bytes = std::min<uint64_t>(size, range.size() - begin);
+      ::memcpy(range.data() + begin, source, bytes);
+      source += bytes;
+      offset += bytes;
+      size -= bytes;
+    }
+    rangeOffset += range.size();
+  }
+  VELOX_CHECK_EQ(size, 0);
+  return offset;
+}
+} // namespace
+
+DecompressedCacheInputStream::DecompressedCacheInputStream(
+    cache::CachePin pin,
+    std::string name)
+    : name_(std::move(name)), pin_(std::move(pin)) {
+  VELOX_CHECK(pin_.checkedEntry()->isShared());
+  readEntry();
+}
+
+DecompressedCacheInputStream::DecompressedCacheInputStream(
+    std::unique_ptr<SeekableInputStream> decompressed,
+    cache::AsyncDataCache* cache,
+    cache::RawFileCacheKey key,
+    std::string name)
+    : name_(std::move(name)),
+      decompressed_(std::move(decompressed)),
+      cache_(cache),
+      key_(key) {
+  VELOX_CHECK(decompressed_->lastBlockStart().has_value());
+}
+
+void DecompressedCacheInputStream::ensureLoaded() {
+  if (decompressed_ == nullptr) {
+    return;
+  }
+  const void* data;
+  int32_t size;
+  while (decompressed_->Next(&data, &size)) {
+    const auto blockStart = decompressed_->lastBlockStart().value();
+    if (blockStarts_.empty() || blockStarts_.back().first != blockStart.first) {
+      blockStarts_.push_back(blockStart);
+    }
+    bytes_.append(reinterpret_cast<const char*>(data), size);
+  }
+  decompressed_.reset();
+
+  // The entry has the number of blocks and the block starts before the bytes.
+  const uint64_t numBlocks = blockStarts_.size();
+  const auto headerSize =
+      sizeof(numBlocks) + numBlocks * sizeof(blockStarts_[0]);
+  try {
+    pin_ = cache_->findOrCreate(key_, headerSize + bytes_.size());
+  } catch (const VeloxException& e) {
+    if (e.errorCode() != error_code::kNoCacheSpace.c_str()) {
+      throw;
+    }
+  }
+  if (!pin_.empty() && pin_.checkedEntry()->isExclusive()) {
+    auto* entry = pin_.checkedEntry();
+    const auto ranges = entryRanges(*entry, entry->size());
+    auto offset = copyToRanges(&numBlocks, sizeof(numBlocks), ranges, 0);
+    offset = copyToRanges(
+        blockStarts_.data(),
+        numBlocks * sizeof(blockStarts_[0]),
+        ranges,
+        offset);
+    copyToRanges(bytes_.data(), bytes_.size(), ranges, offset);
+    entry->setDecompressed();
+    entry->setExclusiveToShared(false);
+  }
+  if (!pin_.empty()) {
+    blockStarts_.clear();
+    bytes_.clear();
+    bytes_.shrink_to_fit();
+    readEntry();
+    return;
+  }
+  // Another stream is adding the same entry or there is no space.
+  ranges_.emplace_back(bytes_.data(), bytes_.size());
+  rangeStarts_.push_back(0);
+  size_ = bytes_.size();
+}
+
+void DecompressedCacheInputStream::readEntry() {
+  auto* entry = pin_.checkedEntry();
+  const auto ranges = entryRanges(*entry, entry->size());
+  uint64_t numBlocks;
+  auto offset = copyFromRanges(ranges, 0, &numBlocks, sizeof(numBlocks));
+  blockStarts_.resize(numBlocks);
+  offset = copyFromRanges(
+      ranges, offset, blockStarts_.data(), numBlocks * sizeof(blockStarts_[0]));
+  uint64_t rangeOffset = 0;
+  for (const auto& range : ranges) {
+    if (offset < rangeOffset + range.size()) {
+      const auto begin = std::max(offset, rangeOffset) - rangeOffset;
+      rangeStarts_.push_back(size_);
+      ranges_.emplace_back(range.data() + begin, range.size() - begin);
+      size_ += range.size() - begin;
+    }
+    rangeOffset += range.size();
+  }
+}
+
+bool DecompressedCacheInputStream::Next(const void** data, int32_t* size) {
+  ensureLoaded();
+  if (position_ >= size_) {
+    *size = 0;
+    lastSize_ = 0;
+    return false;
+  }
+  const auto index =
+      std::upper_bound(rangeStarts_.begin(), rangeStarts_.end(), position_) -
+      rangeStarts_.begin() - 1;
+  const auto offsetInRange = position_ - rangeStarts_[index];
+  *data = ranges_[index].data() + offsetInRange;
+  *size = ranges_[index].size() - offsetInRange;
+  position_ += *size;
+  lastSize_ = *size;
+  return true;
+}
+
+void DecompressedCacheInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_GE(count, 0);
+  VELOX_CHECK_LE(count, lastSize_, "Backup past last Next in {}", name_);
+  position_ -= count;
+  lastSize_ -= count;
+}
+
+bool DecompressedCacheInputStream::SkipInt64(int64_t count) {
+  VELOX_CHECK_GE(count, 0);
+  ensureLoaded();
+  position_ = std::min<uint64_t>(position_ + count, size_);
+  lastSize_ = 0;
+  return position_ < size_;
+}
+
+google::protobuf::int64 DecompressedCacheInputStream::ByteCount() const {
+  return position_;
+}
+
+void DecompressedCacheInputStream::seekToPosition(
+    PositionProvider& positionProvider) {
+  ensureLoaded();
+  const auto compressedOffset = positionProvider.next();
+  const auto uncompressedOffset = positionProvider.next();
+  auto it = std::lower_bound(
+      blockStarts_.begin(),
+      blockStarts_.end(),
+      compressedOffset,
+      [](const auto& blockStart, uint64_t offset) {
+        return blockStart.first < offset;
+      });
+  if (it == blockStarts_.end()) {
+    // Seeks to the end of the stream.
+    VELOX_CHECK_EQ(uncompressedOffset, 0, "Bad seek in {}", name_);
+    position_ = size_;
+  } else {
+    VELOX_CHECK_EQ(
+        it->first, compressedOffset, "Seek to no block start in {}", name_);
+    position_ = it->second + uncompressedOffset;
+    VELOX_CHECK_LE(position_, size_, "Seek past end in {}", name_);
+  }
+  lastSize_ = 0;
+}
+
+std::string DecompressedCacheInputStream::getName() const {
+  return fmt::format(
+      "DecompressedCacheInputStream {} of {} bytes", name_, size_);
+}
+
+} // namespace facebook::velox::dwio::common
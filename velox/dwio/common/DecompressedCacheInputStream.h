@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Stream over the decompressed bytes of a stream of compression blocks that
+/// are kept in AsyncDataCache, so that a stream that is read often is not
+/// decompressed again. The cache entry starts with the offsets of the
+/// compression blocks, so that the positions in the compressed stream, e.g.
+/// from a row index, can be seeked to. These entries are evicted before the
+/// entries of file data and are not saved to SSD.
+class DecompressedCacheInputStream : public SeekableInputStream {
+ public:
+  /// Reads the decompressed stream in the entry of 'pin'.
+  DecompressedCacheInputStream(cache::CachePin pin, std::string name);
+
+  /// Reads 'decompressed' on first use and adds its bytes to 'cache' under
+  /// 'key'. Reads from a copy of the bytes if there is no space in 'cache'.
+  /// 'decompressed' must return its block starts from lastBlockStart().
+  DecompressedCacheInputStream(
+      std::unique_ptr<SeekableInputStream> decompressed,
+      cache::AsyncDataCache* cache,
+      cache::RawFileCacheKey key,
+      std::string name);
+
+  /// Returns the cache key of the decompressed bytes of the compressed stream
+  /// at 'offset' in file 'fileNum'.
+  static cache::RawFileCacheKey cacheKey(uint64_t fileNum, uint64_t offset) {
+    return cache::RawFileCacheKey{fileNum, offset | kDecompressedOffsetFlag};
+  }
+
+  bool Next(const void** data, int32_t* size) override;
+  void BackUp(int32_t count) override;
+  bool SkipInt64(int64_t count) override;
+  google::protobuf::int64 ByteCount() const override;
+  void seekToPosition(PositionProvider& position) override;
+  std::string getName() const override;
+
+  size_t positionSize() const override {
+    // Compressed position and position in the block, like the compressed
+    // stream.
+    return 2;
+  }
+
+ private:
+  // Distinguishes the keys of decompressed streams from the keys of file data.
+  static constexpr uint64_t kDecompressedOffsetFlag = 1ULL << 63;
+
+  // Reads 'decompressed_' into the cache if not done yet.
+  void ensureLoaded();
+
+  // Sets 'ranges_' and 'blockStarts_' from the entry of 'pin_'.
+  void readEntry();
+
+  std::string name_;
+  std::unique_ptr<SeekableInputStream> decompressed_;
+  cache::AsyncDataCache* cache_{nullptr};
+  cache::RawFileCacheKey key_{};
+
+  cache::CachePin pin_;
+  // The decompressed bytes if they could not be added to the cache.
+  std::string bytes_;
+
+  // The ranges of the decompressed bytes in 'pin_' or 'bytes_'.
+  std::vector<folly::Range<const char*>> ranges_;
+  // The position of the start of each of 'ranges_'.
+  std::vector<uint64_t> rangeStarts_;
+  uint64_t size_{0};
+
+  // The offset of each compression block in the compressed stream and its
+  // position in the decompressed bytes, ordered by offset.
+  std::vector<std::pair<uint64_t, uint64_t>> blockStarts_;
+
+  uint64_t position_{0};
+  // The size returned by the last Next(), which is the limit of BackUp().
+  int32_t lastSize_{0};
+};
+
+} // namespace facebook::velox::dwio::common
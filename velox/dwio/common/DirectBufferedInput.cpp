@@ -16,6 +16,7 @@
 
 #include "velox/dwio/common/DirectBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/io/CoalescingController.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/DirectInputStream.h"
@@ -92,6 +93,10 @@ bool lessThan(const LoadRequest* left, const LoadRequest* right) {
 void DirectBufferedInput::load(const LogType /*unused*/) {
   // After load, new requests cannot be merged into pre-load ones.
   auto requests = std::move(requests_);
+  if (!input_->getReadFile()->mappedRange(0, fileSize_).empty()) {
+    // The streams read the mapped file in place.
+    return;
+  }
   std::vector<LoadRequest*> storageLoad[2];
   for (auto& request : requests) {
     cache::TrackingData trackingData;
@@ -123,6 +128,22 @@ void DirectBufferedInput::load(const LogType /*unused*/) {
   readRegions(storageLoad[0], false, groupEnds[0]);
 }
 
+int32_t DirectBufferedInput::maxCoalesceDistance() const {
+  if (!options_.adaptiveCoalescing()) {
+    return options_.maxCoalesceDistance();
+  }
+  return io::CoalescingController::forPath(input_->getName())
+      .maxCoalesceDistance(options_.maxCoalesceDistance());
+}
+
+int64_t DirectBufferedInput::maxCoalesceBytes() const {
+  if (!options_.adaptiveCoalescing()) {
+    return options_.maxCoalesceBytes();
+  }
+  return io::CoalescingController::forPath(input_->getName())
+      .maxCoalesceBytes(options_.maxCoalesceBytes());
+}
+
 std::vector<int32_t> DirectBufferedInput::groupRequests(
     const std::vector<LoadRequest*>& requests,
     bool prefetch) const {
@@ -131,13 +152,13 @@ std::vector<int32_t> DirectBufferedInput::groupRequests(
     // eligible to prefetch. This will be loaded by itself on first use.
     return {};
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  const int32_t maxDistance = this->maxCoalesceDistance();
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
   // is correlated.
   const auto maxCoalesceBytes =
-      prefetch ? options_.maxCoalesceBytes() : loadQuantum;
+      prefetch ? this->maxCoalesceBytes() : loadQuantum;
 
   // Combine adjacent short reads.
   int64_t coalescedBytes = 0;
@@ -325,6 +346,7 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
   ioStats_->incRawBytesRead(size);
   ioStats_->incTotalScanTime(usecs * 1'000);
   ioStats_->queryThreadIoLatency().increment(usecs);
+  ioStats_->recordLatency(IoStatistics::IoTier::kStorage, usecs, !prefetch);
   ioStats_->incRawOverreadBytes(overread);
   if (prefetch) {
     ioStats_->prefetch().increment(size + overread);
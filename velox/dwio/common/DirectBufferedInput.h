@@ -225,6 +225,12 @@ class DirectBufferedInput : public BufferedInput {
         fileSize_(input_->getLength()),
         options_(readerOptions) {}
 
+  // Returns the max gap and the max size of coalesced reads. These are
+  // learned from the reads of the file system of 'input_' if adaptive
+  // coalescing is enabled in 'options_'.
+  int32_t maxCoalesceDistance() const;
+  int64_t maxCoalesceBytes() const;
+
   std::vector<int32_t> groupRequests(
       const std::vector<LoadRequest*>& requests,
       bool prefetch) const;
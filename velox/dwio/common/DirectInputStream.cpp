@@ -56,7 +56,7 @@ bool DirectInputStream::Next(const void** buffer, int32_t* size) {
   }
   loadPosition();
 
-  *buffer = reinterpret_cast<const void**>(run_ + offsetInRun_);
+  *buffer = run_ + offsetInRun_;
   *size = runSize_ - offsetInRun_;
   if (offsetInRegion_ + *size > region_.length) {
     *size = region_.length - offsetInRegion_;
@@ -161,7 +161,12 @@ void DirectInputStream::loadPosition() {
   VELOX_CHECK_LT(offsetInRegion_, region_.length);
   if (!loaded_) {
     loaded_ = true;
-    auto load = bufferedInput_->coalescedLoad(this);
+    // A mapped file is read in place and is not part of a coalesced load.
+    mapped_ = input_->getReadFile()
+                  ->mappedRange(region_.offset, region_.length)
+                  .data();
+    auto load =
+        mapped_ == nullptr ? bufferedInput_->coalescedLoad(this) : nullptr;
     if (load != nullptr) {
       folly::SemiFuture<bool> waitFuture(false);
       uint64_t loadUs = 0;
@@ -174,6 +179,10 @@ void DirectInputStream::loadPosition() {
         loadedRegion_.length = load->getData(region_.offset, data_, tinyData_);
       }
       ioStats_->queryThreadIoLatency().increment(loadUs);
+    } else if (mapped_ != nullptr) {
+      loadedRegion_ = region_;
+      ioStats_->incRawBytesRead(region_.length);
+      ioStats_->read().increment(region_.length);
     } else {
       // Standalone stream, not part of coalesced load.
       loadedRegion_.offset = 0;
@@ -181,6 +190,14 @@ void DirectInputStream::loadPosition() {
     }
   }
 
+  if (mapped_ != nullptr) {
+    run_ = reinterpret_cast<const uint8_t*>(mapped_);
+    runSize_ = region_.length;
+    offsetInRun_ = offsetInRegion_;
+    offsetOfRun_ = 0;
+    return;
+  }
+
   // Check if position outside of loaded bounds.
   if (loadedRegion_.length == 0 ||
       region_.offset + offsetInRegion_ < loadedRegion_.offset ||
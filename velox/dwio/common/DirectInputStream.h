@@ -91,9 +91,13 @@ class DirectInputStream : public SeekableInputStream {
   // Contains the data if the range is too small for Allocation.
   std::string tinyData_;
 
+  // The bytes of 'region_' if the file is mapped into memory. The stream then
+  // returns these bytes without loading.
+  const char* mapped_{nullptr};
+
   // Pointer  to start of current run in 'entry->data()' or
   // 'entry->tinyData()'.
-  uint8_t* run_{nullptr};
+  const uint8_t* run_{nullptr};
 
   // Offset of current run from start of 'data_'
   uint64_t offsetOfRun_;
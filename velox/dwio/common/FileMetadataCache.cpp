@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+FileMetadataCache*& instance() {
+  static FileMetadataCache* cache{nullptr};
+  return cache;
+}
+
+} // namespace
+
+FileMetadataCache::FileMetadataCache(uint64_t maxBytes)
+    : pool_(memory::memoryManager()->addLeafPool("fileMetadataCache")),
+      factory_(
+          std::make_unique<SimpleLRUCache<std::string, FileMetadata>>(
+              maxBytes),
+          std::make_unique<FileMetadataGenerator>()) {}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return instance();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  instance() = cache;
+}
+
+// static
+std::string FileMetadataCache::makeKey(
+    std::string_view path,
+    int64_t modificationTime,
+    int64_t fileSize) {
+  return fmt::format("{}\n{}\n{}", path, modificationTime, fileSize);
+}
+
+FileMetadataCachedPtr FileMetadataCache::get(
+    const std::string& key,
+    const FileMetadataLoader& loader) {
+  return factory_.generate(key, &loader);
+}
+
+void FileMetadataCache::prefetch(
+    const std::string& key,
+    FileMetadataLoader loader,
+    folly::Executor* executor) {
+  VELOX_CHECK_NOT_NULL(executor);
+  executor->add([this, key, loader = std::move(loader)]() {
+    try {
+      factory_.generate(key, &loader);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to prefetch the metadata of "
+                   << key.substr(0, key.find('\n')) << ": " << e.what();
+    }
+  });
+}
+
+void FileMetadataCache::clear() {
+  factory_.clearCache();
+}
+
+} // namespace facebook::velox::dwio::common
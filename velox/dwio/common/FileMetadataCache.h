@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::dwio::common {
+
+/// The parsed metadata of a file, e.g. its deserialized footer with the
+/// schema and the stripe or row group statistics. Subclassed by the file
+/// formats that cache their metadata.
+class FileMetadata {
+ public:
+  virtual ~FileMetadata() = default;
+
+  /// Estimated memory footprint in bytes.
+  virtual uint64_t estimatedSize() const = 0;
+};
+
+struct FileMetadataSizer {
+  int64_t operator()(const FileMetadata& metadata) const {
+    return metadata.estimatedSize();
+  }
+};
+
+/// Reads and parses the metadata of a file on a cache miss.
+using FileMetadataLoader = std::function<std::unique_ptr<FileMetadata>()>;
+
+/// The CachedFactory generator of the metadata, which is read by the
+/// FileMetadataLoader passed as the properties of the lookup.
+class FileMetadataGenerator {
+ public:
+  std::unique_ptr<FileMetadata> operator()(
+      const std::string& /*key*/,
+      const FileMetadataLoader* loader,
+      void* /*stats*/) {
+    return (*loader)();
+  }
+};
+
+using FileMetadataCachedPtr = CachedPtr<std::string, FileMetadata>;
+
+/// Node level cache of the parsed metadata of files, shared by the readers of
+/// all queries so that the readers of the splits of a file parse its footer
+/// once. The entries are keyed by makeKey() on the path, modification time and
+/// size of the files, which identify an immutable version of a file.
+/// Concurrent lookups of a missing entry load the metadata once. The readers
+/// pin the entries they use, so these must not be modified.
+class FileMetadataCache {
+ public:
+  /// 'maxBytes' is the capacity in terms of FileMetadata::estimatedSize().
+  explicit FileMetadataCache(uint64_t maxBytes);
+
+  /// The cache used by the readers, nullptr if metadata is not cached.
+  static FileMetadataCache* getInstance();
+
+  /// Installs or, with nullptr, removes the cache used by the readers. The
+  /// caller keeps the ownership of 'cache'.
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the key of the version of the file at 'path' with
+  /// 'modificationTime' and 'fileSize'.
+  static std::string
+  makeKey(std::string_view path, int64_t modificationTime, int64_t fileSize);
+
+  /// The pool of the reads issued by the loaders of prefetch().
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// Returns the metadata for 'key', read by 'loader' if not cached.
+  FileMetadataCachedPtr get(
+      const std::string& key,
+      const FileMetadataLoader& loader);
+
+  /// Loads the metadata for 'key' with 'loader' on 'executor' unless it is
+  /// cached, so that the readers of the file opened later find it in the
+  /// cache. Loading failures are logged and left to the readers to report.
+  /// 'this' must outlive the scheduled loads.
+  void prefetch(
+      const std::string& key,
+      FileMetadataLoader loader,
+      folly::Executor* executor);
+
+  SimpleLRUCacheStats stats() {
+    return factory_.cacheStats();
+  }
+
+  /// Drops the entries not in use.
+  void clear();
+
+ private:
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  CachedFactory<
+      std::string,
+      FileMetadata,
+      FileMetadataGenerator,
+      FileMetadataLoader,
+      void,
+      FileMetadataSizer>
+      factory_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -66,7 +66,9 @@ ReadFileInputStream::ReadFileInputStream(
     IoStatistics* stats,
     filesystems::File::IoStats* fsStats)
     : InputStream(readFile->getName(), metricsLog, stats, fsStats),
-      readFile_(std::move(readFile)) {}
+      readFile_(std::move(readFile)),
+      coalescingController_(
+          &io::CoalescingController::forPath(readFile_->getName())) {}
 
 void ReadFileInputStream::read(
     void* buf,
@@ -81,6 +83,7 @@ void ReadFileInputStream::read(
     MicrosecondTimer timer(&readTimeUs);
     readData = readFile_->pread(offset, length, buf, fsStats_);
   }
+  coalescingController_->recordRead(length, readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
@@ -102,7 +105,13 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  const auto size = readFile_->preadv(offset, buffers, fsStats_);
+  uint64_t readTimeUs{0};
+  uint64_t size;
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    size = readFile_->preadv(offset, buffers, fsStats_);
+  }
+  coalescingController_->recordRead(bufferSize, readTimeUs);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
@@ -32,6 +32,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
+#include "velox/common/io/CoalescingController.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/dwio/common/MetricsLog.h"
 
@@ -184,6 +185,9 @@ class ReadFileInputStream final : public InputStream {
 
  private:
   std::shared_ptr<velox::ReadFile> readFile_;
+  // Learns the cost of reads for the file system of 'readFile_' from the
+  // timings of the synchronous reads.
+  io::CoalescingController* const coalescingController_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -182,7 +182,7 @@ std::unique_ptr<MetadataFilter::Node> MetadataFilter::Node::fromExpression(
     Subfield subfield;
     auto filter =
         exec::ExprToSubfieldFilterParser::getInstance()
-            ->leafCallToSubfieldFilter(*call, subfield, evaluator, negated);
+            ->leafCallToMetadataFilter(*call, subfield, evaluator, negated);
     if (!filter) {
       return nullptr;
     }
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/MultiColumnFilter.h"
+
+#include <algorithm>
+
+#include <folly/String.h>
+
+namespace facebook::velox::common {
+
+namespace {
+std::vector<DecodedVector> decodeAll(
+    const RowVector& values,
+    const std::vector<std::string>& fields,
+    uint64_t* nonNullRows) {
+  VELOX_CHECK_EQ(values.childrenSize(), fields.size());
+  SelectivityVector rows(values.size());
+  std::vector<DecodedVector> decoded(fields.size());
+  for (auto i = 0; i < fields.size(); ++i) {
+    decoded[i].decode(*values.childAt(i), rows);
+    if (decoded[i].mayHaveNulls()) {
+      bits::andBits(nonNullRows, decoded[i].nulls(&rows), 0, values.size());
+    }
+  }
+  return decoded;
+}
+
+std::vector<TypePtr> childTypes(const RowVector& values) {
+  return asRowType(values.type())->children();
+}
+} // namespace
+
+MultiColumnFilter::MultiColumnFilter(std::vector<std::string> fields)
+    : fields_(std::move(fields)) {
+  VELOX_CHECK_GE(
+      fields_.size(), 2, "A MultiColumnFilter must have at least 2 fields");
+}
+
+// static
+uint64_t MultiColumnFilter::hashRow(
+    const std::vector<DecodedVector>& columns,
+    vector_size_t row) {
+  uint64_t hash = 0;
+  for (auto& column : columns) {
+    hash = bits::hashMix(hash, column.base()->hashValueAt(column.index(row)));
+  }
+  return hash;
+}
+
+std::vector<DecodedVector> MultiColumnFilter::decode(
+    const std::vector<VectorPtr>& columns,
+    const std::vector<TypePtr>& types,
+    vector_size_t numRows,
+    uint64_t* passed) const {
+  VELOX_CHECK_EQ(columns.size(), fields_.size());
+  SelectivityVector rows(numRows);
+  std::vector<DecodedVector> decoded(columns.size());
+  for (auto i = 0; i < columns.size(); ++i) {
+    VELOX_CHECK(
+        columns[i]->type()->equivalent(*types[i]),
+        "Type of {} does not match the filter: {} vs. {}",
+        fields_[i],
+        columns[i]->type()->toString(),
+        types[i]->toString());
+    decoded[i].decode(*columns[i], rows);
+    if (decoded[i].mayHaveNulls()) {
+      bits::andBits(passed, decoded[i].nulls(&rows), 0, numRows);
+    }
+  }
+  return decoded;
+}
+
+TupleValues::TupleValues(std::vector<std::string> fields, RowVectorPtr values)
+    : MultiColumnFilter(std::move(fields)),
+      values_(std::move(values)),
+      types_(childTypes(*values_)) {
+  std::vector<uint64_t> nonNullRows(bits::nwords(values_->size()), ~0ULL);
+  decodedValues_ = decodeAll(*values_, fields_, nonNullRows.data());
+  bits::forEachSetBit(nonNullRows.data(), 0, values_->size(), [&](auto row) {
+    hashes_.emplace_back(hashRow(decodedValues_, row), row);
+  });
+  std::sort(hashes_.begin(), hashes_.end());
+}
+
+void TupleValues::test(
+    const std::vector<VectorPtr>& columns,
+    vector_size_t numRows,
+    uint64_t* passed) const {
+  auto decoded = decode(columns, types_, numRows, passed);
+  bits::forEachSetBit(passed, 0, numRows, [&](auto row) {
+    const auto hash = hashRow(decoded, row);
+    auto it = std::lower_bound(
+        hashes_.begin(),
+        hashes_.end(),
+        std::make_pair(hash, static_cast<vector_size_t>(0)));
+    for (; it != hashes_.end() && it->first == hash; ++it) {
+      bool equal = true;
+      for (auto i = 0; i < decoded.size() && equal; ++i) {
+        equal = decodedValues_[i].base()->equalValueAt(
+            decoded[i].base(),
+            decodedValues_[i].index(it->second),
+            decoded[i].index(row));
+      }
+      if (equal) {
+        return;
+      }
+    }
+    bits::clearBit(passed, row);
+  });
+}
+
+std::string TupleValues::toString() const {
+  return fmt::format(
+      "TupleValues({}): {} tuples", folly::join(", ", fields_), hashes_.size());
+}
+
+TupleBloomFilter::TupleBloomFilter(
+    std::vector<std::string> fields,
+    const RowVectorPtr& values)
+    : MultiColumnFilter(std::move(fields)), types_(childTypes(*values)) {
+  std::vector<uint64_t> nonNullRows(bits::nwords(values->size()), ~0ULL);
+  auto decoded = decodeAll(*values, fields_, nonNullRows.data());
+  bloomFilter_.reset(values->size());
+  bits::forEachSetBit(nonNullRows.data(), 0, values->size(), [&](auto row) {
+    bloomFilter_.insert(hashRow(decoded, row));
+  });
+}
+
+void TupleBloomFilter::test(
+    const std::vector<VectorPtr>& columns,
+    vector_size_t numRows,
+    uint64_t* passed) const {
+  auto decoded = decode(columns, types_, numRows, passed);
+  bits::forEachSetBit(passed, 0, numRows, [&](auto row) {
+    if (!bloomFilter_.mayContain(hashRow(decoded, row))) {
+      bits::clearBit(passed, row);
+    }
+  });
+}
+
+std::string TupleBloomFilter::toString() const {
+  return fmt::format("TupleBloomFilter({})", folly::join(", ", fields_));
+}
+
+} // namespace facebook::velox::common
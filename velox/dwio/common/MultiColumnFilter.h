@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::common {
+
+/// Filter on the values of several children of a struct. Set on the ScanSpec
+/// of the struct and evaluated by the struct reader after the children are
+/// read. Covers conditions that do not decompose into filters on single
+/// columns, like (a, b) IN ((1, 2), (3, 4)) or a dynamic filter on a
+/// composite join key. A row with a null in any of the columns does not pass.
+class MultiColumnFilter {
+ public:
+  explicit MultiColumnFilter(std::vector<std::string> fields);
+
+  virtual ~MultiColumnFilter() = default;
+
+  /// Names of the children of the struct that are tested.
+  const std::vector<std::string>& fields() const {
+    return fields_;
+  }
+
+  /// Tests the first 'numRows' rows of 'columns', which hold the values of
+  /// fields() in the same order. Clears the bits in 'passed' of the rows that
+  /// do not pass and leaves the other bits unchanged.
+  virtual void test(
+      const std::vector<VectorPtr>& columns,
+      vector_size_t numRows,
+      uint64_t* passed) const = 0;
+
+  virtual std::string toString() const = 0;
+
+  /// Returns the hash of the values of 'row' in 'columns'. Equal tuples have
+  /// equal hashes regardless of the encodings of 'columns'.
+  static uint64_t hashRow(
+      const std::vector<DecodedVector>& columns,
+      vector_size_t row);
+
+ protected:
+  // Decodes the first 'numRows' rows of 'columns' and clears the bits in
+  // 'passed' of the rows with a null in any column. Checks that the types of
+  // 'columns' are 'types'.
+  std::vector<DecodedVector> decode(
+      const std::vector<VectorPtr>& columns,
+      const std::vector<TypePtr>& types,
+      vector_size_t numRows,
+      uint64_t* passed) const;
+
+  const std::vector<std::string> fields_;
+};
+
+/// IN-list of tuples. Passes the rows that are equal to a row of 'values'.
+class TupleValues final : public MultiColumnFilter {
+ public:
+  /// 'values' has a child per field and a row per tuple. Tuples with a null
+  /// never match.
+  TupleValues(std::vector<std::string> fields, RowVectorPtr values);
+
+  void test(
+      const std::vector<VectorPtr>& columns,
+      vector_size_t numRows,
+      uint64_t* passed) const override;
+
+  std::string toString() const override;
+
+ private:
+  const RowVectorPtr values_;
+  std::vector<TypePtr> types_;
+  std::vector<DecodedVector> decodedValues_;
+  // Hash and row of the tuples of 'values_' without nulls, sorted on hash.
+  std::vector<std::pair<uint64_t, vector_size_t>> hashes_;
+};
+
+/// Bloom filter on the hashes of tuples, e.g. the composite keys of the build
+/// side of a join. Passes the rows that are equal to a tuple added to the
+/// filter and about 2% of the others.
+class TupleBloomFilter final : public MultiColumnFilter {
+ public:
+  /// Adds the rows of 'values' that have no nulls to the filter. 'values' has
+  /// a child per field.
+  TupleBloomFilter(std::vector<std::string> fields, const RowVectorPtr& values);
+
+  void test(
+      const std::vector<VectorPtr>& columns,
+      vector_size_t numRows,
+      uint64_t* passed) const override;
+
+  std::string toString() const override;
+
+ private:
+  std::vector<TypePtr> types_;
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace facebook::velox::common
@@ -77,11 +77,17 @@ class SerDeOptions {
   bool lastColumnTakesRest;
   uint8_t escapeChar;
   bool isEscaped;
+  /// If 'isQuoted' is true, then fields may be enclosed in 'quoteChar' as in
+  /// CSV. Delimiters inside a quoted field are part of the field and a
+  /// doubled 'quoteChar' stands for one 'quoteChar'.
+  uint8_t quoteChar;
+  bool isQuoted;
 
   inline static const std::string kFieldDelim{"field.delim"};
   inline static const std::string kCollectionDelim{"collection.delim"};
   inline static const std::string kMapKeyDelim{"mapkey.delim"};
   inline static const std::string kEscapeChar{"escape.delim"};
+  inline static const std::string kQuoteChar{"quoteChar"};
 
   explicit SerDeOptions(
       uint8_t fieldDelim = '\1',
@@ -93,7 +99,9 @@ class SerDeOptions {
         nullString("\\N"),
         lastColumnTakesRest(false),
         escapeChar(escape),
-        isEscaped(isEscapedFlag) {}
+        isEscaped(isEscapedFlag),
+        quoteChar('"'),
+        isQuoted(false) {}
   ~SerDeOptions() = default;
 };
 
@@ -287,6 +295,29 @@ class RowReaderOptions {
     decodingParallelismFactor_ = factor;
   }
 
+  /// Decompresses up to about 'maxBytes' of upcoming pages of each column
+  /// chunk on 'executor' while the current page is decoded. Used by the
+  /// Parquet reader. Disabled if 'executor' is null or 'maxBytes' is 0.
+  void setPageDecompressionAhead(folly::Executor* executor, uint64_t maxBytes) {
+    pageDecompressionExecutor_ = executor;
+    maxPageDecompressionAheadBytes_ = maxBytes;
+  }
+
+  /// Decodes up to 'maxUnits' load units, i.e. stripes, of the read range
+  /// concurrently on 'executor' and returns their rows in order. More than one
+  /// unit is decoded only while the reserved memory of the query, together
+  /// with the estimated memory of the decoded units, stays below
+  /// 'memoryUsageRatio' of the query capacity. Used by the DWRF reader.
+  /// Disabled if 'executor' is null or 'maxUnits' is at most 1.
+  void setParallelUnitDecoding(
+      folly::Executor* executor,
+      uint32_t maxUnits,
+      double memoryUsageRatio) {
+    parallelUnitExecutor_ = executor;
+    maxParallelUnits_ = maxUnits;
+    parallelUnitMemoryUsageRatio_ = memoryUsageRatio;
+  }
+
   void setRowNumberColumnInfo(
       std::optional<RowNumberColumnInfo> rowNumberColumnInfo) {
     rowNumberColumnInfo_ = std::move(rowNumberColumnInfo);
@@ -365,6 +396,26 @@ class RowReaderOptions {
     return decodingParallelismFactor_;
   }
 
+  folly::Executor* pageDecompressionExecutor() const {
+    return pageDecompressionExecutor_;
+  }
+
+  uint64_t maxPageDecompressionAheadBytes() const {
+    return maxPageDecompressionAheadBytes_;
+  }
+
+  folly::Executor* parallelUnitExecutor() const {
+    return parallelUnitExecutor_;
+  }
+
+  uint32_t maxParallelUnits() const {
+    return maxParallelUnits_;
+  }
+
+  double parallelUnitMemoryUsageRatio() const {
+    return parallelUnitMemoryUsageRatio_;
+  }
+
   TimestampPrecision timestampPrecision() const {
     return timestampPrecision_;
   }
@@ -411,6 +462,11 @@ class RowReaderOptions {
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
   size_t decodingParallelismFactor_{0};
+  folly::Executor* pageDecompressionExecutor_{nullptr};
+  uint64_t maxPageDecompressionAheadBytes_{0};
+  folly::Executor* parallelUnitExecutor_{nullptr};
+  uint32_t maxParallelUnits_{1};
+  double parallelUnitMemoryUsageRatio_{0.7};
   std::optional<RowNumberColumnInfo> rowNumberColumnInfo_{std::nullopt};
   // Parameters that are provided as the physical storage properties.
   std::unordered_map<std::string, std::string> storageParameters_ = {};
@@ -499,6 +555,13 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the key of the file in the FileMetadataCache. The readers of the
+  /// formats that cache their metadata look it up there if set.
+  ReaderOptions& setFileMetadataCacheKey(std::optional<std::string> key) {
+    fileMetadataCacheKey_ = std::move(key);
+    return *this;
+  }
+
   ReaderOptions& setFileColumnNamesReadAsLowerCase(bool flag) {
     fileColumnNamesReadAsLowerCase_ = flag;
     return *this;
@@ -524,6 +587,13 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets whether to read the column chunk Bloom filters of Parquet files to
+  /// prune row groups for equality and IN-list filters.
+  ReaderOptions& setReadBloomFilters(bool readBloomFilters) {
+    readBloomFilters_ = readBloomFilters;
+    return *this;
+  }
+
   /// Gets the desired tail location.
   uint64_t tailLocation() const {
     return tailLocation_;
@@ -559,6 +629,10 @@ class ReaderOptions : public io::ReaderOptions {
     return filePreloadThreshold_;
   }
 
+  const std::optional<std::string>& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
   const std::shared_ptr<folly::Executor>& ioExecutor() const {
     return ioExecutor_;
   }
@@ -571,6 +645,10 @@ class ReaderOptions : public io::ReaderOptions {
     return adjustTimestampToTimezone_;
   }
 
+  bool readBloomFilters() const {
+    return readBloomFilters_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -619,6 +697,7 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<encryption::DecrypterFactory> decrypterFactory_;
   uint64_t footerEstimatedSize_{kDefaultFooterEstimatedSize};
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
+  std::optional<std::string> fileMetadataCacheKey_;
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
@@ -627,6 +706,7 @@ class ReaderOptions : public io::ReaderOptions {
   const tz::TimeZone* sessionTimezone_{nullptr};
   bool adjustTimestampToTimezone_{false};
   bool selectiveNimbleReaderEnabled_{false};
+  bool readBloomFilters_{false};
 };
 
 struct WriterOptions {
@@ -67,6 +67,14 @@ VectorPtr RowReader::projectColumns(
     types[i] = child->type();
     children[i] = std::move(child);
   }
+  for (const auto& filter : spec.multiColumnFilters()) {
+    std::vector<VectorPtr> columns;
+    columns.reserve(filter->fields().size());
+    for (const auto& field : filter->fields()) {
+      columns.push_back(inputRow->childAt(inputRowType.getChildIdx(field)));
+    }
+    filter->test(columns, input->size(), passed.data());
+  }
   auto rowType = ROW(std::move(names), std::move(types));
   auto size = bits::countBits(passed.data(), 0, input->size());
   if (size == 0) {
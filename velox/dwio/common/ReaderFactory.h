@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Reader.h"
 
@@ -60,6 +61,28 @@ class ReaderFactory {
       std::unique_ptr<BufferedInput>,
       const ReaderOptions& options) = 0;
 
+  /**
+   * Whether the readers of this format look up their parsed metadata in the
+   * FileMetadataCache, so that it can be prefetched with loadFileMetadata().
+   */
+  virtual bool cachesFileMetadata() const {
+    return false;
+  }
+
+  /**
+   * Read and parse the metadata of a file into the form the readers of this
+   * format cache in the FileMetadataCache.
+   * @param stream input stream
+   * @param options reader options
+   * @return file metadata
+   */
+  virtual std::unique_ptr<FileMetadata> loadFileMetadata(
+      std::unique_ptr<BufferedInput> /*input*/,
+      const ReaderOptions& /*options*/) {
+    VELOX_UNSUPPORTED(
+        "{} readers do not cache file metadata", toString(format_));
+  }
+
  private:
   const FileFormat format_;
 };
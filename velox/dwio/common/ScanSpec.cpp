@@ -53,13 +53,14 @@ bool ScanSpec::compareTimeToDropValue(
       return left->selectivity_.timeToDropValue() <
           right->selectivity_.timeToDropValue();
     }
-    // Integer filters are before other filters if there is no
-    // history data.
+    // Cheap filters on cheap columns are first if there is no history data.
     if (left->filter_ && right->filter_) {
-      if (left->filter_->kind() == right->filter_->kind()) {
+      const auto leftCost = left->estimatedFilterCost();
+      const auto rightCost = right->estimatedFilterCost();
+      if (leftCost == rightCost) {
         return left->fieldName_ < right->fieldName_;
       }
-      return left->filter_->kind() < right->filter_->kind();
+      return leftCost < rightCost;
     }
     // If hasFilter() is true but 'filter_' is nullptr, we have a filter
     // on complex type members. The simple type filter goes first.
@@ -81,6 +82,77 @@ bool ScanSpec::compareTimeToDropValue(
   return left->fieldName_ < right->fieldName_;
 }
 
+namespace {
+// Returns the cost of evaluating a filter of 'kind' on a value relative to
+// decoding an integer.
+float filterCost(FilterKind kind) {
+  switch (kind) {
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kIsNull:
+    case FilterKind::kIsNotNull:
+      return 0;
+    case FilterKind::kBoolValue:
+    case FilterKind::kBigintRange:
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kDoubleRange:
+    case FilterKind::kFloatRange:
+      return 0.5;
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kHugeintRange:
+    case FilterKind::kTimestampRange:
+      return 1;
+    case FilterKind::kHugeintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return 1.5;
+    case FilterKind::kBytesRange:
+    case FilterKind::kNegatedBytesRange:
+    case FilterKind::kBytesValues:
+    case FilterKind::kNegatedBytesValues:
+      return 2;
+    case FilterKind::kMultiRange:
+      return 3;
+  }
+  VELOX_UNREACHABLE();
+}
+} // namespace
+
+void ScanSpec::setDecodeCost(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+      decodeCost_ = 0.5;
+      break;
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      decodeCost_ = 1;
+      break;
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+      decodeCost_ = 2;
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      decodeCost_ = 4;
+      break;
+    default:
+      decodeCost_ = 8;
+      break;
+  }
+}
+
+float ScanSpec::estimatedFilterCost() const {
+  VELOX_CHECK_NOT_NULL(filter_);
+  return decodeCost_ + filterCost(filter_->kind());
+}
+
 uint64_t ScanSpec::newRead() {
   // NOTE: in case of split preload, a new split might see zero reads but
   // non-empty filter stats. Hence we need to avoid stats triggered filter
@@ -142,7 +214,7 @@ bool ScanSpec::hasFilter() const {
   if (hasFilter_.has_value()) {
     return hasFilter_.value();
   }
-  if (!isConstant() && filter()) {
+  if (!isConstant() && (filter() || !multiColumnFilters_.empty())) {
     hasFilter_ = true;
     return true;
   }
@@ -174,6 +246,10 @@ bool ScanSpec::testNull() const {
   if (filter && !filter->testNull()) {
     return false;
   }
+  // The fields of a null struct are null and fail multi-column filters.
+  if (!multiColumnFilters().empty()) {
+    return false;
+  }
   for (auto& child : children_) {
     if (!child->isArrayElementOrMapEntry_ && !child->testNull()) {
       return false;
@@ -199,7 +275,38 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
       child->filter_ = std::move(otherChild->filter_);
       child->selectivity_ = otherChild->selectivity_;
     }
+    child->isMultiColumnFilterInput_ = otherChild->isMultiColumnFilterInput_;
   }
+  multiColumnFilters_ = std::move(other.multiColumnFilters_);
+}
+
+std::shared_ptr<ScanSpec> ScanSpec::clone() const {
+  auto copy = std::make_shared<ScanSpec>(fieldName_);
+  copy->disableStatsBasedFilterReorder_ = disableStatsBasedFilterReorder_;
+  copy->subscript_ = subscript_;
+  copy->channel_ = channel_;
+  copy->constantValue_ = constantValue_;
+  copy->projectOut_ = projectOut_;
+  copy->columnType_ = columnType_;
+  copy->makeFlat_ = makeFlat_;
+  copy->runLengthEncode_ = runLengthEncode_;
+  copy->filter_ = filter_ ? filter_->clone() : nullptr;
+  copy->filterDisabled_ = filterDisabled_;
+  copy->metadataFilters_ = metadataFilters_;
+  copy->multiColumnFilters_ = multiColumnFilters_;
+  copy->isMultiColumnFilterInput_ = isMultiColumnFilterInput_;
+  copy->selectivity_ = selectivity_;
+  copy->decodeCost_ = decodeCost_;
+  copy->children_.reserve(children_.size());
+  for (const auto& child : children_) {
+    copy->children_.push_back(child->clone());
+    copy->childByFieldName_[child->fieldName_] = copy->children_.back().get();
+  }
+  copy->isArrayElementOrMapEntry_ = isArrayElementOrMapEntry_;
+  copy->maxArrayElementsCount_ = maxArrayElementsCount_;
+  copy->flatMapFeatureSelection_ = flatMapFeatureSelection_;
+  copy->isFlatMapAsStruct_ = isFlatMapAsStruct_;
+  return copy;
 }
 
 namespace {
@@ -418,6 +525,9 @@ std::string ScanSpec::toString() const {
       out << " metadata_filters(" << metadataFilters_.size() << ")";
     }
   }
+  for (auto& filter : multiColumnFilters_) {
+    out << " " << filter->toString();
+  }
   if (!children_.empty()) {
     out << " (";
     for (auto& child : children_) {
@@ -428,6 +538,22 @@ std::string ScanSpec::toString() const {
   return out.str();
 }
 
+void ScanSpec::addMultiColumnFilter(
+    std::shared_ptr<const MultiColumnFilter> filter) {
+  for (auto& field : filter->fields()) {
+    auto* child = childByName(field);
+    VELOX_CHECK_NOT_NULL(
+        child, "Field of multi-column filter not found: {}", field);
+    VELOX_CHECK(
+        child->readFromFile(),
+        "Field of multi-column filter is not read from file: {}",
+        field);
+    child->isMultiColumnFilterInput_ = true;
+  }
+  multiColumnFilters_.push_back(std::move(filter));
+  hasFilter_.reset();
+}
+
 void ScanSpec::addFilter(const Filter& filter) {
   filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
 }
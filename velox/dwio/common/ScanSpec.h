@@ -19,6 +19,7 @@
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/dwio/common/MetadataFilter.h"
 #include "velox/dwio/common/Mutation.h"
+#include "velox/dwio/common/MultiColumnFilter.h"
 #include "velox/type/Filter.h"
 #include "velox/type/Subfield.h"
 #include "velox/vector/BaseVector.h"
@@ -95,6 +96,22 @@ class ScanSpec {
     return metadataFilters_[i].second;
   }
 
+  /// Adds a filter on several children of 'this'. The children must exist.
+  /// They are read without LazyVectors and 'filter' is applied to their
+  /// values after all children are read.
+  void addMultiColumnFilter(std::shared_ptr<const MultiColumnFilter> filter);
+
+  const std::vector<std::shared_ptr<const MultiColumnFilter>>&
+  multiColumnFilters() const {
+    static const std::vector<std::shared_ptr<const MultiColumnFilter>> kEmpty;
+    return filterDisabled_ ? kEmpty : multiColumnFilters_;
+  }
+
+  /// True if 'this' is a field of a multi-column filter of the parent.
+  bool isMultiColumnFilterInput() const {
+    return isMultiColumnFilterInput_;
+  }
+
   // Returns a constant vector if 'this' corresponds to a partitioning
   // column or to a missing column. These change from split to split.
   VectorPtr constantValue() const {
@@ -251,6 +268,16 @@ class ScanSpec {
     makeFlat_ = makeFlat;
   }
 
+  /// True if scalar values of this field that come in long runs, e.g. of a
+  /// sorted column, are returned as a dictionary over one value per run.
+  bool runLengthEncode() const {
+    return runLengthEncode_;
+  }
+
+  void setRunLengthEncode(bool runLengthEncode) {
+    runLengthEncode_ = runLengthEncode;
+  }
+
   // True if this or a descendant has a filter that will affect the number of
   // output rows.  Note that filter on map keys and array indices is not
   // counted, as they do not change the number of container output rows.
@@ -293,6 +320,12 @@ class ScanSpec {
   // the ScanSpec tree itself.
   void moveAdaptationFrom(ScanSpec& other);
 
+  // Returns a deep copy of 'this' with its filters, constants and adaptive
+  // filter order. Value hooks and delta updates are not copied since they are
+  // set per read. Used for reading several stripes of a split concurrently,
+  // each with its own ScanSpec tree.
+  std::shared_ptr<ScanSpec> clone() const;
+
   std::string toString() const;
 
   // Add a field to this ScanSpec, with content projected out.
@@ -370,6 +403,16 @@ class ScanSpec {
     isFlatMapAsStruct_ = value;
   }
 
+  /// Sets the estimated cost of decoding a value of 'type' relative to an
+  /// integer. The filters are ordered on their decode and evaluation costs
+  /// until their selectivity is measured, or always if stats based reordering
+  /// is disabled.
+  void setDecodeCost(const Type& type);
+
+  float decodeCost() const {
+    return decodeCost_;
+  }
+
   /// Disable stats based filter reordering.
   void disableStatsBasedFilterReorder() {
     disableStatsBasedFilterReorder_ = true;
@@ -391,6 +434,10 @@ class ScanSpec {
       const std::shared_ptr<ScanSpec>& x,
       const std::shared_ptr<ScanSpec>& y);
 
+  // Returns the estimated cost per row of reading and filtering 'this', for
+  // ordering filters without measured selectivity.
+  float estimatedFilterCost() const;
+
   bool disableStatsBasedFilterReorder_{false};
 
   // Serializes stableChildren().
@@ -422,6 +469,7 @@ class ScanSpec {
   // True if a string dictionary or flat map in this field should be
   // returned as flat.
   bool makeFlat_ = false;
+  bool runLengthEncode_ = false;
   std::unique_ptr<common::Filter> filter_;
   bool filterDisabled_ = false;
   dwio::common::DeltaColumnUpdater* deltaUpdate_ = nullptr;
@@ -434,7 +482,13 @@ class ScanSpec {
   std::vector<std::pair<const MetadataFilter::LeafNode*, common::Filter*>>
       metadataFilters_;
 
+  // Filters on several children of 'this'. Immutable and shared between
+  // clones.
+  std::vector<std::shared_ptr<const MultiColumnFilter>> multiColumnFilters_;
+  bool isMultiColumnFilterInput_ = false;
+
   SelectivityInfo selectivity_;
+  float decodeCost_{1};
 
   std::vector<std::shared_ptr<ScanSpec>> children_;
   // Read-only copy of children, not subject to reordering. Used when
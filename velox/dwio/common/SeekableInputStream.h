@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/PositionProvider.h"
@@ -49,6 +51,22 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
   }
 
   void readFully(char* buffer, size_t bufferSize);
+
+  // Reads up to 'size' bytes that would be returned by the next calls to
+  // Next() directly into 'buffer', e.g. by decompressing into 'buffer' instead
+  // of into a buffer of the stream. Returns the number of bytes read, possibly
+  // 0. The bytes after these are returned by Next().
+  virtual int64_t readDirect(char* /*buffer*/, int64_t /*size*/) {
+    return 0;
+  }
+
+  // For a stream that decompresses a stream of compression blocks, returns
+  // the offset in the compressed stream of the block of the bytes returned
+  // by the last Next() and the number of bytes returned before the block.
+  // std::nullopt for other streams.
+  virtual std::optional<std::pair<uint64_t, uint64_t>> lastBlockStart() const {
+    return std::nullopt;
+  }
 };
 
 /**
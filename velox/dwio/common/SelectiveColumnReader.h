@@ -455,6 +455,7 @@ class SelectiveColumnReader {
 
   static constexpr int8_t kNoValueSize = -1;
   static constexpr uint32_t kRowGroupNotSet = ~0;
+  static constexpr int32_t kMinAverageRunLength = 16;
 
   template <typename T>
   void ensureValuesCapacity(vector_size_t numRows);
@@ -562,6 +563,12 @@ class SelectiveColumnReader {
       const TypePtr& type,
       bool isFinal = false);
 
+  // Replaces the flat 'result' with a dictionary over one value per run of
+  // equal values if the runs are on average at least kMinAverageRunLength
+  // long.
+  template <typename T>
+  void encodeRuns(VectorPtr& result);
+
   template <typename T, typename TVector>
   void compactScalarValues(const RowSet& rows, bool isFinal);
 
@@ -147,7 +147,59 @@ void SelectiveColumnReader::getFlatValues(
         numValues_,
         values_,
         std::move(stringBuffers_));
+    if (scanSpec_->runLengthEncode()) {
+      encodeRuns<TVector>(*result);
+    }
+  }
+}
+
+template <typename T>
+void SelectiveColumnReader::encodeRuns(VectorPtr& result) {
+  const auto* flat = result->asUnchecked<FlatVector<T>>();
+  const auto size = flat->size();
+  const auto* values = flat->rawValues();
+  const auto* nulls = flat->rawNulls();
+  if (size == 0 || values == nullptr) {
+    return;
+  }
+  auto sameAsPrevious = [&](vector_size_t i) {
+    if (nulls &&
+        (bits::isBitNull(nulls, i) || bits::isBitNull(nulls, i - 1))) {
+      return bits::isBitNull(nulls, i) && bits::isBitNull(nulls, i - 1);
+    }
+    return values[i] == values[i - 1];
+  };
+  vector_size_t numRuns = 1;
+  for (vector_size_t i = 1; i < size; ++i) {
+    numRuns += !sameAsPrevious(i);
+  }
+  if (static_cast<int64_t>(numRuns) * kMinAverageRunLength > size) {
+    return;
+  }
+  auto runValues =
+      BaseVector::create<FlatVector<T>>(result->type(), numRuns, memoryPool_);
+  auto* rawRunValues = runValues->mutableRawValues();
+  auto lengths = AlignedBuffer::allocate<vector_size_t>(numRuns, memoryPool_);
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  vector_size_t run = 0;
+  vector_size_t runStart = 0;
+  for (vector_size_t i = 1; i <= size; ++i) {
+    if (i < size && sameAsPrevious(i)) {
+      continue;
+    }
+    if (nulls && bits::isBitNull(nulls, runStart)) {
+      runValues->setNull(run, true);
+    } else {
+      rawRunValues[run] = values[runStart];
+    }
+    rawLengths[run++] = i - runStart;
+    runStart = i;
+  }
+  if constexpr (std::is_same_v<T, StringView>) {
+    runValues->setStringBuffers(flat->stringBuffers());
   }
+  result = BaseVector::wrapInSequence(
+      std::move(lengths), size, std::move(runValues));
 }
 
 template <>
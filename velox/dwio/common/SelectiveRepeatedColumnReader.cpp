@@ -182,8 +182,10 @@ SelectiveListColumnReader::SelectiveListColumnReader(
     const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
     FormatParams& params,
     velox::common::ScanSpec& scanSpec)
-    : SelectiveRepeatedColumnReader(requestedType, params, scanSpec, fileType) {
-}
+    : SelectiveRepeatedColumnReader(requestedType, params, scanSpec, fileType),
+      lengthsOnly_(
+          scanSpec.children().size() == 1 &&
+          scanSpec.children()[0]->isConstant()) {}
 
 uint64_t SelectiveListColumnReader::skip(uint64_t numValues) {
   numValues = formatData_->skipNulls(numValues);
@@ -217,7 +219,7 @@ void SelectiveListColumnReader::read(
   prepareRead<char>(offset, rows, incomingNulls);
   auto activeRows = applyFilter(rows);
   makeNestedRowSet(activeRows, rows.back());
-  if (child_ && !nestedRows_.empty()) {
+  if (child_ && !lengthsOnly_ && !nestedRows_.empty()) {
     child_->read(child_->readOffset(), nestedRows_, nullptr);
   }
   numValues_ = activeRows.size();
@@ -232,6 +234,11 @@ void SelectiveListColumnReader::getValues(
   auto* resultArray = result->get()->asUnchecked<ArrayVector>();
   makeOffsetsAndSizes(rows, *resultArray);
   setComplexNulls(rows, *result);
+  if (lengthsOnly_) {
+    resultArray->setElements(BaseVector::wrapInConstant(
+        nestedRows_.size(), 0, scanSpec_->children()[0]->constantValue()));
+    return;
+  }
   if (child_ && !nestedRows_.empty()) {
     auto& elements = resultArray->elements();
     prepareStructResult(requestedType_->childAt(0), &elements);
@@ -124,7 +124,19 @@ class SelectiveListColumnReader : public SelectiveRepeatedColumnReader {
   void getValues(const RowSet& rows, VectorPtr* result) override;
 
  protected:
+  /// Returns true if the elements are not read because the scan spec of the
+  /// elements is a constant, e.g. when only the sizes and nulls of the lists
+  /// are used. 'child_' is then only positioned past the elements, and a file
+  /// format may build it over a subset of the element columns that has the
+  /// structure of the list.
+  bool lengthsOnly() const {
+    return lengthsOnly_;
+  }
+
   std::unique_ptr<SelectiveColumnReader> child_;
+
+ private:
+  const bool lengthsOnly_;
 };
 
 class SelectiveMapColumnReader : public SelectiveRepeatedColumnReader {
@@ -385,7 +385,7 @@ void SelectiveStructColumnReaderBase::read(
     const auto fieldIndex = childSpec->subscript();
     auto* reader = children_.at(fieldIndex);
     if (reader->isTopLevel() && childSpec->projectOut() &&
-        !childSpec->hasFilter()) {
+        !childSpec->hasFilter() && !childSpec->isMultiColumnFilterInput()) {
       // Will make a LazyVector.
       continue;
     }
@@ -412,6 +412,10 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!activeRows.empty() && !scanSpec_->multiColumnFilters().empty()) {
+    activeRows = applyMultiColumnFilters(activeRows);
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -423,6 +427,42 @@ void SelectiveStructColumnReaderBase::read(
   readOffset_ = offset + rows.back() + 1;
 }
 
+RowSet SelectiveStructColumnReaderBase::applyMultiColumnFilters(
+    const RowSet& rows) {
+  std::vector<uint64_t> passed(bits::nwords(rows.size()), ~0ULL);
+  for (const auto& filter : scanSpec_->multiColumnFilters()) {
+    std::vector<VectorPtr> columns;
+    columns.reserve(filter->fields().size());
+    for (const auto& field : filter->fields()) {
+      const auto* childSpec = scanSpec_->childByName(field);
+      if (childSpec->isConstant()) {
+        columns.push_back(BaseVector::wrapInConstant(
+            rows.size(), 0, childSpec->constantValue()));
+        continue;
+      }
+      if (isChildConstant(*childSpec)) {
+        // A missing column is all null and no row passes.
+        multiColumnFilterRows_.clear();
+        return multiColumnFilterRows_;
+      }
+      // The child was read for a superset of 'rows' and can be read again
+      // for the rows passing the filter.
+      auto* reader = children_.at(childSpec->subscript());
+      auto& column = columns.emplace_back(
+          BaseVector::create(reader->requestedType(), 0, memoryPool_));
+      reader->getValues(rows, &column);
+    }
+    filter->test(columns, rows.size(), passed.data());
+  }
+  multiColumnFilterRows_.resize(rows.size());
+  vector_size_t numPassed = 0;
+  bits::forEachSetBit(passed.data(), 0, rows.size(), [&](auto i) {
+    multiColumnFilterRows_[numPassed++] = rows[i];
+  });
+  multiColumnFilterRows_.resize(numPassed);
+  return multiColumnFilterRows_;
+}
+
 void SelectiveStructColumnReaderBase::recordParentNullsInChildren(
     int64_t offset,
     const RowSet& rows) {
@@ -543,7 +583,8 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
 
-    if (childSpec->hasFilter() || !children_[index]->isTopLevel()) {
+    if (childSpec->hasFilter() || childSpec->isMultiColumnFilterInput() ||
+        !children_[index]->isTopLevel()) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
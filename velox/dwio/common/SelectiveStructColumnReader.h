@@ -59,6 +59,19 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
       SelectiveColumnReader* reader,
       int64_t offset) = 0;
 
+  /// Like advanceFieldReader() for reading rows of 'reader' from 'offset'
+  /// where the rows before 'offset + firstRow' are not read. Formats with an
+  /// index of row groups seek to the row group of 'offset + firstRow' instead
+  /// of the one of 'offset'. Returns the number of rows the read offset of
+  /// 'reader' is past 'offset'. The rows to read must be rebased by as much.
+  virtual int64_t advanceFieldReaderToRow(
+      SelectiveColumnReader* reader,
+      int64_t offset,
+      vector_size_t /*firstRow*/) {
+    advanceFieldReader(reader, offset);
+    return 0;
+  }
+
   // Returns the nulls bitmap from reading this. Used in LazyVector loaders.
   const uint64_t* nulls() const {
     return nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
@@ -141,6 +154,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
  private:
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  // Applies the multi-column filters of 'scanSpec_' to 'rows' after the
+  // children are read and returns the passing rows.
+  RowSet applyMultiColumnFilters(const RowSet& rows);
+
   /// Records the number of nulls added by 'this' between the end position of
   /// each child reader and the end of the range of 'read(). This must be done
   /// also if a child is not read so that we know how much to skip when seeking
@@ -167,6 +184,9 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Dense set of rows to read in next().
   raw_vector<vector_size_t> rows_;
 
+  // Rows passing the multi-column filters in the last read().
+  raw_vector<vector_size_t> multiColumnFilterRows_;
+
   // Sequence number of output batch. Checked against ColumnLoaders
   // created by 'this' to verify they are still valid at load.
   uint64_t numReads_ = 0;
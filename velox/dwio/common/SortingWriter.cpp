@@ -22,13 +22,15 @@ SortingWriter::SortingWriter(
     std::unique_ptr<exec::SortBuffer> sortBuffer,
     vector_size_t maxOutputRowsConfig,
     uint64_t maxOutputBytesConfig,
-    uint64_t outputTimeSliceLimitMs)
+    uint64_t outputTimeSliceLimitMs,
+    std::unique_ptr<ZOrderEncoder> zOrderEncoder)
     : outputWriter_(std::move(writer)),
       maxOutputRowsConfig_(maxOutputRowsConfig),
       maxOutputBytesConfig_(maxOutputBytesConfig),
       finishTimeSliceLimitMs_(outputTimeSliceLimitMs),
       sortPool_(sortBuffer->pool()),
       canReclaim_(sortBuffer->canSpill()),
+      zOrderEncoder_(std::move(zOrderEncoder)),
       sortBuffer_(std::move(sortBuffer)) {
   VELOX_CHECK_GT(maxOutputRowsConfig_, 0);
   VELOX_CHECK_GT(maxOutputBytesConfig_, 0);
@@ -44,6 +46,12 @@ SortingWriter::~SortingWriter() {
 
 void SortingWriter::write(const VectorPtr& data) {
   checkRunning();
+  if (zOrderEncoder_ != nullptr) {
+    auto input = std::dynamic_pointer_cast<RowVector>(data);
+    VELOX_CHECK_NOT_NULL(input, "Z-order clustering expects a RowVector");
+    sortBuffer_->addInput(zOrderEncoder_->appendZValues(input, sortPool_));
+    return;
+  }
   sortBuffer_->addInput(data);
 }
 
@@ -77,7 +85,9 @@ bool SortingWriter::finish() {
     }
     output = sortBuffer_->getOutput(maxOutputBatchRows);
     if (output != nullptr) {
-      outputWriter_->write(output);
+      outputWriter_->write(
+          zOrderEncoder_ != nullptr ? zOrderEncoder_->removeZValues(output)
+                                    : output);
     }
   } while (output != nullptr);
 
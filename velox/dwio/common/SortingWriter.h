@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/Writer.h"
+#include "velox/dwio/common/ZOrderEncoder.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/SortBuffer.h"
 
@@ -25,12 +26,17 @@ namespace facebook::velox::dwio::common {
 /// Sorting Writer object is used to write sorted data into a single file.
 class SortingWriter : public Writer {
  public:
+  /// If 'zOrderEncoder' is set, the rows are clustered in Z-order instead of
+  /// sorted lexicographically. 'sortBuffer' then takes the outputType() of
+  /// 'zOrderEncoder' and sorts by its Z-value column, which is removed before
+  /// the rows are written.
   SortingWriter(
       std::unique_ptr<Writer> writer,
       std::unique_ptr<exec::SortBuffer> sortBuffer,
       vector_size_t maxOutputRowsConfig,
       uint64_t maxOutputBytesConfig,
-      uint64_t outputTimeSliceLimitMs);
+      uint64_t outputTimeSliceLimitMs,
+      std::unique_ptr<ZOrderEncoder> zOrderEncoder = nullptr);
 
   ~SortingWriter() override;
 
@@ -84,6 +90,7 @@ class SortingWriter : public Writer {
   const uint64_t finishTimeSliceLimitMs_;
   memory::MemoryPool* const sortPool_;
   const bool canReclaim_;
+  const std::unique_ptr<ZOrderEncoder> zOrderEncoder_;
 
   std::unique_ptr<exec::SortBuffer> sortBuffer_;
 };
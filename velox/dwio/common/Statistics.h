@@ -536,6 +536,10 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of string dictionaries that were the same as the dictionary of the
+  // previous stripe and shared its values and filter results.
+  int64_t reusedStringDictionaries{0};
 };
 
 struct RuntimeStatistics {
@@ -554,6 +558,14 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Number of rows skipped inside row groups based on page statistics.
+  int64_t skippedPageRows{0};
+
+  // Number of strides (row groups) and rows in them skipped based on Bloom
+  // filters. The strides are also counted in 'skippedStrides'.
+  int64_t bloomFilterSkippedStrides{0};
+  int64_t bloomFilterSkippedRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -579,6 +591,18 @@ struct RuntimeStatistics {
     if (processedStrides > 0) {
       result.emplace("processedStrides", RuntimeCounter(processedStrides));
     }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
+    if (bloomFilterSkippedStrides > 0) {
+      result.emplace(
+          "bloomFilterSkippedStrides",
+          RuntimeCounter(bloomFilterSkippedStrides));
+    }
+    if (bloomFilterSkippedRows > 0) {
+      result.emplace(
+          "bloomFilterSkippedRows", RuntimeCounter(bloomFilterSkippedRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
@@ -592,6 +616,11 @@ struct RuntimeStatistics {
           "flattenStringDictionaryValues",
           RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues));
     }
+    if (columnReaderStatistics.reusedStringDictionaries > 0) {
+      result.emplace(
+          "reusedStringDictionaries",
+          RuntimeCounter(columnReaderStatistics.reusedStringDictionaries));
+    }
     return result;
   }
 };
@@ -61,6 +61,16 @@ inline void readBytes(
     if (!bytesNeeded) {
       break;
     }
+    // The buffer is used up, so the stream is positioned at the next byte.
+    const auto bytesDirect =
+        input->readDirect(&bytesAsChars[bytesRead], bytesNeeded);
+    if (bytesDirect) {
+      bytesNeeded -= bytesDirect;
+      bytesRead += bytesDirect;
+      if (!bytesNeeded) {
+        break;
+      }
+    }
     int32_t size;
     const void* bufferPointer;
     if (!input->Next(&bufferPointer, &size)) {
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ZOrderEncoder.h"
+
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+using exec::prefixsort::PrefixSortEncoder;
+
+// Writes the null byte and 'size' value bytes of each row of 'decoded' at
+// 'offset' of the normalized rows. 'T' is the Velox value type and
+// 'EncodedT' the type it is normalized as.
+template <typename T, typename EncodedT = T>
+void encodeKey(
+    const DecodedVector& decoded,
+    const PrefixSortEncoder& encoder,
+    uint32_t offset,
+    uint32_t size,
+    uint32_t rowSize,
+    vector_size_t numRows,
+    char* normalized) {
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    char* dest = normalized + static_cast<size_t>(row) * rowSize + offset;
+    if (decoded.isNullAt(row)) {
+      encoder.encode<EncodedT>(std::nullopt, dest, size + 1, true);
+    } else if constexpr (std::is_same_v<T, StringView>) {
+      dest[0] = encoder.isNullsFirst() ? 1 : 0;
+      encoder.encodeContiguousNoNulls(
+          decoded.valueAt<StringView>(row), dest + 1, size);
+    } else {
+      encoder.encode<EncodedT>(
+          static_cast<EncodedT>(decoded.valueAt<T>(row)), dest, size + 1, true);
+    }
+  }
+}
+
+} // namespace
+
+// static
+bool ZOrderEncoder::isSupported(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+ZOrderEncoder::ZOrderEncoder(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<CompareFlags>& keyCompareFlags,
+    uint32_t maxStringPrefixLength)
+    : inputType_(inputType), maxStringPrefixLength_(maxStringPrefixLength) {
+  VELOX_CHECK(!keyChannels.empty(), "Z-order needs at least one key");
+  VELOX_CHECK_EQ(keyChannels.size(), keyCompareFlags.size());
+  VELOX_CHECK_GT(maxStringPrefixLength_, 0);
+  VELOX_CHECK(
+      !inputType_->containsChild(kZValueColumnName),
+      "Input already has a {} column",
+      kZValueColumnName);
+
+  uint32_t maxValueBits = 0;
+  for (auto i = 0; i < keyChannels.size(); ++i) {
+    const auto& type = inputType_->childAt(keyChannels[i]);
+    VELOX_CHECK(
+        isSupported(type),
+        "Unsupported Z-order key type: {}",
+        type->toString());
+    Key key;
+    key.channel = keyChannels[i];
+    key.kind = type->kind();
+    key.ascending = keyCompareFlags[i].ascending;
+    key.nullsFirst = keyCompareFlags[i].nullsFirst;
+    key.offset = normalizedRowSize_;
+    if (key.kind == TypeKind::TINYINT) {
+      key.size = sizeof(int16_t);
+    } else {
+      key.size = PrefixSortEncoder::encodedSize(
+                     key.kind, maxStringPrefixLength_, false)
+                     .value();
+    }
+    normalizedRowSize_ += 1 + key.size;
+    maxValueBits = std::max<uint32_t>(maxValueBits, key.size * 8);
+    keys_.push_back(key);
+  }
+
+  // The null bits come first, so the rows with nulls are clustered apart.
+  // The null byte is 0 or 1.
+  for (const auto& key : keys_) {
+    bitSources_.push_back(key.offset * 8 + 7);
+  }
+  // The value bits are taken round robin with the least significant bits of
+  // all keys aligned: small values of a wide type have their high bits in
+  // common and should not make the narrower keys less significant.
+  for (uint32_t bit = 0; bit < maxValueBits; ++bit) {
+    for (const auto& key : keys_) {
+      const auto firstBit = maxValueBits - key.size * 8;
+      if (bit >= firstBit) {
+        bitSources_.push_back((key.offset + 1) * 8 + bit - firstBit);
+      }
+    }
+  }
+  zValueSize_ = bits::nbytes(bitSources_.size());
+
+  auto names = inputType_->names();
+  auto types = inputType_->children();
+  names.push_back(kZValueColumnName);
+  types.push_back(VARBINARY());
+  outputType_ = ROW(std::move(names), std::move(types));
+}
+
+void ZOrderEncoder::normalizeKeys(const RowVector& input, char* normalized)
+    const {
+  const auto numRows = input.size();
+  DecodedVector decoded;
+  for (const auto& key : keys_) {
+    decoded.decode(*input.childAt(key.channel));
+    const PrefixSortEncoder encoder(key.ascending, key.nullsFirst);
+    const auto encode = [&](auto* type) {
+      using T = std::remove_pointer_t<decltype(type)>;
+      encodeKey<T>(
+          decoded,
+          encoder,
+          key.offset,
+          key.size,
+          normalizedRowSize_,
+          numRows,
+          normalized);
+    };
+    switch (key.kind) {
+      case TypeKind::TINYINT:
+        encodeKey<int8_t, int16_t>(
+            decoded,
+            encoder,
+            key.offset,
+            key.size,
+            normalizedRowSize_,
+            numRows,
+            normalized);
+        break;
+      case TypeKind::SMALLINT:
+        encode(static_cast<int16_t*>(nullptr));
+        break;
+      case TypeKind::INTEGER:
+        encode(static_cast<int32_t*>(nullptr));
+        break;
+      case TypeKind::BIGINT:
+        encode(static_cast<int64_t*>(nullptr));
+        break;
+      case TypeKind::HUGEINT:
+        encode(static_cast<int128_t*>(nullptr));
+        break;
+      case TypeKind::REAL:
+        encode(static_cast<float*>(nullptr));
+        break;
+      case TypeKind::DOUBLE:
+        encode(static_cast<double*>(nullptr));
+        break;
+      case TypeKind::TIMESTAMP:
+        encode(static_cast<Timestamp*>(nullptr));
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        encode(static_cast<StringView*>(nullptr));
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+RowVectorPtr ZOrderEncoder::appendZValues(
+    const RowVectorPtr& input,
+    memory::MemoryPool* pool) const {
+  const auto numRows = input->size();
+  std::vector<char> normalized(
+      static_cast<size_t>(numRows) * normalizedRowSize_);
+  normalizeKeys(*input, normalized.data());
+
+  auto zValues =
+      BaseVector::create<FlatVector<StringView>>(VARBINARY(), numRows, pool);
+  char* rawZValues = zValues->getRawStringBufferWithSpace(
+      static_cast<size_t>(numRows) * zValueSize_, true);
+  std::memset(rawZValues, 0, static_cast<size_t>(numRows) * zValueSize_);
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    const auto* source = reinterpret_cast<const uint8_t*>(
+        normalized.data() + static_cast<size_t>(row) * normalizedRowSize_);
+    char* zValue = rawZValues + static_cast<size_t>(row) * zValueSize_;
+    for (uint32_t bit = 0; bit < bitSources_.size(); ++bit) {
+      const auto sourceBit = bitSources_[bit];
+      if (source[sourceBit / 8] & (0x80 >> (sourceBit % 8))) {
+        zValue[bit / 8] |= 0x80 >> (bit % 8);
+      }
+    }
+    zValues->setNoCopy(row, StringView(zValue, zValueSize_));
+  }
+
+  auto children = input->children();
+  children.push_back(std::move(zValues));
+  return std::make_shared<RowVector>(
+      pool, outputType_, nullptr, numRows, std::move(children));
+}
+
+RowVectorPtr ZOrderEncoder::removeZValues(const RowVectorPtr& input) const {
+  VELOX_CHECK_EQ(input->childrenSize(), outputType_->size());
+  auto children = input->children();
+  children.pop_back();
+  return std::make_shared<RowVector>(
+      input->pool(), inputType_, nullptr, input->size(), std::move(children));
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/type/Type.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Computes the Z-order (Morton) value of several clustering columns. Each
+/// key is normalized into a fixed width byte string with
+/// exec::prefixsort::PrefixSortEncoder, whose memcmp order is the value order,
+/// and the bits of the normalized keys are interleaved with their least
+/// significant bits aligned. Sorting rows by the Z-value clusters them on all
+/// keys at once, so the stripes and row groups written in this order have
+/// tight min/max ranges on every key rather than on the first one only.
+///
+/// Nulls take one bit per key, ahead of all value bits. Strings are clustered
+/// on their first 'maxStringPrefixLength' bytes.
+class ZOrderEncoder {
+ public:
+  /// The name of the VARBINARY Z-value column added by appendZValues().
+  static constexpr const char* kZValueColumnName = "$z_value";
+
+  /// Returns true if columns of 'type' can be clustered.
+  static bool isSupported(const TypePtr& type);
+
+  /// 'keyChannels' are the clustering columns of 'inputType' with their sort
+  /// orders in 'keyCompareFlags'. Descending keys are clustered on the
+  /// inverted values.
+  ZOrderEncoder(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<CompareFlags>& keyCompareFlags,
+      uint32_t maxStringPrefixLength);
+
+  /// The type of the outputs of appendZValues(): 'inputType' followed by the
+  /// Z-value column.
+  const RowTypePtr& outputType() const {
+    return outputType_;
+  }
+
+  /// Size in bytes of each Z-value.
+  uint32_t zValueSize() const {
+    return zValueSize_;
+  }
+
+  /// Returns the columns of 'input' followed by the Z-value of each row.
+  RowVectorPtr appendZValues(
+      const RowVectorPtr& input,
+      memory::MemoryPool* pool) const;
+
+  /// Returns 'input' without the Z-value column added by appendZValues().
+  RowVectorPtr removeZValues(const RowVectorPtr& input) const;
+
+ private:
+  struct Key {
+    column_index_t channel;
+    TypeKind kind;
+    bool ascending;
+    bool nullsFirst;
+    // Offset of the null byte in the normalized row.
+    uint32_t offset;
+    // Bytes of the normalized value after the null byte.
+    uint32_t size;
+  };
+
+  // Writes the normalized keys of the rows of 'input' into 'normalized',
+  // 'normalizedRowSize_' bytes per row.
+  void normalizeKeys(const RowVector& input, char* normalized) const;
+
+  const RowTypePtr inputType_;
+  const uint32_t maxStringPrefixLength_;
+  std::vector<Key> keys_;
+  uint32_t normalizedRowSize_{0};
+  uint32_t zValueSize_{0};
+  // Bit position in the normalized row of each bit of the Z-value, most
+  // significant bits first. The positions are counted from the most
+  // significant bit of the first byte.
+  std::vector<uint32_t> bitSources_;
+  RowTypePtr outputType_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -15,10 +15,13 @@
  */
 
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 #include <lz4.h>
 #include <snappy.h>
@@ -610,8 +613,128 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+// Decompresses the blocks of at least accelerator_->minInputBytes() with
+// 'accelerator_' and the other blocks and the blocks the accelerator fails on
+// with 'decompressor_'.
+class OffloadingDecompressor : public Decompressor {
+ public:
+  OffloadingDecompressor(
+      std::unique_ptr<Decompressor> decompressor,
+      std::shared_ptr<DecompressionAccelerator> accelerator,
+      CompressionKind kind,
+      const CompressionOptions& options,
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo},
+        decompressor_{std::move(decompressor)},
+        accelerator_{std::move(accelerator)},
+        kind_{kind},
+        options_{options} {}
+
+  std::pair<int64_t, bool> getDecompressedLength(
+      const char* src,
+      uint64_t srcLength) const override {
+    return decompressor_->getDecompressedLength(src, srcLength);
+  }
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    std::vector<Block> blocks{{src, srcLength, dest, destLength}};
+    decompressBatch(blocks);
+    return blocks[0].decompressedLength;
+  }
+
+  void decompressBatch(std::vector<Block>& blocks) override;
+
+ private:
+  const std::unique_ptr<Decompressor> decompressor_;
+  const std::shared_ptr<DecompressionAccelerator> accelerator_;
+  const CompressionKind kind_;
+  const CompressionOptions options_;
+};
+
+void OffloadingDecompressor::decompressBatch(std::vector<Block>& blocks) {
+  std::vector<Block> offloaded;
+  std::vector<int32_t> offloadedIndices;
+  for (auto i = 0; i < blocks.size(); ++i) {
+    if (blocks[i].srcLength >= accelerator_->minInputBytes()) {
+      offloaded.push_back(blocks[i]);
+      offloadedIndices.push_back(i);
+    }
+  }
+  auto future = folly::makeSemiFuture(std::vector<folly::Try<uint64_t>>{});
+  if (!offloaded.empty()) {
+    try {
+      future = accelerator_->decompress(kind_, options_, offloaded);
+    } catch (const std::exception& e) {
+      LOG_EVERY_N(WARNING, 1000)
+          << "Failed to submit decompression: " << e.what();
+    }
+  }
+
+  // The small blocks are decompressed while the device works on the others.
+  for (auto i = 0, next = 0; i < blocks.size(); ++i) {
+    if (next < offloadedIndices.size() && offloadedIndices[next] == i) {
+      ++next;
+      continue;
+    }
+    auto& block = blocks[i];
+    block.decompressedLength = decompressor_->decompress(
+        block.src, block.srcLength, block.dest, block.destLength);
+  }
+  if (offloaded.empty()) {
+    return;
+  }
+
+  std::vector<folly::Try<uint64_t>> results;
+  try {
+    results = std::move(future).get();
+  } catch (const std::exception& e) {
+    LOG_EVERY_N(WARNING, 1000) << "Failed to decompress: " << e.what();
+  }
+  uint64_t offloadedBytes{0};
+  for (auto i = 0; i < offloadedIndices.size(); ++i) {
+    auto& block = blocks[offloadedIndices[i]];
+    if (i < results.size() && results[i].hasValue()) {
+      DWIO_ENSURE_LE(
+          results[i].value(),
+          block.destLength,
+          "Bad offloaded decompression. Info: ",
+          streamDebugInfo_);
+      block.decompressedLength = results[i].value();
+      offloadedBytes += block.srcLength;
+      continue;
+    }
+    RECORD_METRIC_VALUE(kMetricDecompressionOffloadFallbackCount);
+    block.decompressedLength = decompressor_->decompress(
+        block.src, block.srcLength, block.dest, block.destLength);
+  }
+  if (offloadedBytes > 0) {
+    RECORD_METRIC_VALUE(kMetricDecompressionOffloadedBytes, offloadedBytes);
+  }
+}
+
+folly::Synchronized<std::shared_ptr<DecompressionAccelerator>>&
+registeredAccelerator() {
+  static folly::Synchronized<std::shared_ptr<DecompressionAccelerator>>
+      accelerator;
+  return accelerator;
+}
+
 } // namespace
 
+void registerDecompressionAccelerator(
+    std::shared_ptr<DecompressionAccelerator> accelerator) {
+  *registeredAccelerator().wlock() = std::move(accelerator);
+}
+
+std::shared_ptr<DecompressionAccelerator> decompressionAccelerator() {
+  return *registeredAccelerator().rlock();
+}
+
 std::unique_ptr<Compressor> createCompressor(
     CompressionKind kind,
     const CompressionOptions& options) {
@@ -652,6 +775,10 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const Decrypter* decrypter,
     bool useRawDecompression,
     size_t compressedLength) {
+  auto accelerator = decompressionAccelerator();
+  if (accelerator != nullptr && !accelerator->supports(kind, options)) {
+    accelerator = nullptr;
+  }
   std::unique_ptr<Decompressor> decompressor;
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
@@ -661,9 +788,9 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       // decompressor remain as nullptr
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
+      if (!decrypter && !accelerator) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
-        // copying data
+        // copying data. Offloading needs whole blocks.
         return std::make_unique<ZlibDecompressionStream>(
             std::move(input),
             blockSize,
@@ -678,9 +805,9 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
           blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
       break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
+      if (!decrypter && !accelerator) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
-        // copying data
+        // copying data. Offloading needs whole blocks.
         return std::make_unique<ZlibDecompressionStream>(
             std::move(input),
             blockSize,
@@ -717,6 +844,15 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     default:
       DWIO_RAISE("Unknown compression codec ", kind);
   }
+  if (decompressor && accelerator) {
+    decompressor = std::make_unique<OffloadingDecompressor>(
+        std::move(decompressor),
+        std::move(accelerator),
+        kind,
+        options,
+        blockSize,
+        streamDebugInfo);
+  }
   return std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/futures/Future.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/encryption/Encryption.h"
@@ -43,6 +45,16 @@ class Compressor {
 
 class Decompressor {
  public:
+  /// A compressed block for decompressBatch().
+  struct Block {
+    const char* src;
+    uint64_t srcLength;
+    char* dest;
+    uint64_t destLength;
+    /// Set by decompressBatch().
+    uint64_t decompressedLength{0};
+  };
+
   explicit Decompressor(uint64_t blockSize, const std::string& streamDebugInfo)
       : blockSize_{static_cast<int64_t>(blockSize)},
         streamDebugInfo_{streamDebugInfo} {}
@@ -60,6 +72,15 @@ class Decompressor {
       char* dest,
       uint64_t destLength) = 0;
 
+  /// Decompresses 'blocks' and sets their 'decompressedLength'. A decompressor
+  /// that offloads to a DecompressionAccelerator submits the blocks together.
+  virtual void decompressBatch(std::vector<Block>& blocks) {
+    for (auto& block : blocks) {
+      block.decompressedLength = decompress(
+          block.src, block.srcLength, block.dest, block.destLength);
+    }
+  }
+
  protected:
   int64_t blockSize_;
   const std::string streamDebugInfo_;
@@ -89,6 +110,47 @@ struct CompressionOptions {
   uint32_t compressionThreshold;
 };
 
+/// A device that decompresses blocks off the CPU, e.g. Intel IAA or QAT. When
+/// one is registered with registerDecompressionAccelerator(), the
+/// decompressors made by createDecompressor() for the kinds it supports submit
+/// their blocks to it. The blocks smaller than minInputBytes() and the blocks
+/// the device fails on are decompressed in software. The offloaded bytes are
+/// reported in kMetricDecompressionOffloadedBytes.
+class DecompressionAccelerator {
+ public:
+  static constexpr uint64_t kDefaultMinInputBytes = 16 << 10;
+
+  virtual ~DecompressionAccelerator() = default;
+
+  /// Returns true if the blocks of 'kind' compressed with 'options' can be
+  /// offloaded.
+  virtual bool supports(
+      facebook::velox::common::CompressionKind kind,
+      const CompressionOptions& options) const = 0;
+
+  /// Returns the compressed size of the smallest block that is offloaded.
+  /// Smaller blocks are faster to decompress in software than to submit.
+  virtual uint64_t minInputBytes() const {
+    return kDefaultMinInputBytes;
+  }
+
+  /// Starts decompressing 'blocks' as one batch. The result has the
+  /// decompressed size of each block or the error the device failed with.
+  /// 'blocks' stay valid until the result is ready.
+  virtual folly::SemiFuture<std::vector<folly::Try<uint64_t>>> decompress(
+      facebook::velox::common::CompressionKind kind,
+      const CompressionOptions& options,
+      const std::vector<Decompressor::Block>& blocks) = 0;
+};
+
+/// Registers the accelerator used by the decompressors created after this.
+/// nullptr stops offloading.
+void registerDecompressionAccelerator(
+    std::shared_ptr<DecompressionAccelerator> accelerator);
+
+/// Returns the registered accelerator or nullptr.
+std::shared_ptr<DecompressionAccelerator> decompressionAccelerator();
+
 /**
  * Create a decompressor for the given compression kind.
  * @param kind The compression type to implement
@@ -212,6 +212,92 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+int64_t PagedInputStream::readDirect(char* buffer, int64_t size) {
+  // ZlibDecompressionStream decompresses in its own readOrSkip().
+  if (!decompressor_ || decrypter_ || !skipAllPending()) {
+    return 0;
+  }
+  // The blocks of known decompressed size that are decompressed together, so
+  // that an offloading decompressor can submit them as one batch. Their input
+  // is in the range from the last input_->Next() or in 'inputBuffer_', so they
+  // are decompressed before either changes.
+  std::vector<Decompressor::Block> batch;
+  auto flush = [&]() {
+    if (batch.empty()) {
+      return;
+    }
+    decompressor_->decompressBatch(batch);
+    for (const auto& block : batch) {
+      DWIO_ENSURE_EQ(
+          block.decompressedLength,
+          block.destLength,
+          "Bad decompressed length in ",
+          getName());
+    }
+    batch.clear();
+  };
+  int64_t bytesRead = 0;
+  while (bytesRead < size && outputBufferLength_ == 0) {
+    if (state_ == State::HEADER || remainingLength_ == 0) {
+      if (inputBufferPtrEnd_ - inputBufferPtr_ < kHeaderSize) {
+        flush();
+      }
+      readHeader();
+    }
+    if (state_ != State::START) {
+      break;
+    }
+    if (inputBufferPtr_ == inputBufferPtrEnd_) {
+      flush();
+      readBuffer(true);
+    }
+    const auto availSize = std::min(
+        static_cast<size_t>(inputBufferPtrEnd_ - inputBufferPtr_),
+        remainingLength_);
+    if (availSize < remainingLength_) {
+      flush();
+    }
+    const auto* input = ensureInput(availSize);
+    const auto [decompressedLength, exact] =
+        decompressor_->getDecompressedLength(input, remainingLength_);
+    const uint64_t available = size - bytesRead;
+    if (exact && decompressedLength <= available) {
+      batch.push_back(
+          {input,
+           remainingLength_,
+           buffer + bytesRead,
+           static_cast<uint64_t>(decompressedLength)});
+      bytesRead += decompressedLength;
+      bytesReturned_ += decompressedLength;
+      lastWindowSize_ = decompressedLength;
+      // There is no output to back up into.
+      outputBufferPtr_ = nullptr;
+    } else if (decompressedLength <= available) {
+      const auto length = decompressor_->decompress(
+          input, remainingLength_, buffer + bytesRead, available);
+      bytesRead += length;
+      bytesReturned_ += length;
+      lastWindowSize_ = length;
+      outputBufferPtr_ = nullptr;
+    } else {
+      // Decompresses as Next() would and leaves the block to be returned by
+      // the next Next() like after a BackUp().
+      prepareOutputBuffer(decompressedLength);
+      outputBufferLength_ = decompressor_->decompress(
+          input,
+          remainingLength_,
+          outputBuffer_->data(),
+          outputBuffer_->capacity());
+      outputBufferPtr_ = outputBuffer_->data();
+      lastWindowSize_ = outputBufferLength_;
+    }
+    remainingLength_ = 0;
+    state_ = State::HEADER;
+  }
+  flush();
+  return bytesRead;
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
@@ -296,7 +382,16 @@ void PagedInputStream::seekToPosition(
         lastWindowSize_ < alreadyRead - uncompressedOffset;
   };
 
-  if (compressedOffset != lastHeaderOffset_ || outsideOriginalWindow()) {
+  // There is nothing to back up into if the last block was decompressed by
+  // readDirect() or skipped without decompression.
+  auto outsideOutput = [&]() {
+    return state_ != State::ORIGINAL && outputBufferPtr_ == nullptr &&
+        compressedOffset == lastHeaderOffset_ &&
+        uncompressedOffset < alreadyRead;
+  };
+
+  if (compressedOffset != lastHeaderOffset_ || outsideOriginalWindow() ||
+      outsideOutput()) {
     std::vector<uint64_t> positions = {compressedOffset};
     auto provider = dwio::common::PositionProvider(positions);
     input_->seekToPosition(provider);
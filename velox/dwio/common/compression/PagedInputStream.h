@@ -60,6 +60,18 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     return bytesReturned_ + pendingSkip_;
   }
 
+  // Decompresses the compressed blocks that fit into 'size' bytes directly
+  // into 'buffer'. Stops at the first block that does not fit and leaves it
+  // decompressed for the next Next(). Returns 0 if the stream has data backed
+  // up, is encrypted or the next block is not compressed. The blocks of known
+  // decompressed size are passed to Decompressor::decompressBatch() together.
+  int64_t readDirect(char* buffer, int64_t size) override;
+
+  std::optional<std::pair<uint64_t, uint64_t>> lastBlockStart()
+      const override {
+    return std::make_pair(lastHeaderOffset_, bytesReturnedAtLastHeaderOffset_);
+  }
+
   void seekToPosition(dwio::common::PositionProvider& position) override;
   std::string getName() const override {
     return folly::to<std::string>(
@@ -116,6 +128,9 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   enum class State { HEADER, START, ORIGINAL, END };
 
+  // The size of the header of a compressed block.
+  static constexpr int32_t kHeaderSize = 3;
+
   // make sure input is contiguous for decompression/decryption
   const char* ensureInput(size_t availableInputBytes);
 
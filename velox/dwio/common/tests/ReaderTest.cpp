@@ -60,6 +60,38 @@ TEST_F(ReaderTest, getOrCreateChild) {
       "Field not found: c. Available fields are: c.0, c.1.");
 }
 
+TEST_F(ReaderTest, filterOrderWithoutHistory) {
+  common::ScanSpec spec("<root>");
+  const auto addChild = [&](const std::string& name,
+                            const TypePtr& type,
+                            std::unique_ptr<common::Filter> filter) {
+    auto* child = spec.getOrCreateChild(name);
+    child->setDecodeCost(*type);
+    child->setFilter(std::move(filter));
+  };
+  addChild(
+      "a",
+      VARCHAR(),
+      std::make_unique<common::BytesValues>(
+          std::vector<std::string>{"x", "y"}, false));
+  addChild("b", VARCHAR(), std::make_unique<common::IsNotNull>());
+  addChild("c", BIGINT(), std::make_unique<common::BigintRange>(0, 10, false));
+  addChild(
+      "d",
+      DOUBLE(),
+      std::make_unique<common::DoubleRange>(
+          0, false, false, 1, false, false, false));
+  addChild("e", ARRAY(BIGINT()), std::make_unique<common::IsNotNull>());
+  spec.newRead();
+
+  // Cheap filters on cheap columns are first, the ties are by name.
+  std::vector<std::string> order;
+  for (const auto& child : spec.children()) {
+    order.push_back(child->fieldName());
+  }
+  ASSERT_EQ(order, (std::vector<std::string>{"c", "d", "b", "a", "e"}));
+}
+
 TEST_F(ReaderTest, projectColumnsFilterStruct) {
   constexpr int kSize = 10;
   auto input = makeRowVector({
@@ -112,6 +144,54 @@ TEST_F(ReaderTest, projectColumnsFilterArray) {
   }
 }
 
+TEST_F(ReaderTest, projectColumnsMultiColumnFilter) {
+  constexpr int kSize = 10;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto i) { return fmt::format("s{}", i % 3); },
+          [](auto i) { return i == 5; }),
+  });
+  auto tuples = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 5, 7, 8}),
+      makeNullableFlatVector<std::string>(
+          {"s1", "s0", std::nullopt, "s1", "s2"}),
+  });
+  {
+    SCOPED_TRACE("TupleValues");
+    common::ScanSpec spec("<root>");
+    spec.addField("c0", 0);
+    spec.getOrCreateChild("c1");
+    spec.addMultiColumnFilter(std::make_shared<common::TupleValues>(
+        std::vector<std::string>{"c0", "c1"}, tuples));
+    auto actual = RowReader::projectColumns(input, spec, nullptr);
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>({1, 7, 8}),
+    });
+    test::assertEqualVectors(expected, actual);
+  }
+  {
+    SCOPED_TRACE("TupleBloomFilter");
+    common::ScanSpec spec("<root>");
+    spec.addField("c0", 0);
+    spec.getOrCreateChild("c1");
+    spec.addMultiColumnFilter(std::make_shared<common::TupleBloomFilter>(
+        std::vector<std::string>{"c0", "c1"}, tuples));
+    auto actual = RowReader::projectColumns(input, spec, nullptr);
+    // False positives pass but rows with nulls do not.
+    auto* c0 = actual->asChecked<RowVector>()->childAt(0).get();
+    std::vector<int64_t> keys;
+    for (auto i = 0; i < actual->size(); ++i) {
+      keys.push_back(c0->as<SimpleVector<int64_t>>()->valueAt(i));
+    }
+    for (auto key : {1, 7, 8}) {
+      ASSERT_NE(std::find(keys.begin(), keys.end(), key), keys.end()) << key;
+    }
+    ASSERT_EQ(std::find(keys.begin(), keys.end(), 5), keys.end());
+  }
+}
+
 TEST_F(ReaderTest, projectColumnsMutation) {
   constexpr int kSize = 10;
   auto input = makeRowVector({makeFlatVector<int64_t>(kSize, folly::identity)});
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ZOrderEncoder.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+const CompareFlags kAscNullsLast{
+    false,
+    true,
+    false,
+    CompareFlags::NullHandlingMode::kNullAsValue};
+const CompareFlags kDescNullsLast{
+    false,
+    false,
+    false,
+    CompareFlags::NullHandlingMode::kNullAsValue};
+
+class ZOrderEncoderTest : public testing::Test,
+                          public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Returns the rows of 'input' in the order of their Z-values.
+  std::vector<vector_size_t> zOrder(
+      const ZOrderEncoder& encoder,
+      const RowVectorPtr& input) {
+    const auto output = encoder.appendZValues(input, pool());
+    const auto* zValues =
+        output->childAt(output->childrenSize() - 1)->asFlatVector<StringView>();
+    std::vector<vector_size_t> rows(input->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+      return zValues->valueAt(left) < zValues->valueAt(right);
+    });
+    return rows;
+  }
+};
+
+TEST_F(ZOrderEncoderTest, interleave) {
+  // A 4 x 4 grid of (c0, c1) in row major order.
+  auto input = makeRowVector({
+      makeFlatVector<int16_t>(16, [](auto row) { return row / 4; }),
+      makeFlatVector<int64_t>(16, [](auto row) { return row % 4; }),
+      makeFlatVector<std::string>(
+          16, [](auto row) { return std::to_string(row); }),
+  });
+  ZOrderEncoder encoder(
+      asRowType(input->type()), {0, 1}, {kAscNullsLast, kAscNullsLast}, 16);
+  // The null bits, 16 value bits of c0 and 64 value bits of c1.
+  ASSERT_EQ(encoder.zValueSize(), bits::nbytes(2 + 16 + 64));
+
+  // Morton order: the quadrants in order, each of them in Z-order. The small
+  // values of c1 are not made less significant by its wider type.
+  const std::vector<vector_size_t> expected = {
+      0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+  ASSERT_EQ(zOrder(encoder, input), expected);
+}
+
+TEST_F(ZOrderEncoderTest, nullsAndDescending) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<int32_t>({2, std::nullopt, 1, 2, 1}),
+      makeNullableFlatVector<double>({1.5, 0.5, std::nullopt, -1.0, 1.5}),
+  });
+  const auto rowType = asRowType(input->type());
+
+  // Nulls last: the rows with a null key sort after the others, a null in the
+  // first key after a null in the second.
+  ZOrderEncoder ascending(rowType, {0, 1}, {kAscNullsLast, kAscNullsLast}, 16);
+  auto order = zOrder(ascending, input);
+  ASSERT_EQ(order.back(), 1);
+  ASSERT_EQ(order[order.size() - 2], 2);
+
+  // A single descending key sorts in descending order.
+  ZOrderEncoder descending(rowType, {1}, {kDescNullsLast}, 16);
+  order = zOrder(descending, input);
+  ASSERT_EQ(order, std::vector<vector_size_t>({0, 4, 1, 3, 2}));
+}
+
+TEST_F(ZOrderEncoderTest, stringPrefix) {
+  auto input = makeRowVector({
+      makeFlatVector<std::string>(
+          {"banana", "apple", "cherry", "apricot", "applesauce"}),
+      makeFlatVector<int8_t>({1, 1, 1, 1, 1}),
+  });
+  // Strings are clustered on their first 5 bytes, so "apple" and "applesauce"
+  // keep their input order.
+  ZOrderEncoder encoder(
+      asRowType(input->type()), {0, 1}, {kAscNullsLast, kAscNullsLast}, 5);
+  ASSERT_EQ(
+      zOrder(encoder, input), std::vector<vector_size_t>({1, 4, 3, 0, 2}));
+}
+
+TEST_F(ZOrderEncoderTest, appendAndRemove) {
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>({3, 1, 2}),
+      makeFlatVector<Timestamp>(
+          {Timestamp(1, 0), Timestamp(0, 5), Timestamp(0, 1)}),
+      makeArrayVector<int32_t>({{1}, {2, 3}, {}}),
+  });
+  const auto rowType = asRowType(input->type());
+  ZOrderEncoder encoder(rowType, {0, 1}, {kAscNullsLast, kAscNullsLast}, 16);
+  ASSERT_EQ(
+      encoder.outputType()->names().back(), ZOrderEncoder::kZValueColumnName);
+
+  auto output = encoder.appendZValues(input, pool());
+  ASSERT_EQ(*output->type(), *encoder.outputType());
+  test::assertEqualVectors(input, encoder.removeZValues(output));
+
+  ASSERT_FALSE(ZOrderEncoder::isSupported(ARRAY(INTEGER())));
+  ASSERT_FALSE(ZOrderEncoder::isSupported(BOOLEAN()));
+  VELOX_ASSERT_THROW(
+      ZOrderEncoder(rowType, {2}, {kAscNullsLast}, 16),
+      "Unsupported Z-order key type: ARRAY<INTEGER>");
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
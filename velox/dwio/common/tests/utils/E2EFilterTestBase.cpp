@@ -761,6 +761,90 @@ void E2EFilterTestBase::testSubfieldsPruning() {
   }
 }
 
+void E2EFilterTestBase::testArrayLengthsOnly() {
+  test::VectorMaker vectorMaker(leafPool_.get());
+  std::vector<RowVectorPtr> batches;
+  const auto sizeAt = [](auto j) { return j % 7 == 3 ? 0 : j % 4; };
+  for (int i = 0; i < batchCount_; ++i) {
+    auto a = vectorMaker.flatVector<int64_t>(
+        batchSize_, [&](auto j) { return i * batchSize_ + j; });
+    std::vector<vector_size_t> offsets;
+    std::vector<vector_size_t> nulls;
+    vector_size_t numElements = 0;
+    for (auto j = 0; j < batchSize_; ++j) {
+      offsets.push_back(numElements);
+      numElements += sizeAt(j);
+      if (j % 7 == 3) {
+        nulls.push_back(j);
+      }
+    }
+    auto elements = vectorMaker.rowVector(
+        {"x", "y"},
+        {vectorMaker.flatVector<int64_t>(
+             numElements, [](auto j) { return j; }),
+         vectorMaker.flatVector<StringView>(numElements, [](auto) {
+           return "foofoofoofoofoo"_sv;
+         })});
+    auto c = vectorMaker.arrayVector(offsets, elements, nulls);
+    auto d = vectorMaker.arrayVector(
+        offsets,
+        vectorMaker.arrayVector<int32_t>(
+            numElements,
+            [](auto j) { return j % 3; },
+            [](auto j) { return j; }),
+        nulls);
+    batches.push_back(vectorMaker.rowVector({"a", "c", "d"}, {a, c, d}));
+  }
+  auto& rowType = batches[0]->type();
+  writeToMemory(rowType, batches, false);
+
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  // Skips some rows between the ones read.
+  std::vector<int64_t> requiredA;
+  for (int64_t i = 0; i < batchCount_ * batchSize_; ++i) {
+    if (i % 13 != 0) {
+      requiredA.push_back(i);
+    }
+  }
+  spec->addFieldRecursively("a", *BIGINT(), 0)
+      ->setFilter(common::createBigintValues(requiredA, false));
+  for (auto i = 1; i < rowType->size(); ++i) {
+    auto& type = rowType->childAt(i);
+    spec->addFieldRecursively(rowType->asRow().nameOf(i), *type, i)
+        ->childByName(common::ScanSpec::kArrayElementsFieldName)
+        ->setConstantValue(
+            BaseVector::createNullConstant(
+                type->childAt(0), 1, leafPool_.get()));
+  }
+  ReaderOptions readerOpts{leafPool_.get()};
+  RowReaderOptions rowReaderOpts;
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(sinkData_), readerOpts.memoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto result = BaseVector::create(rowType, 1, leafPool_.get());
+  int64_t numRows = 0;
+  while (rowReader->next(10, result)) {
+    auto* actual = result->as<RowVector>();
+    auto* a = actual->childAt(0)->loadedVector()->asFlatVector<int64_t>();
+    for (auto row = 0; row < actual->size(); ++row) {
+      const auto value = a->valueAt(row);
+      ASSERT_NE(value % 13, 0);
+      const auto j = value % batchSize_;
+      for (auto i = 1; i < rowType->size(); ++i) {
+        auto* array = actual->childAt(i)->loadedVector()->as<ArrayVector>();
+        ASSERT_EQ(array->isNullAt(row), j % 7 == 3) << value;
+        if (!array->isNullAt(row)) {
+          ASSERT_EQ(array->sizeAt(row), sizeAt(j)) << value;
+        }
+      }
+      ++numRows;
+    }
+  }
+  ASSERT_EQ(numRows, requiredA.size());
+}
+
 void E2EFilterTestBase::testMutationCornerCases() {
   test::VectorMaker vectorMaker(leafPool_.get());
   flushEveryNBatches_ = 1;
@@ -341,6 +341,10 @@ class E2EFilterTestBase : public testing::Test {
 
   void testSubfieldsPruning();
 
+  // Tests reading only the sizes and nulls of lists whose elements have a
+  // constant scan spec.
+  void testArrayLengthsOnly();
+
   void testMutationCornerCases();
 
   // Allows testing reading with different batch sizes.
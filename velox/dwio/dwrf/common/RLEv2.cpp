@@ -15,6 +15,9 @@
  */
 
 #include "velox/dwio/dwrf/common/RLEv2.h"
+
+#include <folly/lang/Bits.h>
+
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
@@ -22,6 +25,48 @@ namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
 
+namespace {
+// Unpacks 'numValues' big endian values of sizeof(T) bytes from 'input'.
+template <typename T>
+void unpackAligned(const char* input, uint64_t numValues, int64_t* data) {
+  for (uint64_t i = 0; i < numValues; ++i) {
+    data[i] = static_cast<int64_t>(
+        folly::Endian::big(folly::loadUnaligned<T>(input + i * sizeof(T))));
+  }
+}
+
+// Unpacks 'numValues' values of 'bitWidth' bits packed most significant bit
+// first from the start of 'input'. Each value is extracted from the 8 bytes
+// starting at its first byte, so these must be readable. 'bitWidth' is one of
+// the widths of RLEv2, so the value and its offset in the first byte fit in
+// the 8 bytes.
+void unpackBigEndian(
+    const char* input,
+    uint64_t numValues,
+    uint64_t bitWidth,
+    int64_t* data) {
+  switch (bitWidth) {
+    case 8:
+      return unpackAligned<uint8_t>(input, numValues, data);
+    case 16:
+      return unpackAligned<uint16_t>(input, numValues, data);
+    case 32:
+      return unpackAligned<uint32_t>(input, numValues, data);
+    case 64:
+      return unpackAligned<uint64_t>(input, numValues, data);
+    default:
+      break;
+  }
+  const auto shift = 64 - bitWidth;
+  for (uint64_t i = 0; i < numValues; ++i) {
+    const uint64_t bit = i * bitWidth;
+    const auto word =
+        folly::Endian::big(folly::loadUnaligned<uint64_t>(input + bit / 8));
+    data[i] = static_cast<int64_t>((word << (bit % 8)) >> shift);
+  }
+}
+} // namespace
+
 struct FixedBitSizes {
   enum FBS {
     ONE = 0,
@@ -119,6 +164,48 @@ int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   return ret;
 }
 
+template <bool isSigned>
+void RleDecoderV2<isSigned>::unpackLongs(
+    int64_t* data,
+    uint64_t numValues,
+    uint64_t fb) {
+  VELOX_DCHECK(fb > 0 && fb <= 64);
+  auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart_;
+  const auto& bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd_;
+  uint64_t i = 0;
+  while (i < numValues) {
+    // The next value starts at a byte boundary if no bits of 'curByte_' are
+    // left. This is the case at least every 8 values.
+    const uint64_t available = bitsLeft_ == 0 ? bufferEnd - bufferStart : 0;
+    // The number of values whose 8 bytes from their first byte are in the
+    // buffer.
+    const uint64_t numInBuffer = available < sizeof(uint64_t)
+        ? 0
+        : std::min(numValues - i, ((available - 7) * 8 - 1) / fb + 1);
+    if (numInBuffer == 0) {
+      data[i++] = static_cast<int64_t>(readLongBits(fb));
+      continue;
+    }
+    unpackBigEndian(bufferStart, numInBuffer, fb, data + i);
+    i += numInBuffer;
+    const uint64_t numBits = numInBuffer * fb;
+    bufferStart += numBits / 8;
+    if (numBits % 8 != 0) {
+      curByte_ = static_cast<unsigned char>(*bufferStart++);
+      bitsLeft_ = 8 - numBits % 8;
+    }
+  }
+}
+
+template void RleDecoderV2<true>::unpackLongs(
+    int64_t* data,
+    uint64_t numValues,
+    uint64_t fb);
+template void RleDecoderV2<false>::unpackLongs(
+    int64_t* data,
+    uint64_t numValues,
+    uint64_t fb);
+
 template <bool isSigned>
 RleDecoderV2<isSigned>::RleDecoderV2(
     std::unique_ptr<dwio::common::SeekableInputStream> input,
@@ -427,42 +514,46 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
     // any remaining bits are thrown out
     resetReadLongs();
 
-    // apply the patch directly when decoding the packed data
+    // Applies the patches and the base to the whole run, so that the values
+    // are copied out without checking for patches.
     patchMask_ = ((static_cast<int64_t>(1) << patchBitSize_) - 1);
-
     adjustGapAndPatch();
-  }
-
-  uint64_t nRead = std::min(runLength_ - runRead_, numValues);
-
-  for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
-    // skip null positions
-    if (nulls && bits::isBitNull(nulls, pos)) {
-      continue;
+    for (;;) {
+      const auto patchedIdx = static_cast<uint64_t>(actualGap_);
+      VELOX_CHECK_LT(
+          patchedIdx,
+          runLength_,
+          "Corrupt PATCHED_BASE encoded data (patch past end of run)! ",
+          dwio::common::IntDecoder<isSigned>::inputStream_->getName());
+      unpacked_[patchedIdx] |= curPatch_ << bitSize_;
+      if (++patchIdx_ >= unpackedPatch_.size()) {
+        break;
+      }
+      adjustGapAndPatch();
+      // next gap is relative to the current gap
+      actualGap_ += patchedIdx;
     }
-    if (static_cast<int64_t>(unpackedIdx_) != actualGap_) {
-      // no patching required. add base to unpacked value to get final value
-      data[pos] = base_ + unpacked_[unpackedIdx_];
-    } else {
-      // extract the patch value
-      int64_t patchedVal = unpacked_[unpackedIdx_] | (curPatch_ << bitSize_);
-
-      // add base to patched value
-      data[pos] = base_ + patchedVal;
-
-      // increment the patch to point to next entry in patch list
-      ++patchIdx_;
-
-      if (patchIdx_ < unpackedPatch_.size()) {
-        adjustGapAndPatch();
+    auto* unpacked = unpacked_.data();
+    for (uint64_t i = 0; i < runLength_; ++i) {
+      unpacked[i] += base_;
+    }
+  }
 
-        // next gap is relative to the current gap
-        actualGap_ += unpackedIdx_;
+  const uint64_t nRead = std::min(runLength_ - runRead_, numValues);
+  const auto* unpacked = unpacked_.data() + unpackedIdx_;
+  if (nulls) {
+    uint64_t numNonNulls = 0;
+    for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
+      if (!bits::isBitNull(nulls, pos)) {
+        data[pos] = unpacked[numNonNulls++];
       }
     }
-
-    ++runRead_;
-    ++unpackedIdx_;
+    runRead_ += numNonNulls;
+    unpackedIdx_ += numNonNulls;
+  } else {
+    std::copy(unpacked, unpacked + nRead, data + offset);
+    runRead_ += nRead;
+    unpackedIdx_ += nRead;
   }
 
   return nRead;
@@ -532,13 +623,24 @@ uint64_t RleDecoderV2<isSigned>::nextDelta(
 
   if (bitSize_ == 0) {
     // add fixed deltas to adjacent values
-    for (; pos < offset + nRead; ++pos) {
-      // skip null positions
-      if (nulls && bits::isBitNull(nulls, pos)) {
-        continue;
+    if (nulls) {
+      for (; pos < offset + nRead; ++pos) {
+        // skip null positions
+        if (bits::isBitNull(nulls, pos)) {
+          continue;
+        }
+        prevValue_ = data[pos] = prevValue_ + deltaBase_;
+        ++runRead_;
       }
-      prevValue_ = data[pos] = prevValue_ + deltaBase_;
-      ++runRead_;
+    } else if (pos < offset + nRead) {
+      // The values do not depend on each other, so this loop vectorizes.
+      const auto numDeltas = offset + nRead - pos;
+      const auto first = prevValue_;
+      for (uint64_t i = 0; i < numDeltas; ++i) {
+        data[pos + i] = first + deltaBase_ * static_cast<int64_t>(i + 1);
+      }
+      prevValue_ = data[pos + numDeltas - 1];
+      runRead_ += numDeltas;
     }
   } else {
     for (; pos < offset + nRead; ++pos) {
@@ -559,20 +661,21 @@ uint64_t RleDecoderV2<isSigned>::nextDelta(
     uint64_t remaining = (offset + nRead) - pos;
     runRead_ += readLongs(data, pos, remaining, bitSize_, nulls);
 
-    if (deltaBase_ < 0) {
+    if (nulls) {
       for (; pos < offset + nRead; ++pos) {
         // skip null positions
-        if (nulls && bits::isBitNull(nulls, pos)) {
+        if (bits::isBitNull(nulls, pos)) {
           continue;
         }
+        prevValue_ = data[pos] = deltaBase_ < 0 ? prevValue_ - data[pos]
+                                                : prevValue_ + data[pos];
+      }
+    } else if (deltaBase_ < 0) {
+      for (; pos < offset + nRead; ++pos) {
         prevValue_ = data[pos] = prevValue_ - data[pos];
       }
     } else {
       for (; pos < offset + nRead; ++pos) {
-        // skip null positions
-        if (nulls && bits::isBitNull(nulls, pos)) {
-          continue;
-        }
         prevValue_ = data[pos] = prevValue_ + data[pos];
       }
     }
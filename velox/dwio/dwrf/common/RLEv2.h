@@ -19,6 +19,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -62,6 +63,12 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if constexpr (!std::is_same_v<typename Visitor::DataType, int128_t>) {
+      if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+        fastPath<hasNulls>(nulls, visitor);
+        return;
+      }
+    }
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +107,128 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  // Number of values decoded at a time into a temporary buffer when the
+  // values are not decoded directly into the output of the visitor.
+  static constexpr int32_t kBatchSize = 256;
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values of 'nonNullRows' a batch at a time and passes them to
+  // the visitor. Dense 64 bit values are decoded directly into the values of
+  // the visitor.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    constexpr bool kDecodeInPlace =
+        Visitor::dense && std::is_same_v<T, int64_t>;
+    const auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    const auto* rows = visitor.rows();
+    const auto numRows = visitor.numRows();
+    auto* values = visitor.rawValues(numRows);
+    auto* filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    int32_t rowIndex = 0;
+    int32_t currentRow = 0;
+    int64_t batch[kBatchSize];
+    while (rowIndex < numRows) {
+      int32_t numInBatch;
+      if constexpr (kDecodeInPlace) {
+        numInBatch = numRows - rowIndex;
+        doNext(
+            reinterpret_cast<int64_t*>(values) + numValues,
+            numInBatch,
+            nullptr);
+      } else if (Visitor::dense) {
+        numInBatch = std::min(numRows - rowIndex, kBatchSize);
+        doNext(batch, numInBatch, nullptr);
+        for (auto i = 0; i < numInBatch; ++i) {
+          values[numValues + i] = static_cast<T>(batch[i]);
+        }
+      } else {
+        if (rows[rowIndex] - currentRow >= kBatchSize) {
+          this->template skip<false>(
+              rows[rowIndex] - currentRow, currentRow, nullptr);
+          currentRow = rows[rowIndex];
+        }
+        numInBatch = std::lower_bound(
+                         rows + rowIndex,
+                         rows + numRows,
+                         currentRow + kBatchSize) -
+            (rows + rowIndex);
+        const auto numDecoded =
+            rows[rowIndex + numInBatch - 1] - currentRow + 1;
+        doNext(batch, numDecoded, nullptr);
+        for (auto i = 0; i < numInBatch; ++i) {
+          values[numValues + i] =
+              static_cast<T>(batch[rows[rowIndex + i] - currentRow]);
+        }
+        currentRow += numDecoded;
+      }
+      visitor.template processRun<hasFilter, hasHook, scatter>(
+          values + numValues,
+          numInBatch,
+          scatterRows,
+          filterHits,
+          values,
+          numValues);
+      rowIndex += numInBatch;
+    }
+    visitor.setNumValues(hasFilter ? numValues : numAllRows);
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap_ = static_cast<uint64_t>(unpackedPatch_[patchIdx_]) >> patchBitSize_;
@@ -154,43 +283,59 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
+
+  // Reads 'len' values of 'fb' bits into 'data' starting at 'offset', skipping
+  // the positions that are null in 'nulls'. Returns the number of values read.
+  // Null positions of 'data' are left undefined.
   uint64_t readLongs(
       int64_t* data,
       uint64_t offset,
       uint64_t len,
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
-    uint64_t ret = 0;
-
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
-      // skip null positions
-      if (nulls && bits::isBitNull(nulls, i)) {
-        continue;
-      }
-      uint64_t result = 0;
-      uint64_t bitsLeftToRead = fb;
-      while (bitsLeftToRead > bitsLeft_) {
-        result <<= bitsLeft_;
-        result |= curByte_ & ((1 << bitsLeft_) - 1);
-        bitsLeftToRead -= bitsLeft_;
-        curByte_ = readByte();
-        bitsLeft_ = 8;
+    if (nulls == nullptr) {
+      unpackLongs(data + offset, len, fb);
+      return len;
+    }
+    const uint64_t numNonNulls =
+        bits::countNonNulls(nulls, offset, offset + len);
+    unpackLongs(data + offset, numNonNulls, fb);
+    // Moves the values to their non-null positions, last to first.
+    int64_t source = offset + numNonNulls - 1;
+    for (int64_t pos = offset + len - 1; pos > source; --pos) {
+      if (!bits::isBitNull(nulls, pos)) {
+        data[pos] = data[source--];
       }
+    }
+    return numNonNulls;
+  }
 
-      // handle the left over bits
-      if (bitsLeftToRead > 0) {
-        result <<= bitsLeftToRead;
-        bitsLeft_ -= static_cast<uint32_t>(bitsLeftToRead);
-        result |= (curByte_ >> bitsLeft_) & ((1 << bitsLeftToRead) - 1);
-      }
-      data[i] = static_cast<int64_t>(result);
-      ++ret;
+  // Reads one value of 'fb' bits a byte at a time.
+  uint64_t readLongBits(uint64_t fb) {
+    uint64_t result = 0;
+    uint64_t bitsLeftToRead = fb;
+    while (bitsLeftToRead > bitsLeft_) {
+      result <<= bitsLeft_;
+      result |= curByte_ & ((1 << bitsLeft_) - 1);
+      bitsLeftToRead -= bitsLeft_;
+      curByte_ = readByte();
+      bitsLeft_ = 8;
     }
 
-    return ret;
+    // handle the left over bits
+    if (bitsLeftToRead > 0) {
+      result <<= bitsLeftToRead;
+      bitsLeft_ -= static_cast<uint32_t>(bitsLeftToRead);
+      result |= (curByte_ >> bitsLeft_) & ((1 << bitsLeftToRead) - 1);
+    }
+    return result;
   }
 
+  // Reads 'numValues' consecutive values of 'fb' bits into 'data'. Unpacks
+  // the values that are in the current buffer with 64 bit loads and reads
+  // the values that cross the end of the buffer with readLongBits().
+  void unpackLongs(int64_t* data, uint64_t numValues, uint64_t fb);
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -22,6 +22,7 @@
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
+#include "velox/dwio/dwrf/reader/ParallelDwrfRowReader.h"
 #include "velox/dwio/dwrf/reader/StreamLabels.h"
 #include "velox/vector/FlatVector.h"
 
@@ -44,7 +45,8 @@ class DwrfUnit : public LoadUnit {
       uint32_t stripeIndex,
       std::shared_ptr<dwio::common::ColumnSelector> columnSelector,
       const std::shared_ptr<BitSet>& projectedNodes,
-      RowReaderOptions options)
+      RowReaderOptions options,
+      std::shared_ptr<StringDictionaryCache> stringDictionaryCache)
       : stripeReaderBase_{stripeReaderBase},
         strideIndexProvider_{strideIndexProvider},
         columnReaderStatistics_{&columnReaderStatistics},
@@ -53,7 +55,8 @@ class DwrfUnit : public LoadUnit {
         projectedNodes_{projectedNodes},
         options_{std::move(options)},
         stripeInfo_{
-            stripeReaderBase.getReader().footer().stripes(stripeIndex_)} {}
+            stripeReaderBase.getReader().footer().stripes(stripeIndex_)},
+        stringDictionaryCache_{std::move(stringDictionaryCache)} {}
 
   ~DwrfUnit() override = default;
 
@@ -91,6 +94,7 @@ class DwrfUnit : public LoadUnit {
   const std::shared_ptr<BitSet> projectedNodes_;
   const RowReaderOptions options_;
   const StripeInformationWrapper stripeInfo_;
+  const std::shared_ptr<StringDictionaryCache> stringDictionaryCache_;
 
   // Mutables
   bool preloaded_;
@@ -149,7 +153,8 @@ void DwrfUnit::ensureDecoders() {
       stripeInfo_.offset(),
       stripeInfo_.numberOfRows(),
       strideIndexProvider_,
-      stripeIndex_);
+      stripeIndex_,
+      stringDictionaryCache_);
 
   auto* scanSpec = options_.scanSpec().get();
   const auto& fileType = stripeReaderBase_.getReader().schemaWithId();
@@ -328,7 +333,8 @@ std::unique_ptr<dwio::common::UnitLoader> DwrfRowReader::getUnitLoader() {
         stripe,
         columnSelector_,
         projectedNodes_,
-        options_));
+        options_,
+        stringDictionaryCache_));
   }
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory =
       options_.unitLoaderFactory();
@@ -642,7 +648,9 @@ uint64_t DwrfRowReader::next(
 }
 
 void DwrfRowReader::resetFilterCaches() {
-  if (getSelectiveColumnReader()) {
+  // The filter results of the previous stripes are also stale.
+  stringDictionaryCache_->clearFilterResults();
+  if (currentUnit_ && getSelectiveColumnReader()) {
     getSelectiveColumnReader()->resetFilterCaches();
     recomputeStridesToSkip_ = true;
   }
@@ -1009,6 +1017,12 @@ uint64_t DwrfReader::getMemoryUse(
 
 std::unique_ptr<dwio::common::RowReader> DwrfReader::createRowReader(
     const RowReaderOptions& opts) const {
+  // Stripes are decoded in parallel only by the selective reader. Random skip
+  // is tracked across the stripes and needs them read in order.
+  if (opts.parallelUnitExecutor() != nullptr && opts.maxParallelUnits() > 1 &&
+      opts.scanSpec() != nullptr && readerBase_->randomSkip() == nullptr) {
+    return std::make_unique<ParallelDwrfRowReader>(readerBase_, opts);
+  }
   return createDwrfRowReader(opts);
 }
 
@@ -113,6 +113,8 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.numStripes += stripeCeiling_ - firstStripe_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    stats.columnReaderStatistics.reusedStringDictionaries +=
+        columnReaderStatistics_.reusedStringDictionaries;
   }
 
   void resetFilterCaches() override;
@@ -198,8 +200,8 @@ class DwrfRowReader : public StrideIndexProvider,
 
   std::shared_ptr<BitSet> projectedNodes_;
 
-  const uint64_t* stridesToSkip_;
-  int stridesToSkipSize_;
+  const uint64_t* stridesToSkip_{nullptr};
+  int stridesToSkipSize_{0};
   // Record of strides to skip in each visited stripe. Used for diagnostics.
   std::unordered_map<uint32_t, std::vector<uint64_t>> stripeStridesToSkip_;
   // Number of skipped strides.
@@ -215,6 +217,11 @@ class DwrfRowReader : public StrideIndexProvider,
 
   dwio::common::ColumnReaderStatistics columnReaderStatistics_;
 
+  // The string dictionaries of the stripes read so far, shared by the stripes
+  // that repeat them.
+  const std::shared_ptr<StringDictionaryCache> stringDictionaryCache_{
+      std::make_shared<StringDictionaryCache>()};
+
   std::optional<int64_t> nextRowNumber_;
 
   std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
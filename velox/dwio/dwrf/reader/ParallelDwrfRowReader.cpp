@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/ParallelDwrfRowReader.h"
+
+namespace facebook::velox::dwrf {
+
+ParallelDwrfRowReader::ParallelDwrfRowReader(
+    const std::shared_ptr<ReaderBase>& reader,
+    const dwio::common::RowReaderOptions& options)
+    : reader_{reader},
+      options_{options},
+      executor_{options.parallelUnitExecutor()},
+      maxParallelUnits_{options.maxParallelUnits()},
+      serialReader_{std::make_unique<DwrfRowReader>(reader, options)} {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_NOT_NULL(options_.scanSpec());
+  const auto& footer = reader_->footer();
+  uint64_t firstRow{0};
+  for (uint32_t i = 0; i < footer.stripesSize(); ++i) {
+    const auto stripeInfo = footer.stripes(i);
+    if (stripeInfo.offset() >= options_.offset() &&
+        stripeInfo.offset() < options_.limit()) {
+      stripes_.push_back(i);
+      stripeFirstRows_.push_back(firstRow);
+    }
+    firstRow += stripeInfo.numberOfRows();
+  }
+}
+
+void ParallelDwrfRowReader::scheduleUnits() {
+  if (serial_) {
+    return;
+  }
+  while (nextStripe_ < stripes_.size() && units_.size() < maxParallelUnits_) {
+    if (!units_.empty() && !hasMemoryHeadroom()) {
+      break;
+    }
+    units_.push_back(startUnit(nextStripe_++));
+  }
+}
+
+bool ParallelDwrfRowReader::hasMemoryHeadroom() const {
+  // Like the scaled table scan, only scales up after a stripe has been decoded
+  // and its memory usage is known. Counts the full estimate for every started
+  // stripe even if part of it is already reserved.
+  if (!estimatedUnitMemoryUsage_.has_value()) {
+    return false;
+  }
+  const auto* queryPool = reader_->memoryPool().root();
+  const uint64_t estimatedQueryUsage = queryPool->reservedBytes() +
+      *estimatedUnitMemoryUsage_ * (units_.size() + 1);
+  return estimatedQueryUsage <=
+      queryPool->maxCapacity() * options_.parallelUnitMemoryUsageRatio();
+}
+
+std::unique_ptr<ParallelDwrfRowReader::Unit> ParallelDwrfRowReader::startUnit(
+    size_t index) {
+  const auto stripeInfo = reader_->footer().stripes(stripes_[index]);
+  auto unit = std::make_unique<Unit>();
+  unit->firstRow = stripeFirstRows_[index];
+  unit->endRow = unit->firstRow + stripeInfo.numberOfRows();
+  unit->nextRow = unit->firstRow;
+  unit->generation = generation_;
+  unit->scanSpec = options_.scanSpec()->clone();
+
+  auto options = options_;
+  options.range(stripeInfo.offset(), 1);
+  options.setScanSpec(unit->scanSpec);
+  // The stripes are counted by 'serialReader_'.
+  options.setStripeCountCallback(nullptr);
+  unit->rowReader = std::make_unique<DwrfRowReader>(reader_, options);
+
+  unit->barrier = std::make_unique<dwio::common::ExecutorBarrier>(
+      folly::getKeepAliveToken(executor_));
+  unit->barrier->add([unit = unit.get(), batchSize = batchSize_]() {
+    decodeUnit(*unit, batchSize);
+  });
+  ++numParallelUnits_;
+  return unit;
+}
+
+// static
+void ParallelDwrfRowReader::decodeUnit(Unit& unit, uint64_t batchSize) {
+  auto& rowReader = *unit.rowReader;
+  for (;;) {
+    const auto firstRow = rowReader.nextRowNumber();
+    if (firstRow == kAtEnd) {
+      break;
+    }
+    VectorPtr vector;
+    const auto numRows = rowReader.next(batchSize, vector);
+    VELOX_CHECK_GT(numRows, 0);
+    // Lazy vectors must be loaded here since their readers move on to the next
+    // batch.
+    vector->loadedVector();
+    unit.memoryUsage += vector->retainedSize();
+    unit.batches.push_back(
+        {std::move(vector), static_cast<uint64_t>(firstRow), numRows});
+  }
+}
+
+void ParallelDwrfRowReader::finishUnit(Unit& unit) {
+  if (unit.finished) {
+    return;
+  }
+  unit.barrier->waitAll();
+  unit.finished = true;
+  estimatedUnitMemoryUsage_ =
+      std::max(estimatedUnitMemoryUsage_.value_or(0), unit.memoryUsage);
+}
+
+void ParallelDwrfRowReader::popUnit() {
+  VELOX_CHECK(!units_.empty());
+  dwio::common::RuntimeStatistics stats;
+  units_.front()->rowReader->updateRuntimeStats(stats);
+  skippedStrides_ += stats.skippedStrides;
+  processedStrides_ += stats.processedStrides;
+  flattenStringDictionaryValues_ +=
+      stats.columnReaderStatistics.flattenStringDictionaryValues;
+  reusedStringDictionaries_ +=
+      stats.columnReaderStatistics.reusedStringDictionaries;
+  units_.pop_front();
+}
+
+ParallelDwrfRowReader::Batch* ParallelDwrfRowReader::nextBatch(
+    uint64_t maxRows) {
+  while (!serial_) {
+    if (serialEndRow_.has_value()) {
+      const auto row = serialReader_->nextRowNumber();
+      if (row != kAtEnd && row < *serialEndRow_) {
+        return nullptr;
+      }
+      serialEndRow_.reset();
+    }
+    scheduleUnits();
+    if (units_.empty()) {
+      return nullptr;
+    }
+    auto& unit = *units_.front();
+    finishUnit(unit);
+    if (unit.nextBatch < unit.batches.size()) {
+      auto& batch = unit.batches[unit.nextBatch];
+      if (unit.generation == generation_ && batch.numRows <= maxRows) {
+        return &batch;
+      }
+      readSerially(unit.nextRow, unit.endRow);
+    }
+    popUnit();
+  }
+  return nullptr;
+}
+
+void ParallelDwrfRowReader::readSerially(uint64_t row, uint64_t endRow) {
+  serialEndRow_ = endRow;
+  serialReader_->seekToRow(row);
+}
+
+void ParallelDwrfRowReader::switchToSerial() {
+  const auto row = nextRowNumber();
+  if (row == kAtEnd) {
+    return;
+  }
+  if (!serialEndRow_.has_value()) {
+    serialReader_->seekToRow(row);
+  }
+  serialEndRow_.reset();
+  serial_ = true;
+  while (!units_.empty()) {
+    finishUnit(*units_.front());
+    popUnit();
+  }
+}
+
+uint64_t ParallelDwrfRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  batchSize_ = size;
+  if (dwio::common::hasDeletion(mutation) && !serial_) {
+    // Deletions apply to the rows of each read and cannot be applied to
+    // batches that are decoded ahead.
+    switchToSerial();
+  }
+  auto* batch = nextBatch(size);
+  if (batch == nullptr) {
+    return readsSerially() ? serialReader_->next(size, result, mutation) : 0;
+  }
+  auto& unit = *units_.front();
+  ++unit.nextBatch;
+  unit.nextRow = batch->firstRow + batch->numRows;
+  result = std::move(batch->vector);
+  return batch->numRows;
+}
+
+int64_t ParallelDwrfRowReader::nextRowNumber() {
+  if (auto* batch = nextBatch(std::numeric_limits<uint64_t>::max())) {
+    return batch->firstRow;
+  }
+  return readsSerially() ? serialReader_->nextRowNumber() : kAtEnd;
+}
+
+int64_t ParallelDwrfRowReader::nextReadSize(uint64_t size) {
+  VELOX_DCHECK_GT(size, 0);
+  batchSize_ = size;
+  if (auto* batch = nextBatch(size)) {
+    return batch->numRows;
+  }
+  return readsSerially() ? serialReader_->nextReadSize(size) : kAtEnd;
+}
+
+void ParallelDwrfRowReader::updateRuntimeStats(
+    dwio::common::RuntimeStatistics& stats) const {
+  serialReader_->updateRuntimeStats(stats);
+  stats.skippedStrides += skippedStrides_;
+  stats.processedStrides += processedStrides_;
+  stats.columnReaderStatistics.flattenStringDictionaryValues +=
+      flattenStringDictionaryValues_;
+  stats.columnReaderStatistics.reusedStringDictionaries +=
+      reusedStringDictionaries_;
+}
+
+void ParallelDwrfRowReader::resetFilterCaches() {
+  ++generation_;
+  serialReader_->resetFilterCaches();
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/dwio/common/ExecutorBarrier.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+
+namespace facebook::velox::dwrf {
+
+/// Row reader that decodes several stripes of its range concurrently on
+/// RowReaderOptions::parallelUnitExecutor() and returns their rows in stripe
+/// order. Each stripe is read by its own DwrfRowReader with a copy of the
+/// ScanSpec, and its batches are fully loaded on the executor. The number of
+/// stripes that are decoded or held at the same time is bounded by
+/// RowReaderOptions::maxParallelUnits() and grows only while the query memory
+/// pool has headroom for one more decoded stripe.
+///
+/// The remaining rows of a stripe are read serially with the ScanSpec of the
+/// options when the batches decoded ahead cannot be returned: after
+/// resetFilterCaches() for a dynamic filter, or when a batch has more rows than
+/// requested. A read with deletions switches the rest of the range to serial
+/// reading.
+class ParallelDwrfRowReader : public dwio::common::RowReader {
+ public:
+  ParallelDwrfRowReader(
+      const std::shared_ptr<ReaderBase>& reader,
+      const dwio::common::RowReaderOptions& options);
+
+  ~ParallelDwrfRowReader() override = default;
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& stats) const override;
+
+  void resetFilterCaches() override;
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return serialReader_->estimatedRowSize();
+  }
+
+  bool allPrefetchIssued() const override {
+    return true;
+  }
+
+  /// Returns the number of stripes that were decoded on the executor. Used for
+  /// testing.
+  uint32_t testingNumParallelUnits() const {
+    return numParallelUnits_;
+  }
+
+ private:
+  struct Batch {
+    VectorPtr vector;
+    // File row number of the first row read for 'vector'.
+    uint64_t firstRow;
+    // Number of rows read for 'vector', before filtering.
+    uint64_t numRows;
+  };
+
+  struct Unit {
+    // File row numbers of the first row of the stripe and of the row after it.
+    uint64_t firstRow;
+    uint64_t endRow;
+    // Value of 'generation_' when the unit was started.
+    uint64_t generation;
+    std::shared_ptr<common::ScanSpec> scanSpec;
+    std::unique_ptr<DwrfRowReader> rowReader;
+    std::vector<Batch> batches;
+    uint64_t memoryUsage{0};
+    bool finished{false};
+    // Index in 'batches' of the next batch to return.
+    size_t nextBatch{0};
+    // File row number after the last returned batch.
+    uint64_t nextRow;
+    // Declared last so that it waits for the decoding before the rest of the
+    // unit is destroyed.
+    std::unique_ptr<dwio::common::ExecutorBarrier> barrier;
+  };
+
+  // Starts decoding the next stripes on the executor while there is room.
+  void scheduleUnits();
+
+  bool hasMemoryHeadroom() const;
+
+  // Starts decoding the stripe at 'index' in 'stripes_'.
+  std::unique_ptr<Unit> startUnit(size_t index);
+
+  // Reads all batches of 'unit'. Runs on the executor.
+  static void decodeUnit(Unit& unit, uint64_t batchSize);
+
+  // Waits for 'unit' to be decoded and updates the memory estimate from it.
+  void finishUnit(Unit& unit);
+
+  // Collects the stats of the front unit and removes it.
+  void popUnit();
+
+  // Returns the next decoded batch with at most 'maxRows' rows. Returns
+  // nullptr if the next rows are read by 'serialReader_' or if there are no
+  // more rows.
+  Batch* nextBatch(uint64_t maxRows);
+
+  bool readsSerially() const {
+    return serial_ || serialEndRow_.has_value();
+  }
+
+  // Makes 'serialReader_' read the rows from 'row' to 'endRow'.
+  void readSerially(uint64_t row, uint64_t endRow);
+
+  // Makes 'serialReader_' read all remaining rows.
+  void switchToSerial();
+
+  const std::shared_ptr<ReaderBase> reader_;
+  const dwio::common::RowReaderOptions options_;
+  folly::Executor* const executor_;
+  const uint32_t maxParallelUnits_;
+
+  // Reads the rows that are not decoded ahead on the executor.
+  std::unique_ptr<DwrfRowReader> serialReader_;
+
+  // Stripes in the range of 'options_' and the file row numbers of their first
+  // rows.
+  std::vector<uint32_t> stripes_;
+  std::vector<uint64_t> stripeFirstRows_;
+  // Index in 'stripes_' of the next stripe to start.
+  size_t nextStripe_{0};
+  // Started stripes in stripe order. The front one is being returned.
+  std::deque<std::unique_ptr<Unit>> units_;
+
+  // Batch size for the stripes decoded ahead. Set from the last next() or
+  // nextReadSize().
+  uint64_t batchSize_{1'024};
+  // Incremented for every resetFilterCaches(). Units started before are read
+  // serially since they do not have the new filters.
+  uint64_t generation_{0};
+  // If set, 'serialReader_' reads rows up to this row number.
+  std::optional<uint64_t> serialEndRow_;
+  // If true, 'serialReader_' reads all remaining rows.
+  bool serial_{false};
+
+  // Max memory usage of the batches of a decoded stripe. Unset until the first
+  // stripe is decoded.
+  std::optional<uint64_t> estimatedUnitMemoryUsage_;
+
+  uint32_t numParallelUnits_{0};
+  int64_t skippedStrides_{0};
+  int64_t processedStrides_{0};
+  int64_t flattenStringDictionaryValues_{0};
+  int64_t reusedStringDictionaries_{0};
+};
+
+} // namespace facebook::velox::dwrf
@@ -178,8 +178,10 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
         keyNodes_(
             getKeyNodes<T>(requestedType, fileType, params, scanSpec, true)) {
     VELOX_CHECK(
-        !keyNodes_.empty(),
+        !scanSpec.children().empty(),
         "For struct encoding, keys to project must be configured");
+    // 'keyNodes_' is empty if none of the keys are in this stripe. All the
+    // fields are then null.
     children_.resize(keyNodes_.size());
     for (auto& childSpec : scanSpec.children()) {
       childSpec->setSubscript(kConstantChildSpecSubscript);
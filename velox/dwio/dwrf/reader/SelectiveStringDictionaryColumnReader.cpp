@@ -27,19 +27,20 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
     DwrfParams& params,
     common::ScanSpec& scanSpec)
     : SelectiveColumnReader(fileType->type(), fileType, params, scanSpec),
+      encodingKey_{fileType_->id(), params.flatMapContext().sequence},
+      dictionaryCache_(params.stripeStreams().stringDictionaryCache()),
       lastStrideIndex_(-1),
       provider_(params.stripeStreams().getStrideIndexProvider()),
       statistics_(params.runtimeStatistics()) {
   auto& stripe = params.stripeStreams();
-  EncodingKey encodingKey{fileType_->id(), params.flatMapContext().sequence};
-  version_ = convertRleVersion(stripe, encodingKey);
+  version_ = convertRleVersion(stripe, encodingKey_);
   scanState_.dictionary.numValues = stripe.format() == DwrfFormat::kDwrf
-      ? stripe.getEncoding(encodingKey).dictionarysize()
-      : stripe.getEncodingOrc(encodingKey).dictionarysize();
+      ? stripe.getEncoding(encodingKey_).dictionarysize()
+      : stripe.getEncodingOrc(encodingKey_).dictionarysize();
 
   const auto dataId = StripeStreamsUtil::getStreamForKind(
       stripe,
-      encodingKey,
+      encodingKey_,
       proto::Stream_Kind_DATA,
       proto::orc::Stream_Kind_DATA);
   bool dictVInts = stripe.getUseVInts(dataId);
@@ -52,7 +53,7 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
 
   const auto lenId = StripeStreamsUtil::getStreamForKind(
       stripe,
-      encodingKey,
+      encodingKey_,
       proto::Stream_Kind_LENGTH,
       proto::orc::Stream_Kind_LENGTH);
   bool lenVInts = stripe.getUseVInts(lenId);
@@ -66,7 +67,7 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
   blobStream_ = stripe.getStream(
       StripeStreamsUtil::getStreamForKind(
           stripe,
-          encodingKey,
+          encodingKey_,
           proto::Stream_Kind_DICTIONARY_DATA,
           proto::orc::Stream_Kind_DICTIONARY_DATA),
       params.streamLabels().label(),
@@ -74,24 +75,24 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_IN_DICTIONARY),
+      encodingKey_.forKind(proto::Stream_Kind_IN_DICTIONARY),
       params.streamLabels().label(),
       false);
   if (inDictStream) {
     VELOX_CHECK_EQ(stripe.format(), DwrfFormat::kDwrf);
 
     inDictionaryReader_ =
-        createBooleanRleDecoder(std::move(inDictStream), encodingKey);
+        createBooleanRleDecoder(std::move(inDictStream), encodingKey_);
 
     // stride dictionary only exists if in dictionary exists
     strideDictStream_ = stripe.getStream(
-        encodingKey.forKind(proto::Stream_Kind_STRIDE_DICTIONARY),
+        encodingKey_.forKind(proto::Stream_Kind_STRIDE_DICTIONARY),
         params.streamLabels().label(),
         true);
     VELOX_CHECK_NOT_NULL(strideDictStream_, "Stride dictionary is missing");
 
     const auto strideDictLenId =
-        encodingKey.forKind(proto::Stream_Kind_STRIDE_DICTIONARY_LENGTH);
+        encodingKey_.forKind(proto::Stream_Kind_STRIDE_DICTIONARY_LENGTH);
     bool strideLenVInt = stripe.getUseVInts(strideDictLenId);
     strideDictLengthDecoder_ = createRleDecoder</*isSigned*/ false>(
         stripe.getStream(strideDictLenId, params.streamLabels().label(), true),
@@ -103,6 +104,17 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
   scanState_.updateRawState();
 }
 
+SelectiveStringDictionaryColumnReader::
+    ~SelectiveStringDictionaryColumnReader() {
+  if (dictionaryCache_ != nullptr && initialFilter_ != nullptr) {
+    dictionaryCache_->setFilterResults(
+        encodingKey_,
+        scanState_.dictionary,
+        initialFilter_,
+        scanState_.filterCache);
+  }
+}
+
 uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
   numValues = SelectiveColumnReader::skip(numValues);
   dictIndex_->skip(numValues);
@@ -203,13 +215,20 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         std::vector<BufferPtr>{
             scanState_.dictionary.strings, scanState_.dictionary2.strings});
   } else {
-    dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
-        memoryPool_,
-        fileType_->type(),
-        BufferPtr(nullptr), // TODO nulls
-        scanState_.dictionary.numValues /*length*/,
-        scanState_.dictionary.values,
-        std::vector<BufferPtr>{scanState_.dictionary.strings});
+    if (!stripeDictionaryValues_) {
+      stripeDictionaryValues_ = std::make_shared<FlatVector<StringView>>(
+          memoryPool_,
+          fileType_->type(),
+          BufferPtr(nullptr), // TODO nulls
+          scanState_.dictionary.numValues /*length*/,
+          scanState_.dictionary.values,
+          std::vector<BufferPtr>{scanState_.dictionary.strings});
+      if (dictionaryCache_ != nullptr) {
+        dictionaryCache_->setVector(
+            encodingKey_, scanState_.dictionary, stripeDictionaryValues_);
+      }
+    }
+    dictionaryValues_ = stripeDictionaryValues_;
   }
 }
 
@@ -320,12 +339,23 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
 
-  if (DictionaryValues::hasFilter(scanSpec_->filter())) {
+  const auto* filter = scanSpec_->filter();
+  if (DictionaryValues::hasFilter(filter)) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
     simd::memset(
         scanState_.filterCache.data(),
         FilterResult::kUnknown,
         scanState_.dictionary.numValues);
+    initialFilter_ = filter;
+  }
+  if (dictionaryCache_ != nullptr &&
+      dictionaryCache_->reuse(
+          encodingKey_,
+          scanState_.dictionary,
+          initialFilter_,
+          scanState_.filterCache,
+          stripeDictionaryValues_)) {
+    ++statistics_.reusedStringDictionaries;
   }
 
   // handle in dictionary stream
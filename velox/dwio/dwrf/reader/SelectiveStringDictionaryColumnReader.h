@@ -32,6 +32,8 @@ class SelectiveStringDictionaryColumnReader
       DwrfParams& params,
       common::ScanSpec& scanSpec);
 
+  ~SelectiveStringDictionaryColumnReader() override;
+
   bool hasBulkPath() const override {
     // Only ORC uses RLEv2 encoding. Currently, ORC string data does not
     // support fastpath reads. When reading RLEv2-encoded string data
@@ -89,6 +91,15 @@ class SelectiveStringDictionaryColumnReader
       strideDictLengthDecoder_;
 
   FlatVectorPtr<StringView> dictionaryValues_;
+  // The base vector over the stripe dictionary only, used when there is no
+  // stride dictionary.
+  FlatVectorPtr<StringView> stripeDictionaryValues_;
+
+  const EncodingKey encodingKey_;
+  // Shares the stripe dictionary with the stripes that have the same one.
+  StringDictionaryCache* const dictionaryCache_;
+  // The filter the filter cache was initialized for.
+  const common::Filter* initialFilter_{nullptr};
 
   int64_t lastStrideIndex_;
   size_t positionOffset_;
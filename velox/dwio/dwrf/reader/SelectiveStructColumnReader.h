@@ -74,6 +74,14 @@ class SelectiveStructColumnReaderBase
     }
   }
 
+  int64_t advanceFieldReaderToRow(
+      SelectiveColumnReader* reader,
+      int64_t offset,
+      vector_size_t firstRow) override {
+    advanceFieldReader(reader, offset + firstRow);
+    return std::max<int64_t>(0, reader->readOffset() - offset);
+  }
+
  private:
   const int32_t rowsPerRowGroup_;
 };
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/StringDictionaryCache.h"
+
+namespace facebook::velox::dwrf {
+
+using dwio::common::DictionaryValues;
+
+namespace {
+int64_t dictionaryBytes(const DictionaryValues& values) {
+  return values.numValues * sizeof(StringView) + values.strings->size();
+}
+
+// Returns true if 'left' and 'right' have the same strings in the same order.
+// The strings of a dictionary are stored one after the other, so comparing
+// the lengths and the bytes is enough.
+bool sameStrings(const DictionaryValues& left, const DictionaryValues& right) {
+  if (left.numValues != right.numValues ||
+      left.strings->size() != right.strings->size()) {
+    return false;
+  }
+  const auto* leftViews = left.values->as<StringView>();
+  const auto* rightViews = right.values->as<StringView>();
+  for (auto i = 0; i < left.numValues; ++i) {
+    if (leftViews[i].size() != rightViews[i].size()) {
+      return false;
+    }
+  }
+  return memcmp(
+             left.strings->as<char>(),
+             right.strings->as<char>(),
+             left.strings->size()) == 0;
+}
+} // namespace
+
+bool StringDictionaryCache::reuse(
+    const EncodingKey& key,
+    DictionaryValues& values,
+    const common::Filter* filter,
+    raw_vector<uint8_t>& filterCache,
+    FlatVectorPtr<StringView>& vector) {
+  if (values.numValues == 0 || dictionaryBytes(values) > kMaxBytes) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end() || !sameStrings(it->second.values, values)) {
+    entries_[key] = Entry{values};
+    return false;
+  }
+  const auto& entry = it->second;
+  values = entry.values;
+  vector = entry.vector;
+  if (filter != nullptr && entry.filter == filter &&
+      filterCache.size() >= entry.filterResults.size()) {
+    memcpy(
+        filterCache.data(),
+        entry.filterResults.data(),
+        entry.filterResults.size());
+  }
+  return true;
+}
+
+void StringDictionaryCache::setVector(
+    const EncodingKey& key,
+    const DictionaryValues& values,
+    FlatVectorPtr<StringView> vector) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (auto* entry = findLocked(key, values)) {
+    entry->vector = std::move(vector);
+  }
+}
+
+void StringDictionaryCache::setFilterResults(
+    const EncodingKey& key,
+    const DictionaryValues& values,
+    const common::Filter* filter,
+    const raw_vector<uint8_t>& filterCache) {
+  if (filterCache.size() < values.numValues) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (auto* entry = findLocked(key, values)) {
+    entry->filter = filter;
+    entry->filterResults.assign(
+        filterCache.begin(), filterCache.begin() + values.numValues);
+  }
+}
+
+void StringDictionaryCache::clearFilterResults() {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& [_, entry] : entries_) {
+    entry.filter = nullptr;
+    entry.filterResults.clear();
+  }
+}
+
+StringDictionaryCache::Entry* StringDictionaryCache::findLocked(
+    const EncodingKey& key,
+    const DictionaryValues& values) {
+  auto it = entries_.find(key);
+  if (it == entries_.end() || it->second.values.values != values.values) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+} // namespace facebook::velox::dwrf
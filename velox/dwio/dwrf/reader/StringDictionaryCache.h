@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <mutex>
+
+#include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/dwrf/common/Common.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::dwrf {
+
+/// Keeps the last string dictionary of each column across the stripes read by
+/// a row reader. Writers repeat the same dictionary in each stripe for low
+/// cardinality columns, e.g. enums. A stripe with the same dictionary as the
+/// last one then shares its values, its base vector, so that the results over
+/// the dictionary base can be reused downstream, and the results of the filter
+/// of the column on the values. Dictionaries of more than kMaxBytes are not
+/// kept. Thread safe.
+class StringDictionaryCache {
+ public:
+  static constexpr int64_t kMaxBytes = 1 << 20;
+
+  /// If the last dictionary of 'key' has the same strings as 'values',
+  /// replaces 'values' with it, sets 'vector' to its base vector if any,
+  /// copies its results for 'filter' into the start of 'filterCache' if any
+  /// and returns true. Otherwise makes 'values' the last dictionary of 'key'
+  /// and returns false.
+  bool reuse(
+      const EncodingKey& key,
+      dwio::common::DictionaryValues& values,
+      const common::Filter* filter,
+      raw_vector<uint8_t>& filterCache,
+      FlatVectorPtr<StringView>& vector);
+
+  /// Sets the base vector of the last dictionary of 'key' if it is 'values'.
+  void setVector(
+      const EncodingKey& key,
+      const dwio::common::DictionaryValues& values,
+      FlatVectorPtr<StringView> vector);
+
+  /// Sets the results of 'filter' on the last dictionary of 'key' from the
+  /// start of 'filterCache' if the dictionary is 'values'.
+  void setFilterResults(
+      const EncodingKey& key,
+      const dwio::common::DictionaryValues& values,
+      const common::Filter* filter,
+      const raw_vector<uint8_t>& filterCache);
+
+  /// Drops the filter results, e.g. after adding a dynamic filter.
+  void clearFilterResults();
+
+ private:
+  struct Entry {
+    dwio::common::DictionaryValues values;
+    FlatVectorPtr<StringView> vector;
+    // The filter 'filterResults' are for.
+    const common::Filter* filter{nullptr};
+    std::vector<uint8_t> filterResults;
+  };
+
+  // Returns the entry of 'key' if its values are 'values'.
+  Entry* findLocked(
+      const EncodingKey& key,
+      const dwio::common::DictionaryValues& values);
+
+  std::mutex mutex_;
+  folly::F14FastMap<EncodingKey, Entry, EncodingKeyHash> entries_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -332,9 +332,22 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
     streamInput = getIndexStreamFromCache(info);
   }
 
+  // The decompressed bytes of compressed data streams may be cached.
+  auto* stripeInput = readState_->stripeMetadata->stripeInput;
+  const auto* decrypter = getDecrypter(si.encodingKey().node());
+  const velox::common::Region region{
+      info.getOffset() + stripeStart_, info.getLength(), label};
+  const bool cacheDecompressed = !streamInput && decrypter == nullptr &&
+      readState_->readerBase->compressionKind() !=
+          common::CompressionKind_NONE;
+  if (cacheDecompressed) {
+    if (auto decompressed = stripeInput->readDecompressed(region)) {
+      return decompressed;
+    }
+  }
+
   if (!streamInput) {
-    streamInput = readState_->stripeMetadata->stripeInput->enqueue(
-        {info.getOffset() + stripeStart_, info.getLength(), label}, &si);
+    streamInput = stripeInput->enqueue(region, &si);
   }
 
   if (!streamInput) {
@@ -343,10 +356,12 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   const auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
-  return readState_->readerBase->createDecompressedStream(
-      std::move(streamInput),
-      streamDebugInfo,
-      getDecrypter(si.encodingKey().node()));
+  auto decompressed = readState_->readerBase->createDecompressedStream(
+      std::move(streamInput), streamDebugInfo, decrypter);
+  if (cacheDecompressed) {
+    return stripeInput->cacheDecompressed(region, std::move(decompressed));
+  }
+  return decompressed;
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
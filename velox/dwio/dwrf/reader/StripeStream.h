@@ -22,6 +22,7 @@
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/reader/StreamLabels.h"
+#include "velox/dwio/dwrf/reader/StringDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/StripeReaderBase.h"
 
@@ -149,6 +150,12 @@ class StripeStreams {
 
   virtual std::shared_ptr<StripeDictionaryCache> getStripeDictionaryCache() = 0;
 
+  /// Returns the cache of the string dictionaries of the previous stripes or
+  /// nullptr.
+  virtual StringDictionaryCache* stringDictionaryCache() const {
+    return nullptr;
+  }
+
   /// visit all streams of given node and execute visitor logic
   /// return number of streams visited
   virtual uint32_t visitStreamsOfNode(
@@ -229,7 +236,8 @@ class StripeStreamsImpl : public StripeStreamsBase {
       uint64_t stripeStart,
       int64_t stripeNumberOfRows,
       const StrideIndexProvider& provider,
-      uint32_t stripeIndex)
+      uint32_t stripeIndex,
+      std::shared_ptr<StringDictionaryCache> stringDictionaryCache = nullptr)
       : StripeStreamsBase{&readState->readerBase->memoryPool()},
         readState_(std::move(readState)),
         selector_{selector},
@@ -238,7 +246,8 @@ class StripeStreamsImpl : public StripeStreamsBase {
         stripeStart_{stripeStart},
         stripeNumberOfRows_{stripeNumberOfRows},
         provider_(provider),
-        stripeIndex_{stripeIndex} {
+        stripeIndex_{stripeIndex},
+        stringDictionaryCache_{std::move(stringDictionaryCache)} {
     loadStreams();
   }
 
@@ -338,6 +347,10 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return readState_->readerBase->footer().rowIndexStride();
   }
 
+  StringDictionaryCache* stringDictionaryCache() const override {
+    return stringDictionaryCache_.get();
+  }
+
  private:
   const StreamInformation& getStreamInfo(
       const DwrfStreamIdentifier& si,
@@ -374,6 +387,7 @@ class StripeStreamsImpl : public StripeStreamsBase {
   const int64_t stripeNumberOfRows_;
   const StrideIndexProvider& provider_;
   const uint32_t stripeIndex_;
+  const std::shared_ptr<StringDictionaryCache> stringDictionaryCache_;
 
   bool readPlanLoaded_{false};
 
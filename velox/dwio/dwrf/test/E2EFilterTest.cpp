@@ -442,6 +442,10 @@ TEST_F(E2EFilterTest, subfieldsPruning) {
   testSubfieldsPruning();
 }
 
+TEST_F(E2EFilterTest, arrayLengthsOnly) {
+  testArrayLengthsOnly();
+}
+
 TEST_F(E2EFilterTest, mutationCornerCases) {
   testMutationCornerCases();
 }
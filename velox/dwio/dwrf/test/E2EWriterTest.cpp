@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1634,6 +1635,96 @@ TEST_F(E2EWriterTest, fuzzFlatmap) {
   }
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  const auto type = ROW({
+      {"int_val", INTEGER()},
+      {"long_val", BIGINT()},
+      {"string_val", VARCHAR()},
+      {"double_val", DOUBLE()},
+      {"array_val", ARRAY(BIGINT())},
+      {"row_val", ROW({{"a", INTEGER()}, {"b", VARCHAR()}})},
+      {"flatmap_val", MAP(INTEGER(), BIGINT())},
+  });
+  const size_t batchSize = 5'000;
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = batchSize,
+          .nullRatio = 0.1,
+          .stringLength = 20,
+          .stringVariableLength = true,
+      },
+      pool.get(),
+      0);
+  VectorMaker maker{pool.get()};
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    std::vector<VectorPtr> children;
+    for (auto j = 0; j < type->size() - 1; ++j) {
+      children.push_back(fuzzer.fuzz(type->childAt(j)));
+    }
+    // The flat map gets a stream per key, which are created during write.
+    children.push_back(maker.mapVector<int32_t, int64_t>(
+        batchSize,
+        [](auto row) { return 1 + row % 3; },
+        [&](auto /*row*/, auto index) { return (index + i) % 10; },
+        [](auto /*row*/, auto index) { return index; }));
+    batches.push_back(std::make_shared<RowVector>(
+        pool.get(), type, nullptr, batchSize, std::move(children)));
+  }
+
+  const auto writeFile = [&](folly::Executor* executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::FLATTEN_MAP, true);
+    config->set(dwrf::Config::MAP_FLAT_COLS, {6});
+    // Small compression blocks make concurrent streams compress during write.
+    config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1024);
+    auto sink = std::make_unique<MemorySink>(
+        16 * kSizeMB, dwio::common::FileSink::Options{.pool = pool.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = executor;
+    dwrf::Writer writer{std::move(sink), options};
+    for (auto i = 0; i < batches.size(); ++i) {
+      writer.write(batches[i]);
+      if (i % 2 == 1) {
+        writer.flush();
+      }
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const auto sequential = writeFile(nullptr);
+  const auto parallel = writeFile(executor.get());
+  // The columns are encoded the same way and their encodings added to the
+  // footer in the same order.
+  ASSERT_EQ(sequential, parallel);
+
+  dwio::common::ReaderOptions readerOpts{pool.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(parallel),
+          readerOpts.memoryPool()));
+  ASSERT_EQ(reader->getNumberOfStripes(), 2);
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr result;
+  for (const auto& expected : batches) {
+    ASSERT_TRUE(rowReader->next(batchSize, result));
+    ASSERT_EQ(result->size(), batchSize);
+    for (auto row = 0; row < batchSize; ++row) {
+      ASSERT_TRUE(result->equalValueAt(expected.get(), row, row))
+          << "Mismatch at " << row;
+    }
+  }
+  ASSERT_FALSE(rowReader->next(batchSize, result));
+}
+
 TEST_F(E2EWriterTest, memoryConfigError) {
   const auto type = ROW(
       {{"int_val", INTEGER()},
@@ -25,6 +25,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/reader/ParallelDwrfRowReader.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 #include "velox/dwio/dwrf/test/utils/E2EWriterTestUtil.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
@@ -2140,6 +2141,48 @@ TEST_F(TestReader, setRowNumberColumnInfo) {
   }
 }
 
+TEST_F(TestReader, multiColumnFilter) {
+  constexpr int32_t kSize = 1'000;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 7; }),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("s{}", row); }),
+  });
+  auto [writer, reader] = createWriterReader({batch}, pool());
+  auto schema = asRowType(batch->type());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(0, 900, false));
+  // (998, 4) fails the filter on c0 and (20, 0) is not in the data.
+  spec->addMultiColumnFilter(std::make_shared<common::TupleValues>(
+      std::vector<std::string>{"c0", "c1"},
+      makeRowVector({
+          makeFlatVector<int64_t>({3, 10, 20, 500, 998}),
+          makeFlatVector<int32_t>({3, 3, 0, 3, 4}),
+      })));
+  spec->resetCachedValues(true);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  std::vector<int64_t> keys;
+  VectorPtr result;
+  while (rowReader->next(100, result) > 0) {
+    auto* rowVector = result->asUnchecked<RowVector>();
+    auto* c0 = rowVector->childAt(0)->loadedVector();
+    auto* c2 = rowVector->childAt(2)->loadedVector();
+    for (auto i = 0; i < result->size(); ++i) {
+      const auto key = c0->asUnchecked<SimpleVector<int64_t>>()->valueAt(i);
+      ASSERT_EQ(
+          c2->asUnchecked<SimpleVector<StringView>>()->valueAt(i),
+          StringView(fmt::format("s{}", key)));
+      keys.push_back(key);
+    }
+  }
+  ASSERT_EQ(keys, (std::vector<int64_t>{3, 10, 500}));
+}
+
 TEST_F(TestReader, reuseRowNumberColumn) {
   std::vector<std::vector<int32_t>> integerValues{{0, 1, 2, 3, 4}};
   auto batches = createBatches(integerValues);
@@ -2523,6 +2566,87 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
 
+TEST_F(TestReader, readRunLengthEncoded) {
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row / 100; }, nullEvery(250)),
+      makeFlatVector<double>(1'000, [](auto row) { return row; }),
+  });
+  auto [writer, reader] = createWriterReader({batch}, pool());
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  spec->childByName("c0")->setRunLengthEncode(true);
+  spec->childByName("c1")->setRunLengthEncode(true);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(rowType, 0, pool());
+  ASSERT_EQ(rowReader->next(1'000, actual), 1'000);
+  auto* c0 = actual->as<RowVector>()->childAt(0)->loadedVector();
+  ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+  // The runs of 10 values, split by 4 nulls.
+  ASSERT_EQ(c0->valueVector()->size(), 16);
+  auto* c1 = actual->as<RowVector>()->childAt(1)->loadedVector();
+  ASSERT_TRUE(c1->isFlatEncoding());
+  assertEqualVectors(batch, actual);
+}
+
+TEST_F(TestReader, reuseStringDictionaryAcrossStripes) {
+  constexpr int32_t kNumStripes = 4;
+  constexpr vector_size_t kStripeSize = 1'000;
+  std::vector<std::string> dictionary;
+  for (int i = 0; i < 26; ++i) {
+    dictionary.emplace_back(20 + i, 'a' + i);
+  }
+  // Each stripe has the same dictionary.
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < kNumStripes; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<std::string>(
+        kStripeSize,
+        [&](auto row) { return dictionary[row % dictionary.size()]; })}));
+  }
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, 1.0f);
+  auto [writer, reader] = createWriterReader(batches, pool(), config);
+  ASSERT_EQ(reader->getNumberOfStripes(), kNumStripes);
+
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  spec->childByName("c0")->setFilter(std::make_unique<common::BytesValues>(
+      std::vector<std::string>{dictionary[0], dictionary[1]}, false));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto batch = BaseVector::create(rowType, 0, pool());
+  std::vector<const BaseVector*> dictionaryBases;
+  vector_size_t numRows = 0;
+  while (rowReader->next(kStripeSize, batch) > 0) {
+    auto* c0 = batch->as<RowVector>()->childAt(0)->loadedVector();
+    for (auto i = 0; i < c0->size(); ++i) {
+      const auto value =
+          c0->asUnchecked<SimpleVector<StringView>>()->valueAt(i).str();
+      ASSERT_TRUE(value == dictionary[0] || value == dictionary[1]);
+    }
+    numRows += c0->size();
+    ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+    dictionaryBases.push_back(c0->valueVector().get());
+  }
+  // Rows 0 and 1 of every 26.
+  ASSERT_EQ(numRows, kNumStripes * 2 * 39);
+
+  // The stripes after the first share its dictionary base vector.
+  ASSERT_EQ(dictionaryBases.size(), kNumStripes);
+  for (const auto* base : dictionaryBases) {
+    ASSERT_EQ(base, dictionaryBases[0]);
+  }
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_EQ(
+      stats.columnReaderStatistics.reusedStringDictionaries, kNumStripes - 1);
+}
+
 // A primitive subfield is missing in file, and result is not reused.
 TEST_F(TestReader, missingSubfieldsNoResultReusing) {
   constexpr int kSize = 10;
@@ -2665,3 +2789,156 @@ TEST_F(TestReader, skipLongString) {
     validate(batch);
   }
 }
+
+TEST_F(TestReader, lazyVectorSeeksToRowGroupOfFirstRow) {
+  constexpr vector_size_t kSize = 10'000;
+  auto row = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<std::string>(
+          kSize, [](auto i) { return fmt::format("s{}", i); }),
+      makeFlatVector<double>(
+          kSize, [](auto i) { return i * 0.5; }, nullEvery(5)),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, 100u);
+  auto [writer, reader] = createWriterReader({row}, pool(), config);
+
+  auto schema = asRowType(row->type());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  spec->childByName("c0")->setFilter(
+      common::createBigintValues({255, 256, 3'701, 9'999}, false));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  // The first passing row of each batch is in a later row group than the
+  // start of the batch. The lazy vectors of 'c1' and 'c2' seek to the row
+  // group of their first row.
+  const std::vector<std::vector<int64_t>> expected = {
+      {255, 256, 3'701}, {9'999}};
+  VectorPtr batch = BaseVector::create(schema, 0, pool());
+  for (const auto& expectedKeys : expected) {
+    ASSERT_EQ(rowReader->next(5'000, batch), 5'000);
+    auto* rowVector = batch->asUnchecked<RowVector>();
+    ASSERT_EQ(rowVector->size(), expectedKeys.size());
+    auto* keys = rowVector->childAt(0)->loadedVector();
+    auto* strings = rowVector->childAt(1)->loadedVector();
+    auto* doubles = rowVector->childAt(2)->loadedVector();
+    for (auto i = 0; i < expectedKeys.size(); ++i) {
+      const auto key = expectedKeys[i];
+      ASSERT_EQ(keys->asUnchecked<SimpleVector<int64_t>>()->valueAt(i), key);
+      ASSERT_EQ(
+          strings->asUnchecked<SimpleVector<StringView>>()->valueAt(i),
+          StringView(fmt::format("s{}", key)));
+      ASSERT_EQ(doubles->isNullAt(i), key % 5 == 0);
+      if (!doubles->isNullAt(i)) {
+        ASSERT_EQ(
+            doubles->asUnchecked<SimpleVector<double>>()->valueAt(i),
+            key * 0.5);
+      }
+    }
+  }
+  ASSERT_EQ(rowReader->next(5'000, batch), 0);
+}
+
+TEST_F(TestReader, parallelStripes) {
+  constexpr int32_t kNumStripes = 8;
+  constexpr vector_size_t kStripeSize = 1'000;
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < kNumStripes; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kStripeSize, [&](auto row) { return i * kStripeSize + row; }),
+        makeFlatVector<std::string>(
+            kStripeSize,
+            [&](auto row) {
+              return fmt::format("s{}", i * kStripeSize + row);
+            }),
+    }));
+  }
+  auto [writer, reader] = createWriterReader(batches, pool());
+  ASSERT_EQ(reader->getNumberOfStripes(), kNumStripes);
+
+  auto schema = asRowType(batches[0]->type());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  rowReaderOpts.setParallelUnitDecoding(executor.get(), 4, 0.7);
+
+  // Reads the remaining rows of 'rowReader' and appends the keys to 'keys'.
+  auto readKeys = [](RowReader& rowReader,
+                     uint64_t batchSize,
+                     std::vector<int64_t>& keys,
+                     bool oneBatch = false) {
+    VectorPtr batch;
+    while (rowReader.next(batchSize, batch) > 0) {
+      ASSERT_LE(batch->size(), batchSize);
+      auto* rowVector = batch->asUnchecked<RowVector>();
+      auto* c0 = rowVector->childAt(0)->loadedVector();
+      auto* c1 = rowVector->childAt(1)->loadedVector();
+      for (auto i = 0; i < batch->size(); ++i) {
+        const auto key = c0->asUnchecked<SimpleVector<int64_t>>()->valueAt(i);
+        ASSERT_EQ(
+            c1->asUnchecked<SimpleVector<StringView>>()->valueAt(i),
+            StringView(fmt::format("s{}", key)));
+        keys.push_back(key);
+      }
+      if (oneBatch) {
+        return;
+      }
+    }
+  };
+  auto makeKeys = [](int64_t first, int64_t last) {
+    std::vector<int64_t> keys(last - first + 1);
+    std::iota(keys.begin(), keys.end(), first);
+    return keys;
+  };
+
+  {
+    SCOPED_TRACE("Filter");
+    spec->childByName("c0")->setFilter(
+        std::make_unique<common::BigintRange>(500, 6'499, false));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto* parallelReader =
+        dynamic_cast<ParallelDwrfRowReader*>(rowReader.get());
+    ASSERT_NE(parallelReader, nullptr);
+    std::vector<int64_t> keys;
+    readKeys(*rowReader, 300, keys);
+    ASSERT_EQ(keys, makeKeys(500, 6'499));
+    ASSERT_GT(parallelReader->testingNumParallelUnits(), 1);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    ASSERT_EQ(stats.numStripes, kNumStripes);
+  }
+
+  {
+    SCOPED_TRACE("Dynamic filter");
+    spec->childByName("c0")->setFilter(nullptr);
+    spec->resetCachedValues(false);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<int64_t> keys;
+    readKeys(*rowReader, 300, keys, true);
+    // The stripes decoded ahead do not have the new filter and are read
+    // again.
+    spec->childByName("c0")->setFilter(
+        std::make_unique<common::BigintRange>(0, 2'999, false));
+    spec->resetCachedValues(false);
+    rowReader->resetFilterCaches();
+    readKeys(*rowReader, 300, keys);
+    ASSERT_EQ(keys, makeKeys(0, 2'999));
+  }
+
+  {
+    SCOPED_TRACE("Smaller batches");
+    spec->childByName("c0")->setFilter(nullptr);
+    spec->resetCachedValues(false);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<int64_t> keys;
+    readKeys(*rowReader, 300, keys, true);
+    readKeys(*rowReader, 100, keys);
+    ASSERT_EQ(keys, makeKeys(0, kNumStripes * kStripeSize - 1));
+  }
+}
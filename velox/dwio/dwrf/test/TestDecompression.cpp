@@ -15,13 +15,19 @@
  */
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
 #include <folly/String.h>
 #include <folly/compression/Compression.h>
 #include <folly/compression/Zlib.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/dwio/common/DecompressedCacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
@@ -746,6 +752,283 @@ TEST_F(DecompressionTest, testMultiBuffer) {
   }
 }
 
+TEST_F(DecompressionTest, readDirect) {
+  constexpr int32_t N = 1024;
+  constexpr int32_t kNumBlocks = 4;
+  constexpr size_t kBlockBytes = N * sizeof(int32_t);
+  std::vector<int32_t> values(N * kNumBlocks);
+  for (int32_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+
+  // Each block of N values is compressed separately.
+  std::vector<char> input;
+  std::vector<uint64_t> blockOffsets;
+  for (int32_t block = 0; block < kNumBlocks; ++block) {
+    auto ioBuf =
+        folly::IOBuf::wrapBuffer(values.data() + block * N, kBlockBytes);
+    auto compressedBuf = getCodec(CodecType::SNAPPY)->compress(ioBuf.get());
+    const auto compressedSize = compressedBuf->length();
+    ASSERT_LT(compressedSize, kBlockBytes);
+    CompressBuffer compressBuffer(compressedSize);
+    memcpy(
+        compressBuffer.getCompressed(), compressedBuf->data(), compressedSize);
+    compressBuffer.writeHeader(compressedSize);
+    blockOffsets.push_back(input.size());
+    input.insert(
+        input.end(),
+        compressBuffer.getBuffer(),
+        compressBuffer.getBuffer() + compressBuffer.getBufferSize());
+  }
+
+  auto stream = createTestDecompressor(
+      CompressionKind_SNAPPY,
+      std::make_unique<SeekableArrayInputStream>(
+          input.data(), input.size(), 7),
+      kBlockBytes);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+
+  // The first 2 blocks are decompressed into 'result', the third is not
+  // complete and is decompressed into the buffer of the stream.
+  std::vector<int32_t> result(values.size());
+  const auto firstValues = 2 * N + 10;
+  readBytes(
+      firstValues * sizeof(int32_t),
+      stream.get(),
+      result.data(),
+      bufferStart,
+      bufferEnd);
+  ASSERT_EQ(stream->ByteCount(), 3 * kBlockBytes);
+  readBytes(
+      (values.size() - firstValues) * sizeof(int32_t),
+      stream.get(),
+      result.data() + firstValues,
+      bufferStart,
+      bufferEnd);
+  ASSERT_EQ(result, values);
+
+  // Seeks back into a block that was decompressed directly.
+  std::vector<uint64_t> positions{blockOffsets[1], 5 * sizeof(int32_t)};
+  stream = createTestDecompressor(
+      CompressionKind_SNAPPY,
+      std::make_unique<SeekableArrayInputStream>(
+          input.data(), input.size(), 7),
+      kBlockBytes);
+  bufferStart = nullptr;
+  bufferEnd = nullptr;
+  readBytes(
+      2 * kBlockBytes, stream.get(), result.data(), bufferStart, bufferEnd);
+  PositionProvider provider(positions);
+  stream->seekToPosition(provider);
+  const void* data;
+  int32_t size;
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, kBlockBytes - 5 * sizeof(int32_t));
+  ASSERT_EQ(reinterpret_cast<const int32_t*>(data)[0], N + 5);
+}
+
+TEST_F(DecompressionTest, decompressedCache) {
+  constexpr int32_t N = 1024;
+  constexpr int32_t kNumBlocks = 3;
+  constexpr size_t kBlockBytes = N * sizeof(int32_t);
+  std::vector<int32_t> values(N * kNumBlocks);
+  for (int32_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  std::vector<char> input;
+  std::vector<uint64_t> blockOffsets;
+  for (int32_t block = 0; block < kNumBlocks; ++block) {
+    auto ioBuf =
+        folly::IOBuf::wrapBuffer(values.data() + block * N, kBlockBytes);
+    auto compressedBuf = getCodec(CodecType::SNAPPY)->compress(ioBuf.get());
+    const auto compressedSize = compressedBuf->length();
+    CompressBuffer compressBuffer(compressedSize);
+    memcpy(
+        compressBuffer.getCompressed(), compressedBuf->data(), compressedSize);
+    compressBuffer.writeHeader(compressedSize);
+    blockOffsets.push_back(input.size());
+    input.insert(
+        input.end(),
+        compressBuffer.getBuffer(),
+        compressBuffer.getBuffer() + compressBuffer.getBufferSize());
+  }
+
+  memory::MmapAllocator::Options options;
+  options.capacity = 64 << 20;
+  auto allocator = std::make_shared<memory::MmapAllocator>(options);
+  auto cache = cache::AsyncDataCache::create(allocator.get());
+  StringIdLease fileId(fileIds(), "decompressedCache");
+  const auto key = DecompressedCacheInputStream::cacheKey(fileId.id(), 100);
+
+  auto readAll = [&](SeekableInputStream& stream) {
+    std::vector<int32_t> result(values.size());
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    readBytes(
+        result.size() * sizeof(int32_t),
+        &stream,
+        result.data(),
+        bufferStart,
+        bufferEnd);
+    return result;
+  };
+
+  // The first stream decompresses and adds the entry.
+  DecompressedCacheInputStream miss(
+      createTestDecompressor(
+          CompressionKind_SNAPPY,
+          std::make_unique<SeekableArrayInputStream>(
+              input.data(), input.size(), 100),
+          kBlockBytes),
+      cache.get(),
+      key,
+      "miss");
+  ASSERT_EQ(readAll(miss), values);
+  ASSERT_TRUE(cache->exists(key));
+
+  auto pin = cache->findOrCreate(key, 1);
+  ASSERT_TRUE(pin.checkedEntry()->isShared());
+  ASSERT_TRUE(pin.checkedEntry()->isDecompressed());
+  ASSERT_FALSE(pin.checkedEntry()->ssdSaveable());
+  DecompressedCacheInputStream hit(std::move(pin), "hit");
+  ASSERT_EQ(readAll(hit), values);
+
+  // Seeks by the positions of the compressed stream.
+  for (auto block = 0; block < kNumBlocks; ++block) {
+    std::vector<uint64_t> positions{blockOffsets[block], 8};
+    PositionProvider provider(positions);
+    hit.seekToPosition(provider);
+    ASSERT_EQ(hit.ByteCount(), block * kBlockBytes + 8);
+    const void* data;
+    int32_t size;
+    ASSERT_TRUE(hit.Next(&data, &size));
+    ASSERT_EQ(reinterpret_cast<const int32_t*>(data)[0], block * N + 2);
+  }
+  std::vector<uint64_t> positions{blockOffsets[1] + 1, 0};
+  PositionProvider provider(positions);
+  VELOX_ASSERT_THROW(hit.seekToPosition(provider), "Seek to no block start");
+}
+
+namespace {
+// Decompresses snappy blocks in software as a device would and fails on the
+// block number 'failBlock'.
+class TestAccelerator
+    : public dwio::common::compression::DecompressionAccelerator {
+ public:
+  bool supports(
+      CompressionKind kind,
+      const dwio::common::compression::CompressionOptions& /*options*/)
+      const override {
+    return kind == CompressionKind_SNAPPY;
+  }
+
+  uint64_t minInputBytes() const override {
+    return 64;
+  }
+
+  folly::SemiFuture<std::vector<folly::Try<uint64_t>>> decompress(
+      CompressionKind /*kind*/,
+      const dwio::common::compression::CompressionOptions& /*options*/,
+      const std::vector<dwio::common::compression::Decompressor::Block>& blocks)
+      override {
+    batchSizes.push_back(blocks.size());
+    std::vector<folly::Try<uint64_t>> results;
+    for (const auto& block : blocks) {
+      if (numBlocks++ == failBlock) {
+        results.emplace_back(
+            folly::make_exception_wrapper<std::runtime_error>("Failed"));
+        continue;
+      }
+      const auto decompressed = getCodec(CodecType::SNAPPY)
+                                    ->uncompress(folly::StringPiece(
+                                        block.src, block.srcLength));
+      memcpy(block.dest, decompressed.data(), decompressed.size());
+      offloadedBytes += block.srcLength;
+      results.emplace_back(decompressed.size());
+    }
+    return folly::makeSemiFuture(std::move(results));
+  }
+
+  std::vector<size_t> batchSizes;
+  int32_t numBlocks{0};
+  int32_t failBlock{-1};
+  uint64_t offloadedBytes{0};
+};
+} // namespace
+
+TEST_F(DecompressionTest, offload) {
+  constexpr int32_t N = 1024;
+  constexpr int32_t kNumBlocks = 4;
+  constexpr size_t kBlockBytes = N * sizeof(int32_t);
+  // The last block is all zeros and is too small to offload.
+  std::vector<int32_t> values(N * kNumBlocks);
+  for (int32_t i = 0; i < N * (kNumBlocks - 1); ++i) {
+    values[i] = i;
+  }
+  std::vector<char> input;
+  std::vector<uint64_t> compressedSizes;
+  for (int32_t block = 0; block < kNumBlocks; ++block) {
+    auto ioBuf =
+        folly::IOBuf::wrapBuffer(values.data() + block * N, kBlockBytes);
+    auto compressedBuf = getCodec(CodecType::SNAPPY)->compress(ioBuf.get());
+    const auto compressedSize = compressedBuf->length();
+    compressedSizes.push_back(compressedSize);
+    CompressBuffer compressBuffer(compressedSize);
+    memcpy(
+        compressBuffer.getCompressed(), compressedBuf->data(), compressedSize);
+    compressBuffer.writeHeader(compressedSize);
+    input.insert(
+        input.end(),
+        compressBuffer.getBuffer(),
+        compressBuffer.getBuffer() + compressBuffer.getBufferSize());
+  }
+  ASSERT_GE(compressedSizes[0], 64);
+  ASSERT_LT(compressedSizes.back(), 64);
+
+  auto accelerator = std::make_shared<TestAccelerator>();
+  accelerator->failBlock = 1;
+  dwio::common::compression::registerDecompressionAccelerator(accelerator);
+  auto guard = folly::makeGuard([&]() {
+    dwio::common::compression::registerDecompressionAccelerator(nullptr);
+  });
+
+  // readDirect() submits the 3 large blocks together and decompresses the
+  // small one and the one the device failed on in software.
+  auto stream = createTestDecompressor(
+      CompressionKind_SNAPPY,
+      std::make_unique<SeekableArrayInputStream>(input.data(), input.size()),
+      kBlockBytes);
+  std::vector<int32_t> result(values.size());
+  ASSERT_EQ(
+      stream->readDirect(
+          reinterpret_cast<char*>(result.data()), values.size() * 4),
+      values.size() * 4);
+  ASSERT_EQ(result, values);
+  ASSERT_EQ(accelerator->batchSizes, std::vector<size_t>{3});
+  ASSERT_EQ(
+      accelerator->offloadedBytes, compressedSizes[0] + compressedSizes[2]);
+
+  // Next() offloads one block at a time.
+  stream = createTestDecompressor(
+      CompressionKind_SNAPPY,
+      std::make_unique<SeekableArrayInputStream>(input.data(), input.size()),
+      kBlockBytes);
+  std::fill(result.begin(), result.end(), 0);
+  stream->readFully(reinterpret_cast<char*>(result.data()), values.size() * 4);
+  ASSERT_EQ(result, values);
+  ASSERT_EQ(accelerator->batchSizes, (std::vector<size_t>{3, 1, 1, 1}));
+
+  // The decompressors created after unregistering do not offload.
+  dwio::common::compression::registerDecompressionAccelerator(nullptr);
+  stream = createTestDecompressor(
+      CompressionKind_SNAPPY,
+      std::make_unique<SeekableArrayInputStream>(input.data(), input.size()),
+      kBlockBytes);
+  stream->readFully(reinterpret_cast<char*>(result.data()), values.size() * 4);
+  ASSERT_EQ(accelerator->batchSizes.size(), 4);
+}
+
 TEST_F(DecompressionTest, testSkipSnappy) {
   const int32_t N = 1024;
   std::vector<char> buf(N * sizeof(int));
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/SeekableInputStream.h"
@@ -673,6 +675,111 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+namespace {
+// Appends a DIRECT run of 'values' packed in 'width' bits to 'bytes'.
+void appendDirectRun(
+    const std::vector<uint64_t>& values,
+    uint32_t width,
+    std::vector<unsigned char>& bytes) {
+  static const std::vector<uint32_t> kWideWidths = {
+      26, 28, 30, 32, 40, 48, 56, 64};
+  uint32_t code = width - 1;
+  if (width > 24) {
+    code = 24 +
+        (std::find(kWideWidths.begin(), kWideWidths.end(), width) -
+         kWideWidths.begin());
+  }
+  const auto length = values.size() - 1;
+  bytes.push_back(0x40 | (code << 1) | (length >> 8));
+  bytes.push_back(length & 0xff);
+  uint64_t bitPos = 0;
+  for (auto value : values) {
+    for (int32_t bit = width - 1; bit >= 0; --bit, ++bitPos) {
+      if (bitPos % 8 == 0) {
+        bytes.push_back(0);
+      }
+      bytes.back() |= ((value >> bit) & 1) << (7 - bitPos % 8);
+    }
+  }
+}
+} // namespace
+
+TEST_F(RLEv2Test, directAllBitWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  std::mt19937 rng(1);
+  for (uint32_t width = 1; width <= 64; ++width) {
+    if (width > 24 && (width % 2 != 0 || (width > 32 && width % 8 != 0))) {
+      continue;
+    }
+    SCOPED_TRACE(fmt::format("width {}", width));
+    const uint64_t mask =
+        width == 64 ? ~0ULL : (static_cast<uint64_t>(1) << width) - 1;
+    std::vector<uint64_t> expected;
+    std::vector<unsigned char> bytes;
+    for (auto runLength : {512, 37, 1, 100}) {
+      std::vector<uint64_t> run(runLength);
+      for (auto& value : run) {
+        value = ((static_cast<uint64_t>(rng()) << 32) | rng()) & mask;
+      }
+      appendDirectRun(run, width, bytes);
+      expected.insert(expected.end(), run.begin(), run.end());
+    }
+
+    // Every third position is null when reading with nulls.
+    const size_t numRows = expected.size() * 3 / 2;
+    std::vector<uint64_t> nulls(bits::nwords(numRows));
+    for (size_t i = 0; i < numRows; ++i) {
+      bits::setNull(nulls.data(), i, i % 3 == 2);
+    }
+
+    // Small blocks make values cross the end of the buffer.
+    for (auto blockSize : {0, 13}) {
+      for (auto batchSize : {1, 7, 100, 1000}) {
+        for (bool withNulls : {false, true}) {
+          SCOPED_TRACE(fmt::format(
+              "block size {} batch size {} nulls {}",
+              blockSize,
+              batchSize,
+              withNulls));
+          auto rle = createRleDecoder<false>(
+              std::make_unique<dwio::common::SeekableArrayInputStream>(
+                  bytes.data(), bytes.size(), blockSize),
+              RleVersion_2,
+              *pool,
+              true /* doesn't matter */,
+              dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+          const size_t count = withNulls ? numRows : expected.size();
+          std::vector<int64_t> data(batchSize);
+          std::vector<uint64_t> batchNulls(bits::nwords(batchSize));
+          size_t numNonNulls = 0;
+          for (size_t row = 0; row < count; row += batchSize) {
+            const auto numRead = std::min<size_t>(batchSize, count - row);
+            if (withNulls) {
+              for (size_t i = 0; i < numRead; ++i) {
+                bits::setNull(
+                    batchNulls.data(),
+                    i,
+                    bits::isBitNull(nulls.data(), row + i));
+              }
+            }
+            rle->next(
+                data.data(), numRead, withNulls ? batchNulls.data() : nullptr);
+            for (size_t i = 0; i < numRead; ++i) {
+              if (withNulls && bits::isBitNull(batchNulls.data(), i)) {
+                continue;
+              }
+              ASSERT_EQ(static_cast<uint64_t>(data[i]), expected[numNonNulls])
+                  << "at " << numNonNulls;
+              ++numNonNulls;
+            }
+          }
+          ASSERT_EQ(numNonNulls, expected.size());
+        }
+      }
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
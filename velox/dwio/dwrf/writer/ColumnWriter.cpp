@@ -15,8 +15,13 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+
+#include <deque>
+#include <numeric>
+
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ExecutorBarrier.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -1729,26 +1734,92 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
+    if (encodeChildrenInParallel()) {
+      flushChildrenInParallel(encodingFactory);
+      return;
+    }
     for (auto& c : children_) {
       c->flush(encodingFactory);
     }
   }
 
  private:
+  // True if the top-level columns are encoded on the executor of the context.
+  bool encodeChildrenInParallel() const {
+    return isRoot() && children_.size() > 1 &&
+        context_.encodingExecutor() != nullptr;
+  }
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  uint64_t writeChildrenInParallel(
+      const RowVector* rowSlice,
+      const common::Ranges& ranges);
+
+  void flushChildrenInParallel(
+      const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory);
 };
 
+uint64_t StructColumnWriter::writeChildrenInParallel(
+    const RowVector* rowSlice,
+    const common::Ranges& ranges) {
+  // Lazy vectors are loaded on the calling thread.
+  for (const auto& child : rowSlice->children()) {
+    child->loadedVector();
+  }
+  std::vector<uint64_t> rawSizes(children_.size());
+  ExecutorBarrier barrier{
+      folly::getKeepAliveToken(context_.encodingExecutor())};
+  for (size_t i = 0; i < children_.size(); ++i) {
+    barrier.add([&, i]() {
+      rawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    });
+  }
+  barrier.waitAll();
+  return std::accumulate(rawSizes.begin(), rawSizes.end(), 0UL);
+}
+
+void StructColumnWriter::flushChildrenInParallel(
+    const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory) {
+  // The footer is not thread-safe, so each column collects its encodings and
+  // they are added to the footer in the same order as in a sequential flush.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      encodings(children_.size());
+  ExecutorBarrier barrier{
+      folly::getKeepAliveToken(context_.encodingExecutor())};
+  for (size_t i = 0; i < children_.size(); ++i) {
+    barrier.add([&, i]() {
+      children_[i]->flush(
+          [&encodings = encodings[i]](
+              uint32_t nodeId) -> proto::ColumnEncoding& {
+            return encodings.emplace_back(nodeId, proto::ColumnEncoding{})
+                .second;
+          });
+    });
+  }
+  barrier.waitAll();
+  for (auto& childEncodings : encodings) {
+    for (auto& [nodeId, encoding] : childEncodings) {
+      encodingFactory(nodeId).Swap(&encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (encodeChildrenInParallel()) {
+      rawSize = writeChildrenInParallel(rowSlice, ranges);
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
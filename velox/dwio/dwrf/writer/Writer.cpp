@@ -183,6 +183,10 @@ Writer::Writer(
       "Unexpected memory usage on dwrf writer construction");
   setMemoryReclaimers(pool);
   writerBase_->initBuffers();
+  if (options.encryptionSpec == nullptr) {
+    // Columns of an encryption group share their encrypter.
+    context.setEncodingExecutor(options.encodingExecutor);
+  }
 
   context.buildPhysicalSizeAggregators(*schema_);
   if (options.flushPolicyFactory == nullptr) {
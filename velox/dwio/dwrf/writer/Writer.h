@@ -45,6 +45,10 @@ struct WriterOptions : public dwio::common::WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
   DwrfFormat format{DwrfFormat::kDwrf};
+  /// If set, the top-level columns of each write and stripe flush are encoded
+  /// and compressed in parallel on this executor. Memory is still charged to
+  /// the writer pool. Ignored for encrypted files.
+  folly::Executor* encodingExecutor{nullptr};
 
   void processConfigs(
       const config::ConfigBase& connectorConfig,
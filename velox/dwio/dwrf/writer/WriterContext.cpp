@@ -102,6 +102,37 @@ void WriterContext::initBuffer() {
   }
 }
 
+std::unique_ptr<dwio::common::DataBuffer<char>> WriterContext::getBuffer(
+    uint64_t size) {
+  std::lock_guard<std::mutex> l(bufferMutex_);
+  if (compressionBuffer_ == nullptr && encodingExecutor_ != nullptr) {
+    if (!extraCompressionBuffers_.empty()) {
+      auto buffer = std::move(extraCompressionBuffers_.back());
+      extraCompressionBuffers_.pop_back();
+      VELOX_CHECK_GE(buffer->size(), size);
+      return buffer;
+    }
+    VELOX_CHECK_GE(compressionBlockSize_ + PAGE_HEADER_SIZE, size);
+    return std::make_unique<dwio::common::DataBuffer<char>>(
+        *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+  }
+  VELOX_CHECK_NOT_NULL(compressionBuffer_);
+  VELOX_CHECK_GE(compressionBuffer_->size(), size);
+  return std::move(compressionBuffer_);
+}
+
+void WriterContext::returnBuffer(
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer) {
+  VELOX_CHECK_NOT_NULL(buffer);
+  std::lock_guard<std::mutex> l(bufferMutex_);
+  if (compressionBuffer_ != nullptr && encodingExecutor_ != nullptr) {
+    extraCompressionBuffers_.push_back(std::move(buffer));
+    return;
+  }
+  VELOX_CHECK_NULL(compressionBuffer_);
+  compressionBuffer_ = std::move(buffer);
+}
+
 memory::MemoryPool& WriterContext::getMemoryPool(
     const MemoryUsageCategory& category) {
   switch (category) {
@@ -159,6 +190,7 @@ int64_t WriterContext::releaseMemoryReservation() {
 
 void WriterContext::abort() {
   compressionBuffer_.reset();
+  extraCompressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
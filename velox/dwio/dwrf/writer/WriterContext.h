@@ -17,6 +17,10 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -73,6 +77,7 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamMutex_);
     VELOX_CHECK(
         !hasStream(stream), "Stream already exists: {}", stream.toString());
 
@@ -114,6 +119,7 @@ class WriterContext : public CompressionBufferPool {
       const EncodingKey& encodingKey,
       velox::memory::MemoryPool& dictionaryPool,
       velox::memory::MemoryPool& generalPool) {
+    std::lock_guard<std::mutex> l(dictEncoderMutex_);
     auto result = dictEncoders_.find(encodingKey);
     if (result == dictEncoders_.end()) {
       auto emplaceResult = dictEncoders_.emplace(
@@ -256,18 +262,25 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the compression buffer. With an encoding executor, streams of
+  /// different columns compress concurrently and get an extra buffer from the
+  /// general pool while the shared one is in use.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
-      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
-    VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override;
+
+  /// Sets the executor on which the top-level columns are encoded and their
+  /// streams compressed in parallel. Each write() and stripe flush waits for
+  /// all of its columns. Columns are encoded sequentially on the calling
+  /// thread if 'executor' is null.
+  void setEncodingExecutor(folly::Executor* executor) {
+    encodingExecutor_ = executor;
+  }
+
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_;
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -583,6 +596,12 @@ class WriterContext : public CompressionBufferPool {
   }
 
   SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
+    if (encodingExecutor_ != nullptr) {
+      // Columns are decoded concurrently, so each thread has its own vector.
+      thread_local SelectivityVector threadSelectivityVector;
+      threadSelectivityVector.resize(size);
+      return threadSelectivityVector;
+    }
     if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
       selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
     } else {
@@ -609,6 +628,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(bufferMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -618,6 +638,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(bufferMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -659,11 +680,21 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Extra compression buffers allocated for concurrently compressed streams.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
   std::unique_ptr<velox::SelectivityVector> selectivityVector_;
 
+  folly::Executor* encodingExecutor_{nullptr};
+  // Guard the state shared by columns encoded in parallel on
+  // 'encodingExecutor_'.
+  std::mutex streamMutex_;
+  std::mutex dictEncoderMutex_;
+  std::mutex bufferMutex_;
+
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
   CompressionRatioTracker compressionRatioTracker_;
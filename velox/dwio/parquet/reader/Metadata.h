@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Builds Velox column statistics from Parquet 'statistics' covering
+/// 'numRows' rows. Used for column chunk as well as page level statistics.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& statistics,
+    const velox::Type& type,
+    uint64_t numRows);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -37,6 +48,27 @@ class ColumnChunkMetaDataPtr {
   /// Check the presence of the dictionary page offset in ColumnChunk metadata.
   bool hasDictionaryPageOffset() const;
 
+  /// Check the presence of the Bloom filter offset in ColumnChunk metadata.
+  bool hasBloomFilterOffset() const;
+
+  /// File offset of the Bloom filter header and bitset of the ColumnChunk.
+  /// Must check for its presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
+  /// Check the presence of the ColumnIndex and OffsetIndex (page index) of
+  /// the ColumnChunk.
+  bool hasPageIndex() const;
+
+  /// File offset and length of the serialized ColumnIndex. Must check for its
+  /// presence using hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// File offset and length of the serialized OffsetIndex. Must check for its
+  /// presence using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
   /// Return the ColumnChunk statistics.
   std::unique_ptr<dwio::common::ColumnStatistics> getColumnStatistics(
       const TypePtr type,
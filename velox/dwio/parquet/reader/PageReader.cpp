@@ -38,6 +38,43 @@ struct __attribute__((__packed__)) Int96Timestamp {
   uint64_t nanos;
 };
 
+namespace {
+// Decompresses 'compressedSize' bytes at 'data' into 'uncompressedSize' bytes
+// at 'result'.
+void decompress(
+    common::CompressionKind codec,
+    const char* data,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize,
+    const std::string& streamName,
+    memory::MemoryPool& pool,
+    char* result) {
+  std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          data, compressedSize, 0);
+  auto streamDebugInfo = fmt::format("Page Reader: Stream {}", streamName);
+  std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
+      dwio::common::compression::createDecompressor(
+          codec,
+          std::move(inputStream),
+          uncompressedSize,
+          pool,
+          getParquetDecompressionOptions(codec),
+          streamDebugInfo,
+          nullptr,
+          true,
+          compressedSize);
+  // The page is one block that is decompressed directly into 'result', which
+  // also lets a DecompressionAccelerator write into it.
+  const auto bytesRead =
+      decompressedStream->readDirect(result, uncompressedSize);
+  if (bytesRead < uncompressedSize) {
+    decompressedStream->readFully(
+        result + bytesRead, uncompressedSize - bytesRead);
+  }
+}
+} // namespace
+
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
@@ -50,7 +87,7 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
-    PageHeader pageHeader = readPageHeader();
+    PageHeader pageHeader = nextPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
     switch (pageHeader.type) {
@@ -62,11 +99,7 @@ void PageReader::seekToPage(int64_t row) {
         break;
       case thrift::PageType::DICTIONARY_PAGE:
         if (row == kRepDefOnly) {
-          skipBytes(
-              pageHeader.compressed_page_size,
-              inputStream_.get(),
-              bufferStart_,
-              bufferEnd_);
+          skipPageBytes(pageHeader.compressed_page_size);
           continue;
         }
         prepareDictionary(pageHeader);
@@ -105,6 +138,104 @@ PageHeader PageReader::readPageHeader() {
   return pageHeader;
 }
 
+PageHeader PageReader::nextPageHeader() {
+  if (decompressionExecutor_ == nullptr) {
+    return readPageHeader();
+  }
+  currentAheadPage_.reset();
+  readAheadPages();
+  currentAheadPage_ = std::move(aheadPages_.front());
+  aheadPages_.pop_front();
+  const auto& pageHeader = currentAheadPage_->header;
+  aheadBytes_ -=
+      pageHeader.compressed_page_size + pageHeader.uncompressed_page_size;
+  pageDataStart_ = currentAheadPage_->pageDataStart;
+  return pageHeader;
+}
+
+void PageReader::readAheadPages() {
+  while (aheadOffset_ < chunkSize_ &&
+         (aheadPages_.empty() || aheadBytes_ < maxDecompressionAheadBytes_)) {
+    AheadPage page;
+    page.header = readPageHeader();
+    // 'readPageHeader()' sets 'pageDataStart_' relative to 'pageStart_'. The
+    // header was read at 'aheadOffset_'.
+    page.pageDataStart = aheadOffset_ + pageDataStart_ - pageStart_;
+    const uint32_t compressedSize = page.header.compressed_page_size;
+    aheadOffset_ = page.pageDataStart + compressedSize;
+    page.compressed = AlignedBuffer::allocate<char>(compressedSize, &pool_);
+    dwio::common::readBytes(
+        compressedSize,
+        inputStream_.get(),
+        page.compressed->asMutable<char>(),
+        bufferStart_,
+        bufferEnd_);
+
+    // The levels of a V2 data page are not compressed.
+    uint32_t levelsSize = 0;
+    bool compressed = false;
+    switch (page.header.type) {
+      case thrift::PageType::DATA_PAGE:
+      case thrift::PageType::DICTIONARY_PAGE:
+        compressed = true;
+        break;
+      case thrift::PageType::DATA_PAGE_V2: {
+        const auto& v2Header = page.header.data_page_header_v2;
+        levelsSize = v2Header.definition_levels_byte_length +
+            v2Header.repetition_levels_byte_length;
+        compressed = v2Header.__isset.is_compressed &&
+            v2Header.is_compressed && compressedSize > levelsSize;
+        break;
+      }
+      default:
+        break;
+    }
+    if (compressed) {
+      const uint32_t uncompressedSize =
+          page.header.uncompressed_page_size - levelsSize;
+      page.decompressed =
+          AlignedBuffer::allocate<char>(uncompressedSize, &pool_);
+      page.barrier = std::make_unique<dwio::common::ExecutorBarrier>(
+          folly::getKeepAliveToken(decompressionExecutor_));
+      page.barrier->add([codec = codec_,
+                         source = page.compressed,
+                         result = page.decompressed,
+                         levelsSize,
+                         compressedSize,
+                         uncompressedSize,
+                         streamName = inputStream_->getName(),
+                         pool = &pool_]() {
+        decompress(
+            codec,
+            source->as<char>() + levelsSize,
+            compressedSize - levelsSize,
+            uncompressedSize,
+            streamName,
+            *pool,
+            result->asMutable<char>());
+      });
+    }
+    aheadBytes_ += compressedSize + page.header.uncompressed_page_size;
+    aheadPages_.push_back(std::move(page));
+  }
+  VELOX_CHECK(!aheadPages_.empty(), "Read past end of column chunk");
+}
+
+const char* PageReader::readPageBytes(int32_t size) {
+  if (!currentAheadPage_.has_value()) {
+    return readBytes(size, pageBuffer_);
+  }
+  pageBuffer_ = std::move(currentAheadPage_->compressed);
+  return pageBuffer_->as<char>();
+}
+
+void PageReader::skipPageBytes(int32_t size) {
+  if (!currentAheadPage_.has_value()) {
+    dwio::common::skipBytes(
+        size, inputStream_.get(), bufferStart_, bufferEnd_);
+  }
+}
+
 const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer = nullptr;
@@ -133,28 +264,21 @@ const char* PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
-  std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
-      std::make_unique<dwio::common::SeekableArrayInputStream>(
-          pageData, compressedSize, 0);
-  auto streamDebugInfo =
-      fmt::format("Page Reader: Stream {}", inputStream_->getName());
-  std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
-      dwio::common::compression::createDecompressor(
-          codec_,
-          std::move(inputStream),
-          uncompressedSize,
-          pool_,
-          getParquetDecompressionOptions(codec_),
-          streamDebugInfo,
-          nullptr,
-          true,
-          compressedSize);
-
+  if (currentAheadPage_.has_value() && currentAheadPage_->decompressed) {
+    currentAheadPage_->barrier->waitAll();
+    decompressedData_ = std::move(currentAheadPage_->decompressed);
+    return decompressedData_->as<char>();
+  }
   dwio::common::ensureCapacity<char>(
       decompressedData_, uncompressedSize, &pool_);
-  decompressedStream->readFully(
-      decompressedData_->asMutable<char>(), uncompressedSize);
-
+  decompress(
+      codec_,
+      pageData,
+      compressedSize,
+      uncompressedSize,
+      inputStream_->getName(),
+      pool_,
+      decompressedData_->asMutable<char>());
   return decompressedData_->as<char>();
 }
 
@@ -208,15 +332,10 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    dwio::common::skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
-
+    skipPageBytes(pageHeader.compressed_page_size);
     return;
   }
-  pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
+  pageData_ = readPageBytes(pageHeader.compressed_page_size);
   pageData_ = decompressData(
       pageData_,
       pageHeader.compressed_page_size,
@@ -264,11 +383,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
+    skipPageBytes(pageHeader.compressed_page_size);
     return;
   }
 
@@ -278,7 +393,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
       pageHeader.data_page_header_v2.repetition_levels_byte_length;
 
   auto bytes = pageHeader.compressed_page_size;
-  pageData_ = readBytes(bytes, pageBuffer_);
+  pageData_ = readPageBytes(bytes);
 
   if (repeatLength) {
     repeatDecoder_ = std::make_unique<RleDecoder>(
@@ -328,7 +443,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionaryEncoding_ == Encoding::PLAIN);
 
   if (codec_ != common::CompressionKind::CompressionKind_NONE) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
+    pageData_ = readPageBytes(pageHeader.compressed_page_size);
     pageData_ = decompressData(
         pageData_,
         pageHeader.compressed_page_size,
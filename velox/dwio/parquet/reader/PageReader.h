@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <deque>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
+#include "velox/dwio/common/ExecutorBarrier.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/common/RleEncodingInternal.h"
@@ -36,13 +39,20 @@ namespace facebook::velox::parquet {
 /// continuous stream accessible via readWithVisitor().
 class PageReader {
  public:
+  /// If 'decompressionExecutor' is set, up to about
+  /// 'maxDecompressionAheadBytes' of the pages following the current page are
+  /// read and decompressed on 'decompressionExecutor' while the current page
+  /// is decoded. This is done only for compressed columns that are not
+  /// repeated.
   PageReader(
       std::unique_ptr<dwio::common::SeekableInputStream> stream,
       memory::MemoryPool& pool,
       ParquetTypeWithIdPtr fileType,
       common::CompressionKind codec,
       int64_t chunkSize,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      folly::Executor* decompressionExecutor = nullptr,
+      uint64_t maxDecompressionAheadBytes = 0)
       : pool_(pool),
         inputStream_(std::move(stream)),
         type_(std::move(fileType)),
@@ -52,7 +62,13 @@ class PageReader {
         codec_(codec),
         chunkSize_(chunkSize),
         nullConcatenation_(pool_),
-        sessionTimezone_(sessionTimezone) {
+        sessionTimezone_(sessionTimezone),
+        decompressionExecutor_(
+            maxRepeat_ == 0 && maxDecompressionAheadBytes > 0 &&
+                    codec_ != common::CompressionKind::CompressionKind_NONE
+                ? decompressionExecutor
+                : nullptr),
+        maxDecompressionAheadBytes_(maxDecompressionAheadBytes) {
     type_->makeLevelInfo(leafInfo_);
   }
 
@@ -71,7 +87,9 @@ class PageReader {
         codec_(codec),
         chunkSize_(chunkSize),
         nullConcatenation_(pool_),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        decompressionExecutor_(nullptr),
+        maxDecompressionAheadBytes_(0) {}
 
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
@@ -183,6 +201,23 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Returns the header of the next page and sets 'pageDataStart_'. The page
+  // is taken from 'aheadPages_' if decompressing ahead and is otherwise read
+  // from 'inputStream_'.
+  thrift::PageHeader nextPageHeader();
+
+  // Reads pages from 'inputStream_' into 'aheadPages_' and schedules their
+  // decompression on 'decompressionExecutor_' until about
+  // 'maxDecompressionAheadBytes_' are queued or the column chunk ends. Reads
+  // at least one page if 'aheadPages_' is empty.
+  void readAheadPages();
+
+  // Returns the 'size' bytes of the current page. See readBytes().
+  const char* readPageBytes(int32_t size);
+
+  // Skips the 'size' bytes of the current page.
+  void skipPageBytes(int32_t size);
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -218,6 +253,8 @@ class PageReader {
   // Decompresses data starting at 'pageData_', consuming 'compressedsize' and
   // producing up to 'uncompressedSize' bytes. The start of the decoding
   // result is returned. an intermediate copy may be made in 'decompresseddata_'
+  // If the current page was decompressed ahead, waits for and returns the
+  // decompressed data.
   const char* decompressData(
       const char* pageData,
       uint32_t compressedSize,
@@ -513,6 +550,42 @@ class PageReader {
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
   std::unique_ptr<RleBpDataDecoder> rleBooleanDecoder_;
   // Add decoders for other encodings here.
+
+  // A page read ahead of decoding.
+  struct AheadPage {
+    thrift::PageHeader header;
+
+    // Offset of first byte after the page header from start of ColumnChunk.
+    uint64_t pageDataStart;
+
+    // Copy of the page as stored in the column chunk.
+    BufferPtr compressed;
+
+    // The decompressed page, or the decompressed data after the levels for a
+    // V2 data page. nullptr if the page is not decompressed ahead.
+    BufferPtr decompressed;
+
+    // Waits for the decompression into 'decompressed'.
+    std::unique_ptr<dwio::common::ExecutorBarrier> barrier;
+  };
+
+  // Executor for decompressing pages ahead of decoding. nullptr if not
+  // decompressing ahead.
+  folly::Executor* const decompressionExecutor_;
+  const uint64_t maxDecompressionAheadBytes_;
+
+  // Pages read after the current page, in order.
+  std::deque<AheadPage> aheadPages_;
+
+  // Sum of the compressed and uncompressed sizes of 'aheadPages_'.
+  uint64_t aheadBytes_{0};
+
+  // Offset of first byte after the last page read into 'aheadPages_' from
+  // start of ColumnChunk.
+  uint64_t aheadOffset_{0};
+
+  // The current page if taken from 'aheadPages_'.
+  std::optional<AheadPage> currentAheadPage_;
 };
 
 FOLLY_ALWAYS_INLINE dwio::common::compression::CompressionOptions
@@ -17,7 +17,11 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
 
 namespace facebook::velox::parquet {
 
@@ -25,7 +29,12 @@ std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), sessionTimezone_);
+      type,
+      metaData_,
+      pool(),
+      sessionTimezone_,
+      pageDecompressionExecutor_,
+      maxPageDecompressionAheadBytes_);
 }
 
 void ParquetData::filterRowGroups(
@@ -89,6 +98,254 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+namespace {
+
+// Returns the number of bytes consumed by 'result'.
+template <typename T>
+uint32_t readThriftStruct(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length,
+    T& result) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> buffer(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), buffer.data(), bufferStart, bufferEnd);
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      buffer.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  return result.read(&protocol);
+}
+
+// Limit on the number of values of a BigintRange probed in a Bloom filter.
+constexpr int64_t kMaxBloomFilterProbes = 64;
+
+// Upper bound on the serialized size of a thrift::BloomFilterHeader. The
+// header has one integer and three single field unions.
+constexpr int32_t kMaxBloomFilterHeaderSize = 64;
+
+// Appends the integer values that pass 'filter' to 'values'. Returns false if
+// the filter is not an equality or small IN-list filter.
+bool bigintFilterValues(
+    const common::Filter& filter,
+    std::vector<int64_t>& values) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(&filter);
+      if (range->upper() < range->lower() ||
+          static_cast<uint64_t>(range->upper()) -
+                  static_cast<uint64_t>(range->lower()) >=
+              kMaxBloomFilterProbes) {
+        return false;
+      }
+      const auto numValues = range->upper() - range->lower() + 1;
+      for (auto i = 0; i < numValues; ++i) {
+        values.push_back(range->lower() + i);
+      }
+      return true;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      values = static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+                   ->values();
+      return true;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      values =
+          static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+              ->values();
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Appends the string values that pass 'filter' to 'values'. Returns false if
+// the filter is not an equality or IN-list filter.
+bool bytesFilterValues(
+    const common::Filter& filter,
+    std::vector<std::string_view>& values) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(&filter);
+      if (!range->isSingleValue()) {
+        return false;
+      }
+      values.push_back(range->lower());
+      return true;
+    }
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues*>(&filter)->values()) {
+        values.push_back(value);
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    dwio::common::BufferedInput& input) {
+  auto* filter = scanSpec.filter();
+  if (!filter || filter->testNull() || maxRepeat_ > 0 ||
+      !type_->parquetType_.has_value()) {
+    return true;
+  }
+  const auto& type = type_->type();
+  const auto physicalType = type_->parquetType_.value();
+  std::vector<int64_t> bigintValues;
+  std::vector<std::string_view> bytesValues;
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+      if (physicalType != thrift::Type::INT32 ||
+          !bigintFilterValues(*filter, bigintValues)) {
+        return true;
+      }
+      break;
+    case TypeKind::BIGINT:
+      if (type->isDecimal() || physicalType != thrift::Type::INT64 ||
+          !bigintFilterValues(*filter, bigintValues)) {
+        return true;
+      }
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (physicalType != thrift::Type::BYTE_ARRAY ||
+          !bytesFilterValues(*filter, bytesValues)) {
+        return true;
+      }
+      break;
+    default:
+      return true;
+  }
+
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!columnChunk.hasBloomFilterOffset()) {
+    return true;
+  }
+  const auto offset = columnChunk.bloomFilterOffset();
+  const auto fileSize = input.getReadFile()->size();
+  if (offset < 0 || offset >= fileSize) {
+    return true;
+  }
+
+  // The footer does not record the size of the Bloom filter. Parse the header
+  // first to read exactly the header and bitset through 'input'.
+  thrift::BloomFilterHeader header;
+  const auto headerReadSize = static_cast<int32_t>(
+      std::min<uint64_t>(kMaxBloomFilterHeaderSize, fileSize - offset));
+  const auto headerSize =
+      readThriftStruct(input, offset, headerReadSize, header);
+  if (header.numBytes <= 0 ||
+      offset + headerSize + header.numBytes > fileSize) {
+    return true;
+  }
+  auto stream = input.read(
+      offset,
+      headerSize + header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  auto bloomFilter = BlockSplitBloomFilter::deserialize(stream.get(), pool_);
+
+  for (auto value : bigintValues) {
+    const auto hash = physicalType == thrift::Type::INT32
+        ? bloomFilter.hash(static_cast<int32_t>(value))
+        : bloomFilter.hash(value);
+    if (bloomFilter.findHash(hash)) {
+      return true;
+    }
+  }
+  for (auto value : bytesValues) {
+    ByteArray byteArray(value);
+    if (bloomFilter.findHash(bloomFilter.hash(&byteArray))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParquetData::filterDataPages(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    const dwio::common::StatsContext& writerContext,
+    dwio::common::BufferedInput& input,
+    std::vector<RowRange>& skippedRanges) {
+  auto* filter = scanSpec.filter();
+  if (!filter || maxRepeat_ > 0) {
+    return;
+  }
+  auto parquetStatsContext =
+      reinterpret_cast<const ParquetStatsContext*>(&writerContext);
+  if (type_->parquetType_.has_value() &&
+      parquetStatsContext->shouldIgnoreStatistics(
+          type_->parquetType_.value())) {
+    return;
+  }
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto columnChunk = rowGroup.columnChunk(type_->column());
+  if (!columnChunk.hasPageIndex()) {
+    return;
+  }
+
+  thrift::ColumnIndex columnIndex;
+  thrift::OffsetIndex offsetIndex;
+  readThriftStruct(
+      input,
+      columnChunk.columnIndexOffset(),
+      columnChunk.columnIndexLength(),
+      columnIndex);
+  readThriftStruct(
+      input,
+      columnChunk.offsetIndexOffset(),
+      columnChunk.offsetIndexLength(),
+      offsetIndex);
+
+  const auto& locations = offsetIndex.page_locations;
+  const auto numPages = locations.size();
+  if (columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages ||
+      (columnIndex.__isset.null_counts &&
+       columnIndex.null_counts.size() != numPages)) {
+    // Malformed index. Read all pages.
+    return;
+  }
+
+  const auto& type = type_->type();
+  for (auto i = 0; i < numPages; ++i) {
+    const int64_t begin = locations[i].first_row_index;
+    const int64_t end = i + 1 < numPages ? locations[i + 1].first_row_index
+                                         : rowGroup.numRows();
+    if (end <= begin) {
+      continue;
+    }
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(end - begin);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (columnIndex.__isset.null_counts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, end - begin);
+    if (!testFilter(filter, columnStats.get(), end - begin, type)) {
+      skippedRanges.push_back({begin, end});
+    }
+  }
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -126,7 +383,9 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       type_,
       metadata.compression(),
       metadata.totalCompressedSize(),
-      sessionTimezone_);
+      sessionTimezone_,
+      pageDecompressionExecutor_,
+      maxPageDecompressionAheadBytes_);
   return dwio::common::PositionProvider(empty);
 }
 
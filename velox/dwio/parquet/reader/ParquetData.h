@@ -37,11 +37,15 @@ class ParquetParams : public dwio::common::FormatParams {
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
       const tz::TimeZone* sessionTimezone,
-      TimestampPrecision timestampPrecision)
+      TimestampPrecision timestampPrecision,
+      folly::Executor* pageDecompressionExecutor = nullptr,
+      uint64_t maxPageDecompressionAheadBytes = 0)
       : FormatParams(pool, stats),
         metaData_(metaData),
         sessionTimezone_(sessionTimezone),
-        timestampPrecision_(timestampPrecision) {}
+        timestampPrecision_(timestampPrecision),
+        pageDecompressionExecutor_(pageDecompressionExecutor),
+        maxPageDecompressionAheadBytes_(maxPageDecompressionAheadBytes) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -54,6 +58,14 @@ class ParquetParams : public dwio::common::FormatParams {
   const FileMetaDataPtr metaData_;
   const tz::TimeZone* sessionTimezone_;
   const TimestampPrecision timestampPrecision_;
+  folly::Executor* const pageDecompressionExecutor_;
+  const uint64_t maxPageDecompressionAheadBytes_;
+};
+
+/// A range of rows [begin, end) relative to the start of a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -63,14 +75,18 @@ class ParquetData : public dwio::common::FormatData {
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      folly::Executor* pageDecompressionExecutor = nullptr,
+      uint64_t maxPageDecompressionAheadBytes = 0)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        pageDecompressionExecutor_(pageDecompressionExecutor),
+        maxPageDecompressionAheadBytes_(maxPageDecompressionAheadBytes) {}
 
   /// Prepares to read data for 'index'th row group.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
@@ -86,6 +102,28 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Reads the page index (ColumnIndex and OffsetIndex) of the column chunk in
+  /// row group 'index' from 'input' and appends to 'skippedRanges' the row
+  /// ranges covered by pages whose min/max/null count statistics cannot match
+  /// the filter in 'scanSpec'. Does nothing if there is no filter, no page
+  /// index or the column is repeated, as page boundaries of repeated columns
+  /// are not aligned on top level rows.
+  void filterDataPages(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      const dwio::common::StatsContext& writerContext,
+      dwio::common::BufferedInput& input,
+      std::vector<RowRange>& skippedRanges);
+
+  /// Reads the split-block Bloom filter of the column chunk in row group
+  /// 'index' from 'input' and returns false if none of the values accepted by
+  /// the equality or IN-list filter in 'scanSpec' is present in it. Returns
+  /// true if there is no such filter or the column chunk has no Bloom filter.
+  bool bloomFilterMatches(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      dwio::common::BufferedInput& input);
+
   PageReader* reader() const {
     return reader_.get();
   }
@@ -220,6 +258,10 @@ class ParquetData : public dwio::common::FormatData {
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
   const tz::TimeZone* sessionTimezone_;
+  // Executor and memory budget for decompressing pages ahead of decoding. See
+  // PageReader.
+  folly::Executor* const pageDecompressionExecutor_;
+  const uint64_t maxPageDecompressionAheadBytes_;
   std::unique_ptr<PageReader> reader_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
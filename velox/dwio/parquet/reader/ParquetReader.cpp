@@ -36,8 +36,113 @@ bool isParquetReservedKeyword(
       ? true
       : false;
 }
+
+// Reads and parses the footer of the Parquet file of 'input'.
+std::unique_ptr<thrift::FileMetaData> readFileMetaData(
+    dwio::common::BufferedInput& input,
+    uint64_t fileLength,
+    uint64_t footerEstimatedSize,
+    uint64_t filePreloadThreshold) {
+  bool preloadFile =
+      fileLength <= std::max(filePreloadThreshold, footerEstimatedSize);
+  uint64_t readSize = preloadFile ? fileLength : footerEstimatedSize;
+
+  std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  if (preloadFile) {
+    stream = input.loadCompleteFile();
+  } else {
+    stream = input.read(
+        fileLength - readSize, readSize, dwio::common::LogType::FOOTER);
+  }
+
+  std::vector<char> copy(readSize);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      readSize, stream.get(), copy.data(), bufferStart, bufferEnd);
+  VELOX_CHECK(
+      strncmp(copy.data() + readSize - 4, "PAR1", 4) == 0,
+      "No magic bytes found at end of the Parquet file");
+
+  uint32_t footerLength;
+  std::memcpy(&footerLength, copy.data() + readSize - 8, sizeof(uint32_t));
+  VELOX_CHECK_LE(footerLength + 12, fileLength);
+  int32_t footerOffsetInBuffer = readSize - 8 - footerLength;
+  if (footerLength > readSize - 8) {
+    footerOffsetInBuffer = 0;
+    auto missingLength = footerLength - readSize + 8;
+    stream = input.read(
+        fileLength - footerLength - 8,
+        missingLength,
+        dwio::common::LogType::FOOTER);
+    copy.resize(footerLength);
+    std::memmove(copy.data() + missingLength, copy.data(), readSize - 8);
+    bufferStart = nullptr;
+    bufferEnd = nullptr;
+    dwio::common::readBytes(
+        missingLength, stream.get(), copy.data(), bufferStart, bufferEnd);
+  }
+
+  std::shared_ptr<thrift::ThriftTransport> thriftTransport =
+      std::make_shared<thrift::ThriftBufferedTransport>(
+          copy.data() + footerOffsetInBuffer, footerLength);
+  auto thriftProtocol = std::make_unique<
+      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
+      thriftTransport);
+  auto fileMetaData = std::make_unique<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  return fileMetaData;
+}
+
+// Estimates the memory footprint of 'fileMetaData'. The column chunks of the
+// row groups take most of it.
+uint64_t estimateSize(const thrift::FileMetaData& fileMetaData) {
+  uint64_t size = sizeof(thrift::FileMetaData) + fileMetaData.created_by.size();
+  for (const auto& element : fileMetaData.schema) {
+    size += sizeof(element) + element.name.size();
+  }
+  for (const auto& rowGroup : fileMetaData.row_groups) {
+    size += sizeof(rowGroup);
+    for (const auto& column : rowGroup.columns) {
+      const auto& statistics = column.meta_data.statistics;
+      size += sizeof(column) + column.file_path.size() +
+          column.meta_data.encodings.size() * sizeof(thrift::Encoding::type) +
+          statistics.min_value.size() + statistics.max_value.size() +
+          statistics.min.size() + statistics.max.size();
+      for (const auto& name : column.meta_data.path_in_schema) {
+        size += sizeof(name) + name.size();
+      }
+    }
+  }
+  for (const auto& keyValue : fileMetaData.key_value_metadata) {
+    size += sizeof(keyValue) + keyValue.key.size() + keyValue.value.size();
+  }
+  return size;
+}
+
 } // namespace
 
+/// The parsed footer of a Parquet file in the FileMetadataCache.
+class ParquetFileMetadata : public dwio::common::FileMetadata {
+ public:
+  explicit ParquetFileMetadata(
+      std::unique_ptr<thrift::FileMetaData> fileMetaData)
+      : fileMetaData_(std::move(fileMetaData)),
+        estimatedSize_(estimateSize(*fileMetaData_)) {}
+
+  thrift::FileMetaData& fileMetaData() const {
+    return *fileMetaData_;
+  }
+
+  uint64_t estimatedSize() const override {
+    return estimatedSize_;
+  }
+
+ private:
+  const std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  const uint64_t estimatedSize_;
+};
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -83,10 +188,20 @@ class ReaderBase {
     return options_.sessionTimezone();
   }
 
+  bool readBloomFilters() const {
+    return options_.readBloomFilters();
+  }
+
   std::optional<SemanticVersion> version() const {
     return version_;
   }
 
+  /// True if the file metadata comes from the FileMetadataCache and must not
+  /// be modified.
+  bool sharedFileMetaData() const {
+    return sharedFileMetaData_;
+  }
+
   /// Ensures that streams are enqueued and loading for the row group at
   /// 'currentGroup'. May start loading one or more subsequent groups.
   void scheduleRowGroups(
@@ -105,7 +220,7 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
-  // Reads and parses file footer.
+  // Reads and parses file footer, or looks it up in the FileMetadataCache.
   void loadFileMetaData();
 
   void initializeSchema();
@@ -139,7 +254,10 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Owned by 'this' or by the FileMetadataCache.
+  std::shared_ptr<thrift::FileMetaData> fileMetaData_;
+  // True if 'fileMetaData_' is shared with the other readers of the file.
+  bool sharedFileMetaData_{false};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -168,54 +286,29 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
-  bool preloadFile =
-      fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
-  uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
-
-  std::unique_ptr<dwio::common::SeekableInputStream> stream;
-  if (preloadFile) {
-    stream = input_->loadCompleteFile();
-  } else {
-    stream = input_->read(
-        fileLength_ - readSize, readSize, dwio::common::LogType::FOOTER);
+  auto* cache = dwio::common::FileMetadataCache::getInstance();
+  const auto& key = options_.fileMetadataCacheKey();
+  if (cache == nullptr || !key.has_value()) {
+    fileMetaData_ = readFileMetaData(
+        *input_, fileLength_, footerEstimatedSize_, filePreloadThreshold_);
+    return;
   }
-
-  std::vector<char> copy(readSize);
-  const char* bufferStart = nullptr;
-  const char* bufferEnd = nullptr;
-  dwio::common::readBytes(
-      readSize, stream.get(), copy.data(), bufferStart, bufferEnd);
-  VELOX_CHECK(
-      strncmp(copy.data() + readSize - 4, "PAR1", 4) == 0,
-      "No magic bytes found at end of the Parquet file");
-
-  uint32_t footerLength;
-  std::memcpy(&footerLength, copy.data() + readSize - 8, sizeof(uint32_t));
-  VELOX_CHECK_LE(footerLength + 12, fileLength_);
-  int32_t footerOffsetInBuffer = readSize - 8 - footerLength;
-  if (footerLength > readSize - 8) {
-    footerOffsetInBuffer = 0;
-    auto missingLength = footerLength - readSize + 8;
-    stream = input_->read(
-        fileLength_ - footerLength - 8,
-        missingLength,
-        dwio::common::LogType::FOOTER);
-    copy.resize(footerLength);
-    std::memmove(copy.data() + missingLength, copy.data(), readSize - 8);
-    bufferStart = nullptr;
-    bufferEnd = nullptr;
-    dwio::common::readBytes(
-        missingLength, stream.get(), copy.data(), bufferStart, bufferEnd);
-  }
-
-  std::shared_ptr<thrift::ThriftTransport> thriftTransport =
-      std::make_shared<thrift::ThriftBufferedTransport>(
-          copy.data() + footerOffsetInBuffer, footerLength);
-  auto thriftProtocol = std::make_unique<
-      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
-      thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto cached =
+      std::make_shared<dwio::common::FileMetadataCachedPtr>(cache->get(
+          *key, [&]() -> std::unique_ptr<dwio::common::FileMetadata> {
+            return std::make_unique<ParquetFileMetadata>(readFileMetaData(
+                *input_,
+                fileLength_,
+                footerEstimatedSize_,
+                filePreloadThreshold_));
+          }));
+  auto* metadata = dynamic_cast<ParquetFileMetadata*>(cached->get());
+  VELOX_CHECK_NOT_NULL(
+      metadata, "Cached metadata of {} is not Parquet metadata", *key);
+  // Keeps the cache entry pinned while 'this' refers to it.
+  fileMetaData_ = std::shared_ptr<thrift::FileMetaData>(
+      cached, &metadata->fileMetaData());
+  sharedFileMetaData_ = true;
 }
 
 void ReaderBase::initializeSchema() {
@@ -952,7 +1045,9 @@ class ParquetRowReader::Impl {
         columnReaderStats_,
         readerBase_->fileMetaData(),
         readerBase->sessionTimezone(),
-        options_.timestampPrecision());
+        options_.timestampPrecision(),
+        options_.pageDecompressionExecutor(),
+        options_.maxPageDecompressionAheadBytes());
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -997,16 +1092,29 @@ class ParquetRowReader::Impl {
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
       auto isEmpty = rowGroups_[i].num_rows == 0;
 
+      // Probe the Bloom filters only for row groups that the statistics could
+      // not exclude.
+      if (rowGroupInRange && !isExcluded && !isEmpty &&
+          readerBase_->readBloomFilters() &&
+          !static_cast<StructColumnReader&>(*columnReader_)
+               .bloomFilterMatches(i, readerBase_->bufferedInput())) {
+        isExcluded = true;
+        ++bloomFilterSkippedStrides_;
+        bloomFilterSkippedRows_ += rowGroups_[i].num_rows;
+      }
+
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
       if (rowGroupInRange && !isExcluded && !isEmpty) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
       } else {
-        if (i != 0) {
+        if (i != 0 && !readerBase_->sharedFileMetaData()) {
           // Clear the metadata of row groups that are not read. This helps
           // reduce the memory consumption. ColumnChunks consume the most
           // memory. Skip the 0th RowGroup as it is used by estimatedRowSize().
+          // The metadata shared through the cache is kept for the other
+          // readers.
           rowGroups_[i].columns.clear();
         }
         if (rowGroupInRange) {
@@ -1019,9 +1127,14 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      if (!skipFilteredPages()) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -1031,7 +1144,11 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    uint64_t readEnd = rowsInCurrentRowGroup_;
+    if (nextSkippedRange_ < skippedRanges_.size()) {
+      readEnd = skippedRanges_[nextSkippedRange_].begin;
+    }
+    return std::min(size, readEnd - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -1071,6 +1188,9 @@ class ParquetRowReader::Impl {
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
+    stats.bloomFilterSkippedStrides += bloomFilterSkippedStrides_;
+    stats.bloomFilterSkippedRows += bloomFilterSkippedRows_;
   }
 
   void resetFilterCaches() {
@@ -1097,9 +1217,63 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    filterDataPages(nextRowGroupIndex);
     return true;
   }
 
+  // Computes 'skippedRanges_' for row group 'index' from the page indexes of
+  // the filtered columns. Since filters in ScanSpec are conjunctive, a row
+  // range can be skipped if any filtered column has a non-matching page
+  // there.
+  void filterDataPages(uint32_t index) {
+    skippedRanges_.clear();
+    nextSkippedRange_ = 0;
+    std::vector<RowRange> ranges;
+    static_cast<StructColumnReader&>(*columnReader_)
+        .filterDataPages(
+            index, parquetStatsContext_, readerBase_->bufferedInput(), ranges);
+    if (ranges.empty()) {
+      return;
+    }
+    std::sort(ranges.begin(), ranges.end(), [](auto& left, auto& right) {
+      return left.begin < right.begin;
+    });
+    skippedRanges_.push_back(ranges[0]);
+    for (auto i = 1; i < ranges.size(); ++i) {
+      auto& last = skippedRanges_.back();
+      if (ranges[i].begin <= last.end) {
+        last.end = std::max(last.end, ranges[i].end);
+      } else {
+        skippedRanges_.push_back(ranges[i]);
+      }
+    }
+  }
+
+  // Advances past the rows of the current row group that are known not to
+  // pass the filters from the page indexes. The column readers skip to the
+  // new read offset on their next read, which skips the pages in between
+  // without decompressing or decoding them. Returns true if rows were
+  // skipped.
+  bool skipFilteredPages() {
+    bool skipped = false;
+    while (nextSkippedRange_ < skippedRanges_.size() &&
+           skippedRanges_[nextSkippedRange_].begin <=
+               static_cast<int64_t>(currentRowInGroup_)) {
+      const auto end = std::min<uint64_t>(
+          skippedRanges_[nextSkippedRange_].end, rowsInCurrentRowGroup_);
+      ++nextSkippedRange_;
+      if (end <= currentRowInGroup_) {
+        continue;
+      }
+      const auto numSkipped = end - currentRowInGroup_;
+      columnReader_->setReadOffset(columnReader_->readOffset() + numSkipped);
+      currentRowInGroup_ = end;
+      skippedPageRows_ += numSkipped;
+      skipped = true;
+    }
+    return skipped;
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -1114,6 +1288,17 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
   uint32_t skippedStrides_{0};
+  // Row groups and rows in them skipped using the Bloom filters.
+  uint32_t bloomFilterSkippedStrides_{0};
+  int64_t bloomFilterSkippedRows_{0};
+
+  // Row ranges of the current row group that cannot pass the filters
+  // according to the page indexes. Sorted and non-overlapping.
+  std::vector<RowRange> skippedRanges_;
+  // Index of the first range in 'skippedRanges_' not yet skipped.
+  size_t nextSkippedRange_{0};
+  // Number of rows skipped using the page indexes.
+  int64_t skippedPageRows_{0};
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
@@ -1170,6 +1355,19 @@ ParquetReader::ParquetReader(
     const dwio::common::ReaderOptions& options)
     : readerBase_(std::make_shared<ReaderBase>(std::move(input), options)) {}
 
+std::unique_ptr<dwio::common::FileMetadata>
+ParquetReaderFactory::loadFileMetadata(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options) {
+  const auto fileLength = input->getReadFile()->size();
+  VELOX_CHECK_GE(fileLength, 12, "Parquet file is too small");
+  return std::make_unique<ParquetFileMetadata>(readFileMetaData(
+      *input,
+      fileLength,
+      options.footerEstimatedSize(),
+      options.filePreloadThreshold()));
+}
+
 std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->thriftFileMetaData().num_rows;
 }
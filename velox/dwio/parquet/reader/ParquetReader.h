@@ -119,6 +119,14 @@ class ParquetReaderFactory : public dwio::common::ReaderFactory {
       const dwio::common::ReaderOptions& options) override {
     return std::make_unique<ParquetReader>(std::move(input), options);
   }
+
+  bool cachesFileMetadata() const override {
+    return true;
+  }
+
+  std::unique_ptr<dwio::common::FileMetadata> loadFileMetadata(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override;
 };
 
 void registerParquetReaderFactory();
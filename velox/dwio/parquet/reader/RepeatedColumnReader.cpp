@@ -83,6 +83,34 @@ void skipUnreadLengthsAndNulls(dwio::common::SelectiveColumnReader& reader) {
   }
 }
 
+// Returns the leaf of 'type' that is reached through structs only, preferring
+// a leaf that is not a string, or nullptr if all leaves are inside repeated
+// types. The levels of such a leaf have the nulls and lengths of the list that
+// has 'type' as elements.
+std::shared_ptr<const dwio::common::TypeWithId> findLevelsLeaf(
+    const std::shared_ptr<const dwio::common::TypeWithId>& type) {
+  if (reinterpret_cast<const ParquetTypeWithId*>(type.get())->isLeaf()) {
+    return type;
+  }
+  if (type->type()->kind() != TypeKind::ROW) {
+    return nullptr;
+  }
+  std::shared_ptr<const dwio::common::TypeWithId> best;
+  for (auto i = 0; i < type->size(); ++i) {
+    auto leaf = findLevelsLeaf(type->childAt(i));
+    if (leaf == nullptr) {
+      continue;
+    }
+    if (!leaf->type()->isVarchar() && !leaf->type()->isVarbinary()) {
+      return leaf;
+    }
+    if (best == nullptr) {
+      best = std::move(leaf);
+    }
+  }
+  return best;
+}
+
 void enqueueChildren(
     dwio::common::SelectiveColumnReader* reader,
     uint32_t index,
@@ -228,9 +256,27 @@ ListColumnReader::ListColumnReader(
           fileType,
           params,
           scanSpec) {
-  auto& childType = requestedType->childAt(0);
-  child_ = ParquetColumnReader::build(
-      childType, fileType_->childAt(0), params, *scanSpec.children()[0]);
+  if (lengthsOnly()) {
+    // Only the levels are needed, so the child reads a single leaf of the
+    // elements and is only positioned past its values.
+    auto leaf = findLevelsLeaf(fileType_->childAt(0));
+    levelsSpec_ = std::make_unique<common::ScanSpec>(
+        leaf == nullptr ? scanSpec.children()[0]->fieldName()
+                        : reinterpret_cast<const ParquetTypeWithId*>(leaf.get())
+                              ->name_);
+    if (leaf == nullptr) {
+      // The elements are lists or maps whose leaves all have more levels than
+      // the elements.
+      leaf = fileType_->childAt(0);
+      levelsSpec_->addAllChildFields(*leaf->type());
+    }
+    child_ =
+        ParquetColumnReader::build(leaf->type(), leaf, params, *levelsSpec_);
+  } else {
+    auto& childType = requestedType->childAt(0);
+    child_ = ParquetColumnReader::build(
+        childType, fileType_->childAt(0), params, *scanSpec.children()[0]);
+  }
   reinterpret_cast<const ParquetTypeWithId*>(fileType.get())
       ->makeLevelInfo(levelInfo_);
   children_ = {child_.get()};
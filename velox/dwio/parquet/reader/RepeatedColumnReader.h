@@ -161,6 +161,8 @@ class ListColumnReader : public dwio::common::SelectiveListColumnReader {
  private:
   RepeatedLengths lengths_;
   LevelInfo levelInfo_;
+  // The scan spec of 'child_' if only the lengths and nulls are read.
+  std::unique_ptr<common::ScanSpec> levelsSpec_;
 };
 
 /// Sets nulls and lengths for 'reader' and its children for the
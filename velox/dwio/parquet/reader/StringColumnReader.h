@@ -21,6 +21,10 @@
 
 namespace facebook::velox::parquet {
 
+/// Reads string columns. Batches read from dictionary-encoded pages are
+/// returned as DictionaryVectors over the dictionary of the column chunk, and
+/// filter results are cached per dictionary entry. A batch that spans a
+/// dictionary-encoded and a plain page is returned flat.
 class StringColumnReader : public dwio::common::SelectiveColumnReader {
  public:
   using ValueType = StringView;
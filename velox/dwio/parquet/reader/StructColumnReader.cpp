@@ -202,4 +202,40 @@ void StructColumnReader::filterRowGroups(
   }
 }
 
+void StructColumnReader::filterDataPages(
+    uint32_t index,
+    const dwio::common::StatsContext& context,
+    dwio::common::BufferedInput& input,
+    std::vector<RowRange>& skippedRanges) const {
+  for (const auto& child : children_) {
+    if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
+      structChild->filterDataPages(index, context, input, skippedRanges);
+    } else if (
+        !dynamic_cast<ListColumnReader*>(child) &&
+        !dynamic_cast<MapColumnReader*>(child)) {
+      child->formatData().as<ParquetData>().filterDataPages(
+          index, *child->scanSpec(), context, input, skippedRanges);
+    }
+  }
+}
+
+bool StructColumnReader::bloomFilterMatches(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (const auto& child : children_) {
+    if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
+      if (!structChild->bloomFilterMatches(index, input)) {
+        return false;
+      }
+    } else if (
+        !dynamic_cast<ListColumnReader*>(child) &&
+        !dynamic_cast<MapColumnReader*>(child) &&
+        !child->formatData().as<ParquetData>().bloomFilterMatches(
+            index, *child->scanSpec(), input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace facebook::velox::parquet
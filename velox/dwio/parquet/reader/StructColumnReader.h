@@ -28,6 +28,7 @@ namespace facebook::velox::parquet {
 enum class LevelMode;
 class PageReader;
 class ParquetParams;
+struct RowRange;
 
 class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  public:
@@ -75,6 +76,22 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       const dwio::common::StatsContext&,
       dwio::common::FormatData::FilterRowGroupsResult&) const override;
 
+  /// Appends to 'skippedRanges' the row ranges of row group 'index' that
+  /// cannot pass the filters of the non-repeated leaf columns under 'this'
+  /// according to their page indexes. The ranges are not sorted and may
+  /// overlap.
+  void filterDataPages(
+      uint32_t index,
+      const dwio::common::StatsContext& context,
+      dwio::common::BufferedInput& input,
+      std::vector<RowRange>& skippedRanges) const;
+
+  /// Returns false if the Bloom filter of any filtered top level column
+  /// shows that no row in row group 'index' can pass the filters.
+  bool bloomFilterMatches(
+      uint32_t index,
+      dwio::common::BufferedInput& input) const;
+
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -944,6 +947,29 @@ TEST_F(ParquetReaderTest, readSampleEqualFilter) {
       "sample.parquet", sampleSchema(), std::move(filters), expected);
 }
 
+TEST_F(ParquetReaderTest, readBloomFiltersWithoutBloomFilter) {
+  // sample.parquet has no Bloom filters. Reading them must not skip any row
+  // group.
+  FilterMap filters;
+  filters.insert({"a", exec::equal(16)});
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(1, [](auto row) { return row + 16; }),
+      makeFlatVector<double>(1, [](auto row) { return row + 16; }),
+  });
+
+  const auto filePath(getExampleFilePath("sample.parquet"));
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  readerOpts.setReadBloomFilters(true);
+  auto reader = createReader(filePath, readerOpts);
+  assertReadWithReaderAndFilters(
+      std::move(reader),
+      "sample.parquet",
+      sampleSchema(),
+      std::move(filters),
+      expected);
+}
+
 TEST_F(ParquetReaderTest, dateFilters) {
   // Read date.parquet with the date filter "date BETWEEN 5 AND 14".
   FilterMap filters;
@@ -1691,3 +1717,238 @@ TEST_F(ParquetReaderTest, parquet251) {
   assertReadWithFilters(
       "parquet-251.parquet", rowType, std::move(filters), expected);
 }
+
+TEST_F(ParquetReaderTest, pageDecompressionAhead) {
+  auto rowType = ROW({"a", "b", "c"}, {BIGINT(), VARCHAR(), DOUBLE()});
+  constexpr vector_size_t kSize = 20'000;
+  auto data = makeRowVector(
+      {"a", "b", "c"},
+      {
+          makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              kSize, [](auto row) { return fmt::format("str{}", row % 997); }),
+          makeFlatVector<double>(
+              kSize, [](auto row) { return row * 0.5; }, nullEvery(7)),
+      });
+
+  const auto path =
+      fmt::format("{}/decompress_ahead.parquet", tempPath_->getPath());
+  WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.compressionKind = common::CompressionKind_SNAPPY;
+  writerOptions.dataPageSize = 4 * 1024;
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<LambdaFlushPolicy>(
+        kSize / 2, kBytesInRowGroup, []() { return false; });
+  };
+  auto writer =
+      std::make_unique<Writer>(createSink(path), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(path, readerOptions);
+  // A budget of 1 byte keeps one page ahead.
+  for (const uint64_t maxBytes : {1UL, 64UL << 10, 64UL << 20}) {
+    SCOPED_TRACE(fmt::format("maxBytes: {}", maxBytes));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    rowReaderOpts.setPageDecompressionAhead(executor.get(), maxBytes);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, data, *leafPool_);
+  }
+
+  // The pages of 'b' and 'c' before the rows passing the filter are skipped.
+  FilterMap filters;
+  filters.insert({"a", exec::between(15'000, 15'100)});
+  auto scanSpec = makeScanSpec(rowType);
+  for (auto&& [column, filter] : filters) {
+    scanSpec->getOrCreateChild(velox::common::Subfield(column))
+        ->setFilter(std::move(filter));
+  }
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  rowReaderOpts.setPageDecompressionAhead(executor.get(), 64 << 10);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto expected = makeRowVector(
+      {"a", "b", "c"},
+      {
+          data->childAt(0)->slice(15'000, 101),
+          data->childAt(1)->slice(15'000, 101),
+          data->childAt(2)->slice(15'000, 101),
+      });
+  assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+}
+
+TEST_F(ParquetReaderTest, dictionaryEncodedStrings) {
+  auto rowType = ROW({"a", "b"}, {VARCHAR(), BIGINT()});
+  constexpr vector_size_t kSize = 10'000;
+  auto data = makeRowVector(
+      {"a", "b"},
+      {
+          makeFlatVector<std::string>(
+              kSize, [](auto row) { return fmt::format("value{}", row % 20); }),
+          makeFlatVector<int64_t>(kSize, folly::identity),
+      });
+  const auto path =
+      fmt::format("{}/dictionary_strings.parquet", tempPath_->getPath());
+  WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  auto writer =
+      std::make_unique<Writer>(createSink(path), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(path, readerOptions);
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("a")->setFilter(
+      std::make_unique<velox::common::BytesValues>(
+          std::vector<std::string>{"value3", "value17"}, false));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  // The filtered column is returned as indices into the dictionary of the
+  // column chunk, which is the same vector in all batches.
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  const BaseVector* dictionary = nullptr;
+  vector_size_t numRows = 0;
+  while (rowReader->next(1'000, result) > 0) {
+    auto* rowVector = result->asUnchecked<RowVector>();
+    auto a = rowVector->childAt(0)->loadedVector();
+    auto b = rowVector->childAt(1)->loadedVector()->as<SimpleVector<int64_t>>();
+    ASSERT_EQ(a->encoding(), VectorEncoding::Simple::DICTIONARY);
+    if (dictionary == nullptr) {
+      dictionary = a->valueVector().get();
+    }
+    ASSERT_EQ(a->valueVector().get(), dictionary);
+    for (auto i = 0; i < rowVector->size(); ++i) {
+      ASSERT_EQ(
+          a->asUnchecked<SimpleVector<StringView>>()->valueAt(i).str(),
+          fmt::format("value{}", b->valueAt(i) % 20));
+    }
+    numRows += rowVector->size();
+  }
+  ASSERT_EQ(numRows, kSize / 10);
+}
+
+TEST_F(ParquetReaderTest, filterOnDictionaryRuns) {
+  // Runs of 100 equal values are written as RLE runs of dictionary indices.
+  auto rowType = ROW({"a", "b", "c"}, {BIGINT(), VARCHAR(), BIGINT()});
+  constexpr vector_size_t kSize = 10'000;
+  auto keyAt = [](auto row) { return row / 100 % 10; };
+  auto data = makeRowVector(
+      {"a", "b", "c"},
+      {
+          makeFlatVector<int64_t>(
+              kSize, [&](auto row) { return keyAt(row); }, nullEvery(7)),
+          makeFlatVector<std::string>(
+              kSize, [&](auto row) { return fmt::format("v{}", keyAt(row)); }),
+          makeFlatVector<int64_t>(kSize, folly::identity),
+      });
+  const auto path =
+      fmt::format("{}/dictionary_runs.parquet", tempPath_->getPath());
+  WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  auto writer =
+      std::make_unique<Writer>(createSink(path), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(path, readerOptions);
+  auto test = [&](FilterMap filters, std::function<bool(int64_t)> passes) {
+    std::vector<vector_size_t> expectedRows;
+    for (auto row = 0; row < kSize; ++row) {
+      if (passes(row)) {
+        expectedRows.push_back(row);
+      }
+    }
+    std::vector<VectorPtr> children;
+    for (auto& child : data->children()) {
+      children.push_back(BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(expectedRows),
+          expectedRows.size(),
+          child));
+    }
+    assertReadWithReaderAndFilters(
+        std::move(reader),
+        "",
+        rowType,
+        std::move(filters),
+        makeRowVector({"a", "b", "c"}, children));
+    reader = createReader(path, readerOptions);
+  };
+
+  FilterMap filters;
+  filters.insert({"a", exec::between(3, 4)});
+  test(std::move(filters), [&](auto row) {
+    return row % 7 != 0 && keyAt(row) >= 3 && keyAt(row) <= 4;
+  });
+
+  filters = {};
+  filters.insert({"b", exec::equal("v6")});
+  test(std::move(filters), [&](auto row) { return keyAt(row) == 6; });
+
+  // Filters on both dictionary columns.
+  filters = {};
+  filters.insert({"a", exec::lessThan(5)});
+  filters.insert({"b", exec::in(std::vector<std::string>{"v1", "v8"})});
+  test(std::move(filters), [&](auto row) {
+    return row % 7 != 0 && keyAt(row) == 1;
+  });
+}
+
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  FileMetadataCache cache(1 << 20);
+  FileMetadataCache::setInstance(&cache);
+  SCOPE_EXIT {
+    FileMetadataCache::setInstance(nullptr);
+  };
+
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  const auto key = FileMetadataCache::makeKey(sample, 1, 0);
+  folly::CPUThreadPoolExecutor executor(1);
+  ParquetReaderFactory factory;
+  cache.prefetch(
+      key,
+      [&]() {
+        return factory.loadFileMetadata(
+            std::make_unique<BufferedInput>(
+                std::make_shared<LocalReadFile>(sample), *leafPool_),
+            ReaderOptions{leafPool_.get()});
+      },
+      &executor);
+  executor.join();
+  ASSERT_EQ(cache.stats().numElements, 1);
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  // The first reader skips the second row group, whose metadata must be kept
+  // for the second reader of the whole file.
+  for (const auto numRows : {10, 20}) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFileMetadataCacheKey(key);
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    if (numRows == 10) {
+      rowReaderOpts.range(0, 200);
+    }
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        sampleSchema(),
+        *rowReader,
+        std::dynamic_pointer_cast<RowVector>(expected->slice(0, numRows)),
+        *leafPool_);
+  }
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numElements, 1);
+  ASSERT_EQ(stats.numHits, 2);
+}
@@ -1257,6 +1257,50 @@ TEST_F(ParquetTableScanTest, singleBooleanRle) {
   assertSelect({"c2"}, "SELECT c2 FROM tmp");
 }
 
+TEST_F(ParquetTableScanTest, pageIndexFilter) {
+  WriterOptions options;
+  options.enableDictionary = false;
+  options.dataPageSize = 1'024;
+  options.enablePageIndex = true;
+
+  constexpr vector_size_t kSize = 20'000;
+  auto vector = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              kSize, [](auto row) { return fmt::format("s{}", row % 97); }),
+      });
+  auto schema = asRowType(vector->type());
+  auto file = TempFilePath::create();
+  writeToParquetFile(file->getPath(), {vector}, options);
+  loadData(file->getPath(), schema, vector);
+
+  auto runQuery = [&](const std::vector<std::string>& filters,
+                      const std::string& sql) {
+    auto plan = PlanBuilder().tableScan(schema, filters).planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .split(makeSplit(file->getPath()))
+                    .assertResults(sql);
+    return task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats;
+  };
+
+  auto stats = runQuery(
+      {"c0 between 10000 and 10100"},
+      "SELECT c0, c1 FROM tmp WHERE c0 between 10000 and 10100");
+  ASSERT_GT(stats.at("skippedPageRows").sum, kSize / 2);
+
+  // Filters on both columns. Only the filter on c0 prunes pages.
+  stats = runQuery(
+      {"c0 >= 19000", "c1 = 's5'"},
+      "SELECT c0, c1 FROM tmp WHERE c0 >= 19000 AND c1 = 's5'");
+  ASSERT_GT(stats.at("skippedPageRows").sum, kSize / 2);
+
+  // No page can be skipped.
+  stats = runQuery({"c0 >= 0"}, "SELECT c0, c1 FROM tmp");
+  ASSERT_EQ(stats.count("skippedPageRows"), 0);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::Init init{&argc, &argv, false};
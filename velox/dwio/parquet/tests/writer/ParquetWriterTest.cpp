@@ -30,6 +30,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/expression/ExprToSubfieldFilter.h"
 
 namespace {
 
@@ -148,6 +149,169 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, columnChunksFromVectors) {
+  // The primitive columns are written from flat, dictionary and constant
+  // vectors without conversion to Arrow. The array column goes through Arrow.
+  // Row groups of 12'000 rows span the batches of 10'000 rows.
+  const vector_size_t kBatchRows = 10'000;
+  const int kNumBatches = 3;
+  const vector_size_t kRows = kBatchRows * kNumBatches;
+  auto nullEvery = [](int n) {
+    return [n](auto row) { return row % n == 0; };
+  };
+  const auto expected = makeRowVector({
+      makeFlatVector<bool>(
+          kRows, [](auto row) { return row % 3 == 0; }, nullEvery(7)),
+      makeFlatVector<int8_t>(kRows, [](auto row) { return row % 100; }),
+      makeConstant<int16_t>(123, kRows),
+      makeFlatVector<int32_t>(
+          kRows, [](auto row) { return row * 3; }, nullEvery(11)),
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row - 1'000; }),
+      makeFlatVector<float>(
+          kRows, [](auto row) { return row / 4.0; }, nullEvery(13)),
+      makeFlatVector<double>(
+          kRows, [](auto row) { return row / 8.0; }, nullEvery(5)),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return std::string(row % 30, 'a' + row % 26); },
+          nullEvery(17)),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return fmt::format("binary value {}", row % 50); },
+          nullptr,
+          VARBINARY()),
+      makeFlatVector<int32_t>(
+          kRows, [](auto row) { return row; }, nullEvery(19), DATE()),
+      makeArrayVector<int32_t>(
+          kRows,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; },
+          nullEvery(23)),
+  });
+  const auto schema = asRowType(expected->type());
+  // Columns passed as dictionaries.
+  const std::unordered_set<int> dictionaryColumns = {1, 6, 8};
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(12'000, 1L << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    std::vector<VectorPtr> children;
+    for (auto i = 0; i < schema->size(); ++i) {
+      auto child =
+          expected->childAt(i)->slice(batch * kBatchRows, kBatchRows);
+      if (dictionaryColumns.count(i)) {
+        child = BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndices(kBatchRows, [](auto row) { return row; }),
+            kBatchRows,
+            child);
+      }
+      children.push_back(child);
+    }
+    writer->write(makeRowVector(schema->names(), children));
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  ASSERT_EQ(*reader->rowType(), *schema);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 3);
+
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, bloomFilterAndPageIndexFromTableProperties) {
+  const vector_size_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 2; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value {}", row * 2); }),
+      makeFlatVector<int32_t>(kRows, [](auto row) { return row; }),
+  });
+  const auto schema = asRowType(data->type());
+
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.serdeParameters = {
+      {parquet::WriterOptions::kParquetBloomFilterColumns, "c0, c1"},
+      {parquet::WriterOptions::kParquetBloomFilterExpectedNdv, "20000"},
+      {parquet::WriterOptions::kParquetBloomFilterFpp, "0.01"},
+      {parquet::WriterOptions::kParquetPageIndexColumns, "c2"},
+      {parquet::WriterOptions::kParquetBlockRowCount, "2500"},
+  };
+  const config::ConfigBase connectorConfig({});
+  const config::ConfigBase connectorSessionProperties({});
+  writerOptions.processConfigs(connectorConfig, connectorSessionProperties);
+  ASSERT_EQ(writerOptions.columnBloomFiltersMap.size(), 2);
+  ASSERT_EQ(writerOptions.columnBloomFiltersMap.at("c0").ndv, 20'000);
+  ASSERT_EQ(writerOptions.columnBloomFiltersMap.at("c1").fpp, 0.01);
+  ASSERT_TRUE(writerOptions.columnPageIndexesMap.at("c2"));
+  ASSERT_EQ(writerOptions.rowGroupRows, 2'500);
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  auto writer = std::make_unique<parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setReadBloomFilters(true);
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  const auto& fileMetaData = reader->fileMetaData();
+  ASSERT_EQ(fileMetaData.numRowGroups(), 4);
+  for (auto i = 0; i < fileMetaData.numRowGroups(); ++i) {
+    auto rowGroup = fileMetaData.rowGroup(i);
+    ASSERT_TRUE(rowGroup.columnChunk(0).hasBloomFilterOffset());
+    ASSERT_TRUE(rowGroup.columnChunk(1).hasBloomFilterOffset());
+    ASSERT_FALSE(rowGroup.columnChunk(2).hasBloomFilterOffset());
+    ASSERT_FALSE(rowGroup.columnChunk(0).hasPageIndex());
+    ASSERT_FALSE(rowGroup.columnChunk(1).hasPageIndex());
+    ASSERT_TRUE(rowGroup.columnChunk(2).hasPageIndex());
+  }
+
+  // 1'001 is within the min and max of the first row group but is not in the
+  // column, so the Bloom filter skips the row group.
+  auto scanSpec = makeScanSpec(schema);
+  scanSpec->childByName("c0")->setFilter(exec::equal(1'001));
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr result = BaseVector::create(schema, 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(kRows, result), 0);
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_EQ(stats.bloomFilterSkippedStrides, 1);
+
+  // A present value is still found.
+  reader = createReaderInMemory(*sinkPtr, readerOptions);
+  scanSpec = makeScanSpec(schema);
+  scanSpec->childByName("c0")->setFilter(exec::equal(1'000));
+  rowReaderOpts.setScanSpec(scanSpec);
+  rowReader = reader->createRowReader(rowReaderOpts);
+  assertReadWithReaderAndExpected(
+      schema,
+      *rowReader,
+      makeRowVector(
+          {makeFlatVector<int64_t>({1'000}),
+           makeFlatVector<std::string>({"value 1000"}),
+           makeFlatVector<int32_t>({500})}),
+      *leafPool_);
+}
+
 TEST_F(ParquetWriterTest, testPageSizeAndBatchSizeConfiguration) {
   const auto schema = ROW({"c0"}, {SMALLINT()});
   constexpr int64_t kRows = 10'000;
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/ColumnChunkWriter.h"
+
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+bool canWriteColumnChunk(const TypePtr& type) {
+  static const std::vector<TypePtr> kTypes = {
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      DATE()};
+  return std::any_of(kTypes.begin(), kTypes.end(), [&](const auto& other) {
+    return other->equivalent(*type);
+  });
+}
+
+namespace {
+
+template <typename ParquetT, typename T>
+ParquetT toParquetValue(const DecodedVector& decoded, vector_size_t row) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    // Refers to the StringView in the base vector, which also holds the inlined
+    // strings.
+    const auto& value = decoded.data<StringView>()[decoded.index(row)];
+    return arrow::ByteArray(
+        value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+  } else {
+    return static_cast<ParquetT>(decoded.valueAt<T>(row));
+  }
+}
+
+// Writes rows [begin, end) of 'decoded' into 'columnWriter'.
+template <typename ParquetType, typename T>
+void writeRows(
+    DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end,
+    arrow::ColumnWriter& columnWriter,
+    std::vector<int16_t>& defLevels) {
+  using ParquetT = typename ParquetType::c_type;
+  auto* writer =
+      dynamic_cast<arrow::TypedColumnWriter<ParquetType>*>(&columnWriter);
+  VELOX_CHECK_NOT_NULL(
+      writer,
+      "Unexpected Parquet physical type {} for {}",
+      arrow::TypeToString(columnWriter.type()),
+      decoded.base()->type()->toString());
+
+  const auto numRows = end - begin;
+  const bool optional = writer->descr()->max_definition_level() > 0;
+  vector_size_t numValues = numRows;
+  if (optional) {
+    defLevels.resize(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      const bool isNull = decoded.isNullAt(begin + i);
+      defLevels[i] = isNull ? 0 : 1;
+      numValues -= isNull;
+    }
+  } else if (decoded.mayHaveNulls()) {
+    for (auto row = begin; row < end; ++row) {
+      VELOX_CHECK(
+          !decoded.isNullAt(row), "Null value in a required Parquet column");
+    }
+  }
+  const int16_t* levels = optional ? defLevels.data() : nullptr;
+
+  // Velox stores booleans as bits, the other primitive types of the same
+  // width as their Parquet physical values.
+  if constexpr (std::is_same_v<T, ParquetT> && !std::is_same_v<T, bool>) {
+    if (decoded.isIdentityMapping() && decoded.data<T>() != nullptr) {
+      const auto* values = decoded.data<T>() + begin;
+      if (numValues < numRows) {
+        writer->WriteBatchSpaced(
+            numRows,
+            levels,
+            nullptr,
+            reinterpret_cast<const uint8_t*>(decoded.nulls()),
+            begin,
+            values);
+      } else {
+        writer->WriteBatch(numRows, levels, nullptr, values);
+      }
+      return;
+    }
+  }
+
+  auto values = std::make_unique<ParquetT[]>(numValues);
+  vector_size_t numCopied = 0;
+  for (auto row = begin; row < end; ++row) {
+    if (!decoded.isNullAt(row)) {
+      values[numCopied++] = toParquetValue<ParquetT, T>(decoded, row);
+    }
+  }
+  writer->WriteBatch(numRows, levels, nullptr, values.get());
+}
+
+void writeVector(
+    const BaseVector& vector,
+    vector_size_t begin,
+    vector_size_t end,
+    arrow::ColumnWriter& writer,
+    DecodedVector& decoded,
+    std::vector<int16_t>& defLevels) {
+  decoded.decode(vector);
+  switch (vector.typeKind()) {
+    case TypeKind::BOOLEAN:
+      return writeRows<arrow::BooleanType, bool>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::TINYINT:
+      return writeRows<arrow::Int32Type, int8_t>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::SMALLINT:
+      return writeRows<arrow::Int32Type, int16_t>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::INTEGER:
+      return writeRows<arrow::Int32Type, int32_t>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::BIGINT:
+      return writeRows<arrow::Int64Type, int64_t>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::REAL:
+      return writeRows<arrow::FloatType, float>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::DOUBLE:
+      return writeRows<arrow::DoubleType, double>(
+          decoded, begin, end, writer, defLevels);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return writeRows<arrow::ByteArrayType, StringView>(
+          decoded, begin, end, writer, defLevels);
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported type for Parquet column chunk writer: {}",
+          vector.type()->toString());
+  }
+}
+
+} // namespace
+
+void writeColumnChunk(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t numRows,
+    arrow::ColumnWriter& writer) {
+  VELOX_CHECK_EQ(
+      writer.descr()->max_repetition_level(),
+      0,
+      "Only top-level Parquet columns are written from Velox vectors");
+  DecodedVector decoded;
+  std::vector<int16_t> defLevels;
+  const auto endRow = offset + numRows;
+  int64_t firstRow = 0;
+  for (const auto& vector : vectors) {
+    if (firstRow >= endRow) {
+      break;
+    }
+    const auto begin = std::max(offset, firstRow);
+    const auto end = std::min(endRow, firstRow + vector->size());
+    if (begin < end) {
+      writeVector(
+          *vector,
+          begin - firstRow,
+          end - firstRow,
+          writer,
+          decoded,
+          defLevels);
+    }
+    firstRow += vector->size();
+  }
+  writer.Close();
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace arrow {
+class ColumnWriter;
+}
+
+/// Returns true if top-level columns of 'type' are written by
+/// writeColumnChunk() directly from Velox vectors instead of being converted
+/// to Arrow arrays first. These are the primitive types whose Parquet physical
+/// values are the Velox values, possibly widened.
+bool canWriteColumnChunk(const TypePtr& type);
+
+/// Writes rows [offset, offset + numRows) of the concatenation of 'vectors'
+/// into 'writer' and closes it. 'vectors' are the values of a top-level column
+/// of a type accepted by canWriteColumnChunk(). Flat vectors are written
+/// without copying their values. Dictionary and constant vectors are written
+/// from their base vectors without flattening them first.
+void writeColumnChunk(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t numRows,
+    arrow::ColumnWriter& writer);
+
+} // namespace facebook::velox::parquet
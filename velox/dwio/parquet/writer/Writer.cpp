@@ -18,10 +18,12 @@
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include <folly/String.h>
 #include "velox/common/base/Pointers.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/dwio/parquet/writer/ColumnChunkWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -105,6 +107,9 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // columns, Vectors. Used instead of 'stagingChunks' for the columns written
+  // directly from Velox vectors.
+  std::vector<std::vector<VectorPtr>> stagingVectors;
 };
 
 Compression::type getArrowParquetCompression(
@@ -150,6 +155,20 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
   properties = properties->enable_store_decimal_as_integer();
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
+  for (const auto& [path, enabled] : options.columnPageIndexesMap) {
+    if (enabled) {
+      properties->enable_write_page_index(path);
+    } else {
+      properties->disable_write_page_index(path);
+    }
+  }
+  for (const auto& [path, bloomFilterOptions] :
+       options.columnBloomFiltersMap) {
+    properties->enable_bloom_filter(path, bloomFilterOptions);
+  }
   if (options.useParquetDataPageV2.value_or(false)) {
     properties =
         properties->data_page_version(arrow::ParquetDataPageVersion::V2);
@@ -285,6 +304,48 @@ std::optional<int64_t> getParquetBatchSize(
   return std::nullopt;
 }
 
+std::optional<std::string> getTableProperty(
+    const std::map<std::string, std::string>& properties,
+    const char* key) {
+  const auto it = properties.find(key);
+  if (it == properties.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+template <typename T>
+std::optional<T> getNumericTableProperty(
+    const std::map<std::string, std::string>& properties,
+    const char* key) {
+  if (const auto value = getTableProperty(properties, key)) {
+    try {
+      return folly::to<T>(value.value());
+    } catch (const folly::ConversionError& e) {
+      VELOX_USER_FAIL(
+          "Invalid value for parquet table property {}: {}", key, e.what());
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string> getColumnsTableProperty(
+    const std::map<std::string, std::string>& properties,
+    const char* key) {
+  std::vector<std::string> columns;
+  if (const auto value = getTableProperty(properties, key)) {
+    std::vector<folly::StringPiece> parts;
+    folly::split(',', value.value(), parts);
+    for (const auto& part : parts) {
+      const auto column = folly::trimWhitespace(part);
+      if (!column.empty()) {
+        columns.push_back(column.str());
+      }
+    }
+  }
+  return columns;
+}
+
 } // namespace
 
 Writer::Writer(
@@ -305,7 +366,11 @@ Writer::Writer(
   if (options.flushPolicyFactory) {
     castUniquePointer(options.flushPolicyFactory(), flushPolicy_);
   } else {
-    flushPolicy_ = std::make_unique<DefaultFlushPolicy>();
+    flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
+        options.rowGroupRows.value_or(
+            DefaultFlushPolicy::kDefaultRowsInRowGroup),
+        options.rowGroupBytes.value_or(
+            DefaultFlushPolicy::kDefaultBytesInRowGroup));
   }
   options_.timestampUnit =
       static_cast<TimestampUnit>(options.parquetWriteTimestampUnit.value_or(
@@ -315,6 +380,9 @@ Writer::Writer(
       "facebook::velox::parquet::Writer::Writer", &options_);
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  for (const auto& type : schema_->children()) {
+    vectorColumns_.push_back(canWriteColumnChunk(type));
+  }
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
 }
@@ -350,25 +418,46 @@ void Writer::flush() {
     }
 
     auto fields = arrowContext_->schema->fields();
-    std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
+    std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks(fields.size());
     for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+      if (vectorColumns_[colIdx]) {
+        continue;
+      }
       auto dataType = fields.at(colIdx)->type();
-      auto chunk =
+      chunks[colIdx] =
           ::arrow::ChunkedArray::Make(
               std::move(arrowContext_->stagingChunks.at(colIdx)), dataType)
               .ValueOrDie();
-      chunks.push_back(chunk);
     }
-    auto table = ::arrow::Table::Make(
-        arrowContext_->schema,
-        std::move(chunks),
-        static_cast<int64_t>(arrowContext_->stagingRows));
-    PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
-        *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
+
+    // Writes row groups of at most 'rowsInRowGroup' rows like
+    // FileWriter::WriteTable() but writes the columns accepted by
+    // canWriteColumnChunk() from the staged Velox vectors.
+    const int64_t numRows = arrowContext_->stagingRows;
+    const int64_t rowsInRowGroup = flushPolicy_->rowsInRowGroup();
+    for (int64_t offset = 0; offset < numRows; offset += rowsInRowGroup) {
+      const auto size = std::min(rowsInRowGroup, numRows - offset);
+      PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(size));
+      for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+        if (vectorColumns_[colIdx]) {
+          writeColumnChunk(
+              arrowContext_->stagingVectors[colIdx],
+              offset,
+              size,
+              *arrowContext_->writer->NextColumnWriter());
+        } else {
+          PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteColumnChunk(
+              chunks[colIdx], offset, size));
+        }
+      }
+    }
     PARQUET_THROW_NOT_OK(stream_->Flush());
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
     }
+    for (auto& vectors : arrowContext_->stagingVectors) {
+      vectors.clear();
+    }
     arrowContext_->stagingRows = 0;
     arrowContext_->stagingBytes = 0;
   }
@@ -394,9 +483,38 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
+  // The columns written from Velox vectors are not exported to Arrow. Their
+  // Arrow types are still needed for the file schema.
+  auto input = std::dynamic_pointer_cast<RowVector>(data);
+  if (input == nullptr) {
+    input = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::loadedVectorShared(data));
+    if (input == nullptr) {
+      VectorPtr flat = data;
+      BaseVector::flattenVector(flat);
+      input = std::static_pointer_cast<RowVector>(flat);
+    }
+  }
+  std::vector<std::string> arrowNames;
+  std::vector<TypePtr> arrowTypes;
+  std::vector<VectorPtr> arrowChildren;
+  for (auto i = 0; i < schema_->size(); ++i) {
+    if (!vectorColumns_[i]) {
+      arrowNames.push_back(schema_->nameOf(i));
+      arrowTypes.push_back(schema_->childAt(i));
+      arrowChildren.push_back(input->childAt(i));
+    }
+  }
+  auto arrowInput = std::make_shared<RowVector>(
+      generalPool_.get(),
+      ROW(std::move(arrowNames), std::move(arrowTypes)),
+      input->nulls(),
+      input->size(),
+      std::move(arrowChildren));
+
   ArrowArray array;
   ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options_);
+  exportToArrow(arrowInput, array, generalPool_.get(), options_);
   exportToArrow(data, schema, options_);
 
   // Convert the arrow schema to Schema and then update the column names based
@@ -411,16 +529,19 @@ void Writer::write(const VectorPtr& data) {
         arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
   }
 
+  std::vector<std::shared_ptr<::arrow::Field>> arrowFields;
+  for (auto i = 0; i < childSize; i++) {
+    if (!vectorColumns_[i]) {
+      arrowFields.push_back(newFields[i]);
+    }
+  }
   PARQUET_ASSIGN_OR_THROW(
       auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
+      ::arrow::ImportRecordBatch(&array, ::arrow::schema(arrowFields)));
   if (!arrowContext_->schema) {
-    arrowContext_->schema = recordBatch->schema();
-    for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
-         colIdx++) {
-      arrowContext_->stagingChunks.push_back(
-          std::vector<std::shared_ptr<::arrow::Array>>());
-    }
+    arrowContext_->schema = ::arrow::schema(newFields);
+    arrowContext_->stagingChunks.resize(childSize);
+    arrowContext_->stagingVectors.resize(childSize);
   }
 
   auto bytes = data->estimateFlatSize();
@@ -430,9 +551,17 @@ void Writer::write(const VectorPtr& data) {
     flush();
   }
 
-  for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
-    arrowContext_->stagingChunks.at(colIdx).push_back(
-        recordBatch->column(colIdx));
+  for (int colIdx = 0, arrowIdx = 0; colIdx < childSize; colIdx++) {
+    if (vectorColumns_[colIdx]) {
+      // Lazy vectors must be loaded here since their readers move on to the
+      // next batch before flush().
+      const auto& child = input->childAt(colIdx);
+      child->loadedVector();
+      arrowContext_->stagingVectors.at(colIdx).push_back(child);
+    } else {
+      arrowContext_->stagingChunks.at(colIdx).push_back(
+          recordBatch->column(arrowIdx++));
+    }
   }
   arrowContext_->stagingRows += numRows;
   arrowContext_->stagingBytes += bytes;
@@ -457,6 +586,7 @@ void Writer::close() {
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingVectors.clear();
 }
 
 void Writer::abort() {
@@ -515,6 +645,8 @@ void WriterOptions::processConfigs(
     parquetWriteTimestampTimeZone = parquetWriterOptions->sessionTimezoneName;
   }
 
+  processTableProperties();
+
   if (!useParquetDataPageV2) {
     useParquetDataPageV2 =
         getParquetDataPageVersion(session, kParquetSessionDataPageVersion)
@@ -541,4 +673,59 @@ void WriterOptions::processConfigs(
   }
 }
 
+void WriterOptions::processTableProperties() {
+  if (columnBloomFiltersMap.empty()) {
+    arrow::BloomFilterOptions bloomFilterOptions;
+    if (const auto fpp = getNumericTableProperty<double>(
+            serdeParameters, kParquetBloomFilterFpp)) {
+      VELOX_USER_CHECK(
+          fpp.value() > 0 && fpp.value() < 1,
+          "Parquet Bloom filter false positive probability must be in "
+          "(0, 1): {}",
+          fpp.value());
+      bloomFilterOptions.fpp = fpp.value();
+    }
+    if (const auto ndv = getNumericTableProperty<int32_t>(
+            serdeParameters, kParquetBloomFilterExpectedNdv)) {
+      VELOX_USER_CHECK_GT(
+          ndv.value(), 0, "Parquet Bloom filter expected NDV must be positive");
+      bloomFilterOptions.ndv = ndv.value();
+    }
+    for (const auto& column :
+         getColumnsTableProperty(serdeParameters, kParquetBloomFilterColumns)) {
+      columnBloomFiltersMap[column] = bloomFilterOptions;
+    }
+  }
+
+  if (const auto enabled = getTableProperty(
+          serdeParameters, kParquetPageIndexEnabled)) {
+    enablePageIndex = folly::to<bool>(enabled.value());
+  }
+  if (columnPageIndexesMap.empty()) {
+    for (const auto& column :
+         getColumnsTableProperty(serdeParameters, kParquetPageIndexColumns)) {
+      columnPageIndexesMap[column] = true;
+    }
+  }
+
+  if (!dataPageSize) {
+    if (const auto pageSize =
+            getTableProperty(serdeParameters, kParquetPageSize)) {
+      dataPageSize =
+          config::toCapacity(pageSize.value(), config::CapacityUnit::BYTE);
+    }
+  }
+  if (!rowGroupBytes) {
+    if (const auto blockSize =
+            getTableProperty(serdeParameters, kParquetBlockSize)) {
+      rowGroupBytes =
+          config::toCapacity(blockSize.value(), config::CapacityUnit::BYTE);
+    }
+  }
+  if (!rowGroupRows) {
+    rowGroupRows = getNumericTableProperty<uint64_t>(
+        serdeParameters, kParquetBlockRowCount);
+  }
+}
+
 } // namespace facebook::velox::parquet
@@ -24,6 +24,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
@@ -39,8 +40,12 @@ struct ArrowContext;
 
 class DefaultFlushPolicy : public dwio::common::FlushPolicy {
  public:
+  static constexpr uint64_t kDefaultRowsInRowGroup = 1'024 * 1'024;
+  static constexpr int64_t kDefaultBytesInRowGroup = 128 * 1'024 * 1'024;
+
   DefaultFlushPolicy()
-      : rowsInRowGroup_(1'024 * 1'024), bytesInRowGroup_(128 * 1'024 * 1'024) {}
+      : rowsInRowGroup_(kDefaultRowsInRowGroup),
+        bytesInRowGroup_(kDefaultBytesInRowGroup) {}
   DefaultFlushPolicy(uint64_t rowsInRowGroup, int64_t bytesInRowGroup)
       : rowsInRowGroup_(rowsInRowGroup), bytesInRowGroup_(bytesInRowGroup) {}
 
@@ -110,6 +115,19 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::optional<bool> useParquetDataPageV2;
   std::optional<int64_t> dataPageSize;
   std::optional<int64_t> batchSize;
+  // Writes the ColumnIndex and OffsetIndex (page index) of each column chunk.
+  bool enablePageIndex = false;
+  // Overrides 'enablePageIndex' for the leaf columns keyed by their dot
+  // separated paths.
+  std::unordered_map<std::string, bool> columnPageIndexesMap;
+  // Writes a split block Bloom filter of each column chunk of the leaf columns
+  // keyed by their dot separated paths.
+  std::unordered_map<std::string, arrow::BloomFilterOptions>
+      columnBloomFiltersMap;
+  // Row group size limits of the default flush policy. Ignored if
+  // 'flushPolicyFactory' is set.
+  std::optional<uint64_t> rowGroupRows;
+  std::optional<int64_t> rowGroupBytes;
 
   // Parsing session and hive configs.
 
@@ -132,10 +150,33 @@ struct WriterOptions : public dwio::common::WriterOptions {
   static constexpr const char* kParquetHiveConnectorWriteBatchSize =
       "hive.parquet.writer.batch-size";
 
+  // Table properties, passed in 'serdeParameters'. They take precedence over
+  // the session and hive connector configs. The column lists are comma
+  // separated dot paths of leaf columns.
+  static constexpr const char* kParquetBloomFilterColumns =
+      "parquet.bloom.filter.columns";
+  static constexpr const char* kParquetBloomFilterFpp =
+      "parquet.bloom.filter.fpp";
+  static constexpr const char* kParquetBloomFilterExpectedNdv =
+      "parquet.bloom.filter.expected.ndv";
+  static constexpr const char* kParquetPageIndexEnabled =
+      "parquet.page.index.enabled";
+  static constexpr const char* kParquetPageIndexColumns =
+      "parquet.page.index.columns";
+  static constexpr const char* kParquetPageSize = "parquet.page.size";
+  static constexpr const char* kParquetBlockSize = "parquet.block.size";
+  static constexpr const char* kParquetBlockRowCount =
+      "parquet.block.row.count";
+
   // Process hive connector and session configs.
   void processConfigs(
       const config::ConfigBase& connectorConfig,
       const config::ConfigBase& session) override;
+
+ private:
+  // Sets the options named by the table properties in 'serdeParameters' that
+  // are not set yet.
+  void processTableProperties();
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -197,6 +238,10 @@ class Writer : public dwio::common::Writer {
 
   const RowTypePtr schema_;
 
+  // True for the columns of 'schema_' that are written directly from Velox
+  // vectors. The other columns are converted to Arrow arrays first.
+  std::vector<bool> vectorColumns_;
+
   ArrowOptions options_{.flattenDictionary = true, .flattenConstant = true};
 
   // Whether to write Int96 timestamps in Arrow Parquet write.
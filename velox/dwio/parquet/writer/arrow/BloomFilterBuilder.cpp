@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Adapted from Apache Arrow.
+
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
+
+#include <limits>
+#include <map>
+#include <vector>
+
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/dwio/parquet/writer/arrow/Metadata.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+
+namespace facebook::velox::parquet::arrow {
+
+namespace {
+
+class BloomFilterBuilderImpl final : public BloomFilterBuilder {
+ public:
+  BloomFilterBuilderImpl(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties)
+      : schema_(schema), properties_(properties) {}
+
+  void AppendRowGroup() override {
+    if (finished_) {
+      throw ParquetException(
+          "Cannot call AppendRowGroup() to finished BloomFilterBuilder.");
+    }
+    bloom_filters_.emplace_back();
+  }
+
+  BloomFilter* GetOrCreateBloomFilter(int32_t column_ordinal) override {
+    if (finished_) {
+      throw ParquetException("BloomFilterBuilder is already finished.");
+    }
+    if (column_ordinal < 0 || column_ordinal >= schema_->num_columns()) {
+      throw ParquetException("Invalid column ordinal: ", column_ordinal);
+    }
+    if (bloom_filters_.empty()) {
+      throw ParquetException("No row group appended to BloomFilterBuilder.");
+    }
+    const auto* descr = schema_->Column(column_ordinal);
+    // The Parquet format does not define Bloom filters of booleans.
+    if (descr->physical_type() == Type::BOOLEAN) {
+      return nullptr;
+    }
+    const auto& options = properties_->bloom_filter_options(descr->path());
+    if (!options.has_value()) {
+      return nullptr;
+    }
+    auto& filter = bloom_filters_.back()[column_ordinal];
+    if (filter == nullptr) {
+      auto block_split_filter =
+          std::make_unique<BlockSplitBloomFilter>(properties_->memory_pool());
+      block_split_filter->Init(BlockSplitBloomFilter::OptimalNumOfBytes(
+          options->ndv, options->fpp));
+      filter = std::move(block_split_filter);
+    }
+    return filter.get();
+  }
+
+  void WriteTo(::arrow::io::OutputStream* sink, BloomFilterLocation* location)
+      override {
+    if (finished_) {
+      throw ParquetException("BloomFilterBuilder is already finished.");
+    }
+    finished_ = true;
+    location->bloom_filter_location.clear();
+
+    const auto num_columns = static_cast<size_t>(schema_->num_columns());
+    for (size_t row_group = 0; row_group < bloom_filters_.size(); ++row_group) {
+      const auto& row_group_filters = bloom_filters_[row_group];
+      if (row_group_filters.empty()) {
+        continue;
+      }
+      std::vector<std::optional<IndexLocation>> locations(
+          num_columns, std::nullopt);
+      // The map is ordered by column ordinal.
+      for (const auto& [column, filter] : row_group_filters) {
+        PARQUET_ASSIGN_OR_THROW(int64_t pos_before_write, sink->Tell());
+        filter->WriteTo(sink);
+        PARQUET_ASSIGN_OR_THROW(int64_t pos_after_write, sink->Tell());
+        const int64_t len = pos_after_write - pos_before_write;
+        if (len > std::numeric_limits<int32_t>::max()) {
+          throw ParquetException("Bloom filter size overflows to INT32_MAX");
+        }
+        locations[column] = {pos_before_write, static_cast<int32_t>(len)};
+      }
+      location->bloom_filter_location.emplace(row_group, std::move(locations));
+    }
+  }
+
+ private:
+  const SchemaDescriptor* schema_;
+  const WriterProperties* properties_;
+  // Bloom filters by column ordinal of each row group.
+  std::vector<std::map<int32_t, std::unique_ptr<BloomFilter>>> bloom_filters_;
+  bool finished_ = false;
+};
+
+} // namespace
+
+std::unique_ptr<BloomFilterBuilder> BloomFilterBuilder::Make(
+    const SchemaDescriptor* schema,
+    const WriterProperties* properties) {
+  return std::make_unique<BloomFilterBuilderImpl>(schema, properties);
+}
+
+} // namespace facebook::velox::parquet::arrow
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Adapted from Apache Arrow.
+
+#pragma once
+
+#include "arrow/io/interfaces.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
+
+namespace facebook::velox::parquet::arrow {
+
+class BloomFilter;
+struct BloomFilterLocation;
+class SchemaDescriptor;
+class WriterProperties;
+
+/// \brief Interface for collecting the Bloom filters of a parquet file.
+///
+/// The filters of all column chunks are kept in memory until the last row
+/// group is written, then they are serialized together before the page index
+/// and the footer.
+class PARQUET_EXPORT BloomFilterBuilder {
+ public:
+  /// \brief API convenience to create a BloomFilterBuilder.
+  static std::unique_ptr<BloomFilterBuilder> Make(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties);
+
+  virtual ~BloomFilterBuilder() = default;
+
+  /// \brief Start a new row group.
+  virtual void AppendRowGroup() = 0;
+
+  /// \brief Get the Bloom filter of a column in the current row group.
+  ///
+  /// \param column_ordinal Column ordinal.
+  /// \return The filter, or nullptr if no Bloom filter is written for the
+  /// column. Its memory ownership belongs to the BloomFilterBuilder.
+  virtual BloomFilter* GetOrCreateBloomFilter(int32_t column_ordinal) = 0;
+
+  /// \brief Serialize all Bloom filters ordered by row group and then column
+  /// ordinal. No more write is allowed afterwards.
+  ///
+  /// \param[out] sink The output stream to write the Bloom filters.
+  /// \param[out] location The location of all Bloom filters to the start of
+  /// sink.
+  virtual void WriteTo(
+      ::arrow::io::OutputStream* sink,
+      BloomFilterLocation* location) = 0;
+};
+
+} // namespace facebook::velox::parquet::arrow
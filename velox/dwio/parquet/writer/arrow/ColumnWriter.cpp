@@ -20,6 +20,7 @@
 
 #include <glog/logging.h>
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <map>
@@ -34,6 +35,7 @@
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
+#include "arrow/util/bit_run_reader.h"
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_ops.h"
 #include "arrow/util/checked_cast.h"
@@ -42,6 +44,7 @@
 #include "arrow/util/type_traits.h"
 
 #include "velox/dwio/parquet/common/LevelConversion.h"
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnPage.h"
 #include "velox/dwio/parquet/writer/arrow/Encoding.h"
 #include "velox/dwio/parquet/writer/arrow/Encryption.h"
@@ -1458,13 +1461,15 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
       std::unique_ptr<PageWriter> pager,
       const bool use_dictionary,
       Encoding::type encoding,
-      const WriterProperties* properties)
+      const WriterProperties* properties,
+      BloomFilter* bloom_filter)
       : ColumnWriterImpl(
             metadata,
             std::move(pager),
             use_dictionary,
             encoding,
-            properties) {
+            properties),
+        bloom_filter_(bloom_filter) {
     current_encoder_ = MakeEncoder(
         DType::type_num,
         encoding,
@@ -1749,6 +1754,9 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
   std::shared_ptr<TypedStats> page_statistics_;
   std::shared_ptr<TypedStats> chunk_statistics_;
   bool pages_change_on_record_boundaries_;
+  // Bloom filter of the column chunk, owned by the BloomFilterBuilder of the
+  // file. Null if the column has no Bloom filter.
+  BloomFilter* bloom_filter_;
 
   // If writing a sequence of ::arrow::DictionaryArray to the writer, we keep
   // the dictionary passed to DictEncoder<T>::PutDictionary so we can check
@@ -1950,6 +1958,68 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(values, num_values, num_nulls);
     }
+    UpdateBloomFilter(values, num_values);
+  }
+
+  // Inserts the hashes of 'num_values' dense values into the Bloom filter.
+  void UpdateBloomFilter(const T* values, int64_t num_values) {
+    if constexpr (!std::is_same_v<DType, BooleanType>) {
+      if (bloom_filter_ == nullptr) {
+        return;
+      }
+      constexpr int64_t kHashBatchSize = 256;
+      std::array<uint64_t, kHashBatchSize> hashes;
+      for (int64_t i = 0; i < num_values; i += kHashBatchSize) {
+        const int batch_size =
+            static_cast<int>(std::min(kHashBatchSize, num_values - i));
+        if constexpr (std::is_same_v<DType, FLBAType>) {
+          bloom_filter_->Hashes(
+              values + i, descr_->type_length(), batch_size, hashes.data());
+        } else {
+          bloom_filter_->Hashes(values + i, batch_size, hashes.data());
+        }
+        bloom_filter_->InsertHashes(hashes.data(), batch_size);
+      }
+    }
+  }
+
+  // Inserts the hashes of the values whose bits are set in 'valid_bits'.
+  void UpdateBloomFilterSpaced(
+      const T* values,
+      int64_t num_spaced_values,
+      const uint8_t* valid_bits,
+      int64_t valid_bits_offset) {
+    if (bloom_filter_ == nullptr) {
+      return;
+    }
+    if (valid_bits == nullptr) {
+      UpdateBloomFilter(values, num_spaced_values);
+      return;
+    }
+    ::arrow::internal::VisitSetBitRunsVoid(
+        valid_bits,
+        valid_bits_offset,
+        num_spaced_values,
+        [&](int64_t position, int64_t length) {
+          UpdateBloomFilter(values + position, length);
+        });
+  }
+
+  // Inserts the hashes of the non-null values of a binary-like array.
+  template <typename ArrayType>
+  void UpdateBloomFilterBinary(const ::arrow::Array& array) {
+    const auto& binary_array =
+        ::arrow::internal::checked_cast<const ArrayType&>(array);
+    for (int64_t i = 0; i < binary_array.length(); ++i) {
+      if (binary_array.IsNull(i)) {
+        continue;
+      }
+      const auto view = binary_array.GetView(i);
+      const ByteArray value(
+          static_cast<uint32_t>(view.size()),
+          reinterpret_cast<const uint8_t*>(view.data()));
+      bloom_filter_->InsertHash(bloom_filter_->Hash(&value));
+    }
   }
 
   /// \brief Write values with spaces and update page statistics accordingly.
@@ -1995,6 +2065,12 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
           num_values,
           num_nulls);
     }
+    if (num_values != num_spaced_values) {
+      UpdateBloomFilterSpaced(
+          values, num_spaced_values, valid_bits, valid_bits_offset);
+    } else {
+      UpdateBloomFilter(values, num_values);
+    }
   }
 };
 
@@ -2045,6 +2121,12 @@ Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
     return WriteDense();
   }
 
+  if (bloom_filter_ != nullptr) {
+    // The direct path writes only the indices of each chunk, so the values
+    // are materialized to be inserted into the Bloom filter.
+    return WriteDense();
+  }
+
   auto dict_encoder = dynamic_cast<DictEncoder<DType>*>(current_encoder_.get());
   const auto& data = checked_cast<const ::arrow::DictionaryArray&>(array);
   std::shared_ptr<::arrow::Array> dictionary = data.dictionary();
@@ -2722,6 +2804,14 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
         MaybeReplaceValidity(data_slice, null_count, ctx->memory_pool));
 
     current_encoder_->Put(*data_slice);
+    if (bloom_filter_ != nullptr) {
+      if (data_slice->type_id() == ::arrow::Type::LARGE_BINARY ||
+          data_slice->type_id() == ::arrow::Type::LARGE_STRING) {
+        UpdateBloomFilterBinary<::arrow::LargeBinaryArray>(*data_slice);
+      } else {
+        UpdateBloomFilterBinary<::arrow::BinaryArray>(*data_slice);
+      }
+    }
     // Null values in ancestors count as nulls.
     const int64_t non_null = data_slice->length() - data_slice->null_count();
     if (page_statistics_ != nullptr) {
@@ -2879,7 +2969,8 @@ Status TypedColumnWriterImpl<FLBAType>::WriteArrowDense(
 std::shared_ptr<ColumnWriter> ColumnWriter::Make(
     ColumnChunkMetaDataBuilder* metadata,
     std::unique_ptr<PageWriter> pager,
-    const WriterProperties* properties) {
+    const WriterProperties* properties,
+    BloomFilter* bloom_filter) {
   const ColumnDescriptor* descr = metadata->descr();
   const bool use_dictionary = properties->dictionary_enabled(descr->path()) &&
       descr->physical_type() != Type::BOOLEAN;
@@ -2901,28 +2992,68 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
       return std::make_shared<TypedColumnWriterImpl<BooleanType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT32:
       return std::make_shared<TypedColumnWriterImpl<Int32Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT64:
       return std::make_shared<TypedColumnWriterImpl<Int64Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT96:
       return std::make_shared<TypedColumnWriterImpl<Int96Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FLOAT:
       return std::make_shared<TypedColumnWriterImpl<FloatType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::DOUBLE:
       return std::make_shared<TypedColumnWriterImpl<DoubleType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<ByteArrayType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<FLBAType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     default:
       ParquetException::NYI("type reader not implemented");
   }
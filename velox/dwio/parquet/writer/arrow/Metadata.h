@@ -564,6 +564,14 @@ struct PageIndexLocation {
   FileIndexLocation offset_index_location;
 };
 
+/// \brief Public struct for location to all Bloom filters in a parquet file.
+struct BloomFilterLocation {
+  /// Bloom filter locations of each row group, located by column ordinal. If
+  /// a column does not have a Bloom filter, its value is set to std::nullopt.
+  /// Uses the row group ordinal as the key.
+  PageIndexLocation::FileIndexLocation bloom_filter_location;
+};
+
 class PARQUET_EXPORT FileMetaDataBuilder {
  public:
   ARROW_DEPRECATED(
@@ -586,6 +594,9 @@ class PARQUET_EXPORT FileMetaDataBuilder {
   // Update location to all page indexes in the parquet file
   void SetPageIndexLocation(const PageIndexLocation& location);
 
+  // Update location to all Bloom filters in the parquet file
+  void SetBloomFilterLocation(const BloomFilterLocation& location);
+
   // Complete the Thrift structure
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata =
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -219,6 +220,18 @@ static const char DEFAULT_CREATED_BY[] = CREATED_BY_VERSION;
 static constexpr Compression::type DEFAULT_COMPRESSION_TYPE =
     Compression::UNCOMPRESSED;
 static constexpr bool DEFAULT_IS_PAGE_INDEX_ENABLED = false;
+static constexpr int32_t DEFAULT_BLOOM_FILTER_NDV = 1024 * 1024;
+static constexpr double DEFAULT_BLOOM_FILTER_FPP = 0.05;
+
+/// Options of the split block Bloom filter written for each column chunk of a
+/// column.
+struct PARQUET_EXPORT BloomFilterOptions {
+  /// Expected number of distinct values in a column chunk. Together with 'fpp'
+  /// it determines the size of the filter bitset.
+  int32_t ndv = DEFAULT_BLOOM_FILTER_NDV;
+  /// False positive probability of the filter, in (0, 1).
+  double fpp = DEFAULT_BLOOM_FILTER_FPP;
+};
 
 class PARQUET_EXPORT ColumnProperties {
  public:
@@ -271,6 +284,11 @@ class PARQUET_EXPORT ColumnProperties {
     page_index_enabled_ = page_index_enabled;
   }
 
+  void set_bloom_filter_options(
+      std::optional<BloomFilterOptions> bloom_filter_options) {
+    bloom_filter_options_ = bloom_filter_options;
+  }
+
   Encoding::type encoding() const {
     return encoding_;
   }
@@ -303,6 +321,10 @@ class PARQUET_EXPORT ColumnProperties {
     return page_index_enabled_;
   }
 
+  const std::optional<BloomFilterOptions>& bloom_filter_options() const {
+    return bloom_filter_options_;
+  }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
@@ -311,6 +333,7 @@ class PARQUET_EXPORT ColumnProperties {
   size_t max_stats_size_;
   std::shared_ptr<CodecOptions> codec_options_;
   bool page_index_enabled_;
+  std::optional<BloomFilterOptions> bloom_filter_options_;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -735,6 +758,31 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_write_page_index(path->ToDotString());
     }
 
+    /// Enable writing a Bloom filter for each column chunk of the column
+    /// specified by `path`. Default disabled. Bloom filters are not written
+    /// for BOOLEAN columns.
+    Builder* enable_bloom_filter(
+        const std::string& path,
+        const BloomFilterOptions& bloom_filter_options = {}) {
+      bloom_filter_options_[path] = bloom_filter_options;
+      return this;
+    }
+
+    /// Enable writing a Bloom filter for each column chunk of the column
+    /// specified by `path`. Default disabled.
+    Builder* enable_bloom_filter(
+        const std::shared_ptr<schema::ColumnPath>& path,
+        const BloomFilterOptions& bloom_filter_options = {}) {
+      return this->enable_bloom_filter(
+          path->ToDotString(), bloom_filter_options);
+    }
+
+    /// Disable writing Bloom filters for the column specified by `path`.
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_options_[path] = std::nullopt;
+      return this;
+    }
+
     /// \brief Build the WriterProperties with the builder parameters.
     /// \return The WriterProperties defined by the builder.
     std::shared_ptr<WriterProperties> build() {
@@ -759,6 +807,8 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_statistics_enabled(item.second);
       for (const auto& item : page_index_enabled_)
         get(item.first).set_page_index_enabled(item.second);
+      for (const auto& item : bloom_filter_options_)
+        get(item.first).set_bloom_filter_options(item.second);
 
       return std::shared_ptr<WriterProperties>(new WriterProperties(
           pool_,
@@ -803,6 +853,8 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
     std::unordered_map<std::string, bool> page_index_enabled_;
+    std::unordered_map<std::string, std::optional<BloomFilterOptions>>
+        bloom_filter_options_;
   };
 
   inline MemoryPool* memory_pool() const {
@@ -924,6 +976,21 @@ class PARQUET_EXPORT WriterProperties {
     return false;
   }
 
+  const std::optional<BloomFilterOptions>& bloom_filter_options(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_options();
+  }
+
+  /// Returns true if a Bloom filter is written for any column.
+  bool bloom_filter_enabled() const {
+    for (const auto& item : column_properties_) {
+      if (item.second.bloom_filter_options().has_value()) {
+        return true;
+      }
+    }
+    return default_column_properties_.bloom_filter_options().has_value();
+  }
+
   inline FileEncryptionProperties* file_encryption_properties() const {
     return file_encryption_properties_.get();
   }
@@ -389,6 +389,14 @@ class FileWriterImpl : public FileWriter {
     return WriteColumnChunk(data, 0, data->length());
   }
 
+  ColumnWriter* NextColumnWriter() override {
+    if (row_group_writer_ == nullptr || row_group_writer_->buffered()) {
+      throw ParquetException(
+          "Cannot write column chunk outside of an unbuffered row group.");
+    }
+    return row_group_writer_->NextColumn();
+  }
+
   std::shared_ptr<::arrow::Schema> schema() const override {
     return schema_;
   }
@@ -36,6 +36,7 @@ class Table;
 
 namespace facebook::velox::parquet::arrow {
 
+class ColumnWriter;
 class FileMetaData;
 class ParquetFileWriter;
 
@@ -128,6 +129,15 @@ class PARQUET_EXPORT FileWriter {
   virtual ::arrow::Status WriteColumnChunk(
       const std::shared_ptr<::arrow::ChunkedArray>& data) = 0;
 
+  /// \brief Return the writer for the next column chunk in the row group
+  /// started by NewRowGroup().
+  ///
+  /// The caller writes the whole column chunk and closes the writer. This
+  /// allows writing a column chunk without converting it to an Arrow array
+  /// first. The writer is valid until the next call to NextColumnWriter() or
+  /// WriteColumnChunk().
+  virtual ColumnWriter* NextColumnWriter() = 0;
+
   /// \brief Start a new buffered row group.
   ///
   /// Returns an error if not all columns have been written.
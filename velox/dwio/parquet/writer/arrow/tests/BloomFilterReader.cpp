@@ -17,9 +17,9 @@
 // Adapted from Apache Arrow.
 
 #include "velox/dwio/parquet/writer/arrow/tests/BloomFilterReader.h"
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
 #include "velox/dwio/parquet/writer/arrow/Metadata.h"
-#include "velox/dwio/parquet/writer/arrow/tests/BloomFilter.h"
 
 namespace facebook::velox::parquet::arrow {
 
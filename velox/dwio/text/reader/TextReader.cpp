@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/type/Conversions.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+namespace {
+constexpr char kNewLine = '\n';
+
+// Bytes after the valid data of a read buffer, so that SIMD loads starting
+// at any valid position stay in the buffer. One more byte is for a newline
+// appended to a file that does not end with one.
+constexpr int32_t kPadding = xsimd::batch<uint8_t>::size + 1;
+
+// Reads past the end of the range, which only finish the last row of the
+// range, are in steps of this size.
+constexpr uint64_t kReadPastRangeSize = 64 << 10;
+
+void checkSupportedType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (!type->isDecimal()) {
+        return;
+      }
+      [[fallthrough]];
+    default:
+      VELOX_NYI("{} is not supported yet in TextReader", type->toString());
+  }
+}
+
+template <TypeKind kKind>
+void setCast(BaseVector& vector, vector_size_t row, const StringView& value) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  const auto result = util::Converter<kKind>::tryCast(value);
+  if (result.hasError()) {
+    vector.setNull(row, true);
+    return;
+  }
+  vector.asUnchecked<FlatVector<T>>()->set(row, result.value());
+}
+} // namespace
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : pool_(options.memoryPool()),
+      serDeOptions_(options.serDeOptions()),
+      input_(std::move(input)),
+      schema_(options.fileSchema()),
+      typeWithId_(
+          schema_ == nullptr ? nullptr
+                             : dwio::common::TypeWithId::create(schema_)) {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_USER_CHECK_NOT_NULL(
+      schema_, "Text files have no schema, the file schema must be set");
+}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(*this, options);
+}
+
+TextRowReader::TextRowReader(
+    const TextReader& reader,
+    const dwio::common::RowReaderOptions& options)
+    : reader_(reader),
+      serDeOptions_(reader.serDeOptions()),
+      scanSpec_(options.scanSpec()),
+      delimiter_(serDeOptions_.separators[size_t(
+          dwio::common::SerDeSeparator::FIELD_DELIM)]),
+      quote_(
+          serDeOptions_.isQuoted ? std::optional(serDeOptions_.quoteChar)
+                                 : std::nullopt),
+      escape_(
+          serDeOptions_.isEscaped ? std::optional(serDeOptions_.escapeChar)
+                                  : std::nullopt) {
+  const auto& schema = reader_.rowType();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (column_index_t i = 0; i < schema->size(); ++i) {
+    const auto& name = schema->nameOf(i);
+    if (scanSpec_ != nullptr) {
+      const auto* childSpec = scanSpec_->childByName(name);
+      if (childSpec == nullptr || childSpec->isConstant()) {
+        continue;
+      }
+    }
+    checkSupportedType(schema->childAt(i));
+    columns_.push_back({i, schema->childAt(i), nullptr});
+    names.push_back(name);
+    types.push_back(schema->childAt(i));
+  }
+  outputType_ = ROW(std::move(names), std::move(types));
+
+  fileSize_ = reader_.readFile()->size();
+  rangeEnd_ = std::min(options.limit(), fileSize_);
+  readOffset_ = std::min(options.offset(), fileSize_);
+  if (readOffset_ >= rangeEnd_) {
+    atEnd_ = true;
+    return;
+  }
+  if (readOffset_ > 0) {
+    // The row that starts before the range belongs to the previous range.
+    // Skips to the first row that starts at or after the range start.
+    --readOffset_;
+    for (;;) {
+      if (!loadBuffer(size_)) {
+        atEnd_ = true;
+        return;
+      }
+      const auto* data = buffer_->as<char>();
+      const auto* newLine =
+          static_cast<const char*>(memchr(data, kNewLine, size_));
+      if (newLine != nullptr) {
+        pos_ = newLine - data + 1;
+        break;
+      }
+      pos_ = size_;
+    }
+  } else {
+    for (uint64_t i = 0; i < options.skipRows(); ++i) {
+      if (!nextRow()) {
+        break;
+      }
+    }
+  }
+}
+
+bool TextRowReader::loadBuffer(int32_t keepFrom) {
+  if (readOffset_ >= fileSize_) {
+    return false;
+  }
+  const int32_t numKept = size_ - keepFrom;
+  const int32_t capacity = std::max(kReadBufferSize, 2 * numKept);
+  auto buffer =
+      AlignedBuffer::allocate<char>(capacity + kPadding, &reader_.memoryPool());
+  auto* data = buffer->asMutable<char>();
+  if (numKept > 0) {
+    memcpy(data, buffer_->as<char>() + keepFrom, numKept);
+  }
+  const uint64_t numLeftInRange =
+      rangeEnd_ > readOffset_ ? rangeEnd_ - readOffset_ : 0;
+  const auto numRead = std::min<uint64_t>(
+      {static_cast<uint64_t>(capacity - numKept),
+       std::max(numLeftInRange, kReadPastRangeSize),
+       fileSize_ - readOffset_});
+  reader_.readFile()->pread(readOffset_, numRead, data + numKept);
+  bufferOffset_ = readOffset_ - numKept;
+  readOffset_ += numRead;
+  size_ = numKept + numRead;
+  pos_ = 0;
+  if (readOffset_ == fileSize_ && data[size_ - 1] != kNewLine) {
+    // Terminates the last row of a file that does not end with a newline.
+    data[size_++] = kNewLine;
+  }
+  buffer_ = std::move(buffer);
+  batchBuffers_.push_back(buffer_);
+  return true;
+}
+
+int32_t TextRowReader::findSpecial(int32_t pos) const {
+  using Batch = xsimd::batch<uint8_t>;
+  const auto* data = buffer_->as<uint8_t>();
+  const auto delimiter = Batch::broadcast(delimiter_);
+  const auto newLine = Batch::broadcast(kNewLine);
+  // The quote and escape compare equal to newlines if not set.
+  const auto quote = Batch::broadcast(quote_.value_or(kNewLine));
+  const auto escape = Batch::broadcast(escape_.value_or(kNewLine));
+  for (; pos < size_; pos += Batch::size) {
+    const auto bytes = Batch::load_unaligned(data + pos);
+    const auto bits = simd::toBitMask(
+        bytes == delimiter || bytes == newLine || bytes == quote ||
+        bytes == escape);
+    if (bits != 0) {
+      return std::min<int32_t>(pos + __builtin_ctzll(bits), size_);
+    }
+  }
+  return size_;
+}
+
+bool TextRowReader::parseRow() {
+  fields_.clear();
+  const auto* data = buffer_->as<char>();
+  auto byteAt = [&](int32_t pos) { return static_cast<uint8_t>(data[pos]); };
+  int32_t pos = pos_;
+  for (;;) {
+    // Starts a field at 'pos'.
+    Field field{data + pos, 0, false, false};
+    std::optional<int32_t> quoteEnd;
+    if (quote_.has_value() && pos < size_ && byteAt(pos) == *quote_) {
+      field.quoted = true;
+      ++field.data;
+      ++pos;
+    }
+    bool inQuotes = field.quoted;
+    for (;;) {
+      const auto special = findSpecial(pos);
+      if (special >= size_) {
+        return false;
+      }
+      const uint8_t c = byteAt(special);
+      if (escape_.has_value() && c == *escape_) {
+        // The next byte is taken as is.
+        field.unescape = true;
+        pos = special + 2;
+        continue;
+      }
+      if (inQuotes) {
+        if (c == *quote_) {
+          if (special + 1 >= size_) {
+            return false;
+          }
+          if (byteAt(special + 1) == *quote_) {
+            field.unescape = true;
+            pos = special + 2;
+            continue;
+          }
+          // Bytes between the closing quote and the delimiter are ignored.
+          inQuotes = false;
+          quoteEnd = special;
+        }
+        pos = special + 1;
+        continue;
+      }
+      if (quote_.has_value() && c == *quote_) {
+        // A quote inside an unquoted field is a regular byte.
+        pos = special + 1;
+        continue;
+      }
+      int32_t end = quoteEnd.value_or(special);
+      if (c == kNewLine && quote_.has_value() && !quoteEnd.has_value() &&
+          end > field.data - data && data[end - 1] == '\r') {
+        // CSV rows may end with CRLF.
+        --end;
+      }
+      field.size = data + end - field.data;
+      fields_.push_back(field);
+      pos = special + 1;
+      if (c == kNewLine) {
+        pos_ = pos;
+        return true;
+      }
+      break;
+    }
+  }
+}
+
+bool TextRowReader::nextRow() {
+  for (;;) {
+    if (pos_ < size_) {
+      if (fileOffset(pos_) >= rangeEnd_) {
+        return false;
+      }
+      if (parseRow()) {
+        return true;
+      }
+    }
+    // The row continues past the buffer. It is parsed again from the start
+    // of the next buffer.
+    if (!loadBuffer(pos_)) {
+      return false;
+    }
+  }
+}
+
+std::string TextRowReader::unescape(const Field& field) const {
+  std::string result;
+  result.reserve(field.size);
+  for (int32_t i = 0; i < field.size; ++i) {
+    const uint8_t c = field.data[i];
+    if (i + 1 < field.size &&
+        ((escape_.has_value() && c == *escape_) ||
+         (field.quoted && c == *quote_ &&
+          static_cast<uint8_t>(field.data[i + 1]) == *quote_))) {
+      ++i;
+    }
+    result.push_back(field.data[i]);
+  }
+  return result;
+}
+
+void TextRowReader::setValue(
+    Column& column,
+    vector_size_t row,
+    const Field& field) {
+  auto& vector = *column.vector;
+  if (!field.quoted &&
+      std::string_view(field.data, field.size) == serDeOptions_.nullString) {
+    vector.setNull(row, true);
+    return;
+  }
+  std::string unescaped;
+  StringView value(field.data, field.size);
+  if (field.unescape) {
+    unescaped = unescape(field);
+    value = StringView(unescaped);
+  }
+  switch (column.type->kind()) {
+    case TypeKind::VARCHAR: {
+      auto* flat = vector.asUnchecked<FlatVector<StringView>>();
+      if (field.unescape) {
+        flat->set(row, value);
+      } else {
+        flat->setNoCopy(row, value);
+      }
+      return;
+    }
+    case TypeKind::VARBINARY: {
+      // The text writer writes binary values in base64. Values that are not
+      // base64 are taken as is.
+      auto* flat = vector.asUnchecked<FlatVector<StringView>>();
+      size_t inputSize = value.size();
+      const auto decodedSize =
+          encoding::Base64::calculateDecodedSize(value.data(), inputSize);
+      if (decodedSize.hasValue()) {
+        std::string decoded(decodedSize.value(), '\0');
+        if (encoding::Base64::decode(
+                value.data(), inputSize, decoded.data(), decoded.size())
+                .ok()) {
+          flat->set(row, StringView(decoded));
+          return;
+        }
+      }
+      flat->set(row, value);
+      return;
+    }
+    case TypeKind::INTEGER:
+      if (column.type->isDate()) {
+        const auto days =
+            util::fromDateString(value, util::ParseMode::kPrestoCast);
+        if (days.hasError()) {
+          vector.setNull(row, true);
+        } else {
+          vector.asUnchecked<FlatVector<int32_t>>()->set(row, days.value());
+        }
+        return;
+      }
+      setCast<TypeKind::INTEGER>(vector, row, value);
+      return;
+    case TypeKind::TIMESTAMP: {
+      const auto timestamp = util::fromTimestampString(
+          value, util::TimestampParseMode::kPrestoCast);
+      if (timestamp.hasError()) {
+        vector.setNull(row, true);
+      } else {
+        vector.asUnchecked<FlatVector<Timestamp>>()->set(
+            row, timestamp.value());
+      }
+      return;
+    }
+    case TypeKind::BOOLEAN:
+      setCast<TypeKind::BOOLEAN>(vector, row, value);
+      return;
+    case TypeKind::TINYINT:
+      setCast<TypeKind::TINYINT>(vector, row, value);
+      return;
+    case TypeKind::SMALLINT:
+      setCast<TypeKind::SMALLINT>(vector, row, value);
+      return;
+    case TypeKind::BIGINT:
+      setCast<TypeKind::BIGINT>(vector, row, value);
+      return;
+    case TypeKind::REAL:
+      setCast<TypeKind::REAL>(vector, row, value);
+      return;
+    case TypeKind::DOUBLE:
+      setCast<TypeKind::DOUBLE>(vector, row, value);
+      return;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  VELOX_CHECK(
+      scanSpec_ != nullptr || mutation == nullptr,
+      "Mutation requires a scan spec");
+  if (atEnd_) {
+    return 0;
+  }
+  auto* pool = &reader_.memoryPool();
+  for (auto& column : columns_) {
+    column.vector = BaseVector::create(column.type, size, pool);
+  }
+  batchBuffers_.clear();
+  if (buffer_ != nullptr) {
+    batchBuffers_.push_back(buffer_);
+  }
+
+  vector_size_t numRows = 0;
+  while (numRows < size) {
+    if (!nextRow()) {
+      atEnd_ = true;
+      break;
+    }
+    for (auto& column : columns_) {
+      if (column.fileIndex < fields_.size()) {
+        setValue(column, numRows, fields_[column.fileIndex]);
+      } else {
+        // Missing trailing fields are null.
+        column.vector->setNull(numRows, true);
+      }
+    }
+    ++numRows;
+  }
+  if (numRows == 0) {
+    return 0;
+  }
+
+  std::vector<VectorPtr> children;
+  children.reserve(columns_.size());
+  for (auto& column : columns_) {
+    column.vector->resize(numRows);
+    if (column.type->kind() == TypeKind::VARCHAR) {
+      // The strings that were not copied are in the read buffers.
+      auto* flat = column.vector->asUnchecked<FlatVector<StringView>>();
+      auto stringBuffers = flat->stringBuffers();
+      stringBuffers.insert(
+          stringBuffers.end(), batchBuffers_.begin(), batchBuffers_.end());
+      flat->setStringBuffers(std::move(stringBuffers));
+    }
+    children.push_back(std::move(column.vector));
+  }
+  auto rows = std::make_shared<RowVector>(
+      pool, outputType_, nullptr, numRows, std::move(children));
+  rowNumber_ += numRows;
+  if (scanSpec_ == nullptr) {
+    result = std::move(rows);
+  } else {
+    result = projectColumns(rows, *scanSpec_, mutation);
+  }
+  return numRows;
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  return atEnd_ ? kAtEnd : rowNumber_;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  return atEnd_ ? kAtEnd : size;
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Reads delimited text files, e.g. Hive TEXTFILE or CSV, with the delimiters
+/// and quoting given by the SerDeOptions of the reader options. Text files
+/// carry no schema, so the file schema must be set in the reader options. The
+/// reader supports scalar columns only. Fields that can't be parsed as their
+/// column type are null.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  ~TextReader() override = default;
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return schema_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  /// The range of 'options' is split at line boundaries: a row is read by the
+  /// row reader whose range contains the first byte of the row. Quoted fields
+  /// may contain newlines only if the ranges do not start inside them.
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+  memory::MemoryPool& memoryPool() const {
+    return pool_;
+  }
+
+  const dwio::common::SerDeOptions& serDeOptions() const {
+    return serDeOptions_;
+  }
+
+  const std::shared_ptr<ReadFile>& readFile() const {
+    return input_->getReadFile();
+  }
+
+ private:
+  memory::MemoryPool& pool_;
+  const dwio::common::SerDeOptions serDeOptions_;
+  const std::unique_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr schema_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+/// Reads the rows of a range of a text file. The fields are found with SIMD
+/// comparisons against the delimiters, quote and escape characters. String
+/// fields without escapes or doubled quotes refer to the read buffer without
+/// a copy.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      const TextReader& reader,
+      const dwio::common::RowReaderOptions& options);
+
+  ~TextRowReader() override = default;
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  int64_t nextRowNumber() override;
+
+  /// The number of rows left in the range is not known ahead, so this returns
+  /// 'size' unless at end.
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+  /// Size of the buffers the file is read into. A row longer than this is
+  /// read into a larger buffer.
+  static constexpr int32_t kReadBufferSize = 1 << 20;
+
+ private:
+  // A field of the row being parsed.
+  struct Field {
+    const char* data;
+    int32_t size;
+    // True if enclosed in quotes.
+    bool quoted;
+    // True if the field contains escapes or doubled quotes to remove.
+    bool unescape;
+  };
+
+  // A column to parse.
+  struct Column {
+    column_index_t fileIndex;
+    TypePtr type;
+    VectorPtr vector;
+  };
+
+  // Returns the offset in the file of position 'pos' of 'buffer_'.
+  uint64_t fileOffset(int32_t pos) const {
+    return bufferOffset_ + pos;
+  }
+
+  // Reads more of the file into a new buffer. The bytes of the current
+  // buffer from 'keepFrom' on are moved to the start of the new buffer.
+  // Returns false if there is nothing left to read.
+  bool loadBuffer(int32_t keepFrom);
+
+  // Returns the position of the first special byte at or after 'pos', or
+  // 'size_' if there is none.
+  int32_t findSpecial(int32_t pos) const;
+
+  // Parses the next row of the range into 'fields_'. Returns false at the
+  // end of the range.
+  bool nextRow();
+
+  // Parses a row starting at 'pos_' from 'buffer_'. Returns false if the row
+  // does not end in 'buffer_'.
+  bool parseRow();
+
+  // Sets 'row' of 'column' from 'field'.
+  void setValue(Column& column, vector_size_t row, const Field& field);
+
+  // Returns the value of 'field' without escapes and quotes.
+  std::string unescape(const Field& field) const;
+
+  const TextReader& reader_;
+  const dwio::common::SerDeOptions& serDeOptions_;
+  const std::shared_ptr<velox::common::ScanSpec> scanSpec_;
+  const uint8_t delimiter_;
+  const std::optional<uint8_t> quote_;
+  const std::optional<uint8_t> escape_;
+
+  // The end of the file and of the range to read.
+  uint64_t fileSize_;
+  uint64_t rangeEnd_;
+
+  RowTypePtr outputType_;
+  std::vector<Column> columns_;
+  std::vector<Field> fields_;
+
+  // The current read buffer. 'buffer_' has padding after 'size_' valid bytes
+  // for SIMD loads.
+  BufferPtr buffer_;
+  int32_t size_{0};
+  // The next position to parse in 'buffer_'.
+  int32_t pos_{0};
+  // File offset of the first byte of 'buffer_'.
+  uint64_t bufferOffset_{0};
+  // File offset of the next byte to read.
+  uint64_t readOffset_{0};
+  // The buffers that hold the strings of the current batch.
+  std::vector<BufferPtr> batchBuffers_;
+
+  int64_t rowNumber_{0};
+  bool atEnd_{false};
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  TextReaderFactory() : ReaderFactory(dwio::common::FileFormat::TEXT) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::text
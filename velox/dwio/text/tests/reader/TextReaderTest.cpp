@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <gtest/gtest.h>
+#include <fstream>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/text/writer/TextWriter.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+class TextReaderTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    velox::filesystems::registerLocalFileSystem();
+    dwio::common::LocalFileSink::registerFactory();
+    rootPool_ = memory::memoryManager()->addRootPool("TextReaderTests");
+    leafPool_ = rootPool_->addLeafChild("TextReaderTests");
+    tempPath_ = exec::test::TempDirectoryPath::create();
+  }
+
+  std::string writeFile(const std::string& content) {
+    const auto path =
+        fmt::format("{}/text_reader_{}.txt", tempPath_->getPath(), fileId_++);
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+    return path;
+  }
+
+  std::unique_ptr<TextReader> createReader(
+      const std::string& path,
+      const RowTypePtr& schema,
+      const dwio::common::SerDeOptions& serDeOptions = {}) {
+    dwio::common::ReaderOptions options(leafPool_.get());
+    options.setFileSchema(schema);
+    options.setSerDeOptions(serDeOptions);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<LocalReadFile>(path), *leafPool_);
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+
+  // Reads all rows of 'reader' in batches of 'batchSize'.
+  RowVectorPtr read(
+      const TextReader& reader,
+      const dwio::common::RowReaderOptions& options = {},
+      int32_t batchSize = 1'000) {
+    auto rowReader = reader.createRowReader(options);
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (result == nullptr) {
+        result = std::static_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader->nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> leafPool_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempPath_;
+  int32_t fileId_{0};
+};
+
+TEST_F(TextReaderTest, writerRoundTrip) {
+  auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9"},
+          {BOOLEAN(),
+           TINYINT(),
+           SMALLINT(),
+           INTEGER(),
+           BIGINT(),
+           REAL(),
+           DOUBLE(),
+           TIMESTAMP(),
+           VARCHAR(),
+           VARBINARY()});
+  auto data = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9"},
+      {
+          makeFlatVector<bool>({true, false, true}),
+          makeFlatVector<int8_t>({1, 2, 3}),
+          makeNullableFlatVector<int16_t>({1, std::nullopt, 3}),
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeFlatVector<int64_t>({1, 2, 3}),
+          makeFlatVector<float>({1.5, 2.25, -3.5}),
+          makeFlatVector<double>({1.5, 2.25, -3.5}),
+          makeFlatVector<Timestamp>(
+              3, [](auto i) { return Timestamp(i, i * 1'000'000); }),
+          makeNullableFlatVector<StringView>(
+              {"hello", std::nullopt, "a string longer than inline"}),
+          makeFlatVector<StringView>({"hello", "world", "cpp"}, VARBINARY()),
+      });
+
+  WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  const auto path =
+      fmt::format("{}/text_reader_round_trip.txt", tempPath_->getPath());
+  auto sink = std::make_unique<dwio::common::LocalFileSink>(
+      path, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto writer = std::make_unique<TextWriter>(
+      schema,
+      std::move(sink),
+      std::make_shared<text::WriterOptions>(writerOptions));
+  writer->write(data);
+  writer->close();
+
+  auto reader = createReader(path, schema);
+  velox::test::assertEqualVectors(data, read(*reader));
+}
+
+TEST_F(TextReaderTest, csv) {
+  dwio::common::SerDeOptions serDeOptions(',');
+  serDeOptions.isQuoted = true;
+  serDeOptions.nullString = "";
+  const auto path = writeFile(
+      "1,plain,2.5\n"
+      "2,\"with, comma\",x\r\n"
+      "3,\"doubled \"\"quotes\"\"\",\n"
+      "4,\"multi\nline\"\n"
+      "5,quote\"inside,7");
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), DOUBLE()});
+  auto reader = createReader(path, schema, serDeOptions);
+  auto expected = makeRowVector(
+      {"c0", "c1", "c2"},
+      {
+          makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+          makeFlatVector<StringView>(
+              {"plain",
+               "with, comma",
+               "doubled \"quotes\"",
+               "multi\nline",
+               "quote\"inside"}),
+          makeNullableFlatVector<double>(
+              {2.5, std::nullopt, std::nullopt, std::nullopt, 7}),
+      });
+  velox::test::assertEqualVectors(expected, read(*reader));
+}
+
+TEST_F(TextReaderTest, escape) {
+  dwio::common::SerDeOptions serDeOptions('|', '\2', '\3', '\\', true);
+  const auto path = writeFile("a\\|b|\\N\nc\\\\|d\\\ne\n");
+  auto schema = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto reader = createReader(path, schema, serDeOptions);
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<StringView>({"a|b", "c\\"}),
+          makeNullableFlatVector<StringView>({std::nullopt, "d\ne"}),
+      });
+  velox::test::assertEqualVectors(expected, read(*reader));
+}
+
+TEST_F(TextReaderTest, scanSpec) {
+  std::string content;
+  for (auto i = 0; i < 100; ++i) {
+    content += fmt::format("{}\x01name{}\x01{}\n", i, i, i % 3 == 0);
+  }
+  const auto path = writeFile(content);
+  auto schema = ROW({"c0", "c1", "c2"}, {INTEGER(), VARCHAR(), BOOLEAN()});
+  auto reader = createReader(path, schema);
+
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(10, 19, false));
+  // 'c2' is filtered on but not projected out.
+  auto* c2Spec = spec->childByName("c2");
+  c2Spec->setFilter(std::make_unique<common::BoolValue>(true, false));
+  c2Spec->setProjectOut(false);
+  c2Spec->setChannel(common::ScanSpec::kNoChannel);
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(spec);
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int32_t>({12, 15, 18}),
+          makeFlatVector<std::string>({"name12", "name15", "name18"}),
+      });
+  velox::test::assertEqualVectors(expected, read(*reader, options, 7));
+}
+
+TEST_F(TextReaderTest, splits) {
+  // Rows of varying length, one longer than the read buffer.
+  std::string content;
+  std::vector<int64_t> keys;
+  std::vector<std::string> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    keys.push_back(i);
+    values.push_back(std::string(
+        i == 500 ? TextRowReader::kReadBufferSize + 10 : i % 37,
+        'a' + i % 26));
+    content += fmt::format("{}\x01{}\n", keys.back(), values.back());
+  }
+  const auto path = writeFile(content);
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto reader = createReader(path, schema);
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(keys), makeFlatVector<std::string>(values)});
+
+  for (const uint64_t splitSize : {1'000UL, 10'000UL, 1UL << 20, 2UL << 20}) {
+    SCOPED_TRACE(fmt::format("splitSize: {}", splitSize));
+    RowVectorPtr result;
+    for (uint64_t offset = 0; offset < content.size(); offset += splitSize) {
+      dwio::common::RowReaderOptions options;
+      options.range(offset, splitSize);
+      auto split = read(*reader, options, 100);
+      if (split == nullptr) {
+        continue;
+      }
+      if (result == nullptr) {
+        result = split;
+      } else {
+        result->append(split.get());
+      }
+    }
+    velox::test::assertEqualVectors(expected, result);
+  }
+
+  dwio::common::RowReaderOptions options;
+  options.setSkipRows(2);
+  auto result = read(*reader, options);
+  ASSERT_EQ(result->size(), keys.size() - 2);
+  ASSERT_EQ(result->childAt(0)->asFlatVector<int64_t>()->valueAt(0), 2);
+}
+
+TEST_F(TextReaderTest, unsupportedType) {
+  const auto path = writeFile("1\n");
+  auto reader = createReader(path, ROW({"c0"}, {ARRAY(BIGINT())}));
+  VELOX_ASSERT_THROW(reader->createRowReader(), "is not supported yet");
+}
+
+} // namespace
+} // namespace facebook::velox::text
@@ -200,6 +200,49 @@ class Aggregate {
     VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
   }
 
+  /// Whether the function supports dense accumulators for the raw input of a
+  /// small number of groups.
+  ///
+  /// When this returns true, `initializeDenseAccumulators`,
+  /// `addRawDenseInput` and `addDenseAccumulators` should be implemented.
+  virtual bool supportsDenseInput() const {
+    return false;
+  }
+
+  /// Initializes 'numGroups' dense accumulators of accumulatorFixedWidthSize()
+  /// bytes each, laid out contiguously in 'accumulators'.
+  virtual void initializeDenseAccumulators(
+      char* /*accumulators*/,
+      int32_t /*numGroups*/) {
+    VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
+  }
+
+  /// Fast path for the raw input of a small number of groups. Same as
+  /// `addRawInput`, except that the rows update the dense accumulators of
+  /// initializeDenseAccumulators() instead of the accumulators in the group
+  /// rows. `groupIndices` are aligned with `args` and give the index of the
+  /// accumulator of each row. Sets the bits in `nonNullGroups` of the groups
+  /// that get a non-null value.
+  virtual void addRawDenseInput(
+      const uint64_t* /*groupIndices*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/,
+      char* /*accumulators*/,
+      uint64_t* /*nonNullGroups*/) {
+    VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
+  }
+
+  /// Adds the dense accumulators of the groups set in `nonNullGroups` to the
+  /// accumulators of the group rows in `groups`, which has an entry for each
+  /// of the `numGroups` dense accumulators.
+  virtual void addDenseAccumulators(
+      char** /*groups*/,
+      int32_t /*numGroups*/,
+      const char* /*accumulators*/,
+      const uint64_t* /*nonNullGroups*/) {
+    VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
+  }
+
   // Updates final accumulators from intermediate results.
   // @param groups Pointers to the start of the group rows. These are aligned
   // with the 'args', e.g. data in the i-th row of the 'args' goes to the i-th
@@ -235,6 +278,28 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  /// Whether the function can remove raw input from a single group accumulator.
+  /// Aggregate window functions use this to slide the frame incrementally.
+  ///
+  /// When this returns true, `removeSingleGroupRawInput` should be implemented.
+  virtual bool supportsRemoveRawInput() const {
+    return false;
+  }
+
+  /// Reverses addSingleGroupRawInput() for rows that were added to 'group'
+  /// before. 'rows' and 'args' are the same as in addSingleGroupRawInput().
+  /// The caller re-initializes the accumulator when no rows with non-null
+  /// arguments remain, so the function does not need to restore the null flag
+  /// of 'group'.
+  ///
+  /// Will only be called when `supportsRemoveRawInput` returns true.
+  virtual void removeSingleGroupRawInput(
+      char* /*group*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_NYI("Unimplemented: {} {}", typeid(*this).name(), __func__);
+  }
+
   // Updates the single final accumulator from intermediate results for global
   // aggregation.
   // @param group Pointer to the start of the group row.
@@ -302,6 +367,14 @@ class Aggregate {
     }
   }
 
+  /// Passes the references to the out-of-line data of the accumulators in
+  /// 'groups' to 'relocator' when the HashStringAllocator of the accumulators
+  /// is compacted. See HashStringAllocator::compact(). The data of aggregates
+  /// that do not override this stays in place.
+  virtual void relocateAccumulators(
+      folly::Range<char**> /*groups*/,
+      HashStringAllocator::Relocator& /*relocator*/) {}
+
   // Clears state between reuses, e.g. this is called before reusing
   // the aggregation operator's state after flushing a partial
   // aggregation.
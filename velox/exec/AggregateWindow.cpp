@@ -28,7 +28,10 @@ namespace {
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
-// to frameEnd boundaries at that row using singleGroup.
+// to frameEnd boundaries at that row using singleGroup. Expanding frames add
+// the new rows to the aggregate of the previous row. Sliding frames also remove
+// the rows that left the frame if the aggregate supports it. Otherwise, large
+// frames are computed from a segment tree of intermediate results.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -66,6 +69,19 @@ class AggregateWindowFunction : public exec::WindowFunction {
         resultType,
         config);
     aggregate_->setAllocator(stringAllocator_);
+    removableAggregate_ = aggregate_->supportsRemoveRawInput();
+    // A segment tree keeps the intermediate result of every node. This is only
+    // done for fixed size accumulators with primitive intermediate results,
+    // e.g. not sketches, to bound its memory.
+    if (!removableAggregate_ && aggregate_->isFixedSize() &&
+        !aggregate_->accumulatorUsesExternalMemory()) {
+      auto intermediateType =
+          exec::Aggregate::intermediateType(name, argTypes_);
+      if (intermediateType->isPrimitiveType() &&
+          intermediateType->kind() != TypeKind::VARBINARY) {
+        segmentTreeType_ = std::move(intermediateType);
+      }
+    }
 
     // Aggregate initialization.
     // Row layout is:
@@ -116,6 +132,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    slidingFrame_.reset();
+    segmentTree_.reset();
   }
 
   void apply(
@@ -163,7 +181,23 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+      slidingFrame_.reset();
+    } else if (
+        frameMetadata.slidingAggregation && removableAggregate_ &&
+        !partition_->partial()) {
+      slidingAggregation(
+          validRows,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
+    } else if (useSegmentTree(validRows, frameMetadata)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
+      slidingFrame_.reset();
     } else {
+      slidingFrame_.reset();
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
           validRows,
@@ -193,8 +227,30 @@ class AggregateWindowFunction : public exec::WindowFunction {
 
     // Resume incremental aggregation from the prior block.
     bool usePreviousAggregate;
+
+    // If both the frame starts and the frame ends of the rows in the block are
+    // non-decreasing, then an aggregate that can remove input can slide the
+    // frame: the rows that leave the frame are removed and the rows that enter
+    // it are added.
+    bool slidingAggregation;
+
+    // Sum of the frame sizes of the rows in the block.
+    int64_t numFrameRows;
   };
 
+  // Current frame of the sliding aggregation in the single group.
+  struct SlidingFrame {
+    // First row and the row after the last row of the frame.
+    vector_size_t start;
+    vector_size_t end;
+
+    // Number of rows in the frame with non-null arguments.
+    vector_size_t numNonNullRows;
+  };
+
+  // Min average frame size for building a segment tree.
+  static constexpr int64_t kMinSegmentTreeFrameSize = 32;
+
   bool handleAllEmptyFrames(
       const SelectivityVector& validRows,
       vector_size_t resultOffset,
@@ -222,18 +278,25 @@ class AggregateWindowFunction : public exec::WindowFunction {
     vector_size_t firstRow = rawFrameStarts[firstValidRow];
     vector_size_t fixedFrameStartRow = firstRow;
     vector_size_t lastRow = rawFrameEnds[firstValidRow];
+    vector_size_t prevFrameStarts = firstRow;
     vector_size_t prevFrameEnds = lastRow;
 
     bool incrementalAggregation = true;
+    bool slidingAggregation = true;
+    int64_t numFrameRows = 0;
     validRows.applyToSelected([&](auto i) {
       firstRow = std::min(firstRow, rawFrameStarts[i]);
       lastRow = std::max(lastRow, rawFrameEnds[i]);
+      numFrameRows += rawFrameEnds[i] + 1 - rawFrameStarts[i];
 
       // Incremental aggregation can be done if :
       // i) All rows have the same frameStart value.
       // ii) The frame end values are non-decreasing.
       incrementalAggregation &= (rawFrameStarts[i] == fixedFrameStartRow);
       incrementalAggregation &= rawFrameEnds[i] >= prevFrameEnds;
+      slidingAggregation &= rawFrameStarts[i] >= prevFrameStarts;
+      slidingAggregation &= rawFrameEnds[i] >= prevFrameEnds;
+      prevFrameStarts = rawFrameStarts[i];
       prevFrameEnds = rawFrameEnds[i];
     });
 
@@ -251,7 +314,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
       }
     }
 
-    return {firstRow, lastRow, incrementalAggregation, usePreviousAggregate};
+    return {
+        firstRow,
+        lastRow,
+        incrementalAggregation,
+        usePreviousAggregate,
+        slidingAggregation,
+        numFrameRows};
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
@@ -327,10 +396,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
     validRows.applyToSelected([&](auto i) {
       // This is a very naive algorithm.
       // It evaluates the entire aggregation for each row by iterating over
-      // input rows from frameStart to frameEnd in the SelectivityVector.
-      // TODO : Try to re-use previous computations by advancing and retracting
-      // the aggregation based on the frame changes with each row. This would
-      // require adding new APIs to the Aggregate framework.
+      // input rows from frameStart to frameEnd in the SelectivityVector. Used
+      // for small frames and for frames that can neither slide nor use a
+      // segment tree.
       aggregate_->clear();
       aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
       aggregateInitialized_ = true;
@@ -345,6 +413,241 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Starts a new aggregation in the single group.
+  void initializeSingleGroup() {
+    static const auto kSingleGroup = std::vector<vector_size_t>{0};
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    aggregateInitialized_ = true;
+  }
+
+  // Adds the rows in [begin, end) of 'argVectors_' to the single group or
+  // removes them from it. Returns the number of these rows with non-null
+  // arguments. 'rows' has no rows selected before and after the call.
+  vector_size_t updateSingleGroup(
+      SelectivityVector& rows,
+      vector_size_t begin,
+      vector_size_t end,
+      bool remove) {
+    rows.setValidRange(begin, end, true);
+    rows.updateBounds();
+    if (remove) {
+      aggregate_->removeSingleGroupRawInput(
+          rawSingleGroupRow_, rows, argVectors_);
+    } else {
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, rows, argVectors_, false);
+    }
+    rows.setValidRange(begin, end, false);
+
+    vector_size_t numNonNullRows = end - begin;
+    if (std::none_of(argVectors_.begin(), argVectors_.end(), [](auto& arg) {
+          return arg->mayHaveNulls();
+        })) {
+      return numNonNullRows;
+    }
+    for (auto row = begin; row < end; ++row) {
+      if (std::any_of(argVectors_.begin(), argVectors_.end(), [&](auto& arg) {
+            return arg->isNullAt(row);
+          })) {
+        --numNonNullRows;
+      }
+    }
+    return numNonNullRows;
+  }
+
+  // Computes the aggregate of frames with non-decreasing starts and ends by
+  // removing the rows that leave the frame of the previous row and adding the
+  // rows that enter the frame of the current row. The frame is carried over
+  // to the next block.
+  void slidingAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t lastRow,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const auto firstValidRow = validRows.begin();
+    // The frame is also restarted when the block does not continue the rows
+    // of the previous one, e.g. for a block of a lane of a partition processed
+    // in parallel, so that the skipped rows are not read.
+    if (slidingFrame_.has_value() &&
+        (rawFrameStarts[firstValidRow] < slidingFrame_->start ||
+         rawFrameStarts[firstValidRow] >= slidingFrame_->end ||
+         rawFrameEnds[firstValidRow] + 1 < slidingFrame_->end)) {
+      slidingFrame_.reset();
+    }
+    if (!slidingFrame_.has_value()) {
+      initializeSingleGroup();
+      const auto start = rawFrameStarts[firstValidRow];
+      slidingFrame_ = SlidingFrame{start, start, 0};
+    }
+    auto& frame = slidingFrame_.value();
+
+    // The arguments of the rows removed from the previous frame are needed
+    // too.
+    const auto firstRow = frame.start;
+    fillArgVectors(firstRow, lastRow);
+    SelectivityVector rows(lastRow + 1 - firstRow, false);
+
+    validRows.applyToSelected([&](auto i) {
+      const auto start = rawFrameStarts[i];
+      const auto end = rawFrameEnds[i] + 1;
+      if (start >= frame.end) {
+        // The frame has no rows in common with the previous one.
+        initializeSingleGroup();
+        frame = {start, start, 0};
+      } else if (start > frame.start) {
+        frame.numNonNullRows -= updateSingleGroup(
+            rows, frame.start - firstRow, start - firstRow, true);
+        frame.start = start;
+        if (frame.numNonNullRows == 0) {
+          // Restores the result for a frame without non-null input, e.g. null
+          // for sum.
+          initializeSingleGroup();
+        }
+      }
+      if (end > frame.end) {
+        frame.numNonNullRows += updateSingleGroup(
+            rows, frame.end - firstRow, end - firstRow, false);
+        frame.end = end;
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  // Returns true if the frames of the block are computed from a segment tree.
+  // The segment tree is built for the aggregates that cannot remove input,
+  // once the frames are large enough to pay for it.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const FrameMetadata& frameMetadata) const {
+    if (segmentTreeType_ == nullptr || partition_->partial() ||
+        partition_->numRows() > std::numeric_limits<vector_size_t>::max() / 2) {
+      return false;
+    }
+    return segmentTree_ != nullptr ||
+        frameMetadata.numFrameRows >=
+        kMinSegmentTreeFrameSize * validRows.countSelected();
+  }
+
+  // Builds 'segmentTree_' over all rows of the partition. The tree is stored
+  // as intermediate results, where node 'i' combines the nodes '2 * i' and
+  // '2 * i + 1', and the leaves at [numRows, 2 * numRows) are the rows.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    const auto numNodes = 2 * numRows;
+    fillArgVectors(0, numRows - 1);
+
+    const auto nodeSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    auto nodesBuffer =
+        AlignedBuffer::allocate<char>(numNodes * nodeSize, pool_);
+    std::vector<char*> nodes(numNodes);
+    std::vector<vector_size_t> nodeIndices(numNodes);
+    for (auto i = 0; i < numNodes; ++i) {
+      nodes[i] = nodesBuffer->asMutable<char>() + i * nodeSize;
+      nodeIndices[i] = i;
+    }
+    aggregate_->initializeNewGroups(nodes.data(), nodeIndices);
+
+    aggregate_->addRawInput(
+        nodes.data() + numRows, SelectivityVector(numRows), argVectors_, false);
+
+    // Combines the nodes level by level, so that the children of the nodes in
+    // [begin, end) are complete.
+    auto children = BaseVector::create(segmentTreeType_, 0, pool_);
+    std::vector<char*> parents;
+    for (auto end = numRows; end > 1;) {
+      const auto begin = (end + 1) / 2;
+      const auto numChildren = 2 * (end - begin);
+      aggregate_->extractAccumulators(
+          nodes.data() + 2 * begin, numChildren, &children);
+      parents.resize(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        parents[i] = nodes[begin + i / 2];
+      }
+      aggregate_->addIntermediateResults(
+          parents.data(), SelectivityVector(numChildren), {children}, false);
+      end = begin;
+    }
+
+    segmentTree_ = BaseVector::create(segmentTreeType_, numNodes, pool_);
+    aggregate_->extractAccumulators(nodes.data(), numNodes, &segmentTree_);
+    aggregate_->destroy(folly::Range(nodes.data(), numNodes));
+  }
+
+  // Computes the aggregate of each frame by combining the O(log(n)) nodes of
+  // the segment tree covering the frame.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (segmentTree_ == nullptr) {
+      buildSegmentTree();
+    }
+    const auto numRows = partition_->numRows();
+
+    // Collects the nodes of all frames in the order of their rows, which
+    // matters for order sensitive aggregates.
+    std::vector<vector_size_t> nodes;
+    std::vector<vector_size_t> nodeOffsets;
+    std::vector<vector_size_t> rightNodes;
+    validRows.applyToSelected([&](auto i) {
+      nodeOffsets.push_back(nodes.size());
+      rightNodes.clear();
+      for (auto left = rawFrameStarts[i] + numRows,
+                right = rawFrameEnds[i] + 1 + numRows;
+           left < right;
+           left >>= 1, right >>= 1) {
+        if (left & 1) {
+          nodes.push_back(left++);
+        }
+        if (right & 1) {
+          rightNodes.push_back(--right);
+        }
+      }
+      nodes.insert(nodes.end(), rightNodes.rbegin(), rightNodes.rend());
+    });
+    nodeOffsets.push_back(nodes.size());
+
+    auto indices = allocateIndices(nodes.size(), pool_);
+    std::copy(
+        nodes.begin(), nodes.end(), indices->asMutable<vector_size_t>());
+    const std::vector<VectorPtr> args{BaseVector::wrapInDictionary(
+        nullptr, indices, nodes.size(), segmentTree_)};
+
+    SelectivityVector rows(nodes.size(), false);
+    vector_size_t frameIndex = 0;
+    validRows.applyToSelected([&](auto i) {
+      const auto begin = nodeOffsets[frameIndex];
+      const auto end = nodeOffsets[++frameIndex];
+      initializeSingleGroup();
+      rows.setValidRange(begin, end, true);
+      rows.updateBounds();
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, rows, args, false);
+      rows.setValidRange(begin, end, false);
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -389,6 +692,21 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // True if 'aggregate_' can remove input. Frames with non-decreasing starts
+  // and ends are then computed by sliding the frame.
+  bool removableAggregate_{false};
+
+  // The frame in the single group of the sliding aggregation. Set while the
+  // single group is used for sliding the frame.
+  std::optional<SlidingFrame> slidingFrame_;
+
+  // Intermediate type of 'aggregate_'. Set if the frames can be computed from
+  // a segment tree.
+  TypePtr segmentTreeType_;
+
+  // Segment tree over the rows of the partition. Built on first use.
+  VectorPtr segmentTree_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
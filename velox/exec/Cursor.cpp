@@ -63,6 +63,7 @@ exec::BlockingReason TaskQueue::enqueue(
   }
   queue_.push_back(std::move(entry));
   totalBytes_ += bytes;
+  peakBytes_ = std::max(peakBytes_, totalBytes_);
   if (consumerBlocked_) {
     consumerBlocked_ = false;
     consumerPromise_.setValue();
@@ -116,8 +117,13 @@ RowVectorPtr TaskQueue::dequeue() {
 }
 
 void TaskQueue::close() {
+  std::deque<TaskQueueEntry> queued;
   std::lock_guard<std::mutex> l(mutex_);
   closed_ = true;
+  // The queued results are not read anymore. Frees them when leaving, after
+  // 'mutex_' is released.
+  queued.swap(queue_);
+  totalBytes_ = 0;
   // Unblock producers.
   for (auto& promise : producerUnblockPromises_) {
     promise.setValue();
@@ -232,9 +238,11 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
         Task::ExecutionMode::kParallel,
         // consumer
         [queue, copyResult = params.copyResult](
-            const RowVectorPtr& vector, velox::ContinueFuture* future) {
+            RowVectorPtr vector, velox::ContinueFuture* future) {
           if (!vector || !copyResult) {
-            return queue->enqueue(vector, future);
+            // The sink gives up its reference, so that the queue owns the
+            // vector and the operators do not reuse its buffers.
+            return queue->enqueue(std::move(vector), future);
           }
           // Make sure to load lazy vector if not loaded already.
           for (auto& child : vector->children()) {
@@ -282,6 +290,9 @@ class MultiThreadedTaskCursor : public TaskCursorBase {
       std::rethrow_exception(error_);
     }
 
+    // Releases the previous batch before waiting for the next one, so that
+    // a consumer that keeps up holds no more than the queued results.
+    current_.reset();
     current_ = queue_->dequeue();
     if (task_->error()) {
       // Wait for the task to finish (there's' a small period of time between
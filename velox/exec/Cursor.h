@@ -70,6 +70,13 @@ struct CursorParameters {
   /// would be built from it.
   std::string spillDirectory;
 
+  /// If true, the results are copied into 'outputPool', so that they stay
+  /// valid after the task is destroyed. If false, the vectors produced by the
+  /// task are handed to the consumer without a copy. These must then be
+  /// released before the task. In both cases at most about 'bufferedBytes' of
+  /// results are queued before the task blocks on the consumer.
+  ///
+  /// Only used if serialExecution is false.
   bool copyResult = true;
 
   /// If true, use serial execution mode. Use parallel execution mode
@@ -119,6 +126,12 @@ class TaskQueue {
     return pool_.get();
   }
 
+  /// Returns the largest number of bytes that were queued at a time.
+  uint64_t peakBytes() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return peakBytes_;
+  }
+
  private:
   // Owns the vectors in 'queue_', hence must be declared first.
   std::shared_ptr<velox::memory::MemoryPool> pool_;
@@ -126,6 +139,7 @@ class TaskQueue {
   std::optional<int32_t> numProducers_;
   int32_t producersFinished_ = 0;
   uint64_t totalBytes_ = 0;
+  uint64_t peakBytes_ = 0;
   // Blocks the producer if 'totalBytes' exceeds 'maxBytes' after
   // adding the result.
   uint64_t maxBytes_;
@@ -17,6 +17,8 @@
 #include "velox/exec/Driver.h"
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/exec/DriverExecutor.h"
+#include "velox/exec/FairShareExecutor.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -24,6 +26,10 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 namespace {
 
+// The number of stack samples a Driver buffers between two flushes, i.e. in an
+// operator call. The surplus samples of longer calls are dropped.
+constexpr int32_t kStackSampleCapacity = 64;
+
 // Checks if output channel is produced using identity projection and returns
 // input channel if so.
 std::optional<column_index_t> getIdentityProjection(
@@ -76,6 +82,26 @@ std::exception_ptr makeException(
       false));
 }
 
+// Adds an interval of the Driver of 'ctx' to the timeline of its task.
+void addTimelineEvent(
+    TaskTimeline* timeline,
+    const DriverCtx& ctx,
+    TaskTimeline::Event::Kind kind,
+    BlockingReason reason,
+    int32_t operatorId,
+    uint64_t startUs,
+    uint64_t endUs) {
+  TaskTimeline::Event event;
+  event.kind = kind;
+  event.reason = reason;
+  event.pipelineId = ctx.pipelineId;
+  event.driverId = ctx.driverId;
+  event.operatorId = operatorId;
+  event.startUs = startUs;
+  event.endUs = endUs;
+  timeline->add(event);
+}
+
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -144,7 +170,10 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.spillPrefixSortEnabled()
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillColumnarFormatEnabled(),
+      queryConfig.spillReadAheadEnabled(),
+      queryConfig.spillMergeFanIn());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -179,6 +208,16 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         std::lock_guard<std::timed_mutex> l(task->mutex());
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(state->sinceUs_, state->reason_);
+          if (FOLLY_UNLIKELY(task->timeline() != nullptr)) {
+            addTimelineEvent(
+                task->timeline(),
+                *driver->driverCtx(),
+                TaskTimeline::Event::Kind::kBlocked,
+                state->reason_,
+                state->operator_->operatorId(),
+                state->sinceUs_,
+                getCurrentTimeMicro());
+          }
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -238,8 +277,18 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* fairShareExecutor = dynamic_cast<FairShareExecutor*>(executor)) {
+    fairShareExecutor->add(
+        [driver]() { Driver::run(driver); }, driver->task()->queryCtx());
+    return;
+  }
+  if (auto* driverExecutor = dynamic_cast<DriverExecutor*>(executor)) {
+    driverExecutor->add(
+        [driver]() { Driver::run(driver); }, driver->task()->affinityHint());
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -248,10 +297,52 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  timeline_ = task()->timeline();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  if (ctx_->queryConfig().operatorStackSamplingEnabled()) {
+    stackSamples_ =
+        std::make_unique<process::StackSampleBuffer>(kStackSampleCapacity);
+  }
+  if (ctx_->queryConfig().operatorPerfCountersEnabled()) {
+    perfCountersSamplingInterval_ = std::max<uint32_t>(
+        1, ctx_->queryConfig().operatorPerfCountersSamplingInterval());
+  }
+  outputBatchCacheBytes_ = ctx_->queryConfig().adaptiveOutputBatchCacheBytes();
+}
+
+void Driver::updateAdaptiveOutputBatchRows(
+    size_t operatorIndex,
+    uint64_t bytes,
+    vector_size_t rows) {
+  if (outputBatchCacheBytes_ == 0 || rows == 0) {
+    return;
+  }
+  // The operators may change after init() by a DriverAdapter.
+  if (operatorOutputBytes_.size() != operators_.size()) {
+    operatorOutputBytes_.assign(operators_.size(), 0);
+    operatorOutputRows_.assign(operators_.size(), 0);
+  }
+  operatorOutputBytes_[operatorIndex] += bytes;
+  operatorOutputRows_[operatorIndex] += rows;
+
+  // The working set of a batch is the output of all the operators for it.
+  double bytesPerRow = 0;
+  for (auto i = 0; i < operators_.size(); ++i) {
+    if (operatorOutputRows_[i] > 0) {
+      bytesPerRow += static_cast<double>(operatorOutputBytes_[i]) /
+          operatorOutputRows_[i];
+    }
+  }
+  const auto maxRows = ctx_->queryConfig().maxOutputBatchRows();
+  if (bytesPerRow * maxRows <= outputBatchCacheBytes_) {
+    adaptiveOutputBatchRows_ = maxRows;
+  } else {
+    adaptiveOutputBatchRows_ = std::max<vector_size_t>(
+        1, static_cast<vector_size_t>(outputBatchCacheBytes_ / bytesPerRow));
+  }
 }
 
 void Driver::initializeOperators() {
@@ -366,6 +457,8 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
+    process::ScopedStackSampleTag stackSampleTag(                          \
+        stackSamples_.get(), operatorId);                                  \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -511,6 +604,34 @@ StopReason Driver::runInternal(
         kMetricDriverQueueTimeMs, queuedTimeUs / 1'000);
   }
 
+  // Records the time in the executor queue and, on exit, the time on thread
+  // up to the operator the Driver stopped at.
+  auto timelineGuard = folly::makeGuard([&]() {
+    if (FOLLY_LIKELY(timeline_ == nullptr)) {
+      return;
+    }
+    addTimelineEvent(
+        timeline_,
+        *ctx_,
+        TaskTimeline::Event::Kind::kOnThread,
+        BlockingReason::kNotBlocked,
+        curOperatorId_ < operators_.size()
+            ? operators_[curOperatorId_]->operatorId()
+            : -1,
+        now,
+        getCurrentTimeMicro());
+  });
+  if (FOLLY_UNLIKELY(timeline_ != nullptr) && queueTimeStartUs_ != 0) {
+    addTimelineEvent(
+        timeline_,
+        *ctx_,
+        TaskTimeline::Event::Kind::kQueued,
+        BlockingReason::kNotBlocked,
+        -1,
+        queueTimeStartUs_,
+        now);
+  }
+
   CancelGuard guard(self, task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
     if (reason == StopReason::kTerminate) {
@@ -545,6 +666,10 @@ StopReason Driver::runInternal(
 
         auto* op = operators_[i].get();
 
+        if (FOLLY_UNLIKELY(stackSamples_ != nullptr)) {
+          flushStackSamples();
+        }
+
         // In case we are blocked, this index will point to the operator, whose
         // queuedTime we should update.
         curOperatorId_ = i;
@@ -616,6 +741,8 @@ StopReason Driver::runInternal(
                   lockedStats->addOutputVector(
                       resultBytes, intermediateResult->size());
                 }
+                updateAdaptiveOutputBatchRows(
+                    i, resultBytes, intermediateResult->size());
               }
             });
             pushdownFilters(i);
@@ -704,11 +831,12 @@ StopReason Driver::runInternal(
             if (result) {
               validateOperatorOutputResult(result, *op);
 
+              const auto resultBytes = result->estimateFlatSize();
               {
                 auto lockedStats = op->stats().wlock();
-                lockedStats->addOutputVector(
-                    result->estimateFlatSize(), result->size());
+                lockedStats->addOutputVector(resultBytes, result->size());
               }
+              updateAdaptiveOutputBatchRows(i, resultBytes, result->size());
             }
           });
 
@@ -826,6 +954,8 @@ void Driver::initializeOperatorStats(std::vector<OperatorStats>& stats) {
 }
 
 void Driver::closeOperators() {
+  flushStackSamples();
+
   // Close operators.
   for (auto& op : operators_) {
     op->close();
@@ -852,6 +982,17 @@ void Driver::updateStats() {
   task()->addDriverStats(ctx_->pipelineId, std::move(stats));
 }
 
+void Driver::flushStackSamples() {
+  if (stackSamples_ == nullptr || stackSamples_->empty()) {
+    return;
+  }
+  stackSamples_->drain([&](const process::StackSampleBuffer::Sample& sample) {
+    VELOX_CHECK_LT(static_cast<size_t>(sample.tag), operators_.size());
+    task()->addStackSample(
+        operators_[sample.tag]->planNodeId(), sample.frames, sample.numFrames);
+  });
+}
+
 void Driver::close() {
   if (closed_) {
     // Already closed.
@@ -1037,11 +1178,40 @@ folly::dynamic Driver::toJson() const {
   return obj;
 }
 
+bool Driver::shouldSamplePerfCounters(TimingMemberPtr opTimingMember) {
+  if (perfCountersSamplingInterval_ == 0 ||
+      (opTimingMember != &OperatorStats::addInputTiming &&
+       opTimingMember != &OperatorStats::getOutputTiming)) {
+    return false;
+  }
+  return ++numPerfCountersCalls_ % perfCountersSamplingInterval_ == 0;
+}
+
 template <typename Func>
 void Driver::withDeltaCpuWallTimer(
     Operator* op,
     TimingMemberPtr opTimingMember,
     Func&& opFunction) {
+  if (FOLLY_LIKELY(!shouldSamplePerfCounters(opTimingMember))) {
+    return withDeltaCpuWallTimerImpl(
+        op, opTimingMember, std::forward<Func>(opFunction));
+  }
+  // The counters include the lazy loads triggered by the call, unlike the
+  // timing.
+  const process::DeltaPerfCounterStopWatch perfCountersWatch;
+  withDeltaCpuWallTimerImpl(op, opTimingMember, std::forward<Func>(opFunction));
+  if (const auto perfCounters = perfCountersWatch.elapsed()) {
+    op->stats().withWLock([&](auto& lockedStats) {
+      lockedStats.perfCounters.add(*perfCounters);
+    });
+  }
+}
+
+template <typename Func>
+void Driver::withDeltaCpuWallTimerImpl(
+    Operator* op,
+    TimingMemberPtr opTimingMember,
+    Func&& opFunction) {
   // If 'trackOperatorCpuUsage_' is true, create and initialize the timer object
   // to track cpu and wall time of the opFunction.
   if (!trackOperatorCpuUsage_) {
@@ -1138,6 +1308,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForScanScaleUp";
     case BlockingReason::kWaitForIndexLookup:
       return "kWaitForIndexLookup";
+    case BlockingReason::kWaitForAggregationMerge:
+      return "kWaitForAggregationMerge";
     default:
       VELOX_UNREACHABLE(
           fmt::format("Unknown blocking reason {}", static_cast<int>(reason)));
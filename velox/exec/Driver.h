@@ -25,6 +25,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/TraceConfig.h"
+#include "velox/common/process/StackSampler.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
@@ -36,6 +37,7 @@ class ExchangeClient;
 class Operator;
 struct OperatorStats;
 class Task;
+class TaskTimeline;
 
 enum class StopReason {
   /// Keep running.
@@ -217,6 +219,10 @@ enum class BlockingReason {
   /// Used by IndexLookupJoin operator, indicating that it was blocked by the
   /// async index lookup.
   kWaitForIndexLookup,
+  /// Used by HashAggregation operator that merges its partitions with its peer
+  /// operators, indicating that it was blocked by the peers not having finished
+  /// their input or the merge.
+  kWaitForAggregationMerge,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -305,10 +311,13 @@ struct DriverCtx {
   std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
 
   common::PrefixSortConfig prefixSortConfig() const {
-    return common::PrefixSortConfig{
+    common::PrefixSortConfig config{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
         queryConfig().prefixSortMinRows(),
         queryConfig().prefixSortMaxStringPrefixLength()};
+    config.maxRadixSortKeyBytes =
+        queryConfig().prefixSortMaxRadixSortKeyBytes();
+    return config;
   }
 };
 
@@ -421,6 +430,10 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// Close operators and add operator stats to the task.
   void closeOperators();
 
+  /// Adds the stack samples taken in the operator calls since the last flush
+  /// to the stack profile of the task.
+  void flushStackSamples();
+
   /// Returns true if all operators between the source and 'aggregation' are
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
@@ -446,6 +459,15 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// Returns a list of all operators.
   std::vector<Operator*> operators() const;
 
+  /// Returns the number of rows per batch for which the output of all the
+  /// operators of the pipeline for one batch fits in
+  /// QueryConfig::kAdaptiveOutputBatchCacheBytes, given the output bytes per
+  /// row of each operator so far. Returns std::nullopt if the budget is not
+  /// set or there was no output yet.
+  std::optional<vector_size_t> adaptiveOutputBatchRows() const {
+    return adaptiveOutputBatchRows_;
+  }
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -538,6 +560,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // position in the pipeline.
   void pushdownFilters(int operatorIndex);
 
+  // Adds 'bytes' and 'rows' of output of the operator at 'operatorIndex' and
+  // updates 'adaptiveOutputBatchRows_'.
+  void updateAdaptiveOutputBatchRows(
+      size_t operatorIndex,
+      uint64_t bytes,
+      vector_size_t rows);
+
   using TimingMemberPtr = CpuWallTiming OperatorStats::*;
   template <typename Func>
   void withDeltaCpuWallTimer(
@@ -545,6 +574,16 @@ class Driver : public std::enable_shared_from_this<Driver> {
       TimingMemberPtr opTimingMember,
       Func&& opFunction);
 
+  template <typename Func>
+  void withDeltaCpuWallTimerImpl(
+      Operator* op,
+      TimingMemberPtr opTimingMember,
+      Func&& opFunction);
+
+  // Returns true if the hardware performance counters of the call timed into
+  // 'opTimingMember' are to be measured.
+  bool shouldSamplePerfCounters(TimingMemberPtr opTimingMember);
+
   // Adjusts 'timing' by removing the lazy load wall time, CPU time, and input
   // bytes accrued since last time timing information was recorded for 'op'. The
   // accrued lazy load times are credited to the source operator of 'this'. The
@@ -591,6 +630,29 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // Measures the perf counters of one out of this many addInput and getOutput
+  // calls. 0 if the query does not collect perf counters.
+  uint32_t perfCountersSamplingInterval_{0};
+  uint32_t numPerfCountersCalls_{0};
+
+  // The stack samples taken in the operator calls, tagged with the index of
+  // the operator. nullptr if the query does not record stack samples.
+  std::unique_ptr<process::StackSampleBuffer> stackSamples_;
+
+  // The timeline of the task. nullptr if the task keeps no timeline.
+  TaskTimeline* timeline_{nullptr};
+
+  // The bytes of the output of all the operators for one batch that fit in
+  // the cache. 0 if the batch sizes are not adapted.
+  uint64_t outputBatchCacheBytes_{0};
+
+  // The output bytes and rows of each operator so far. Only kept if
+  // 'outputBatchCacheBytes_' is set.
+  std::vector<uint64_t> operatorOutputBytes_;
+  std::vector<uint64_t> operatorOutputRows_;
+
+  std::optional<vector_size_t> adaptiveOutputBatchRows_;
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -733,6 +795,9 @@ struct DriverFactory {
   /// based on this pipeline.
   std::vector<core::PlanNodeId> needsNestedLoopJoinBridges() const;
 
+  /// Returns plan node IDs of the TopN nodes in this pipeline.
+  std::vector<core::PlanNodeId> needsTopNThresholds() const;
+
   static std::vector<DriverAdapter> adapters;
 };
 
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <fmt/format.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+struct CurrentWorker {
+  const DriverExecutor* executor{nullptr};
+  uint32_t id{0};
+};
+
+thread_local CurrentWorker currentWorker;
+
+// Parses a cpulist like "0-3,8,10-11" from sysfs.
+std::vector<int32_t> parseCpuList(const std::string& cpuList) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpuList), ranges, true);
+  for (const auto& range : ranges) {
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (!folly::split('-', range, first, last)) {
+      first = last = range;
+    }
+    const auto begin = folly::to<int32_t>(first);
+    const auto end = folly::to<int32_t>(last);
+    for (auto cpu = begin; cpu <= end; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+void pinToCpu(int32_t cpu) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  const auto result =
+      pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+  if (result != 0) {
+    LOG(WARNING) << "Failed to pin driver executor thread to CPU " << cpu
+                 << ": " << folly::errnoStr(result);
+  }
+#endif
+}
+} // namespace
+
+// static
+std::vector<std::vector<int32_t>> DriverExecutor::numaNodeCpus() {
+  std::vector<std::vector<int32_t>> nodes;
+  for (auto node = 0;; ++node) {
+    std::string cpuList;
+    if (!folly::readFile(
+            fmt::format("/sys/devices/system/node/node{}/cpulist", node)
+                .c_str(),
+            cpuList)) {
+      break;
+    }
+    auto cpus = parseCpuList(cpuList);
+    if (!cpus.empty()) {
+      nodes.push_back(std::move(cpus));
+    }
+  }
+  if (nodes.empty()) {
+    nodes.emplace_back();
+    const auto numCpus = std::max(1U, std::thread::hardware_concurrency());
+    for (auto cpu = 0; cpu < numCpus; ++cpu) {
+      nodes.back().push_back(cpu);
+    }
+  }
+  return nodes;
+}
+
+DriverExecutor::DriverExecutor(Options options) {
+  const auto nodeCpus = numaNodeCpus();
+  // The CPUs in node order with their node.
+  std::vector<std::pair<uint32_t, int32_t>> cpus;
+  for (auto node = 0; node < nodeCpus.size(); ++node) {
+    for (auto cpu : nodeCpus[node]) {
+      cpus.emplace_back(node, cpu);
+    }
+  }
+  const auto numThreads =
+      options.numThreads == 0 ? cpus.size() : options.numThreads;
+  VELOX_CHECK_GT(numThreads, 0);
+
+  // Spreads the workers over the nodes in proportion to their CPUs.
+  nodeWorkers_.resize(nodeCpus.size());
+  workers_.reserve(numThreads);
+  for (uint32_t i = 0; i < numThreads; ++i) {
+    const auto& [node, cpu] =
+        cpus[(i * cpus.size() / numThreads) % cpus.size()];
+    auto worker = std::make_unique<Worker>();
+    worker->id = i;
+    worker->node = node;
+    worker->cpu = cpu;
+    nodeWorkers_[node].push_back(i);
+    workers_.push_back(std::move(worker));
+  }
+  // Drops the nodes without workers.
+  nodeWorkers_.erase(
+      std::remove_if(
+          nodeWorkers_.begin(),
+          nodeWorkers_.end(),
+          [](const auto& workers) { return workers.empty(); }),
+      nodeWorkers_.end());
+  for (auto node = 0; node < nodeWorkers_.size(); ++node) {
+    for (auto id : nodeWorkers_[node]) {
+      workers_[id]->node = node;
+    }
+  }
+
+  for (auto& worker : workers_) {
+    worker->thread = std::thread(
+        [this, worker = worker.get(), pinThreads = options.pinThreads]() {
+          if (pinThreads) {
+            pinToCpu(worker->cpu);
+          }
+          run(*worker);
+        });
+  }
+}
+
+DriverExecutor::~DriverExecutor() {
+  stopped_ = true;
+  for (auto& worker : workers_) {
+    wakeup(*worker);
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void DriverExecutor::add(folly::Func func) {
+  if (currentWorker.executor == this) {
+    enqueue(*workers_[currentWorker.id], std::move(func));
+    return;
+  }
+  enqueue(*workers_[nextWorker_++ % workers_.size()], std::move(func));
+}
+
+void DriverExecutor::add(folly::Func func, uint64_t affinityHint) {
+  const auto node = affinityHint % nodeWorkers_.size();
+  if (currentWorker.executor == this &&
+      workers_[currentWorker.id]->node == node) {
+    enqueue(*workers_[currentWorker.id], std::move(func));
+    return;
+  }
+  const auto& nodeWorkers = nodeWorkers_[node];
+  enqueue(
+      *workers_[nodeWorkers[nextWorker_++ % nodeWorkers.size()]],
+      std::move(func));
+}
+
+void DriverExecutor::enqueue(Worker& worker, folly::Func func) {
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.tasks.push_back(std::move(func));
+  }
+  ++numQueued_;
+  if (wakeup(worker)) {
+    return;
+  }
+  // 'worker' is busy. Wakes up an idle worker to steal the task, first on the
+  // same node.
+  for (auto id : nodeWorkers_[worker.node]) {
+    if (id != worker.id && wakeup(*workers_[id])) {
+      return;
+    }
+  }
+  for (auto node = 0; node < nodeWorkers_.size(); ++node) {
+    if (node == worker.node) {
+      continue;
+    }
+    for (auto id : nodeWorkers_[node]) {
+      if (wakeup(*workers_[id])) {
+        return;
+      }
+    }
+  }
+}
+
+bool DriverExecutor::wakeup(Worker& worker) {
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    if (!worker.idle) {
+      return false;
+    }
+    worker.idle = false;
+  }
+  worker.wakeup.notify_one();
+  return true;
+}
+
+bool DriverExecutor::popLocal(Worker& worker, folly::Func& func) {
+  std::lock_guard<std::mutex> l(worker.mutex);
+  if (worker.tasks.empty()) {
+    return false;
+  }
+  func = std::move(worker.tasks.front());
+  worker.tasks.pop_front();
+  --numQueued_;
+  return true;
+}
+
+bool DriverExecutor::steal(Worker& worker, folly::Func& func) {
+  if (numQueued_ <= 0) {
+    return false;
+  }
+  const auto stealFrom = [&](uint32_t node) {
+    const auto& nodeWorkers = nodeWorkers_[node];
+    for (auto i = 0; i < nodeWorkers.size(); ++i) {
+      // Starts after 'worker' to spread the steals over the victims.
+      auto& victim =
+          *workers_[nodeWorkers[(worker.id + i) % nodeWorkers.size()]];
+      if (&victim == &worker) {
+        continue;
+      }
+      std::lock_guard<std::mutex> l(victim.mutex);
+      if (victim.tasks.empty()) {
+        continue;
+      }
+      func = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      --numQueued_;
+      return true;
+    }
+    return false;
+  };
+  if (stealFrom(worker.node)) {
+    ++worker.numSteals;
+    return true;
+  }
+  for (auto i = 1; i < nodeWorkers_.size(); ++i) {
+    if (stealFrom((worker.node + i) % nodeWorkers_.size())) {
+      ++worker.numSteals;
+      ++worker.numRemoteSteals;
+      return true;
+    }
+  }
+  return false;
+}
+
+void DriverExecutor::run(Worker& worker) {
+  currentWorker = {this, worker.id};
+  for (;;) {
+    folly::Func func;
+    if (popLocal(worker, func) || steal(worker, func)) {
+      ++worker.numTasks;
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "DriverExecutor task threw unhandled exception: "
+                   << e.what();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> l(worker.mutex);
+    if (!worker.tasks.empty()) {
+      continue;
+    }
+    if (stopped_ && numQueued_ <= 0) {
+      break;
+    }
+    worker.idle = true;
+    ++worker.numIdleWaits;
+    // Wakes up periodically to steal the tasks queued while all the other
+    // workers were busy.
+    worker.wakeup.wait_for(l, kIdleWait, [&]() {
+      return !worker.idle || !worker.tasks.empty() || stopped_;
+    });
+    worker.idle = false;
+  }
+  currentWorker = {};
+}
+
+std::vector<DriverExecutor::QueueStats> DriverExecutor::stats() const {
+  std::vector<QueueStats> stats;
+  stats.reserve(workers_.size());
+  for (const auto& worker : workers_) {
+    stats.push_back(QueueStats{
+        worker->node,
+        worker->numTasks,
+        worker->numSteals,
+        worker->numRemoteSteals,
+        worker->numIdleWaits});
+  }
+  return stats;
+}
+
+} // namespace facebook::velox::exec
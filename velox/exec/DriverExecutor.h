@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor for running Drivers with one run queue per worker thread and work
+/// stealing between the queues. The workers are grouped by the NUMA node of
+/// the CPU they run on. A task added with an affinity hint goes to a queue on
+/// the NUMA node selected by the hint, so that the drivers of the same Task,
+/// which share the hash tables and the memory of the query, run on the same
+/// node. An idle worker steals from the other queues of its node before it
+/// steals from the queues of the other nodes.
+///
+/// Driver::enqueue uses Task::affinityHint() when the query executor is a
+/// DriverExecutor.
+class DriverExecutor : public folly::Executor {
+ public:
+  struct Options {
+    /// Number of worker threads. 0 means one per CPU.
+    uint32_t numThreads{0};
+
+    /// If true, pins each worker thread to a single CPU. Otherwise the
+    /// workers are only assigned a NUMA node for the placement of the tasks.
+    bool pinThreads{false};
+  };
+
+  /// Counters of a single run queue.
+  struct QueueStats {
+    /// The NUMA node of the worker of the queue.
+    uint32_t numaNode{0};
+
+    /// Number of tasks run by the worker of the queue.
+    uint64_t numTasks{0};
+
+    /// Number of tasks the worker stole from other queues.
+    uint64_t numSteals{0};
+
+    /// Number of the steals from queues of other NUMA nodes.
+    uint64_t numRemoteSteals{0};
+
+    /// Number of times the worker found no task and waited.
+    uint64_t numIdleWaits{0};
+  };
+
+  explicit DriverExecutor(Options options);
+
+  /// Runs the pending tasks, including the ones they add, and joins the worker
+  /// threads. No tasks may be added from outside the executor after this
+  /// starts.
+  ~DriverExecutor() override;
+
+  /// Adds 'func' to the queue of the calling worker thread. If not called on
+  /// a worker thread, adds to the queues in round robin order.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' to a queue of the NUMA node selected by 'affinityHint'.
+  /// Tasks with the same hint go to the same node.
+  void add(folly::Func func, uint64_t affinityHint);
+
+  uint32_t numThreads() const {
+    return workers_.size();
+  }
+
+  uint32_t numNumaNodes() const {
+    return nodeWorkers_.size();
+  }
+
+  /// Returns the counters of the run queues in worker order.
+  std::vector<QueueStats> stats() const;
+
+  /// Returns the CPUs of each NUMA node of the machine. Returns a single node
+  /// with all CPUs if the NUMA topology is not available.
+  static std::vector<std::vector<int32_t>> numaNodeCpus();
+
+ private:
+  // Time an idle worker waits for a task before trying to steal again.
+  static constexpr std::chrono::milliseconds kIdleWait{10};
+
+  struct Worker {
+    uint32_t id;
+    uint32_t node;
+    int32_t cpu;
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<folly::Func> tasks;
+    bool idle{false};
+
+    std::atomic_uint64_t numTasks{0};
+    std::atomic_uint64_t numSteals{0};
+    std::atomic_uint64_t numRemoteSteals{0};
+    std::atomic_uint64_t numIdleWaits{0};
+  };
+
+  void run(Worker& worker);
+
+  // Appends 'func' to the queue of 'worker' and wakes up an idle worker to run
+  // it.
+  void enqueue(Worker& worker, folly::Func func);
+
+  // Pops the oldest task of 'worker'.
+  bool popLocal(Worker& worker, folly::Func& func);
+
+  // Takes the newest task of the other queues, first of the same node.
+  bool steal(Worker& worker, folly::Func& func);
+
+  // Wakes up 'worker' if it is idle. Returns true if it was idle.
+  bool wakeup(Worker& worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // The ids of the workers of each NUMA node.
+  std::vector<std::vector<uint32_t>> nodeWorkers_;
+  // Number of tasks queued and not yet taken by a worker.
+  std::atomic_int64_t numQueued_{0};
+  std::atomic_uint64_t nextWorker_{0};
+  std::atomic_bool stopped_{false};
+};
+
+} // namespace facebook::velox::exec
@@ -52,6 +52,9 @@ Exchange::Exchange(
       serdeOptions_{getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
           serdeKind_)},
+      outputPerPage_{
+          serdeKind_ == VectorSerde::Kind::kPresto &&
+          driverCtx->queryConfig().shuffleDictionaryEncodingEnabled()},
       processSplits_{operatorCtx_->driverCtx()->driverId == 0},
       driverId_{driverCtx->driverId},
       exchangeClient_{std::move(exchangeClient)} {}
@@ -167,7 +170,9 @@ RowVectorPtr Exchange::getOutput() {
       return nullptr;
     }
     vector_size_t resultOffset = 0;
-    for (const auto& page : currentPages_) {
+    const auto numPages = outputPerPage_ ? 1 : currentPages_.size();
+    for (auto i = 0; i < numPages; ++i) {
+      const auto& page = currentPages_[i];
       rawInputBytes += page->size();
 
       auto inputStream = page->prepareStreamForDeserialize();
@@ -182,7 +187,8 @@ RowVectorPtr Exchange::getOutput() {
         resultOffset = result_->size();
       }
     }
-    currentPages_.clear();
+    currentPages_.erase(
+        currentPages_.begin(), currentPages_.begin() + numPages);
     recordInputStats(rawInputBytes);
     return result_;
   }
@@ -97,6 +97,11 @@ class Exchange : public SourceOperator {
 
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
+  // If true, each page is deserialized into its own output vector so that
+  // the dictionary encoded columns of the page are kept. Set if
+  // 'shuffle_dictionary_encoding_enabled' is true for the Presto serde.
+  const bool outputPerPage_;
+
   /// True if this operator is responsible for fetching splits from the Task
   /// and passing these to ExchangeClient.
   const bool processSplits_;
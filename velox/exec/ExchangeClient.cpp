@@ -71,7 +71,7 @@ void ExchangeClient::noMoreRemoteTasks() {
 
 void ExchangeClient::close() {
   std::vector<std::shared_ptr<ExchangeSource>> sources;
-  std::queue<ProducingSource> producingSources;
+  std::deque<ProducingSource> producingSources;
   std::queue<std::shared_ptr<ExchangeSource>> emptySources;
   {
     std::lock_guard<std::mutex> l(queue_->mutex());
@@ -115,6 +115,8 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  stats["queueStallWallNanos"] = RuntimeMetric(
+      queue_->stallTimeUsLocked() * 1'000, RuntimeCounter::Unit::kNanos);
 
   return stats;
 }
@@ -193,12 +195,16 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 if (self->closed_) {
                   return;
                 }
+                if (spec.maxBytes > 0) {
+                  self->updateSourceStatsLocked(
+                      currentSource.get(), requestTimeMs, response.bytes);
+                }
                 if (!response.atEnd) {
                   if (!response.remainingBytes.empty()) {
                     for (auto bytes : response.remainingBytes) {
                       VELOX_CHECK_GT(bytes, 0);
                     }
-                    self->producingSources_.push(
+                    self->producingSources_.push_back(
                         {std::move(spec.source),
                          std::move(response.remainingBytes)});
                   } else {
@@ -241,14 +247,42 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+  if (queue_->numWaitingConsumersLocked() > 0 &&
+      producingSources_.size() > 1) {
+    // Consumers are blocked on the sources. Request first from the ones that
+    // are expected to respond soonest.
+    std::stable_sort(
+        producingSources_.begin(),
+        producingSources_.end(),
+        [&](const ProducingSource& left, const ProducingSource& right) {
+          auto leftIt = sourceStats_.find(left.source.get());
+          auto rightIt = sourceStats_.find(right.source.get());
+          const double leftMs =
+              leftIt == sourceStats_.end() ? 0 : leftIt->second.latencyMs;
+          const double rightMs =
+              rightIt == sourceStats_.end() ? 0 : rightIt->second.latencyMs;
+          return leftMs < rightMs;
+        });
+  }
+  // Share the free space between the sources that have data so that a few
+  // sources do not take all of it while the others wait.
+  const int64_t fairShareBytes = producingSources_.empty()
+      ? 0
+      : availableSpace / static_cast<int64_t>(producingSources_.size());
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
+    const auto maxRequestBytes =
+        maxRequestBytesLocked(source.get(), fairShareBytes);
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+      if (requestBytes > 0 && requestBytes + bytes > maxRequestBytes) {
         break;
       }
+      if (bytes > availableSpace) {
+        availableSpace -= bytes;
+        break;
+      }
+      availableSpace -= bytes;
       requestBytes += bytes;
     }
     if (requestBytes == 0) {
@@ -257,7 +291,7 @@ ExchangeClient::pickSourcesToRequestLocked() {
     }
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    producingSources_.pop_front();
     totalPendingBytes_ += requestBytes;
   }
 
@@ -277,12 +311,44 @@ ExchangeClient::pickSourcesToRequestLocked() {
               << " bytes, exceeding capacity " << maxQueuedBytes_;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    producingSources_.pop_front();
     totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
 }
 
+int64_t ExchangeClient::maxRequestBytesLocked(
+    const ExchangeSource* source,
+    int64_t fairShareBytes) const {
+  int64_t maxBytes = fairShareBytes;
+  auto it = sourceStats_.find(source);
+  if (it != sourceStats_.end()) {
+    maxBytes = std::max<int64_t>(
+        maxBytes, it->second.bytesPerMs * kTargetRequestTimeMs);
+  }
+  return maxBytes;
+}
+
+void ExchangeClient::updateSourceStatsLocked(
+    const ExchangeSource* source,
+    int64_t requestTimeMs,
+    int64_t bytes) {
+  // Weight of the latest response in the moving averages.
+  constexpr double kWeight = 0.3;
+  auto& stats = sourceStats_[source];
+  const double bytesPerMs =
+      static_cast<double>(bytes) / std::max<int64_t>(requestTimeMs, 1);
+  if (stats.numResponses == 0) {
+    stats.latencyMs = requestTimeMs;
+    stats.bytesPerMs = bytesPerMs;
+  } else {
+    stats.latencyMs =
+        kWeight * requestTimeMs + (1 - kWeight) * stats.latencyMs;
+    stats.bytesPerMs = kWeight * bytesPerMs + (1 - kWeight) * stats.bytesPerMs;
+  }
+  ++stats.numResponses;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
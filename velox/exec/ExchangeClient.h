@@ -26,6 +26,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
  public:
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr std::chrono::milliseconds kRequestDataMaxWait{100};
+  /// A source may be asked for more than its share of the free queue space if
+  /// it is expected to return that many bytes within this time.
+  static constexpr int64_t kTargetRequestTimeMs{500};
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
 
   ExchangeClient(
@@ -127,8 +130,29 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     std::vector<int64_t> remainingBytes;
   };
 
+  // Observed performance of the data requests to a source.
+  struct SourceStats {
+    // Moving averages of the request time and the bytes received per ms.
+    double latencyMs{0};
+    double bytesPerMs{0};
+    int64_t numResponses{0};
+  };
+
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Returns the max bytes to request from 'source' given its share of the free
+  // queue space. A source that sends more than that within
+  // kTargetRequestTimeMs may be asked for more. The first page is always
+  // requested regardless.
+  int64_t maxRequestBytesLocked(
+      const ExchangeSource* source,
+      int64_t fairShareBytes) const;
+
+  void updateSourceStatsLocked(
+      const ExchangeSource* source,
+      int64_t requestTimeMs,
+      int64_t bytes);
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
@@ -153,8 +177,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   int64_t totalPendingBytes_{0};
 
   // A queue of sources that have returned non-empty response from the latest
-  // request.
-  std::queue<ProducingSource> producingSources_;
+  // request. Requested in order, except that the sources with the lowest
+  // latency go first while consumers are waiting for data.
+  std::deque<ProducingSource> producingSources_;
+  folly::F14FastMap<const ExchangeSource*, SourceStats> sourceStats_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
 };
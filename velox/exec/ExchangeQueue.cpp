@@ -16,6 +16,8 @@
 #include "velox/exec/ExchangeQueue.h"
 #include <algorithm>
 
+#include "velox/common/time/Timer.h"
+
 namespace facebook::velox::exec {
 
 SerializedPage::SerializedPage(
@@ -110,6 +112,21 @@ void ExchangeQueue::enqueueLocked(
     promises.push_back(std::move(it->second));
     promises_.erase(it);
   }
+  endStallLocked();
+}
+
+uint64_t ExchangeQueue::stallTimeUsLocked() const {
+  if (stallStartUs_ == 0) {
+    return stallTimeUs_;
+  }
+  return stallTimeUs_ + (getCurrentTimeMicro() - stallStartUs_);
+}
+
+void ExchangeQueue::endStallLocked() {
+  if (promises_.empty() && stallStartUs_ != 0) {
+    stallTimeUs_ += getCurrentTimeMicro() - stallStartUs_;
+    stallStartUs_ = 0;
+  }
 }
 
 void ExchangeQueue::addPromiseLocked(
@@ -118,6 +135,9 @@ void ExchangeQueue::addPromiseLocked(
     ContinuePromise* stalePromise) {
   ContinuePromise promise{"ExchangeQueue::dequeue"};
   *future = promise.getSemiFuture();
+  if (promises_.empty()) {
+    stallStartUs_ = getCurrentTimeMicro();
+  }
   auto it = promises_.find(consumerId);
   if (it != promises_.end()) {
     // resolve stale promises outside the lock to avoid broken promises
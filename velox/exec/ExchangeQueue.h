@@ -155,6 +155,15 @@ class ExchangeQueue {
     return receivedPages_ > 0 ? receivedBytes_ / receivedPages_ : 0;
   }
 
+  /// Returns the number of consumers waiting for data.
+  int32_t numWaitingConsumersLocked() const {
+    return promises_.size();
+  }
+
+  /// Returns the wall time in microseconds during which at least one consumer
+  /// was waiting for data, including the current wait.
+  uint64_t stallTimeUsLocked() const;
+
   void addSourceLocked() {
     VELOX_CHECK(!noMoreSources_, "addSource called after noMoreSources");
     numSources_++;
@@ -200,9 +209,14 @@ class ExchangeQueue {
       it = promises_.erase(it);
     }
     VELOX_CHECK(promises_.empty());
+    endStallLocked();
     return promises;
   }
 
+  // Adds the time since the first consumer started waiting to 'stallTimeUs_'
+  // if no consumer is waiting anymore.
+  void endStallLocked();
+
   static void clearPromises(std::vector<ContinuePromise>& promises) {
     for (auto& promise : promises) {
       promise.setValue();
@@ -236,5 +250,10 @@ class ExchangeQueue {
   int64_t receivedBytes_{0};
   // Maximum value of totalBytes_.
   int64_t peakBytes_{0};
+  // Time when 'promises_' became non-empty. 0 if 'promises_' is empty.
+  uint64_t stallStartUs_{0};
+  // Total time during which 'promises_' was non-empty, excluding the current
+  // wait.
+  uint64_t stallTimeUs_{0};
 };
 } // namespace facebook::velox::exec
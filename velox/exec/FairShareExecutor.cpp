@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareExecutor.h"
+
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+
+FairShareExecutor::FairShareExecutor(
+    folly::Executor* executor,
+    uint32_t maxConcurrency)
+    : executor_(executor), maxConcurrency_(maxConcurrency) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(maxConcurrency_, 0);
+}
+
+FairShareExecutor::~FairShareExecutor() {
+  std::unique_lock<std::mutex> l(mutex_);
+  finished_.wait(l, [&]() { return numQueued_ == 0 && numRunning_ == 0; });
+}
+
+void FairShareExecutor::add(folly::Func func) {
+  add(std::move(func), nullptr);
+}
+
+void FairShareExecutor::add(
+    folly::Func func,
+    std::shared_ptr<core::QueryCtx> queryCtx) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& query = queries_[queryCtx.get()];
+    if (query == nullptr) {
+      query = std::make_unique<Query>();
+      if (queryCtx != nullptr) {
+        query->cpuShares = queryCtx->queryConfig().queryCpuShares();
+        query->virtualRuntimeNanos =
+            queryCtx->schedulingStats().rlock()->virtualRuntimeNanos;
+        query->queryCtx = std::move(queryCtx);
+      }
+    }
+    if (query->queue.empty() && query->numRunning == 0) {
+      query->virtualRuntimeNanos =
+          std::max(query->virtualRuntimeNanos, minVirtualRuntimeNanos_);
+    }
+    query->queue.emplace_back(std::move(func), getCurrentTimeNano());
+    ++numQueued_;
+  }
+  runQueued();
+}
+
+void FairShareExecutor::runQueued() {
+  for (;;) {
+    Query* next{nullptr};
+    folly::Func func;
+    uint64_t queuedNanos{0};
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (numRunning_ >= maxConcurrency_ || numQueued_ == 0) {
+        return;
+      }
+      for (auto& [_, query] : queries_) {
+        if (!query->queue.empty() &&
+            (next == nullptr ||
+             query->virtualRuntimeNanos < next->virtualRuntimeNanos)) {
+          next = query.get();
+        }
+      }
+      VELOX_CHECK_NOT_NULL(next);
+      func = std::move(next->queue.front().first);
+      queuedNanos = getCurrentTimeNano() - next->queue.front().second;
+      next->queue.pop_front();
+      --numQueued_;
+      ++next->numRunning;
+      ++numRunning_;
+      minVirtualRuntimeNanos_ =
+          std::max(minVirtualRuntimeNanos_, next->virtualRuntimeNanos);
+    }
+    executor_->add(
+        [this, next, func = std::move(func), queuedNanos]() mutable {
+          const auto startNanos = getCurrentTimeNano();
+          try {
+            func();
+          } catch (const std::exception& e) {
+            LOG(ERROR) << "FairShareExecutor task threw unhandled exception: "
+                       << e.what();
+          }
+          // Releases the captures of 'func' before the query may go away.
+          func = {};
+          finish(next, getCurrentTimeNano() - startNanos, queuedNanos);
+        });
+  }
+}
+
+void FairShareExecutor::finish(
+    Query* query,
+    uint64_t runNanos,
+    uint64_t queuedNanos) {
+  std::shared_ptr<core::QueryCtx> finishedQueryCtx;
+  bool hasQueued;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    --query->numRunning;
+    --numRunning_;
+    query->virtualRuntimeNanos += runNanos / query->cpuShares;
+    if (query->queryCtx != nullptr) {
+      auto stats = query->queryCtx->schedulingStats().wlock();
+      ++stats->numRuns;
+      stats->runNanos += runNanos;
+      stats->queuedNanos += queuedNanos;
+      stats->virtualRuntimeNanos = query->virtualRuntimeNanos;
+    }
+    if (query->queue.empty() && query->numRunning == 0 &&
+        query->queryCtx != nullptr) {
+      // The QueryCtx is released outside of the lock.
+      finishedQueryCtx = std::move(query->queryCtx);
+      queries_.erase(finishedQueryCtx.get());
+    }
+    hasQueued = numQueued_ > 0;
+    if (!hasQueued && numRunning_ == 0) {
+      // The destructor may run after this.
+      finished_.notify_all();
+    }
+  }
+  if (hasQueued) {
+    runQueued();
+  }
+}
+
+uint64_t FairShareExecutor::numQueued() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numQueued_;
+}
+
+uint32_t FairShareExecutor::numRunning() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numRunning_;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "velox/core/QueryCtx.h"
+
+namespace facebook::velox::exec {
+
+/// Executor in front of another executor that shares the threads between the
+/// queries in proportion to their CPU shares, see QueryConfig::kQueryCpuShares.
+/// It runs up to 'maxConcurrency' functions at a time on the underlying
+/// executor. When one finishes, it runs the oldest queued function of the
+/// query with the least virtual runtime, which is the time the functions of
+/// the query ran divided by its shares. A query that has nothing to run gets
+/// no credit: when it has a function to run again, its virtual runtime is
+/// moved forward to the virtual runtime of the queries that did run.
+///
+/// Driver::enqueue adds the drivers of a Task for its QueryCtx when the query
+/// executor is a FairShareExecutor. A driver holds its thread until it blocks,
+/// finishes or yields, so the shares are only kept at the granularity of
+/// QueryConfig::kDriverCpuTimeSliceLimitMs.
+///
+/// The time each query ran and waited is exported in
+/// QueryCtx::schedulingStats().
+class FairShareExecutor : public folly::Executor {
+ public:
+  /// 'maxConcurrency' is typically the number of threads of 'executor'.
+  FairShareExecutor(folly::Executor* executor, uint32_t maxConcurrency);
+
+  /// Waits for the queued and running functions.
+  ~FairShareExecutor() override;
+
+  /// Adds 'func' outside of any query. These functions are scheduled together
+  /// like a query with one share.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' for 'queryCtx'.
+  void add(folly::Func func, std::shared_ptr<core::QueryCtx> queryCtx);
+
+  /// Returns the number of functions that wait to run.
+  uint64_t numQueued() const;
+
+  /// Returns the number of functions running on the underlying executor.
+  uint32_t numRunning() const;
+
+ private:
+  struct Query {
+    // nullptr for the functions outside of a query.
+    std::shared_ptr<core::QueryCtx> queryCtx;
+    uint32_t cpuShares{1};
+    uint64_t virtualRuntimeNanos{0};
+    // The queued functions with their enqueue time.
+    std::deque<std::pair<folly::Func, uint64_t>> queue;
+    uint32_t numRunning{0};
+  };
+
+  // Starts the queued functions while fewer than 'maxConcurrency_' run.
+  void runQueued();
+
+  // Records that a function of 'query' ran for 'runNanos' after waiting for
+  // 'queuedNanos' and starts the next one.
+  void finish(Query* query, uint64_t runNanos, uint64_t queuedNanos);
+
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrency_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable finished_;
+  // The queries with queued or running functions, by their QueryCtx.
+  folly::F14FastMap<const core::QueryCtx*, std::unique_ptr<Query>> queries_;
+  // The largest virtual runtime of a query when it started a function.
+  uint64_t minVirtualRuntimeNanos_{0};
+  uint64_t numQueued_{0};
+  uint32_t numRunning_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 #include "velox/exec/FilterProject.h"
+#include <folly/ScopeGuard.h>
 #include "velox/core/Expressions.h"
+#include "velox/exec/Task.h"
+#include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 
@@ -133,13 +136,47 @@ void FilterProject::initialize() {
       auto fieldIndex = inputType->getChildIdx(field->name());
       distinctFieldIndices.insert(fieldIndex);
     }
+    std::unordered_set<uint32_t> loadedByFilter;
+    if (auto* conjunct = filterConjunct()) {
+      for (auto* field : conjunct->fieldsLoadedOnActiveRows()) {
+        loadedByFilter.insert(inputType->getChildIdx(field->name()));
+      }
+    }
     for (auto identityField : identityProjections_) {
       if (distinctFieldIndices.find(identityField.inputChannel) !=
-          distinctFieldIndices.end()) {
+              distinctFieldIndices.end() &&
+          loadedByFilter.count(identityField.inputChannel) == 0) {
         multiplyReferencedFieldIndices_.push_back(identityField.inputChannel);
       }
     }
   }
+
+  if (!isIdentityProjection_ && !identityProjections_.empty() &&
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .filterProjectPrefetchLazyColumns()) {
+    const auto& inputType = project_->sources()[0]->outputType();
+    std::unordered_set<column_index_t> exprFieldIndices;
+    for (auto* field : exprs_->distinctFields()) {
+      exprFieldIndices.insert(inputType->getChildIdx(field->name()));
+    }
+    for (const auto& identityField : identityProjections_) {
+      if (exprFieldIndices.count(identityField.inputChannel) == 0) {
+        prefetchFieldIndices_.push_back(identityField.inputChannel);
+      }
+    }
+    if (!prefetchFieldIndices_.empty()) {
+      std::unordered_set<column_index_t> projectionFieldIndices;
+      for (auto i = hasFilter_ ? 1 : 0; i < numExprs_; ++i) {
+        for (auto* field : exprs_->expr(i)->distinctFields()) {
+          projectionFieldIndices.insert(inputType->getChildIdx(field->name()));
+        }
+      }
+      projectionFieldIndices_.assign(
+          projectionFieldIndices.begin(), projectionFieldIndices.end());
+      executor_ = operatorCtx_->task()->queryCtx()->executor();
+    }
+  }
   filter_.reset();
   project_.reset();
 }
@@ -218,12 +255,87 @@ RowVectorPtr FilterProject::getOutput() {
 std::vector<VectorPtr> FilterProject::project(
     const SelectivityVector& rows,
     EvalCtx& evalCtx) {
+  auto prefetch = startPrefetch(rows, evalCtx);
+  // The prefetch refers to the input, so it must complete also if the
+  // projections fail.
+  auto prefetchGuard = folly::makeGuard([&]() {
+    if (prefetch != nullptr) {
+      prefetch->close();
+    }
+  });
   std::vector<VectorPtr> results;
   exprs_->eval(
       hasFilter_ ? 1 : 0, numExprs_, !hasFilter_, rows, evalCtx, results);
+  if (prefetch != nullptr) {
+    prefetch->move();
+  }
   return results;
 }
 
+std::shared_ptr<AsyncSource<bool>> FilterProject::startPrefetch(
+    const SelectivityVector& rows,
+    EvalCtx& evalCtx) {
+  if (executor_ == nullptr) {
+    return nullptr;
+  }
+  std::vector<VectorPtr> columns;
+  for (auto fieldIdx : prefetchFieldIndices_) {
+    const auto& column = input_->childAt(fieldIdx);
+    if (isLazyNotLoaded(*column)) {
+      columns.push_back(column);
+    }
+  }
+  if (columns.empty()) {
+    return nullptr;
+  }
+  for (auto fieldIdx : projectionFieldIndices_) {
+    evalCtx.ensureFieldLoaded(fieldIdx, rows);
+  }
+  addRuntimeStat(kPrefetchedLazyColumns, RuntimeCounter(columns.size()));
+
+  auto prefetch = std::make_shared<AsyncSource<bool>>(
+      [columns = std::move(columns), rows = rows]() {
+        for (const auto& column : columns) {
+          LazyVector::ensureLoadedRows(column, rows);
+        }
+        return std::make_unique<bool>(true);
+      });
+  DriverCtx* driverCtx{nullptr};
+  if (const auto* driverThreadCtx = driverThreadContext()) {
+    driverCtx = driverThreadCtx->driverCtx();
+  }
+  executor_->add([driverCtx, prefetch]() {
+    ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+    prefetch->prepare();
+  });
+  return prefetch;
+}
+
+ConjunctExpr* FilterProject::filterConjunct() const {
+  if (!hasFilter_ || exprs_ == nullptr) {
+    return nullptr;
+  }
+  auto* conjunct = dynamic_cast<ConjunctExpr*>(exprs_->expr(0).get());
+  if (conjunct == nullptr || !conjunct->isAnd()) {
+    return nullptr;
+  }
+  return conjunct;
+}
+
+void FilterProject::addFilterConjunctStats() {
+  const auto* conjunct = filterConjunct();
+  if (conjunct == nullptr) {
+    return;
+  }
+  addRuntimeStat(
+      kFilterConjunctReorders, RuntimeCounter(conjunct->numReorders()));
+  const auto& order = conjunct->inputOrder();
+  for (auto i = 0; i < order.size(); ++i) {
+    addRuntimeStat(
+        fmt::format("{}{}", kFilterConjunctOrder, i), RuntimeCounter(order[i]));
+  }
+}
+
 vector_size_t FilterProject::filter(
     EvalCtx& evalCtx,
     const SelectivityVector& allRows) {
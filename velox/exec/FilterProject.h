@@ -15,14 +15,31 @@
  */
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
 
 namespace facebook::velox::exec {
+class ConjunctExpr;
+
 class FilterProject : public Operator {
  public:
+  /// Runtime stats of a filter that is an AND. The number of times the
+  /// evaluation order of the conjuncts changed.
+  static inline const std::string kFilterConjunctReorders{
+      "filterConjunctReorders"};
+  /// The prefix of the stats with the final evaluation order of the
+  /// conjuncts. The stat for position N is the index of the conjunct that is
+  /// evaluated Nth.
+  static inline const std::string kFilterConjunctOrder{"filterConjunctOrder"};
+  /// Runtime stat with the number of lazy columns loaded on the query
+  /// executor while the projections were computed. See
+  /// QueryConfig::kFilterProjectPrefetchLazyColumns.
+  static inline const std::string kPrefetchedLazyColumns{
+      "prefetchedLazyColumns"};
+
   FilterProject(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -54,6 +71,7 @@ class FilterProject : public Operator {
   void close() override {
     Operator::close();
     if (exprs_ != nullptr) {
+      addFilterConjunctStats();
       exprs_->clear();
     } else {
       VELOX_CHECK(!initialized_);
@@ -86,12 +104,28 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
-  // Evaluate projections on the specified rows and return the results.
+  // Returns the filter if it is an AND of conjuncts, nullptr otherwise.
+  ConjunctExpr* filterConjunct() const;
+
+  // Reports the evaluation order the filter conjuncts settled on.
+  void addFilterConjunctStats();
+
+  // Evaluate projections on the specified rows and return the results. Loads
+  // the lazy columns of 'prefetchFieldIndices_' for these rows meanwhile if
+  // 'executor_' is set.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
       const SelectivityVector& rows,
       EvalCtx& evalCtx);
 
+  // Loads the fields read by the projections for 'rows' and starts loading
+  // the lazy columns of 'prefetchFieldIndices_' for 'rows' on 'executor_'.
+  // Returns nullptr if there is nothing to prefetch. The caller must call
+  // move() on the result before using the prefetched columns.
+  std::shared_ptr<AsyncSource<bool>> startPrefetch(
+      const SelectivityVector& rows,
+      EvalCtx& evalCtx);
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
 
@@ -115,7 +149,22 @@ class FilterProject : public Operator {
   // Consider projection with 2 expressions: f(c0) AND g(c1), c1
   // If c1 is a LazyVector and f(c0) AND g(c1) expression is evaluated first, it
   // will load c1 only for rows where f(c0) is true. However, c1 identity
-  // projection needs all rows.
+  // projection needs all rows. The fields that a filter of conjuncts loads on
+  // the rows that are still active when they are first needed are not
+  // preloaded, since the filter loads them for all the rows that pass.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Set if kFilterProjectPrefetchLazyColumns is enabled and there are identity
+  // projections that no expression reads, see 'prefetchFieldIndices_'.
+  folly::Executor* executor_{nullptr};
+
+  // Input channels of the identity projections that no expression reads.
+  // These are loaded on 'executor_' while the projections are computed.
+  std::vector<column_index_t> prefetchFieldIndices_;
+
+  // Input channels read by the projections. These are loaded on the driver
+  // thread before starting the prefetch, since the loaders of the columns of
+  // a batch must not run concurrently.
+  std::vector<column_index_t> projectionFieldIndices_;
 };
 } // namespace facebook::velox::exec
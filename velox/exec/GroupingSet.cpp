@@ -15,6 +15,7 @@
  */
 #include "velox/exec/GroupingSet.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -69,6 +70,7 @@ GroupingSet::GroupingSet(
       groupIdChannel_(groupIdChannel),
       spillConfig_(spillConfig),
       nonReclaimableSection_(nonReclaimableSection),
+      denseAggregationMaxGroups_(queryConfig_.denseAggregationMaxGroups()),
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
@@ -152,6 +154,44 @@ std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
       /*spillStats=*/nullptr);
 };
 
+std::unique_ptr<GroupingSet> GroupingSet::createRadixPartitioned(
+    const RowTypePtr& inputType,
+    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
+    const HashBitRange& partitionBits,
+    const std::function<std::unique_ptr<GroupingSet>()>& makePartition,
+    OperatorCtx* operatorCtx,
+    tsan_atomic<bool>* nonReclaimableSection) {
+  VELOX_CHECK(!hashers.empty());
+  VELOX_CHECK_GT(partitionBits.numBits(), 0);
+  auto groupingSet = std::make_unique<GroupingSet>(
+      inputType,
+      std::move(hashers),
+      /*preGroupedKeys=*/std::vector<column_index_t>{},
+      /*groupingKeyOutputProjections=*/std::vector<column_index_t>{},
+      /*aggregates=*/std::vector<AggregateInfo>{},
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/false,
+      /*isRawInput=*/false,
+      /*globalGroupingSets=*/std::vector<vector_size_t>{},
+      /*groupIdColumn=*/std::nullopt,
+      /*spillConfig=*/nullptr,
+      nonReclaimableSection,
+      operatorCtx,
+      /*spillStats=*/nullptr);
+  groupingSet->partitionBits_ = partitionBits;
+  const auto numPartitions = partitionBits.numPartitions();
+  groupingSet->partitions_.reserve(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    auto partition = makePartition();
+    VELOX_CHECK(!partition->isGlobal_);
+    VELOX_CHECK(!partition->isPartial_);
+    VELOX_CHECK(partition->preGroupedKeyChannels_.empty());
+    VELOX_CHECK(partition->globalGroupingSets_.empty());
+    groupingSet->partitions_.push_back(std::move(partition));
+  }
+  return groupingSet;
+}
+
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -170,6 +210,11 @@ bool equalKeys(
 } // namespace
 
 void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
+  if (isRadixPartitioned()) {
+    addPartitionedInput(input);
+    return;
+  }
+
   if (isGlobal_) {
     addGlobalAggregationInput(input, mayPushdown);
     return;
@@ -202,9 +247,59 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
+void GroupingSet::addPartitionedInput(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  numInputRows_ += numRows;
+
+  // Each partition gets a dictionary over 'input'. Loads the lazy columns
+  // once here instead of once per partition.
+  input->loadedVector();
+
+  activeRows_.resize(numRows);
+  activeRows_.setAll();
+  partitionHashes_.resize(numRows);
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    auto& hasher = hashers_[i];
+    hasher->decode(*input->childAt(hasher->channel()), activeRows_);
+    hasher->hash(activeRows_, i > 0, partitionHashes_);
+  }
+
+  const auto numPartitions = partitions_.size();
+  std::vector<BufferPtr> indices(numPartitions);
+  std::vector<vector_size_t*> rawIndices(numPartitions);
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    indices[partition] = allocateIndices(numRows, &pool_);
+    rawIndices[partition] = indices[partition]->asMutable<vector_size_t>();
+  }
+  std::vector<vector_size_t> numPartitionRows(numPartitions, 0);
+  for (auto row = 0; row < numRows; ++row) {
+    const auto partition = partitionBits_.partition(partitionHashes_[row]);
+    rawIndices[partition][numPartitionRows[partition]++] = row;
+  }
+
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto size = numPartitionRows[partition];
+    if (size == 0) {
+      continue;
+    }
+    // The rows of 'input' are shared by the partitions, so the partitions
+    // must not push down aggregates into the possibly lazy columns.
+    partitions_[partition]->addInput(
+        size == numRows ? input : wrap(size, indices[partition], input),
+        /*mayPushdown=*/false);
+  }
+}
+
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
 
+  if (isRadixPartitioned()) {
+    for (auto& partition : partitions_) {
+      partition->noMoreInput();
+    }
+    return;
+  }
+
   if (remainingInput_) {
     addRemainingInput();
   }
@@ -221,6 +316,12 @@ void GroupingSet::noMoreInput() {
 }
 
 bool GroupingSet::hasSpilled() const {
+  if (isRadixPartitioned()) {
+    return std::any_of(
+        partitions_.begin(), partitions_.end(), [](const auto& partition) {
+          return partition->hasSpilled();
+        });
+  }
   if (inputSpiller_ != nullptr) {
     VELOX_CHECK_NULL(outputSpiller_);
     return true;
@@ -261,6 +362,14 @@ void GroupingSet::addInputForActiveRows(
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
 
+  const bool useDense = useDenseAccumulators();
+  if (useDense) {
+    denseGroups_.assign(table_->capacity(), nullptr);
+    for (auto row : lookup_->rows) {
+      denseGroups_[lookup_->hashes[row]] = groups[row];
+    }
+  }
+
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
@@ -296,7 +405,11 @@ void GroupingSet::addInputForActiveRows(
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      if (useDense && !canPushdown && function->supportsDenseInput()) {
+        addDenseInput(i, rows);
+      } else {
+        function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      }
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
     }
@@ -311,6 +424,39 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+bool GroupingSet::useDenseAccumulators() const {
+  if (!isRawInput_ || denseAggregationMaxGroups_ == 0 ||
+      table_->hashMode() != BaseHashTable::HashMode::kArray) {
+    return false;
+  }
+  // Initializing and adding the dense accumulators is proportional to the
+  // number of slots, so there must be at least as many input rows.
+  const auto numSlots = table_->capacity();
+  return numSlots <= denseAggregationMaxGroups_ &&
+      numSlots <= lookup_->rows.size();
+}
+
+void GroupingSet::addDenseInput(
+    int32_t aggregateIndex,
+    const SelectivityVector& rows) {
+  auto& function = aggregates_[aggregateIndex].function;
+  const auto numGroups = denseGroups_.size();
+  denseAccumulators_.resize(numGroups * function->accumulatorFixedWidthSize());
+  denseNonNullGroups_.assign(bits::nwords(numGroups), 0);
+  function->initializeDenseAccumulators(denseAccumulators_.data(), numGroups);
+  function->addRawDenseInput(
+      lookup_->hashes.data(),
+      rows,
+      tempVectors_,
+      denseAccumulators_.data(),
+      denseNonNullGroups_.data());
+  function->addDenseAccumulators(
+      denseGroups_.data(),
+      numGroups,
+      denseAccumulators_.data(),
+      denseNonNullGroups_.data());
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -738,6 +884,11 @@ bool GroupingSet::getOutput(
     int32_t maxOutputBytes,
     RowContainerIterator& iterator,
     RowVectorPtr& result) {
+  if (isRadixPartitioned()) {
+    return getPartitionedOutput(
+        maxOutputRows, maxOutputBytes, iterator, result);
+  }
+
   TestValue::adjust("facebook::velox::exec::GroupingSet::getOutput", this);
 
   if (isGlobal_) {
@@ -770,6 +921,136 @@ bool GroupingSet::getOutput(
   return true;
 }
 
+bool GroupingSet::getPartitionedOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
+    RowVectorPtr& result) {
+  for (; outputPartition_ < partitions_.size(); ++outputPartition_) {
+    if (partitions_[outputPartition_]->getOutput(
+            maxOutputRows, maxOutputBytes, iterator, result)) {
+      return true;
+    }
+    // 'iterator' is positioned in the rows of a single partition.
+    iterator.reset();
+  }
+  return false;
+}
+
+bool GroupingSet::canMergePartitions() const {
+  if (!isRadixPartitioned()) {
+    return false;
+  }
+  for (const auto& partition : partitions_) {
+    if (partition->sortedAggregations_ != nullptr ||
+        partition->hasSpilled()) {
+      return false;
+    }
+    for (const auto& aggregation : partition->distinctAggregations_) {
+      if (aggregation != nullptr) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void GroupingSet::mergePartition(int32_t partition, GroupingSet& other) {
+  VELOX_CHECK(canMergePartitions());
+  VELOX_CHECK(other.canMergePartitions());
+  VELOX_CHECK_EQ(numPartitions(), other.numPartitions());
+  partitions_[partition]->mergeGroups(*other.partitions_[partition]);
+}
+
+void GroupingSet::clearPartition(int32_t partition) {
+  VELOX_CHECK(isRadixPartitioned());
+  partitions_[partition]->resetTable(/*freeTable=*/true);
+}
+
+void GroupingSet::mergeGroups(GroupingSet& other) {
+  VELOX_CHECK_EQ(aggregates_.size(), other.aggregates_.size());
+  if (other.table_ == nullptr) {
+    return;
+  }
+  constexpr int32_t kBatchSize = 1'024;
+  auto* otherRows = other.table_->rows();
+  const auto& otherHashers = other.table_->hashers();
+  VELOX_CHECK_EQ(otherHashers.size(), keyChannels_.size());
+
+  // The hashers of 'this' read the keys at their input channels. The other
+  // channels are filled with null constants.
+  const auto numChannels =
+      *std::max_element(keyChannels_.begin(), keyChannels_.end()) + 1;
+  std::vector<std::string> names(numChannels);
+  std::vector<TypePtr> types(numChannels, UNKNOWN());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    types[keyChannels_[i]] = otherHashers[i]->type();
+  }
+  const auto inputType = ROW(std::move(names), std::move(types));
+
+  std::vector<char*> groups(kBatchSize);
+  std::vector<VectorPtr> accumulators(aggregates_.size());
+  RowContainerIterator iterator;
+  for (;;) {
+    const auto numGroups =
+        otherRows->listRows(&iterator, kBatchSize, groups.data());
+    if (numGroups == 0) {
+      break;
+    }
+    std::vector<VectorPtr> keys(numChannels);
+    for (auto channel = 0; channel < numChannels; ++channel) {
+      keys[channel] = BaseVector::createNullConstant(
+          inputType->childAt(channel), numGroups, &pool_);
+    }
+    for (auto i = 0; i < keyChannels_.size(); ++i) {
+      auto& key = keys[keyChannels_[i]];
+      key = BaseVector::create(otherHashers[i]->type(), numGroups, &pool_);
+      otherRows->extractColumn(groups.data(), numGroups, i, key);
+    }
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      accumulators[i] = BaseVector::create(
+          aggregates_[i].intermediateType, numGroups, &pool_);
+      other.aggregates_[i].function->extractAccumulators(
+          groups.data(), numGroups, &accumulators[i]);
+    }
+    addIntermediateGroups(
+        std::make_shared<RowVector>(
+            &pool_, inputType, nullptr, numGroups, std::move(keys)),
+        accumulators);
+  }
+}
+
+void GroupingSet::addIntermediateGroups(
+    const RowVectorPtr& input,
+    const std::vector<VectorPtr>& accumulators) {
+  if (!table_) {
+    createHashTable();
+  }
+  activeRows_.resize(input->size());
+  activeRows_.setAll();
+  table_->prepareForGroupProbe(
+      *lookup_,
+      input,
+      activeRows_,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (lookup_->rows.empty()) {
+    return;
+  }
+  table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+
+  auto* groups = lookup_->hits.data();
+  const auto& newGroups = lookup_->newGroups;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& function = aggregates_[i].function;
+    if (!newGroups.empty()) {
+      function->initializeNewGroups(groups, newGroups);
+    }
+    tempVectors_ = {accumulators[i]};
+    function->addIntermediateResults(groups, activeRows_, tempVectors_, false);
+  }
+  tempVectors_.clear();
+}
+
 void GroupingSet::extractGroups(
     RowContainer* rowContainer,
     folly::Range<char**> groups,
@@ -814,6 +1095,9 @@ void GroupingSet::extractGroups(
 }
 
 void GroupingSet::resetTable(bool freeTable) {
+  for (auto& partition : partitions_) {
+    partition->resetTable(freeTable);
+  }
   if (table_ != nullptr) {
     table_->clear(freeTable);
   }
@@ -843,6 +1127,12 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
 
 uint64_t GroupingSet::allocatedBytes() const {
   uint64_t totalBytes{0};
+  if (isRadixPartitioned()) {
+    for (const auto& partition : partitions_) {
+      totalBytes += partition->allocatedBytes();
+    }
+    return totalBytes;
+  }
   if (sortedAggregations_ != nullptr) {
     totalBytes += sortedAggregations_->inputRowBytes();
   }
@@ -855,9 +1145,59 @@ uint64_t GroupingSet::allocatedBytes() const {
 }
 
 const HashLookup& GroupingSet::hashLookup() const {
+  if (isRadixPartitioned()) {
+    // Returns the lookup of the first partition that has received input.
+    for (const auto& partition : partitions_) {
+      if (partition->lookup_ != nullptr) {
+        return *partition->lookup_;
+      }
+    }
+    VELOX_FAIL("None of the partitions has received input");
+  }
   return *lookup_;
 }
 
+int64_t GroupingSet::numDistinct() const {
+  if (isRadixPartitioned()) {
+    int64_t numDistinct{0};
+    for (const auto& partition : partitions_) {
+      numDistinct += partition->numDistinct();
+    }
+    return numDistinct;
+  }
+  return table_ ? table_->numDistinct() : 0;
+}
+
+HashTableStats GroupingSet::hashTableStats() const {
+  if (isRadixPartitioned()) {
+    HashTableStats stats;
+    for (const auto& partition : partitions_) {
+      const auto partitionStats = partition->hashTableStats();
+      stats.capacity += partitionStats.capacity;
+      stats.numRehashes += partitionStats.numRehashes;
+      stats.numDistinct += partitionStats.numDistinct;
+      stats.numTombstones += partitionStats.numTombstones;
+      stats.numHotKeys += partitionStats.numHotKeys;
+      stats.tableBytes += partitionStats.tableBytes;
+      stats.rowBytes += partitionStats.rowBytes;
+      stats.stringBytes += partitionStats.stringBytes;
+    }
+    return stats;
+  }
+  return table_ ? table_->stats() : HashTableStats{};
+}
+
+int64_t GroupingSet::numRows() const {
+  if (isRadixPartitioned()) {
+    int64_t numRows{0};
+    for (const auto& partition : partitions_) {
+      numRows += partition->numRows();
+    }
+    return numRows;
+  }
+  return table_ ? table_->rows()->numRows() : 0;
+}
+
 void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   // Spilling is considered if this is a final or single aggregation and
   // spillPath is set.
@@ -873,9 +1213,13 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
 
   auto* rows = table_->rows();
   auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
+  const int64_t flatBytes = input->estimateFlatSize();
+  // Coalesces fragmented free space before asking for more memory.
+  if (outOfLineFreeBytes < flatBytes * 2 && compactVariableWidthData()) {
+    outOfLineFreeBytes = rows->freeSpace().second;
+  }
   const auto outOfLineBytes =
       rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
-  const int64_t flatBytes = input->estimateFlatSize();
 
   // Test-only spill path.
   if (testingTriggerSpill(pool_.name())) {
@@ -934,6 +1278,36 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
                << ", reservation: " << succinctBytes(pool_.reservedBytes());
 }
 
+bool GroupingSet::compactVariableWidthData() {
+  // Bounds the work per input batch.
+  constexpr int64_t kMaxCompactionBytes = 16 << 20;
+  constexpr int32_t kBatchSize = 1'024;
+  auto* rows = table_->rows();
+  auto& allocator = rows->stringAllocator();
+  if (allocator.freeSpace() * 4 < allocator.retainedSize()) {
+    return false;
+  }
+  const auto movedBytes = allocator.compact(
+      [&](HashStringAllocator::Relocator& relocator) {
+        RowContainerIterator iter;
+        std::vector<char*> groups(kBatchSize);
+        for (;;) {
+          const auto numGroups =
+              rows->listRows(&iter, kBatchSize, groups.data());
+          if (numGroups == 0) {
+            break;
+          }
+          const folly::Range<char**> range(groups.data(), numGroups);
+          rows->relocateVariableWidthFields(range, relocator);
+          for (auto& aggregate : aggregates_) {
+            aggregate.function->relocateAccumulators(range, relocator);
+          }
+        }
+      },
+      kMaxCompactionBytes);
+  return movedBytes > 0;
+}
+
 void GroupingSet::ensureOutputFits() {
   // If spilling has already been triggered on this operator, then we don't need
   // to reserve memory for the output as we can't reclaim much memory from this
@@ -994,6 +1368,15 @@ std::optional<common::SpillStats> GroupingSet::spilledStats() const {
   if (!hasSpilled()) {
     return std::nullopt;
   }
+  if (isRadixPartitioned()) {
+    common::SpillStats stats;
+    for (const auto& partition : partitions_) {
+      if (auto partitionStats = partition->spilledStats()) {
+        stats += partitionStats.value();
+      }
+    }
+    return stats;
+  }
   if (inputSpiller_ != nullptr) {
     VELOX_CHECK_NULL(outputSpiller_);
     return inputSpiller_->stats();
@@ -1003,6 +1386,13 @@ std::optional<common::SpillStats> GroupingSet::spilledStats() const {
 }
 
 void GroupingSet::spill() {
+  if (isRadixPartitioned()) {
+    for (auto& partition : partitions_) {
+      partition->spill();
+    }
+    return;
+  }
+
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
   // Correspondingly, 'table_' will not be initialized at that point.
@@ -1057,6 +1447,22 @@ void GroupingSet::spill() {
 }
 
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
+  if (isRadixPartitioned()) {
+    // The partitions before 'outputPartition_' have produced all their output
+    // and the partitions after it have not started yet. The partition being
+    // output can only be spilled if it has not spilled before, otherwise its
+    // remaining rows are read from the spill files.
+    for (auto i = outputPartition_; i < partitions_.size(); ++i) {
+      auto& partition = partitions_[i];
+      if (i > outputPartition_) {
+        partition->spill();
+      } else if (!partition->hasSpilled()) {
+        partition->spill(rowIterator);
+      }
+    }
+    return;
+  }
+
   VELOX_CHECK(!hasSpilled());
 
   if (table_ == nullptr) {
@@ -1078,6 +1484,31 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   table_->clear(/*freeTable=*/true);
 }
 
+void GroupingSet::spillLargestPartitions(uint64_t targetBytes) {
+  VELOX_CHECK(isRadixPartitioned());
+  VELOX_CHECK(!noMoreInput_);
+  std::vector<std::pair<uint64_t, GroupingSet*>> candidates;
+  candidates.reserve(partitions_.size());
+  for (auto& partition : partitions_) {
+    if (partition->numRows() > 0) {
+      candidates.emplace_back(partition->allocatedBytes(), partition.get());
+    }
+  }
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+  uint64_t spilledBytes{0};
+  for (auto& [bytes, partition] : candidates) {
+    if (targetBytes != 0 && spilledBytes >= targetBytes) {
+      break;
+    }
+    partition->spill();
+    spilledBytes += bytes;
+  }
+}
+
 bool GroupingSet::getOutputWithSpill(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
@@ -1131,6 +1562,8 @@ bool GroupingSet::getOutputWithSpill(
 bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_EQ(merge_ == nullptr, outputSpillPartition_ == -1);
   merge_ = nullptr;
+  // All single row groups of the previous partition have been extracted.
+  singleRowGroups_.clear();
   if (spillPartitionSet_.empty()) {
     return false;
   }
@@ -1179,13 +1612,27 @@ bool GroupingSet::mergeNextWithAggregates(
       VELOX_CHECK_NOT_NULL(merge_);
       continue;
     }
+    auto* stream = next.first;
+    ++numSpillMergeRows_;
     if (!nextKeyIsEqual) {
+      ++numSpillMergeGroups_;
       mergeState_ = mergeRows_->newRow();
-      initializeRow(*next.first, mergeState_);
+      if (!next.second && mergeSingleRowGroups()) {
+        addSingleRowGroup(*stream, mergeState_);
+      } else {
+        initializeRow(*stream, mergeState_);
+        updateRow(*stream, mergeState_);
+      }
+    } else {
+      updateRow(*stream, mergeState_);
     }
-    updateRow(*next.first, mergeState_);
     nextKeyIsEqual = next.second;
-    next.first->pop();
+    bool isLastRow;
+    stream->currentIndex(&isLastRow);
+    if (isLastRow) {
+      flushSingleRowGroups(*stream);
+    }
+    stream->pop();
 
     if (!nextKeyIsEqual &&
         ((mergeRows_->numRows() >= maxOutputRows) ||
@@ -1337,7 +1784,79 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
   }
 }
 
+uint64_t GroupingSet::numSpillMergeSingleRowGroups() const {
+  if (isRadixPartitioned()) {
+    uint64_t numGroups{0};
+    for (const auto& partition : partitions_) {
+      numGroups += partition->numSpillMergeSingleRowGroups();
+    }
+    return numGroups;
+  }
+  return numSpillMergeSingleRowGroups_;
+}
+
+bool GroupingSet::mergeSingleRowGroups() const {
+  // Merges row by row until enough rows are read to tell the ratio.
+  constexpr uint64_t kMinRows = 1'024;
+  // Min percentage of distinct keys in the merged rows.
+  constexpr uint64_t kMinGroupsPct = 50;
+  if (sortedAggregations_ != nullptr || !distinctAggregations_.empty()) {
+    return false;
+  }
+  return numSpillMergeRows_ >= kMinRows &&
+      numSpillMergeGroups_ * 100 >= numSpillMergeRows_ * kMinGroupsPct;
+}
+
+void GroupingSet::addSingleRowGroup(SpillMergeStream& stream, char* row) {
+  const auto index = stream.currentIndex();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    mergeRows_->store(stream.decoded(i), index, row, i);
+  }
+  auto& pending = singleRowGroups_[&stream];
+  if (pending.groups.size() <= index) {
+    pending.groups.resize(stream.current().size());
+  }
+  pending.groups[index] = row;
+  pending.rows.push_back(index);
+  ++numSpillMergeSingleRowGroups_;
+}
+
+void GroupingSet::flushSingleRowGroups(SpillMergeStream& stream) {
+  auto it = singleRowGroups_.find(&stream);
+  if (it == singleRowGroups_.end() || it->second.rows.empty()) {
+    return;
+  }
+  auto& pending = it->second;
+  const folly::Range<const vector_size_t*> indices(
+      pending.rows.data(), pending.rows.size());
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->initializeNewGroups(pending.groups.data(), indices);
+  }
+
+  // The rows are in increasing order.
+  mergeSelection_.resize(pending.groups.size());
+  mergeSelection_.clearAll();
+  for (auto row : pending.rows) {
+    mergeSelection_.setValid(row, true);
+  }
+  mergeSelection_.updateBounds();
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    mergeArgs_[0] = stream.current().childAt(i + keyChannels_.size());
+    aggregates_[i].function->addIntermediateResults(
+        pending.groups.data(), mergeSelection_, mergeArgs_, false);
+  }
+  mergeSelection_.clearAll();
+  pending.rows.clear();
+}
+
+void GroupingSet::flushSingleRowGroups() {
+  for (auto& [stream, pending] : singleRowGroups_) {
+    flushSingleRowGroups(*stream);
+  }
+}
+
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
+  flushSingleRowGroups();
   std::vector<char*> rows(mergeRows_->numRows());
   RowContainerIterator iter;
   if (!rows.empty()) {
@@ -1410,9 +1929,25 @@ void GroupingSet::abandonPartialAggregation() {
       false,
       &pool_);
   initializeAggregates(aggregates_, *intermediateRows_, true);
+  // Keeps hashers for the keys so that the hash table can be re-created if
+  // partial aggregation is resumed.
+  hashers_.clear();
+  for (const auto& hasher : table_->hashers()) {
+    hashers_.push_back(
+        std::make_unique<VectorHasher>(hasher->type(), hasher->channel()));
+  }
   table_.reset();
 }
 
+void GroupingSet::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(table_);
+  abandonedPartialAggregation_ = false;
+  intermediateRows_.reset();
+  intermediateGroups_.clear();
+  intermediateRowNumbers_.clear();
+}
+
 namespace {
 // Recursive resize all children.
 
@@ -1515,6 +2050,16 @@ void GroupingSet::toIntermediate(
 }
 
 std::optional<int64_t> GroupingSet::estimateOutputRowSize() const {
+  if (isRadixPartitioned()) {
+    std::optional<int64_t> rowSize;
+    for (const auto& partition : partitions_) {
+      const auto partitionRowSize = partition->estimateOutputRowSize();
+      if (partitionRowSize.has_value()) {
+        rowSize = std::max(rowSize.value_or(0), partitionRowSize.value());
+      }
+    }
+    return rowSize;
+  }
   if (table_ == nullptr) {
     return std::nullopt;
   }
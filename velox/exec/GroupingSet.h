@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
@@ -55,6 +57,50 @@ class GroupingSet {
       OperatorCtx* operatorCtx,
       tsan_atomic<bool>* nonReclaimableSection);
 
+  /// Creates a grouping set that splits its input by 'partitionBits' of the
+  /// hashes of the grouping keys and aggregates each of the
+  /// 2^partitionBits.numBits() partitions in its own grouping set created by
+  /// 'makePartition'. 'hashers' are used for partitioning only. Each partition
+  /// has a smaller hash table and row container, which improves the cache and
+  /// TLB locality with a large number of groups, and can be spilled on its
+  /// own. If 'partitionBits' are a prefix of the spill partition bits, each
+  /// partition spills into a single spill partition. Only supports final or
+  /// single aggregations with grouping keys and without pre-grouped keys or
+  /// global grouping sets.
+  static std::unique_ptr<GroupingSet> createRadixPartitioned(
+      const RowTypePtr& inputType,
+      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
+      const HashBitRange& partitionBits,
+      const std::function<std::unique_ptr<GroupingSet>()>& makePartition,
+      OperatorCtx* operatorCtx,
+      tsan_atomic<bool>* nonReclaimableSection);
+
+  /// Returns true if 'this' was created by createRadixPartitioned().
+  bool isRadixPartitioned() const {
+    return !partitions_.empty();
+  }
+
+  /// Returns the number of partitions of a radix-partitioned grouping set.
+  int32_t numPartitions() const {
+    return partitions_.size();
+  }
+
+  /// Returns true if the partitions of another radix-partitioned grouping set
+  /// with the same aggregates and partitioning can be merged into 'this' with
+  /// mergePartition(). Sorted and distinct aggregates and spilled partitions
+  /// are not supported.
+  bool canMergePartitions() const;
+
+  /// Adds the groups of 'partition' of 'other' to the same partition of
+  /// 'this'. The keys and intermediate accumulators of 'other' are read in
+  /// batches and 'other' is not modified otherwise. The caller must ensure that
+  /// no other thread uses the partition of 'other' at the same time.
+  void mergePartition(int32_t partition, GroupingSet& other);
+
+  /// Frees the groups of 'partition', e.g. after they were merged into another
+  /// grouping set.
+  void clearPartition(int32_t partition);
+
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -94,9 +140,7 @@ class GroupingSet {
   bool isPartialFull(int64_t maxBytes);
 
   /// Returns the count of the hash table, if any.
-  int64_t numDistinct() const {
-    return table_ ? table_->numDistinct() : 0;
-  }
+  int64_t numDistinct() const;
 
   /// Returns number of global grouping sets rows if there is default output.
   std::optional<vector_size_t> numDefaultGlobalGroupingSetRows() const {
@@ -116,26 +160,36 @@ class GroupingSet {
   /// when no spill has occurred previously.
   void spill(const RowContainerIterator& rowIterator);
 
+  /// Spills the partitions of a radix-partitioned grouping set in descending
+  /// order of their memory usage until at least 'targetBytes' have been
+  /// spilled. Spills all partitions if 'targetBytes' is 0. This should be only
+  /// called before no-more-input.
+  void spillLargestPartitions(uint64_t targetBytes);
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<common::SpillStats> spilledStats() const;
 
   /// Returns true if spilling has triggered on this grouping set.
   bool hasSpilled() const;
 
+  /// Returns the number of groups of the spill merge that were updated in
+  /// batches because they had a single spilled row.
+  uint64_t numSpillMergeSingleRowGroups() const;
+
   /// Returns the hashtable stats.
-  HashTableStats hashTableStats() const {
-    return table_ ? table_->stats() : HashTableStats{};
-  }
+  HashTableStats hashTableStats() const;
 
   /// Return the number of rows kept in memory.
-  int64_t numRows() const {
-    return table_ ? table_->rows()->numRows() : 0;
-  }
+  int64_t numRows() const;
 
   /// Frees hash tables and other state when giving up partial aggregation as
   /// non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
 
+  /// Goes back to aggregating the input after abandonPartialAggregation(). The
+  /// hash table is re-created on the next addInput().
+  void resumePartialAggregation();
+
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
@@ -161,6 +215,27 @@ class GroupingSet {
 
   void addInputForActiveRows(const RowVectorPtr& input, bool mayPushdown);
 
+  // Splits 'input' by 'partitionBits_' and adds the rows of each partition to
+  // the corresponding grouping set in 'partitions_'.
+  void addPartitionedInput(const RowVectorPtr& input);
+
+  // Adds the groups of 'other' to the groups of 'this'.
+  void mergeGroups(GroupingSet& other);
+
+  // Adds the groups with the keys in 'input' and the intermediate accumulators
+  // in 'accumulators'. The keys are at the input channels of the keys of
+  // 'this'.
+  void addIntermediateGroups(
+      const RowVectorPtr& input,
+      const std::vector<VectorPtr>& accumulators);
+
+  // Produces the output of 'partitions_' one partition after another.
+  bool getPartitionedOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
+      RowVectorPtr& result);
+
   void addRemainingInput();
 
   void initializeGlobalAggregation();
@@ -184,6 +259,17 @@ class GroupingSet {
 
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
+  // Returns true if the raw input of the last groupProbe() is added to dense
+  // accumulators, see addDenseInput(). The groups are indexed by their slot in
+  // the hash table in array mode.
+  bool useDenseAccumulators() const;
+
+  // Adds the raw input of 'rows' for the aggregate at 'aggregateIndex' to
+  // dense accumulators of the hash table slots and then adds these to the
+  // group rows. Replaces the scattered updates of the group rows with cached
+  // updates of a small array plus one update per group.
+  void addDenseInput(int32_t aggregateIndex, const SelectivityVector& rows);
+
   // If the given aggregation has mask, the method returns reference to the
   // selectivity vector from the maskedActiveRows_ (based on the mask channel
   // index for this aggregation), otherwise it returns reference to activeRows_.
@@ -203,6 +289,10 @@ class GroupingSet {
   // fit.
   void ensureInputFits(const RowVectorPtr& input);
 
+  // Compacts the out-of-line data of the keys and accumulators of 'table_' if
+  // enough of its allocator is free. Returns true if any data was moved.
+  bool compactVariableWidthData();
+
   // Reserves memory for output processing. If reservation cannot be increased,
   // spills enough to make output fit.
   void ensureOutputFits();
@@ -270,6 +360,25 @@ class GroupingSet {
   // 'keys'. This is called for each row received from a merge of spilled data.
   void updateRow(SpillMergeStream& keys, char* row);
 
+  // Returns true if the groups of the spill merge that have a single spilled
+  // row are stored with addSingleRowGroup(). This is the case when most keys
+  // are distinct, so that the merge does about one update per output row.
+  bool mergeSingleRowGroups() const;
+
+  // Stores the keys of the current row of 'stream' in 'row' of 'mergeRows_'.
+  // The accumulators of 'row' are initialized and updated from the row with the
+  // other single row groups of the same batch of 'stream' by
+  // flushSingleRowGroups().
+  void addSingleRowGroup(SpillMergeStream& stream, char* row);
+
+  // Initializes and updates the accumulators of the single row groups of
+  // 'stream' with one call per aggregate. Must be called before 'stream' moves
+  // to its next batch.
+  void flushSingleRowGroups(SpillMergeStream& stream);
+
+  // Calls flushSingleRowGroups() for all streams.
+  void flushSingleRowGroups();
+
   // Returns a RowType of the spilled data.
   RowTypePtr makeSpillType() const;
 
@@ -332,6 +441,17 @@ class GroupingSet {
 
   // Place for the arguments of the aggregate being updated.
   std::vector<VectorPtr> tempVectors_;
+
+  // Max number of hash table slots for dense accumulators. 0 if dense
+  // accumulators are disabled.
+  const uint32_t denseAggregationMaxGroups_;
+  // The group row of each hash table slot that has input in the current batch
+  // when using dense accumulators.
+  std::vector<char*> denseGroups_;
+  // Dense accumulators of the aggregate being updated and the bits of their
+  // groups with a non-null value.
+  std::vector<char> denseAccumulators_;
+  std::vector<uint64_t> denseNonNullGroups_;
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
@@ -391,6 +511,21 @@ class GroupingSet {
   // to merge.
   SelectivityVector mergeSelection_;
 
+  // Groups of the spill merge that have a single spilled row and are not
+  // initialized yet. 'groups' is indexed by the row number in the current
+  // batch of the stream and 'rows' lists the rows.
+  struct SingleRowGroups {
+    std::vector<char*> groups;
+    std::vector<vector_size_t> rows;
+  };
+  folly::F14FastMap<SpillMergeStream*, SingleRowGroups> singleRowGroups_;
+
+  // Number of rows and groups read from the spill merge. Their ratio decides
+  // mergeSingleRowGroups().
+  uint64_t numSpillMergeRows_{0};
+  uint64_t numSpillMergeGroups_{0};
+  uint64_t numSpillMergeSingleRowGroups_{0};
+
   // Pool of the OperatorCtx. Used for spilling.
   memory::MemoryPool& pool_;
 
@@ -411,6 +546,20 @@ class GroupingSet {
   std::vector<char*> firstGroup_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // The hash bits selecting the partition of an input row if 'this' is radix
+  // partitioned.
+  HashBitRange partitionBits_;
+
+  // The grouping sets of the partitions if 'this' is radix partitioned. The
+  // partitioning 'hashers_' are then not used for a hash table of 'this'.
+  std::vector<std::unique_ptr<GroupingSet>> partitions_;
+
+  // The partition producing output in getPartitionedOutput().
+  size_t outputPartition_{0};
+
+  // Hashes of the grouping keys of the input rows for partitioning.
+  raw_vector<uint64_t> partitionHashes_;
 };
 
 class AggregationInputSpiller : public SpillerBase {
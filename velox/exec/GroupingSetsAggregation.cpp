@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/GroupingSetsAggregation.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Returns the output channel in 'groupIdNode' of each grouping key.
+std::unordered_map<std::string, column_index_t> groupingKeyOutputs(
+    const core::GroupIdNode& groupIdNode) {
+  std::unordered_map<std::string, column_index_t> outputs;
+  const auto& outputType = groupIdNode.outputType();
+  for (const auto& info : groupIdNode.groupingKeyInfos()) {
+    outputs[info.output] = outputType->getChildIdx(info.output);
+  }
+  return outputs;
+}
+
+} // namespace
+
+// static
+bool GroupingSetsAggregation::canFuse(
+    const core::GroupIdNode& groupIdNode,
+    const core::AggregationNode& aggregationNode,
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.groupingSetsRollupEnabled()) {
+    return false;
+  }
+  const auto step = aggregationNode.step();
+  if (step != core::AggregationNode::Step::kPartial &&
+      step != core::AggregationNode::Step::kSingle) {
+    return false;
+  }
+  if (aggregationNode.canSpill(queryConfig) ||
+      aggregationNode.ignoreNullKeys() ||
+      !aggregationNode.preGroupedKeys().empty() ||
+      aggregationNode.aggregates().empty()) {
+    return false;
+  }
+
+  // The aggregation must group by each grouping key and the group id once.
+  const column_index_t numGroupingKeys = groupIdNode.numGroupingKeys();
+  const auto& groupingKeys = aggregationNode.groupingKeys();
+  if (groupingKeys.size() != numGroupingKeys + 1) {
+    return false;
+  }
+  const auto keyOutputs = groupingKeyOutputs(groupIdNode);
+  std::vector<bool> seen(numGroupingKeys + 1, false);
+  for (const auto& key : groupingKeys) {
+    column_index_t index;
+    if (key->name() == groupIdNode.groupIdName()) {
+      index = numGroupingKeys;
+    } else if (auto it = keyOutputs.find(key->name()); it != keyOutputs.end()) {
+      index = it->second;
+    } else {
+      return false;
+    }
+    if (index > numGroupingKeys || seen[index]) {
+      return false;
+    }
+    seen[index] = true;
+  }
+
+  // The aggregates must only use the aggregation inputs, which are not
+  // nulled out per grouping set.
+  const auto& inputType = groupIdNode.outputType();
+  const auto isAggregationInput = [&](const std::string& name) {
+    const auto channel = inputType->getChildIdxIfExists(name);
+    return channel.has_value() && channel.value() >= numGroupingKeys &&
+        channel.value() < inputType->size() - 1;
+  };
+  for (const auto& aggregate : aggregationNode.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    if (aggregate.mask != nullptr &&
+        !isAggregationInput(aggregate.mask->name())) {
+      return false;
+    }
+    for (const auto& arg : aggregate.call->inputs()) {
+      if (auto field =
+              dynamic_cast<const core::FieldAccessTypedExpr*>(arg.get())) {
+        if (!isAggregationInput(field->name())) {
+          return false;
+        }
+      } else if (!dynamic_cast<const core::ConstantTypedExpr*>(arg.get())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+GroupingSetsAggregation::GroupingSetsAggregation(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::GroupIdNode>& groupIdNode,
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode)
+    : Operator(
+          driverCtx,
+          aggregationNode->outputType(),
+          operatorId,
+          aggregationNode->id(),
+          "GroupingSetsAggregation"),
+      groupIdNode_(groupIdNode),
+      aggregationNode_(aggregationNode),
+      isPartialOutput_(isPartialOutput(aggregationNode->step())),
+      maxPartialAggregationMemoryUsage_(
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {
+  VELOX_CHECK(
+      canFuse(*groupIdNode, *aggregationNode, driverCtx->queryConfig()));
+}
+
+void GroupingSetsAggregation::initialize() {
+  Operator::initialize();
+
+  VELOX_CHECK(pool()->trackUsage());
+
+  const auto& inputType = groupIdNode_->sources()[0]->outputType();
+  const auto& groupIdType = groupIdNode_->outputType();
+  const auto numGroupingKeys = groupIdNode_->numGroupingKeys();
+
+  groupingKeyChannels_.resize(numGroupingKeys);
+  for (const auto& info : groupIdNode_->groupingKeyInfos()) {
+    groupingKeyChannels_[groupIdType->getChildIdx(info.output)] =
+        inputType->getChildIdx(info.input->name());
+  }
+  for (const auto& input : groupIdNode_->aggregationInputs()) {
+    aggregationInputChannels_.push_back(inputType->getChildIdx(input->name()));
+  }
+
+  for (const auto& groupingSet : groupIdNode_->groupingSets()) {
+    std::vector<column_index_t> keys;
+    keys.reserve(groupingSet.size());
+    for (const auto& key : groupingSet) {
+      keys.push_back(groupIdType->getChildIdx(key));
+    }
+    groupingSetKeys_.push_back(std::move(keys));
+  }
+
+  for (const auto& key : aggregationNode_->groupingKeys()) {
+    outputKeys_.push_back(
+        key->name() == groupIdNode_->groupIdName()
+            ? kGroupIdChannel
+            : groupIdType->getChildIdx(key->name()));
+  }
+
+  auto aggregates = makeAggregates(true, numGroupingKeys);
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < numGroupingKeys; ++i) {
+    names.push_back(fmt::format("k{}", i));
+    types.push_back(groupIdType->childAt(i));
+  }
+  for (const auto& aggregate : aggregates) {
+    names.push_back(fmt::format("a{}", names.size()));
+    types.push_back(aggregate.intermediateType);
+  }
+  groupsType_ = ROW(std::move(names), std::move(types));
+
+  for (const auto& keys : groupingSetKeys_) {
+    std::vector<std::string> setNames;
+    std::vector<TypePtr> setTypes;
+    for (auto key : keys) {
+      setNames.push_back(groupsType_->nameOf(key));
+      setTypes.push_back(groupsType_->childAt(key));
+    }
+    const auto numKeys = aggregationNode_->groupingKeys().size();
+    for (auto i = 0; i < aggregates.size(); ++i) {
+      setNames.push_back(fmt::format("a{}", setNames.size()));
+      setTypes.push_back(outputType_->childAt(numKeys + i));
+    }
+    groupingSetTypes_.push_back(ROW(std::move(setNames), std::move(setTypes)));
+  }
+
+  groups_ = std::make_unique<GroupingSet>(
+      inputType,
+      createVectorHashers(inputType, groupingKeyChannels_),
+      std::vector<column_index_t>{},
+      std::vector<column_index_t>{},
+      std::move(aggregates),
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/true,
+      /*isRawInput=*/true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+}
+
+std::vector<AggregateInfo> GroupingSetsAggregation::makeAggregates(
+    bool inputs,
+    size_t numKeys) {
+  const auto numGroupingKeys = groupingKeyChannels_.size();
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  auto aggregates = toAggregateInfo(
+      *aggregationNode_,
+      *operatorCtx_,
+      aggregationNode_->groupingKeys().size(),
+      expressionEvaluator);
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    auto& aggregate = aggregates[i];
+    if (inputs) {
+      // The channels are in the output of GroupId, where the aggregation
+      // inputs follow the grouping keys.
+      for (auto& channel : aggregate.inputs) {
+        if (channel != kConstantChannel) {
+          channel = aggregationInputChannels_[channel - numGroupingKeys];
+        }
+      }
+      if (aggregate.mask.has_value()) {
+        aggregate.mask =
+            aggregationInputChannels_[aggregate.mask.value() - numGroupingKeys];
+      }
+    } else {
+      aggregate.inputs = {static_cast<column_index_t>(numGroupingKeys + i)};
+      aggregate.constantInputs = {nullptr};
+      aggregate.mask = std::nullopt;
+    }
+    aggregate.output = numKeys + i;
+  }
+  return aggregates;
+}
+
+void GroupingSetsAggregation::addInput(RowVectorPtr input) {
+  groups_->addInput(input, /*mayPushdown=*/false);
+  if (isPartialOutput_ &&
+      groups_->isPartialFull(maxPartialAggregationMemoryUsage_)) {
+    flushing_ = true;
+  }
+}
+
+void GroupingSetsAggregation::noMoreInput() {
+  groups_->noMoreInput();
+  Operator::noMoreInput();
+  flushing_ = true;
+}
+
+void GroupingSetsAggregation::rollUp() {
+  VELOX_CHECK(groupingSets_.empty());
+  for (const auto& keys : groupingSetKeys_) {
+    groupingSets_.push_back(std::make_unique<GroupingSet>(
+        groupsType_,
+        createVectorHashers(groupsType_, keys),
+        std::vector<column_index_t>{},
+        std::vector<column_index_t>{},
+        makeAggregates(false, keys.size()),
+        /*ignoreNullKeys=*/false,
+        isPartialOutput_,
+        /*isRawInput=*/false,
+        std::vector<vector_size_t>{},
+        std::nullopt,
+        nullptr,
+        &nonReclaimableSection_,
+        operatorCtx_.get(),
+        &spillStats_));
+  }
+
+  const auto maxOutputRows = outputBatchRows(groups_->estimateOutputRowSize());
+  const auto maxOutputBytes =
+      operatorCtx_->driverCtx()->queryConfig().preferredOutputBatchBytes();
+  RowContainerIterator iterator;
+  for (;;) {
+    auto groups = BaseVector::create<RowVector>(groupsType_, 0, pool());
+    if (!groups_->getOutput(maxOutputRows, maxOutputBytes, iterator, groups)) {
+      break;
+    }
+    for (auto& groupingSet : groupingSets_) {
+      groupingSet->addInput(groups, /*mayPushdown=*/false);
+    }
+  }
+  groups_->resetTable(/*freeTable=*/false);
+}
+
+RowVectorPtr GroupingSetsAggregation::getOutput() {
+  if (!flushing_ || finished_) {
+    return nullptr;
+  }
+  if (groupingSets_.empty()) {
+    rollUp();
+  }
+
+  const auto maxOutputBytes =
+      operatorCtx_->driverCtx()->queryConfig().preferredOutputBatchBytes();
+  for (; outputGroupingSet_ < groupingSets_.size(); ++outputGroupingSet_) {
+    auto& groupingSet = groupingSets_[outputGroupingSet_];
+    const auto maxOutputRows =
+        outputBatchRows(groupingSet->estimateOutputRowSize());
+    auto result = BaseVector::create<RowVector>(
+        groupingSetTypes_[outputGroupingSet_], maxOutputRows, pool());
+    if (groupingSet->getOutput(
+            maxOutputRows, maxOutputBytes, outputIterator_, result)) {
+      return makeOutput(outputGroupingSet_, result);
+    }
+    // Frees the grouping set once it is produced.
+    groupingSet.reset();
+    outputIterator_.reset();
+  }
+
+  groupingSets_.clear();
+  outputGroupingSet_ = 0;
+  flushing_ = false;
+  if (noMoreInput_) {
+    finished_ = true;
+  }
+  return nullptr;
+}
+
+RowVectorPtr GroupingSetsAggregation::makeOutput(
+    int32_t groupingSet,
+    const RowVectorPtr& result) {
+  const auto numRows = result->size();
+  const auto& keys = groupingSetKeys_[groupingSet];
+  std::vector<VectorPtr> children(outputType_->size());
+  for (auto i = 0; i < outputKeys_.size(); ++i) {
+    if (outputKeys_[i] == kGroupIdChannel) {
+      children[i] = std::make_shared<ConstantVector<int64_t>>(
+          pool(), numRows, false, BIGINT(), groupingSet);
+      continue;
+    }
+    auto it = std::find(keys.begin(), keys.end(), outputKeys_[i]);
+    if (it == keys.end()) {
+      children[i] = BaseVector::createNullConstant(
+          outputType_->childAt(i), numRows, pool());
+    } else {
+      children[i] = result->childAt(it - keys.begin());
+    }
+  }
+  for (auto i = outputKeys_.size(); i < children.size(); ++i) {
+    children[i] = result->childAt(keys.size() + i - outputKeys_.size());
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numRows, std::move(children));
+}
+
+void GroupingSetsAggregation::close() {
+  Operator::close();
+  groupingSets_.clear();
+  groups_.reset();
+}
+
+} // namespace facebook::velox::exec
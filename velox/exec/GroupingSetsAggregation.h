@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/GroupingSet.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Computes a partial or single aggregation over a GroupIdNode without
+/// replicating the input per grouping set. The input is aggregated once by
+/// all the grouping keys. Each grouping set is then computed by adding the
+/// intermediate results of these groups to a grouping set with only its keys.
+/// The output is the same as the one of the aggregation over GroupId: the
+/// grouping keys not in a grouping set are null and the group id column has
+/// the index of the grouping set.
+///
+/// A partial aggregation produces the grouping sets whenever the groups by
+/// all the keys exceed the partial aggregation memory limit and then starts
+/// over.
+class GroupingSetsAggregation : public Operator {
+ public:
+  GroupingSetsAggregation(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::GroupIdNode>& groupIdNode,
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode);
+
+  /// Returns true if 'aggregationNode' with 'groupIdNode' as its source can be
+  /// computed by this operator. Requires a partial or single aggregation that
+  /// cannot spill, groups by all the grouping keys and the group id and has
+  /// aggregates that are neither distinct nor sorted and only take the
+  /// aggregation inputs of 'groupIdNode' and constants as arguments.
+  static bool canFuse(
+      const core::GroupIdNode& groupIdNode,
+      const core::AggregationNode& aggregationNode,
+      const core::QueryConfig& queryConfig);
+
+  void initialize() override;
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !flushing_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  void noMoreInput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return finished_;
+  }
+
+  void close() override;
+
+ private:
+  // Marks the output channel of the group id.
+  static constexpr column_index_t kGroupIdChannel =
+      std::numeric_limits<column_index_t>::max();
+
+  // Returns the aggregates of 'aggregationNode_' with new functions. The
+  // arguments are replaced with the input channels of the aggregation inputs
+  // if 'inputs' is true, otherwise with the intermediate results in
+  // 'groupsType_'. The outputs follow 'numKeys' keys.
+  std::vector<AggregateInfo> makeAggregates(bool inputs, size_t numKeys);
+
+  // Creates the grouping sets and adds the groups of 'groups_' to them.
+  void rollUp();
+
+  // Returns the output for grouping set 'groupingSet' from 'result' with its
+  // keys and aggregates.
+  RowVectorPtr makeOutput(int32_t groupingSet, const RowVectorPtr& result);
+
+  std::shared_ptr<const core::GroupIdNode> groupIdNode_;
+  std::shared_ptr<const core::AggregationNode> aggregationNode_;
+
+  const bool isPartialOutput_;
+  const int64_t maxPartialAggregationMemoryUsage_;
+
+  // The input channel of each grouping key in the order of the grouping keys
+  // of 'groupIdNode_'.
+  std::vector<column_index_t> groupingKeyChannels_;
+
+  // The input channel of each aggregation input of 'groupIdNode_'.
+  std::vector<column_index_t> aggregationInputChannels_;
+
+  // The keys of each grouping set as indices into 'groupingKeyChannels_'.
+  std::vector<std::vector<column_index_t>> groupingSetKeys_;
+
+  // The grouping key index or kGroupIdChannel of each grouping key of the
+  // output.
+  std::vector<column_index_t> outputKeys_;
+
+  // The type of the output of 'groups_': the grouping keys followed by the
+  // intermediate results.
+  RowTypePtr groupsType_;
+
+  // The groups by all the grouping keys.
+  std::unique_ptr<GroupingSet> groups_;
+
+  // The grouping sets computed from 'groups_'. Set while 'flushing_'.
+  std::vector<std::unique_ptr<GroupingSet>> groupingSets_;
+
+  // The type of the output of each of 'groupingSets_'.
+  std::vector<RowTypePtr> groupingSetTypes_;
+
+  // The grouping set to produce output from next.
+  int32_t outputGroupingSet_{0};
+
+  RowContainerIterator outputIterator_;
+
+  // True while the grouping sets are produced, after no more input or if the
+  // partial aggregation is full.
+  bool flushing_{false};
+
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::exec
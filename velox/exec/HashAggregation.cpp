@@ -16,12 +16,40 @@
 #include "velox/exec/HashAggregation.h"
 
 #include <optional>
+#include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
+#include "velox/common/time/Timer.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns true if all 'aggregates' are distinct over the same input columns
+// without masks, sorting keys or constant inputs, so that they can aggregate
+// the rows left after removing duplicate grouping keys and inputs.
+bool canAggregateDistinctInTwoPhases(
+    const std::vector<AggregateInfo>& aggregates) {
+  if (aggregates.empty()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregates) {
+    if (!aggregate.distinct || aggregate.mask.has_value() ||
+        !aggregate.sortingKeys.empty() ||
+        aggregate.inputs != aggregates[0].inputs) {
+      return false;
+    }
+    for (const auto& constant : aggregate.constantInputs) {
+      if (constant != nullptr) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -47,6 +75,9 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      cardinalityEstimation_(
+          isPartialOutput_ && !isGlobal_ &&
+          driverCtx->queryConfig().partialAggregationCardinalityEstimation()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -64,6 +95,14 @@ void HashAggregation::initialize() {
   auto hashers = createVectorHashers(inputType, groupingKeyInputChannels);
   const auto numHashers = hashers.size();
 
+  if (cardinalityEstimation_) {
+    estimationHashers_ =
+        createVectorHashers(inputType, groupingKeyInputChannels);
+    estimationAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    estimationHll_.emplace(
+        kEstimationIndexBitLength, estimationAllocator_.get());
+  }
+
   std::vector<column_index_t> preGroupedChannels;
   preGroupedChannels.reserve(aggregationNode_->preGroupedKeys().size());
   for (const auto& key : aggregationNode_->preGroupedKeys()) {
@@ -99,6 +138,71 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
+  const auto radixPartitionBits =
+      operatorCtx_->driverCtx()->queryConfig().aggregationRadixPartitionBits();
+  if (radixPartitionBits > 0 && !isPartialOutput_ && !isGlobal_ &&
+      !isDistinct_ && preGroupedChannels.empty() &&
+      aggregationNode_->globalGroupingSets().empty()) {
+    // Starts the partition bits at the spill partition bits so that each
+    // partition spills into a single spill partition.
+    const auto startBit = spillConfig_.has_value()
+        ? spillConfig_->startPartitionBit
+        : operatorCtx_->driverCtx()->queryConfig().spillStartPartitionBit();
+    // Each partition has its own aggregate functions since the accumulator
+    // offsets are bound to the row container of the partition.
+    groupingSet_ = GroupingSet::createRadixPartitioned(
+        inputType,
+        std::move(hashers),
+        HashBitRange(startBit, startBit + radixPartitionBits),
+        [&]() {
+          return std::make_unique<GroupingSet>(
+              inputType,
+              createVectorHashers(inputType, groupingKeyInputChannels),
+              std::vector<column_index_t>{},
+              std::vector<column_index_t>(groupingKeyOutputChannels),
+              toAggregateInfo(
+                  *aggregationNode_,
+                  *operatorCtx_,
+                  numHashers,
+                  expressionEvaluator),
+              aggregationNode_->ignoreNullKeys(),
+              isPartialOutput_,
+              isRawInput(aggregationNode_->step()),
+              aggregationNode_->globalGroupingSets(),
+              groupIdChannel,
+              spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
+              &nonReclaimableSection_,
+              operatorCtx_.get(),
+              &spillStats_);
+        },
+        operatorCtx_.get(),
+        &nonReclaimableSection_);
+    partitionMerge_ = operatorCtx_->driverCtx()
+                          ->queryConfig()
+                          .aggregationPartitionMergeEnabled() &&
+        !spillConfig_.has_value() && groupingSet_->canMergePartitions() &&
+        operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1;
+    aggregationNode_.reset();
+    return;
+  }
+
+  const auto twoPhaseDistinctMinGroups =
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .twoPhaseDistinctAggregationMinGroups();
+  if (twoPhaseDistinctMinGroups > 0 &&
+      aggregationNode_->step() == core::AggregationNode::Step::kSingle &&
+      !isGlobal_ && preGroupedChannels.empty() && !groupIdChannel.has_value() &&
+      aggregationNode_->globalGroupingSets().empty() &&
+      canAggregateDistinctInTwoPhases(aggregateInfos)) {
+    twoPhaseDistinctMinGroups_ = twoPhaseDistinctMinGroups;
+    initializeTwoPhaseDistinct(
+        inputType,
+        groupingKeyInputChannels,
+        groupingKeyOutputChannels,
+        expressionEvaluator);
+  }
+
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
@@ -118,6 +222,150 @@ void HashAggregation::initialize() {
   aggregationNode_.reset();
 }
 
+void HashAggregation::initializeTwoPhaseDistinct(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& groupingKeyInputChannels,
+    const std::vector<column_index_t>& groupingKeyOutputChannels,
+    std::shared_ptr<core::ExpressionEvaluator>& expressionEvaluator) {
+  const auto numKeys = groupingKeyInputChannels.size();
+  auto aggregateInfos = toAggregateInfo(
+      *aggregationNode_, *operatorCtx_, numKeys, expressionEvaluator);
+
+  distinctChannels_ = groupingKeyInputChannels;
+  for (auto channel : aggregateInfos[0].inputs) {
+    if (std::find(
+            distinctChannels_.begin(), distinctChannels_.end(), channel) ==
+        distinctChannels_.end()) {
+      distinctChannels_.push_back(channel);
+    }
+  }
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto channel : distinctChannels_) {
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  }
+  distinctInputType_ = ROW(std::move(names), std::move(types));
+
+  // The aggregates read their inputs from the deduplicated rows.
+  for (auto& aggregate : aggregateInfos) {
+    for (auto& input : aggregate.inputs) {
+      input = std::find(
+                  distinctChannels_.begin(), distinctChannels_.end(), input) -
+          distinctChannels_.begin();
+    }
+    aggregate.distinct = false;
+  }
+
+  auto* spillConfig =
+      spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
+  std::vector<column_index_t> keyChannels(numKeys);
+  std::iota(keyChannels.begin(), keyChannels.end(), 0);
+  twoPhaseGroupingSet_ = std::make_unique<GroupingSet>(
+      distinctInputType_,
+      createVectorHashers(distinctInputType_, keyChannels),
+      std::vector<column_index_t>{},
+      std::vector<column_index_t>(groupingKeyOutputChannels),
+      std::move(aggregateInfos),
+      aggregationNode_->ignoreNullKeys(),
+      /*isPartial=*/false,
+      /*isRawInput=*/true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      spillConfig,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+
+  // Keeps the rows with null keys, which may have non-null distinct inputs.
+  std::vector<column_index_t> distinctOutputChannels(distinctChannels_.size());
+  std::iota(distinctOutputChannels.begin(), distinctOutputChannels.end(), 0);
+  distinctGroupingSet_ = std::make_unique<GroupingSet>(
+      inputType,
+      createVectorHashers(inputType, distinctChannels_),
+      std::vector<column_index_t>{},
+      std::move(distinctOutputChannels),
+      std::vector<AggregateInfo>{},
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/false,
+      /*isRawInput=*/true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      spillConfig,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+}
+
+void HashAggregation::chooseDistinctAggregation(const RowVectorPtr& input) {
+  VELOX_CHECK_NOT_NULL(distinctGroupingSet_);
+  // The grouping keys are the first of 'distinctChannels_'.
+  const auto numKeys = identityProjections_.size();
+  auto hashers = createVectorHashers(
+      asRowType(input->type()),
+      std::vector<column_index_t>(
+          distinctChannels_.begin(), distinctChannels_.begin() + numKeys));
+  SelectivityVector rows(input->size());
+  raw_vector<uint64_t> hashes(input->size());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    auto& hasher = hashers[i];
+    hasher->decode(*input->childAt(hasher->channel()), rows);
+    hasher->hash(rows, i > 0, hashes);
+  }
+  const folly::F14FastSet<uint64_t> distinctHashes(
+      hashes.begin(), hashes.end());
+  if (distinctHashes.size() >= twoPhaseDistinctMinGroups_) {
+    groupingSet_ = std::move(twoPhaseGroupingSet_);
+    addRuntimeStat("twoPhaseDistinctAggregation", RuntimeCounter(1));
+  } else {
+    twoPhaseGroupingSet_.reset();
+    distinctGroupingSet_.reset();
+  }
+}
+
+void HashAggregation::addDistinctInput(const RowVectorPtr& input) {
+  distinctGroupingSet_->addInput(input, /*mayPushdown=*/false);
+  if (distinctGroupingSet_->hasSpilled()) {
+    // The new rows can only be known after merging with the spilled rows.
+    return;
+  }
+  const auto& newGroups = distinctGroupingSet_->hashLookup().newGroups;
+  if (newGroups.empty()) {
+    return;
+  }
+  const auto size = newGroups.size();
+  BufferPtr indices = allocateIndices(size, pool());
+  std::copy(
+      newGroups.begin(), newGroups.end(), indices->asMutable<vector_size_t>());
+  std::vector<VectorPtr> children;
+  children.reserve(distinctChannels_.size());
+  for (auto channel : distinctChannels_) {
+    children.push_back(input->childAt(channel));
+  }
+  groupingSet_->addInput(
+      wrap(size, std::move(indices), distinctInputType_, children, pool()),
+      /*mayPushdown=*/false);
+}
+
+void HashAggregation::finishDistinctInput() {
+  distinctGroupingSet_->noMoreInput();
+  if (distinctGroupingSet_->hasSpilled()) {
+    const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+    const auto maxOutputRows = outputBatchRows();
+    RowContainerIterator iterator;
+    auto distinctRows = BaseVector::create<RowVector>(
+        distinctInputType_, maxOutputRows, pool());
+    while (distinctGroupingSet_->getOutput(
+        maxOutputRows,
+        queryConfig.preferredOutputBatchBytes(),
+        iterator,
+        distinctRows)) {
+      groupingSet_->addInput(distinctRows, /*mayPushdown=*/false);
+    }
+  }
+  distinctGroupingSet_.reset();
+}
+
 void HashAggregation::setupGroupingKeyChannelProjections(
     std::vector<column_index_t>& groupingKeyInputChannels,
     std::vector<column_index_t>& groupingKeyOutputChannels) const {
@@ -177,12 +425,22 @@ void HashAggregation::addInput(RowVectorPtr input) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
+  if (cardinalityEstimation_) {
+    updateCardinalityEstimate(input);
+  }
   if (abandonedPartialAggregation_) {
     input_ = input;
     numInputRows_ += input->size();
     return;
   }
-  groupingSet_->addInput(input, mayPushdown_);
+  if (twoPhaseGroupingSet_ != nullptr) {
+    chooseDistinctAggregation(input);
+  }
+  if (distinctGroupingSet_ != nullptr) {
+    addDistinctInput(input);
+  } else {
+    groupingSet_->addInput(input, mayPushdown_);
+  }
   numInputRows_ += input->size();
 
   updateRuntimeStats();
@@ -191,7 +449,9 @@ void HashAggregation::addInput(RowVectorPtr input) {
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      (cardinalityEstimation_
+           ? highCardinality_
+           : abandonPartialAggregationEarly(groupingSet_->numDistinct()));
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
@@ -214,12 +474,58 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::updateCardinalityEstimate(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  estimationRows_.resize(numRows);
+  estimationRows_.setAll();
+  estimationHashes_.resize(numRows);
+  for (auto i = 0; i < estimationHashers_.size(); ++i) {
+    auto& hasher = estimationHashers_[i];
+    hasher->decode(*input->childAt(hasher->channel()), estimationRows_);
+    hasher->hash(estimationRows_, i > 0, estimationHashes_);
+  }
+  // The HLL takes the bucket index from the high bits of the hash, which are
+  // not well distributed for the hashes of small integers.
+  for (auto row = 0; row < numRows; ++row) {
+    estimationHll_->insertHash(
+        folly::hash::twang_mix64(estimationHashes_[row]));
+  }
+  numEstimationRows_ += numRows;
+  if (numEstimationRows_ < abandonPartialAggregationMinRows_) {
+    return;
+  }
+
+  const auto distinctPct =
+      100 * estimationHll_->cardinality() / numEstimationRows_;
+  addRuntimeStat("estimatedDistinctKeysPct", RuntimeCounter(distinctPct));
+  highCardinality_ = distinctPct >= abandonPartialAggregationMinPct_;
+  estimationHll_.emplace(
+      kEstimationIndexBitLength, estimationAllocator_.get());
+  numEstimationRows_ = 0;
+  if (abandonedPartialAggregation_ && !highCardinality_) {
+    resumePartialAggregation();
+  }
+}
+
+void HashAggregation::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  groupingSet_->resumePartialAggregation();
+  abandonedPartialAggregation_ = false;
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  addRuntimeStat("resumedPartialAggregation", RuntimeCounter(1));
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
-  const auto& hashers = groupingSet_->hashLookup().hashers;
+  // A two-phase distinct aggregation reports the keys and the hash table of
+  // the first phase, which holds the most rows.
+  const auto& statsGroupingSet =
+      distinctGroupingSet_ != nullptr ? distinctGroupingSet_ : groupingSet_;
+  const auto& hashers = statsGroupingSet->hashLookup().hashers;
   uint64_t asRange{0};
   uint64_t asDistinct{0};
-  const auto hashTableStats = groupingSet_->hashTableStats();
+  const auto hashTableStats = statsGroupingSet->hashTableStats();
 
   auto lockedStats = stats_.wlock();
   auto& runtimeStats = lockedStats->runtimeStats;
@@ -242,6 +548,18 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+
+  // Keeps the peaks since partial aggregation flushes and spilling clear the
+  // table.
+  const auto setPeakBytes = [&](const std::string& name, int64_t bytes) {
+    auto it = runtimeStats.find(name);
+    if (it == runtimeStats.end() || it->second.sum < bytes) {
+      runtimeStats[name] = RuntimeMetric(bytes, RuntimeCounter::Unit::kBytes);
+    }
+  };
+  setPeakBytes(BaseHashTable::kTableBytes, hashTableStats.tableBytes);
+  setPeakBytes(BaseHashTable::kRowBytes, hashTableStats.rowBytes);
+  setPeakBytes(BaseHashTable::kStringBytes, hashTableStats.stringBytes);
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -285,11 +603,16 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   constexpr int32_t kPartialMinFinalPct = 40;
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
-  // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
-      (aggregationPct > kPartialMinFinalPct &&
-       maxPartialAggregationMemoryUsage_ >=
-           maxExtendedPartialAggregationMemoryUsage_)) {
+  // aggregation. With the cardinality estimate, abandons only if the input is
+  // estimated to have no reduction. Otherwise, a table at max size keeps being
+  // flushed whenever it is full.
+  const bool abandon = cardinalityEstimation_
+      ? highCardinality_
+      : abandonPartialAggregationEarly(numOutputRows_) ||
+          (aggregationPct > kPartialMinFinalPct &&
+           maxPartialAggregationMemoryUsage_ >=
+               maxExtendedPartialAggregationMemoryUsage_);
+  if (abandon) {
     groupingSet_->abandonPartialAggregation();
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
@@ -322,6 +645,9 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (partitionMerge_ && noMoreInput_ && !mergePartitions()) {
+    return nullptr;
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
@@ -374,6 +700,73 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+bool HashAggregation::waitForPeerMerge() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return false;
+  }
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return true;
+}
+
+bool HashAggregation::ownsPartition(int32_t partition) const {
+  const auto* driverCtx = operatorCtx_->driverCtx();
+  return partition % driverCtx->task->numDrivers(driverCtx->driver) ==
+      driverCtx->driverId;
+}
+
+bool HashAggregation::mergePartitions() {
+  if (mergeState_ == MergeState::kMerge) {
+    // All peers have received all input and wait for each other at the next
+    // step, so each partition of a peer is read by its owner only.
+    uint64_t mergeTimeNs{0};
+    {
+      NanosecondTimer timer(&mergeTimeNs);
+      const auto peers = operatorCtx_->task()->findPeerOperators(
+          operatorCtx_->driverCtx()->pipelineId, this);
+      for (auto partition = 0; partition < groupingSet_->numPartitions();
+           ++partition) {
+        if (!ownsPartition(partition)) {
+          continue;
+        }
+        for (auto* peer : peers) {
+          if (peer == this) {
+            continue;
+          }
+          auto* peerAggregation = dynamic_cast<HashAggregation*>(peer);
+          VELOX_CHECK_NOT_NULL(peerAggregation);
+          groupingSet_->mergePartition(
+              partition, *peerAggregation->groupingSet_);
+        }
+      }
+    }
+    addRuntimeStat(
+        "partitionMergeWallNanos",
+        RuntimeCounter(mergeTimeNs, RuntimeCounter::Unit::kNanos));
+    mergeState_ = MergeState::kClear;
+    if (!waitForPeerMerge()) {
+      return false;
+    }
+  }
+  if (mergeState_ == MergeState::kClear) {
+    // The owners have merged the other partitions.
+    for (auto partition = 0; partition < groupingSet_->numPartitions();
+         ++partition) {
+      if (!ownsPartition(partition)) {
+        groupingSet_->clearPartition(partition);
+      }
+    }
+    mergeState_ = MergeState::kOutput;
+  }
+  VELOX_CHECK(mergeState_ == MergeState::kOutput);
+  return true;
+}
+
 RowVectorPtr HashAggregation::getDistinctOutput() {
   VELOX_CHECK(isDistinct_);
   VELOX_CHECK(!finished_);
@@ -427,6 +820,9 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
           resultIterator_,
           output_)) {
     finished_ = true;
+    if (const auto numGroups = groupingSet_->numSpillMergeSingleRowGroups()) {
+      addRuntimeStat("spillMergeSingleRowGroups", RuntimeCounter(numGroups));
+    }
     return nullptr;
   }
   numOutputRows_ += output_->size();
@@ -434,11 +830,18 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (distinctGroupingSet_ != nullptr) {
+    finishDistinctInput();
+  }
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
+  if (partitionMerge_) {
+    mergeState_ = MergeState::kMerge;
+    waitForPeerMerge();
+  }
 }
 
 bool HashAggregation::isFinished() {
@@ -458,7 +861,7 @@ void HashAggregation::reclaim(
   updateEstimatedOutputRowSize();
 
   if (noMoreInput_) {
-    if (groupingSet_->hasSpilled()) {
+    if (groupingSet_->hasSpilled() && !groupingSet_->isRadixPartitioned()) {
       LOG(WARNING)
           << "Can't reclaim from aggregation operator which has spilled and is under output processing, pool "
           << pool()->name()
@@ -477,10 +880,19 @@ void HashAggregation::reclaim(
     // Spill all the rows starting from the next output row pointed by
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
+  } else if (groupingSet_->isRadixPartitioned()) {
+    // Spills the largest partitions only. The others continue aggregating in
+    // memory.
+    groupingSet_->spillLargestPartitions(targetBytes);
+    pool()->release();
+    return;
   } else {
     // TODO: support fine-grain disk spilling based on 'targetBytes' after
     // having row container memory compaction support later.
     groupingSet_->spill();
+    if (distinctGroupingSet_ != nullptr) {
+      distinctGroupingSet_->spill();
+    }
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
   VELOX_CHECK_EQ(groupingSet_->numDistinct(), 0);
@@ -493,6 +905,10 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  distinctGroupingSet_.reset();
+  twoPhaseGroupingSet_.reset();
+  estimationHll_.reset();
+  estimationAllocator_.reset();
 }
 
 void HashAggregation::updateEstimatedOutputRowSize() {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -39,8 +40,12 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (!future_.valid()) {
+      return BlockingReason::kNotBlocked;
+    }
+    *future = std::move(future_);
+    return BlockingReason::kWaitForAggregationMerge;
   }
 
   bool isFinished() override;
@@ -70,8 +75,52 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Adds the grouping keys of 'input' to the cardinality estimate of the
+  // current window of input rows. At the end of a window of
+  // 'abandonPartialAggregationMinRows_' rows, sets 'highCardinality_' from the
+  // estimated number of distinct keys and resumes partial aggregation if it
+  // was abandoned and the window would be reduced.
+  void updateCardinalityEstimate(const RowVectorPtr& input);
+
+  // Switches from passing through the input back to aggregating it.
+  void resumePartialAggregation();
+
   RowVectorPtr getDistinctOutput();
 
+  // Sets up 'distinctGroupingSet_' and 'twoPhaseGroupingSet_' for a two-phase
+  // distinct aggregation. 'groupingKeyInputChannels' and
+  // 'groupingKeyOutputChannels' are as in 'setupGroupingKeyChannelProjections'.
+  void initializeTwoPhaseDistinct(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& groupingKeyInputChannels,
+      const std::vector<column_index_t>& groupingKeyOutputChannels,
+      std::shared_ptr<core::ExpressionEvaluator>& expressionEvaluator);
+
+  // Chooses between the two-phase distinct aggregation and the distinct
+  // aggregates of 'groupingSet_' by the number of distinct grouping keys in
+  // the first 'input'.
+  void chooseDistinctAggregation(const RowVectorPtr& input);
+
+  // Adds 'input' to 'distinctGroupingSet_' and the rows with new grouping keys
+  // and distinct inputs to 'groupingSet_'.
+  void addDistinctInput(const RowVectorPtr& input);
+
+  // Adds the rows of 'distinctGroupingSet_' that were not added to
+  // 'groupingSet_' on input because it spilled, and frees it.
+  void finishDistinctInput();
+
+  // Waits for all peer operators to reach the same step of merging the
+  // partitions. Returns true if all of them did, otherwise sets 'future_'.
+  bool waitForPeerMerge();
+
+  // Advances the merge of the partitions with the peer operators. Returns
+  // true once the partitions owned by 'this' have the groups of all peers and
+  // the other partitions are freed.
+  bool mergePartitions();
+
+  // Returns true if partition 'partition' is merged and produced by 'this'.
+  bool ownsPartition(int32_t partition) const;
+
   // Setups the projections for accessing grouping keys stored in grouping
   // set.
   // For 'groupingKeyInputChannels', the index is the key column index from
@@ -96,10 +145,51 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // True if partial aggregation decides whether to abandon or resume
+  // aggregation from a HyperLogLog estimate of the number of distinct grouping
+  // keys instead of the number of groups in the hash table.
+  const bool cardinalityEstimation_;
+
+  // True if the radix-partitioned 'groupingSet_' is merged with the ones of
+  // the peer operators at no more input, and each operator then produces the
+  // groups of the partitions it owns.
+  bool partitionMerge_{false};
+
+  // Steps of merging the partitions with the peer operators.
+  enum class MergeState {
+    // Receiving input.
+    kInput,
+    // Merging the owned partitions of the peers into 'groupingSet_'.
+    kMerge,
+    // Freeing the partitions of 'groupingSet_' owned by the peers.
+    kClear,
+    // Producing the groups of the owned partitions.
+    kOutput,
+  };
+  MergeState mergeState_{MergeState::kInput};
+
+  // Future for waiting for the peer operators to reach the same merge step.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
+  // Set for a two-phase distinct aggregation, see
+  // QueryConfig::kTwoPhaseDistinctAggregationMinGroups. Removes the duplicate
+  // grouping keys and distinct inputs, which are at 'distinctChannels_' of the
+  // input. Its new rows are aggregated by 'groupingSet_' with non-distinct
+  // aggregates.
+  std::unique_ptr<GroupingSet> distinctGroupingSet_;
+  // The aggregation of the rows of 'distinctGroupingSet_' until the first
+  // input decides if it replaces 'groupingSet_'.
+  std::unique_ptr<GroupingSet> twoPhaseGroupingSet_;
+  // The input channels of the grouping keys followed by the distinct inputs
+  // and the type of these columns, which is the input type of the two-phase
+  // 'groupingSet_'.
+  std::vector<column_index_t> distinctChannels_;
+  RowTypePtr distinctInputType_;
+  uint32_t twoPhaseDistinctMinGroups_{0};
+
   // Size of a single output row estimated using
   // 'groupingSet_->estimateRowSize()'. If spilling, this value is set to max
   // 'groupingSet_->estimateRowSize()' across all accumulated data set.
@@ -122,6 +212,23 @@ class HashAggregation : public Operator {
   // flush.
   int64_t numOutputRows_ = 0;
 
+  // Index bits of the HyperLogLog sketch for the cardinality estimate. Gives a
+  // standard error of about 2.3% with 1KB of memory.
+  static constexpr int8_t kEstimationIndexBitLength{11};
+
+  // Hashers for the grouping keys, a sketch of the key hashes in the current
+  // window of input rows and the number of rows in the window. Used if
+  // 'cardinalityEstimation_' is true.
+  std::vector<std::unique_ptr<VectorHasher>> estimationHashers_;
+  std::unique_ptr<HashStringAllocator> estimationAllocator_;
+  std::optional<common::hll::DenseHll> estimationHll_;
+  SelectivityVector estimationRows_;
+  raw_vector<uint64_t> estimationHashes_;
+  int64_t numEstimationRows_{0};
+  // True if the last complete window of input rows was estimated to have at
+  // least 'abandonPartialAggregationMinPct_' % distinct keys.
+  bool highCardinality_{false};
+
   // Possibly reusable output vector.
   RowVectorPtr output_;
 };
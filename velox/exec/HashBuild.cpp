@@ -39,6 +39,8 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       return BlockingReason::kWaitForJoinBuild;
     case HashBuild::State::kWaitForProbe:
       return BlockingReason::kWaitForJoinProbe;
+    case HashBuild::State::kWaitForSharedTable:
+      return BlockingReason::kWaitForJoinBuild;
     default:
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
@@ -101,6 +103,15 @@ HashBuild::HashBuild(
     }
   }
 
+  // The shared tables are keyed by query id.
+  const auto& queryCtx = operatorCtx_->task()->queryCtx();
+  if (!queryCtx->queryId().empty() &&
+      canShareHashJoinTable(
+          *joinNode_, driverCtx->queryConfig(), driverCtx->splitGroupId)) {
+    sharedTable_ = SharedHashJoinTableRegistry::instance().getOrCreate(
+        queryCtx->queryId(), planNodeId(), queryCtx->pool());
+  }
+
   tableType_ = hashJoinTableType(joinNode_);
   setupTable();
   setupSpiller();
@@ -143,7 +154,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool());
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -163,7 +174,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -174,15 +185,26 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool());
     }
   }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  table_->setJoinProbePartitioning(
+      queryConfig.hashProbePartitioningEnabled(),
+      queryConfig.hashProbePartitionBytes());
+  table_->setJoinKeyRows(queryConfig.hashJoinKeyRowsMinKeys());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
-void HashBuild::setupSpiller(SpillPartition* spillPartition) {
+memory::MemoryPool* HashBuild::tablePool() const {
+  return sharedTable_ != nullptr ? sharedTable_->pool() : pool();
+}
+
+void HashBuild::setupSpiller(SpillPartition* spillPartition, bool merged) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
+  VELOX_CHECK(!merged || spillPartition != nullptr);
+  restoringMergedPartitions_ = merged;
 
   if (!canSpill()) {
     return;
@@ -206,6 +228,10 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
         config->readBufferSize, pool(), &spillStats_);
     VELOX_CHECK(!restoringPartitionId_.has_value());
     restoringPartitionId_ = spillPartition->id();
+    if (merged) {
+      // The merged partitions are expected to fit in memory together.
+      return;
+    }
     const auto numPartitionBits = config->numPartitionBits;
     startPartitionBit =
         partitionBitOffset(
@@ -647,6 +673,20 @@ bool HashBuild::finishHashBuild() {
   // table.
   pool()->release();
 
+  // Each build reports the rows it collected before they are merged into the
+  // table of the last build.
+  {
+    const auto hashTableStats = table_->stats();
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kRowBytes,
+        RuntimeCounter(hashTableStats.rowBytes, RuntimeCounter::Unit::kBytes));
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kStringBytes,
+        RuntimeCounter(
+            hashTableStats.stringBytes, RuntimeCounter::Unit::kBytes));
+  }
+
   std::vector<ContinuePromise> promises;
   std::vector<std::shared_ptr<Driver>> peers;
   // The last Driver to hit HashBuild::finish gathers the data from
@@ -673,7 +713,7 @@ bool HashBuild::finishHashBuild() {
 
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
-    joinBridge_->setAntiJoinHasNullKeys();
+    setAntiJoinHasNullKeys();
     return true;
   }
 
@@ -691,7 +731,7 @@ bool HashBuild::finishHashBuild() {
     if (build->joinHasNullKeys_) {
       joinHasNullKeys_ = true;
       if (isAntiJoin(joinType_) && nullAware_ && !joinNode_->filter()) {
-        joinBridge_->setAntiJoinHasNullKeys();
+        setAntiJoinHasNullKeys();
         return true;
       }
     }
@@ -784,8 +824,15 @@ bool HashBuild::finishHashBuild() {
           spillStats);
     };
   }
+  std::shared_ptr<BaseHashTable> table;
+  if (buildSharedTable_) {
+    table =
+        sharedTable_->setTable(taskId(), std::move(table_), joinHasNullKeys_);
+  } else {
+    table = std::move(table_);
+  }
   joinBridge_->setHashTable(
-      std::move(table_),
+      std::move(table),
       std::move(spillPartitions),
       joinHasNullKeys_,
       std::move(tableSpillFunc));
@@ -795,6 +842,59 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+void HashBuild::setAntiJoinHasNullKeys() {
+  if (buildSharedTable_) {
+    sharedTable_->setTable(taskId(), nullptr, /*hasNullKeys=*/true);
+  }
+  joinBridge_->setAntiJoinHasNullKeys();
+}
+
+void HashBuild::maybeUseSharedTable() {
+  checkRunning();
+  VELOX_CHECK_NOT_NULL(sharedTable_);
+  VELOX_CHECK(!buildSharedTable_);
+
+  std::optional<SharedHashJoinTable::Table> sharedTable;
+  if (sharedTable_->shouldBuild(taskId(), sharedTable, &future_)) {
+    buildSharedTable_ = true;
+    return;
+  }
+  if (!sharedTable.has_value()) {
+    VELOX_CHECK(future_.valid());
+    setState(State::kWaitForSharedTable);
+    return;
+  }
+
+  // Another task has built the table. Skip the build input and hand the table
+  // over to the probe side once all the peers got here.
+  Operator::noMoreInput();
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    setState(State::kWaitForBuild);
+    return;
+  }
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  if (sharedTable->table == nullptr) {
+    joinBridge_->setAntiJoinHasNullKeys();
+  } else {
+    joinBridge_->setHashTable(
+        std::move(sharedTable->table),
+        {},
+        sharedTable->hasNullKeys,
+        nullptr);
+  }
+  stats_.wlock()->addRuntimeStat("sharedHashTable", RuntimeCounter(1));
+  postHashBuildProcess();
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -877,7 +977,7 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
-  setupSpiller(spillInput.spillPartition.get());
+  setupSpiller(spillInput.spillPartition.get(), spillInput.merged);
   stateCleared_ = false;
 
   // Start to process spill input.
@@ -928,10 +1028,16 @@ void HashBuild::addRuntimeStats() {
       RuntimeMetric(hashTableStats.numRehashes);
   lockedStats->runtimeStats[BaseHashTable::kNumDistinct] =
       RuntimeMetric(hashTableStats.numDistinct);
+  lockedStats->runtimeStats[BaseHashTable::kTableBytes] = RuntimeMetric(
+      hashTableStats.tableBytes, RuntimeCounter::Unit::kBytes);
   if (hashTableStats.numTombstones != 0) {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  if (hashTableStats.numHotKeys != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kNumHotKeys] =
+        RuntimeMetric(hashTableStats.numHotKeys);
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->state().isAnyPartitionSpilled()) {
@@ -947,6 +1053,9 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kRunning:
       if (isInputFromSpill()) {
         processSpillInput();
+      } else if (
+          sharedTable_ != nullptr && !buildSharedTable_ && !noMoreInput_) {
+        maybeUseSharedTable();
       }
       break;
     case State::kYield:
@@ -964,6 +1073,12 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
         postHashBuildProcess();
       }
       break;
+    case State::kWaitForSharedTable:
+      if (!future_.valid()) {
+        setRunning();
+        maybeUseSharedTable();
+      }
+      break;
     default:
       VELOX_UNREACHABLE("Unexpected state: {}", stateName(state_));
       break;
@@ -1001,7 +1116,10 @@ void HashBuild::checkStateTransition(State state) {
   switch (state) {
     case State::kRunning:
       if (!canSpill()) {
-        VELOX_CHECK_EQ(state_, State::kWaitForBuild);
+        VELOX_CHECK(
+            state_ == State::kWaitForBuild ||
+                state_ == State::kWaitForSharedTable,
+            stateName(state_));
       } else {
         VELOX_CHECK_NE(state_, State::kFinish);
       }
@@ -1010,6 +1128,8 @@ void HashBuild::checkStateTransition(State state) {
       [[fallthrough]];
     case State::kWaitForProbe:
       [[fallthrough]];
+    case State::kWaitForSharedTable:
+      [[fallthrough]];
     case State::kFinish:
       VELOX_CHECK_EQ(state_, State::kRunning);
       break;
@@ -1031,6 +1151,8 @@ std::string HashBuild::stateName(State state) {
       return "WAIT_FOR_PROBE";
     case State::kFinish:
       return "FINISH";
+    case State::kWaitForSharedTable:
+      return "WAIT_FOR_SHARED_TABLE";
     default:
       return fmt::format("UNKNOWN: {}", static_cast<int>(state));
   }
@@ -1042,7 +1164,8 @@ bool HashBuild::canSpill() const {
 }
 
 bool HashBuild::canReclaim() const {
-  return canSpill() && !exceededMaxSpillLevelLimit_;
+  return canSpill() && !exceededMaxSpillLevelLimit_ &&
+      !restoringMergedPartitions_;
 }
 
 void HashBuild::reclaim(
@@ -1149,6 +1272,10 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  if (sharedTable_ != nullptr) {
+    sharedTable_->closeBuild(taskId());
+    sharedTable_.reset();
+  }
 }
 
 HashBuildSpiller::HashBuildSpiller(
@@ -53,6 +53,9 @@ class HashBuild final : public Operator {
     kWaitForProbe = 4,
     /// The finishing state.
     kFinish = 5,
+    /// The state that waits for another task to build the shared hash table.
+    /// This state only applies if the table is shared across tasks.
+    kWaitForSharedTable = 6,
   };
   static std::string stateName(State state);
 
@@ -115,6 +118,18 @@ class HashBuild final : public Operator {
   // merged from all the other drivers.
   bool finishHashBuild();
 
+  // Invoked before processing any input if the table is shared with the other
+  // tasks of the query. Returns if this task builds the table. Otherwise, waits
+  // for another task to build it and hands it over to the probe side without
+  // processing the build input.
+  void maybeUseSharedTable();
+
+  // Invoked by the last driver if a null-aware anti join has null keys.
+  void setAntiJoinHasNullKeys();
+
+  // Returns the pool to allocate the hash table from.
+  memory::MemoryPool* tablePool() const;
+
   // Invoked after the hash table has been built. It waits for any spill data to
   // process after the probe side has finished processing the previously built
   // hash table. If disk spilling is not enabled or there is no more spill data,
@@ -138,7 +153,11 @@ class HashBuild final : public Operator {
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
   // in memory, then we will recursively spill part(s) of its data on disk.
-  void setupSpiller(SpillPartition* spillPartition = nullptr);
+  // If 'merged' is true, then 'spillPartition' contains the data of several
+  // spilled partitions and the restored table is not spilled again.
+  void setupSpiller(
+      SpillPartition* spillPartition = nullptr,
+      bool merged = false);
 
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
@@ -223,8 +242,20 @@ class HashBuild final : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // Set if the table is shared with the other tasks of the query. All the
+  // HashBuild operators of the task then allocate their tables from the shared
+  // pool.
+  std::shared_ptr<SharedHashJoinTable> sharedTable_;
+
+  // True if 'sharedTable_' is set and this task has been picked to build it.
+  bool buildSharedTable_{false};
+
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
 
+  // True if the table is built from a shard of several merged spill
+  // partitions. Spilling is disabled for such a table.
+  tsan_atomic<bool> restoringMergedPartitions_{false};
+
   State state_{State::kRunning};
 
   // The row type used for hash table build and disk spilling.
@@ -212,7 +212,7 @@ SpillPartitionSet spillHashJoinTable(
 }
 
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys,
     HashJoinTableSpillFunc&& tableSpillFunc) {
@@ -234,7 +234,10 @@ void HashJoinBridge::setHashTable(
         std::move(restoringSpillPartitionId_),
         spillPartitionIdSet,
         hasNullKeys);
+    buildResult_->mergedPartitionIds =
+        std::move(restoringMergedPartitionIds_);
     restoringSpillPartitionId_.reset();
+    restoringMergedPartitionIds_.clear();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -301,6 +304,7 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
 
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
+    restoringMergedPartitionIds_.clear();
     spillPartitions.swap(spillPartitionSets_);
     promises = std::move(promises_);
   }
@@ -326,7 +330,7 @@ std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
   return std::nullopt;
 }
 
-bool HashJoinBridge::probeFinished() {
+bool HashJoinBridge::probeFinished(uint64_t maxMergedRestoreBytes) {
   std::vector<ContinuePromise> promises;
   bool hasSpillInput = false;
   {
@@ -336,6 +340,7 @@ bool HashJoinBridge::probeFinished() {
     VELOX_CHECK(
         !restoringSpillPartitionId_.has_value() &&
         restoringSpillShards_.empty());
+    VELOX_CHECK(restoringMergedPartitionIds_.empty());
     VELOX_CHECK_GT(numBuilders_, 0);
     probeStarted_ = false;
     VELOX_CHECK_NULL(tableSpillFunc_);
@@ -347,11 +352,24 @@ bool HashJoinBridge::probeFinished() {
 
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
+      auto restoringPartition = std::move(spillPartitionSets_.begin()->second);
       restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
-      VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
       spillPartitionSets_.erase(spillPartitionSets_.begin());
+      // The partitions at the same spill level are adjacent in
+      // 'spillPartitionSets_'. Since they use the same partition bits, the
+      // data of several small ones can be built into one table.
+      auto it = spillPartitionSets_.begin();
+      while (it != spillPartitionSets_.end() &&
+             it->first.spillLevel() ==
+                 restoringSpillPartitionId_->spillLevel() &&
+             restoringPartition->size() + it->second->size() <=
+                 maxMergedRestoreBytes) {
+        restoringMergedPartitionIds_.insert(it->first);
+        restoringPartition->addFiles(it->second->files());
+        it = spillPartitionSets_.erase(it);
+      }
+      restoringSpillShards_ = restoringPartition->split(numBuilders_);
+      VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
     }
     promises = std::move(promises_);
   }
@@ -387,7 +405,155 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(
+      std::move(spillShard), !restoringMergedPartitionIds_.empty());
+}
+
+SharedHashJoinTable::SharedHashJoinTable(
+    std::string queryId,
+    core::PlanNodeId planNodeId,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : queryId_(std::move(queryId)),
+      planNodeId_(std::move(planNodeId)),
+      pool_(std::move(pool)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+SharedHashJoinTable::~SharedHashJoinTable() {
+  SharedHashJoinTableRegistry::instance().remove(queryId_, planNodeId_);
+}
+
+bool SharedHashJoinTable::shouldBuild(
+    const std::string& taskId,
+    std::optional<Table>& table,
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (tableSet_) {
+    auto sharedTable = table_.lock();
+    if (sharedTable != nullptr || hasNullKeys_) {
+      table = Table{std::move(sharedTable), hasNullKeys_};
+      return false;
+    }
+    // All the users of the table have finished. Build a new one.
+    tableSet_ = false;
+    builderTaskId_.reset();
+  }
+  if (!builderTaskId_.has_value()) {
+    builderTaskId_ = taskId;
+  }
+  if (builderTaskId_.value() == taskId) {
+    return true;
+  }
+  promises_.emplace_back("SharedHashJoinTable::shouldBuild");
+  *future = promises_.back().getSemiFuture();
+  return false;
+}
+
+std::shared_ptr<BaseHashTable> SharedHashJoinTable::setTable(
+    const std::string& taskId,
+    std::unique_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  std::shared_ptr<BaseHashTable> sharedTable;
+  if (table != nullptr) {
+    VELOX_CHECK(table->rows()->pool() == pool_.get());
+    // The table keeps its pool alive as it may outlive 'this'.
+    sharedTable = std::shared_ptr<BaseHashTable>(
+        table.release(),
+        [pool = pool_](BaseHashTable* hashTable) { delete hashTable; });
+  }
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(builderTaskId_ == taskId);
+    VELOX_CHECK(!tableSet_);
+    tableSet_ = true;
+    hasNullKeys_ = hasNullKeys;
+    table_ = sharedTable;
+    promises.swap(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return sharedTable;
+}
+
+void SharedHashJoinTable::closeBuild(const std::string& taskId) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (tableSet_ || builderTaskId_ != taskId) {
+      return;
+    }
+    builderTaskId_.reset();
+    promises.swap(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+// static
+SharedHashJoinTableRegistry& SharedHashJoinTableRegistry::instance() {
+  static SharedHashJoinTableRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<SharedHashJoinTable> SharedHashJoinTableRegistry::getOrCreate(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId,
+    memory::MemoryPool* queryPool) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& entry = tables_[{queryId, planNodeId}];
+  if (auto table = entry.lock()) {
+    return table;
+  }
+  auto pool = queryPool->addLeafChild(
+      fmt::format("sharedHashJoinTable.{}.{}", planNodeId, nextPoolId_++),
+      true,
+      queryPool->reclaimer() != nullptr ? exec::MemoryReclaimer::create()
+                                        : nullptr);
+  auto table = std::make_shared<SharedHashJoinTable>(
+      queryId, planNodeId, std::move(pool));
+  entry = table;
+  return table;
+}
+
+size_t SharedHashJoinTableRegistry::numTables() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return tables_.size();
+}
+
+void SharedHashJoinTableRegistry::remove(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tables_.find({queryId, planNodeId});
+  // The entry may have been replaced by a new table after the last reference
+  // to the destroyed one was dropped.
+  if (it != tables_.end() && it->second.expired()) {
+    tables_.erase(it);
+  }
+}
+
+bool canShareHashJoinTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig,
+    uint32_t splitGroupId) {
+  if (!queryConfig.hashJoinShareBroadcastBuild() ||
+      splitGroupId != kUngroupedGroupId || joinNode.canSpill(queryConfig)) {
+    return false;
+  }
+  // The other join types set the probed flags in the table.
+  switch (joinNode.joinType()) {
+    case core::JoinType::kInner:
+    case core::JoinType::kLeft:
+    case core::JoinType::kLeftSemiFilter:
+    case core::JoinType::kLeftSemiProject:
+    case core::JoinType::kAnti:
+      return true;
+    default:
+      return false;
+  }
 }
 
 bool isLeftNullAwareJoinWithFilter(
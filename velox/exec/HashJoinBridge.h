@@ -54,7 +54,7 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys,
       HashJoinTableSpillFunc&& tableSpillFunc);
@@ -106,6 +106,12 @@ class HashJoinBridge : public JoinBridge {
     /// fine-grained spilling for hash table, either 'table' is empty or
     /// 'spillPartitionIds' is empty.
     SpillPartitionIdSet spillPartitionIds;
+
+    /// The ids of the spill partitions other than 'restoredPartitionId' that
+    /// are restored into 'table'. The probe side reads the spilled probe
+    /// inputs of these partitions together with the one of
+    /// 'restoredPartitionId'.
+    SpillPartitionIdSet mergedPartitionIds;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -119,17 +125,26 @@ class HashJoinBridge : public JoinBridge {
   /// operators will then build the next hash table from the selected spilled
   /// one. The function returns true if there is spill data to be restored by
   /// HashBuild operators next.
-  bool probeFinished();
+  ///
+  /// If 'maxMergedRestoreBytes' is not zero, then the following spilled
+  /// partitions at the same spill level are restored together with the
+  /// selected one as long as their total size is within this limit.
+  bool probeFinished(uint64_t maxMergedRestoreBytes = 0);
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
   /// data to restore.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool merged = false)
+        : spillPartition(std::move(spillPartition)), merged(merged) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+
+    /// True if 'spillPartition' contains the data of more than one spilled
+    /// partition. The table built from a merged shard is not spilled again.
+    bool merged;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -164,6 +179,10 @@ class HashJoinBridge : public JoinBridge {
   // If not null, set to the currently restoring table spill partition id.
   std::optional<SpillPartitionId> restoringSpillPartitionId_;
 
+  // The ids of the partitions restored together with
+  // 'restoringSpillPartitionId_'. Their files are in 'restoringSpillShards_'.
+  SpillPartitionIdSet restoringMergedPartitionIds_;
+
   // If 'restoringSpillPartitionId_' is not null, this set to the restoring
   // spill partition data shards. Each shard is expected to have the same number
   // of spill files and will be processed by one of the HashBuild operator.
@@ -183,6 +202,125 @@ class HashJoinBridge : public JoinBridge {
   friend test::HashJoinBridgeTestHelper;
 };
 
+/// A hash join table shared by the tasks of one query that run on the same
+/// worker and build the same table from a broadcast build side. The first task
+/// to ask builds the table. The others skip their build input and hand the
+/// shared, read-only table to their probe side through their own
+/// HashJoinBridge. The table memory is allocated from a leaf pool of the query
+/// pool so that the table can outlive the task which built it.
+///
+/// This is owned by shared_ptr by the HashBuild operators of all the tasks
+/// concerned and is registered in SharedHashJoinTableRegistry while alive. The
+/// built table is owned by the HashProbe operators of all the tasks and holds
+/// a reference to the memory pool. A task that comes after the table has been
+/// released builds a new one.
+class SharedHashJoinTable {
+ public:
+  SharedHashJoinTable(
+      std::string queryId,
+      core::PlanNodeId planNodeId,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  ~SharedHashJoinTable();
+
+  /// The pool to allocate the table from.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// The built table. 'table' is null if the join is a null-aware anti join
+  /// and the build side has null keys.
+  struct Table {
+    std::shared_ptr<BaseHashTable> table;
+    bool hasNullKeys{false};
+  };
+
+  /// Invoked by the HashBuild operators of 'taskId' before they add any input.
+  /// Returns true if 'taskId' must build the table. This is the case for the
+  /// first task to ask, and if the building task closed without setting the
+  /// table or if the table has been released. Otherwise, sets 'table' if the
+  /// table is available or sets 'future' to wait for it.
+  bool shouldBuild(
+      const std::string& taskId,
+      std::optional<Table>& table,
+      ContinueFuture* future);
+
+  /// Invoked by the last HashBuild operator of the building task 'taskId' to
+  /// set the built table. Returns the table to hand over to the probe side of
+  /// 'taskId', or null if 'table' is null.
+  std::shared_ptr<BaseHashTable> setTable(
+      const std::string& taskId,
+      std::unique_ptr<BaseHashTable> table,
+      bool hasNullKeys);
+
+  /// Invoked by each HashBuild operator of 'taskId' on close. If 'taskId' is
+  /// building the table and has not set it, lets one of the waiting tasks
+  /// build it instead.
+  void closeBuild(const std::string& taskId);
+
+ private:
+  const std::string queryId_;
+  const core::PlanNodeId planNodeId_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  std::mutex mutex_;
+
+  // The task building the table, if any.
+  std::optional<std::string> builderTaskId_;
+
+  // True once the builder task has set the table.
+  bool tableSet_{false};
+
+  bool hasNullKeys_{false};
+
+  // The table is owned by the probe operators of the tasks using it.
+  std::weak_ptr<BaseHashTable> table_;
+
+  std::vector<ContinuePromise> promises_;
+};
+
+/// Process wide registry of the SharedHashJoinTable's of the running queries,
+/// keyed by query id and hash join plan node id.
+class SharedHashJoinTableRegistry {
+ public:
+  static SharedHashJoinTableRegistry& instance();
+
+  /// Returns the shared table for 'planNodeId' of 'queryId'. Creates it with a
+  /// leaf pool of 'queryPool' if it does not exist or has been released.
+  std::shared_ptr<SharedHashJoinTable> getOrCreate(
+      const std::string& queryId,
+      const core::PlanNodeId& planNodeId,
+      memory::MemoryPool* queryPool);
+
+  /// Returns the number of live shared tables. Used for testing.
+  size_t numTables();
+
+ private:
+  friend class SharedHashJoinTable;
+
+  // Invoked from the SharedHashJoinTable destructor.
+  void remove(const std::string& queryId, const core::PlanNodeId& planNodeId);
+
+  std::mutex mutex_;
+  std::map<
+      std::pair<std::string, core::PlanNodeId>,
+      std::weak_ptr<SharedHashJoinTable>>
+      tables_;
+
+  // Used to make the pool names unique while a released table is still alive.
+  uint64_t nextPoolId_{0};
+};
+
+/// Returns true if the HashBuild operators for 'joinNode' can share the built
+/// table with the other tasks of the query. This requires
+/// QueryConfig::hashJoinShareBroadcastBuild() to be set, no spilling and
+/// ungrouped execution, and a join type that does not update the table while
+/// probing.
+bool canShareHashJoinTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig,
+    uint32_t splitGroupId);
+
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
 // has filter set.
 bool isLeftNullAwareJoinWithFilter(
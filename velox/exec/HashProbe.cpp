@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashProbe.h"
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
@@ -30,6 +31,63 @@ namespace {
 
 // Batch size used when iterating the row container.
 constexpr int kBatchSize = 1024;
+
+template <typename T>
+std::unique_ptr<common::Filter> makeBloomFilter(
+    const BaseHashTable& table,
+    column_index_t keyIndex) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(std::min<uint64_t>(
+      table.numDistinct(), std::numeric_limits<int32_t>::max()));
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  std::vector<char*> rows(kBatchSize);
+  for (auto* rowContainer : table.allRows()) {
+    const auto column = rowContainer->columnAt(keyIndex);
+    RowContainerIterator iter;
+    int32_t numRows;
+    while ((numRows = rowContainer->listRows(&iter, kBatchSize, rows.data())) >
+           0) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            RowContainer::valueAt<T>(rows[i], column.offset());
+        bloomFilter->insert(
+            common::BigintValuesUsingBloomFilter::hash(value));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  }
+  if (min > max) {
+    // All keys are null. Null keys never match so there is nothing to pass.
+    return std::make_unique<common::AlwaysFalse>();
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), /*nullAllowed=*/false);
+}
+
+// Returns a Bloom filter over the non-null values of the 'keyIndex'th key of
+// 'table' or nullptr if the key type is not an integer type.
+std::unique_ptr<common::Filter> makeBloomFilter(
+    const BaseHashTable& table,
+    column_index_t keyIndex,
+    const TypePtr& keyType) {
+  switch (keyType->kind()) {
+    case TypeKind::BIGINT:
+      return makeBloomFilter<int64_t>(table, keyIndex);
+    case TypeKind::INTEGER:
+      return makeBloomFilter<int32_t>(table, keyIndex);
+    case TypeKind::SMALLINT:
+      return makeBloomFilter<int16_t>(table, keyIndex);
+    case TypeKind::TINYINT:
+      return makeBloomFilter<int8_t>(table, keyIndex);
+    default:
+      return nullptr;
+  }
+}
 } // namespace
 
 // static
@@ -118,12 +176,38 @@ T* initBuffer(BufferPtr& buffer, vector_size_t size, memory::MemoryPool* pool) {
   return buffer->asMutable<T>();
 }
 
+// Returns the conjunction of 'joinFilter' and 'fusedFilter', either of which
+// may be null.
+core::TypedExprPtr combineFilters(
+    core::TypedExprPtr joinFilter,
+    core::TypedExprPtr fusedFilter) {
+  if (joinFilter == nullptr) {
+    return fusedFilter;
+  }
+  if (fusedFilter == nullptr) {
+    return joinFilter;
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(),
+      std::vector<core::TypedExprPtr>{
+          std::move(joinFilter), std::move(fusedFilter)},
+      "and");
+}
+
 } // namespace
 
+// static
+bool HashProbe::canFuseFilter(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& queryConfig) {
+  return queryConfig.hashProbeFilterFusionEnabled() && joinNode.isInnerJoin();
+}
+
 HashProbe::HashProbe(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::HashJoinNode>& joinNode)
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    core::TypedExprPtr fusedFilter)
     : Operator(
           driverCtx,
           joinNode->outputType(),
@@ -135,12 +219,15 @@ HashProbe::HashProbe(
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinNode_(std::move(joinNode)),
+      joinFilter_(combineFilters(joinNode_->filter(), std::move(fusedFilter))),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
       probeType_(joinNode_->sources()[0]->outputType()),
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      maxMergedSpillRestoreBytes_(
+          driverCtx->queryConfig().maxMergedJoinSpillRestoreBytes()),
       filterResult_(1),
       outputTableRowsCapacity_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -162,8 +249,8 @@ void HashProbe::initialize() {
   lookup_ = std::make_unique<HashLookup>(hashers_, pool());
   auto buildType = joinNode_->sources()[1]->outputType();
   auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
-  if (joinNode_->filter()) {
-    initializeFilter(joinNode_->filter(), probeType_, tableType);
+  if (joinFilter_) {
+    initializeFilter(joinFilter_, probeType_, tableType);
   }
 
   size_t numIdentityProjections = 0;
@@ -280,9 +367,12 @@ void HashProbe::maybeSetupInputSpiller(
 }
 
 void HashProbe::maybeSetupSpillInputReader(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    const SpillPartitionIdSet& mergedPartitionIds) {
   VELOX_CHECK_NULL(spillInputReader_);
+  restoringMergedPartitions_ = !mergedPartitionIds.empty();
   if (!restoredPartitionId.has_value()) {
+    VELOX_CHECK(mergedPartitionIds.empty());
     return;
   }
   // If 'restoredPartitionId' is not null, then 'table_' is built from the
@@ -292,10 +382,16 @@ void HashProbe::maybeSetupSpillInputReader(
   VELOX_CHECK(iter != inputSpillPartitionSet_.end());
   auto partition = std::move(iter->second);
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
+  inputSpillPartitionSet_.erase(iter);
+  for (const auto& id : mergedPartitionIds) {
+    auto mergedIter = inputSpillPartitionSet_.find(id);
+    VELOX_CHECK(mergedIter != inputSpillPartitionSet_.end());
+    partition->addFiles(mergedIter->second->files());
+    inputSpillPartitionSet_.erase(mergedIter);
+  }
   restoringPartitionId_ = restoredPartitionId;
   spillInputReader_ = partition->createUnorderedReader(
       spillConfig_->readBufferSize, pool(), &spillStats_);
-  inputSpillPartitionSet_.erase(iter);
 }
 
 std::optional<uint64_t> HashProbe::estimatedRowSize(
@@ -412,10 +508,17 @@ void HashProbe::asyncWaitForHashTable() {
 
   VELOX_CHECK_NOT_NULL(table_);
 
-  maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
+  maybeSetupSpillInputReader(
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->mergedPartitionIds);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
   checkMaxSpillLevel(hashBuildResult->restoredPartitionId);
 
+  const auto bloomFilterPushdownMaxSize =
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .hashProbeBloomFilterPushdownMaxSize();
+  int64_t numBloomFilters{0};
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
       if (!needToSpillInput()) {
@@ -434,8 +537,9 @@ void HashProbe::asyncWaitForHashTable() {
        isRightSemiFilterJoin(joinType_) ||
        (isRightSemiProjectJoin(joinType_) && !nullAware_) ||
        isRightJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       bloomFilterPushdownMaxSize > 0) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -450,12 +554,29 @@ void HashProbe::asyncWaitForHashTable() {
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
       if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(/*nullAllowed=*/false)) {
+        std::unique_ptr<common::Filter> filter;
+        if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+          filter = buildHashers[i]->getFilter(/*nullAllowed=*/false);
+        }
+        // Fall back to a Bloom filter on the build side keys if there is no
+        // range or IN-list filter for the key and the table is small enough.
+        if (filter == nullptr &&
+            table_->numDistinct() <= bloomFilterPushdownMaxSize) {
+          filter = makeBloomFilter(*table_, i, buildHashers[i]->type());
+          if (filter != nullptr) {
+            ++numBloomFilters;
+          }
+        }
+        if (filter != nullptr) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
         }
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
+    if (numBloomFilters > 0) {
+      addRuntimeStat(
+          "bloomFilterDynamicFilters", RuntimeCounter(numBloomFilters));
+    }
   }
 }
 
@@ -486,7 +607,7 @@ void HashProbe::prepareForSpillRestore() {
     return;
   }
   // Notify the hash build operators to build the next hash table.
-  joinBridge_->probeFinished();
+  joinBridge_->probeFinished(maxMergedSpillRestoreBytes_);
 
   wakeupPeerOperators();
 
@@ -770,13 +891,9 @@ void HashProbe::prepareOutput(vector_size_t size) {
   // We expect output vectors containing probe-side data to be null (reset in
   // clearIdentityProjectedOutput). BaseVector::prepareForReuse keeps null
   // children unmodified and makes non-null (build side) children reusable.
-  if (output_) {
-    VectorPtr output = std::move(output_);
-    BaseVector::prepareForReuse(output, size);
-    output_ = std::static_pointer_cast<RowVector>(output);
-  } else {
-    output_ = BaseVector::create<RowVector>(outputType_, size, pool());
-  }
+  VectorPtr output = std::move(output_);
+  prepareOutputVector(output, outputType_, size);
+  output_ = std::static_pointer_cast<RowVector>(output);
 }
 
 namespace {
@@ -1040,7 +1157,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
       asyncWaitForHashTable();
     } else {
       if (lastProber_ && canSpill()) {
-        joinBridge_->probeFinished();
+        joinBridge_->probeFinished(maxMergedSpillRestoreBytes_);
         wakeupPeerOperators();
       }
       setState(ProbeOperatorState::kFinish);
@@ -1763,7 +1880,8 @@ void HashProbe::ensureOutputFits() {
 }
 
 bool HashProbe::canReclaim() const {
-  return canSpill() && !exceededMaxSpillLevelLimit_;
+  return canSpill() && !exceededMaxSpillLevelLimit_ &&
+      !restoringMergedPartitions_;
 }
 
 void HashProbe::reclaim(
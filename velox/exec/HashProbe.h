@@ -27,10 +27,22 @@ namespace facebook::velox::exec {
 // Probes a hash table made by HashBuild.
 class HashProbe : public Operator {
  public:
+  /// 'fusedFilter' is the condition of a FilterNode over the output of the
+  /// join that is evaluated with the join filter instead of on the output.
+  /// See canFuseFilter().
   HashProbe(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::HashJoinNode>& hashJoinNode);
+      const std::shared_ptr<const core::HashJoinNode>& hashJoinNode,
+      core::TypedExprPtr fusedFilter = nullptr);
+
+  /// Returns true if a FilterNode over the output of 'joinNode' can be
+  /// evaluated by the probe as part of the join filter. This is the case for
+  /// inner joins, where a row fails the filter after the join if and only if
+  /// it fails it as part of the join condition.
+  static bool canFuseFilter(
+      const core::HashJoinNode& joinNode,
+      const core::QueryConfig& queryConfig);
 
   void initialize() override;
 
@@ -233,8 +245,11 @@ class HashProbe : public Operator {
 
   // If 'restoredSpillPartitionId' is set, then setup 'spillInputReader_' to
   // read probe inputs from spilled data on disk.
+  // 'mergedPartitionIds' are the ids of the partitions whose spilled probe
+  // inputs are read together with the one of 'restoredSpillPartitionId'.
   void maybeSetupSpillInputReader(
-      const std::optional<SpillPartitionId>& restoredSpillPartitionId);
+      const std::optional<SpillPartitionId>& restoredSpillPartitionId,
+      const SpillPartitionIdSet& mergedPartitionIds);
 
   // Checks the hash table's spill level limit from the restored table. Sets the
   // 'exceededMaxSpillLevelLimit_' accordingly.
@@ -363,6 +378,10 @@ class HashProbe : public Operator {
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
+  // The conjunction of the filter of 'joinNode_' and the fused filter, if
+  // any.
+  const core::TypedExprPtr joinFilter_;
+
   const core::JoinType joinType_;
 
   const bool nullAware_;
@@ -371,6 +390,10 @@ class HashProbe : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // The max total size of the spill partitions restored together in one
+  // round. See QueryConfig::kMaxMergedJoinSpillRestoreBytes.
+  const uint64_t maxMergedSpillRestoreBytes_;
+
   ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
 
   // Used for synchronization with the hash probe operators of the same pipeline
@@ -666,6 +689,10 @@ class HashProbe : public Operator {
   // the next previously spilled hash table partition.
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
 
+  // True if 'table_' is built from several merged spill partitions. Spilling
+  // is disabled for such a table.
+  tsan_atomic<bool> restoringMergedPartitions_{false};
+
   // The partition bits used to spill the hash table.
   HashBitRange tableSpillHashBits_;
 
@@ -79,6 +79,51 @@ HashTable<ignoreNullKeys>::HashTable(
   nextOffset_ = rows_->nextOffset();
 }
 
+namespace {
+// Returns true if the values of 'type' are equal if and only if their bytes
+// in a RowContainer row are equal. Floating point types are not, because of
+// NaNs and signed zeros.
+bool isKeyRowType(const Type& type) {
+  if (type.providesCustomComparison()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setJoinKeyRows(int32_t minKeys) {
+  VELOX_CHECK(isJoinBuild_);
+  VELOX_CHECK_EQ(rows_->numRows(), 0);
+  keyRowSize_ = 0;
+  // With null keys in the table the null flags would have to be compared too.
+  if (!ignoreNullKeys || minKeys <= 0 || hashers_.size() < minKeys) {
+    return;
+  }
+  int32_t size = 0;
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto& type = hashers_[i]->type();
+    if (!isKeyRowType(*type)) {
+      return;
+    }
+    // The keys are the first fields of a row, without gaps.
+    VELOX_CHECK_EQ(rows_->columnAt(i).offset(), size);
+    size += type->cppSizeInBytes();
+  }
+  keyRowSize_ = size;
+}
+
 class ProbeState {
  public:
   enum class Operation { kProbe, kInsert, kErase };
@@ -352,6 +397,13 @@ bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
     HashLookup& lookup,
     vector_size_t row) {
+  if (keyRowSize_ > 0) {
+    return memcmp(
+               group,
+               lookup.keyRows.data() +
+                   static_cast<int64_t>(row) * keyRowSize_,
+               keyRowSize_) == 0;
+  }
   int32_t numKeys = lookup.hashers.size();
   // The loop runs at least once. Allow for first comparison to fail
   // before loop end check.
@@ -370,6 +422,9 @@ template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
     const char* inserted) {
+  if (keyRowSize_ > 0) {
+    return memcmp(group, inserted, keyRowSize_) == 0;
+  }
   auto numKeys = hashers_.size();
   int32_t i = 0;
   do {
@@ -602,6 +657,20 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  if (capacity_ > 0 && lookup.rows.size() >= kPrefetchSize) {
+    // Without the partitioned probe, large tables are still probed in order
+    // of 256 regions, which saves TLB misses.
+    constexpr int32_t kRegionBits = 8;
+    const auto partitionBits = probePartitionBits();
+    if (partitionBits > 0) {
+      groupPrefetchJoinProbe(lookup, partitionBits);
+      return;
+    }
+    if (static_cast<uint64_t>(sizeMask_) + 1 >= groupPrefetchProbeMinBytes_) {
+      groupPrefetchJoinProbe(lookup, kRegionBits);
+      return;
+    }
+  }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
@@ -635,6 +704,79 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::probePartitionBits() const {
+  // A table that is only a few times the size of the cache stays mostly
+  // cached without partitioning.
+  constexpr uint64_t kMinPartitions = 4;
+  if (!probePartitioning_) {
+    return 0;
+  }
+  const uint64_t numPartitions =
+      (static_cast<uint64_t>(sizeMask_) + 1) / probePartitionBytes_;
+  if (numPartitions < kMinPartitions) {
+    return 0;
+  }
+  return std::min<int32_t>(
+      63 - __builtin_clzll(numPartitions), kMaxProbePartitionBits);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::groupPrefetchJoinProbe(
+    HashLookup& lookup,
+    int32_t partitionBits) {
+  // Counting sort of the rows by the high bits of their bucket offset. Rows
+  // that go to the same part of the table are probed close in time, which
+  // keeps that part in cache and saves TLB misses and the page table walks
+  // that come with them.
+  VELOX_DCHECK_LE(partitionBits, kMaxProbePartitionBits);
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  const int32_t tableBits = 64 - __builtin_clzll(sizeMask_);
+  partitionBits = std::min(partitionBits, tableBits);
+  const int32_t regionShift = tableBits - partitionBits;
+  int32_t regionStarts[(1 << kMaxProbePartitionBits) + 1];
+  const int32_t numRegions = 1 << partitionBits;
+  std::fill(regionStarts, regionStarts + numRegions + 1, 0);
+  for (auto i = 0; i < numProbes; ++i) {
+    ++regionStarts[(bucketOffset(hashes[rows[i]]) >> regionShift) + 1];
+  }
+  for (auto i = 1; i <= numRegions; ++i) {
+    regionStarts[i] += regionStarts[i - 1];
+  }
+  lookup.probeOrder.resize(numProbes);
+  vector_size_t* probeOrder = lookup.probeOrder.data();
+  for (auto i = 0; i < numProbes; ++i) {
+    const auto row = rows[i];
+    probeOrder[regionStarts[bucketOffset(hashes[row]) >> regionShift]++] = row;
+  }
+
+  // Each step of a group of 'kPrefetchSize' probes touches memory that the
+  // previous step prefetched: The buckets, then the first row with a
+  // matching tag.
+  ProbeState states[kPrefetchSize];
+  int32_t probeIndex = 0;
+  for (; probeIndex + kPrefetchSize <= numProbes; probeIndex += kPrefetchSize) {
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      const auto row = probeOrder[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    const auto row = probeOrder[probeIndex];
+    states[0].preProbe(*this, hashes[row], row);
+    states[0].firstProbe(*this, 0);
+    fullProbe<true>(lookup, states[0], false);
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -750,6 +892,7 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
   }
   numDistinct_ = 0;
   numTombstones_ = 0;
+  numHotKeys_ = 0;
 }
 
 template <bool ignoreNullKeys>
@@ -804,6 +947,12 @@ bool HashTable<ignoreNullKeys>::hashRows(
     }
     return true;
   }
+  if (hashMode_ == HashMode::kHash && keyRowSize_ > 0) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      hashes[i] = hashKeyRow(rows[i]);
+    }
+    return true;
+  }
 
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
@@ -1176,6 +1325,7 @@ bool HashTable<ignoreNullKeys>::arrayPushRow(
     if (nextOffset_ > 0) {
       hasDuplicates_ = true;
       rows->appendNextRow(existingRow, row, allocator);
+      countHotKey(rows, existingRow);
     }
     return false;
   }
@@ -1192,6 +1342,14 @@ void HashTable<ignoreNullKeys>::pushNext(
   VELOX_CHECK_GT(nextOffset_, 0);
   hasDuplicates_ = true;
   rows->appendNextRow(row, next, allocator);
+  countHotKey(rows, row);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::countHotKey(RowContainer* rows, char* row) {
+  if (rows->getNextRowVector(row)->size() == kHotKeyMinRows) {
+    ++numHotKeys_;
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -1329,6 +1487,8 @@ void HashTable<ignoreNullKeys>::rehash(
     bool initNormalizedKeys,
     int8_t spillInputStartPartitionBit) {
   ++numRehashes_;
+  // All rows are inserted again.
+  numHotKeys_ = 0;
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
@@ -1819,21 +1979,6 @@ inline uint64_t HashTable<ignoreNullKeys>::joinProjectedVarColumnsSize(
   return totalBytes;
 }
 
-template <bool ignoreNullKeys>
-inline uint64_t HashTable<ignoreNullKeys>::joinProjectedVarColumnsSize(
-    const std::vector<vector_size_t>& columns,
-    NextRowVector*& rows) const {
-  uint64_t totalBytes{0};
-  for (const auto& column : columns) {
-    if (!rows_->columnTypes()[column]->isFixedWidth()) {
-      for (const auto* row : *rows) {
-        totalBytes += rows_->variableSizeAt(row, column);
-      }
-    }
-  }
-  return totalBytes;
-}
-
 template <bool ignoreNullKeys>
 int32_t HashTable<ignoreNullKeys>::listJoinResults(
     JoinResultIterator& iter,
@@ -1880,24 +2025,34 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
           : (joinProjectedVarColumnsSize(iter.varSizeListColumns, hit) +
              iter.fixedSizeListColumnsSizeSum);
     } else {
+      // The rows of a key are listed in batches within 'maxBytes', so that a
+      // hot key with many rows does not make an oversized output.
       const auto numRows = rows->size();
       auto num =
           std::min(numRows - iter.lastDuplicateRowIndex, maxOut - numOut);
-      std::fill_n(inputRows.begin() + numOut, num, row);
-      std::memcpy(
-          hits.data() + numOut,
-          rows->data() + iter.lastDuplicateRowIndex,
-          num * sizeof(char*));
-      iter.lastDuplicateRowIndex += num;
-      numOut += num;
+      const auto* duplicates = rows->data() + iter.lastDuplicateRowIndex;
       if (iter.estimatedRowSize.has_value()) {
-        totalBytes += iter.estimatedRowSize.value() * numRows;
+        const auto rowSize = iter.estimatedRowSize.value();
+        if (rowSize > 0) {
+          num = std::min<size_t>(
+              num, std::max<uint64_t>(1, (maxBytes - totalBytes) / rowSize));
+        }
+        totalBytes += rowSize * num;
       } else {
-        totalBytes +=
-            joinProjectedVarColumnsSize(iter.varSizeListColumns, rows);
-        totalBytes += (iter.fixedSizeListColumnsSizeSum * rows->size());
-        totalBytes += (iter.fixedSizeListColumnsSizeSum * numRows);
+        for (size_t i = 0; i < num; ++i) {
+          const auto* duplicate = duplicates[i];
+          totalBytes += iter.fixedSizeListColumnsSizeSum +
+              joinProjectedVarColumnsSize(iter.varSizeListColumns, duplicate);
+          if (totalBytes >= maxBytes) {
+            num = i + 1;
+            break;
+          }
+        }
       }
+      std::fill_n(inputRows.begin() + numOut, num, row);
+      std::memcpy(hits.data() + numOut, duplicates, num * sizeof(char*));
+      iter.lastDuplicateRowIndex += num;
+      numOut += num;
       if (iter.lastDuplicateRowIndex >= numRows) {
         iter.lastDuplicateRowIndex = 0;
         iter.lastRowIndex++;
@@ -2093,6 +2248,13 @@ void HashTable<ignoreNullKeys>::erase(folly::Range<char**> rows) {
   auto numRows = rows.size();
   raw_vector<uint64_t> hashes;
   hashes.resize(numRows);
+  if (hashMode_ == HashMode::kHash && keyRowSize_ > 0) {
+    for (auto i = 0; i < numRows; ++i) {
+      hashes[i] = hashKeyRow(rows[i]);
+    }
+    eraseWithHashes(rows, hashes.data());
+    return;
+  }
 
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
@@ -2263,6 +2425,49 @@ void HashTable<ignoreNullKeys>::prepareForGroupProbe(
   populateLookupRows(rows, lookup.rows);
 }
 
+namespace {
+template <TypeKind Kind>
+void storeKeyRowColumn(
+    const DecodedVector& decoded,
+    const raw_vector<vector_size_t>& rows,
+    int32_t offset,
+    int32_t keyRowSize,
+    char* keyRows) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  for (const auto row : rows) {
+    const T value = decoded.valueAt<T>(row);
+    memcpy(
+        keyRows + static_cast<int64_t>(row) * keyRowSize + offset,
+        &value,
+        sizeof(T));
+  }
+}
+} // namespace
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::hashProbeKeyRows(HashLookup& lookup) {
+  if (lookup.rows.empty()) {
+    return;
+  }
+  lookup.keyRows.resize(
+      static_cast<int64_t>(lookup.rows.back() + 1) * keyRowSize_);
+  auto* keyRows = lookup.keyRows.data();
+  for (auto i = 0; i < lookup.hashers.size(); ++i) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        storeKeyRowColumn,
+        hashers_[i]->typeKind(),
+        lookup.hashers[i]->decodedVector(),
+        lookup.rows,
+        rows_->columnAt(i).offset(),
+        keyRowSize_,
+        keyRows);
+  }
+  for (const auto row : lookup.rows) {
+    lookup.hashes[row] =
+        hashKeyRow(keyRows + static_cast<int64_t>(row) * keyRowSize_);
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::prepareForJoinProbe(
     HashLookup& lookup,
@@ -2284,6 +2489,11 @@ void HashTable<ignoreNullKeys>::prepareForJoinProbe(
   lookup.reset(rows.end());
 
   const auto mode = hashMode();
+  if (mode == BaseHashTable::HashMode::kHash && keyRowSize_ > 0) {
+    populateLookupRows(rows, lookup.rows);
+    hashProbeKeyRows(lookup);
+    return;
+  }
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
     if (mode != BaseHashTable::HashMode::kHash) {
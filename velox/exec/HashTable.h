@@ -62,7 +62,9 @@ struct HashLookup {
         rows(raw_vector<vector_size_t>(pool)),
         hashes(raw_vector<uint64_t>(pool)),
         hits(raw_vector<char*>(pool)),
-        normalizedKeys(raw_vector<uint64_t>(pool)) {}
+        normalizedKeys(raw_vector<uint64_t>(pool)),
+        probeOrder(raw_vector<vector_size_t>(pool)),
+        keyRows(raw_vector<char>(pool)) {}
 
   void reset(vector_size_t size) {
     rows.resize(size);
@@ -101,6 +103,15 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch for joinProbe of large tables. 'rows' in the order of their
+  /// position in the table.
+  raw_vector<vector_size_t> probeOrder;
+
+  /// If the table compares keys as rows, the keys of each row of the probe
+  /// input laid out like the keys of the table rows. The key row of row 'i'
+  /// starts at i * HashTable::keyRowSize(). Populated by prepareForJoinProbe.
+  raw_vector<char> keyRows;
 };
 
 struct HashTableStats {
@@ -109,6 +120,15 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Number of join build keys with at least BaseHashTable::kHotKeyMinRows
+  /// rows.
+  int64_t numHotKeys{0};
+  /// Bytes of the table of row pointers and tags.
+  int64_t tableBytes{0};
+  /// Bytes of the fixed-width parts of the rows.
+  int64_t rowBytes{0};
+  /// Bytes retained for the variable-width keys, dependents and accumulators.
+  int64_t stringBytes{0};
 };
 
 class BaseHashTable {
@@ -135,6 +155,15 @@ class BaseHashTable {
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kNumHotKeys{"hashtable.numHotKeys"};
+  static inline const std::string kTableBytes{"hashtable.tableBytes"};
+  static inline const std::string kRowBytes{"hashtable.rowBytes"};
+  static inline const std::string kStringBytes{"hashtable.stringBytes"};
+
+  /// A join build key with at least this many rows is a hot key. The rows of
+  /// a key are kept in a dense array and listed in batches by
+  /// listJoinResults().
+  static constexpr int32_t kHotKeyMinRows = 10'000;
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
@@ -231,6 +260,23 @@ class BaseHashTable {
   /// join probe. Use listJoinResults to iterate over the results.
   virtual void joinProbe(HashLookup& lookup) = 0;
 
+  /// If 'enabled', joinProbe partitions its input by the high bits of the
+  /// bucket offset, the same bits that assign rows to partitions in a
+  /// parallel join build, so that each partition probes a range of the table
+  /// of about 'partitionBytes'. 'partitionBytes' should be about the size of
+  /// the per core cache. Applies only to tables that are several times that
+  /// size.
+  virtual void setJoinProbePartitioning(
+      bool enabled,
+      uint64_t partitionBytes) = 0;
+
+  /// If this is a join table with at least 'minKeys' keys and all keys are of
+  /// types whose values are equal if and only if their bytes are equal, hashes
+  /// and compares the keys in hash mode as one row of bytes instead of column
+  /// by column. The probe keys are laid out as such rows by
+  /// prepareForJoinProbe. Must be called before adding rows. 0 disables.
+  virtual void setJoinKeyRows(int32_t minKeys) = 0;
+
   /// Populates 'hashes' and 'rows' fields in 'lookup' in preparation for
   /// 'joinProbe' call. If hash mode is not kHash, populates 'hashes' with
   /// values IDs. Rows which do not have value IDs are removed from 'rows'
@@ -512,6 +558,33 @@ class HashTable : public BaseHashTable {
 
   void joinProbe(HashLookup& lookup) override;
 
+  /// Join tables with at least this many bytes of buckets are probed with
+  /// many rows in flight. Such tables are much larger than the CPU caches and
+  /// the probe is bound by the latency of memory.
+  static constexpr uint64_t kDefaultGroupPrefetchProbeMinBytes = 64 << 20;
+
+  void setGroupPrefetchProbeMinBytes(uint64_t bytes) {
+    groupPrefetchProbeMinBytes_ = bytes;
+  }
+
+  /// Max number of partitions of the probe input is 1 << this.
+  static constexpr int32_t kMaxProbePartitionBits = 12;
+
+  void setJoinProbePartitioning(bool enabled, uint64_t partitionBytes)
+      override {
+    VELOX_CHECK_GT(partitionBytes, 0);
+    probePartitioning_ = enabled;
+    probePartitionBytes_ = partitionBytes;
+  }
+
+  void setJoinKeyRows(int32_t minKeys) override;
+
+  /// Returns the number of bytes of key in a table row if the keys are hashed
+  /// and compared as rows, 0 otherwise. See setJoinKeyRows().
+  int32_t keyRowSize() const {
+    return keyRowSize_;
+  }
+
   int32_t listJoinResults(
       JoinResultIterator& iter,
       bool includeMisses,
@@ -565,7 +638,14 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        numHotKeys_,
+        static_cast<int64_t>(sizeof(char*) * capacity_),
+        static_cast<int64_t>(rows_->rowBytes()),
+        static_cast<int64_t>(rows_->stringBytes())};
   }
 
   bool hasDuplicateKeys() const override {
@@ -892,6 +972,15 @@ class HashTable : public BaseHashTable {
 
   bool compareKeys(const char* group, const char* inserted);
 
+  // Returns the hash of the 'keyRowSize_' bytes of keys at 'keyRow'.
+  uint64_t hashKeyRow(const char* keyRow) const {
+    return bits::hashMix(bits::hashBytes(1, keyRow, keyRowSize_), keyRowSize_);
+  }
+
+  // Lays out the keys of 'lookup.rows' as key rows in 'lookup.keyRows' and
+  // sets their hashes in 'lookup.hashes'.
+  void hashProbeKeyRows(HashLookup& lookup);
+
   template <bool isJoin, bool isNormalizedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
@@ -904,6 +993,17 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns the number of bits of bucket offset that partition the probe
+  // input for 'probePartitionBytes_' of table per partition, 0 if the probe
+  // input is not to be partitioned.
+  int32_t probePartitionBits() const;
+
+  // Probe for tables of at least 'groupPrefetchProbeMinBytes_' or with a
+  // partitioned probe. Orders the rows by the top 'partitionBits' of their
+  // bucket offset and probes them in groups of many rows so that as many
+  // cache misses are outstanding at the same time.
+  void groupPrefetchJoinProbe(HashLookup& lookup, int32_t partitionBits);
+
   // Returns the total size of the variable size 'columns' in 'row'.
   // NOTE: No checks are done in the method for performance considerations.
   // Caller needs to make sure only variable size columns are inside of
@@ -912,13 +1012,6 @@ class HashTable : public BaseHashTable {
       const std::vector<vector_size_t>& columns,
       const char* row) const;
 
-  // The exact same as joinProjectedVarColumnsSize(const
-  // std::vector<vector_size_t>&, const char*) with the exception that this
-  // function takes in vector of rows instead of an individual row.
-  inline uint64_t joinProjectedVarColumnsSize(
-      const std::vector<vector_size_t>& columns,
-      NextRowVector*& rows) const;
-
   // Adds a row to a hash join table in kArray hash mode. Returns true if a new
   // entry was made and false if the row was added to an existing set of rows
   // with the same key. 'allocator' is provided for duplicate row vector
@@ -939,6 +1032,10 @@ class HashTable : public BaseHashTable {
       char* next,
       HashStringAllocator* allocator);
 
+  // Counts the key of 'row' as hot if this is the duplicate that makes it
+  // reach kHotKeyMinRows rows.
+  void countHotKey(RowContainer* rows, char* row);
+
   // Finishes inserting an entry into a join hash table. If 'partitionInfo' is
   // not null and the insert falls out-side of the partition range, then insert
   // is not made but row is instead added to 'overflow' in 'partitionInfo'
@@ -1045,6 +1142,15 @@ class HashTable : public BaseHashTable {
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
+  uint64_t groupPrefetchProbeMinBytes_{kDefaultGroupPrefetchProbeMinBytes};
+  // See setJoinProbePartitioning().
+  bool probePartitioning_{false};
+  uint64_t probePartitionBytes_{1 << 20};
+
+  // Number of bytes of the keys at the start of a row if the keys are hashed
+  // and compared as a row. See setJoinKeyRows().
+  int32_t keyRowSize_{0};
+
   // Set at join build time if the table has duplicates, meaning that
   // the join can be cardinality increasing. Atomic for tsan because
   // many threads can set this.
@@ -1071,6 +1177,9 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Counts the join build keys with at least kHotKeyMinRows rows. Atomic
+  // because of parallel join build.
+  std::atomic<int64_t> numHotKeys_{0};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -29,30 +29,35 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    // A consumer has decreased the usage below the limit meanwhile.
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
-  std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasPromises_) {
+    return {};
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ >= maxBufferSize_) {
+    return {};
   }
-  return promises;
+  hasPromises_ = false;
+  return std::move(promises_);
 }
 
 void LocalExchangeVectorPool::push(const RowVectorPtr& vector, int64_t size) {
@@ -105,18 +110,12 @@ BlockingReason LocalExchangeQueue::enqueue(
     int64_t inputBytes,
     ContinueFuture* future) {
   std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
     queue.emplace(std::move(input), inputBytes);
     consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
     return false;
   });
 
@@ -126,7 +125,10 @@ BlockingReason LocalExchangeQueue::enqueue(
 
   notify(consumerPromises);
 
-  if (blockedOnConsumer) {
+  // The memory manager is shared by all the queues. It is updated outside of
+  // the lock of this queue. A consumer may take the data and decrease the
+  // usage before it is increased here.
+  if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
     return BlockingReason::kWaitForConsumer;
   }
 
@@ -150,7 +152,6 @@ BlockingReason LocalExchangeQueue::next(
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
   int64_t size;
-  std::vector<ContinuePromise> memoryPromises;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -166,13 +167,11 @@ BlockingReason LocalExchangeQueue::next(
 
     std::tie(*data, size) = std::move(queue.front());
     queue.pop();
-
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
   if (*data != nullptr) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(size);
+    notify(memoryPromises);
     vectorPool_->push(*data, size);
   }
   return blockingReason;
@@ -202,20 +201,18 @@ bool LocalExchangeQueue::testingProducersDone() const {
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
+  uint64_t freedBytes = 0;
   queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
     while (!queue.empty()) {
       freedBytes += queue.front().second;
       queue.pop();
     }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
     consumerPromises = std::move(consumerPromises_);
     closed_ = true;
   });
+  if (freedBytes) {
+    memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+  }
   notify(consumerPromises);
   notify(memoryPromises);
 }
@@ -283,7 +280,13 @@ LocalPartition::LocalPartition(
           numPartitions_ == 1 ? nullptr
                               : planNode->partitionFunctionSpec().create(
                                     numPartitions_,
-                                    /*localExchange=*/true)) {
+                                    /*localExchange=*/true)),
+      partitionBatching_{
+          ctx->queryConfig().localExchangePartitionBatchingEnabled()},
+      maxBatchRows_{
+          static_cast<vector_size_t>(
+              ctx->queryConfig().preferredOutputBatchRows())},
+      maxBatchBytes_{ctx->queryConfig().preferredOutputBatchBytes()} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -293,6 +296,9 @@ LocalPartition::LocalPartition(
     indexBuffers_.resize(numPartitions_);
     rawIndices_.resize(numPartitions_);
   }
+  if (partitionBatching_) {
+    partitionBatches_.resize(numPartitions_);
+  }
 }
 
 void LocalPartition::allocateIndexBuffers(
@@ -359,13 +365,12 @@ void LocalPartition::addInput(RowVectorPtr input) {
       ? 0
       : partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason = queues_[singlePartition.value()]->enqueue(
-        input, input->retainedSize(), &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
+    if (partitionBatching_) {
+      // Keeps the order of the rows of the partition.
+      flushPartitionBatch(singlePartition.value());
     }
+    const auto inputBytes = input->retainedSize();
+    enqueue(singlePartition.value(), std::move(input), inputBytes);
     return;
   }
 
@@ -383,6 +388,15 @@ void LocalPartition::addInput(RowVectorPtr input) {
     ++maxIndex[partition];
   }
 
+  if (partitionBatching_) {
+    for (auto i = 0; i < numPartitions_; i++) {
+      if (maxIndex[i] != 0) {
+        appendToPartitionBatch(i, input, rawIndices_[i], maxIndex[i]);
+      }
+    }
+    return;
+  }
+
   const int64_t totalSize = input->retainedSize();
   for (auto i = 0; i < numPartitions_; i++) {
     auto partitionSize = maxIndex[i];
@@ -392,14 +406,68 @@ void LocalPartition::addInput(RowVectorPtr input) {
     }
     auto partitionData = wrapChildren(
         input, partitionSize, indexBuffers_[i], queues_[i]->getVector());
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(
-        partitionData, totalSize * partitionSize / numInput, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
+    enqueue(i, std::move(partitionData), totalSize * partitionSize / numInput);
+  }
+}
+
+void LocalPartition::enqueue(
+    uint32_t partition,
+    RowVectorPtr data,
+    int64_t bytes) {
+  ContinueFuture future;
+  auto reason = queues_[partition]->enqueue(std::move(data), bytes, &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
+  }
+}
+
+void LocalPartition::appendToPartitionBatch(
+    uint32_t partition,
+    const RowVectorPtr& input,
+    const vector_size_t* indices,
+    vector_size_t numRows) {
+  auto& batch = partitionBatches_[partition];
+  if (batch == nullptr) {
+    // Reuses a batch consumed from the queue of 'partition' if any.
+    VectorPtr reusable = queues_[partition]->getVector();
+    if (reusable != nullptr) {
+      BaseVector::prepareForReuse(reusable, 0);
+      batch = std::static_pointer_cast<RowVector>(reusable);
+    } else {
+      batch = BaseVector::create<RowVector>(input->type(), 0, pool());
     }
   }
+
+  // Coalesces the runs of consecutive rows into one range each.
+  const auto offset = batch->size();
+  copyRanges_.clear();
+  for (auto i = 0; i < numRows; ++i) {
+    if (!copyRanges_.empty() &&
+        copyRanges_.back().sourceIndex + copyRanges_.back().count ==
+            indices[i]) {
+      ++copyRanges_.back().count;
+    } else {
+      copyRanges_.push_back({indices[i], offset + i, 1});
+    }
+  }
+  batch->resize(offset + numRows);
+  batch->copyRanges(input.get(), copyRanges_);
+
+  if (batch->size() >= maxBatchRows_ ||
+      batch->estimateFlatSize() >= maxBatchBytes_) {
+    flushPartitionBatch(partition);
+  }
+}
+
+void LocalPartition::flushPartitionBatch(uint32_t partition) {
+  auto& batch = partitionBatches_[partition];
+  if (batch == nullptr || batch->size() == 0) {
+    return;
+  }
+  const auto batchBytes = batch->retainedSize();
+  enqueue(partition, std::move(batch), batchBytes);
+  batch = nullptr;
 }
 
 void LocalPartition::prepareForInput(RowVectorPtr& input) {
@@ -429,6 +497,11 @@ BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
 
 void LocalPartition::noMoreInput() {
   Operator::noMoreInput();
+  if (partitionBatching_) {
+    for (auto i = 0; i < numPartitions_; ++i) {
+      flushPartitionBatch(i);
+    }
+  }
   for (const auto& queue : queues_) {
     queue->noMoreData();
   }
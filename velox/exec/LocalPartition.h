@@ -21,7 +21,9 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The producers and consumers of all the queues update
+/// the size, so it is an atomic and the mutex is only taken to block or
+/// unblock the producers at the limit.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -48,8 +50,12 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic_int64_t bufferedBytes_{0};
+  // True if 'promises_' may not be empty. Set before 'bufferedBytes_' is
+  // checked under 'mutex_' so that a concurrent decrease either sees it or
+  // its decrease is seen by the check.
+  std::atomic_bool hasPromises_{false};
   std::mutex mutex_;
-  tsan_atomic<int64_t> bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -187,6 +193,13 @@ class LocalExchange : public SourceOperator {
 
 /// Hash partitions the data using specified keys. The number of partitions is
 /// determined by the number of LocalExchangeQueues(s) found in the task.
+///
+/// By default, every input vector is enqueued to every partition as a
+/// dictionary over the rows of the partition. If
+/// QueryConfig::localExchangePartitionBatchingEnabled() is set, the rows of
+/// each partition are instead copied into a flat batch across several input
+/// vectors. The batch is enqueued when it reaches the preferred output batch
+/// size, with its own retained size as the buffered size.
 class LocalPartition : public Operator {
  public:
   LocalPartition(
@@ -227,9 +240,28 @@ class LocalPartition : public Operator {
       const BufferPtr& indices,
       RowVectorPtr reusable);
 
+  /// Enqueues 'data' of 'bytes' to the queue of 'partition' and records the
+  /// future to wait for if the queue is full.
+  void enqueue(uint32_t partition, RowVectorPtr data, int64_t bytes);
+
+  /// Copies the 'numRows' rows of 'input' at 'indices' to the batch of
+  /// 'partition' and enqueues the batch if it has reached the preferred output
+  /// batch size.
+  void appendToPartitionBatch(
+      uint32_t partition,
+      const RowVectorPtr& input,
+      const vector_size_t* indices,
+      vector_size_t numRows);
+
+  /// Enqueues the batch of 'partition' if it is not empty.
+  void flushPartitionBatch(uint32_t partition);
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  const bool partitionBatching_;
+  const vector_size_t maxBatchRows_;
+  const uint64_t maxBatchBytes_;
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
@@ -239,6 +271,10 @@ class LocalPartition : public Operator {
   /// Reusable buffers for input partitioning.
   std::vector<BufferPtr> indexBuffers_;
   std::vector<vector_size_t*> rawIndices_;
+  /// The row batches of the partitions if 'partitionBatching_' is set.
+  std::vector<RowVectorPtr> partitionBatches_;
+  /// Reusable memory for copying rows into 'partitionBatches_'.
+  std::vector<BaseVector::CopyRange> copyRanges_;
 };
 
 } // namespace facebook::velox::exec
@@ -23,6 +23,7 @@
 #include "velox/exec/Expand.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/exec/GroupId.h"
+#include "velox/exec/GroupingSetsAggregation.h"
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashProbe.h"
@@ -525,6 +526,20 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto joinNode =
             std::dynamic_pointer_cast<const core::HashJoinNode>(planNode)) {
+      std::shared_ptr<const core::FilterNode> filterNode;
+      if (i < planNodes.size() - 1 &&
+          HashProbe::canFuseFilter(*joinNode, ctx->queryConfig())) {
+        filterNode =
+            std::dynamic_pointer_cast<const core::FilterNode>(planNodes[i + 1]);
+      }
+      if (filterNode != nullptr) {
+        // A ProjectNode after the FilterNode makes a FilterProject without a
+        // filter.
+        operators.push_back(std::make_unique<HashProbe>(
+            id, ctx.get(), joinNode, filterNode->filter()));
+        i++;
+        continue;
+      }
       operators.push_back(std::make_unique<HashProbe>(id, ctx.get(), joinNode));
     } else if (
         auto joinNode =
@@ -555,6 +570,19 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto groupIdNode =
             std::dynamic_pointer_cast<const core::GroupIdNode>(planNode)) {
+      if (i < planNodes.size() - 1) {
+        auto aggregationNode =
+            std::dynamic_pointer_cast<const core::AggregationNode>(
+                planNodes[i + 1]);
+        if (aggregationNode != nullptr &&
+            GroupingSetsAggregation::canFuse(
+                *groupIdNode, *aggregationNode, ctx->queryConfig())) {
+          operators.push_back(std::make_unique<GroupingSetsAggregation>(
+              id, ctx.get(), groupIdNode, aggregationNode));
+          i++;
+          continue;
+        }
+      }
       operators.push_back(
           std::make_unique<GroupId>(id, ctx.get(), groupIdNode));
     } else if (
@@ -746,6 +774,16 @@ std::vector<core::PlanNodeId> DriverFactory::needsNestedLoopJoinBridges()
   return planNodeIds;
 }
 
+std::vector<core::PlanNodeId> DriverFactory::needsTopNThresholds() const {
+  std::vector<core::PlanNodeId> planNodeIds;
+  for (const auto& planNode : planNodes) {
+    if (std::dynamic_pointer_cast<const core::TopNNode>(planNode)) {
+      planNodeIds.emplace_back(planNode->id());
+    }
+  }
+  return planNodeIds;
+}
+
 // static
 void DriverFactory::registerAdapter(DriverAdapter adapter) {
   adapters.push_back(std::move(adapter));
@@ -43,17 +43,28 @@ MarkDistinct::MarkDistinct(
   // We will use result[0] for distinct mask output.
   resultProjections_.emplace_back(0, inputType->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  if (planNode->preGrouped()) {
+    std::vector<column_index_t> keyChannels;
+    for (const auto& key : planNode->distinctKeys()) {
+      keyChannels.push_back(exprToChannel(key.get(), inputType));
+    }
+    groupStartFinder_ = std::make_unique<GroupStartFinder>(
+        inputType, std::move(keyChannels), pool());
+  } else {
+    groupingSet_ = GroupingSet::createForMarkDistinct(
+        inputType,
+        createVectorHashers(inputType, planNode->distinctKeys()),
+        operatorCtx_.get(),
+        &nonReclaimableSection_);
+  }
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  if (groupingSet_ != nullptr) {
+    groupingSet_->addInput(input, false /*mayPushdown*/);
+  }
 
   input_ = std::move(input);
 }
@@ -65,12 +76,7 @@ RowVectorPtr MarkDistinct::getOutput() {
 
   auto outputSize = input_->size();
   // Re-use memory for the ID vector if possible.
-  VectorPtr& result = results_[0];
-  if (result && result.use_count() == 1) {
-    BaseVector::prepareForReuse(result, outputSize);
-  } else {
-    result = BaseVector::create(BOOLEAN(), outputSize, operatorCtx_->pool());
-  }
+  prepareOutputVector(results_[0], BOOLEAN(), outputSize);
 
   // newGroups contains the indices of distinct rows.
   // For each index in newGroups, we mark the index'th bit true in the result
@@ -78,9 +84,14 @@ RowVectorPtr MarkDistinct::getOutput() {
   auto resultBits =
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
-  bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
-    bits::setBit(resultBits, i, true);
+  if (groupStartFinder_ != nullptr) {
+    // The first row of each group of equal keys is distinct.
+    groupStartFinder_->find(*input_, resultBits);
+  } else {
+    bits::fillBits(resultBits, 0, outputSize, false);
+    for (const auto i : groupingSet_->hashLookup().newGroups) {
+      bits::setBit(resultBits, i, true);
+    }
   }
   auto output = fillOutput(outputSize, nullptr);
 
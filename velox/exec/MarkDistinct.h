@@ -18,6 +18,7 @@
 
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 
@@ -49,5 +50,9 @@ class MarkDistinct : public Operator {
  private:
   // TODO: Document spilling configuration in spilling.rst.
   std::unique_ptr<GroupingSet> groupingSet_;
+
+  // Finds the distinct rows instead of 'groupingSet_' if the input is grouped
+  // on the distinct keys.
+  std::unique_ptr<GroupStartFinder> groupStartFinder_;
 };
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 #include "velox/exec/Merge.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
+#include "velox/vector/EncodedVectorCopy.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -33,6 +34,12 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   return options;
 }
+
+// Returns true if 'vector' is wrapped in a dictionary or is a constant.
+bool isEncoded(const BaseVector& vector) {
+  return VectorEncoding::isDictionary(vector.encoding()) ||
+      VectorEncoding::isConstant(vector.encoding());
+}
 } // namespace
 
 Merge::Merge(
@@ -237,13 +244,36 @@ void SourceStream::copyToOutput(RowVectorPtr& output) {
     return;
   }
 
+  // The source rows are consecutive. The output rows are consecutive as long
+  // as no other stream wins in between.
   vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
+  copyRanges_.clear();
+  outputRows_.applyToSelected([&](auto row) {
+    if (!copyRanges_.empty() &&
+        copyRanges_.back().targetIndex + copyRanges_.back().count == row) {
+      ++copyRanges_.back().count;
+    } else {
+      copyRanges_.push_back({sourceRow, row, 1});
+    }
+    ++sourceRow;
+  });
 
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    auto& target = output->childAt(i);
+    const auto& source = data_->childAt(i);
+    // Dictionary and constant encoded columns are copied with their encoding,
+    // so that e.g. a dictionary over complex values does not get flattened.
+    // Once a column of 'output' is encoded, the next batches are added to it
+    // the same way.
+    if (!isEncoded(*source) && !isEncoded(*target)) {
+      target->copyRanges(source.get(), copyRanges_);
+    } else {
+      encodedVectorCopy(
+          {.pool = output->pool(), .reuseSource = false},
+          source,
+          copyRanges_,
+          target);
+    }
   }
 
   outputRows_.clearAll();
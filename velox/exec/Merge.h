@@ -90,8 +90,7 @@ class SourceStream final : public MergeStream {
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+        outputRows_(outputBatchSize, false) {
     keyColumns_.reserve(sortingKeys.size());
   }
 
@@ -163,8 +162,9 @@ class SourceStream final : public MergeStream {
   /// Output row numbers for source rows that haven't been copied out yet.
   SelectivityVector outputRows_;
 
-  /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  /// Runs of consecutive output rows that come from consecutive source rows,
+  /// copied as one range per column. Reusable memory.
+  std::vector<BaseVector::CopyRange> copyRanges_;
 };
 
 // LocalMerge merges its source's output into a single stream of
@@ -236,6 +236,76 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+// static
+vector_size_t MergeJoin::gallop(
+    const std::vector<column_index_t>& keys,
+    const RowVectorPtr& batch,
+    vector_size_t row,
+    const std::vector<column_index_t>& otherKeys,
+    const RowVectorPtr& otherBatch,
+    vector_size_t otherIndex) {
+  const auto isBefore = [&](vector_size_t index) {
+    for (auto key : keys) {
+      if (batch->childAt(key)->isNullAt(index)) {
+        return false;
+      }
+    }
+    return compare(keys, batch, index, otherKeys, otherBatch, otherIndex) < 0;
+  };
+
+  // 'before' sorts before the other row. 'notBefore' is the first row known
+  // not to.
+  auto before = row;
+  vector_size_t notBefore = batch->size();
+  for (vector_size_t step = 1; step < notBefore - before; step *= 2) {
+    if (!isBefore(before + step)) {
+      notBefore = before + step;
+      break;
+    }
+    before += step;
+  }
+  while (notBefore - before > 1) {
+    const auto middle = before + (notBefore - before) / 2;
+    if (isBefore(middle)) {
+      before = middle;
+    } else {
+      notBefore = middle;
+    }
+  }
+  return notBefore;
+}
+
+void MergeJoin::pushdownLeftKeyLowerBound() {
+  const auto leftChannel = leftKeyChannels_[0];
+  const auto& rightKey = rightInput_->childAt(rightKeyChannels_[0]);
+  if (!canPushdownLeftKeyLowerBound_.has_value()) {
+    const auto& leftKeyType = input_->childAt(leftChannel)->type();
+    canPushdownLeftKeyLowerBound_ = canMakeCutoffFilter(leftKeyType) &&
+        leftKeyType->equivalent(*rightKey->type()) &&
+        !operatorCtx_->driver()->canPushdownFilters(this, {leftChannel})
+             .empty();
+  }
+  if (!canPushdownLeftKeyLowerBound_.value() ||
+      rightKey->isNullAt(rightRowIndex_)) {
+    return;
+  }
+
+  if (leftKeyLowerBound_ == nullptr) {
+    leftKeyLowerBound_ = BaseVector::create(rightKey->type(), 1, pool());
+  } else if (leftKeyLowerBound_->equalValueAt(
+                 rightKey.get(), 0, rightRowIndex_)) {
+    return;
+  }
+  leftKeyLowerBound_->copy(rightKey.get(), 0, rightRowIndex_, 1);
+
+  // Passes the values that sort after the bound in ascending order or are
+  // equal to it. Null keys never match.
+  static const CompareFlags kLowerBoundFlags{
+      .nullsFirst = false, .ascending = false};
+  dynamicFilters_[leftChannel] =
+      makeCutoffFilter(*leftKeyLowerBound_, 0, kLowerBoundFlags);
+}
+
 bool MergeJoin::findEndOfMatch(
     const RowVectorPtr& input,
     const std::vector<column_index_t>& keys,
@@ -1079,8 +1149,19 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
       } else {
-        leftRowIndex_ =
-            firstNonNull(input_, leftKeyChannels_, leftRowIndex_ + 1);
+        // The left rows without a match are not part of the output.
+        const auto nextRow = gallop(
+            leftKeyChannels_,
+            input_,
+            leftRowIndex_,
+            rightKeyChannels_,
+            rightInput_,
+            rightRowIndex_);
+        numSkippedRows_ += nextRow - leftRowIndex_ - 1;
+        leftRowIndex_ = firstNonNull(input_, leftKeyChannels_, nextRow);
+        if (finishedLeftBatch()) {
+          pushdownLeftKeyLowerBound();
+        }
       }
 
       if (finishedLeftBatch()) {
@@ -1104,8 +1185,16 @@ RowVectorPtr MergeJoin::doGetOutput() {
           return std::move(output_);
         }
       } else {
-        rightRowIndex_ =
-            firstNonNull(rightInput_, rightKeyChannels_, rightRowIndex_ + 1);
+        // The right rows without a match are not part of the output.
+        const auto nextRow = gallop(
+            rightKeyChannels_,
+            rightInput_,
+            rightRowIndex_,
+            leftKeyChannels_,
+            input_,
+            leftRowIndex_);
+        numSkippedRows_ += nextRow - rightRowIndex_ - 1;
+        rightRowIndex_ = firstNonNull(rightInput_, rightKeyChannels_, nextRow);
       }
 
       if (finishedRightBatch()) {
@@ -65,9 +65,16 @@ class MergeJoin : public Operator {
     if (rightSource_) {
       rightSource_->close();
     }
+    if (numSkippedRows_ > 0) {
+      addRuntimeStat(kNumSkippedRows, RuntimeCounter(numSkippedRows_));
+    }
     Operator::close();
   }
 
+  /// Number of rows without a match that were skipped by exponential search
+  /// instead of being compared one by one.
+  static inline const std::string kNumSkippedRows{"numSkippedRows"};
+
  private:
   // Sets up 'filter_' and related member variables.
   void initializeFilter(
@@ -85,6 +92,28 @@ class MergeJoin : public Operator {
       const RowVectorPtr& otherBatch,
       vector_size_t otherIndex);
 
+  // Returns the first row after 'row' in 'batch' that does not sort before
+  // row 'otherIndex' of 'otherBatch'. 'row' itself must sort before it. Uses
+  // exponential search followed by binary search, so that a run of n rows
+  // without a match costs O(log(n)) comparisons. Rows with null keys are not
+  // ordered with respect to the others and stop the search. The caller
+  // continues from such a row one row at a time.
+  static vector_size_t gallop(
+      const std::vector<column_index_t>& keys,
+      const RowVectorPtr& batch,
+      vector_size_t row,
+      const std::vector<column_index_t>& otherKeys,
+      const RowVectorPtr& otherBatch,
+      vector_size_t otherIndex);
+
+  // Pushes the first key of the current right row as a lower bound on the
+  // first key of the left side into the left side source. The rows before it
+  // cannot have a match, so a scan of sorted files can skip the row groups
+  // between the matching keys. Called when the left side caught up with the
+  // right side without a match and only for joins that do not output the left
+  // rows without a match.
+  void pushdownLeftKeyLowerBound();
+
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
   int32_t compare() const {
     return compare(
@@ -550,5 +579,16 @@ class MergeJoin : public Operator {
 
   // True if all the right side data has been received.
   bool noMoreRightInput_{false};
+
+  // True if pushdownLeftKeyLowerBound() can install a filter on the left side
+  // source. Set on first use.
+  std::optional<bool> canPushdownLeftKeyLowerBound_;
+
+  // Single row vector with the last lower bound pushed by
+  // pushdownLeftKeyLowerBound(). nullptr if none was pushed.
+  VectorPtr leftKeyLowerBound_;
+
+  // Number of rows skipped by gallop() without comparing them.
+  uint64_t numSkippedRows_{0};
 };
 } // namespace facebook::velox::exec
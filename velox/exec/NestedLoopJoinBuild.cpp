@@ -18,12 +18,17 @@
 
 namespace facebook::velox::exec {
 
-void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+void NestedLoopJoinBridge::setData(
+    std::vector<RowVectorPtr> buildVectors,
+    std::vector<NestedLoopJoinRange::SortedKeys> sortedKeys) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
+    VELOX_CHECK(
+        sortedKeys.empty() || sortedKeys.size() == buildVectors.size());
     buildVectors_ = std::move(buildVectors);
+    sortedKeys_ = std::move(sortedKeys);
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -41,6 +46,13 @@ std::optional<std::vector<RowVectorPtr>> NestedLoopJoinBridge::dataOrFuture(
   return std::nullopt;
 }
 
+std::vector<NestedLoopJoinRange::SortedKeys>
+NestedLoopJoinBridge::sortedKeys() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(buildVectors_.has_value());
+  return sortedKeys_;
+}
+
 NestedLoopJoinBuild::NestedLoopJoinBuild(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -50,7 +62,8 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      range_(NestedLoopJoinRange::make(*joinNode)) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -139,10 +152,17 @@ void NestedLoopJoinBuild::noMoreInput() {
   }
 
   dataVectors_ = mergeDataVectors();
+  std::vector<NestedLoopJoinRange::SortedKeys> sortedKeys;
+  if (range_.has_value()) {
+    sortedKeys.reserve(dataVectors_.size());
+    for (const auto& vector : dataVectors_) {
+      sortedKeys.push_back(range_->sortKeys(vector, pool()));
+    }
+  }
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(std::move(dataVectors_), std::move(sortedKeys));
 }
 
 bool NestedLoopJoinBuild::isFinished() {
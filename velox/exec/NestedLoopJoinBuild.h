@@ -16,18 +16,28 @@
 #pragma once
 
 #include "velox/exec/JoinBridge.h"
+#include "velox/exec/NestedLoopJoinRange.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
 class NestedLoopJoinBridge : public JoinBridge {
  public:
-  void setData(std::vector<RowVectorPtr> buildVectors);
+  /// 'sortedKeys' has the sorted keys of each of 'buildVectors' if the join
+  /// condition has range form. Empty otherwise.
+  void setData(
+      std::vector<RowVectorPtr> buildVectors,
+      std::vector<NestedLoopJoinRange::SortedKeys> sortedKeys = {});
 
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the sorted keys of the build vectors. Must be called after
+  /// dataOrFuture() returned the build vectors.
+  std::vector<NestedLoopJoinRange::SortedKeys> sortedKeys();
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  std::vector<NestedLoopJoinRange::SortedKeys> sortedKeys_;
 };
 
 class NestedLoopJoinBuild : public Operator {
@@ -63,6 +73,10 @@ class NestedLoopJoinBuild : public Operator {
  private:
   std::vector<RowVectorPtr> dataVectors_;
 
+  // Set if the join condition has range form. The keys of the build vectors
+  // are then sorted before they are handed over to the probe side.
+  const std::optional<NestedLoopJoinRange> range_;
+
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
   ContinueFuture future_{ContinueFuture::makeEmpty()};
@@ -73,6 +73,7 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    initializeRange(NestedLoopJoinRange::make(*joinNode_));
   }
 
   joinNode_.reset();
@@ -122,6 +123,24 @@ void NestedLoopJoinProbe::initializeFilter(
   filterInputType_ = ROW(std::move(names), std::move(types));
 }
 
+void NestedLoopJoinProbe::initializeRange(
+    std::optional<NestedLoopJoinRange> range) {
+  if (!range.has_value()) {
+    return;
+  }
+  auto bounds = std::make_unique<ExprSet>(
+      range->boundExprs(), operatorCtx_->execCtx());
+  // The bounds are evaluated separately from the join condition, so they must
+  // give the same values.
+  for (const auto& expr : bounds->exprs()) {
+    if (!expr->isDeterministic()) {
+      return;
+    }
+  }
+  range_ = std::move(range);
+  rangeBounds_ = std::move(bounds);
+}
+
 BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case ProbeOperatorState::kRunning:
@@ -181,9 +200,25 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (input_->size() > 0) {
     probeSideEmpty_ = false;
   }
+  if (range_.has_value()) {
+    evaluateRangeBounds();
+  }
+  for (auto& tile : filterTiles_) {
+    tile.numProbeRows = 0;
+  }
   VELOX_CHECK_EQ(buildIndex_, 0);
 }
 
+void NestedLoopJoinProbe::evaluateRangeBounds() {
+  SelectivityVector rows(input_->size());
+  EvalCtx evalCtx(operatorCtx_->execCtx(), rangeBounds_.get(), input_.get());
+  rangeBounds_->eval(rows, evalCtx, rangeBoundValues_);
+  decodedRangeBounds_.resize(rangeBoundValues_.size());
+  for (auto i = 0; i < rangeBoundValues_.size(); ++i) {
+    decodedRangeBounds_[i].decode(*rangeBoundValues_[i], rows);
+  }
+}
+
 void NestedLoopJoinProbe::noMoreInput() {
   Operator::noMoreInput();
   if (state_ != ProbeOperatorState::kRunning || input_ != nullptr) {
@@ -209,6 +244,15 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   }
 
   buildVectors_ = std::move(buildData);
+  if (range_.has_value()) {
+    sortedBuildKeys_ =
+        operatorCtx_->task()
+            ->getNestedLoopJoinBridge(
+                operatorCtx_->driverCtx()->splitGroupId, planNodeId())
+            ->sortedKeys();
+    VELOX_CHECK_EQ(sortedBuildKeys_.size(), buildVectors_->size());
+  }
+  filterTiles_.resize(buildVectors_->size());
   return true;
 }
 
@@ -347,11 +391,17 @@ bool NestedLoopJoinProbe::addToOutput() {
 
     // Only re-calculate the filter if we have a new build vector.
     if (buildRow_ == 0) {
+      if (!selectBuildRows(currentBuild)) {
+        // No build row is within the range of the probe row.
+        ++buildIndex_;
+        continue;
+      }
       evaluateJoinFilter(currentBuild);
     }
 
     // Iterate over the filter results. For each match, add an output record.
-    for (size_t i = buildRow_; i < decodedFilterResult_.size(); ++i) {
+    for (auto i = nextBuildRow(buildRow_); i < filterInputRows_.end();
+         i = nextBuildRow(i + 1)) {
       if (!isJoinConditionMatch(i)) {
         continue;
       }
@@ -419,7 +469,36 @@ void NestedLoopJoinProbe::prepareOutput() {
       pool(), outputType_, nullptr, outputBatchSize_, std::move(localColumns));
 }
 
+bool NestedLoopJoinProbe::selectBuildRows(const RowVectorPtr& buildVector) {
+  const auto numRows = buildVector->size();
+  if (!range_.has_value()) {
+    if (filterInputRows_.size() != numRows) {
+      filterInputRows_.resizeFill(numRows, true);
+    }
+    return true;
+  }
+
+  const auto& sortedKeys = sortedBuildKeys_[buildIndex_];
+  const auto [begin, end] =
+      range_->findKeys(sortedKeys, decodedRangeBounds_, probeRow_);
+  if (begin == end) {
+    return false;
+  }
+  const auto* rows = sortedKeys.rows->as<vector_size_t>();
+  filterInputRows_.resizeFill(numRows, false);
+  for (auto i = begin; i < end; ++i) {
+    filterInputRows_.setValid(rows[i], true);
+  }
+  filterInputRows_.updateBounds();
+  return true;
+}
+
 void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
+  if (!range_.has_value() && buildVector->size() <= outputBatchSize_ / 2) {
+    evaluateJoinFilterTile(buildVector);
+    return;
+  }
+
   // First step to process is to get a batch so we can evaluate the join
   // filter.
   auto filterInput = getNextCrossProductBatch(
@@ -428,10 +507,7 @@ void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
       filterProbeProjections_,
       filterBuildProjections_);
 
-  if (filterInputRows_.size() != filterInput->size()) {
-    filterInputRows_.resizeFill(filterInput->size(), true);
-  }
-  VELOX_CHECK(filterInputRows_.isAllSelected());
+  VELOX_CHECK_EQ(filterInputRows_.size(), filterInput->size());
 
   std::vector<VectorPtr> filterResult;
   EvalCtx evalCtx(
@@ -439,6 +515,83 @@ void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
   joinCondition_->eval(0, 1, true, filterInputRows_, evalCtx, filterResult);
   filterOutput_ = filterResult[0];
   decodedFilterResult_.decode(*filterOutput_, filterInputRows_);
+  filterResult_ = &decodedFilterResult_;
+  filterResultOffset_ = 0;
+}
+
+void NestedLoopJoinProbe::evaluateJoinFilterTile(
+    const RowVectorPtr& buildVector) {
+  const auto buildRowCount = buildVector->size();
+  auto& tile = filterTiles_[buildIndex_];
+  if (probeRow_ < tile.probeBegin ||
+      probeRow_ >= tile.probeBegin + tile.numProbeRows) {
+    tile.probeBegin = probeRow_;
+    tile.numProbeRows = std::min<vector_size_t>(
+        outputBatchSize_ / buildRowCount, input_->size() - probeRow_);
+    auto filterInput = genFilterInputTile(buildVector, tile);
+
+    if (tileRows_.size() != filterInput->size()) {
+      tileRows_.resizeFill(filterInput->size(), true);
+    }
+    std::vector<VectorPtr> filterResult;
+    EvalCtx evalCtx(
+        operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
+    joinCondition_->eval(0, 1, true, tileRows_, evalCtx, filterResult);
+    tile.result = filterResult[0];
+    tile.decodedResult.decode(*tile.result, tileRows_);
+  }
+  filterResult_ = &tile.decodedResult;
+  filterResultOffset_ = (probeRow_ - tile.probeBegin) * buildRowCount;
+}
+
+RowVectorPtr NestedLoopJoinProbe::genFilterInputTile(
+    const RowVectorPtr& buildVector,
+    FilterTile& tile) {
+  const auto buildRowCount = buildVector->size();
+  const auto numRows = tile.numProbeRows * buildRowCount;
+
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, numRows, pool());
+  for (auto i = 0; i < tile.numProbeRows; ++i) {
+    std::fill(
+        rawProbeIndices.begin() + i * buildRowCount,
+        rawProbeIndices.begin() + (i + 1) * buildRowCount,
+        tile.probeBegin + i);
+  }
+
+  // The build indices are the same for all tiles of a build vector. They are
+  // made once for the largest tile.
+  if (tile.buildIndices == nullptr) {
+    const auto maxProbeRows = outputBatchSize_ / buildRowCount;
+    auto rawBuildIndices = initializeRowNumberMapping(
+        tile.buildIndices, maxProbeRows * buildRowCount, pool());
+    for (auto i = 0; i < maxProbeRows; ++i) {
+      std::iota(
+          rawBuildIndices.begin() + i * buildRowCount,
+          rawBuildIndices.begin() + (i + 1) * buildRowCount,
+          0);
+    }
+  }
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numRows,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVector,
+      filterBuildProjections_,
+      numRows,
+      tile.buildIndices);
+  return std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numRows,
+      std::move(projectedChildren));
 }
 
 RowVectorPtr NestedLoopJoinProbe::getNextCrossProductBatch(
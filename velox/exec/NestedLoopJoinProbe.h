@@ -65,6 +65,15 @@ namespace facebook::velox::exec {
 /// to be copied, then performs the copies in batch, column-by-column. It
 /// produces at most `outputBatchSize_` records, but it may produce fewer since
 /// the output needs to follow the probe vector boundaries.
+///
+/// The join condition is evaluated on a probe block times a build vector at a
+/// time for build vectors with at most half of `outputBatchSize_` rows, and
+/// the results are reused for each probe row of the block.
+///
+/// If the join condition has range form (check NestedLoopJoinRange), e.g.
+/// "t.ts BETWEEN u.start AND u.end", the build side sorts the keys of each
+/// build vector and the join condition is evaluated only on the build rows
+/// whose keys are within the bounds given by the current probe row.
 class NestedLoopJoinProbe : public Operator {
  public:
   NestedLoopJoinProbe(
@@ -101,6 +110,13 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Sets `range_` and `rangeBounds_` if 'range' is set and its bounds are
+  // deterministic.
+  void initializeRange(std::optional<NestedLoopJoinRange> range);
+
+  // Evaluates the range bounds on `input_` into `decodedRangeBounds_`.
+  void evaluateRangeBounds();
+
   // Materializes build data from nested loop join bridge into `buildVectors_`.
   // Returns whether the data has been materialized and is ready for use. Nested
   // loop join requires all build data to be materialized and available in
@@ -141,16 +157,62 @@ class NestedLoopJoinProbe : public Operator {
   // receive rows. Batches have space for `outputBatchSize_`.
   void prepareOutput();
 
+  // Sets `filterInputRows_` to the rows of a given build vector to evaluate
+  // the joinCondition on for the current probe row. These are all the rows
+  // unless the join condition has range form. Returns false if there are no
+  // such rows.
+  bool selectBuildRows(const RowVectorPtr& buildVector);
+
+  // Returns the first row in `filterInputRows_` at or after 'row', or
+  // filterInputRows_.end() if there is none.
+  vector_size_t nextBuildRow(vector_size_t row) const {
+    if (row >= filterInputRows_.end() || filterInputRows_.isAllSelected()) {
+      return row;
+    }
+    const auto next = bits::findFirstBit(
+        filterInputRows_.asRange().bits(), row, filterInputRows_.end());
+    return next < 0 ? filterInputRows_.end() : next;
+  }
+
   // Evaluates the joinCondition for a given build vector. This method sets
   // `filterOutput_` and `decodedFilterResult_`, which will be ready to be used
   // by `isJoinConditionMatch(buildRow)` below.
   void evaluateJoinFilter(const RowVectorPtr& buildVector);
 
+  // Evaluates the joinCondition for a given build vector and a block of probe
+  // rows starting at the current probe row, unless the last evaluation for
+  // the build vector covered the current probe row. Used for build vectors
+  // with at most half of `outputBatchSize_` rows, so that the condition is
+  // evaluated on a probe block times the build vector at a time instead of on
+  // one probe row at a time.
+  void evaluateJoinFilterTile(const RowVectorPtr& buildVector);
+
+  // The join condition results for a block of probe rows and a build vector.
+  struct FilterTile {
+    // The first probe row of the block.
+    vector_size_t probeBegin{0};
+
+    // The number of probe rows in the block. 0 if there is no block.
+    vector_size_t numProbeRows{0};
+
+    // The results for each probe row, for all build rows.
+    VectorPtr result;
+    DecodedVector decodedResult;
+
+    // Dictionary indices for the build columns. The same for all blocks.
+    BufferPtr buildIndices;
+  };
+
+  // Generates the join condition input for the probe rows and a build vector
+  // of 'tile'.
+  RowVectorPtr genFilterInputTile(
+      const RowVectorPtr& buildVector,
+      FilterTile& tile);
+
   // Checks if the join condition matched for a particular row.
   bool isJoinConditionMatch(vector_size_t i) const {
-    return (
-        !decodedFilterResult_.isNullAt(i) &&
-        decodedFilterResult_.valueAt<bool>(i));
+    const auto row = filterResultOffset_ + i;
+    return !filterResult_->isNullAt(row) && filterResult_->valueAt<bool>(row);
   }
 
   // Generates the next batch of a cross product between probe and build. It
@@ -307,12 +369,38 @@ class NestedLoopJoinProbe : public Operator {
   // Input type for the join condition expression.
   RowTypePtr filterInputType_;
 
+  // Set if the join condition has range form.
+  std::optional<NestedLoopJoinRange> range_;
+
+  // Evaluates the bounds of `range_` on the probe input.
+  std::unique_ptr<ExprSet> rangeBounds_;
+
+  // The bounds of `range_` for the rows of `input_`.
+  std::vector<VectorPtr> rangeBoundValues_;
+  std::vector<DecodedVector> decodedRangeBounds_;
+
+  // The sorted keys of each of `buildVectors_`. Only set if `range_` is set.
+  std::vector<NestedLoopJoinRange::SortedKeys> sortedBuildKeys_;
+
   // Join condition evaluation state that need to persisted across the
   // generation of successive output buffers.
   SelectivityVector filterInputRows_;
   VectorPtr filterOutput_;
   DecodedVector decodedFilterResult_;
 
+  // The join condition results for the current probe row and build vector:
+  // the result for build row 'i' is at 'filterResultOffset_ + i' of
+  // 'filterResult_'. Points to `decodedFilterResult_` or to the decoded result
+  // of a tile in `filterTiles_`.
+  const DecodedVector* filterResult_{nullptr};
+  vector_size_t filterResultOffset_{0};
+
+  // The last evaluated tile for each of `buildVectors_`.
+  std::vector<FilterTile> filterTiles_;
+
+  // All the rows of a tile.
+  SelectivityVector tileRows_;
+
   // Join metadata and state.
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
 
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/NestedLoopJoinRange.h"
+
+#include "velox/expression/ConjunctExpr.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isSupportedKeyType(const TypePtr& type) {
+  return !type->providesCustomComparison() &&
+      (isIntegerKind(type->kind()) || type->kind() == TypeKind::TIMESTAMP);
+}
+
+// Calls 'func' with a value of the C++ type of the key type 'kind'.
+template <typename TFunc>
+auto dispatchKeyType(TypeKind kind, TFunc&& func) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return func(int8_t{});
+    case TypeKind::SMALLINT:
+      return func(int16_t{});
+    case TypeKind::INTEGER:
+      return func(int32_t{});
+    case TypeKind::BIGINT:
+      return func(int64_t{});
+    case TypeKind::TIMESTAMP:
+      return func(Timestamp{});
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported range join key type: {}", mapTypeKindToName(kind));
+  }
+}
+
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == kAnd) {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+// Returns the channel of the build side column 'expr' reads, if 'expr' is a
+// build side column.
+std::optional<column_index_t> toBuildColumn(
+    const core::TypedExprPtr& expr,
+    const RowType& probeType,
+    const RowType& buildType) {
+  const auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr || !field->isInputColumn() ||
+      probeType.containsChild(field->name())) {
+    return std::nullopt;
+  }
+  return buildType.getChildIdxIfExists(field->name());
+}
+
+// Returns true if 'expr' reads only probe side columns.
+bool isProbeExpr(const core::TypedExprPtr& expr, const RowType& probeType) {
+  if (const auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    if (field->isInputColumn()) {
+      return probeType.containsChild(field->name());
+    }
+  }
+  if (dynamic_cast<const core::InputTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return false;
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!isProbeExpr(input, probeType)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The bounds of one build side column.
+struct ColumnBounds {
+  column_index_t channel;
+  TypePtr type;
+  std::vector<NestedLoopJoinRange::Bound> lowerBounds;
+  std::vector<NestedLoopJoinRange::Bound> upperBounds;
+};
+
+template <typename T>
+std::optional<int128_t> maxIntervalLength(
+    const DecodedVector& keys,
+    const DecodedVector& ends,
+    const vector_size_t* rows,
+    vector_size_t numRows) {
+  std::optional<int128_t> maxLength;
+  for (auto i = 0; i < numRows; ++i) {
+    const auto row = rows[i];
+    if (ends.isNullAt(row)) {
+      continue;
+    }
+    const int128_t length =
+        static_cast<int128_t>(ends.valueAt<T>(row)) - keys.valueAt<T>(row);
+    if (!maxLength.has_value() || length > maxLength.value()) {
+      maxLength = length;
+    }
+  }
+  return maxLength;
+}
+
+} // namespace
+
+// static
+std::optional<NestedLoopJoinRange> NestedLoopJoinRange::make(
+    const core::NestedLoopJoinNode& joinNode) {
+  if (joinNode.joinCondition() == nullptr) {
+    return std::nullopt;
+  }
+  const auto& probeType = *joinNode.sources()[0]->outputType();
+  const auto& buildType = *joinNode.sources()[1]->outputType();
+
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(joinNode.joinCondition(), conjuncts);
+
+  // The bounded build side columns in the order of their first bound.
+  std::vector<ColumnBounds> columns;
+  const auto addBound = [&](const core::TypedExprPtr& column,
+                            const core::TypedExprPtr& bound,
+                            bool lower,
+                            bool inclusive) {
+    const auto channel = toBuildColumn(column, probeType, buildType);
+    if (!channel.has_value() || !isSupportedKeyType(column->type()) ||
+        !bound->type()->equivalent(*column->type()) ||
+        !isProbeExpr(bound, probeType)) {
+      return;
+    }
+    auto it = std::find_if(
+        columns.begin(), columns.end(), [&](const auto& candidate) {
+          return candidate.channel == channel.value();
+        });
+    if (it == columns.end()) {
+      it = columns.insert(
+          columns.end(), ColumnBounds{channel.value(), column->type(), {}, {}});
+    }
+    (lower ? it->lowerBounds : it->upperBounds).push_back({bound, inclusive});
+  };
+
+  for (const auto& conjunct : conjuncts) {
+    const auto* call = dynamic_cast<const core::CallTypedExpr*>(conjunct.get());
+    if (call == nullptr) {
+      continue;
+    }
+    const auto& name = call->name();
+    const auto& inputs = call->inputs();
+    if (inputs.size() == 2 &&
+        (name == "lt" || name == "lte" || name == "gt" || name == "gte")) {
+      // 'a < b' is an upper bound of 'a' and a lower bound of 'b'.
+      const bool less = name == "lt" || name == "lte";
+      const bool inclusive = name == "lte" || name == "gte";
+      addBound(inputs[0], inputs[1], !less, inclusive);
+      addBound(inputs[1], inputs[0], less, inclusive);
+    } else if (inputs.size() == 3 && name == "between") {
+      addBound(inputs[0], inputs[1], true, true);
+      addBound(inputs[0], inputs[2], false, true);
+      addBound(inputs[1], inputs[0], false, true);
+      addBound(inputs[2], inputs[0], true, true);
+    }
+  }
+
+  // Prefers a key bounded from both sides, either directly or as the start of
+  // an interval whose end has a lower bound.
+  const ColumnBounds* key = nullptr;
+  const ColumnBounds* intervalEnd = nullptr;
+  int32_t bestScore = 0;
+  for (const auto& column : columns) {
+    int32_t score = !column.lowerBounds.empty() + !column.upperBounds.empty();
+    const ColumnBounds* end = nullptr;
+    if (column.lowerBounds.empty() && isIntegerKind(column.type->kind())) {
+      for (const auto& other : columns) {
+        if (&other != &column && !other.lowerBounds.empty() &&
+            other.type->equivalent(*column.type)) {
+          end = &other;
+          ++score;
+          break;
+        }
+      }
+    }
+    if (score > bestScore) {
+      bestScore = score;
+      key = &column;
+      intervalEnd = end;
+    }
+  }
+  if (key == nullptr) {
+    return std::nullopt;
+  }
+
+  if (intervalEnd == nullptr) {
+    return NestedLoopJoinRange(
+        key->type,
+        key->channel,
+        key->lowerBounds,
+        key->upperBounds,
+        std::nullopt,
+        {});
+  }
+  return NestedLoopJoinRange(
+      key->type,
+      key->channel,
+      key->lowerBounds,
+      key->upperBounds,
+      intervalEnd->channel,
+      intervalEnd->lowerBounds);
+}
+
+std::vector<core::TypedExprPtr> NestedLoopJoinRange::boundExprs() const {
+  std::vector<core::TypedExprPtr> exprs;
+  for (const auto* bounds :
+       {&lowerBounds_, &upperBounds_, &intervalEndLowerBounds_}) {
+    for (const auto& bound : *bounds) {
+      exprs.push_back(bound.expr);
+    }
+  }
+  return exprs;
+}
+
+NestedLoopJoinRange::SortedKeys NestedLoopJoinRange::sortKeys(
+    const RowVectorPtr& buildVector,
+    memory::MemoryPool* pool) const {
+  const auto numRows = buildVector->size();
+  const auto& keyVector = buildVector->childAt(keyChannel_);
+  SelectivityVector allRows(numRows);
+  DecodedVector keys(*keyVector, allRows);
+
+  SortedKeys sortedKeys;
+  sortedKeys.rows = allocateIndices(numRows, pool);
+  auto* rows = sortedKeys.rows->asMutable<vector_size_t>();
+  vector_size_t numKeys = 0;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (!keys.isNullAt(row)) {
+      rows[numKeys++] = row;
+    }
+  }
+
+  dispatchKeyType(keyType_->kind(), [&](auto tag) {
+    using T = decltype(tag);
+    std::sort(rows, rows + numKeys, [&](auto left, auto right) {
+      return keys.valueAt<T>(left) < keys.valueAt<T>(right);
+    });
+    if constexpr (std::is_integral_v<T>) {
+      if (intervalEndChannel_.has_value()) {
+        DecodedVector ends(
+            *buildVector->childAt(intervalEndChannel_.value()), allRows);
+        sortedKeys.maxIntervalLength =
+            maxIntervalLength<T>(keys, ends, rows, numKeys);
+      }
+    }
+  });
+
+  sortedKeys.keys = BaseVector::create(keyType_, numKeys, pool);
+  sortedKeys.keys->copy(keyVector.get(), SelectivityVector(numKeys), rows);
+  return sortedKeys;
+}
+
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinRange::findKeys(
+    const SortedKeys& sortedKeys,
+    const std::vector<DecodedVector>& bounds,
+    vector_size_t row) const {
+  return dispatchKeyType(keyType_->kind(), [&](auto tag) {
+    return searchKeys<decltype(tag)>(sortedKeys, bounds, row);
+  });
+}
+
+template <typename T>
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinRange::searchKeys(
+    const SortedKeys& sortedKeys,
+    const std::vector<DecodedVector>& bounds,
+    vector_size_t row) const {
+  const auto* keys = sortedKeys.keys->asFlatVector<T>()->rawValues();
+  const auto* keysEnd = keys + sortedKeys.keys->size();
+  const auto* begin = keys;
+  const auto* end = keysEnd;
+
+  size_t boundIndex = 0;
+  const auto nextBound = [&]() -> std::optional<T> {
+    const auto& decoded = bounds[boundIndex++];
+    if (decoded.isNullAt(row)) {
+      return std::nullopt;
+    }
+    return decoded.valueAt<T>(row);
+  };
+
+  for (const auto& bound : lowerBounds_) {
+    const auto value = nextBound();
+    if (!value.has_value()) {
+      return {0, 0};
+    }
+    begin = std::max(
+        begin,
+        bound.inclusive ? std::lower_bound(keys, keysEnd, value.value())
+                        : std::upper_bound(keys, keysEnd, value.value()));
+  }
+  for (const auto& bound : upperBounds_) {
+    const auto value = nextBound();
+    if (!value.has_value()) {
+      return {0, 0};
+    }
+    end = std::min(
+        end,
+        bound.inclusive ? std::upper_bound(keys, keysEnd, value.value())
+                        : std::lower_bound(keys, keysEnd, value.value()));
+  }
+  if constexpr (std::is_integral_v<T>) {
+    for (size_t i = 0; i < intervalEndLowerBounds_.size(); ++i) {
+      const auto value = nextBound();
+      if (!value.has_value() || !sortedKeys.maxIntervalLength.has_value()) {
+        return {0, 0};
+      }
+      // 'end >= value' and 'end - key <= maxIntervalLength' imply
+      // 'key >= value - maxIntervalLength'.
+      const int128_t lowest = static_cast<int128_t>(value.value()) -
+          sortedKeys.maxIntervalLength.value();
+      if (lowest > std::numeric_limits<T>::max()) {
+        return {0, 0};
+      }
+      if (lowest > std::numeric_limits<T>::min()) {
+        begin = std::max(
+            begin,
+            std::lower_bound(keys, keysEnd, static_cast<T>(lowest)));
+      }
+    }
+  }
+
+  if (begin >= end) {
+    return {0, 0};
+  }
+  return {
+      static_cast<vector_size_t>(begin - keys),
+      static_cast<vector_size_t>(end - keys)};
+}
+
+} // namespace facebook::velox::exec
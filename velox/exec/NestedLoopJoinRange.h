@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// A nested loop join condition of range form: a conjunction with comparisons
+/// between one build side column, the key, and expressions over probe side
+/// columns, e.g. "u.start <= t.ts AND t.ts < u.start + 100". An interval
+/// condition like "t.ts BETWEEN u.start AND u.end" also bounds the key
+/// 'u.start' by 't.ts' minus the longest build side interval.
+///
+/// The build side sorts the keys of each build vector once. For each probe row
+/// the probe side then finds the keys within the bounds with binary searches
+/// and evaluates the join condition only on the build rows with these keys.
+class NestedLoopJoinRange {
+ public:
+  /// A bound of the key given by an expression over probe side columns.
+  struct Bound {
+    core::TypedExprPtr expr;
+    bool inclusive;
+  };
+
+  /// The keys of a build vector in ascending order.
+  struct SortedKeys {
+    /// The non-null keys.
+    VectorPtr keys;
+
+    /// The row of each of 'keys' in the build vector.
+    BufferPtr rows;
+
+    /// The largest difference between the interval end and the key over the
+    /// rows where neither is null. Only set if there is an interval end and
+    /// such a row.
+    std::optional<int128_t> maxIntervalLength;
+  };
+
+  /// Returns the range form of the join condition of 'joinNode' or
+  /// std::nullopt if the condition does not bound any build side column of a
+  /// supported type.
+  static std::optional<NestedLoopJoinRange> make(
+      const core::NestedLoopJoinNode& joinNode);
+
+  /// The channel of the key in the build side type.
+  column_index_t keyChannel() const {
+    return keyChannel_;
+  }
+
+  /// Bounds 'b' with 'key > b' or 'key >= b'.
+  const std::vector<Bound>& lowerBounds() const {
+    return lowerBounds_;
+  }
+
+  /// Bounds 'b' with 'key < b' or 'key <= b'.
+  const std::vector<Bound>& upperBounds() const {
+    return upperBounds_;
+  }
+
+  /// The channel in the build side type of the end of an interval that starts
+  /// at the key, if any.
+  const std::optional<column_index_t>& intervalEndChannel() const {
+    return intervalEndChannel_;
+  }
+
+  /// Bounds 'b' with 'end > b' or 'end >= b' for the interval end.
+  const std::vector<Bound>& intervalEndLowerBounds() const {
+    return intervalEndLowerBounds_;
+  }
+
+  /// Returns the expressions of the lower bounds, the upper bounds and the
+  /// interval end lower bounds, in this order.
+  std::vector<core::TypedExprPtr> boundExprs() const;
+
+  /// Sorts the keys of 'buildVector'.
+  SortedKeys sortKeys(const RowVectorPtr& buildVector, memory::MemoryPool* pool)
+      const;
+
+  /// Returns the positions [begin, end) in 'sortedKeys' of the keys within the
+  /// bounds for row 'row' of 'bounds'. 'bounds' are the decoded values of
+  /// boundExprs(). Returns an empty range if any bound is null.
+  std::pair<vector_size_t, vector_size_t> findKeys(
+      const SortedKeys& sortedKeys,
+      const std::vector<DecodedVector>& bounds,
+      vector_size_t row) const;
+
+ private:
+  NestedLoopJoinRange(
+      TypePtr keyType,
+      column_index_t keyChannel,
+      std::vector<Bound> lowerBounds,
+      std::vector<Bound> upperBounds,
+      std::optional<column_index_t> intervalEndChannel,
+      std::vector<Bound> intervalEndLowerBounds)
+      : keyType_(std::move(keyType)),
+        keyChannel_(keyChannel),
+        lowerBounds_(std::move(lowerBounds)),
+        upperBounds_(std::move(upperBounds)),
+        intervalEndChannel_(intervalEndChannel),
+        intervalEndLowerBounds_(std::move(intervalEndLowerBounds)) {}
+
+  template <typename T>
+  std::pair<vector_size_t, vector_size_t> searchKeys(
+      const SortedKeys& sortedKeys,
+      const std::vector<DecodedVector>& bounds,
+      vector_size_t row) const;
+
+  TypePtr keyType_;
+  column_index_t keyChannel_;
+  std::vector<Bound> lowerBounds_;
+  std::vector<Bound> upperBounds_;
+  std::optional<column_index_t> intervalEndChannel_;
+  std::vector<Bound> intervalEndLowerBounds_;
+};
+
+} // namespace facebook::velox::exec
@@ -172,11 +172,15 @@ Operator::translators() {
 }
 
 void Operator::setupInputTracer(const std::string& opTraceDirPath) {
+  const auto* driverCtx = operatorCtx_->driverCtx();
   inputTracer_ = std::make_unique<trace::OperatorTraceInputWriter>(
       this,
       opTraceDirPath,
       memory::traceMemoryPool(),
-      operatorCtx_->driverCtx()->traceConfig()->updateAndCheckTraceLimitCB);
+      driverCtx->traceConfig()->updateAndCheckTraceLimitCB,
+      common::stringToCompressionKind(
+          driverCtx->queryConfig().queryTraceCompressionKind()),
+      driverCtx->queryConfig().queryTraceAsyncEnabled());
 }
 
 void Operator::setupSplitTracer(const std::string& opTraceDirPath) {
@@ -345,10 +349,31 @@ void Operator::close() {
   operatorCtx_->pool()->release();
 }
 
+void Operator::prepareOutputVector(
+    VectorPtr& vector,
+    const TypePtr& type,
+    vector_size_t size) {
+  if (vector != nullptr) {
+    const auto* previous = vector.get();
+    BaseVector::prepareForReuse(vector, size);
+    if (vector.get() == previous) {
+      addRuntimeStat(kOutputVectorReuses, RuntimeCounter(1));
+      return;
+    }
+  } else {
+    vector = BaseVector::create(type, size, pool());
+  }
+  addRuntimeStat(kOutputVectorAllocations, RuntimeCounter(1));
+}
+
 vector_size_t Operator::outputBatchRows(
     std::optional<uint64_t> averageRowSize) const {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
   if (!averageRowSize.has_value()) {
+    const auto* driver = operatorCtx_->driver();
+    if (driver != nullptr && driver->adaptiveOutputBatchRows().has_value()) {
+      return driver->adaptiveOutputBatchRows().value();
+    }
     return queryConfig.preferredOutputBatchRows();
   }
 
@@ -436,6 +461,20 @@ void Operator::recordSpillStats() {
             static_cast<int64_t>(lockedSpillStats->spillWriteTimeNanos),
             RuntimeCounter::Unit::kNanos});
   }
+  if (lockedSpillStats->spillEncodingSavedBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillEncodingSavedBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillEncodingSavedBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
+  if (lockedSpillStats->spillCompressionSavedBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillCompressionSavedBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillCompressionSavedBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
   if (lockedSpillStats->spillRuns != 0) {
     lockedStats->addRuntimeStat(
         kSpillRuns,
@@ -574,6 +613,12 @@ void OperatorStats::add(const OperatorStats& other) {
 
   backgroundTiming.add(other.backgroundTiming);
 
+  perfCounters.add(other.perfCounters);
+
+  for (const auto& [name, histogram] : other.ioLatencyHistograms) {
+    ioLatencyHistograms[name].merge(histogram);
+  }
+
   memoryStats.add(other.memoryStats);
 
   for (const auto& [name, stats] : other.runtimeStats) {
@@ -617,6 +662,10 @@ void OperatorStats::clear() {
 
   backgroundTiming.clear();
 
+  perfCounters.clear();
+
+  ioLatencyHistograms.clear();
+
   memoryStats.clear();
 
   runtimeStats.clear();
@@ -169,6 +169,10 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillFlushTime{"spillFlushWallNanos"};
   static inline const std::string kSpillWrites{"spillWrites"};
   static inline const std::string kSpillWriteTime{"spillWriteWallNanos"};
+  static inline const std::string kSpillEncodingSavedBytes{
+      "spillEncodingSavedBytes"};
+  static inline const std::string kSpillCompressionSavedBytes{
+      "spillCompressionSavedBytes"};
   static inline const std::string kSpillRuns{"spillRuns"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
@@ -188,6 +192,12 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kShuffleCompressionKind{
       "shuffleCompressionKind"};
 
+  /// The number of output vectors allocated and reused across batches by the
+  /// operators that recycle their output vectors with prepareOutputVector().
+  static inline const std::string kOutputVectorAllocations{
+      "outputVectorAllocations"};
+  static inline const std::string kOutputVectorReuses{"outputVectorReuses"};
+
   /// 'operatorId' is the initial index of the 'this' in the Driver's list of
   /// Operators. This is used as in index into OperatorStats arrays in the Task.
   /// 'planNodeId' is a query-level unique identifier of the PlanNode to which
@@ -580,11 +590,22 @@ class Operator : public BaseRuntimeStatWriter {
   /// 'identityProjections_' and 'resultProjections_'.
   RowVectorPtr fillOutput(vector_size_t size, const BufferPtr& mapping);
 
+  /// Makes 'vector' a writable vector of 'type' with 'size' rows for the next
+  /// output batch. If 'vector' holds the output of the previous batch and is no
+  /// longer referenced by the downstream operators, its children and buffers
+  /// are reused. Otherwise, a new vector is allocated. Records the allocation
+  /// or reuse in the runtime stats.
+  void prepareOutputVector(
+      VectorPtr& vector,
+      const TypePtr& type,
+      vector_size_t size);
+
   /// Returns the number of rows for the output batch. This uses averageRowSize
   /// to calculate how many rows fit in preferredOutputBatchBytes. It caps the
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
+  /// the Driver's adaptiveOutputBatchRows if set, otherwise
   /// preferredOutputBatchRows.
   vector_size_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include "velox/common/io/IoStatistics.h"
 #include "velox/common/memory/MemoryPool.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 
 namespace facebook::velox::exec {
@@ -152,6 +154,14 @@ struct OperatorStats {
   // CPU time at a reasonable time granularity.
   CpuWallTiming backgroundTiming;
 
+  // Hardware performance counters of the sampled addInput and getOutput calls
+  // if enabled by QueryConfig::kOperatorPerfCountersEnabled.
+  process::PerfCounters perfCounters;
+
+  // Latency histograms of the reads of a TableScan per cache tier and storage
+  // type, see io::IoStatistics::latencyHistograms().
+  std::unordered_map<std::string, io::IoLatencyHistogram> ioLatencyHistograms;
+
   MemoryStats memoryStats;
 
   // Total bytes in memory for spilling
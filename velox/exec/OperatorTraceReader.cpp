@@ -89,6 +89,10 @@ OperatorTraceSummary OperatorTraceSummaryReader::read() const {
       summaryObj[OperatorTraceTraits::kRawInputRowsKey].asInt();
   summary.rawInputBytes =
       summaryObj[OperatorTraceTraits::kRawInputBytesKey].asInt();
+  if (summaryObj.count(OperatorTraceTraits::kNumDroppedBatchesKey) != 0) {
+    summary.numDroppedBatches =
+        summaryObj[OperatorTraceTraits::kNumDroppedBatchesKey].asInt();
+  }
   return summary;
 }
 
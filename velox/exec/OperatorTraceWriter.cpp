@@ -16,8 +16,10 @@
 
 #include "velox/exec/OperatorTraceWriter.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/hash/Checksum.h>
 #include <folly/io/Cursor.h>
+#include <thread>
 #include <utility>
 
 #include "velox/common/file/File.h"
@@ -41,28 +43,97 @@ void recordOperatorSummary(Operator* op, folly::dynamic& obj) {
   obj[OperatorTraceTraits::kRawInputRowsKey] = stats.rawInputPositions;
   obj[OperatorTraceTraits::kRawInputBytesKey] = stats.rawInputBytes;
 }
+
+// The executor shared by the asynchronous input writers of all traced
+// operators.
+folly::Executor* traceWriteExecutor() {
+  static folly::CPUThreadPoolExecutor executor(
+      std::max<int32_t>(1, std::thread::hardware_concurrency() / 8),
+      std::make_shared<folly::NamedThreadFactory>("TraceWriter"));
+  return &executor;
+}
 } // namespace
 
 OperatorTraceInputWriter::OperatorTraceInputWriter(
     Operator* traceOp,
     std::string traceDir,
     memory::MemoryPool* pool,
-    UpdateAndCheckTraceLimitCB updateAndCheckTraceLimitCB)
+    UpdateAndCheckTraceLimitCB updateAndCheckTraceLimitCB,
+    common::CompressionKind compressionKind,
+    bool async)
     : traceOp_(traceOp),
       traceDir_(std::move(traceDir)),
+      options_{true, compressionKind, 0.8, /*nullsFirst=*/true},
       fs_(filesystems::getFileSystem(traceDir_, nullptr)),
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
-      updateAndCheckTraceLimitCB_(std::move(updateAndCheckTraceLimitCB)) {
+      updateAndCheckTraceLimitCB_(std::move(updateAndCheckTraceLimitCB)),
+      async_(async) {
   traceFile_ = fs_->openFileForWrite(getOpTraceInputFilePath(traceDir_));
   VELOX_CHECK_NOT_NULL(traceFile_);
 }
 
+OperatorTraceInputWriter::~OperatorTraceInputWriter() {
+  waitForPending();
+}
+
 void OperatorTraceInputWriter::write(const RowVectorPtr& rows) {
   if (FOLLY_UNLIKELY(finished_)) {
     return;
   }
 
+  if (!async_) {
+    writeBatch(rows);
+    return;
+  }
+
+  // The lazy vectors are loaded on the driver thread that owns them.
+  rows->loadedVector();
+  std::lock_guard<std::mutex> l(mutex_);
+  if (error_ != nullptr) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+  if (pending_.size() >= kMaxPendingBatches) {
+    ++numDroppedBatches_;
+    return;
+  }
+  pending_.push_back(rows);
+  if (!writing_) {
+    writing_ = true;
+    traceWriteExecutor()->add([this]() { writePending(); });
+  }
+}
+
+void OperatorTraceInputWriter::writePending() {
+  for (;;) {
+    RowVectorPtr rows;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (pending_.empty() || error_ != nullptr) {
+        pending_.clear();
+        writing_ = false;
+        // Notifies under the lock, so that the writer is not destroyed before.
+        pendingDone_.notify_all();
+        return;
+      }
+      rows = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    try {
+      writeBatch(rows);
+    } catch (const std::exception&) {
+      std::lock_guard<std::mutex> l(mutex_);
+      error_ = std::current_exception();
+    }
+  }
+}
+
+void OperatorTraceInputWriter::waitForPending() {
+  std::unique_lock<std::mutex> l(mutex_);
+  pendingDone_.wait(l, [&]() { return !writing_; });
+}
+
+void OperatorTraceInputWriter::writeBatch(const RowVectorPtr& rows) {
   if (batch_ == nullptr) {
     batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
     batch_->createStreamTree(
@@ -87,6 +158,17 @@ void OperatorTraceInputWriter::finish() {
     return;
   }
 
+  waitForPending();
+  if (error_ != nullptr) {
+    // Does not throw from the close of the operator.
+    try {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to write operator trace input to " << traceDir_
+                   << ": " << e.what();
+    }
+  }
+
   VELOX_CHECK_NOT_NULL(
       traceFile_, "The query data writer has already been finished");
   traceFile_->close();
@@ -101,6 +183,7 @@ void OperatorTraceInputWriter::writeSummary() const {
   const auto file = fs_->openFileForWrite(summaryFilePath);
   folly::dynamic obj = folly::dynamic::object;
   recordOperatorSummary(traceOp_, obj);
+  obj[OperatorTraceTraits::kNumDroppedBatchesKey] = numDroppedBatches();
   file->append(folly::toJson(obj));
   file->close();
 }
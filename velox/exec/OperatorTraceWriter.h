@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "velox/common/base/TraceConfig.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
@@ -35,39 +39,77 @@ namespace facebook::velox::exec::trace {
 class OperatorTraceInputWriter {
  public:
   /// 'traceOp' is the operator to trace. 'traceDir' specifies the trace
-  /// directory for the operator.
-  explicit OperatorTraceInputWriter(
+  /// directory for the operator. 'compressionKind' is the codec of the
+  /// serialized batches. The reader reads the batches of any codec. If
+  /// 'async' is true, the batches are serialized and written on a background
+  /// executor. At most kMaxPendingBatches batches wait for the executor and
+  /// the batches that arrive while the queue is full are dropped.
+  OperatorTraceInputWriter(
       Operator* traceOp,
       std::string traceDir,
       memory::MemoryPool* pool,
-      UpdateAndCheckTraceLimitCB updateAndCheckTraceLimitCB);
+      UpdateAndCheckTraceLimitCB updateAndCheckTraceLimitCB,
+      common::CompressionKind compressionKind =
+          common::CompressionKind::CompressionKind_ZSTD,
+      bool async = false);
+
+  /// Waits for the pending asynchronous writes.
+  ~OperatorTraceInputWriter();
+
+  static constexpr int32_t kMaxPendingBatches = 2;
 
-  /// Serializes rows and writes out each batch.
+  /// Serializes rows and writes out each batch. With 'async', rethrows the
+  /// error of a previous background write, e.g. of exceeding the trace limit.
   void write(const RowVectorPtr& rows);
 
-  /// Closes the data file and writes out the data summary.
+  /// Closes the data file and writes out the data summary. Waits for the
+  /// pending asynchronous writes first.
   void finish();
 
+  /// Returns the number of batches dropped by the asynchronous writer.
+  uint64_t numDroppedBatches() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numDroppedBatches_;
+  }
+
  private:
+  // Serializes and writes out 'rows'.
+  void writeBatch(const RowVectorPtr& rows);
+
+  // Writes out the pending batches on the background executor until there is
+  // none.
+  void writePending();
+
+  // Waits until the background executor has written the pending batches.
+  void waitForPending();
+
   // Flushes the trace data summaries to the disk.
   void writeSummary() const;
 
   Operator* const traceOp_;
   const std::string traceDir_;
   // TODO: make 'useLosslessTimestamp' configuerable.
-  const serializer::presto::PrestoVectorSerde::PrestoOptions options_ = {
-      true,
-      common::CompressionKind::CompressionKind_ZSTD,
-      0.8,
-      /*nullsFirst=*/true};
+  const serializer::presto::PrestoVectorSerde::PrestoOptions options_;
   const std::shared_ptr<filesystems::FileSystem> fs_;
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
   const UpdateAndCheckTraceLimitCB updateAndCheckTraceLimitCB_;
 
+  const bool async_;
+
   std::unique_ptr<WriteFile> traceFile_;
   std::unique_ptr<VectorStreamGroup> batch_;
   bool finished_{false};
+
+  // Guards the state shared with the background executor below.
+  mutable std::mutex mutex_;
+  std::condition_variable pendingDone_;
+  std::deque<RowVectorPtr> pending_;
+  // True while the executor runs writePending().
+  bool writing_{false};
+  // The first error of a background write.
+  std::exception_ptr error_;
+  uint64_t numDroppedBatches_{0};
 };
 
 /// Used to write the input splits during the execution of a traced 'TableScan'
@@ -465,6 +465,121 @@ void aggregateOperatorRuntimeStats(
   }
 }
 
+bool canMakeCutoffFilter(const TypePtr& type) {
+  if (type->providesCustomComparison()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+namespace {
+template <TypeKind Kind>
+std::unique_ptr<common::Filter> makeBigintCutoffFilter(
+    const BaseVector& vector,
+    vector_size_t index,
+    bool ascending,
+    bool nullAllowed) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const int64_t cutoff = vector.as<SimpleVector<T>>()->valueAt(index);
+  if (ascending) {
+    return std::make_unique<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), cutoff, nullAllowed);
+  }
+  return std::make_unique<common::BigintRange>(
+      cutoff, std::numeric_limits<int64_t>::max(), nullAllowed);
+}
+} // namespace
+
+std::unique_ptr<common::Filter> makeCutoffFilter(
+    const BaseVector& vector,
+    vector_size_t index,
+    const CompareFlags& flags) {
+  if (vector.isNullAt(index)) {
+    if (flags.nullsFirst) {
+      return std::make_unique<common::IsNull>();
+    }
+    return nullptr;
+  }
+  const bool nullAllowed = flags.nullsFirst;
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      return makeBigintCutoffFilter<TypeKind::TINYINT>(
+          vector, index, flags.ascending, nullAllowed);
+    case TypeKind::SMALLINT:
+      return makeBigintCutoffFilter<TypeKind::SMALLINT>(
+          vector, index, flags.ascending, nullAllowed);
+    case TypeKind::INTEGER:
+      return makeBigintCutoffFilter<TypeKind::INTEGER>(
+          vector, index, flags.ascending, nullAllowed);
+    case TypeKind::BIGINT:
+      return makeBigintCutoffFilter<TypeKind::BIGINT>(
+          vector, index, flags.ascending, nullAllowed);
+    case TypeKind::VARCHAR: {
+      const auto cutoff =
+          vector.as<SimpleVector<StringView>>()->valueAt(index).str();
+      if (flags.ascending) {
+        return std::make_unique<common::BytesRange>(
+            "", true, false, cutoff, false, false, nullAllowed);
+      }
+      return std::make_unique<common::BytesRange>(
+          cutoff, false, false, "", true, false, nullAllowed);
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+GroupStartFinder::GroupStartFinder(
+    const RowTypePtr& inputType,
+    std::vector<column_index_t> keyChannels,
+    memory::MemoryPool* pool)
+    : inputType_(inputType), keyChannels_(std::move(keyChannels)), pool_(pool) {
+  VELOX_CHECK(!keyChannels_.empty());
+}
+
+void GroupStartFinder::find(const RowVector& input, uint64_t* groupStarts) {
+  const auto numRows = input.size();
+  if (numRows == 0) {
+    return;
+  }
+  bits::fillBits(groupStarts, 0, numRows, false);
+  if (lastKeys_.empty()) {
+    bits::setBit(groupStarts, 0);
+  }
+
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    const auto* key = input.childAt(keyChannels_[i]).get();
+    if (!lastKeys_.empty() && !bits::isBitSet(groupStarts, 0) &&
+        !key->equalValueAt(lastKeys_[i].get(), 0, 0)) {
+      bits::setBit(groupStarts, 0);
+    }
+    for (vector_size_t row = 1; row < numRows; ++row) {
+      if (!bits::isBitSet(groupStarts, row) &&
+          !key->equalValueAt(key, row, row - 1)) {
+        bits::setBit(groupStarts, row);
+      }
+    }
+  }
+
+  // Copies into new vectors so that copies of complex type keys do not
+  // accumulate in the same vectors.
+  lastKeys_.resize(keyChannels_.size());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    const auto channel = keyChannels_[i];
+    lastKeys_[i] = BaseVector::create(inputType_->childAt(channel), 1, pool_);
+    lastKeys_[i]->copy(input.childAt(channel).get(), 0, numRows - 1, 1);
+  }
+}
+
 folly::Range<vector_size_t*> initializeRowNumberMapping(
     BufferPtr& mapping,
     vector_size_t size,
@@ -156,6 +156,43 @@ void addOperatorRuntimeStats(
 void aggregateOperatorRuntimeStats(
     std::unordered_map<std::string, RuntimeMetric>& stats);
 
+/// Returns true if makeCutoffFilter() can make a filter on a column of 'type'.
+bool canMakeCutoffFilter(const TypePtr& type);
+
+/// Returns a filter that passes the values that sort before row 'index' of
+/// 'vector' or are equal to it in the order given by 'flags'. Returns nullptr
+/// if all values pass. The type of 'vector' must be accepted by
+/// canMakeCutoffFilter().
+std::unique_ptr<common::Filter> makeCutoffFilter(
+    const BaseVector& vector,
+    vector_size_t index,
+    const CompareFlags& flags);
+
+/// Finds the rows that start a group of adjacent rows with equal keys in input
+/// grouped on the keys. Groups may span inputs: a copy of the keys of the last
+/// row of the previous input is kept to compare with the first row.
+class GroupStartFinder {
+ public:
+  GroupStartFinder(
+      const RowTypePtr& inputType,
+      std::vector<column_index_t> keyChannels,
+      memory::MemoryPool* pool);
+
+  /// Sets the bits in 'groupStarts' for the rows of 'input' that start a group
+  /// and clears the bits for the other rows. Must be called for consecutive
+  /// inputs in order.
+  void find(const RowVector& input, uint64_t* groupStarts);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  memory::MemoryPool* const pool_;
+
+  // The keys of the last row of the previous input. Empty before the first
+  // input.
+  std::vector<VectorPtr> lastKeys_;
+};
+
 /// Allocates 'mapping' to fit at least 'size' indices and initializes them to
 /// zero if 'mapping' is either: nullptr, not unique or cannot fit 'size'.
 /// Returns 'mapping' as folly::Range<vector_size_t*>. Can be used by operator
@@ -90,7 +90,10 @@ void OrderBy::reclaim(
 
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
-  sortBuffer_->noMoreInput();
+  // With time slicing the rows are sorted in getOutput(), which can yield the
+  // driver thread in between.
+  sortBuffer_->noMoreInput(
+      operatorCtx_->driverCtx()->queryConfig().driverCpuTimeSliceLimitMs() > 0);
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
 }
 
@@ -99,6 +102,12 @@ RowVectorPtr OrderBy::getOutput() {
     return nullptr;
   }
 
+  if (!sortBuffer_->sortInput(
+          [&]() { return operatorCtx_->driver()->shouldYield(); })) {
+    // Returns to the driver to yield. The sorting continues on the next call.
+    return nullptr;
+  }
+
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
   return output;
@@ -15,13 +15,47 @@
  */
 #include "velox/exec/OutputBuffer.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/exec/SpillFile.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
 using core::PartitionedOutputNode;
 
+// A finished spill file with the pages written by one
+// DestinationBuffer::spill() call. The file is removed when the last page in it
+// is read back or deleted.
+class SpilledPageFile {
+ public:
+  explicit SpilledPageFile(std::string path)
+      : path_(std::move(path)),
+        file_(filesystems::getFileSystem(path_, nullptr)
+                  ->openFileForRead(path_)) {}
+
+  ~SpilledPageFile() {
+    try {
+      filesystems::getFileSystem(path_, nullptr)->remove(path_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove output buffer spill file " << path_
+                 << ": " << e.what();
+    }
+  }
+
+  std::shared_ptr<SerializedPage>
+  read(uint64_t offset, int64_t bytes, int64_t rows) const {
+    auto iobuf = folly::IOBuf::create(bytes);
+    file_->pread(offset, bytes, iobuf->writableData());
+    iobuf->append(bytes);
+    return std::make_shared<SerializedPage>(std::move(iobuf), nullptr, rows);
+  }
+
+ private:
+  const std::string path_;
+  const std::unique_ptr<ReadFile> file_;
+};
+
 void ArbitraryBuffer::noMoreData() {
   // Drop duplicate end markers.
   if (!pages_.empty() && pages_.back() == nullptr) {
@@ -92,15 +126,18 @@ void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordAcknowledge(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordAcknowledge(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
@@ -108,6 +145,10 @@ void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
   recordAcknowledge(data);
 }
 
+void DestinationBuffer::Stats::recordDelete(int64_t bytes, int64_t rows) {
+  recordAcknowledge(bytes, rows);
+}
+
 DestinationBuffer::Data DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
@@ -151,6 +192,10 @@ DestinationBuffer::Data DestinationBuffer::getData(
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
     for (; i < data_.size(); ++i) {
+      if (spilledPage(i) != nullptr) {
+        // Returned after it is read back by unspill().
+        break;
+      }
       // nullptr is used as end marker
       if (data_[i] == nullptr) {
         VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
@@ -165,10 +210,15 @@ DestinationBuffer::Data DestinationBuffer::getData(
       }
     }
   }
+  fetchedSequence_ = std::max<int64_t>(fetchedSequence_, sequence_ + i);
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
   remainingBytes.reserve(data_.size() - i);
   for (; i < data_.size(); ++i) {
+    if (const auto* spilled = spilledPage(i)) {
+      remainingBytes.push_back(spilled->bytes);
+      continue;
+    }
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
       atEnd = true;
@@ -270,6 +320,11 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
       numDeleted, data_.size(), "Ack received for a not yet produced item");
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < numDeleted; ++i) {
+    if (const auto* spilled = spilledPage(i)) {
+      stats_.recordAcknowledge(spilled->bytes, spilled->rows);
+      spilledPages_.erase(sequence_ + i);
+      continue;
+    }
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
       break;
@@ -286,6 +341,10 @@ std::vector<std::shared_ptr<SerializedPage>>
 DestinationBuffer::deleteResults() {
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < data_.size(); ++i) {
+    if (const auto* spilled = spilledPage(i)) {
+      stats_.recordDelete(spilled->bytes, spilled->rows);
+      continue;
+    }
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
       break;
@@ -294,9 +353,94 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  spilledPages_.clear();
   return freed;
 }
 
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::spill(
+    const std::string& pathPrefix,
+    const std::string& fileCreateConfig,
+    uint64_t targetBytes) {
+  // Picks the most recently enqueued pages since they are fetched last.
+  const int64_t firstUnfetched =
+      std::max<int64_t>(0, fetchedSequence_ - sequence_);
+  int64_t firstSpilled = data_.size();
+  uint64_t spillBytes{0};
+  for (int64_t i = data_.size() - 1; i >= firstUnfetched; --i) {
+    if (targetBytes != 0 && spillBytes >= targetBytes) {
+      break;
+    }
+    // Skips the end marker and the pages that are already spilled.
+    if (data_[i] != nullptr) {
+      spillBytes += data_[i]->size();
+      firstSpilled = i;
+    }
+  }
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  if (spillBytes == 0) {
+    return spilled;
+  }
+
+  auto writeFile = SpillWriteFile::create(0, pathPrefix, fileCreateConfig);
+  // Index in 'data_' and file offset of each spilled page.
+  std::vector<std::pair<size_t, uint64_t>> offsets;
+  uint64_t fileSize{0};
+  for (auto i = firstSpilled; i < data_.size(); ++i) {
+    if (data_[i] != nullptr) {
+      offsets.emplace_back(i, fileSize);
+      fileSize += writeFile->write(data_[i]->getIOBuf());
+    }
+  }
+  writeFile->finish();
+
+  auto file = std::make_shared<SpilledPageFile>(writeFile->path());
+  spilled.reserve(offsets.size());
+  for (const auto& [index, offset] : offsets) {
+    auto& page = data_[index];
+    spilledPages_.emplace(
+        sequence_ + index,
+        SpilledPage{
+            file,
+            offset,
+            static_cast<int64_t>(page->size()),
+            page->numRows().value()});
+    spilled.push_back(std::move(page));
+  }
+  return spilled;
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::unspill(
+    int64_t sequence,
+    uint64_t maxBytes) {
+  std::vector<std::shared_ptr<SerializedPage>> unspilled;
+  if (spilledPages_.empty() || sequence < sequence_) {
+    return unspilled;
+  }
+  uint64_t bytes{0};
+  for (auto i = sequence - sequence_; i < data_.size() && bytes < maxBytes;
+       ++i) {
+    if (const auto* spilled = spilledPage(i)) {
+      data_[i] = spilled->file->read(
+          spilled->offset, spilled->bytes, spilled->rows);
+      spilledPages_.erase(sequence_ + i);
+      unspilled.push_back(data_[i]);
+    } else if (data_[i] == nullptr) {
+      break;
+    }
+    bytes += data_[i]->size();
+  }
+  return unspilled;
+}
+
+const DestinationBuffer::SpilledPage* DestinationBuffer::spilledPage(
+    size_t index) const {
+  if (spilledPages_.empty()) {
+    return nullptr;
+  }
+  auto it = spilledPages_.find(sequence_ + index);
+  return it == spilledPages_.end() ? nullptr : &it->second;
+}
+
 DestinationBuffer::Stats DestinationBuffer::stats() const {
   return stats_;
 }
@@ -304,7 +448,8 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+      << ", " << "spilled: " << spilledPages_.size() << ", "
+      << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
 }
 
@@ -433,6 +578,19 @@ void OutputBuffer::updateStatsWithFreedPagesLocked(
   VELOX_CHECK_GE(bufferedPages_, 0);
 }
 
+void OutputBuffer::updateStatsWithUnspilledPagesLocked(
+    const std::vector<std::shared_ptr<SerializedPage>>& pages) {
+  if (pages.empty()) {
+    return;
+  }
+  updateTotalBufferedBytesMsLocked();
+
+  for (const auto& page : pages) {
+    bufferedBytes_ += page->size();
+  }
+  bufferedPages_ += pages.size();
+}
+
 void OutputBuffer::updateTotalBufferedBytesMsLocked() {
   const auto nowMs = getCurrentTimeMs();
   if (bufferedBytes_ > 0) {
@@ -733,6 +891,7 @@ void OutputBuffer::getData(
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
       updateAfterAcknowledgeLocked(freed, promises);
+      updateStatsWithUnspilledPagesLocked(buffer->unspill(sequence, maxBytes));
       data = buffer->getData(
           maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
     } else {
@@ -761,6 +920,75 @@ void OutputBuffer::terminate() {
   }
 }
 
+uint64_t OutputBuffer::spill(
+    const common::SpillConfig& spillConfig,
+    uint64_t targetBytes,
+    common::SpillStats& stats) {
+  if (!isPartitioned()) {
+    return 0;
+  }
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  std::vector<ContinuePromise> promises;
+  uint64_t spilledBytes{0};
+  uint64_t spillTimeUs{0};
+  {
+    MicrosecondTimer timer(&spillTimeUs);
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto spillDir = spillConfig.getSpillDirPathCb();
+    VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
+
+    // Spills from the destinations with the most buffered data first.
+    std::vector<int32_t> destinations;
+    destinations.reserve(buffers_.size());
+    for (auto i = 0; i < buffers_.size(); ++i) {
+      if (buffers_[i] != nullptr) {
+        destinations.push_back(i);
+      }
+    }
+    std::sort(
+        destinations.begin(), destinations.end(), [&](auto lhs, auto rhs) {
+          return buffers_[lhs]->stats().bytesBuffered >
+              buffers_[rhs]->stats().bytesBuffered;
+        });
+    for (const auto destination : destinations) {
+      if (targetBytes != 0 && spilledBytes >= targetBytes) {
+        break;
+      }
+      auto pages = buffers_[destination]->spill(
+          fmt::format(
+              "{}/{}-output-{}",
+              spillDir,
+              spillConfig.fileNamePrefix,
+              destination),
+          spillConfig.fileCreateConfig,
+          targetBytes == 0 ? 0 : targetBytes - spilledBytes);
+      if (pages.empty()) {
+        continue;
+      }
+      ++stats.spilledFiles;
+      ++stats.spilledPartitions;
+      for (auto& page : pages) {
+        spilledBytes += page->size();
+        stats.spilledRows += page->numRows().value();
+        ++stats.spillWrites;
+        spilled.push_back(std::move(page));
+      }
+    }
+    if (spilled.empty()) {
+      return 0;
+    }
+    updateAfterAcknowledgeLocked(spilled, promises);
+  }
+  ++stats.spillRuns;
+  stats.spilledInputBytes += spilledBytes;
+  stats.spilledBytes += spilledBytes;
+  stats.spillWriteTimeNanos += spillTimeUs * 1'000;
+
+  releaseAfterAcknowledge(spilled, promises);
+  spillConfig.updateAndCheckSpillLimitCb(spilledBytes);
+  return spilledBytes;
+}
+
 std::string OutputBuffer::toString() {
   std::lock_guard<std::mutex> l(mutex_);
   return toStringLocked();
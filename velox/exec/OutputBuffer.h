@@ -15,11 +15,17 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SpillConfig.h"
+#include "velox/common/base/SpillStats.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
 namespace facebook::velox::exec {
 
+class SpilledPageFile;
+
 /// nullptr in pages indicates that there is no more data.
 /// sequence is the same as specified in BufferManager::getData call. The
 /// caller is expected to advance sequence by the number of entries in groups
@@ -102,8 +108,12 @@ class DestinationBuffer {
 
     void recordAcknowledge(const SerializedPage& data);
 
+    void recordAcknowledge(int64_t bytes, int64_t rows);
+
     void recordDelete(const SerializedPage& data);
 
+    void recordDelete(int64_t bytes, int64_t rows);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -172,6 +182,29 @@ class DestinationBuffer {
   /// Removes all remaining data from the queue and returns the removed data.
   std::vector<std::shared_ptr<SerializedPage>> deleteResults();
 
+  /// Writes the buffered pages that have not been fetched yet to a new spill
+  /// file with 'pathPrefix', starting from the most recently enqueued ones,
+  /// until at least 'targetBytes' are written. Spills all of them if
+  /// 'targetBytes' is zero. Returns the spilled pages, which are freed by the
+  /// caller. The spilled pages keep their sequence numbers and are read back
+  /// by unspill().
+  std::vector<std::shared_ptr<SerializedPage>> spill(
+      const std::string& pathPrefix,
+      const std::string& fileCreateConfig,
+      uint64_t targetBytes);
+
+  /// Reads back the spilled pages that getData() returns for 'sequence' and
+  /// 'maxBytes'. Returns the pages read back. getData() does not return a
+  /// spilled page before it is read back but counts it in the remaining bytes.
+  std::vector<std::shared_ptr<SerializedPage>> unspill(
+      int64_t sequence,
+      uint64_t maxBytes);
+
+  /// Returns the number of pages that are spilled and not yet read back.
+  size_t numSpilledPages() const {
+    return spilledPages_.size();
+  }
+
   /// Returns and clears the notify callback, if any, along with arguments for
   /// the callback.
   DataAvailable getAndClearNotify();
@@ -185,11 +218,33 @@ class DestinationBuffer {
   std::string toString();
 
  private:
+  // A page written to 'file' at 'offset'. Its entry in 'data_' is nullptr.
+  struct SpilledPage {
+    std::shared_ptr<SpilledPageFile> file;
+    uint64_t offset;
+    int64_t bytes;
+    int64_t rows;
+  };
+
   void clearNotify();
 
+  // Returns the spilled page at 'index' in 'data_' or nullptr if the page is
+  // in memory.
+  const SpilledPage* spilledPage(size_t index) const;
+
+  // Returns true if the entry at 'index' in 'data_' is the end marker.
+  bool isEndMarker(size_t index) const {
+    return data_[index] == nullptr && spilledPage(index) == nullptr;
+  }
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The sequence number after the last page returned by getData(). Pages from
+  // this sequence number on have not been fetched and can be spilled.
+  int64_t fetchedSequence_{0};
+  // The spilled pages keyed by sequence number.
+  folly::F14FastMap<int64_t, SpilledPage> spilledPages_;
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
@@ -310,6 +365,18 @@ class OutputBuffer {
   /// has an error or cancellation.
   void terminate();
 
+  /// Spills the pages that have not been fetched by the consumers to files in
+  /// the spill directory of 'spillConfig' until at least 'targetBytes' are
+  /// spilled, or all of them if 'targetBytes' is zero. The spilled pages are
+  /// read back when fetched. Continues the blocked producers if the buffered
+  /// bytes drop below the continue size. Only applies to partitioned output.
+  /// The pages of broadcast and arbitrary output are shared by destinations
+  /// and are left in memory. Returns the number of spilled bytes.
+  uint64_t spill(
+      const common::SpillConfig& spillConfig,
+      uint64_t targetBytes,
+      common::SpillStats& stats);
+
   std::string toString();
 
   /// Gets the memory utilization ratio in this output buffer.
@@ -333,6 +400,10 @@ class OutputBuffer {
 
   void updateStatsWithFreedPagesLocked(int numPages, int64_t pageBytes);
 
+  // Adds back the pages read back from spill files to the buffered size.
+  void updateStatsWithUnspilledPagesLocked(
+      const std::vector<std::shared_ptr<SerializedPage>>& pages);
+
   void updateTotalBufferedBytesMsLocked();
 
   int64_t getAverageBufferTimeMsLocked() const;
@@ -23,10 +23,16 @@ namespace {
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     const core::QueryConfig& queryConfig,
     VectorSerde::Kind kind) {
-  std::unique_ptr<VectorSerde::Options> options =
-      kind == VectorSerde::Kind::kPresto
-      ? std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>()
-      : std::make_unique<VectorSerde::Options>();
+  std::unique_ptr<VectorSerde::Options> options;
+  if (kind == VectorSerde::Kind::kPresto) {
+    auto prestoOptions = std::make_unique<
+        serializer::presto::PrestoVectorSerde::PrestoOptions>();
+    prestoOptions->dictionaryEncodeStrings =
+        queryConfig.shuffleDictionaryEncodingEnabled();
+    options = std::move(prestoOptions);
+  } else {
+    options = std::make_unique<VectorSerde::Options>();
+  }
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   options->minCompressionRatio = PartitionedOutput::minCompressionRatio();
@@ -42,6 +48,7 @@ Destination::Destination(
     VectorSerde::Options* serdeOptions,
     memory::MemoryPool* pool,
     bool eagerFlush,
+    bool zeroCopyFlush,
     std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
     : taskId_(taskId),
       destination_(destination),
@@ -49,6 +56,8 @@ Destination::Destination(
       serdeOptions_(serdeOptions),
       pool_(pool),
       eagerFlush_(eagerFlush),
+      zeroCopyFlush_(
+          zeroCopyFlush && serde->kind() == VectorSerde::Kind::kPresto),
       recordEnqueued_(std::move(recordEnqueued)),
       rows_(raw_vector<vector_size_t>(pool)) {
   setTargetSizePct();
@@ -66,7 +75,7 @@ BlockingReason Destination::advance(
     ContinueFuture* future,
     Scratch& scratch) {
   VELOX_CHECK_LE(!!outputCompactRow + !!outputUnsafeRow, 1);
-  if (rowIdx_ >= rows_.size()) {
+  if (rowIdx_ >= batchRows_.size()) {
     *atEnd = true;
     return BlockingReason::kNotBlocked;
   }
@@ -79,8 +88,8 @@ BlockingReason Destination::advance(
 
   // Collect rows to serialize.
   bool shouldFlush = false;
-  while (rowIdx_ < rows_.size() && !shouldFlush) {
-    bytesInCurrent_ += sizes[rows_[rowIdx_]];
+  while (rowIdx_ < batchRows_.size() && !shouldFlush) {
+    bytesInCurrent_ += sizes[batchRows_[rowIdx_]];
     ++rowIdx_;
     ++rowsInCurrent_;
     shouldFlush =
@@ -89,12 +98,12 @@ BlockingReason Destination::advance(
 
   // Serialize
   if (current_ == nullptr) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
+    current_ = std::make_shared<VectorStreamGroup>(pool_, serde_);
     const auto rowType = asRowType(output->type());
     current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
   }
 
-  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
+  const auto rows = batchRows_.subpiece(firstRow, rowIdx_ - firstRow);
   if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
     VELOX_CHECK_NOT_NULL(outputCompactRow);
     current_->append(*outputCompactRow, rows, sizes);
@@ -107,7 +116,7 @@ BlockingReason Destination::advance(
   }
 
   // Update output state variable.
-  if (rowIdx_ == rows_.size()) {
+  if (rowIdx_ == batchRows_.size()) {
     *atEnd = true;
   }
   if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
@@ -127,16 +136,33 @@ BlockingReason Destination::flush(
   // Upper limit of message size with no columns.
   constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
-  IOBufOutputStream stream(
-      *current_->pool(),
-      listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
   const int64_t flushedRows = rowsInCurrent_;
+  std::unique_ptr<IOBufOutputStream> stream;
+  if (zeroCopyFlush_) {
+    // Only the headers are written to 'stream'. The pages keep 'current_'
+    // alive and a new one is made for the next rows.
+    stream = std::make_unique<IOBufOutputStream>(
+        *current_->pool(), listener.get(), kMinMessageSize, current_);
+    current_->flush(stream.get());
+    for (auto& [name, counter] : current_->runtimeStats()) {
+      auto it = flushedSerializerStats_.find(name);
+      if (it == flushedSerializerStats_.end()) {
+        flushedSerializerStats_.emplace(name, counter);
+      } else {
+        it->second.value += counter.value;
+      }
+    }
+    current_.reset();
+  } else {
+    stream = std::make_unique<IOBufOutputStream>(
+        *current_->pool(),
+        listener.get(),
+        std::max<int64_t>(kMinMessageSize, current_->size()));
+    current_->flush(stream.get());
+    current_->clear();
+  }
 
-  current_->flush(&stream);
-  current_->clear();
-
-  const int64_t flushedBytes = stream.tellp();
+  const int64_t flushedBytes = stream->tellp();
 
   bytesInCurrent_ = 0;
   rowsInCurrent_ = 0;
@@ -146,7 +172,7 @@ BlockingReason Destination::flush(
       taskId_,
       destination_,
       std::make_unique<SerializedPage>(
-          stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows),
+          stream->getIOBuf(bufferReleaseFn), nullptr, flushedRows),
       future);
 
   recordEnqueued_(flushedBytes, flushedRows);
@@ -157,8 +183,18 @@ BlockingReason Destination::flush(
 
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
+  auto serializerStats = flushedSerializerStats_;
   if (current_) {
-    const auto serializerStats = current_->runtimeStats();
+    for (auto& [name, counter] : current_->runtimeStats()) {
+      auto it = serializerStats.find(name);
+      if (it == serializerStats.end()) {
+        serializerStats.emplace(name, counter);
+      } else {
+        it->second.value += counter.value;
+      }
+    }
+  }
+  if (!serializerStats.empty()) {
     auto lockedStats = op->stats().wlock();
     for (auto& pair : serializerStats) {
       lockedStats->addRuntimeStat(pair.first, pair.second);
@@ -178,7 +214,10 @@ PartitionedOutput::PartitionedOutput(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "PartitionedOutput"),
+          "PartitionedOutput",
+          planNode->canSpill(ctx->queryConfig())
+              ? ctx->makeSpillConfig(operatorId)
+              : std::nullopt),
       keyChannels_(toChannels(planNode->inputType(), planNode->keys())),
       numDestinations_(planNode->numPartitions()),
       replicateNullsAndAny_(planNode->isReplicateNullsAndAny()),
@@ -201,6 +240,9 @@ PartitionedOutput::PartitionedOutput(
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
       eagerFlush_(eagerFlush),
+      zeroCopyFlush_(ctx->task->queryCtx()
+                         ->queryConfig()
+                         .partitionedOutputZeroCopyFlush()),
       serde_(getNamedVectorSerde(planNode->serdeKind())),
       serdeOptions_(getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
@@ -211,6 +253,16 @@ PartitionedOutput::PartitionedOutput(
   if (numDestinations_ == 1) {
     VELOX_USER_CHECK(keyChannels_.empty());
     VELOX_USER_CHECK_NULL(partitionFunction_);
+  } else if (planNode->rebalanceSkewedPartitions()) {
+    const auto& queryConfig = ctx->queryConfig();
+    partitionRebalancer_ = std::make_unique<common::SkewedPartitionRebalancer>(
+        numDestinations_,
+        numDestinations_,
+        queryConfig.partitionedOutputMinPartitionRebalanceBytes(),
+        queryConfig.partitionedOutputMinRebalanceBytes());
+    partitionRowCounts_.resize(numDestinations_, 0);
+    partitionDestinations_.resize(numDestinations_, -1);
+    partitionBatchIndexes_.resize(numDestinations_, 0);
   }
 }
 
@@ -263,6 +315,7 @@ void PartitionedOutput::initializeDestinations() {
           serdeOptions_.get(),
           pool(),
           eagerFlush_,
+          zeroCopyFlush_,
           [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
@@ -344,17 +397,89 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
           }
         }
       }
+    } else if (partitionRebalancer_ != nullptr) {
+      assignRebalancedDestinations(singlePartition, numInput);
+      partitionRows(numInput);
     } else {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+        partitionRows(numInput);
       }
     }
   }
+
+  pendingDestinations_.clear();
+  for (auto i = 0; i < numDestinations_; ++i) {
+    if (destinations_[i]->hasRowsLeft()) {
+      pendingDestinations_.push_back(i);
+    }
+  }
+}
+
+void PartitionedOutput::partitionRows(vector_size_t numInput) {
+  partitionOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionOffsets_[partitions_[i] + 1];
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionOffsets_[i + 1] += partitionOffsets_[i];
+  }
+  partitionedRows_.resize(numInput);
+  // Rows are placed in increasing order, like addRow() would add them.
+  // 'partitionOffsets_[p]' is the next free slot of partition p and ends at
+  // the start of partition p + 1.
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    partitionedRows_[partitionOffsets_[partitions_[i]]++] = i;
+  }
+  vector_size_t start = 0;
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto end = partitionOffsets_[i];
+    if (end > start) {
+      destinations_[i]->setRows(
+          folly::Range(partitionedRows_.data() + start, end - start));
+    }
+    start = end;
+  }
+}
+
+void PartitionedOutput::assignRebalancedDestinations(
+    std::optional<uint32_t> singlePartition,
+    vector_size_t numInput) {
+  if (singlePartition.has_value()) {
+    partitions_.resize(numInput);
+    std::fill_n(partitions_.begin(), numInput, singlePartition.value());
+  }
+
+  // The load of a partition is measured by the estimated serialized bytes of
+  // its rows.
+  int64_t inputBytes = 0;
+  std::fill(partitionRowCounts_.begin(), partitionRowCounts_.end(), 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionRowCounts_[partitions_[i]];
+    inputBytes += rowSize_[i];
+  }
+  for (auto partition = 0; partition < numDestinations_; ++partition) {
+    if (partitionRowCounts_[partition] > 0) {
+      partitionRebalancer_->addPartitionRowCount(
+          partition, partitionRowCounts_[partition]);
+    }
+  }
+  if (inputBytes > 0) {
+    partitionRebalancer_->addProcessedBytes(inputBytes);
+  }
+  partitionRebalancer_->rebalance();
+
+  std::fill(partitionDestinations_.begin(), partitionDestinations_.end(), -1);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    const auto partition = partitions_[i];
+    if (partitionDestinations_[partition] == -1) {
+      partitionDestinations_[partition] = partitionRebalancer_->getTaskId(
+          partition, partitionBatchIndexes_[partition]++);
+    }
+    partitions_[i] = partitionDestinations_[partition];
+  }
 }
 
 void PartitionedOutput::collectNullRows() {
@@ -407,7 +532,11 @@ RowVectorPtr PartitionedOutput::getOutput() {
   bool workLeft;
   do {
     workLeft = false;
-    for (auto& destination : destinations_) {
+    // Destinations that reached the end of their rows are dropped from
+    // 'pendingDestinations_'. The order of the others is kept.
+    size_t numPending = 0;
+    for (size_t i = 0; i < pendingDestinations_.size(); ++i) {
+      auto* destination = destinations_[pendingDestinations_[i]].get();
       bool atEnd = false;
       blockingReason_ = destination->advance(
           maxPageSize,
@@ -421,17 +550,26 @@ RowVectorPtr PartitionedOutput::getOutput() {
           &future_,
           scratch_);
       if (blockingReason_ != BlockingReason::kNotBlocked) {
-        blockedDestination = destination.get();
+        blockedDestination = destination;
         workLeft = false;
         // We stop on first blocked. Adding data to unflushed targets
         // would be possible but could allocate memory. We wait for
         // free space in the outgoing queue.
+        if (numPending < i) {
+          std::copy(
+              pendingDestinations_.begin() + i,
+              pendingDestinations_.end(),
+              pendingDestinations_.begin() + numPending);
+        }
+        numPending += pendingDestinations_.size() - i;
         break;
       }
       if (!atEnd) {
         workLeft = true;
+        pendingDestinations_[numPending++] = pendingDestinations_[i];
       }
     }
+    pendingDestinations_.resize(numPending);
   } while (workLeft);
 
   if (blockedDestination) {
@@ -475,6 +613,25 @@ bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+void PartitionedOutput::reclaim(
+    uint64_t targetBytes,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  auto bufferManager = bufferManager_.lock();
+  if (bufferManager == nullptr) {
+    return;
+  }
+  // The output buffer is shared by all the drivers of the task. The pages
+  // spilled from it free memory in the pools of the drivers that produced them.
+  auto buffer = bufferManager->getBufferIfExists(operatorCtx_->taskId());
+  if (buffer == nullptr) {
+    return;
+  }
+  common::SpillStats spillStats;
+  buffer->spill(*spillConfig(), targetBytes, spillStats);
+  *spillStats_.wlock() += spillStats;
+}
+
 void PartitionedOutput::close() {
   Operator::close();
   {
@@ -485,6 +642,19 @@ void PartitionedOutput::close() {
     lockedStats->addRuntimeStat(
         Operator::kShuffleCompressionKind,
         RuntimeCounter(static_cast<int64_t>(serdeOptions_->compressionKind)));
+    if (partitionRebalancer_ != nullptr) {
+      const auto rebalanceStats = partitionRebalancer_->stats();
+      if (rebalanceStats.numBalanceTriggers != 0) {
+        lockedStats->addRuntimeStat(
+            kRebalanceTriggers,
+            RuntimeCounter(rebalanceStats.numBalanceTriggers));
+      }
+      if (rebalanceStats.numScaledPartitions != 0) {
+        lockedStats->addRuntimeStat(
+            kScaledPartitions,
+            RuntimeCounter(rebalanceStats.numScaledPartitions));
+      }
+    }
   }
   destinations_.clear();
 }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <folly/Random.h>
+#include "velox/common/base/SkewedPartitionBalancer.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/row/CompactRow.h"
@@ -36,22 +37,38 @@ class Destination {
       VectorSerde::Options* options,
       memory::MemoryPool* pool,
       bool eagerFlush,
+      bool zeroCopyFlush,
       std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued);
 
   /// Resets the destination before starting a new batch.
   void beginBatch() {
     rows_.clear();
+    batchRows_ = {};
     rowIdx_ = 0;
   }
 
   void addRow(vector_size_t row) {
     rows_.push_back(row);
+    batchRows_ = folly::Range(rows_.data(), rows_.size());
   }
 
   void addRows(const IndexRange& rows) {
     for (auto i = 0; i < rows.size; ++i) {
       rows_.push_back(rows.begin + i);
     }
+    batchRows_ = folly::Range(rows_.data(), rows_.size());
+  }
+
+  /// Sets the rows of the batch to 'rows' instead of adding them one by one.
+  /// 'rows' must stay valid until the next beginBatch().
+  void setRows(folly::Range<const vector_size_t*> rows) {
+    VELOX_DCHECK(rows_.empty());
+    batchRows_ = rows;
+  }
+
+  /// Returns true if the batch has rows that are not serialized yet.
+  bool hasRowsLeft() const {
+    return rowIdx_ < batchRows_.size();
   }
 
   /// Serializes row from 'output' till either 'maxBytes' have been serialized
@@ -108,20 +125,29 @@ class Destination {
   VectorSerde::Options* const serdeOptions_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  // If true, the serialized pages reference the memory of 'current_' instead
+  // of a copy. 'current_' is then handed over to the pages on flush and
+  // released when the pages are freed.
+  const bool zeroCopyFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
   // Number of rows serialized in 'current_'
   vector_size_t rowsInCurrent_{0};
+  // The rows added by addRow() and addRows().
   raw_vector<vector_size_t> rows_;
+  // The rows of the batch, in 'rows_' or in the buffer passed to setRows().
+  folly::Range<const vector_size_t*> batchRows_;
 
-  // First index of 'rows_' that is not appended to 'current_'.
+  // First index of 'batchRows_' that is not appended to 'current_'.
   vector_size_t rowIdx_{0};
 
   // The current stream where the input is serialized to. This is cleared on
-  // every flush() call.
-  std::unique_ptr<VectorStreamGroup> current_;
+  // every flush() call, or replaced if 'zeroCopyFlush_' is true.
+  std::shared_ptr<VectorStreamGroup> current_;
+  // Serializer stats of the streams replaced by zero copy flushes.
+  std::unordered_map<std::string, RuntimeCounter> flushedSerializerStats_;
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -183,6 +209,12 @@ class PartitionedOutput : public Operator {
 
   bool isFinished() override;
 
+  /// Spills the pages of the task's output buffer that are not yet fetched by
+  /// the consumers. Only applies to partitioned output with
+  /// 'partitioned_output_spill_enabled' set.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override;
 
   static void testingSetMinCompressionRatio(float ratio) {
@@ -193,6 +225,12 @@ class PartitionedOutput : public Operator {
     return minCompressionRatio_;
   }
 
+  /// The names of the runtime stats of skewed partition rebalancing.
+  /// The number of times that the partitions are rebalanced.
+  static inline const std::string kRebalanceTriggers{"rebalanceTriggers"};
+  /// The number of times that a partition is spread over one more destination.
+  static inline const std::string kScaledPartitions{"scaledPartitions"};
+
  private:
   void initializeInput(RowVectorPtr input);
 
@@ -205,6 +243,19 @@ class PartitionedOutput : public Operator {
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Groups the rows of the input by their partition in 'partitions_' with a
+  // counting sort into 'partitionedRows_' and sets the rows of each
+  // destination to its range, instead of adding each row to its destination.
+  void partitionRows(vector_size_t numInput);
+
+  // Replaces the partition of each row in 'partitions_', or all rows if
+  // 'singlePartition' is set, with the destination 'partitionRebalancer_'
+  // assigns to it. All rows of a partition in a batch go to the same
+  // destination. The destinations of a skewed partition take turns per batch.
+  void assignRebalancedDestinations(
+      std::optional<uint32_t> singlePartition,
+      vector_size_t numInput);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -213,12 +264,16 @@ class PartitionedOutput : public Operator {
   const int numDestinations_;
   const bool replicateNullsAndAny_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // Set if the plan node rebalances skewed partitions. Maps the partitions of
+  // 'partitionFunction_' to destinations.
+  std::unique_ptr<common::SkewedPartitionRebalancer> partitionRebalancer_;
   // Empty if column order in the output is exactly the same as in input.
   const std::vector<column_index_t> outputChannels_;
   const std::weak_ptr<exec::OutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool zeroCopyFlush_;
   VectorSerde* const serde_;
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
@@ -248,6 +303,18 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // The rows of the input grouped by partition and the start of the rows of
+  // each partition in it.
+  std::vector<vector_size_t> partitionedRows_;
+  std::vector<vector_size_t> partitionOffsets_;
+  // The destinations that have rows of the current input to serialize, so
+  // that getOutput() does not visit the other destinations.
+  std::vector<int32_t> pendingDestinations_;
+  // The number of rows, the destination in the current batch and the number
+  // of batches of each partition for 'partitionRebalancer_'.
+  std::vector<uint32_t> partitionRowCounts_;
+  std::vector<int32_t> partitionDestinations_;
+  std::vector<uint64_t> partitionBatchIndexes_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
@@ -17,6 +17,8 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/exec/TaskStats.h"
 
+#include <map>
+
 namespace facebook::velox::exec {
 
 PlanNodeStats& PlanNodeStats::operator+=(const PlanNodeStats& another) {
@@ -45,6 +47,11 @@ PlanNodeStats& PlanNodeStats::operator+=(const PlanNodeStats& another) {
 
   backgroundTiming.add(another.backgroundTiming);
 
+  perfCounters.add(another.perfCounters);
+  for (const auto& [name, histogram] : another.ioLatencyHistograms) {
+    ioLatencyHistograms[name].merge(histogram);
+  }
+
   blockedWallNanos += another.blockedWallNanos;
 
   peakMemoryBytes += another.peakMemoryBytes;
@@ -117,6 +124,11 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
 
   backgroundTiming.add(stats.backgroundTiming);
 
+  perfCounters.add(stats.perfCounters);
+  for (const auto& [name, histogram] : stats.ioLatencyHistograms) {
+    ioLatencyHistograms[name].merge(histogram);
+  }
+
   blockedWallNanos += stats.blockedWallNanos;
 
   peakMemoryBytes += stats.memoryStats.peakTotalMemoryReservation;
@@ -199,6 +211,25 @@ std::string PlanNodeStats::toString(
              succinctNanos(getOutputTiming.cpuNanos),
              succinctNanos(finishTiming.cpuNanos));
 
+  if (!perfCounters.empty()) {
+    out << ", Perf counters: (" << perfCounters.toString() << ")";
+  }
+
+  if (!ioLatencyHistograms.empty()) {
+    // Sorted by name for a stable output.
+    std::map<std::string, const io::IoLatencyHistogram*> sorted;
+    for (const auto& [name, histogram] : ioLatencyHistograms) {
+      sorted.emplace(name, &histogram);
+    }
+    out << ", I/O latency: (";
+    bool first = true;
+    for (const auto& [name, histogram] : sorted) {
+      out << (first ? "" : ", ") << name << ": " << histogram->toString();
+      first = false;
+    }
+    out << ")";
+  }
+
   if (includeRuntimeStats) {
     out << ", Runtime stats: (";
     for (const auto& [name, metric] : customStats) {
@@ -264,6 +295,17 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["getOutputTiming"] = operatorStat.second->getOutputTiming.toString();
       stat["finishTiming"] = operatorStat.second->finishTiming.toString();
       stat["cpuWallTiming"] = operatorStat.second->cpuWallTiming.toString();
+      if (!operatorStat.second->perfCounters.empty()) {
+        stat["perfCounters"] = operatorStat.second->perfCounters.toString();
+      }
+      if (!operatorStat.second->ioLatencyHistograms.empty()) {
+        folly::dynamic latencies = folly::dynamic::object;
+        for (const auto& [name, histogram] :
+             operatorStat.second->ioLatencyHistograms) {
+          latencies[name] = histogram.toString();
+        }
+        stat["ioLatencyHistograms"] = latencies;
+      }
       stat["blockedWallNanos"] = operatorStat.second->blockedWallNanos;
       stat["peakMemoryBytes"] = operatorStat.second->peakMemoryBytes;
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
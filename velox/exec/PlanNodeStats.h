@@ -104,6 +104,14 @@ struct PlanNodeStats {
   /// operators.
   CpuWallTiming backgroundTiming;
 
+  /// Sum of the hardware performance counters of the sampled addInput and
+  /// getOutput calls for all corresponding operators.
+  process::PerfCounters perfCounters;
+
+  /// Latency histograms of the reads of all corresponding TableScan operators
+  /// per cache tier and storage type.
+  std::unordered_map<std::string, io::IoLatencyHistogram> ioLatencyHistograms;
+
   /// Sum of blocked wall time for all corresponding operators.
   uint64_t blockedWallNanos{0};
 
@@ -105,6 +105,41 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
   }
 }
 
+template <typename T>
+void encodeDecodedColumn(
+    const PrefixSortLayout& layout,
+    uint32_t index,
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    uint32_t prefixSize,
+    char* prefixes) {
+  const auto& encoder = layout.encoders[index];
+  const auto encodeSize = layout.encodeSizes[index];
+  const auto hasNullByte = layout.normalizedKeyHasNullByte[index];
+  char* dest = prefixes + layout.prefixOffsets[index];
+  for (vector_size_t row = 0; row < numRows; ++row, dest += prefixSize) {
+    if constexpr (std::is_same_v<T, StringView>) {
+      if (hasNullByte && decoded.isNullAt(row)) {
+        dest[0] = encoder.isNullsFirst() ? 0 : 1;
+        simd::memset(dest + 1, 0, encodeSize - 1);
+      } else if (hasNullByte) {
+        dest[0] = encoder.isNullsFirst() ? 1 : 0;
+        encoder.encodeContiguousNoNulls(
+            decoded.valueAt<StringView>(row), dest + 1, encodeSize - 1);
+      } else {
+        encoder.encodeContiguousNoNulls(
+            decoded.valueAt<StringView>(row), dest, encodeSize);
+      }
+    } else {
+      std::optional<T> value;
+      if (!decoded.isNullAt(row)) {
+        value = decoded.valueAt<T>(row);
+      }
+      encoder.encode(value, dest, encodeSize, hasNullByte);
+    }
+  }
+}
+
 FOLLY_ALWAYS_INLINE int32_t alignmentPadding(int32_t size, int32_t alignment) {
   const auto extra = size % alignment;
   return extra == 0 ? 0 : alignment - extra;
@@ -277,8 +312,12 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
 PrefixSort::PrefixSort(
     const RowContainer* rowContainer,
     const PrefixSortLayout& sortLayout,
+    const velox::common::PrefixSortConfig& config,
     memory::MemoryPool* pool)
-    : rowContainer_(rowContainer), sortLayout_(sortLayout), pool_(pool) {}
+    : rowContainer_(rowContainer),
+      sortLayout_(sortLayout),
+      maxRadixSortKeyBytes_(config.maxRadixSortKeyBytes),
+      pool_(pool) {}
 
 void PrefixSort::extractRowAndEncodePrefixKeys(char* row, char* prefixBuffer) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
@@ -324,7 +363,7 @@ uint32_t PrefixSort::maxRequiredBytes(
     return 0;
   }
 
-  const PrefixSort prefixSort(rowContainer, sortLayout, pool);
+  const PrefixSort prefixSort(rowContainer, sortLayout, config, pool);
   return prefixSort.maxRequiredBytes();
 }
 
@@ -349,13 +388,21 @@ uint32_t PrefixSort::maxRequiredBytes() const {
   const auto numRows = rowContainer_->numRows();
   const auto numPages =
       memory::AllocationTraits::numPages(numRows * sortLayout_.entrySize);
+  // Radix sort needs a second prefix buffer.
+  const auto numPrefixBuffers = useRadixSort(numRows) ? 2 : 1;
   // Prefix data size + swap buffer size.
-  return memory::AllocationTraits::pageBytes(numPages) +
+  return numPrefixBuffers * memory::AllocationTraits::pageBytes(numPages) +
       pool_->preferredSize(checkedPlus<size_t>(
           sortLayout_.entrySize, AlignedBuffer::kPaddedSize)) +
       2 * pool_->alignment();
 }
 
+bool PrefixSort::useRadixSort(uint64_t numRows) const {
+  return numRows >= kMinRadixSortRows && !sortLayout_.hasNonNormalizedKey &&
+      sortLayout_.nonPrefixSortStartIndex == sortLayout_.numNormalizedKeys &&
+      sortLayout_.normalizedBufferSize <= maxRadixSortKeyBytes_;
+}
+
 void PrefixSort::sortInternal(
     std::vector<char*, memory::StlAllocator<char*>>& rows) {
   const auto numRows = rows.size();
@@ -387,7 +434,21 @@ void PrefixSort::sortInternal(
           RuntimeCounter(
               sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
     }
-    if (sortLayout_.hasNonNormalizedKey ||
+    if (useRadixSort(numRows)) {
+      memory::ContiguousAllocation radixBufferAlloc;
+      pool_->allocateContiguous(
+          memory::AllocationTraits::numPages(numRows * entrySize),
+          radixBufferAlloc);
+      sortRunner.radixSort(
+          prefixBufferStart,
+          prefixBufferEnd,
+          sortLayout_.normalizedBufferSize,
+          radixBufferAlloc.data<char>());
+      addThreadLocalRuntimeStat(
+          PrefixSort::kNumRadixSorts,
+          RuntimeCounter(1, RuntimeCounter::Unit::kNone));
+    } else if (
+        sortLayout_.hasNonNormalizedKey ||
         sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys) {
       sortRunner.quickSort(
           prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
@@ -407,4 +468,95 @@ void PrefixSort::sortInternal(
   }
 }
 
+// static
+std::unique_ptr<PrefixSortKeyEncoder> PrefixSortKeyEncoder::create(
+    const std::vector<TypePtr>& keyTypes,
+    const std::vector<CompareFlags>& compareFlags,
+    const velox::common::PrefixSortConfig& config) {
+  VELOX_CHECK_EQ(keyTypes.size(), compareFlags.size());
+  // Input columns may have nulls and strings of any length.
+  auto layout = PrefixSortLayout::generate(
+      keyTypes,
+      std::vector<bool>(keyTypes.size(), true),
+      compareFlags,
+      config.maxNormalizedKeyBytes,
+      config.maxStringPrefixLength,
+      std::vector<std::optional<uint32_t>>(keyTypes.size(), std::nullopt));
+  if (!layout.hasNormalizedKeys) {
+    return nullptr;
+  }
+  return std::make_unique<PrefixSortKeyEncoder>(std::move(layout));
+}
+
+PrefixSortKeyEncoder::PrefixSortKeyEncoder(PrefixSortLayout layout)
+    : layout_(std::move(layout)),
+      prefixSize_(layout_.normalizedBufferSize - layout_.numPaddingBytes) {}
+
+void PrefixSortKeyEncoder::encode(
+    const std::vector<const DecodedVector*>& keys,
+    vector_size_t numRows,
+    char* prefixes) const {
+  VELOX_CHECK_EQ(keys.size(), layout_.numKeys);
+  for (auto i = 0; i < layout_.numNormalizedKeys; ++i) {
+    const auto& decoded = *keys[i];
+    switch (decoded.base()->typeKind()) {
+      case TypeKind::SMALLINT:
+        encodeDecodedColumn<int16_t>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::INTEGER:
+        encodeDecodedColumn<int32_t>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::BIGINT:
+        encodeDecodedColumn<int64_t>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::REAL:
+        encodeDecodedColumn<float>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::DOUBLE:
+        encodeDecodedColumn<double>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeDecodedColumn<Timestamp>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::HUGEINT:
+        encodeDecodedColumn<int128_t>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      case TypeKind::VARCHAR:
+        [[fallthrough]];
+      case TypeKind::VARBINARY:
+        encodeDecodedColumn<StringView>(
+            layout_, i, decoded, numRows, prefixSize_, prefixes);
+        break;
+      default:
+        VELOX_UNSUPPORTED(
+            "prefix-sort does not support type kind: {}",
+            mapTypeKindToName(decoded.base()->typeKind()));
+    }
+  }
+}
+
+void PrefixSortKeyEncoder::encode(
+    const RowContainer& rowContainer,
+    char* row,
+    const std::vector<column_index_t>& keyColumns,
+    char* prefix) const {
+  VELOX_CHECK_EQ(keyColumns.size(), layout_.numKeys);
+  for (auto i = 0; i < layout_.numNormalizedKeys; ++i) {
+    extractRowColumnToPrefix(
+        rowContainer.columnTypes()[keyColumns[i]]->kind(),
+        layout_,
+        i,
+        rowContainer.columnAt(keyColumns[i]),
+        row,
+        prefix);
+  }
+}
+
 } // namespace facebook::velox::exec
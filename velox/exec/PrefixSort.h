@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <cstring>
 #include <optional>
 
 #include "velox/common/base/PrefixSortConfig.h"
@@ -97,11 +98,68 @@ struct PrefixSortLayout {
       std::vector<IdentityProjection>& keyColumnProjections);
 };
 
+/// Encodes the sort keys of input rows and of RowContainer rows into
+/// normalized prefixes that compare with memcmp in sort order. TopN and
+/// TopNRowNumber use it to compare input rows with the top row of their heaps,
+/// which needs a full comparison only if the prefixes are equal. Strings are
+/// always treated as partially encoded, since the lengths of input strings are
+/// not known up front.
+class PrefixSortKeyEncoder {
+ public:
+  /// Returns nullptr if the first sort key cannot be normalized.
+  static std::unique_ptr<PrefixSortKeyEncoder> create(
+      const std::vector<TypePtr>& keyTypes,
+      const std::vector<CompareFlags>& compareFlags,
+      const velox::common::PrefixSortConfig& config);
+
+  explicit PrefixSortKeyEncoder(PrefixSortLayout layout);
+
+  /// Number of bytes of an encoded prefix.
+  uint32_t prefixSize() const {
+    return prefixSize_;
+  }
+
+  /// Number of sort keys that are encoded, fully or partially.
+  uint32_t numNormalizedKeys() const {
+    return layout_.numNormalizedKeys;
+  }
+
+  /// Returns true if rows with equal prefixes have equal sort keys.
+  bool isComplete() const {
+    return !layout_.hasNonNormalizedKey &&
+        layout_.nonPrefixSortStartIndex == layout_.numNormalizedKeys;
+  }
+
+  /// Encodes the sort keys of rows [0, numRows) of 'keys' into 'prefixes', one
+  /// prefixSize() entry per row. 'keys' has one decoded vector per sort key.
+  void encode(
+      const std::vector<const DecodedVector*>& keys,
+      vector_size_t numRows,
+      char* prefixes) const;
+
+  /// Encodes the sort keys of 'row' of 'rowContainer' into 'prefix'.
+  /// 'keyColumns' are the columns of the sort keys in 'rowContainer'.
+  void encode(
+      const RowContainer& rowContainer,
+      char* row,
+      const std::vector<column_index_t>& keyColumns,
+      char* prefix) const;
+
+  int compare(const char* left, const char* right) const {
+    return std::memcmp(left, right, prefixSize_);
+  }
+
+ private:
+  const PrefixSortLayout layout_;
+  const uint32_t prefixSize_;
+};
+
 class PrefixSort {
  public:
   PrefixSort(
       const RowContainer* rowContainer,
       const PrefixSortLayout& sortLayout,
+      const velox::common::PrefixSortConfig& config,
       memory::MemoryPool* pool);
 
   /// Follow the steps below to sort the data in RowContainer:
@@ -110,7 +168,9 @@ class PrefixSort {
   /// normalized, normalize it. For this kind of keys can be normalized，we
   /// combine them with the original row address ptr and store them
   /// together into a buffer, called 'Prefix'.
-  /// 3. Sort the prefixes data we got in step 2.
+  /// 3. Sort the prefixes data we got in step 2. If all the keys are fully
+  /// normalized into at most 'maxRadixSortKeyBytes' and there are at least
+  /// kMinRadixSortRows rows, the prefixes are radix sorted.
   /// For keys can normalized(All fixed width types), we use 'memcmp' to compare
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
@@ -146,7 +206,7 @@ class PrefixSort {
       return;
     }
 
-    PrefixSort prefixSort(rowContainer, sortLayout, pool);
+    PrefixSort prefixSort(rowContainer, sortLayout, config, pool);
     prefixSort.sortInternal(rows);
   }
 
@@ -163,6 +223,14 @@ class PrefixSort {
   /// The number of prefix sort keys.
   static inline const std::string kNumPrefixSortKeys{"numPrefixSortKeys"};
 
+  /// The runtime stats name collected for prefix sort.
+  /// The number of sorts done with radix sort.
+  static inline const std::string kNumRadixSorts{"numPrefixRadixSorts"};
+
+  /// Minimum number of rows to sort with radix sort. Quick sort is faster for
+  /// fewer rows.
+  static constexpr uint32_t kMinRadixSortRows{1'024};
+
  private:
   /// Fallback to stdSort when prefix sort conditions such as config and memory
   /// are not satisfied. stdSort provides >2X performance win than std::sort for
@@ -207,6 +275,9 @@ class PrefixSort {
   // swap buffer.
   uint32_t maxRequiredBytes() const;
 
+  // Returns true if 'numRows' rows are radix sorted.
+  bool useRadixSort(uint64_t numRows) const;
+
   void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
 
   int compareAllNormalizedKeys(char* left, char* right);
@@ -224,6 +295,7 @@ class PrefixSort {
 
   const RowContainer* const rowContainer_;
   const PrefixSortLayout sortLayout_;
+  const uint32_t maxRadixSortKeyBytes_;
   memory::MemoryPool* const pool_;
 };
 } // namespace facebook::velox::exec
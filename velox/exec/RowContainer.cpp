@@ -147,12 +147,13 @@ RowContainer::RowContainer(
       stringAllocator_(std::make_unique<HashStringAllocator>(pool)),
       accumulators_(accumulators),
       rows_(pool) {
-  // Compute the layout of the payload row.  The row has keys, null flags,
-  // accumulators, dependent fields. All fields are fixed width. If variable
-  // width data is referenced, this is done with StringView(for VARCHAR) and
-  // std::string_view(for ARRAY, MAP and ROW) pointing to the data (StringView
-  // might inline the data if it's sufficiently small). The number of bytes used
-  // by each key is determined by keyTypes[i]. Null flags are one bit per field.
+  // Compute the layout of the payload row.  The row has keys, the next row
+  // pointer of a join build side, null flags, accumulators, dependent fields.
+  // All fields are fixed width. If variable width data is referenced, this is
+  // done with StringView(for VARCHAR) and std::string_view(for ARRAY, MAP and
+  // ROW) pointing to the data (StringView might inline the data if it's
+  // sufficiently small). The number of bytes used by each key is determined by
+  // keyTypes[i]. Null flags are one bit per field.
   // If nullableKeys is true there is a null flag for each key. If there are
   // accumulators, the remaining bits in the current byte are ignored and the
   // flags for the accumulators begin aligned on the next byte. A null bit and
@@ -165,8 +166,11 @@ RowContainer::RowContainer(
   // non-key columns for hash join or order by. If there are variable length
   // columns or accumulators, i.e. ones that allocate extra space, this space is
   // tracked by a uint32_t after the dependent columns. If this is a hash join
-  // build side, the pointer to the next row with the same key is after the
-  // optional row size.
+  // build side, the pointer to the next row with the same key comes right
+  // after the keys, before the null flags. A probe compares the keys and, on
+  // a match, follows the next pointer. Both are at the start of the row, so
+  // that the accumulators and dependent fields of a wide row are only read
+  // for the rows that are extracted.
   //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
@@ -192,6 +196,10 @@ RowContainer::RowContainer(
   // Make offset at least sizeof pointer so that there is space for a
   // free list next pointer below the bit at 'freeFlagOffset_'.
   offset = std::max<int32_t>(offset, sizeof(void*));
+  if (hasNext) {
+    nextOffset_ = offset;
+    offset += sizeof(void*);
+  }
   const int32_t firstAggregateOffset = offset;
   if (!accumulators.empty()) {
     // This moves nullOffset to the start of the next byte.
@@ -247,10 +255,6 @@ RowContainer::RowContainer(
     rowSizeOffset_ = offset;
     offset += sizeof(uint32_t);
   }
-  if (hasNext) {
-    nextOffset_ = offset;
-    offset += sizeof(void*);
-  }
   fixedRowSize_ = bits::roundUp(offset, alignment_);
   // A distinct hash table has no aggregates and if the hash table has
   // no nulls, it may be that there are no null flags.
@@ -443,6 +447,28 @@ void RowContainer::freeVariableWidthFields(folly::Range<char**> rows) {
   }
 }
 
+void RowContainer::relocateVariableWidthFields(
+    folly::Range<char**> rows,
+    HashStringAllocator::Relocator& relocator) {
+  for (auto i = 0; i < types_.size(); ++i) {
+    switch (typeKinds_[i]) {
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        relocateVariableWidthFieldsAtColumn<StringView>(i, rows, relocator);
+        break;
+      }
+      case TypeKind::ROW:
+      case TypeKind::ARRAY:
+      case TypeKind::MAP: {
+        relocateVariableWidthFieldsAtColumn<std::string_view>(
+            i, rows, relocator);
+        break;
+      }
+      default:;
+    }
+  }
+}
+
 void RowContainer::freeAggregates(folly::Range<char**> rows) {
   for (auto& accumulator : accumulators_) {
     accumulator.destroy(rows);
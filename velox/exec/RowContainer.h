@@ -414,7 +414,9 @@ class RowContainer {
 
   /// Copies the values at 'col' into 'result' (starting at 'resultOffset')
   /// for the 'numRows' rows pointed to by 'rows'. If a 'row' is null, sets
-  /// corresponding row in 'result' to null.
+  /// corresponding row in 'result' to null. Strings stored in one piece are not
+  /// copied: the StringViews in 'result' point into the container and are
+  /// valid only while the rows are neither freed nor cleared.
   /// @param columnHasNulls indicates whether the 'col' column contains null
   /// values. If 'columnHasNulls' is false, a null-free optimization will be
   /// applied. It is the caller's responsibility to ensure this flag is set
@@ -776,7 +778,18 @@ class RowContainer {
       uint64_t* result) const;
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rowBytes() + stringBytes();
+  }
+
+  /// Returns the bytes allocated for the fixed-width parts of the rows.
+  uint64_t rowBytes() const {
+    return rows_.allocatedBytes();
+  }
+
+  /// Returns the bytes retained for the variable-width data and the
+  /// accumulators of the rows.
+  uint64_t stringBytes() const {
+    return stringAllocator_->retainedSize();
   }
 
   /// Returns the number of fixed size rows that can be allocated without
@@ -788,6 +801,13 @@ class RowContainer {
         stringAllocator_->freeSpace());
   }
 
+  /// Passes the references to the out-of-line data of the variable width keys
+  /// and dependents of 'rows' to 'relocator'. See
+  /// HashStringAllocator::compact().
+  void relocateVariableWidthFields(
+      folly::Range<char**> rows,
+      HashStringAllocator::Relocator& relocator);
+
   /// Returns the average size of rows in bytes stored in this container.
   std::optional<int64_t> estimateRowSize() const;
 
@@ -1095,6 +1115,106 @@ class RowContainer {
     }
   }
 
+  // Returns the row at position 'index' of 'rows' or of 'rowNumbers' into
+  // 'rows'. A negative row number gives nullptr.
+  template <bool useRowNumbers>
+  static inline const char* rowAt(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t index) {
+    if constexpr (useRowNumbers) {
+      const auto rowNumber = rowNumbers[index];
+      return rowNumber >= 0 ? rows[rowNumber] : nullptr;
+    } else {
+      return rows[index];
+    }
+  }
+
+  // Returns a word with bit 'i' set if the row at 'begin + i' is nullptr or has
+  // the null flag at 'nullByte' and 'nullMask' set, for the first 'numRows'
+  // (at most 64) rows from 'begin'. A zero 'nullMask' only checks for nullptr.
+  template <bool useRowNumbers>
+  static inline uint64_t nullWord(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t begin,
+      int32_t numRows,
+      int32_t nullByte,
+      uint8_t nullMask) {
+    uint64_t word = 0;
+    for (int32_t i = 0; i < numRows; ++i) {
+      const char* row = rowAt<useRowNumbers>(rows, rowNumbers, begin + i);
+      const bool isNull = row == nullptr || (row[nullByte] & nullMask) != 0;
+      word |= static_cast<uint64_t>(isNull) << i;
+    }
+    return word;
+  }
+
+  // Sets the bits of 'nulls' from 'resultOffset' on to the null flags of the
+  // 'numRows' rows, in the vector convention where a set bit is not null.
+  // Takes 64 rows at a time instead of setting one bit per row.
+  template <bool useRowNumbers>
+  static void extractNullBits(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t nullByte,
+      uint8_t nullMask,
+      int32_t resultOffset,
+      uint64_t* nulls) {
+    for (int32_t i = 0; i < numRows; i += 64) {
+      const auto numBits = std::min<int32_t>(64, numRows - i);
+      const uint64_t notNulls = ~nullWord<useRowNumbers>(
+          rows, rowNumbers, i, numBits, nullByte, nullMask);
+      bits::copyBits(&notNulls, 0, nulls, resultOffset + i, numBits);
+    }
+  }
+
+  // Number of rows ahead of the current one whose values are prefetched when
+  // copying fixed width values out of the container.
+  static constexpr int32_t kExtractPrefetchDistance = 16;
+
+  // Copies the fixed width values at 'offset' of the 'numRows' rows into
+  // 'values'. Prefetches the rows a fixed distance ahead so that the cache
+  // misses on the scattered rows overlap. Skips nullptr rows and returns true
+  // if there were any. Values under a null flag are copied as is.
+  template <bool useRowNumbers, typename T>
+  static bool gatherValues(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t offset,
+      T* values) {
+    bool anyNullRow = false;
+    const auto copyValue = [&](int32_t i) {
+      const char* row = rowAt<useRowNumbers>(rows, rowNumbers, i);
+      if (FOLLY_UNLIKELY(row == nullptr)) {
+        anyNullRow = true;
+      } else {
+        values[i] = valueAt<T>(row, offset);
+      }
+    };
+    int32_t i = 0;
+    for (; i + kExtractPrefetchDistance < numRows; ++i) {
+      const char* ahead =
+          rowAt<useRowNumbers>(rows, rowNumbers, i + kExtractPrefetchDistance);
+      if (ahead != nullptr) {
+        __builtin_prefetch(ahead + offset);
+      }
+      copyValue(i);
+    }
+    for (; i < numRows; ++i) {
+      copyValue(i);
+    }
+    return anyNullRow;
+  }
+
+  // True if values of 'T' are copied with gatherValues(). Booleans are bits in
+  // the result and strings may need copying out of the container.
+  template <typename T>
+  static constexpr bool kGatherValues =
+      !std::is_same_v<T, bool> && !std::is_same_v<T, StringView>;
+
   template <bool useRowNumbers, typename T>
   static void extractValuesWithNulls(
       const char* const* rows,
@@ -1111,26 +1231,26 @@ class RowContainer {
     BufferPtr& nullBuffer = result->mutableNulls(maxRows, true);
     auto nulls = nullBuffer->asMutable<uint64_t>();
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
-    [[maybe_unused]] auto values = valuesBuffer->asMutableRange<T>();
-    for (int32_t i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
-      }
-      auto resultIndex = resultOffset + i;
-      if (row == nullptr || isNullAt(row, nullByte, nullMask)) {
-        bits::setNull(nulls, resultIndex, true);
-      } else {
-        bits::setNull(nulls, resultIndex, false);
+    extractNullBits<useRowNumbers>(
+        rows, rowNumbers, numRows, nullByte, nullMask, resultOffset, nulls);
+    if constexpr (kGatherValues<T>) {
+      gatherValues<useRowNumbers, T>(
+          rows,
+          rowNumbers,
+          numRows,
+          offset,
+          valuesBuffer->asMutable<T>() + resultOffset);
+    } else {
+      [[maybe_unused]] auto values = valuesBuffer->asMutableRange<T>();
+      bits::forEachSetBit(nulls, resultOffset, maxRows, [&](auto resultIndex) {
+        const char* row =
+            rowAt<useRowNumbers>(rows, rowNumbers, resultIndex - resultOffset);
         if constexpr (std::is_same_v<T, StringView>) {
           extractString(valueAt<StringView>(row, offset), result, resultIndex);
         } else {
           values[resultIndex] = valueAt<T>(row, offset);
         }
-      }
+      });
     }
   }
 
@@ -1145,15 +1265,26 @@ class RowContainer {
     auto maxRows = numRows + resultOffset;
     VELOX_DCHECK_LE(maxRows, result->size());
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
+    if constexpr (kGatherValues<T>) {
+      const bool anyNullRow = gatherValues<useRowNumbers, T>(
+          rows,
+          rowNumbers,
+          numRows,
+          offset,
+          valuesBuffer->asMutable<T>() + resultOffset);
+      if (anyNullRow) {
+        auto nulls = result->mutableNulls(maxRows, true)->asMutable<uint64_t>();
+        extractNullBits<useRowNumbers>(
+            rows, rowNumbers, numRows, 0, 0, resultOffset, nulls);
+      } else if (result->rawNulls()) {
+        bits::fillBits(
+            result->mutableRawNulls(), resultOffset, maxRows, bits::kNotNull);
+      }
+      return;
+    }
     [[maybe_unused]] auto values = valuesBuffer->asMutableRange<T>();
     for (int32_t i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
-      }
+      const char* row = rowAt<useRowNumbers>(rows, rowNumbers, i);
       auto resultIndex = resultOffset + i;
       if (row == nullptr) {
         result->setNull(resultIndex, true);
@@ -1470,6 +1601,19 @@ class RowContainer {
     }
   }
 
+  template <typename FieldType>
+  void relocateVariableWidthFieldsAtColumn(
+      size_t column_index,
+      folly::Range<char**> rows,
+      HashStringAllocator::Relocator& relocator) {
+    const auto column = columnAt(column_index);
+    for (auto row : rows) {
+      if (!isNullAt(row, column.nullByte(), column.nullMask())) {
+        relocator.relocate(valueAt<FieldType>(row, column.offset()));
+      }
+    }
+  }
+
   // Free any variable-width fields associated with the 'rows' and zero out
   // complex-typed field in 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
@@ -1741,10 +1885,13 @@ inline void RowContainer::extractNulls(
   }
 
   auto nullByte = column.nullByte();
-  for (int32_t i = 0; i < numRows; ++i) {
-    const char* row = rows[i];
-    if (row == nullptr || isNullAt(row, nullByte, nullMask)) {
-      bits::setBit(rawResult, i, true);
+  for (int32_t i = 0; i < numRows; i += 64) {
+    const auto numBits = std::min<int32_t>(64, numRows - i);
+    const auto word = nullWord<false>(rows, {}, i, numBits, nullByte, nullMask);
+    if (numBits == 64) {
+      rawResult[i / 64] = word;
+    } else {
+      bits::copyBits(&word, 0, rawResult, i, numBits);
     }
   }
 }
@@ -38,7 +38,14 @@ RowNumber::RowNumber(
   const auto& keys = rowNumberNode->partitionKeys();
   const auto numKeys = keys.size();
 
-  if (numKeys > 0) {
+  if (numKeys > 0 && rowNumberNode->preGrouped()) {
+    std::vector<column_index_t> keyChannels;
+    for (const auto& key : keys) {
+      keyChannels.push_back(exprToChannel(key.get(), inputType));
+    }
+    groupStartFinder_ = std::make_unique<GroupStartFinder>(
+        inputType, std::move(keyChannels), pool());
+  } else if (numKeys > 0) {
     table_ = std::make_unique<HashTable<false>>(
         createVectorHashers(inputType, keys),
         std::vector<Accumulator>{},
@@ -245,11 +252,7 @@ void RowNumber::ensureInputFits(const RowVectorPtr& input) {
 
 FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
   VectorPtr& result = results_[0];
-  if (result && result.use_count() == 1) {
-    BaseVector::prepareForReuse(result, size);
-  } else {
-    result = BaseVector::create(BIGINT(), size, pool());
-  }
+  prepareOutputVector(result, BIGINT(), size);
   return *result->as<FlatVector<int64_t>>();
 }
 
@@ -270,6 +273,10 @@ RowVectorPtr RowNumber::getOutput() {
     }
   }
 
+  if (groupStartFinder_) {
+    return getOutputForPreGroupedPartitions();
+  }
+
   if (!table_) {
     // No partition keys.
     return getOutputForSinglePartition();
@@ -364,6 +371,56 @@ RowVectorPtr RowNumber::getOutputForSinglePartition() {
   return output;
 }
 
+RowVectorPtr RowNumber::getOutputForPreGroupedPartitions() {
+  const auto numInput = input_->size();
+
+  partitionStarts_.resize(bits::nwords(numInput));
+  groupStartFinder_->find(*input_, partitionStarts_.data());
+
+  BufferPtr mapping;
+  vector_size_t* rawMapping;
+  vector_size_t index = 0;
+  if (limit_) {
+    mapping = allocateIndices(numInput, pool());
+    rawMapping = mapping->asMutable<vector_size_t>();
+  }
+
+  FlatVector<int64_t>* rowNumbers = nullptr;
+  if (generateRowNumber_) {
+    rowNumbers = &getOrCreateRowNumberVector(numInput);
+  }
+
+  for (auto i = 0; i < numInput; ++i) {
+    if (bits::isBitSet(partitionStarts_.data(), i)) {
+      numPartitionRows_ = 0;
+    }
+    const auto rowNumber = ++numPartitionRows_;
+
+    if (limit_) {
+      if (rowNumber > limit_) {
+        // Exceeded the limit for this partition. Drop rows.
+        continue;
+      }
+      rawMapping[index++] = i;
+    }
+
+    if (generateRowNumber_) {
+      rowNumbers->set(i, rowNumber);
+    }
+  }
+
+  RowVectorPtr output;
+  if (limit_) {
+    if (index > 0) {
+      output = fillOutput(index, mapping);
+    }
+  } else {
+    output = fillOutput(numInput, nullptr);
+  }
+  input_ = nullptr;
+  return output;
+}
+
 int64_t RowNumber::numRows(char* partition) {
   return *reinterpret_cast<int64_t*>(partition + numRowsOffset_);
 }
@@ -18,6 +18,7 @@
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -77,6 +78,9 @@ class RowNumber : public Operator {
 
   RowVectorPtr getOutputForSinglePartition();
 
+  // Computes the row numbers for input grouped on the partition keys.
+  RowVectorPtr getOutputForPreGroupedPartitions();
+
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
 
   // Finishes the current input spilling and restore the next processing
@@ -109,6 +113,17 @@ class RowNumber : public Operator {
   std::unique_ptr<HashLookup> lookup_;
   int32_t numRowsOffset_;
 
+  // Finds the first row of each partition instead of 'table_' if the input is
+  // grouped on the partition keys.
+  std::unique_ptr<GroupStartFinder> groupStartFinder_;
+
+  // The first rows of the partitions in the current input.
+  std::vector<uint64_t> partitionStarts_;
+
+  // The number of rows so far in the current partition, which may span
+  // inputs.
+  int64_t numPartitionRows_{0};
+
   // Total number of input rows. Used when there are no partitioning keys and
   // therefore no hash table.
   int64_t numTotalInput_{0};
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ScaledScanController.h"
 
+#include <folly/executors/ThreadPoolExecutor.h>
+
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
@@ -22,11 +24,13 @@ namespace facebook::velox::exec {
 ScaledScanController::ScaledScanController(
     memory::MemoryPool* nodePool,
     uint32_t numDrivers,
-    double scaleUpMemoryUsageRatio)
+    double scaleUpMemoryUsageRatio,
+    folly::Executor* executor)
     : queryPool_(nodePool->root()),
       nodePool_(nodePool),
       numDrivers_(numDrivers),
       scaleUpMemoryUsageRatio_(scaleUpMemoryUsageRatio),
+      executor_(executor),
       driverPromises_(numDrivers_) {
   VELOX_CHECK_NOT_NULL(queryPool_);
   VELOX_CHECK_NOT_NULL(nodePool_);
@@ -65,13 +69,14 @@ bool ScaledScanController::shouldStopLocked(
 
 void ScaledScanController::updateAndTryScale(
     uint32_t driverIdx,
-    uint64_t memoryUsage) {
+    uint64_t memoryUsage,
+    SplitTiming splitTiming) {
   VELOX_CHECK_LT(driverIdx, numDrivers_);
 
-  std::optional<ContinuePromise> driverPromise;
+  std::vector<ContinuePromise> driverPromises;
   SCOPE_EXIT {
-    if (driverPromise.has_value()) {
-      driverPromise->setValue();
+    for (auto& promise : driverPromises) {
+      promise.setValue();
     }
   };
   {
@@ -80,11 +85,18 @@ void ScaledScanController::updateAndTryScale(
       return;
     }
 
-    VELOX_CHECK_LT(driverIdx, numRunningDrivers_);
-
+    // NOTE: a driver at or beyond 'numRunningDrivers_' might still report
+    // the split it was processing when the scan scaled down.
     updateDriverScanUsageLocked(driverIdx, memoryUsage);
 
-    tryScaleLocked(driverPromise);
+    if (splitTiming.wallNanos > 0) {
+      const double ratio = std::min<double>(
+          1.0, static_cast<double>(splitTiming.ioWaitNanos) /
+              splitTiming.wallNanos);
+      ioWaitRatio_ = ioWaitRatio_ == 0 ? ratio : (ioWaitRatio_ * 3 + ratio) / 4;
+    }
+
+    tryScaleLocked(driverPromises);
   }
 }
 
@@ -105,14 +117,27 @@ void ScaledScanController::updateDriverScanUsageLocked(
   if (driverIdx + 1 < numRunningDrivers_) {
     return;
   }
-  VELOX_CHECK_EQ(driverIdx, numRunningDrivers_ - 1);
-  ++numDriverReportedUsage_;
+  numDriverReportedUsage_ = numRunningDrivers_;
 }
 
 void ScaledScanController::tryScaleLocked(
-    std::optional<ContinuePromise>& driverPromise) {
+    std::vector<ContinuePromise>& driverPromises) {
   VELOX_CHECK_LE(numDriverReportedUsage_, numRunningDrivers_);
 
+  const uint64_t maxQueryCapacity = queryPool_->maxCapacity();
+  // Scale down by one driver if the query memory usage gets half way from
+  // the scale up limit to the query capacity, e.g. when other operators or
+  // memory arbitration take memory from the query after the scan scaled up.
+  const double scaleDownMemoryUsageRatio = (1 + scaleUpMemoryUsageRatio_) / 2;
+  if (numRunningDrivers_ > 1 &&
+      queryPool_->reservedBytes() >
+          maxQueryCapacity * scaleDownMemoryUsageRatio) {
+    --numRunningDrivers_;
+    numDriverReportedUsage_ = numRunningDrivers_;
+    ++numScaleDowns_;
+    return;
+  }
+
   if (numRunningDrivers_ == numDrivers_) {
     return;
   }
@@ -121,11 +146,35 @@ void ScaledScanController::tryScaleLocked(
     // the memory usage updates from all the running scan drivers.
     return;
   }
+  if (!canAddDriversLocked(1)) {
+    return;
+  }
+
+  const bool ioBound = ioWaitRatio_ >= kIoBoundWaitRatio;
+  if (!ioBound) {
+    // A scan that mostly runs on CPU does not go faster with more drivers if
+    // the executor has no idle thread to run them.
+    const auto idleRatio = executorIdleRatio();
+    if (idleRatio.has_value() && idleRatio.value() <= 0) {
+      return;
+    }
+  }
+
+  scaleUpLocked(driverPromises);
+  // A scan that mostly waits for I/O keeps more reads in flight with more
+  // drivers, so it scales up faster.
+  if (ioBound && numRunningDrivers_ < numDrivers_ &&
+      canAddDriversLocked(1)) {
+    scaleUpLocked(driverPromises);
+  }
+}
 
+bool ScaledScanController::canAddDriversLocked(uint32_t numNewDrivers) const {
   const uint64_t peakNodeUsage = nodePool_->peakBytes();
+  const uint64_t newDriversUsage = estimatedDriverUsage_ * numNewDrivers;
   const uint64_t estimatedPeakNodeUsageAfterScale = std::max(
-      estimatedDriverUsage_ * (numRunningDrivers_ + 1),
-      peakNodeUsage + estimatedDriverUsage_);
+      estimatedDriverUsage_ * (numRunningDrivers_ + numNewDrivers),
+      peakNodeUsage + newDriversUsage);
 
   const uint64_t currNodeUsage = nodePool_->reservedBytes();
   const uint64_t currQueryUsage = queryPool_->reservedBytes();
@@ -133,25 +182,36 @@ void ScaledScanController::tryScaleLocked(
       currQueryUsage > currNodeUsage ? currQueryUsage - currNodeUsage : 0;
 
   const uint64_t estimatedQueryUsageAfterScale = std::max(
-      currQueryUsage + estimatedDriverUsage_,
+      currQueryUsage + newDriversUsage,
       currOtherUsage + estimatedPeakNodeUsageAfterScale);
 
-  const uint64_t maxQueryCapacity = queryPool_->maxCapacity();
-  if (estimatedQueryUsageAfterScale >
-      maxQueryCapacity * scaleUpMemoryUsageRatio_) {
-    return;
-  }
+  return estimatedQueryUsageAfterScale <=
+      queryPool_->maxCapacity() * scaleUpMemoryUsageRatio_;
+}
 
-  scaleUpLocked(driverPromise);
+std::optional<double> ScaledScanController::executorIdleRatio() const {
+  const auto* threadPool =
+      dynamic_cast<const folly::ThreadPoolExecutor*>(executor_);
+  if (threadPool == nullptr) {
+    return std::nullopt;
+  }
+  const auto numThreads = threadPool->numThreads();
+  if (numThreads == 0) {
+    return std::nullopt;
+  }
+  const auto numActiveThreads = std::min<size_t>(
+      threadPool->getPoolStats().activeThreadCount, numThreads);
+  return 1.0 - static_cast<double>(numActiveThreads) / numThreads;
 }
 
 void ScaledScanController::scaleUpLocked(
-    std::optional<ContinuePromise>& driverPromise) {
+    std::vector<ContinuePromise>& driverPromises) {
   VELOX_CHECK_LT(numRunningDrivers_, numDrivers_);
 
   ++numRunningDrivers_;
   if (driverPromises_[numRunningDrivers_ - 1].has_value()) {
-    driverPromise = std::move(driverPromises_[numRunningDrivers_ - 1]);
+    driverPromises.emplace_back(
+        std::move(driverPromises_[numRunningDrivers_ - 1].value()));
     driverPromises_[numRunningDrivers_ - 1].reset();
   }
 }
@@ -185,6 +245,9 @@ bool ScaledScanController::close() {
 }
 
 std::string ScaledScanController::Stats::toString() const {
-  return fmt::format("numRunningDrivers: {}", numRunningDrivers);
+  return fmt::format(
+      "numRunningDrivers: {}, numScaleDowns: {}",
+      numRunningDrivers,
+      numScaleDowns);
 }
 } // namespace facebook::velox::exec
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::exec {
@@ -24,16 +26,27 @@ class ScaledScanControllerTestHelper;
 }
 
 /// Controller used to scales table scan processing based on the query memory
-/// usage.
+/// usage, the time the scan drivers wait for I/O and the idle threads of the
+/// query executor.
+///
+/// The scan scales up while the memory usage allows another driver. If the
+/// drivers mostly wait for I/O, it scales up by two drivers at a time, and if
+/// they mostly run on CPU while the executor has no idle thread, it does not
+/// scale up. It scales down by a driver when the query memory usage gets
+/// half way from the scale up ratio to the query capacity. A driver that is
+/// scaled down stops before its next split.
 class ScaledScanController {
  public:
   /// 'nodePool' is the table scan node pool. 'numDrivers' is number of the
   /// table scan drivers. 'scaleUpMemoryUsageRatio' specifies the memory usage
-  /// ratio used to make scan scale up decision.
+  /// ratio used to make scan scale up decision. 'executor' is the query
+  /// executor. Its idle threads are only known if it is a
+  /// folly::ThreadPoolExecutor.
   ScaledScanController(
       memory::MemoryPool* nodePool,
       uint32_t numDrivers,
-      double scaleUpMemoryUsageRatio);
+      double scaleUpMemoryUsageRatio,
+      folly::Executor* executor = nullptr);
 
   ~ScaledScanController();
 
@@ -51,21 +64,35 @@ class ScaledScanController {
   /// run.
   bool shouldStop(uint32_t driverIdx, ContinueFuture* future);
 
+  /// The time a scan driver spent on a split.
+  struct SplitTiming {
+    /// The time the driver waited for I/O of the split.
+    uint64_t ioWaitNanos{0};
+    /// The wall time from the start to the end of the split.
+    uint64_t wallNanos{0};
+  };
+
   /// Invoked by a scan operator to update per-driver memory usage estimation
   /// after finish processing a non-empty split. 'driverIdx' is the driver id of
   /// the scan operator. 'driverMemoryUsage' is the peak memory usage of the
-  /// scan operator.
-  void updateAndTryScale(uint32_t driverIdx, uint64_t driverMemoryUsage);
+  /// scan operator. 'splitTiming' is the time spent on the split.
+  void updateAndTryScale(
+      uint32_t driverIdx,
+      uint64_t driverMemoryUsage,
+      SplitTiming splitTiming = {});
 
   struct Stats {
     uint32_t numRunningDrivers{0};
+    uint32_t numScaleDowns{0};
 
     std::string toString() const;
   };
 
   Stats stats() const {
     std::lock_guard<std::mutex> l(lock_);
-    return {.numRunningDrivers = numRunningDrivers_};
+    return {
+        .numRunningDrivers = numRunningDrivers_,
+        .numScaleDowns = numScaleDowns_};
   }
 
   /// Invoked by the closed scan operator to close the controller. It returns
@@ -80,12 +107,20 @@ class ScaledScanController {
  private:
   // Invoked to check if we can scale up scan processing. If so, call
   // 'scaleUpLocked' for scale up processing.
-  void tryScaleLocked(std::optional<ContinuePromise>& driverePromise);
+  void tryScaleLocked(std::vector<ContinuePromise>& driverPromises);
 
   // Invoked to scale up scan processing by bumping up the number of running
-  // scan drivers by one. 'drverPromise' returns the promise to fulfill if the
+  // scan drivers by one. 'drverPromises' returns the promise to fulfill if the
   // scaled scan driver has been stopped.
-  void scaleUpLocked(std::optional<ContinuePromise>& driverePromise);
+  void scaleUpLocked(std::vector<ContinuePromise>& driverPromises);
+
+  // Returns true if the query memory usage after adding 'numNewDrivers'
+  // drivers is within 'scaleUpMemoryUsageRatio_' of the query capacity.
+  bool canAddDriversLocked(uint32_t numNewDrivers) const;
+
+  // Returns the fraction of the threads of 'executor_' that are idle, or
+  // std::nullopt if not known.
+  std::optional<double> executorIdleRatio() const;
 
   // Invoked to check if we need to stop waiting for scale up processing of the
   // specified scan driver. If 'driverIdx' is beyond 'numRunningDrivers_', then
@@ -99,10 +134,15 @@ class ScaledScanController {
   /// report.
   void updateDriverScanUsageLocked(uint32_t driverIdx, uint64_t memoryUsage);
 
+  // The fraction of the split time spent on I/O wait above which the scan is
+  // I/O bound.
+  static constexpr double kIoBoundWaitRatio{0.5};
+
   memory::MemoryPool* const queryPool_;
   memory::MemoryPool* const nodePool_;
   const uint32_t numDrivers_;
   const double scaleUpMemoryUsageRatio_;
+  folly::Executor* const executor_;
 
   mutable std::mutex lock_;
   uint32_t numRunningDrivers_{1};
@@ -113,6 +153,12 @@ class ScaledScanController {
   // The number of drivers that have reported memory usage.
   uint32_t numDriverReportedUsage_{0};
 
+  // The exponential moving average of the fraction of the split time the
+  // drivers waited for I/O.
+  double ioWaitRatio_{0};
+
+  uint32_t numScaleDowns_{0};
+
   // The driver resume promises with one per each driver index.
   std::vector<std::optional<ContinuePromise>> driverPromises_;
 
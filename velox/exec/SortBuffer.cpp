@@ -107,7 +107,7 @@ void SortBuffer::addInput(const VectorPtr& input) {
   numInputRows_ += allRows.size();
 }
 
-void SortBuffer::noMoreInput() {
+void SortBuffer::noMoreInput(bool sortInSlices) {
   velox::common::testutil::TestValue::adjust(
       "facebook::velox::exec::SortBuffer::noMoreInput", this);
   VELOX_CHECK(!noMoreInput_);
@@ -131,8 +131,19 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    PrefixSort::sort(
-        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    if (sortInSlices && numInputRows_ > kSortRunRows) {
+      sortPending_ = true;
+      nextSortRunRow_ = 0;
+      mergeRunRows_ = kSortRunRows;
+      nextMergeRow_ = 0;
+    } else {
+      PrefixSort::sort(
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_,
+          pool_,
+          sortedRows_);
+    }
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -147,12 +158,66 @@ void SortBuffer::noMoreInput() {
   pool_->release();
 }
 
+bool SortBuffer::sortInput(const std::function<bool()>& shouldYield) {
+  VELOX_CHECK(noMoreInput_);
+  if (!sortPending_) {
+    return true;
+  }
+  velox::common::testutil::TestValue::adjust(
+      "facebook::velox::exec::SortBuffer::sortInput", this);
+
+  const auto numRows = sortedRows_.size();
+  std::vector<char*, memory::StlAllocator<char*>> buffer(
+      0, memory::StlAllocator<char*>(*pool_));
+  while (nextSortRunRow_ < numRows) {
+    const auto begin = sortedRows_.begin() + nextSortRunRow_;
+    const auto end = sortedRows_.begin() +
+        std::min(nextSortRunRow_ + kSortRunRows, numRows);
+    buffer.assign(begin, end);
+    PrefixSort::sort(
+        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, buffer);
+    std::copy(buffer.begin(), buffer.end(), begin);
+    nextSortRunRow_ += buffer.size();
+    if (shouldYield()) {
+      return false;
+    }
+  }
+
+  const auto lessThan = [&](const char* left, const char* right) {
+    for (auto i = 0; i < sortCompareFlags_.size(); ++i) {
+      if (const auto result =
+              data_->compare(left, right, i, sortCompareFlags_[i])) {
+        return result < 0;
+      }
+    }
+    return false;
+  };
+  for (; mergeRunRows_ < numRows; mergeRunRows_ *= 2, nextMergeRow_ = 0) {
+    while (nextMergeRow_ + mergeRunRows_ < numRows) {
+      const auto begin = sortedRows_.begin() + nextMergeRow_;
+      const auto middle = begin + mergeRunRows_;
+      const auto end = sortedRows_.begin() +
+          std::min(nextMergeRow_ + 2 * mergeRunRows_, numRows);
+      buffer.resize(end - begin);
+      std::merge(begin, middle, middle, end, buffer.begin(), lessThan);
+      std::copy(buffer.begin(), buffer.end(), begin);
+      nextMergeRow_ += buffer.size();
+      if (shouldYield()) {
+        return false;
+      }
+    }
+  }
+  sortPending_ = false;
+  return true;
+}
+
 RowVectorPtr SortBuffer::getOutput(vector_size_t maxOutputRows) {
   SCOPE_EXIT {
     pool_->release();
   };
 
   VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(!sortPending_, "The rows are not sorted yet");
 
   if (numOutputRows_ == numInputRows_) {
     return nullptr;
@@ -192,6 +257,8 @@ void SortBuffer::spill() {
   if (sortedRows_.empty()) {
     spillInput();
   } else {
+    // The output is spilled in sorted order.
+    sortInput([]() { return false; });
     spillOutput();
   }
 }
@@ -492,7 +559,7 @@ void SortBuffer::prepareOutputWithSpill() {
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
   spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      *spillConfig_, pool(), spillStats_);
   spillPartitionSet_.clear();
 }
 } // namespace facebook::velox::exec
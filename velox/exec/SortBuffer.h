@@ -50,7 +50,17 @@ class SortBuffer {
   ///  - In-memory sorting on rows stored in 'data_' if spilling is not enabled.
   ///  - Finish spilling and setup the sort merge reader for the un-spilling
   ///  processing for the output.
-  void noMoreInput();
+  /// If 'sortInSlices' is true, the in-memory sorting is done by sortInput()
+  /// instead.
+  void noMoreInput(bool sortInSlices = false);
+
+  /// Continues the in-memory sorting after noMoreInput(true). Sorts runs of
+  /// kSortRunRows rows and then merges pairs of sorted runs until the rows are
+  /// sorted, checking 'shouldYield' after each run or merge. Returns false if
+  /// 'shouldYield' returned true before the rows are sorted. The next call
+  /// continues from there. Returns true once the rows are sorted. getOutput()
+  /// can only be called after that.
+  bool sortInput(const std::function<bool()>& shouldYield);
 
   /// Returns the sorted output rows in batch.
   RowVectorPtr getOutput(vector_size_t maxOutputRows);
@@ -70,6 +80,9 @@ class SortBuffer {
   std::optional<uint64_t> estimateOutputRowSize() const;
 
  private:
+  // The number of rows sortInput() sorts at a time before merging.
+  static constexpr size_t kSortRunRows = 64 * 1024;
+
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
 
@@ -143,6 +156,17 @@ class SortBuffer {
 
   std::vector<char*, memory::StlAllocator<char*>> sortedRows_;
 
+  // True while the rows in 'sortedRows_' are sorted by sortInput().
+  bool sortPending_{false};
+
+  // The first row in 'sortedRows_' that is not in a sorted run yet.
+  size_t nextSortRunRow_{0};
+
+  // The number of rows of the sorted runs that are merged next and the first
+  // row of the next pair of these runs.
+  size_t mergeRunRows_{0};
+  size_t nextMergeRow_{0};
+
   // The data type of the rows stored in 'data_' and spilled on disk. The
   // sort key columns are stored first then the non-sorted data columns.
   RowTypePtr spillerStoreType_;
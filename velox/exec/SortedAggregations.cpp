@@ -290,50 +290,47 @@ bool SortedAggregations::compareRowsWithKeys(
   return false;
 }
 
-void SortedAggregations::sortSingleGroup(
-    std::vector<char*>& groupRows,
+void SortedAggregations::sortRows(
+    std::vector<std::pair<vector_size_t, char*>>& groupRows,
     const SortingSpec& sortingSpec) {
   std::sort(
       groupRows.begin(),
       groupRows.end(),
-      [&](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, sortingSpec);
+      [&](const std::pair<vector_size_t, char*>& left,
+          const std::pair<vector_size_t, char*>& right) {
+        if (left.first != right.first) {
+          return left.first < right.first;
+        }
+        return compareRowsWithKeys(left.second, right.second, sortingSpec);
       });
 }
 
-vector_size_t SortedAggregations::extractSingleGroup(
-    std::vector<char*>& groupRows,
+bool SortedAggregations::extractInputs(
+    folly::Range<char**> rows,
     const AggregateInfo& aggregate,
-    std::vector<VectorPtr>& inputVectors) {
-  const auto numGroupRows = groupRows.size();
-
-  std::vector<vector_size_t> rowNumbers;
+    std::vector<VectorPtr>& inputVectors,
+    SelectivityVector& selected) {
+  const auto numRows = rows.size();
+  selected.resizeFill(numRows, true);
   if (aggregate.mask) {
     FlatVectorPtr<bool> mask = BaseVector::create<FlatVector<bool>>(
-        BOOLEAN(), numGroupRows, inputData_->pool());
+        BOOLEAN(), numRows, inputData_->pool());
     inputData_->extractColumn(
-        groupRows.data(),
-        numGroupRows,
-        inputMapping_[aggregate.mask.value()],
-        mask);
-
-    rowNumbers.reserve(numGroupRows);
-    for (auto i = 0; i < numGroupRows; ++i) {
-      if (!mask->isNullAt(i) && mask->valueAt(i)) {
-        rowNumbers.push_back(i);
+        rows.data(), numRows, inputMapping_[aggregate.mask.value()], mask);
+    for (auto i = 0; i < numRows; ++i) {
+      if (mask->isNullAt(i) || !mask->valueAt(i)) {
+        selected.setValid(i, false);
       }
     }
-
-    if (rowNumbers.empty()) {
-      return 0;
+    selected.updateBounds();
+    if (!selected.hasSelections()) {
+      return false;
     }
   }
 
   const auto numInputs = aggregate.inputs.size();
   VELOX_CHECK_EQ(numInputs, inputVectors.size());
 
-  const auto numRows = aggregate.mask ? rowNumbers.size() : numGroupRows;
-
   for (auto i = 0; i < numInputs; ++i) {
     if (aggregate.inputs[i] == kConstantChannel) {
       inputVectors[i] = aggregate.constantInputs[i];
@@ -345,22 +342,11 @@ vector_size_t SortedAggregations::extractSingleGroup(
       } else {
         BaseVector::prepareForReuse(inputVectors[i], numRows);
       }
-
-      if (aggregate.mask) {
-        inputData_->extractColumn(
-            groupRows.data(),
-            folly::Range(rowNumbers.data(), rowNumbers.size()),
-            columnIndex,
-            0, // resultOffset
-            inputVectors[i]);
-      } else {
-        inputData_->extractColumn(
-            groupRows.data(), numRows, columnIndex, inputVectors[i]);
-      }
+      inputData_->extractColumn(
+          rows.data(), numRows, columnIndex, inputVectors[i]);
     }
   }
-
-  return numRows;
+  return true;
 }
 
 void SortedAggregations::extractValues(
@@ -368,7 +354,22 @@ void SortedAggregations::extractValues(
     const RowVectorPtr& result) {
   raw_vector<int32_t> temp;
   SelectivityVector rows;
-  std::vector<char*> groupRows;
+
+  // The rows of all groups with the index of their group.
+  std::vector<std::pair<vector_size_t, char*>> groupRows;
+  std::vector<char*> accumulatorRows;
+  for (auto i = 0; i < groups.size(); ++i) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
+    accumulatorRows.resize(accumulator->size);
+    accumulator->read(
+        folly::Range(accumulatorRows.data(), accumulatorRows.size()));
+    for (auto* row : accumulatorRows) {
+      groupRows.emplace_back(i, row);
+    }
+  }
+
+  std::vector<char*> batchRows;
+  std::vector<char*> batchGroups;
   for (const auto& [sortingSpec, aggregates] : aggregates_) {
     std::vector<VectorPtr> inputVectors;
     size_t numInputColumns = 0;
@@ -377,18 +378,20 @@ void SortedAggregations::extractValues(
     }
     inputVectors.resize(numInputColumns);
 
-    // For each group, sort inputs, add them to aggregate.
-    for (auto* group : groups) {
-      auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-      if (accumulator->size == 0) {
-        continue;
+    sortRows(groupRows, sortingSpec);
+
+    // Adds the sorted rows to the aggregates in batches. The rows of a group
+    // may span batches and are added in order.
+    for (size_t begin = 0; begin < groupRows.size(); begin += kMaxBatchRows) {
+      const auto end =
+          std::min<size_t>(begin + kMaxBatchRows, groupRows.size());
+      batchRows.resize(end - begin);
+      batchGroups.resize(end - begin);
+      for (auto i = begin; i < end; ++i) {
+        batchGroups[i - begin] = groups[groupRows[i].first];
+        batchRows[i - begin] = groupRows[i].second;
       }
 
-      groupRows.resize(accumulator->size);
-      accumulator->read(folly::Range(groupRows.data(), groupRows.size()));
-
-      sortSingleGroup(groupRows, sortingSpec);
-
       size_t firstInputColumn = 0;
       for (const auto& aggregate : aggregates) {
         std::vector<VectorPtr> aggregateInputs;
@@ -398,20 +401,15 @@ void SortedAggregations::extractValues(
               std::move(inputVectors[firstInputColumn + i]));
         }
 
-        // TODO Process group rows in batches to avoid creating very large input
-        // vectors.
-        const auto numRows =
-            extractSingleGroup(groupRows, *aggregate, aggregateInputs);
-        if (numRows == 0) {
-          firstInputColumn += aggregateInputs.size();
-          // Mask must be false for all 'groupRows'.
-          continue;
+        if (extractInputs(
+                folly::Range(batchRows.data(), batchRows.size()),
+                *aggregate,
+                aggregateInputs,
+                rows)) {
+          aggregate->function->addRawInput(
+              batchGroups.data(), rows, aggregateInputs, false);
         }
 
-        rows.resize(numRows);
-        aggregate->function->addSingleGroupRawInput(
-            group, rows, aggregateInputs, false);
-
         for (auto i = 0; i < aggregate->inputs.size(); ++i) {
           inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
         }
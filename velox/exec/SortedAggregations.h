@@ -79,7 +79,10 @@ class SortedAggregations {
       vector_size_t index);
 
   /// Sorts input row for the specified groups, computes aggregations and stores
-  /// results in the specified 'result' vector.
+  /// results in the specified 'result' vector. The rows of all groups are
+  /// sorted together by group and sorting keys and are added to the aggregates
+  /// in batches of up to 'kMaxBatchRows' rows, so that many small groups do
+  /// not each make their own sort and input vectors.
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result);
 
   uint64_t inputRowBytes() const {
@@ -89,6 +92,8 @@ class SortedAggregations {
   /// Clears all data accumulated so far. Used to release memory after spilling.
   void clear();
 
+  static constexpr vector_size_t kMaxBatchRows = 10'000;
+
  private:
   void addNewRow(char* group, char* newRow);
 
@@ -102,14 +107,20 @@ class SortedAggregations {
       const char* rhs,
       const SortingSpec& sortingSpec);
 
-  void sortSingleGroup(
-      std::vector<char*>& groupRows,
+  // Sorts the rows of 'groupRows' by their group, which is the index into
+  // the groups of extractValues(), and then by 'sortingSpec'.
+  void sortRows(
+      std::vector<std::pair<vector_size_t, char*>>& groupRows,
       const SortingSpec& sortingSpec);
 
-  vector_size_t extractSingleGroup(
-      std::vector<char*>& groupRows,
+  // Extracts the inputs of 'aggregate' for 'rows' into 'inputVectors'. Sets
+  // 'selected' to the rows for which the mask of 'aggregate' is true. Returns
+  // false if no row is selected.
+  bool extractInputs(
+      folly::Range<char**> rows,
       const AggregateInfo& aggregate,
-      std::vector<VectorPtr>& inputVectors);
+      std::vector<VectorPtr>& inputVectors,
+      SelectivityVector& selected);
 
   void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
@@ -15,9 +15,11 @@
  */
 
 #include "velox/exec/Spill.h"
+#include <folly/ScopeGuard.h>
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -35,6 +37,113 @@ const std::vector<CompareFlags> getCompareFlagsOrDefault(
   }
   return std::vector<CompareFlags>(numSortKeys);
 }
+
+std::unique_ptr<TreeOfLosers<SpillMergeStream>> createMerge(
+    const SpillFiles& files,
+    uint64_t bufferSize,
+    folly::Executor* readAheadExecutor,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  std::vector<std::unique_ptr<SpillMergeStream>> streams;
+  streams.reserve(files.size());
+  for (const auto& fileInfo : files) {
+    streams.push_back(FileSpillMergeStream::create(
+        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats),
+        readAheadExecutor));
+  }
+  // Check if the partition is empty or not.
+  if (FOLLY_UNLIKELY(streams.empty())) {
+    return nullptr;
+  }
+  return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
+}
+
+// Merges the sorted runs in 'files' into a single sorted run written to a
+// file named after the first of 'files'. Deletes 'files' afterwards.
+SpillFiles mergeSpillFiles(
+    const SpillFiles& files,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  constexpr vector_size_t kMergeBatchRows = 1'024;
+  VELOX_CHECK_GT(files.size(), 1);
+  const auto& fileInfo = files.front();
+  auto updateAndCheckSpillLimitCb = spillConfig.updateAndCheckSpillLimitCb;
+  SpillWriter writer(
+      fileInfo.type,
+      fileInfo.numSortKeys,
+      fileInfo.sortFlags,
+      fileInfo.compressionKind,
+      fmt::format("{}-merge", fileInfo.path),
+      // The merged run must stay in a single file to reduce the number of
+      // runs.
+      std::numeric_limits<uint64_t>::max(),
+      spillConfig.writeBufferSize,
+      spillConfig.fileCreateConfig,
+      fileInfo.columnarFormat,
+      updateAndCheckSpillLimitCb,
+      pool,
+      spillStats);
+  {
+    auto merge = createMerge(
+        files, spillConfig.readBufferSize, nullptr, pool, spillStats);
+    std::vector<const RowVector*> sources(kMergeBatchRows);
+    std::vector<vector_size_t> sourceRows(kMergeBatchRows);
+    RowVectorPtr output;
+    vector_size_t outputRow{0};
+    vector_size_t outputSize{0};
+    const auto copyRows = [&]() {
+      if (outputSize == 0) {
+        return;
+      }
+      if (output == nullptr) {
+        output = BaseVector::create<RowVector>(
+            fileInfo.type, kMergeBatchRows, pool);
+      }
+      gatherCopy(
+          output.get(), outputRow, outputSize, sources, sourceRows);
+      outputRow += outputSize;
+      outputSize = 0;
+    };
+    const auto writeRows = [&]() {
+      copyRows();
+      if (outputRow == 0) {
+        return;
+      }
+      output->resize(outputRow);
+      IndexRange range{0, outputRow};
+      writer.write(output, folly::Range<IndexRange*>(&range, 1));
+      output = nullptr;
+      outputRow = 0;
+    };
+    for (;;) {
+      auto* stream = merge->next();
+      if (stream == nullptr) {
+        break;
+      }
+      bool isEndOfBatch{false};
+      sources[outputSize] = &stream->current();
+      sourceRows[outputSize] = stream->currentIndex(&isEndOfBatch);
+      ++outputSize;
+      // The rows of the current batch of 'stream' must be copied out before
+      // its next batch is fetched by pop().
+      if (isEndOfBatch) {
+        copyRows();
+      }
+      stream->pop();
+      if (outputRow + outputSize == kMergeBatchRows) {
+        writeRows();
+      }
+    }
+    writeRows();
+  }
+  auto mergedFiles = writer.finish();
+  VELOX_CHECK_EQ(mergedFiles.size(), 1);
+  for (const auto& file : files) {
+    filesystems::getFileSystem(file.path, nullptr)->remove(file.path);
+  }
+  return mergedFiles;
+}
 } // namespace
 
 void SpillMergeStream::pop() {
@@ -103,7 +212,8 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool columnarFormat)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -116,6 +226,7 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
+      columnarFormat_(columnarFormat),
       pool_(pool),
       stats_(stats),
       partitionWriters_(maxPartitions_) {}
@@ -171,6 +282,7 @@ uint64_t SpillState::appendToPartition(
         targetFileSize_,
         writeBufferSize_,
         fileCreateConfig_,
+        columnarFormat_,
         updateAndCheckSpillLimitCb_,
         pool_,
         stats_);
@@ -303,18 +415,73 @@ SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* spillStats) {
-  std::vector<std::unique_ptr<SpillMergeStream>> streams;
-  streams.reserve(files_.size());
-  for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
-  }
+  auto merge = createMerge(files_, bufferSize, nullptr, pool, spillStats);
   files_.clear();
-  // Check if the partition is empty or not.
-  if (FOLLY_UNLIKELY(streams.empty())) {
-    return nullptr;
+  return merge;
+}
+
+std::unique_ptr<TreeOfLosers<SpillMergeStream>>
+SpillPartition::createOrderedReader(
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  const auto fanIn = spillConfig.mergeFanIn;
+  while (fanIn != 0 && files_.size() > fanIn) {
+    // Merges each group of 'fanIn' files into one file. The first group is
+    // merged on the calling thread and the others on the executor if set.
+    std::vector<std::shared_ptr<AsyncSource<SpillFiles>>> merges;
+    for (size_t i = 0; i < files_.size(); i += fanIn) {
+      SpillFiles group(
+          files_.begin() + i,
+          files_.begin() + std::min<size_t>(i + fanIn, files_.size()));
+      if (group.size() == 1) {
+        merges.push_back(std::make_shared<AsyncSource<SpillFiles>>(
+            [group = std::move(group)]() {
+              return std::make_unique<SpillFiles>(group);
+            }));
+        continue;
+      }
+      merges.push_back(std::make_shared<AsyncSource<SpillFiles>>(
+          [group = std::move(group), &spillConfig, pool, spillStats]() {
+            return std::make_unique<SpillFiles>(
+                mergeSpillFiles(group, spillConfig, pool, spillStats));
+          }));
+      if (merges.size() > 1 && spillConfig.executor != nullptr) {
+        spillConfig.executor->add(
+            [source = merges.back()]() { source->prepare(); });
+      }
+    }
+    auto sync = folly::makeGuard([&]() {
+      for (auto& merge : merges) {
+        // Waits for the pending merges. This is a cleanup in the guard and
+        // must not throw. The first error is already captured before this
+        // runs.
+        try {
+          merge->move();
+        } catch (const std::exception&) {
+        }
+      }
+    });
+    SpillFiles mergedFiles;
+    mergedFiles.reserve(merges.size());
+    for (auto& merge : merges) {
+      auto files = merge->move();
+      mergedFiles.insert(mergedFiles.end(), files->begin(), files->end());
+    }
+    files_ = std::move(mergedFiles);
   }
-  return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
+  auto merge = createMerge(
+      files_,
+      spillConfig.readBufferSize,
+      spillConfig.readAheadEnabled ? spillConfig.executor : nullptr,
+      pool,
+      spillStats);
+  files_.clear();
+  return merge;
+}
+
+FileSpillMergeStream::~FileSpillMergeStream() {
+  closeReadAhead();
 }
 
 uint32_t FileSpillMergeStream::id() const {
@@ -325,18 +492,48 @@ uint32_t FileSpillMergeStream::id() const {
 void FileSpillMergeStream::nextBatch() {
   VELOX_CHECK(!closed_);
   index_ = 0;
-  if (!spillFile_->nextBatch(rowVector_)) {
+  bool hasBatch{false};
+  if (readAhead_ == nullptr) {
+    hasBatch = spillFile_->nextBatch(rowVector_);
+  } else {
+    auto readAhead = std::move(readAhead_);
+    hasBatch = *readAhead->move();
+    // The previous batch has been consumed and is reused by the next read.
+    std::swap(rowVector_, nextRowVector_);
+  }
+  if (!hasBatch) {
     size_ = 0;
     close();
     return;
   }
   size_ = rowVector_->size();
+  startReadAhead();
+}
+
+void FileSpillMergeStream::startReadAhead() {
+  if (readAheadExecutor_ == nullptr) {
+    return;
+  }
+  VELOX_CHECK_NULL(readAhead_);
+  readAhead_ = std::make_shared<AsyncSource<bool>>([this]() {
+    return std::make_unique<bool>(spillFile_->nextBatch(nextRowVector_));
+  });
+  readAheadExecutor_->add([source = readAhead_]() { source->prepare(); });
+}
+
+void FileSpillMergeStream::closeReadAhead() {
+  if (readAhead_ != nullptr) {
+    readAhead_->close();
+    readAhead_.reset();
+  }
 }
 
 void FileSpillMergeStream::close() {
   VELOX_CHECK(!closed_);
+  closeReadAhead();
   SpillMergeStream::close();
   spillFile_.reset();
+  nextRowVector_.reset();
 }
 
 SpillPartitionId::SpillPartitionId(uint32_t partitionNumber)
@@ -19,6 +19,7 @@
 #include <folly/container/F14Set.h>
 
 #include <re2/re2.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -138,19 +139,27 @@ class SpillMergeStream : public MergeStream {
 /// A source of spilled RowVectors coming from a file.
 class FileSpillMergeStream : public SpillMergeStream {
  public:
+  /// If 'readAheadExecutor' is set, the next batch of 'spillFile' is read on
+  /// 'readAheadExecutor' while the current one is consumed.
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillReadFile> spillFile) {
+      std::unique_ptr<SpillReadFile> spillFile,
+      folly::Executor* readAheadExecutor = nullptr) {
     auto spillStream = std::unique_ptr<SpillMergeStream>(
-        new FileSpillMergeStream(std::move(spillFile)));
+        new FileSpillMergeStream(std::move(spillFile), readAheadExecutor));
     static_cast<FileSpillMergeStream*>(spillStream.get())->nextBatch();
     return spillStream;
   }
 
+  ~FileSpillMergeStream() override;
+
   uint32_t id() const override;
 
  private:
-  explicit FileSpillMergeStream(std::unique_ptr<SpillReadFile> spillFile)
-      : spillFile_(std::move(spillFile)) {
+  FileSpillMergeStream(
+      std::unique_ptr<SpillReadFile> spillFile,
+      folly::Executor* readAheadExecutor)
+      : spillFile_(std::move(spillFile)),
+        readAheadExecutor_(readAheadExecutor) {
     VELOX_CHECK_NOT_NULL(spillFile_);
   }
 
@@ -168,7 +177,19 @@ class FileSpillMergeStream : public SpillMergeStream {
 
   void close() override;
 
+  // Starts reading the next batch into 'nextRowVector_' on
+  // 'readAheadExecutor_' if set.
+  void startReadAhead();
+
+  // Waits for and discards the pending read-ahead if any.
+  void closeReadAhead();
+
   std::unique_ptr<SpillReadFile> spillFile_;
+  folly::Executor* const readAheadExecutor_;
+  // The batch read ahead of 'rowVector_' and the pending read that fills it.
+  // The read returns false at the end of 'spillFile_'.
+  RowVectorPtr nextRowVector_;
+  std::shared_ptr<AsyncSource<bool>> readAhead_;
 };
 
 /// A source of spilled RowVectors coming from a file. The spill data might not
@@ -345,6 +366,17 @@ class SpillPartition {
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// Same as above but reads with 'spillConfig.readBufferSize'. If
+  /// 'spillConfig.readAheadEnabled' is set, the files are read ahead on
+  /// 'spillConfig.executor'. If there are more than 'spillConfig.mergeFanIn'
+  /// files, groups of 'mergeFanIn' files are first merged into single files
+  /// in parallel on 'spillConfig.executor', level by level, until at most
+  /// 'mergeFanIn' files are left. The merged files are deleted.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
+      const common::SpillConfig& spillConfig,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   std::string toString() const;
 
  private:
@@ -367,7 +399,8 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'columnarFormat' is true, the files are written in the
+  /// encoded columnar page format described in SpillWriter.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -381,7 +414,8 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      bool columnarFormat = false);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -488,6 +522,7 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
+  const bool columnarFormat_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -15,10 +15,17 @@
  */
 
 #include "velox/exec/SpillFile.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/ByteStream.h"
 #include "velox/vector/VectorStream.h"
 
+DECLARE_bool(velox_io_uring);
+
 namespace facebook::velox::exec {
 namespace {
 // Spilling currently uses the default PrestoSerializer which by default
@@ -27,8 +34,228 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// The page header of the columnar spill format is codec(1) |
+// uncompressedSize(4) | compressedSize(4).
+constexpr int32_t kColumnarPageHeaderSize = 9;
+
+// Minimum number of rows per distinct value to dictionary encode a column in
+// the columnar spill format.
+constexpr vector_size_t kMinRowsPerDictionaryValue = 4;
+
+// Returns the approximate number of bytes 'value' takes in a Presto page.
+template <typename T>
+uint64_t serializedValueBytes(const T& /*value*/) {
+  return sizeof(T);
+}
+
+template <>
+uint64_t serializedValueBytes(const StringView& value) {
+  return sizeof(int32_t) + value.size();
+}
+
+// Returns 'column' run-length or dictionary encoded if the rows in 'ranges'
+// have one or few distinct values, otherwise returns 'column'. Each encoded
+// row refers to the first row in 'ranges' with the same value, so no values
+// are copied and the serializer only writes the referenced ones. Adds the
+// number of serialized bytes saved by the encoding to 'savedBytes'.
+template <typename T>
+VectorPtr encodeColumn(
+    const VectorPtr& column,
+    const folly::Range<IndexRange*>& ranges,
+    vector_size_t numRows,
+    memory::MemoryPool* pool,
+    uint64_t& savedBytes) {
+  // The Presto serializer flattens dictionaries over values that are not
+  // wider than the indices.
+  constexpr bool kCanUseDictionary =
+      std::is_same_v<T, StringView> || sizeof(T) > sizeof(int32_t);
+  const vector_size_t maxDistinct = kCanUseDictionary
+      ? std::max<vector_size_t>(1, numRows / kMinRowsPerDictionaryValue)
+      : 1;
+
+  const auto* flat = column->asUnchecked<FlatVector<T>>();
+  BufferPtr indices = allocateIndices(column->size(), pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  folly::F14FastMap<T, vector_size_t> firstRows;
+  std::optional<vector_size_t> firstNullRow;
+  vector_size_t numDistinct{0};
+  uint64_t flatBytes{0};
+  uint64_t distinctBytes{0};
+  for (const auto& range : ranges) {
+    for (auto row = range.begin; row < range.begin + range.size; ++row) {
+      if (flat->isNullAt(row)) {
+        if (!firstNullRow.has_value()) {
+          if (++numDistinct > maxDistinct) {
+            return column;
+          }
+          firstNullRow = row;
+        }
+        rawIndices[row] = firstNullRow.value();
+        continue;
+      }
+      const auto value = flat->valueAtFast(row);
+      const auto bytes = serializedValueBytes(value);
+      flatBytes += bytes;
+      auto [it, inserted] = firstRows.emplace(value, row);
+      if (inserted) {
+        if (++numDistinct > maxDistinct) {
+          return column;
+        }
+        distinctBytes += bytes;
+      }
+      rawIndices[row] = it->second;
+    }
+  }
+
+  if (numDistinct == 1) {
+    savedBytes += flatBytes - std::min(flatBytes, distinctBytes);
+    return BaseVector::wrapInConstant(
+        column->size(), ranges[0].begin, column);
+  }
+  const uint64_t dictionaryBytes =
+      distinctBytes + numRows * sizeof(vector_size_t);
+  if (dictionaryBytes >= flatBytes) {
+    return column;
+  }
+  savedBytes += flatBytes - dictionaryBytes;
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), column->size(), column);
+}
+
+// Returns 'rows' with the flat integer and string columns run-length or
+// dictionary encoded where this makes the serialized rows in 'ranges'
+// smaller.
+RowVectorPtr encodeColumns(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& ranges,
+    memory::MemoryPool* pool,
+    uint64_t& savedBytes) {
+  vector_size_t numRows{0};
+  for (const auto& range : ranges) {
+    numRows += range.size;
+  }
+  if (numRows == 0) {
+    return rows;
+  }
+
+  std::vector<VectorPtr> columns;
+  columns.reserve(rows->childrenSize());
+  for (const auto& column : rows->children()) {
+    if (column->encoding() != VectorEncoding::Simple::FLAT) {
+      columns.push_back(column);
+      continue;
+    }
+    switch (column->typeKind()) {
+      case TypeKind::TINYINT:
+        columns.push_back(
+            encodeColumn<int8_t>(column, ranges, numRows, pool, savedBytes));
+        break;
+      case TypeKind::SMALLINT:
+        columns.push_back(
+            encodeColumn<int16_t>(column, ranges, numRows, pool, savedBytes));
+        break;
+      case TypeKind::INTEGER:
+        columns.push_back(
+            encodeColumn<int32_t>(column, ranges, numRows, pool, savedBytes));
+        break;
+      case TypeKind::BIGINT:
+        columns.push_back(
+            encodeColumn<int64_t>(column, ranges, numRows, pool, savedBytes));
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        columns.push_back(encodeColumn<StringView>(
+            column, ranges, numRows, pool, savedBytes));
+        break;
+      default:
+        columns.push_back(column);
+        break;
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool, rows->type(), rows->nulls(), rows->size(), std::move(columns));
+}
 } // namespace
 
+SpillCodecSelector::SpillCodecSelector(
+    common::CompressionKind compressionKind) {
+  candidates_.push_back(
+      Candidate{common::CompressionKind::CompressionKind_NONE, nullptr});
+  if (compressionKind == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  candidates_.push_back(Candidate{
+      compressionKind, common::compressionKindToCodec(compressionKind)});
+  if (compressionKind != common::CompressionKind::CompressionKind_LZ4 &&
+      folly::compression::hasCodec(folly::compression::CodecType::LZ4)) {
+    candidates_.push_back(Candidate{
+        common::CompressionKind::CompressionKind_LZ4,
+        common::compressionKindToCodec(
+            common::CompressionKind::CompressionKind_LZ4)});
+  }
+}
+
+std::pair<common::CompressionKind, std::unique_ptr<folly::IOBuf>>
+SpillCodecSelector::compress(std::unique_ptr<folly::IOBuf> page) {
+  if (candidates_.size() == 1) {
+    return {common::CompressionKind::CompressionKind_NONE, std::move(page)};
+  }
+  if (numBatches_++ % kProbeInterval == 0) {
+    return probe(std::move(page));
+  }
+  const auto& candidate = candidates_[current_];
+  if (candidate.codec == nullptr) {
+    return {common::CompressionKind::CompressionKind_NONE, std::move(page)};
+  }
+  auto compressed = candidate.codec->compress(page.get());
+  if (compressed->computeChainDataLength() >= page->computeChainDataLength()) {
+    return {common::CompressionKind::CompressionKind_NONE, std::move(page)};
+  }
+  return {candidate.kind, std::move(compressed)};
+}
+
+std::pair<common::CompressionKind, std::unique_ptr<folly::IOBuf>>
+SpillCodecSelector::probe(std::unique_ptr<folly::IOBuf> page) {
+  const auto size = page->computeChainDataLength();
+  const auto writeCost = writeNanosPerByte();
+  // The first candidate is no compression, which costs only the write.
+  current_ = 0;
+  double minCost = size * writeCost;
+  std::unique_ptr<folly::IOBuf> result;
+  for (auto i = 1; i < candidates_.size(); ++i) {
+    uint64_t compressTimeNs{0};
+    std::unique_ptr<folly::IOBuf> compressed;
+    {
+      NanosecondTimer timer(&compressTimeNs);
+      compressed = candidates_[i].codec->compress(page.get());
+    }
+    const double cost =
+        compressTimeNs + compressed->computeChainDataLength() * writeCost;
+    if (cost < minCost) {
+      minCost = cost;
+      current_ = i;
+      result = std::move(compressed);
+    }
+  }
+  if (current_ == 0) {
+    return {common::CompressionKind::CompressionKind_NONE, std::move(page)};
+  }
+  return {candidates_[current_].kind, std::move(result)};
+}
+
+void SpillCodecSelector::recordWrite(uint64_t bytes, uint64_t timeNs) {
+  writtenBytes_ += bytes;
+  writeTimeNs_ += timeNs;
+}
+
+double SpillCodecSelector::writeNanosPerByte() const {
+  if (writtenBytes_ == 0) {
+    return kDefaultWriteNanosPerByte;
+  }
+  return static_cast<double>(writeTimeNs_) / writtenBytes_;
+}
+
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
     uint32_t id,
     const std::string& pathPrefix,
@@ -81,6 +308,7 @@ SpillWriter::SpillWriter(
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     const std::string& fileCreateConfig,
+    bool columnarFormat,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
@@ -92,6 +320,7 @@ SpillWriter::SpillWriter(
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
+      columnarFormat_(columnarFormat),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
@@ -128,7 +357,8 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .columnarFormat = columnarFormat_});
   currentFile_.reset();
 }
 
@@ -137,29 +367,39 @@ size_t SpillWriter::numFinishedFiles() const {
 }
 
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && columnarPages_ == nullptr) {
     return 0;
   }
 
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
 
-  IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
   uint64_t flushTimeNs{0};
-  {
-    NanosecondTimer timer(&flushTimeNs);
-    batch_->flush(&out);
+  std::unique_ptr<folly::IOBuf> iobuf;
+  if (columnarPages_ != nullptr) {
+    // The pages are serialized and compressed on write().
+    iobuf = std::move(columnarPages_);
+    columnarPagesSize_ = 0;
+  } else {
+    IOBufOutputStream out(
+        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+    {
+      NanosecondTimer timer(&flushTimeNs);
+      batch_->flush(&out);
+    }
+    batch_.reset();
+    iobuf = out.getIOBuf();
   }
-  batch_.reset();
 
   uint64_t writeTimeNs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     NanosecondTimer timer(&writeTimeNs);
     writtenBytes = file->write(std::move(iobuf));
   }
+  if (codecSelector_ != nullptr) {
+    codecSelector_->recordWrite(writtenBytes, writeTimeNs);
+  }
   updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
@@ -171,6 +411,18 @@ uint64_t SpillWriter::write(
   checkNotFinished();
 
   uint64_t timeNs{0};
+  if (columnarFormat_) {
+    {
+      NanosecondTimer timer(&timeNs);
+      appendColumnarPage(rows, indices);
+    }
+    updateAppendStats(rows->size(), timeNs);
+    if (columnarPagesSize_ < writeBufferSize_) {
+      return 0;
+    }
+    return flush();
+  }
+
   {
     NanosecondTimer timer(&timeNs);
     if (batch_ == nullptr) {
@@ -194,6 +446,53 @@ uint64_t SpillWriter::write(
   return flush();
 }
 
+uint64_t SpillWriter::appendColumnarPage(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  if (columnarSerializer_ == nullptr) {
+    // Compression is applied to the serialized page by 'codecSelector_'.
+    serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+        kDefaultUseLosslessTimestamp,
+        common::CompressionKind::CompressionKind_NONE,
+        0.8,
+        /*nullsFirst=*/true};
+    columnarSerializer_ = serde_->createBatchSerializer(pool_, &options);
+    codecSelector_ = std::make_unique<SpillCodecSelector>(compressionKind_);
+  }
+
+  uint64_t encodingSavedBytes{0};
+  const auto encodedRows =
+      encodeColumns(rows, indices, pool_, encodingSavedBytes);
+  IOBufOutputStream out(*pool_);
+  columnarSerializer_->serialize(encodedRows, indices, &out);
+  auto page = out.getIOBuf();
+  const auto uncompressedSize = page->computeChainDataLength();
+  auto [compressionKind, compressedPage] =
+      codecSelector_->compress(std::move(page));
+  const auto compressedSize = compressedPage->computeChainDataLength();
+  VELOX_CHECK_LE(uncompressedSize, std::numeric_limits<int32_t>::max());
+
+  auto header = folly::IOBuf::create(kColumnarPageHeaderSize);
+  auto* rawHeader = header->writableData();
+  rawHeader[0] = static_cast<uint8_t>(compressionKind);
+  folly::storeUnaligned<int32_t>(rawHeader + 1, uncompressedSize);
+  folly::storeUnaligned<int32_t>(rawHeader + 5, compressedSize);
+  header->append(kColumnarPageHeaderSize);
+  header->appendToChain(std::move(compressedPage));
+  if (columnarPages_ == nullptr) {
+    columnarPages_ = std::move(header);
+  } else {
+    columnarPages_->appendToChain(std::move(header));
+  }
+  const auto pageSize = kColumnarPageHeaderSize + compressedSize;
+  columnarPagesSize_ += pageSize;
+
+  auto statsLocked = stats_->wlock();
+  statsLocked->spillEncodingSavedBytes += encodingSavedBytes;
+  statsLocked->spillCompressionSavedBytes += uncompressedSize - compressedSize;
+  return pageSize;
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeNs) {
@@ -278,6 +577,7 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.columnarFormat,
       pool,
       stats));
 }
@@ -291,6 +591,7 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    bool columnarFormat,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
     : id_(id),
@@ -300,16 +601,22 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      columnarFormat_(columnarFormat),
+      // The pages of the columnar spill format are decompressed before
+      // deserialization.
       readOptions_{
           kDefaultUseLosslessTimestamp,
-          compressionKind_,
+          columnarFormat_ ? common::CompressionKind::CompressionKind_NONE
+                          : compressionKind_,
           0.8,
           /*nullsFirst=*/true},
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
       stats_(stats) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
-  auto file = fs->openFileForRead(path_);
+  filesystems::FileOptions fileOptions;
+  fileOptions.useIoUring = FLAGS_velox_io_uring;
+  auto file = fs->openFileForRead(path_, fileOptions);
   input_ = std::make_unique<common::FileInputStream>(
       std::move(file), bufferSize, pool_);
 }
@@ -323,14 +630,45 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeNs{0};
   {
     NanosecondTimer timer{&timeNs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, serde_, &rowVector, &readOptions_);
+    if (columnarFormat_) {
+      readColumnarPage(rowVector);
+    } else {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, serde_, &rowVector, &readOptions_);
+    }
   }
   stats_->wlock()->spillDeserializationTimeNanos += timeNs;
   common::updateGlobalSpillDeserializationTimeNs(timeNs);
   return true;
 }
 
+void SpillReadFile::readColumnarPage(RowVectorPtr& rowVector) {
+  const auto compressionKind =
+      static_cast<common::CompressionKind>(input_->read<uint8_t>());
+  const auto uncompressedSize = input_->read<int32_t>();
+  const auto compressedSize = input_->read<int32_t>();
+  if (compressionKind == common::CompressionKind::CompressionKind_NONE) {
+    VELOX_CHECK_EQ(uncompressedSize, compressedSize);
+    serde_->deserialize(input_.get(), pool_, type_, &rowVector, &readOptions_);
+  } else {
+    auto compressed = folly::IOBuf::create(compressedSize);
+    input_->readBytes(compressed->writableData(), compressedSize);
+    compressed->append(compressedSize);
+    auto page = common::compressionKindToCodec(compressionKind)
+                    ->uncompress(compressed.get(), uncompressedSize);
+    BufferInputStream pageInput(byteRangesFromIOBuf(page.get()));
+    serde_->deserialize(&pageInput, pool_, type_, &rowVector, &readOptions_);
+  }
+
+  // The consumers of spilled data, e.g. SpillMergeStream, expect flat columns
+  // as produced by the row wise spill format.
+  for (auto& column : rowVector->children()) {
+    if (column->encoding() != VectorEncoding::Simple::FLAT) {
+      BaseVector::flattenVector(column);
+    }
+  }
+}
+
 void SpillReadFile::recordSpillStats() {
   VELOX_CHECK(input_->atEnd());
   const auto readStats = input_->stats();
@@ -90,10 +90,62 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// True if the file is written in the columnar spill format.
+  bool columnarFormat{false};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
 
+/// Chooses the compression codec of each batch written in the columnar spill
+/// format. The candidates are no compression, lz4 and the configured spill
+/// codec. Every 'kProbeInterval' batches, compresses the batch with each
+/// candidate to measure its compression ratio and time. Picks the candidate
+/// with the lowest estimated cost of compressing and then writing a batch until
+/// the next probe. The write cost is derived from the measured write throughput
+/// of the spill files.
+class SpillCodecSelector {
+ public:
+  static constexpr int32_t kProbeInterval = 16;
+
+  /// Assumed write time per byte until a write has been recorded.
+  static constexpr double kDefaultWriteNanosPerByte = 2;
+
+  explicit SpillCodecSelector(common::CompressionKind compressionKind);
+
+  /// Compresses 'page' with the chosen codec. Returns the kind of the codec
+  /// used and the compressed page. Returns CompressionKind_NONE and 'page' if
+  /// compression does not pay off.
+  std::pair<common::CompressionKind, std::unique_ptr<folly::IOBuf>> compress(
+      std::unique_ptr<folly::IOBuf> page);
+
+  /// Records that writing 'bytes' to a spill file took 'timeNs'.
+  void recordWrite(uint64_t bytes, uint64_t timeNs);
+
+  /// Returns the codec used for the batches until the next probe.
+  common::CompressionKind currentKind() const {
+    return candidates_[current_].kind;
+  }
+
+ private:
+  struct Candidate {
+    common::CompressionKind kind;
+    std::unique_ptr<folly::compression::Codec> codec;
+  };
+
+  // Compresses 'page' with every candidate and sets 'current_' to the
+  // cheapest one. Returns the output of the chosen candidate.
+  std::pair<common::CompressionKind, std::unique_ptr<folly::IOBuf>> probe(
+      std::unique_ptr<folly::IOBuf> page);
+
+  double writeNanosPerByte() const;
+
+  std::vector<Candidate> candidates_;
+  size_t current_{0};
+  uint64_t numBatches_{0};
+  uint64_t writtenBytes_{0};
+  uint64_t writeTimeNs_{0};
+};
+
 /// Used to write the spilled data to a sequence of files for one partition. If
 /// data is sorted, each file is sorted. The globally sorted order is produced
 /// by merging the constituent files.
@@ -104,9 +156,13 @@ class SpillWriter {
   /// prefix. ' 'targetFileSize' is the target byte size of a single file.
   /// 'writeBufferSize' specifies the size limit of the buffered data before
   /// write to file. 'fileOptions' specifies the file layout on remote storage
-  /// which is storage system specific. 'pool' is used for buffering and
-  /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// which is storage system specific. If 'columnarFormat' is true, writes in
+  /// the columnar spill format: every write() call produces a page whose low
+  /// cardinality columns are dictionary or run-length encoded. The page is
+  /// compressed with a codec chosen by SpillCodecSelector with
+  /// 'compressionKind' as the configured codec. 'pool' is used for buffering
+  /// and constructing the result data read from 'this'. 'stats' is used to
+  /// collect the spill write stats.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -119,6 +175,7 @@ class SpillWriter {
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       const std::string& fileCreateConfig,
+      bool columnarFormat,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
@@ -162,10 +219,16 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Writes data from 'batch_' or 'columnarPages_' to the current output file.
+  // Returns the actual written size.
   uint64_t flush();
 
+  // Encodes, serializes and compresses the rows of 'indices' into a page
+  // appended to 'columnarPages_'. Returns the size of the page.
+  uint64_t appendColumnarPage(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -186,6 +249,7 @@ class SpillWriter {
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
+  const bool columnarFormat_;
 
   // Updates the aggregated spill bytes of this query, and throws if exceeds
   // the max spill bytes limit.
@@ -197,6 +261,14 @@ class SpillWriter {
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+
+  // Used for the columnar spill format.
+  std::unique_ptr<BatchVectorSerializer> columnarSerializer_;
+  std::unique_ptr<SpillCodecSelector> codecSelector_;
+  // The buffered pages of the columnar spill format and their total size.
+  std::unique_ptr<folly::IOBuf> columnarPages_;
+  uint64_t columnarPagesSize_{0};
+
   std::unique_ptr<SpillWriteFile> currentFile_;
   SpillFiles finishedFiles_;
 };
@@ -249,9 +321,14 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      bool columnarFormat,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
+  // Reads the next page of a file in the columnar spill format into
+  // 'rowVector'.
+  void readColumnarPage(RowVectorPtr& rowVector);
+
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
 
@@ -266,6 +343,7 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const bool columnarFormat_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
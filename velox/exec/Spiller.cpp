@@ -59,7 +59,8 @@ SpillerBase::SpillerBase(
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 
   spillRuns_.reserve(state_.maxPartitions());
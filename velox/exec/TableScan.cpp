@@ -39,6 +39,9 @@ TableScan::TableScan(
       driverCtx_(driverCtx),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      adaptiveSplitPreload_(
+          driverCtx_->queryConfig().adaptiveSplitPreloadEnabled()),
+      maxSplitPreloadBytes_(driverCtx_->queryConfig().maxSplitPreloadBytes()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       connectorPool_(driverCtx_->task->addConnectorPoolLocked(
           planNodeId(),
@@ -53,6 +56,11 @@ TableScan::TableScan(
           driverCtx_->splitGroupId,
           planNodeId())) {
   readBatchSize_ = driverCtx_->queryConfig().preferredOutputBatchRows();
+  // Adaptive preloading starts from a single split per driver and deepens
+  // once the time to open a split is known to exceed the time to process one.
+  splitPreloadDepth_ = adaptiveSplitPreload_
+      ? std::min(1, maxSplitPreloadPerDriver_)
+      : maxSplitPreloadPerDriver_;
 }
 
 bool TableScan::shouldYield(StopReason taskStopReason, size_t startTimeMs)
@@ -77,8 +85,10 @@ RowVectorPtr TableScan::getOutput() {
   if (noMoreSplits_) {
     return nullptr;
   }
-  // Check if we need to wait for scale up. We expect only wait once on startup.
-  if (shouldWaitForScaleUp()) {
+  // Check if we need to wait for scale up. We expect only wait once on startup
+  // unless the scan scales down, in which case the driver stops before its
+  // next split.
+  if (needNewSplit_ && shouldWaitForScaleUp()) {
     VELOX_CHECK(blockingFuture_.valid());
     VELOX_CHECK_EQ(blockingReason_, BlockingReason::kWaitForScanScaleUp);
     return nullptr;
@@ -186,6 +196,7 @@ RowVectorPtr TableScan::getOutput() {
     }
 
     uint64_t currNumRawInputRows{0};
+    uint64_t currNumRawInputBytes{0};
     {
       auto lockedStats = stats_.wlock();
       if (numPreloadedSplits_ > 0) {
@@ -198,11 +209,20 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (adaptiveSplitPreload_) {
+        lockedStats->addRuntimeStat(
+            "splitPreloadDepth", RuntimeCounter(splitPreloadDepth_));
+      }
       currNumRawInputRows = lockedStats->rawInputPositions;
+      currNumRawInputBytes = lockedStats->rawInputBytes;
     }
     VELOX_CHECK_LE(rawInputRowsSinceLastSplit_, currNumRawInputRows);
     const bool emptySplit = currNumRawInputRows == rawInputRowsSinceLastSplit_;
     rawInputRowsSinceLastSplit_ = currNumRawInputRows;
+    VELOX_CHECK_LE(rawInputBytesSinceLastSplit_, currNumRawInputBytes);
+    updateSplitPreloadStats(
+        currNumRawInputBytes - rawInputBytesSinceLastSplit_);
+    rawInputBytesSinceLastSplit_ = currNumRawInputBytes;
 
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
@@ -240,7 +260,11 @@ bool TableScan::getSplit() {
     dynamicFilters_.clear();
     if (dataSource_) {
       const auto connectorStats = dataSource_->runtimeStats();
+      auto latencyHistograms = dataSource_->ioLatencyHistograms();
       auto lockedStats = stats_.wlock();
+      for (auto& [name, histogram] : latencyHistograms) {
+        lockedStats->ioLatencyHistograms[name].merge(histogram);
+      }
       for (const auto& [name, counter] : connectorStats) {
         if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
           lockedStats->runtimeStats.emplace(name, RuntimeMetric(counter.unit));
@@ -295,15 +319,23 @@ bool TableScan::getSplit() {
     // The AsyncSource returns a unique_ptr to a shared_ptr. The unique_ptr
     // will be nullptr if there was a cancellation.
     numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
-    auto preparedDataSource = connectorSplit->dataSource->move();
-    stats_.wlock()->getOutputTiming.add(
-        connectorSplit->dataSource->prepareTiming());
+    uint64_t moveTimeUs{0};
+    std::unique_ptr<connector::DataSource> preparedDataSource;
+    {
+      MicrosecondTimer timer(&moveTimeUs);
+      preparedDataSource = connectorSplit->dataSource->move();
+    }
+    const auto& prepareTiming = connectorSplit->dataSource->prepareTiming();
+    stats_.wlock()->getOutputTiming.add(prepareTiming);
     if (!preparedDataSource) {
       // There must be a cancellation.
       VELOX_CHECK(operatorCtx_->task()->isCancelled());
       return false;
     }
     dataSource_->setFromDataSource(std::move(preparedDataSource));
+    // The split was opened in the background unless move() made the data
+    // source inline, in which case the prepare timing is empty.
+    splitOpenUs_ = std::max(prepareTiming.wallNanos / 1'000, moveTimeUs);
   } else {
     uint64_t addSplitTimeUs{0};
     {
@@ -313,7 +345,9 @@ bool TableScan::getSplit() {
     stats_.wlock()->addRuntimeStat(
         "dataSourceAddSplitWallNanos",
         RuntimeCounter(addSplitTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+    splitOpenUs_ = addSplitTimeUs;
   }
+  splitStartUs_ = getCurrentTimeMicro();
   ++stats_.wlock()->numSplits;
   return true;
 }
@@ -337,8 +371,21 @@ void TableScan::tryScaleUp() {
     return;
   }
 
+  ScaledScanController::SplitTiming splitTiming;
+  splitTiming.wallNanos = (getCurrentTimeMicro() - splitStartUs_) * 1'000;
+  if (dataSource_ != nullptr) {
+    const auto connectorStats = dataSource_->runtimeStats();
+    const auto it = connectorStats.find("ioWaitWallNanos");
+    if (it != connectorStats.end()) {
+      const uint64_t ioWaitNanos = it->second.value;
+      if (ioWaitNanos >= ioWaitNanosSinceLastSplit_) {
+        splitTiming.ioWaitNanos = ioWaitNanos - ioWaitNanosSinceLastSplit_;
+      }
+      ioWaitNanosSinceLastSplit_ = ioWaitNanos;
+    }
+  }
   scaledController_->updateAndTryScale(
-      operatorCtx_->driverCtx()->driverId, pool()->peakBytes());
+      operatorCtx_->driverCtx()->driverId, pool()->peakBytes(), splitTiming);
 }
 
 void TableScan::preload(
@@ -382,6 +429,29 @@ void TableScan::preload(
       });
 }
 
+void TableScan::updateSplitPreloadStats(uint64_t splitInputBytes) {
+  // The weight of the last split in the moving averages.
+  constexpr double kNewSampleWeight = 0.25;
+  const auto updateAverage = [&](double& average, double sample) {
+    average = average == 0
+        ? sample
+        : (1 - kNewSampleWeight) * average + kNewSampleWeight * sample;
+  };
+  const auto processUs = getCurrentTimeMicro() - splitStartUs_;
+  updateAverage(avgSplitOpenUs_, splitOpenUs_);
+  updateAverage(avgSplitProcessUs_, std::max<uint64_t>(processUs, 1));
+  updateAverage(avgSplitInputBytes_, splitInputBytes);
+  if (!adaptiveSplitPreload_ || maxSplitPreloadPerDriver_ == 0) {
+    return;
+  }
+  // Each driver finishes a split per 'avgSplitProcessUs_', so the splits
+  // started opening 'avgSplitOpenUs_' ahead of their turn are ready when
+  // reached if a driver keeps that many of them preloading.
+  const auto depth = std::ceil(avgSplitOpenUs_ / avgSplitProcessUs_);
+  splitPreloadDepth_ = std::max<int32_t>(
+      1, std::min<double>(depth, maxSplitPreloadPerDriver_));
+}
+
 void TableScan::checkPreload() {
   auto* executor = connector_->executor();
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
@@ -389,8 +459,15 @@ void TableScan::checkPreload() {
     return;
   }
   if (dataSource_->allPrefetchIssued()) {
+    // The preloads are applied to the head of the split queue shared by the
+    // drivers of the task, so this bounds the preloads across the task.
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        maxSplitPreloadPerDriver_;
+        splitPreloadDepth_;
+    if (maxSplitPreloadBytes_ > 0 && avgSplitInputBytes_ > 0) {
+      maxPreloadedSplits_ = std::min<double>(
+          maxPreloadedSplits_,
+          std::floor(maxSplitPreloadBytes_ / avgSplitInputBytes_));
+    }
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor,
@@ -448,5 +525,10 @@ void TableScan::close() {
   lockedStats->addRuntimeStat(
       TableScan::kNumRunningScaleThreads,
       RuntimeCounter(scaledStats.numRunningDrivers));
+  if (scaledStats.numScaleDowns > 0) {
+    lockedStats->addRuntimeStat(
+        TableScan::kNumScanScaleDowns,
+        RuntimeCounter(scaledStats.numScaleDowns));
+  }
 }
 } // namespace facebook::velox::exec
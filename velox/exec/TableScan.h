@@ -58,6 +58,9 @@ class TableScan : public SourceOperator {
   /// all the splits have been dispatched.
   static inline const std::string kNumRunningScaleThreads{
       "numRunningScaleThreads"};
+  /// The number of times the scan scaled down by a driver because of the
+  /// query memory usage.
+  static inline const std::string kNumScanScaleDowns{"numScanScaleDowns"};
 
   std::shared_ptr<ScaledScanController> testingScaledController() const {
     return scaledController_;
@@ -86,12 +89,17 @@ class TableScan : public SourceOperator {
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Updates the moving averages of the time to open and process a split and
+  // of the input bytes per split with the split just finished, and adapts
+  // 'splitPreloadDepth_' to them if adaptive preloading is enabled.
+  void updateSplitPreloadStats(uint64_t splitInputBytes);
+
   // Invoked by scan operator to check if it needs to stop to wait for scale up.
   bool shouldWaitForScaleUp();
 
   // Invoked after scan operator finishes processing a non-empty split to update
-  // the scan driver memory usage and check to see if we need to scale up scan
-  // processing or not.
+  // the scan driver memory usage and split timing, and check to see if we need
+  // to scale scan processing up or down.
   void tryScaleUp();
 
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
@@ -100,6 +108,8 @@ class TableScan : public SourceOperator {
           columnHandles_;
   DriverCtx* const driverCtx_;
   const int32_t maxSplitPreloadPerDriver_{0};
+  const bool adaptiveSplitPreload_;
+  const uint64_t maxSplitPreloadBytes_;
   const vector_size_t maxReadBatchSize_;
   memory::MemoryPool* const connectorPool_;
   const std::shared_ptr<connector::Connector> connector_;
@@ -126,6 +136,25 @@ class TableScan : public SourceOperator {
 
   int32_t maxPreloadedSplits_{0};
 
+  // The number of splits to preload per driver. Adapted between 1 and
+  // 'maxSplitPreloadPerDriver_' if 'adaptiveSplitPreload_' is set.
+  int32_t splitPreloadDepth_{0};
+
+  // Exponential moving averages of the wall time to open a split and make
+  // its data source ready, of the wall time from then until the split is
+  // finished and of the input bytes of a split.
+  double avgSplitOpenUs_{0};
+  double avgSplitProcessUs_{0};
+  double avgSplitInputBytes_{0};
+
+  // The open time of the current split and the time it was opened at.
+  uint64_t splitOpenUs_{0};
+  uint64_t splitStartUs_{0};
+
+  // The I/O wait time of 'dataSource_' when the last split finished, used for
+  // the I/O wait of a split reported to 'scaledController_'.
+  uint64_t ioWaitNanosSinceLastSplit_{0};
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -147,5 +176,8 @@ class TableScan : public SourceOperator {
   // The total number of raw input rows read up till the last finished split.
   // This is used to detect if a finished split is empty or not.
   uint64_t rawInputRowsSinceLastSplit_{0};
+
+  // The total number of raw input bytes read up till the last finished split.
+  uint64_t rawInputBytesSinceLastSplit_{0};
 };
 } // namespace facebook::velox::exec
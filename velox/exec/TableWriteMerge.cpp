@@ -33,6 +33,13 @@ bool isSameCommitContext(
              second[TableWriteTraits::kCommitStrategyContextKey]);
 }
 
+// Returns the json encoded commit context of the last row of 'input'.
+StringView commitContextString(const RowVectorPtr& input) {
+  auto* contextVector = input->childAt(TableWriteTraits::kContextChannel)
+                            ->as<SimpleVector<StringView>>();
+  return contextVector->valueAt(input->size() - 1);
+}
+
 bool containsNonNullRows(const VectorPtr& vector) {
   if (!vector->mayHaveNulls()) {
     return true;
@@ -84,16 +91,23 @@ void TableWriteMerge::addInput(RowVectorPtr input) {
   // Increments row count.
   numRows_ += TableWriteTraits::getRowCount(input);
 
-  // Makes sure the lifespan is the same.
-  auto commitContext = TableWriteTraits::getTableCommitContext(input);
-  if (lastCommitContext_ != nullptr) {
-    VELOX_CHECK(
-        isSameCommitContext(lastCommitContext_, commitContext),
-        "incompatible table commit context: {} is not compatible with {}",
-        lastCommitContext_.asString(),
-        commitContext.asString());
+  // Makes sure the lifespan is the same. The writers of a query mostly send
+  // the same commit context, which is then not parsed again.
+  const auto commitContextJson = commitContextString(input);
+  if (lastCommitContext_ == nullptr ||
+      commitContextJson != StringView(lastCommitContextJson_)) {
+    auto commitContext = folly::parseJson(commitContextJson);
+    if (lastCommitContext_ != nullptr) {
+      VELOX_CHECK(
+          isSameCommitContext(lastCommitContext_, commitContext),
+          "incompatible table commit context: {} is not compatible with {}",
+          lastCommitContext_.asString(),
+          commitContext.asString());
+    }
+    lastCommitContext_ = std::move(commitContext);
+    lastCommitContextJson_ = commitContextJson.str();
+    nonLastCommitContext_.clear();
   }
-  lastCommitContext_ = commitContext;
 
   // Adds fragments to the buffer. Fragments will be emitted as soon as possible
   // to avoid using extra memory.
@@ -122,11 +136,10 @@ RowVectorPtr TableWriteMerge::getOutput() {
   }
 
   if (aggregation_ != nullptr && !aggregation_->isFinished()) {
-    const std::string commitContext = createTableCommitContext(false);
     return TableWriteTraits::createAggregationStatsOutput(
         outputType_,
         aggregation_->getOutput(),
-        StringView(commitContext),
+        StringView(nonLastCommitContext()),
         pool());
   }
   finished_ = true;
@@ -145,14 +158,13 @@ RowVectorPtr TableWriteMerge::createFragmentsOutput() {
     if (outputChannel == TableWriteTraits::kFragmentChannel) {
       outputColumns[outputChannel] = std::move(outputFragmentVector);
     } else if (outputChannel == TableWriteTraits::kContextChannel) {
-      const std::string commitContext = createTableCommitContext(false);
       outputColumns[outputChannel] =
           std::make_shared<ConstantVector<StringView>>(
               pool(),
               numOutputRows,
               false /*isNull*/,
               outputType_->childAt(outputChannel),
-              StringView(commitContext));
+              StringView(nonLastCommitContext()));
     } else {
       outputColumns[outputChannel] = BaseVector::createNullConstant(
           outputType_->childAt(outputChannel), numOutputRows, pool());
@@ -168,6 +180,13 @@ std::string TableWriteMerge::createTableCommitContext(bool lastOutput) const {
   return folly::toJson(commitContext);
 }
 
+const std::string& TableWriteMerge::nonLastCommitContext() {
+  if (nonLastCommitContext_.empty()) {
+    nonLastCommitContext_ = createTableCommitContext(false);
+  }
+  return nonLastCommitContext_;
+}
+
 RowVectorPtr TableWriteMerge::createLastOutput() {
   VELOX_CHECK(
       lastCommitContext_[TableWriteTraits::klastPageContextKey].asBool(),
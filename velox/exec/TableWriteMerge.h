@@ -59,6 +59,10 @@ class TableWriteMerge : public Operator {
   // 'lastOutput' flag.
   std::string createTableCommitContext(bool lastOutput) const;
 
+  // Returns createTableCommitContext(false), which is only made again when
+  // 'lastCommitContext_' changes.
+  const std::string& nonLastCommitContext();
+
   // Creates the last output and fragment columns must be null.
   RowVectorPtr createLastOutput();
 
@@ -71,5 +75,9 @@ class TableWriteMerge : public Operator {
   int64_t numRows_{0};
   std::queue<VectorPtr> fragmentVectors_;
   folly::dynamic lastCommitContext_;
+  // The json of 'lastCommitContext_' as received from the writers.
+  std::string lastCommitContextJson_;
+  // Cache of nonLastCommitContext().
+  std::string nonLastCommitContext_;
 };
 } // namespace facebook::velox::exec
@@ -298,6 +298,19 @@ void TableWriter::updateStats(const connector::DataSink::Stats& stats) {
           RuntimeCounter(
               stats.writeIOTimeUs * 1000, RuntimeCounter::Unit::kNanos));
     }
+    if (stats.writeStallTimeUs != 0) {
+      lockedStats->addRuntimeStat(
+          kWriteStallTime,
+          RuntimeCounter(
+              stats.writeStallTimeUs * 1000, RuntimeCounter::Unit::kNanos));
+    }
+    if (stats.backgroundWriteTimeUs != 0) {
+      lockedStats->addRuntimeStat(
+          kBackgroundWriteTime,
+          RuntimeCounter(
+              stats.backgroundWriteTimeUs * 1000,
+              RuntimeCounter::Unit::kNanos));
+    }
     if (stats.recodeTimeNs != 0) {
       lockedStats->addRuntimeStat(
           kWriteRecodeTime,
@@ -147,6 +147,13 @@ class TableWriter : public Operator {
   static inline const std::string kNumWrittenFiles{"numWrittenFiles"};
   /// The file write IO walltime.
   static inline const std::string kWriteIOTime{"writeIOWallNanos"};
+  /// The walltime the writer waited for background file writes, e.g. for
+  /// uploads in flight to object storage.
+  static inline const std::string kWriteStallTime{"writeStallWallNanos"};
+  /// The walltime of background file writes. Together with the physical
+  /// written bytes this gives the upload throughput.
+  static inline const std::string kBackgroundWriteTime{
+      "backgroundWriteWallNanos"};
   /// The walltime spend on file write data recoding.
   static inline const std::string kWriteRecodeTime{"writeRecodeWallNanos"};
   /// The walltime spent on file write data compression.
@@ -16,6 +16,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/hash/Hash.h>
 #include <string>
 
 #include "velox/common/base/Counters.h"
@@ -32,6 +33,7 @@
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/TopNThreshold.h"
 #include "velox/exec/TraceUtil.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -313,6 +315,11 @@ Task::Task(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
 
+  if (const auto capacity = queryCtx_->queryConfig().taskTimelineCapacity();
+      capacity > 0) {
+    timeline_ = std::make_unique<TaskTimeline>(capacity);
+  }
+
   maybeInitTrace();
 }
 
@@ -492,6 +499,14 @@ uint64_t Task::driverCpuTimeSliceLimitMs() const {
       : queryCtx_->queryConfig().driverCpuTimeSliceLimitMs();
 }
 
+uint64_t Task::affinityHint() const {
+  const auto affinityHint = affinityHint_.load();
+  if (affinityHint != kNoAffinityHint) {
+    return affinityHint;
+  }
+  return folly::hasher<const memory::MemoryPool*>()(queryCtx_->pool());
+}
+
 void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
@@ -1157,6 +1172,10 @@ void Task::createSplitGroupStateLocked(uint32_t splitGroupId) {
       addScaledScanControllerLocked(
           splitGroupId, tableScanNodeId, factory->numDrivers);
     }
+
+    if (queryCtx_->queryConfig().topNDynamicFilterEnabled()) {
+      addTopNThresholdsLocked(splitGroupId, factory->needsTopNThresholds());
+    }
   }
 }
 
@@ -1697,7 +1716,30 @@ void Task::addScaledScanControllerLocked(
       std::make_shared<ScaledScanController>(
           getOrAddNodePool(planNodeId),
           numDrivers,
-          queryCtx_->queryConfig().tableScanScaleUpMemoryUsageRatio()));
+          queryCtx_->queryConfig().tableScanScaleUpMemoryUsageRatio(),
+          queryCtx_->executor()));
+}
+
+std::shared_ptr<TopNThreshold> Task::getTopNThresholdLocked(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  auto it = splitGroupState.topNThresholds.find(planNodeId);
+  if (it == splitGroupState.topNThresholds.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+void Task::addTopNThresholdsLocked(
+    uint32_t splitGroupId,
+    const std::vector<core::PlanNodeId>& planNodeIds) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  for (const auto& planNodeId : planNodeIds) {
+    VELOX_CHECK_EQ(splitGroupState.topNThresholds.count(planNodeId), 0);
+    splitGroupState.topNThresholds.emplace(
+        planNodeId, std::make_shared<TopNThreshold>());
+  }
 }
 
 void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
@@ -1938,7 +1980,6 @@ void Task::addCustomJoinBridgesLocked(
           inserted,
           "Join bridge for node {} is already present",
           planNode->id());
-      return;
     }
   }
 }
@@ -2263,6 +2304,32 @@ void Task::addDriverStats(int pipelineId, DriverStats stats) {
   taskStats_.pipelineStats[pipelineId].driverStats.push_back(std::move(stats));
 }
 
+std::string Task::timelineTrace() const {
+  if (timeline_ == nullptr) {
+    return "";
+  }
+  // The operator labels per pipeline and operator id.
+  std::vector<std::vector<std::string>> labels;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    labels.resize(taskStats_.pipelineStats.size());
+    for (auto i = 0; i < taskStats_.pipelineStats.size(); ++i) {
+      for (const auto& stats : taskStats_.pipelineStats[i].operatorStats) {
+        labels[i].push_back(
+            fmt::format("{} {}", stats.operatorType, stats.planNodeId));
+      }
+    }
+  }
+  return timeline_->toChromeTrace(
+      taskId_, [&](int32_t pipelineId, int32_t operatorId) -> std::string {
+        if (pipelineId < labels.size() &&
+            operatorId < labels[pipelineId].size()) {
+          return labels[pipelineId][operatorId];
+        }
+        return std::to_string(operatorId);
+      });
+}
+
 TaskStats Task::taskStats() const {
   std::lock_guard<std::timed_mutex> l(mutex_);
 
@@ -2324,6 +2391,9 @@ TaskStats Task::taskStats() const {
   if (!taskStats.outputBufferStats.has_value()) {
     taskStats.outputBufferStats = bufferManager->stats(taskId_);
   }
+  if (!stackProfile_.empty()) {
+    taskStats.foldedStacks = stackProfile_.toFolded();
+  }
   return taskStats;
 }
 
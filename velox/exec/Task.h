@@ -27,6 +27,7 @@
 #include "velox/exec/TableScan.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/exec/TaskTimeline.h"
 #include "velox/exec/TaskTraceWriter.h"
 #include "velox/vector/ComplexVector.h"
 
@@ -151,6 +152,17 @@ class Task : public std::enable_shared_from_this<Task> {
   /// disabled) when task is under serial mode.
   uint64_t driverCpuTimeSliceLimitMs() const;
 
+  /// Returns the hint used by DriverExecutor to run the drivers of this task
+  /// on the same NUMA node. Defaults to a hash of the query memory pool, so
+  /// that the tasks of a query, including the pipelines that share a
+  /// HashJoinBridge, run close to the memory they share.
+  uint64_t affinityHint() const;
+
+  /// Overrides the default affinity hint of this task.
+  void setAffinityHint(uint64_t affinityHint) {
+    affinityHint_ = affinityHint;
+  }
+
   /// Returns QueryCtx specified in the constructor.
   const std::shared_ptr<core::QueryCtx>& queryCtx() const {
     return queryCtx_;
@@ -448,6 +460,12 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the threshold shared by the drivers of a given TopN node, or
+  /// nullptr if 'topn_dynamic_filter_enabled' is false.
+  std::shared_ptr<TopNThreshold> getTopNThresholdLocked(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
   void multipleSplitsFinished(
@@ -585,6 +603,27 @@ class Task : public std::enable_shared_from_this<Task> {
   /// stats. Called from Drivers upon their closure.
   void addOperatorStats(OperatorStats& stats);
 
+  /// Adds a stack sample with 'numFrames' 'frames', innermost first, taken in
+  /// an operator of 'planNodeId' to the stack profile of the task. Called
+  /// from Drivers when the query records stack samples.
+  void addStackSample(
+      const core::PlanNodeId& planNodeId,
+      const uintptr_t* frames,
+      int32_t numFrames) {
+    stackProfile_.add(planNodeId, frames, numFrames);
+  }
+
+  /// Returns the timeline of the Drivers of the task, nullptr if
+  /// QueryConfig::kTaskTimelineCapacity is 0.
+  TaskTimeline* timeline() const {
+    return timeline_.get();
+  }
+
+  /// Returns the timeline of the Drivers as Chrome trace event JSON, with the
+  /// operators labeled by type and plan node id. Returns an empty string if
+  /// the task keeps no timeline.
+  std::string timelineTrace() const;
+
   /// Adds per driver statistics.  Called from Drivers upon their closure.
   void addDriverStats(int pipelineId, DriverStats stats);
 
@@ -803,6 +842,11 @@ class Task : public std::enable_shared_from_this<Task> {
       const core::PlanNodeId& planNodeId,
       uint32_t numDrivers);
 
+  // Creates the shared thresholds for the given TopN nodes.
+  void addTopNThresholdsLocked(
+      uint32_t splitGroupId,
+      const std::vector<core::PlanNodeId>& planNodeIds);
+
   // Creates new instance of memory pool for a plan node, stores it in the task
   // to ensure lifetime and returns a raw pointer.
   memory::MemoryPool* getOrAddNodePool(const core::PlanNodeId& planNodeId);
@@ -1069,6 +1113,11 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::shared_ptr<core::QueryCtx> queryCtx_;
 
+  // Set by setAffinityHint(). kNoAffinityHint if not set.
+  static constexpr uint64_t kNoAffinityHint =
+      std::numeric_limits<uint64_t>::max();
+  std::atomic_uint64_t affinityHint_{kNoAffinityHint};
+
   core::PlanFragment planFragment_;
 
   const std::optional<trace::TraceConfig> traceConfig_;
@@ -1253,6 +1302,13 @@ class Task : public std::enable_shared_from_this<Task> {
 
   TaskStats taskStats_;
 
+  // The stack samples taken in the operators of the task per plan node.
+  process::StackProfile stackProfile_;
+
+  // The on thread, queued and blocked intervals of the Drivers. nullptr if
+  // disabled by QueryConfig::kTaskTimelineCapacity.
+  std::unique_ptr<TaskTimeline> timeline_;
+
   // Stores inter-operator state (exchange, bridges) per split group. During
   // ungrouped execution we use the [0] entry in this vector.
   std::unordered_map<uint32_t, SplitGroupState> splitGroupStates_;
@@ -121,6 +121,12 @@ struct TaskStats {
   uint32_t memoryReclaimCount{0};
   /// The total memory reclamation time.
   uint64_t memoryReclaimMs{0};
+
+  /// The folded stacks of the stack samples taken in the operators of each
+  /// plan node if the query records stack samples. See
+  /// process::StackProfile::toFolded() for the format. The stacks of the tasks
+  /// of a query can be concatenated to get the profile of the query.
+  std::unordered_map<core::PlanNodeId, std::string> foldedStacks;
 };
 
 } // namespace facebook::velox::exec
@@ -26,6 +26,7 @@ class LocalExchangeMemoryManager;
 class MergeSource;
 class MergeJoinSource;
 struct Split;
+class TopNThreshold;
 
 /// Corresponds to Presto TaskState, needed for reporting query completion.
 enum class TaskState : int {
@@ -121,6 +122,11 @@ struct SplitGroupState {
   std::unordered_map<core::PlanNodeId, std::shared_ptr<ScaledScanController>>
       scaledScanControllers;
 
+  /// Map of TopN thresholds keyed on TopN plan node ID. Set only if
+  /// 'topn_dynamic_filter_enabled' is true.
+  std::unordered_map<core::PlanNodeId, std::shared_ptr<TopNThreshold>>
+      topNThresholds;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskTimeline.h"
+
+#include <folly/json.h>
+
+#include <optional>
+#include <set>
+
+namespace facebook::velox::exec {
+
+namespace {
+
+const char* kindName(TaskTimeline::Event::Kind kind) {
+  switch (kind) {
+    case TaskTimeline::Event::Kind::kOnThread:
+      return "onThread";
+    case TaskTimeline::Event::Kind::kQueued:
+      return "queued";
+    case TaskTimeline::Event::Kind::kBlocked:
+      return "blocked";
+  }
+  return "unknown";
+}
+
+// Returns a metadata event that names the process 'pid' or the thread 'tid' of
+// it '<prefix> <id>'.
+folly::dynamic metadataEvent(
+    const char* name,
+    int32_t pid,
+    std::optional<int32_t> tid,
+    const char* prefix,
+    int32_t id) {
+  folly::dynamic event = folly::dynamic::object;
+  event["name"] = name;
+  event["ph"] = "M";
+  event["pid"] = pid;
+  if (tid.has_value()) {
+    event["tid"] = tid.value();
+  }
+  event["args"] =
+      folly::dynamic::object("name", fmt::format("{} {}", prefix, id));
+  return event;
+}
+
+} // namespace
+
+TaskTimeline::TaskTimeline(uint32_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+void TaskTimeline::add(const Event& event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < capacity_) {
+    events_.push_back(event);
+  } else {
+    events_[numAdded_ % capacity_] = event;
+  }
+  ++numAdded_;
+}
+
+std::vector<TaskTimeline::Event> TaskTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numAdded_ <= capacity_) {
+    return events_;
+  }
+  // The oldest event is the one to be overwritten next.
+  const auto oldest = numAdded_ % capacity_;
+  std::vector<Event> events;
+  events.reserve(capacity_);
+  events.insert(events.end(), events_.begin() + oldest, events_.end());
+  events.insert(events.end(), events_.begin(), events_.begin() + oldest);
+  return events;
+}
+
+uint64_t TaskTimeline::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numAdded_ > capacity_ ? numAdded_ - capacity_ : 0;
+}
+
+std::string TaskTimeline::toChromeTrace(
+    const std::string& taskId,
+    const std::function<std::string(int32_t pipelineId, int32_t operatorId)>&
+        operatorLabel) const {
+  const auto allEvents = events();
+  folly::dynamic traceEvents = folly::dynamic::array;
+  std::set<int32_t> pipelineIds;
+  std::set<std::pair<int32_t, int32_t>> driverIds;
+  for (const auto& event : allEvents) {
+    pipelineIds.insert(event.pipelineId);
+    driverIds.emplace(event.pipelineId, event.driverId);
+
+    folly::dynamic args = folly::dynamic::object;
+    if (event.operatorId >= 0) {
+      args["operatorId"] = event.operatorId;
+      args["operator"] = operatorLabel(event.pipelineId, event.operatorId);
+    }
+    std::string name;
+    switch (event.kind) {
+      case Event::Kind::kOnThread:
+        name = "Running";
+        break;
+      case Event::Kind::kQueued:
+        name = "Queued";
+        break;
+      case Event::Kind::kBlocked:
+        name = blockingReasonToString(event.reason);
+        break;
+    }
+    const auto durationUs =
+        event.endUs > event.startUs ? event.endUs - event.startUs : 0;
+    folly::dynamic traceEvent = folly::dynamic::object;
+    traceEvent["name"] = name;
+    traceEvent["cat"] = kindName(event.kind);
+    traceEvent["ph"] = "X";
+    traceEvent["ts"] = static_cast<int64_t>(event.startUs);
+    traceEvent["dur"] = static_cast<int64_t>(durationUs);
+    traceEvent["pid"] = event.pipelineId;
+    traceEvent["tid"] = event.driverId;
+    traceEvent["args"] = std::move(args);
+    traceEvents.push_back(std::move(traceEvent));
+  }
+  // Names the processes and threads after the pipelines and Drivers.
+  for (auto pipelineId : pipelineIds) {
+    traceEvents.push_back(metadataEvent(
+        "process_name", pipelineId, std::nullopt, "Pipeline", pipelineId));
+  }
+  for (const auto& [pipelineId, driverId] : driverIds) {
+    traceEvents.push_back(
+        metadataEvent("thread_name", pipelineId, driverId, "Driver", driverId));
+  }
+
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"] = folly::dynamic::object("taskId", taskId)(
+      "numDroppedEvents", static_cast<int64_t>(numDropped()));
+  return folly::toJson(trace);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+/// Bounded log of the intervals the Drivers of a Task spend on thread, queued
+/// for a thread and blocked. Keeps the last 'capacity' intervals and drops
+/// the older ones. Enabled by QueryConfig::kTaskTimelineCapacity. The
+/// intervals are recorded once per Driver quantum and blocking, so the
+/// overhead is a few lock acquisitions per quantum. Thread-safe.
+class TaskTimeline {
+ public:
+  struct Event {
+    enum class Kind : uint8_t {
+      /// Running on a thread.
+      kOnThread,
+      /// Ready to run and waiting for a thread of the executor.
+      kQueued,
+      /// Blocked on a future of an operator, see 'reason'.
+      kBlocked,
+    };
+
+    Kind kind;
+    /// The reason of a kBlocked interval, kNotBlocked for the others.
+    BlockingReason reason{BlockingReason::kNotBlocked};
+    int32_t pipelineId;
+    int32_t driverId;
+    /// The id of the operator that blocked the Driver for kBlocked and of the
+    /// last operator run for kOnThread. -1 for kQueued.
+    int32_t operatorId{-1};
+    uint64_t startUs;
+    uint64_t endUs;
+  };
+
+  explicit TaskTimeline(uint32_t capacity);
+
+  void add(const Event& event);
+
+  /// Returns the retained events in the order they were added.
+  std::vector<Event> events() const;
+
+  /// Returns the number of events dropped because of the capacity.
+  uint64_t numDropped() const;
+
+  /// Returns the events in the Chrome trace event JSON format, which can be
+  /// loaded by chrome://tracing and Perfetto. Each pipeline is a process and
+  /// each Driver a thread of it. 'operatorLabel' returns the name of an
+  /// operator, e.g. its type and plan node id, from the pipeline and operator
+  /// ids.
+  std::string toChromeTrace(
+      const std::string& taskId,
+      const std::function<std::string(int32_t pipelineId, int32_t operatorId)>&
+          operatorLabel) const;
+
+ private:
+  const uint32_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Ring buffer of the last 'capacity_' events. The next event goes to
+  // 'numAdded_' % 'capacity_'.
+  std::vector<Event> events_;
+  uint64_t numAdded_{0};
+};
+
+} // namespace facebook::velox::exec
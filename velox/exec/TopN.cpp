@@ -16,10 +16,13 @@
 #include <folly/container/F14Map.h>
 
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Task.h"
 #include "velox/exec/TopN.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -47,6 +50,27 @@ TopN::TopN(
     sortingKeyColumns_.emplace_back(exprToChannel(key.get(), outputType_));
     isSortingKey[sortingKeyColumns_.back()] = true;
   }
+  std::vector<TypePtr> keyTypes;
+  std::vector<CompareFlags> compareFlags;
+  for (auto i = 0; i < numSortingKeys; ++i) {
+    const auto& order = topNNode->sortingOrders()[i];
+    keyTypes.push_back(outputType_->childAt(sortingKeyColumns_[i]));
+    compareFlags.push_back({order.isNullsFirst(), order.isAscending()});
+  }
+  prefixEncoder_ = PrefixSortKeyEncoder::create(
+      keyTypes, compareFlags, driverCtx->prefixSortConfig());
+  if (prefixEncoder_ != nullptr) {
+    topPrefix_.resize(prefixEncoder_->prefixSize());
+  }
+
+  if (canMakeCutoffFilter(keyTypes[0])) {
+    threshold_ = driverCtx->task->getTopNThresholdLocked(
+        driverCtx->splitGroupId, planNodeId());
+    thresholdFlags_ = compareFlags[0];
+    thresholdValue_ = BaseVector::create(keyTypes[0], 1, pool());
+    reportedThresholdValue_ = BaseVector::create(keyTypes[0], 1, pool());
+  }
+
   if (numColumns > numSortingKeys) {
     nonKeyColumns_.reserve(numColumns - numSortingKeys);
     for (column_index_t i = 0; i < numColumns; ++i) {
@@ -61,6 +85,14 @@ void TopN::addInput(RowVectorPtr input) {
   for (const auto col : sortingKeyColumns_) {
     decodedVectors_[col].decode(*input->childAt(col));
   }
+  if (prefixEncoder_ != nullptr) {
+    std::vector<const DecodedVector*> keys;
+    for (const auto col : sortingKeyColumns_) {
+      keys.push_back(&decodedVectors_[col]);
+    }
+    inputPrefixes_.resize(input->size() * prefixEncoder_->prefixSize());
+    prefixEncoder_->encode(keys, input->size(), inputPrefixes_.data());
+  }
 
   const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
   // Maps passed rows of 'data_' to the corresponding input row number. These
@@ -73,7 +105,7 @@ void TopN::addInput(RowVectorPtr input) {
     } else {
       char* topRow = topRows_.top();
 
-      if (!comparator_(decodedVectors_, row, topRow)) {
+      if (!isBeforeTopRow(row, topRow)) {
         continue;
       }
       topRows_.pop();
@@ -87,6 +119,7 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     topRows_.push(newRow);
+    topPrefixValid_ = false;
     if (hasNonKeyColumn) {
       passedRows[newRow] = row;
     }
@@ -106,6 +139,64 @@ void TopN::addInput(RowVectorPtr input) {
   }
 }
 
+  updateThreshold();
+}
+
+void TopN::updateThreshold() {
+  if (threshold_ == nullptr) {
+    return;
+  }
+  const auto channel = sortingKeyColumns_[0];
+  if (!canPushdownThreshold_.has_value()) {
+    canPushdownThreshold_ =
+        !operatorCtx_->driver()->canPushdownFilters(this, {channel}).empty();
+  }
+  if (!canPushdownThreshold_.value()) {
+    return;
+  }
+
+  if (topRows_.size() == count_) {
+    char* topRow = topRows_.top();
+    data_->extractColumn(&topRow, 1, channel, thresholdValue_);
+    if (!thresholdReported_ ||
+        !thresholdValue_->equalValueAt(reportedThresholdValue_.get(), 0, 0)) {
+      auto filter = makeCutoffFilter(*thresholdValue_, 0, thresholdFlags_);
+      if (filter != nullptr) {
+        threshold_->update(*filter);
+      }
+      std::swap(thresholdValue_, reportedThresholdValue_);
+      thresholdReported_ = true;
+    }
+  }
+
+  if (threshold_->version() == pushedThresholdVersion_) {
+    return;
+  }
+  if (auto filter = threshold_->filter(pushedThresholdVersion_)) {
+    dynamicFilters_[channel] = std::move(filter);
+  }
+}
+
+bool TopN::isBeforeTopRow(vector_size_t row, char* topRow) {
+  if (prefixEncoder_ != nullptr) {
+    if (!topPrefixValid_) {
+      prefixEncoder_->encode(
+          *data_, topRow, sortingKeyColumns_, topPrefix_.data());
+      topPrefixValid_ = true;
+    }
+    const auto result = prefixEncoder_->compare(
+        inputPrefixes_.data() + row * prefixEncoder_->prefixSize(),
+        topPrefix_.data());
+    if (result != 0) {
+      return result < 0;
+    }
+    if (prefixEncoder_->isComplete()) {
+      return false;
+    }
+  }
+  return comparator_(decodedVectors_, row, topRow);
+}
+
 RowVectorPtr TopN::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
@@ -143,6 +234,11 @@ void TopN::noMoreInput() {
   }
 
   outputBatchSize_ = outputBatchRows(data_->estimateRowSize());
+  if (prefixEncoder_ != nullptr) {
+    addRuntimeStat(
+        PrefixSort::kNumPrefixSortKeys,
+        RuntimeCounter(prefixEncoder_->numNormalizedKeys()));
+  }
 }
 
 bool TopN::isFinished() {
@@ -16,7 +16,9 @@
 #pragma once
 
 #include "velox/exec/Operator.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/TopNThreshold.h"
 
 namespace facebook::velox::exec {
 
@@ -44,6 +46,14 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Returns true if 'row' of the input sorts before 'topRow'.
+  bool isBeforeTopRow(vector_size_t row, char* topRow);
+
+  // Reports the first sorting key of the top row to 'threshold_' if the heap
+  // is full and sets 'dynamicFilters_' if the shared cutoff has changed since
+  // it was last pushed down.
+  void updateThreshold();
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -68,5 +78,31 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Encodes the sorting keys into prefixes that compare with memcmp. Input
+  // rows are compared with the top row by prefix and only ties are compared
+  // with 'comparator_'. Not set if the first sorting key cannot be encoded.
+  std::unique_ptr<PrefixSortKeyEncoder> prefixEncoder_;
+  // Prefixes of the rows of the current input.
+  std::vector<char> inputPrefixes_;
+  // Prefix of the top row of 'topRows_'. Valid if 'topPrefixValid_' is true.
+  std::vector<char> topPrefix_;
+  bool topPrefixValid_{false};
+
+  // Cutoff on the first sorting key shared with the other drivers of the
+  // pipeline. Set if 'topn_dynamic_filter_enabled' is true and a filter can be
+  // made for the type of the first sorting key.
+  std::shared_ptr<TopNThreshold> threshold_;
+  CompareFlags thresholdFlags_;
+  // True if an upstream operator accepts a filter on the first sorting key.
+  // Set on the first input.
+  std::optional<bool> canPushdownThreshold_;
+  // Version of 'threshold_' last added to 'dynamicFilters_'.
+  uint64_t pushedThresholdVersion_{0};
+  // First sorting key of the top row, and its value when last reported to
+  // 'threshold_'.
+  VectorPtr thresholdValue_;
+  VectorPtr reportedThresholdValue_;
+  bool thresholdReported_{false};
 };
 } // namespace facebook::velox::exec
@@ -140,6 +140,18 @@ TopNRowNumber::TopNRowNumber(
           node->sortingOrders(),
           data_.get()),
       decodedVectors_(inputType_->size()) {
+  const auto numSortingKeys = node->sortingKeys().size();
+  std::vector<TypePtr> sortingKeyTypes;
+  std::vector<CompareFlags> compareFlags;
+  for (auto i = 0; i < numSortingKeys; ++i) {
+    const auto& order = node->sortingOrders()[i];
+    sortingKeyColumns_.push_back(numPartitionKeys_ + i);
+    sortingKeyTypes.push_back(inputType_->childAt(numPartitionKeys_ + i));
+    compareFlags.push_back({order.isNullsFirst(), order.isAscending()});
+  }
+  prefixEncoder_ = PrefixSortKeyEncoder::create(
+      sortingKeyTypes, compareFlags, driverCtx->prefixSortConfig());
+
   const auto& keys = node->partitionKeys();
   const auto numKeys = keys.size();
 
@@ -182,6 +194,20 @@ void TopNRowNumber::prepareInput(RowVectorPtr& input) {
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
+  encodeInputPrefixes(input->size());
+}
+
+void TopNRowNumber::encodeInputPrefixes(vector_size_t numInput) {
+  if (prefixEncoder_ == nullptr) {
+    return;
+  }
+  std::vector<const DecodedVector*> keys;
+  keys.reserve(sortingKeyColumns_.size());
+  for (const auto col : sortingKeyColumns_) {
+    keys.push_back(&decodedVectors_[col]);
+  }
+  inputPrefixes_.resize(numInput * prefixEncoder_->prefixSize());
+  prefixEncoder_->encode(keys, numInput, inputPrefixes_.data());
 }
 
 void TopNRowNumber::addInput(RowVectorPtr input) {
@@ -258,7 +284,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   } else {
     char* topRow = topRows.top();
 
-    if (!comparator_(decodedVectors_, index, topRow)) {
+    if (!isBeforeTopRow(index, partition)) {
       // Drop this input row.
       return;
     }
@@ -275,6 +301,29 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   }
 
   topRows.push(newRow);
+  partition.topPrefixValid = false;
+}
+
+bool TopNRowNumber::isBeforeTopRow(vector_size_t index, TopRows& partition) {
+  char* topRow = partition.rows.top();
+  if (prefixEncoder_ != nullptr) {
+    const auto prefixSize = prefixEncoder_->prefixSize();
+    if (!partition.topPrefixValid) {
+      partition.topPrefix.resize(prefixSize);
+      prefixEncoder_->encode(
+          *data_, topRow, sortingKeyColumns_, partition.topPrefix.data());
+      partition.topPrefixValid = true;
+    }
+    const auto result = prefixEncoder_->compare(
+        inputPrefixes_.data() + index * prefixSize, partition.topPrefix.data());
+    if (result != 0) {
+      return result < 0;
+    }
+    if (prefixEncoder_->isComplete()) {
+      return false;
+    }
+  }
+  return comparator_(decodedVectors_, index, topRow);
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -282,6 +331,11 @@ void TopNRowNumber::noMoreInput() {
 
   updateEstimatedOutputRowSize();
   outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+  if (prefixEncoder_ != nullptr) {
+    addRuntimeStat(
+        PrefixSort::kNumPrefixSortKeys,
+        RuntimeCounter(prefixEncoder_->numNormalizedKeys()));
+  }
 
   if (spiller_ != nullptr) {
     // Spill remaining data to avoid running out of memory while sort-merging
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -84,8 +85,14 @@ class TopNRowNumber : public Operator {
     std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
         rows;
 
+    // Prefix of the sorting keys of the top row. Valid if 'topPrefixValid' is
+    // true. Allocated when the partition first reaches the limit.
+    std::vector<char, StlAllocator<char>> topPrefix;
+    bool topPrefixValid{false};
+
     TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+        : rows{{comparator}, StlAllocator<char*>(allocator)},
+          topPrefix{StlAllocator<char>(allocator)} {}
   };
 
   void initializeNewPartitions();
@@ -97,6 +104,13 @@ class TopNRowNumber : public Operator {
   // Decodes and potentially loads input if lazy vector.
   void prepareInput(RowVectorPtr& input);
 
+  // Encodes the sorting keys of the input into 'inputPrefixes_'.
+  void encodeInputPrefixes(vector_size_t numInput);
+
+  // Returns true if input row 'index' sorts before the top row of
+  // 'partition'.
+  bool isBeforeTopRow(vector_size_t index, TopRows& partition);
+
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
@@ -210,6 +224,18 @@ class TopNRowNumber : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
 
+  // Columns of the sorting keys in 'data_'.
+  std::vector<column_index_t> sortingKeyColumns_;
+
+  // Encodes the sorting keys into prefixes that compare with memcmp. Input
+  // rows are compared with the top row of their partition by prefix and only
+  // ties are compared with 'comparator_'. Not set if the first sorting key
+  // cannot be encoded.
+  std::unique_ptr<PrefixSortKeyEncoder> prefixEncoder_;
+
+  // Prefixes of the rows of the current input.
+  std::vector<char> inputPrefixes_;
+
   bool finished_{false};
 
   // Size of a single output row estimated using 'data_->estimateRowSize()'.
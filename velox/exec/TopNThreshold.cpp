@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TopNThreshold.h"
+
+namespace facebook::velox::exec {
+
+void TopNThreshold::update(const common::Filter& filter) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (filter_ == nullptr) {
+    filter_ = filter.clone();
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
+  version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::shared_ptr<common::Filter> TopNThreshold::filter(uint64_t& version) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  version = version_.load(std::memory_order_relaxed);
+  return filter_;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::exec {
+
+/// Cutoff on the first sorting key shared by the TopN drivers of a pipeline.
+/// A driver whose heap is full reports a filter that passes the first sorting
+/// key values that can still make it into its top rows. Rows rejected by the
+/// filter of any driver are not in the result, so the intersection of the
+/// reported filters applies to all the drivers and is pushed down into the
+/// table scans feeding them.
+class TopNThreshold {
+ public:
+  TopNThreshold() = default;
+
+  TopNThreshold(const TopNThreshold&) = delete;
+  TopNThreshold& operator=(const TopNThreshold&) = delete;
+
+  /// Intersects the shared filter with 'filter'.
+  void update(const common::Filter& filter);
+
+  /// Incremented on each update. Lets the drivers check for a new cutoff
+  /// without taking the lock.
+  uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  /// Returns the shared filter, or nullptr if no driver has reported one yet.
+  /// Sets 'version' to the version of the returned filter.
+  std::shared_ptr<common::Filter> filter(uint64_t& version) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::shared_ptr<common::Filter> filter_;
+  std::atomic<uint64_t> version_{0};
+};
+
+} // namespace facebook::velox::exec
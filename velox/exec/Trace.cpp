@@ -24,9 +24,10 @@
 namespace facebook::velox::exec::trace {
 
 std::string OperatorTraceSummary::toString() const {
+  std::string result;
   if (numSplits.has_value()) {
     VELOX_CHECK_EQ(opType, "TableScan");
-    return fmt::format(
+    result = fmt::format(
         "opType {}, numSplits {}, inputRows {}, inputBytes {}, rawInputRows {}, rawInputBytes {}, peakMemory {}",
         opType,
         numSplits.value(),
@@ -37,7 +38,7 @@ std::string OperatorTraceSummary::toString() const {
         succinctBytes(peakMemory));
   } else {
     VELOX_CHECK_NE(opType, "TableScan");
-    return fmt::format(
+    result = fmt::format(
         "opType {}, inputRows {},  inputBytes {}, rawInputRows {}, rawInputBytes {}, peakMemory {}",
         opType,
         inputRows,
@@ -46,5 +47,9 @@ std::string OperatorTraceSummary::toString() const {
         succinctBytes(rawInputBytes),
         succinctBytes(peakMemory));
   }
+  if (numDroppedBatches > 0) {
+    result += fmt::format(", numDroppedBatches {}", numDroppedBatches);
+  }
+  return result;
 }
 } // namespace facebook::velox::exec::trace
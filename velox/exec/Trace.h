@@ -44,6 +44,7 @@ struct OperatorTraceTraits {
   static inline const std::string kRawInputRowsKey = "rawInputRows";
   static inline const std::string kRawInputBytesKey = "rawInputBytes";
   static inline const std::string kNumSplitsKey = "numSplits";
+  static inline const std::string kNumDroppedBatchesKey = "numDroppedBatches";
 };
 
 /// Contains the summary of an operator trace.
@@ -58,6 +59,9 @@ struct OperatorTraceSummary {
   uint64_t rawInputRows{0};
   uint64_t rawInputBytes{0};
   uint64_t peakMemory{0};
+  /// The number of input batches that the asynchronous trace writer dropped
+  /// because it fell behind. The trace misses these batches.
+  uint64_t numDroppedBatches{0};
 
   std::string toString() const;
 };
@@ -58,6 +58,7 @@ Unnest::Unnest(
 
 void Unnest::addInput(RowVectorPtr input) {
   input_ = std::move(input);
+  maxOutputSize_ = outputBatchRows();
 
   for (auto& child : input_->children()) {
     child->loadedVector();
@@ -179,12 +180,24 @@ Unnest::RowRange Unnest::extractRowRange(vector_size_t size) const {
 void Unnest::generateRepeatedColumns(
     const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  VELOX_DCHECK_GT(range.size, 0);
+  if (range.size == 1) {
+    // All output rows come from one input row, e.g. a slice of a large array.
+    // Repeat the row as a constant instead of allocating indices.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          range.numElements,
+          range.start,
+          input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(range.numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  VELOX_DCHECK_GT(range.size, 0);
   // Record the row number to process.
   range.forEachRow(
       [&](vector_size_t row, vector_size_t /*start*/, vector_size_t size) {
@@ -205,9 +218,54 @@ void Unnest::generateRepeatedColumns(
   }
 }
 
+std::optional<vector_size_t> Unnest::contiguousElementsOffset(
+    column_index_t channel,
+    const RowRange& range) const {
+  const auto& currentDecoded = unnestDecoded_[channel];
+  const auto* currentSizes = rawSizes_[channel];
+  const auto* currentOffsets = rawOffsets_[channel];
+  const auto* currentIndices = rawIndices_[channel];
+
+  std::optional<vector_size_t> firstOffset;
+  vector_size_t nextOffset = 0;
+  bool contiguous = true;
+  range.forEachRow(
+      [&](vector_size_t row, vector_size_t start, vector_size_t size) {
+        if (!contiguous || size == 0) {
+          return;
+        }
+        if (currentDecoded.isNullAt(row) ||
+            currentSizes[currentIndices[row]] < start + size) {
+          // Needs null padding.
+          contiguous = false;
+          return;
+        }
+        const auto offset = currentOffsets[currentIndices[row]] + start;
+        if (!firstOffset.has_value()) {
+          firstOffset = offset;
+        } else if (offset != nextOffset) {
+          contiguous = false;
+          return;
+        }
+        nextOffset = offset + size;
+      },
+      rawMaxSizes_,
+      firstRowStart_);
+
+  if (!contiguous) {
+    return std::nullopt;
+  }
+  return firstOffset;
+}
+
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
     const RowRange& range) {
+  VELOX_DCHECK_GT(range.size, 0);
+  if (const auto offset = contiguousElementsOffset(channel, range)) {
+    return {nullptr, nullptr, offset};
+  }
+
   BufferPtr elementIndices = allocateIndices(range.numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
@@ -221,21 +279,12 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
 
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
-  bool identityMapping = true;
-  VELOX_DCHECK_GT(range.size, 0);
-
   range.forEachRow(
       [&](vector_size_t row, vector_size_t start, vector_size_t size) {
         const auto end = start + size;
         if (!currentDecoded.isNullAt(row)) {
           const auto offset = currentOffsets[currentIndices[row]];
           const auto unnestSize = currentSizes[currentIndices[row]];
-          // The 'identityMapping' is false when there exists a partially
-          // processed row.
-          if (index != offset || start != 0 || end != rawMaxSizes_[row] ||
-              unnestSize < end) {
-            identityMapping = false;
-          }
           auto currentUnnestSize = std::min(end, unnestSize);
           for (auto i = start; i < currentUnnestSize; i++) {
             rawElementIndices[index++] = offset + i;
@@ -245,8 +294,6 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
             bits::setNull(rawNulls, index++, true);
           }
         } else if (size > 0) {
-          identityMapping = false;
-
           for (auto i = start; i < end; ++i) {
             bits::setNull(rawNulls, index++, true);
           }
@@ -255,16 +302,16 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
       rawMaxSizes_,
       firstRowStart_);
 
-  return {elementIndices, nulls, identityMapping};
+  return {elementIndices, nulls, std::nullopt};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
-  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
-      BIGINT(), range.numElements, pool());
+  prepareOutputVector(ordinalityVector_, BIGINT(), range.numElements);
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
-  auto* rawOrdinality = ordinalityVector->mutableRawValues();
+  auto* rawOrdinality =
+      ordinalityVector_->asUnchecked<FlatVector<int64_t>>()->mutableRawValues();
 
   VELOX_DCHECK_GT(range.size, 0);
 
@@ -276,7 +323,7 @@ VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
       rawMaxSizes_,
       firstRowStart_);
 
-  return ordinalityVector;
+  return ordinalityVector_;
 }
 
 RowVectorPtr Unnest::generateOutput(const RowRange& range) {
@@ -323,8 +370,13 @@ RowVectorPtr Unnest::generateOutput(const RowRange& range) {
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  if (contiguousOffset.has_value()) {
+    if (contiguousOffset.value() == 0) {
+      return base;
+    }
+    // Shares the buffers of 'base', so a large array split across output
+    // batches is not materialized.
+    return base->slice(contiguousOffset.value(), wrapSize);
   }
 
   const auto result =
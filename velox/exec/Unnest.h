@@ -109,7 +109,11 @@ class Unnest : public Operator {
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    // Set when the output elements are the contiguous range of the base
+    // vector starting at this offset, with no null padding. 'indices' and
+    // 'nulls' are not allocated in this case and the output is a zero-copy
+    // slice of the base vector.
+    std::optional<vector_size_t> contiguousOffset;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
@@ -120,7 +124,16 @@ class Unnest : public Operator {
       column_index_t channel,
       const RowRange& rowRange);
 
-  // Invoked by generateOutput for the ordinality column.
+  // Returns the offset of the first element if the elements of 'channel' in
+  // 'rowRange' are consecutive in the base vector and no row needs null
+  // padding, e.g. the whole range is a part of one large array. Returns
+  // std::nullopt otherwise.
+  std::optional<vector_size_t> contiguousElementsOffset(
+      column_index_t channel,
+      const RowRange& rowRange) const;
+
+  // Invoked by generateOutput for the ordinality column. Reuses
+  // 'ordinalityVector_' if the downstream has released the previous output.
   VectorPtr generateOrdinalityVector(const RowRange& rowRange);
 
   const bool withOrdinality_;
@@ -128,8 +141,9 @@ class Unnest : public Operator {
 
   std::vector<DecodedVector> unnestDecoded_;
 
-  // The maximum number of output batch rows.
-  const uint32_t maxOutputSize_;
+  // The maximum number of output batch rows. Updated for each input to follow
+  // the Driver's adaptive output batch rows.
+  uint32_t maxOutputSize_;
   BufferPtr maxSizes_;
   vector_size_t* rawMaxSizes_{nullptr};
 
@@ -142,5 +156,8 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // The ordinality column of the last output.
+  VectorPtr ordinalityVector_;
 };
 } // namespace facebook::velox::exec
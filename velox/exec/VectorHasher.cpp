@@ -15,12 +15,17 @@
  */
 
 #include "velox/exec/VectorHasher.h"
+
+#include <gflags/gflags.h>
+
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/type/FloatingPointUtil.h"
 
+DECLARE_bool(velox_cache_string_hashes);
+
 namespace facebook::velox::exec {
 
 #define VALUE_ID_TYPE_DISPATCH(TEMPLATE_FUNC, typeKind, ...)             \
@@ -75,6 +80,77 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
     }
   }
 }
+
+// Masks for the bytes of strings of 0 to 7 bytes.
+constexpr uint64_t kShortStringMasks[] = {
+    0,
+    0xff,
+    0xffff,
+    0xffffff,
+    0xffffffff,
+    0xffffffffff,
+    0xffffffffffff,
+    0xffffffffffffff};
+
+// Returns the same as bits::hashBytes(1, data, size) for a string of less than
+// 8 bytes whose bytes are in the low bytes of 'word'.
+inline uint64_t hashShortString(uint64_t word, uint32_t size) {
+  const auto data = word & kShortStringMasks[size];
+  const uint64_t low = simd::crc32U64(1, data);
+  const uint64_t high = simd::crc32U64(1, data >> 32);
+  return low | (high << 32);
+}
+
+// Sets hashes[rows[i]] to the hash of values[rows[i]] for the first 'numRows'
+// of 'rows'. The hash is the same as folly::hasher<StringView>. Strings of
+// less than 8 bytes are inlined in their StringView. These are hashed a batch
+// at a time: their bytes are gathered into SIMD lanes and the CRCs of the
+// lanes are independent, so that they overlap in the pipeline.
+void hashStringViews(
+    const StringView* values,
+    const vector_size_t* rows,
+    int32_t numRows,
+    uint64_t* hashes) {
+  using Batch = xsimd::batch<uint64_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  // A StringView is 2 words. The first has the size in its low and the 4
+  // byte prefix in its high half. The second starts with the inlined bytes
+  // after the prefix.
+  static_assert(sizeof(StringView) == 2 * sizeof(uint64_t));
+  const auto* words = reinterpret_cast<const uint64_t*>(values);
+  int32_t i = 0;
+  for (; i + kBatchSize <= numRows; i += kBatchSize) {
+    int32_t indices[kBatchSize];
+    for (auto j = 0; j < kBatchSize; ++j) {
+      indices[j] = rows[i + j] * 2;
+    }
+    const auto first = simd::gather(words, indices);
+    const auto second = simd::gather(words + 1, indices);
+    uint64_t sizes[kBatchSize];
+    uint64_t data[kBatchSize];
+    (first & Batch::broadcast(0xffffffff)).store_unaligned(sizes);
+    ((first >> 32) | (second << 32)).store_unaligned(data);
+    bool allShort = true;
+    for (auto j = 0; j < kBatchSize; ++j) {
+      allShort &= sizes[j] < sizeof(uint64_t);
+    }
+    if (allShort) {
+      for (auto j = 0; j < kBatchSize; ++j) {
+        hashes[rows[i + j]] = hashShortString(data[j], sizes[j]);
+      }
+      continue;
+    }
+    for (auto j = 0; j < kBatchSize; ++j) {
+      const auto row = rows[i + j];
+      hashes[row] = sizes[j] < sizeof(uint64_t)
+          ? hashShortString(data[j], sizes[j])
+          : folly::hasher<StringView>()(values[row]);
+    }
+  }
+  for (; i < numRows; ++i) {
+    hashes[rows[i]] = folly::hasher<StringView>()(values[rows[i]]);
+  }
+}
 } // namespace
 
 template <bool typeProvidesCustomComparison, TypeKind Kind>
@@ -83,6 +159,12 @@ void VectorHasher::hashValues(
     bool mix,
     uint64_t* result) {
   using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (!typeProvidesCustomComparison && Kind == TypeKind::VARCHAR) {
+    if (decoded_.isIdentityMapping() && decoded_.base()->isFlatEncoding()) {
+      hashStrings(rows, mix, result);
+      return;
+    }
+  }
   if (decoded_.isConstantMapping()) {
     auto hash = decoded_.isNullAt(rows.begin())
         ? kNullHash
@@ -120,6 +202,40 @@ void VectorHasher::hashValues(
   }
 }
 
+void VectorHasher::hashStrings(
+    const SelectivityVector& rows,
+    bool mix,
+    uint64_t* result) {
+  const auto* base = decoded_.base()->asUnchecked<SimpleVector<StringView>>();
+  cachedHashes_.resize(rows.end());
+  auto* hashes = cachedHashes_.data();
+  const bool useCache = FLAGS_velox_cache_string_hashes;
+  if (!useCache || !base->getCachedHashes(rows, hashes)) {
+    nonNullRows_.resize(rows.end());
+    int32_t numNonNull = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      if (decoded_.isNullAt(row)) {
+        hashes[row] = kNullHash;
+      } else {
+        nonNullRows_[numNonNull++] = row;
+      }
+    });
+    hashStringViews(
+        decoded_.data<StringView>(), nonNullRows_.data(), numNonNull, hashes);
+    if (useCache) {
+      base->setCachedHashes(rows, hashes);
+    }
+  }
+  if (mix) {
+    rows.applyToSelected([&](vector_size_t row) {
+      result[row] = bits::hashMix(result[row], hashes[row]);
+    });
+  } else {
+    rows.applyToSelected(
+        [&](vector_size_t row) { result[row] = hashes[row]; });
+  }
+}
+
 template <TypeKind Kind>
 bool VectorHasher::makeValueIds(
     const SelectivityVector& rows,
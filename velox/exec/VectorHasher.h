@@ -543,6 +543,10 @@ class VectorHasher {
   template <bool typeProvidesCustomComparison, TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Hashes the strings of a flat vector. Reuses and saves the hashes cached on
+  // the vector if this is enabled.
+  void hashStrings(const SelectivityVector& rows, bool mix, uint64_t* result);
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -550,6 +554,9 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // Scratch for the non-null rows of a string vector in hashStrings().
+  raw_vector<vector_size_t> nonNullRows_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
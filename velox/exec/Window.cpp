@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include <folly/ScopeGuard.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionStreamingWindowBuild.h"
 #include "velox/exec/RowsStreamingWindowBuild.h"
@@ -37,8 +39,7 @@ Window::Window(
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
       windowNode_(windowNode),
-      currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      currentPartition_(nullptr) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (spillConfig == nullptr &&
@@ -58,10 +59,7 @@ Window::Window(
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode,
         pool(),
-        common::PrefixSortConfig{
-            driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes(),
-            driverCtx->queryConfig().prefixSortMinRows(),
-            driverCtx->queryConfig().prefixSortMaxStringPrefixLength()},
+        driverCtx->prefixSortConfig(),
         spillConfig,
         &nonReclaimableSection_,
         &spillStats_);
@@ -72,7 +70,12 @@ void Window::initialize() {
   Operator::initialize();
   VELOX_CHECK_NOT_NULL(windowNode_);
   createWindowFunctions();
-  createPeerAndFrameBuffers();
+  // TODO: This computation needs to be revised. It only takes into account
+  // the input columns size. We need to also account for the output columns.
+  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
+  for (auto& lane : lanes_) {
+    createPeerAndFrameBuffers(lane);
+  }
   windowBuild_->setNumRowsPerOutput(numRowsPerOutput_);
   windowNode_.reset();
 }
@@ -159,10 +162,8 @@ Window::WindowFrame Window::createWindowFrame(
       return std::make_optional(
           FrameChannelArg{kConstantChannel, nullptr, value});
     } else {
-      return std::make_optional(FrameChannelArg{
-          frameChannel,
-          BaseVector::create(frame->type(), 0, pool()),
-          std::nullopt});
+      return std::make_optional(
+          FrameChannelArg{frameChannel, frame->type(), std::nullopt});
     }
   };
 
@@ -176,11 +177,50 @@ Window::WindowFrame Window::createWindowFrame(
        std::move(endFrameArg)});
 }
 
+uint32_t Window::numParallelLanes() const {
+  const auto parallelism =
+      operatorCtx_->driverCtx()->queryConfig().windowParallelism();
+  // Only the partitions of SortWindowBuild are complete before their output
+  // starts.
+  if (parallelism == 1 || windowNode_->inputsSorted() ||
+      operatorCtx_->task()->queryCtx()->executor() == nullptr) {
+    return 1;
+  }
+  // The results of aggregate window functions only depend on the frame of
+  // each row. The other functions, e.g. rank or lag, carry state from row to
+  // row.
+  for (const auto& windowFunction : windowNode_->windowFunctions()) {
+    if (!exec::getWindowFunctionMetadata(windowFunction.functionCall->name())
+             .isAggregate) {
+      return 1;
+    }
+  }
+  return parallelism;
+}
+
 void Window::createWindowFunctions() {
   VELOX_CHECK_NOT_NULL(windowNode_);
-  VELOX_CHECK(windowFunctions_.empty());
+  VELOX_CHECK(lanes_.empty());
   VELOX_CHECK(windowFrames_.empty());
 
+  const auto& inputType = windowNode_->sources()[0]->outputType();
+  for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
+    windowFrames_.push_back(
+        createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
+  }
+
+  lanes_.resize(numParallelLanes());
+  for (auto& lane : lanes_) {
+    createLaneFunctions(lane);
+  }
+  if (lanes_.size() > 1) {
+    executor_ = operatorCtx_->task()->queryCtx()->executor();
+  }
+}
+
+void Window::createLaneFunctions(Lane& lane) {
+  lane.stringAllocator = std::make_unique<HashStringAllocator>(pool());
+
   const auto& inputType = windowNode_->sources()[0]->outputType();
   for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
     std::vector<WindowFunctionArg> functionArgs;
@@ -196,17 +236,14 @@ void Window::createWindowFunctions() {
       }
     }
 
-    windowFunctions_.push_back(WindowFunction::create(
+    lane.windowFunctions.push_back(WindowFunction::create(
         windowNodeFunction.functionCall->name(),
         functionArgs,
         windowNodeFunction.functionCall->type(),
         windowNodeFunction.ignoreNulls,
         operatorCtx_->pool(),
-        &stringAllocator_,
+        lane.stringAllocator.get(),
         operatorCtx_->driverCtx()->queryConfig()));
-
-    windowFrames_.push_back(
-        createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
   }
 }
 
@@ -259,29 +296,37 @@ void Window::reclaim(
   windowBuild_->spill();
 }
 
-void Window::createPeerAndFrameBuffers() {
-  // TODO: This computation needs to be revised. It only takes into account
-  // the input columns size. We need to also account for the output columns.
-  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
-
-  peerStartBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+void Window::createPeerAndFrameBuffers(Lane& lane) {
+  lane.peerStartBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
-  peerEndBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+  lane.peerEndBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
 
-  const auto numFuncs = windowFunctions_.size();
-  frameStartBuffers_.reserve(numFuncs);
-  frameEndBuffers_.reserve(numFuncs);
-  validFrames_.reserve(numFuncs);
+  const auto numFuncs = lane.windowFunctions.size();
+  lane.frameStartBuffers.reserve(numFuncs);
+  lane.frameEndBuffers.reserve(numFuncs);
+  lane.validFrames.reserve(numFuncs);
+  lane.frameStartValues.reserve(numFuncs);
+  lane.frameEndValues.reserve(numFuncs);
+
+  const auto makeFrameValues =
+      [&](const std::optional<FrameChannelArg>& frameArg) -> VectorPtr {
+    if (!frameArg.has_value() || frameArg->index == kConstantChannel) {
+      return nullptr;
+    }
+    return BaseVector::create(frameArg->type, 0, pool());
+  };
 
   for (auto i = 0; i < numFuncs; i++) {
     BufferPtr frameStartBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
     BufferPtr frameEndBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
-    frameStartBuffers_.push_back(frameStartBuffer);
-    frameEndBuffers_.push_back(frameEndBuffer);
-    validFrames_.push_back(SelectivityVector(numRowsPerOutput_));
+    lane.frameStartBuffers.push_back(frameStartBuffer);
+    lane.frameEndBuffers.push_back(frameEndBuffer);
+    lane.validFrames.push_back(SelectivityVector(numRowsPerOutput_));
+    lane.frameStartValues.push_back(makeFrameValues(windowFrames_[i].start));
+    lane.frameEndValues.push_back(makeFrameValues(windowFrames_[i].end));
   }
 }
 
@@ -292,17 +337,30 @@ void Window::noMoreInput() {
 
 void Window::callResetPartition() {
   partitionOffset_ = 0;
-  peerStartRow_ = 0;
-  peerEndRow_ = 0;
+  auto& lane = lanes_[0];
+  lane.peerStartRow = 0;
+  lane.peerEndRow = 0;
   currentPartition_ = nullptr;
   if (windowBuild_->hasNextPartition()) {
     currentPartition_ = windowBuild_->nextPartition();
-    for (int i = 0; i < windowFunctions_.size(); ++i) {
-      windowFunctions_[i]->resetPartition(currentPartition_.get());
-    }
+    ++numPartitions_;
+    // The other lanes are reset when they are first used for the partition.
+    resetLanePartition(lane);
   }
 }
 
+void Window::resetLanePartition(Lane& lane) {
+  for (auto& windowFunction : lane.windowFunctions) {
+    windowFunction->resetPartition(currentPartition_.get());
+  }
+  lane.partitionNumber = numPartitions_;
+}
+
+void Window::seekPeerGroup(Lane& lane, vector_size_t row) {
+  std::tie(lane.peerStartRow, lane.peerEndRow) =
+      currentPartition_->findPeerGroup(row);
+}
+
 namespace {
 
 template <typename T>
@@ -348,6 +406,7 @@ void updateKRowsOffsetsColumn(
 void Window::updateKRowsFrameBounds(
     bool isKPreceding,
     const FrameChannelArg& frameArg,
+    const VectorPtr& frameValues,
     vector_size_t startRow,
     vector_size_t numRows,
     vector_size_t* rawFrameBounds) {
@@ -392,13 +451,13 @@ void Window::updateKRowsFrameBounds(
     std::iota(rawFrameBounds, rawFrameBounds + numRows, startValue);
   } else {
     currentPartition_->extractColumn(
-        frameArg.index, partitionOffset_, numRows, 0, frameArg.value);
-    if (frameArg.value->typeKind() == TypeKind::INTEGER) {
+        frameArg.index, startRow, numRows, 0, frameValues);
+    if (frameValues->typeKind() == TypeKind::INTEGER) {
       updateKRowsOffsetsColumn<int32_t>(
-          isKPreceding, frameArg.value, startRow, numRows, rawFrameBounds);
+          isKPreceding, frameValues, startRow, numRows, rawFrameBounds);
     } else {
       updateKRowsOffsetsColumn<int64_t>(
-          isKPreceding, frameArg.value, startRow, numRows, rawFrameBounds);
+          isKPreceding, frameValues, startRow, numRows, rawFrameBounds);
     }
   }
 }
@@ -406,6 +465,7 @@ void Window::updateKRowsFrameBounds(
 void Window::updateFrameBounds(
     const WindowFrame& windowFrame,
     const bool isStartBound,
+    const VectorPtr& frameValues,
     const vector_size_t startRow,
     const vector_size_t numRows,
     const vector_size_t* rawPeerStarts,
@@ -440,7 +500,12 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kPreceding: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            true, frameArg.value(), startRow, numRows, rawFrameBounds);
+            true,
+            frameArg.value(),
+            frameValues,
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
         currentPartition_->computeKRangeFrameBounds(
             isStartBound,
@@ -457,7 +522,12 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kFollowing: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            false, frameArg.value(), startRow, numRows, rawFrameBounds);
+            false,
+            frameArg.value(),
+            frameValues,
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
         currentPartition_->computeKRangeFrameBounds(
             isStartBound,
@@ -511,58 +581,67 @@ void computeValidFrames(
 } // namespace
 
 void Window::computePeerAndFrameBuffers(
+    Lane& lane,
     vector_size_t startRow,
     vector_size_t endRow) {
   const vector_size_t numRows = endRow - startRow;
-  const vector_size_t numFuncs = windowFunctions_.size();
+  const vector_size_t numFuncs = lane.windowFunctions.size();
 
   // Size buffers for the call to WindowFunction::apply.
   const auto bufferSize = numRows * sizeof(vector_size_t);
-  peerStartBuffer_->setSize(bufferSize);
-  peerEndBuffer_->setSize(bufferSize);
-  auto* rawPeerStarts = peerStartBuffer_->asMutable<vector_size_t>();
-  auto* rawPeerEnds = peerEndBuffer_->asMutable<vector_size_t>();
+  lane.peerStartBuffer->setSize(bufferSize);
+  lane.peerEndBuffer->setSize(bufferSize);
+  auto* rawPeerStarts = lane.peerStartBuffer->asMutable<vector_size_t>();
+  auto* rawPeerEnds = lane.peerEndBuffer->asMutable<vector_size_t>();
 
   std::vector<vector_size_t*> rawFrameStarts;
   std::vector<vector_size_t*> rawFrameEnds;
   rawFrameStarts.reserve(numFuncs);
   rawFrameEnds.reserve(numFuncs);
   for (auto i = 0; i < numFuncs; ++i) {
-    frameStartBuffers_[i]->setSize(bufferSize);
-    frameEndBuffers_[i]->setSize(bufferSize);
+    lane.frameStartBuffers[i]->setSize(bufferSize);
+    lane.frameEndBuffers[i]->setSize(bufferSize);
 
-    auto* rawFrameStart = frameStartBuffers_[i]->asMutable<vector_size_t>();
-    auto* rawFrameEnd = frameEndBuffers_[i]->asMutable<vector_size_t>();
+    auto* rawFrameStart = lane.frameStartBuffers[i]->asMutable<vector_size_t>();
+    auto* rawFrameEnd = lane.frameEndBuffers[i]->asMutable<vector_size_t>();
     rawFrameStarts.push_back(rawFrameStart);
     rawFrameEnds.push_back(rawFrameEnd);
   }
 
-  std::tie(peerStartRow_, peerEndRow_) = currentPartition_->computePeerBuffers(
-      startRow, endRow, peerStartRow_, peerEndRow_, rawPeerStarts, rawPeerEnds);
+  std::tie(lane.peerStartRow, lane.peerEndRow) =
+      currentPartition_->computePeerBuffers(
+          startRow,
+          endRow,
+          lane.peerStartRow,
+          lane.peerEndRow,
+          rawPeerStarts,
+          rawPeerEnds);
 
   for (auto i = 0; i < numFuncs; ++i) {
     const auto& windowFrame = windowFrames_[i];
     // Default all rows to have validFrames. The invalidity of frames is only
     // computed for k rows/range frames at a later point.
-    validFrames_[i].resizeFill(numRows, true);
+    lane.validFrames[i].resizeFill(numRows, true);
     updateFrameBounds(
         windowFrame,
         true,
+        lane.frameStartValues[i],
         startRow,
         numRows,
         rawPeerStarts,
         rawPeerEnds,
         rawFrameStarts[i],
-        validFrames_[i]);
+        lane.validFrames[i]);
     updateFrameBounds(
         windowFrame,
         false,
+        lane.frameEndValues[i],
         startRow,
         numRows,
         rawPeerStarts,
         rawPeerEnds,
         rawFrameEnds[i],
-        validFrames_[i]);
+        lane.validFrames[i]);
     if (windowFrames_[i].start || windowFrames_[i].end) {
       // k preceding and k following bounds can be problematic. They can go over
       // the partition limits or result in empty frames. Fix the frame
@@ -575,7 +654,7 @@ void Window::computePeerAndFrameBuffers(
           numRows,
           rawFrameStarts[i],
           rawFrameEnds[i],
-          validFrames_[i]);
+          lane.validFrames[i]);
     }
   }
 }
@@ -588,11 +667,12 @@ void Window::getInputColumns(
   const auto numRows = endRow - startRow;
   for (int i = 0; i < numInputColumns_; ++i) {
     currentPartition_->extractColumn(
-        i, partitionOffset_, numRows, resultOffset, result->childAt(i));
+        i, startRow, numRows, resultOffset, result->childAt(i));
   }
 }
 
-void Window::callApplyForPartitionRows(
+void Window::applyLane(
+    Lane& lane,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
@@ -601,20 +681,28 @@ void Window::callApplyForPartitionRows(
   // processed rows (used for peer group comparison) will be deleted by
   // computePeerAndFrameBuffers after peer group comparison. Hence we need to
   // call getInputColumns after computePeerAndFrameBuffers.
-  computePeerAndFrameBuffers(startRow, endRow);
+  computePeerAndFrameBuffers(lane, startRow, endRow);
 
   getInputColumns(startRow, endRow, resultOffset, result);
-  vector_size_t numFuncs = windowFunctions_.size();
+  vector_size_t numFuncs = lane.windowFunctions.size();
   for (auto i = 0; i < numFuncs; ++i) {
-    windowFunctions_[i]->apply(
-        peerStartBuffer_,
-        peerEndBuffer_,
-        frameStartBuffers_[i],
-        frameEndBuffers_[i],
-        validFrames_[i],
+    lane.windowFunctions[i]->apply(
+        lane.peerStartBuffer,
+        lane.peerEndBuffer,
+        lane.frameStartBuffers[i],
+        lane.frameEndBuffers[i],
+        lane.validFrames[i],
         resultOffset,
         result->childAt(numInputColumns_ + i));
   }
+}
+
+void Window::callApplyForPartitionRows(
+    vector_size_t startRow,
+    vector_size_t endRow,
+    vector_size_t resultOffset,
+    const RowVectorPtr& result) {
+  applyLane(lanes_[0], startRow, endRow, resultOffset, result);
 
   const vector_size_t numRows = endRow - startRow;
   numProcessedRows_ += numRows;
@@ -679,7 +767,94 @@ vector_size_t Window::callApplyLoop(
   return numOutputRows - numOutputRowsLeft;
 }
 
+bool Window::canApplyInParallel() const {
+  if (lanes_.size() == 1 || !currentPartition_->complete() ||
+      currentPartition_->partial()) {
+    return false;
+  }
+  // Leaves the last rows of the partition to the first lane, which then moves
+  // on to the next partition.
+  return currentPartition_->numRowsForProcessing(partitionOffset_) >
+      2 * numRowsPerOutput_;
+}
+
+void Window::applyInParallel() {
+  const auto numPartitionRows =
+      currentPartition_->numRowsForProcessing(partitionOffset_);
+  const auto numLanes = std::min<vector_size_t>(
+      lanes_.size(), (numPartitionRows - 1) / numRowsPerOutput_);
+  VELOX_CHECK_GE(numLanes, 2);
+
+  std::vector<RowVectorPtr> results;
+  results.reserve(numLanes);
+  for (auto i = 0; i < numLanes; ++i) {
+    results.push_back(BaseVector::create<RowVector>(
+        outputType_, numRowsPerOutput_, operatorCtx_->pool()));
+  }
+
+  const auto applyBatch = [&](vector_size_t laneIndex) {
+    auto& lane = lanes_[laneIndex];
+    if (lane.partitionNumber != numPartitions_) {
+      resetLanePartition(lane);
+    }
+    const auto startRow = partitionOffset_ + laneIndex * numRowsPerOutput_;
+    seekPeerGroup(lane, startRow);
+    applyLane(
+        lane, startRow, startRow + numRowsPerOutput_, 0, results[laneIndex]);
+  };
+
+  // Passing driver context directly to avoid cross thread access to thread
+  // local driver thread context.
+  const DriverCtx* driverCtx{nullptr};
+  if (const auto* driverThreadCtx = driverThreadContext()) {
+    driverCtx = driverThreadCtx->driverCtx();
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> batches;
+  // The batches refer to the lanes and the results, so they must all complete
+  // also if one of them fails.
+  auto sync = folly::makeGuard([&]() {
+    for (auto& batch : batches) {
+      try {
+        batch->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+  for (auto i = 1; i < numLanes; ++i) {
+    batches.push_back(std::make_shared<AsyncSource<bool>>([&applyBatch, i]() {
+      applyBatch(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor_->add([driverCtx, batch = batches.back()]() {
+      ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+      batch->prepare();
+    });
+  }
+
+  applyBatch(0);
+  for (auto& batch : batches) {
+    batch->move();
+  }
+  batches.clear();
+
+  partitionOffset_ += numLanes * numRowsPerOutput_;
+  // The first lane continues after the last batch of the other lanes.
+  seekPeerGroup(lanes_[0], partitionOffset_);
+  for (auto& result : results) {
+    parallelOutputs_.push_back(std::move(result));
+  }
+  addRuntimeStat(kParallelBatches, RuntimeCounter(numLanes));
+}
+
 RowVectorPtr Window::getOutput() {
+  if (!parallelOutputs_.empty()) {
+    auto result = std::move(parallelOutputs_.front());
+    parallelOutputs_.pop_front();
+    numProcessedRows_ += result->size();
+    return result;
+  }
+
   if (numRows_ == 0) {
     return nullptr;
   }
@@ -702,6 +877,11 @@ RowVectorPtr Window::getOutput() {
     return nullptr;
   }
 
+  if (canApplyInParallel()) {
+    applyInParallel();
+    return getOutput();
+  }
+
   const auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = BaseVector::create<RowVector>(
       outputType_, numOutputRows, operatorCtx_->pool());
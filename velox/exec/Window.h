@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/WindowBuild.h"
@@ -42,6 +44,10 @@ class Window : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::WindowNode>& windowNode);
 
+  /// Runtime stat for the number of output batches computed in parallel with
+  /// other batches of the same partition.
+  static inline const std::string kParallelBatches{"parallelBatches"};
+
   /// Initialize the window functions from 'windowNode_' once by driver operator
   /// initialization. 'windowNode_' is reset after this call.
   void initialize() override;
@@ -69,11 +75,11 @@ class Window : public Operator {
 
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
-  // column. value is used to read column values from the column index when k
-  // is a column. The field constant stores constant k values.
+  // column. type is the type of the column when k is a column. The field
+  // constant stores constant k values.
   struct FrameChannelArg {
     column_index_t index;
-    VectorPtr value;
+    TypePtr type;
     std::optional<int64_t> constant;
   };
 
@@ -88,31 +94,101 @@ class Window : public Operator {
     const std::optional<FrameChannelArg> end;
   };
 
+  // The window functions and the buffers passed to them to compute a range of
+  // rows of the current partition. 'lanes_[0]' computes all the rows, except
+  // for the batches of a large partition that are computed in parallel, one
+  // per lane.
+  struct Lane {
+    // HashStringAllocator required by functions that allocate out of line
+    // buffers.
+    std::unique_ptr<HashStringAllocator> stringAllocator;
+
+    // Vector of WindowFunction objects required by this operator.
+    // WindowFunction is the base API implemented by all the window functions.
+    // The functions are ordered by their positions in the output columns.
+    std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions;
+
+    // Value of 'numPartitions_' at the last resetPartition() of
+    // 'windowFunctions'.
+    uint64_t partitionNumber{0};
+
+    // The following 4 Buffers are used to pass peer and frame start and end
+    // values to the WindowFunction::apply method. These buffers can be
+    // allocated once and reused across all the getOutput calls.
+    // Only a single peer start and peer end buffer is needed across all
+    // functions (as the peer values are based on the ORDER BY clause).
+    BufferPtr peerStartBuffer;
+    BufferPtr peerEndBuffer;
+    // A separate BufferPtr is required for the frame indexes of each function.
+    // Each function has its own frame clause and style. So we have as many
+    // buffers as the number of functions.
+    std::vector<BufferPtr> frameStartBuffers;
+    std::vector<BufferPtr> frameEndBuffers;
+
+    // Frame types for kPreceding or kFollowing could result in empty frames if
+    // the frameStart > frameEnds, or frameEnds < firstPartitionRow or
+    // frameStarts > lastPartitionRow. Such frames usually evaluate to NULL in
+    // the window function.
+    // This SelectivityVector captures the valid (non-empty) frames in the
+    // buffer being worked on. The window function can use this to compute
+    // output values. There is one SelectivityVector per window function.
+    std::vector<SelectivityVector> validFrames;
+
+    // Used to read the column values of k preceding/following row frame
+    // bounds. There is one for the frame start and one for the frame end of
+    // each function, null if the bound is not a k column.
+    std::vector<VectorPtr> frameStartValues;
+    std::vector<VectorPtr> frameEndValues;
+
+    // When traversing input partition rows, the peers are the rows with the
+    // same values for the ORDER BY clause. These rows are equal in some ways
+    // and affect the results of ranking functions. Since all rows between the
+    // peerStartRow and peerEndRow have the same values for peerStartRow and
+    // peerEndRow, we needn't compute them for each row independently. Since
+    // these rows might cross getOutput boundaries and be called in subsequent
+    // calls to computePeerBuffers they are saved here.
+    vector_size_t peerStartRow{0};
+    vector_size_t peerEndRow{0};
+  };
+
   // Returns if a window operator support rows-wise streaming processing or not.
   // Currently we supports 'rank', 'dense_rank' and 'row_number' functions with
   // any frame type. Also supports the agg window function with default frame.
   bool supportRowsStreaming();
 
+  // Returns the number of lanes that compute the batches of a large partition
+  // in parallel, 1 if the partitions are computed serially.
+  uint32_t numParallelLanes() const;
+
   // Creates WindowFunction and frame objects for this operator.
   void createWindowFunctions();
 
+  // Creates the WindowFunction objects of 'lane'.
+  void createLaneFunctions(Lane& lane);
+
   // Converts WindowNode::Frame to Window::WindowFrame.
   WindowFrame createWindowFrame(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       const core::WindowNode::Frame& frame,
       const RowTypePtr& inputType);
 
-  // Creates the buffers for peer and frame row
+  // Creates the buffers of 'lane' for peer and frame row
   // indices to send in window function apply invocations.
-  void createPeerAndFrameBuffers();
+  void createPeerAndFrameBuffers(Lane& lane);
 
-  // Compute the peer and frame buffers for rows between
+  // Compute the peer and frame buffers of 'lane' for rows between
   // startRow and endRow in the current partition.
-  void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
+  void computePeerAndFrameBuffers(
+      Lane& lane,
+      vector_size_t startRow,
+      vector_size_t endRow);
 
   // Updates all the state for the next partition.
   void callResetPartition();
 
+  // Resets the window functions of 'lane' to the current partition.
+  void resetLanePartition(Lane& lane);
+
   // Computes the result vector for a subset of the current
   // partition rows starting from startRow to endRow. A single partition
   // could span multiple output blocks and a single output block could
@@ -125,6 +201,25 @@ class Window : public Operator {
       vector_size_t resultOffset,
       const RowVectorPtr& result);
 
+  // Computes the input columns and the window function results of the rows
+  // from startRow to endRow with the functions of 'lane'. Does not update the
+  // progress of the operator.
+  void applyLane(
+      Lane& lane,
+      vector_size_t startRow,
+      vector_size_t endRow,
+      vector_size_t resultOffset,
+      const RowVectorPtr& result);
+
+  // Returns true if the next batches of the current partition can be computed
+  // in parallel by 'lanes_'.
+  bool canApplyInParallel() const;
+
+  // Computes one full output batch of the current partition per lane in
+  // parallel on 'executor_' and adds them to 'parallelOutputs_' in row order.
+  // Each lane starts its batch at the peer group of its first row.
+  void applyInParallel();
+
   // Gets the input columns of the current window partition
   // between startRow and endRow in result at resultOffset.
   void getInputColumns(
@@ -141,20 +236,27 @@ class Window : public Operator {
       vector_size_t numOutputRows,
       const RowVectorPtr& result);
 
+  // Sets the peer state of 'lane' to the peer group of 'row' when the lane did
+  // not compute the rows just before 'row'.
+  void seekPeerGroup(Lane& lane, vector_size_t row);
+
   // Update frame bounds for kPreceding, kFollowing row frames.
   void updateKRowsFrameBounds(
       bool isKPreceding,
       const FrameChannelArg& frameArg,
+      const VectorPtr& frameValues,
       vector_size_t startRow,
       vector_size_t numRows,
       vector_size_t* rawFrameBounds);
 
   // Populate frame bounds in the current partition into rawFrameBounds.
   // Unselect rows from validFrames where the frame bounds are NaN that are
-  // invalid.
+  // invalid. 'frameValues' is used to read the k values of a k rows frame
+  // bound from a column.
   void updateFrameBounds(
       const WindowFrame& windowFrame,
       const bool isStartBound,
+      const VectorPtr& frameValues,
       const vector_size_t startRow,
       const vector_size_t numRows,
       const vector_size_t* rawPeerStarts,
@@ -176,41 +278,22 @@ class Window : public Operator {
   // operator and functions. This structure is owned by the WindowBuild.
   std::shared_ptr<WindowPartition> currentPartition_;
 
-  // HashStringAllocator required by functions that allocate out of line
-  // buffers.
-  HashStringAllocator stringAllocator_;
+  // The first lane computes the output serially. The others are only used by
+  // applyInParallel().
+  std::vector<Lane> lanes_;
 
-  // Vector of WindowFunction objects required by this operator.
-  // WindowFunction is the base API implemented by all the window functions.
-  // The functions are ordered by their positions in the output columns.
-  std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
+  // Executor for the lanes after the first one. Null if there is only one
+  // lane.
+  folly::Executor* executor_{nullptr};
 
-  // Vector of WindowFrames corresponding to each windowFunction above.
+  // Batches computed by applyInParallel() that are not yet returned. Their
+  // rows are not yet counted in 'numProcessedRows_'.
+  std::deque<RowVectorPtr> parallelOutputs_;
+
+  // Vector of WindowFrames corresponding to each window function of a lane.
   // It represents the frame spec for the function computation.
   std::vector<WindowFrame> windowFrames_;
 
-  // The following 4 Buffers are used to pass peer and frame start and end
-  // values to the WindowFunction::apply method. These buffers can be allocated
-  // once and reused across all the getOutput calls.
-  // Only a single peer start and peer end buffer is needed across all
-  // functions (as the peer values are based on the ORDER BY clause).
-  BufferPtr peerStartBuffer_;
-  BufferPtr peerEndBuffer_;
-  // A separate BufferPtr is required for the frame indexes of each function.
-  // Each function has its own frame clause and style. So we have as many
-  // buffers as the number of functions.
-  std::vector<BufferPtr> frameStartBuffers_;
-  std::vector<BufferPtr> frameEndBuffers_;
-
-  // Frame types for kPreceding or kFollowing could result in empty frames if
-  // the frameStart > frameEnds, or frameEnds < firstPartitionRow or frameStarts
-  // > lastPartitionRow. Such frames usually evaluate to NULL in the window
-  // function.
-  // This SelectivityVector captures the valid (non-empty) frames in the buffer
-  // being worked on. The window function can use this to compute output values.
-  // There is one SelectivityVector per window function.
-  std::vector<SelectivityVector> validFrames_;
-
   // Number of input rows.
   vector_size_t numRows_ = 0;
 
@@ -226,15 +309,9 @@ class Window : public Operator {
   // Tracks how far along the partition rows have been output.
   vector_size_t partitionOffset_ = 0;
 
-  // When traversing input partition rows, the peers are the rows with the same
-  // values for the ORDER BY clause. These rows are equal in some ways and
-  // affect the results of ranking functions. Since all rows between the
-  // peerStartRow_ and peerEndRow_ have the same values for peerStartRow_ and
-  // peerEndRow_, we needn't compute them for each row independently. Since
-  // these rows might cross getOutput boundaries and be called in subsequent
-  // calls to computePeerBuffers they are saved here.
-  vector_size_t peerStartRow_ = 0;
-  vector_size_t peerEndRow_ = 0;
+  // Number of partitions started so far. Tells the lanes whose functions are
+  // not yet reset to the current partition.
+  uint64_t numPartitions_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -271,6 +271,22 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
   return {peerStart, peerEnd};
 }
 
+std::pair<vector_size_t, vector_size_t> WindowPartition::findPeerGroup(
+    vector_size_t row) {
+  VELOX_CHECK(!partial_);
+  VELOX_CHECK_LT(row, numRows());
+  const auto peerCompare = [&](const char* lhs, const char* rhs) -> bool {
+    return compareRowsWithSortKeys(lhs, rhs);
+  };
+  auto peerStart = row;
+  while (peerStart > 0 &&
+         !peerCompare(partition_[peerStart - 1], partition_[row])) {
+    --peerStart;
+  }
+  return {
+      peerStart, findPeerRowEndIndex(row, numRows() - 1, peerCompare)};
+}
+
 // Searches for start[frameColumn] in orderByColumn.
 // The search could return the first or last row matching start[frameColumn].
 // If a matching row is not present, then the index of the first row greater
@@ -149,6 +149,13 @@ class WindowPartition {
       vector_size_t* rawPeerStarts,
       vector_size_t* rawPeerEnds);
 
+  /// Returns the peer start and the row after the peer end of 'row'. Passed as
+  /// prevPeerStart and prevPeerEnd to computePeerBuffers() to start at 'row'
+  /// without having processed the rows before it, e.g. when the batches of a
+  /// partition are computed concurrently. Only supported for a partition that
+  /// is not partial.
+  std::pair<vector_size_t, vector_size_t> findPeerGroup(vector_size_t row);
+
   /// Sets in 'rawFrameBounds' the frame boundary for the k range
   /// preceding/following frame.
   /// @param isStartBound start or end boundary of the frame.
@@ -34,6 +34,11 @@ DEFINE_int32(task_width, 4, "Number of threads in each task in shuffle");
 
 DEFINE_int32(num_local_tasks, 8, "Number of concurrent local shuffles");
 DEFINE_int32(num_local_repeat, 8, "Number of repeats of local exchange query");
+DEFINE_int32(
+    wide_local_width,
+    64,
+    "Number of producers and consumers of each local exchange in the wide "
+    "local shuffle");
 DEFINE_int32(flat_batch_mb, 1, "MB in a 10k row flat batch.");
 DEFINE_int64(
     local_exchange_buffer_mb,
@@ -41,6 +46,11 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_bool(
+    zero_copy_flush,
+    true,
+    "Reference the serialized memory from the shuffled pages instead of "
+    "copying it");
 // Add the following definitions to allow Clion runs
 DEFINE_bool(gtest_color, false, "");
 DEFINE_string(gtest_filter, "*", "");
@@ -88,6 +98,30 @@ void sortByAndPrintMax(
             << "\n Min: " << metrics.back().toString() << std::endl;
 }
 
+void printLocalStats(
+    const char* title,
+    int64_t wallUs,
+    const PlanNodeStats& localPartitionStats,
+    LocalPartitionWaitStats& waitStats) {
+  std::cout << fmt::format("{:-^77}", title) << std::endl;
+  std::sort(waitStats.wallMs.begin(), waitStats.wallMs.end());
+  VELOX_CHECK(!waitStats.wallMs.empty());
+  std::cout << "Wall Time (ms): " << "\n Total: " << succinctMicros(wallUs)
+            << "\n Max: " << waitStats.wallMs.back()
+            << "\n Median: " << waitStats.wallMs[waitStats.wallMs.size() / 2]
+            << "\n Min: " << waitStats.wallMs.front() << std::endl;
+  std::cout << "LocalPartition: " << localPartitionStats.toString()
+            << std::endl;
+  sortByAndPrintMax(
+      "Producer Wait Time (ms)",
+      waitStats.totalProducerWaitMs,
+      waitStats.producerWaitMs);
+  sortByAndPrintMax(
+      "Consumer Wait Time (ms)",
+      waitStats.totalConsumerWaitMs,
+      waitStats.consumerWaitMs);
+}
+
 class ExchangeBenchmark : public VectorTestBase {
  public:
   std::vector<RowVectorPtr> makeRows(
@@ -139,6 +173,8 @@ class ExchangeBenchmark : public VectorTestBase {
       assert(!vectors.empty());
       configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+      configSettings_[core::QueryConfig::kPartitionedOutputZeroCopyFlush] =
+          FLAGS_zero_copy_flush ? "true" : "false";
       const auto iteration = ++iteration_;
 
       // leafPlan: PartitionedOutput/kPartitioned(1) <-- Values(0)
@@ -523,6 +559,22 @@ void runBenchmarks() {
     return 1;
   });
 
+  // Many small batches through local exchanges with many producers and
+  // consumers show the contention on the local exchange queues.
+  int64_t wideLocalPartitionWallUs;
+  PlanNodeStats wideLocalPartitionStatsFlat50;
+  LocalPartitionWaitStats wideLocalPartitionWaitStats;
+  folly::addBenchmark(__FILE__, "localFlat50Wide", [&]() {
+    bm->runLocal(
+        flat50,
+        FLAGS_wide_local_width,
+        FLAGS_num_local_tasks,
+        wideLocalPartitionWallUs,
+        wideLocalPartitionStatsFlat50,
+        wideLocalPartitionWaitStats);
+    return 1;
+  });
+
   folly::runBenchmarks();
 
   std::cout
@@ -565,31 +617,16 @@ void runBenchmarks() {
             << std::endl;
   std::cout << "Exchange: " << exchangeStatsStruct1K.toString() << std::endl;
 
-  std::cout
-      << "--------------------------------LocalFlat10K-------------------------------"
-      << std::endl;
-  std::cout << "Wall Time (ms): " << "\n Total: "
-            << succinctMicros(localPartitionWallUs)
-            << "\n Max: " << localPartitionWaitStats.wallMs.back()
-            << "\n Median: "
-            << localPartitionWaitStats
-                   .wallMs[localPartitionWaitStats.wallMs.size() / 2]
-            << "\n Min: " << localPartitionWaitStats.wallMs.front()
-            << std::endl;
-  std::cout << "LocalPartition: " << localPartitionStatsFlat10K.toString()
-            << std::endl;
-  sortByAndPrintMax(
-      "Producer Wait Time (ms)",
-      localPartitionWaitStats.totalProducerWaitMs,
-      localPartitionWaitStats.producerWaitMs);
-  sortByAndPrintMax(
-      "Consumer Wait Time (ms)",
-      localPartitionWaitStats.totalConsumerWaitMs,
-      localPartitionWaitStats.consumerWaitMs);
-  std::sort(
-      localPartitionWaitStats.wallMs.begin(),
-      localPartitionWaitStats.wallMs.end());
-  assert(!localPartitionWaitStats.wallMs.empty());
+  printLocalStats(
+      "LocalFlat10K",
+      localPartitionWallUs,
+      localPartitionStatsFlat10K,
+      localPartitionWaitStats);
+  printLocalStats(
+      "LocalFlat50Wide",
+      wideLocalPartitionWallUs,
+      wideLocalPartitionStatsFlat50,
+      wideLocalPartitionWaitStats);
 }
 
 } // namespace
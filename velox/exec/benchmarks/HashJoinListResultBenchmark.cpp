@@ -36,7 +36,8 @@ struct HashTableBenchmarkParams {
   //  -the build & probe row schema,
   //  -the expected hash table size,
   //  -number of probing rows,
-  //  -build key repetition distribution.
+  //  -build key repetition distribution,
+  //  -whether to probe with many rows in flight regardless of table size.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
@@ -44,13 +45,15 @@ struct HashTableBenchmarkParams {
       int64_t probeSize,
       const std::vector<std::pair<int32_t, int32_t>>&
           keyRepeatTimesDistribution,
-      bool runErase)
+      bool runErase,
+      bool groupPrefetchProbe = false)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         probeSize{probeSize},
         keyRepeatTimesDistribution{keyRepeatTimesDistribution},
-        runErase{runErase} {
+        runErase{runErase},
+        groupPrefetchProbe{groupPrefetchProbe} {
     int32_t distSum = 0;
     buildSize = 0;
     buildKeyRepeat.reserve(keyRepeatTimesDistribution.size());
@@ -89,10 +92,17 @@ struct HashTableBenchmarkParams {
       distStr << fmt::format("{}%:{};", dist.first, dist.second);
     }
     title = fmt::format(
-        "{},probe:{},buildDist:{}", modeString, probeSize, distStr.str());
+        "{},size:{},probe:{},buildDist:{}",
+        modeString,
+        hashTableSize,
+        probeSize,
+        distStr.str());
     if (runErase) {
       title += ",withErase";
     }
+    if (groupPrefetchProbe) {
+      title += ",groupPrefetch";
+    }
   }
 
   // Expected mode.
@@ -113,6 +123,10 @@ struct HashTableBenchmarkParams {
 
   bool runErase;
 
+  // Probes kHash tables with HashTable::groupPrefetchJoinProbe() regardless
+  // of their size if true, never if false.
+  bool groupPrefetchProbe;
+
   // Title for reporting
   std::string title;
 
@@ -394,6 +408,8 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
           executor_.get());
     }
     buildTime_ = buildClocks;
+    topTable_->setGroupPrefetchProbeMinBytes(
+        params_.groupPrefetchProbe ? 0 : std::numeric_limits<uint64_t>::max());
   }
 
   void probeTable(
@@ -579,6 +595,20 @@ int main(int argc, char** argv) {
       }
     }
   }
+  // Compares probing 4 and kPrefetchSize rows at a time. The gain grows with
+  // the table size as more probes miss the CPU caches.
+  for (auto& dist : keyRepeatDists) {
+    for (auto groupPrefetch : {false, true}) {
+      params.emplace_back(HashTableBenchmarkParams(
+          BaseHashTable::HashMode::kHash,
+          onlyKeyType,
+          hashTableSize * 8,
+          probeRowSize,
+          dist,
+          false,
+          groupPrefetch));
+    }
+  }
 
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
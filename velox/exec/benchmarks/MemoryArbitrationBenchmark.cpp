@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+
+#include <fstream>
+#include <random>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Cursor.h"
+#include "velox/exec/tests/utils/ArbitratorTestUtil.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int64(
+    allocator_capacity,
+    32L << 30,
+    "The memory allocator capacity in bytes");
+DEFINE_int64(
+    arbitrator_capacity,
+    1L << 30,
+    "The capacity in bytes shared by all the queries through the arbitrator");
+DEFINE_int64(
+    query_capacity,
+    0,
+    "The max capacity in bytes of each query. No limit if 0");
+DEFINE_bool(
+    global_arbitration_enabled,
+    true,
+    "If true, enables global arbitration in the SharedArbitrator");
+DEFINE_string(
+    arbitrator_configs,
+    "",
+    "Comma separated list of additional SharedArbitrator configs, e.g. "
+    "'memory-pool-min-reclaim-bytes=64MB,max-memory-arbitration-time=1m'");
+DEFINE_int32(num_threads, 16, "The number of queries running concurrently");
+DEFINE_int32(duration_sec, 30, "For how long to run the queries in seconds");
+DEFINE_int32(num_drivers, 4, "The number of drivers of each query");
+DEFINE_string(
+    query_mix,
+    "join:1,aggregation:1,orderby:1",
+    "Comma separated list of <query kind>:<weight>. Each query picks its kind "
+    "randomly with probabilities proportional to the weights. The kinds are "
+    "join, aggregation and orderby");
+DEFINE_int32(batch_size, 1'024, "The number of rows per input vector");
+DEFINE_int32(num_batches, 100, "The number of distinct input vectors");
+DEFINE_int32(
+    repeat_times,
+    10,
+    "The number of times each query reads its input vectors");
+DEFINE_bool(spill_enabled, true, "If true, the queries can spill");
+DEFINE_int64(seed, 0, "The random seed. Uses the current time if 0");
+DEFINE_string(
+    output_json,
+    "",
+    "If set, writes the report to this file as JSON in addition to stdout");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+// Latencies and outcomes of the queries of one kind.
+struct QueryKindStats {
+  std::vector<uint64_t> latencyUs;
+  uint64_t numSucceeded{0};
+  uint64_t numOom{0};
+  uint64_t numAborted{0};
+  uint64_t numFailed{0};
+  uint64_t arbitrationWallNanos{0};
+  uint64_t spilledBytes{0};
+};
+
+class MemoryArbitrationBenchmark {
+ public:
+  explicit MemoryArbitrationBenchmark(size_t seed) : seed_(seed) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_batch_size;
+    options.stringLength = 50;
+    options.stringVariableLength = true;
+    VectorFuzzer fuzzer(options, pool_.get(), seed);
+    const auto rowType = ROW(
+        {"k0", "k1", "v0", "v1"}, {BIGINT(), BIGINT(), DOUBLE(), VARCHAR()});
+    // 'k0' has every value twice so that the joins find matches, 'k1' is
+    // unique.
+    const auto numDistinctKeys =
+        std::max<int64_t>(1, FLAGS_num_batches * FLAGS_batch_size / 2);
+    for (auto i = 0; i < FLAGS_num_batches; ++i) {
+      auto vector = fuzzer.fuzzInputFlatRow(rowType);
+      auto keys = vector->childAt(0)->asFlatVector<int64_t>();
+      for (auto row = 0; row < vector->size(); ++row) {
+        keys->set(row, (i * FLAGS_batch_size + row) % numDistinctKeys);
+      }
+      input_.push_back(std::move(vector));
+    }
+
+    for (const auto& entry :
+         splitString(FLAGS_query_mix, ',', "--query_mix")) {
+      const auto kindAndWeight = splitString(entry, ':', "--query_mix");
+      VELOX_USER_CHECK_EQ(
+          kindAndWeight.size(), 2, "Invalid --query_mix entry: {}", entry);
+      queryKinds_.push_back(kindAndWeight[0]);
+      weights_.push_back(folly::to<double>(kindAndWeight[1]));
+      plans_.push_back(makePlan(kindAndWeight[0]));
+    }
+    for (auto i = 0; i < queryKinds_.size(); ++i) {
+      stats_.push_back(
+          std::make_unique<folly::Synchronized<QueryKindStats>>());
+    }
+  }
+
+  void run() {
+    const auto spillDirectory = TempDirectoryPath::create();
+    const auto arbitratorStatsBefore =
+        memory::memoryManager()->arbitrator()->stats();
+    std::atomic_bool stop{false};
+    std::atomic_int32_t queryCount{0};
+    std::vector<std::thread> queryThreads;
+    queryThreads.reserve(FLAGS_num_threads);
+    for (auto i = 0; i < FLAGS_num_threads; ++i) {
+      queryThreads.emplace_back([&, i]() {
+        std::mt19937 rng(seed_ + i);
+        std::discrete_distribution<size_t> pickKind(
+            weights_.begin(), weights_.end());
+        while (!stop) {
+          const auto kind = pickKind(rng);
+          const auto queryId = fmt::format("query_{}", queryCount++);
+          runQuery(
+              kind,
+              queryId,
+              fmt::format("{}/{}", spillDirectory->getPath(), queryId));
+        }
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(FLAGS_duration_sec));
+    stop = true;
+    for (auto& thread : queryThreads) {
+      thread.join();
+    }
+    arbitratorStats_ =
+        memory::memoryManager()->arbitrator()->stats() - arbitratorStatsBefore;
+  }
+
+  void printReport(std::ostream& out) const {
+    out << "Arbitrator: "
+        << memory::memoryManager()->arbitrator()->kind()
+        << ", capacity: " << succinctBytes(FLAGS_arbitrator_capacity)
+        << ", concurrent queries: " << FLAGS_num_threads << std::endl;
+    out << fmt::format(
+               "{:<12} {:>8} {:>8} {:>8} {:>8} {:>10} {:>10} {:>10} {:>10} "
+               "{:>12} {:>12}",
+               "query",
+               "success",
+               "oom",
+               "aborted",
+               "failed",
+               "p50",
+               "p90",
+               "p99",
+               "max",
+               "arbitration",
+               "spilled")
+        << std::endl;
+    for (auto i = 0; i < queryKinds_.size(); ++i) {
+      const auto stats = stats_[i]->copy();
+      out << fmt::format(
+                 "{:<12} {:>8} {:>8} {:>8} {:>8} {:>10} {:>10} {:>10} {:>10} "
+                 "{:>12} {:>12}",
+                 queryKinds_[i],
+                 stats.numSucceeded,
+                 stats.numOom,
+                 stats.numAborted,
+                 stats.numFailed,
+                 succinctMicros(percentile(stats.latencyUs, 0.5)),
+                 succinctMicros(percentile(stats.latencyUs, 0.9)),
+                 succinctMicros(percentile(stats.latencyUs, 0.99)),
+                 succinctMicros(percentile(stats.latencyUs, 1)),
+                 succinctNanos(stats.arbitrationWallNanos),
+                 succinctBytes(stats.spilledBytes))
+          << std::endl;
+    }
+    out << "Arbitration requests: " << arbitratorStats_.numRequests
+        << ", failures: " << arbitratorStats_.numFailures
+        << ", aborted: " << arbitratorStats_.numAborted
+        << ", reclaimed used bytes: "
+        << succinctBytes(arbitratorStats_.reclaimedUsedBytes)
+        << ", reclaimed free bytes: "
+        << succinctBytes(arbitratorStats_.reclaimedFreeBytes) << std::endl;
+  }
+
+  folly::dynamic toJson() const {
+    folly::dynamic queries = folly::dynamic::array;
+    for (auto i = 0; i < queryKinds_.size(); ++i) {
+      const auto stats = stats_[i]->copy();
+      folly::dynamic query = folly::dynamic::object;
+      query["kind"] = queryKinds_[i];
+      query["numSucceeded"] = stats.numSucceeded;
+      query["numOom"] = stats.numOom;
+      query["numAborted"] = stats.numAborted;
+      query["numFailed"] = stats.numFailed;
+      query["p50LatencyUs"] = percentile(stats.latencyUs, 0.5);
+      query["p90LatencyUs"] = percentile(stats.latencyUs, 0.9);
+      query["p99LatencyUs"] = percentile(stats.latencyUs, 0.99);
+      query["maxLatencyUs"] = percentile(stats.latencyUs, 1);
+      query["arbitrationWallNanos"] = stats.arbitrationWallNanos;
+      query["spilledBytes"] = stats.spilledBytes;
+      queries.push_back(std::move(query));
+    }
+    folly::dynamic arbitrator = folly::dynamic::object;
+    arbitrator["numRequests"] = arbitratorStats_.numRequests;
+    arbitrator["numFailures"] = arbitratorStats_.numFailures;
+    arbitrator["numAborted"] = arbitratorStats_.numAborted;
+    arbitrator["reclaimedUsedBytes"] = arbitratorStats_.reclaimedUsedBytes;
+    arbitrator["reclaimedFreeBytes"] = arbitratorStats_.reclaimedFreeBytes;
+
+    folly::dynamic report = folly::dynamic::object;
+    report["arbitratorCapacity"] = FLAGS_arbitrator_capacity;
+    report["numThreads"] = FLAGS_num_threads;
+    report["durationSec"] = FLAGS_duration_sec;
+    report["queries"] = std::move(queries);
+    report["arbitrator"] = std::move(arbitrator);
+    return report;
+  }
+
+ private:
+  static std::vector<std::string>
+  splitString(const std::string& input, char delimiter, const char* flag) {
+    std::vector<std::string> parts;
+    folly::split(delimiter, input, parts, /*ignoreEmpty=*/true);
+    VELOX_USER_CHECK(!parts.empty(), "Empty {}", flag);
+    return parts;
+  }
+
+  // Returns the value at 'pct' of the sorted 'values'.
+  static uint64_t percentile(std::vector<uint64_t> values, double pct) {
+    if (values.empty()) {
+      return 0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = std::min<size_t>(
+        values.size() - 1, static_cast<size_t>(pct * values.size()));
+    return values[index];
+  }
+
+  PlanBuilder inputScan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator)
+      const {
+    return PlanBuilder(planNodeIdGenerator)
+        .values(input_, /*parallelizable=*/true, FLAGS_repeat_times);
+  }
+
+  // The plans aggregate their output to a few rows so that the time is spent
+  // in the memory intensive operators.
+  core::PlanNodePtr makePlan(const std::string& kind) const {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    if (kind == "join") {
+      return inputScan(planNodeIdGenerator)
+          .project({"k0 AS p0", "v0 AS p1"})
+          .hashJoin(
+              {"p0"},
+              {"b0"},
+              inputScan(planNodeIdGenerator)
+                  .project({"k0 AS b0", "v1 AS b1"})
+                  .planNode(),
+              "",
+              {"p1", "b1"})
+          .singleAggregation({}, {"count(1)", "max(b1)"})
+          .planNode();
+    }
+    if (kind == "aggregation") {
+      return inputScan(planNodeIdGenerator)
+          .singleAggregation({"k1"}, {"count(1)", "max(v1)", "sum(v0)"})
+          .singleAggregation({}, {"count(1)"})
+          .planNode();
+    }
+    if (kind == "orderby") {
+      return inputScan(planNodeIdGenerator)
+          .orderBy({"k1", "v1"}, false)
+          .singleAggregation({}, {"count(1)"})
+          .planNode();
+    }
+    VELOX_USER_FAIL("Unknown query kind in --query_mix: {}", kind);
+  }
+
+  void runQuery(
+      size_t kind,
+      const std::string& queryId,
+      const std::string& spillDirectory) {
+    CursorParameters params;
+    params.planNode = plans_[kind];
+    params.maxDrivers = FLAGS_num_drivers;
+    params.copyResult = false;
+    params.queryCtx = newQueryCtx(
+        memory::memoryManager(),
+        executor_.get(),
+        FLAGS_query_capacity == 0 ? memory::kMaxMemory : FLAGS_query_capacity,
+        queryId);
+    if (FLAGS_spill_enabled) {
+      params.spillDirectory = spillDirectory;
+      params.queryConfigs = {
+          {core::QueryConfig::kSpillEnabled, "true"},
+          {core::QueryConfig::kJoinSpillEnabled, "true"},
+          {core::QueryConfig::kAggregationSpillEnabled, "true"},
+          {core::QueryConfig::kOrderBySpillEnabled, "true"},
+      };
+    }
+
+    enum class Outcome { kSucceeded, kOom, kAborted, kFailed };
+    Outcome outcome{Outcome::kSucceeded};
+    std::shared_ptr<Task> task;
+    uint64_t latencyUs{0};
+    {
+      MicrosecondTimer timer(&latencyUs);
+      try {
+        auto cursor = TaskCursor::create(params);
+        task = cursor->task();
+        while (cursor->moveNext()) {
+        }
+        waitForTaskCompletion(task.get());
+      } catch (const VeloxException& e) {
+        if (e.errorCode() == error_code::kMemCapExceeded.c_str()) {
+          outcome = Outcome::kOom;
+        } else if (e.errorCode() == error_code::kMemAborted.c_str()) {
+          outcome = Outcome::kAborted;
+        } else {
+          LOG(ERROR) << "Query " << queryId << " failed: " << e.what();
+          outcome = Outcome::kFailed;
+        }
+      }
+    }
+
+    uint64_t arbitrationWallNanos{0};
+    uint64_t spilledBytes{0};
+    if (task != nullptr) {
+      for (const auto& pipeline : task->taskStats().pipelineStats) {
+        for (const auto& op : pipeline.operatorStats) {
+          spilledBytes += op.spilledBytes;
+          auto it = op.runtimeStats.find(
+              memory::SharedArbitrator::kMemoryArbitrationWallNanos);
+          if (it != op.runtimeStats.end()) {
+            arbitrationWallNanos += it->second.sum;
+          }
+        }
+      }
+    }
+
+    auto stats = stats_[kind]->wlock();
+    stats->arbitrationWallNanos += arbitrationWallNanos;
+    stats->spilledBytes += spilledBytes;
+    switch (outcome) {
+      case Outcome::kSucceeded:
+        ++stats->numSucceeded;
+        stats->latencyUs.push_back(latencyUs);
+        break;
+      case Outcome::kOom:
+        ++stats->numOom;
+        break;
+      case Outcome::kAborted:
+        ++stats->numAborted;
+        break;
+      case Outcome::kFailed:
+        ++stats->numFailed;
+        break;
+    }
+  }
+
+  const size_t seed_;
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool("memoryArbitrationBenchmark")};
+  std::shared_ptr<folly::Executor> executor_{
+      std::make_shared<folly::CPUThreadPoolExecutor>(
+          std::thread::hardware_concurrency())};
+  std::vector<RowVectorPtr> input_;
+  std::vector<std::string> queryKinds_;
+  std::vector<double> weights_;
+  std::vector<core::PlanNodePtr> plans_;
+  // Latencies only cover the succeeded queries.
+  std::vector<std::unique_ptr<folly::Synchronized<QueryKindStats>>> stats_;
+  memory::MemoryArbitrator::Stats arbitratorStats_;
+};
+
+std::unordered_map<std::string, std::string> arbitratorConfigs() {
+  std::unordered_map<std::string, std::string> configs{
+      {std::string(memory::SharedArbitrator::ExtraConfig::
+                       kGlobalArbitrationEnabled),
+       FLAGS_global_arbitration_enabled ? "true" : "false"}};
+  std::vector<std::string> entries;
+  folly::split(',', FLAGS_arbitrator_configs, entries, /*ignoreEmpty=*/true);
+  for (const auto& entry : entries) {
+    std::string key;
+    std::string value;
+    VELOX_USER_CHECK(
+        folly::split('=', entry, key, value),
+        "Invalid --arbitrator_configs entry: {}",
+        entry);
+    configs[key] = value;
+  }
+  return configs;
+}
+
+} // namespace
+
+// Runs a concurrent mix of spilling joins, aggregations and sorts against a
+// fixed arbitrator capacity and reports the query latencies and outcomes
+// together with the arbitration wait time and the reclaimed bytes. Used to
+// compare arbitration policies and their configs.
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+
+  memory::SharedArbitrator::registerFactory();
+  memory::MemoryManagerOptions options;
+  options.allocatorCapacity = FLAGS_allocator_capacity;
+  options.arbitratorCapacity = FLAGS_arbitrator_capacity;
+  options.arbitratorKind = "SHARED";
+  options.extraArbitratorConfigs = arbitratorConfigs();
+  memory::MemoryManager::initialize(options);
+
+  filesystems::registerLocalFileSystem();
+  serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  if (!isRegisteredNamedVectorSerde(VectorSerde::Kind::kPresto)) {
+    serializer::presto::PrestoVectorSerde::registerNamedVectorSerde();
+  }
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  const size_t seed = FLAGS_seed == 0 ? std::time(nullptr) : FLAGS_seed;
+  LOG(INFO) << "Seed: " << seed;
+  {
+    MemoryArbitrationBenchmark benchmark(seed);
+    benchmark.run();
+    benchmark.printReport(std::cout);
+    if (!FLAGS_output_json.empty()) {
+      std::ofstream file(FLAGS_output_json);
+      VELOX_CHECK(file.good(), "Cannot open {}", FLAGS_output_json);
+      file << folly::toPrettyJson(benchmark.toJson()) << std::endl;
+    }
+  }
+  waitForAllTasksToBeDeleted();
+  return 0;
+}
@@ -20,7 +20,10 @@
 #include <gflags/gflags.h>
 
 #include "velox/exec/TreeOfLosers.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -29,6 +32,56 @@ TestData narrow;
 TestData medium;
 TestData wide;
 
+namespace {
+// Returns a LocalMerge over 'numSources' sorted sources of 'numRows' rows
+// each. The merged output takes 'runLength' consecutive rows from each source
+// in turn.
+core::PlanNodePtr makeLocalMergePlan(
+    memory::MemoryPool* pool,
+    int32_t numSources,
+    vector_size_t numRows,
+    vector_size_t runLength) {
+  constexpr vector_size_t kBatchSize = 10'000;
+  facebook::velox::test::VectorMaker maker(pool);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  std::vector<core::PlanNodePtr> sources;
+  for (auto source = 0; source < numSources; ++source) {
+    std::vector<RowVectorPtr> batches;
+    for (auto start = 0; start < numRows; start += kBatchSize) {
+      batches.push_back(maker.rowVector({
+          maker.flatVector<int64_t>(
+              kBatchSize,
+              [&](auto row) {
+                const int64_t sourceRow = start + row;
+                return (sourceRow / runLength) * numSources * runLength +
+                    source * runLength + sourceRow % runLength;
+              }),
+          maker.flatVector<int64_t>(
+              kBatchSize, [](auto row) { return row * 3; }),
+          maker.flatVector<StringView>(
+              kBatchSize,
+              [](auto /*row*/) { return StringView("payload of a row"); }),
+      }));
+    }
+    sources.push_back(
+        PlanBuilder(planNodeIdGenerator).values(batches).planNode());
+  }
+  return PlanBuilder(planNodeIdGenerator)
+      .localMerge({"c0"}, std::move(sources))
+      .planNode();
+}
+
+std::shared_ptr<memory::MemoryPool> pool;
+core::PlanNodePtr shortRunsPlan;
+core::PlanNodePtr longRunsPlan;
+core::PlanNodePtr wideShortRunsPlan;
+
+void runLocalMerge(const core::PlanNodePtr& plan) {
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(plan).runWithoutResults(task);
+}
+} // namespace
+
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
 }
@@ -53,9 +106,29 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+// LocalMerge copies the rows of a source that win one after another as one
+// range per column. These compare outputs that are made of short and of long
+// runs from the same source.
+BENCHMARK(localMergeShortRuns) {
+  runLocalMerge(shortRunsPlan);
+}
+
+BENCHMARK_RELATIVE(localMergeLongRuns) {
+  runLocalMerge(longRunsPlan);
+}
+
+BENCHMARK(localMergeWideShortRuns) {
+  runLocalMerge(wideShortRunsPlan);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+  shortRunsPlan = makeLocalMergePlan(pool.get(), 8, 200'000, 1);
+  longRunsPlan = makeLocalMergePlan(pool.get(), 8, 200'000, 1'000);
+  wideShortRunsPlan = makeLocalMergePlan(pool.get(), 100, 20'000, 1);
   MergeTestBase test;
   test.seed(1);
   narrow = test.makeTestData(100'000'000, 7);
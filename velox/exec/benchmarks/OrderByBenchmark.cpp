@@ -43,37 +43,51 @@ class OrderByBenchmark {
       int32_t iterations,
       int numKeys) {
     TestCase testCase = {numRows, rowType, numKeys};
-    {
-      folly::addBenchmark(
-          __FILE__,
-          "OrderBy_" + benchmarkName,
-          [test = testCase, iterations = std::max(1, iterations / 10), this]() {
-            core::PlanNodeId orderByNodeId;
-            const auto plan = makeOrderByPlan(test, orderByNodeId);
-            uint64_t inputNs = 0;
-            uint64_t outputNs = 0;
-            uint64_t finishNs = 0;
-            const auto start = getCurrentTimeMicro();
-            for (auto i = 0; i < iterations; ++i) {
-              std::shared_ptr<Task> task;
-              test::AssertQueryBuilder(plan).runWithoutResults(task);
-              auto taskStats = exec::toPlanStats(task->taskStats());
-              auto& stats = taskStats.at(orderByNodeId);
-              inputNs += stats.addInputTiming.wallNanos;
-              finishNs += stats.finishTiming.wallNanos;
-              outputNs += stats.getOutputTiming.wallNanos;
-            }
-            const uint64_t total = getCurrentTimeMicro() - start;
-            std::cout << "Total " << succinctMicros(total) << " Input "
-                      << succinctNanos(inputNs) << " Output "
-                      << succinctNanos(outputNs) << " Finish "
-                      << succinctNanos(finishNs) << std::endl;
-            return 1;
-          });
-    }
+    iterations = std::max(1, iterations / 10);
+    folly::addBenchmark(
+        __FILE__,
+        "OrderBy_" + benchmarkName,
+        [test = testCase, iterations, this]() {
+          return runOrderBy(test, iterations, true);
+        });
+    // Radix sort applies only to small fully normalized keys, the relative
+    // numbers show its gain.
+    folly::addBenchmark(
+        __FILE__, "%OrderByQuickSort", [test = testCase, iterations, this]() {
+          return runOrderBy(test, iterations, false);
+        });
   }
 
  private:
+  unsigned
+  runOrderBy(const TestCase& test, int32_t iterations, bool radixSort) {
+    core::PlanNodeId orderByNodeId;
+    const auto plan = makeOrderByPlan(test, orderByNodeId);
+    uint64_t inputNs = 0;
+    uint64_t outputNs = 0;
+    uint64_t finishNs = 0;
+    const auto start = getCurrentTimeMicro();
+    for (auto i = 0; i < iterations; ++i) {
+      std::shared_ptr<Task> task;
+      auto queryBuilder = test::AssertQueryBuilder(plan);
+      if (!radixSort) {
+        queryBuilder.config(
+            core::QueryConfig::kPrefixSortMaxRadixSortKeyBytes, "0");
+      }
+      queryBuilder.runWithoutResults(task);
+      auto taskStats = exec::toPlanStats(task->taskStats());
+      auto& stats = taskStats.at(orderByNodeId);
+      inputNs += stats.addInputTiming.wallNanos;
+      finishNs += stats.finishTiming.wallNanos;
+      outputNs += stats.getOutputTiming.wallNanos;
+    }
+    const uint64_t total = getCurrentTimeMicro() - start;
+    std::cout << "Total " << succinctMicros(total) << " Input "
+              << succinctNanos(inputNs) << " Output " << succinctNanos(outputNs)
+              << " Finish " << succinctNanos(finishNs) << std::endl;
+    return 1;
+  }
+
   core::PlanNodePtr makeOrderByPlan(
       const TestCase& test,
       core::PlanNodeId& orderByNodeId) {
@@ -111,6 +111,14 @@ static const common::PrefixSortConfig kDefaultSortConfig(1024, 100, 50);
 static const common::PrefixSortConfig
     kStdSortConfig(1024, std::numeric_limits<int>::max(), 50);
 
+// Prefix-sort that always uses quick sort, to compare with radix sort which
+// 'kDefaultSortConfig' uses for small fully normalized keys.
+static const common::PrefixSortConfig kQuickSortConfig = [] {
+  common::PrefixSortConfig config(1024, 100, 50);
+  config.maxRadixSortKeyBytes = 0;
+  return config;
+}();
+
 class PrefixSortBenchmark {
  public:
   PrefixSortBenchmark(memory::MemoryPool* pool) : pool_(pool) {}
@@ -126,6 +134,16 @@ class PrefixSortBenchmark {
         rowContainer, compareFlags, kDefaultSortConfig, pool_, sortedRows);
   }
 
+  void runPrefixQuickSort(
+      const std::vector<char*>& rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags) {
+    auto sortedRows = std::vector<char*, memory::StlAllocator<char*>>(
+        rows.begin(), rows.end(), *pool_);
+    PrefixSort::sort(
+        rowContainer, compareFlags, kQuickSortConfig, pool_, sortedRows);
+  }
+
   void runStdSort(
       const std::vector<char*>& rows,
       RowContainer* rowContainer,
@@ -145,7 +163,8 @@ class PrefixSortBenchmark {
       int numKeys) {
     auto testCase =
         std::make_unique<TestCase>(pool_, testName, numRows, rowType, numKeys);
-    // Add benchmarks for std-sort and prefix-sort.
+    // Add benchmarks for std-sort, prefix-sort and prefix-sort without radix
+    // sort.
     {
       folly::addBenchmark(
           __FILE__,
@@ -173,6 +192,19 @@ class PrefixSortBenchmark {
             }
             return rows.size() * iterations;
           });
+      folly::addBenchmark(
+          __FILE__,
+          "%PrefixQuickSort",
+          [rows = testCase->rows(),
+           container = testCase->rowContainer(),
+           sortFlags = testCase->compareFlags(),
+           iterations = iterations,
+           this]() {
+            for (auto i = 0; i < iterations; ++i) {
+              runPrefixQuickSort(rows, container, sortFlags);
+            }
+            return rows.size() * iterations;
+          });
     }
     testCases_.push_back(std::move(testCase));
   }
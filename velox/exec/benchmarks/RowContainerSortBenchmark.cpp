@@ -156,6 +156,34 @@ void rowContainerTimSortBenchmark(uint32_t iterations, size_t cardinality) {
   }
 }
 
+// Measures copying a column out of the rows in sorted order, as OrderBy does
+// when producing output. The sorted rows are scattered across the container.
+template <typename T>
+void rowContainerExtractBenchmark(uint32_t iterations, size_t cardinality) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  VectorMaker vectorMaker(pool.get());
+
+  auto data =
+      genTestData<T>(cardinality, CppToType<T>::create(), true, false, false);
+  auto vector =
+      vectorMaker.encodedVector<T>(VectorEncoding::Simple::FLAT, data.data());
+  DecodedVector decoded(*vector);
+  std::vector<TypePtr> types{vector->type()};
+  auto rowContainer =
+      std::make_unique<velox::exec::RowContainer>(types, pool.get());
+  auto rows = store(*rowContainer, decoded, vector->size());
+  std::sort(rows.begin(), rows.end(), [&](const char* left, const char* right) {
+    return rowContainer->compareRows(left, right) < 0;
+  });
+  auto result = BaseVector::create(vector->type(), rows.size(), pool.get());
+  for (size_t k = 0; k < iterations; ++k) {
+    suspender.dismiss();
+    rowContainer->extractColumn(rows.data(), rows.size(), 0, result);
+    suspender.rehire();
+  }
+}
+
 void BM_Int64_stdSort(uint32_t iterations, size_t cardinality) {
   rowContainerStdSortBenchmark<int64_t>(iterations, cardinality);
 }
@@ -164,6 +192,14 @@ void BM_Int64_timSort(uint32_t iterations, size_t cardinality) {
   rowContainerTimSortBenchmark<int64_t>(iterations, cardinality);
 }
 
+void BM_Int64_extract(uint32_t iterations, size_t cardinality) {
+  rowContainerExtractBenchmark<int64_t>(iterations, cardinality);
+}
+
+void BM_Int32_extract(uint32_t iterations, size_t cardinality) {
+  rowContainerExtractBenchmark<int32_t>(iterations, cardinality);
+}
+
 void BM_STR_stdSort(uint32_t iterations) {
   folly::BenchmarkSuspender suspender;
   auto pool = memory::memoryManager()->addLeafPool();
@@ -227,6 +263,10 @@ BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 1k_uni_noseq, 1000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 1k_uni_noseq, 1000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_NAMED_PARAM(BM_Int64_extract, 100k_uni_noseq, 100000);
+BENCHMARK_NAMED_PARAM(BM_Int32_extract, 100k_uni_noseq, 100000);
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_NAMED_PARAM(BM_STR_stdSort, RealWorldData_stdSort);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_STR_timSort, RealWorldData_timSort);
 BENCHMARK_DRAW_LINE();
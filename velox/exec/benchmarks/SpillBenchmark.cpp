@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/exec/Spill.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_string(
+    spill_benchmark_path,
+    "",
+    "The directory to write the spill files to, e.g. a directory on a local "
+    "NVMe drive or on tmpfs such as /dev/shm. Any path of a registered file "
+    "system is accepted. Uses a temporary local directory if empty.");
+DEFINE_uint32(
+    spill_benchmark_num_rows,
+    500'000,
+    "The number of rows spilled per schema");
+DEFINE_uint32(
+    spill_benchmark_vector_size,
+    1'024,
+    "The number of rows per spilled vector");
+DEFINE_string(
+    spill_benchmark_compression_kinds,
+    "none,lz4,zstd",
+    "Comma separated compression kinds of the write benchmarks");
+DEFINE_string(
+    spill_benchmark_target_file_sizes_mb,
+    "1,64",
+    "Comma separated target spill file sizes in MB of the write benchmarks");
+DEFINE_string(
+    spill_benchmark_read_compression_kind,
+    "lz4",
+    "The compression kind of the files read by the merge and restore "
+    "benchmarks");
+DEFINE_string(
+    spill_benchmark_num_runs,
+    "4,16,64",
+    "Comma separated numbers of sorted runs merged by the merge benchmarks");
+DEFINE_uint64(
+    spill_benchmark_read_buffer_size,
+    1 << 20,
+    "The read buffer size of each spill file");
+DEFINE_uint64(
+    spill_benchmark_write_buffer_size,
+    1 << 20,
+    "The spill write buffer size");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+struct TestSchema {
+  std::string name;
+  RowTypePtr rowType;
+};
+
+// Kept alive for the duration of the benchmarks.
+struct TestData {
+  RowTypePtr rowType;
+  std::vector<RowVectorPtr> vectors;
+  // Sorted runs on the first column by number of runs.
+  std::unordered_map<uint32_t, SpillFiles> sortedRuns;
+  // Files read by the restore benchmark.
+  SpillFiles unsortedFiles;
+};
+
+std::vector<TestSchema> testSchemas() {
+  std::vector<std::string> wideNames;
+  std::vector<TypePtr> wideTypes;
+  for (auto i = 0; i < 20; ++i) {
+    wideNames.push_back(fmt::format("c{}", i));
+    switch (i % 4) {
+      case 0:
+        wideTypes.push_back(BIGINT());
+        break;
+      case 1:
+        wideTypes.push_back(DOUBLE());
+        break;
+      case 2:
+        wideTypes.push_back(INTEGER());
+        break;
+      default:
+        wideTypes.push_back(VARCHAR());
+        break;
+    }
+  }
+  return {
+      {"narrow", ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), DOUBLE()})},
+      {"strings", ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), VARCHAR()})},
+      {"wide", ROW(std::move(wideNames), std::move(wideTypes))},
+  };
+}
+
+template <typename T>
+std::vector<T> splitFlag(const std::string& flag) {
+  std::vector<T> values;
+  folly::split(',', flag, values, /*ignoreEmpty=*/true);
+  return values;
+}
+
+class SpillBenchmark {
+ public:
+  SpillBenchmark(memory::MemoryPool* pool, std::string spillDir)
+      : pool_(pool),
+        spillDir_(std::move(spillDir)),
+        fs_(filesystems::getFileSystem(spillDir_, {})) {
+    fs_->mkdir(spillDir_);
+  }
+
+  ~SpillBenchmark() {
+    for (const auto& data : testData_) {
+      for (const auto& [_, files] : data->sortedRuns) {
+        removeFiles(files);
+      }
+      removeFiles(data->unsortedFiles);
+    }
+  }
+
+  void addBenchmarks(const TestSchema& schema) {
+    auto data = std::make_unique<TestData>();
+    data->rowType = schema.rowType;
+    data->vectors = makeVectors(schema.rowType, 1);
+    addWriteBenchmarks(schema.name, *data);
+    addMergeBenchmarks(schema.name, *data);
+    addRestoreBenchmark(schema.name, *data);
+    testData_.push_back(std::move(data));
+  }
+
+ private:
+  // Returns FLAGS_spill_benchmark_num_rows rows of 'rowType' in 'numRuns'
+  // runs. The first column of each run is a distinct ascending sequence.
+  std::vector<RowVectorPtr> makeVectors(
+      const RowTypePtr& rowType,
+      uint32_t numRuns) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_spill_benchmark_vector_size;
+    options.nullRatio = 0;
+    options.stringLength = 20;
+    VectorFuzzer fuzzer(options, pool_);
+
+    const auto numVectors = bits::divRoundUp(
+        FLAGS_spill_benchmark_num_rows, FLAGS_spill_benchmark_vector_size);
+    std::vector<RowVectorPtr> vectors;
+    vectors.reserve(numVectors);
+    for (auto i = 0; i < numVectors; ++i) {
+      auto vector = fuzzer.fuzzInputFlatRow(rowType);
+      auto keys = BaseVector::create<FlatVector<int64_t>>(
+          BIGINT(), vector->size(), pool_);
+      // Vector 'i' belongs to run 'i % numRuns'.
+      const auto run = i % numRuns;
+      const int64_t firstKey = (i / numRuns) * vector->size() * numRuns + run;
+      for (auto row = 0; row < vector->size(); ++row) {
+        keys->set(row, firstKey + row * numRuns);
+      }
+      auto children = vector->children();
+      children[0] = keys;
+      vectors.push_back(std::make_shared<RowVector>(
+          pool_, rowType, nullptr, vector->size(), std::move(children)));
+    }
+    return vectors;
+  }
+
+  // Writes 'vectors' with a new SpillWriter. If 'numRuns' > 1, writes vector
+  // 'i' to the file of run 'i % numRuns', one writer per run, so that every
+  // file is a sorted run.
+  SpillFiles write(
+      const std::vector<RowVectorPtr>& vectors,
+      common::CompressionKind compressionKind,
+      uint64_t targetFileSize,
+      bool columnarFormat,
+      uint32_t numSortKeys,
+      uint32_t numRuns = 1) {
+    std::vector<std::unique_ptr<SpillWriter>> writers;
+    for (auto run = 0; run < numRuns; ++run) {
+      writers.push_back(std::make_unique<SpillWriter>(
+          asRowType(vectors[0]->type()),
+          numSortKeys,
+          std::vector<CompareFlags>(numSortKeys),
+          compressionKind,
+          fmt::format("{}/spill-{}-{}", spillDir_, nextFileId_++, run),
+          targetFileSize,
+          FLAGS_spill_benchmark_write_buffer_size,
+          "",
+          columnarFormat,
+          updateAndCheckSpillLimitCb_,
+          pool_,
+          &stats_));
+    }
+    for (auto i = 0; i < vectors.size(); ++i) {
+      IndexRange range{0, vectors[i]->size()};
+      writers[i % numRuns]->write(
+          vectors[i], folly::Range<IndexRange*>(&range, 1));
+    }
+    SpillFiles files;
+    for (auto& writer : writers) {
+      auto writerFiles = writer->finish();
+      files.insert(files.end(), writerFiles.begin(), writerFiles.end());
+    }
+    return files;
+  }
+
+  void removeFiles(const SpillFiles& files) {
+    for (const auto& file : files) {
+      fs_->remove(file.path);
+    }
+  }
+
+  // Measures the spill write throughput by compression kind, file format and
+  // target file size.
+  void addWriteBenchmarks(const std::string& schemaName, TestData& data) {
+    for (const auto& kindName :
+         splitFlag<std::string>(FLAGS_spill_benchmark_compression_kinds)) {
+      const auto kind = common::stringToCompressionKind(kindName);
+      for (const auto fileSizeMb : splitFlag<uint64_t>(
+               FLAGS_spill_benchmark_target_file_sizes_mb)) {
+        for (const bool columnar : {false, true}) {
+          folly::addBenchmark(
+              __FILE__,
+              fmt::format(
+                  "write_{}_{}_{}MB{}",
+                  schemaName,
+                  kindName,
+                  fileSizeMb,
+                  columnar ? "_columnar" : ""),
+              [this, &data, kind, fileSizeMb, columnar]() {
+                const auto files = write(
+                    data.vectors, kind, fileSizeMb << 20, columnar, 0);
+                folly::BenchmarkSuspender suspender;
+                removeFiles(files);
+                return FLAGS_spill_benchmark_num_rows;
+              });
+        }
+      }
+    }
+  }
+
+  // Measures the sorted merge of 'numRuns' spill files through the
+  // TreeOfLosers of FileSpillMergeStreams.
+  void addMergeBenchmarks(const std::string& schemaName, TestData& data) {
+    const auto kind = common::stringToCompressionKind(
+        FLAGS_spill_benchmark_read_compression_kind);
+    for (const auto numRuns :
+         splitFlag<uint32_t>(FLAGS_spill_benchmark_num_runs)) {
+      data.sortedRuns[numRuns] = write(
+          makeVectors(data.rowType, numRuns),
+          kind,
+          std::numeric_limits<uint64_t>::max(),
+          false,
+          1,
+          numRuns);
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("merge_{}_{}runs", schemaName, numRuns),
+          [this, &files = data.sortedRuns[numRuns]]() {
+            SpillPartition partition(SpillPartitionId(0), files);
+            auto merge = partition.createOrderedReader(
+                FLAGS_spill_benchmark_read_buffer_size, pool_, &stats_);
+            uint64_t numRows = 0;
+            int64_t lastKey = std::numeric_limits<int64_t>::min();
+            for (auto* stream = merge->next(); stream != nullptr;
+                 stream = merge->next()) {
+              const auto key = stream->decoded(0).valueAt<int64_t>(
+                  stream->currentIndex());
+              VELOX_CHECK_GT(key, lastKey);
+              lastKey = key;
+              stream->pop();
+              ++numRows;
+            }
+            return numRows;
+          });
+    }
+  }
+
+  // Measures reading back spill files and storing their rows into a
+  // RowContainer as the hash build and aggregation do on restore.
+  void addRestoreBenchmark(const std::string& schemaName, TestData& data) {
+    data.unsortedFiles = write(
+        data.vectors,
+        common::stringToCompressionKind(
+            FLAGS_spill_benchmark_read_compression_kind),
+        std::numeric_limits<uint64_t>::max(),
+        false,
+        0);
+    folly::addBenchmark(
+        __FILE__,
+        fmt::format("restore_{}", schemaName),
+        [this, &data]() {
+          folly::BenchmarkSuspender suspender;
+          std::vector<TypePtr> dependentTypes(
+              data.rowType->children().begin() + 1,
+              data.rowType->children().end());
+          RowContainer container(
+              {data.rowType->childAt(0)}, dependentTypes, pool_);
+          suspender.dismiss();
+
+          SpillPartition partition(SpillPartitionId(0), data.unsortedFiles);
+          auto reader = partition.createUnorderedReader(
+              FLAGS_spill_benchmark_read_buffer_size, pool_, &stats_);
+          uint64_t numRows = 0;
+          RowVectorPtr batch;
+          std::vector<char*> rows;
+          DecodedVector decoded;
+          while (reader->nextBatch(batch)) {
+            rows.resize(batch->size());
+            for (auto i = 0; i < batch->size(); ++i) {
+              rows[i] = container.newRow();
+            }
+            for (auto column = 0; column < batch->childrenSize(); ++column) {
+              decoded.decode(*batch->childAt(column));
+              container.store(
+                  decoded,
+                  folly::Range<char**>(rows.data(), rows.size()),
+                  column);
+            }
+            numRows += batch->size();
+          }
+
+          suspender.rehire();
+          container.clear();
+          return numRows;
+        });
+  }
+
+  memory::MemoryPool* const pool_;
+  const std::string spillDir_;
+  const std::shared_ptr<filesystems::FileSystem> fs_;
+  common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_{
+      [](uint64_t) {}};
+  folly::Synchronized<common::SpillStats> stats_;
+  uint32_t nextFileId_{0};
+  std::vector<std::unique_ptr<TestData>> testData_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  filesystems::registerLocalFileSystem();
+  serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  serializer::presto::PrestoVectorSerde::registerNamedVectorSerde();
+
+  auto rootPool = memory::memoryManager()->addRootPool("SpillBenchmark");
+  auto leafPool = rootPool->addLeafChild("leaf");
+
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDir;
+  std::string spillDir = FLAGS_spill_benchmark_path;
+  if (spillDir.empty()) {
+    tempDir = exec::test::TempDirectoryPath::create();
+    spillDir = tempDir->getPath();
+  }
+
+  {
+    SpillBenchmark benchmark(leafPool.get(), spillDir);
+    for (const auto& schema : testSchemas()) {
+      benchmark.addBenchmarks(schema);
+    }
+    folly::runBenchmarks();
+  }
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include <gflags/gflags.h>
 #include "velox/exec/VectorHasher.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -24,6 +25,8 @@ using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
 
+DECLARE_bool(velox_cache_string_hashes);
+
 namespace {
 class BenchmarkBase {
  public:
@@ -270,6 +273,76 @@ BENCHMARK(computeValueIdsDictionaryForFiltering) {
   }
 }
 
+// Hashes a batch of strings of up to 'maxLength' bytes with 'numHashers'
+// hashers, e.g. of a partitioned output, a hash aggregation and a hash join
+// probe in one pipeline. If 'scalar' is true, hashes each string with
+// folly::hasher instead, as VectorHasher did before hashing strings in
+// batches.
+void benchmarkHashStrings(
+    int32_t maxLength,
+    int32_t numHashers,
+    bool cacheHashes,
+    bool scalar = false) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_cache_string_hashes = cacheHashes;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+  auto values = base.vectorMaker().flatVector<std::string>(
+      size, [&](vector_size_t row) {
+        return std::string(1 + row % maxLength, 'a' + row % 26);
+      });
+  auto* strings = values->asFlatVector<StringView>();
+
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers;
+  for (auto i = 0; i < numHashers; ++i) {
+    hashers.emplace_back(exec::VectorHasher::create(VARCHAR(), 0));
+  }
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes(size);
+  suspender.dismiss();
+
+  for (auto i = 0; i < 10'000; ++i) {
+    // Each iteration stands for a new batch.
+    strings->invalidateCachedHashes();
+    for (auto& hasher : hashers) {
+      if (scalar) {
+        rows.applyToSelected([&](auto row) {
+          hashes[row] = folly::hasher<StringView>()(strings->valueAt(row));
+        });
+      } else {
+        hasher->decode(*values, rows);
+        hasher->hash(rows, false, hashes);
+      }
+      folly::doNotOptimizeAway(hashes);
+    }
+  }
+}
+
+BENCHMARK(hashShortStringsScalar) {
+  benchmarkHashStrings(7, 1, false, true);
+}
+
+BENCHMARK_RELATIVE(hashShortStrings) {
+  benchmarkHashStrings(7, 1, false);
+}
+
+BENCHMARK(hashLongStringsScalar) {
+  benchmarkHashStrings(40, 1, false, true);
+}
+
+BENCHMARK_RELATIVE(hashLongStrings) {
+  benchmarkHashStrings(40, 1, false);
+}
+
+BENCHMARK(hashStringsThreeOperators) {
+  benchmarkHashStrings(20, 3, false);
+}
+
+BENCHMARK_RELATIVE(hashStringsThreeOperatorsCached) {
+  benchmarkHashStrings(20, 3, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManager::initialize({});
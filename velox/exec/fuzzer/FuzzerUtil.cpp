@@ -16,6 +16,7 @@
 #include "velox/exec/fuzzer/FuzzerUtil.h"
 #include <re2/re2.h>
 #include <filesystem>
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
@@ -23,6 +24,8 @@
 #include "velox/dwio/dwrf/writer/Writer.h"
 #include "velox/exec/fuzzer/DuckQueryRunner.h"
 #include "velox/exec/fuzzer/PrestoQueryRunner.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/functions/prestosql/types/IPPrefixType.h"
 
@@ -433,4 +436,77 @@ computeReferenceResultsAsVector(
     ReferenceQueryRunner* referenceQueryRunner) {
   return referenceQueryRunner->executeAndReturnVector(plan);
 }
+
+namespace {
+PerfResult measurePerformance(
+    const core::PlanNodePtr& plan,
+    const std::function<void(AssertQueryBuilder&)>& addSplits,
+    const PerfConfig& config,
+    int32_t repeats) {
+  PerfResult result{config.name, std::numeric_limits<uint64_t>::max(), 0};
+  for (auto i = 0; i < repeats; ++i) {
+    AssertQueryBuilder builder(plan);
+    if (addSplits) {
+      addSplits(builder);
+    }
+    builder.maxDrivers(config.maxDrivers).configs(config.queryConfigs);
+
+    std::shared_ptr<TempDirectoryPath> spillDirectory;
+    auto it = config.queryConfigs.find(core::QueryConfig::kSpillEnabled);
+    if (it != config.queryConfigs.end() && it->second == "true") {
+      spillDirectory = TempDirectoryPath::create();
+      builder.spillDirectory(spillDirectory->getPath());
+    }
+
+    std::shared_ptr<Task> task;
+    const auto start = std::chrono::steady_clock::now();
+    builder.runWithoutResults(task);
+    const uint64_t wallNanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    result.wallNanos = std::min(result.wallNanos, wallNanos);
+    result.peakMemoryBytes =
+        std::max(result.peakMemoryBytes, task->pool()->peakBytes());
+    task.reset();
+    waitForAllTasksToBeDeleted();
+  }
+  return result;
+}
+} // namespace
+
+std::vector<PerfResult> comparePerformance(
+    const core::PlanNodePtr& plan,
+    const std::function<void(AssertQueryBuilder&)>& addSplits,
+    const PerfConfig& baseline,
+    const std::vector<PerfConfig>& variants,
+    int32_t repeats,
+    double slowdownThreshold,
+    uint64_t minSlowdownNanos) {
+  VELOX_CHECK_GT(repeats, 0);
+  const auto baselineResult =
+      measurePerformance(plan, addSplits, baseline, repeats);
+  LOG(INFO) << "Performance of " << baselineResult.name << ": "
+            << succinctNanos(baselineResult.wallNanos) << ", peak memory "
+            << succinctBytes(baselineResult.peakMemoryBytes);
+
+  std::vector<PerfResult> slower;
+  for (const auto& variant : variants) {
+    auto result = measurePerformance(plan, addSplits, variant, repeats);
+    LOG(INFO) << "Performance of " << result.name << ": "
+              << succinctNanos(result.wallNanos) << ", peak memory "
+              << succinctBytes(result.peakMemoryBytes);
+    if (result.wallNanos > baselineResult.wallNanos * slowdownThreshold &&
+        result.wallNanos >= baselineResult.wallNanos + minSlowdownNanos) {
+      LOG(WARNING) << "Config " << result.name << " is slower than "
+                   << baselineResult.name << ": "
+                   << succinctNanos(result.wallNanos) << " vs. "
+                   << succinctNanos(baselineResult.wallNanos)
+                   << " for plan: " << plan->toString(true, true);
+      slower.push_back(std::move(result));
+    }
+  }
+  return slower;
+}
+
 } // namespace facebook::velox::exec::test
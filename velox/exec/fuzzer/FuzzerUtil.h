@@ -160,4 +160,41 @@ computeReferenceResultsAsVector(
     const core::PlanNodePtr& plan,
     ReferenceQueryRunner* referenceQueryRunner);
 
+/// A named set of query configs and a driver count to execute a plan with.
+/// Used to compare the performance of optimizations against a baseline.
+struct PerfConfig {
+  std::string name;
+  std::unordered_map<std::string, std::string> queryConfigs;
+  int32_t maxDrivers{1};
+};
+
+/// Timing and memory of executing a plan with a PerfConfig.
+struct PerfResult {
+  std::string name;
+  /// Minimum wall time across the repeated executions.
+  uint64_t wallNanos{0};
+  /// Maximum peak memory of the task across the repeated executions.
+  int64_t peakMemoryBytes{0};
+};
+
+class AssertQueryBuilder;
+
+/// Executes 'plan' under 'baseline' and under each of 'variants', 'repeats'
+/// times each, and logs the timing and memory of every
+/// configuration. Returns the results of the variants whose wall time exceeds
+/// the baseline's by more than a factor of 'slowdownThreshold' and by at
+/// least 'minSlowdownNanos', which keeps timer noise of tiny plans from being
+/// reported. 'addSplits' is called to add the splits of the plan to each
+/// execution. A config that enables spilling gets a temporary spill
+/// directory. Results are not compared; this is left to the correctness
+/// checks of the fuzzers.
+std::vector<PerfResult> comparePerformance(
+    const core::PlanNodePtr& plan,
+    const std::function<void(AssertQueryBuilder&)>& addSplits,
+    const PerfConfig& baseline,
+    const std::vector<PerfConfig>& variants,
+    int32_t repeats,
+    double slowdownThreshold,
+    uint64_t minSlowdownNanos = 1'000'000);
+
 } // namespace facebook::velox::exec::test
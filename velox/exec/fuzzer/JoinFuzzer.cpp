@@ -66,6 +66,26 @@ DEFINE_double(
     0,
     "The chance of testing plans with filters enabled.");
 
+DEFINE_bool(
+    perf_compare,
+    false,
+    "When enabled, the default plan of each iteration is also executed with "
+    "alternative configs (driver counts, spilling, probe partitioning, key "
+    "rows) and the configs slower than the baseline by more than "
+    "--perf_slowdown_threshold are reported.");
+
+DEFINE_int32(
+    perf_repeats,
+    3,
+    "Number of executions per config in --perf_compare mode. The fastest "
+    "one is used.");
+
+DEFINE_double(
+    perf_slowdown_threshold,
+    1.5,
+    "Ratio of a config's wall time to the baseline's above which the config "
+    "is reported as slower in --perf_compare mode.");
+
 namespace facebook::velox::exec {
 
 namespace {
@@ -288,6 +308,10 @@ class JoinFuzzer {
 
   RowVectorPtr execute(const PlanWithSplits& plan, bool injectSpill);
 
+  // Executes 'plan' with the default configs and alternative ones and records
+  // the configs that are slower than the default.
+  void comparePerformance(const PlanWithSplits& plan);
+
   std::optional<test::MaterializedRowMultiset> computeReferenceResults(
       const core::PlanNodePtr& plan,
       const std::vector<RowVectorPtr>& probeInput,
@@ -337,6 +361,10 @@ class JoinFuzzer {
     // The number of iterations that test cross product.
     size_t numCrossProduct{0};
 
+    // The number of alternative configs that were slower than the default in
+    // --perf_compare mode.
+    size_t numPerfRegressions{0};
+
     std::string toString() const {
       std::stringstream out;
       out << "\nTotal iterations tested: " << numIterations << std::endl;
@@ -344,6 +372,9 @@ class JoinFuzzer {
           << makePercentageString(numVerified, numIterations) << std::endl;
       out << "Total iterations testing cross product: "
           << makePercentageString(numCrossProduct, numIterations) << std::endl;
+      if (FLAGS_perf_compare) {
+        out << "Total slower configs: " << numPerfRegressions << std::endl;
+      }
 
       return out.str();
     }
@@ -527,6 +558,43 @@ std::vector<RowVectorPtr> flatten(const std::vector<RowVectorPtr>& vectors) {
   return flatVectors;
 }
 
+void JoinFuzzer::comparePerformance(const PlanWithSplits& plan) {
+  // Same driver count as execute().
+  const test::PerfConfig baseline{"default", {}, 2};
+  std::vector<test::PerfConfig> variants = {
+      {"1 driver", {}, 1},
+      {"4 drivers", {}, 4},
+      {"no probe partitioning",
+       {{core::QueryConfig::kHashProbePartitioningEnabled, "false"}},
+       2},
+      {"key rows", {{core::QueryConfig::kHashJoinKeyRowsMinKeys, "1"}}, 2},
+  };
+  // Spilling for right semi project doesn't work yet.
+  auto hashJoin =
+      std::dynamic_pointer_cast<const core::HashJoinNode>(plan.plan);
+  if (FLAGS_enable_spill &&
+      !(hashJoin != nullptr && hashJoin->isRightSemiProjectJoin())) {
+    variants.push_back(
+        {"spill",
+         {{core::QueryConfig::kSpillEnabled, "true"},
+          {core::QueryConfig::kJoinSpillEnabled, "true"}},
+         2});
+  }
+
+  const auto slower = test::comparePerformance(
+      plan.plan,
+      [&](test::AssertQueryBuilder& builder) {
+        for (const auto& [planNodeId, nodeSplits] : plan.splits) {
+          builder.splits(planNodeId, nodeSplits);
+        }
+      },
+      baseline,
+      variants,
+      FLAGS_perf_repeats,
+      FLAGS_perf_slowdown_threshold);
+  stats_.numPerfRegressions += slower.size();
+}
+
 RowVectorPtr JoinFuzzer::execute(const PlanWithSplits& plan, bool injectSpill) {
   LOG(INFO) << "Executing query plan with "
             << executionStrategyToString(plan.executionStrategy) << " strategy["
@@ -1301,6 +1369,10 @@ void JoinFuzzer::verify(core::JoinType joinType) {
       }
     }
   }
+
+  if (FLAGS_perf_compare && expected != nullptr) {
+    comparePerformance(defaultPlan);
+  }
 }
 
 JoinFuzzer::PlanWithSplits JoinFuzzer::makeMergeJoinPlanWithTableScan(
@@ -64,6 +64,25 @@ DEFINE_bool(
     "up after failures. Therefore, results are not compared when this is "
     "enabled. Note that this option only works in debug builds.");
 
+DEFINE_bool(
+    perf_compare,
+    false,
+    "When enabled, the first plan of each iteration is also executed with "
+    "alternative configs (driver counts, spilling) and the configs slower "
+    "than the baseline by more than --perf_slowdown_threshold are reported.");
+
+DEFINE_int32(
+    perf_repeats,
+    3,
+    "Number of executions per config in --perf_compare mode. The fastest "
+    "one is used.");
+
+DEFINE_double(
+    perf_slowdown_threshold,
+    1.5,
+    "Ratio of a config's wall time to the baseline's above which the config "
+    "is reported as slower in --perf_compare mode.");
+
 namespace facebook::velox::exec {
 
 RowNumberFuzzerBase::RowNumberFuzzerBase(
@@ -236,6 +255,33 @@ RowVectorPtr RowNumberFuzzerBase::execute(
   return result;
 }
 
+void RowNumberFuzzerBase::comparePerformance(
+    const PlanWithSplits& plan,
+    const std::optional<std::string>& spillConfig) {
+  // Same driver count as execute().
+  const test::PerfConfig baseline{"default", {}, 1};
+  std::vector<test::PerfConfig> variants = {{"4 drivers", {}, 4}};
+  if (FLAGS_enable_spill && spillConfig.has_value()) {
+    variants.push_back(
+        {"spill",
+         {{core::QueryConfig::kSpillEnabled, "true"},
+          {spillConfig.value(), "true"}},
+         1});
+  }
+
+  test::comparePerformance(
+      plan.plan,
+      [&](test::AssertQueryBuilder& builder) {
+        if (!plan.splits.empty()) {
+          builder.splits(plan.splits);
+        }
+      },
+      baseline,
+      variants,
+      FLAGS_perf_repeats,
+      FLAGS_perf_slowdown_threshold);
+}
+
 void RowNumberFuzzerBase::testPlan(
     const PlanWithSplits& plan,
     int32_t testNumber,
@@ -281,6 +327,10 @@ void RowNumberFuzzerBase::testPlan(
           FLAGS_enable_oom_injection, "Got unexpected nullptr for results");
     }
   }
+
+  if (FLAGS_perf_compare && testNumber == 0 && expected != nullptr) {
+    comparePerformance(plan, spillConfig);
+  }
 }
 
 } // namespace facebook::velox::exec
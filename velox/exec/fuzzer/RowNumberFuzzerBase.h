@@ -38,6 +38,12 @@ DECLARE_int32(max_spill_level);
 
 DECLARE_bool(enable_oom_injection);
 
+DECLARE_bool(perf_compare);
+
+DECLARE_int32(perf_repeats);
+
+DECLARE_double(perf_slowdown_threshold);
+
 namespace facebook::velox::exec {
 
 class RowNumberFuzzerBase {
@@ -109,6 +115,13 @@ class RowNumberFuzzerBase {
       const std::optional<std::string>& spillConfig = std::nullopt,
       int maxSpillLevel = -1);
 
+  // Executes 'plan' with the default configs and alternative ones and logs
+  // the configs that are slower than the default. Used when
+  // FLAGS_perf_compare is set.
+  void comparePerformance(
+      const PlanWithSplits& plan,
+      const std::optional<std::string>& spillConfig);
+
   // Tests a plan by executing it with and without spilling. OOM injection
   // also might be done based on FLAG_enable_oom_injection.
   void testPlan(
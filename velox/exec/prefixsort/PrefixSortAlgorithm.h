@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -159,6 +161,60 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) with a least significant digit radix
+  /// sort on their first 'keySize' bytes. The keys are compared as 'keySize' /
+  /// 8 unsigned 64-bit words in native (little-endian) byte order, most
+  /// significant word first, the same as the word-wise compare of normalized
+  /// keys. Entries with equal keys keep their order. 'buffer' must be as large
+  /// as the range. A byte that is the same in all entries takes no pass, so
+  /// small values of wide types take only a few passes.
+  void radixSort(char* start, char* end, uint64_t keySize, char* buffer) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    VELOX_CHECK_EQ(keySize % sizeof(uint64_t), 0);
+    VELOX_CHECK_LE(keySize, entrySize_);
+    const uint64_t numEntries = (end - start) / entrySize_;
+    if (numEntries < 2) {
+      return;
+    }
+
+    // The counts of the values of a byte do not depend on the order of the
+    // entries, so the counts of all bytes are taken in one pass.
+    std::vector<std::array<uint64_t, 256>> offsets(keySize);
+    for (auto* entry = start; entry < end; entry += entrySize_) {
+      for (uint64_t byte = 0; byte < keySize; ++byte) {
+        ++offsets[byte][static_cast<uint8_t>(entry[byte])];
+      }
+    }
+
+    char* source = start;
+    char* target = buffer;
+    for (int64_t word = keySize / sizeof(uint64_t) - 1; word >= 0; --word) {
+      for (auto i = 0; i < sizeof(uint64_t); ++i) {
+        const auto byte = word * sizeof(uint64_t) + i;
+        auto& byteOffsets = offsets[byte];
+        if (byteOffsets[static_cast<uint8_t>(source[byte])] == numEntries) {
+          continue;
+        }
+        uint64_t offset = 0;
+        for (auto& count : byteOffsets) {
+          const auto numValues = count;
+          count = offset;
+          offset += numValues;
+        }
+        const auto* sourceEnd = source + numEntries * entrySize_;
+        for (auto* entry = source; entry < sourceEnd; entry += entrySize_) {
+          auto& entryOffset = byteOffsets[static_cast<uint8_t>(entry[byte])];
+          simd::memcpy(target + entryOffset * entrySize_, entry, entrySize_);
+          ++entryOffset;
+        }
+        std::swap(source, target);
+      }
+    }
+    if (source != start) {
+      simd::memcpy(start, source, numEntries * entrySize_);
+    }
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -63,6 +63,17 @@ class PrefixSortEncoder {
   FOLLY_ALWAYS_INLINE void
   encodeNoNulls(T value, char* dest, uint32_t encodeSize) const;
 
+  /// Same as encodeNoNulls() for a string whose data is contiguous in memory,
+  /// e.g. a string of a vector. encodeNoNulls() reads strings stored in a
+  /// RowContainer.
+  FOLLY_ALWAYS_INLINE void
+  encodeContiguousNoNulls(StringView value, char* dest, uint32_t encodeSize)
+      const {
+    const uint32_t copySize = std::min<uint32_t>(value.size(), encodeSize);
+    std::memcpy(dest, value.data(), copySize);
+    encodeStringPadding(value, dest, encodeSize);
+  }
+
   bool isAscending() const {
     return ascending_;
   }
@@ -103,6 +114,23 @@ class PrefixSortEncoder {
   }
 
  private:
+  // Pads the string prefix in 'dest' with zeros and inverts the bits if
+  // descending.
+  FOLLY_ALWAYS_INLINE void encodeStringPadding(
+      StringView value,
+      char* dest,
+      uint32_t encodeSize) const {
+    if (value.size() < encodeSize) {
+      std::memset(dest + value.size(), 0, encodeSize - value.size());
+    }
+
+    if (!ascending_) {
+      for (auto i = 0; i < encodeSize; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   const bool ascending_;
   const bool nullsFirst_;
 };
@@ -299,15 +327,7 @@ FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
     stream.ByteInputStream::readBytes(dest, copySize);
   }
 
-  if (value.size() < encodeSize) {
-    std::memset(dest + value.size(), 0, encodeSize - value.size());
-  }
-
-  if (!ascending_) {
-    for (auto i = 0; i < encodeSize; ++i) {
-      dest[i] = ~dest[i];
-    }
-  }
+  encodeStringPadding(value, dest, encodeSize);
 }
 
 } // namespace facebook::velox::exec::prefixsort
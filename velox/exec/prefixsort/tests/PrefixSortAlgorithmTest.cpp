@@ -17,6 +17,7 @@
 #include <folly/Random.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <numeric>
 
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
 #include "velox/exec/prefixsort/PrefixSortEncoder.h"
@@ -70,6 +71,57 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  // Each entry has 'numWords' key words followed by the original position.
+  // Keys have few distinct high bytes so that some passes are skipped.
+  auto testRadixSort = [&](size_t numEntries, size_t numWords) {
+    SCOPED_TRACE(fmt::format("{} entries, {} words", numEntries, numWords));
+    const auto entryWords = numWords + 1;
+    std::vector<uint64_t> data(numEntries * entryWords);
+    for (auto i = 0; i < numEntries; ++i) {
+      for (auto word = 0; word < numWords; ++word) {
+        data[i * entryWords + word] =
+            folly::Random::rand64() % (word == 0 ? 100 : 1'000'000);
+      }
+      data[i * entryWords + numWords] = i;
+    }
+
+    // Expected order: keys compared word by word, ties in original order.
+    std::vector<uint64_t> expected(numEntries);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::stable_sort(
+        expected.begin(), expected.end(), [&](uint64_t left, uint64_t right) {
+          return std::lexicographical_compare(
+              data.begin() + left * entryWords,
+              data.begin() + left * entryWords + numWords,
+              data.begin() + right * entryWords,
+              data.begin() + right * entryWords + numWords);
+        });
+
+    const auto entrySize = entryWords * sizeof(uint64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+    auto radixBuffer =
+        AlignedBuffer::allocate<char>(numEntries * entrySize, pool());
+    PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+    char* start = reinterpret_cast<char*>(data.data());
+    sortRunner.radixSort(
+        start,
+        start + numEntries * entrySize,
+        numWords * sizeof(uint64_t),
+        radixBuffer->asMutable<char>());
+
+    for (auto i = 0; i < numEntries; ++i) {
+      ASSERT_EQ(data[i * entryWords + numWords], expected[i]) << i;
+    }
+  };
+
+  testRadixSort(0, 1);
+  testRadixSort(1, 1);
+  testRadixSort(1'000, 1);
+  testRadixSort(10'000, 2);
+  testRadixSort(10'000, 3);
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
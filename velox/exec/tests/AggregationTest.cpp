@@ -811,6 +811,60 @@ TEST_F(AggregationTest, rangeToDistinct) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, denseAccumulators) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    // The last batch widens the key range past the dense accumulator limit.
+    const int16_t numKeys = i == 9 ? 3'000 : 7;
+    batches.push_back(makeRowVector(
+        {"k", "a", "b", "c", "m"},
+        {
+            makeFlatVector<int16_t>(
+                1'000, [&](auto row) { return (row * 3 + i) % numKeys; }),
+            makeFlatVector<int64_t>(
+                1'000, [&](auto row) { return row * i - 500; }, nullEvery(5)),
+            makeFlatVector<double>(
+                1'000, [&](auto row) { return row * 0.25 - i; }, nullEvery(3)),
+            makeConstant<int32_t>(i, 1'000),
+            makeFlatVector<bool>(1'000, [](auto row) { return row % 4 == 0; }),
+        }));
+  }
+  createDuckDbTable(batches);
+
+  const std::vector<std::string> aggregates = {
+      "sum(a)",
+      "count(a)",
+      "min(b)",
+      "max(b)",
+      "sum(c)",
+      "max(a)",
+      "sum(a) filter (where m)",
+      "count(b) filter (where m)",
+  };
+  const auto sql = fmt::format(
+      "SELECT k, {} FROM tmp GROUP BY k", folly::join(", ", aggregates));
+
+  for (const auto& maxGroups : {"0", "1000"}) {
+    SCOPED_TRACE(fmt::format("maxGroups: {}", maxGroups));
+    auto plan = PlanBuilder()
+                    .values(batches)
+                    .singleAggregation({"k"}, aggregates)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kDenseAggregationMaxGroups, maxGroups)
+        .assertResults(sql);
+
+    plan = PlanBuilder()
+               .values(batches)
+               .partialAggregation({"k"}, aggregates)
+               .finalAggregation()
+               .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kDenseAggregationMaxGroups, maxGroups)
+        .assertResults(sql);
+  }
+}
+
 TEST_F(AggregationTest, allKeyTypes) {
   // Covers different key types. Unlike the integer/string tests, the
   // hash table begins life in the generic mode, not array or
@@ -962,6 +1016,42 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationCardinalityEstimation) {
+  // The first 3 batches have only distinct keys, the last 3 have 10 keys.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return i * 1'000 + row; })}));
+  }
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggNodeId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .config(QueryConfig::kAbandonPartialAggregationMinRows, 1'000)
+          .config(QueryConfig::kAbandonPartialAggregationMinPct, 80)
+          .config(QueryConfig::kPartialAggregationCardinalityEstimation, true)
+          .maxDrivers(1)
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .partialAggregation({"c0"}, {"sum(c0)", "count(1)"})
+                    .capturePlanNodeId(aggNodeId)
+                    .finalAggregation()
+                    .planNode())
+          .assertResults("SELECT c0, sum(c0), count(1) FROM tmp GROUP BY 1");
+
+  // Partial aggregation is abandoned after the first batch and resumed on the
+  // first batch with few keys.
+  const auto stats = toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+  EXPECT_EQ(1, stats.at("abandonedPartialAggregation").sum);
+  EXPECT_EQ(1, stats.at("resumedPartialAggregation").sum);
+  EXPECT_EQ(vectors.size(), stats.at("estimatedDistinctKeysPct").count);
+}
+
 TEST_F(AggregationTest, distinctWithGroupingKeysReordered) {
   rowType_ =
       ROW({"c0", "c1", "c2", "c3", "c4"},
@@ -1049,6 +1139,17 @@ TEST_F(AggregationTest, largeValueRangeArray) {
   // then expected to change hash mode and rehash.
   EXPECT_EQ(1, runtimeStats.at("hashtable.numRehashes").count);
 
+  // The accumulated strings of the first batch are attributed to the string
+  // storage of the rows.
+  EXPECT_GE(
+      runtimeStats.at(BaseHashTable::kStringBytes).sum,
+      static_cast<int64_t>(1000 * string1k.size()));
+  EXPECT_EQ(
+      runtimeStats.at(BaseHashTable::kStringBytes).unit,
+      RuntimeCounter::Unit::kBytes);
+  EXPECT_LT(0, runtimeStats.at(BaseHashTable::kRowBytes).sum);
+  EXPECT_LT(0, runtimeStats.at(BaseHashTable::kTableBytes).sum);
+
   // The partial agg is expected to flush just once. The final agg gets one
   // batch.
   EXPECT_EQ(1, stats.at(finalAggId).inputVectors);
@@ -1220,6 +1321,127 @@ TEST_F(AggregationTest, spillAll) {
   }
 }
 
+TEST_F(AggregationTest, spillMergeSingleRowGroups) {
+  // Most keys are in a single batch. Every tenth key is in all batches.
+  std::vector<RowVectorPtr> inputs;
+  for (int32_t batch = 0; batch < 10; ++batch) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              return row % 10 == 0 ? row : batch * 1'000 + row;
+            }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row + batch; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(std::to_string(row % 77));
+            }),
+    }));
+  }
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId aggrNodeId;
+  const auto plan =
+      PlanBuilder()
+          .values(inputs)
+          .singleAggregation({"c0"}, {"sum(c1)", "count(1)", "max(c2)"})
+          .capturePlanNodeId(aggrNodeId)
+          .planNode();
+  const std::string sql =
+      "SELECT c0, sum(c1), count(1), max(c2) FROM tmp GROUP BY 1";
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(tempDirectory->getPath())
+                  .config(QueryConfig::kSpillEnabled, true)
+                  .config(QueryConfig::kAggregationSpillEnabled, true)
+                  .config(QueryConfig::kPreferredOutputBatchRows, "100")
+                  .assertResults(sql);
+  const auto planStats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_GT(planStats.spilledRows, 0);
+  ASSERT_LT(0, planStats.customStats.at("spillMergeSingleRowGroups").sum);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
+TEST_F(AggregationTest, radixPartitioned) {
+  auto inputs = makeVectors(rowType_, 1'000, 10);
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation(
+                      {"c0", "c2"}, {"sum(c1)", "count(1)", "max(c6)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  const std::string sql =
+      "SELECT c0, c2, sum(c1), count(1), max(c6) FROM tmp GROUP BY 1, 2";
+
+  for (int radixPartitionBits : {1, 3, 6}) {
+    SCOPED_TRACE(fmt::format("radixPartitionBits: {}", radixPartitionBits));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            QueryConfig::kAggregationRadixPartitionBits,
+            std::to_string(radixPartitionBits))
+        .assertResults(sql);
+
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(tempDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(
+                        QueryConfig::kAggregationRadixPartitionBits,
+                        std::to_string(radixPartitionBits))
+                    .assertResults(sql);
+    const auto planStats = toPlanStats(task->taskStats()).at(aggrNodeId);
+    ASSERT_GT(planStats.spilledBytes, 0);
+    ASSERT_GT(planStats.spilledRows, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
+TEST_F(AggregationTest, radixPartitionMerge) {
+  // Every driver reads all of 'inputs', so each group is in all drivers.
+  constexpr int32_t kNumDrivers = 4;
+  const auto inputs = makeVectors(rowType_, 1'000, 5);
+  std::vector<RowVectorPtr> allInputs;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    allInputs.insert(allInputs.end(), inputs.begin(), inputs.end());
+  }
+  createDuckDbTable(allInputs);
+
+  core::PlanNodeId aggrNodeId;
+  const auto plan = PlanBuilder()
+                        .values(inputs, true)
+                        .singleAggregation(
+                            {"c0", "c2"}, {"sum(c1)", "count(1)", "max(c6)"})
+                        .capturePlanNodeId(aggrNodeId)
+                        .planNode();
+  const std::string sql =
+      "SELECT c0, c2, sum(c1), count(1), max(c6) FROM tmp GROUP BY 1, 2";
+
+  // Fewer and more partitions than drivers.
+  for (int radixPartitionBits : {1, 4}) {
+    SCOPED_TRACE(fmt::format("radixPartitionBits: {}", radixPartitionBits));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(kNumDrivers)
+            .config(
+                QueryConfig::kAggregationRadixPartitionBits,
+                std::to_string(radixPartitionBits))
+            .config(QueryConfig::kAggregationPartitionMergeEnabled, true)
+            .assertResults(sql);
+    const auto planStats = toPlanStats(task->taskStats()).at(aggrNodeId);
+    ASSERT_EQ(
+        kNumDrivers,
+        planStats.customStats.at("partitionMergeWallNanos").count);
+  }
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1587,6 +1809,109 @@ TEST_F(AggregationTest, groupingSetsEmptyInput) {
       }));
 }
 
+TEST_F(AggregationTest, groupingSetsRollup) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 5; ++i) {
+    data.push_back(makeRowVector(
+        {"k1", "k2", "a", "b"},
+        {
+            makeFlatVector<int64_t>(
+                200, [](auto row) { return row % 7; }, nullEvery(13)),
+            makeFlatVector<int64_t>(
+                200, [i](auto row) { return (row + i) % 5; }, nullEvery(17)),
+            makeFlatVector<int64_t>(200, [i](auto row) { return row * i; }),
+            makeFlatVector<std::string>(
+                200, [](auto row) { return std::string(row % 9, 'x'); }),
+        }));
+  }
+  createDuckDbTable(data);
+
+  const std::vector<std::string> aggregates = {
+      "count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"};
+  const auto usesRollup = [](const std::shared_ptr<Task>& task) {
+    for (const auto& pipeline : task->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType == "GroupingSetsAggregation") {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  struct {
+    std::vector<std::vector<std::string>> groupingSets;
+    std::string groupBy;
+  } testSettings[] = {
+      {{{"k1", "k2"}, {"k1"}, {"k2"}, {}}, "CUBE (k1, k2)"},
+      {{{"k1", "k2"}, {"k1"}, {}}, "ROLLUP (k1, k2)"},
+      {{{"k1"}, {"k2"}}, "GROUPING SETS ((k1), (k2))"},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.groupBy);
+    const auto sql = fmt::format(
+        "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY {}",
+        testData.groupBy);
+
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .groupId({"k1", "k2"}, testData.groupingSets, {"a", "b"})
+                    .singleAggregation({"k1", "k2", "group_id"}, aggregates)
+                    .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(core::QueryConfig::kGroupingSetsRollupEnabled, true)
+                    .assertResults(sql);
+    ASSERT_TRUE(usesRollup(task));
+
+    // A small partial aggregation memory limit makes the partial aggregation
+    // produce the grouping sets several times.
+    plan = PlanBuilder()
+               .values(data)
+               .groupId({"k1", "k2"}, testData.groupingSets, {"a", "b"})
+               .partialAggregation({"k1", "k2", "group_id"}, aggregates)
+               .finalAggregation()
+               .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+               .planNode();
+    task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+               .config(core::QueryConfig::kGroupingSetsRollupEnabled, true)
+               .config(core::QueryConfig::kMaxPartialAggregationMemory, 100)
+               .assertResults(sql);
+    ASSERT_TRUE(usesRollup(task));
+  }
+
+  // An aggregate over a grouping key sees the nulls of the grouping sets
+  // without the key and is computed over GroupId.
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a"})
+                  .singleAggregation({"k1", "k2", "group_id"}, {"count(k1)"})
+                  .project({"k1", "k2", "a0"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kGroupingSetsRollupEnabled, true)
+          .assertResults(
+              "SELECT k1, k2, count(k1) FROM tmp "
+              "GROUP BY GROUPING SETS ((k1), (k2))");
+  ASSERT_FALSE(usesRollup(task));
+
+  // Empty input produces a row for the global grouping set.
+  plan = PlanBuilder()
+             .values(data)
+             .filter("a < 0")
+             .groupId({"k1"}, {{"k1"}, {}}, {"b"})
+             .partialAggregation({"k1", "group_id"}, {"count(b) as count_b"})
+             .finalAggregation()
+             .project({"count_b"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kGroupingSetsRollupEnabled, true)
+      .assertResults(
+          "SELECT count(b) FROM tmp WHERE a < 0 "
+          "GROUP BY GROUPING SETS ((k1), ())");
+}
+
 TEST_F(AggregationTest, disableNonBooleanMasks) {
   auto data = makeRowVector(
       {"c0", "c1"},
@@ -2000,6 +2325,57 @@ TEST_F(AggregationTest, distinctWithSpilling) {
   }
 }
 
+TEST_F(AggregationTest, twoPhaseDistinct) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+        makeFlatVector<int32_t>(
+            1'000, [](auto row) { return row % 7; }, nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggrNodeId;
+  const auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation(
+              {"c0"}, {"count(DISTINCT c1)", "sum(DISTINCT c1)"}, {})
+          .capturePlanNodeId(aggrNodeId)
+          .planNode();
+  const std::string sql =
+      "SELECT c0, count(DISTINCT c1), sum(DISTINCT c1) FROM tmp GROUP BY 1";
+
+  // The first batch has 300 groups.
+  for (const auto& [minGroups, twoPhase] :
+       std::vector<std::pair<int32_t, bool>>{{100, true}, {1'000, false}}) {
+    SCOPED_TRACE(fmt::format("minGroups: {}", minGroups));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        QueryConfig::kTwoPhaseDistinctAggregationMinGroups,
+                        std::to_string(minGroups))
+                    .assertResults(sql);
+    const auto planStats = toPlanStats(task->taskStats()).at(aggrNodeId);
+    ASSERT_EQ(
+        planStats.customStats.count("twoPhaseDistinctAggregation"),
+        twoPhase ? 1 : 0);
+  }
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->getPath())
+                  .config(QueryConfig::kSpillEnabled, true)
+                  .config(QueryConfig::kAggregationSpillEnabled, true)
+                  .config(QueryConfig::kTwoPhaseDistinctAggregationMinGroups, 1)
+                  .assertResults(sql);
+  const auto planStats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_EQ(planStats.customStats.count("twoPhaseDistinctAggregation"), 1);
+  ASSERT_GT(planStats.spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
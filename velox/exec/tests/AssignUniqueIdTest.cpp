@@ -67,7 +67,15 @@ class AssignUniqueIdTest : public OperatorTestBase {
     // ID vector. Memory should be allocated when producing first batch of
     // output and re-used for subsequent batches.
     auto stats = toPlanStats(task->taskStats());
-    ASSERT_EQ(1, stats.at(uniqueNodeId_).numMemoryAllocations);
+    const auto& nodeStats = stats.at(uniqueNodeId_);
+    ASSERT_EQ(1, nodeStats.numMemoryAllocations);
+    ASSERT_EQ(
+        1, nodeStats.customStats.at(Operator::kOutputVectorAllocations).sum);
+    if (result.second.size() > 1) {
+      ASSERT_EQ(
+          result.second.size() - 1,
+          nodeStats.customStats.at(Operator::kOutputVectorReuses).sum);
+    }
   }
 
   core::PlanNodeId uniqueNodeId_;
@@ -138,6 +146,11 @@ TEST_F(AssignUniqueIdTest, multiThread) {
     // output and re-used for subsequent batches.
     auto stats = toPlanStats(task->taskStats());
     ASSERT_EQ(8, stats.at(uniqueNodeId_).numMemoryAllocations);
+    ASSERT_EQ(
+        8,
+        stats.at(uniqueNodeId_)
+            .customStats.at(Operator::kOutputVectorAllocations)
+            .sum);
   }
 }
 
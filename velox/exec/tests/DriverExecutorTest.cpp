@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class DriverExecutorTest : public OperatorTestBase {
+ protected:
+  static uint64_t sum(
+      const std::vector<DriverExecutor::QueueStats>& stats,
+      uint64_t DriverExecutor::QueueStats::*counter) {
+    uint64_t total = 0;
+    for (const auto& queueStats : stats) {
+      total += queueStats.*counter;
+    }
+    return total;
+  }
+};
+
+TEST_F(DriverExecutorTest, numaNodeCpus) {
+  const auto nodes = DriverExecutor::numaNodeCpus();
+  ASSERT_FALSE(nodes.empty());
+  for (const auto& cpus : nodes) {
+    ASSERT_FALSE(cpus.empty());
+  }
+}
+
+TEST_F(DriverExecutorTest, runTasks) {
+  std::atomic_int32_t numRun{0};
+  constexpr int32_t kNumTasks = 1'000;
+  {
+    DriverExecutor executor({.numThreads = 4});
+    ASSERT_EQ(executor.numThreads(), 4);
+    for (auto i = 0; i < kNumTasks; ++i) {
+      if (i % 2 == 0) {
+        executor.add([&]() { ++numRun; });
+      } else {
+        executor.add([&]() { ++numRun; }, i);
+      }
+    }
+    // A task adding a task from a worker thread.
+    executor.add([&]() { executor.add([&]() { ++numRun; }); });
+  }
+  ASSERT_EQ(numRun, kNumTasks + 1);
+}
+
+TEST_F(DriverExecutorTest, workStealing) {
+  DriverExecutor executor({.numThreads = 4});
+  folly::Baton<> release;
+  std::atomic_int32_t numRun{0};
+  constexpr int32_t kNumTasks = 100;
+  // Blocks one worker and queues more tasks behind it on the same worker. The
+  // other workers steal them.
+  executor.add([&]() {
+    for (auto i = 0; i < kNumTasks; ++i) {
+      executor.add([&]() { ++numRun; });
+    }
+    release.wait();
+  });
+  while (numRun < kNumTasks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  release.post();
+  while (sum(executor.stats(), &DriverExecutor::QueueStats::numTasks) <
+         kNumTasks + 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto stats = executor.stats();
+  ASSERT_EQ(stats.size(), 4);
+  ASSERT_GE(sum(stats, &DriverExecutor::QueueStats::numSteals), kNumTasks);
+  ASSERT_GT(sum(stats, &DriverExecutor::QueueStats::numIdleWaits), 0);
+  for (const auto& queueStats : stats) {
+    ASSERT_LT(queueStats.numaNode, executor.numNumaNodes());
+  }
+}
+
+TEST_F(DriverExecutorTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data, data, data});
+
+  DriverExecutor executor({.numThreads = 4});
+  auto queryCtx = core::QueryCtx::create(&executor);
+  auto plan = PlanBuilder()
+                  .values({data, data, data}, true)
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(queryCtx)
+      .maxDrivers(4)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+  ASSERT_GT(
+      sum(executor.stats(), &DriverExecutor::QueueStats::numTasks), 0);
+}
+
+} // namespace
@@ -227,6 +227,7 @@ TEST_P(ExchangeClientTest, stats) {
   ASSERT_GE(totalBytes, stats.at("peakBytes").sum);
   ASSERT_EQ(data.size(), stats.at("numReceivedPages").sum);
   ASSERT_EQ(totalBytes / data.size(), stats.at("averageReceivedPageBytes").sum);
+  ASSERT_EQ(1, stats.count("queueStallWallNanos"));
 
   task->requestCancel();
   bufferManager_->removeTask(taskId);
@@ -328,6 +329,40 @@ TEST_P(ExchangeClientTest, smallPage) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, queueStallTime) {
+  auto client = std::make_shared<ExchangeClient>(
+      "test", 17, 1 << 20, 1, 1, pool(), executor());
+  const auto& queue = client->queue();
+  addSources(*queue, 1);
+  auto stallTimeUs = [&]() {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    return queue->stallTimeUsLocked();
+  };
+  ASSERT_EQ(0, stallTimeUs());
+
+  bool atEnd;
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto pages = client->next(1, 1, &atEnd, &future);
+  ASSERT_TRUE(pages.empty());
+  ASSERT_TRUE(future.valid());
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // The current wait is included.
+  ASSERT_GE(stallTimeUs(), 10'000);
+
+  enqueue(*queue, makePage(1'000));
+  ASSERT_TRUE(future.isReady());
+  const auto stalledUs = stallTimeUs();
+  ASSERT_GE(stalledUs, 10'000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // No consumer is waiting.
+  ASSERT_EQ(stalledUs, stallTimeUs());
+
+  pages = client->next(1, 1, &atEnd, &future);
+  ASSERT_EQ(1, pages.size());
+  enqueue(*queue, nullptr);
+  client->close();
+}
+
 TEST_P(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
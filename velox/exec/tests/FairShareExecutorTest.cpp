@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareExecutor.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class FairShareExecutorTest : public OperatorTestBase {
+ protected:
+  std::shared_ptr<core::QueryCtx> makeQueryCtx(
+      folly::Executor* executor,
+      uint32_t cpuShares) {
+    return core::QueryCtx::create(
+        executor,
+        core::QueryConfig(
+            {{core::QueryConfig::kQueryCpuShares,
+              std::to_string(cpuShares)}}));
+  }
+
+  // Queues 'numTasks' tasks for each of 'queryCtxs' behind a task that blocks
+  // the only thread of 'executor'. Returns the query index of the tasks in the
+  // order they ran.
+  static std::vector<int32_t> runBlocked(
+      FairShareExecutor& executor,
+      const std::vector<std::shared_ptr<core::QueryCtx>>& queryCtxs,
+      int32_t numTasks) {
+    folly::Baton<> release;
+    executor.add([&]() { release.wait(); });
+    std::mutex mutex;
+    std::vector<int32_t> order;
+    for (auto i = 0; i < numTasks; ++i) {
+      for (auto query = 0; query < queryCtxs.size(); ++query) {
+        executor.add(
+            [&, query]() {
+              std::this_thread::sleep_for(std::chrono::milliseconds(2));
+              std::lock_guard<std::mutex> l(mutex);
+              order.push_back(query);
+            },
+            queryCtxs[query]);
+      }
+    }
+    EXPECT_EQ(executor.numQueued(), numTasks * queryCtxs.size());
+    release.post();
+    while (executor.numQueued() > 0 || executor.numRunning() > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return order;
+  }
+};
+
+TEST_F(FairShareExecutorTest, cpuShares) {
+  folly::CPUThreadPoolExecutor threads(1);
+  FairShareExecutor executor(&threads, 1);
+  const std::vector<std::shared_ptr<core::QueryCtx>> queryCtxs = {
+      makeQueryCtx(&executor, 1), makeQueryCtx(&executor, 3)};
+  const auto order = runBlocked(executor, queryCtxs, 20);
+  ASSERT_EQ(order.size(), 40);
+
+  // The query with 3 shares runs 3 of 4 tasks while both have tasks.
+  const auto numRuns = std::count(order.begin(), order.begin() + 16, 1);
+  ASSERT_GE(numRuns, 11);
+  ASSERT_LE(numRuns, 13);
+
+  for (const auto& queryCtx : queryCtxs) {
+    const auto stats = queryCtx->schedulingStats().copy();
+    ASSERT_EQ(stats.numRuns, 20);
+    ASSERT_GE(stats.runNanos, 20 * 2'000'000);
+    ASSERT_GT(stats.queuedNanos, 0);
+    // The virtual runtime is added up per run.
+    const auto shares = queryCtx->queryConfig().queryCpuShares();
+    ASSERT_LE(stats.virtualRuntimeNanos, stats.runNanos / shares);
+    ASSERT_GE(stats.virtualRuntimeNanos, stats.runNanos / shares - 20);
+  }
+}
+
+TEST_F(FairShareExecutorTest, noCreditWhenIdle) {
+  folly::CPUThreadPoolExecutor threads(1);
+  FairShareExecutor executor(&threads, 1);
+  auto busyQueryCtx = makeQueryCtx(&executor, 1);
+  runBlocked(executor, {busyQueryCtx}, 10);
+
+  // A query that was idle does not run all its tasks before the busy query.
+  auto newQueryCtx = makeQueryCtx(&executor, 1);
+  const auto order = runBlocked(executor, {busyQueryCtx, newQueryCtx}, 5);
+  ASSERT_EQ(order.size(), 10);
+  ASSERT_NE(
+      std::find(order.begin(), order.begin() + 3, 0), order.begin() + 3);
+}
+
+TEST_F(FairShareExecutorTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data, data, data});
+
+  folly::CPUThreadPoolExecutor threads(4);
+  FairShareExecutor executor(&threads, 4);
+  auto queryCtx = makeQueryCtx(&executor, 2);
+  auto plan = PlanBuilder()
+                  .values({data, data, data}, true)
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(queryCtx)
+      .maxDrivers(4)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+  const auto stats = queryCtx->schedulingStats().copy();
+  ASSERT_GT(stats.numRuns, 0);
+  ASSERT_GT(stats.runNanos, 0);
+}
+
+} // namespace
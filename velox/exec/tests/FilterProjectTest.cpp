@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/FilterProject.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -406,3 +407,87 @@ TEST_F(FilterProjectTest, statsSplitter) {
   EXPECT_EQ(projectStats.outputRows, 25);
   EXPECT_EQ(projectStats.outputVectors, 4);
 }
+
+TEST_F(FilterProjectTest, conjunctsOverLazy) {
+  vector_size_t size = 1'000;
+  auto valueAtC0 = [](auto row) -> int32_t { return row; };
+  auto valueAtC1 = [](auto row) -> int64_t { return row % 7 - 3; };
+  // The lazy vectors fill the rows that are not loaded with garbage. The
+  // filter output is correct only if c1 is loaded for the rows that pass,
+  // although it is not preloaded for the identity projection.
+  auto lazyVectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAtC0),
+      vectorMaker_.lazyFlatVector<int64_t>(size, valueAtC1),
+  });
+  auto vectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAtC0),
+      makeFlatVector<int64_t>(size, valueAtC1),
+  });
+  createDuckDbTable({vectors});
+
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values({lazyVectors})
+                  .filter("c0 % 3 = 0 and c1 > 0")
+                  .capturePlanNodeId(filterId)
+                  .planNode();
+  auto task =
+      assertQuery(plan, "SELECT * FROM tmp WHERE c0 % 3 = 0 AND c1 > 0");
+
+  const auto& customStats =
+      toPlanStats(task->taskStats()).at(filterId).customStats;
+  ASSERT_EQ(customStats.count(FilterProject::kFilterConjunctReorders), 1);
+  std::vector<int64_t> order;
+  for (auto i = 0; i < 2; ++i) {
+    order.push_back(
+        customStats
+            .at(fmt::format("{}{}", FilterProject::kFilterConjunctOrder, i))
+            .sum);
+  }
+  std::sort(order.begin(), order.end());
+  ASSERT_EQ(order, (std::vector<int64_t>{0, 1}));
+}
+
+TEST_F(FilterProjectTest, prefetchLazyColumns) {
+  vector_size_t size = 1'000;
+  auto valueAtC0 = [](auto row) -> int32_t { return row; };
+  auto valueAtC1 = [](auto row) -> int64_t { return row % 7; };
+  auto valueAtC2 = [](auto row) -> int64_t { return row * 3; };
+  // c2 is only an identity projection, so it is loaded on the executor for
+  // the rows that pass while c0 + c1 is computed.
+  auto makeInput = [&](bool lazy) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(size, valueAtC0),
+        lazy ? vectorMaker_.lazyFlatVector<int64_t>(size, valueAtC1)
+             : makeFlatVector<int64_t>(size, valueAtC1),
+        lazy ? vectorMaker_.lazyFlatVector<int64_t>(size, valueAtC2)
+             : makeFlatVector<int64_t>(size, valueAtC2),
+    });
+  };
+  createDuckDbTable({makeInput(false)});
+
+  for (bool prefetch : {false, true}) {
+    SCOPED_TRACE(fmt::format("prefetch: {}", prefetch));
+    core::PlanNodeId projectId;
+    auto plan = PlanBuilder()
+                    .values({makeInput(true)})
+                    .filter("c0 % 3 = 0")
+                    .project({"c0 + c1", "c2"})
+                    .capturePlanNodeId(projectId)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kFilterProjectPrefetchLazyColumns,
+                prefetch ? "true" : "false")
+            .assertResults("SELECT c0 + c1, c2 FROM tmp WHERE c0 % 3 = 0");
+
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(projectId).customStats;
+    if (prefetch) {
+      ASSERT_EQ(customStats.at(FilterProject::kPrefetchedLazyColumns).sum, 1);
+    } else {
+      ASSERT_EQ(customStats.count(FilterProject::kPrefetchedLazyColumns), 0);
+    }
+  }
+}
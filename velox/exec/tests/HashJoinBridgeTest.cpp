@@ -563,6 +563,58 @@ TEST_P(HashJoinBridgeTest, multiThreading) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, mergedSpillRestore) {
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+
+  SpillPartitionSet partitionSet;
+  for (int32_t partition = 0; partition < 3; ++partition) {
+    const SpillPartitionId id(partition);
+    partitionSet.emplace(
+        id,
+        std::make_unique<SpillPartition>(
+            id, makeFakeSpillFiles(numSpillFilesPerPartition_)));
+  }
+  const uint64_t partitionSize = partitionSet.begin()->second->size();
+  joinBridge->setHashTable(
+      createFakeHashTable(), std::move(partitionSet), false, nullptr);
+
+  auto futures = createEmptyFutures(numBuilders_);
+  ASSERT_TRUE(joinBridge->tableOrFuture(&futures[0]).has_value());
+
+  // Restores the first two partitions together and then the last one alone.
+  struct {
+    SpillPartitionId restoredId;
+    SpillPartitionIdSet mergedIds;
+  } expectedRounds[] = {
+      {SpillPartitionId(0), {SpillPartitionId(1)}},
+      {SpillPartitionId(2), {}}};
+  for (const auto& expected : expectedRounds) {
+    ASSERT_TRUE(joinBridge->probeFinished(2 * partitionSize));
+    size_t numFiles{0};
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      auto inputOr = joinBridge->spillInputOrFuture(&futures[i]);
+      ASSERT_TRUE(inputOr.has_value());
+      ASSERT_EQ(inputOr->spillPartition->id(), expected.restoredId);
+      ASSERT_EQ(inputOr->merged, !expected.mergedIds.empty());
+      numFiles += inputOr->spillPartition->numFiles();
+    }
+    ASSERT_EQ(
+        numFiles,
+        numSpillFilesPerPartition_ * (1 + expected.mergedIds.size()));
+
+    joinBridge->setHashTable(createFakeHashTable(), {}, false, nullptr);
+    auto tableOr = joinBridge->tableOrFuture(&futures[0]);
+    ASSERT_TRUE(tableOr.has_value());
+    ASSERT_EQ(tableOr->restoredPartitionId, expected.restoredId);
+    ASSERT_EQ(tableOr->mergedPartitionIds, expected.mergedIds);
+  }
+  ASSERT_FALSE(joinBridge->probeFinished(2 * partitionSize));
+}
+
 TEST_P(HashJoinBridgeTest, isHashJoinMemoryPools) {
   auto root = memory::memoryManager()->addRootPool("isHashBuildMemoryPool");
   struct {
@@ -592,6 +644,86 @@ TEST_P(HashJoinBridgeTest, isHashJoinMemoryPools) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, sharedHashJoinTable) {
+  auto queryPool =
+      memory::memoryManager()->addRootPool("sharedHashJoinTable");
+  auto& registry = SharedHashJoinTableRegistry::instance();
+  const auto numTables = registry.numTables();
+  auto makeTable = [&](memory::MemoryPool* pool) {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    keyHashers.emplace_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    return HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, 1'000, pool);
+  };
+
+  // The first task to ask builds the table and the others wait for it.
+  auto sharedTable = registry.getOrCreate("query", "0", queryPool.get());
+  ASSERT_EQ(sharedTable, registry.getOrCreate("query", "0", queryPool.get()));
+  ASSERT_NE(sharedTable, registry.getOrCreate("query", "1", queryPool.get()));
+  ASSERT_NE(sharedTable, registry.getOrCreate("query2", "0", queryPool.get()));
+  ASSERT_EQ(registry.numTables(), numTables + 1);
+  ASSERT_EQ(sharedTable->pool()->parent(), queryPool.get());
+
+  std::optional<SharedHashJoinTable::Table> table;
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(sharedTable->shouldBuild("task1", table, &future));
+  ASSERT_TRUE(sharedTable->shouldBuild("task1", table, &future));
+  ASSERT_FALSE(future.valid());
+  ASSERT_FALSE(sharedTable->shouldBuild("task2", table, &future));
+  ASSERT_FALSE(table.has_value());
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+
+  auto builtTable = sharedTable->setTable(
+      "task1", makeTable(sharedTable->pool()), /*hasNullKeys=*/false);
+  ASSERT_NE(builtTable, nullptr);
+  ASSERT_TRUE(future.isReady());
+  future = ContinueFuture::makeEmpty();
+  ASSERT_FALSE(sharedTable->shouldBuild("task2", table, &future));
+  ASSERT_FALSE(future.valid());
+  ASSERT_TRUE(table.has_value());
+  ASSERT_EQ(table->table, builtTable);
+  ASSERT_FALSE(table->hasNullKeys);
+  sharedTable->closeBuild("task1");
+
+  // The table outlives the shared table and keeps its pool alive.
+  sharedTable.reset();
+  ASSERT_EQ(registry.numTables(), numTables);
+  ASSERT_EQ(queryPool->getChildCount(), 1);
+  table.reset();
+  builtTable.reset();
+  ASSERT_EQ(queryPool->getChildCount(), 0);
+
+  // A waiting task builds the table if the building task closes first.
+  sharedTable = registry.getOrCreate("query", "0", queryPool.get());
+  ASSERT_TRUE(sharedTable->shouldBuild("task1", table, &future));
+  ASSERT_FALSE(sharedTable->shouldBuild("task2", table, &future));
+  ASSERT_TRUE(future.valid());
+  sharedTable->closeBuild("task2");
+  ASSERT_FALSE(future.isReady());
+  sharedTable->closeBuild("task1");
+  ASSERT_TRUE(future.isReady());
+  future = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(sharedTable->shouldBuild("task2", table, &future));
+  ASSERT_FALSE(sharedTable->shouldBuild("task3", table, &future));
+  ASSERT_TRUE(future.valid());
+
+  // A task builds a new table if the previous one has been released.
+  builtTable = sharedTable->setTable(
+      "task2", makeTable(sharedTable->pool()), /*hasNullKeys=*/false);
+  builtTable.reset();
+  future = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(sharedTable->shouldBuild("task3", table, &future));
+  ASSERT_FALSE(table.has_value());
+
+  // A null-aware anti join with null keys has no table.
+  sharedTable->setTable("task3", nullptr, /*hasNullKeys=*/true);
+  ASSERT_FALSE(sharedTable->shouldBuild("task4", table, &future));
+  ASSERT_TRUE(table.has_value());
+  ASSERT_EQ(table->table, nullptr);
+  ASSERT_TRUE(table->hasNullKeys);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     HashJoinBridgeTest,
     HashJoinBridgeTest,
@@ -18,6 +18,7 @@
 
 #include <fmt/format.h>
 #include "folly/experimental/EventCount.h"
+#include "folly/hash/Hash.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
@@ -4540,6 +4541,145 @@ TEST_F(HashJoinTest, dynamicFiltersAppliedToPreloadedSplits) {
       .run();
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  // More than VectorHasher::kMaxDistinct keys spread over the whole bigint
+  // range, so that the table is in hash mode and there is no range or IN-list
+  // filter for the key.
+  const vector_size_t numBuildRows = 110'000;
+  auto keyAt = [](auto row) {
+    return static_cast<int64_t>(folly::hash::twang_mix64(row));
+  };
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(numBuildRows, keyAt)})};
+
+  // A probe row matches every tenth build row.
+  const vector_size_t numProbeRows = 10'000;
+  std::vector<RowVectorPtr> probeVectors{makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(
+           numProbeRows,
+           [&](auto row) {
+             return row % 10 == 0 ? keyAt(row) : keyAt(numBuildRows + row);
+           }),
+       makeFlatVector<int64_t>(numProbeRows, folly::identity)})};
+  auto probeFile = TempFilePath::create();
+  writeToFile(probeFile->getPath(), probeVectors);
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId scanNodeId;
+  core::PlanNodeId joinNodeId;
+  auto op = PlanBuilder(planNodeIdGenerator)
+                .tableScan(asRowType(probeVectors[0]->type()))
+                .capturePlanNodeId(scanNodeId)
+                .hashJoin(
+                    {"c0"},
+                    {"u0"},
+                    PlanBuilder(planNodeIdGenerator)
+                        .values(buildVectors)
+                        .planNode(),
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinNodeId)
+                .planNode();
+
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            enabled ? "1000000" : "0")
+        .inputSplits(
+            {{scanNodeId,
+              {Split(makeHiveConnectorSplit(probeFile->getPath()))}}})
+        .injectSpill(false)
+        .checkSpillStats(false)
+        .referenceQuery("SELECT c0, c1 FROM t, u WHERE c0 = u0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          const auto& joinStats = planStats.at(joinNodeId).customStats;
+          if (!enabled) {
+            ASSERT_EQ(0, joinStats.count("bloomFilterDynamicFilters"));
+            ASSERT_EQ(0, joinStats.count("dynamicFiltersProduced"));
+            return;
+          }
+          ASSERT_EQ(1, joinStats.at("bloomFilterDynamicFilters").sum);
+          ASSERT_EQ(1, joinStats.at("dynamicFiltersProduced").sum);
+          ASSERT_EQ(
+              1, getFiltersAccepted(task, getOperatorIndex(scanNodeId)).sum);
+          // The scan drops most of the rows that do not match.
+          ASSERT_LT(
+              getInputPositions(task, getOperatorIndex(joinNodeId)),
+              numProbeRows / 2);
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, shareBroadcastBuild) {
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+       makeFlatVector<int64_t>(1'000, folly::identity)})};
+  std::vector<RowVectorPtr> probeVectors{makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>(2'000, [](auto row) { return row % 500; }),
+       makeFlatVector<int64_t>(2'000, folly::identity)})};
+
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kLeftSemiFilter,
+        core::JoinType::kAnti}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    const bool semiOrAnti = joinType == core::JoinType::kLeftSemiFilter ||
+        joinType == core::JoinType::kAnti;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto buildSide =
+        PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        buildSide,
+                        "",
+                        semiOrAnti
+                            ? std::vector<std::string>{"t0", "t1"}
+                            : std::vector<std::string>{"t0", "t1", "u1"},
+                        joinType)
+                    .planNode();
+    const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+    // Run the tasks of one query concurrently. Whichever task gets to the join
+    // first builds the table for the others.
+    auto queryCtx = core::QueryCtx::create(
+        driverExecutor_.get(),
+        core::QueryConfig(
+            {{core::QueryConfig::kHashJoinShareBroadcastBuild, "true"}}),
+        {},
+        cache::AsyncDataCache::getInstance(),
+        nullptr,
+        nullptr,
+        "shareBroadcastBuild");
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i) {
+      threads.emplace_back([&]() {
+        AssertQueryBuilder(plan).queryCtx(queryCtx).assertResults(expected);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    waitForAllTasksToBeDeleted();
+    ASSERT_EQ(SharedHashJoinTableRegistry::instance().numTables(), 0);
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersPushDownThroughAgg) {
   const int32_t numRowsProbe = 300;
   const int32_t numRowsBuild = 100;
@@ -7768,6 +7908,105 @@ TEST_F(HashJoinTest, nanKeys) {
   facebook::velox::test::assertEqualVectors(expected, result);
 }
 
+TEST_F(HashJoinTest, filterFusion) {
+  auto probeInput = makeRowVector(
+      {"t0", "t1"},
+      {
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row % 23; }),
+          makeFlatVector<int64_t>(
+              1'000, [](auto row) { return row; }, nullEvery(7)),
+      });
+  auto buildInput = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(100, [](auto row) { return row % 31; }),
+          makeFlatVector<int64_t>(
+              100, [](auto row) { return row * 3; }, nullEvery(11)),
+      });
+  createDuckDbTable("t", {probeInput});
+  createDuckDbTable("u", {buildInput});
+
+  const auto numOperators = [](const std::shared_ptr<Task>& task,
+                               const std::string& operatorType) {
+    int32_t count = 0;
+    for (const auto& pipeline : task->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        count += op.operatorType == operatorType;
+      }
+    }
+    return count;
+  };
+
+  for (const auto& joinFilter : {"", "t1 < u1 + 100"}) {
+    SCOPED_TRACE(fmt::format("joinFilter: {}", joinFilter));
+    const std::string joinSql = fmt::format(
+        "FROM t, u WHERE t0 = u0{}{} AND (t1 + u1) % 3 = 1",
+        strlen(joinFilter) > 0 ? " AND " : "",
+        joinFilter);
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probeInput})
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({buildInput})
+                            .planNode(),
+                        joinFilter,
+                        {"t0", "t1", "u1"})
+                    .filter("(t1 + u1) % 3 = 1")
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kHashProbeFilterFusionEnabled, true)
+            .assertResults("SELECT t0, t1, u1 " + joinSql);
+    ASSERT_EQ(numOperators(task, "FilterProject"), 0);
+
+    // The projection after the filter remains.
+    plan = PlanBuilder(planNodeIdGenerator)
+               .values({probeInput})
+               .hashJoin(
+                   {"t0"},
+                   {"u0"},
+                   PlanBuilder(planNodeIdGenerator)
+                       .values({buildInput})
+                       .planNode(),
+                   joinFilter,
+                   {"t0", "t1", "u1"})
+               .filter("(t1 + u1) % 3 = 1")
+               .project({"t0", "t1 * u1 AS p"})
+               .planNode();
+    task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+               .config(core::QueryConfig::kHashProbeFilterFusionEnabled, true)
+               .assertResults("SELECT t0, t1 * u1 " + joinSql);
+    ASSERT_EQ(numOperators(task, "FilterProject"), 1);
+  }
+
+  // A filter after a left join is not part of the join condition.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probeInput})
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({buildInput})
+                          .planNode(),
+                      "",
+                      {"t0", "t1", "u1"},
+                      core::JoinType::kLeft)
+                  .filter("u1 IS NULL")
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kHashProbeFilterFusionEnabled, true)
+          .assertResults(
+              "SELECT t0, t1, u1 FROM t LEFT JOIN u ON t0 = u0 "
+              "WHERE u1 IS NULL");
+  ASSERT_EQ(numOperators(task, "FilterProject"), 1);
+}
+
 DEBUG_ONLY_TEST_F(HashJoinTest, spillOnBlockedProbe) {
   auto blockedOperatorFactoryUniquePtr =
       std::make_unique<BlockedOperatorFactory>();
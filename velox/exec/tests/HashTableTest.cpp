@@ -138,12 +138,23 @@ class HashTableTest : public testing::TestWithParam<bool>,
       }
       auto table = HashTable<true>::createForJoin(
           std::move(keyHashers), dependentTypes, true, false, 1'000, pool());
+      if (keyRowsMinKeys_.has_value()) {
+        table->setJoinKeyRows(keyRowsMinKeys_.value());
+      }
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
       sequence += size;
       if (topTable_ == nullptr) {
         topTable_ = std::move(table);
+        if (groupPrefetchProbeMinBytes_.has_value()) {
+          topTable_->setGroupPrefetchProbeMinBytes(
+              groupPrefetchProbeMinBytes_.value());
+        }
+        if (probePartitionBytes_.has_value()) {
+          topTable_->setJoinProbePartitioning(
+              true, probePartitionBytes_.value());
+        }
         numRows += topTable_->rows()->numRows();
       } else {
         numRows += table->rows()->numRows();
@@ -395,6 +406,12 @@ class HashTableTest : public testing::TestWithParam<bool>,
             [&](vector_size_t row) { return keySpacing_ * (sequence + row); },
             nullptr);
 
+      case TypeKind::INTEGER:
+        return makeFlatVector<int32_t>(
+            size,
+            [&](vector_size_t row) { return keySpacing_ * (sequence + row); },
+            nullptr);
+
       case TypeKind::VARCHAR: {
         auto strings =
             BaseVector::create<FlatVector<StringView>>(VARCHAR(), size, pool());
@@ -467,6 +484,23 @@ class HashTableTest : public testing::TestWithParam<bool>,
       const auto& batch = batches_[batchIndex];
       lookup->reset(batch->size());
       rows.setAll();
+      if (topTable_->keyRowSize() > 0) {
+        // The probe keys are laid out as rows by the table.
+        {
+          SelectivityTimer timer(hashTime, 0);
+          topTable_->prepareForJoinProbe(*lookup, batch, rows, true);
+        }
+        const auto startOffset = batchIndex * batchSize;
+        {
+          SelectivityTimer timer(probeTime, 0);
+          topTable_->joinProbe(*lookup);
+        }
+        for (auto i = 0; i < lookup->rows.size(); ++i) {
+          const auto key = lookup->rows[i];
+          ASSERT_EQ(rowOfKey_[startOffset + key], lookup->hits[key]);
+        }
+        continue;
+      }
       {
         SelectivityTimer timer(hashTime, 0);
         for (auto i = 0; i < hashers.size(); ++i) {
@@ -588,6 +622,14 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // If set, overrides the table size from which joinProbe has many rows in
+  // flight.
+  std::optional<uint64_t> groupPrefetchProbeMinBytes_;
+  // If set, joinProbe partitions the probe input for this many bytes of
+  // table per partition.
+  std::optional<uint64_t> probePartitionBytes_;
+  // If set, the tables are made with setJoinKeyRows() of this.
+  std::optional<int32_t> keyRowsMinKeys_;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -640,6 +682,68 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, int5SparseKeyRows) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5"},
+          {BIGINT(), INTEGER(), BIGINT(), INTEGER(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 70;
+  keyRowsMinKeys_ = 4;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 5);
+  ASSERT_EQ(topTable_->keyRowSize(), 32);
+}
+
+TEST_P(HashTableTest, keyRowsNotApplicable) {
+  auto makeTable = [&](const std::vector<TypePtr>& keyTypes) {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    for (auto i = 0; i < keyTypes.size(); ++i) {
+      keyHashers.emplace_back(std::make_unique<VectorHasher>(keyTypes[i], i));
+    }
+    return HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, 1'000, pool());
+  };
+  auto table = makeTable({BIGINT(), SMALLINT(), BOOLEAN(), TIMESTAMP()});
+  table->setJoinKeyRows(4);
+  ASSERT_EQ(table->keyRowSize(), 8 + 2 + 1 + 16);
+  // Too few keys.
+  table->setJoinKeyRows(5);
+  ASSERT_EQ(table->keyRowSize(), 0);
+  table->setJoinKeyRows(0);
+  ASSERT_EQ(table->keyRowSize(), 0);
+  // Equal doubles can have different bytes.
+  table = makeTable({BIGINT(), DOUBLE(), BIGINT()});
+  table->setJoinKeyRows(2);
+  ASSERT_EQ(table->keyRowSize(), 0);
+  table = makeTable({BIGINT(), VARCHAR(), BIGINT()});
+  table->setJoinKeyRows(2);
+  ASSERT_EQ(table->keyRowSize(), 0);
+}
+
+TEST_P(HashTableTest, groupPrefetchJoinProbe) {
+  auto type = ROW({"key"}, {ROW({"k1", "k2"}, {BIGINT(), VARCHAR()})});
+  keySpacing_ = 1000;
+  insertPct_ = 70;
+  groupPrefetchProbeMinBytes_ = 0;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 1);
+}
+
+TEST_P(HashTableTest, partitionedJoinProbe) {
+  auto type = ROW({"key"}, {ROW({"k1", "k2"}, {BIGINT(), VARCHAR()})});
+  keySpacing_ = 1000;
+  insertPct_ = 70;
+  // 64KB of table per partition gives tens of partitions.
+  probePartitionBytes_ = 64 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 1);
+}
+
+TEST_P(HashTableTest, partitionedJoinProbeMaxPartitions) {
+  auto type = ROW({"key"}, {ROW({"k1", "k2"}, {BIGINT(), VARCHAR()})});
+  keySpacing_ = 1000;
+  // More partitions than HashTable::kMaxProbePartitionBits allows.
+  probePartitionBytes_ = 64;
+  testCycle(BaseHashTable::HashMode::kHash, 10000, 2, type, 1);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clearBeforeInsert) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -960,6 +1064,58 @@ TEST_P(HashTableTest, listJoinResultsSize) {
   }
 }
 
+TEST_P(HashTableTest, hotKey) {
+  // Every other row has key 7, the others have distinct keys.
+  constexpr int32_t kNumRows = 2 * BaseHashTable::kHotKeyMinRows + 100;
+  const std::string payload(100, 'x');
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows,
+          [](auto row) { return row % 2 == 0 ? 7 : 1'000 + row; }),
+      makeFlatVector<StringView>(
+          kNumRows, [&](auto /*row*/) { return StringView(payload); }),
+  });
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  auto table = HashTable<true>::createForJoin(
+      std::move(hashers), {VARCHAR()}, true, false, 1'000, pool());
+  copyVectorsToTable({batch}, 0, table.get());
+  table->prepareJoinTable(
+      {}, BaseHashTable::kNoSpillInputStartPartitionBit, executor_.get());
+  ASSERT_EQ(table->stats().numHotKeys, 1);
+
+  HashLookup lookup(table->hashers(), pool());
+  auto probe = makeRowVector({makeFlatVector<int64_t>({7})});
+  SelectivityVector probeRows(1);
+  table->prepareForJoinProbe(lookup, probe, probeRows, true);
+  table->joinProbe(lookup);
+  ASSERT_NE(lookup.hits[0], nullptr);
+
+  std::vector<vector_size_t> inputRows(kNumRows);
+  std::vector<char*> outputRows(kNumRows);
+  for (const auto& estimatedRowSize :
+       {std::optional<uint64_t>(std::nullopt), std::optional<uint64_t>(116)}) {
+    BaseHashTable::JoinResultIterator iter({1}, 16, estimatedRowSize);
+    iter.reset(lookup);
+    int32_t numBatches = 0;
+    int32_t numResults = 0;
+    while (!iter.atEnd()) {
+      const auto numOut = table->listJoinResults(
+          iter,
+          false,
+          folly::Range(inputRows.data(), inputRows.size()),
+          folly::Range(outputRows.data(), outputRows.size()),
+          100 << 10);
+      // 100KB of rows of 116 bytes.
+      ASSERT_LE(numOut, 883);
+      numResults += numOut;
+      ++numBatches;
+    }
+    ASSERT_EQ(numResults, kNumRows / 2);
+    ASSERT_GT(numBatches, 10);
+  }
+}
+
 TEST_P(HashTableTest, groupBySpill) {
   auto type = ROW({"k1"}, {BIGINT()});
   testGroupBySpill(5'000'000, type, 1, 1000, 1000);
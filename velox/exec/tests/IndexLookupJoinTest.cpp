@@ -21,6 +21,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/HiveIndexSource.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -1925,6 +1926,105 @@ TEST_P(IndexLookupJoinTest, joinFuzzer) {
       GetParam().numPrefetches,
       "SELECT u.c0, u.c1, u.c2, u.c3, u.c4, u.c5, t.c0, t.c1, t.c2, t.c3, t.c4, t.c5 FROM t, u WHERE t.c0 = u.c0 AND array_contains(t.c4, u.c1) AND u.c2 BETWEEN t.c1 AND t.c2");
 }
+
+TEST_P(IndexLookupJoinTest, hiveIndexSource) {
+  // Three index files sorted on u0, with the even keys of [0, 300).
+  const int kRowsPerFile = 50;
+  std::vector<RowVectorPtr> tableData;
+  std::vector<std::shared_ptr<TempFilePath>> files;
+  std::vector<std::shared_ptr<connector::hive::HiveConnectorSplit>> splits;
+  for (int i = 0; i < 3; ++i) {
+    tableData.push_back(makeRowVector(
+        {"u0", "u1", "u2"},
+        {makeFlatVector<int64_t>(
+             kRowsPerFile,
+             [&](auto row) { return 2 * (i * kRowsPerFile + row); }),
+         makeFlatVector<int64_t>(
+             kRowsPerFile, [&](auto row) { return i * kRowsPerFile + row; }),
+         makeFlatVector<std::string>(kRowsPerFile, [&](auto row) {
+           return fmt::format("value {}", i * kRowsPerFile + row);
+         })}));
+    files.push_back(TempFilePath::create());
+    writeToFile(files.back()->getPath(), tableData.back());
+    splits.push_back(makeHiveConnectorSplit(files.back()->getPath()));
+  }
+  const auto tableType = asRowType(tableData[0]->type());
+
+  // The probe keys are in the ranges of the first two files, half of them
+  // with no match. Nulls match no rows.
+  std::vector<RowVectorPtr> probeVectors;
+  for (int i = 0; i < 2; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             70,
+             [&](auto row) { return i * 70 + row; },
+             [](auto row) { return row % 17 == 0; }),
+         makeFlatVector<int64_t>(70, [&](auto row) { return i * 70 + row; })}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", tableData);
+
+  const auto indexTableHandle =
+      std::make_shared<connector::hive::HiveIndexTableHandle>(
+          kHiveConnectorId,
+          "index_table",
+          true,
+          common::SubfieldFilters{},
+          nullptr,
+          tableType,
+          std::unordered_map<std::string, std::string>{},
+          splits);
+  ASSERT_TRUE(indexTableHandle->supportsIndexLookup());
+  connector::hive::HiveIndexTableHandle::registerSerDe();
+  const auto copy = ISerializable::deserialize<connector::ConnectorTableHandle>(
+      indexTableHandle->serialize(), pool());
+  ASSERT_EQ(copy->toString(), indexTableHandle->toString());
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      columnHandles;
+  for (auto i = 0; i < tableType->size(); ++i) {
+    columnHandles.emplace(
+        tableType->nameOf(i),
+        makeColumnHandle(tableType->nameOf(i), tableType->childAt(i), {}));
+  }
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId indexScanNodeId;
+    const auto indexScanNode = makeIndexScanNode(
+        planNodeIdGenerator,
+        indexTableHandle,
+        tableType,
+        indexScanNodeId,
+        columnHandles);
+    core::PlanNodeId joinNodeId;
+    auto plan = makeLookupPlan(
+        planNodeIdGenerator,
+        indexScanNode,
+        probeVectors,
+        {"t0"},
+        {"u0"},
+        {},
+        joinType,
+        {"t1", "u1", "u2"},
+        joinNodeId);
+    auto task = runLookupQuery(
+        plan,
+        GetParam().numPrefetches,
+        joinType == core::JoinType::kInner
+            ? "SELECT t.c1, u.c1, u.c2 FROM t, u WHERE t.c0 = u.c0"
+            : "SELECT t.c1, u.c1, u.c2 FROM t LEFT JOIN u ON t.c0 = u.c0");
+
+    // The last file is not read by any lookup.
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(joinNodeId).customStats;
+    ASSERT_GE(
+        runtimeStats.at("numSkippedLookupSplits").sum,
+        runtimeStats.at("numSkippedLookupSplits").count);
+    ASSERT_GT(runtimeStats.at("numLookupMatches").sum, 0);
+  }
+}
 } // namespace
 
 VELOX_INSTANTIATE_TEST_SUITE_P(
@@ -371,6 +371,68 @@ TEST_F(LocalPartitionTest, indicesBufferCapacity) {
   ASSERT_LE(capacity, 1.5 * numRows * sizeof(vector_size_t));
 }
 
+TEST_F(LocalPartitionTest, partitionBatching) {
+  std::vector<RowVectorPtr> vectors;
+  int64_t expectedSum = 0;
+  for (auto i = 0; i < 21; i++) {
+    vectors.emplace_back(makeRowVector({makeFlatVector<int32_t>(
+        100, [i](auto row) { return -71 + i * 10 + row; })}));
+    for (auto row = 0; row < 100; ++row) {
+      expectedSum += -71 + i * 10 + row;
+    }
+  }
+  auto filePaths = writeToFiles(vectors);
+  auto rowType = asRowType(vectors[0]->type());
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  std::vector<core::PlanNodeId> scanNodeIds;
+  auto scanNode = [&]() {
+    auto node = PlanBuilder(planNodeIdGenerator).tableScan(rowType).planNode();
+    scanNodeIds.push_back(node->id());
+    return node;
+  };
+  CursorParameters params;
+  params.planNode = PlanBuilder(planNodeIdGenerator)
+                        .localPartition(
+                            {"c0"},
+                            {
+                                scanNode(),
+                                scanNode(),
+                                scanNode(),
+                            })
+                        .planNode();
+  params.copyResult = false;
+  params.maxDrivers = 2;
+  params.queryConfigs
+      [core::QueryConfig::kLocalExchangePartitionBatchingEnabled] = "true";
+  params.queryConfigs[core::QueryConfig::kPreferredOutputBatchRows] = "1000";
+  auto cursor = TaskCursor::create(params);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    auto id = scanNodeIds[i % 3];
+    cursor->task()->addSplit(
+        id, Split(makeHiveConnectorSplit(filePaths[i]->getPath())));
+    cursor->task()->noMoreSplits(id);
+  }
+  int numRows = 0;
+  int numBatches = 0;
+  int64_t sum = 0;
+  while (cursor->moveNext()) {
+    auto* batch = cursor->current()->as<RowVector>();
+    ASSERT_EQ(batch->childrenSize(), 1);
+    auto* column = batch->childAt(0)->asFlatVector<int32_t>();
+    ASSERT_NE(column, nullptr);
+    for (auto row = 0; row < batch->size(); ++row) {
+      sum += column->valueAt(row);
+    }
+    numRows += batch->size();
+    ++numBatches;
+  }
+  ASSERT_EQ(numRows, 2100);
+  ASSERT_EQ(sum, expectedSum);
+  // Each of the 6 producers enqueues a single batch per partition as none of
+  // the partitions reaches 1000 rows.
+  ASSERT_LE(numBatches, 12);
+}
+
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
   auto localExchangeBufferSize = "1024";
   auto baseVector = vectorMaker_.flatVector<int64_t>(
@@ -951,5 +1013,47 @@ TEST_F(LocalPartitionTest, vectorPool) {
   ASSERT_FALSE(vectorPool.pop());
 }
 
+TEST_F(LocalPartitionTest, memoryManager) {
+  LocalExchangeMemoryManager memoryManager(100);
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_EQ(memoryManager.bufferedBytes(), 120);
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+  auto promises = memoryManager.decreaseMemoryUsage(60);
+  ASSERT_EQ(promises.size(), 1);
+  ASSERT_EQ(memoryManager.bufferedBytes(), 50);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  ASSERT_TRUE(future.isReady());
+
+  // Producers and consumers update the usage concurrently. Each blocked
+  // producer waits for its future, which a consumer must complete.
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumUpdates = 10'000;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, producer = i % 2 == 0]() {
+      for (auto j = 0; j < kNumUpdates; ++j) {
+        if (producer) {
+          ContinueFuture producerFuture;
+          if (memoryManager.increaseMemoryUsage(&producerFuture, 10)) {
+            producerFuture.wait();
+          }
+        } else {
+          for (auto& promise : memoryManager.decreaseMemoryUsage(10)) {
+            promise.setValue();
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(memoryManager.bufferedBytes(), 50);
+}
+
 } // namespace
 } // namespace facebook::velox::exec::test
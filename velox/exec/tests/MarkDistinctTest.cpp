@@ -141,3 +141,39 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, preGrouped) {
+  // Groups span inputs and null keys form a group of their own.
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector({
+          makeNullableFlatVector<int32_t>({std::nullopt, std::nullopt, 1, 1}),
+          makeNullableFlatVector<int32_t>({1, 1, std::nullopt, 1}),
+          makeFlatVector<int32_t>({0, 1, 2, 3}),
+      }),
+      makeRowVector({
+          makeNullableFlatVector<int32_t>({1, 1, 2, 2}),
+          makeNullableFlatVector<int32_t>({1, 2, 2, 2}),
+          makeFlatVector<int32_t>({4, 5, 6, 7}),
+      }),
+      makeRowVector({
+          makeNullableFlatVector<int32_t>({2, 2, 3, 3}),
+          makeNullableFlatVector<int32_t>({2, 3, 3, 3}),
+          makeFlatVector<int32_t>({8, 9, 10, 11}),
+      }),
+  };
+
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .streamingMarkDistinct("c0_distinct", {"c0"})
+                  .streamingMarkDistinct("c01_distinct", {"c0", "c1"})
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT *, "
+          "row_number() over (partition by c0 order by c2) = 1, "
+          "row_number() over (partition by c0, c1 order by c2) = 1 "
+          "FROM tmp");
+}
@@ -16,6 +16,8 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/MergeJoin.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -828,6 +830,92 @@ TEST_F(MergeJoinTest, lazyVectors) {
   }
 }
 
+TEST_F(MergeJoinTest, sparseRightSide) {
+  // 100'000 ascending keys on the left in strides of 10'000 rows joined with a
+  // few keys on the right. The left rows between the matches are skipped by
+  // exponential search and the lower bound on the left key pushed into the
+  // left scan skips the strides in between.
+  auto leftVectors = makeRowVector({
+      makeFlatVector<int64_t>(100'000, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(100'000, [](auto row) { return row % 31; }),
+  });
+  auto rightVectors = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>({5, 6, 50'005, 95'000, 200'000}),
+          makeFlatVector<int32_t>({1, 2, 3, 4, 5}),
+      });
+
+  auto leftFile = TempFilePath::create();
+  writeToFile(leftFile->getPath(), leftVectors);
+  createDuckDbTable("t", {leftVectors});
+  createDuckDbTable("u", {rightVectors});
+
+  struct {
+    core::JoinType joinType;
+    std::vector<std::string> outputLayout;
+    std::string sql;
+    bool skipsLeftRows;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       {"c0", "c1", "u1"},
+       "SELECT c0, c1, u1 FROM t, u WHERE c0 = u0",
+       true},
+      {core::JoinType::kRight,
+       {"c0", "c1", "u1"},
+       "SELECT c0, c1, u1 FROM t RIGHT JOIN u ON c0 = u0",
+       true},
+      {core::JoinType::kLeftSemiFilter,
+       {"c0", "c1"},
+       "SELECT c0, c1 FROM t WHERE c0 IN (SELECT u0 FROM u)",
+       true},
+      {core::JoinType::kLeft,
+       {"c0", "c1", "u1"},
+       "SELECT c0, c1, u1 FROM t LEFT JOIN u ON c0 = u0",
+       false},
+  };
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(joinTypeName(testData.joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId leftScanId;
+    core::PlanNodeId joinId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .tableScan(asRowType(leftVectors->type()))
+                    .capturePlanNodeId(leftScanId)
+                    .mergeJoin(
+                        {"c0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({rightVectors})
+                            .planNode(),
+                        "",
+                        testData.outputLayout,
+                        testData.joinType)
+                    .capturePlanNodeId(joinId)
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .split(leftScanId, makeHiveConnectorSplit(leftFile->getPath()))
+            .assertResults(testData.sql);
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& scanStats = planStats.at(leftScanId).customStats;
+    const auto& joinStats = planStats.at(joinId).customStats;
+    if (testData.skipsLeftRows) {
+      ASSERT_GT(joinStats.at(MergeJoin::kNumSkippedRows).sum, 0);
+      ASSERT_GT(scanStats.at("dynamicFiltersAccepted").sum, 0);
+      ASSERT_GT(scanStats.at("skippedStrides").sum, 0);
+      ASSERT_LT(planStats.at(leftScanId).rawInputRows, 100'000);
+    } else {
+      ASSERT_EQ(joinStats.count(MergeJoin::kNumSkippedRows), 0);
+      ASSERT_EQ(scanStats.count("dynamicFiltersAccepted"), 0);
+      ASSERT_EQ(planStats.at(leftScanId).rawInputRows, 100'000);
+    }
+  }
+}
+
 // Ensures the output of merge joins are dictionaries.
 TEST_F(MergeJoinTest, dictionaryOutput) {
   auto left =
@@ -183,3 +183,39 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+TEST_F(MergeTest, preserveDictionary) {
+  auto data1 = makeRowVector({
+      makeFlatVector<int64_t>({0, 2, 4, 6}),
+      wrapInDictionary(
+          makeIndices({0, 1, 0, 1}),
+          makeArrayVector<int64_t>({{1, 2, 3}, {4, 5}})),
+  });
+  auto data2 = makeRowVector({
+      makeFlatVector<int64_t>({1, 3, 5}),
+      wrapInDictionary(
+          makeIndices({1, 1, 0}), makeArrayVector<int64_t>({{6}, {7, 8}})),
+  });
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder(planNodeIdGenerator)
+          .localMerge(
+              {"c0"},
+              {
+                  PlanBuilder(planNodeIdGenerator).values({data1}).planNode(),
+                  PlanBuilder(planNodeIdGenerator).values({data2}).planNode(),
+              })
+          .planNode();
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  ASSERT_EQ(results.size(), 1);
+  ASSERT_EQ(
+      results[0]->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6}),
+      makeArrayVector<int64_t>(
+          {{1, 2, 3}, {7, 8}, {4, 5}, {7, 8}, {1, 2, 3}, {6}, {4, 5}}),
+  });
+  assertEqualVectors(expected, results[0]);
+}
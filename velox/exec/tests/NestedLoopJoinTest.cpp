@@ -571,6 +571,180 @@ TEST_F(NestedLoopJoinTest, outputOrder) {
   assertEqualVectors(expectedLeft, results);
 }
 
+TEST_F(NestedLoopJoinTest, rangeForm) {
+  auto probe = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>({1, 2}), makeFlatVector<int64_t>({3, 4})});
+  auto build = makeRowVector(
+      {"u0", "u1", "u2"},
+      {
+          makeNullableFlatVector<int64_t>({30, std::nullopt, 10, 20}),
+          makeNullableFlatVector<int64_t>({35, 5, std::nullopt, 22}),
+          makeFlatVector<StringView>({"a", "b", "c", "d"}),
+      });
+
+  const auto makeRange = [&](const std::string& condition) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probe})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({build})
+                            .planNode(),
+                        condition,
+                        {"t0", "u0"},
+                        core::JoinType::kInner)
+                    .planNode();
+    return NestedLoopJoinRange::make(
+        *std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(plan));
+  };
+
+  auto range = makeRange("t0 < u1");
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(range->keyChannel(), 1);
+  ASSERT_EQ(range->lowerBounds().size(), 1);
+  EXPECT_FALSE(range->lowerBounds()[0].inclusive);
+  EXPECT_TRUE(range->upperBounds().empty());
+  EXPECT_FALSE(range->intervalEndChannel().has_value());
+
+  // Prefers the column bounded from both sides.
+  range = makeRange("u0 > t1 AND u1 >= t0 - 10 AND u1 <= t0 + t1");
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(range->keyChannel(), 1);
+  EXPECT_EQ(range->lowerBounds().size(), 1);
+  EXPECT_EQ(range->upperBounds().size(), 1);
+  EXPECT_FALSE(range->intervalEndChannel().has_value());
+
+  range = makeRange("t0 BETWEEN u0 AND u1");
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(range->keyChannel(), 0);
+  EXPECT_TRUE(range->lowerBounds().empty());
+  ASSERT_EQ(range->upperBounds().size(), 1);
+  EXPECT_TRUE(range->upperBounds()[0].inclusive);
+  EXPECT_EQ(range->intervalEndChannel(), 1);
+  EXPECT_EQ(range->intervalEndLowerBounds().size(), 1);
+
+  auto sortedKeys = range->sortKeys(build, pool());
+  assertEqualVectors(makeFlatVector<int64_t>({10, 20, 30}), sortedKeys.keys);
+  const auto* rows = sortedKeys.rows->as<vector_size_t>();
+  EXPECT_EQ(
+      std::vector<vector_size_t>(rows, rows + 3),
+      std::vector<vector_size_t>({2, 3, 0}));
+  ASSERT_TRUE(sortedKeys.maxIntervalLength.has_value());
+  EXPECT_EQ(static_cast<int64_t>(sortedKeys.maxIntervalLength.value()), 5);
+
+  // 't0 BETWEEN u0 AND u1' for 't0' of 21, 30 and null. The key of a match is
+  // at most 't0' and at least 't0' minus the longest interval.
+  auto probeValues = makeNullableFlatVector<int64_t>({21, 30, std::nullopt});
+  SelectivityVector probeRows(probeValues->size());
+  std::vector<DecodedVector> bounds(2);
+  bounds[0].decode(*probeValues, probeRows);
+  bounds[1].decode(*probeValues, probeRows);
+  using Range = std::pair<vector_size_t, vector_size_t>;
+  EXPECT_EQ(range->findKeys(sortedKeys, bounds, 0), Range(1, 2));
+  EXPECT_EQ(range->findKeys(sortedKeys, bounds, 1), Range(2, 3));
+  EXPECT_EQ(range->findKeys(sortedKeys, bounds, 2), Range(0, 0));
+
+  EXPECT_FALSE(makeRange("t0 = u0").has_value());
+  EXPECT_FALSE(makeRange("t0 < u0 OR t1 > u1").has_value());
+  EXPECT_FALSE(makeRange("u0 < u1").has_value());
+  EXPECT_FALSE(makeRange("u2 < 'foo'").has_value());
+}
+
+TEST_F(NestedLoopJoinTest, rangeCondition) {
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int64_t>(
+                50,
+                [i](auto row) { return (row * 7 + i * 13) % 120; },
+                nullEvery(11)),
+            makeFlatVector<int64_t>(50, [](auto row) { return row % 9; }),
+        }));
+    const auto start = [i](auto row) { return (row * 17 + i * 5) % 100; };
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int64_t>(40, start, nullEvery(13)),
+            makeFlatVector<int64_t>(
+                40,
+                [&](auto row) { return start(row) + row % 11; },
+                nullEvery(7)),
+        }));
+  }
+
+  setComparisons({
+      "t0 < u0",
+      "u0 <= t0",
+      "t0 BETWEEN u0 AND u1",
+      "u0 <= t0 AND t0 < u1 AND t1 > 3",
+      "u0 >= t0 - 10 AND u0 <= t0 + t1",
+      "u1 > t0 + 200",
+  });
+  setOutputLayout({"t0", "t1", "u0", "u1"});
+  setJoinConditionStr("{}");
+  setQueryStr("SELECT t0, t1, u0, u1 FROM t {0} JOIN u ON {1}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
+// Build vectors of at most half the output batch size are joined with blocks
+// of probe rows at a time.
+TEST_F(NestedLoopJoinTest, filterTiles) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int64_t>(
+                37, [i](auto row) { return (row * 3 + i) % 20; }, nullEvery(5)),
+            makeFlatVector<int64_t>(37, [](auto row) { return row % 4; }),
+        }));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto size : {3, 7, 10}) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int64_t>(
+                size, [](auto row) { return row % 10; }, nullEvery(4)),
+            makeFlatVector<int64_t>(size, [](auto row) { return row % 3; }),
+        }));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    SCOPED_TRACE(joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "t0 + u0 < 12 AND t1 <> u1",
+                        {"t0", "t1", "u0", "u1"},
+                        joinType)
+                    .planNode();
+    // Keeps the build vectors apart. The first two are joined with blocks of
+    // 5 and 2 probe rows and the last with one probe row at a time.
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kMaxOutputBatchRows, "5")
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "16")
+        .assertResults(fmt::format(
+            "SELECT t0, t1, u0, u1 FROM t {} JOIN u "
+            "ON t0 + u0 < 12 AND t1 <> u1",
+            joinTypeName(joinType)));
+  }
+}
+
 TEST_F(NestedLoopJoinTest, mergeBuildVectors) {
   const std::vector<RowVectorPtr> buildVectors = {
       makeRowVector({makeFlatVector<int64_t>({1, 2})}),
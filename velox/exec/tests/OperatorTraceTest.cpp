@@ -255,6 +255,101 @@ TEST_F(OperatorTraceTest, traceData) {
   }
 }
 
+TEST_F(OperatorTraceTest, traceDataUncompressed) {
+  std::vector<RowVectorPtr> inputVectors;
+  constexpr auto numBatch = 3;
+  for (auto i = 0; i < numBatch; ++i) {
+    inputVectors.push_back(vectorFuzzer_.fuzzInputFlatRow(dataType_));
+  }
+  createDuckDbTable(inputVectors);
+
+  std::string planNodeId;
+  auto traceDirPath = TempDirectoryPath::create();
+  auto plan = PlanBuilder()
+                  .values(inputVectors)
+                  .singleAggregation({"a"}, {"count(1)"})
+                  .capturePlanNodeId(planNodeId)
+                  .planNode();
+  const auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .plan(plan)
+          .config(core::QueryConfig::kQueryTraceEnabled, true)
+          .config(core::QueryConfig::kQueryTraceDir, traceDirPath->getPath())
+          .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+          .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+          .config(core::QueryConfig::kQueryTraceNodeIds, planNodeId)
+          .config(core::QueryConfig::kQueryTraceCompressionKind, "none")
+          .assertResults("SELECT a, count(1) FROM tmp GROUP BY 1");
+
+  const auto opTraceDir = getOpTraceDirectory(
+      getTaskTraceDirectory(traceDirPath->getPath(), *task),
+      planNodeId,
+      /*pipelineId=*/0,
+      /*driverId=*/0);
+  const auto reader = OperatorTraceInputReader(opTraceDir, dataType_, pool());
+  RowVectorPtr actual;
+  size_t numOutputVectors{0};
+  while (reader.read(actual)) {
+    ASSERT_LT(numOutputVectors, numBatch);
+    velox::test::assertEqualVectors(inputVectors[numOutputVectors], actual);
+    ++numOutputVectors;
+  }
+  ASSERT_EQ(numOutputVectors, numBatch);
+}
+
+TEST_F(OperatorTraceTest, traceDataAsync) {
+  std::vector<RowVectorPtr> inputVectors;
+  constexpr auto numBatch = 20;
+  for (auto i = 0; i < numBatch; ++i) {
+    inputVectors.push_back(vectorFuzzer_.fuzzInputFlatRow(dataType_));
+  }
+  createDuckDbTable(inputVectors);
+
+  std::string planNodeId;
+  auto traceDirPath = TempDirectoryPath::create();
+  auto plan = PlanBuilder()
+                  .values(inputVectors)
+                  .singleAggregation({"a"}, {"count(1)"})
+                  .capturePlanNodeId(planNodeId)
+                  .planNode();
+  const auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .plan(plan)
+          .config(core::QueryConfig::kQueryTraceEnabled, true)
+          .config(core::QueryConfig::kQueryTraceDir, traceDirPath->getPath())
+          .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+          .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+          .config(core::QueryConfig::kQueryTraceNodeIds, planNodeId)
+          .config(core::QueryConfig::kQueryTraceAsyncEnabled, true)
+          .assertResults("SELECT a, count(1) FROM tmp GROUP BY 1");
+
+  const auto opTraceDir = getOpTraceDirectory(
+      getTaskTraceDirectory(traceDirPath->getPath(), *task),
+      planNodeId,
+      /*pipelineId=*/0,
+      /*driverId=*/0);
+  const auto summary = OperatorTraceSummaryReader(opTraceDir, pool()).read();
+  ASSERT_EQ(summary.inputRows, numBatch * 16);
+
+  // The batches that were not dropped are traced in order.
+  const auto reader = OperatorTraceInputReader(opTraceDir, dataType_, pool());
+  RowVectorPtr actual;
+  size_t numTracedBatches{0};
+  size_t nextInput{0};
+  while (reader.read(actual)) {
+    ++numTracedBatches;
+    while (nextInput < numBatch &&
+           !actual->equalValueAt(inputVectors[nextInput].get(), 0, 0)) {
+      ++nextInput;
+    }
+    ASSERT_LT(nextInput, numBatch);
+    velox::test::assertEqualVectors(inputVectors[nextInput], actual);
+    ++nextInput;
+  }
+  ASSERT_GT(numTracedBatches, 0);
+  ASSERT_EQ(numTracedBatches + summary.numDroppedBatches, numBatch);
+}
+
 TEST_F(OperatorTraceTest, traceMetadata) {
   const auto rowType =
       ROW({"c0", "c1", "c2", "c3", "c4", "c5"},
@@ -480,6 +480,51 @@ TEST_F(OrderByTest, outputBatchRows) {
   }
 }
 
+DEBUG_ONLY_TEST_F(OrderByTest, sortInSlices) {
+  // More rows than a sort run of SortBuffer.
+  const vector_size_t numRows = 200'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows / 4,
+            [&](auto row) { return (row * 7'919 + i) % numRows; },
+            nullEvery(13)),
+        makeFlatVector<int32_t>(numRows / 4, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Each step of the sorting takes longer than the time slice.
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::SortBuffer::sortInput",
+      std::function<void(SortBuffer*)>([&](SortBuffer* /*unused*/) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }));
+
+  for (const auto timeSliceLimitMs : {0, 1}) {
+    SCOPED_TRACE(fmt::format("timeSliceLimitMs: {}", timeSliceLimitMs));
+    const auto prevYieldCount = Driver::yieldCount();
+    AssertQueryBuilder(
+        PlanBuilder()
+            .values(vectors)
+            .orderBy({"c0 DESC NULLS FIRST", "c1"}, false)
+            .planNode(),
+        duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kDriverCpuTimeSliceLimitMs,
+            std::to_string(timeSliceLimitMs))
+        .assertResults(
+            "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1", {{0, 1}});
+    if (timeSliceLimitMs == 0) {
+      ASSERT_EQ(Driver::yieldCount(), prevYieldCount);
+    } else {
+      // Yields after each of the 4 sorted runs and 3 merges.
+      ASSERT_GE(Driver::yieldCount(), prevYieldCount + 7);
+    }
+  }
+}
+
 TEST_F(OrderByTest, spill) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -17,10 +17,12 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/SerializedPageUtil.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/UnsafeRowSerializer.h"
@@ -1450,6 +1452,113 @@ TEST_P(OutputBufferManagerWithDifferentSerdeKindsTest, outOfOrderAcks) {
   bufferManager_->removeTask(taskId);
 }
 
+TEST_F(OutputBufferManagerTest, spill) {
+  filesystems::registerLocalFileSystem();
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+  common::SpillConfig spillConfig;
+  spillConfig.getSpillDirPathCb = [&]() -> std::string_view {
+    return spillDirectory->getPath();
+  };
+  uint64_t spillLimitBytes{0};
+  spillConfig.updateAndCheckSpillLimitCb = [&](uint64_t bytes) {
+    spillLimitBytes += bytes;
+  };
+  spillConfig.fileNamePrefix = "spill";
+  auto fs = filesystems::getFileSystem(spillDirectory->getPath(), nullptr);
+  const auto numSpillFiles = [&]() {
+    return fs->list(spillDirectory->getPath()).size();
+  };
+
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+  // The serialized bytes of the pages enqueued for each destination.
+  std::vector<std::vector<std::string>> pages(2);
+  uint64_t totalBytes{0};
+  for (int destination = 0; destination < 2; ++destination) {
+    for (int i = 0; i < 2 + 2 * destination; ++i) {
+      auto page = makeSerializedPage(rowType_, 100);
+      pages[destination].push_back(
+          page->getIOBuf()->moveToFbString().toStdString());
+      totalBytes += page->size();
+      ContinueFuture future;
+      ASSERT_FALSE(bufferManager_->enqueue(
+          taskId, destination, std::move(page), &future));
+    }
+  }
+
+  // Verifies that the pages of 'destination' from 'sequence' on are returned
+  // with their original content.
+  const auto fetchAll = [&](int destination, int64_t sequence) {
+    bool receivedData{false};
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        destination,
+        std::numeric_limits<uint64_t>::max(),
+        sequence,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> data,
+            int64_t inSequence,
+            std::vector<int64_t> remainingBytes) {
+          ASSERT_EQ(inSequence, sequence);
+          ASSERT_TRUE(remainingBytes.empty());
+          ASSERT_EQ(data.size(), pages[destination].size() - sequence);
+          for (auto i = 0; i < data.size(); ++i) {
+            ASSERT_EQ(
+                data[i]->moveToFbString().toStdString(),
+                pages[destination][sequence + i]);
+          }
+          receivedData = true;
+        }));
+    ASSERT_TRUE(receivedData);
+  };
+
+  // The first page of destination 0 has been fetched but not acknowledged
+  // and is not spilled.
+  fetch(taskId, 0, 0, 1, 1);
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  common::SpillStats spillStats;
+  const uint64_t fetchedBytes = pages[0][0].size();
+  ASSERT_EQ(
+      buffer->spill(spillConfig, 0, spillStats), totalBytes - fetchedBytes);
+  ASSERT_EQ(spillStats.spilledBytes, totalBytes - fetchedBytes);
+  ASSERT_EQ(spillStats.spilledRows, 5 * 100);
+  ASSERT_EQ(spillStats.spilledFiles, 2);
+  ASSERT_EQ(spillLimitBytes, totalBytes - fetchedBytes);
+  ASSERT_EQ(numSpillFiles(), 2);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, fetchedBytes);
+  ASSERT_EQ(getStats(taskId).bufferedPages, 1);
+  // Nothing is left to spill.
+  ASSERT_EQ(buffer->spill(spillConfig, 0, spillStats), 0);
+
+  // Reading back all the pages of destination 0 removes its spill file.
+  fetchAll(0, 0);
+  ASSERT_EQ(numSpillFiles(), 1);
+  ASSERT_EQ(
+      getStats(taskId).bufferedBytes,
+      pages[0][0].size() + pages[0][1].size());
+  acknowledge(taskId, 0, 2);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+
+  // Only the fetched page of destination 1 is read back. Deleting the results
+  // removes the rest of the spilled pages.
+  fetch(taskId, 1, 0, 1, 1);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, pages[1][0].size());
+  ASSERT_EQ(numSpillFiles(), 1);
+  acknowledge(taskId, 1, 1);
+  deleteResults(taskId, 1);
+  ASSERT_EQ(numSpillFiles(), 0);
+  const auto stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.bufferedPages, 0);
+  ASSERT_EQ(stats.buffersStats[1].pagesSent, 4);
+  ASSERT_EQ(stats.buffersStats[1].bytesBuffered, 0);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 2);
+  ASSERT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, errorInQueue) {
   auto queue = std::make_shared<ExchangeQueue>(1, 0);
   queue->setError("Forced failure");
@@ -206,6 +206,122 @@ TEST_P(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_P(PartitionedOutputTest, manyDestinations) {
+  // Rows are grouped by destination before they are serialized. Verifies that
+  // each row goes to one destination and that every destination gets its rows.
+  constexpr int32_t kNumDestinations = 200;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           1'000, [](auto row) { return std::to_string(row); })});
+
+  core::PlanNodeId partitionNodeId;
+  auto plan = PlanBuilder()
+                  .values({input}, false, 5)
+                  .partitionedOutput(
+                      {"p1"},
+                      kNumDestinations,
+                      std::vector<std::string>{"v1"},
+                      GetParam())
+                  .capturePlanNodeId(partitionNodeId)
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-many-destinations-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext({}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  for (auto destination = 0; destination < kNumDestinations; ++destination) {
+    ASSERT_FALSE(getAllData(taskId, destination).empty()) << destination;
+  }
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(partitionNodeId).outputRows, 5 * 1'000);
+}
+
+TEST_P(PartitionedOutputTest, rebalanceSkewedPartitions) {
+  // All rows have the same key. With rebalancing, the partition of the key is
+  // spread over the other destinations once they fall behind.
+  constexpr int32_t kNumDestinations = 4;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int64_t>(100, [](auto /*row*/) { return 7; }),
+       makeFlatVector<std::string>(
+           100, [](auto row) { return std::string(100, 'a' + row % 26); })});
+
+  for (const bool rebalance : {false, true}) {
+    SCOPED_TRACE(fmt::format("rebalance: {}", rebalance));
+    auto node = std::dynamic_pointer_cast<const core::PartitionedOutputNode>(
+        PlanBuilder()
+            .values({input}, false, 20)
+            .partitionedOutput(
+                {"p1"},
+                kNumDestinations,
+                std::vector<std::string>{"v1"},
+                GetParam())
+            .planNode());
+    auto plan = std::make_shared<core::PartitionedOutputNode>(
+        node->id(),
+        node->kind(),
+        node->keys(),
+        node->numPartitions(),
+        /*replicateNullsAndAny=*/false,
+        node->partitionFunctionSpecPtr(),
+        node->outputType(),
+        node->serdeKind(),
+        node->sources()[0],
+        rebalance);
+
+    auto taskId = fmt::format(
+        "local://test-partitioned-output-rebalance-{}", rebalance ? 1 : 0);
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kPartitionedOutputMinPartitionRebalanceBytes,
+              "1"},
+             {core::QueryConfig::kPartitionedOutputMinRebalanceBytes, "1"}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    int32_t numDestinationsWithData = 0;
+    for (auto destination = 0; destination < kNumDestinations; ++destination) {
+      if (!getAllData(taskId, destination).empty()) {
+        ++numDestinationsWithData;
+      }
+    }
+    ASSERT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(plan->id());
+    ASSERT_EQ(stats.outputRows, 20 * 100);
+    if (rebalance) {
+      ASSERT_GT(numDestinationsWithData, 1);
+      ASSERT_GT(
+          stats.customStats.at(PartitionedOutput::kScaledPartitions).sum, 0);
+    } else {
+      ASSERT_EQ(numDestinationsWithData, 1);
+      ASSERT_EQ(
+          stats.customStats.count(PartitionedOutput::kScaledPartitions), 0);
+    }
+  }
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     PartitionedOutputTest,
     PartitionedOutputTest,
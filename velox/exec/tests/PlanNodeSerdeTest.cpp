@@ -144,6 +144,12 @@ TEST_F(PlanNodeSerdeTest, markDistinct) {
                   .markDistinct("marker", {"c0", "c1", "c2"})
                   .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .streamingMarkDistinct("marker", {"c0", "c1"})
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, nestedLoopJoin) {
@@ -389,6 +395,21 @@ TEST_F(PlanNodeSerdeTest, partitionedOutput) {
                .partitionedOutput({"c0"}, 50, {"c1", {"c2"}, "c0"}, serdeKind)
                .planNode();
     testSerde(plan);
+
+    auto partitionedOutput =
+        std::dynamic_pointer_cast<const core::PartitionedOutputNode>(plan);
+    plan = std::make_shared<core::PartitionedOutputNode>(
+        partitionedOutput->id(),
+        partitionedOutput->kind(),
+        partitionedOutput->keys(),
+        partitionedOutput->numPartitions(),
+        /*replicateNullsAndAny=*/false,
+        partitionedOutput->partitionFunctionSpecPtr(),
+        partitionedOutput->outputType(),
+        serdeKind,
+        partitionedOutput->sources()[0],
+        /*rebalanceSkewedPartitions=*/true);
+    testSerde(plan);
   }
 }
 
@@ -558,6 +579,12 @@ TEST_F(PlanNodeSerdeTest, rowNumber) {
              .rowNumber({"c1", "c2"}, 10, false)
              .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .streamingRowNumber({"c1", "c2"}, 10)
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, scan) {
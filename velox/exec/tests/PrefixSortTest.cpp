@@ -41,7 +41,15 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t maxRadixSortKeyBytes =
+          common::PrefixSortConfig().maxRadixSortKeyBytes) {
+    common::PrefixSortConfig config{
+        1024,
+        // Set threshold to 0 to enable prefix-sort in small dataset.
+        0,
+        12};
+    config.maxRadixSortKeyBytes = maxRadixSortKeyBytes;
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -61,27 +69,12 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
     const std::shared_ptr<memory::MemoryPool> sortPool =
         rootPool_->addLeafChild("prefixsort");
     const auto maxBytes = PrefixSort::maxRequiredBytes(
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
-        sortPool.get());
+        &rowContainer, compareFlags, config, sortPool.get());
     const auto beforeBytes = sortPool->peakBytes();
     ASSERT_EQ(sortPool->peakBytes(), 0);
     // Use PrefixSort to sort rows.
     PrefixSort::sort(
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
-        sortPool.get(),
-        rows);
+        &rowContainer, compareFlags, config, sortPool.get(), rows);
     ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
 
     // Extract data from the RowContainer in order.
@@ -330,6 +323,37 @@ TEST_F(PrefixSortTest, fuzzMulti) {
   runFuzzTest(0.0);
 }
 
+TEST_F(PrefixSortTest, radixSort) {
+  const vector_size_t size = 2 * PrefixSort::kMinRadixSortRows;
+  const std::vector<VectorPtr> testData = {
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 7 == 0 ? -row : row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 100 - 50; }, nullEvery(11)),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return (row * 7'919) % 1'001; }, nullEvery(7)),
+      makeFlatVector<int16_t>(size, [](auto row) { return row % 13; }),
+      makeFlatVector<Timestamp>(
+          size,
+          [](auto row) { return Timestamp(row % 17, row * 1'000); },
+          nullEvery(5))};
+
+  // One key and two keys, with radix sort on and off.
+  for (const auto maxRadixSortKeyBytes : {24, 0}) {
+    SCOPED_TRACE(fmt::format("maxRadixSortKeyBytes {}", maxRadixSortKeyBytes));
+    for (auto i = 0; i < testData.size(); ++i) {
+      const auto data = makeRowVector({testData[i]});
+      testPrefixSort({kAsc}, data, maxRadixSortKeyBytes);
+      testPrefixSort({kDesc}, data, maxRadixSortKeyBytes);
+    }
+    for (auto i = 0; i + 1 < 3; ++i) {
+      const auto data = makeRowVector({testData[i], testData[i + 1]});
+      testPrefixSort({kAsc, kDesc}, data, maxRadixSortKeyBytes);
+      testPrefixSort({kDesc, kAsc}, data, maxRadixSortKeyBytes);
+    }
+  }
+}
+
 TEST_F(PrefixSortTest, checkMaxNormalizedKeySizeForMultipleKeys) {
   // Test the normalizedKeySize doesn't exceed the MaxNormalizedKeySize.
   // The normalizedKeySize for BIGINT should be 8 + 1.
@@ -168,6 +168,9 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        hashtable.capacity\\s+sum: 200, count: 1, min: 200, max: 200, avg: 200"},
        {"        hashtable.numDistinct\\s+sum: 100, count: 1, min: 100, max: 100, avg: 100"},
        {"        hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1, avg: 1"},
+       {"        hashtable.rowBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"        hashtable.stringBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"        hashtable.tableBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        rangeKey0\\s+sum: 200, count: 1, min: 200, max: 200, avg: 200"},
        {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -279,6 +282,9 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"      hashtable.numDistinct\\s+sum: (?:849|835), count: 1, min: (?:849|835), max: (?:849|835), avg: (?:849|835)"},
          {"      hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1, avg: 1"},
          {"      hashtable.numTombstones\\s+sum: 0, count: 1, min: 0, max: 0, avg: 0"},
+         {"      hashtable.rowBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      hashtable.stringBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      hashtable.tableBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      loadedToValueHook\\s+sum: 50000, count: 5, min: 10000, max: 10000, avg: 10000"},
          {"      runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -422,3 +428,47 @@ TEST_F(PrintPlanWithStatsTest, taskAPI) {
   ASSERT_TRUE(waitForTaskAborted(task.get()));
   checkOutput(task.get());
 }
+
+TEST_F(PrintPlanWithStatsTest, perfCounters) {
+  if (!process::DeltaPerfCounterStopWatch::available()) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  core::PlanNodeId projectId;
+  const auto plan = PlanBuilder()
+                        .values({data}, false, 10)
+                        .project({"c0 * 2 AS c1"})
+                        .capturePlanNodeId(projectId)
+                        .planNode();
+
+  std::vector<uint64_t> counts;
+  for (const auto interval : {1, 4}) {
+    SCOPED_TRACE(fmt::format("interval: {}", interval));
+    std::shared_ptr<exec::Task> task;
+    AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kOperatorPerfCountersEnabled, "true")
+        .config(
+            core::QueryConfig::kOperatorPerfCountersSamplingInterval,
+            std::to_string(interval))
+        .copyResults(pool(), task);
+
+    const auto planStats = exec::toPlanStats(task->taskStats());
+    const auto& perfCounters = planStats.at(projectId).perfCounters;
+    ASSERT_GT(perfCounters.count, 0);
+    ASSERT_GT(perfCounters.instructions, 0);
+    ASSERT_GT(perfCounters.cycles, 0);
+    counts.push_back(perfCounters.count);
+    ASSERT_NE(
+        task->printPlanWithStats().find("Perf counters: (count: "),
+        std::string::npos);
+  }
+  // Only one out of 4 calls is measured with the larger interval.
+  ASSERT_LT(counts[1], counts[0]);
+
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  ASSERT_TRUE(
+      exec::toPlanStats(task->taskStats()).at(projectId).perfCounters.empty());
+}
@@ -1294,16 +1294,110 @@ TEST_F(RowContainerTest, extractNulls) {
   }
 }
 
+TEST_F(RowContainerTest, extractWithNullRowsAndOffset) {
+  // More rows than one null word and the prefetch distance, with an unaligned
+  // result offset. Covers fixed width columns with and without nulls, strings
+  // and booleans.
+  constexpr int32_t kNumRows = 300;
+  constexpr int32_t kResultOffset = 5;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 3; }, nullEvery(7)),
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) {
+            return fmt::format("a string longer than 12 {}", row);
+          },
+          nullEvery(5)),
+      makeFlatVector<bool>(
+          kNumRows, [](auto row) { return row % 2 == 0; }, nullEvery(3)),
+  });
+  auto data = makeRowContainer(
+      {}, {BIGINT(), INTEGER(), VARCHAR(), BOOLEAN()}, false);
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    DecodedVector decoded(*batch->childAt(column), allRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      data->store(decoded, i, rows[i], column);
+    }
+  }
+
+  // Every 13th row is missing, as for the non-matches of an outer join.
+  std::vector<char*> probeRows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    probeRows[i] = i % 13 == 0 ? nullptr : rows[i];
+  }
+  // Reversed row numbers with every 11th negative.
+  std::vector<vector_size_t> rowNumbers(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rowNumbers[i] = i % 11 == 0 ? -1 : kNumRows - 1 - i;
+  }
+
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    const auto& source = batch->childAt(column);
+    auto result =
+        BaseVector::create(source->type(), kResultOffset, pool_.get());
+    for (auto i = 0; i < kResultOffset; ++i) {
+      result->setNull(i, true);
+    }
+    data->extractColumn(
+        probeRows.data(), kNumRows, column, kResultOffset, result);
+    ASSERT_EQ(result->size(), kNumRows + kResultOffset);
+    for (auto i = 0; i < kResultOffset; ++i) {
+      ASSERT_TRUE(result->isNullAt(i));
+    }
+    for (auto i = 0; i < kNumRows; ++i) {
+      const auto index = kResultOffset + i;
+      if (probeRows[i] == nullptr) {
+        ASSERT_TRUE(result->isNullAt(index)) << column << " " << i;
+      } else {
+        ASSERT_TRUE(result->equalValueAt(source.get(), index, i))
+            << column << " " << i;
+      }
+    }
+
+    result = BaseVector::create(source->type(), 0, pool_.get());
+    data->extractColumn(
+        rows.data(),
+        folly::Range<const vector_size_t*>(rowNumbers.data(), kNumRows),
+        column,
+        0,
+        result);
+    ASSERT_EQ(result->size(), kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      if (rowNumbers[i] < 0) {
+        ASSERT_TRUE(result->isNullAt(i)) << column << " " << i;
+      } else {
+        ASSERT_TRUE(result->equalValueAt(source.get(), i, rowNumbers[i]))
+            << column << " " << i;
+      }
+    }
+  }
+
+  auto nulls = allocateNulls(kNumRows, pool());
+  data->extractNulls(probeRows.data(), kNumRows, 0, nulls);
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(
+        bits::isBitSet(nulls->as<uint64_t>(), i),
+        probeRows[i] == nullptr || i % 7 == 0);
+  }
+}
+
 TEST_F(RowContainerTest, erase) {
   constexpr int32_t kNumRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
 
-  // The layout is expected to be smallint - 6 bytes of padding - 1 byte of bits
-  // - smallint - next pointer. The bits are a null flag for the second
+  // The layout is expected to be smallint - 6 bytes of padding - next pointer -
+  // 1 byte of bits - smallint. The bits are a null flag for the second
   // smallint, a probed flag and a free flag.
-  EXPECT_EQ(data->nextOffset(), 11);
+  EXPECT_EQ(data->nextOffset(), 8);
   // 2nd bit in first byte of flags.
-  EXPECT_EQ(data->probedFlagOffset(), 8 * 8 + 1);
+  EXPECT_EQ(data->probedFlagOffset(), 16 * 8 + 1);
   std::unordered_set<char*> rowSet;
   std::vector<char*> rows;
   for (int i = 0; i < kNumRows; ++i) {
@@ -1371,13 +1465,13 @@ TEST_F(RowContainerTest, rowSize) {
   constexpr int32_t kNumRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()});
 
-  // The layout is expected to be smallint - 6 bytes of padding - 1 byte of bits
-  // - StringView - rowSize - next pointer. The bits are a null flag for the
-  // second smallint, a probed flag and a free flag.
-  EXPECT_EQ(25, data->rowSizeOffset());
-  EXPECT_EQ(29, data->nextOffset());
+  // The layout is expected to be smallint - 6 bytes of padding - next pointer -
+  // 1 byte of bits - StringView - rowSize. The bits are a null flag for the
+  // StringView, a probed flag and a free flag.
+  EXPECT_EQ(33, data->rowSizeOffset());
+  EXPECT_EQ(8, data->nextOffset());
   // 2nd bit in first byte of flags.
-  EXPECT_EQ(data->probedFlagOffset(), 8 * 8 + 1);
+  EXPECT_EQ(data->probedFlagOffset(), 16 * 8 + 1);
   std::vector<char*> rows;
   for (int i = 0; i < kNumRows; ++i) {
     rows.push_back(data->newRow());
@@ -2133,10 +2227,31 @@ DEBUG_ONLY_TEST_F(RowContainerTest, eraseAfterOomStoringString) {
   rowContainer->eraseRows(folly::Range<char**>(rows.data(), numRows));
 }
 
+TEST_F(RowContainerTest, joinBuildLayout) {
+  // The next row pointer follows the keys, so that a probe that checks the
+  // keys and the next row touches only the start of a wide row.
+  std::vector<TypePtr> dependentTypes(10, BIGINT());
+  auto data = makeRowContainer({BIGINT(), INTEGER()}, dependentTypes);
+  EXPECT_EQ(data->columnAt(0).offset(), 0);
+  EXPECT_EQ(data->columnAt(1).offset(), 8);
+  EXPECT_EQ(data->nextOffset(), 12);
+  // Flags come after the next row pointer.
+  EXPECT_EQ(data->probedFlagOffset(), 20 * 8 + 10);
+  for (auto i = 2; i < dependentTypes.size() + 2; ++i) {
+    EXPECT_GE(data->columnAt(i).offset(), 20 + 2);
+  }
+  EXPECT_EQ(data->fixedRowSize(), 12 + 8 + 2 + 10 * 8);
+
+  // Without duplicate rows there is no next row pointer.
+  data = makeRowContainer({BIGINT(), INTEGER()}, dependentTypes, false);
+  EXPECT_EQ(data->nextOffset(), 0);
+  EXPECT_EQ(data->columnAt(2).offset(), 12 + 2);
+}
+
 TEST_F(RowContainerTest, nextRowVector) {
   int32_t numRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
-  EXPECT_EQ(data->nextOffset(), 11);
+  EXPECT_EQ(data->nextOffset(), 8);
   std::unordered_set<char*> rowSet;
   std::vector<char*> rows;
 
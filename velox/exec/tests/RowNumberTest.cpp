@@ -139,6 +139,59 @@ TEST_F(RowNumberTest, noPartitionKeys) {
   testLimit(50);
 }
 
+TEST_F(RowNumberTest, preGrouped) {
+  // Partitions span inputs and null keys form a partition of their own.
+  std::vector<RowVectorPtr> data = {
+      makeRowVector({
+          makeNullableFlatVector<int64_t>(
+              {std::nullopt, std::nullopt, 1, 1, 1}),
+          makeFlatVector<int64_t>({0, 1, 2, 3, 4}),
+      }),
+      makeRowVector({
+          makeFlatVector<int64_t>({1, 2, 2, 2, 2}),
+          makeFlatVector<int64_t>({5, 6, 7, 8, 9}),
+      }),
+      makeRowVector({
+          makeFlatVector<int64_t>({2, 3, 4, 4, 4}),
+          makeFlatVector<int64_t>({10, 11, 12, 13, 14}),
+      }),
+  };
+
+  createDuckDbTable(data);
+
+  const std::string rowNumberSql =
+      "SELECT *, row_number() over (partition by c0 order by c1) as rn "
+      "FROM tmp";
+
+  auto plan =
+      PlanBuilder().values(data).streamingRowNumber({"c0"}).planNode();
+  assertQuery(plan, rowNumberSql);
+
+  plan = PlanBuilder()
+             .values(data)
+             .streamingRowNumber({"c0"}, std::nullopt, false)
+             .planNode();
+  assertQuery(plan, fmt::format("SELECT c0, c1 FROM ({})", rowNumberSql));
+
+  for (auto limit : {1, 2, 5}) {
+    SCOPED_TRACE(fmt::format("limit: {}", limit));
+    plan =
+        PlanBuilder().values(data).streamingRowNumber({"c0"}, limit).planNode();
+    assertQuery(
+        plan,
+        fmt::format("SELECT * FROM ({}) WHERE rn <= {}", rowNumberSql, limit));
+
+    plan = PlanBuilder()
+               .values(data)
+               .streamingRowNumber({"c0"}, limit, false)
+               .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT c0, c1 FROM ({}) WHERE rn <= {}", rowNumberSql, limit));
+  }
+}
+
 TEST_F(RowNumberTest, largeInput) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>(10'000, [](auto row) { return row % 7; }),
@@ -16,6 +16,9 @@
 
 #include "velox/exec/ScaledScanController.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/synchronization/Baton.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -268,6 +271,82 @@ TEST_F(ScaledScanControllerTest, estimateDriverUsage) {
   }
 }
 
+TEST_F(ScaledScanControllerTest, ioBound) {
+  auto root = rootPool(256 << 20);
+  auto node = root->addAggregateChild("test");
+  const int numDrivers{4};
+  for (bool ioBound : {false, true}) {
+    SCOPED_TRACE(fmt::format("ioBound {}", ioBound));
+    auto controller =
+        std::make_shared<ScaledScanController>(node.get(), numDrivers, 0.9);
+    const ScaledScanController::SplitTiming splitTiming{
+        .ioWaitNanos = ioBound ? 900'000 : 100'000, .wallNanos = 1'000'000};
+    controller->updateAndTryScale(0, 1 << 20, splitTiming);
+    // An I/O bound scan scales up by two drivers at a time.
+    ASSERT_EQ(controller->stats().numRunningDrivers, ioBound ? 3 : 2);
+  }
+}
+
+TEST_F(ScaledScanControllerTest, noIdleThread) {
+  auto root = rootPool(256 << 20);
+  auto node = root->addAggregateChild("test");
+  const int numDrivers{4};
+  folly::CPUThreadPoolExecutor executor(1);
+  for (bool ioBound : {false, true}) {
+    SCOPED_TRACE(fmt::format("ioBound {}", ioBound));
+    auto controller = std::make_shared<ScaledScanController>(
+        node.get(), numDrivers, 0.9, &executor);
+    const ScaledScanController::SplitTiming splitTiming{
+        .ioWaitNanos = ioBound ? 900'000 : 100'000, .wallNanos = 1'000'000};
+    // The only thread of the executor is busy with the reporting driver.
+    folly::Baton<> done;
+    executor.add([&]() {
+      controller->updateAndTryScale(0, 1 << 20, splitTiming);
+      done.post();
+    });
+    done.wait();
+    ASSERT_EQ(controller->stats().numRunningDrivers, ioBound ? 3 : 1);
+  }
+}
+
+TEST_F(ScaledScanControllerTest, scaleDown) {
+  auto root = rootPool(256 << 20);
+  auto node = root->addAggregateChild("test");
+  auto otherNode = root->addAggregateChild("other");
+  auto otherPool = otherNode->addLeafChild("other");
+  const int numDrivers{4};
+  auto controller =
+      std::make_shared<ScaledScanController>(node.get(), numDrivers, 0.5);
+  controller->updateAndTryScale(0, 1 << 20);
+  controller->updateAndTryScale(1, 1 << 20);
+  ASSERT_EQ(controller->stats().numRunningDrivers, 3);
+
+  // The query memory usage gets beyond half way from the scale up limit to
+  // the query capacity.
+  const uint64_t otherUsage{200 << 20};
+  void* otherBuffer = otherPool->allocate(otherUsage);
+  controller->updateAndTryScale(2, 1 << 20);
+  ASSERT_EQ(controller->stats().numRunningDrivers, 2);
+  ASSERT_EQ(controller->stats().numScaleDowns, 1);
+
+  ContinueFuture future{ContinueFuture::makeEmpty()};
+  ASSERT_TRUE(controller->shouldStop(2, &future));
+  ASSERT_TRUE(future.valid());
+  controller->updateAndTryScale(1, 1 << 20);
+  ASSERT_EQ(controller->stats().numRunningDrivers, 1);
+  ASSERT_EQ(controller->stats().numScaleDowns, 2);
+
+  // Scales up again after the memory is freed.
+  otherPool->free(otherBuffer, otherUsage);
+  controller->updateAndTryScale(0, 1 << 20);
+  ASSERT_EQ(controller->stats().numRunningDrivers, 2);
+  ASSERT_FALSE(future.isReady());
+  controller->updateAndTryScale(1, 1 << 20);
+  ASSERT_EQ(controller->stats().numRunningDrivers, 3);
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(controller->stats().numScaleDowns, 2);
+}
+
 TEST_F(ScaledScanControllerTest, error) {
   auto root = rootPool(256 << 20);
   auto node = root->addAggregateChild("test");
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <filesystem>
 #include <memory>
 
 #include "velox/common/base/RuntimeMetrics.h"
@@ -609,6 +611,159 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, columnarFormat) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      {},
+      kGB,
+      1 << 10,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_,
+      "",
+      /*columnarFormat=*/true);
+  const int partition = 0;
+  state.setPartitionSpilled(partition);
+
+  // Sorted unique keys, a low cardinality string column, a constant column, a
+  // low cardinality bigint column with nulls and a high cardinality string
+  // column.
+  const int32_t numBatches = 10;
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < numBatches; ++i) {
+    auto batch = makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return i * batchSize + row; }),
+        makeFlatVector<std::string>(
+            batchSize,
+            [](auto row) {
+              return fmt::format("a long repeated string value {}", row % 7);
+            }),
+        makeFlatVector<int32_t>(batchSize, [](auto /*row*/) { return 17; }),
+        makeFlatVector<int64_t>(
+            batchSize,
+            [](auto row) { return row % 5; },
+            [](auto row) { return row % 11 == 0; }),
+        makeFlatVector<std::string>(
+            batchSize,
+            [&](auto row) {
+              return fmt::format("unique {}", i * batchSize + row);
+            }),
+    });
+    state.appendToPartition(partition, batch);
+    batches.push_back(std::move(batch));
+  }
+  state.finishFile(partition);
+
+  const auto stats = spillStats_.copy();
+  ASSERT_EQ(stats.spilledRows, numBatches * batchSize);
+  ASSERT_GT(stats.spillEncodingSavedBytes, 0);
+  if (compressionKind_ == common::CompressionKind::CompressionKind_NONE) {
+    ASSERT_EQ(stats.spillCompressionSavedBytes, 0);
+  }
+
+  SpillPartition spillPartition(SpillPartitionId{0}, state.finish(partition));
+  auto merge =
+      spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+  for (const auto& batch : batches) {
+    for (auto row = 0; row < batchSize; ++row) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      for (auto column = 0; column < batch->childrenSize(); ++column) {
+        ASSERT_TRUE(stream->current().childAt(column)->equalValueAt(
+            batch->childAt(column).get(), stream->currentIndex(), row));
+      }
+      stream->pop();
+    }
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+}
+
+TEST_P(SpillTest, parallelMergeWithReadAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      {},
+      kGB,
+      1 << 10,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_);
+  const int partition = 0;
+  state.setPartitionSpilled(partition);
+
+  // Writes 'numRuns' sorted runs of interleaved keys, one file per run.
+  const int32_t numRuns = 10;
+  const int32_t numBatchesPerRun = 3;
+  const vector_size_t batchSize = 100;
+  for (auto run = 0; run < numRuns; ++run) {
+    for (auto i = 0; i < numBatchesPerRun; ++i) {
+      const auto firstKey = i * batchSize * numRuns + run;
+      state.appendToPartition(
+          partition,
+          makeRowVector({
+              makeFlatVector<int64_t>(
+                  batchSize,
+                  [&](auto row) { return firstKey + row * numRuns; }),
+              makeFlatVector<std::string>(
+                  batchSize,
+                  [&](auto row) {
+                    return fmt::format(
+                        "string value {}", firstKey + row * numRuns);
+                  }),
+          }));
+    }
+    state.finishFile(partition);
+  }
+  auto files = state.finish(partition);
+  ASSERT_EQ(files.size(), numRuns);
+
+  folly::CPUThreadPoolExecutor executor(4);
+  common::SpillConfig spillConfig;
+  spillConfig.updateAndCheckSpillLimitCb = updateSpilledBytesCb_;
+  spillConfig.writeBufferSize = 1 << 10;
+  spillConfig.readBufferSize = 1 << 20;
+  spillConfig.executor = &executor;
+  spillConfig.readAheadEnabled = true;
+  // Merges 10 runs into 4 and then into 2 before the final merge.
+  spillConfig.mergeFanIn = 3;
+
+  SpillPartition spillPartition(SpillPartitionId{0}, std::move(files));
+  auto merge =
+      spillPartition.createOrderedReader(spillConfig, pool(), &spillStats_);
+  const auto numSpillFiles = std::distance(
+      std::filesystem::directory_iterator(tempDirectory->getPath()),
+      std::filesystem::directory_iterator{});
+  ASSERT_EQ(numSpillFiles, 2);
+
+  const int64_t numRows = numRuns * numBatchesPerRun * batchSize;
+  for (int64_t key = 0; key < numRows; ++key) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    const auto& current = stream->current();
+    const auto index = stream->currentIndex();
+    ASSERT_EQ(
+        current.childAt(0)->asFlatVector<int64_t>()->valueAt(index), key);
+    ASSERT_EQ(
+        current.childAt(1)->asFlatVector<StringView>()->valueAt(index).str(),
+        fmt::format("string value {}", key));
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -94,6 +94,12 @@ TEST_F(SqlTest, tableScan) {
   assertSql("SELECT * FROM t, u WHERE t.a = u.a");
   assertSql("SELECT t.a, t.b, t.c, u.b FROM t, u WHERE t.a = u.a");
   assertSql("SELECT t.a, t.b, t.c, u.b FROM t left join u on t.a = u.a");
+  assertSql("SELECT t.c, u.b FROM u, t WHERE t.a = u.a AND t.b > 2");
+  assertSql("SELECT t.c, u.b FROM u, t WHERE t.a = u.a AND t.c + u.b > 5");
+  assertSql("SELECT t.c, u.b FROM u, t WHERE t.c > 8");
+  assertSql(
+      "SELECT t1.b, t2.b, u.b FROM t t1, u, t t2 "
+      "WHERE t1.a = u.a AND u.a = t2.a AND t2.b < 5");
   assertSql(
       "SELECT t.a, t.b, t.c FROM t WHERE EXISTS (SELECT 1 FROM u WHERE t.a = u.a)");
   assertSql("SELECT t.a, t.b, t.c FROM t WHERE a < (SELECT max(u.a) FROM u)");
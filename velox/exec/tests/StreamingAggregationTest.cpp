@@ -562,5 +562,43 @@ TEST_P(StreamingAggregationTest, clusteredInput) {
   }
 }
 
+TEST_P(StreamingAggregationTest, mergedSortedStreams) {
+  // Each stream, e.g. a split of a sorted table, is sorted on the grouping key
+  // but the same keys appear in several streams. The streams are merged with a
+  // LocalMerge and aggregated in one pass.
+  std::vector<RowVectorPtr> streams;
+  for (auto i = 0; i < 4; ++i) {
+    streams.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return (row + i * 100) / 7; }),
+        makeFlatVector<int64_t>(1'000, [i](auto row) { return row * i; }),
+    }));
+  }
+  createDuckDbTable(streams);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  std::vector<core::PlanNodePtr> sources;
+  for (const auto& stream : streams) {
+    sources.push_back(
+        PlanBuilder(planNodeIdGenerator).values({stream}).planNode());
+  }
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localMerge({"c0"}, std::move(sources))
+                  .streamingAggregation(
+                      {"c0"},
+                      {"count(1)", "sum(c1)", "max(c1)"},
+                      {},
+                      core::AggregationNode::Step::kSingle,
+                      false)
+                  .planNode();
+
+  for (auto batchSize : {7, 1'000}) {
+    SCOPED_TRACE(fmt::format("batchSize={}", batchSize));
+    config(AssertQueryBuilder(plan, duckDbQueryRunner_), batchSize)
+        .assertResults(
+            "SELECT c0, count(1), sum(c1), max(c1) FROM tmp GROUP BY 1");
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec
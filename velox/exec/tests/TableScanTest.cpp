@@ -331,6 +331,12 @@ TEST_F(TableScanTest, directBufferInputRawInputBytes) {
       rawInputBytes + overreadBytes);
   ASSERT_GT(getTableScanRuntimeStats(task)["totalScanTime"].sum, 0);
   ASSERT_GT(getTableScanRuntimeStats(task)["ioWaitWallNanos"].sum, 0);
+  // The storage reads are in the latency histograms of the local file system.
+  const auto& latencies = it->second.ioLatencyHistograms;
+  ASSERT_GT(latencies.at("storage").count(), 0);
+  ASSERT_EQ(
+      latencies.at("storage.file").count(), latencies.at("storage").count());
+  ASSERT_NE(it->second.toString().find("I/O latency: ("), std::string::npos);
 }
 
 DEBUG_ONLY_TEST_F(TableScanTest, pendingCoalescedIoWhenTaskFailed) {
@@ -1682,6 +1688,52 @@ TEST_F(TableScanTest, preloadingSplitClose) {
   latch.wait();
 }
 
+DEBUG_ONLY_TEST_F(TableScanTest, adaptiveSplitPreload) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Opening a split takes much longer than processing it, as on high latency
+  // storage.
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::connector::hive::HiveDataSource::addSplit",
+      std::function<void(connector::hive::HiveDataSource*)>(
+          [&](connector::hive::HiveDataSource* /*unused*/) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          }));
+  {
+    SCOPED_TRACE("Adaptive depth");
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "4")
+            .config(core::QueryConfig::kAdaptiveSplitPreloadEnabled, "true")
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    ASSERT_EQ(stats.at("splitPreloadDepth").min, 1);
+    ASSERT_EQ(stats.at("splitPreloadDepth").max, 4);
+    ASSERT_GT(stats.at("preloadedSplits").sum, 10);
+  }
+  {
+    SCOPED_TRACE("Preload bytes limit");
+    // The limit is less than the bytes of a split, so no splits are preloaded
+    // after the first one is read.
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "4")
+            .config(core::QueryConfig::kAdaptiveSplitPreloadEnabled, "true")
+            .config(core::QueryConfig::kMaxSplitPreloadBytes, "1")
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    const auto it = stats.find("preloadedSplits");
+    ASSERT_LE(it == stats.end() ? 0 : it->second.sum, 2);
+  }
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -2750,6 +2802,67 @@ TEST_F(TableScanTest, statsBasedSkippingNumerics) {
   EXPECT_EQ(size - 20'000, getTableScanStats(task).rawInputRows);
 }
 
+// Test that the cutoff of TopN is pushed down into the scan and prunes row
+// groups by stats.
+TEST_F(TableScanTest, topNDynamicFilter) {
+  const vector_size_t size = 50'000;
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           size, [](auto row) { return fmt::format("{:05}", row); }),
+       makeFlatVector<int32_t>(
+           size, [](auto row) { return row % 100; }, nullEvery(7))});
+  auto rowType = asRowType(rowVector->type());
+
+  auto filePaths = makeFilePaths(1);
+  writeToFile(filePaths[0]->getPath(), rowVector);
+  createDuckDbTable({rowVector});
+
+  // Row groups after the first one have no rows that make it into the result.
+  for (const auto& key : {"c0", "c1"}) {
+    SCOPED_TRACE(key);
+    auto plan = PlanBuilder(pool_.get())
+                    .tableScan(rowType)
+                    .topN({key}, 10, true)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kTopNDynamicFilterEnabled, true)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults(
+                fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 10", key));
+    ASSERT_GT(
+        getTableScanRuntimeStats(task).at("dynamicFiltersAccepted").sum, 0);
+    ASSERT_LE(getTableScanStats(task).rawInputRows, 10'000);
+  }
+
+  // Multiple drivers share the cutoff. Rows with the cutoff value and nulls
+  // that sort first must pass the filter.
+  filePaths = makeFilePaths(4);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), rowVector);
+  }
+  for (const auto& order :
+       {"c2 NULLS FIRST", "c2 DESC NULLS LAST", "c1 DESC"}) {
+    SCOPED_TRACE(order);
+    auto plan = PlanBuilder(pool_.get())
+                    .tableScan(rowType)
+                    .topN({order, "c0"}, 100, true)
+                    .localMerge({order, "c0"})
+                    .topN({order, "c0"}, 100, false)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kTopNDynamicFilterEnabled, true)
+        .maxDrivers(4)
+        .splits(makeHiveConnectorSplits(filePaths))
+        .assertResults(fmt::format(
+            "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+            "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) "
+            "ORDER BY {}, c0 LIMIT 100",
+            order));
+  }
+}
+
 // Test stats-based skipping for list and map columns that don't have
 // filters themselves. Skipping is driven by a single bigint column.
 TEST_F(TableScanTest, statsBasedSkippingComplexTypes) {
@@ -3629,6 +3742,50 @@ TEST_F(TableScanTest, remainingFilter) {
       "SELECT * FROM tmp WHERE not (c0 > 0 or c1 > c0)");
 }
 
+TEST_F(TableScanTest, remainingFilterProjections) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), DOUBLE()});
+  auto filePaths = makeFilePaths(5);
+  auto vectors = makeVectors(5, 1'000, rowType);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // 'p0' shares 'c2 * 2.0' with the filter. 'p1' reads a column that is used
+  // by neither the filter nor the other outputs.
+  auto makePlan = [&](const core::TypedExprPtr& remainingFilter) {
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        common::SubfieldFilters{},
+        remainingFilter,
+        rowType,
+        std::unordered_map<std::string, std::string>{},
+        std::vector<HiveTableHandle::Projection>{
+            {"p0", parseExpr("c2 * 2.0", rowType)},
+            {"p1", parseExpr("c1 % 7", rowType)}});
+    return PlanBuilder(pool_.get())
+        .startTableScan()
+        .outputType(ROW({"c0", "p0", "p1"}, {INTEGER(), DOUBLE(), INTEGER()}))
+        .tableHandle(tableHandle)
+        .assignments({{"c0", regularColumn("c0", INTEGER())}})
+        .endTableScan()
+        .project({"c0", "p0 + 1.0", "p1"})
+        .planNode();
+  };
+
+  assertQuery(
+      makePlan(parseExpr("c2 * 2.0 > 0.5", rowType)),
+      filePaths,
+      "SELECT c0, c2 * 2.0 + 1.0, c1 % 7 FROM tmp WHERE c2 * 2.0 > 0.5");
+  // The projections are also computed without a remaining filter.
+  assertQuery(
+      makePlan(nullptr),
+      filePaths,
+      "SELECT c0, c2 * 2.0 + 1.0, c1 % 7 FROM tmp");
+}
+
 TEST_F(TableScanTest, remainingFilterLazyWithMultiReferences) {
   constexpr int kSize = 10;
   auto vector = makeRowVector({
@@ -5146,6 +5303,18 @@ TEST_F(TableScanTest, readFlatMapAsStruct) {
           c0->childAt(1),
       })});
   AssertQueryBuilder(plan).split(split).assertResults(expected);
+
+  // None of the keys are in the file.
+  readSchema = ROW({"c0"}, {ROW({"4", "5"}, {BIGINT(), BIGINT()})});
+  plan = PlanBuilder().tableScan(readSchema, {}, "", writeSchema).planNode();
+  split = makeHiveConnectorSplit(file->getPath());
+  expected = makeRowVector({makeRowVector(
+      {"4", "5"},
+      {
+          makeNullConstant(TypeKind::BIGINT, kSize),
+          makeNullConstant(TypeKind::BIGINT, kSize),
+      })});
+  AssertQueryBuilder(plan).split(split).assertResults(expected);
 }
 
 TEST_F(TableScanTest, dynamicFilters) {
@@ -5671,6 +5840,159 @@ TEST_F(TableScanTest, footerIOCount) {
   ASSERT_GT(stats.at("footerBufferOverread").sum, 0);
 }
 
+TEST_F(TableScanTest, splitResultCache) {
+  resetHiveConnector(std::make_shared<config::ConfigBase>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kSplitResultCacheMaxBytes, "64MB"}}));
+  auto* cache = std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+                    connector::getConnector(kHiveConnectorId))
+                    ->splitResultCache();
+  ASSERT_NE(cache, nullptr);
+
+  auto vectors = makeVectors(2, 1'000);
+  auto filePaths = makeFilePaths(vectors.size());
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  const auto makeSplits = [&](int64_t modificationTime) {
+    connector::hive::FileProperties properties;
+    properties.modificationTime = modificationTime;
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                           .fileProperties(properties)
+                           .build());
+    }
+    return splits;
+  };
+  const auto runQuery = [&](const std::string& filter,
+                            int64_t modificationTime,
+                            bool cacheEnabled) {
+    auto plan =
+        PlanBuilder().tableScan(rowType_, {"c0 > 0"}, filter).planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .splits(makeSplits(modificationTime))
+                    .connectorSessionProperty(
+                        kHiveConnectorId,
+                        connector::hive::HiveConfig::
+                            kSplitResultCacheEnabledSession,
+                        cacheEnabled ? "true" : "false")
+                    .assertResults(fmt::format(
+                        "SELECT * FROM tmp WHERE c0 > 0 AND {}", filter));
+    const auto stats = getTableScanRuntimeStats(task);
+    const auto it = stats.find("numSplitResultCacheHits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  ASSERT_EQ(runQuery("c1 % 2 = 0", 1, true), 0);
+  ASSERT_EQ(cache->stats().numElements, 2);
+  ASSERT_EQ(runQuery("c1 % 2 = 0", 1, true), 2);
+
+  // A different filter, a modified file or a disabled cache do not hit.
+  ASSERT_EQ(runQuery("c1 % 3 = 0", 1, true), 0);
+  ASSERT_EQ(cache->stats().numElements, 4);
+  ASSERT_EQ(runQuery("c1 % 2 = 0", 2, true), 0);
+  ASSERT_EQ(cache->stats().numElements, 6);
+  ASSERT_EQ(runQuery("c1 % 2 = 0", 1, false), 0);
+  ASSERT_EQ(runQuery("c1 % 2 = 0", 1, true), 2);
+
+  // The memory arbitrator reclaims the memory of the cached results.
+  auto* rootPool = cache->pool()->root();
+  ASSERT_GT(rootPool->reclaimableBytes().value(), 0);
+  memory::MemoryReclaimer::Stats reclaimStats;
+  ASSERT_GT(rootPool->reclaim(0, 0, reclaimStats), 0);
+  ASSERT_EQ(cache->stats().numElements, 0);
+  ASSERT_EQ(cache->pool()->usedBytes(), 0);
+}
+
+TEST_F(TableScanTest, statsAggregates) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), BIGINT()});
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(
+             1'000,
+             [&](auto row) { return row * (i + 1) - 300; },
+             nullEvery(7)),
+         makeFlatVector<std::string>(
+             1'000, [&](auto row) { return fmt::format("{}", row + i); }),
+         makeFlatVector<int64_t>(1'000, folly::identity)}));
+  }
+  auto filePaths = makeFilePaths(vectors.size());
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  using Kind = HiveTableHandle::StatsAggregate::Kind;
+  const auto runQuery = [&](int64_t c2Lower, bool withVarchar) {
+    std::vector<HiveTableHandle::StatsAggregate> aggregates = {
+        {"cnt", Kind::kCount, ""},
+        {"nn", Kind::kCount, "c0"},
+        {"nulls", Kind::kNullCount, "c0"},
+        {"mn", Kind::kMin, "c0"},
+        {"mx", Kind::kMax, "c0"}};
+    auto outputType =
+        ROW({"cnt", "nn", "nulls", "mn", "mx"},
+            {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+    if (withVarchar) {
+      aggregates.push_back({"s", Kind::kMax, "c1"});
+      outputType = ROW(
+          {"cnt", "nn", "nulls", "mn", "mx", "s"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+    }
+    // Folds the aggregates of the splits.
+    std::vector<std::string> finalAggregates = {
+        "sum(cnt)", "sum(nn)", "sum(nulls)", "min(mn)", "max(mx)"};
+    if (withVarchar) {
+      finalAggregates.push_back("max(s)");
+    }
+    auto tableHandle = std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        SubfieldFiltersBuilder()
+            .add("c2", greaterThanOrEqual(c2Lower))
+            .build(),
+        nullptr,
+        rowType,
+        std::unordered_map<std::string, std::string>{},
+        std::vector<HiveTableHandle::Projection>{},
+        aggregates);
+    auto plan = PlanBuilder(pool_.get())
+                    .startTableScan()
+                    .outputType(outputType)
+                    .tableHandle(tableHandle)
+                    .assignments(
+                        {{"c0", regularColumn("c0", BIGINT())},
+                         {"c1", regularColumn("c1", VARCHAR())}})
+                    .endTableScan()
+                    .singleAggregation({}, finalAggregates)
+                    .planNode();
+    auto task = assertQuery(
+        plan,
+        filePaths,
+        fmt::format(
+            "SELECT count(*), count(c0), count(*) - count(c0), min(c0), "
+            "max(c0){} FROM tmp WHERE c2 >= {}",
+            withVarchar ? ", max(c1)" : "",
+            c2Lower));
+    const auto stats = getTableScanRuntimeStats(task);
+    const auto it = stats.find("numFileStatsAggregateSplits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  // All rows pass the filter on the file statistics, so no data is read.
+  ASSERT_EQ(runQuery(0, false), 3);
+  // Some rows do not pass the filter.
+  ASSERT_EQ(runQuery(500, false), 0);
+  // The statistics of strings are not used.
+  ASSERT_EQ(runQuery(0, true), 0);
+}
+
 TEST_F(TableScanTest, statsBasedFilterReorderDisabled) {
   gflags::FlagSaver gflagSaver;
   // Disable prefetch to avoid test flakiness.
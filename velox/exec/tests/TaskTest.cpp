@@ -16,6 +16,7 @@
 
 #include "velox/exec/Task.h"
 #include "folly/experimental/EventCount.h"
+#include "folly/json.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -2456,4 +2457,188 @@ TEST_F(TaskTest, finishTiming) {
   ASSERT_GT(
       orderByStats.finishTiming.wallNanos, projectStats.finishTiming.wallNanos);
 }
+
+TEST_F(TaskTest, operatorStackSampling) {
+  process::StackSampler::start(1'000);
+  SCOPE_EXIT {
+    process::StackSampler::stop();
+  };
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return (row * 7'919) % 10'000; }),
+  });
+  core::PlanNodeId orderById;
+  auto plan = PlanBuilder()
+                  .values({data}, false, 100)
+                  .orderBy({"c0"}, false)
+                  .capturePlanNodeId(orderById)
+                  .planNode();
+
+  for (bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kOperatorStackSamplingEnabled,
+            enabled ? "true" : "false")
+        .copyResults(pool(), task);
+    const auto foldedStacks = task->taskStats().foldedStacks;
+    if (!enabled) {
+      ASSERT_TRUE(foldedStacks.empty());
+      continue;
+    }
+    // Sorting 1M rows takes many samples in the OrderBy.
+    ASSERT_EQ(foldedStacks.count(orderById), 1);
+    for (const auto& [planNodeId, stacks] : foldedStacks) {
+      ASSERT_FALSE(stacks.empty());
+      // Each line is a stack followed by its number of samples.
+      ASSERT_EQ(stacks.back(), '\n');
+      const auto lastLine =
+          stacks.substr(stacks.rfind('\n', stacks.size() - 2) + 1);
+      ASSERT_GT(std::stoll(lastLine.substr(lastLine.rfind(' ') + 1)), 0);
+    }
+  }
+}
+
+TEST_F(TaskTest, timeline) {
+  TaskTimeline timeline(3);
+  for (auto i = 0; i < 5; ++i) {
+    TaskTimeline::Event event;
+    event.kind = TaskTimeline::Event::Kind::kOnThread;
+    event.pipelineId = 0;
+    event.driverId = i;
+    event.operatorId = 0;
+    event.startUs = i * 10;
+    event.endUs = i * 10 + 5;
+    timeline.add(event);
+  }
+  // Keeps the last 3 events in order.
+  auto events = timeline.events();
+  ASSERT_EQ(events.size(), 3);
+  ASSERT_EQ(timeline.numDropped(), 2);
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_EQ(events[i].driverId, i + 2);
+  }
+
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({data}, true, 10)
+                  .project({"c0 AS t0"})
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({data}, true)
+                          .project({"c0 AS u0"})
+                          .planNode(),
+                      "",
+                      {"t0", "u0"})
+                  .planNode();
+
+  for (uint32_t capacity : {0, 10'000}) {
+    SCOPED_TRACE(fmt::format("capacity: {}", capacity));
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kTaskTimelineCapacity, std::to_string(capacity))
+        .maxDrivers(2)
+        .copyResults(pool(), task);
+    if (capacity == 0) {
+      ASSERT_EQ(task->timeline(), nullptr);
+      ASSERT_TRUE(task->timelineTrace().empty());
+      continue;
+    }
+    ASSERT_NE(task->timeline(), nullptr);
+    ASSERT_EQ(task->timeline()->numDropped(), 0);
+    std::set<std::pair<int32_t, int32_t>> runDrivers;
+    for (const auto& event : task->timeline()->events()) {
+      ASSERT_LE(event.startUs, event.endUs);
+      switch (event.kind) {
+        case TaskTimeline::Event::Kind::kOnThread:
+          ASSERT_GE(event.operatorId, 0);
+          ASSERT_EQ(event.reason, BlockingReason::kNotBlocked);
+          runDrivers.emplace(event.pipelineId, event.driverId);
+          break;
+        case TaskTimeline::Event::Kind::kQueued:
+          ASSERT_EQ(event.operatorId, -1);
+          break;
+        case TaskTimeline::Event::Kind::kBlocked:
+          ASSERT_GE(event.operatorId, 0);
+          ASSERT_NE(event.reason, BlockingReason::kNotBlocked);
+          break;
+      }
+    }
+    // Both drivers of the probe and build pipelines ran.
+    ASSERT_EQ(runDrivers.size(), 4);
+
+    const auto trace = folly::parseJson(task->timelineTrace());
+    ASSERT_EQ(trace["otherData"]["taskId"].asString(), task->taskId());
+    int32_t numIntervals{0};
+    int32_t numProcessNames{0};
+    for (const auto& event : trace["traceEvents"]) {
+      if (event["ph"] == "X") {
+        ++numIntervals;
+      } else if (event["name"] == "process_name") {
+        ++numProcessNames;
+      }
+    }
+    ASSERT_EQ(numIntervals, task->timeline()->events().size());
+    ASSERT_EQ(numProcessNames, 2);
+  }
+}
+
+TEST_F(TaskTest, taskQueueBackpressure) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  const auto bytes = data->retainedSize();
+  TaskQueue queue(2 * bytes, pool_);
+  queue.setNumProducers(1);
+
+  ContinueFuture future;
+  ASSERT_EQ(queue.enqueue(data, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(queue.enqueue(data, &future), BlockingReason::kNotBlocked);
+  // The producer blocks once the queue is over its size.
+  ASSERT_EQ(queue.enqueue(data, &future), BlockingReason::kWaitForConsumer);
+  ASSERT_FALSE(future.isReady());
+  ASSERT_EQ(queue.peakBytes(), 3 * bytes);
+
+  // The queue hands over the vector that was added.
+  ASSERT_EQ(queue.dequeue().get(), data.get());
+  ASSERT_FALSE(future.isReady());
+  queue.dequeue();
+  // The producer continues when the queue is below half its size.
+  ASSERT_TRUE(future.isReady());
+
+  // Closing the queue releases the queued results.
+  const auto useCount = data.use_count();
+  queue.close();
+  ASSERT_EQ(data.use_count(), useCount - 1);
+  ASSERT_FALSE(queue.hasNext());
+  ASSERT_EQ(queue.dequeue(), nullptr);
+}
+
+TEST_F(TaskTest, cursorWithoutCopy) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+
+  CursorParameters params;
+  params.planNode = PlanBuilder().values({data}, false, 200).planNode();
+  params.copyResult = false;
+  params.bufferedBytes = 4 * data->retainedSize();
+  auto cursor = TaskCursor::create(params);
+
+  int64_t numRows = 0;
+  while (cursor->moveNext()) {
+    // The consumer is slower than the task, which blocks on the queue.
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    numRows += cursor->current()->size();
+  }
+  ASSERT_EQ(numRows, 200 * 1'000);
+  ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
+
+  const auto stats = cursor->task()->taskStats().pipelineStats;
+  ASSERT_FALSE(stats.empty());
+  ASSERT_GT(stats[0].operatorStats.back().blockedWallNanos, 0);
+}
 } // namespace facebook::velox::exec::test
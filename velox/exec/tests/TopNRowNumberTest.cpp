@@ -16,6 +16,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -243,6 +244,54 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_F(TopNRowNumberTest, prefixSortKeys) {
+  const vector_size_t size = 3'000;
+  auto data = split(
+      makeRowVector(
+          {"p", "s", "t"},
+          {
+              makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+              // Strings share a prefix longer than the normalized string
+              // prefix.
+              makeFlatVector<std::string>(
+                  size,
+                  [](auto row) {
+                    return std::string(40, 'a' + row % 3) +
+                        std::to_string(row % 37);
+                  },
+                  nullEvery(17)),
+              makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          }),
+      6);
+
+  createDuckDbTable(data);
+
+  for (const auto& order : {"NULLS LAST", "DESC NULLS FIRST"}) {
+    SCOPED_TRACE(order);
+    const auto sortingKey = fmt::format("s {}", order);
+    for (const auto& partitionKeys :
+         {std::vector<std::string>{"p"}, std::vector<std::string>{}}) {
+      core::PlanNodeId topNRowNumberId;
+      auto plan = PlanBuilder()
+                      .values(data)
+                      .topNRowNumber(partitionKeys, {sortingKey, "t"}, 20, true)
+                      .capturePlanNodeId(topNRowNumberId)
+                      .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .assertResults(fmt::format(
+                  "SELECT * FROM (SELECT *, row_number() over "
+                  "({} order by {}, t) as rn FROM tmp) WHERE rn <= 20",
+                  partitionKeys.empty() ? "" : "partition by p",
+                  sortingKey));
+
+      auto taskStats = exec::toPlanStats(task->taskStats());
+      const auto& stats = taskStats.at(topNRowNumberId);
+      ASSERT_GT(stats.customStats.at(PrefixSort::kNumPrefixSortKeys).sum, 0);
+    }
+  }
+}
+
 TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   auto data = makeRowVector(
       {"p", "s"},
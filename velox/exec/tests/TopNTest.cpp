@@ -215,6 +215,28 @@ TEST_F(TopNTest, varchar) {
   testSingleKey(vectors, "c2", 200);
 }
 
+// Strings that share a prefix longer than the normalized string prefix, so
+// that prefix ties fall back to the full comparison.
+TEST_F(TopNTest, longStringPrefix) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<std::string>(
+        batchSize,
+        [&](vector_size_t row) {
+          return std::string(40, 'a' + row % 3) +
+              std::to_string((batchSize * i + row) % 97);
+        },
+        nullEvery(13));
+    auto c1 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return batchSize * i + row; });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  testTwoKeys(vectors, "c0", "c1", 300);
+}
+
 TEST_F(TopNTest, multiBatch) {
   vector_size_t batchSize = 1'000;
   std::vector<RowVectorPtr> vectors;
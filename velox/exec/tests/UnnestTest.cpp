@@ -476,6 +476,82 @@ TEST_P(UnnestTest, batchSize) {
   ASSERT_EQ(expectedNumVectors, stats.at(unnestId).outputVectors);
 }
 
+TEST_P(UnnestTest, adaptiveBatchSize) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+
+  // Unnest 1K rows into 3K rows.
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .project({"sequence(1, 3) as s"})
+                  .unnest({}, {"s"})
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(1'000 * 3, [](auto row) { return 1 + row % 3; }),
+  });
+
+  auto numOutputVectors = [&](uint64_t cacheBytes) {
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(batchSize_))
+                    .config(
+                        core::QueryConfig::kAdaptiveOutputBatchCacheBytes,
+                        std::to_string(cacheBytes))
+                    .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+    EXPECT_EQ(3'000, stats.at(unnestId).outputRows);
+    return stats.at(unnestId).outputVectors;
+  };
+
+  // All the rows fit in the budget. The batch size is max_output_batch_rows.
+  ASSERT_EQ(1, numOutputVectors(1UL << 30));
+
+  // No row fits in the budget. The batches have one row.
+  ASSERT_EQ(3'000, numOutputVectors(1));
+}
+
+TEST_P(UnnestTest, largeArraySlices) {
+  // Two large arrays whose elements are consecutive in the elements vector.
+  // Each output batch holds a contiguous range of elements, which is returned
+  // as a slice of the elements vector rather than a copy.
+  const vector_size_t arraySize = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({10, 20}),
+      makeArrayVector<int32_t>(
+          2,
+          [&](auto /*row*/) { return arraySize; },
+          [&](auto row, auto index) { return row * arraySize + index; }),
+  });
+
+  auto plan = PlanBuilder().values({data}).unnest({"c0"}, {"c1"}).planNode();
+  auto [cursor, results] = readCursor(makeCursorParameters(plan), [](Task*) {});
+
+  vector_size_t numRows = 0;
+  for (const auto& result : results) {
+    ASSERT_LE(result->size(), batchSize_);
+    const auto& elements = result->childAt(1);
+    ASSERT_EQ(elements->encoding(), VectorEncoding::Simple::FLAT);
+    auto* flatElements = elements->asFlatVector<int32_t>();
+    const auto& replicated = result->childAt(0);
+    if (numRows / arraySize == (numRows + result->size() - 1) / arraySize) {
+      // All rows come from the same input row.
+      ASSERT_TRUE(replicated->isConstantEncoding());
+    }
+    for (auto i = 0; i < result->size(); ++i, ++numRows) {
+      ASSERT_EQ(flatElements->valueAt(i), numRows);
+      ASSERT_EQ(
+          replicated->as<SimpleVector<int64_t>>()->valueAt(i),
+          10 * (1 + numRows / arraySize));
+    }
+  }
+  ASSERT_EQ(numRows, 2 * arraySize);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     UnnestTest,
     UnnestTest,
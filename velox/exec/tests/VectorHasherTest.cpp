@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/VectorHasher.h"
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/type/Type.h"
@@ -25,6 +26,8 @@ using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
 
+DECLARE_bool(velox_cache_string_hashes);
+
 class VectorHasherTest : public testing::Test, public VectorTestBase {
  protected:
   static void SetUpTestCase() {
@@ -227,6 +230,91 @@ TEST_F(VectorHasherTest, flat) {
   }
 }
 
+TEST_F(VectorHasherTest, strings) {
+  // Covers the inlined strings that are hashed a batch at a time and the
+  // longer ones, in the same batches.
+  auto vector = makeFlatVector<std::string>(
+      100,
+      [](auto row) { return std::string(row % 23, 'a' + row % 26); },
+      nullEvery(7));
+  auto* strings = vector->asFlatVector<StringView>();
+  auto expectedHash = [&](auto row) {
+    return strings->isNullAt(row)
+        ? exec::VectorHasher::kNullHash
+        : folly::hasher<StringView>()(strings->valueAt(row));
+  };
+
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  raw_vector<uint64_t> hashes(100);
+  std::fill(hashes.begin(), hashes.end(), 0);
+  hasher->decode(*vector, oddRows_);
+  hasher->hash(oddRows_, false, hashes);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(hashes[i], i % 2 == 0 ? 0 : expectedHash(i)) << "at " << i;
+  }
+
+  hasher->decode(*vector, allRows_);
+  hasher->hash(allRows_, true, hashes);
+  for (auto i = 0; i < 100; ++i) {
+    const auto expected = i % 2 == 0 ? expectedHash(i)
+                                     : bits::hashMix(
+                                           expectedHash(i), expectedHash(i));
+    EXPECT_EQ(hashes[i], expected) << "at " << i;
+  }
+}
+
+TEST_F(VectorHasherTest, cachedStringHashes) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_cache_string_hashes = true;
+  auto vector = makeFlatVector<std::string>(
+      100,
+      [](auto row) { return fmt::format("string {}", row % 17); },
+      nullEvery(5));
+  auto* strings = vector->asFlatVector<StringView>();
+  raw_vector<uint64_t> cached(100);
+  ASSERT_FALSE(strings->getCachedHashes(allRows_, cached.data()));
+
+  // The first hasher caches the hashes of 'oddRows_'.
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  raw_vector<uint64_t> hashes(100);
+  hasher->decode(*vector, oddRows_);
+  hasher->hash(oddRows_, false, hashes);
+  ASSERT_TRUE(strings->getCachedHashes(oddRows_, cached.data()));
+  ASSERT_FALSE(strings->getCachedHashes(allRows_, cached.data()));
+  oddRows_.applyToSelected([&](auto row) {
+    EXPECT_EQ(cached[row], hashes[row]) << "at " << row;
+    EXPECT_EQ(
+        hashes[row],
+        strings->isNullAt(row)
+            ? exec::VectorHasher::kNullHash
+            : folly::hasher<StringView>()(strings->valueAt(row)));
+  });
+
+  // Another hasher, e.g. of the next operator, fills in the other rows.
+  auto otherHasher = exec::VectorHasher::create(VARCHAR(), 1);
+  raw_vector<uint64_t> otherHashes(100);
+  otherHasher->decode(*vector, allRows_);
+  otherHasher->hash(allRows_, false, otherHashes);
+  ASSERT_TRUE(strings->getCachedHashes(allRows_, cached.data()));
+  oddRows_.applyToSelected([&](auto row) {
+    EXPECT_EQ(otherHashes[row], hashes[row]) << "at " << row;
+  });
+
+  // Rewriting rows clears their hashes.
+  SelectivityVector firstRows(10);
+  auto source = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("new {}", row); });
+  strings->copy(source.get(), firstRows, nullptr);
+  ASSERT_FALSE(strings->getCachedHashes(allRows_, cached.data()));
+  SelectivityVector lastRows(100, false);
+  lastRows.setValidRange(10, 100, true);
+  lastRows.updateBounds();
+  ASSERT_TRUE(strings->getCachedHashes(lastRows, cached.data()));
+
+  strings->prepareForReuse();
+  ASSERT_FALSE(strings->getCachedHashes(lastRows, cached.data()));
+}
+
 TEST_F(VectorHasherTest, nans) {
   // Sanity check to ensure the NaNs are correctly hashed, that is, all NaNs are
   // considered equal and therefore should have the same hash.
@@ -19,6 +19,7 @@
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/RowsStreamingWindowBuild.h"
 #include "velox/exec/SortWindowBuild.h"
+#include "velox/exec/Window.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -750,5 +751,61 @@ TEST_F(WindowTest, NaNFrameBound) {
   }
 }
 
+TEST_F(WindowTest, parallelPartition) {
+  const vector_size_t size = 1'000;
+  // The peers have the same payload and frame offset so that the results do
+  // not depend on the order of the rows in a peer group.
+  auto data = makeRowVector(
+      {"d", "p", "s", "k"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row / 14 * 3; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 2; }),
+          // Sorting key with peer groups that span output batches.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 14; }),
+          // Frame offset.
+          makeFlatVector<int64_t>(size, [](auto row) { return row / 14 % 5; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "sum(d) over (partition by p order by s)",
+      "avg(d) over (partition by p order by s "
+      "rows between 3 preceding and 2 following)",
+      "count(d) over (partition by p order by s "
+      "rows between k preceding and current row)",
+      "max(d) over (partition by p order by s "
+      "range between current row and unbounded following)",
+  };
+
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  const auto sql =
+      fmt::format("SELECT *, {} FROM tmp", folly::join(", ", functions));
+  for (const auto& parallelism : {"1", "4"}) {
+    SCOPED_TRACE(fmt::format("parallelism: {}", parallelism));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(core::QueryConfig::kPreferredOutputBatchRows, "10")
+                    .config(core::QueryConfig::kMaxOutputBatchRows, "10")
+                    .config(core::QueryConfig::kWindowParallelism, parallelism)
+                    .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& customStats = taskStats.at(windowId).customStats;
+    if (std::string(parallelism) == "1") {
+      ASSERT_EQ(customStats.count(Window::kParallelBatches), 0);
+    } else {
+      ASSERT_GT(customStats.at(Window::kParallelBatches).sum, 0);
+    }
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -99,7 +99,10 @@ class LocalExchangeSource : public exec::ExchangeSource {
           continue;
         }
         totalBytes += inputPage->length();
-        inputPage->unshare();
+        // The producer and the consumer are in the same process, so the page
+        // shares the producer's buffers instead of being copied. The buffers
+        // stay accounted to the producer's pool and the page's release
+        // callback keeps the producer task alive until the page is consumed.
         pages.push_back(std::make_unique<SerializedPage>(std::move(inputPage)));
         inputPage = nullptr;
       }
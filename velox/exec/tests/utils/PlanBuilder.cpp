@@ -17,6 +17,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
 #include "velox/connectors/tpch/TpchConnector.h"
 #include "velox/duckdb/conversion/DuckParser.h"
 #include "velox/exec/Aggregate.h"
@@ -134,6 +135,33 @@ PlanBuilder& PlanBuilder::tpchTableScan(
       .endTableScan();
 }
 
+PlanBuilder& PlanBuilder::tpcdsTableScan(
+    tpcds::Table table,
+    std::vector<std::string> columnNames,
+    double scaleFactor,
+    std::string_view connectorId) {
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignmentsMap;
+  std::vector<TypePtr> outputTypes;
+
+  assignmentsMap.reserve(columnNames.size());
+  outputTypes.reserve(columnNames.size());
+
+  for (const auto& columnName : columnNames) {
+    assignmentsMap.emplace(
+        columnName,
+        std::make_shared<connector::tpcds::TpcdsColumnHandle>(columnName));
+    outputTypes.emplace_back(tpcds::resolveTpcdsColumn(table, columnName));
+  }
+  auto rowType = ROW(std::move(columnNames), std::move(outputTypes));
+  return TableScanBuilder(*this)
+      .outputType(rowType)
+      .tableHandle(std::make_shared<connector::tpcds::TpcdsTableHandle>(
+          std::string(connectorId), table, scaleFactor))
+      .assignments(assignmentsMap)
+      .endTableScan();
+}
+
 PlanBuilder::TableScanBuilder& PlanBuilder::TableScanBuilder::subfieldFilters(
     std::vector<std::string> subfieldFilters) {
   subfieldFilters_.clear();
@@ -2132,6 +2160,21 @@ PlanBuilder& PlanBuilder::rowNumber(
     const std::vector<std::string>& partitionKeys,
     std::optional<int32_t> limit,
     const bool generateRowNumber) {
+  return rowNumber(partitionKeys, limit, generateRowNumber, false);
+}
+
+PlanBuilder& PlanBuilder::streamingRowNumber(
+    const std::vector<std::string>& partitionKeys,
+    std::optional<int32_t> limit,
+    const bool generateRowNumber) {
+  return rowNumber(partitionKeys, limit, generateRowNumber, true);
+}
+
+PlanBuilder& PlanBuilder::rowNumber(
+    const std::vector<std::string>& partitionKeys,
+    std::optional<int32_t> limit,
+    bool generateRowNumber,
+    bool preGrouped) {
   std::optional<std::string> rowNumberColumnName;
   if (generateRowNumber) {
     rowNumberColumnName = "row_number";
@@ -2141,7 +2184,8 @@ PlanBuilder& PlanBuilder::rowNumber(
       fields(partitionKeys),
       rowNumberColumnName,
       limit,
-      planNode_);
+      planNode_,
+      preGrouped);
   return *this;
 }
 
@@ -2171,13 +2215,26 @@ PlanBuilder& PlanBuilder::topNRowNumber(
 PlanBuilder& PlanBuilder::markDistinct(
     std::string markerKey,
     const std::vector<std::string>& distinctKeys) {
+  return markDistinct(std::move(markerKey), distinctKeys, false);
+}
+
+PlanBuilder& PlanBuilder::streamingMarkDistinct(
+    std::string markerKey,
+    const std::vector<std::string>& distinctKeys) {
+  return markDistinct(std::move(markerKey), distinctKeys, true);
+}
+
+PlanBuilder& PlanBuilder::markDistinct(
+    std::string markerKey,
+    const std::vector<std::string>& distinctKeys,
+    bool preGrouped) {
   VELOX_CHECK_NOT_NULL(planNode_, "MarkDistinct cannot be the source node");
   planNode_ = std::make_shared<core::MarkDistinctNode>(
       nextPlanNodeId(),
       std::move(markerKey),
       fields(planNode_->outputType(), distinctKeys),
-
-      planNode_);
+      planNode_,
+      preGrouped);
   return *this;
 }
 
@@ -30,6 +30,10 @@ namespace facebook::velox::tpch {
 enum class Table : uint8_t;
 }
 
+namespace facebook::velox::tpcds {
+enum class Table : uint8_t;
+}
+
 namespace facebook::velox::exec::test {
 
 /// A builder class with fluent API for building query plans. Plans are built
@@ -109,6 +113,8 @@ class PlanBuilder {
 
   static constexpr const std::string_view kHiveDefaultConnectorId{"test-hive"};
   static constexpr const std::string_view kTpchDefaultConnectorId{"test-tpch"};
+  static constexpr const std::string_view kTpcdsDefaultConnectorId{
+      "test-tpcds"};
 
   ///
   /// TableScan
@@ -185,6 +191,18 @@ class PlanBuilder {
       double scaleFactor = 1,
       std::string_view connectorId = kTpchDefaultConnectorId);
 
+  /// Add a TableScanNode to scan a TPC-DS table.
+  ///
+  /// @param table The TPC-DS table.
+  /// @param columnNames The columns to be returned from that table.
+  /// @param scaleFactor The TPC-DS scale factor.
+  /// @param connectorId The TPC-DS connector id.
+  PlanBuilder& tpcdsTableScan(
+      tpcds::Table table,
+      std::vector<std::string> columnNames,
+      double scaleFactor = 1,
+      std::string_view connectorId = kTpcdsDefaultConnectorId);
+
   /// Helper class to build a custom TableScanNode.
   /// Uses a planBuilder instance to get the next plan id, memory pool, and
   /// parse options.
@@ -1214,6 +1232,13 @@ class PlanBuilder {
       std::optional<int32_t> limit = std::nullopt,
       bool generateRowNumber = true);
 
+  /// Add a RowNumberNode over input that is already grouped on
+  /// 'partitionKeys', i.e. the rows of each partition are consecutive.
+  PlanBuilder& streamingRowNumber(
+      const std::vector<std::string>& partitionKeys,
+      std::optional<int32_t> limit = std::nullopt,
+      bool generateRowNumber = true);
+
   /// Add a TopNRowNumberNode to compute single row_number window function with
   /// a limit applied to sorted partitions.
   PlanBuilder& topNRowNumber(
@@ -1229,6 +1254,12 @@ class PlanBuilder {
       std::string markerKey,
       const std::vector<std::string>& distinctKeys);
 
+  /// Add a MarkDistinctNode over input that is already grouped on
+  /// 'distinctKeys', i.e. rows with the same keys are consecutive.
+  PlanBuilder& streamingMarkDistinct(
+      std::string markerKey,
+      const std::vector<std::string>& distinctKeys);
+
   /// Stores the latest plan node ID into the specified variable. Useful for
   /// capturing IDs of the leaf plan nodes (table scans, exchanges, etc.) to use
   /// when adding splits at runtime.
@@ -1383,6 +1414,23 @@ class PlanBuilder {
       const std::vector<std::string>& windowFunctions,
       bool inputSorted);
 
+  /// Create RowNumberNode that groups the input with a hash table or, if
+  /// 'preGrouped' is true, relies on the input being grouped on
+  /// 'partitionKeys'.
+  PlanBuilder& rowNumber(
+      const std::vector<std::string>& partitionKeys,
+      std::optional<int32_t> limit,
+      bool generateRowNumber,
+      bool preGrouped);
+
+  /// Create MarkDistinctNode that groups the input with a hash table or, if
+  /// 'preGrouped' is true, relies on the input being grouped on
+  /// 'distinctKeys'.
+  PlanBuilder& markDistinct(
+      std::string markerKey,
+      const std::vector<std::string>& distinctKeys,
+      bool preGrouped);
+
  protected:
   core::PlanNodePtr planNode_;
   parse::ParseOptions options_;
@@ -0,0 +1,829 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+
+using tpcds::Table;
+
+namespace {
+
+std::vector<std::string> mergeColumnNames(
+    std::vector<std::string> first,
+    const std::vector<std::string>& second) {
+  first.insert(first.end(), second.begin(), second.end());
+  return first;
+}
+
+void collectScanNodeIds(
+    const core::PlanNodePtr& node,
+    std::vector<core::PlanNodeId>& ids) {
+  if (std::dynamic_pointer_cast<const core::TableScanNode>(node)) {
+    ids.push_back(node->id());
+  }
+  for (const auto& source : node->sources()) {
+    collectScanNodeIds(source, ids);
+  }
+}
+
+// The store_sales measures averaged by Q7 and Q27.
+const std::vector<std::string> kAveragedMeasures{
+    "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+
+const std::vector<std::string> kAverages{
+    "avg(ss_quantity) AS agg1",
+    "avg(ss_list_price) AS agg2",
+    "avg(ss_coupon_amt) AS agg3",
+    "avg(ss_sales_price) AS agg4"};
+
+const std::string kSelectedDemographics =
+    "cd_gender = 'M' AND cd_marital_status = 'S' "
+    "AND cd_education_status = 'College'";
+
+} // namespace
+
+// static
+const std::vector<int>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int> kQueryIds{3, 7, 19, 27, 36, 42, 89, 98};
+  return kQueryIds;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 19:
+      return getQ19Plan();
+    case 27:
+      return getQ27Plan();
+    case 36:
+      return getQ36Plan();
+    case 42:
+      return getQ42Plan();
+    case 89:
+      return getQ89Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+PlanBuilder TpcdsQueryBuilder::scan(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    Table table,
+    const std::vector<std::string>& columns) const {
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder.tpcdsTableScan(table, columns, scaleFactor_, connectorId_);
+  return builder;
+}
+
+TpcdsPlan TpcdsQueryBuilder::makePlan(core::PlanNodePtr plan) const {
+  TpcdsPlan tpcdsPlan;
+  collectScanNodeIds(plan, tpcdsPlan.scanNodeIds);
+  tpcdsPlan.plan = std::move(plan);
+  return tpcdsPlan;
+}
+
+// SELECT dt.d_year, i_brand_id brand_id, i_brand brand,
+//        sum(ss_ext_sales_price) sum_agg
+// FROM date_dim dt, store_sales, item
+// WHERE dt.d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk
+//   AND i_manufact_id = 128 AND dt.d_moy = 11
+// GROUP BY dt.d_year, i_brand, i_brand_id
+// ORDER BY dt.d_year, sum_agg DESC, brand_id
+// LIMIT 100
+TpcdsPlan TpcdsQueryBuilder::getQ3Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto item = scan(
+                  planNodeIdGenerator,
+                  Table::TBL_ITEM,
+                  {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"})
+                  .filter("i_manufact_id = 128")
+                  .planNode();
+
+  auto dateDim = scan(
+                     planNodeIdGenerator,
+                     Table::TBL_DATE_DIM,
+                     {"d_date_sk", "d_year", "d_moy"})
+                     .filter("d_moy = 11")
+                     .planNode();
+
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy({"d_year", "sum_agg DESC", "i_brand_id"}, false)
+          .limit(0, 100, false)
+          .project(
+              {"d_year",
+               "i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "sum_agg"})
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT i_item_id, avg(ss_quantity) agg1, avg(ss_list_price) agg2,
+//        avg(ss_coupon_amt) agg3, avg(ss_sales_price) agg4
+// FROM store_sales, customer_demographics, date_dim, item, promotion
+// WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk
+//   AND ss_cdemo_sk = cd_demo_sk AND ss_promo_sk = p_promo_sk
+//   AND cd_gender = 'M' AND cd_marital_status = 'S'
+//   AND cd_education_status = 'College'
+//   AND (p_channel_email = 'N' OR p_channel_event = 'N') AND d_year = 2000
+// GROUP BY i_item_id
+// ORDER BY i_item_id
+// LIMIT 100
+TpcdsPlan TpcdsQueryBuilder::getQ7Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto customerDemographics =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_CUSTOMER_DEMOGRAPHICS,
+          {"cd_demo_sk",
+           "cd_gender",
+           "cd_marital_status",
+           "cd_education_status"})
+          .filter(kSelectedDemographics)
+          .planNode();
+
+  auto dateDim =
+      scan(planNodeIdGenerator, Table::TBL_DATE_DIM, {"d_date_sk", "d_year"})
+          .filter("d_year = 2000")
+          .planNode();
+
+  auto promotion =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_PROMOTION,
+          {"p_promo_sk", "p_channel_email", "p_channel_event"})
+          .filter("p_channel_email = 'N' OR p_channel_event = 'N'")
+          .planNode();
+
+  auto item =
+      scan(planNodeIdGenerator, Table::TBL_ITEM, {"i_item_sk", "i_item_id"})
+          .planNode();
+
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          mergeColumnNames(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_promo_sk"},
+              kAveragedMeasures))
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              customerDemographics,
+              "",
+              mergeColumnNames(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_promo_sk"},
+                  kAveragedMeasures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              mergeColumnNames(
+                  {"ss_item_sk", "ss_promo_sk"}, kAveragedMeasures))
+          .hashJoin(
+              {"ss_promo_sk"},
+              {"p_promo_sk"},
+              promotion,
+              "",
+              mergeColumnNames({"ss_item_sk"}, kAveragedMeasures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              mergeColumnNames({"i_item_id"}, kAveragedMeasures))
+          .partialAggregation({"i_item_id"}, kAverages)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy({"i_item_id"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT i_brand_id brand_id, i_brand brand, i_manufact_id, i_manufact,
+//        sum(ss_ext_sales_price) ext_price
+// FROM date_dim, store_sales, item, customer, customer_address, store
+// WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk
+//   AND i_manager_id = 8 AND d_moy = 11 AND d_year = 1998
+//   AND ss_customer_sk = c_customer_sk AND c_current_addr_sk = ca_address_sk
+//   AND substr(ca_zip, 1, 5) <> substr(s_zip, 1, 5)
+//   AND ss_store_sk = s_store_sk
+// GROUP BY i_brand, i_brand_id, i_manufact_id, i_manufact
+// ORDER BY ext_price DESC, i_brand, i_brand_id, i_manufact_id, i_manufact
+// LIMIT 100
+TpcdsPlan TpcdsQueryBuilder::getQ19Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const std::vector<std::string> itemColumns{
+      "i_brand_id", "i_brand", "i_manufact_id", "i_manufact"};
+
+  auto item = scan(
+                  planNodeIdGenerator,
+                  Table::TBL_ITEM,
+                  mergeColumnNames({"i_item_sk", "i_manager_id"}, itemColumns))
+                  .filter("i_manager_id = 8")
+                  .planNode();
+
+  auto dateDim = scan(
+                     planNodeIdGenerator,
+                     Table::TBL_DATE_DIM,
+                     {"d_date_sk", "d_year", "d_moy"})
+                     .filter("d_moy = 11 AND d_year = 1998")
+                     .planNode();
+
+  auto store =
+      scan(planNodeIdGenerator, Table::TBL_STORE, {"s_store_sk", "s_zip"})
+          .planNode();
+
+  auto customerAddress = scan(
+                             planNodeIdGenerator,
+                             Table::TBL_CUSTOMER_ADDRESS,
+                             {"ca_address_sk", "ca_zip"})
+                             .planNode();
+
+  auto customer = scan(
+                      planNodeIdGenerator,
+                      Table::TBL_CUSTOMER,
+                      {"c_customer_sk", "c_current_addr_sk"})
+                      .hashJoin(
+                          {"c_current_addr_sk"},
+                          {"ca_address_sk"},
+                          customerAddress,
+                          "",
+                          {"c_customer_sk", "ca_zip"})
+                      .planNode();
+
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_customer_sk",
+           "ss_store_sk",
+           "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_item_sk",
+               "ss_customer_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              mergeColumnNames(
+                  {"ss_customer_sk", "ss_store_sk", "ss_ext_sales_price"},
+                  itemColumns))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              store,
+              "",
+              mergeColumnNames(
+                  {"ss_customer_sk", "ss_ext_sales_price", "s_zip"},
+                  itemColumns))
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customer,
+              "substr(ca_zip, 1, 5) <> substr(s_zip, 1, 5)",
+              mergeColumnNames({"ss_ext_sales_price"}, itemColumns))
+          .partialAggregation(
+              {"i_brand", "i_brand_id", "i_manufact_id", "i_manufact"},
+              {"sum(ss_ext_sales_price) AS ext_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy(
+              {"ext_price DESC",
+               "i_brand",
+               "i_brand_id",
+               "i_manufact_id",
+               "i_manufact"},
+              false)
+          .limit(0, 100, false)
+          .project(
+              {"i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "i_manufact_id",
+               "i_manufact",
+               "ext_price"})
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT i_item_id, s_state, grouping(s_state) g_state,
+//        avg(ss_quantity) agg1, avg(ss_list_price) agg2,
+//        avg(ss_coupon_amt) agg3, avg(ss_sales_price) agg4
+// FROM store_sales, customer_demographics, date_dim, store, item
+// WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk
+//   AND ss_store_sk = s_store_sk AND ss_cdemo_sk = cd_demo_sk
+//   AND cd_gender = 'M' AND cd_marital_status = 'S'
+//   AND cd_education_status = 'College' AND d_year = 2002
+//   AND s_state IN ('TN', 'TN', 'TN', 'TN', 'TN', 'TN')
+// GROUP BY ROLLUP (i_item_id, s_state)
+// ORDER BY i_item_id, s_state
+// LIMIT 100
+TpcdsPlan TpcdsQueryBuilder::getQ27Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto customerDemographics =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_CUSTOMER_DEMOGRAPHICS,
+          {"cd_demo_sk",
+           "cd_gender",
+           "cd_marital_status",
+           "cd_education_status"})
+          .filter(kSelectedDemographics)
+          .planNode();
+
+  auto dateDim =
+      scan(planNodeIdGenerator, Table::TBL_DATE_DIM, {"d_date_sk", "d_year"})
+          .filter("d_year = 2002")
+          .planNode();
+
+  auto store =
+      scan(planNodeIdGenerator, Table::TBL_STORE, {"s_store_sk", "s_state"})
+          .filter("s_state = 'TN'")
+          .planNode();
+
+  auto item =
+      scan(planNodeIdGenerator, Table::TBL_ITEM, {"i_item_sk", "i_item_id"})
+          .planNode();
+
+  // The rows of the grouping sets (i_item_id, s_state), (i_item_id) and ()
+  // have group_id 0, 1 and 2.
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          mergeColumnNames(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk", "ss_cdemo_sk"},
+              kAveragedMeasures))
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              customerDemographics,
+              "",
+              mergeColumnNames(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"},
+                  kAveragedMeasures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              mergeColumnNames(
+                  {"ss_item_sk", "ss_store_sk"}, kAveragedMeasures))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              store,
+              "",
+              mergeColumnNames({"ss_item_sk", "s_state"}, kAveragedMeasures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              mergeColumnNames({"i_item_id", "s_state"}, kAveragedMeasures))
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              kAveragedMeasures)
+          .partialAggregation({"i_item_id", "s_state", "group_id"}, kAverages)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy({"i_item_id", "s_state"}, false)
+          .limit(0, 100, false)
+          .project(
+              {"i_item_id",
+               "s_state",
+               "CASE WHEN group_id = 0 THEN 0 ELSE 1 END AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT sum(ss_net_profit) / sum(ss_ext_sales_price) AS gross_margin,
+//        i_category, i_class,
+//        grouping(i_category) + grouping(i_class) AS lochierarchy,
+//        rank() OVER (
+//            PARTITION BY grouping(i_category) + grouping(i_class),
+//                CASE WHEN grouping(i_class) = 0 THEN i_category END
+//            ORDER BY sum(ss_net_profit) / sum(ss_ext_sales_price) ASC)
+//            AS rank_within_parent
+// FROM store_sales, date_dim d1, item, store
+// WHERE d1.d_year = 2001 AND d1.d_date_sk = ss_sold_date_sk
+//   AND i_item_sk = ss_item_sk AND s_store_sk = ss_store_sk
+//   AND s_state IN ('TN', 'TN', 'TN', 'TN', 'TN', 'TN', 'TN', 'TN')
+// GROUP BY ROLLUP (i_category, i_class)
+// ORDER BY lochierarchy DESC,
+//     CASE WHEN lochierarchy = 0 THEN i_category END, rank_within_parent
+// LIMIT 100
+TpcdsPlan TpcdsQueryBuilder::getQ36Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto dateDim =
+      scan(planNodeIdGenerator, Table::TBL_DATE_DIM, {"d_date_sk", "d_year"})
+          .filter("d_year = 2001")
+          .planNode();
+
+  auto item = scan(
+                  planNodeIdGenerator,
+                  Table::TBL_ITEM,
+                  {"i_item_sk", "i_category", "i_class"})
+                  .planNode();
+
+  auto store =
+      scan(planNodeIdGenerator, Table::TBL_STORE, {"s_store_sk", "s_state"})
+          .filter("s_state = 'TN'")
+          .planNode();
+
+  // The rows of the grouping sets (i_category, i_class), (i_category) and ()
+  // have group_id 0, 1 and 2, which is the lochierarchy.
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_store_sk",
+           "ss_ext_sales_price",
+           "ss_net_profit"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_item_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price",
+               "ss_net_profit"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              store,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price", "ss_net_profit"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"i_category", "i_class", "ss_ext_sales_price", "ss_net_profit"})
+          .groupId(
+              {"i_category", "i_class"},
+              {{"i_category", "i_class"}, {"i_category"}, {}},
+              {"ss_ext_sales_price", "ss_net_profit"})
+          .partialAggregation(
+              {"i_category", "i_class", "group_id"},
+              {"sum(ss_net_profit) AS net_profit",
+               "sum(ss_ext_sales_price) AS ext_sales_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"net_profit / ext_sales_price AS gross_margin",
+               "i_category",
+               "i_class",
+               "group_id AS lochierarchy",
+               "CASE WHEN group_id = 0 THEN i_category "
+               "ELSE cast(null as varchar) END AS parent_category"})
+          .window(
+              {"rank() over (partition by lochierarchy, parent_category "
+               "order by gross_margin) AS rank_within_parent"})
+          .orderBy(
+              {"lochierarchy DESC", "parent_category", "rank_within_parent"},
+              false)
+          .limit(0, 100, false)
+          .project(
+              {"gross_margin",
+               "i_category",
+               "i_class",
+               "lochierarchy",
+               "rank_within_parent"})
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT dt.d_year, i_category_id, i_category, sum(ss_ext_sales_price)
+// FROM date_dim dt, store_sales, item
+// WHERE dt.d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk
+//   AND i_manager_id = 1 AND dt.d_moy = 11 AND dt.d_year = 2000
+// GROUP BY dt.d_year, i_category_id, i_category
+// ORDER BY sum(ss_ext_sales_price) DESC, dt.d_year, i_category_id, i_category
+// LIMIT 100
+TpcdsPlan TpcdsQueryBuilder::getQ42Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto item = scan(
+                  planNodeIdGenerator,
+                  Table::TBL_ITEM,
+                  {"i_item_sk", "i_category_id", "i_category", "i_manager_id"})
+                  .filter("i_manager_id = 1")
+                  .planNode();
+
+  auto dateDim = scan(
+                     planNodeIdGenerator,
+                     Table::TBL_DATE_DIM,
+                     {"d_date_sk", "d_year", "d_moy"})
+                     .filter("d_moy = 11 AND d_year = 2000")
+                     .planNode();
+
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price", "d_year"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"d_year", "i_category_id", "i_category", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_category_id", "i_category"},
+              {"sum(ss_ext_sales_price) AS total_sales"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy(
+              {"total_sales DESC", "d_year", "i_category_id", "i_category"},
+              false)
+          .limit(0, 100, false)
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT * FROM (
+//   SELECT i_category, i_class, i_brand, s_store_name, s_company_name, d_moy,
+//          sum(ss_sales_price) sum_sales,
+//          avg(sum(ss_sales_price)) OVER (
+//              PARTITION BY i_category, i_brand, s_store_name, s_company_name)
+//              avg_monthly_sales
+//   FROM item, store_sales, date_dim, store
+//   WHERE ss_item_sk = i_item_sk AND ss_sold_date_sk = d_date_sk
+//     AND ss_store_sk = s_store_sk AND d_year IN (1999)
+//     AND ((i_category IN ('Books', 'Electronics', 'Sports')
+//           AND i_class IN ('computers', 'stereo', 'football'))
+//       OR (i_category IN ('Men', 'Jewelry', 'Women')
+//           AND i_class IN ('shirts', 'birdal', 'dresses')))
+//   GROUP BY i_category, i_class, i_brand, s_store_name, s_company_name, d_moy)
+//   tmp1
+// WHERE CASE WHEN avg_monthly_sales <> 0
+//     THEN abs(sum_sales - avg_monthly_sales) / avg_monthly_sales
+//     ELSE NULL END > 0.1
+// ORDER BY sum_sales - avg_monthly_sales, s_store_name
+// LIMIT 100
+//
+// The generator has no 'computers', 'stereo' and 'birdal' classes, which are
+// replaced by 'fiction', 'sports' and 'accessories'.
+TpcdsPlan TpcdsQueryBuilder::getQ89Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const std::vector<std::string> windowKeys{
+      "i_category", "i_brand", "s_store_name", "s_company_name"};
+
+  auto item = scan(
+                  planNodeIdGenerator,
+                  Table::TBL_ITEM,
+                  {"i_item_sk", "i_category", "i_class", "i_brand"})
+                  .filter(
+                      "(i_category IN ('Books', 'Electronics', 'Sports') "
+                      "AND i_class IN ('fiction', 'sports', 'football')) "
+                      "OR (i_category IN ('Men', 'Jewelry', 'Women') "
+                      "AND i_class IN ('shirts', 'accessories', 'dresses'))")
+                  .planNode();
+
+  auto dateDim = scan(
+                     planNodeIdGenerator,
+                     Table::TBL_DATE_DIM,
+                     {"d_date_sk", "d_year", "d_moy"})
+                     .filter("d_year = 1999")
+                     .planNode();
+
+  auto store = scan(
+                   planNodeIdGenerator,
+                   Table::TBL_STORE,
+                   {"s_store_sk", "s_store_name", "s_company_name"})
+                   .planNode();
+
+  // The window partition keys are a subset of the grouping keys so that the
+  // final aggregation and the window run on the same partitions.
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk", "ss_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"ss_sold_date_sk",
+               "ss_store_sk",
+               "ss_sales_price",
+               "i_category",
+               "i_class",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_store_sk",
+               "ss_sales_price",
+               "i_category",
+               "i_class",
+               "i_brand",
+               "d_moy"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              store,
+              "",
+              {"ss_sales_price",
+               "i_category",
+               "i_class",
+               "i_brand",
+               "d_moy",
+               "s_store_name",
+               "s_company_name"})
+          .partialAggregation(
+              {"i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy"},
+              {"sum(ss_sales_price) AS sum_sales"})
+          .localPartition(windowKeys)
+          .finalAggregation()
+          .window(
+              {"avg(sum_sales) over (partition by i_category, i_brand, "
+               "s_store_name, s_company_name) AS avg_monthly_sales"})
+          .filter(
+              "avg_monthly_sales <> 0 AND "
+              "abs(sum_sales - avg_monthly_sales) / avg_monthly_sales > 0.1")
+          .project(
+              {"i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy",
+               "sum_sales",
+               "avg_monthly_sales",
+               "sum_sales - avg_monthly_sales AS sales_delta"})
+          .localPartition(std::vector<std::string>{})
+          .orderBy({"sales_delta", "s_store_name"}, false)
+          .limit(0, 100, false)
+          .project(
+              {"i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy",
+               "sum_sales",
+               "avg_monthly_sales"})
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+// SELECT i_item_id, i_item_desc, i_category, i_class, i_current_price,
+//        sum(ss_ext_sales_price) AS itemrevenue,
+//        sum(ss_ext_sales_price) * 100 / sum(sum(ss_ext_sales_price)) OVER (
+//            PARTITION BY i_class) AS revenueratio
+// FROM store_sales, item, date_dim
+// WHERE ss_item_sk = i_item_sk
+//   AND i_category IN ('Sports', 'Books', 'Home')
+//   AND ss_sold_date_sk = d_date_sk
+//   AND d_date BETWEEN cast('1999-02-22' AS date)
+//       AND (cast('1999-02-22' AS date) + INTERVAL '30' DAY)
+// GROUP BY i_item_id, i_item_desc, i_category, i_class, i_current_price
+// ORDER BY i_category, i_class, i_item_id, i_item_desc, revenueratio
+TpcdsPlan TpcdsQueryBuilder::getQ98Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const std::vector<std::string> itemColumns{
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+
+  auto item = scan(
+                  planNodeIdGenerator,
+                  Table::TBL_ITEM,
+                  mergeColumnNames({"i_item_sk"}, itemColumns))
+                  .filter("i_category IN ('Sports', 'Books', 'Home')")
+                  .planNode();
+
+  auto dateDim =
+      scan(planNodeIdGenerator, Table::TBL_DATE_DIM, {"d_date_sk", "d_date"})
+          .filter("d_date between '1999-02-22'::DATE and '1999-03-24'::DATE")
+          .planNode();
+
+  auto plan =
+      scan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              mergeColumnNames({"ss_ext_sales_price"}, itemColumns))
+          .partialAggregation(
+              itemColumns, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          .localPartition({"i_class"})
+          .finalAggregation()
+          .window(
+              {"sum(itemrevenue) over (partition by i_class) AS class_revenue"})
+          .project(mergeColumnNames(
+              itemColumns,
+              {"itemrevenue",
+               "itemrevenue * 100 / class_revenue AS revenueratio"}))
+          .localPartition(std::vector<std::string>{})
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+
+  return makePlan(std::move(plan));
+}
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Contains the query plan and the ids of its TableScan nodes, which read
+/// TpcdsConnectorSplits.
+struct TpcdsPlan {
+  core::PlanNodePtr plan;
+  std::vector<core::PlanNodeId> scanNodeIds;
+};
+
+/// Builds plans for a representative set of TPC-DS queries over the tables of
+/// the TPC-DS connector. The queries cover the patterns TPC-H does not
+/// exercise: star joins of up to six tables, ROLLUP through GroupId and
+/// window functions over aggregates. The plans follow the query text with
+/// the joins ordered so that the build sides are the filtered dimensions.
+/// Predicates on values that the generator does not produce, e.g. some item
+/// classes, are replaced by values in its domain.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(
+      double scaleFactor,
+      std::string connectorId =
+          std::string(PlanBuilder::kTpcdsDefaultConnectorId))
+      : scaleFactor_(scaleFactor), connectorId_(std::move(connectorId)) {}
+
+  /// Get the query plan for a given TPC-DS query number. Throws if the query
+  /// is not in getQueryIds().
+  TpcdsPlan getQueryPlan(int queryId) const;
+
+  /// Returns the numbers of the supported TPC-DS queries.
+  static const std::vector<int>& getQueryIds();
+
+ private:
+  TpcdsPlan getQ3Plan() const;
+  TpcdsPlan getQ7Plan() const;
+  TpcdsPlan getQ19Plan() const;
+  TpcdsPlan getQ27Plan() const;
+  TpcdsPlan getQ36Plan() const;
+  TpcdsPlan getQ42Plan() const;
+  TpcdsPlan getQ89Plan() const;
+  TpcdsPlan getQ98Plan() const;
+
+  // Returns a builder starting with a scan of 'columns' of 'table'.
+  PlanBuilder scan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      tpcds::Table table,
+      const std::vector<std::string>& columns) const;
+
+  TpcdsPlan makePlan(core::PlanNodePtr plan) const;
+
+  const double scaleFactor_;
+  const std::string connectorId_;
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
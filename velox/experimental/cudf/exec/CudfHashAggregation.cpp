@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/CudfHashAggregation.h"
+#include "velox/experimental/cudf/exec/Utilities.h"
+#include "velox/experimental/cudf/exec/VeloxCudfInterop.h"
+
+#include "velox/exec/Aggregate.h"
+
+#include <cudf/column/column_factories.hpp>
+#include <cudf/groupby.hpp>
+#include <cudf/reduction.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/scalar/scalar_factories.hpp>
+#include <cudf/unary.hpp>
+
+namespace facebook::velox::cudf_velox {
+
+namespace {
+
+// Strips the registration prefix, e.g. 'presto.default.', from the name of
+// an aggregate function.
+std::string_view baseName(std::string_view name) {
+  const auto pos = name.rfind('.');
+  return pos == std::string_view::npos ? name : name.substr(pos + 1);
+}
+
+// Returns true if 'input' of the aggregate function 'name' is a non-null
+// constant argument of a count over raw input.
+bool isCountAll(
+    std::string_view name,
+    const core::TypedExprPtr& input,
+    bool isRawInput) {
+  auto constant =
+      std::dynamic_pointer_cast<const core::ConstantTypedExpr>(input);
+  return name == "count" && isRawInput && constant != nullptr &&
+      !constant->isNull();
+}
+
+// Expects 'type' to be supported by cuDF.
+bool isNumeric(const TypePtr& type) {
+  if (type->isDate()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+std::unique_ptr<T> makeAggregation(
+    CudfHashAggregation::AggregateKind kind,
+    bool countAll) {
+  using AggregateKind = CudfHashAggregation::AggregateKind;
+  switch (kind) {
+    case AggregateKind::kSum:
+      return cudf::make_sum_aggregation<T>();
+    case AggregateKind::kCount:
+      return cudf::make_count_aggregation<T>(
+          countAll ? cudf::null_policy::INCLUDE : cudf::null_policy::EXCLUDE);
+    case AggregateKind::kMin:
+      return cudf::make_min_aggregation<T>();
+    case AggregateKind::kMax:
+      return cudf::make_max_aggregation<T>();
+    case AggregateKind::kAvg:
+      return cudf::make_mean_aggregation<T>();
+  }
+  VELOX_UNREACHABLE();
+}
+
+} // namespace
+
+// static
+bool CudfHashAggregation::isSupported(
+    const core::AggregationNode& aggregationNode) {
+  if (aggregationNode.groupId().has_value() ||
+      !aggregationNode.globalGroupingSets().empty()) {
+    return false;
+  }
+  const auto& inputType = aggregationNode.sources()[0]->outputType();
+  for (const auto& key : aggregationNode.groupingKeys()) {
+    if (!isSupportedCudfType(key->type())) {
+      return false;
+    }
+  }
+  const auto step = aggregationNode.step();
+  const bool isRawInput = exec::isRawInput(step);
+  const auto& outputType = aggregationNode.outputType();
+  const auto numKeys = aggregationNode.groupingKeys().size();
+  for (auto i = 0; i < aggregationNode.aggregates().size(); ++i) {
+    const auto& aggregate = aggregationNode.aggregates()[i];
+    if (aggregate.mask != nullptr || !aggregate.sortingKeys.empty() ||
+        aggregate.distinct) {
+      return false;
+    }
+    const auto name = baseName(aggregate.call->name());
+    if (name != "sum" && name != "count" && name != "min" && name != "max" &&
+        name != "avg") {
+      return false;
+    }
+    // The intermediate result of avg is a (sum, count) struct.
+    if (name == "avg" && step != core::AggregationNode::Step::kSingle) {
+      return false;
+    }
+    const auto& inputs = aggregate.call->inputs();
+    if (inputs.size() > 1 ||
+        (inputs.empty() && !(name == "count" && isRawInput))) {
+      return false;
+    }
+    // count(1) counts all rows like count(*).
+    if (!inputs.empty() && !isCountAll(name, inputs[0], isRawInput)) {
+      if (!std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+              inputs[0]) ||
+          exec::exprToChannel(inputs[0].get(), inputType) ==
+              kConstantChannel) {
+        return false;
+      }
+      const auto& type = inputs[0]->type();
+      if (!isSupportedCudfType(type)) {
+        return false;
+      }
+      if ((name == "sum" || name == "avg") && !isNumeric(type)) {
+        return false;
+      }
+    }
+    if (!isSupportedCudfType(outputType->childAt(numKeys + i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CudfHashAggregation::CudfHashAggregation(
+    int32_t operatorId,
+    exec::DriverCtx* driverCtx,
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode)
+    : exec::Operator(
+          driverCtx,
+          aggregationNode->outputType(),
+          operatorId,
+          aggregationNode->id(),
+          "CudfHashAggregation"),
+      NvtxHelper(nvtx3::rgb{255, 215, 0}, operatorId), // Gold
+      step_(aggregationNode->step()),
+      ignoreNullKeys_(aggregationNode->ignoreNullKeys()) {
+  VELOX_CHECK(isSupported(*aggregationNode));
+  const auto& inputType = aggregationNode->sources()[0]->outputType();
+  groupingKeys_.reserve(aggregationNode->groupingKeys().size());
+  for (const auto& key : aggregationNode->groupingKeys()) {
+    groupingKeys_.push_back(exec::exprToChannel(key.get(), inputType));
+  }
+
+  const bool isRawInput = exec::isRawInput(step_);
+  aggregates_.reserve(aggregationNode->aggregates().size());
+  for (auto i = 0; i < aggregationNode->aggregates().size(); ++i) {
+    const auto& call = aggregationNode->aggregates()[i].call;
+    const auto name = baseName(call->name());
+    AggregateInfo info;
+    if (name == "sum") {
+      info.kind = AggregateKind::kSum;
+    } else if (name == "count") {
+      // Partial counts are merged by summing them.
+      info.kind = isRawInput ? AggregateKind::kCount : AggregateKind::kSum;
+    } else if (name == "min") {
+      info.kind = AggregateKind::kMin;
+    } else if (name == "max") {
+      info.kind = AggregateKind::kMax;
+    } else {
+      info.kind = AggregateKind::kAvg;
+    }
+    if (!call->inputs().empty() &&
+        !isCountAll(name, call->inputs()[0], isRawInput)) {
+      info.channel = exec::exprToChannel(call->inputs()[0].get(), inputType);
+    }
+    info.resultType = outputType_->childAt(groupingKeys_.size() + i);
+    info.isCount = name == "count";
+    aggregates_.push_back(std::move(info));
+  }
+}
+
+void CudfHashAggregation::addInput(RowVectorPtr input) {
+  // Accumulate inputs
+  if (input->size() > 0) {
+    auto cudfInput = std::dynamic_pointer_cast<CudfVector>(input);
+    VELOX_CHECK_NOT_NULL(cudfInput);
+    numInputRows_ += cudfInput->size();
+    inputs_.push_back(std::move(cudfInput));
+  }
+}
+
+void CudfHashAggregation::noMoreInput() {
+  exec::Operator::noMoreInput();
+
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+
+  if (inputs_.empty() && !groupingKeys_.empty()) {
+    return;
+  }
+
+  auto stream = cudfGlobalStreamPool().get_stream();
+  std::unique_ptr<cudf::table> tbl;
+  if (!inputs_.empty()) {
+    tbl = getConcatenatedTable(inputs_, stream);
+    // Release input data after synchronizing
+    stream.synchronize();
+    inputs_.clear();
+    VELOX_CHECK_NOT_NULL(tbl);
+  }
+
+  auto result = groupingKeys_.empty() ? computeGlobal(tbl.get(), stream)
+                                      : computeGroupBy(tbl->view(), stream);
+  const auto size = result->num_rows();
+  if (size > 0) {
+    outputTable_ = std::make_shared<CudfVector>(
+        pool(), outputType_, size, std::move(result), stream);
+  }
+}
+
+std::unique_ptr<cudf::table> CudfHashAggregation::computeGroupBy(
+    cudf::table_view input,
+    rmm::cuda_stream_view stream) const {
+  cudf::groupby::groupby groupBy(
+      input.select(groupingKeys_),
+      ignoreNullKeys_ ? cudf::null_policy::EXCLUDE
+                      : cudf::null_policy::INCLUDE);
+
+  std::vector<cudf::groupby::aggregation_request> requests(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    // count(*) counts the rows of the group, null or not, of any column.
+    requests[i].values =
+        input.column(aggregate.channel.value_or(groupingKeys_[0]));
+    requests[i].aggregations.push_back(
+        makeAggregation<cudf::groupby_aggregation>(
+            aggregate.kind, !aggregate.channel.has_value()));
+  }
+  auto [keys, results] = groupBy.aggregate(requests, stream);
+
+  auto columns = keys->release();
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    columns.push_back(castTo(
+        std::move(results[i].results[0]), aggregates_[i].resultType, stream));
+  }
+  return std::make_unique<cudf::table>(std::move(columns));
+}
+
+std::unique_ptr<cudf::table> CudfHashAggregation::computeGlobal(
+    const cudf::table* input,
+    rmm::cuda_stream_view stream) const {
+  std::vector<std::unique_ptr<cudf::column>> columns;
+  columns.reserve(aggregates_.size());
+  for (const auto& aggregate : aggregates_) {
+    const auto outputType =
+        cudf::data_type(veloxToCudfTypeId(aggregate.resultType));
+    std::unique_ptr<cudf::scalar> value;
+    if (aggregate.kind == AggregateKind::kCount) {
+      // cudf::reduce has no count.
+      int64_t count = numInputRows_;
+      if (input != nullptr && aggregate.channel.has_value()) {
+        count -= input->get_column(*aggregate.channel).null_count();
+      }
+      value =
+          std::make_unique<cudf::numeric_scalar<int64_t>>(count, true, stream);
+    } else if (input == nullptr) {
+      value = cudf::make_default_constructed_scalar(outputType, stream);
+    } else {
+      value = cudf::reduce(
+          input->get_column(aggregate.channel.value()).view(),
+          *makeAggregation<cudf::reduce_aggregation>(
+              aggregate.kind, false),
+          outputType,
+          stream);
+    }
+    if (aggregate.isCount && !value->is_valid(stream)) {
+      // The merge of partial counts over no rows.
+      value =
+          std::make_unique<cudf::numeric_scalar<int64_t>>(0, true, stream);
+    }
+    columns.push_back(cudf::make_column_from_scalar(*value, 1, stream));
+  }
+  return std::make_unique<cudf::table>(std::move(columns));
+}
+
+// static
+std::unique_ptr<cudf::column> CudfHashAggregation::castTo(
+    std::unique_ptr<cudf::column> column,
+    const TypePtr& type,
+    rmm::cuda_stream_view stream) {
+  const auto typeId = veloxToCudfTypeId(type);
+  if (column->type().id() == typeId) {
+    return column;
+  }
+  return cudf::cast(column->view(), cudf::data_type(typeId), stream);
+}
+
+RowVectorPtr CudfHashAggregation::getOutput() {
+  if (finished_ || !noMoreInput_) {
+    return nullptr;
+  }
+  finished_ = true;
+  return outputTable_;
+}
+
+void CudfHashAggregation::close() {
+  exec::Operator::close();
+  // Release stored inputs
+  // Release cudf memory resources
+  inputs_.clear();
+  outputTable_.reset();
+}
+
+} // namespace facebook::velox::cudf_velox
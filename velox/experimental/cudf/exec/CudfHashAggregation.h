@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/cudf/exec/NvtxHelper.h"
+#include "velox/experimental/cudf/vector/CudfVector.h"
+
+#include "velox/exec/Operator.h"
+#include "velox/vector/ComplexVector.h"
+
+#include <cudf/aggregation.hpp>
+#include <cudf/table/table.hpp>
+
+namespace facebook::velox::cudf_velox {
+
+/// cuDF replacement of exec::HashAggregation. Accumulates its input on the
+/// device and computes the aggregates with cudf::groupby, or with
+/// cudf::reduce when there are no grouping keys, once all input is received.
+/// Supports sum, count, min and max in all steps and avg in the single step.
+/// Grouping keys and aggregate inputs must be column references. Unlike the
+/// CPU version, integer sums wrap around on overflow instead of failing.
+class CudfHashAggregation : public exec::Operator, public NvtxHelper {
+ public:
+  CudfHashAggregation(
+      int32_t operatorId,
+      exec::DriverCtx* driverCtx,
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode);
+
+  /// Returns true if 'aggregationNode' can be run by this operator.
+  static bool isSupported(const core::AggregationNode& aggregationNode);
+
+  enum class AggregateKind { kSum, kCount, kMin, kMax, kAvg };
+
+  bool needsInput() const override {
+    return !noMoreInput_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  void noMoreInput() override;
+
+  RowVectorPtr getOutput() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return finished_;
+  }
+
+  void close() override;
+
+ private:
+  struct AggregateInfo {
+    AggregateKind kind;
+    // Input column. Not set for count(*).
+    std::optional<cudf::size_type> channel;
+    TypePtr resultType;
+    // True for count and for the merge of partial counts, whose result is 0
+    // rather than null on empty input.
+    bool isCount;
+  };
+
+  std::unique_ptr<cudf::table> computeGroupBy(
+      cudf::table_view input,
+      rmm::cuda_stream_view stream) const;
+
+  // Returns a single row. 'input' is nullptr if there was no input.
+  std::unique_ptr<cudf::table> computeGlobal(
+      const cudf::table* input,
+      rmm::cuda_stream_view stream) const;
+
+  // Casts 'column' to 'type' if its cuDF type differs from the one of 'type'.
+  static std::unique_ptr<cudf::column> castTo(
+      std::unique_ptr<cudf::column> column,
+      const TypePtr& type,
+      rmm::cuda_stream_view stream);
+
+  const core::AggregationNode::Step step_;
+  const bool ignoreNullKeys_;
+  std::vector<cudf::size_type> groupingKeys_;
+  std::vector<AggregateInfo> aggregates_;
+  std::vector<CudfVectorPtr> inputs_;
+  // Number of input rows. Used by a global count(*).
+  int64_t numInputRows_{0};
+  CudfVectorPtr outputTable_;
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::cudf_velox
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/CudfHashJoin.h"
+#include "velox/experimental/cudf/exec/ToCudf.h"
+#include "velox/experimental/cudf/exec/Utilities.h"
+#include "velox/experimental/cudf/exec/VeloxCudfInterop.h"
+
+#include "velox/exec/Task.h"
+
+#include <cudf/column/column_factories.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/scalar/scalar_factories.hpp>
+#include <cudf/utilities/type_dispatcher.hpp>
+
+#include <rmm/device_uvector.hpp>
+
+#include <folly/ScopeGuard.h>
+
+namespace facebook::velox::cudf_velox {
+
+namespace {
+
+// Returns a column view over the row indices produced by a cudf::hash_join.
+cudf::column_view toColumnView(
+    const rmm::device_uvector<cudf::size_type>& indices) {
+  return cudf::column_view(
+      cudf::data_type{cudf::type_to_id<cudf::size_type>()},
+      static_cast<cudf::size_type>(indices.size()),
+      indices.data(),
+      nullptr,
+      0);
+}
+
+std::vector<cudf::size_type> toChannels(
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const RowTypePtr& type) {
+  std::vector<cudf::size_type> channels;
+  channels.reserve(keys.size());
+  for (const auto& key : keys) {
+    channels.push_back(exec::exprToChannel(key.get(), type));
+  }
+  return channels;
+}
+
+} // namespace
+
+void CudfHashJoinBridge::setBuildSide(BuildSide buildSide) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(
+        !buildSide_.has_value(), "setBuildSide must be called only once");
+    buildSide_ = std::move(buildSide);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+std::optional<CudfHashJoinBridge::BuildSide>
+CudfHashJoinBridge::buildSideOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting data after the build side is aborted");
+  if (buildSide_.has_value()) {
+    return buildSide_;
+  }
+  promises_.emplace_back("CudfHashJoinBridge::buildSideOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+std::unique_ptr<exec::JoinBridge> CudfHashJoinBridgeTranslator::toJoinBridge(
+    const core::PlanNodePtr& node) {
+  if (!cudfIsRegistered()) {
+    return nullptr;
+  }
+  auto joinNode = std::dynamic_pointer_cast<const core::HashJoinNode>(node);
+  if (joinNode == nullptr || !CudfHashJoinProbe::isSupported(*joinNode)) {
+    return nullptr;
+  }
+  return std::make_unique<CudfHashJoinBridge>();
+}
+
+CudfHashJoinBuild::CudfHashJoinBuild(
+    int32_t operatorId,
+    exec::DriverCtx* driverCtx,
+    std::shared_ptr<const core::HashJoinNode> joinNode)
+    : exec::Operator(
+          driverCtx,
+          nullptr,
+          operatorId,
+          joinNode->id(),
+          "CudfHashBuild"),
+      NvtxHelper(nvtx3::rgb{65, 105, 225}, operatorId), // Royal blue
+      joinNode_(std::move(joinNode)),
+      buildKeys_(toChannels(
+          joinNode_->rightKeys(),
+          joinNode_->sources()[1]->outputType())) {}
+
+void CudfHashJoinBuild::addInput(RowVectorPtr input) {
+  // Accumulate inputs
+  if (input->size() > 0) {
+    auto cudfInput = std::dynamic_pointer_cast<CudfVector>(input);
+    VELOX_CHECK_NOT_NULL(cudfInput);
+    inputs_.push_back(std::move(cudfInput));
+  }
+}
+
+void CudfHashJoinBuild::noMoreInput() {
+  exec::Operator::noMoreInput();
+
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<exec::Driver>> peers;
+  // The last Driver to finish gathers the input of all build Drivers and
+  // hands the build side over to the probe side.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  {
+    auto promisesGuard = folly::makeGuard([&]() {
+      // Realize the promises so that the other Drivers (which were not
+      // the last to finish) can continue from the barrier and finish.
+      peers.clear();
+      for (auto& promise : promises) {
+        promise.setValue();
+      }
+    });
+
+    for (auto& peer : peers) {
+      auto op = peer->findOperator(planNodeId());
+      auto* build = dynamic_cast<CudfHashJoinBuild*>(op);
+      VELOX_CHECK_NOT_NULL(build);
+      inputs_.insert(
+          inputs_.end(),
+          std::make_move_iterator(build->inputs_.begin()),
+          std::make_move_iterator(build->inputs_.end()));
+      build->inputs_.clear();
+    }
+  }
+
+  CudfHashJoinBridge::BuildSide buildSide;
+  auto stream = cudfGlobalStreamPool().get_stream();
+  if (inputs_.empty()) {
+    const auto& buildType = joinNode_->sources()[1]->outputType();
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.reserve(buildType->size());
+    for (const auto& type : buildType->children()) {
+      columns.push_back(
+          cudf::make_empty_column(cudf::data_type(veloxToCudfTypeId(type))));
+    }
+    buildSide.table = std::make_shared<cudf::table>(std::move(columns));
+  } else {
+    buildSide.table = getConcatenatedTable(inputs_, stream);
+    inputs_.clear();
+    VELOX_CHECK_NOT_NULL(buildSide.table);
+    // Velox join keys never match nulls.
+    buildSide.hashJoin = std::make_shared<cudf::hash_join>(
+        buildSide.table->view().select(buildKeys_),
+        cudf::null_equality::UNEQUAL,
+        stream);
+  }
+  // The probe operators use the build side on their own streams.
+  stream.synchronize();
+
+  auto bridge = std::dynamic_pointer_cast<CudfHashJoinBridge>(
+      operatorCtx_->task()->getCustomJoinBridge(
+          operatorCtx_->driverCtx()->splitGroupId, planNodeId()));
+  VELOX_CHECK_NOT_NULL(bridge);
+  bridge->setBuildSide(std::move(buildSide));
+}
+
+exec::BlockingReason CudfHashJoinBuild::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return exec::BlockingReason::kWaitForJoinBuild;
+}
+
+bool CudfHashJoinBuild::isFinished() {
+  return !future_.valid() && noMoreInput_;
+}
+
+void CudfHashJoinBuild::close() {
+  exec::Operator::close();
+  inputs_.clear();
+}
+
+// static
+bool CudfHashJoinProbe::isSupported(const core::HashJoinNode& joinNode) {
+  if (!joinNode.isInnerJoin() && !joinNode.isLeftJoin()) {
+    return false;
+  }
+  if (joinNode.filter() != nullptr || joinNode.isNullAware()) {
+    return false;
+  }
+  for (const auto& source : joinNode.sources()) {
+    for (const auto& type : source->outputType()->children()) {
+      if (!isSupportedCudfType(type)) {
+        return false;
+      }
+    }
+  }
+  for (auto i = 0; i < joinNode.leftKeys().size(); ++i) {
+    if (*joinNode.leftKeys()[i]->type() != *joinNode.rightKeys()[i]->type()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CudfHashJoinProbe::CudfHashJoinProbe(
+    int32_t operatorId,
+    exec::DriverCtx* driverCtx,
+    std::shared_ptr<const core::HashJoinNode> joinNode)
+    : exec::Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "CudfHashProbe"),
+      NvtxHelper(nvtx3::rgb{135, 206, 250}, operatorId), // Light sky blue
+      joinNode_(std::move(joinNode)) {
+  VELOX_CHECK(isSupported(*joinNode_));
+  const auto& probeType = joinNode_->sources()[0]->outputType();
+  const auto& buildType = joinNode_->sources()[1]->outputType();
+  probeKeys_ = toChannels(joinNode_->leftKeys(), probeType);
+
+  outputSources_.reserve(outputType_->size());
+  for (const auto& name : outputType_->names()) {
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      outputSources_.emplace_back(true, probeOutputChannels_.size());
+      probeOutputChannels_.push_back(*channel);
+    } else {
+      outputSources_.emplace_back(false, buildOutputChannels_.size());
+      buildOutputChannels_.push_back(buildType->getChildIdx(name));
+    }
+  }
+}
+
+exec::BlockingReason CudfHashJoinProbe::isBlocked(ContinueFuture* future) {
+  if (buildSide_.has_value()) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto bridge = std::dynamic_pointer_cast<CudfHashJoinBridge>(
+      operatorCtx_->task()->getCustomJoinBridge(
+          operatorCtx_->driverCtx()->splitGroupId, planNodeId()));
+  VELOX_CHECK_NOT_NULL(bridge);
+  buildSide_ = bridge->buildSideOrFuture(future);
+  return buildSide_.has_value() ? exec::BlockingReason::kNotBlocked
+                                : exec::BlockingReason::kWaitForJoinBuild;
+}
+
+void CudfHashJoinProbe::addInput(RowVectorPtr input) {
+  if (input->size() > 0) {
+    probeInput_ = std::dynamic_pointer_cast<CudfVector>(input);
+    VELOX_CHECK_NOT_NULL(probeInput_);
+  }
+}
+
+RowVectorPtr CudfHashJoinProbe::getOutput() {
+  if (probeInput_ == nullptr) {
+    return nullptr;
+  }
+  VELOX_CHECK(buildSide_.has_value());
+
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+
+  // Keep working on the stream the input was produced on.
+  auto stream = probeInput_->stream();
+  auto probeTable = probeInput_->release();
+  probeInput_.reset();
+  auto probeView = probeTable->view();
+
+  std::vector<std::unique_ptr<cudf::column>> probeColumns;
+  std::vector<std::unique_ptr<cudf::column>> buildColumns;
+  if (buildSide_->hashJoin == nullptr) {
+    // Empty build side.
+    if (joinNode_->isInnerJoin()) {
+      return nullptr;
+    }
+    probeColumns =
+        std::make_unique<cudf::table>(
+            probeView.select(probeOutputChannels_), stream)
+            ->release();
+    buildColumns = makeNullBuildColumns(probeView.num_rows(), stream);
+  } else {
+    const auto probeKeys = probeView.select(probeKeys_);
+    auto [probeIndices, buildIndices] = joinNode_->isInnerJoin()
+        ? buildSide_->hashJoin->inner_join(probeKeys, std::nullopt, stream)
+        : buildSide_->hashJoin->left_join(probeKeys, std::nullopt, stream);
+    if (probeIndices->size() == 0) {
+      return nullptr;
+    }
+    probeColumns = cudf::gather(
+                       probeView.select(probeOutputChannels_),
+                       toColumnView(*probeIndices),
+                       cudf::out_of_bounds_policy::DONT_CHECK,
+                       stream)
+                       ->release();
+    // Probe rows of a left join without a match have an out of bounds build
+    // index, which gathers nulls.
+    buildColumns = cudf::gather(
+                       buildSide_->table->view().select(buildOutputChannels_),
+                       toColumnView(*buildIndices),
+                       cudf::out_of_bounds_policy::NULLIFY,
+                       stream)
+                       ->release();
+  }
+
+  std::vector<std::unique_ptr<cudf::column>> columns;
+  columns.reserve(outputSources_.size());
+  for (const auto& [isProbe, index] : outputSources_) {
+    columns.push_back(
+        std::move(isProbe ? probeColumns[index] : buildColumns[index]));
+  }
+  auto output = std::make_unique<cudf::table>(std::move(columns));
+  const auto size = output->num_rows();
+  return std::make_shared<CudfVector>(
+      pool(), outputType_, size, std::move(output), stream);
+}
+
+std::vector<std::unique_ptr<cudf::column>>
+CudfHashJoinProbe::makeNullBuildColumns(
+    cudf::size_type numRows,
+    rmm::cuda_stream_view stream) const {
+  std::vector<std::unique_ptr<cudf::column>> columns;
+  columns.reserve(buildOutputChannels_.size());
+  for (const auto channel : buildOutputChannels_) {
+    const auto type = cudf::data_type(veloxToCudfTypeId(
+        joinNode_->sources()[1]->outputType()->childAt(channel)));
+    auto nullValue = cudf::make_default_constructed_scalar(type, stream);
+    columns.push_back(
+        cudf::make_column_from_scalar(*nullValue, numRows, stream));
+  }
+  return columns;
+}
+
+void CudfHashJoinProbe::close() {
+  exec::Operator::close();
+  probeInput_.reset();
+  buildSide_.reset();
+}
+
+} // namespace facebook::velox::cudf_velox
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/cudf/exec/NvtxHelper.h"
+#include "velox/experimental/cudf/vector/CudfVector.h"
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/JoinBridge.h"
+#include "velox/exec/Operator.h"
+#include "velox/vector/ComplexVector.h"
+
+#include <cudf/join.hpp>
+#include <cudf/table/table.hpp>
+
+namespace facebook::velox::cudf_velox {
+
+/// Hands the build side of a cuDF hash join over to the probe operators. The
+/// table and the hash table built on its keys stay on the device.
+class CudfHashJoinBridge : public exec::JoinBridge {
+ public:
+  struct BuildSide {
+    std::shared_ptr<cudf::table> table;
+    // Hash table over the join keys of 'table'. Not set if 'table' is empty.
+    std::shared_ptr<cudf::hash_join> hashJoin;
+  };
+
+  void setBuildSide(BuildSide buildSide);
+
+  /// Returns the build side if it is set. Otherwise sets 'future' to be
+  /// realized when it is.
+  std::optional<BuildSide> buildSideOrFuture(ContinueFuture* future);
+
+ private:
+  std::optional<BuildSide> buildSide_;
+};
+
+/// Creates a CudfHashJoinBridge for the hash join nodes the cuDF operators
+/// replace. Registered by registerCudf().
+class CudfHashJoinBridgeTranslator : public exec::Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<exec::JoinBridge> toJoinBridge(
+      const core::PlanNodePtr& node) override;
+};
+
+/// cuDF replacement of exec::HashBuild. The last driver to finish
+/// concatenates the input of all drivers, builds a cudf::hash_join over its
+/// keys and sets it on the bridge.
+class CudfHashJoinBuild : public exec::Operator, public NvtxHelper {
+ public:
+  CudfHashJoinBuild(
+      int32_t operatorId,
+      exec::DriverCtx* driverCtx,
+      std::shared_ptr<const core::HashJoinNode> joinNode);
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override {
+    return nullptr;
+  }
+
+  bool needsInput() const override {
+    return !noMoreInput_;
+  }
+
+  void noMoreInput() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override;
+
+  void close() override;
+
+ private:
+  std::shared_ptr<const core::HashJoinNode> joinNode_;
+  std::vector<cudf::size_type> buildKeys_;
+  std::vector<CudfVectorPtr> inputs_;
+  // Realized when the last build driver has set the build side.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+};
+
+/// cuDF replacement of exec::HashProbe. Joins each input batch with the build
+/// side on the device and gathers the output columns from both sides.
+/// Supports inner and left joins without a filter.
+class CudfHashJoinProbe : public exec::Operator, public NvtxHelper {
+ public:
+  CudfHashJoinProbe(
+      int32_t operatorId,
+      exec::DriverCtx* driverCtx,
+      std::shared_ptr<const core::HashJoinNode> joinNode);
+
+  /// Returns true if 'joinNode' can be run by CudfHashJoinBuild and this
+  /// operator.
+  static bool isSupported(const core::HashJoinNode& joinNode);
+
+  bool needsInput() const override {
+    return !noMoreInput_ && probeInput_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override {
+    return noMoreInput_ && probeInput_ == nullptr;
+  }
+
+  void close() override;
+
+ private:
+  // Returns the build side columns of the output for a left join with an
+  // empty build side.
+  std::vector<std::unique_ptr<cudf::column>> makeNullBuildColumns(
+      cudf::size_type numRows,
+      rmm::cuda_stream_view stream) const;
+
+  std::shared_ptr<const core::HashJoinNode> joinNode_;
+  std::vector<cudf::size_type> probeKeys_;
+  // Probe and build side columns of the output, in output order.
+  std::vector<cudf::size_type> probeOutputChannels_;
+  std::vector<cudf::size_type> buildOutputChannels_;
+  // For each output column, whether it comes from the probe side and its
+  // index in 'probeOutputChannels_' or 'buildOutputChannels_'.
+  std::vector<std::pair<bool, cudf::size_type>> outputSources_;
+  std::optional<CudfHashJoinBridge::BuildSide> buildSide_;
+  CudfVectorPtr probeInput_;
+};
+
+} // namespace facebook::velox::cudf_velox
@@ -15,6 +15,8 @@
  */
 
 #include "velox/experimental/cudf/exec/CudfConversion.h"
+#include "velox/experimental/cudf/exec/CudfHashAggregation.h"
+#include "velox/experimental/cudf/exec/CudfHashJoin.h"
 #include "velox/experimental/cudf/exec/CudfOrderBy.h"
 #include "velox/experimental/cudf/exec/ToCudf.h"
 #include "velox/experimental/cudf/exec/Utilities.h"
@@ -81,8 +83,24 @@ bool CompileState::compile() {
     return driverFactory_.consumerNode;
   };
 
-  auto isSupportedGpuOperator = [](const exec::Operator* op) {
-    return isAnyOf<exec::OrderBy>(op);
+  // The decision for HashBuild and HashProbe depends only on their join node,
+  // so that either both or neither of them run on the GPU.
+  auto isSupportedGpuOperator = [&](const exec::Operator* op) {
+    if (isAnyOf<exec::OrderBy>(op)) {
+      return true;
+    }
+    if (isAnyOf<exec::HashAggregation>(op)) {
+      auto planNode = std::dynamic_pointer_cast<const core::AggregationNode>(
+          getPlanNode(op->planNodeId()));
+      return planNode != nullptr &&
+          CudfHashAggregation::isSupported(*planNode);
+    }
+    if (isAnyOf<exec::HashBuild, exec::HashProbe>(op)) {
+      auto planNode = std::dynamic_pointer_cast<const core::HashJoinNode>(
+          getPlanNode(op->planNodeId()));
+      return planNode != nullptr && CudfHashJoinProbe::isSupported(*planNode);
+    }
+    return false;
   };
 
   std::vector<bool> isSupportedGpuOperators(operators.size());
@@ -92,12 +110,23 @@ bool CompileState::compile() {
       isSupportedGpuOperators.begin(),
       isSupportedGpuOperator);
 
-  auto acceptsGpuInput = [](const exec::Operator* op) {
-    return isAnyOf<exec::OrderBy>(op);
+  auto acceptsGpuInput = [&](int32_t operatorIndex) {
+    return isSupportedGpuOperators[operatorIndex];
   };
 
-  auto producesGpuOutput = [](const exec::Operator* op) {
-    return isAnyOf<exec::OrderBy>(op);
+  auto producesGpuOutput = [&](int32_t operatorIndex) {
+    return isSupportedGpuOperators[operatorIndex] &&
+        !isAnyOf<exec::HashBuild>(operators[operatorIndex]);
+  };
+
+  // Returns the type of the input of a GPU operator. HashBuild consumes the
+  // build side of its join node.
+  auto inputType = [&](const exec::Operator* op) {
+    auto planNode = getPlanNode(op->planNodeId());
+    if (isAnyOf<exec::HashBuild>(op)) {
+      return planNode->sources()[1]->outputType();
+    }
+    return planNode->sources()[0]->outputType();
   };
 
   int32_t operatorsOffset = 0;
@@ -118,10 +147,9 @@ bool CompileState::compile() {
         driverFactory_.outputDriver and operatorIndex == operators.size() - 1;
 
     auto id = oper->operatorId();
-    if (previousOperatorIsNotGpu and acceptsGpuInput(oper)) {
-      auto planNode = getPlanNode(oper->planNodeId());
+    if (previousOperatorIsNotGpu and acceptsGpuInput(operatorIndex)) {
       replaceOp.push_back(std::make_unique<CudfFromVelox>(
-          id, planNode->outputType(), ctx, planNode->id() + "-from-velox"));
+          id, inputType(oper), ctx, oper->planNodeId() + "-from-velox"));
       replaceOp.back()->initialize();
     }
 
@@ -132,9 +160,32 @@ bool CompileState::compile() {
       VELOX_CHECK(planNode != nullptr);
       replaceOp.push_back(std::make_unique<CudfOrderBy>(id, ctx, planNode));
       replaceOp.back()->initialize();
+    } else if (
+        isSupportedGpuOperators[operatorIndex] and
+        isAnyOf<exec::HashAggregation>(oper)) {
+      auto planNode = std::dynamic_pointer_cast<const core::AggregationNode>(
+          getPlanNode(oper->planNodeId()));
+      VELOX_CHECK(planNode != nullptr);
+      replaceOp.push_back(
+          std::make_unique<CudfHashAggregation>(id, ctx, planNode));
+      replaceOp.back()->initialize();
+    } else if (
+        isSupportedGpuOperators[operatorIndex] and
+        isAnyOf<exec::HashBuild, exec::HashProbe>(oper)) {
+      auto planNode = std::dynamic_pointer_cast<const core::HashJoinNode>(
+          getPlanNode(oper->planNodeId()));
+      VELOX_CHECK(planNode != nullptr);
+      if (isAnyOf<exec::HashBuild>(oper)) {
+        replaceOp.push_back(
+            std::make_unique<CudfHashJoinBuild>(id, ctx, planNode));
+      } else {
+        replaceOp.push_back(
+            std::make_unique<CudfHashJoinProbe>(id, ctx, planNode));
+      }
+      replaceOp.back()->initialize();
     }
 
-    if (producesGpuOutput(oper) and
+    if (producesGpuOutput(operatorIndex) and
         (nextOperatorIsNotGpu or isLastOperatorOfTask)) {
       auto planNode = getPlanNode(oper->planNodeId());
       replaceOp.push_back(std::make_unique<CudfToVelox>(
@@ -199,6 +250,14 @@ void registerCudf(const CudfOptions& options) {
   CudfDriverAdapter cda{mr};
   exec::DriverAdapter cudfAdapter{kCudfAdapterName, {}, cda};
   exec::DriverFactory::registerAdapter(cudfAdapter);
+  // Operator translators cannot be unregistered one by one. The translator
+  // creates no join bridges while cuDF is not registered.
+  static bool isTranslatorRegistered = false;
+  if (!isTranslatorRegistered) {
+    exec::Operator::registerOperator(
+        std::make_unique<CudfHashJoinBridgeTranslator>());
+    isTranslatorRegistered = true;
+  }
   isCudfRegistered = true;
 }
 
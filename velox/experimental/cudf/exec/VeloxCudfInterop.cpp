@@ -48,11 +48,57 @@
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
 
+#include <algorithm>
 #include <functional>
 #include <numeric>
 
 namespace facebook::velox::cudf_velox {
 
+bool isSupportedCudfType(const TypePtr& type) {
+  // Logical types other than DATE, e.g. decimals or intervals, share the
+  // physical type of their kind but need conversions that are not done yet.
+  static const std::vector<TypePtr> kSupportedTypes = {
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      DATE()};
+  return std::any_of(
+      kSupportedTypes.begin(),
+      kSupportedTypes.end(),
+      [&](const auto& supported) { return *supported == *type; });
+}
+
+cudf::type_id veloxToCudfTypeId(const TypePtr& type) {
+  if (type->isDate()) {
+    return cudf::type_id::TIMESTAMP_DAYS;
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return cudf::type_id::BOOL8;
+    case TypeKind::TINYINT:
+      return cudf::type_id::INT8;
+    case TypeKind::SMALLINT:
+      return cudf::type_id::INT16;
+    case TypeKind::INTEGER:
+      return cudf::type_id::INT32;
+    case TypeKind::BIGINT:
+      return cudf::type_id::INT64;
+    case TypeKind::REAL:
+      return cudf::type_id::FLOAT32;
+    case TypeKind::DOUBLE:
+      return cudf::type_id::FLOAT64;
+    case TypeKind::VARCHAR:
+      return cudf::type_id::STRING;
+    default:
+      VELOX_UNSUPPORTED("Type not supported by cuDF: {}", type->toString());
+  }
+}
+
 namespace with_arrow {
 
 std::unique_ptr<cudf::table> toCudfTable(
@@ -24,6 +24,19 @@
 #include <cudf/table/table.hpp>
 #include <cudf/types.hpp>
 
+namespace facebook::velox::cudf_velox {
+
+/// Returns true if columns of 'type' keep their Velox type when converted to
+/// cuDF and back, so that cuDF operators can process them. Currently these are
+/// the boolean, integer, floating point, varchar and date types.
+bool isSupportedCudfType(const TypePtr& type);
+
+/// Returns the cuDF type id a column of 'type' has after conversion. 'type'
+/// must satisfy isSupportedCudfType().
+cudf::type_id veloxToCudfTypeId(const TypePtr& type);
+
+} // namespace facebook::velox::cudf_velox
+
 namespace facebook::velox::cudf_velox::with_arrow {
 std::unique_ptr<cudf::table> toCudfTable(
     const facebook::velox::RowVectorPtr& veloxTable,
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/ToCudf.h"
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class AggregationTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    cudf_velox::registerCudf();
+  }
+
+  void TearDown() override {
+    cudf_velox::unregisterCudf();
+    OperatorTestBase::TearDown();
+  }
+
+  std::vector<RowVectorPtr> makeVectors(int32_t numVectors) {
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < numVectors; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int32_t>(
+              1'000, [](auto row) { return row % 17; }, nullEvery(23)),
+          makeFlatVector<int64_t>(
+              1'000, [i](auto row) { return i * 1'000 + row; }, nullEvery(7)),
+          makeFlatVector<double>(
+              1'000, [](auto row) { return row * 0.25; }, nullEvery(11)),
+          makeFlatVector<StringView>(
+              1'000,
+              [](auto row) {
+                return StringView::makeInline(fmt::format("s{}", row % 5));
+              }),
+      }));
+    }
+    return vectors;
+  }
+
+  // Returns true if 'task' ran an operator of type 'operatorType'.
+  static bool hasOperator(
+      const std::shared_ptr<Task>& task,
+      const std::string& operatorType) {
+    for (const auto& pipeline : task->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType == operatorType) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+};
+
+TEST_F(AggregationTest, groupBy) {
+  auto vectors = makeVectors(3);
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)",
+                       "count(c1)",
+                       "count(1)",
+                       "min(c2)",
+                       "max(c3)",
+                       "avg(c2)"})
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      "SELECT c0, sum(c1), count(c1), count(*), min(c2), max(c3), avg(c2) "
+      "FROM tmp GROUP BY c0");
+  EXPECT_TRUE(hasOperator(task, "CudfHashAggregation"));
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation({"c0", "c3"}, {"sum(c2)", "max(c1)"})
+             .planNode();
+  assertQuery(
+      plan, "SELECT c0, c3, sum(c2), max(c1) FROM tmp GROUP BY c0, c3");
+}
+
+TEST_F(AggregationTest, partialAndFinal) {
+  auto vectors = makeVectors(3);
+  createDuckDbTable(vectors);
+
+  // The partial and final aggregations are adjacent, so the intermediate
+  // results stay on the device.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation(
+                      {"c0"}, {"sum(c1)", "count(c1)", "count(1)", "min(c3)"})
+                  .finalAggregation()
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      "SELECT c0, sum(c1), count(c1), count(*), min(c3) FROM tmp GROUP BY c0");
+  EXPECT_TRUE(hasOperator(task, "CudfHashAggregation"));
+  EXPECT_FALSE(hasOperator(task, "Aggregation"));
+}
+
+TEST_F(AggregationTest, global) {
+  auto vectors = makeVectors(3);
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation(
+                      {}, {"sum(c1)", "count(c2)", "count(1)", "max(c2)"})
+                  .finalAggregation()
+                  .planNode();
+  assertQuery(plan, "SELECT sum(c1), count(c2), count(*), max(c2) FROM tmp");
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation({}, {"avg(c1)", "min(c3)"})
+             .planNode();
+  assertQuery(plan, "SELECT avg(c1), min(c3) FROM tmp");
+}
+
+TEST_F(AggregationTest, emptyInput) {
+  auto vectors = makeVectors(1);
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c1 < 0")
+                  .partialAggregation({}, {"sum(c1)", "count(c1)", "count(1)"})
+                  .finalAggregation()
+                  .planNode();
+  assertQuery(
+      plan, "SELECT sum(c1), count(c1), count(*) FROM tmp WHERE c1 < 0");
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("c1 < 0")
+             .singleAggregation({"c0"}, {"sum(c1)"})
+             .planNode();
+  assertQuery(plan, "SELECT c0, sum(c1) FROM tmp WHERE c1 < 0 GROUP BY c0");
+}
+
+TEST_F(AggregationTest, unsupportedFallsBack) {
+  auto vectors = makeVectors(2);
+  createDuckDbTable(vectors);
+
+  // Aggregations with a mask run on the CPU.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0", "c1", "c1 % 2 = 0 AS m"})
+                  .singleAggregation({"c0"}, {"sum(c1)"}, {"m"})
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      "SELECT c0, sum(c1) FILTER (WHERE c1 % 2 = 0) FROM tmp GROUP BY c0");
+  EXPECT_FALSE(hasOperator(task, "CudfHashAggregation"));
+}
+
+} // namespace
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/cudf/exec/ToCudf.h"
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    cudf_velox::registerCudf();
+
+    probeVectors_ = makeVectors(3, 1'000, "t", 0);
+    buildVectors_ = makeVectors(2, 300, "u", 500);
+    createDuckDbTable("t", probeVectors_);
+    createDuckDbTable("u", buildVectors_);
+  }
+
+  void TearDown() override {
+    cudf_velox::unregisterCudf();
+    OperatorTestBase::TearDown();
+  }
+
+  // Makes vectors with columns <prefix>_k0 integer, <prefix>_k1 bigint,
+  // <prefix>_v0 double and <prefix>_v1 varchar. The keys of the rows start at
+  // 'keyOffset'.
+  std::vector<RowVectorPtr> makeVectors(
+      int32_t numVectors,
+      vector_size_t size,
+      const std::string& prefix,
+      int32_t keyOffset) {
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < numVectors; ++i) {
+      vectors.push_back(makeRowVector(
+          {prefix + "_k0", prefix + "_k1", prefix + "_v0", prefix + "_v1"},
+          {
+              makeFlatVector<int32_t>(
+                  size,
+                  [&](auto row) { return keyOffset + (i * size + row) % 800; },
+                  nullEvery(13)),
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return row % 3; }, nullEvery(17)),
+              makeFlatVector<double>(
+                  size, [](auto row) { return row * 0.5; }, nullEvery(7)),
+              makeFlatVector<StringView>(
+                  size,
+                  [](auto row) {
+                    return StringView::makeInline(fmt::format("v{}", row % 9));
+                  }),
+          }));
+    }
+    return vectors;
+  }
+
+  core::PlanNodePtr makePlan(
+      core::JoinType joinType,
+      const std::vector<std::string>& probeKeys,
+      const std::vector<std::string>& buildKeys,
+      const std::vector<std::string>& outputLayout,
+      const std::string& buildFilter = "") {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto build = PlanBuilder(planNodeIdGenerator).values(buildVectors_);
+    if (!buildFilter.empty()) {
+      build.filter(buildFilter);
+    }
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probeVectors_)
+        .hashJoin(
+            probeKeys, buildKeys, build.planNode(), "", outputLayout, joinType)
+        .planNode();
+  }
+
+  // Returns true if 'task' ran an operator of type 'operatorType'.
+  static bool hasOperator(
+      const std::shared_ptr<Task>& task,
+      const std::string& operatorType) {
+    for (const auto& pipeline : task->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType == operatorType) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  std::vector<RowVectorPtr> probeVectors_;
+  std::vector<RowVectorPtr> buildVectors_;
+};
+
+TEST_F(HashJoinTest, inner) {
+  auto plan = makePlan(
+      core::JoinType::kInner,
+      {"t_k0"},
+      {"u_k0"},
+      {"t_k0", "t_v0", "u_v1", "u_k1"});
+  auto task = assertQuery(
+      plan,
+      "SELECT t_k0, t_v0, u_v1, u_k1 FROM t, u WHERE t_k0 = u_k0");
+  EXPECT_TRUE(hasOperator(task, "CudfHashBuild"));
+  EXPECT_TRUE(hasOperator(task, "CudfHashProbe"));
+
+  plan = makePlan(
+      core::JoinType::kInner,
+      {"t_k0", "t_k1"},
+      {"u_k0", "u_k1"},
+      {"u_v0", "t_v1"});
+  assertQuery(
+      plan,
+      "SELECT u_v0, t_v1 FROM t, u WHERE t_k0 = u_k0 AND t_k1 = u_k1");
+}
+
+TEST_F(HashJoinTest, left) {
+  auto plan = makePlan(
+      core::JoinType::kLeft,
+      {"t_k0"},
+      {"u_k0"},
+      {"t_k0", "t_v1", "u_v0"});
+  auto task = assertQuery(
+      plan,
+      "SELECT t_k0, t_v1, u_v0 FROM t LEFT JOIN u ON t_k0 = u_k0");
+  EXPECT_TRUE(hasOperator(task, "CudfHashProbe"));
+}
+
+TEST_F(HashJoinTest, emptyBuild) {
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto plan = makePlan(
+        joinType, {"t_k0"}, {"u_k0"}, {"t_k0", "u_v0", "u_v1"}, "u_k1 < 0");
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT t_k0, u_v0, u_v1 FROM t {} JOIN "
+            "(SELECT * FROM u WHERE u_k1 < 0) ON t_k0 = u_k0",
+            joinType == core::JoinType::kInner ? "INNER" : "LEFT"));
+  }
+}
+
+TEST_F(HashJoinTest, multipleDrivers) {
+  // Each of the 4 drivers of both pipelines produces all the rows of its
+  // side, so every match appears 16 times.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors_, true)
+                  .hashJoin(
+                      {"t_k0"},
+                      {"u_k0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors_, true)
+                          .planNode(),
+                      "",
+                      {"t_k0", "u_k1", "u_v1"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(4)
+          .assertResults(
+              "SELECT t_k0, u_k1, u_v1 FROM t, u, range(16) WHERE t_k0 = u_k0");
+  EXPECT_TRUE(hasOperator(task, "CudfHashBuild"));
+}
+
+TEST_F(HashJoinTest, joinThenAggregation) {
+  // Join and aggregation run in the same pipeline without leaving the device.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values(probeVectors_)
+          .hashJoin(
+              {"t_k0"},
+              {"u_k0"},
+              PlanBuilder(planNodeIdGenerator).values(buildVectors_).planNode(),
+              "",
+              {"t_k1", "u_v0"})
+          .singleAggregation({"t_k1"}, {"sum(u_v0)", "count(1)"})
+          .planNode();
+  auto task = assertQuery(
+      plan,
+      "SELECT t_k1, sum(u_v0), count(*) FROM t, u WHERE t_k0 = u_k0 "
+      "GROUP BY t_k1");
+  EXPECT_TRUE(hasOperator(task, "CudfHashProbe"));
+  EXPECT_TRUE(hasOperator(task, "CudfHashAggregation"));
+}
+
+TEST_F(HashJoinTest, unsupportedFallsBack) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values(probeVectors_)
+          .hashJoin(
+              {"t_k0"},
+              {"u_k0"},
+              PlanBuilder(planNodeIdGenerator).values(buildVectors_).planNode(),
+              "t_v0 < u_v0",
+              {"t_k0", "u_v0"})
+          .planNode();
+  auto task = assertQuery(
+      plan, "SELECT t_k0, u_v0 FROM t, u WHERE t_k0 = u_k0 AND t_v0 < u_v0");
+  EXPECT_FALSE(hasOperator(task, "CudfHashProbe"));
+  EXPECT_FALSE(hasOperator(task, "CudfHashBuild"));
+}
+
+} // namespace
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef PLATFORM_CUDA
+#define PLATFORM_CUDA
+#endif
+
+// clang-format off
+#ifndef CUDA_PLATFORM_SPECIALIZATION_HEADER
+#define CUDA_PLATFORM_SPECIALIZATION_HEADER \
+  breeze/platforms/specialization/cuda-ptx.cuh
+#endif
+// clang-format on
+
+#include <breeze/functions/scan.h>
+#include <breeze/functions/sort.h>
+#include <breeze/platforms/platform.h>
+#include <breeze/platforms/cuda.cuh>
+
+namespace facebook::velox::wave {
+
+/// Returns true if grouping 'numDistinct' keys is expected to be faster with
+/// SortReduceByKey than with updating the group of each row. With fewer
+/// distinct keys than the rows of a tile, every tile has runs of equal keys
+/// and the sort saves atomic updates of the same group. With more distinct
+/// keys the runs are mostly of one row and the sort is overhead.
+template <int32_t kBlockSize, int32_t kItemsPerThread>
+constexpr bool __host__ __device__ preferSortReduce(int64_t numDistinct) {
+  return numDistinct < kBlockSize * kItemsPerThread;
+}
+
+/// Sort-based reduction by key over tiles of kBlockSize * kItemsPerThread
+/// rows with Breeze block primitives. The rows of a tile are radix sorted by
+/// key, the values of each run of equal keys are added up with block scans
+/// and the group of each distinct key is updated once per tile. Must be run
+/// by a thread block of kBlockSize threads. 'Key' is one of the integer types
+/// supported by Breeze radix sort, e.g. int or unsigned.
+template <
+    int32_t kBlockSize,
+    int32_t kItemsPerThread,
+    typename Key,
+    typename Value>
+struct SortReduceByKey {
+  static constexpr int32_t kWarpThreads = 32;
+  static constexpr int32_t kTileSize = kBlockSize * kItemsPerThread;
+  static constexpr int32_t kRadixBits = 8;
+
+  using Platform = ::CudaPlatform<kBlockSize, kWarpThreads>;
+  using Sort = breeze::functions::
+      BlockRadixSort<Platform, kItemsPerThread, kRadixBits, Key, Value>;
+  using RunScan = breeze::functions::BlockScan<Platform, int, kItemsPerThread>;
+  using ValueScan =
+      breeze::functions::BlockScan<Platform, Value, kItemsPerThread>;
+
+  struct Scratch {
+    union {
+      typename Sort::Scratch sort;
+      typename RunScan::Scratch runScan;
+      typename ValueScan::Scratch valueScan;
+    };
+    Key keys[kTileSize];
+    // The sorted values, then the sum of the values before each run.
+    Value values[kTileSize];
+  };
+
+  /// Adds up the values of equal keys in rows [0, numRows) of a tile, where
+  /// 'numRows' is at most kTileSize. 'keyGetter(i)' and 'valueGetter(i)'
+  /// return the key and value of row 'i'. Calls 'update(key, sum)' once per
+  /// distinct key of the tile. The calls of the tile are made by different
+  /// threads with distinct keys, so 'update' only needs to be atomic if
+  /// several tiles update the same groups concurrently.
+  template <typename KeyGetter, typename ValueGetter, typename Update>
+  static void __device__ reduce(
+      int32_t numRows,
+      KeyGetter keyGetter,
+      ValueGetter valueGetter,
+      Update update,
+      Scratch* scratch) {
+    using namespace breeze::utils;
+    Platform p;
+
+    // Radix sort takes the rows in a warp striped arrangement.
+    Key keys[kItemsPerThread];
+    Value values[kItemsPerThread];
+    const int32_t threadOffset =
+        p.warp_idx() * kWarpThreads * kItemsPerThread + p.lane_idx();
+    for (auto i = 0; i < kItemsPerThread; ++i) {
+      const auto row = threadOffset + i * kWarpThreads;
+      if (row < numRows) {
+        keys[i] = keyGetter(row);
+        values[i] = valueGetter(row);
+      }
+    }
+    Sort::Sort(
+        p,
+        make_slice<THREAD, WARP_STRIPED>(keys),
+        make_slice<THREAD, WARP_STRIPED>(values),
+        make_slice<SHARED>(&scratch->sort),
+        numRows);
+    p.syncthreads();
+    for (auto i = 0; i < kItemsPerThread; ++i) {
+      const auto row = threadOffset + i * kWarpThreads;
+      if (row < numRows) {
+        scratch->keys[row] = keys[i];
+        scratch->values[row] = values[i];
+      }
+    }
+    p.syncthreads();
+
+    // Block scans take the rows in a striped arrangement. A row starts a run
+    // if its key differs from the key of the previous row.
+    int runStarts[kItemsPerThread];
+    for (auto i = 0; i < kItemsPerThread; ++i) {
+      const auto row = p.thread_idx() + i * kBlockSize;
+      values[i] = 0;
+      runStarts[i] = 0;
+      if (row < numRows) {
+        keys[i] = scratch->keys[row];
+        values[i] = scratch->values[row];
+        runStarts[i] = row == 0 || scratch->keys[row - 1] != keys[i];
+      }
+    }
+    int runs[kItemsPerThread];
+    RunScan::template Scan<breeze::functions::ScanOpAdd>(
+        p,
+        make_slice(runStarts),
+        make_slice(runs),
+        make_slice<SHARED>(&scratch->runScan));
+    p.syncthreads();
+    Value sums[kItemsPerThread];
+    ValueScan::template Scan<breeze::functions::ScanOpAdd>(
+        p,
+        make_slice(values),
+        make_slice(sums),
+        make_slice<SHARED>(&scratch->valueScan));
+    p.syncthreads();
+
+    // The first row of each run records the sum before the run. The last row
+    // of each run updates the group of the run.
+    for (auto i = 0; i < kItemsPerThread; ++i) {
+      if (runStarts[i]) {
+        scratch->values[runs[i] - 1] = sums[i] - values[i];
+      }
+    }
+    p.syncthreads();
+    for (auto i = 0; i < kItemsPerThread; ++i) {
+      const auto row = p.thread_idx() + i * kBlockSize;
+      if (row < numRows &&
+          (row == numRows - 1 || scratch->keys[row + 1] != keys[i])) {
+        update(keys[i], sums[i] - scratch->values[runs[i] - 1]);
+      }
+    }
+    p.syncthreads();
+  }
+};
+
+} // namespace facebook::velox::wave
@@ -550,6 +550,7 @@ UPDATE_CASE(
     testSumAtomicCoalesceShmem,
     run.blockSize * sizeof(int64_t));
 UPDATE_CASE(updateSum1Order, testSumOrder, 0);
+UPDATE_CASE(updateSum1SortReduce, testSumSortReduce, 0);
 
 void __global__ __launch_bounds__(1024) update1PartitionKernel(
     int32_t numRows,
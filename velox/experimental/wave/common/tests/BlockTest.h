@@ -158,6 +158,9 @@ class BlockTestStream : public Stream {
   void updateSum1Mtx(TestingRow* rows, HashRun& run);
   void updateSum1MtxCoalesce(TestingRow* rows, HashRun& run);
   void updateSum1Order(TestingRow* rows, HashRun& run);
+  // Sorts the rows of each tile by key and adds up runs of equal keys before
+  // updating the groups. Needs a block size of 256.
+  void updateSum1SortReduce(TestingRow* rows, HashRun& run);
 
   static int32_t scatterBitsSize(int32_t blockSize);
 
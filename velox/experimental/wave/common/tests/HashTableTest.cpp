@@ -264,6 +264,7 @@ class HashTableTest : public testing::Test {
         updateJitMtxCoa(rows, run, reference);
         UPDATE_CASE("sum1MtxCoa", updateSum1MtxCoalesce, true, 0);
         UPDATE_CASE("sum1Part", updateSum1Part, true, 0);
+        UPDATE_CASE("sum1SortReduce", updateSum1SortReduce, true, 0);
         // UPDATE_CASE("sum1Order", updateSum1Order, true, 0);
 
         break;
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/experimental/wave/common/HashTable.cuh"
+#include "velox/experimental/wave/common/SortReduce.cuh"
 #include "velox/experimental/wave/common/tests/BlockTest.h"
 
 namespace facebook::velox::wave {
@@ -249,4 +250,29 @@ void __device__ testSumOrder(TestingRow* rows, HashProbe* probe) {
   }
 }
 
+// Needs a block size of 256.
+using SumSortReduce = SortReduceByKey<256, 4, int32_t, int64_t>;
+
+void __device__ testSumSortReduce(TestingRow* rows, HashProbe* probe) {
+  __shared__ SumSortReduce::Scratch scratch;
+  auto keys = reinterpret_cast<int64_t**>(probe->keys);
+  auto indices = keys[0];
+  auto deltas = keys[1];
+  int32_t base = probe->numRowsPerThread * blockDim.x * blockIdx.x;
+  int32_t end = base + probe->numRows[blockIdx.x];
+
+  for (auto tile = base; tile < end; tile += SumSortReduce::kTileSize) {
+    SumSortReduce::reduce(
+        min(SumSortReduce::kTileSize, end - tile),
+        [&](auto i) { return static_cast<int32_t>(indices[tile + i]); },
+        [&](auto i) { return deltas[tile + i]; },
+        [&](auto index, auto total) {
+          atomicAdd(
+              (unsigned long long*)&rows[index].count,
+              (unsigned long long)total);
+        },
+        &scratch);
+  }
+}
+
 } // namespace facebook::velox::wave
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HostInput.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+DEFINE_int32(
+    velox_wave_host_input_batches,
+    2,
+    "Number of host batches queued for transfer to the device by a WaveDriver "
+    "that does not start its Driver");
+
+namespace facebook::velox::wave {
+
+HostInput::HostInput(
+    CompileState& state,
+    RowTypePtr outputType,
+    const core::PlanNodeId& planNodeId)
+    : WaveSourceOperator(state, std::move(outputType), planNodeId) {}
+
+void HostInput::addInput(RowVectorPtr input) {
+  VELOX_CHECK(!noMoreInput_);
+  // The device copy is made from flat vectors. The input may be shared with
+  // the producer, so the flattened children go into a new RowVector.
+  auto children = input->children();
+  for (auto& child : children) {
+    child = BaseVector::loadedVectorShared(child);
+    BaseVector::flattenVector(child);
+  }
+  inputs_.push_back(std::make_shared<RowVector>(
+      input->pool(),
+      asRowType(input->type()),
+      nullptr,
+      input->size(),
+      std::move(children)));
+}
+
+std::vector<AdvanceResult> HostInput::canAdvance(WaveStream& stream) {
+  std::vector<AdvanceResult> results;
+  if (!inputs_.empty()) {
+    auto& result = results.emplace_back();
+    result.numRows = inputs_.front()->size();
+  }
+  return results;
+}
+
+void HostInput::schedule(WaveStream& stream, int32_t maxRows) {
+  VELOX_CHECK(!inputs_.empty());
+  auto data = std::move(inputs_.front());
+  inputs_.pop_front();
+  VELOX_CHECK_LE(data->size(), maxRows);
+
+  std::vector<const BaseVector*> sources;
+  for (auto i = 0; i < outputIds_.size(); ++i) {
+    sources.push_back(data->childAt(i).get());
+  }
+  int32_t counter = 0;
+  outputIds_.forEach([&](auto id) {
+    stream.setNullable(*stream.operandAt(id), sources[counter]->mayHaveNulls());
+    ++counter;
+  });
+  folly::Range<Executable**> empty(nullptr, nullptr);
+  auto numBlocks = bits::roundUp(data->size(), kBlockSize) / kBlockSize;
+  stream.setNumRows(data->size());
+  stream.prepareProgramLaunch(
+      id_, 0, data->size(), empty, numBlocks, nullptr, nullptr);
+  // The copy is enqueued on the stream and overlaps with the kernels of the
+  // other streams of the WaveDriver.
+  vectorsToDevice(
+      folly::Range(sources.data(), sources.size()), outputIds_, stream);
+}
+
+std::string HostInput::toString() const {
+  return fmt::format("HostInput {} queued", inputs_.size());
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+DECLARE_int32(velox_wave_host_input_batches);
+
+namespace facebook::velox::wave {
+
+/// Source of a WaveDriver that is preceded by host Operators in its Driver.
+/// Queues the host batches added by the Driver and copies one to the device
+/// per WaveStream. Up to FLAGS_velox_wave_host_input_batches batches are
+/// queued, so that the next batch is available while the previous ones are
+/// copied and processed on other streams.
+class HostInput : public WaveSourceOperator {
+ public:
+  HostInput(
+      CompileState& state,
+      RowTypePtr outputType,
+      const core::PlanNodeId& planNodeId);
+
+  std::vector<AdvanceResult> canAdvance(WaveStream& stream) override;
+
+  bool isStreaming() const override {
+    return true;
+  }
+
+  void schedule(WaveStream& stream, int32_t maxRows = 0) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && inputs_.empty();
+  }
+
+  bool isWaitingForInput() const override {
+    return !noMoreInput_ && inputs_.empty();
+  }
+
+  /// True if another batch can be queued.
+  bool canAddInput() const {
+    return !noMoreInput_ &&
+        inputs_.size() < FLAGS_velox_wave_host_input_batches;
+  }
+
+  void addInput(RowVectorPtr input);
+
+  void noMoreInput() {
+    noMoreInput_ = true;
+  }
+
+  std::string toString() const override;
+
+ private:
+  std::deque<RowVectorPtr> inputs_;
+  bool noMoreInput_{false};
+};
+
+} // namespace facebook::velox::wave
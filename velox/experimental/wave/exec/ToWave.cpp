@@ -25,6 +25,12 @@
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
 
+DEFINE_bool(
+    velox_wave_split_plans,
+    true,
+    "Offload the supported Operators after an unsupported one in a Driver to "
+    "another WaveDriver that takes host input");
+
 namespace facebook::velox::wave {
 
 using exec::Expr;
@@ -183,11 +189,10 @@ bool CompileState::reserveMemory() {
   return true;
 }
 
-bool CompileState::compile() {
+bool CompileState::compile(int32_t& operatorIndex) {
   auto operators = driver_.operators();
 
-  int32_t first = 0;
-  int32_t operatorIndex = 0;
+  const int32_t first = operatorIndex;
   RowTypePtr outputType;
   // Make sure operator states are initialized.  We will need to inspect some of
   // them during the transformation.
@@ -196,6 +201,7 @@ bool CompileState::compile() {
   std::vector<OperandId> resultOrder;
   outputType = makeOperators(operatorIndex, resultOrder);
   if (operators_.empty()) {
+    operatorIndex = first + 1;
     return false;
   }
 
@@ -210,7 +216,7 @@ bool CompileState::compile() {
       outputType,
       operators[first]->planNodeId(),
       operators[first]->operatorId(),
-      std::move(arena_),
+      arena_,
       std::move(operators_),
       std::move(resultOrder),
       runtime_);
@@ -221,14 +227,29 @@ bool CompileState::compile() {
   auto replaced = driverFactory_.replaceOperators(
       driver_, first, operatorIndex, std::move(added));
   waveOp->setReplaced(std::move(replaced));
+  operatorIndex = first + 1;
   return true;
 }
 
 bool waveDriverAdapter(
     const exec::DriverFactory& factory,
     exec::Driver& driver) {
-  auto state = std::make_shared<CompileState>(factory, driver);
-  return state->compile();
+  bool changed = false;
+  std::shared_ptr<GpuArena> arena;
+  // Each run of supported Operators becomes a WaveDriver. The Operators
+  // between the runs stay on the host.
+  for (int32_t operatorIndex = 0; operatorIndex < driver.operators().size();) {
+    auto state = std::make_shared<CompileState>(factory, driver);
+    state->setArena(arena);
+    if (state->compile(operatorIndex)) {
+      changed = true;
+      arena = state->sharedArena();
+    }
+    if (!FLAGS_velox_wave_split_plans) {
+      break;
+    }
+  }
+  return changed;
 }
 
 bool AggregateRegistry::registerGenerator(
@@ -54,6 +54,7 @@ enum class StepKind : int8_t {
   kNullCheck,
   kEndNullCheck,
   kValues,
+  kHostInput,
   kTableScan,
   kFilter,
   kAggregateProbe,
@@ -191,6 +192,20 @@ struct ValuesStep : public KernelStep {
   std::vector<AbstractOperand*> results;
 };
 
+/// Source of a pipeline that starts after a host Operator. The results are
+/// the columns of the host input, copied to the device by HostInput.
+struct HostInputStep : public KernelStep {
+  StepKind kind() const override {
+    return StepKind::kHostInput;
+  }
+
+  void visitResults(
+      std::function<void(AbstractOperand*)> visitor) const override;
+
+  RowTypePtr type;
+  std::vector<AbstractOperand*> results;
+};
+
 struct TableScanStep : public KernelStep {
   StepKind kind() const override {
     return StepKind::kTableScan;
@@ -863,9 +878,13 @@ class CompileState {
     return driver_;
   }
 
-  // Replaces sequences of Operators in the Driver given at construction with
-  // Wave equivalents. Returns true if the Driver was changed.
-  bool compile();
+  // Replaces the longest run of supported Operators starting at
+  // 'operatorIndex' in the Driver given at construction with a WaveDriver.
+  // If the run does not start the Driver, the WaveDriver takes the output of
+  // the preceding Operator as host input. Returns true if the Driver was
+  // changed. 'operatorIndex' is set to the index of the first Operator after
+  // the WaveDriver or after the unsupported Operator at 'operatorIndex'.
+  bool compile(int32_t& operatorIndex);
 
   common::Subfield* toSubfield(const exec::Expr& expr);
 
@@ -907,6 +926,16 @@ class CompileState {
     return arena_.get();
   }
 
+  const std::shared_ptr<GpuArena>& sharedArena() const {
+    return arena_;
+  }
+
+  /// Sets the arena to use instead of allocating one in reserveMemory().
+  /// WaveDrivers in the same Driver share one arena.
+  void setArena(std::shared_ptr<GpuArena> arena) {
+    arena_ = std::move(arena);
+  }
+
   int numOperators() const {
     return operators_.size();
   }
@@ -1156,9 +1185,18 @@ class CompileState {
 
   // Partitions the Driver's Operators into segments, one per cardinality
   // change. 'operatorIndex' is the index of the first considered operator and
-  // is set to one after the last converted operator.
+  // is set to one after the last converted operator. Returns false if no
+  // operator was converted.
   bool makeSegments(int32_t& operatorIndex);
 
+  // Adds a source segment for the host input of a pipeline starting at
+  // 'operatorIndex' > 0. Sets 'nodeIndex' to the index of the matching plan
+  // node and 'outputType' to the type of the host input.
+  void addHostInput(
+      int32_t operatorIndex,
+      int32_t& nodeIndex,
+      RowTypePtr& outputType);
+
   void recordCandidate(PipelineCandidate& candidate, int32_t lastSegmentIdx);
 
   void planSegment(
@@ -1187,9 +1225,10 @@ class CompileState {
 
   void fillExtraWrap(OperandSet& extraWrap);
 
-  // Transforms the leading operators into WaveOperators with codegen.
-  // 'operatorIndex' is set to 1 after the index of the last transformed
-  // operator inde the original Driver.
+  // Transforms the operators starting at 'operatorIndex' into WaveOperators
+  // with codegen. 'operatorIndex' is set to 1 after the index of the last
+  // transformed operator inde the original Driver. Returns nullptr if no
+  // operator was transformed.
   RowTypePtr makeOperators(
       int32_t& operatorIndex,
       std::vector<OperandId>& resultOrder);
@@ -19,6 +19,7 @@
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/HostInput.h"
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
@@ -301,7 +302,7 @@ WaveDriver::WaveDriver(
     std::vector<std::unique_ptr<WaveOperator>> waveOperators,
     std::vector<OperandId> resultOrder,
     std::shared_ptr<WaveRuntimeObjects> runtime)
-    : exec::SourceOperator(
+    : exec::Operator(
           driverCtx,
           outputType,
           operatorId,
@@ -329,6 +330,23 @@ WaveDriver::WaveDriver(
   // True unless ends with repartitioning.
   pipelines_.back().makesHostResult = true;
   pipelines_.front().canAdvance = true;
+  hostInput_ = dynamic_cast<HostInput*>(pipelines_[0].operators[0].get());
+}
+
+bool WaveDriver::needsInput() const {
+  return hostInput_ != nullptr && !finished_ && hostInput_->canAddInput();
+}
+
+void WaveDriver::addInput(RowVectorPtr input) {
+  VELOX_CHECK_NOT_NULL(hostInput_, "{} does not take input", toString());
+  hostInput_->addInput(std::move(input));
+}
+
+void WaveDriver::noMoreInput() {
+  Operator::noMoreInput();
+  if (hostInput_) {
+    hostInput_->noMoreInput();
+  }
 }
 
 bool WaveDriver::shouldYield(
@@ -499,6 +517,9 @@ exec::BlockingReason WaveDriver::processArrived(Pipeline& pipeline) {
 
     if (continued) {
       --streamIdx;
+    } else if (pipeline.operators[0]->isWaitingForInput()) {
+      // The stream is continued when the Driver adds the next batch.
+      waitingForInput_ = true;
     } else {
       /// Not blocked and not continuable, so must be at end.
       pipeline.arrived[streamIdx]->releaseStreamsAndEvents();
@@ -642,6 +663,7 @@ Advance WaveDriver::advance(int pipelineIdx) {
         pipeline.arrived[i]->resetSink();
       }
     }
+    waitingForInput_ = false;
     blockingReason_ = processArrived(pipeline);
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
       totalWaitLoops += waitLoops;
@@ -692,6 +714,13 @@ Advance WaveDriver::advance(int pipelineIdx) {
         ++waitLoops;
       }
     }
+    if (waitingForInput_) {
+      // Returns to the Driver for more host input. The running streams
+      // continue on the device meanwhile.
+      totalWaitLoops += waitLoops;
+      waveStats_.waitTime.micros += waitUs;
+      return Advance::kBlocked;
+    }
     if (pipeline.finished.empty() &&
         pipeline.running.size() + pipeline.arrived.size() <
             FLAGS_max_streams_per_driver) {
@@ -160,8 +160,13 @@ struct WaveRuntimeObjects {
   std::vector<std::unique_ptr<AbstractState>> states;
 };
 
-/// Operator that replaces a sequence of Velox Operators offloaded to Wave.
-class WaveDriver : public exec::SourceOperator {
+class HostInput;
+
+/// Operator that replaces a sequence of Velox Operators offloaded to Wave. If
+/// the sequence does not start the Driver, 'this' takes the output of the
+/// preceding host Operator as input and its first WaveOperator is a
+/// HostInput.
+class WaveDriver : public exec::Operator {
  public:
   WaveDriver(
       exec::DriverCtx* driverCtx,
@@ -173,6 +178,12 @@ class WaveDriver : public exec::SourceOperator {
       std::vector<OperandId> resultOrder_,
       std::shared_ptr<WaveRuntimeObjects> runtime);
 
+  bool needsInput() const override;
+
+  void addInput(RowVectorPtr input) override;
+
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   exec::BlockingReason isBlocked(ContinueFuture* future) override {
@@ -320,6 +331,13 @@ class WaveDriver : public exec::SourceOperator {
 
   bool hasError_{false};
 
+  // The source of the first pipeline if 'this' takes host input.
+  HostInput* hostInput_{nullptr};
+
+  // Set by processArrived() if a stream is idle because 'hostInput_' has no
+  // batch.
+  bool waitingForInput_{false};
+
   // Streams for device side activity. First in destruct order to finish device
   // activity before releasing shared device resources.
   std::vector<Pipeline> pipelines_;
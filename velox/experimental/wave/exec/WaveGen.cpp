@@ -15,6 +15,7 @@
  */
 
 #include "velox/experimental/wave/exec/AggregateGen.h"
+#include "velox/experimental/wave/exec/HostInput.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/ToWave.h"
@@ -1054,6 +1055,11 @@ void CompileState::generatePrograms() {
           std::make_unique<Values>(*this, *firstStep->as<ValuesStep>().node));
       start = 1;
     }
+    if (firstStep->kind() == StepKind::kHostInput) {
+      operators_.push_back(std::make_unique<HostInput>(
+          *this, firstStep->as<HostInputStep>().type, startNodeId_));
+      start = 1;
+    }
 
     if (start == 1) {
       currentCandidate_->setOutputIds(this, operators_[0].get(), 0, 1);
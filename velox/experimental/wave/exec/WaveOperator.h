@@ -89,6 +89,12 @@ class WaveOperator {
     VELOX_FAIL("Override for source or blocking operator");
   }
 
+  /// True for a source that has no rows to produce until it gets more input
+  /// from the Driver.
+  virtual bool isWaitingForInput() const {
+    return false;
+  }
+
   virtual bool isSink() const {
     return false;
   }
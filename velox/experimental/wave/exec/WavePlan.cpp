@@ -65,6 +65,13 @@ void ValuesStep::visitResults(
   }
 }
 
+void HostInputStep::visitResults(
+    std::function<void(AbstractOperand*)> visitor) const {
+  for (auto& out : results) {
+    visitor(out);
+  }
+}
+
 void Compute::visitReferences(
     std::function<void(AbstractOperand*)> visitor) const {
   for (auto& in : operand->inputs) {
@@ -537,11 +544,42 @@ bool CompileState::tryPlanOperator(
   return true;
 }
 
+void CompileState::addHostInput(
+    int32_t operatorIndex,
+    int32_t& nodeIndex,
+    RowTypePtr& outputType) {
+  auto* op = driver_.operators()[operatorIndex];
+  auto& planNodes = driverFactory_.planNodes;
+  auto it = std::find_if(
+      planNodes.begin(), planNodes.end(), [&](const auto& node) {
+        return node->id() == op->planNodeId();
+      });
+  // A HashBuild has the id of the join, which is the consumer node.
+  nodeIndex = it - planNodes.begin();
+  // A FilterProject of a Filter and a Project has the id of the Project.
+  if (nodeIndex > 1 && nodeIndex < planNodes.size() &&
+      dynamic_cast<const core::ProjectNode*>(planNodes[nodeIndex].get()) &&
+      dynamic_cast<const core::FilterNode*>(planNodes[nodeIndex - 1].get())) {
+    --nodeIndex;
+  }
+  VELOX_CHECK_GT(nodeIndex, 0);
+  outputType = planNodes[nodeIndex - 1]->outputType();
+  addSegment(BoundaryType::kSource, nullptr, outputType);
+  auto step = makeStep<HostInputStep>();
+  step->type = outputType;
+  step->results = rowTypeToOperands(outputType);
+  segments_.back().steps.push_back(step);
+}
+
 bool CompileState::makeSegments(int32_t& operatorIndex) {
   auto operators = driver_.operators();
   int32_t nodeIndex = 0;
   RowTypePtr outputType;
   RowTypePtr inputType;
+  const auto first = operatorIndex;
+  if (first > 0) {
+    addHostInput(first, nodeIndex, outputType);
+  }
   for (; operatorIndex < operators.size(); ++operatorIndex) {
     if (!tryPlanOperator(operators[operatorIndex], nodeIndex, outputType)) {
       break;
@@ -551,6 +589,9 @@ bool CompileState::makeSegments(int32_t& operatorIndex) {
     }
     ++nodeIndex;
   }
+  if (operatorIndex == first) {
+    return false;
+  }
   if (!segments_.back().outputType) {
     segments_.back().outputType = outputType;
   }
@@ -1158,7 +1199,9 @@ void CompileState::markWraps(int32_t pipelineIdx) {
 RowTypePtr CompileState::makeOperators(
     int32_t& operatorIndex,
     std::vector<OperandId>& resultOrder) {
-  makeSegments(operatorIndex);
+  if (!makeSegments(operatorIndex)) {
+    return nullptr;
+  }
   auto outputType = segments_.back().outputType;
   for (auto i = 0; i < outputType->size(); ++i) {
     auto op = fieldToOperand(*toSubfield(outputType->nameOf(i)), &topScope_);
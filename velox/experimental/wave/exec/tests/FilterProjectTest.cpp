@@ -134,6 +134,30 @@ TEST_F(FilterProjectTest, filterProject) {
       vectors);
 }
 
+TEST_F(FilterProjectTest, hostInput) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  // The Limit stays on the host. The Values and the FilterProject after the
+  // Limit run in separate WaveDrivers.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .limit(0, 700, false)
+                  .filter("c0 < 400000000")
+                  .project({"c0", "c1 + c0 as s"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, c1 + c0 FROM (SELECT * FROM tmp LIMIT 700) "
+      "WHERE c0 < 400000000");
+}
+
 TEST_F(FilterProjectTest, error) {
   auto data = makeRowVector(
       {makeFlatVector<int64_t>(12'000, [](auto row) { return row; })});
@@ -18,6 +18,7 @@
 #include "velox/common/base/CountBits.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/core/CoreTypeSystem.h"
+#include "velox/expression/CastKernels.h"
 #include "velox/expression/StringWriter.h"
 #include "velox/type/Type.h"
 #include "velox/vector/SelectivityVector.h"
@@ -697,21 +698,53 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  // Casts the strings in the common formats with the fast parsers first. The
+  // other rows are cast row by row below.
+  const SelectivityVector* remainingRows = &rows;
+  LocalSelectivityVector slowRows(context);
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+       ToKind == TypeKind::DOUBLE)) {
+    auto* slow = slowRows.get(rows.end(), false);
+    auto* rawResults = resultFlatVector->mutableRawValues();
+    resultFlatVector->clearNulls(rows);
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto value = inputSimpleVector->valueAt(row);
+      bool parsed;
+      if constexpr (ToKind == TypeKind::DOUBLE) {
+        parsed = detail::tryParseDouble(value, rawResults[row]);
+      } else {
+        parsed = detail::tryParseInteger(value, rawResults[row]);
+      }
+      if (!parsed) {
+        slow->setValid(row, true);
+      }
+    });
+    slow->updateBounds();
+    if (!slow->hasSelections()) {
+      return;
+    }
+    remainingRows = slow;
+  }
+  const auto& remaining = *remainingRows;
+
   switch (hooks_->getPolicy()) {
     case LegacyCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case PrestoCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::PrestoCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case SparkCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::SparkCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
@@ -17,6 +17,7 @@
 #include "velox/expression/CastExpr.h"
 
 #include <fmt/format.h>
+#include <charconv>
 #include <stdexcept>
 
 #include "velox/common/base/Exceptions.h"
@@ -790,6 +791,23 @@ void CastExpr::applyPeeled(
       (toType->kind() == TypeKind::VARCHAR ||
        toType->kind() == TypeKind::VARBINARY)) {
     result = applyTimestampToVarcharCast(toType, rows, context, input);
+  } else if (toType->kind() == TypeKind::VARCHAR) {
+    switch (fromType->kind()) {
+      case TypeKind::SMALLINT:
+        result = applyIntToVarcharCast<int16_t>(rows, context, input);
+        break;
+      case TypeKind::INTEGER:
+        result = applyIntToVarcharCast<int32_t>(rows, context, input);
+        break;
+      case TypeKind::BIGINT:
+        result = applyIntToVarcharCast<int64_t>(rows, context, input);
+        break;
+      default:
+        // Handle primitive type conversions.
+        applyCastPrimitivesDispatch<TypeKind::VARCHAR>(
+            fromType, toType, rows, context, input, result);
+        break;
+    }
   } else if (toType->kind() == TypeKind::VARBINARY) {
     switch (fromType->kind()) {
       case TypeKind::TINYINT:
@@ -918,6 +936,58 @@ VectorPtr CastExpr::applyIntToBinaryCast(
   return result;
 }
 
+template <typename TInput>
+VectorPtr CastExpr::applyIntToVarcharCast(
+    const SelectivityVector& rows,
+    exec::EvalCtx& context,
+    const BaseVector& input) {
+  static constexpr int32_t kMaxLength = 20;
+  VectorPtr result;
+  context.ensureWritable(rows, VARCHAR(), result);
+  (*result).clearNulls(rows);
+  auto flatResult = result->asFlatVector<StringView>();
+  const auto simpleInput = input.as<SimpleVector<TInput>>();
+
+  // Only BIGINT values with 13 or more characters are not inlined.
+  const auto isInline = [](TInput value) {
+    if constexpr (std::is_same_v<TInput, int64_t>) {
+      return value < 1'000'000'000'000 && value > -100'000'000'000;
+    }
+    return true;
+  };
+  vector_size_t numNotInline = 0;
+  if constexpr (std::is_same_v<TInput, int64_t>) {
+    rows.applyToSelected([&](vector_size_t row) {
+      numNotInline += !isInline(simpleInput->valueAt(row));
+    });
+  }
+  Buffer* buffer = nullptr;
+  char* rawBuffer = nullptr;
+  if (numNotInline > 0) {
+    buffer = flatResult->getBufferWithSpace(
+        numNotInline * kMaxLength, true /*exactSize*/);
+    rawBuffer = buffer->asMutable<char>() + buffer->size();
+  }
+
+  char inlined[kMaxLength];
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto value = simpleInput->valueAt(row);
+    char* output = isInline(value) ? inlined : rawBuffer;
+    const auto size = std::to_chars(output, output + kMaxLength, value).ptr -
+        output;
+    flatResult->setNoCopy(row, StringView(output, size));
+    if (output == rawBuffer) {
+      rawBuffer += size;
+    }
+  });
+
+  if (buffer != nullptr) {
+    // Update the exact buffer size.
+    buffer->setSize(rawBuffer - buffer->asMutable<char>());
+  }
+  return result;
+}
+
 void CastExpr::apply(
     const SelectivityVector& rows,
     const VectorPtr& input,
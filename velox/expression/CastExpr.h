@@ -228,6 +228,14 @@ class CastExpr : public SpecialForm {
       exec::EvalCtx& context,
       const BaseVector& input);
 
+  /// Formats the integers of 'input' as decimal strings. The strings that do
+  /// not fit inline in StringView are written to one string buffer.
+  template <typename TInput>
+  VectorPtr applyIntToVarcharCast(
+      const SelectivityVector& rows,
+      exec::EvalCtx& context,
+      const BaseVector& input);
+
   template <typename TInput, typename TOutput>
   void applyFloatingPointToDecimalCastKernel(
       const SelectivityVector& rows,
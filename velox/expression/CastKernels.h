@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "velox/type/StringView.h"
+
+/// Fast paths for the casts of strings in the most common formats to numbers.
+/// They accept a subset of the formats the regular casts accept, which they
+/// parse to the same values. For other strings they return false and the
+/// regular casts handle them, including the white space handling and the
+/// errors of the cast policy.
+
+namespace facebook::velox::exec::detail {
+
+/// Returns true if the 8 bytes of 'chunk' are ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+/// Returns the value of the 8 ASCII digits in 'chunk'. The first digit is in
+/// the lowest byte. Combines pairs of digits, then pairs of pairs, and so on
+/// with one multiplication per step.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+  chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+  return ((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+}
+
+/// Parses 1 to 18 ASCII digits into 'value'. Returns false if there is a
+/// character that is not a digit.
+inline bool parseDigits(const char* data, int32_t size, uint64_t& value) {
+  uint64_t prefix = 0;
+  if (size > 16) {
+    for (auto i = 0; i < size - 16; ++i) {
+      const uint8_t digit = data[i] - '0';
+      if (digit > 9) {
+        return false;
+      }
+      prefix = prefix * 10 + digit;
+    }
+    data += size - 16;
+    size = 16;
+  }
+  // Pads the digits with leading zeros to 16.
+  char padded[16];
+  std::memset(padded, '0', sizeof(padded));
+  std::memcpy(padded + sizeof(padded) - size, data, size);
+  uint64_t high;
+  uint64_t low;
+  std::memcpy(&high, padded, 8);
+  std::memcpy(&low, padded + 8, 8);
+  if (!isEightDigits(high) || !isEightDigits(low)) {
+    return false;
+  }
+  value = prefix * 10'000'000'000'000'000 +
+      parseEightDigits(high) * uint64_t{100'000'000} + parseEightDigits(low);
+  return true;
+}
+
+/// Parses 'input' into 'result' if it is an optional '-' followed by 1 to 18
+/// ASCII digits and the value fits in T.
+template <typename T>
+bool tryParseInteger(StringView input, T& result) {
+  const char* data = input.data();
+  int32_t size = input.size();
+  const bool negative = size > 0 && data[0] == '-';
+  data += negative;
+  size -= negative;
+  if (size == 0 || size > 18) {
+    return false;
+  }
+  uint64_t value;
+  if (!parseDigits(data, size, value)) {
+    return false;
+  }
+  const int64_t signedValue =
+      negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+  if (signedValue < std::numeric_limits<T>::min() ||
+      signedValue > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  result = signedValue;
+  return true;
+}
+
+/// Parses 'input' into 'result' if it is an optional '-', digits with an
+/// optional fraction of one or more digits and an optional exponent, and the
+/// value can be computed exactly in double arithmetic: the digits without the
+/// point are at most 2^53 and the power of ten is at most 22 (Clinger's fast
+/// path). The result is then correctly rounded, as by the regular casts.
+inline bool tryParseDouble(StringView input, double& result) {
+  static constexpr double kPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  static constexpr int32_t kMaxPowerOfTen = 22;
+
+  const char* current = input.data();
+  const char* end = current + input.size();
+  const auto isDigit = [&]() {
+    return current < end && static_cast<uint8_t>(*current - '0') <= 9;
+  };
+
+  const bool negative = current < end && *current == '-';
+  current += negative;
+
+  // Overflows with more than 19 digits, which is checked below.
+  uint64_t mantissa = 0;
+  const char* digits = current;
+  for (; isDigit(); ++current) {
+    mantissa = mantissa * 10 + (*current - '0');
+  }
+  int32_t numDigits = current - digits;
+  if (numDigits == 0) {
+    return false;
+  }
+  int32_t exponent = 0;
+  if (current < end && *current == '.') {
+    const char* fraction = ++current;
+    for (; isDigit(); ++current) {
+      mantissa = mantissa * 10 + (*current - '0');
+    }
+    if (current == fraction) {
+      return false;
+    }
+    exponent = fraction - current;
+    numDigits += current - fraction;
+  }
+  if (numDigits > 19) {
+    return false;
+  }
+  if (current < end && (*current == 'e' || *current == 'E')) {
+    ++current;
+    const bool negativeExponent = current < end && *current == '-';
+    if (current < end && (*current == '-' || *current == '+')) {
+      ++current;
+    }
+    const char* exponentDigits = current;
+    int32_t value = 0;
+    for (; isDigit() && current - exponentDigits < 3; ++current) {
+      value = value * 10 + (*current - '0');
+    }
+    if (current == exponentDigits) {
+      return false;
+    }
+    exponent += negativeExponent ? -value : value;
+  }
+  if (current != end || mantissa > (uint64_t{1} << 53) ||
+      exponent < -kMaxPowerOfTen || exponent > kMaxPowerOfTen) {
+    return false;
+  }
+
+  double value = mantissa;
+  value = exponent < 0 ? value / kPowersOfTen[-exponent]
+                       : value * kPowersOfTen[exponent];
+  result = negative ? -value : value;
+  return true;
+}
+
+} // namespace facebook::velox::exec::detail
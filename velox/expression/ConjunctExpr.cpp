@@ -116,6 +116,7 @@ void ConjunctExpr::evalSpecialForm(
   // OR: fix finalSelection at "rows" unless already fixed
   ScopedFinalSelectionSetter scopedFinalSelectionSetter(
       context, &rows, !isAnd_);
+  initializeFields();
 
   bool handleErrors = false;
   LocalSelectivityVector errorRows(context);
@@ -131,15 +132,11 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
     if (evaluatesArgumentsOnNonIncreasingSelection()) {
       // Exclude loading rows that we know for sure will have a false result.
-      for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
-        if (multiplyReferencedFields_.count(field) > 0) {
-          context.ensureFieldLoaded(field->index(context), *activeRows);
-        }
-      }
+      loadFields(inputOrder_[i], *activeRows, context);
     }
+    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
     inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
     if (context.errors()) {
       handleErrors = true;
@@ -178,23 +175,171 @@ void ConjunctExpr::evalSpecialForm(
   }
 }
 
+std::vector<FieldReference*> ConjunctExpr::fieldsLoadedOnActiveRows() {
+  initializeFields();
+  std::vector<FieldReference*> fields;
+  if (isAnd_) {
+    for (auto i = 0; i < fields_.size(); ++i) {
+      if (loadOnActiveRows_[i]) {
+        fields.push_back(fields_[i]);
+      }
+    }
+  }
+  return fields;
+}
+
+void ConjunctExpr::initializeFields() {
+  if (fieldsInitialized_) {
+    return;
+  }
+  fieldsInitialized_ = true;
+  inputFields_.resize(inputs_.size());
+  std::vector<bool> inConditional;
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    for (auto* field : inputs_[i]->distinctFields()) {
+      auto it = std::find(fields_.begin(), fields_.end(), field);
+      const int32_t index = it - fields_.begin();
+      if (it == fields_.end()) {
+        fields_.push_back(field);
+        inConditional.push_back(false);
+      }
+      inputFields_[i].push_back(index);
+      if (inputs_[i]->hasConditionals()) {
+        inConditional[index] = true;
+      }
+    }
+  }
+  // A field that is referenced by more than one input is loaded on the
+  // active rows before the first input that needs it, so that later inputs
+  // do not load more rows. So is a field of a single input without
+  // conditionals, since the input needs the field for all the active rows.
+  // A field that is referenced only inside a conditional, e.g. in a branch of
+  // an IF, is left for the input to load for the rows that reach it.
+  loadOnActiveRows_.resize(fields_.size());
+  for (auto i = 0; i < fields_.size(); ++i) {
+    loadOnActiveRows_[i] =
+        multiplyReferencedFields_.count(fields_[i]) > 0 || !inConditional[i];
+  }
+  fieldLoads_.resize(fields_.size());
+}
+
+void ConjunctExpr::loadFields(
+    int32_t index,
+    const SelectivityVector& rows,
+    EvalCtx& context) {
+  const auto numRows = rows.countSelected();
+  for (auto field : inputFields_[index]) {
+    if (!loadOnActiveRows_[field]) {
+      continue;
+    }
+    const auto fieldIndex = fields_[field]->index(context);
+    if (!isLazyNotLoaded(*context.getField(fieldIndex))) {
+      continue;
+    }
+    SelectivityTimer timer(fieldLoads_[field], numRows);
+    context.ensureFieldLoaded(fieldIndex, rows);
+  }
+}
+
+double ConjunctExpr::expectedCost(const std::vector<int32_t>& order) const {
+  std::vector<bool> loaded(fields_.size(), false);
+  double cost = 0;
+  double activeFraction = 1;
+  for (auto input : order) {
+    const auto& selectivity = selectivity_[input];
+    if (selectivity.numIn() == 0) {
+      continue;
+    }
+    double inputCost = static_cast<double>(selectivity.timeClocks()) /
+        static_cast<double>(selectivity.numIn());
+    for (auto field : inputFields_[input]) {
+      const auto& load = fieldLoads_[field];
+      if (!loaded[field] && load.numIn() > 0) {
+        inputCost += static_cast<double>(load.timeClocks()) /
+            static_cast<double>(load.numIn());
+      }
+      loaded[field] = true;
+    }
+    cost += activeFraction * inputCost;
+    activeFraction *= static_cast<double>(selectivity.numOut()) /
+        static_cast<double>(selectivity.numIn());
+  }
+  return cost;
+}
+
 void ConjunctExpr::maybeReorderInputs() {
-  bool reorder = false;
-  for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
-      reorder = true;
-      break;
+  // The inputs that have not seen any rows go first so that their cost gets
+  // known.
+  std::vector<int32_t> order;
+  std::vector<int32_t> measured;
+  for (auto input : inputOrder_) {
+    if (selectivity_[input].numIn() == 0) {
+      order.push_back(input);
+    } else {
+      measured.push_back(input);
     }
   }
-  if (reorder) {
-    std::sort(
-        inputOrder_.begin(),
-        inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
-        });
+
+  // Orders the measured inputs by the expected cost of evaluating them. The
+  // cost of loading a field is counted once, for the first input that needs
+  // it. All the orders are tried for a few inputs. Otherwise, the inputs are
+  // picked greedily by the cost of dropping a value given the fields loaded
+  // so far.
+  constexpr int32_t kMaxExhaustiveInputs = 4;
+  auto best = measured;
+  auto bestCost = expectedCost(measured);
+  if (measured.size() <= kMaxExhaustiveInputs) {
+    auto candidate = measured;
+    std::sort(candidate.begin(), candidate.end());
+    do {
+      const auto cost = expectedCost(candidate);
+      if (cost < bestCost) {
+        best = candidate;
+        bestCost = cost;
+      }
+    } while (std::next_permutation(candidate.begin(), candidate.end()));
+  } else {
+    std::vector<int32_t> greedy;
+    std::vector<bool> loaded(fields_.size(), false);
+    auto remaining = measured;
+    while (!remaining.empty()) {
+      auto bestIt = remaining.begin();
+      double bestRank = std::numeric_limits<double>::infinity();
+      for (auto it = remaining.begin(); it != remaining.end(); ++it) {
+        const auto& selectivity = selectivity_[*it];
+        double clocks = selectivity.timeClocks();
+        for (auto field : inputFields_[*it]) {
+          const auto& load = fieldLoads_[field];
+          if (!loaded[field] && load.numIn() > 0) {
+            clocks += static_cast<double>(load.timeClocks()) *
+                selectivity.numIn() / load.numIn();
+          }
+        }
+        const auto numDropped = selectivity.numIn() - selectivity.numOut();
+        const double rank = numDropped == 0
+            ? std::numeric_limits<double>::infinity()
+            : clocks / numDropped;
+        if (rank < bestRank) {
+          bestIt = it;
+          bestRank = rank;
+        }
+      }
+      for (auto field : inputFields_[*bestIt]) {
+        loaded[field] = true;
+      }
+      greedy.push_back(*bestIt);
+      remaining.erase(bestIt);
+    }
+    const auto cost = expectedCost(greedy);
+    if (cost < bestCost) {
+      best = std::move(greedy);
+      bestCost = cost;
+    }
+  }
+  order.insert(order.end(), best.begin(), best.end());
+  if (order != inputOrder_) {
+    inputOrder_ = std::move(order);
+    ++numReorders_;
   }
 }
 
@@ -67,6 +67,26 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  bool isAnd() const {
+    return isAnd_;
+  }
+
+  /// Returns the indices of the inputs in the order they are evaluated.
+  const std::vector<int32_t>& inputOrder() const {
+    return inputOrder_;
+  }
+
+  /// Returns how many times the evaluation order of the inputs changed.
+  uint64_t numReorders() const {
+    return numReorders_;
+  }
+
+  /// Returns the top-level fields an AND loads on the rows that are still
+  /// active before evaluating the first input that references them. The
+  /// values of these fields are loaded at least for the rows that pass. Empty
+  /// for an OR.
+  std::vector<FieldReference*> fieldsLoadedOnActiveRows();
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -83,6 +103,20 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Collects the distinct fields of the inputs into 'fields_'.
+  void initializeFields();
+
+  // Loads the lazy fields of input 'index' that are not loaded yet for
+  // 'rows'. The time is added to the load cost of the field.
+  void
+  loadFields(int32_t index, const SelectivityVector& rows, EvalCtx& context);
+
+  // Returns the expected clocks per input row of evaluating the inputs in
+  // 'order', i.e. the sum of the cost of each input and of the loads of its
+  // fields that are not loaded by an earlier input, weighted by the fraction
+  // of rows still active when the input is evaluated.
+  double expectedCost(const std::vector<int32_t>& order) const;
+
   void maybeReorderInputs();
 
   void updateResult(
@@ -105,6 +139,20 @@ class ConjunctExpr : public SpecialForm {
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  uint64_t numReorders_{0};
+
+  bool fieldsInitialized_{false};
+  // The distinct top-level fields of the inputs.
+  std::vector<FieldReference*> fields_;
+  // Indices into 'fields_' of the fields of each input.
+  std::vector<std::vector<int32_t>> inputFields_;
+  // For each of 'fields_', true if an AND loads the field on the active rows
+  // before evaluating any of the inputs that reference it. False for fields
+  // that are only referenced by one input with conditionals. These are loaded
+  // by the input for the rows it needs.
+  std::vector<bool> loadOnActiveRows_;
+  // The load cost of each of 'fields_'.
+  std::vector<SelectivityInfo> fieldLoads_;
 
   friend class ConjunctCallToSpecialForm;
 };
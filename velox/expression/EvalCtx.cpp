@@ -332,13 +332,13 @@ VectorPtr extendSizeByWrappingInDictionary(
   targetSize = std::max(targetSize, currentSize);
   VELOX_DCHECK(
       !vector->type()->isPrimitiveType(), "Only used for complex types.");
-  BufferPtr indices = allocateIndices(targetSize, context.pool());
+  BufferPtr indices = context.allocateIndices(targetSize);
   auto rawIndices = indices->asMutable<vector_size_t>();
   // Only fill in indices for existing rows in the vector.
   std::iota(rawIndices, rawIndices + currentSize, 0);
   // A nulls buffer is required otherwise wrapInDictionary() can return a
   // constant. Moreover, nulls will eventually be added, so it's not wasteful.
-  auto nulls = allocateNulls(targetSize, context.pool());
+  auto nulls = context.allocateNulls(targetSize);
   return BaseVector::wrapInDictionary(
       std::move(nulls), std::move(indices), targetSize, std::move(vector));
 }
@@ -505,6 +505,18 @@ class EvalCtx {
     return execCtx_->releaseVectors(vectors);
   }
 
+  /// Returns a nulls buffer for 'size' rows from the arena of temporary
+  /// buffers of 'execCtx_'.
+  BufferPtr allocateNulls(vector_size_t size, bool initValue = bits::kNotNull) {
+    return execCtx_->allocateNulls(size, initValue);
+  }
+
+  /// Returns an indices buffer for 'size' rows from the arena of temporary
+  /// buffers of 'execCtx_'.
+  BufferPtr allocateIndices(vector_size_t size) {
+    return execCtx_->allocateIndices(size);
+  }
+
   /// Makes 'result' writable for 'rows'. Allocates or reuses a vector from the
   /// pool of 'execCtx_' if needed.
   void ensureWritable(
@@ -16,6 +16,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/ScopeGuard.h>
 #include <fstream>
 
 #include "velox/common/base/Exceptions.h"
@@ -138,6 +139,21 @@ Expr::Expr(
       inputIsConstant_.push_back(false);
     }
   }
+
+  if (vectorFunctionMetadata_.cacheResultsByValue &&
+      vectorFunctionMetadata_.deterministic &&
+      vectorFunctionMetadata_.defaultNullBehavior &&
+      std::count(inputIsConstant_.begin(), inputIsConstant_.end(), false) ==
+          1) {
+    const auto argIndex =
+        std::find(inputIsConstant_.begin(), inputIsConstant_.end(), false) -
+        inputIsConstant_.begin();
+    const auto kind = inputs_[argIndex]->type()->kind();
+    if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+      valueCache_ = std::make_unique<ValueCache>();
+      valueCache_->argIndex = argIndex;
+    }
+  }
 }
 
 // static
@@ -1527,7 +1543,10 @@ void Expr::applyFunction(
       : std::nullopt;
 
   try {
-    vectorFunction_->apply(rows, inputValues_, type(), context, result);
+    if (valueCache_ == nullptr ||
+        !applyFunctionWithValueCache(rows, context, result)) {
+      vectorFunction_->apply(rows, inputValues_, type(), context, result);
+    }
   } catch (const VeloxException&) {
     throw;
   } catch (const std::exception& e) {
@@ -1561,6 +1580,88 @@ void Expr::applyFunction(
   }
 }
 
+namespace {
+// Bounds for the memory retained by Expr::valueCache_. The cache is cleared
+// when a batch could exceed them.
+constexpr size_t kMaxValueCacheEntries = 10'000;
+constexpr uint64_t kMaxValueCacheKeyBytes = 8 << 20;
+} // namespace
+
+bool Expr::applyFunctionWithValueCache(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  auto& cache = *valueCache_;
+  LocalDecodedVector decodedHolder(
+      context, *inputValues_[cache.argIndex], rows);
+  const auto* decoded = decodedHolder.get();
+  if (decoded->mayHaveNulls()) {
+    return false;
+  }
+  const auto numRows = rows.countSelected();
+  if (cache.positions.size() + numRows > kMaxValueCacheEntries ||
+      cache.keyBytes > kMaxValueCacheKeyBytes) {
+    cache.clear();
+  }
+
+  // Assigns a position in the cache to each distinct value. 'missRanges' copy
+  // the results of the new values to the cache and 'resultRanges' copy the
+  // results of all rows from the cache.
+  LocalSelectivityVector missHolder(context, rows.end());
+  auto* missRows = missHolder.get();
+  missRows->clearAll();
+  std::vector<BaseVector::CopyRange> missRanges;
+  std::vector<BaseVector::CopyRange> resultRanges;
+  resultRanges.reserve(numRows);
+  rows.applyToSelected([&](auto row) {
+    const auto value = decoded->valueAt<StringView>(row);
+    const std::string_view key(value.data(), value.size());
+    auto it = cache.positions.find(key);
+    if (it == cache.positions.end()) {
+      const vector_size_t position = cache.positions.size();
+      it = cache.positions.emplace(std::string(key), position).first;
+      cache.keyBytes += key.size();
+      missRows->setValid(row, true);
+      missRanges.push_back({row, position, 1});
+    }
+    resultRanges.push_back({it->second, row, 1});
+  });
+  stats_.numValueCacheLookups += numRows;
+  stats_.numValueCacheHits += numRows - missRanges.size();
+
+  // The new positions have no values until the function succeeds.
+  auto clearOnError = folly::makeGuard([&]() { cache.clear(); });
+  if (!missRanges.empty()) {
+    missRows->updateBounds();
+    VectorPtr missResult;
+    vectorFunction_->apply(
+        *missRows, inputValues_, type(), context, missResult);
+    bool hasErrors = missResult == nullptr;
+    if (!hasErrors && context.errors() != nullptr) {
+      hasErrors = !missRows->testSelected(
+          [&](auto row) { return !context.errors()->hasErrorAt(row); });
+    }
+    if (hasErrors) {
+      return false;
+    }
+    if (cache.values == nullptr) {
+      cache.values = BaseVector::create(
+          type(),
+          std::max<vector_size_t>(cache.positions.size(), 1'024),
+          context.pool());
+    } else if (cache.values->size() < cache.positions.size()) {
+      cache.values->resize(std::max<vector_size_t>(
+          cache.positions.size(), 2 * cache.values->size()));
+    }
+    cache.values->copyRanges(missResult.get(), missRanges);
+  }
+  clearOnError.dismiss();
+
+  context.ensureWritable(rows, type(), result);
+  result->copyRanges(cache.values.get(), resultRanges);
+  return true;
+}
+
 void Expr::evalSpecialFormWithStats(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1906,6 +2007,11 @@ void ExprSet::eval(
   if (initialize) {
     clearSharedSubexprs();
   }
+  // The temporary buffers which are not referenced by the results are reused
+  // by the next batch.
+  SCOPE_EXIT {
+    context.execCtx()->resetBufferArena();
+  };
 
   // Make sure LazyVectors, referenced by multiple expressions, are loaded
   // for all the "rows".
@@ -2012,6 +2118,26 @@ void SimpleExpressionEvaluator::evaluate(
   result = results[0];
 }
 
+void SimpleExpressionEvaluator::evaluate(
+    exec::ExprSet* exprSet,
+    int32_t begin,
+    int32_t end,
+    const SelectivityVector& rows,
+    const RowVector& input,
+    std::vector<VectorPtr>& results) {
+  VELOX_CHECK_EQ(results.size(), end - begin);
+  EvalCtx context(ensureExecCtx(), exprSet, &input);
+  std::vector<VectorPtr> allResults(end);
+  for (auto i = begin; i < end; ++i) {
+    allResults[i] = std::move(results[i - begin]);
+  }
+  // Keeps the shared subexpression results of the expressions before 'begin'.
+  exprSet->eval(begin, end, begin == 0, rows, context, allResults);
+  for (auto i = begin; i < end; ++i) {
+    results[i - begin] = std::move(allResults[i]);
+  }
+}
+
 core::ExecCtx* SimpleExpressionEvaluator::ensureExecCtx() {
   if (!execCtx_) {
     execCtx_ = std::make_unique<core::ExecCtx>(pool_, queryCtx_);
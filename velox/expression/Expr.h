@@ -50,20 +50,36 @@ struct ExprStats {
   /// evaluation of rows.
   bool defaultNullRowsSkipped{false};
 
+  /// Number of rows looked up in the cache of results by input value. See
+  /// VectorFunctionMetadata::cacheResultsByValue.
+  uint64_t numValueCacheLookups{0};
+
+  /// Number of the lookups that found a cached result.
+  uint64_t numValueCacheHits{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
     defaultNullRowsSkipped |= other.defaultNullRowsSkipped;
+    numValueCacheLookups += other.numValueCacheLookups;
+    numValueCacheHits += other.numValueCacheHits;
   }
 
   std::string toString() const {
-    return fmt::format(
+    auto result = fmt::format(
         "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}",
         timing.toString(),
         numProcessedRows,
         numProcessedVectors,
         defaultNullRowsSkipped ? "true" : "false");
+    if (numValueCacheLookups > 0) {
+      result += fmt::format(
+          ", numValueCacheLookups: {}, numValueCacheHits: {}",
+          numValueCacheLookups,
+          numValueCacheHits);
+    }
+    return result;
   }
 };
 
@@ -261,6 +277,9 @@ class Expr {
   virtual void clearCache() {
     sharedSubexprResults_.clear();
     clearMemo();
+    if (valueCache_ != nullptr) {
+      valueCache_->clear();
+    }
     for (auto& input : inputs_) {
       input->clearCache();
     }
@@ -480,6 +499,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Sets 'result' for 'rows' from 'valueCache_' and calls the function only
+  // for the values not in the cache. Returns false if the results could not
+  // be cached. The caller then calls the function for all 'rows'.
+  bool applyFunctionWithValueCache(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   // Returns true if values in 'distinctFields_' have nulls that are
   // worth skipping. If so, the rows in 'rows' with at least one sure
   // null are deselected in 'nullHolder->get()'.
@@ -681,6 +708,28 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Results of the function by the value of the non-constant string argument.
+  // Set if the function has VectorFunctionMetadata::cacheResultsByValue and
+  // the other arguments are constant. Kept across batches.
+  struct ValueCache {
+    // Index of the non-constant argument in 'inputValues_'.
+    column_index_t argIndex;
+    // Maps an argument value to its position in 'values'.
+    folly::F14FastMap<std::string, vector_size_t> positions;
+    // The results for the values in 'positions'.
+    VectorPtr values;
+    // Total size of the keys in 'positions'.
+    uint64_t keyBytes{0};
+
+    void clear() {
+      positions.clear();
+      values.reset();
+      keyBytes = 0;
+    }
+  };
+
+  std::unique_ptr<ValueCache> valueCache_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -903,12 +952,25 @@ class SimpleExpressionEvaluator : public core::ExpressionEvaluator {
         std::vector<core::TypedExprPtr>{expression}, ensureExecCtx());
   }
 
+  std::unique_ptr<ExprSet> compile(
+      const std::vector<core::TypedExprPtr>& expressions) override {
+    return std::make_unique<ExprSet>(expressions, ensureExecCtx());
+  }
+
   void evaluate(
       ExprSet* exprSet,
       const SelectivityVector& rows,
       const RowVector& input,
       VectorPtr& result) override;
 
+  void evaluate(
+      ExprSet* exprSet,
+      int32_t begin,
+      int32_t end,
+      const SelectivityVector& rows,
+      const RowVector& input,
+      std::vector<VectorPtr>& results) override;
+
   memory::MemoryPool* pool() override {
     return pool_;
   }
@@ -21,6 +21,8 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FunctionResolutionCache.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -58,6 +60,14 @@ using ExprDedupMap = folly::F14FastMap<
     ITypedExprHasher,
     ITypedExprComparer>;
 
+// Map from ITypedExpr trees to their replacements from expression set
+// rewrites.
+using ExprReplacementMap = folly::F14FastMap<
+    const ITypedExpr*,
+    TypedExprPtr,
+    ITypedExprHasher,
+    ITypedExprComparer>;
+
 /// Represents a lexical scope. A top level scope corresponds to a top
 /// level Expr and is shared among the Exprs of the ExprSet. Each
 /// lambda introduces a new Scope where the 'locals' are the formal
@@ -85,6 +95,10 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // Replacements from expression set rewrites. Only used in a top level
+  // Scope. The keys point to the sources of the ExprSet.
+  ExprReplacementMap replacements;
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
       : locals(_locals), parent(_parent), exprSet(_exprSet) {}
 
@@ -418,37 +432,39 @@ ExprPtr compileRewrittenExpression(
       result = specialForm->constructSpecialForm(
           resultType, std::move(compiledInputs), trackCpuUsage, config);
     } else if (
-        auto functionWithMetadata = getVectorFunctionWithMetadata(
-            call->name(),
+        auto resolved = config.exprFunctionResolutionCacheEnabled()
+            ? FunctionResolutionCache::instance().resolve(
+                  call->name(), inputTypes)
+            : resolveScalarFunction(call->name(), inputTypes)) {
+      std::shared_ptr<VectorFunction> func;
+      VectorFunctionMetadata metadata;
+      if (resolved->vectorFunction.has_value()) {
+        func = makeVectorFunction(
+            *resolved->vectorFunction,
             inputTypes,
             getConstantInputs(compiledInputs),
-            config)) {
-      result = std::make_shared<Expr>(
-          resultType,
-          std::move(compiledInputs),
-          functionWithMetadata->first,
-          functionWithMetadata->second,
-          call->name(),
-          trackCpuUsage);
-    } else if (
-        auto simpleFunctionEntry =
-            simpleFunctions().resolveFunction(call->name(), inputTypes)) {
-      VELOX_USER_CHECK(
-          resultType->equivalent(*simpleFunctionEntry->type().get()),
-          "Found incompatible return types for '{}' ({} vs. {}) "
-          "for input types ({}).",
-          call->name(),
-          simpleFunctionEntry->type(),
-          resultType,
-          folly::join(", ", inputTypes));
+            config);
+        metadata = resolved->vectorFunction->metadata;
+      } else {
+        const auto& simpleFunctionEntry = *resolved->simpleFunction;
+        VELOX_USER_CHECK(
+            resultType->equivalent(*simpleFunctionEntry.type().get()),
+            "Found incompatible return types for '{}' ({} vs. {}) "
+            "for input types ({}).",
+            call->name(),
+            simpleFunctionEntry.type(),
+            resultType,
+            folly::join(", ", inputTypes));
 
-      auto func = simpleFunctionEntry->createFunction()->createVectorFunction(
-          inputTypes, getConstantInputs(compiledInputs), config);
+        func = simpleFunctionEntry.createFunction()->createVectorFunction(
+            inputTypes, getConstantInputs(compiledInputs), config);
+        metadata = simpleFunctionEntry.metadata();
+      }
       result = std::make_shared<Expr>(
           resultType,
           std::move(compiledInputs),
           std::move(func),
-          simpleFunctionEntry->metadata(),
+          std::move(metadata),
           call->name(),
           trackCpuUsage);
     } else {
@@ -524,6 +540,9 @@ ExprPtr compileRewrittenExpression(
   auto folded = enableConstantFolding && !isConstantExpr
       ? tryFoldIfConstant(result, scope)
       : result;
+  if (config.exprFusionEnabled() && folded == result) {
+    folded = FusedExpr::tryFuse(result);
+  }
   scope->visited[expr.get()] = folded;
   return folded;
 }
@@ -535,6 +554,18 @@ ExprPtr compileExpression(
     memory::MemoryPool* pool,
     const std::unordered_set<std::string>& flatteningCandidates,
     bool enableConstantFolding) {
+  if (!scope->replacements.empty()) {
+    auto it = scope->replacements.find(expr.get());
+    if (it != scope->replacements.end()) {
+      return compileExpression(
+          it->second,
+          scope,
+          config,
+          pool,
+          flatteningCandidates,
+          enableConstantFolding);
+    }
+  }
   auto rewritten = rewriteExpression(expr);
   if (rewritten.get() != expr.get()) {
     scope->rewrittenExpressions.push_back(rewritten);
@@ -599,6 +630,13 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   // lock function registry once vs. locking for each function call.
   auto flatteningCandidates = collectFlatteningCandidates(sources);
 
+  for (const auto& rewrite : expressionSetRewrites()) {
+    for (auto& [original, replacement] : rewrite(sources)) {
+      scope.rewrittenExpressions.push_back(original);
+      scope.replacements.emplace(original.get(), std::move(replacement));
+    }
+  }
+
   for (auto& source : sources) {
     exprs.push_back(compileExpression(
         source,
@@ -16,6 +16,8 @@
 
 #include "velox/expression/ExprToSubfieldFilter.h"
 
+#include <folly/container/F14Map.h>
+
 #include "velox/expression/Expr.h"
 
 using namespace facebook::velox;
@@ -112,6 +114,195 @@ toInt64List(const VectorPtr& vector, vector_size_t start, vector_size_t size) {
   return values;
 }
 
+bool isIntegerType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal() && !type.isDate() &&
+          !type.isIntervalDayTime() && !type.isIntervalYearMonth();
+    default:
+      return false;
+  }
+}
+
+// Returns true if 'expr' does not depend on the input row.
+bool isConstantExpr(const core::ITypedExpr& expr) {
+  if (dynamic_cast<const core::FieldAccessTypedExpr*>(&expr) ||
+      dynamic_cast<const core::InputTypedExpr*>(&expr) ||
+      dynamic_cast<const core::LambdaTypedExpr*>(&expr)) {
+    return false;
+  }
+  for (const auto& input : expr.inputs()) {
+    if (!isConstantExpr(*input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the comparison of the swapped arguments of comparison 'name', or
+// nullptr if 'name' is not a comparison.
+const char* swappedComparison(const std::string& name) {
+  static const folly::F14FastMap<std::string, const char*> kSwapped = {
+      {"eq", "eq"},
+      {"neq", "neq"},
+      {"lt", "gt"},
+      {"lte", "gte"},
+      {"gt", "lt"},
+      {"gte", "lte"}};
+  auto it = kSwapped.find(name);
+  return it == kSwapped.end() ? nullptr : it->second;
+}
+
+core::TypedExprPtr makeCall(
+    const TypePtr& type,
+    const char* name,
+    std::vector<core::TypedExprPtr> inputs) {
+  return std::make_shared<core::CallTypedExpr>(type, std::move(inputs), name);
+}
+
+// The function of the subfield in a comparison, undone on the constant side.
+struct InvertedOperand {
+  core::TypedExprPtr operand;
+  // Returns the bound on 'operand' for the bound on the function.
+  std::function<core::TypedExprPtr(const core::TypedExprPtr&)> invert;
+  // True if the function is decreasing.
+  bool decreasing;
+};
+
+// Returns the argument of the monotonic function in 'expr' and its inverse.
+// The inverse fails if it has no exact result, so that the comparison on the
+// argument is the same as on 'expr' for the rows where 'expr' does not fail.
+std::optional<InvertedOperand> invertOperand(const core::TypedExprPtr& expr) {
+  const auto& type = expr->type();
+  if (!isIntegerType(*type) || expr->inputs().empty()) {
+    return std::nullopt;
+  }
+  if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    const auto& input = cast->inputs()[0];
+    // Widening casts are exact.
+    if (!isIntegerType(*input->type()) ||
+        input->type()->cppSizeInBytes() > type->cppSizeInBytes()) {
+      return std::nullopt;
+    }
+    return InvertedOperand{
+        input,
+        [input](const core::TypedExprPtr& bound) -> core::TypedExprPtr {
+          return std::make_shared<core::CastTypedExpr>(
+              input->type(), bound, false);
+        },
+        false};
+  }
+  auto* call = asCall(expr.get());
+  if (call == nullptr) {
+    return std::nullopt;
+  }
+  const auto& inputs = call->inputs();
+  if (call->name() == "negate" && inputs.size() == 1) {
+    return InvertedOperand{
+        inputs[0],
+        [type](const core::TypedExprPtr& bound) {
+          return makeCall(type, "negate", {bound});
+        },
+        true};
+  }
+  if (inputs.size() != 2 || !isIntegerType(*inputs[0]->type()) ||
+      !isIntegerType(*inputs[1]->type())) {
+    return std::nullopt;
+  }
+  const auto& lhs = inputs[0];
+  const auto& rhs = inputs[1];
+  if (call->name() == "plus") {
+    if (isConstantExpr(*rhs)) {
+      return InvertedOperand{
+          lhs,
+          [type, rhs](const core::TypedExprPtr& bound) {
+            return makeCall(type, "minus", {bound, rhs});
+          },
+          false};
+    }
+    if (isConstantExpr(*lhs)) {
+      return InvertedOperand{
+          rhs,
+          [type, lhs](const core::TypedExprPtr& bound) {
+            return makeCall(type, "minus", {bound, lhs});
+          },
+          false};
+    }
+  } else if (call->name() == "minus") {
+    if (isConstantExpr(*rhs)) {
+      return InvertedOperand{
+          lhs,
+          [type, rhs](const core::TypedExprPtr& bound) {
+            return makeCall(type, "plus", {bound, rhs});
+          },
+          false};
+    }
+    if (isConstantExpr(*lhs)) {
+      return InvertedOperand{
+          rhs,
+          [type, lhs](const core::TypedExprPtr& bound) {
+            return makeCall(type, "minus", {lhs, bound});
+          },
+          true};
+    }
+  }
+  return std::nullopt;
+}
+
+// Rewrites comparison 'call' of a function of a subfield and constants to a
+// comparison with one function less on the subfield side. Moves the constant
+// of a comparison to the right. Returns nullptr if there is no rewrite.
+core::CallTypedExprPtr rewriteMonotonicCall(const core::CallTypedExpr& call) {
+  const auto& inputs = call.inputs();
+  if (call.name() == "between" && inputs.size() == 3) {
+    if (!isConstantExpr(*inputs[1]) || !isConstantExpr(*inputs[2])) {
+      return nullptr;
+    }
+    auto inverted = invertOperand(inputs[0]);
+    if (!inverted.has_value()) {
+      return nullptr;
+    }
+    auto lower = inverted->invert(inputs[1]);
+    auto upper = inverted->invert(inputs[2]);
+    if (inverted->decreasing) {
+      std::swap(lower, upper);
+    }
+    return std::make_shared<core::CallTypedExpr>(
+        call.type(),
+        std::vector<core::TypedExprPtr>{
+            inverted->operand, std::move(lower), std::move(upper)},
+        "between");
+  }
+  const auto* swapped = swappedComparison(call.name());
+  if (swapped == nullptr || inputs.size() != 2) {
+    return nullptr;
+  }
+  if (isConstantExpr(*inputs[0])) {
+    if (isConstantExpr(*inputs[1])) {
+      return nullptr;
+    }
+    return std::make_shared<core::CallTypedExpr>(
+        call.type(),
+        std::vector<core::TypedExprPtr>{inputs[1], inputs[0]},
+        swapped);
+  }
+  if (!isConstantExpr(*inputs[1])) {
+    return nullptr;
+  }
+  auto inverted = invertOperand(inputs[0]);
+  if (!inverted.has_value()) {
+    return nullptr;
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      call.type(),
+      std::vector<core::TypedExprPtr>{
+          inverted->operand, inverted->invert(inputs[1])},
+      inverted->decreasing ? std::string(swapped) : call.name());
+}
+
 static std::shared_ptr<ExprToSubfieldFilterParser> defaultParser =
     std::make_shared<PrestoExprToSubfieldFilterParser>();
 
@@ -528,6 +719,27 @@ PrestoExprToSubfieldFilterParser::leafCallToSubfieldFilter(
   return nullptr;
 }
 
+std::unique_ptr<common::Filter>
+PrestoExprToSubfieldFilterParser::leafCallToMetadataFilter(
+    const core::CallTypedExpr& call,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  if (auto filter =
+          leafCallToSubfieldFilter(call, subfield, evaluator, negated)) {
+    return filter;
+  }
+  // Each rewrite takes a function off the subfield side, so this ends.
+  for (auto rewritten = rewriteMonotonicCall(call); rewritten != nullptr;
+       rewritten = rewriteMonotonicCall(*rewritten)) {
+    if (auto filter = leafCallToSubfieldFilter(
+            *rewritten, subfield, evaluator, negated)) {
+      return filter;
+    }
+  }
+  return nullptr;
+}
+
 std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
     const core::TypedExprPtr& expr,
     core::ExpressionEvaluator* evaluator) {
@@ -441,6 +441,18 @@ class ExprToSubfieldFilterParser {
       core::ExpressionEvaluator* evaluator,
       bool negated = false) = 0;
 
+  /// Like leafCallToSubfieldFilter(), but may also convert leaf calls that
+  /// apply monotonic functions to the subfield, e.g. 'a + 1 > 5' to 'a > 4'.
+  /// The filter is only exact for the rows where 'call' does not fail, so it
+  /// may only be used to skip data on statistics, e.g. in MetadataFilter.
+  virtual std::unique_ptr<common::Filter> leafCallToMetadataFilter(
+      const core::CallTypedExpr& call,
+      common::Subfield& subfield,
+      core::ExpressionEvaluator* evaluator,
+      bool negated = false) {
+    return leafCallToSubfieldFilter(call, subfield, evaluator, negated);
+  }
+
  protected:
   // Converts an expression into a subfield. Returns false if the expression is
   // not a valid field expression.
@@ -504,6 +516,15 @@ class PrestoExprToSubfieldFilterParser : public ExprToSubfieldFilterParser {
       common::Subfield& subfield,
       core::ExpressionEvaluator* evaluator,
       bool negated = false) override;
+
+  /// Also converts the comparisons with the constant on the left and the
+  /// comparisons of widening integer casts, integer plus and minus of a
+  /// constant and integer negation of the subfield.
+  std::unique_ptr<common::Filter> leafCallToMetadataFilter(
+      const core::CallTypedExpr& call,
+      common::Subfield& subfield,
+      core::ExpressionEvaluator* evaluator,
+      bool negated = false) override;
 };
 
 } // namespace facebook::velox::exec
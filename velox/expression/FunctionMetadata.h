@@ -43,6 +43,14 @@ struct VectorFunctionMetadata {
 
   /// Indicates if this is a companion function.
   bool companionFunction{false};
+
+  /// True if the function is expensive enough that caching its results by the
+  /// value of the input is cheaper than evaluating it again, e.g. regular
+  /// expressions or JSON parsing. Applies to deterministic functions with
+  /// default null behavior that are called with a single non-constant string
+  /// argument. The results are cached across batches, so that repeated values
+  /// are evaluated once even if they come from different vectors.
+  bool cacheResultsByValue{false};
 };
 
 class VectorFunctionMetadataBuilder {
@@ -67,6 +75,11 @@ class VectorFunctionMetadataBuilder {
     return *this;
   }
 
+  VectorFunctionMetadataBuilder& cacheResultsByValue(bool cacheResultsByValue) {
+    metadata_.cacheResultsByValue = cacheResultsByValue;
+    return *this;
+  }
+
   const VectorFunctionMetadata& build() const {
     return metadata_;
   }
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FunctionResolutionCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+
+std::shared_ptr<const ResolvedScalarFunction> resolveScalarFunction(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes) {
+  auto resolved = std::make_shared<ResolvedScalarFunction>();
+  resolved->vectorFunction = resolveVectorFunctionFactory(name, argTypes);
+  if (!resolved->vectorFunction.has_value()) {
+    resolved->simpleFunction =
+        simpleFunctions().resolveFunction(name, argTypes);
+    if (!resolved->simpleFunction.has_value()) {
+      return nullptr;
+    }
+  }
+  return resolved;
+}
+
+std::string FunctionResolutionCache::Stats::toString() const {
+  return fmt::format(
+      "hits: {}, misses: {}, hit rate: {:.2f}%, miss time: {}us, "
+      "saved time: {}us",
+      numHits,
+      numMisses,
+      hitRate() * 100,
+      missNanos / 1'000,
+      savedNanos() / 1'000);
+}
+
+// static
+FunctionResolutionCache& FunctionResolutionCache::instance() {
+  static FunctionResolutionCache cache;
+  return cache;
+}
+
+size_t FunctionResolutionCache::KeyHasher::operator()(const Key& key) const {
+  auto hash = std::hash<std::string>{}(key.name);
+  for (const auto& type : key.argTypes) {
+    hash = bits::hashMix(hash, type->hashKind());
+  }
+  return hash;
+}
+
+bool FunctionResolutionCache::KeyComparer::operator()(
+    const Key& lhs,
+    const Key& rhs) const {
+  if (lhs.name != rhs.name || lhs.argTypes.size() != rhs.argTypes.size()) {
+    return false;
+  }
+  for (auto i = 0; i < lhs.argTypes.size(); ++i) {
+    if (*lhs.argTypes[i] != *rhs.argTypes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<const ResolvedScalarFunction> FunctionResolutionCache::resolve(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes) {
+  Key key{name, argTypes};
+  {
+    auto entries = entries_.rlock();
+    auto it = entries->find(key);
+    if (it != entries->end()) {
+      ++numHits_;
+      RECORD_METRIC_VALUE(kMetricFunctionResolutionCacheHits);
+      return it->second;
+    }
+  }
+
+  const auto generation = generation_.load();
+  uint64_t nanos{0};
+  std::shared_ptr<const ResolvedScalarFunction> resolved;
+  {
+    NanosecondTimer timer(&nanos);
+    resolved = resolveScalarFunction(name, argTypes);
+  }
+  ++numMisses_;
+  missNanos_ += nanos;
+  RECORD_METRIC_VALUE(kMetricFunctionResolutionCacheMisses);
+  // Calls that do not resolve fail the query and are not kept.
+  if (resolved == nullptr) {
+    return nullptr;
+  }
+
+  auto entries = entries_.wlock();
+  // A function that was registered or removed while resolving may change the
+  // result.
+  if (generation_.load() != generation) {
+    return resolved;
+  }
+  if (entries->size() >= maxEntries_) {
+    entries->clear();
+  }
+  entries->emplace(std::move(key), resolved);
+  return resolved;
+}
+
+void FunctionResolutionCache::clear() {
+  auto entries = entries_.wlock();
+  ++generation_;
+  entries->clear();
+}
+
+FunctionResolutionCache::Stats FunctionResolutionCache::stats() const {
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.missNanos = missNanos_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include <atomic>
+
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+/// The function that a call of a scalar function resolves to. Either
+/// 'vectorFunction' or 'simpleFunction' is set.
+struct ResolvedScalarFunction {
+  std::optional<ResolvedVectorFunction> vectorFunction;
+  std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction> simpleFunction;
+};
+
+/// Returns the function that a call of 'name' with 'argTypes' resolves to. A
+/// vector function is preferred over a simple function. Returns nullptr if no
+/// function binds to 'argTypes'.
+std::shared_ptr<const ResolvedScalarFunction> resolveScalarFunction(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes);
+
+/// Process-wide cache of the functions that calls of scalar functions resolve
+/// to, keyed by the function name and the argument types. Resolving a call
+/// binds the argument types to the signatures of all functions of the name,
+/// which for small queries that are planned over and over can take longer
+/// than running them. Constant arguments only contribute their type to the
+/// key, so that queries that differ only in the values of their parameters
+/// share the entries. The VectorFunction of a call is still made per ExprSet
+/// from the cached factory, since it can depend on the constant arguments and
+/// keep state.
+///
+/// The cache is cleared when a function is registered or removed. Code that
+/// changes vectorFunctionFactories() directly must call clear().
+class FunctionResolutionCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    /// The time spent resolving the calls that missed.
+    uint64_t missNanos{0};
+
+    double hitRate() const {
+      const auto numLookups = numHits + numMisses;
+      return numLookups == 0 ? 0 : static_cast<double>(numHits) / numLookups;
+    }
+
+    /// The time the hits saved, estimated at the average time of a miss.
+    uint64_t savedNanos() const {
+      return numMisses == 0 ? 0 : numHits * (missNanos / numMisses);
+    }
+
+    std::string toString() const;
+  };
+
+  static constexpr size_t kDefaultMaxEntries = 10'000;
+
+  /// The cache is cleared when it has 'maxEntries' entries and a call misses.
+  explicit FunctionResolutionCache(size_t maxEntries = kDefaultMaxEntries)
+      : maxEntries_(maxEntries) {}
+
+  static FunctionResolutionCache& instance();
+
+  /// Returns resolveScalarFunction() of 'name' and 'argTypes', from the cache
+  /// if the same call was resolved before.
+  std::shared_ptr<const ResolvedScalarFunction> resolve(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes);
+
+  void clear();
+
+  size_t size() const {
+    return entries_.rlock()->size();
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Key {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct KeyComparer {
+    bool operator()(const Key& lhs, const Key& rhs) const;
+  };
+
+  const size_t maxEntries_;
+  folly::Synchronized<folly::F14FastMap<
+      Key,
+      std::shared_ptr<const ResolvedScalarFunction>,
+      KeyHasher,
+      KeyComparer>>
+      entries_;
+  // Incremented by clear(), so that a call that is resolved while the
+  // functions change is not added.
+  std::atomic<uint64_t> generation_{0};
+
+  std::atomic<uint64_t> numHits_{0};
+  std::atomic<uint64_t> numMisses_{0};
+  std::atomic<uint64_t> missNanos_{0};
+};
+
+} // namespace facebook::velox::exec
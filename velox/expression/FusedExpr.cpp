@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <folly/Synchronized.h>
+
+#include "velox/expression/ConjunctExpr.h"
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/type/FloatingPointUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+using FusedFunctionMap = std::unordered_map<std::string, FusedOp>;
+
+folly::Synchronized<FusedFunctionMap>& fusedFunctions() {
+  static folly::Synchronized<FusedFunctionMap> functions{
+      FusedFunctionMap{{kAnd, FusedOp::kAnd}, {kOr, FusedOp::kOr}}};
+  return functions;
+}
+
+std::optional<TypeKind> fusableKind(const TypePtr& type) {
+  static const std::vector<TypePtr> kFusableTypes{
+      BOOLEAN(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+  for (const auto& fusable : kFusableTypes) {
+    if (type->equivalent(*fusable)) {
+      return fusable->kind();
+    }
+  }
+  return std::nullopt;
+}
+
+bool isArithmetic(FusedOp op) {
+  return op == FusedOp::kPlus || op == FusedOp::kMinus ||
+      op == FusedOp::kMultiply;
+}
+
+bool isLogical(FusedOp op) {
+  return op == FusedOp::kAnd || op == FusedOp::kOr || op == FusedOp::kNot;
+}
+
+// Computes 'op' of 'size' pairs of 'left' and 'right'. Returns true if an
+// integer operation overflowed for a row set in 'selected'.
+template <typename T>
+bool arithmetic(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    T* result,
+    vector_size_t size,
+    const uint8_t* selected) {
+  if constexpr (std::is_floating_point_v<T>) {
+    switch (op) {
+      case FusedOp::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] + right[i];
+        }
+        break;
+      case FusedOp::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] - right[i];
+        }
+        break;
+      case FusedOp::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] * right[i];
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return false;
+  } else {
+    uint8_t overflow = 0;
+    switch (op) {
+      case FusedOp::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |=
+              __builtin_add_overflow(left[i], right[i], &result[i]) &
+              selected[i];
+        }
+        break;
+      case FusedOp::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |=
+              __builtin_sub_overflow(left[i], right[i], &result[i]) &
+              selected[i];
+        }
+        break;
+      case FusedOp::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          overflow |=
+              __builtin_mul_overflow(left[i], right[i], &result[i]) &
+              selected[i];
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return overflow != 0;
+  }
+}
+
+template <typename T, typename Compare>
+void compareLoop(
+    const T* left,
+    const T* right,
+    uint8_t* result,
+    vector_size_t size,
+    Compare compare) {
+  for (auto i = 0; i < size; ++i) {
+    result[i] = compare(left[i], right[i]);
+  }
+}
+
+template <typename T>
+void compare(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    uint8_t* result,
+    vector_size_t size) {
+  namespace fp = util::floating_point;
+  if constexpr (std::is_floating_point_v<T>) {
+    switch (op) {
+      case FusedOp::kEq:
+        return compareLoop(left, right, result, size, fp::NaNAwareEquals<T>{});
+      case FusedOp::kNeq:
+        return compareLoop(left, right, result, size, [](T l, T r) {
+          return !fp::NaNAwareEquals<T>{}(l, r);
+        });
+      case FusedOp::kLt:
+        return compareLoop(
+            left, right, result, size, fp::NaNAwareLessThan<T>{});
+      case FusedOp::kLte:
+        return compareLoop(
+            left, right, result, size, fp::NaNAwareLessThanEqual<T>{});
+      case FusedOp::kGt:
+        return compareLoop(
+            left, right, result, size, fp::NaNAwareGreaterThan<T>{});
+      case FusedOp::kGte:
+        return compareLoop(
+            left, right, result, size, fp::NaNAwareGreaterThanEqual<T>{});
+      default:
+        VELOX_UNREACHABLE();
+    }
+  } else {
+    switch (op) {
+      case FusedOp::kEq:
+        return compareLoop(left, right, result, size, std::equal_to<T>{});
+      case FusedOp::kNeq:
+        return compareLoop(left, right, result, size, std::not_equal_to<T>{});
+      case FusedOp::kLt:
+        return compareLoop(left, right, result, size, std::less<T>{});
+      case FusedOp::kLte:
+        return compareLoop(left, right, result, size, std::less_equal<T>{});
+      case FusedOp::kGt:
+        return compareLoop(left, right, result, size, std::greater<T>{});
+      case FusedOp::kGte:
+        return compareLoop(
+            left, right, result, size, std::greater_equal<T>{});
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+template <typename T>
+bool runInstruction(
+    const FusedExpr::Instruction& instruction,
+    const std::vector<void*>& values,
+    vector_size_t size,
+    const uint8_t* selected) {
+  const auto* left = static_cast<const T*>(values[instruction.left]);
+  const auto* right = static_cast<const T*>(values[instruction.right]);
+  if (isArithmetic(instruction.op)) {
+    return arithmetic(
+        instruction.op,
+        left,
+        right,
+        static_cast<T*>(values[instruction.result]),
+        size,
+        selected);
+  }
+  compare(
+      instruction.op,
+      left,
+      right,
+      static_cast<uint8_t*>(values[instruction.result]),
+      size);
+  return false;
+}
+
+void runLogical(
+    const FusedExpr::Instruction& instruction,
+    const std::vector<void*>& values,
+    vector_size_t size) {
+  const auto* left = static_cast<const uint8_t*>(values[instruction.left]);
+  auto* result = static_cast<uint8_t*>(values[instruction.result]);
+  if (instruction.op == FusedOp::kNot) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = left[i] ^ 1;
+    }
+    return;
+  }
+  const auto* right = static_cast<const uint8_t*>(values[instruction.right]);
+  if (instruction.op == FusedOp::kAnd) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = left[i] & right[i];
+    }
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = left[i] | right[i];
+    }
+  }
+}
+
+// Fills 'size' values of 'buffer' with the value of 'constant'.
+template <typename T>
+void broadcast(const BaseVector& constant, void* buffer, vector_size_t size) {
+  const auto value = constant.as<ConstantVector<T>>()->valueAt(0);
+  if constexpr (std::is_same_v<T, bool>) {
+    std::fill_n(static_cast<uint8_t*>(buffer), size, value ? 1 : 0);
+  } else {
+    std::fill_n(static_cast<T*>(buffer), size, value);
+  }
+}
+
+template <typename T>
+void store(
+    const void* values,
+    vector_size_t begin,
+    vector_size_t size,
+    const uint8_t* selected,
+    bool allSelected,
+    BaseVector& result) {
+  if constexpr (std::is_same_v<T, bool>) {
+    auto* rawResult = result.asFlatVector<bool>()->mutableRawValues<uint64_t>();
+    const auto* bytes = static_cast<const uint8_t*>(values);
+    for (auto i = 0; i < size; ++i) {
+      if (selected[i]) {
+        bits::setBit(rawResult, begin + i, bytes[i]);
+      }
+    }
+  } else {
+    auto* rawResult = result.asFlatVector<T>()->mutableRawValues() + begin;
+    const auto* typedValues = static_cast<const T*>(values);
+    if (allSelected) {
+      std::copy_n(typedValues, size, rawResult);
+      return;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (selected[i]) {
+        rawResult[i] = typedValues[i];
+      }
+    }
+  }
+}
+} // namespace
+
+void registerFusedFunction(const std::string& name, FusedOp op) {
+  fusedFunctions().wlock()->insert_or_assign(name, op);
+}
+
+std::optional<FusedOp> getFusedFunction(const std::string& name) {
+  return fusedFunctions().withRLock(
+      [&](const auto& functions) -> std::optional<FusedOp> {
+        auto it = functions.find(name);
+        if (it == functions.end()) {
+          return std::nullopt;
+        }
+        return it->second;
+      });
+}
+
+FusedExpr::FusedExpr(
+    ExprPtr original,
+    std::vector<ExprPtr> inputs,
+    std::vector<Register> registers,
+    std::vector<Instruction> instructions,
+    bool hasConjuncts)
+    : SpecialForm(
+          original->type(),
+          std::move(inputs),
+          "fused",
+          /*supportsFlatNoNullsFastPath=*/false,
+          /*trackCpuUsage=*/false),
+      original_(std::move(original)),
+      registers_(std::move(registers)),
+      instructions_(std::move(instructions)),
+      hasConjuncts_(hasConjuncts),
+      inputValues_(inputs_.size()),
+      buffers_(registers_.size()),
+      blockValues_(registers_.size()) {
+  for (auto& buffer : buffers_) {
+    buffer.resize(kBlockSize);
+  }
+}
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr) {
+  std::vector<ExprPtr> inputs;
+  std::unordered_map<std::string, int32_t> columnRegisters;
+  std::vector<Register> registers;
+  std::vector<Instruction> instructions;
+  bool hasConjuncts = false;
+
+  const auto newRegister = [&](TypeKind kind) {
+    registers.push_back({kind});
+    return static_cast<int32_t>(registers.size() - 1);
+  };
+
+  // Adds the registers and instructions for evaluating 'node'. Returns the
+  // register of the result or std::nullopt if 'node' cannot be fused.
+  std::function<std::optional<int32_t>(const ExprPtr&, bool)> compile;
+  compile = [&](const ExprPtr& node,
+                bool isRoot) -> std::optional<int32_t> {
+    if (auto* fused = dynamic_cast<const FusedExpr*>(node.get())) {
+      if (!isRoot && node->isMultiplyReferenced()) {
+        return std::nullopt;
+      }
+      return compile(fused->original(), isRoot);
+    }
+    const auto kind = fusableKind(node->type());
+    if (!kind.has_value()) {
+      return std::nullopt;
+    }
+    if (auto* field = dynamic_cast<const FieldReference*>(node.get())) {
+      if (!field->inputs().empty()) {
+        return std::nullopt;
+      }
+      auto it = columnRegisters.find(field->field());
+      if (it != columnRegisters.end()) {
+        return it->second;
+      }
+      const auto reg = newRegister(kind.value());
+      registers[reg].input = inputs.size();
+      inputs.push_back(node);
+      columnRegisters[field->field()] = reg;
+      return reg;
+    }
+    if (auto* constant = dynamic_cast<const ConstantExpr*>(node.get())) {
+      if (constant->value()->isNullAt(0)) {
+        return std::nullopt;
+      }
+      const auto reg = newRegister(kind.value());
+      registers[reg].constant = constant->value();
+      return reg;
+    }
+    if (!isRoot && node->isMultiplyReferenced()) {
+      // Leaves the common subexpressions to the interpreter.
+      return std::nullopt;
+    }
+    const auto op = getFusedFunction(node->name());
+    if (!op.has_value()) {
+      return std::nullopt;
+    }
+    const auto& nodeInputs = node->inputs();
+    std::vector<int32_t> operands;
+    std::optional<TypeKind> operandKind;
+    for (const auto& input : nodeInputs) {
+      const auto inputKind = fusableKind(input->type());
+      if (!inputKind.has_value() ||
+          (operandKind.has_value() && operandKind != inputKind)) {
+        return std::nullopt;
+      }
+      operandKind = inputKind;
+      const auto operand = compile(input, false);
+      if (!operand.has_value()) {
+        return std::nullopt;
+      }
+      operands.push_back(operand.value());
+    }
+    if (!operandKind.has_value()) {
+      return std::nullopt;
+    }
+    if (isLogical(op.value())) {
+      if (operandKind != TypeKind::BOOLEAN ||
+          (op == FusedOp::kNot) != (operands.size() == 1)) {
+        return std::nullopt;
+      }
+      hasConjuncts |= op != FusedOp::kNot;
+    } else if (operands.size() != 2) {
+      return std::nullopt;
+    } else if (isArithmetic(op.value())) {
+      if (operandKind == TypeKind::BOOLEAN || kind != operandKind) {
+        return std::nullopt;
+      }
+    } else if (kind != TypeKind::BOOLEAN) {
+      return std::nullopt;
+    }
+
+    if (op == FusedOp::kNot) {
+      const auto reg = newRegister(TypeKind::BOOLEAN);
+      instructions.push_back(
+          {FusedOp::kNot, TypeKind::BOOLEAN, reg, operands[0], -1});
+      return reg;
+    }
+    // Folds the operands of a conjunct with more than 2 inputs left to right.
+    auto left = operands[0];
+    for (auto i = 1; i < operands.size(); ++i) {
+      const auto reg = newRegister(kind.value());
+      instructions.push_back(
+          {op.value(), operandKind.value(), reg, left, operands[i]});
+      left = reg;
+    }
+    return left;
+  };
+
+  const auto result = compile(expr, true);
+  if (!result.has_value() || instructions.size() < 2) {
+    return expr;
+  }
+  VELOX_CHECK_EQ(result.value(), instructions.back().result);
+  auto original = expr;
+  if (auto* fused = dynamic_cast<const FusedExpr*>(expr.get())) {
+    original = fused->original();
+  }
+  std::shared_ptr<FusedExpr> fused(new FusedExpr(
+      std::move(original),
+      std::move(inputs),
+      std::move(registers),
+      std::move(instructions),
+      hasConjuncts));
+  fused->computeMetadata();
+  return fused;
+}
+
+bool FusedExpr::canEvaluate(const EvalCtx& context) const {
+  for (const auto& value : inputValues_) {
+    if (value->isConstantEncoding()) {
+      if (value->isNullAt(0)) {
+        return false;
+      }
+    } else if (value->isFlatEncoding()) {
+      // The null rows are removed from the evaluated rows if nulls are pruned.
+      if (value->mayHaveNulls() && !context.nullsPruned()) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FusedExpr::loadBlock(vector_size_t begin, vector_size_t size) {
+  for (auto i = 0; i < registers_.size(); ++i) {
+    const auto& reg = registers_[i];
+    if (reg.input < 0) {
+      continue;
+    }
+    const auto& value = inputValues_[reg.input];
+    if (value->isConstantEncoding()) {
+      continue;
+    }
+    if (reg.kind == TypeKind::BOOLEAN) {
+      const auto* rawValues =
+          value->asFlatVector<bool>()->rawValues<uint64_t>();
+      auto* bytes = reinterpret_cast<uint8_t*>(buffers_[i].data());
+      for (auto row = 0; row < size; ++row) {
+        bytes[row] = bits::isBitSet(rawValues, begin + row);
+      }
+      continue;
+    }
+    const auto* rawValues = static_cast<const char*>(value->valuesAsVoid());
+    blockValues_[i] = const_cast<char*>(rawValues) +
+        static_cast<size_t>(begin) * value->type()->cppSizeInBytes();
+  }
+}
+
+bool FusedExpr::runBlock(vector_size_t size, const uint8_t* selected) {
+  for (const auto& instruction : instructions_) {
+    bool overflow = false;
+    switch (instruction.kind) {
+      case TypeKind::BOOLEAN:
+        if (isLogical(instruction.op)) {
+          runLogical(instruction, blockValues_, size);
+        } else {
+          // Compares booleans stored as bytes.
+          overflow = runInstruction<uint8_t>(
+              instruction, blockValues_, size, selected);
+        }
+        break;
+      case TypeKind::INTEGER:
+        overflow =
+            runInstruction<int32_t>(instruction, blockValues_, size, selected);
+        break;
+      case TypeKind::BIGINT:
+        overflow =
+            runInstruction<int64_t>(instruction, blockValues_, size, selected);
+        break;
+      case TypeKind::REAL:
+        overflow =
+            runInstruction<float>(instruction, blockValues_, size, selected);
+        break;
+      case TypeKind::DOUBLE:
+        overflow =
+            runInstruction<double>(instruction, blockValues_, size, selected);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    if (overflow) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FusedExpr::storeBlock(
+    vector_size_t begin,
+    vector_size_t size,
+    const uint8_t* selected,
+    BaseVector& result) const {
+  const auto* values = blockValues_[instructions_.back().result];
+  const bool allSelected =
+      std::all_of(selected, selected + size, [](auto s) { return s != 0; });
+  switch (result.typeKind()) {
+    case TypeKind::BOOLEAN:
+      return store<bool>(values, begin, size, selected, allSelected, result);
+    case TypeKind::INTEGER:
+      return store<int32_t>(values, begin, size, selected, allSelected, result);
+    case TypeKind::BIGINT:
+      return store<int64_t>(values, begin, size, selected, allSelected, result);
+    case TypeKind::REAL:
+      return store<float>(values, begin, size, selected, allSelected, result);
+    case TypeKind::DOUBLE:
+      return store<double>(values, begin, size, selected, allSelected, result);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(rows, context, inputValues_[i]);
+  }
+  const auto fallback = [&]() {
+    for (auto& value : inputValues_) {
+      value.reset();
+    }
+    original_->eval(rows, context, result);
+  };
+  if (!canEvaluate(context)) {
+    fallback();
+    return;
+  }
+
+  // The registers of constants and of flat booleans use 'buffers_'. The
+  // constants are filled once per batch.
+  for (auto i = 0; i < registers_.size(); ++i) {
+    const auto& reg = registers_[i];
+    blockValues_[i] = buffers_[i].data();
+    const BaseVector* constant = reg.constant.get();
+    if (reg.input >= 0 && inputValues_[reg.input]->isConstantEncoding()) {
+      constant = inputValues_[reg.input].get();
+    }
+    if (constant == nullptr) {
+      continue;
+    }
+    switch (reg.kind) {
+      case TypeKind::BOOLEAN:
+        broadcast<bool>(*constant, blockValues_[i], kBlockSize);
+        break;
+      case TypeKind::INTEGER:
+        broadcast<int32_t>(*constant, blockValues_[i], kBlockSize);
+        break;
+      case TypeKind::BIGINT:
+        broadcast<int64_t>(*constant, blockValues_[i], kBlockSize);
+        break;
+      case TypeKind::REAL:
+        broadcast<float>(*constant, blockValues_[i], kBlockSize);
+        break;
+      case TypeKind::DOUBLE:
+        broadcast<double>(*constant, blockValues_[i], kBlockSize);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  context.ensureWritable(rows, type(), result);
+  result->clearNulls(rows);
+  const auto* rawRows = rows.asRange().bits();
+  uint8_t selected[kBlockSize];
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBlockSize) {
+    const auto size = std::min(kBlockSize, rows.end() - begin);
+    for (auto i = 0; i < size; ++i) {
+      selected[i] = bits::isBitSet(rawRows, begin + i);
+    }
+    loadBlock(begin, size);
+    if (!runBlock(size, selected)) {
+      fallback();
+      return;
+    }
+    storeBlock(begin, size, selected, *result);
+  }
+  for (auto& value : inputValues_) {
+    value.reset();
+  }
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// The operations FusedExpr can evaluate. They apply to BOOLEAN, INTEGER,
+/// BIGINT, REAL and DOUBLE values without nulls. Integer arithmetic fails on
+/// overflow. Floating point comparisons treat NaN as equal to NaN and as larger
+/// than any other value.
+enum class FusedOp : int8_t {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+  kAnd,
+  kOr,
+  kNot,
+};
+
+/// Declares that the overloads of scalar function 'name' for the types above
+/// behave as 'op', so that calls to 'name' can be fused. Called by the function
+/// packages when they register the functions.
+void registerFusedFunction(const std::string& name, FusedOp op);
+
+/// Returns the operation registered for scalar function or special form
+/// 'name'. The 'and' and 'or' special forms are always registered.
+std::optional<FusedOp> getFusedFunction(const std::string& name);
+
+/// Evaluates a tree of fusable functions over top-level columns and
+/// constants in one pass over each batch. The tree is compiled into a
+/// sequence of simple loops that is run block by block. A block holds
+/// kBlockSize rows, so the intermediate results stay in cache and no vector is
+/// materialized per node.
+///
+/// Falls back to evaluating the original tree for a batch in these cases:
+/// - an input is not flat or constant;
+/// - an input may have nulls that were not pruned before the evaluation;
+/// - an integer operation overflows on a selected row. The original tree
+///   then raises the error or suppresses it as the interpreter would.
+class FusedExpr : public SpecialForm {
+ public:
+  static constexpr vector_size_t kBlockSize = 1'024;
+
+  struct Instruction {
+    FusedOp op;
+    // Type of the operands.
+    TypeKind kind;
+    int32_t result;
+    int32_t left;
+    // Unused for kNot.
+    int32_t right;
+  };
+
+  /// Returns a FusedExpr evaluating 'expr' if 'expr' is a tree of at least two
+  /// fusable functions that is not shared with other expressions. Returns
+  /// 'expr' otherwise.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  /// Returns the tree evaluated by 'this'.
+  const ExprPtr& original() const {
+    return original_;
+  }
+
+  const std::vector<Instruction>& instructions() const {
+    return instructions_;
+  }
+
+  std::string toString(bool recursive = true) const override {
+    return original_->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return original_->toSql(complexConstants);
+  }
+
+ private:
+  // An input of the program. Either a column or a constant.
+  struct Register {
+    TypeKind kind;
+    // Index of the column in 'inputs_' or -1 for a constant or a result of an
+    // instruction.
+    int32_t input{-1};
+    // The value of a constant.
+    VectorPtr constant;
+  };
+
+  FusedExpr(
+      ExprPtr original,
+      std::vector<ExprPtr> inputs,
+      std::vector<Register> registers,
+      std::vector<Instruction> instructions,
+      bool hasConjuncts);
+
+  void computePropagatesNulls() override {
+    // The conjuncts may produce a non-null result from a null input.
+    propagatesNulls_ = !hasConjuncts_;
+  }
+
+  // Returns true if the batch in 'inputValues_' can be evaluated by the
+  // program.
+  bool canEvaluate(const EvalCtx& context) const;
+
+  // Sets the values of the registers for the rows of the block starting at
+  // 'begin'.
+  void loadBlock(vector_size_t begin, vector_size_t size);
+
+  // Runs the program for 'size' rows. Returns false if an integer operation
+  // overflowed on a row that is set in 'selected'.
+  bool runBlock(vector_size_t size, const uint8_t* selected);
+
+  // Copies the selected rows of the result register to 'result'.
+  void storeBlock(
+      vector_size_t begin,
+      vector_size_t size,
+      const uint8_t* selected,
+      BaseVector& result) const;
+
+  const ExprPtr original_;
+  const std::vector<Register> registers_;
+  const std::vector<Instruction> instructions_;
+  const bool hasConjuncts_;
+
+  // The values of the columns of the current batch.
+  std::vector<VectorPtr> inputValues_;
+  // kBlockSize values of each register and the pointer to the values of the
+  // current block. The pointer of a flat column of fixed width points to the
+  // column instead.
+  std::vector<std::vector<uint64_t>> buffers_;
+  std::vector<void*> blockValues_;
+};
+
+} // namespace facebook::velox::exec
@@ -64,6 +64,19 @@ struct udf_reuse_strings_from_arg<
     util::detail::void_t<decltype(T::reuse_strings_from_arg)>>
     : std::integral_constant<int32_t, T::reuse_strings_from_arg> {};
 
+// A function that sets reuse_strings_from_arg can also set
+// reference_copied_strings to true to make the result writer reference the
+// bytes of the reused argument that the function assigns or copies to a
+// Varchar or Varbinary result, instead of copying them.
+template <class T, class = void>
+struct udf_reference_copied_strings : std::false_type {};
+
+template <class T>
+struct udf_reference_copied_strings<
+    T,
+    util::detail::void_t<decltype(T::reference_copied_strings)>>
+    : std::integral_constant<bool, T::reference_copied_strings> {};
+
 template <typename FUNC>
 class SimpleFunctionAdapter : public VectorFunction {
   using T = typename FUNC::exec_return_type;
@@ -75,6 +88,9 @@ class SimpleFunctionAdapter : public VectorFunction {
   template <int32_t POSITION>
   using arg_at =
       typename std::tuple_element<POSITION, typename FUNC::arg_types>::type;
+  template <int32_t POSITION>
+  using flat_arg_at =
+      typename VectorExec::template resolver<arg_at<POSITION>>::in_type;
   using result_vector_t =
       typename TypeToFlatVector<typename FUNC::return_type>::type;
   std::unique_ptr<FUNC> fn_;
@@ -156,6 +172,30 @@ class SimpleFunctionAdapter : public VectorFunction {
   /// primitivies.
   static constexpr bool specializeForAllEncodings = FUNC::num_args <= 3;
 
+  template <size_t... Is>
+  constexpr bool static allArgsFixedWidthImpl(std::index_sequence<Is...>) {
+    return ([&]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return SimpleTypeTrait<arg_at<Is>>::isFixedWidth;
+      }
+    }() && ...);
+  }
+
+  /// When true, batches where all rows are selected and all arguments are flat
+  /// without nulls are processed by a loop over the raw values of the
+  /// arguments, which the compiler can vectorize when the function is inlined.
+  /// Requires fixed-width primitive arguments and result, default null
+  /// behavior and a function that never returns null for non-null inputs.
+  /// Functions that provide callBatch() get the raw values of the whole batch.
+  static constexpr bool flatNoNullsKernel = fastPathIteration &&
+      return_type_traits::typeKind != TypeKind::BOOLEAN &&
+      FUNC::num_args > 0 && FUNC::is_default_null_behavior &&
+      !FUNC::can_produce_null_output && !FUNC::udf_has_callNullFree &&
+      allArgsFlatConstantFastPathEligible() &&
+      allArgsFixedWidthImpl(std::make_index_sequence<FUNC::num_args>());
+
   /// If the initialize() method provided by functions throw, we don't (can't)
   /// throw immediately; rather, we capture the exception using this member
   /// variable and set that as error for every single active row. This is
@@ -369,8 +409,33 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    std::vector<BufferPtr> referenceableBuffers;
+    if constexpr (udf_reference_copied_strings<
+                      typename FUNC::udf_struct_t>::value) {
+      static_assert(
+          udf_reuse_strings_from_arg<typename FUNC::udf_struct_t>::value >= 0,
+          "reference_copied_strings requires reuse_strings_from_arg");
+      static_assert(
+          std::is_same_v<typename FUNC::return_type, Varchar> ||
+              std::is_same_v<typename FUNC::return_type, Varbinary>,
+          "reference_copied_strings requires a string result");
+      collectStringBuffers(
+          args.at(reuseStringsFromArgValue()).get(), referenceableBuffers);
+      applyContext.resultWriter.setReferenceableBuffers(&referenceableBuffers);
+    }
+
+    bool applied = false;
+    if constexpr (flatNoNullsKernel) {
+      if (rows.isAllSelected() && allArgsFlatNoNulls(args)) {
+        applied = applyFlatNoNulls(
+            applyContext, args, std::make_index_sequence<FUNC::num_args>());
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
-    if (allPrimitiveArgsFlatConstant(args)) {
+    if (applied) {
+      // Done.
+    } else if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
           allArgsFlatConstantFastPathEligible() && specializeForAllEncodings) {
         unpackSpecializeForAllEncodings<0>(applyContext, args);
@@ -414,6 +479,26 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  // Adds the string buffers of the flat or constant string vector under
+  // 'source' to 'buffers'.
+  static void collectStringBuffers(
+      const BaseVector* source,
+      std::vector<BufferPtr>& buffers) {
+    source = source->wrappedVector();
+    if (source->typeKind() != TypeKind::VARCHAR &&
+        source->typeKind() != TypeKind::VARBINARY) {
+      return;
+    }
+    if (source->isFlatEncoding()) {
+      buffers = source->asUnchecked<FlatVector<StringView>>()->stringBuffers();
+    } else if (source->isConstantEncoding() && !source->isNullAt(0)) {
+      if (auto buffer = source->asUnchecked<ConstantVector<StringView>>()
+                            ->getStringBuffer()) {
+        buffers.push_back(std::move(buffer));
+      }
+    }
+  }
+
   // All string vectors within `vector` will acquire shared ownership of all
   // string buffers found within source.
   void tryAcquireStringBuffer(BaseVector* vector, const BaseVector* source)
@@ -476,6 +561,47 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  static bool allArgsFlatNoNulls(const std::vector<VectorPtr>& args) {
+    return std::all_of(args.begin(), args.end(), [](const auto& arg) {
+      return arg->isFlatEncoding() && !arg->mayHaveNulls();
+    });
+  }
+
+  // Applies the function to all rows of flat arguments without nulls. Returns
+  // false if the function failed on a row. The caller then processes the batch
+  // again on the regular path, which records the errors per row.
+  template <size_t... Is>
+  bool applyFlatNoNulls(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto rawArgs = std::make_tuple(
+        args[Is]->asUnchecked<FlatVector<flat_arg_at<Is>>>()
+            ->rawValues()...);
+    auto* rawResult = applyContext.resultWriter.data_;
+    const auto end = applyContext.rows->end();
+    if constexpr (FUNC::udf_has_callBatch) {
+      // The function computes the batch at once with its own overflow and
+      // error checks.
+      return (*fn_).callBatch(rawResult, end, std::get<Is>(rawArgs)...);
+    }
+    try {
+      for (auto row = 0; row < end; ++row) {
+        typename return_type_traits::NativeType out{};
+        bool notNull;
+        const auto status =
+            (*fn_).call(out, notNull, std::get<Is>(rawArgs)[row]...);
+        if (UNLIKELY(!status.ok())) {
+          return false;
+        }
+        rawResult[row] = out;
+      }
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -15,6 +15,9 @@
  */
 
 #include "velox/expression/SimpleFunctionRegistry.h"
+#include <folly/ScopeGuard.h>
+
+#include "velox/expression/FunctionResolutionCache.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -39,6 +42,9 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
     const FunctionFactory& factory,
     bool overwrite) {
   const auto sanitizedName = sanitizeName(name);
+  SCOPE_EXIT {
+    FunctionResolutionCache::instance().clear();
+  };
   return registeredFunctions_.withWLock([&](auto& map) {
     SignatureMap& signatureMap = map[sanitizedName];
     auto& functions = signatureMap[*metadata->signature()];
@@ -71,6 +77,12 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
 void SimpleFunctionRegistry::removeFunction(const std::string& name) {
   const auto sanitizedName = sanitizeName(name);
   registeredFunctions_.withWLock([&](auto& map) { map.erase(sanitizedName); });
+  FunctionResolutionCache::instance().clear();
+}
+
+void SimpleFunctionRegistry::clearRegistry() {
+  registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+  FunctionResolutionCache::instance().clear();
 }
 
 namespace {
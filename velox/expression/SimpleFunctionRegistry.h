@@ -105,9 +105,7 @@ class SimpleFunctionRegistry {
     return result;
   }
 
-  void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
-  }
+  void clearRegistry();
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
       const std::string& name) const;
@@ -122,7 +120,7 @@ class SimpleFunctionRegistry {
         const TypePtr& type)
         : functionEntry_(functionEntry), type_(type) {}
 
-    auto createFunction() {
+    auto createFunction() const {
       return functionEntry_.createFunction();
     }
 
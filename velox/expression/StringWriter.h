@@ -17,6 +17,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "velox/functions/UDFOutputString.h"
 #include "velox/type/StringView.h"
@@ -37,6 +38,9 @@ class StringWriter : public UDFOutputString {
 
   /// Reserve a space for the output string with size of at least newCapacity
   void reserve(size_t newCapacity) override {
+    if (referencing_) {
+      copyReferenced();
+    }
     if (newCapacity <= capacity()) {
       return;
     }
@@ -63,6 +67,10 @@ class StringWriter : public UDFOutputString {
   /// finalize the allocation and the string writing.
   void finalize() {
     if (!finalized_) {
+      if (referencing_) {
+        vector_->setNoCopy(offset_, StringView(data(), size()));
+        return;
+      }
       VELOX_DCHECK(size() == 0 || data());
       VELOX_USER_CHECK_LE(size(), INT32_MAX);
       if LIKELY (size()) {
@@ -74,7 +82,9 @@ class StringWriter : public UDFOutputString {
   }
 
   void prepareForReuse(bool isSet) {
-    if (isSet) {
+    if (referencing_) {
+      restoreOwnSpace();
+    } else if (isSet) {
       setCapacity(capacity() - size());
       setData(data() + size());
     }
@@ -107,6 +117,9 @@ class StringWriter : public UDFOutputString {
   template <typename T>
   void operator=(const T& input) {
     resize(0);
+    if (tryReference(input)) {
+      return;
+    }
     append(input);
   }
 
@@ -128,6 +141,9 @@ class StringWriter : public UDFOutputString {
 
   template <typename T>
   void copy_from(const T& input) {
+    if (size() == 0 && tryReference(input)) {
+      return;
+    }
     append(input);
   }
 
@@ -138,6 +154,63 @@ class StringWriter : public UDFOutputString {
  private:
   StringWriter() = default;
 
+  // Sets the buffers whose bytes an assigned or copied string may reference
+  // instead of being copied. The buffers must be kept alive by the result
+  // vector. nullptr disables referencing.
+  void setReferenceableBuffers(const std::vector<BufferPtr>* buffers) {
+    referenceableBuffers_ = buffers;
+  }
+
+  // Makes the writer reference 'input' if it is too long to inline and lies
+  // in one of 'referenceableBuffers_'. The writer then has no capacity, so
+  // that the next write copies the referenced bytes into its own space. A
+  // function that opts into referencing must not modify data() in place.
+  template <typename T>
+  bool tryReference(const T& input) {
+    if (referenceableBuffers_ == nullptr ||
+        input.size() <= StringView::kInlineSize) {
+      return false;
+    }
+    const char* begin = input.data();
+    const char* end = begin + input.size();
+    for (const auto& buffer : *referenceableBuffers_) {
+      const auto* bufferBegin = buffer->as<char>();
+      if (begin >= bufferBegin && end <= bufferBegin + buffer->size()) {
+        if (!referencing_) {
+          ownData_ = data();
+          ownCapacity_ = capacity();
+          referencing_ = true;
+        }
+        setData(const_cast<char*>(begin));
+        setSize(input.size());
+        setCapacity(0);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool tryReference(const char* /*input*/) {
+    return false;
+  }
+
+  // Goes back to the space of the writer, dropping the referenced string.
+  void restoreOwnSpace() {
+    setData(ownData_);
+    setCapacity(ownCapacity_);
+    setSize(0);
+    referencing_ = false;
+  }
+
+  // Copies the referenced string to the space of the writer.
+  void copyReferenced() {
+    const char* referenced = data();
+    const auto referencedSize = size();
+    restoreOwnSpace();
+    resize(referencedSize);
+    std::memcpy(data(), referenced, referencedSize);
+  }
+
   bool finalized_{false};
 
   /// The buffer that the output string uses for its allocation set during
@@ -150,6 +223,14 @@ class StringWriter : public UDFOutputString {
 
   std::string value_;
 
+  const std::vector<BufferPtr>* referenceableBuffers_{nullptr};
+
+  // True if data() points to a string in 'referenceableBuffers_'. The space
+  // of the writer is then in 'ownData_' and 'ownCapacity_'.
+  bool referencing_{false};
+  char* ownData_{nullptr};
+  size_t ownCapacity_{0};
+
   template <typename A, typename B>
   friend struct VectorWriter;
 };
@@ -129,7 +129,7 @@ void TryExpr::nullOutErrors(
     auto size = result->size();
     VELOX_DCHECK_GE(size, rows.end());
 
-    auto nulls = allocateNulls(size, context.pool());
+    auto nulls = context.allocateNulls(size);
     auto rawNulls = nulls->asMutable<uint64_t>();
     rows.applyToSelected([&](auto row) {
       if (errors->hasErrorAt(row)) {
@@ -138,7 +138,7 @@ void TryExpr::nullOutErrors(
     });
 
     // Wrap in dictionary indices all pointing to index 0.
-    auto indices = allocateIndices(size, context.pool());
+    auto indices = context.allocateIndices(size);
     result = BaseVector::wrapInDictionary(nulls, indices, size, result);
   } else if (
       result.use_count() == 1 && result->isNullsWritable() &&
@@ -150,9 +150,9 @@ void TryExpr::nullOutErrors(
       }
     });
   } else {
-    auto nulls = allocateNulls(rows.end(), context.pool());
+    auto nulls = context.allocateNulls(rows.end());
     auto* rawNulls = nulls->asMutable<uint64_t>();
-    auto indices = allocateIndices(rows.end(), context.pool());
+    auto indices = context.allocateIndices(rows.end());
     auto* rawIndices = indices->asMutable<vector_size_t>();
 
     rows.applyToSelected([&](auto row) {
@@ -15,8 +15,10 @@
  */
 #include "velox/expression/VectorFunction.h"
 #include <unordered_map>
+#include "folly/ScopeGuard.h"
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -126,31 +128,47 @@ getVectorFunctionWithMetadata(
     const std::vector<TypePtr>& inputTypes,
     const std::vector<VectorPtr>& constantInputs,
     const core::QueryConfig& config) {
-  if (!constantInputs.empty()) {
-    VELOX_CHECK_EQ(inputTypes.size(), constantInputs.size());
+  auto resolved = resolveVectorFunctionFactory(name, inputTypes);
+  if (!resolved.has_value()) {
+    return std::nullopt;
   }
+  return {
+      {makeVectorFunction(*resolved, inputTypes, constantInputs, config),
+       resolved->metadata}};
+}
 
-  return applyToVectorFunctionEntry<
-      std::pair<std::shared_ptr<VectorFunction>, VectorFunctionMetadata>>(
+std::optional<ResolvedVectorFunction> resolveVectorFunctionFactory(
+    const std::string& name,
+    const std::vector<TypePtr>& inputTypes) {
+  return applyToVectorFunctionEntry<ResolvedVectorFunction>(
       name,
-      [&](const auto& sanitizedName, const auto& entry)
-          -> std::optional<std::pair<
-              std::shared_ptr<VectorFunction>,
-              VectorFunctionMetadata>> {
+      [&](const auto& sanitizedName,
+          const auto& entry) -> std::optional<ResolvedVectorFunction> {
         for (const auto& signature : entry.signatures) {
           exec::SignatureBinder binder(*signature, inputTypes);
           if (binder.tryBind()) {
-            auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
-
-            return {
-                {entry.factory(sanitizedName, inputArgs, config),
-                 entry.metadata}};
+            return ResolvedVectorFunction{
+                sanitizedName, entry.factory, entry.metadata};
           }
         }
         return std::nullopt;
       });
 }
 
+std::shared_ptr<VectorFunction> makeVectorFunction(
+    const ResolvedVectorFunction& resolved,
+    const std::vector<TypePtr>& inputTypes,
+    const std::vector<VectorPtr>& constantInputs,
+    const core::QueryConfig& config) {
+  if (!constantInputs.empty()) {
+    VELOX_CHECK_EQ(inputTypes.size(), constantInputs.size());
+  }
+  return resolved.factory(
+      resolved.sanitizedName,
+      toVectorFunctionArgs(inputTypes, constantInputs),
+      config);
+}
+
 /// Registers a new vector function. When overwrite = true, previous functions
 /// with the given name will be replaced.
 /// Returns true iff an insertion actually happened
@@ -161,6 +179,9 @@ bool registerStatefulVectorFunction(
     VectorFunctionMetadata metadata,
     bool overwrite) {
   auto sanitizedName = sanitizeName(name);
+  SCOPE_EXIT {
+    FunctionResolutionCache::instance().clear();
+  };
 
   if (overwrite) {
     vectorFunctionFactories().withWLock([&](auto& functionMap) {
@@ -204,4 +225,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExpressionSetRewrite>& expressionSetRewrites() {
+  static std::vector<ExpressionSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite) {
+  expressionSetRewrites().emplace_back(rewrite);
+}
+
 } // namespace facebook::velox::exec
@@ -246,6 +246,28 @@ using VectorFunctionMap =
 
 VectorFunctionMap& vectorFunctionFactories();
 
+/// The factory of the vector function that a call binds to and the name the
+/// factory is called with.
+struct ResolvedVectorFunction {
+  std::string sanitizedName;
+  VectorFunctionFactory factory;
+  VectorFunctionMetadata metadata;
+};
+
+/// Returns the factory of vector function 'name' if it has a signature that
+/// binds to 'inputTypes', std::nullopt otherwise.
+std::optional<ResolvedVectorFunction> resolveVectorFunctionFactory(
+    const std::string& name,
+    const std::vector<TypePtr>& inputTypes);
+
+/// Returns an instance of the VectorFunction of 'resolved'. 'inputTypes' and
+/// 'constantInputs' are as for getVectorFunction().
+std::shared_ptr<VectorFunction> makeVectorFunction(
+    const ResolvedVectorFunction& resolved,
+    const std::vector<TypePtr>& inputTypes,
+    const std::vector<VectorPtr>& constantInputs,
+    const core::QueryConfig& config);
+
 // A template to simplify making VectorFunctionFactory for a function that has a
 // constructor that takes inputTypes and constantInputs
 //
@@ -290,6 +312,26 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions compiled together into one
+/// ExprSet and returns pairs of {subexpression, equivalent replacement}. Allows
+/// to share work between calls in different expressions, e.g. by replacing
+/// them with references to one common subexpression that computes all of them.
+using ExpressionReplacements =
+    std::vector<std::pair<core::TypedExprPtr, core::TypedExprPtr>>;
+using ExpressionSetRewrite = std::function<ExpressionReplacements(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'.
+///
+/// Re-writes are applied to the expressions of an ExprSet before compilation,
+/// in the order they were registered. A subexpression equal to a replaced one
+/// is replaced wherever it occurs outside of lambda bodies. The replacements
+/// apply before the rewrites registered with registerExpressionRewrite.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
@@ -394,6 +394,12 @@ struct VectorWriter<
     proxy_.offset_ = offset;
   }
 
+  // Lets the written strings reference the bytes of 'buffers' instead of
+  // copying them. See StringWriter::tryReference().
+  void setReferenceableBuffers(const std::vector<BufferPtr>* buffers) {
+    proxy_.setReferenceableBuffers(buffers);
+  }
+
   vector_t& vector() {
     return *proxy_.vector_;
   }
@@ -43,6 +43,12 @@
 // expect simpleMinIntegerNullFreeFastPath to do about as well as
 // simpleMinInteger when null arrays or null elements are present because they
 // use the same code path after a quick additional check once per batch.
+//
+// The simpleMultiplyAdd benchmarks measure a function of primitive arguments.
+// With flat arguments without nulls and all rows selected the adapter runs a
+// loop over the raw values, which we expect to be close to
+// vectorMultiplyAdd. A single null in an argument makes the adapter use the
+// reader based path, which simpleMultiplyAddWithNulls measures.
 
 namespace facebook::velox::functions {
 
@@ -186,6 +192,27 @@ struct ArrayMinNullFreeFastPathFunction {
   }
 };
 
+void fastMultiplyAdd(
+    const VectorPtr& a,
+    const VectorPtr& b,
+    FlatVector<double>& result) {
+  const auto* rawA = a->asFlatVector<double>()->rawValues();
+  const auto* rawB = b->asFlatVector<double>()->rawValues();
+  auto* rawResult = result.mutableRawValues();
+  for (auto row = 0; row < a->size(); ++row) {
+    rawResult[row] = rawA[row] * rawB[row] + rawA[row];
+  }
+}
+
+template <typename T>
+struct MultiplyAddFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void call(double& out, double a, double b) {
+    out = a * b + a;
+  }
+};
+
 void registerSimpleFunctions() {
   registerFunction<ArrayMinSimpleFunction, int32_t, Array<int32_t>>(
       {"array_min_simple"});
@@ -197,6 +224,9 @@ void registerSimpleFunctions() {
 
   registerFunction<ArrayMinNullFreeFastPathFunction, int32_t, Array<int32_t>>(
       {"array_min_null_free_fast_path"});
+
+  registerFunction<MultiplyAddFunction, double, double, double>(
+      {"multiply_add"});
 }
 
 namespace {
@@ -244,6 +274,44 @@ class CallNullFreeBenchmark : public functions::test::FunctionBenchmarkBase {
     return doRun(exprSet, rowVector);
   }
 
+  RowVectorPtr makePrimitiveData(bool withNulls) {
+    std::function<bool(vector_size_t /*row */)> noNulls = nullptr;
+
+    const vector_size_t size = 10'000;
+    return vectorMaker_.rowVector({
+        vectorMaker_.flatVector<double>(
+            size,
+            [](auto row) { return row * 0.5; },
+            withNulls ? [](auto row) { return row == 0; } : noNulls),
+        vectorMaker_.flatVector<double>(
+            size, [](auto row) { return row % 17 * 0.25; }),
+    });
+  }
+
+  size_t runFastMultiplyAdd() {
+    folly::BenchmarkSuspender suspender;
+    auto data = makePrimitiveData(false);
+    auto result = BaseVector::create<FlatVector<double>>(
+        DOUBLE(), data->size(), pool());
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      fastMultiplyAdd(data->childAt(0), data->childAt(1), *result);
+      cnt += result->size();
+    }
+    return cnt;
+  }
+
+  size_t runMultiplyAdd(bool withNulls) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makePrimitiveData(withNulls);
+    auto exprSet = compileExpression("multiply_add(c0, c1)", data->type());
+    suspender.dismiss();
+
+    return doRun(exprSet, data);
+  }
+
   size_t doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -286,6 +354,15 @@ class CallNullFreeBenchmark : public functions::test::FunctionBenchmarkBase {
         VELOX_UNREACHABLE(fmt::format("testing failed at function {}", name));
       }
     }
+
+    auto data = makePrimitiveData(false);
+    auto expected = BaseVector::create<FlatVector<double>>(
+        DOUBLE(), data->size(), pool());
+    fastMultiplyAdd(data->childAt(0), data->childAt(1), *expected);
+    auto exprSet = compileExpression("multiply_add(c0, c1)", data->type());
+    if (!hasSameResults(expected, exprSet, data)) {
+      VELOX_UNREACHABLE("testing failed at function multiply_add");
+    }
   }
 };
 
@@ -308,6 +385,23 @@ BENCHMARK_MULTI(simpleMinIntegerNullFreeFastPath) {
   CallNullFreeBenchmark benchmark;
   return benchmark.runInteger("array_min_null_free_fast_path");
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(vectorMultiplyAdd) {
+  CallNullFreeBenchmark benchmark;
+  return benchmark.runFastMultiplyAdd();
+}
+
+BENCHMARK_MULTI(simpleMultiplyAdd) {
+  CallNullFreeBenchmark benchmark;
+  return benchmark.runMultiplyAdd(false);
+}
+
+BENCHMARK_MULTI(simpleMultiplyAddWithNulls) {
+  CallNullFreeBenchmark benchmark;
+  return benchmark.runMultiplyAdd(true);
+}
 } // namespace
 } // namespace facebook::velox::functions
 
@@ -1257,6 +1257,92 @@ TEST_F(CastExprTest, primitiveValidCornerCases) {
   }
 }
 
+TEST_F(CastExprTest, fastPaths) {
+  // Strings in the common formats are parsed by the fast paths, the others by
+  // the regular casts in the same batch.
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"0",
+       "-7",
+       "12345678",
+       "0001234567890123456",
+       "-123456789012345678",
+       "999999999999999999",
+       "9223372036854775807",
+       "-9223372036854775808",
+       "+5",
+       " 12 "},
+      {0,
+       -7,
+       12345678,
+       1234567890123456,
+       -123456789012345678,
+       999999999999999999,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       5,
+       12});
+  testCast<std::string, int16_t>(
+      "smallint", {"32767", "-32768", "123"}, {32767, -32768, 123});
+  testTryCast<std::string, int16_t>(
+      "smallint",
+      {"32768", "1a", "12", "", "-"},
+      {std::nullopt, std::nullopt, 12, std::nullopt, std::nullopt});
+  testInvalidCast<std::string>(
+      "integer", {"1", "2", "3000000000"}, "Overflow during arithmetic");
+
+  testCast<std::string, double>(
+      "double",
+      {"1.5",
+       "-0.0",
+       "123.456e-5",
+       "1e22",
+       "1e23",
+       "2E-3",
+       "-12.5e010",
+       "9007199254740993",
+       "0.1",
+       "1.",
+       " 3.25",
+       "Infinity"},
+      {1.5,
+       -0.0,
+       123.456e-5,
+       1e22,
+       1e23,
+       2e-3,
+       -12.5e10,
+       9007199254740993.0,
+       0.1,
+       1.0,
+       3.25,
+       kInf});
+  testTryCast<std::string, double>(
+      "double", {"1.5x", "1e", "2.5"}, {std::nullopt, std::nullopt, 2.5});
+
+  // Integers are formatted in bulk.
+  testCast<int64_t, std::string>(
+      "varchar",
+      {0,
+       -1,
+       123456789012,
+       1234567890123,
+       -12345678901,
+       -123456789012,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()},
+      {"0",
+       "-1",
+       "123456789012",
+       "1234567890123",
+       "-12345678901",
+       "-123456789012",
+       "9223372036854775807",
+       "-9223372036854775808"});
+  testCast<int16_t, std::string>(
+      "varchar", {-32768, 0, 32767}, {"-32768", "0", "32767"});
+}
+
 TEST_F(CastExprTest, truncateVsRound) {
   // Testing round cast from double to int.
   testCast<double, int>(
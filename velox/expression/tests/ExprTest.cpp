@@ -18,6 +18,7 @@
 #include <exception>
 #include <fstream>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -483,6 +484,43 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderWithLazyLoadCost) {
+  constexpr int32_t kSize = 1'000;
+  constexpr int32_t kNumBatches = 5;
+  auto exprSet = compileExpression(
+      "c1 > 0 and c0 % 10 = 0", ROW({"c0", "c1"}, {BIGINT(), BIGINT()}));
+  auto conjunct =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(conjunct != nullptr);
+  ASSERT_EQ(conjunct->fieldsLoadedOnActiveRows().size(), 2);
+
+  // c1 passes all rows but is slow to load. Once the load cost is known, c1
+  // is loaded only for the rows that pass c0 % 10 = 0.
+  vector_size_t numLoaded = 0;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    auto data = makeRowVector({
+        makeFlatVector<int64_t>(kSize, folly::identity),
+        std::make_shared<LazyVector>(
+            pool(),
+            BIGINT(),
+            kSize,
+            std::make_unique<SimpleVectorLoader>([&](RowSet rows) {
+              numLoaded = rows.size();
+              std::this_thread::sleep_for(std::chrono::milliseconds(5));
+              return makeFlatVector<int64_t>(
+                  kSize, [](auto row) { return row + 1; });
+            })),
+    });
+    auto result = evaluate(exprSet.get(), data);
+    assertEqualVectors(
+        makeFlatVector<bool>(kSize, [](auto row) { return row % 10 == 0; }),
+        result);
+  }
+  ASSERT_EQ(conjunct->inputOrder(), (std::vector<int32_t>{1, 0}));
+  ASSERT_EQ(conjunct->numReorders(), 1);
+  ASSERT_EQ(numLoaded, kSize / 10);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -5013,5 +5051,94 @@ TEST_F(ExprTest, peelingOnDeterministicFunctionInNonDeterministicExpr) {
   ASSERT_EQ(stats["plus"].numProcessedRows, input->size() / 2);
 }
 
+// Returns the length of the string argument and counts the rows it is called
+// for. Fails for 'bad'.
+class CountingLengthFunction : public exec::VectorFunction {
+ public:
+  explicit CountingLengthFunction(std::shared_ptr<int64_t> numRows)
+      : numRows_(std::move(numRows)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    *numRows_ += rows.countSelected();
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* decoded = decodedArgs.at(0);
+    context.ensureWritable(rows, outputType, result);
+    auto* flatResult = result->asFlatVector<int64_t>();
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto value = decoded->valueAt<StringView>(row);
+      VELOX_USER_CHECK_NE(value, StringView("bad"), "Bad value");
+      flatResult->set(row, value.size());
+    });
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    return {exec::FunctionSignatureBuilder()
+                .returnType("bigint")
+                .argumentType("varchar")
+                .build()};
+  }
+
+ private:
+  const std::shared_ptr<int64_t> numRows_;
+};
+
+TEST_F(ExprTest, cacheResultsByValue) {
+  auto numRows = std::make_shared<int64_t>(0);
+  exec::registerVectorFunction(
+      "counting_length",
+      CountingLengthFunction::signatures(),
+      std::make_unique<CountingLengthFunction>(numRows),
+      exec::VectorFunctionMetadataBuilder().cacheResultsByValue(true).build());
+
+  const auto makeData = [&](vector_size_t size, int32_t numDistinct) {
+    return makeRowVector({makeFlatVector<std::string>(size, [&](auto row) {
+      return fmt::format("v{}", row % numDistinct);
+    })});
+  };
+  const auto makeExpected = [&](vector_size_t size, int32_t numDistinct) {
+    return makeFlatVector<int64_t>(size, [&](auto row) {
+      return fmt::format("v{}", row % numDistinct).size();
+    });
+  };
+
+  auto exprSet = compileExpression("counting_length(c0)", ROW({VARCHAR()}));
+  auto result = evaluate(exprSet.get(), makeData(1'000, 10));
+  assertEqualVectors(makeExpected(1'000, 10), result);
+  ASSERT_EQ(*numRows, 10);
+
+  // A new vector with the same values and one more value. Only the new value
+  // is evaluated.
+  result = evaluate(exprSet.get(), makeData(500, 11));
+  assertEqualVectors(makeExpected(500, 11), result);
+  ASSERT_EQ(*numRows, 11);
+
+  // Dictionary encoded input.
+  auto data = makeData(100, 20);
+  auto indices = makeIndicesInReverse(100);
+  result = evaluate(
+      exprSet.get(),
+      makeRowVector({wrapInDictionary(indices, data->childAt(0))}));
+  assertEqualVectors(wrapInDictionary(indices, makeExpected(100, 20)), result);
+  ASSERT_EQ(*numRows, 20);
+
+  auto stats = exprSet->stats();
+  ASSERT_EQ(stats["counting_length"].numValueCacheLookups, 1'600);
+  ASSERT_EQ(stats["counting_length"].numValueCacheHits, 1'580);
+
+  // The results of the failed values are not cached.
+  exprSet = compileExpression("try(counting_length(c0))", ROW({VARCHAR()}));
+  data = makeRowVector({makeFlatVector<std::string>({"a", "bad", "a"})});
+  auto expected = makeNullableFlatVector<int64_t>({1, std::nullopt, 1});
+  *numRows = 0;
+  assertEqualVectors(expected, evaluate(exprSet.get(), data));
+  assertEqualVectors(expected, evaluate(exprSet.get(), data));
+  ASSERT_EQ(*numRows, 10);
+}
+
 } // namespace
 } // namespace facebook::velox::test
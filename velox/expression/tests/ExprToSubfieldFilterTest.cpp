@@ -282,6 +282,59 @@ TEST_F(ExprToSubfieldFilterTest, dereferenceWithEmptyField) {
   ASSERT_FALSE(filter);
 }
 
+TEST_F(ExprToSubfieldFilterTest, metadataFilter) {
+  auto rowType = ROW({{"a", BIGINT()}, {"b", INTEGER()}});
+  auto* parser = ExprToSubfieldFilterParser::getInstance().get();
+  const auto toFilter = [&](const std::string& expr,
+                            const std::string& field = "a",
+                            bool negated = false) {
+    Subfield subfield;
+    auto filter = parser->leafCallToMetadataFilter(
+        *parseCallExpr(expr, rowType), subfield, evaluator(), negated);
+    if (filter) {
+      validateSubfield(subfield, {field});
+    }
+    return filter;
+  };
+
+  // The exact filters are not used for functions of the subfield.
+  Subfield subfield;
+  ASSERT_FALSE(parser->leafCallToSubfieldFilter(
+      *parseCallExpr("a + 1 > 5", rowType), subfield, evaluator()));
+
+  auto filter = toFilter("a + 1 > 5");
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testInt64(4));
+  ASSERT_TRUE(filter->testInt64(5));
+
+  filter = toFilter("10 - a >= 3");
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(7));
+  ASSERT_FALSE(filter->testInt64(8));
+
+  filter = toFilter("5 < -a");
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(-6));
+  ASSERT_FALSE(filter->testInt64(-5));
+
+  filter = toFilter("cast(b as bigint) + 2 between 5 and 7", "b");
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testInt64(2));
+  ASSERT_TRUE(filter->testInt64(3));
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testInt64(6));
+
+  filter = toFilter("a - 1 = 3", "a", true);
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testInt64(4));
+  ASSERT_TRUE(filter->testInt64(3));
+
+  // No filter if the inverse fails or the function is not monotonic.
+  ASSERT_FALSE(toFilter("cast(b as bigint) > 10000000000", "b"));
+  ASSERT_FALSE(toFilter("a * 2 > 5"));
+  ASSERT_FALSE(toFilter("a + b > 5"));
+}
+
 class CustomExprToSubfieldFilterParser : public ExprToSubfieldFilterParser {
  public:
   std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FunctionResolutionCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/functions/Udf.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+template <typename T>
+struct PlusOneFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& result, const int64_t& input) {
+    result = input + 1;
+  }
+};
+
+class FunctionResolutionCacheTest : public functions::test::FunctionBaseTest {
+ protected:
+  void SetUp() override {
+    FunctionBaseTest::SetUp();
+    setCacheEnabled(true);
+    FunctionResolutionCache::instance().clear();
+  }
+
+  void TearDown() override {
+    setCacheEnabled(false);
+    FunctionBaseTest::TearDown();
+  }
+
+  void setCacheEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFunctionResolutionCacheEnabled,
+         enabled ? "true" : "false"},
+    });
+  }
+
+  static uint64_t numHits() {
+    return FunctionResolutionCache::instance().stats().numHits;
+  }
+
+  static uint64_t numMisses() {
+    return FunctionResolutionCache::instance().stats().numMisses;
+  }
+};
+
+TEST_F(FunctionResolutionCacheTest, sameShapeDifferentConstants) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<std::string>({"a", "b", "c"}),
+  });
+
+  // A simple function.
+  auto result = evaluate("c0 + 5", data);
+  assertEqualVectors(makeFlatVector<int64_t>({6, 7, 8}), result);
+  const auto hits = numHits();
+  const auto misses = numMisses();
+  result = evaluate("c0 + 7", data);
+  assertEqualVectors(makeFlatVector<int64_t>({8, 9, 10}), result);
+  ASSERT_EQ(numHits(), hits + 1);
+  ASSERT_EQ(numMisses(), misses);
+
+  // A vector function. The function is made with the constants of each call.
+  result = evaluate("concat(c1, 'x')", data);
+  assertEqualVectors(makeFlatVector<std::string>({"ax", "bx", "cx"}), result);
+  result = evaluate("concat(c1, 'yz')", data);
+  assertEqualVectors(
+      makeFlatVector<std::string>({"ayz", "byz", "cyz"}), result);
+  ASSERT_EQ(numHits(), hits + 2);
+  ASSERT_EQ(numMisses(), misses + 1);
+
+  // Other argument types are other entries.
+  evaluate("cast(c0 as integer) + cast(1 as integer)", data);
+  ASSERT_EQ(numMisses(), misses + 2);
+
+  const auto stats = FunctionResolutionCache::instance().stats();
+  ASSERT_GT(stats.hitRate(), 0);
+  ASSERT_GT(stats.missNanos, 0);
+  ASSERT_FALSE(stats.toString().empty());
+}
+
+TEST_F(FunctionResolutionCacheTest, disabled) {
+  setCacheEnabled(false);
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  const auto hits = numHits();
+  const auto misses = numMisses();
+  evaluate("c0 + 5", data);
+  evaluate("c0 + 7", data);
+  ASSERT_EQ(numHits(), hits);
+  ASSERT_EQ(numMisses(), misses);
+  ASSERT_EQ(FunctionResolutionCache::instance().size(), 0);
+}
+
+TEST_F(FunctionResolutionCacheTest, clearedOnRegistration) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  evaluate("c0 + 5", data);
+  ASSERT_GT(FunctionResolutionCache::instance().size(), 0);
+
+  registerFunction<PlusOneFunction, int64_t, int64_t>(
+      {"resolution_cache_plus_one"});
+  ASSERT_EQ(FunctionResolutionCache::instance().size(), 0);
+
+  auto result = evaluate("resolution_cache_plus_one(c0)", data);
+  assertEqualVectors(makeFlatVector<int64_t>({2, 3, 4}), result);
+  ASSERT_EQ(FunctionResolutionCache::instance().size(), 1);
+}
+
+TEST_F(FunctionResolutionCacheTest, maxEntries) {
+  FunctionResolutionCache cache(2);
+  ASSERT_NE(cache.resolve("plus", {BIGINT(), BIGINT()}), nullptr);
+  ASSERT_NE(cache.resolve("plus", {INTEGER(), INTEGER()}), nullptr);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_NE(cache.resolve("plus", {INTEGER(), INTEGER()}), nullptr);
+  ASSERT_EQ(cache.stats().numHits, 1);
+
+  // A miss when full clears the cache.
+  ASSERT_NE(cache.resolve("plus", {DOUBLE(), DOUBLE()}), nullptr);
+  ASSERT_EQ(cache.size(), 1);
+
+  // Calls that do not resolve are not kept.
+  ASSERT_EQ(cache.resolve("plus", {VARCHAR(), VARCHAR()}), nullptr);
+  ASSERT_EQ(cache.resolve("no_such_function", {BIGINT()}), nullptr);
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(cache.stats().numMisses, 5);
+}
+
+} // namespace
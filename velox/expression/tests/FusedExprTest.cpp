@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusionEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusionEnabled, enabled ? "true" : "false"},
+    });
+  }
+
+  // Evaluates 'expression' with and without fusion and compares the results.
+  // Returns true if the fused expression set has a FusedExpr at the root.
+  bool testFusion(
+      const std::string& expression,
+      const RowVectorPtr& data,
+      const std::optional<SelectivityVector>& rows = std::nullopt) {
+    setFusionEnabled(false);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    auto expected = evaluate(*exprSet, data, rows);
+
+    setFusionEnabled(true);
+    exprSet = compileExpression(expression, asRowType(data->type()));
+    auto result = evaluate(*exprSet, data, rows);
+    setFusionEnabled(false);
+
+    if (rows.has_value()) {
+      assertEqualVectors(expected, result, rows.value());
+    } else {
+      assertEqualVectors(expected, result);
+    }
+    return dynamic_cast<const exec::FusedExpr*>(exprSet->expr(0).get()) !=
+        nullptr;
+  }
+
+  RowVectorPtr makeData(vector_size_t size, bool withNulls) {
+    const auto nullEvery = [&](vector_size_t n) {
+      return [withNulls, n](vector_size_t row) {
+        return withNulls && row % n == 0;
+      };
+    };
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row % 101 - 50; }, nullEvery(7)),
+        makeFlatVector<int64_t>(size, [](auto row) { return row % 13; }),
+        makeFlatVector<int32_t>(
+            size, [](auto row) { return row % 17; }, nullEvery(11)),
+        makeFlatVector<double>(
+            size,
+            [](auto row) {
+              return row % 19 == 0 ? std::nan("") : row * 0.25 - 100;
+            }),
+        makeFlatVector<double>(size, [](auto row) { return row % 5 * 1.5; }),
+        makeFlatVector<bool>(
+            size, [](auto row) { return row % 3 == 0; }, nullEvery(5)),
+    });
+  }
+};
+
+TEST_F(FusedExprTest, arithmeticAndComparisons) {
+  const std::vector<std::string> expressions = {
+      "c0 + c1 * 2 - 3",
+      "c0 * c1 > c1 - 5",
+      "c2 + cast(3 as integer) <= c2 * c2",
+      "c3 * c4 + 1.5 >= c4 - c3",
+      "c3 = c4 * 2 or c3 <> c3 + 1.0",
+      "c0 + c1 > 10 and c3 < c4 and not c5",
+      "not (c0 < c1) or c5 = (c2 > c2 - cast(3 as integer))",
+  };
+  for (const auto withNulls : {false, true}) {
+    auto data = makeData(3'000, withNulls);
+    for (const auto& expression : expressions) {
+      SCOPED_TRACE(fmt::format("{} withNulls={}", expression, withNulls));
+      ASSERT_TRUE(testFusion(expression, data));
+
+      SelectivityVector oddRows(data->size(), false);
+      for (auto row = 1; row < data->size(); row += 2) {
+        oddRows.setValid(row, true);
+      }
+      oddRows.updateBounds();
+      ASSERT_TRUE(testFusion(expression, data, oddRows));
+    }
+  }
+}
+
+TEST_F(FusedExprTest, nan) {
+  auto data = makeRowVector({
+      makeFlatVector<double>({std::nan(""), 1.0, std::nan(""), -1.0}),
+      makeFlatVector<double>({std::nan(""), std::nan(""), 2.0, -1.0}),
+  });
+  for (const auto& expression :
+       {"c0 + 0.0 = c1 + 0.0",
+        "c0 + 0.0 < c1 + 0.0",
+        "c0 + 0.0 >= c1 + 0.0",
+        "c0 + 0.0 <> c1 + 0.0"}) {
+    SCOPED_TRACE(expression);
+    ASSERT_TRUE(testFusion(expression, data));
+  }
+}
+
+TEST_F(FusedExprTest, overflow) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          2'000,
+          [](auto row) {
+            return row == 1'500 ? std::numeric_limits<int64_t>::max() : row;
+          }),
+  });
+  setFusionEnabled(true);
+  auto exprSet = compileExpression("c0 + 1 > c0", asRowType(data->type()));
+  ASSERT_TRUE(
+      dynamic_cast<const exec::FusedExpr*>(exprSet->expr(0).get()) != nullptr);
+  VELOX_ASSERT_THROW(evaluate(*exprSet, data), "integer overflow");
+
+  // The overflow on an unselected row is ignored.
+  SelectivityVector rows(data->size());
+  rows.setValid(1'500, false);
+  rows.updateBounds();
+  ASSERT_TRUE(testFusion("c0 + 1 > c0", data, rows));
+
+  // The errors are suppressed as without fusion.
+  ASSERT_FALSE(testFusion("try(c0 + 1 > c0)", data));
+}
+
+TEST_F(FusedExprTest, encodings) {
+  auto data = makeData(1'000, true);
+  auto dictionary = makeRowVector({
+      wrapInDictionary(makeIndicesInReverse(1'000), data->childAt(0)),
+      data->childAt(1),
+      makeConstant<int32_t>(7, 1'000),
+      data->childAt(3),
+      makeNullConstant(TypeKind::DOUBLE, 1'000),
+      data->childAt(5),
+  });
+  for (const auto& expression :
+       {"c0 + c1 > c1 * 2",
+        "c3 * c4 < 2.0 or c5",
+        "c2 * c2 = c2 + c2 and c0 > 0"}) {
+    SCOPED_TRACE(expression);
+    ASSERT_TRUE(testFusion(expression, dictionary));
+  }
+}
+
+TEST_F(FusedExprTest, notFused) {
+  auto data = makeData(100, false);
+  // A single function.
+  ASSERT_FALSE(testFusion("c0 + c1", data));
+  // Functions that are not fusable.
+  ASSERT_FALSE(testFusion("abs(c0) + c1", data));
+  // A constant is folded instead.
+  ASSERT_FALSE(testFusion("1 + 2 > 1", data));
+
+  // The fusable subtrees of other expressions are fused.
+  setFusionEnabled(true);
+  auto exprSet = compileExpression(
+      "if(c0 + c1 > 10, c3, c4 * 2.0 - c3)", asRowType(data->type()));
+  setFusionEnabled(false);
+  const auto& inputs = exprSet->expr(0)->inputs();
+  ASSERT_EQ(inputs.size(), 3);
+  ASSERT_TRUE(dynamic_cast<const exec::FusedExpr*>(inputs[0].get()));
+  ASSERT_FALSE(dynamic_cast<const exec::FusedExpr*>(inputs[1].get()));
+  ASSERT_TRUE(dynamic_cast<const exec::FusedExpr*>(inputs[2].get()));
+}
+
+} // namespace
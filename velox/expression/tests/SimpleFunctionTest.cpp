@@ -861,6 +861,56 @@ TEST_F(SimpleFunctionTest, stringReuseConstant) {
   assertEqualVectors(expected, result);
 }
 
+template <typename T>
+struct ReferencingSubstr {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr int32_t reuse_strings_from_arg = 0;
+  static constexpr bool reference_copied_strings = true;
+
+  void call(
+      out_type<Varchar>& out,
+      const arg_type<Varchar>& str,
+      const int32_t& start,
+      const int32_t& length) {
+    if (start < 0) {
+      // A temporary string is copied.
+      out = std::string(str.data(), length);
+      out += std::string_view("!");
+      return;
+    }
+    out.copy_from(StringView(str.data() + start, length));
+  }
+};
+
+TEST_F(SimpleFunctionTest, referenceCopiedStrings) {
+  registerFunction<ReferencingSubstr, Varchar, Varchar, int32_t, int32_t>(
+      {"test_referencing_substr"});
+
+  auto strings = makeFlatVector<StringView>(
+      {"super happy fun string"_sv,
+       "another long enough string"_sv,
+       "a third long enough string"_sv,
+       "short"_sv});
+  auto starts = makeFlatVector<int32_t>({6, 0, -1, 1});
+  auto lengths = makeFlatVector<int32_t>({16, 7, 14, 3});
+
+  auto result = evaluate<FlatVector<StringView>>(
+      "test_referencing_substr(c0, c1, c2)",
+      makeRowVector({strings, starts, lengths}));
+
+  auto expected = makeFlatVector<StringView>(
+      {"happy fun string"_sv, "another"_sv, "a third long e!"_sv, "hor"_sv});
+  assertEqualVectors(expected, result);
+
+  // The long string copied from the input references the input.
+  EXPECT_EQ(result->valueAt(0).data(), strings->valueAt(0).data() + 6);
+  const auto& buffers = result->stringBuffers();
+  EXPECT_NE(
+      std::find(buffers.begin(), buffers.end(), strings->stringBuffers()[0]),
+      buffers.end());
+}
+
 template <typename T>
 struct MapStringOut {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -1655,4 +1705,55 @@ TEST_F(SimpleFunctionTest, toDebugString) {
       "Priority: 999997\nDefaultNullBehavior: true");
 }
 
+template <typename TExec>
+struct CheckedDivideValueFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(int64_t& out, int64_t a, int64_t b) {
+    VELOX_USER_CHECK_NE(b, 0, "Division by zero");
+    out = a / b;
+  }
+};
+
+TEST_F(SimpleFunctionTest, flatNoNullsKernel) {
+  registerFunction<CheckedDivideValueFunction, int64_t, int64_t, int64_t>(
+      {"checked_divide_value"});
+
+  // All rows selected, flat inputs without nulls.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 10; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7 + 1; }),
+  });
+  auto expected = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row * 10 / (row % 7 + 1); });
+  assertEqualVectors(expected, evaluate("checked_divide_value(c0, c1)", data));
+
+  // An error on one row is reported for that row only.
+  data = makeRowVector({
+      data->childAt(0),
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row == 500 ? 0 : row % 7 + 1; }),
+  });
+  VELOX_ASSERT_THROW(
+      evaluate("checked_divide_value(c0, c1)", data), "Division by zero");
+  auto result = evaluate("try(checked_divide_value(c0, c1))", data);
+  expected = makeFlatVector<int64_t>(
+      1'000,
+      [](auto row) { return row * 10 / (row % 7 + 1); },
+      [](auto row) { return row == 500; });
+  assertEqualVectors(expected, result);
+
+  // Inputs with nulls take the regular path.
+  data = makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row * 10; }, nullEvery(11)),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7 + 1; }),
+  });
+  expected = makeFlatVector<int64_t>(
+      1'000,
+      [](auto row) { return row * 10 / (row % 7 + 1); },
+      nullEvery(11));
+  assertEqualVectors(expected, evaluate("checked_divide_value(c0, c1)", data));
+}
+
 } // namespace
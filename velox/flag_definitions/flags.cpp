@@ -93,6 +93,15 @@ DEFINE_bool(
     "'velox_save_input_on_expression_any_failure_path' or "
     "'velox_save_input_on_expression_system_failure_path'");
 
+// Used in exec/VectorHasher.cpp
+
+DEFINE_bool(
+    velox_cache_string_hashes,
+    false,
+    "If true, the hashes of string join, grouping and partitioning keys are "
+    "cached on the hashed vectors, so that the operators of a pipeline that "
+    "hash the same vector compute them once");
+
 // TODO: deprecate this once all the memory leak issues have been fixed in
 // existing meta internal use cases.
 DEFINE_bool(
@@ -127,6 +136,23 @@ DEFINE_int32(
 
 DEFINE_bool(velox_ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 
+DEFINE_bool(
+    velox_io_uring,
+    false,
+    "Use io_uring for SSD cache and spill file IO. Has effect only when built "
+    "with VELOX_ENABLE_IO_URING and supported by the kernel");
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    64,
+    "Number of entries of the per-thread io_uring submission queue");
+
+DEFINE_bool(
+    velox_local_file_mmap,
+    false,
+    "Map the local files of table scans into memory. The unbuffered reads then "
+    "refer to the mapped file instead of copying it from the page cache");
+
 DEFINE_bool(
     velox_ssd_verify_write,
     false,
@@ -24,6 +24,7 @@
 #include "velox/core/SimpleFunctionMetadata.h"
 #include "velox/expression/FunctionCallToSpecialForm.h"
 #include "velox/expression/FunctionSignature.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
 #include "velox/expression/VectorFunction.h"
@@ -95,6 +96,7 @@ void clearFunctionRegistry() {
   exec::mutableSimpleFunctions().clearRegistry();
   exec::vectorFunctionFactories().withWLock(
       [](auto& functionMap) { functionMap.clear(); });
+  exec::FunctionResolutionCache::instance().clear();
 }
 
 std::optional<bool> isDeterministic(const std::string& functionName) {
@@ -185,6 +187,7 @@ void removeFunction(const std::string& functionName) {
   exec::mutableSimpleFunctions().removeFunction(functionName);
   exec::vectorFunctionFactories().withWLock(
       [&](auto& functionMap) { functionMap.erase(functionName); });
+  exec::FunctionResolutionCache::instance().clear();
 }
 
 } // namespace facebook::velox
@@ -16,6 +16,7 @@
 
 #include "velox/functions/lib/DateTimeFormatter.h"
 #include <folly/String.h>
+#include <algorithm>
 #include <charconv>
 #include <cstring>
 #include "velox/common/base/CountBits.h"
@@ -1274,6 +1275,22 @@ int32_t DateTimeFormatter::format(
 
   const auto durationInTheDay = date::make_time(timePoint - daysTimePoint);
   const date::year_month_day calDate(daysTimePoint);
+  if (fixedLayout_.has_value() &&
+      formatFixed(
+          static_cast<int64_t>(calDate.year()),
+          static_cast<unsigned>(calDate.month()),
+          static_cast<unsigned>(calDate.day()),
+          durationInTheDay.hours().count(),
+          durationInTheDay.minutes().count(),
+          durationInTheDay.seconds().count(),
+          durationInTheDay.subseconds().count(),
+          result)) {
+    VELOX_CHECK_LE(
+        fixedLayout_->text.size(),
+        maxResultSize,
+        "Bad allocation size for result.");
+    return fixedLayout_->text.size();
+  }
   const date::weekday weekday(daysTimePoint);
 
   const char* resultStart = result;
@@ -1565,6 +1582,12 @@ int32_t DateTimeFormatter::format(
 
 Expected<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input) const {
+  if (fixedLayout_.has_value()) {
+    if (auto result = parseFixed(input)) {
+      return result.value();
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
@@ -1680,6 +1703,187 @@ Expected<DateTimeResult> DateTimeFormatter::parse(
       date.timezone};
 }
 
+void DateTimeFormatter::initFixedLayout() {
+  // The simple formatters accept trailing input and are lenient about ranges.
+  if (type_ != DateTimeFormatterType::JODA &&
+      type_ != DateTimeFormatterType::MYSQL) {
+    return;
+  }
+  constexpr size_t kMaxSize = 256;
+  FixedLayout layout;
+  bool hasYear = false;
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      if (layout.text.size() + token.literal.size() > kMaxSize) {
+        return;
+      }
+      layout.literals.emplace_back(layout.text.size(), token.literal.size());
+      layout.text.append(token.literal);
+      continue;
+    }
+    const auto& pattern = token.pattern;
+    size_t width;
+    switch (pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        width = 4;
+        hasYear = true;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        width = 2;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        width = 3;
+        break;
+      default:
+        return;
+    }
+    // A field that repeats is resolved by the general parse.
+    if (pattern.minRepresentDigits != width ||
+        layout.text.size() + width > kMaxSize ||
+        std::any_of(
+            layout.fields.begin(), layout.fields.end(), [&](const auto& f) {
+              return f.specifier == pattern.specifier;
+            })) {
+      return;
+    }
+    layout.fields.push_back(
+        {pattern.specifier,
+         static_cast<uint16_t>(layout.text.size()),
+         static_cast<uint16_t>(width)});
+    layout.text.append(width, '0');
+  }
+  if (hasYear) {
+    fixedLayout_ = std::move(layout);
+  }
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::parseFixed(
+    std::string_view input) const {
+  const auto& layout = *fixedLayout_;
+  if (input.size() != layout.text.size()) {
+    return std::nullopt;
+  }
+  for (const auto& [offset, size] : layout.literals) {
+    if (std::memcmp(input.data() + offset, layout.text.data() + offset, size) !=
+        0) {
+      return std::nullopt;
+    }
+  }
+  int32_t year = 1970;
+  int32_t month = 1;
+  int32_t day = 1;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t millis = 0;
+  bool isYearOfEra = false;
+  for (const auto& field : layout.fields) {
+    int32_t value = 0;
+    for (auto i = field.offset; i < field.offset + field.width; ++i) {
+      if (!characterIsDigit(input[i])) {
+        return std::nullopt;
+      }
+      value = value * 10 + (input[i] - '0');
+    }
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        isYearOfEra = true;
+        [[fallthrough]];
+      case DateTimeFormatSpecifier::YEAR:
+        year = value;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = value;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = value;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = value;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = value;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = value;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        millis = value;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  if ((isYearOfEra && year == 0) || hour > 23 || minute > 59 || second > 59 ||
+      !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  const auto daysSinceEpoch = util::daysSinceEpochFromDate(year, month, day);
+  if (daysSinceEpoch.hasError()) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          daysSinceEpoch.value(),
+          util::fromTime(hour, minute, second, millis * util::kMicrosPerMsec)),
+      nullptr};
+}
+
+bool DateTimeFormatter::formatFixed(
+    int64_t year,
+    uint32_t month,
+    uint32_t day,
+    int64_t hour,
+    int64_t minute,
+    int64_t second,
+    int64_t millis,
+    char* result) const {
+  if (year < 1 || year > 9999) {
+    return false;
+  }
+  const auto& layout = *fixedLayout_;
+  std::memcpy(result, layout.text.data(), layout.text.size());
+  for (const auto& field : layout.fields) {
+    int64_t value;
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        value = year;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        value = month;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        value = day;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        value = hour;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        value = minute % 60;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        value = second % 60;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        value = millis;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    for (auto i = field.offset + field.width - 1; i >= field.offset; --i) {
+      result[i] = '0' + value % 10;
+      value /= 10;
+    }
+  }
+  return true;
+}
+
 Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
     const std::string_view& format) {
   if (format.empty()) {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -188,7 +189,9 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type) {
+    initFixedLayout();
+  }
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -229,10 +232,49 @@ class DateTimeFormatter {
       const std::optional<std::string>& zeroOffsetText = std::nullopt) const;
 
  private:
+  // A format of only literals and fixed-width numeric fields that include the
+  // year, e.g. 'yyyy-MM-dd HH:mm:ss.SSS', has the same layout for all values.
+  // Such a format is parsed and formatted at the offsets precomputed here
+  // instead of interpreting the tokens for each value.
+  struct FixedField {
+    DateTimeFormatSpecifier specifier;
+    uint16_t offset;
+    uint16_t width;
+  };
+
+  struct FixedLayout {
+    // The literals at their offsets and zeros in place of the fields.
+    std::string text;
+    std::vector<FixedField> fields;
+    // The offset and size of each literal in 'text'.
+    std::vector<std::pair<uint16_t, uint16_t>> literals;
+  };
+
+  // Sets 'fixedLayout_' if the tokens have a fixed layout.
+  void initFixedLayout();
+
+  // Parses 'input' with 'fixedLayout_'. Returns std::nullopt if 'input' does
+  // not match the layout or has an out of range field, so that the general
+  // parse() handles it, including the error.
+  std::optional<DateTimeResult> parseFixed(std::string_view input) const;
+
+  // Formats the fields with 'fixedLayout_' into 'result'. Returns false if a
+  // field does not fit its width, e.g. a year after 9999.
+  bool formatFixed(
+      int64_t year,
+      uint32_t month,
+      uint32_t day,
+      int64_t hour,
+      int64_t minute,
+      int64_t second,
+      int64_t millis,
+      char* result) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+  std::optional<FixedLayout> fixedLayout_;
 };
 
 Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
@@ -323,6 +323,55 @@ void KllSketch<T, A, C>::doInsert(T value) {
   isLevelZeroSorted_ = false;
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+  }
+  for (auto value : values) {
+    minValue_ = std::min(minValue_, value, C());
+    maxValue_ = std::max(maxValue_, value, C());
+  }
+  doInsert(values);
+}
+
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::doInsert(folly::Range<const T*> values) {
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  if (items_.size() < k_ && numLevels() == 1) {
+    // Same as the growth in doInsert(T).
+    i = std::min<size_t>(k_ - items_.size(), values.size());
+    items_.insert(items_.end(), values.begin(), values.begin() + i);
+    levels_[1] += i;
+    isLevelZeroSorted_ = false;
+  }
+  while (i < values.size()) {
+    if (levels_[0] == 0) {
+      // Compacts to make room at the bottom of level zero. Level zero must be
+      // marked unsorted only after this, as in doInsert(T).
+      items_[insertPosition()] = values[i++];
+      isLevelZeroSorted_ = false;
+      continue;
+    }
+    // Fills the free space below level zero downwards, in the same positions
+    // as inserting the values one by one.
+    const auto count = std::min<size_t>(levels_[0], values.size() - i);
+    T* out = items_.data() + levels_[0];
+    for (size_t j = 0; j < count; ++j) {
+      *--out = values[i + j];
+    }
+    levels_[0] -= count;
+    i += count;
+    isLevelZeroSorted_ = false;
+  }
+  n_ += values.size();
+}
+
 template <typename T, typename A, typename C>
 uint32_t KllSketch<T, A, C>::insertPosition() {
   if (levels_[0] == 0) {
@@ -611,9 +660,9 @@ void KllSketch<T, A, C>::mergeViews(
     if (other.n == 0) {
       continue;
     }
-    for (uint32_t j = other.levels[0]; j < other.levels[1]; ++j) {
-      doInsert(other.items[j]);
-    }
+    doInsert(folly::Range<const T*>(
+        other.items.data() + other.levels[0],
+        other.items.data() + other.levels[1]));
   }
   // Merge higher levels.
   auto tmpNumItems = getNumRetained();
@@ -82,6 +82,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add 'values' to the sketch.  Gives the same sketch as calling
+  /// insert(value) for each of them in order, but copies the values into
+  /// level zero in bulk between compactions.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -179,6 +184,7 @@ struct KllSketch {
  private:
   KllSketch(const Allocator&, uint32_t seed);
   void doInsert(T);
+  void doInsert(folly::Range<const T*>);
   uint32_t insertPosition();
   int findLevelToCompact() const;
   void addEmptyTopLevelToCompletelyFullSketch();
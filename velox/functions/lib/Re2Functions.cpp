@@ -14,6 +14,13 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <bitset>
+#include <deque>
+#include <re2/set.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/core/Expressions.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -674,23 +681,50 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::simdStrstr(
+             input.data(),
+             input.size(),
+             fixedPattern.data(),
+             fixedPattern.size()) != std::string::npos;
 }
 
+// Matches the literals of a kSubstrings pattern in order. The anchored first
+// and last literals are compared in place and the others are searched for in
+// the rest of the string.
 bool matchSubstringsPattern(
     const StringView& input,
-    const std::vector<std::string>& patterns) {
-  const char* data = input.data();
-  for (int i = 0; i < patterns.size(); i++) {
-    auto curPos =
-        std::string_view(data, input.end() - data)
-            .find(std::string_view(patterns[i].c_str(), patterns[i].size()));
-    if (curPos == std::string::npos) {
+    const PatternMetadata& patternMetadata) {
+  const auto& patterns = patternMetadata.substrings();
+  const char* begin = input.data();
+  const char* end = input.data() + input.size();
+  size_t first = 0;
+  size_t last = patterns.size();
+  if (patternMetadata.anchoredStart()) {
+    const auto& prefix = patterns.front();
+    if (input.size() < prefix.size() ||
+        std::memcmp(begin, prefix.data(), prefix.size()) != 0) {
+      return false;
+    }
+    begin += prefix.size();
+    ++first;
+  }
+  if (patternMetadata.anchoredEnd()) {
+    const auto& suffix = patterns.back();
+    if (static_cast<size_t>(end - begin) < suffix.size() ||
+        std::memcmp(end - suffix.size(), suffix.data(), suffix.size()) != 0) {
+      return false;
+    }
+    end -= suffix.size();
+    --last;
+  }
+  for (auto i = first; i < last; ++i) {
+    const auto& pattern = patterns[i];
+    const auto pos =
+        simd::simdStrstr(begin, end - begin, pattern.data(), pattern.size());
+    if (pos == std::string::npos) {
       return false;
     }
-    data = data + curPos + patterns[i].size();
+    begin += pos + pattern.size();
   }
   return true;
 }
@@ -751,7 +785,7 @@ class OptimizedLike final : public exec::VectorFunction {
         case PatternKind::kSubstring:
           return matchSubstringPattern(input, patternMetadata.fixedPattern());
         case PatternKind::kSubstrings:
-          return matchSubstringsPattern(input, patternMetadata.substrings());
+          return matchSubstringsPattern(input, patternMetadata);
       }
     } else {
       switch (P) {
@@ -787,7 +821,7 @@ class OptimizedLike final : public exec::VectorFunction {
         case PatternKind::kSubstring:
           return matchSubstringPattern(input, patternMetadata.fixedPattern());
         case PatternKind::kSubstrings:
-          return matchSubstringsPattern(input, patternMetadata.substrings());
+          return matchSubstringsPattern(input, patternMetadata);
       }
     }
   }
@@ -1069,6 +1103,304 @@ class LikeGeneric final : public exec::VectorFunction {
   int64_t maxCompiledRegexes_;
 };
 
+// Returns the metadata of a constant LIKE pattern without escape character
+// that can be matched without RE2. Returns nullopt for generic patterns.
+std::optional<PatternMetadata> parseOptimizedLikePattern(
+    std::string_view pattern) {
+  auto substrings = PatternMetadata::parseSubstrings(pattern);
+  if (!substrings.empty()) {
+    return PatternMetadata::substrings(std::move(substrings));
+  }
+  if (auto anchored = PatternMetadata::parseAnchoredSubstrings(pattern)) {
+    return anchored;
+  }
+  auto metadata = determinePatternKind(pattern, std::nullopt);
+  if (metadata.patternKind() == PatternKind::kGeneric) {
+    return std::nullopt;
+  }
+  return metadata;
+}
+
+// Aho-Corasick automaton that finds whether a string contains any of a set of
+// literals in one pass over its bytes. The bytes that do not occur in the
+// literals share one class, so that the transition table has 'numClasses_'
+// entries per state.
+class SubstringSetMatcher {
+ public:
+  // The maximum number of entries of the transition table.
+  static constexpr size_t kMaxTransitions = 1 << 20;
+
+  // Returns true if the transition table for 'literals' has at most
+  // kMaxTransitions entries.
+  static bool canBuild(const std::vector<std::string>& literals) {
+    std::bitset<256> bytes;
+    size_t numStates = 1;
+    for (const auto& literal : literals) {
+      for (auto c : literal) {
+        bytes.set(static_cast<uint8_t>(c));
+      }
+      numStates += literal.size();
+    }
+    return numStates * (bytes.count() + 1) <= kMaxTransitions;
+  }
+
+  explicit SubstringSetMatcher(const std::vector<std::string>& literals) {
+    byteClass_.fill(0);
+    for (const auto& literal : literals) {
+      for (auto c : literal) {
+        auto& byteClass = byteClass_[static_cast<uint8_t>(c)];
+        if (byteClass == 0) {
+          byteClass = numClasses_++;
+        }
+      }
+    }
+
+    // Builds the trie of the literals. -1 marks a missing edge.
+    transitions_.assign(numClasses_, -1);
+    accepting_.push_back(false);
+    for (const auto& literal : literals) {
+      VELOX_CHECK(!literal.empty());
+      int32_t state = 0;
+      for (auto c : literal) {
+        const auto edge = state * numClasses_ + classOf(c);
+        if (transitions_[edge] == -1) {
+          transitions_[edge] = accepting_.size();
+          accepting_.push_back(false);
+          transitions_.resize(transitions_.size() + numClasses_, -1);
+        }
+        state = transitions_[edge];
+      }
+      accepting_[state] = true;
+    }
+
+    // Completes the transitions in breadth-first order. A missing edge of a
+    // state is the edge of its failure state, i.e. of the state of its
+    // longest proper suffix in the trie.
+    std::vector<int32_t> failure(accepting_.size(), 0);
+    std::deque<int32_t> queue;
+    for (auto c = 0; c < numClasses_; ++c) {
+      if (transitions_[c] == -1) {
+        transitions_[c] = 0;
+      } else {
+        queue.push_back(transitions_[c]);
+      }
+    }
+    while (!queue.empty()) {
+      const auto state = queue.front();
+      queue.pop_front();
+      // A literal that is a suffix of the state also matches.
+      accepting_[state] = accepting_[state] || accepting_[failure[state]];
+      for (auto c = 0; c < numClasses_; ++c) {
+        const auto edge = state * numClasses_ + c;
+        const auto fallback = transitions_[failure[state] * numClasses_ + c];
+        if (transitions_[edge] == -1) {
+          transitions_[edge] = fallback;
+        } else {
+          failure[transitions_[edge]] = fallback;
+          queue.push_back(transitions_[edge]);
+        }
+      }
+    }
+  }
+
+  bool containsAny(const StringView& input) const {
+    const auto* data = reinterpret_cast<const uint8_t*>(input.data());
+    int32_t state = 0;
+    for (auto i = 0; i < input.size(); ++i) {
+      state = transitions_[state * numClasses_ + byteClass_[data[i]]];
+      if (accepting_[state]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  int32_t classOf(char c) const {
+    return byteClass_[static_cast<uint8_t>(c)];
+  }
+
+  // Class of each byte. 0 for the bytes that are not in any literal.
+  std::array<uint16_t, 256> byteClass_;
+  int32_t numClasses_{1};
+  // The next state for each state and byte class.
+  std::vector<int32_t> transitions_;
+  std::vector<bool> accepting_;
+};
+
+// Returns true if 'input' matches a pattern of any kind other than kGeneric.
+template <bool isAscii>
+bool matchOptimizedPattern(
+    const StringView& input,
+    const PatternMetadata& patternMetadata) {
+  switch (patternMetadata.patternKind()) {
+    case PatternKind::kExactlyN:
+      return OptimizedLike<PatternKind::kExactlyN>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kAtLeastN:
+      return OptimizedLike<PatternKind::kAtLeastN>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kFixed:
+      return OptimizedLike<PatternKind::kFixed>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kRelaxedFixed:
+      return OptimizedLike<PatternKind::kRelaxedFixed>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kPrefix:
+      return OptimizedLike<PatternKind::kPrefix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kRelaxedPrefix:
+      return OptimizedLike<PatternKind::kRelaxedPrefix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSuffix:
+      return OptimizedLike<PatternKind::kSuffix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kRelaxedSuffix:
+      return OptimizedLike<PatternKind::kRelaxedSuffix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSubstring:
+      return OptimizedLike<PatternKind::kSubstring>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSubstrings:
+      return OptimizedLike<PatternKind::kSubstrings>::match<isAscii>(
+          input, patternMetadata);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Matches a string against a set of constant LIKE patterns without escape
+// character. The '%literal%' patterns are looked up together with a
+// SubstringSetMatcher. The other patterns are matched one by one.
+class LikeAny final : public exec::VectorFunction {
+ public:
+  explicit LikeAny(std::vector<PatternMetadata> patterns) {
+    std::vector<std::string> literals;
+    for (auto& pattern : patterns) {
+      const auto kind = pattern.patternKind();
+      if (kind == PatternKind::kSubstring) {
+        literals.push_back(pattern.fixedPattern());
+      } else if (
+          kind == PatternKind::kSubstrings &&
+          pattern.substrings().size() == 1 && !pattern.anchoredStart() &&
+          !pattern.anchoredEnd()) {
+        literals.push_back(pattern.substrings().front());
+      } else {
+        needsUtf8Processing_ = needsUtf8Processing_ ||
+            kind == PatternKind::kExactlyN || kind == PatternKind::kAtLeastN ||
+            kind == PatternKind::kRelaxedFixed ||
+            kind == PatternKind::kRelaxedPrefix ||
+            kind == PatternKind::kRelaxedSuffix;
+        patterns_.push_back(std::move(pattern));
+      }
+    }
+    if (literals.size() > 1 && SubstringSetMatcher::canBuild(literals)) {
+      literals_ = std::make_unique<SubstringSetMatcher>(literals);
+    } else {
+      for (auto& literal : literals) {
+        patterns_.push_back(PatternMetadata::substring(literal));
+      }
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    const bool isAscii = !needsUtf8Processing_ || isAsciiArg(rows, args[0]);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    if (isAscii) {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+        result.set(row, matchAny<true>(decoded->valueAt<StringView>(row)));
+      });
+    } else {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+        result.set(row, matchAny<false>(decoded->valueAt<StringView>(row)));
+      });
+    }
+  }
+
+ private:
+  template <bool isAscii>
+  bool matchAny(const StringView& input) const {
+    if (literals_ && literals_->containsAny(input)) {
+      return true;
+    }
+    for (const auto& pattern : patterns_) {
+      if (matchOptimizedPattern<isAscii>(input, pattern)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::unique_ptr<SubstringSetMatcher> literals_;
+  std::vector<PatternMetadata> patterns_;
+  bool needsUtf8Processing_{false};
+};
+
+// Matches a string against a set of constant regular expressions with one
+// RE2::Set, which scans the string once for all patterns. Falls back to
+// matching the patterns one by one if the set cannot be compiled or runs out
+// of DFA memory on some input.
+class Re2SearchAny final : public exec::VectorFunction {
+ public:
+  explicit Re2SearchAny(const std::vector<std::string>& patterns)
+      : set_(RE2::Options(RE2::Quiet), RE2::UNANCHORED) {
+    patterns_.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+      patterns_.push_back(std::make_unique<RE2>(pattern, RE2::Quiet));
+      checkForBadPattern(*patterns_.back());
+      std::string error;
+      VELOX_USER_CHECK_GE(
+          set_.Add(pattern, &error),
+          0,
+          "invalid regular expression:{}",
+          error);
+    }
+    useSet_ = set_.Compile();
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      result.set(row, matchAny(decoded->valueAt<StringView>(row)));
+    });
+  }
+
+ private:
+  bool matchAny(const StringView& input) const {
+    if (useSet_) {
+      RE2::Set::ErrorInfo errorInfo;
+      if (set_.Match(toStringPiece(input), nullptr, &errorInfo)) {
+        return true;
+      }
+      if (errorInfo.kind != RE2::Set::kOutOfMemory) {
+        return false;
+      }
+    }
+    for (const auto& re : patterns_) {
+      if (re2PartialMatch(input, *re)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  RE2::Set set_;
+  std::vector<std::unique_ptr<RE2>> patterns_;
+  bool useSet_{false};
+};
+
 void re2ExtractAll(
     exec::VectorWriter<Array<Varchar>>& resultWriter,
     const RE2& re,
@@ -1831,8 +2163,14 @@ PatternMetadata PatternMetadata::substring(const std::string& fixedPattern) {
 }
 
 PatternMetadata PatternMetadata::substrings(
-    std::vector<std::string> substrings) {
-  return {PatternKind::kSubstrings, 0, "", {}, std::move(substrings)};
+    std::vector<std::string> substrings,
+    bool anchoredStart,
+    bool anchoredEnd) {
+  PatternMetadata metadata{
+      PatternKind::kSubstrings, 0, "", {}, std::move(substrings)};
+  metadata.anchoredStart_ = anchoredStart;
+  metadata.anchoredEnd_ = anchoredEnd;
+  return metadata;
 }
 
 std::vector<std::string> PatternMetadata::parseSubstrings(
@@ -1852,6 +2190,31 @@ std::vector<std::string> PatternMetadata::parseSubstrings(
   return substrings;
 }
 
+std::optional<PatternMetadata> PatternMetadata::parseAnchoredSubstrings(
+    std::string_view pattern) {
+  if (pattern.empty() || (pattern.front() == '%' && pattern.back() == '%') ||
+      pattern.find('_') != std::string_view::npos) {
+    return std::nullopt;
+  }
+  std::vector<std::string> literals;
+  size_t begin = 0;
+  while (begin < pattern.size()) {
+    auto end = pattern.find('%', begin);
+    if (end == std::string_view::npos) {
+      end = pattern.size();
+    }
+    if (end > begin) {
+      literals.emplace_back(pattern.substr(begin, end - begin));
+    }
+    begin = end + 1;
+  }
+  if (literals.size() < 2) {
+    return std::nullopt;
+  }
+  return substrings(
+      std::move(literals), pattern.front() != '%', pattern.back() != '%');
+}
+
 PatternMetadata::PatternMetadata(
     PatternKind patternKind,
     size_t length,
@@ -2269,6 +2632,11 @@ std::shared_ptr<exec::VectorFunction> makeLike(
         return std::make_shared<OptimizedLike<PatternKind::kSubstrings>>(
             patternMetadata);
       }
+      if (auto anchored = PatternMetadata::parseAnchoredSubstrings(
+              std::string_view(pattern))) {
+        return std::make_shared<OptimizedLike<PatternKind::kSubstrings>>(
+            std::move(anchored.value()));
+      }
     }
 
     patternMetadata =
@@ -2329,6 +2697,229 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures() {
   };
 }
 
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /* config */) {
+  VELOX_CHECK_GE(inputArgs.size(), 2);
+  std::vector<PatternMetadata> patterns;
+  patterns.reserve(inputArgs.size() - 1);
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto* constantPattern = inputArgs[i].constantValue.get();
+    VELOX_CHECK(
+        constantPattern != nullptr && !constantPattern->isNullAt(0),
+        "{} requires constant non-null patterns",
+        name);
+    const auto pattern =
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0);
+    auto metadata = parseOptimizedLikePattern(std::string_view(pattern));
+    VELOX_CHECK(
+        metadata.has_value(), "Unsupported pattern for {}: {}", name, pattern);
+    patterns.push_back(std::move(metadata.value()));
+  }
+  return std::make_shared<LikeAny>(std::move(patterns));
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {
+      exec::FunctionSignatureBuilder()
+          .returnType("boolean")
+          .argumentType("varchar")
+          .constantArgumentType("varchar")
+          .constantVariableArity("varchar")
+          .build(),
+  };
+}
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /* config */) {
+  VELOX_CHECK_GE(inputArgs.size(), 2);
+  std::vector<std::string> patterns;
+  patterns.reserve(inputArgs.size() - 1);
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto* constantPattern = inputArgs[i].constantValue.get();
+    VELOX_CHECK(
+        constantPattern != nullptr && !constantPattern->isNullAt(0),
+        "{} requires constant non-null patterns",
+        name);
+    patterns.emplace_back(
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  return std::make_shared<Re2SearchAny>(patterns);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {
+      exec::FunctionSignatureBuilder()
+          .returnType("boolean")
+          .argumentType("varchar")
+          .constantArgumentType("varchar")
+          .constantVariableArity("varchar")
+          .build(),
+  };
+}
+
+namespace {
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, disjuncts);
+    }
+    return;
+  }
+  disjuncts.push_back(expr);
+}
+
+// Returns the value of the constant non-null varchar pattern of 'expr' if it
+// is a call to 'name' with a varchar string and such a pattern.
+std::optional<std::string> constantPattern(
+    const std::string& name,
+    const core::TypedExprPtr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2 ||
+      !call->inputs()[0]->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  const auto& pattern = call->inputs()[1];
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(pattern.get());
+  if (constant == nullptr || !pattern->type()->isVarchar() ||
+      constant->isNull()) {
+    return std::nullopt;
+  }
+  return constant->hasValueVector()
+      ? std::string(constant->valueVector()
+                        ->as<ConstantVector<StringView>>()
+                        ->valueAt(0))
+      : constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Returns the pattern of 'expr' if it is a call to '<prefix>like' with a
+// constant pattern that can be evaluated by $internal$like_any.
+core::TypedExprPtr likeAnyPattern(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto value = constantPattern(prefix + "like", expr);
+  if (!value.has_value()) {
+    return nullptr;
+  }
+  try {
+    if (!parseOptimizedLikePattern(value.value()).has_value()) {
+      return nullptr;
+    }
+  } catch (const VeloxUserError&) {
+    return nullptr;
+  }
+  return expr->inputs()[1];
+}
+
+// Returns the pattern of 'expr' if it is a call to '<prefix>regexp_like' with
+// a valid constant pattern. Calls with invalid patterns are not rewritten so
+// that they keep raising their errors.
+core::TypedExprPtr regexpLikeAnyPattern(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto value = constantPattern(prefix + "regexp_like", expr);
+  if (!value.has_value() || !RE2(value.value(), RE2::Quiet).ok()) {
+    return nullptr;
+  }
+  return expr->inputs()[1];
+}
+
+// Replaces each group of at least two disjuncts of the 'or' call 'expr' with
+// the same first argument and a pattern returned by 'patternOf' with one call
+// to 'anyName'. Returns nullptr if there is no such group.
+core::TypedExprPtr rewriteAnyCall(
+    const core::TypedExprPtr& expr,
+    const std::function<core::TypedExprPtr(const core::TypedExprPtr&)>&
+        patternOf,
+    const std::string& anyName) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+  std::vector<core::TypedExprPtr> disjuncts;
+  flattenOr(expr, disjuncts);
+
+  // The matching calls grouped by their first argument.
+  struct Group {
+    core::TypedExprPtr input;
+    std::vector<core::TypedExprPtr> calls;
+    std::vector<core::TypedExprPtr> patterns;
+  };
+  std::vector<Group> groups;
+  std::vector<core::TypedExprPtr> others;
+  for (const auto& disjunct : disjuncts) {
+    auto pattern = patternOf(disjunct);
+    if (pattern == nullptr) {
+      others.push_back(disjunct);
+      continue;
+    }
+    const auto& input = disjunct->inputs()[0];
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+      return *g.input == *input;
+    });
+    if (it == groups.end()) {
+      groups.push_back({input, {}, {}});
+      it = groups.end() - 1;
+    }
+    it->calls.push_back(disjunct);
+    it->patterns.push_back(std::move(pattern));
+  }
+
+  std::vector<core::TypedExprPtr> inputs;
+  bool rewritten = false;
+  for (auto& group : groups) {
+    if (group.patterns.size() < 2) {
+      inputs.push_back(group.calls.front());
+      continue;
+    }
+    std::vector<core::TypedExprPtr> args{group.input};
+    args.insert(args.end(), group.patterns.begin(), group.patterns.end());
+    inputs.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(args), anyName));
+    rewritten = true;
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  inputs.insert(inputs.end(), others.begin(), others.end());
+  if (inputs.size() == 1) {
+    return inputs.front();
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(inputs), "or");
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteLikeAnyCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  return rewriteAnyCall(
+      expr,
+      [&](const auto& disjunct) { return likeAnyPattern(prefix, disjunct); },
+      "$internal$like_any");
+}
+
+core::TypedExprPtr rewriteRegexpLikeAnyCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  return rewriteAnyCall(
+      expr,
+      [&](const auto& disjunct) {
+        return regexpLikeAnyPattern(prefix, disjunct);
+      },
+      "$internal$regexp_like_any");
+}
+
 std::shared_ptr<exec::VectorFunction> makeRe2ExtractAll(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
@@ -50,6 +50,8 @@ enum class PatternKind {
   /// Patterns matching '%{c0}%', such as '%foo%%', '%%%hello%'.
   kSubstring,
   /// Patterns matching '%{c0}%{c1}%', such as '%%foo%%bar%%', '%foo%bar%'.
+  /// The first and last literals may be anchored to the start and end of the
+  /// string, such as 'foo%bar', 'foo%bar%' and '%foo%bar'.
   /// Note: Unlike kSubstring, kSubstrings applies only to constant patterns
   /// as pattern parsing is expensive.
   kSubstrings,
@@ -104,11 +106,21 @@ class PatternMetadata {
 
   static PatternMetadata substring(const std::string& fixedPattern);
 
-  static PatternMetadata substrings(std::vector<std::string> substrings);
+  static PatternMetadata substrings(
+      std::vector<std::string> substrings,
+      bool anchoredStart = false,
+      bool anchoredEnd = false);
 
   static std::vector<std::string> parseSubstrings(
       const std::string_view& pattern);
 
+  /// Parses patterns of at least two literals separated by '%' where the first
+  /// or the last literal is not preceded or followed by '%', such as
+  /// 'foo%bar', 'foo%%bar%' and '%foo%bar'. The literals cannot contain '_'.
+  /// Returns nullopt for other patterns. Used only without escape character.
+  static std::optional<PatternMetadata> parseAnchoredSubstrings(
+      std::string_view pattern);
+
   PatternKind patternKind() const {
     return patternKind_;
   }
@@ -129,6 +141,16 @@ class PatternMetadata {
     return substrings_;
   }
 
+  /// True if the first of 'substrings' must be a prefix of the string.
+  bool anchoredStart() const {
+    return anchoredStart_;
+  }
+
+  /// True if the last of 'substrings' must be a suffix of the string.
+  bool anchoredEnd() const {
+    return anchoredEnd_;
+  }
+
  private:
   PatternMetadata(
       PatternKind patternKind,
@@ -155,6 +177,10 @@ class PatternMetadata {
   std::vector<SubPatternMetadata> subPatterns_;
 
   std::vector<std::string> substrings_;
+
+  /// Only used for kSubstrings patterns.
+  bool anchoredStart_{false};
+  bool anchoredEnd_{false};
 };
 
 /// The functions in this file use RE2 as the regex engine. RE2 is fast, but
@@ -186,6 +212,29 @@ std::shared_ptr<exec::VectorFunction> makeRe2Search(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures();
 
+/// $internal$regexp_like_any(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether string has a substring that matches any of the constant
+/// patterns, i.e. the result of 'regexp_like(string, pattern1) OR
+/// regexp_like(string, pattern2) OR ...'. The patterns are matched together
+/// in one pass over the string with an RE2::Set. Calls are produced by
+/// rewriteRegexpLikeAnyCall.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures();
+
+/// Rewrites a disjunction of calls to '<prefix>regexp_like' into one call to
+/// $internal$regexp_like_any for each group of at least two calls with the
+/// same first argument and valid constant patterns. Nested 'or' calls are
+/// flattened. The other disjuncts are kept. Returns nullptr if there is no
+/// such group.
+core::TypedExprPtr rewriteRegexpLikeAnyCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 /// re2Extract(string, pattern, group_id) → string
 /// re2Extract(string, pattern) → string
 ///
@@ -226,6 +275,29 @@ std::shared_ptr<exec::VectorFunction> makeLike(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures();
 
+/// $internal$like_any(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether string matches any of the constant patterns, i.e. the
+/// result of 'string LIKE pattern1 OR string LIKE pattern2 OR ...'. The
+/// patterns have no escape character and are not of kind kGeneric. The
+/// '%literal%' patterns are matched together in one pass over the string.
+/// Calls are produced by rewriteLikeAnyCall.
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures();
+
+/// Rewrites a disjunction of calls to '<prefix>like' into one call to
+/// $internal$like_any for each group of at least two calls with the same
+/// first argument and constant patterns without escape character that are not
+/// of kind kGeneric. Nested 'or' calls are flattened. The other disjuncts are
+/// kept. Returns nullptr if there is no such group.
+core::TypedExprPtr rewriteLikeAnyCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 /// re2ExtractAll(string, pattern, group_id) → array<string>
 /// re2ExtractAll(string, pattern) → array<string>
 ///
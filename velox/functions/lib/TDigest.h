@@ -20,6 +20,7 @@
 #include "velox/common/base/Portability.h"
 
 #include <folly/Bits.h>
+#include <folly/Range.h>
 
 #include <numeric>
 
@@ -45,7 +46,11 @@ constexpr double kDefaultCompression = 100;
 ///
 /// 2. When we merging the deserialized digests, if the centroids are already
 /// sorted (highly likely so), we no longer need to re-sort them and can
-/// directly start merging the sorted centroids.
+/// directly start merging the sorted centroids.  The centroids of many digests
+/// are merged as sorted runs instead of being sorted together.
+///
+/// 3. Values added in batches are sorted directly, and multiple quantiles are
+/// estimated in one pass over the centroids.
 ///
 /// Java implementation can be found at
 /// https://github.com/prestodb/presto/blob/master/presto-main/src/main/java/com/facebook/presto/tdigest/TDigest.java
@@ -70,6 +75,15 @@ class TDigest {
   ///  be added.
   void add(std::vector<int16_t>& positions, double value, int64_t weight = 1);
 
+  /// Add multiple values with weight 1 to the digest.  Faster than adding them
+  /// one by one, since each batch of values is sorted directly instead of
+  /// through the positions of the centroids.
+  ///
+  /// @param positions Scratch memory used to keep the ordered positions of
+  ///  centroids.
+  /// @param values The new values to be added.  Cannot be NaN.
+  void add(std::vector<int16_t>& positions, folly::Range<const double*> values);
+
   /// Compress the buffered values according to the compression parameter
   /// provided.  Must be called before doing any estimation or serialization.
   ///
@@ -82,6 +96,13 @@ class TDigest {
   /// @param quantile Quantile in [0, 1] to be estimated.
   double estimateQuantile(double quantile) const;
 
+  /// Estimate the values of multiple quantiles in one pass over the
+  /// centroids.  Sets 'results[i]' to the value of 'quantiles[i]'.  The
+  /// quantiles can be in any order.
+  void estimateQuantiles(
+      folly::Range<const double*> quantiles,
+      double* results) const;
+
   /// Calculate the size needed for serialization.
   int64_t serializedByteSize() const;
 
@@ -114,8 +135,30 @@ class TDigest {
   static constexpr double kRelativeErrorEpsilon = 1e-4;
 
  private:
+  // The new values are merged as sorted runs if they are on average at least
+  // this long, and sorted otherwise.
+  static constexpr int kMinAverageRunLength = 16;
+
+  // The position in the centroids of a search for increasing quantiles.
+  struct QuantileCursor {
+    int centroid = 1;
+    double weightSoFar;
+  };
+
   void mergeNewValues(std::vector<int16_t>& positions, double compression);
 
+  // Orders 'positions' [numMerged_, positions.size()) by means and merges
+  // them with the merged centroids [0, numMerged_).
+  void sortNewValues(std::vector<int16_t>& positions);
+
+  // Returns the value at 'index' in [0, totalWeight]. 'cursor' is advanced to
+  // the centroids at 'index', so that a later call with a larger index
+  // continues from there.
+  double estimateValueAt(
+      double index,
+      double totalWeight,
+      QuantileCursor& cursor) const;
+
   void merge(
       double compression,
       const double* weights,
@@ -176,6 +219,30 @@ void TDigest<A>::add(
   }
 }
 
+template <typename A>
+void TDigest<A>::add(
+    std::vector<int16_t>& positions,
+    folly::Range<const double*> values) {
+  while (!values.empty()) {
+    const auto begin = means_.size();
+    const auto count =
+        std::min<size_t>(values.size(), maxBufferSize_ - weights_.size());
+    for (size_t i = 0; i < count; ++i) {
+      VELOX_CHECK(!std::isnan(values[i]));
+    }
+    means_.insert(means_.end(), values.begin(), values.begin() + count);
+    weights_.resize(begin + count, 1);
+    // The weights are all 1, so the values can be sorted without positions.
+    std::sort(means_.begin() + begin, means_.end());
+    min_ = std::min(min_, means_[begin]);
+    max_ = std::max(max_, means_.back());
+    values.advance(count);
+    if (weights_.size() >= maxBufferSize_) {
+      mergeNewValues(positions, 2 * compression_);
+    }
+  }
+}
+
 template <typename A>
 void TDigest<A>::compress(std::vector<int16_t>& positions) {
   if (!weights_.empty()) {
@@ -191,12 +258,7 @@ void TDigest<A>::mergeNewValues(
     VELOX_CHECK_LE(weights_.size(), std::numeric_limits<int16_t>::max());
     positions.resize(weights_.size());
     std::iota(positions.begin(), positions.end(), 0);
-    auto newBegin = positions.begin() + numMerged_;
-    auto compare = [this](auto i, auto j) { return means_[i] < means_[j]; };
-    if (!std::is_sorted(means_.begin() + numMerged_, means_.end())) {
-      std::sort(newBegin, positions.end(), compare);
-    }
-    std::inplace_merge(positions.begin(), newBegin, positions.end(), compare);
+    sortNewValues(positions);
     // Reorder weights_ and means_ according to positions.
     for (int i = 0; i < positions.size(); ++i) {
       if (i == positions[i]) {
@@ -224,6 +286,49 @@ void TDigest<A>::mergeNewValues(
   merge(compression, weights_.data(), means_.data(), weights_.size());
 }
 
+template <typename A>
+void TDigest<A>::sortNewValues(std::vector<int16_t>& positions) {
+  auto compare = [this](auto i, auto j) { return means_[i] < means_[j]; };
+  const int32_t size = positions.size();
+  // The boundaries of the merged centroids and of the sorted runs of new
+  // values, e.g. the centroids of each deserialized digest.
+  std::vector<int32_t> runs;
+  if (numMerged_ > 0) {
+    runs.push_back(0);
+  }
+  runs.push_back(numMerged_);
+  for (auto i = numMerged_ + 1; i < size; ++i) {
+    if (means_[i] < means_[i - 1]) {
+      runs.push_back(i);
+    }
+  }
+  const auto numNewRuns = runs.size() - (numMerged_ > 0 ? 1 : 0);
+  if (numNewRuns * kMinAverageRunLength > size - numMerged_) {
+    auto newBegin = positions.begin() + numMerged_;
+    std::sort(newBegin, positions.end(), compare);
+    std::inplace_merge(positions.begin(), newBegin, positions.end(), compare);
+    return;
+  }
+  // Merges the runs pairwise, which takes O(n log k) for k runs.
+  runs.push_back(size);
+  std::vector<int32_t> merged;
+  while (runs.size() > 2) {
+    merged.clear();
+    for (size_t i = 0; i + 1 < runs.size(); i += 2) {
+      merged.push_back(runs[i]);
+      if (i + 2 < runs.size()) {
+        std::inplace_merge(
+            positions.begin() + runs[i],
+            positions.begin() + runs[i + 1],
+            positions.begin() + runs[i + 2],
+            compare);
+      }
+    }
+    merged.push_back(size);
+    std::swap(runs, merged);
+  }
+}
+
 template <typename A>
 void TDigest<A>::merge(
     double compression,
@@ -307,7 +412,44 @@ double TDigest<A>::estimateQuantile(double quantile) const {
     return means_[0];
   }
   auto totalWeight = std::accumulate(weights_.begin(), weights_.end(), 0.0);
-  const auto index = quantile * totalWeight;
+  QuantileCursor cursor{1, weights_[0] / 2};
+  return estimateValueAt(quantile * totalWeight, totalWeight, cursor);
+}
+
+template <typename A>
+void TDigest<A>::estimateQuantiles(
+    folly::Range<const double*> quantiles,
+    double* results) const {
+  VELOX_CHECK_EQ(numMerged_, weights_.size());
+  for (auto quantile : quantiles) {
+    VELOX_CHECK(0 <= quantile && quantile <= 1);
+  }
+  if (numMerged_ <= 1) {
+    std::fill_n(results, quantiles.size(), numMerged_ == 0 ? NAN : means_[0]);
+    return;
+  }
+  auto totalWeight = std::accumulate(weights_.begin(), weights_.end(), 0.0);
+  // The quantiles are visited in increasing order so that each search
+  // continues where the previous one stopped.
+  std::vector<int32_t> order(quantiles.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (!std::is_sorted(quantiles.begin(), quantiles.end())) {
+    std::sort(order.begin(), order.end(), [&](auto i, auto j) {
+      return quantiles[i] < quantiles[j];
+    });
+  }
+  QuantileCursor cursor{1, weights_[0] / 2};
+  for (auto i : order) {
+    results[i] =
+        estimateValueAt(quantiles[i] * totalWeight, totalWeight, cursor);
+  }
+}
+
+template <typename A>
+double TDigest<A>::estimateValueAt(
+    double index,
+    double totalWeight,
+    QuantileCursor& cursor) const {
   if (index < 1) {
     return min_;
   }
@@ -329,8 +471,8 @@ double TDigest<A>::estimateQuantile(double quantile) const {
         (max_ - means_.back());
   }
   // In between extremes we interpolate between centroids.
-  auto weightSoFar = weights_[0] / 2;
-  for (int i = 1; i < numMerged_; ++i) {
+  auto& weightSoFar = cursor.weightSoFar;
+  for (auto& i = cursor.centroid; i < numMerged_; ++i) {
     // Centroids i-1 and i bracket our current point.
     auto dw = (weights_[i - 1] + weights_[i]) / 2;
     if (weightSoFar + dw <= index) {
@@ -125,6 +125,40 @@ struct InitSessionTimezone {
       const arg_type<Timestamp>* /*timestamp*/) {
     timeZone_ = getTimeZoneFromConfig(config);
   }
+
+  /// Computes the results of a batch kernel from the calendar fields of
+  /// 'size' timestamps in the session time zone. Converts the whole batch to
+  /// the time zone at once. Returns false if there is no session time zone or
+  /// the batch must be processed row by row.
+  template <typename TFunc>
+  bool callBatchInTimeZone(
+      int64_t* result,
+      int32_t size,
+      const Timestamp* timestamps,
+      TFunc func) {
+    if (timeZone_ == nullptr) {
+      return false;
+    }
+    localSeconds_.resize(size);
+    for (auto i = 0; i < size; ++i) {
+      localSeconds_[i] = timestamps[i].getSeconds();
+    }
+    if (!timeZone_->to_local(
+            localSeconds_.data(), size, localSeconds_.data())) {
+      return false;
+    }
+    std::tm dateTime;
+    for (auto i = 0; i < size; ++i) {
+      if (!Timestamp::epochToCalendarUtc(localSeconds_[i], dateTime)) {
+        return false;
+      }
+      result[i] = func(dateTime);
+    }
+    return true;
+  }
+
+ private:
+  std::vector<int64_t> localSeconds_;
 };
 
 /// Converts string as date time unit. Throws for invalid input string.
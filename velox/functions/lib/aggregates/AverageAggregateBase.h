@@ -201,6 +201,24 @@ class AverageAggregateBase : public exec::Aggregate {
     }
   }
 
+  bool supportsRemoveRawInput() const override {
+    return true;
+  }
+
+  void removeSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    decodedRaw_.decode(*args[0], rows);
+    auto* sumCount = accumulator(group);
+    rows.applyToSelected([&](vector_size_t i) {
+      if (!decodedRaw_.isNullAt(i)) {
+        sumCount->sum -= TAccumulator(decodedRaw_.valueAt<TInput>(i));
+        --sumCount->count;
+      }
+    });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
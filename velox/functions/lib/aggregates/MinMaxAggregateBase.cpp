@@ -160,6 +160,35 @@ class SimpleNumericMaxAggregate : public SimpleNumericMinMaxAggregate<T> {
     addSingleGroupRawInput(group, rows, args, mayPushdown);
   }
 
+  bool supportsDenseInput() const override {
+    return std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+        !std::is_same_v<T, int128_t>;
+  }
+
+  void initializeDenseAccumulators(char* accumulators, int32_t numGroups)
+      override {
+    std::fill_n(reinterpret_cast<T*>(accumulators), numGroups, kInitialValue_);
+  }
+
+  void addRawDenseInput(
+      const uint64_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      char* accumulators,
+      uint64_t* nonNullGroups) override {
+    BaseAggregate::template updateDenseGroups<T>(
+        groupIndices, rows, args[0], accumulators, nonNullGroups, updateGroup);
+  }
+
+  void addDenseAccumulators(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* nonNullGroups) override {
+    BaseAggregate::template addDenseGroups<T>(
+        groups, numGroups, accumulators, nonNullGroups, updateGroup);
+  }
+
  protected:
   void initializeNewGroupsInternal(
       char** groups,
@@ -261,6 +290,35 @@ class SimpleNumericMinAggregate : public SimpleNumericMinMaxAggregate<T> {
     addSingleGroupRawInput(group, rows, args, mayPushdown);
   }
 
+  bool supportsDenseInput() const override {
+    return std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+        !std::is_same_v<T, int128_t>;
+  }
+
+  void initializeDenseAccumulators(char* accumulators, int32_t numGroups)
+      override {
+    std::fill_n(reinterpret_cast<T*>(accumulators), numGroups, kInitialValue_);
+  }
+
+  void addRawDenseInput(
+      const uint64_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      char* accumulators,
+      uint64_t* nonNullGroups) override {
+    BaseAggregate::template updateDenseGroups<T>(
+        groupIndices, rows, args[0], accumulators, nonNullGroups, updateGroup);
+  }
+
+  void addDenseAccumulators(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* nonNullGroups) override {
+    BaseAggregate::template addDenseGroups<T>(
+        groups, numGroups, accumulators, nonNullGroups, updateGroup);
+  }
+
  protected:
   static inline void updateGroup(T& result, T value) {
     if constexpr (std::is_floating_point_v<T>) {
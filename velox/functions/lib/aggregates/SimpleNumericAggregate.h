@@ -198,6 +198,69 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Updates the dense accumulators of type TData in 'accumulators' with the
+  // values of 'arg' and sets the bits of their groups in 'nonNullGroups'. See
+  // Aggregate::addRawDenseInput(). The accumulators of a small number of groups
+  // stay in cache, unlike the accumulators in scattered group rows.
+  template <
+      typename TData = TAccumulator,
+      typename TValue = TInput,
+      typename UpdateSingleValue>
+  void updateDenseGroups(
+      const uint64_t* groupIndices,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      char* accumulators,
+      uint64_t* nonNullGroups,
+      UpdateSingleValue updateSingleValue) {
+    auto* values = reinterpret_cast<TData*>(accumulators);
+    const auto update = [&](vector_size_t i, TData value) {
+      const auto group = groupIndices[i];
+      updateSingleValue(values[group], value);
+      bits::setBit(nonNullGroups, group);
+    };
+
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        const TData value(decoded.valueAt<TValue>(0));
+        rows.applyToSelected([&](vector_size_t i) { update(i, value); });
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          update(i, TData(decoded.valueAt<TValue>(i)));
+        }
+      });
+    } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+      auto data = decoded.data<TValue>();
+      rows.applyToSelected(
+          [&](vector_size_t i) { update(i, TData(data[i])); });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        update(i, TData(decoded.valueAt<TValue>(i)));
+      });
+    }
+  }
+
+  // Updates the accumulators of 'groups' with the dense accumulators of type
+  // TData of the groups set in 'nonNullGroups'. See
+  // Aggregate::addDenseAccumulators().
+  template <typename TData = TAccumulator, typename UpdateSingleValue>
+  void addDenseGroups(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* nonNullGroups,
+      UpdateSingleValue updateSingleValue) {
+    const auto* values = reinterpret_cast<const TData*>(accumulators);
+    bits::forEachSetBit(nonNullGroups, 0, numGroups, [&](int32_t group) {
+      VELOX_DCHECK_NOT_NULL(groups[group]);
+      updateNonNullValue<true, TData>(
+          groups[group], values[group], updateSingleValue);
+    });
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
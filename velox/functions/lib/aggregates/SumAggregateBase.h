@@ -95,6 +95,69 @@ class SumAggregateBase
         TAccumulator(0));
   }
 
+  bool supportsDenseInput() const override {
+    return true;
+  }
+
+  void initializeDenseAccumulators(char* accumulators, int32_t numGroups)
+      override {
+    std::fill_n(
+        reinterpret_cast<TAccumulator*>(accumulators),
+        numGroups,
+        TAccumulator(0));
+  }
+
+  void addRawDenseInput(
+      const uint64_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      char* accumulators,
+      uint64_t* nonNullGroups) override {
+    BaseAggregate::template updateDenseGroups<TAccumulator>(
+        groupIndices,
+        rows,
+        args[0],
+        accumulators,
+        nonNullGroups,
+        &updateSingleValue<TAccumulator>);
+  }
+
+  void addDenseAccumulators(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* nonNullGroups) override {
+    BaseAggregate::template addDenseGroups<TAccumulator>(
+        groups,
+        numGroups,
+        accumulators,
+        nonNullGroups,
+        &updateSingleValue<TAccumulator>);
+  }
+
+  /// Only integer sums are removable. Removing floating point values loses
+  /// precision.
+  bool supportsRemoveRawInput() const override {
+    return std::is_integral_v<TAccumulator>;
+  }
+
+  void removeSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if constexpr (std::is_integral_v<TAccumulator>) {
+      DecodedVector decoded(*args[0], rows);
+      auto* sum = BaseAggregate::Aggregate::template value<TAccumulator>(group);
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          subtractValue(*sum, TAccumulator(decoded.valueAt<TInput>(i)));
+        }
+      });
+    } else {
+      VELOX_UNREACHABLE();
+    }
+  }
+
   void addSingleGroupIntermediateResults(
       char* group,
       const SelectivityVector& rows,
@@ -155,6 +218,20 @@ class SumAggregateBase
     velox::aggregate::SumHook<TData, Overflow>::add(result, value);
   }
 
+  // Disable undefined behavior sanitizer to not fail on signed integer
+  // overflow.
+  template <typename TData>
+#if defined(FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER)
+  FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER("signed-integer-overflow")
+#endif
+  static void subtractValue(TData& result, TData value) {
+    if constexpr (Overflow) {
+      result -= value;
+    } else {
+      result = functions::checkedMinus<TData>(result, value);
+    }
+  }
+
   // Disable undefined behavior sanitizer to not fail on signed integer
   // overflow.
   template <typename TData>
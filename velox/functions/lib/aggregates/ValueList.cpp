@@ -125,4 +125,63 @@ bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
   pos_++;
   return pos_ < size_;
 }
+
+void ValueListReader::readAll(BaseVector& output, vector_size_t outputIndex) {
+  VELOX_CHECK_EQ(pos_, 0);
+  if (size_ == 0) {
+    return;
+  }
+  const auto kind = output.typeKind();
+  if (output.encoding() == VectorEncoding::Simple::FLAT &&
+      output.type()->isFixedWidth() && kind != TypeKind::BOOLEAN &&
+      kind != TypeKind::UNKNOWN) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        readAllFixedWidth, kind, output, outputIndex);
+    return;
+  }
+  for (auto i = 0; i < size_; ++i) {
+    next(output, outputIndex + i);
+  }
+}
+
+template <TypeKind Kind>
+void ValueListReader::readAllFixedWidth(
+    BaseVector& output,
+    vector_size_t outputIndex) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (!TypeTraits<Kind>::isFixedWidth || Kind == TypeKind::BOOLEAN) {
+    VELOX_UNREACHABLE();
+  } else {
+    auto* values = output.asUnchecked<FlatVector<T>>();
+    auto* rawValues = values->mutableRawValues();
+    // Reads a word of null flags for each 64 values.
+    while (pos_ < size_) {
+      nulls_ =
+          pos_ == lastNullsStart_ ? lastNulls_ : nullsStream_.read<uint64_t>();
+      const auto numValues = std::min<vector_size_t>(64, size_ - pos_);
+      if (nulls_ == 0) {
+        if (values->rawNulls() != nullptr) {
+          bits::fillBits(
+              values->mutableRawNulls(),
+              outputIndex,
+              outputIndex + numValues,
+              bits::kNotNull);
+        }
+        dataStream_.readBytes(
+            reinterpret_cast<uint8_t*>(rawValues + outputIndex),
+            numValues * sizeof(T));
+      } else {
+        for (auto i = 0; i < numValues; ++i) {
+          if (nulls_ & (1UL << i)) {
+            values->setNull(outputIndex + i, true);
+          } else {
+            values->set(outputIndex + i, dataStream_.read<T>());
+          }
+        }
+      }
+      pos_ += numValues;
+      outputIndex += numValues;
+    }
+  }
+}
 } // namespace facebook::velox::aggregate
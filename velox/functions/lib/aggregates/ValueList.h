@@ -27,7 +27,9 @@ namespace facebook::velox::aggregate {
 
 // Represents a list of values, including nulls, for an array/map/distinct value
 // set in aggregation. Bit-packed null flags are stored separately from the
-// non-null values.
+// non-null values. The non-null values of fixed-width types are stored back to
+// back in their native representation, so that ValueListReader::readAll() can
+// copy them in bulk.
 class ValueList {
  public:
   void appendValue(
@@ -71,6 +73,19 @@ class ValueList {
     return lastNulls_;
   }
 
+  // Passes the references to the 'data' and 'nulls' allocations to
+  // 'relocator'. See HashStringAllocator::compact().
+  void relocate(HashStringAllocator::Relocator& relocator) {
+    if (nullsBegin_) {
+      relocator.relocate(nullsBegin_);
+      relocator.relocate(nullsCurrent_);
+    }
+    if (dataBegin_) {
+      relocator.relocate(dataBegin_);
+      relocator.relocate(dataCurrent_);
+    }
+  }
+
   void free(HashStringAllocator* allocator) {
     if (size_) {
       allocator->free(nullsBegin_);
@@ -123,7 +138,15 @@ class ValueListReader {
 
   bool next(BaseVector& output, vector_size_t outputIndex);
 
+  // Reads all values into 'output' starting at 'outputIndex'. Copies the runs
+  // of non-null values with memcpy if 'output' is a flat vector of a
+  // fixed-width type other than BOOLEAN. Must be called before next().
+  void readAll(BaseVector& output, vector_size_t outputIndex);
+
  private:
+  template <TypeKind Kind>
+  void readAllFixedWidth(BaseVector& output, vector_size_t outputIndex);
+
   const vector_size_t size_;
   const vector_size_t lastNullsStart_;
   const uint64_t lastNulls_;
@@ -148,9 +171,7 @@ void copyValueListToArrayWriter(
   writer.reserve(size);
 
   ValueListReader reader(elements);
-  for (vector_size_t i = 0; i < size; ++i) {
-    reader.next(*writer.elementsVector(), writer.valuesOffset() + i);
-  }
+  reader.readAll(*writer.elementsVector(), writer.valuesOffset());
   writer.resize(size);
 }
 
@@ -45,6 +45,22 @@ class ValueListTest : public functions::test::FunctionBaseTest {
     return result;
   }
 
+  // Reads 'values' with ValueListReader::readAll() at an offset into the
+  // result.
+  VectorPtr readAll(
+      aggregate::ValueList& values,
+      const TypePtr& type,
+      vector_size_t size) {
+    constexpr vector_size_t kOffset = 3;
+    aggregate::ValueListReader reader(values);
+    auto result = BaseVector::create(type, size + kOffset, pool());
+    for (auto i = 0; i < size + kOffset; ++i) {
+      result->setNull(i, true);
+    }
+    reader.readAll(*result, kOffset);
+    return result->slice(kOffset, size);
+  }
+
   void testRoundTrip(const VectorPtr& data) {
     auto size = data->size();
 
@@ -60,6 +76,7 @@ class ValueListTest : public functions::test::FunctionBaseTest {
       auto result = read(values, data->type(), size);
 
       assertEqualVectors(data, result);
+      assertEqualVectors(data, readAll(values, data->type(), size));
     }
 
     // Use ValueList::appendRange.
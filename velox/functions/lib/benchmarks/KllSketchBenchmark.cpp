@@ -85,6 +85,17 @@ int insertKllSketch(int iters) {
   return iters;
 }
 
+template <typename T>
+int insertKllSketchBatch(int iters) {
+  std::vector<T> values;
+  BENCHMARK_SUSPEND {
+    populateValues(iters, values);
+  }
+  KllSketch<T> kll;
+  kll.insert(folly::Range<const T*>(values.data(), values.size()));
+  return iters;
+}
+
 void mergeTDigest(int iters, int maxSize, int count) {
   std::vector<folly::TDigest> digests;
   BENCHMARK_SUSPEND {
@@ -121,6 +132,29 @@ void mergeKllSketch(int iters, int maxSize, int count) {
   }
 }
 
+// Merges the sketches one at a time, like a final aggregation that receives
+// one intermediate result per row for each group.
+void mergeKllSketchOneByOne(int iters, int maxSize, int count) {
+  std::vector<KllSketch<double>> sketches;
+  BENCHMARK_SUSPEND {
+    std::vector<double> values;
+    for (int i = 0; i < count; ++i) {
+      populateValues(maxSize, values);
+      KllSketch<double> kll;
+      kll.insert(folly::Range<const double*>(values.data(), values.size()));
+      sketches.push_back(std::move(kll));
+      values.clear();
+    }
+  }
+  for (int i = 0; i < iters; ++i) {
+    auto merged = sketches[0];
+    for (int j = 1; j < count; ++j) {
+      merged.merge(sketches[j]);
+    }
+    folly::doNotOptimizeAway(merged);
+  }
+}
+
 #define DEFINE_WITH_TYPE(name, type)  \
   int name##_##type(int, int iters) { \
     return name<type>(iters);         \
@@ -130,6 +164,8 @@ DEFINE_WITH_TYPE(insertTDigest, int64_t);
 DEFINE_WITH_TYPE(insertTDigest, double);
 DEFINE_WITH_TYPE(insertKllSketch, int64_t);
 DEFINE_WITH_TYPE(insertKllSketch, double);
+DEFINE_WITH_TYPE(insertKllSketchBatch, int64_t);
+DEFINE_WITH_TYPE(insertKllSketchBatch, double);
 
 #undef DEFINE_WITH_TYPE
 
@@ -137,16 +173,22 @@ BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e5);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e5);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e5);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e5);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e6);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e6);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e6);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e6);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e7);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e7);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e7);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e7);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x2, 1e6, 2);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x2, 1e6, 2);
@@ -156,6 +198,12 @@ BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x40, 1e6, 40);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x40, 1e6, 40);
 BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x80, 1e6, 80);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x80, 1e6, 80);
+BENCHMARK_DRAW_LINE();
+// Many small sketches, as in a final aggregation with many groups.
+BENCHMARK_NAMED_PARAM(mergeKllSketchOneByOne, 1e2x1000, 100, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e2x1000, 100, 1000);
+BENCHMARK_NAMED_PARAM(mergeKllSketchOneByOne, 1e3x100, 1000, 100);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e3x100, 1000, 100);
 
 // ============================================================================
 // [...]chmarks/ApproxPercentileBenchmark.cpp     relative  time/iter   iters/s
@@ -104,28 +104,99 @@ reverseUnicode(char* output, const char* input, size_t length) {
   }
 }
 
+namespace detail {
+using ByteBatch = xsimd::batch<int8_t>;
+
+static_assert(ByteBatch::size <= 32);
+
+// Returns true if 'ch' is one of the ascii whitespaces 9-13 and 28-32.
+FOLLY_ALWAYS_INLINE bool isAsciiWhiteSpaceChar(char ch) {
+  return (ch >= 9 && ch <= 13) || (ch >= 28 && ch <= 32);
+}
+
+// Returns a bit mask with the bytes of 'batch' that are ascii whitespaces.
+FOLLY_ALWAYS_INLINE uint32_t asciiWhiteSpaceBits(ByteBatch batch) {
+  return simd::toBitMask(
+      ((batch >= ByteBatch::broadcast(9)) &
+       (batch <= ByteBatch::broadcast(13))) |
+      ((batch >= ByteBatch::broadcast(28)) &
+       (batch <= ByteBatch::broadcast(32))));
+}
+
+// Converts the letters in ['first', 'last'] by adding 'delta' to them and
+// copies the other bytes as is.
+template <char first, char last, int8_t delta>
+FOLLY_ALWAYS_INLINE void
+convertCaseAscii(char* output, const char* input, size_t length) {
+  size_t i = 0;
+  for (; i + ByteBatch::size <= length; i += ByteBatch::size) {
+    const auto batch =
+        ByteBatch::load_unaligned(reinterpret_cast<const int8_t*>(input + i));
+    const auto isLetter = (batch >= ByteBatch::broadcast(first)) &
+        (batch <= ByteBatch::broadcast(last));
+    xsimd::select(isLetter, batch + ByteBatch::broadcast(delta), batch)
+        .store_unaligned(reinterpret_cast<int8_t*>(output + i));
+  }
+  for (; i < length; ++i) {
+    const auto ch = input[i];
+    output[i] = ch >= first && ch <= last ? ch + delta : ch;
+  }
+}
+} // namespace detail
+
 /// Perform upper for ascii string input
 FOLLY_ALWAYS_INLINE static void
 upperAscii(char* output, const char* input, size_t length) {
-  VECTORIZE_LOOP_IF_POSSIBLE for (auto i = 0; i < length; i++) {
-    if (input[i] >= 'a' && input[i] <= 'z') {
-      output[i] = input[i] - 32;
-    } else {
-      output[i] = input[i];
-    }
-  }
+  detail::convertCaseAscii<'a', 'z', -32>(output, input, length);
 }
 
 /// Perform lower for ascii string input
 FOLLY_ALWAYS_INLINE static void
 lowerAscii(char* output, const char* input, size_t length) {
-  VECTORIZE_LOOP_IF_POSSIBLE for (auto i = 0; i < length; i++) {
-    if (input[i] >= 'A' && input[i] <= 'Z') {
-      output[i] = input[i] + 32;
-    } else {
-      output[i] = input[i];
+  detail::convertCaseAscii<'A', 'Z', 32>(output, input, length);
+}
+
+/// Returns the number of ascii whitespaces at the start of 'data'. The
+/// whitespaces are the characters 9-13 and 28-32.
+FOLLY_ALWAYS_INLINE size_t
+leadingAsciiWhiteSpaces(const char* data, size_t size) {
+  constexpr uint32_t kAllSet = simd::allSetBitMask<int8_t>();
+  size_t i = 0;
+  for (; i + detail::ByteBatch::size <= size; i += detail::ByteBatch::size) {
+    const auto bits =
+        detail::asciiWhiteSpaceBits(detail::ByteBatch::load_unaligned(
+            reinterpret_cast<const int8_t*>(data + i)));
+    if (bits != kAllSet) {
+      return i + __builtin_ctz(~bits);
+    }
+  }
+  while (i < size && detail::isAsciiWhiteSpaceChar(data[i])) {
+    ++i;
+  }
+  return i;
+}
+
+/// Returns the number of ascii whitespaces at the end of 'data'.
+FOLLY_ALWAYS_INLINE size_t
+trailingAsciiWhiteSpaces(const char* data, size_t size) {
+  constexpr auto kBatchSize = detail::ByteBatch::size;
+  constexpr uint32_t kAllSet = simd::allSetBitMask<int8_t>();
+  size_t numSpaces = 0;
+  for (; numSpaces + kBatchSize <= size; numSpaces += kBatchSize) {
+    const auto bits =
+        detail::asciiWhiteSpaceBits(detail::ByteBatch::load_unaligned(
+            reinterpret_cast<const int8_t*>(
+                data + size - numSpaces - kBatchSize)));
+    if (bits != kAllSet) {
+      // Counts the whitespaces after the last byte that is not one.
+      return numSpaces + __builtin_clz(~bits << (32 - kBatchSize));
     }
   }
+  while (numSpaces < size &&
+         detail::isAsciiWhiteSpaceChar(data[size - numSpaces - 1])) {
+    ++numSpaces;
+  }
+  return numSpaces;
 }
 
 /// Perform upper for utf8 string input, output should be pre-allocated and
@@ -232,20 +303,23 @@ applyAppendersRecursive(TOutStr& output, Func appenderFunc, Funcs... funcs) {
  */
 FOLLY_ALWAYS_INLINE int64_t
 lengthUnicode(const char* inputBuffer, size_t bufferLength) {
-  // First address after the last byte in the buffer
-  auto buffEndAddress = inputBuffer + bufferLength;
-  auto currentChar = inputBuffer;
+  // Counts the bytes that are not continuation bytes of a multi-byte UTF-8
+  // character (provided that the string is valid UTF-8). The continuation
+  // bytes are 0x80-0xBF, i.e. the signed bytes less than -64.
+  const auto minLeadByte = detail::ByteBatch::broadcast(-64);
   int64_t size = 0;
-  while (currentChar < buffEndAddress) {
-    // This function detects bytes that come after the first byte in a
-    // multi-byte UTF-8 character (provided that the string is valid UTF-8). We
-    // increment size only for the first byte so that we treat all bytes as part
-    // of a single character.
-    if (!utf_cont(*currentChar)) {
+  size_t i = 0;
+  for (; i + detail::ByteBatch::size <= bufferLength;
+       i += detail::ByteBatch::size) {
+    const auto batch = detail::ByteBatch::load_unaligned(
+        reinterpret_cast<const int8_t*>(inputBuffer + i));
+    size += detail::ByteBatch::size -
+        __builtin_popcount(simd::toBitMask(batch < minLeadByte));
+  }
+  for (; i < bufferLength; ++i) {
+    if (!utf_cont(inputBuffer[i])) {
       size++;
     }
-
-    currentChar++;
   }
   return size;
 }
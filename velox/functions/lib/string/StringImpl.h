@@ -373,15 +373,7 @@ FOLLY_ALWAYS_INLINE bool isUnicodeWhiteSpace(utf8proc_int32_t codePoint) {
 }
 
 FOLLY_ALWAYS_INLINE bool isAsciiWhiteSpace(char ch) {
-  static const auto kAsciiCodes = asciiWhitespaceCodes();
-
-  const uint32_t code = ch;
-
-  if (code <= 32) {
-    return bits::isBitSet(&kAsciiCodes, code);
-  }
-
-  return false;
+  return stringCore::detail::isAsciiWhiteSpaceChar(ch);
 }
 
 FOLLY_ALWAYS_INLINE bool isAsciiSpace(char ch) {
@@ -514,6 +506,33 @@ trimAscii(TOutString& output, const TInString& input, TShouldTrim shouldTrim) {
   output.setNoCopy(StringView(start, curPos - start + 1));
 }
 
+/// Removes the ascii whitespaces, as per isAsciiWhiteSpace, from the start
+/// and/or the end of 'input'. Skips the whitespaces a SIMD batch at a time.
+template <
+    bool leftTrim,
+    bool rightTrim,
+    typename TOutString,
+    typename TInString>
+FOLLY_ALWAYS_INLINE void trimAsciiWhiteSpace(
+    TOutString& output,
+    const TInString& input) {
+  const auto* data = input.data();
+  const size_t size = input.size();
+  size_t begin = 0;
+  if constexpr (leftTrim) {
+    begin = leadingAsciiWhiteSpaces(data, size);
+  }
+  if (begin >= size) {
+    output.setEmpty();
+    return;
+  }
+  size_t end = size;
+  if constexpr (rightTrim) {
+    end -= trailingAsciiWhiteSpaces(data + begin, size - begin);
+  }
+  output.setNoCopy(StringView(data + begin, end - begin));
+}
+
 template <
     bool leftTrim,
     bool rightTrim,
@@ -20,6 +20,7 @@
 #include "velox/type/StringView.h"
 
 #include <gtest/gtest.h>
+#include <cctype>
 #include <memory>
 #include <vector>
 
@@ -92,6 +93,30 @@ TEST_F(StringImplTest, lowerAscii) {
   }
 }
 
+TEST_F(StringImplTest, upperLowerAsciiLong) {
+  // Covers the SIMD batches and the remainder of strings of various lengths.
+  std::string input;
+  for (auto i = 0; i < 100; ++i) {
+    input.push_back(static_cast<char>(' ' + i % 95));
+  }
+  for (auto length = 0; length <= input.size(); ++length) {
+    std::string expectedUpper = input.substr(0, length);
+    std::string expectedLower = expectedUpper;
+    for (auto& ch : expectedUpper) {
+      ch = std::toupper(ch);
+    }
+    for (auto& ch : expectedLower) {
+      ch = std::tolower(ch);
+    }
+    std::string output;
+    upper</*ascii*/ true>(output, StringView(input.data(), length));
+    ASSERT_EQ(output, expectedUpper);
+    output.clear();
+    lower</*ascii*/ true>(output, StringView(input.data(), length));
+    ASSERT_EQ(output, expectedLower);
+  }
+}
+
 TEST_F(StringImplTest, upperUnicode) {
   for (auto& testCase : getUpperUnicodeTestData()) {
     auto input = StringView(std::get<0>(testCase));
@@ -177,6 +202,59 @@ TEST_F(StringImplTest, length) {
   }
 }
 
+TEST_F(StringImplTest, lengthLong) {
+  // Mixes 1 to 4 byte characters over strings longer than a SIMD batch.
+  const std::vector<std::string> chars = {
+      "a", "\u00e0", "\u20ac", "\U0001F600"};
+  std::string input;
+  int64_t numChars = 0;
+  for (auto i = 0; i < 100; ++i) {
+    input += chars[(i * 7) % chars.size()];
+    ++numChars;
+    ASSERT_EQ(length</*isAscii*/ false>(input), numChars);
+  }
+}
+
+TEST_F(StringImplTest, trimAsciiWhiteSpace) {
+  struct Output {
+    void setEmpty() {
+      value.clear();
+    }
+
+    void setNoCopy(StringView view) {
+      value = std::string(view.data(), view.size());
+    }
+
+    std::string value;
+  };
+
+  const std::string whiteSpaces = "\t\n\v\f\r\x1c\x1d\x1e\x1f ";
+  const std::vector<std::string> bodies = {"", "a b", std::string(40, 'x')};
+  for (auto numLeading : {0, 1, 15, 16, 17, 33, 70}) {
+    for (auto numTrailing : {0, 1, 15, 16, 17, 33, 70}) {
+      std::string leading;
+      for (auto i = 0; i < numLeading; ++i) {
+        leading.push_back(whiteSpaces[i % whiteSpaces.size()]);
+      }
+      std::string trailing;
+      for (auto i = 0; i < numTrailing; ++i) {
+        trailing.push_back(whiteSpaces[(i * 3) % whiteSpaces.size()]);
+      }
+      for (const auto& body : bodies) {
+        SCOPED_TRACE(fmt::format("{} {} {}", numLeading, numTrailing, body));
+        const auto input = leading + body + trailing;
+        Output output;
+        trimAsciiWhiteSpace<true, true>(output, StringView(input));
+        ASSERT_EQ(output.value, body);
+        trimAsciiWhiteSpace<true, false>(output, StringView(input));
+        ASSERT_EQ(output.value, body.empty() ? body : body + trailing);
+        trimAsciiWhiteSpace<false, true>(output, StringView(input));
+        ASSERT_EQ(output.value, body.empty() ? body : leading + body);
+      }
+    }
+  }
+}
+
 TEST_F(StringImplTest, cappedLength) {
   auto input = std::string("abcd");
   ASSERT_EQ(cappedLength</*isAscii*/ true>(input, 1), 1);
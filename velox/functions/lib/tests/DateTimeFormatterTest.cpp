@@ -1357,6 +1357,61 @@ TEST_F(JodaDateTimeFormatterTest, betterErrorMessaging) {
       "Value 429 for dayOfMonth must be in the range [1,365] for year 2057 and month 2.");
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedLayout) {
+  // 'yyyy-MM-dd HH:mm:ss.SSS' is parsed and formatted at fixed offsets. The
+  // single 'H' and the era make the other formats go through the tokens.
+  const auto fixed = getJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss.SSS");
+  const auto parser = getJodaDateTimeFormatter("yyyy-MM-dd H:mm:ss.SSS");
+  for (const std::string_view input :
+       {"2024-02-29 23:59:59.999",
+        "1970-01-01 00:00:00.000",
+        "0001-01-01 07:08:09.010",
+        "9999-12-31 12:00:00.001",
+        "2024-01-01 1:00:00.000",
+        "12024-01-01 01:00:00.000",
+        "2023-02-29 10:00:00.000",
+        "2024-13-01 10:00:00.000",
+        "2024-01-01 24:00:00.000",
+        "2024-01-01 10:60:00.000",
+        "2024-01-01T10:00:00.000",
+        "2024-01-01 10:00:00.00x",
+        "2024-01-01 10:00:00.000 "}) {
+    SCOPED_TRACE(input);
+    const auto expected = parser->parse(input);
+    const auto actual = fixed->parse(input);
+    ASSERT_EQ(expected.hasError(), actual.hasError());
+    if (!expected.hasError()) {
+      EXPECT_EQ(expected.value().timestamp, actual.value().timestamp);
+      EXPECT_EQ(actual.value().timezone, nullptr);
+    }
+  }
+
+  const auto formatter = getJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss.SSS G");
+  const auto format = [](const DateTimeFormatter& formatter,
+                         const Timestamp& timestamp,
+                         const tz::TimeZone* timezone) {
+    const auto maxSize = formatter.maxResultSize(timezone);
+    std::string result(maxSize, '\0');
+    result.resize(
+        formatter.format(timestamp, timezone, maxSize, result.data()));
+    return result;
+  };
+  const auto* timezone = tz::locateZone("America/Los_Angeles");
+  // Seconds from year 1 to past year 10'000.
+  for (int64_t seconds = -62'135'596'800; seconds < 300'000'000'000;
+       seconds += 7'777'777'777) {
+    const Timestamp timestamp(seconds, 123'456'789);
+    SCOPED_TRACE(timestamp.toString());
+    for (const auto* zone : {static_cast<const tz::TimeZone*>(nullptr),
+                             timezone}) {
+      const auto expected = format(*formatter, timestamp, zone);
+      EXPECT_EQ(
+          expected.substr(0, expected.size() - 3),
+          format(*fixed, timestamp, zone));
+    }
+  }
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
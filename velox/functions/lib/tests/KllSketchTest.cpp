@@ -129,6 +129,37 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  insertRandomData(0, N, expected, values.data());
+  auto serialize = [](const KllSketch<double>& kll) {
+    std::string data(kll.serializedByteSize(), '\0');
+    kll.serialize(data.data());
+    return data;
+  };
+  for (int batchSize : {1, 7, 199, 200, 1'000, N}) {
+    SCOPED_TRACE(fmt::format("batchSize: {}", batchSize));
+    KllSketch<double> kll(kDefaultK, {}, 0);
+    for (int i = 0; i < N; i += batchSize) {
+      kll.insert(folly::Range<const double*>(
+          values.data() + i, values.data() + std::min(N, i + batchSize)));
+    }
+    ASSERT_EQ(serialize(kll), serialize(expected));
+  }
+
+  // Inserting into a compacted sketch.
+  auto compacted = KllSketch<double>::fromRepeatedValue(1, 1'000, kDefaultK);
+  compacted.compact();
+  auto batch = compacted;
+  for (auto value : values) {
+    compacted.insert(value);
+  }
+  batch.insert(folly::Range<const double*>(values.data(), values.size()));
+  ASSERT_EQ(serialize(batch), serialize(compacted));
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
@@ -15,6 +15,7 @@
  */
 #include "velox/functions/lib/Re2Functions.h"
 
+#include <folly/String.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <velox/type/Type.h>
@@ -951,6 +952,181 @@ TEST_F(Re2FunctionsTest, likeSubstringPattern) {
       true);
 }
 
+TEST_F(Re2FunctionsTest, likeAnchoredSubstringsPattern) {
+  testLike("foobar", "foo%bar", true);
+  testLike("foo-bar", "foo%%bar", true);
+  testLike("fobar", "foo%bar", false);
+  testLike("foobarx", "foo%bar", false);
+  testLike("abab", "ab%ab", true);
+  testLike("aba", "ab%ba", false);
+  testLike("abba", "ab%ba", true);
+  testLike("foo-x-bar", "foo%x%bar", true);
+  testLike("foo-bar", "foo%x%bar", false);
+  testLike("foox", "foo%x%bar", false);
+  testLike("foo-bar-", "foo%bar%", true);
+  testLike("xfoo-bar", "foo%bar%", false);
+  testLike("-foo-bar", "%foo%bar", true);
+  testLike("-foo-bar-", "%foo%bar", false);
+  testLike("foo\\bar#", "foo%\\%#", true);
+  testLike("\u00e9foo\u00e9bar", "\u00e9%\u00e9bar", true);
+}
+
+TEST_F(Re2FunctionsTest, likeAny) {
+  // Evaluates 'x LIKE p1 OR x LIKE p2 ...', which is rewritten to
+  // $internal$like_any, and compares with the same expression using an escape
+  // character, which is not rewritten.
+  const std::string alphabet = "abfhiorxz%_";
+  std::vector<std::optional<std::string>> strings;
+  for (auto row = 0; row < 1'000; ++row) {
+    if (row % 23 == 0) {
+      strings.push_back(std::nullopt);
+      continue;
+    }
+    std::string value;
+    for (auto i = 0; i < row % 13; ++i) {
+      value += alphabet[(row * 7 + i * i * 13 + i) % alphabet.size()];
+      if ((row + i) % 37 == 0) {
+        value += "\u00e9";
+      }
+    }
+    strings.push_back(value);
+  }
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(strings),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+  });
+
+  auto test = [&](const std::vector<std::string>& patterns,
+                  const std::string& other = "") {
+    std::vector<std::string> likes;
+    std::vector<std::string> escapedLikes;
+    for (const auto& pattern : patterns) {
+      likes.push_back(fmt::format("c0 like '{}'", pattern));
+      escapedLikes.push_back(fmt::format("like(c0, '{}', '!')", pattern));
+    }
+    if (!other.empty()) {
+      likes.push_back(other);
+      escapedLikes.push_back(other);
+    }
+    const auto expression = folly::join(" or ", likes);
+    SCOPED_TRACE(expression);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    const auto& root = exprSet->expr(0);
+    if (other.empty()) {
+      ASSERT_EQ(root->name(), "$internal$like_any");
+    } else {
+      ASSERT_EQ(root->name(), "or");
+      ASSERT_EQ(root->inputs()[0]->name(), "$internal$like_any");
+    }
+    auto result = evaluate(*exprSet, data);
+    auto expected =
+        evaluate<SimpleVector<bool>>(folly::join(" or ", escapedLikes), data);
+    assertEqualVectors(expected, result);
+  };
+
+  // All the patterns are substrings.
+  test({"%foo%", "%bar%"});
+  test({"%he%", "%she%", "%his%", "%hers%"});
+  test({"%abab%", "%ba%", "%b%bb%", "%zz%"});
+  test({"%\u00e9%", "%\u00e9a%", "%xo%"});
+  // Mixed kinds.
+  test({"%fo%", "ba%", "%z", "_x%", "%a%b%", "a%r", "___", "bi", "%"});
+  test({"%ob%", "%_%", "_\u00e9%", "%\u00e9__", "__"});
+  test({"%fo%", "%ro%", "a%b", "%x%"}, "c1 > 4");
+}
+
+TEST_F(Re2FunctionsTest, likeAnyNotRewritten) {
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto rootName = [&](const std::string& expression) {
+    return compileExpression(expression, rowType)->expr(0)->name();
+  };
+  // A single like.
+  ASSERT_EQ(rootName("c0 like '%a%' or c1 like '%b%'"), "or");
+  // An escape character.
+  ASSERT_EQ(rootName("like(c0, '%a%', '#') or c0 like '%b%'"), "or");
+  // A generic pattern.
+  ASSERT_EQ(rootName("c0 like '%a_b%' or c0 like 'a_b%'"), "or");
+  // A pattern that is not constant.
+  ASSERT_EQ(rootName("c0 like c1 or c0 like '%b%'"), "or");
+  // Nested disjunctions are flattened.
+  auto exprSet = compileExpression(
+      "c0 like '%a%' or (c1 like '%b%' or c0 like 'b%')", rowType);
+  const auto& root = exprSet->expr(0);
+  ASSERT_EQ(root->name(), "or");
+  ASSERT_EQ(root->inputs().size(), 2);
+  ASSERT_EQ(root->inputs()[0]->name(), "$internal$like_any");
+  ASSERT_EQ(root->inputs()[0]->inputs().size(), 3);
+}
+
+TEST_F(Re2FunctionsTest, regexpLikeAny) {
+  // Evaluates 'regexp_like(c0, p1) OR regexp_like(c0, p2) ...', which is
+  // rewritten to $internal$regexp_like_any, and compares with the same
+  // expression using re2_search, which is not rewritten.
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"foo",
+           std::nullopt,
+           "xbarx",
+           "",
+           "abc123",
+           "été",
+           "FOO",
+           "hello world",
+           "a.b"}),
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8}),
+  });
+
+  auto test = [&](const std::vector<std::string>& patterns,
+                  const std::string& other = "") {
+    std::vector<std::string> regexps;
+    std::vector<std::string> searches;
+    for (const auto& pattern : patterns) {
+      regexps.push_back(fmt::format("regexp_like(c0, '{}')", pattern));
+      searches.push_back(fmt::format("re2_search(c0, '{}')", pattern));
+    }
+    if (!other.empty()) {
+      regexps.push_back(other);
+      searches.push_back(other);
+    }
+    const auto expression = folly::join(" or ", regexps);
+    SCOPED_TRACE(expression);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    const auto& root = exprSet->expr(0);
+    if (other.empty()) {
+      ASSERT_EQ(root->name(), "$internal$regexp_like_any");
+    } else {
+      ASSERT_EQ(root->name(), "or");
+      ASSERT_EQ(root->inputs()[0]->name(), "$internal$regexp_like_any");
+    }
+    auto result = evaluate(*exprSet, data);
+    auto expected =
+        evaluate<SimpleVector<bool>>(folly::join(" or ", searches), data);
+    assertEqualVectors(expected, result);
+  };
+
+  test({"^foo$", "bar"});
+  test({"\\d+", "(?i)foo", "^$", "wor.d"});
+  test({"é", "^a\\.b$", "z"});
+  test({"^x", "o{2}"}, "c1 > 6");
+
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto rootName = [&](const std::string& expression) {
+    return compileExpression(expression, rowType)->expr(0)->name();
+  };
+  // Patterns on different inputs.
+  ASSERT_EQ(rootName("regexp_like(c0, 'a') or regexp_like(c1, 'b')"), "or");
+  // A pattern that is not constant.
+  ASSERT_EQ(rootName("regexp_like(c0, c1) or regexp_like(c0, 'b')"), "or");
+  // An invalid pattern keeps its error.
+  ASSERT_EQ(rootName("regexp_like(c0, '(a') or regexp_like(c0, 'b')"), "or");
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "regexp_like(c0, '(a') or regexp_like(c0, 'b') or "
+          "regexp_like(c0, 'c')",
+          data),
+      "invalid regular expression");
+}
+
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
   // Test null pattern.
   ASSERT_TRUE(
@@ -1586,5 +1762,31 @@ TEST_F(Re2FunctionsTest, parseSubstrings) {
   test("%aa%bb%%", {"aa", "bb"});
   test("%aa%bb%%%cc%", {"aa", "bb", "cc"});
 }
+
+TEST_F(Re2FunctionsTest, parseAnchoredSubstrings) {
+  auto test = [&](const std::string& input,
+                  const std::vector<std::string>& expected,
+                  bool anchoredStart,
+                  bool anchoredEnd) {
+    SCOPED_TRACE(input);
+    auto metadata = PatternMetadata::parseAnchoredSubstrings(input);
+    ASSERT_TRUE(metadata.has_value());
+    ASSERT_EQ(metadata->patternKind(), PatternKind::kSubstrings);
+    ASSERT_EQ(metadata->substrings(), expected);
+    ASSERT_EQ(metadata->anchoredStart(), anchoredStart);
+    ASSERT_EQ(metadata->anchoredEnd(), anchoredEnd);
+  };
+  test("aa%bb", {"aa", "bb"}, true, true);
+  test("aa%%bb%", {"aa", "bb"}, true, false);
+  test("%aa%bb%%cc", {"aa", "bb", "cc"}, false, true);
+  test("a#%b\\", {"a#", "b\\"}, true, true);
+
+  // Not supported.
+  for (const auto& pattern :
+       {"", "aa", "aa%", "%aa", "%aa%bb%", "aa_%bb", "aa%%", "%%"}) {
+    SCOPED_TRACE(pattern);
+    ASSERT_FALSE(PatternMetadata::parseAnchoredSubstrings(pattern).has_value());
+  }
+}
 } // namespace
 } // namespace facebook::velox::functions
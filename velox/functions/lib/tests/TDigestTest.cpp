@@ -106,6 +106,56 @@ TEST(TDigestTest, addElementsRandomized) {
   CHECK_QUANTILES(folly::Range(values, N), digest);
 }
 
+TEST(TDigestTest, addBatch) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  std::default_random_engine gen(common::testutil::getRandomSeed(42));
+  std::uniform_real_distribution<> dist;
+  for (auto& v : values) {
+    v = dist(gen);
+  }
+  std::vector<int16_t> positions;
+  TDigest<> digest;
+  digest.add(positions, 0.5);
+  for (int i = 0; i < N; i += 3000) {
+    digest.add(
+        positions, folly::Range(values.data() + i, std::min(3000, N - i)));
+  }
+  digest.compress(positions);
+  values.push_back(0.5);
+  std::sort(values.begin(), values.end());
+  CHECK_QUANTILES(values, digest);
+  ASSERT_EQ(digest.estimateQuantile(0), values.front());
+  ASSERT_EQ(digest.estimateQuantile(1), values.back());
+  const double nan = NAN;
+  ASSERT_THROW(
+      digest.add(positions, folly::Range(&nan, 1)), VeloxRuntimeError);
+}
+
+TEST(TDigestTest, estimateQuantiles) {
+  std::vector<int16_t> positions;
+  TDigest<> digest;
+  std::vector<double> quantiles(std::begin(kQuantiles), std::end(kQuantiles));
+  std::vector<double> results(quantiles.size());
+  digest.estimateQuantiles(quantiles, results.data());
+  for (auto result : results) {
+    ASSERT_TRUE(std::isnan(result));
+  }
+  for (int i = 0; i < 1e4; ++i) {
+    digest.add(positions, i % 7 == 0 ? i * 3 : i);
+  }
+  digest.compress(positions);
+  std::reverse(quantiles.begin(), quantiles.end());
+  quantiles.push_back(0);
+  quantiles.push_back(1);
+  quantiles.push_back(0.5);
+  results.resize(quantiles.size());
+  digest.estimateQuantiles(quantiles, results.data());
+  for (size_t i = 0; i < quantiles.size(); ++i) {
+    ASSERT_EQ(results[i], digest.estimateQuantile(quantiles[i]));
+  }
+}
+
 TEST(TDigestTest, fewElements) {
   TDigest digest;
   std::vector<int16_t> positions;
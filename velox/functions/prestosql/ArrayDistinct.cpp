@@ -23,6 +23,25 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Arrays of up to this many fixed width values are deduplicated by comparing
+// each value with the distinct values found so far. For small arrays this is
+// faster than hashing into a set and clearing it for every row.
+constexpr vector_size_t kMaxLinearDistinctSize = 16;
+
+template <typename T>
+constexpr bool kSupportsLinearDistinct =
+    (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_same_v<T, int128_t>;
+
+template <typename T>
+inline bool distinctValuesEqual(T left, T right) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return util::floating_point::NaNAwareEquals<T>()(left, right);
+  } else {
+    return left == right;
+  }
+}
+
 template <typename T>
 struct ValueSet {
   util::floating_point::HashSetNaNAware<T> values;
@@ -157,12 +176,48 @@ class ArrayDistinctFunction : public exec::VectorFunction {
     // Process the rows: store unique values in the hash table.
     ValueSetT uniqueSet;
 
+    constexpr bool kLinearDistinct =
+        kSupportsLinearDistinct<T> && !useCustomComparison;
+    const T* rawElements = nullptr;
+    if constexpr (kLinearDistinct) {
+      if (elements->isIdentityMapping()) {
+        rawElements = elements->data<T>();
+      }
+    }
+
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
       auto offset = arrayVector->offsetAt(row);
 
       rawNewOffsets[row] = indicesCursor;
       bool hasNulls = false;
+      if constexpr (kLinearDistinct) {
+        if (size <= kMaxLinearDistinctSize) {
+          T distinctValues[kMaxLinearDistinctSize];
+          vector_size_t numDistinct = 0;
+          for (vector_size_t i = offset; i < offset + size; ++i) {
+            if (elements->isNullAt(i)) {
+              if (!hasNulls) {
+                hasNulls = true;
+                rawNewIndices[indicesCursor++] = i;
+              }
+              continue;
+            }
+            const T value =
+                rawElements ? rawElements[i] : elements->valueAt<T>(i);
+            bool found = false;
+            for (vector_size_t j = 0; j < numDistinct; ++j) {
+              found |= distinctValuesEqual(distinctValues[j], value);
+            }
+            if (!found) {
+              distinctValues[numDistinct++] = value;
+              rawNewIndices[indicesCursor++] = i;
+            }
+          }
+          rawNewSizes[row] = indicesCursor - rawNewOffsets[row];
+          return;
+        }
+      }
       for (vector_size_t i = offset; i < offset + size; ++i) {
         if (elements->isNullAt(i)) {
           if (!hasNulls) {
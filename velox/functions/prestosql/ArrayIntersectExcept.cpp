@@ -22,32 +22,88 @@ namespace facebook::velox::functions {
 namespace {
 constexpr vector_size_t kInitialSetSize{128};
 
+// Sets of fixed width values keep up to this many values in an array that is
+// searched linearly. Most arrays are small and this avoids hashing and the
+// allocation and clearing of a hash table per row. The values move to the
+// hash set when there are more.
+constexpr vector_size_t kMaxSmallSetSize{16};
+
+template <typename T>
+constexpr bool kSupportsSmallSet =
+    (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_same_v<T, int128_t>;
+
 template <typename T>
 struct SetWithNull {
   SetWithNull(vector_size_t initialSetSize = kInitialSetSize) {
-    set.reserve(initialSetSize);
+    if constexpr (!kSupportsSmallSet<T>) {
+      set.reserve(initialSetSize);
+    }
   }
 
   bool insert(const DecodedVector* decodedElements, vector_size_t offset) {
-    return set.insert(decodedElements->valueAt<T>(offset)).second;
+    const auto value = decodedElements->valueAt<T>(offset);
+    if constexpr (kSupportsSmallSet<T>) {
+      if (!useSet) {
+        if (smallCount(value)) {
+          return false;
+        }
+        if (numSmallValues < kMaxSmallSetSize) {
+          smallValues[numSmallValues++] = value;
+          return true;
+        }
+        set.insert(smallValues, smallValues + numSmallValues);
+        useSet = true;
+      }
+    }
+    return set.insert(value).second;
   }
 
   size_t count(const DecodedVector* decodedElements, vector_size_t offset)
       const {
-    return set.count(decodedElements->valueAt<T>(offset));
+    const auto value = decodedElements->valueAt<T>(offset);
+    if constexpr (kSupportsSmallSet<T>) {
+      if (!useSet) {
+        return smallCount(value);
+      }
+    }
+    return set.count(value);
   }
 
   void reset() {
-    set.clear();
+    if (useSet) {
+      set.clear();
+      useSet = false;
+    }
+    numSmallValues = 0;
     hasNull = false;
   }
 
   bool empty() const {
-    return !hasNull && set.empty();
+    return !hasNull && numSmallValues == 0 && set.empty();
   }
 
   util::floating_point::HashSetNaNAware<T> set;
   bool hasNull{false};
+
+ private:
+  size_t smallCount(T value) const {
+    bool found = false;
+    for (vector_size_t i = 0; i < numSmallValues; ++i) {
+      if constexpr (std::is_floating_point_v<T>) {
+        found |= util::floating_point::NaNAwareEquals<T>()(
+            smallValues[i], value);
+      } else {
+        found |= smallValues[i] == value;
+      }
+    }
+    return found;
+  }
+
+  // Used instead of 'set' while 'useSet' is false.
+  T smallValues[kSupportsSmallSet<T> ? kMaxSmallSetSize : 1]{};
+  vector_size_t numSmallValues{0};
+  bool useSet{!kSupportsSmallSet<T>};
 };
 
 // This class is used as the entry in a set when the native type cannot be used
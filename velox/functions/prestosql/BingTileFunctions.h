@@ -189,6 +189,43 @@ struct BingTileChildrenFunction {
   }
 };
 
+template <typename T>
+struct BingTileAtFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE Status call(
+      out_type<BingTile>& result,
+      const arg_type<double>& latitude,
+      const arg_type<double>& longitude,
+      const arg_type<int8_t>& zoom) {
+    auto tile = BingTileType::bingTileAt(latitude, longitude, zoom);
+    if (FOLLY_UNLIKELY(tile.hasError())) {
+      return Status::UserError(tile.error());
+    }
+    result = tile.value();
+    return Status::OK();
+  }
+};
+
+template <typename T>
+struct BingTilesAroundFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE Status call(
+      out_type<Array<BingTile>>& result,
+      const arg_type<double>& latitude,
+      const arg_type<double>& longitude,
+      const arg_type<int8_t>& zoom) {
+    auto tiles = BingTileType::bingTilesAround(latitude, longitude, zoom);
+    if (FOLLY_UNLIKELY(tiles.hasError())) {
+      return Status::UserError(tiles.error());
+    }
+    result.reserve(tiles.value().size());
+    result.add_items(tiles.value());
+    return Status::OK();
+  }
+};
+
 template <typename T>
 struct BingTileToQuadKeyFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -234,6 +234,16 @@ struct YearFunction : public InitSessionTimezone<T>,
     result = getYear(getDateTime(timestamp, this->timeZone_));
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      int64_t* result,
+      int32_t size,
+      const arg_type<Timestamp>* timestamps) {
+    return this->callBatchInTimeZone(
+        result, size, timestamps, [&](const std::tm& dateTime) {
+          return getYear(dateTime);
+        });
+  }
+
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
     result = getYear(getDateTime(date));
   }
@@ -272,6 +282,16 @@ struct QuarterFunction : public InitSessionTimezone<T>,
     result = getQuarter(getDateTime(timestamp, this->timeZone_));
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      int64_t* result,
+      int32_t size,
+      const arg_type<Timestamp>* timestamps) {
+    return this->callBatchInTimeZone(
+        result, size, timestamps, [&](const std::tm& dateTime) {
+          return getQuarter(dateTime);
+        });
+  }
+
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
     result = getQuarter(getDateTime(date));
   }
@@ -299,6 +319,16 @@ struct MonthFunction : public InitSessionTimezone<T>,
     result = getMonth(getDateTime(timestamp, this->timeZone_));
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      int64_t* result,
+      int32_t size,
+      const arg_type<Timestamp>* timestamps) {
+    return this->callBatchInTimeZone(
+        result, size, timestamps, [&](const std::tm& dateTime) {
+          return getMonth(dateTime);
+        });
+  }
+
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
     result = getMonth(getDateTime(date));
   }
@@ -333,6 +363,16 @@ struct DayFunction : public InitSessionTimezone<T>,
     result = getDateTime(timestamp, this->timeZone_).tm_mday;
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      int64_t* result,
+      int32_t size,
+      const arg_type<Timestamp>* timestamps) {
+    return this->callBatchInTimeZone(
+        result, size, timestamps, [&](const std::tm& dateTime) {
+          return dateTime.tm_mday;
+        });
+  }
+
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
     result = getDateTime(date).tm_mday;
   }
@@ -754,6 +794,16 @@ struct HourFunction : public InitSessionTimezone<T>,
     result = getDateTime(timestamp, this->timeZone_).tm_hour;
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      int64_t* result,
+      int32_t size,
+      const arg_type<Timestamp>* timestamps) {
+    return this->callBatchInTimeZone(
+        result, size, timestamps, [&](const std::tm& dateTime) {
+          return dateTime.tm_hour;
+        });
+  }
+
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
     result = getDateTime(date).tm_hour;
   }
@@ -788,6 +838,16 @@ struct MinuteFunction : public InitSessionTimezone<T>,
     result = getDateTime(timestamp, this->timeZone_).tm_min;
   }
 
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      int64_t* result,
+      int32_t size,
+      const arg_type<Timestamp>* timestamps) {
+    return this->callBatchInTimeZone(
+        result, size, timestamps, [&](const std::tm& dateTime) {
+          return dateTime.tm_min;
+        });
+  }
+
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
     result = getDateTime(date).tm_min;
   }
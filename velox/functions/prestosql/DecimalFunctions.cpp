@@ -62,6 +62,11 @@ struct DecimalPlusFunction {
     DecimalUtil::valueInRange(out);
   }
 
+  template <typename R, typename A, typename B>
+  bool callBatch(R* out, int32_t size, const A* a, const B* b) {
+    return DecimalUtil::addBatch<false>(out, a, b, size, aRescale_, bRescale_);
+  }
+
  private:
   inline static uint8_t computeRescaleFactor(
       uint8_t fromScale,
@@ -111,6 +116,11 @@ struct DecimalMinusFunction {
     DecimalUtil::valueInRange(out);
   }
 
+  template <typename R, typename A, typename B>
+  bool callBatch(R* out, int32_t size, const A* a, const B* b) {
+    return DecimalUtil::addBatch<true>(out, a, b, size, aRescale_, bRescale_);
+  }
+
  private:
   inline static uint8_t computeRescaleFactor(
       uint8_t fromScale,
@@ -131,6 +141,11 @@ struct DecimalMultiplyFunction {
     out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
     DecimalUtil::valueInRange(out);
   }
+
+  template <typename R, typename A, typename B>
+  bool callBatch(R* out, int32_t size, const A* a, const B* b) {
+    return DecimalUtil::multiplyBatch(out, a, b, size);
+  }
 };
 
 template <typename TExec>
@@ -179,6 +179,145 @@ struct IPSubnetOfFunction {
   }
 };
 
+/// Index over a set of IP prefixes that finds the smallest prefix containing
+/// an IP address with a binary search. The address ranges of the prefixes are
+/// split into non-overlapping ranges that each map to the smallest prefix
+/// covering them. Building takes O(M log M) for M prefixes and a lookup takes
+/// O(log M) instead of M is_subnet_of checks.
+class IPPrefixIndex {
+ public:
+  using Prefix = std::tuple<int128_t, int8_t>;
+
+  /// 'prefixes' are canonical, i.e. the bits after the prefix length are 0.
+  explicit IPPrefixIndex(std::vector<Prefix> prefixes)
+      : prefixes_(std::move(prefixes)) {
+    struct Range {
+      uint128_t first;
+      uint128_t last;
+      int32_t prefix;
+    };
+    std::vector<Range> ranges;
+    ranges.reserve(prefixes_.size());
+    for (auto i = 0; i < prefixes_.size(); ++i) {
+      const auto& [ip, bits] = prefixes_[i];
+      ranges.push_back(
+          {static_cast<uint128_t>(ip),
+           static_cast<uint128_t>(getIPSubnetMax(ip, bits)),
+           i});
+    }
+    // A prefix comes after the prefixes that contain it. Two prefixes are
+    // either disjoint or one contains the other.
+    std::stable_sort(
+        ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+          return a.first < b.first || (a.first == b.first && a.last > b.last);
+        });
+
+    // The prefixes that contain the current position, innermost last.
+    std::vector<const Range*> enclosing;
+    auto popEnclosing = [&](uint128_t position, bool all) {
+      while (!enclosing.empty() &&
+             (all || enclosing.back()->last < position)) {
+        const auto last = enclosing.back()->last;
+        enclosing.pop_back();
+        if (last != std::numeric_limits<uint128_t>::max()) {
+          addStart(
+              last + 1,
+              enclosing.empty() ? kNoPrefix : enclosing.back()->prefix);
+        }
+      }
+    };
+    for (const auto& range : ranges) {
+      popEnclosing(range.first, false);
+      addStart(range.first, range.prefix);
+      enclosing.push_back(&range);
+    }
+    popEnclosing(0, true);
+  }
+
+  /// Returns the smallest prefix that contains 'ip' or std::nullopt if none
+  /// does.
+  std::optional<Prefix> find(int128_t ip) const {
+    const auto it = std::upper_bound(
+        starts_.begin(), starts_.end(), static_cast<uint128_t>(ip));
+    if (it == starts_.begin()) {
+      return std::nullopt;
+    }
+    const auto prefix = owners_[it - starts_.begin() - 1];
+    if (prefix == kNoPrefix) {
+      return std::nullopt;
+    }
+    return prefixes_[prefix];
+  }
+
+ private:
+  static constexpr int32_t kNoPrefix = -1;
+
+  // Starts a range at 'start' that maps to 'prefix'. A range that starts at
+  // the same address is replaced.
+  void addStart(uint128_t start, int32_t prefix) {
+    if (!starts_.empty() && starts_.back() == start) {
+      owners_.back() = prefix;
+    } else if (owners_.empty() || owners_.back() != prefix) {
+      starts_.push_back(start);
+      owners_.push_back(prefix);
+    }
+  }
+
+  const std::vector<Prefix> prefixes_;
+  // The first addresses of the ranges in ascending order. The addresses are
+  // compared as unsigned.
+  std::vector<uint128_t> starts_;
+  // The index in 'prefixes_' of the smallest prefix that contains each range
+  // or kNoPrefix.
+  std::vector<int32_t> owners_;
+};
+
+template <typename T>
+struct IPPrefixLookupFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Array<IPPrefix>>* ipPrefixes,
+      const arg_type<IPAddress>* /*ip*/) {
+    if (ipPrefixes != nullptr) {
+      index_.emplace(toPrefixes(*ipPrefixes));
+    }
+  }
+
+  FOLLY_ALWAYS_INLINE bool call(
+      out_type<IPPrefix>& result,
+      const arg_type<Array<IPPrefix>>& ipPrefixes,
+      const arg_type<IPAddress>& ip) {
+    // The index is built once for a constant array.
+    const auto prefix = index_.has_value()
+        ? index_->find(*ip)
+        : IPPrefixIndex(toPrefixes(ipPrefixes)).find(*ip);
+    if (!prefix.has_value()) {
+      return false;
+    }
+    result = prefix.value();
+    return true;
+  }
+
+ private:
+  static std::vector<IPPrefixIndex::Prefix> toPrefixes(
+      const arg_type<Array<IPPrefix>>& ipPrefixes) {
+    std::vector<IPPrefixIndex::Prefix> prefixes;
+    prefixes.reserve(ipPrefixes.size());
+    for (const auto& ipPrefix : ipPrefixes) {
+      if (ipPrefix.has_value()) {
+        prefixes.emplace_back(
+            *ipPrefix->template at<0>(), *ipPrefix->template at<1>());
+      }
+    }
+    return prefixes;
+  }
+
+  std::optional<IPPrefixIndex> index_;
+};
+
 template <typename T>
 struct IPPrefixCollapseFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -618,6 +757,11 @@ void registerIPAddressFunctions(const std::string& prefix) {
       {prefix + "is_subnet_of"});
   registerFunction<IPPrefixCollapseFunction, Array<IPPrefix>, Array<IPPrefix>>(
       {prefix + "ip_prefix_collapse"});
+  registerFunction<
+      IPPrefixLookupFunction,
+      IPPrefix,
+      Array<IPPrefix>,
+      IPAddress>({prefix + "ip_prefix_lookup"});
   registerFunction<IPPrefixSubnetsFunction, Array<IPPrefix>, IPPrefix, int64_t>(
       {prefix + "ip_prefix_subnets"});
   registerFunction<IsPrivateIPFunction, bool, IPAddress>(
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonExtractScalars.h"
+
+#include "velox/expression/EvalCtx.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
+#include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
+#include "velox/functions/prestosql/json/SIMDJsonMultiPathExtractor.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+const std::string kJsonExtractScalars = "$internal$json_extract_scalars";
+
+// Parses each document once and extracts all the paths in one pass. Where the
+// pass fails, e.g. on malformed JSON, extracts the paths one by one as
+// json_extract_scalar does, so that an error only nulls out the paths it
+// affects.
+class JsonExtractScalarsFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarsFunction(std::vector<std::string> paths)
+      : paths_(std::move(paths)) {
+    for (const auto& path : paths_) {
+      VELOX_USER_CHECK(
+          extractor_.addPath(path).has_value(),
+          "Unsupported JSON path for {}: {}",
+          kJsonExtractScalars,
+          path);
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    const auto numPaths = paths_.size();
+    VELOX_CHECK_EQ(outputType->size(), numPaths);
+
+    auto localResult = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(outputType, rows.end(), context.pool()));
+    std::vector<FlatVector<StringView>*> fields(numPaths);
+    for (auto i = 0; i < numPaths; ++i) {
+      fields[i] = localResult->childAt(i)->asFlatVector<StringView>();
+      bits::fillBits(
+          fields[i]->mutableRawNulls(), 0, rows.end(), bits::kNull);
+    }
+
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      const auto json = decoded->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      auto consumer = [&](const std::vector<int32_t>& paths, auto& value) {
+        std::optional<std::string> scalar;
+        SIMDJSON_TRY(extractJsonScalar(value, scalar));
+        if (scalar.has_value()) {
+          for (auto path : paths) {
+            fields[path]->set(row, StringView(*scalar));
+          }
+        }
+        return simdjson::SUCCESS;
+      };
+      if (extractor_.extract(paddedJson, consumer) != simdjson::SUCCESS) {
+        extractOneByOne(paddedJson, row, fields);
+      }
+    });
+
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  void extractOneByOne(
+      const simdjson::padded_string& json,
+      vector_size_t row,
+      const std::vector<FlatVector<StringView>*>& fields) const {
+    for (auto i = 0; i < paths_.size(); ++i) {
+      fields[i]->setNull(row, true);
+      std::optional<std::string> scalar;
+      auto consumer = [&](auto& value) {
+        return extractJsonScalar(value, scalar);
+      };
+      bool isDefinitePath = true;
+      const auto error = SIMDJsonExtractor::getInstance(paths_[i])
+                             .extract(json, consumer, isDefinitePath);
+      if (error == simdjson::SUCCESS && scalar.has_value()) {
+        fields[i]->set(row, StringView(*scalar));
+      }
+    }
+  }
+
+  const std::vector<std::string> paths_;
+  SIMDJsonMultiPathExtractor extractor_;
+};
+
+// The calls to json_extract_scalar on one input.
+struct CallGroup {
+  core::TypedExprPtr json;
+  // The distinct paths. 'calls[i]' are the calls with path 'paths[i]'.
+  std::vector<std::string> paths;
+  std::vector<std::vector<core::TypedExprPtr>> calls;
+};
+
+// Returns the value of 'expr' if it is a non-null VARCHAR constant.
+std::optional<std::string> constantPath(const core::TypedExprPtr& expr) {
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->isNull()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    return constant->valueVector()
+        ->as<ConstantVector<StringView>>()
+        ->valueAt(0)
+        .str();
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+void collectCalls(
+    const std::string& name,
+    const core::TypedExprPtr& expr,
+    std::vector<CallGroup>& groups) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return;
+  }
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == name && call->inputs().size() == 2) {
+    if (auto path = constantPath(call->inputs()[1])) {
+      const auto& json = call->inputs()[0];
+      auto group = std::find_if(
+          groups.begin(), groups.end(), [&](const auto& candidate) {
+            return *candidate.json == *json;
+          });
+      if (group == groups.end()) {
+        group = groups.insert(groups.end(), CallGroup{json, {}, {}});
+      }
+      auto it = std::find(group->paths.begin(), group->paths.end(), *path);
+      if (it == group->paths.end()) {
+        group->paths.push_back(*path);
+        group->calls.emplace_back();
+        it = group->paths.end() - 1;
+      }
+      group->calls[it - group->paths.begin()].push_back(expr);
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectCalls(name, input, groups);
+  }
+}
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractScalarsSignatures() {
+  // The row type of the result depends on the number of paths. It is not
+  // checked against the signature.
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  for (const auto& inputType : {"json", "varchar"}) {
+    signatures.push_back(exec::FunctionSignatureBuilder()
+                             .returnType("row(varchar)")
+                             .argumentType(inputType)
+                             .constantArgumentType("varchar")
+                             .constantVariableArity("varchar")
+                             .build());
+  }
+  return signatures;
+}
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalars(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_GE(inputArgs.size(), 2);
+  std::vector<std::string> paths;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto* constant = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constant != nullptr && !constant->isNullAt(0),
+        "{} requires constant non-null paths",
+        name);
+    paths.push_back(
+        constant->as<ConstantVector<StringView>>()->valueAt(0).str());
+  }
+  return std::make_shared<JsonExtractScalarsFunction>(std::move(paths));
+}
+
+exec::ExpressionReplacements rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<CallGroup> groups;
+  for (const auto& expr : exprs) {
+    collectCalls(prefix + "json_extract_scalar", expr, groups);
+  }
+
+  exec::ExpressionReplacements replacements;
+  for (const auto& group : groups) {
+    SIMDJsonMultiPathExtractor extractor;
+    std::vector<size_t> supported;
+    for (auto i = 0; i < group.paths.size(); ++i) {
+      if (extractor.addPath(group.paths[i]).has_value()) {
+        supported.push_back(i);
+      }
+    }
+    if (supported.size() < 2) {
+      continue;
+    }
+
+    std::vector<core::TypedExprPtr> args{group.json};
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i : supported) {
+      args.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), variant(group.paths[i])));
+      names.push_back(fmt::format("c{}", names.size()));
+      types.push_back(VARCHAR());
+    }
+    auto shared = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(names), std::move(types)),
+        std::move(args),
+        kJsonExtractScalars);
+    for (auto field = 0; field < supported.size(); ++field) {
+      auto replacement = std::make_shared<core::DereferenceTypedExpr>(
+          VARCHAR(), shared, field);
+      for (const auto& call : group.calls[supported[field]]) {
+        replacements.emplace_back(call, replacement);
+      }
+    }
+  }
+  return replacements;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// $internal$json_extract_scalars(json, path1, path2, ...) -> row(varchar, ...)
+///
+/// Returns a row with the results of json_extract_scalar(json, path1),
+/// json_extract_scalar(json, path2), etc. The paths are constant and
+/// supported by SIMDJsonMultiPathExtractor. Parses each document once for all
+/// the paths. Calls are produced by rewriteJsonExtractScalarCalls.
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractScalarsSignatures();
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalars(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+/// Finds the calls to '<prefix>json_extract_scalar' with a constant path in
+/// 'exprs', outside of lambda bodies. For each input with at least two
+/// distinct paths supported by $internal$json_extract_scalars, replaces the
+/// calls
+///     json_extract_scalar(json, path1), json_extract_scalar(json, path2), ...
+/// with the fields of one common subexpression
+///     $internal$json_extract_scalars(json, path1, path2, ...)
+/// so that each document is parsed once per ExprSet. Returns the replacements.
+exec::ExpressionReplacements rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
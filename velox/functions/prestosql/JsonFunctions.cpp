@@ -866,9 +866,10 @@ VELOX_DECLARE_VECTOR_FUNCTION(
     JsonFormatFunction::signatures(),
     std::make_unique<JsonFormatFunction>());
 
-VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION_WITH_METADATA(
     udf_json_extract,
     JsonExtractFunction::signatures(),
+    exec::VectorFunctionMetadataBuilder().cacheResultsByValue(true).build(),
     [](const std::string& /*name*/,
        const std::vector<exec::VectorFunctionArg>&,
        const velox::core::QueryConfig&) {
@@ -169,6 +169,36 @@ struct JsonArrayGetFunction {
   }
 };
 
+/// Sets 'result' to the value json_extract_scalar returns for JSON value 'v',
+/// which is a simdjson::ondemand::value or document. Leaves 'result' unchanged
+/// for objects, arrays and nulls. Does not iterate over objects and arrays.
+template <typename TValue>
+simdjson::error_code extractJsonScalar(
+    TValue& v,
+    std::optional<std::string>& result) {
+  SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+  switch (vtype) {
+    case simdjson::ondemand::json_type::boolean: {
+      SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+      result = vbool ? "true" : "false";
+      break;
+    }
+    case simdjson::ondemand::json_type::string: {
+      SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+      break;
+    }
+    case simdjson::ondemand::json_type::object:
+    case simdjson::ondemand::json_type::array:
+    case simdjson::ondemand::json_type::null:
+      // Do nothing.
+      break;
+    default: {
+      SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+    }
+  }
+  return simdjson::SUCCESS;
+}
+
 // json_extract_scalar(json, json_path) -> varchar
 // Like json_extract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -201,28 +231,7 @@ struct JsonExtractScalarFunction {
       }
 
       resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
+      return extractJsonScalar(v, resultStr);
     };
 
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/MapSubscripts.h"
+
+#include <folly/container/F14Map.h>
+#include <deque>
+
+#include "velox/expression/EvalCtx.h"
+#include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+const std::string kMapSubscripts = "$internal$map_subscripts";
+
+bool isSupportedKeyType(const TypePtr& type) {
+  if (type->providesCustomComparison()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Resolves all the keys with one pass over the entries of each map. The
+// value for each key is a dictionary over the map values, like the result of
+// subscript.
+template <typename TKey>
+class MapSubscriptsFunction : public exec::VectorFunction {
+ public:
+  // 'keys' are the constant key arguments. 'keys[i]' is the key of output
+  // field i. Duplicate keys share a field.
+  explicit MapSubscriptsFunction(const std::vector<VectorPtr>& keys) {
+    fieldKeys_.reserve(keys.size());
+    for (const auto& key : keys) {
+      TKey value = key->as<ConstantVector<TKey>>()->valueAt(0);
+      if constexpr (std::is_same_v<TKey, StringView>) {
+        if (!value.isInline()) {
+          strings_.emplace_back(value.data(), value.size());
+          value = StringView(strings_.back());
+        }
+      }
+      auto it = keyIndex_.emplace(value, keyIndex_.size()).first;
+      fieldKeys_.push_back(it->second);
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(outputType->size(), fieldKeys_.size());
+    auto* pool = context.pool();
+
+    exec::LocalDecodedVector decodedMap(context, *args[0], rows);
+    const auto* baseMap = decodedMap->base()->as<MapVector>();
+    const auto* rawOffsets = baseMap->rawOffsets();
+    const auto* rawSizes = baseMap->rawSizes();
+    const auto& mapValues = baseMap->mapValues();
+
+    const auto numKeys = keyIndex_.size();
+    std::vector<VectorPtr> values(numKeys);
+    if (mapValues->size() == 0) {
+      // Subscript into empty maps always returns NULLs.
+      for (auto& value : values) {
+        value = BaseVector::createNullConstant(
+            mapValues->type(), rows.end(), pool);
+      }
+    } else {
+      const auto keyRows = toElementRows(
+          baseMap->mapKeys()->size(),
+          rows,
+          baseMap,
+          decodedMap->nulls(&rows),
+          decodedMap->indices());
+      exec::LocalDecodedVector decodedKeys(
+          context, *baseMap->mapKeys(), keyRows);
+
+      std::vector<BufferPtr> indices(numKeys);
+      std::vector<BufferPtr> nulls(numKeys);
+      std::vector<vector_size_t*> rawIndices(numKeys);
+      std::vector<uint64_t*> rawNulls(numKeys);
+      for (auto i = 0; i < numKeys; ++i) {
+        indices[i] = allocateIndices(rows.end(), pool);
+        rawIndices[i] = indices[i]->asMutable<vector_size_t>();
+        nulls[i] = allocateNulls(rows.end(), pool, bits::kNull);
+        rawNulls[i] = nulls[i]->asMutable<uint64_t>();
+      }
+
+      rows.applyToSelected([&](vector_size_t row) {
+        const auto mapIndex = decodedMap->index(row);
+        const auto offset = rawOffsets[mapIndex];
+        const auto end = offset + rawSizes[mapIndex];
+        size_t numFound = 0;
+        for (auto i = offset; i < end && numFound < numKeys; ++i) {
+          auto it = keyIndex_.find(decodedKeys->valueAt<TKey>(i));
+          if (it != keyIndex_.end()) {
+            rawIndices[it->second][row] = i;
+            bits::clearNull(rawNulls[it->second], row);
+            ++numFound;
+          }
+        }
+      });
+
+      for (auto i = 0; i < numKeys; ++i) {
+        values[i] = BaseVector::wrapInDictionary(
+            std::move(nulls[i]),
+            std::move(indices[i]),
+            rows.end(),
+            mapValues,
+            true /*flattenIfRedundant*/);
+      }
+    }
+
+    std::vector<VectorPtr> fields;
+    fields.reserve(fieldKeys_.size());
+    for (auto key : fieldKeys_) {
+      fields.push_back(values[key]);
+    }
+    auto localResult = std::make_shared<RowVector>(
+        pool, outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  // Copies of the non-inline string keys. A deque keeps them in place.
+  std::deque<std::string> strings_;
+
+  // Distinct key -> its index in the per-key vectors built by apply().
+  folly::F14FastMap<TKey, size_t> keyIndex_;
+
+  // The index in 'keyIndex_' of the key of each output field.
+  std::vector<size_t> fieldKeys_;
+};
+
+// The calls to subscript functions on one map input.
+struct CallGroup {
+  core::TypedExprPtr map;
+  // The distinct keys. 'calls[i]' are the calls with key 'keys[i]'.
+  std::vector<core::TypedExprPtr> keys;
+  std::vector<std::vector<core::TypedExprPtr>> calls;
+};
+
+bool isConstantKey(const core::TypedExprPtr& expr) {
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  return constant != nullptr && !constant->isNull();
+}
+
+void collectCalls(
+    const std::vector<std::string>& names,
+    const core::TypedExprPtr& expr,
+    std::vector<CallGroup>& groups) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return;
+  }
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->inputs().size() == 2 &&
+      std::find(names.begin(), names.end(), call->name()) != names.end()) {
+    const auto& map = call->inputs()[0];
+    const auto& key = call->inputs()[1];
+    if (map->type()->isMap() &&
+        isSupportedKeyType(map->type()->childAt(0)) && isConstantKey(key)) {
+      auto group = std::find_if(
+          groups.begin(), groups.end(), [&](const auto& candidate) {
+            return *candidate.map == *map;
+          });
+      if (group == groups.end()) {
+        group = groups.insert(groups.end(), CallGroup{map, {}, {}});
+      }
+      auto it = std::find_if(
+          group->keys.begin(), group->keys.end(), [&](const auto& candidate) {
+            return *candidate == *key;
+          });
+      if (it == group->keys.end()) {
+        group->keys.push_back(key);
+        group->calls.emplace_back();
+        it = group->keys.end() - 1;
+      }
+      group->calls[it - group->keys.begin()].push_back(expr);
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectCalls(names, input, groups);
+  }
+}
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+mapSubscriptsSignatures() {
+  // The row type of the result depends on the number of keys. It is not
+  // checked against the signature.
+  return {exec::FunctionSignatureBuilder()
+              .typeVariable("K")
+              .typeVariable("V")
+              .returnType("row(V)")
+              .argumentType("map(K,V)")
+              .constantArgumentType("K")
+              .constantVariableArity("K")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeMapSubscripts(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_GE(inputArgs.size(), 2);
+  const auto& keyType = inputArgs[0].type->childAt(0);
+  VELOX_USER_CHECK(
+      isSupportedKeyType(keyType),
+      "Unsupported key type for {}: {}",
+      name,
+      keyType->toString());
+  std::vector<VectorPtr> keys;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& constant = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        constant != nullptr && !constant->isNullAt(0),
+        "{} requires constant non-null keys",
+        name);
+    keys.push_back(constant);
+  }
+  switch (keyType->kind()) {
+    case TypeKind::TINYINT:
+      return std::make_shared<MapSubscriptsFunction<int8_t>>(keys);
+    case TypeKind::SMALLINT:
+      return std::make_shared<MapSubscriptsFunction<int16_t>>(keys);
+    case TypeKind::INTEGER:
+      return std::make_shared<MapSubscriptsFunction<int32_t>>(keys);
+    case TypeKind::BIGINT:
+      return std::make_shared<MapSubscriptsFunction<int64_t>>(keys);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return std::make_shared<MapSubscriptsFunction<StringView>>(keys);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+exec::ExpressionReplacements rewriteMapSubscriptCalls(
+    const std::vector<std::string>& names,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<CallGroup> groups;
+  for (const auto& expr : exprs) {
+    collectCalls(names, expr, groups);
+  }
+
+  exec::ExpressionReplacements replacements;
+  for (const auto& group : groups) {
+    if (group.keys.size() < 2) {
+      continue;
+    }
+
+    const auto& valueType = group.map->type()->childAt(1);
+    std::vector<core::TypedExprPtr> args{group.map};
+    std::vector<std::string> fieldNames;
+    std::vector<TypePtr> types;
+    for (const auto& key : group.keys) {
+      args.push_back(key);
+      fieldNames.push_back(fmt::format("c{}", fieldNames.size()));
+      types.push_back(valueType);
+    }
+    auto shared = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(fieldNames), std::move(types)),
+        std::move(args),
+        kMapSubscripts);
+    for (auto field = 0; field < group.keys.size(); ++field) {
+      auto replacement = std::make_shared<core::DereferenceTypedExpr>(
+          valueType, shared, field);
+      for (const auto& call : group.calls[field]) {
+        replacements.emplace_back(call, replacement);
+      }
+    }
+  }
+  return replacements;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// $internal$map_subscripts(map, key1, key2, ...) -> row(V, V, ...)
+///
+/// Returns a row with the values of 'map' for key1, key2, etc., or null for
+/// the keys the map does not contain. The keys are distinct non-null
+/// constants of an integer or string type. Scans the entries of each map once
+/// for all the keys. Calls are produced by rewriteMapSubscriptCalls.
+std::vector<std::shared_ptr<exec::FunctionSignature>> mapSubscriptsSignatures();
+
+std::shared_ptr<exec::VectorFunction> makeMapSubscripts(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+/// Finds the calls to the functions in 'names' on a map with a constant key in
+/// 'exprs', outside of lambda bodies. The functions must return null for
+/// missing keys, like subscript and element_at on maps do. For each map input
+/// with at least two distinct keys, replaces the calls
+///     subscript(map, key1), element_at(map, key2), ...
+/// with the fields of one common subexpression
+///     $internal$map_subscripts(map, key1, key2, ...)
+/// so that each map is scanned once per ExprSet. Returns the replacements.
+exec::ExpressionReplacements rewriteMapSubscriptCalls(
+    const std::vector<std::string>& names,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
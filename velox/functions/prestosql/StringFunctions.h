@@ -261,8 +261,7 @@ struct TrimFunctionBase {
   FOLLY_ALWAYS_INLINE void callAscii(
       out_type<Varchar>& result,
       const arg_type<Varchar>& input) {
-    stringImpl::trimAscii<leftTrim, rightTrim>(
-        result, input, stringImpl::isAsciiWhiteSpace);
+    stringImpl::trimAsciiWhiteSpace<leftTrim, rightTrim>(result, input);
   }
 
   FOLLY_ALWAYS_INLINE void callAscii(
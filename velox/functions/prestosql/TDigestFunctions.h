@@ -50,11 +50,15 @@ struct ValuesAtQuantilesFunction {
     std::vector<int16_t> positions;
     digest.mergeDeserialized(positions, input.data());
     digest.compress(positions);
-    result.resize(quantiles.size());
+    std::vector<double> values(quantiles.size());
     for (size_t i = 0; i < quantiles.size(); ++i) {
-      double quantile = quantiles[i].value();
-      VELOX_USER_CHECK(0 <= quantile && quantile <= 1);
-      result[i] = digest.estimateQuantile(quantile);
+      values[i] = quantiles[i].value();
+      VELOX_USER_CHECK(0 <= values[i] && values[i] <= 1);
+    }
+    digest.estimateQuantiles(values, values.data());
+    result.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      result[i] = values[i];
     }
   }
 };
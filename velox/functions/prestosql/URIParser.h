@@ -16,6 +16,7 @@
 #pragma once
 
 #include <boost/regex.hpp>
+#include <cstring>
 #include "velox/functions/lib/Utf8Utils.h"
 #include "velox/type/StringView.h"
 
@@ -54,32 +55,41 @@ bool tryConsumeIPV6Address(const char* str, const size_t len, int32_t& pos);
 
 /// Find an extract the value for the parameter with key `param` from the query
 /// portion of a URI `query`. `query` should already be decoded if necessary.
+///
+/// The parameters are separated by '&'. A parameter is 'key=value' or 'key',
+/// where the value may contain '='. Parameters with an empty key are
+/// skipped. The delimiters are found with memchr, which scans many bytes at a
+/// time.
 template <typename TString>
 std::optional<StringView> extractParameter(
     const StringView& query,
     const TString& param) {
-  if (!query.empty()) {
-    // Parse query string.
-    static const boost::regex kQueryParamRegex(
-        "(^|&)" // start of query or start of parameter "&"
-        "([^=&]*)=?" // parameter name and "=" if value is expected
-        "([^&]*)" // parameter value (allows "=" to appear)
-        "(?=(&|$))" // forward reference, next should be end of query or
-                    // start of next parameter
-    );
-
-    const boost::cregex_iterator begin(
-        query.data(), query.data() + query.size(), kQueryParamRegex);
-    boost::cregex_iterator end;
-
-    for (auto it = begin; it != end; ++it) {
-      if (it->length(2) != 0 && (*it)[2].matched) { // key shouldnt be empty.
-        auto key = detail::submatch((*it), 2);
-        if (param.compare(key) == 0) {
-          return detail::submatch((*it), 3);
-        }
+  if (query.empty()) {
+    return std::nullopt;
+  }
+  const char* begin = query.data();
+  const char* const end = begin + query.size();
+  for (;;) {
+    const auto* next =
+        reinterpret_cast<const char*>(std::memchr(begin, '&', end - begin));
+    if (next == nullptr) {
+      next = end;
+    }
+    const auto* equals =
+        reinterpret_cast<const char*>(std::memchr(begin, '=', next - begin));
+    const auto* keyEnd = equals == nullptr ? next : equals;
+    // The key shouldn't be empty.
+    if (keyEnd != begin &&
+        param.compare(StringView(begin, keyEnd - begin)) == 0) {
+      if (equals == nullptr) {
+        return StringView();
       }
+      return StringView(equals + 1, next - equals - 1);
+    }
+    if (next == end) {
+      break;
     }
+    begin = next + 1;
   }
   return std::nullopt;
 }
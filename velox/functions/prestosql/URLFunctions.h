@@ -395,6 +395,10 @@ struct UrlExtractParameterFunction {
   // Results refer to strings in the first argument.
   static constexpr int32_t reuse_strings_from_arg = 0;
 
+  // A value that is not unescaped is referenced in the first argument instead
+  // of copied.
+  static constexpr bool reference_copied_strings = true;
+
   // Input is always ASCII, but result may or may not be ASCII.
 
   FOLLY_ALWAYS_INLINE bool call(
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/UrlExtractComponents.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/EvalCtx.h"
+#include "velox/functions/prestosql/URLFunctions.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+const std::string kUrlExtractComponents = "$internal$url_extract_components";
+
+enum class Component {
+  kProtocol,
+  kHost,
+  kPort,
+  kPath,
+  kQuery,
+  kFragment,
+  kParameter,
+};
+
+std::optional<Component> toComponent(std::string_view name) {
+  static const folly::F14FastMap<std::string_view, Component> kComponents = {
+      {"protocol", Component::kProtocol},
+      {"host", Component::kHost},
+      {"port", Component::kPort},
+      {"path", Component::kPath},
+      {"query", Component::kQuery},
+      {"fragment", Component::kFragment},
+      {"parameter", Component::kParameter},
+  };
+  auto it = kComponents.find(name);
+  if (it == kComponents.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+// A field of the result. 'parameter' is the name of the parameter of a
+// kParameter field.
+struct Field {
+  Component component;
+  std::string parameter;
+
+  bool operator==(const Field& other) const {
+    return component == other.component && parameter == other.parameter;
+  }
+};
+
+// Sets 'row' of 'field' to 'value', unescaped if 'hasEncoded'. Values that are
+// not unescaped refer to the strings of the input.
+void setString(
+    FlatVector<StringView>& field,
+    vector_size_t row,
+    StringView value,
+    bool hasEncoded) {
+  if (hasEncoded) {
+    std::string unescaped;
+    detail::urlUnescape(unescaped, value);
+    field.set(row, StringView(unescaped));
+  } else {
+    field.setNoCopy(row, value);
+  }
+}
+
+// Parses each URL once and sets the fields the url_extract_* functions return.
+// The components of a URL that parses are validated, so unescaping them does
+// not throw.
+class UrlExtractComponentsFunction : public exec::VectorFunction {
+ public:
+  explicit UrlExtractComponentsFunction(std::vector<Field> fields)
+      : fields_(std::move(fields)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    const auto numFields = fields_.size();
+    VELOX_CHECK_EQ(outputType->size(), numFields);
+
+    auto localResult = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(outputType, rows.end(), context.pool()));
+    for (auto& child : localResult->children()) {
+      bits::fillBits(child->mutableRawNulls(), 0, rows.end(), bits::kNull);
+    }
+
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      URI uri;
+      if (!parseUri(decoded->valueAt<StringView>(row), uri)) {
+        return;
+      }
+      for (auto i = 0; i < numFields; ++i) {
+        setField(fields_[i], uri, row, *localResult->childAt(i));
+      }
+    });
+
+    for (auto i = 0; i < numFields; ++i) {
+      if (fields_[i].component != Component::kPort) {
+        localResult->childAt(i)
+            ->asFlatVector<StringView>()
+            ->acquireSharedStringBuffers(args[0].get());
+      }
+    }
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  static void setField(
+      const Field& field,
+      const URI& uri,
+      vector_size_t row,
+      BaseVector& result) {
+    if (field.component == Component::kPort) {
+      if (!uri.port.empty()) {
+        try {
+          result.asFlatVector<int64_t>()->set(row, to<int64_t>(uri.port));
+        } catch (folly::ConversionError const&) {
+        }
+      }
+      return;
+    }
+
+    auto& strings = *result.asFlatVector<StringView>();
+    switch (field.component) {
+      case Component::kProtocol:
+        strings.setNoCopy(row, uri.scheme);
+        break;
+      case Component::kHost:
+        setString(strings, row, uri.host, uri.hostHasEncoded);
+        break;
+      case Component::kPath:
+        setString(strings, row, uri.path, uri.pathHasEncoded);
+        break;
+      case Component::kQuery:
+        setString(strings, row, uri.query, uri.queryHasEncoded);
+        break;
+      case Component::kFragment:
+        setString(strings, row, uri.fragment, uri.fragmentHasEncoded);
+        break;
+      case Component::kParameter: {
+        if (uri.query.empty()) {
+          break;
+        }
+        StringView query = uri.query;
+        std::string unescapedQuery;
+        if (uri.queryHasEncoded) {
+          detail::urlUnescape(unescapedQuery, uri.query);
+          query = StringView(unescapedQuery);
+        }
+        if (const auto value =
+                extractParameter(query, StringView(field.parameter))) {
+          // A value in 'unescapedQuery' is copied.
+          if (uri.queryHasEncoded) {
+            strings.set(row, value.value());
+          } else {
+            strings.setNoCopy(row, value.value());
+          }
+        }
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  const std::vector<Field> fields_;
+};
+
+// The calls to url_extract_* on one input.
+struct CallGroup {
+  core::TypedExprPtr url;
+  // The distinct fields. 'calls[i]' are the calls that return 'fields[i]'.
+  std::vector<Field> fields;
+  std::vector<std::vector<core::TypedExprPtr>> calls;
+};
+
+// Returns the value of 'expr' if it is a non-null VARCHAR constant.
+std::optional<std::string> constantString(const core::TypedExprPtr& expr) {
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->isNull()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    return constant->valueVector()
+        ->as<ConstantVector<StringView>>()
+        ->valueAt(0)
+        .str();
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Returns the field that 'call' to '<prefix>url_extract_*' returns.
+std::optional<Field> toField(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  const auto namePrefix = prefix + "url_extract_";
+  if (call.name().compare(0, namePrefix.size(), namePrefix) != 0) {
+    return std::nullopt;
+  }
+  const auto component =
+      toComponent(std::string_view(call.name()).substr(namePrefix.size()));
+  if (!component.has_value()) {
+    return std::nullopt;
+  }
+  if (component == Component::kParameter) {
+    if (call.inputs().size() != 2) {
+      return std::nullopt;
+    }
+    auto parameter = constantString(call.inputs()[1]);
+    if (!parameter.has_value()) {
+      return std::nullopt;
+    }
+    return Field{*component, std::move(*parameter)};
+  }
+  if (call.inputs().size() != 1) {
+    return std::nullopt;
+  }
+  return Field{*component, ""};
+}
+
+void collectCalls(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    std::vector<CallGroup>& groups) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return;
+  }
+  if (const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    if (auto field = toField(prefix, *call)) {
+      const auto& url = call->inputs()[0];
+      auto group = std::find_if(
+          groups.begin(), groups.end(), [&](const auto& candidate) {
+            return *candidate.url == *url;
+          });
+      if (group == groups.end()) {
+        group = groups.insert(groups.end(), CallGroup{url, {}, {}});
+      }
+      auto it = std::find(group->fields.begin(), group->fields.end(), *field);
+      if (it == group->fields.end()) {
+        group->fields.push_back(std::move(*field));
+        group->calls.emplace_back();
+        it = group->fields.end() - 1;
+      }
+      group->calls[it - group->fields.begin()].push_back(expr);
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectCalls(prefix, input, groups);
+  }
+}
+
+std::string componentName(Component component) {
+  switch (component) {
+    case Component::kProtocol:
+      return "protocol";
+    case Component::kHost:
+      return "host";
+    case Component::kPort:
+      return "port";
+    case Component::kPath:
+      return "path";
+    case Component::kQuery:
+      return "query";
+    case Component::kFragment:
+      return "fragment";
+    case Component::kParameter:
+      return "parameter";
+  }
+  VELOX_UNREACHABLE();
+}
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+urlExtractComponentsSignatures() {
+  // The row type of the result depends on the components. It is not checked
+  // against the signature.
+  return {exec::FunctionSignatureBuilder()
+              .returnType("row(varchar)")
+              .argumentType("varchar")
+              .constantArgumentType("varchar")
+              .constantVariableArity("varchar")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeUrlExtractComponents(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_GE(inputArgs.size(), 2);
+  auto constantArg = [&](size_t i) {
+    VELOX_USER_CHECK_LT(i, inputArgs.size(), "{} is missing arguments", name);
+    const auto* constant = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constant != nullptr && !constant->isNullAt(0),
+        "{} requires constant non-null components",
+        name);
+    return constant->as<ConstantVector<StringView>>()->valueAt(0).str();
+  };
+
+  std::vector<Field> fields;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto componentName = constantArg(i);
+    const auto component = toComponent(componentName);
+    VELOX_USER_CHECK(
+        component.has_value(),
+        "Unsupported URL component for {}: {}",
+        name,
+        componentName);
+    if (component == Component::kParameter) {
+      fields.push_back({*component, constantArg(++i)});
+    } else {
+      fields.push_back({*component, ""});
+    }
+  }
+  return std::make_shared<UrlExtractComponentsFunction>(std::move(fields));
+}
+
+exec::ExpressionReplacements rewriteUrlExtractCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<CallGroup> groups;
+  for (const auto& expr : exprs) {
+    collectCalls(prefix, expr, groups);
+  }
+
+  exec::ExpressionReplacements replacements;
+  for (const auto& group : groups) {
+    if (group.fields.size() < 2) {
+      continue;
+    }
+
+    std::vector<core::TypedExprPtr> args{group.url};
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (const auto& field : group.fields) {
+      args.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), variant(componentName(field.component))));
+      if (field.component == Component::kParameter) {
+        args.push_back(std::make_shared<core::ConstantTypedExpr>(
+            VARCHAR(), variant(field.parameter)));
+      }
+      names.push_back(fmt::format("c{}", names.size()));
+      types.push_back(
+          field.component == Component::kPort ? BIGINT() : VARCHAR());
+    }
+    auto shared = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(names), std::vector<TypePtr>(types)),
+        std::move(args),
+        kUrlExtractComponents);
+    for (auto i = 0; i < group.fields.size(); ++i) {
+      auto replacement =
+          std::make_shared<core::DereferenceTypedExpr>(types[i], shared, i);
+      for (const auto& call : group.calls[i]) {
+        replacements.emplace_back(call, replacement);
+      }
+    }
+  }
+  return replacements;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// $internal$url_extract_components(url, component1, component2, ...)
+///     -> row(...)
+///
+/// Returns a row with the results of url_extract_<component1>(url),
+/// url_extract_<component2>(url), etc. The components are constant
+/// 'protocol', 'host', 'port', 'path', 'query', 'fragment' or 'parameter'. A
+/// 'parameter' component is followed by the constant name of the parameter and
+/// gives the result of url_extract_parameter(url, name). The field for 'port'
+/// is a BIGINT and the others are VARCHAR. Parses each URL once for all the
+/// components. Calls are produced by rewriteUrlExtractCalls.
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+urlExtractComponentsSignatures();
+
+std::shared_ptr<exec::VectorFunction> makeUrlExtractComponents(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+/// Finds the calls to '<prefix>url_extract_<component>(url)' and
+/// '<prefix>url_extract_parameter(url, name)' with a constant name in 'exprs',
+/// outside of lambda bodies. For each input with at least two distinct calls,
+/// replaces the calls with the fields of one common subexpression
+///     $internal$url_extract_components(url, component1, component2, ...)
+/// so that each URL is parsed once per ExprSet. Returns the replacements.
+exec::ExpressionReplacements rewriteUrlExtractCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
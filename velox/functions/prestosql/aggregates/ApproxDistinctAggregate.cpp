@@ -95,6 +95,18 @@ struct HllAccumulator {
     }
   }
 
+  void append(folly::Range<const uint64_t*> hashes) {
+    if (isSparse_) {
+      hashes.advance(sparseHll_.insertHashes(hashes));
+      if (sparseHll_.overLimit()) {
+        toDense();
+      }
+    }
+    if (!hashes.empty()) {
+      denseHll_.insertHashes(hashes);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -295,18 +307,46 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
-        }
+      if constexpr (std::is_same_v<T, bool>) {
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
 
-        auto group = groups[row];
-        auto tracker = trackRowSize(group);
-        auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-        accumulator->append(decodedValue_.valueAt<T>(row));
-      });
+          auto group = groups[row];
+          auto tracker = trackRowSize(group);
+          auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
+          clearNull(group);
+          accumulator->setIndexBitLength(indexBitLength_);
+          accumulator->append(decodedValue_.valueAt<T>(row));
+        });
+      } else {
+        hashValues(rows);
+
+        // The hashes of consecutive rows of the same group are inserted in
+        // one batch.
+        char* runGroup = nullptr;
+        size_t runStart = 0;
+        size_t numHashes = 0;
+        auto flushRun = [&]() {
+          if (numHashes > runStart) {
+            auto tracker = trackRowSize(runGroup);
+            appendHashes(runGroup, runStart, numHashes);
+            runStart = numHashes;
+          }
+        };
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
+          if (groups[row] != runGroup) {
+            flushRun();
+            runGroup = groups[row];
+          }
+          ++numHashes;
+        });
+        flushRun();
+      }
     }
   }
 
@@ -341,17 +381,24 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
-        }
+      if constexpr (std::is_same_v<T, bool>) {
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
 
-        auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
+          auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
+          clearNull(group);
+          accumulator->setIndexBitLength(indexBitLength_);
 
-        accumulator->append(decodedValue_.valueAt<T>(row));
-      });
+          accumulator->append(decodedValue_.valueAt<T>(row));
+        });
+      } else {
+        const auto numHashes = hashValues(rows);
+        if (numHashes > 0) {
+          appendHashes(group, 0, numHashes);
+        }
+      }
     }
   }
 
@@ -389,6 +436,45 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   }
 
  private:
+  // Computes the hashes of the selected non-null values in 'decodedValue_'
+  // into 'hashes_' in row order. Returns the number of hashes. Hashing the
+  // whole batch before updating the HLLs keeps the hash loop free of the
+  // branches and memory accesses of the updates.
+  size_t hashValues(const SelectivityVector& rows) {
+    hashes_.resize(rows.countSelected());
+    if constexpr (
+        HllAsFinalResult &&
+        (std::is_same_v<T, int64_t> || std::is_same_v<T, double>)) {
+      if (decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+          rows.isAllSelected()) {
+        common::hll::Murmur3Hash128::hash64ForLong(
+            reinterpret_cast<const int64_t*>(decodedValue_.data<T>()),
+            rows.size(),
+            0,
+            hashes_.data());
+        return rows.size();
+      }
+    }
+
+    size_t numHashes = 0;
+    rows.applyToSelected([&](auto row) {
+      if (!decodedValue_.isNullAt(row)) {
+        hashes_[numHashes++] =
+            hashOne<T, HllAsFinalResult>(decodedValue_.valueAt<T>(row));
+      }
+    });
+    return numHashes;
+  }
+
+  // Inserts 'hashes_' from 'begin' to 'end' into the accumulator of 'group'.
+  void appendHashes(char* group, size_t begin, size_t end) {
+    auto accumulator = value<HllAccumulator<T, HllAsFinalResult>>(group);
+    clearNull(group);
+    accumulator->setIndexBitLength(indexBitLength_);
+    accumulator->append(
+        folly::Range<const uint64_t*>(hashes_.data() + begin, end - begin));
+  }
+
   void mergeToAccumulator(char* group, const vector_size_t row) {
     if constexpr (std::is_same_v<T, bool>) {
       static_assert(!HllAsFinalResult);
@@ -503,6 +589,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the non-null input values of the current batch.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -96,6 +96,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(
       T value,
       int64_t count,
@@ -410,21 +414,27 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight, allocator_, fixedRandomSeed_);
       });
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          auto accumulator = initRawAccumulator(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          auto accumulator = initRawAccumulator(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Consecutive rows of the same group are inserted in one batch.
+      char* runGroup = nullptr;
+      auto flushRun = [&]() {
+        if (!values_.empty()) {
+          auto tracker = trackRowSize(runGroup);
+          initRawAccumulator(runGroup)->append(
+              folly::Range<const T*>(values_.data(), values_.size()));
+          values_.clear();
+        }
+      };
+      rows.applyToSelected([&](auto row) {
+        if (decodedValue_.isNullAt(row)) {
+          return;
+        }
+        if (groups[row] != runGroup) {
+          flushRun();
+          runGroup = groups[row];
+        }
+        values_.push_back(decodedValue_.valueAt<T>(row));
+      });
+      flushRun();
     }
   }
 
@@ -457,20 +467,21 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight, allocator_, fixedRandomSeed_);
       });
+    } else if (
+        decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      const auto* rawValues = decodedValue_.data<T>();
+      accumulator->append(
+          folly::Range<const T*>(rawValues + rows.begin(), rows.size()));
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          values_.push_back(decodedValue_.valueAt<T>(row));
+        }
+      });
+      accumulator->append(
+          folly::Range<const T*>(values_.data(), values_.size()));
+      values_.clear();
     }
   }
 
@@ -696,6 +707,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Buffer of the values of one group to insert into its sketch at once.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -761,8 +774,13 @@ class ApproxPercentileAggregate : public exec::Aggregate {
 
     KllSketchAccumulator<T>* accumulator = nullptr;
     std::vector<KllView<T>> views;
+    // The views of each row and its group. The views of a group are merged in
+    // one mergeViews() call, which compacts the result once.
+    std::vector<std::pair<char*, KllView<T>>> groupViews;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      groupViews.reserve(rows.countSelected());
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -823,8 +841,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews.emplace_back(group[row], v);
       }
     });
     if constexpr (kSingleGroup) {
@@ -832,6 +849,27 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         auto tracker = trackRowSize(group);
         accumulator->append(views);
       }
+    } else {
+      std::stable_sort(
+          groupViews.begin(),
+          groupViews.end(),
+          [](const auto& x, const auto& y) {
+            return std::less<char*>()(x.first, y.first);
+          });
+      for (size_t i = 0; i < groupViews.size();) {
+        char* runGroup = groupViews[i].first;
+        views.clear();
+        for (; i < groupViews.size() && groupViews[i].first == runGroup; ++i) {
+          views.push_back(groupViews[i].second);
+        }
+        auto tracker = trackRowSize(runGroup);
+        auto* runAccumulator = value<KllSketchAccumulator<T>>(runGroup);
+        if (views.size() == 1) {
+          runAccumulator->append(views[0]);
+        } else {
+          runAccumulator->append(views);
+        }
+      }
     }
   }
 };
@@ -170,9 +170,7 @@ class ArrayAggAggregate : public exec::Aggregate {
         if (arraySize) {
           clearNull(rawNulls, i);
           ValueListReader reader(values);
-          for (auto index = 0; index < arraySize; ++index) {
-            reader.next(*elements, arrayOffset + index);
-          }
+          reader.readAll(*elements, arrayOffset);
           resultOffsets[i] = arrayOffset;
           resultSizes[i] = arraySize;
           arrayOffset += arraySize;
@@ -328,6 +326,19 @@ class ArrayAggAggregate : public exec::Aggregate {
     }
   }
 
+  void relocateAccumulators(
+      folly::Range<char**> groups,
+      HashStringAllocator::Relocator& relocator) override {
+    if (clusteredInput_) {
+      return;
+    }
+    for (auto group : groups) {
+      if (isInitialized(group)) {
+        value<ArrayAccumulator>(group)->elements.relocate(relocator);
+      }
+    }
+  }
+
   void destroyInternal(folly::Range<char**> groups) override {
     for (auto group : groups) {
       if (isInitialized(group)) {
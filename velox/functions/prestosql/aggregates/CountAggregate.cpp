@@ -86,29 +86,73 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
+    addToGroup(group, countNonNull(rows, args));
+  }
+
+  bool supportsDenseInput() const override {
+    return true;
+  }
+
+  void initializeDenseAccumulators(char* accumulators, int32_t numGroups)
+      override {
+    std::fill_n(reinterpret_cast<int64_t*>(accumulators), numGroups, 0);
+  }
+
+  void addRawDenseInput(
+      const uint64_t* groupIndices,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      char* accumulators,
+      uint64_t* nonNullGroups) override {
+    auto* counts = reinterpret_cast<int64_t*>(accumulators);
+    const auto addRow = [&](vector_size_t i) {
+      const auto group = groupIndices[i];
+      ++counts[group];
+      bits::setBit(nonNullGroups, group);
+    };
     if (args.empty()) {
-      addToGroup(group, rows.countSelected());
+      rows.applyToSelected(addRow);
       return;
     }
 
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
-        addToGroup(group, rows.countSelected());
+        rows.applyToSelected(addRow);
       }
     } else if (decoded.mayHaveNulls()) {
-      int64_t nonNullCount = 0;
       rows.applyToSelected([&](vector_size_t i) {
         if (!decoded.isNullAt(i)) {
-          ++nonNullCount;
+          addRow(i);
         }
       });
-      addToGroup(group, nonNullCount);
     } else {
-      addToGroup(group, rows.countSelected());
+      rows.applyToSelected(addRow);
     }
   }
 
+  void addDenseAccumulators(
+      char** groups,
+      int32_t numGroups,
+      const char* accumulators,
+      const uint64_t* nonNullGroups) override {
+    const auto* counts = reinterpret_cast<const int64_t*>(accumulators);
+    bits::forEachSetBit(nonNullGroups, 0, numGroups, [&](int32_t group) {
+      addToGroup(groups[group], counts[group]);
+    });
+  }
+
+  bool supportsRemoveRawInput() const override {
+    return true;
+  }
+
+  void removeSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    addToGroup(group, -countNonNull(rows, args));
+  }
+
   void addSingleGroupIntermediateResults(
       char* group,
       const SelectivityVector& rows,
@@ -147,6 +191,30 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     *value<int64_t>(group) += count;
   }
 
+  // Returns the number of 'rows' with a non-null argument.
+  static int64_t countNonNull(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (args.empty()) {
+      return rows.countSelected();
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      return decoded.isNullAt(0) ? 0 : rows.countSelected();
+    }
+    if (!decoded.mayHaveNulls()) {
+      return rows.countSelected();
+    }
+    int64_t nonNullCount = 0;
+    rows.applyToSelected([&](vector_size_t i) {
+      if (!decoded.isNullAt(i)) {
+        ++nonNullCount;
+      }
+    });
+    return nonNullCount;
+  }
+
   DecodedVector decodedIntermediate_;
 };
 
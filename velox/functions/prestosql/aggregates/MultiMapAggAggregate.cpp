@@ -121,9 +121,8 @@ struct MultiMapAccumulator {
       mapValueArrays.setOffsetAndSize(keyOffset, valueOffset, numValues);
 
       aggregate::ValueListReader reader(entry.second);
-      for (auto i = 0; i < numValues; i++) {
-        reader.next(*mapValues, valueOffset++);
-      }
+      reader.readAll(*mapValues, valueOffset);
+      valueOffset += numValues;
 
       ++keyOffset;
     }
@@ -215,9 +214,8 @@ struct ComplexTypeMultiMapAccumulator {
       mapValueArrays.setOffsetAndSize(keyOffset, valueOffset, numValues);
 
       aggregate::ValueListReader reader(entry.second);
-      for (auto i = 0; i < numValues; i++) {
-        reader.next(*mapValues, valueOffset++);
-      }
+      reader.readAll(*mapValues, valueOffset);
+      valueOffset += numValues;
 
       ++keyOffset;
     }
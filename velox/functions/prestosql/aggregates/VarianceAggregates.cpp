@@ -58,6 +58,20 @@ struct VarianceAccumulator {
     m2_ += delta * (value - mean());
   }
 
+  // Reverses update() for a value that was added before.
+  void remove(double value) {
+    if (count_ == 1) {
+      count_ = 0;
+      mean_ = 0;
+      m2_ = 0;
+      return;
+    }
+    count_ -= 1;
+    const double delta = value - mean();
+    mean_ -= delta / count();
+    m2_ = std::max(0.0, m2_ - delta * (value - mean()));
+  }
+
   inline void merge(const VarianceAccumulator& other) {
     merge(other.count(), other.mean(), other.m2());
   }
@@ -242,6 +256,23 @@ class VarianceAggregate : public exec::Aggregate {
     }
   }
 
+  bool supportsRemoveRawInput() const override {
+    return true;
+  }
+
+  void removeSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    decodedRaw_.decode(*args[0], rows);
+    VarianceAccumulator* accData = accumulator(group);
+    rows.applyToSelected([&](vector_size_t i) {
+      if (!decodedRaw_.isNullAt(i)) {
+        accData->remove(static_cast<double>(decodedRaw_.valueAt<T>(i)));
+      }
+    });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -266,6 +266,29 @@ AGG_BENCHMARKS(stddev, k_norm)
 AGG_BENCHMARKS(stddev, k_hash)
 BENCHMARK_DRAW_LINE();
 
+// Approx percentile aggregate. k_hash has many groups with few values each.
+BENCHMARK_NAMED_PARAM(
+    doRun,
+    approx_percentile_DOUBLE_k_array,
+    "k_array",
+    "approx_percentile(f64, 0.5)");
+BENCHMARK_NAMED_PARAM(
+    doRun,
+    approx_percentile_DOUBLE_k_norm,
+    "k_norm",
+    "approx_percentile(f64, 0.5)");
+BENCHMARK_NAMED_PARAM(
+    doRun,
+    approx_percentile_DOUBLE_k_hash,
+    "k_hash",
+    "approx_percentile(f64, 0.5)");
+BENCHMARK_NAMED_PARAM(
+    doRun,
+    approx_percentile_BIGINT_NULLS_k_hash,
+    "k_hash",
+    "approx_percentile(i64_halfnull, 0.5)");
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 
 int main(int argc, char** argv) {
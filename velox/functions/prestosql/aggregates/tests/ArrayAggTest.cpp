@@ -282,6 +282,34 @@ TEST_F(ArrayAggTest, sortedGroupBy) {
   testFunction("simple_array_agg");
 }
 
+TEST_F(ArrayAggTest, sortedGroupByManyRows) {
+  // Many small groups and one group that spans several batches of sorted
+  // rows.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          30'000, [](auto row) { return row % 2 == 0 ? 0 : row % 5'000; }),
+      makeFlatVector<int64_t>(30'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(30'000, [](auto row) { return row % 17; }),
+  });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .project({"c0", "c1", "c2", "c1 % 3 = 0 as m"})
+                  .singleAggregation(
+                      {"c0"},
+                      {"array_agg(c1 ORDER BY c2 DESC, c1)",
+                       "array_agg(c1 ORDER BY c2, c1)"},
+                      {"", "m"})
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT c0, array_agg(c1 ORDER BY c2 DESC, c1), "
+          "array_agg(c1 ORDER BY c2, c1) FILTER (WHERE c1 % 3 = 0) "
+          "FROM tmp GROUP BY 1");
+}
+
 TEST_F(ArrayAggTest, global) {
   auto testFunction = [this](
                           const std::string& functionName,
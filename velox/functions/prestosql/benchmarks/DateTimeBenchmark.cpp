@@ -15,6 +15,7 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include <deque>
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -110,6 +111,61 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Evaluates 'functionName' in a session time zone with DST over timestamps
+  // of one year, which is converted a batch at a time.
+  void runInTimeZone(const std::string& functionName) {
+    folly::BenchmarkSuspender suspender;
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kSessionTimezone, "America/Los_Angeles"},
+        {core::QueryConfig::kAdjustTimestampToTimezone, "true"},
+    });
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<Timestamp>(
+        10'000,
+        [](auto row) { return Timestamp(1704067200 + row * 3'153, 0); })});
+    auto exprSet =
+        compileExpression(fmt::format("{}(c0)", functionName), data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
+  // Formats timestamps of a few decades with the Joda 'format'.
+  void runFormat(const std::string& format) {
+    folly::BenchmarkSuspender suspender;
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<Timestamp>(
+        10'000, [](auto row) {
+          return Timestamp(row * 190'123, (row % 1'000) * 1'000'000);
+        })});
+    auto exprSet = compileExpression(
+        fmt::format("format_datetime(c0, '{}')", format), data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
+  // Parses strings like '2024-03-15 07:08:09.123' with the Joda 'format'.
+  void runParse(const std::string& format) {
+    folly::BenchmarkSuspender suspender;
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<StringView>(
+        10'000, [&](auto row) {
+          strings_.push_back(fmt::format(
+              "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}",
+              1970 + row % 60,
+              1 + row % 12,
+              1 + row % 28,
+              row % 24,
+              row % 60,
+              (row * 7) % 60,
+              row % 1'000));
+          return StringView(strings_.back());
+        })});
+    auto exprSet = compileExpression(
+        fmt::format("parse_datetime(c0, '{}')", format), data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void runDateTrunc(const std::string& unit) {
     folly::BenchmarkSuspender suspender;
     VectorFuzzer::Options opts;
@@ -130,6 +186,9 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     }
     folly::doNotOptimizeAway(cnt);
   }
+
+ private:
+  std::deque<std::string> strings_;
 };
 
 BENCHMARK(truncYear) {
@@ -196,6 +255,50 @@ BENCHMARK(second) {
   DateTimeBenchmark benchmark;
   benchmark.run("second");
 }
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(yearInTimeZone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("year");
+}
+
+BENCHMARK(dayInTimeZone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("day");
+}
+
+BENCHMARK(hourInTimeZone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("hour");
+}
+
+BENCHMARK_RELATIVE(hour_vectorInTimeZone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("hour_vector");
+}
+BENCHMARK_DRAW_LINE();
+
+// A format with 'H' is interpreted token by token. The same format with 'HH'
+// has a fixed layout.
+BENCHMARK(formatDateTime) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("yyyy-MM-dd H:mm:ss.SSS");
+}
+
+BENCHMARK_RELATIVE(formatDateTimeFixedLayout) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("yyyy-MM-dd HH:mm:ss.SSS");
+}
+
+BENCHMARK(parseDateTime) {
+  DateTimeBenchmark benchmark;
+  benchmark.runParse("yyyy-MM-dd H:mm:ss.SSS");
+}
+
+BENCHMARK_RELATIVE(parseDateTimeFixedLayout) {
+  DateTimeBenchmark benchmark;
+  benchmark.runParse("yyyy-MM-dd HH:mm:ss.SSS");
+}
 } // namespace
 
 int main(int argc, char** argv) {
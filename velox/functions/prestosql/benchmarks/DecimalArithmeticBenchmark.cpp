@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Compares arithmetic and sum() over short and long decimals with the same
+// values. Flat inputs without nulls are computed as batches.
+
+namespace facebook::velox::functions::prestosql {
+namespace {
+
+constexpr vector_size_t kVectorSize = 10'000;
+constexpr int32_t kNumVectors = 100;
+
+class DecimalArithmeticBenchmark
+    : public functions::test::FunctionBenchmarkBase {
+ public:
+  DecimalArithmeticBenchmark() {
+    registerArithmeticFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    shortData_ = makeData<int64_t>(DECIMAL(9, 2));
+    longData_ = makeData<int128_t>(DECIMAL(38, 2));
+  }
+
+  size_t run(const std::string& expression, bool isLong) {
+    folly::BenchmarkSuspender suspender;
+    const auto& data = isLong ? longData_ : shortData_;
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < kNumVectors; ++i) {
+      count += evaluate(exprSet, data)->size();
+    }
+    return count;
+  }
+
+  size_t runSum(bool isLong) {
+    folly::BenchmarkSuspender suspender;
+    const auto& data = isLong ? longData_ : shortData_;
+    auto plan = exec::test::PlanBuilder()
+                    .values(std::vector<RowVectorPtr>(kNumVectors, data))
+                    .singleAggregation({}, {"sum(c0)", "sum(c1)"})
+                    .planNode();
+    suspender.dismiss();
+
+    return exec::test::AssertQueryBuilder(plan).copyResults(pool())->size();
+  }
+
+ private:
+  template <typename T>
+  RowVectorPtr makeData(const TypePtr& type) {
+    return vectorMaker_.rowVector({
+        vectorMaker_.flatVector<T>(
+            kVectorSize,
+            [](auto row) { return T(row) * 1'234 - 5'000'000; },
+            nullptr,
+            type),
+        vectorMaker_.flatVector<T>(
+            kVectorSize,
+            [](auto row) { return T(row % 1'000) * 7 + 1; },
+            nullptr,
+            type),
+    });
+  }
+
+  RowVectorPtr shortData_;
+  RowVectorPtr longData_;
+};
+
+std::unique_ptr<DecimalArithmeticBenchmark> benchmark;
+
+#define DECIMAL_BENCHMARKS(_name_, _expression_)                   \
+  BENCHMARK(_name_##Short) {                                       \
+    folly::doNotOptimizeAway(benchmark->run(_expression_, false)); \
+  }                                                                \
+  BENCHMARK_RELATIVE(_name_##Long) {                               \
+    folly::doNotOptimizeAway(benchmark->run(_expression_, true));  \
+  }                                                                \
+  BENCHMARK_DRAW_LINE();
+
+DECIMAL_BENCHMARKS(plus, "c0 + c1")
+DECIMAL_BENCHMARKS(minus, "c0 - c1")
+DECIMAL_BENCHMARKS(multiply, "c0 * c1")
+
+BENCHMARK(sumShort) {
+  folly::doNotOptimizeAway(benchmark->runSum(false));
+}
+
+BENCHMARK_RELATIVE(sumLong) {
+  folly::doNotOptimizeAway(benchmark->runSum(true));
+}
+
+} // namespace
+} // namespace facebook::velox::functions::prestosql
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize({});
+  facebook::velox::functions::prestosql::benchmark = std::make_unique<
+      facebook::velox::functions::prestosql::DecimalArithmeticBenchmark>();
+  folly::runBenchmarks();
+  facebook::velox::functions::prestosql::benchmark.reset();
+  return 0;
+}
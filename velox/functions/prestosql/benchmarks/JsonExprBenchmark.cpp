@@ -18,9 +18,11 @@
  * expression framework and Velox vectors.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/JsonExtractScalars.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/JsonExtractor.h"
 #include "velox/functions/prestosql/types/JsonRegistration.h"
@@ -198,6 +200,16 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
         {"folly_json_extract_scalar"});
     registerFunction<JsonExtractScalarFunction, Varchar, Json, Varchar>(
         {"json_extract_scalar"});
+    // Not rewritten to share the parsing with other calls.
+    registerFunction<JsonExtractScalarFunction, Varchar, Json, Varchar>(
+        {"single_json_extract_scalar"});
+    exec::registerStatefulVectorFunction(
+        "$internal$json_extract_scalars",
+        jsonExtractScalarsSignatures(),
+        makeJsonExtractScalars);
+    exec::registerExpressionSetRewrite([](const auto& exprs) {
+      return rewriteJsonExtractScalarCalls("", exprs);
+    });
     registerFunction<FollyJsonExtractFunction, Varchar, Json, Varchar>(
         {"folly_json_extract"});
     registerFunction<JsonSizeFunction, int64_t, Json, Varchar>({"json_size"});
@@ -259,6 +271,29 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Evaluates concat() of the calls to 'fnName' with each of 'paths'.
+  void runWithJsonExtractScalars(
+      int iter,
+      int vectorSize,
+      const std::string& fnName,
+      const std::string& json,
+      const std::vector<std::string>& paths) {
+    folly::BenchmarkSuspender suspender;
+
+    auto jsonVector = makeJsonData(json, vectorSize);
+
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+    std::vector<std::string> calls;
+    for (const auto& path : paths) {
+      calls.push_back(fmt::format("{}(c0, '{}')", fnName, path));
+    }
+    auto exprSet = compileExpression(
+        fmt::format("concat({})", folly::join(", ", calls)),
+        rowVector->type());
+    suspender.dismiss();
+    doRun(iter, exprSet, rowVector);
+  }
+
   void runWithJsonContains(
       int iter,
       int vectorSize,
@@ -355,6 +390,32 @@ void SIMDJsonExtractScalar(int iter, int vectorSize, int jsonSize) {
       iter, vectorSize, "json_extract_scalar", json, "$.key[7].k1");
 }
 
+const std::vector<std::string> kScalarPaths = {
+    "$.key[0].k1",
+    "$.key[2].k1",
+    "$.key[7].k1",
+    "$.key[20].k1",
+    "$.key[90].k1",
+};
+
+void SIMDJsonExtractScalarsSingle(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractScalars(
+      iter, vectorSize, "single_json_extract_scalar", json, kScalarPaths);
+}
+
+void SIMDJsonExtractScalarsShared(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractScalars(
+      iter, vectorSize, "json_extract_scalar", json, kScalarPaths);
+}
+
 void FollyJsonExtract(int iter, int vectorSize, int jsonSize) {
   folly::BenchmarkSuspender suspender;
   JsonBenchmark benchmark;
@@ -555,6 +616,43 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarsSingle,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarsShared,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarsSingle,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarsShared,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarsSingle,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarsShared,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(FollyJsonExtract, 100_iters_10bytes_size, 100, 10);
 BENCHMARK_RELATIVE_NAMED_PARAM(
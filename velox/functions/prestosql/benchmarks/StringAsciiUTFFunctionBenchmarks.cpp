@@ -35,7 +35,10 @@ class StringAsciiUTFFunctionBenchmark
     functions::prestosql::registerStringFunctions();
   }
 
-  void runUpperLower(const std::string& fnName, bool utf) {
+  void runUpperLower(
+      const std::string& fnName,
+      bool utf,
+      size_t stringLength = 100) {
     folly::BenchmarkSuspender suspender;
 
     VectorFuzzer::Options opts;
@@ -44,7 +47,7 @@ class StringAsciiUTFFunctionBenchmark
       opts.charEncodings = {UTF8CharList::UNICODE_CASE_SENSITIVE};
     }
 
-    opts.stringLength = 100;
+    opts.stringLength = stringLength;
     opts.vectorSize = 100'000;
     VectorFuzzer fuzzer(opts, execCtx_.pool());
     auto vector = fuzzer.fuzzFlat(VARCHAR());
@@ -86,6 +89,59 @@ class StringAsciiUTFFunctionBenchmark
     doRun(exprSet, rowVector);
   }
 
+  void runLength(bool utf) {
+    folly::BenchmarkSuspender suspender;
+
+    VectorFuzzer::Options opts;
+    if (utf) {
+      opts.charEncodings.clear();
+      opts.charEncodings = {
+          UTF8CharList::UNICODE_CASE_SENSITIVE,
+          UTF8CharList::EXTENDED_UNICODE,
+          UTF8CharList::MATHEMATICAL_SYMBOLS};
+    }
+
+    opts.stringLength = 100;
+    opts.vectorSize = 100'000;
+    VectorFuzzer fuzzer(opts, execCtx_.pool());
+    auto vector = fuzzer.fuzzFlat(VARCHAR());
+
+    auto rowVector = vectorMaker_.rowVector({vector});
+    auto exprSet = compileExpression("length(c0)", rowVector->type());
+
+    suspender.dismiss();
+    doRun(exprSet, rowVector);
+  }
+
+  // Trims strings with 'numSpaces' spaces on each side, such as fixed width
+  // fields padded with spaces.
+  void runTrim(const std::string& fnName, bool utf, int32_t numSpaces) {
+    folly::BenchmarkSuspender suspender;
+
+    VectorFuzzer::Options opts;
+    if (utf) {
+      opts.charEncodings.clear();
+      opts.charEncodings = {UTF8CharList::UNICODE_CASE_SENSITIVE};
+    }
+
+    opts.stringLength = 20;
+    opts.vectorSize = 100'000;
+    VectorFuzzer fuzzer(opts, execCtx_.pool());
+    auto strings = fuzzer.fuzzFlat(VARCHAR())->asFlatVector<StringView>();
+    const std::string spaces(numSpaces, ' ');
+    auto vector = vectorMaker_.flatVector<std::string>(
+        opts.vectorSize, [&](auto row) {
+          return spaces + std::string(strings->valueAt(row)) + spaces;
+        });
+
+    auto rowVector = vectorMaker_.rowVector({vector});
+    auto exprSet =
+        compileExpression(fmt::format("{}(c0)", fnName), rowVector->type());
+
+    suspender.dismiss();
+    doRun(exprSet, rowVector);
+  }
+
   void runLPadRPad(const std::string& fnName, bool utf) {
     folly::BenchmarkSuspender suspender;
 
@@ -146,6 +202,46 @@ BENCHMARK_RELATIVE(asciiUpper) {
   benchmark.runUpperLower("upper", false);
 }
 
+BENCHMARK(utfShortLower) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runUpperLower("lower", true, 8);
+}
+
+BENCHMARK_RELATIVE(asciiShortLower) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runUpperLower("lower", false, 8);
+}
+
+BENCHMARK(utfLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runLength(true);
+}
+
+BENCHMARK_RELATIVE(asciiLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runLength(false);
+}
+
+BENCHMARK(utfTrim) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runTrim("trim", true, 2);
+}
+
+BENCHMARK_RELATIVE(asciiTrim) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runTrim("trim", false, 2);
+}
+
+BENCHMARK(utfTrimPadded) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runTrim("trim", true, 40);
+}
+
+BENCHMARK_RELATIVE(asciiTrimPadded) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runTrim("trim", false, 40);
+}
+
 BENCHMARK(utfSubStr) {
   StringAsciiUTFFunctionBenchmark benchmark;
   benchmark.runSubStr(true);
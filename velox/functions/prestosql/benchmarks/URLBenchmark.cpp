@@ -17,6 +17,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include "folly/Uri.h"
+#include "velox/functions/prestosql/URLFunctions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
@@ -184,6 +185,16 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
         Varchar,
         Varchar,
         Varchar>({"folly_url_extract_parameter"});
+
+    // Not rewritten to share the parsing with other calls.
+    registerFunction<UrlExtractHostFunction, Varchar, Varchar>(
+        {"single_url_extract_host"});
+    registerFunction<UrlExtractPathFunction, Varchar, Varchar>(
+        {"single_url_extract_path"});
+    registerFunction<UrlExtractProtocolFunction, Varchar, Varchar>(
+        {"single_url_extract_protocol"});
+    registerFunction<UrlExtractParameterFunction, Varchar, Varchar, Varchar>(
+        {"single_url_extract_parameter"});
   }
 
   void runUrlExtract(const std::string& fnName, bool isParameter = false) {
@@ -218,6 +229,39 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, rowVector);
   }
 
+  // Evaluates concat() of the host, path, protocol and two parameters of each
+  // URL with the functions named '<prefix>url_extract_*'.
+  void runUrlExtractComponents(const std::string& prefix) {
+    folly::BenchmarkSuspender suspender;
+
+    size_t size = 1000;
+    std::string url;
+    auto vectorUrls = vectorMaker_.flatVector<StringView>(
+        size,
+        [&](auto row) {
+          url = fmt::format(
+              "http://somehost{}.com:8080/somepath{}/p.php?k1={}&k2={}#Refi",
+              row,
+              row % 2,
+              row % 3,
+              row % 5);
+          return StringView(url);
+        },
+        nullptr);
+    auto rowVector = vectorMaker_.rowVector({vectorUrls});
+    auto exprSet = compileExpression(
+        fmt::format(
+            "concat({0}url_extract_host(c0), {0}url_extract_path(c0), "
+            "{0}url_extract_protocol(c0), {0}url_extract_parameter(c0, 'k1'), "
+            "{0}url_extract_parameter(c0, 'k2'))",
+            prefix),
+        rowVector->type());
+
+    suspender.dismiss();
+
+    doRun(exprSet, rowVector);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -297,6 +341,16 @@ BENCHMARK_RELATIVE(velox_param) {
   benchmark.runUrlExtract("url_extract_parameter", true);
 }
 
+BENCHMARK(velox_components_single) {
+  UrlBenchmark benchmark;
+  benchmark.runUrlExtractComponents("single_");
+}
+
+BENCHMARK_RELATIVE(velox_components_shared) {
+  UrlBenchmark benchmark;
+  benchmark.runUrlExtractComponents("");
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/SIMDJsonMultiPathExtractor.h"
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+
+#include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+
+namespace facebook::velox::functions {
+
+std::optional<int32_t> SIMDJsonMultiPathExtractor::addPath(
+    std::string_view path) {
+  const auto trimmedPath = folly::trimWhitespace(path);
+  JsonPathTokenizer tokenizer;
+  if (trimmedPath.empty() ||
+      !tokenizer.reset({trimmedPath.data(), trimmedPath.size()})) {
+    return std::nullopt;
+  }
+
+  // The tokens with the array index each of them selects.
+  std::vector<std::pair<std::string, std::optional<int32_t>>> tokens;
+  while (tokenizer.hasNext()) {
+    auto token = tokenizer.getNext();
+    if (!token.has_value() ||
+        token->selector == JsonPathTokenizer::Selector::WILDCARD ||
+        token->selector == JsonPathTokenizer::Selector::RECURSIVE) {
+      return std::nullopt;
+    }
+    std::optional<int32_t> index;
+    if (token->selector == JsonPathTokenizer::Selector::KEY_OR_INDEX) {
+      if (auto value = folly::tryTo<int32_t>(token->value); value.hasValue()) {
+        // Negative indices need the size of the array. Non-canonical indices
+        // such as '01' would make keys '1' and '01' match the same element.
+        if (value.value() < 0 ||
+            folly::to<std::string>(value.value()) != token->value) {
+          return std::nullopt;
+        }
+        index = value.value();
+      }
+    }
+    tokens.emplace_back(std::move(token->value), index);
+  }
+
+  // Follows the existing nodes.
+  int32_t nodeId = 0;
+  size_t numMatched = 0;
+  for (; numMatched < tokens.size(); ++numMatched) {
+    const auto& [key, index] = tokens[numMatched];
+    const auto& children = nodes_[nodeId].children;
+    auto it = std::find_if(children.begin(), children.end(), [&](auto id) {
+      return nodes_[id].key == key;
+    });
+    if (it == children.end()) {
+      break;
+    }
+    // A quoted key '["0"]' and an index '[0]' select the same field of an
+    // object but not the same elements of an array.
+    if (nodes_[*it].index != index) {
+      return std::nullopt;
+    }
+    nodeId = *it;
+  }
+  if (numMatched < tokens.size() &&
+      nodes_[nodeId].children.size() == kMaxChildren) {
+    return std::nullopt;
+  }
+
+  // Adds the nodes for the remaining tokens.
+  for (; numMatched < tokens.size(); ++numMatched) {
+    auto& [key, index] = tokens[numMatched];
+    const int32_t childId = nodes_.size();
+    nodes_.push_back(Node{std::move(key), index});
+    auto& parent = nodes_[nodeId];
+    parent.children.push_back(childId);
+    if (index.has_value()) {
+      parent.maxChildIndex = std::max(parent.maxChildIndex, index.value());
+    }
+    nodeId = childId;
+  }
+  nodes_[nodeId].paths.push_back(numPaths_);
+  return numPaths_++;
+}
+
+} // namespace facebook::velox::functions
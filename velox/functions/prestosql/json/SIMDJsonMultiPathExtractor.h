@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+namespace facebook::velox::functions {
+
+/// Extracts the values at several JSON paths in one pass over a document. The
+/// paths are merged into a trie of their tokens, see JsonPathTokenizer, so
+/// that a common prefix is navigated once and the fields of an object or the
+/// elements of an array are visited at most once, in document order. Finds the
+/// same values as SIMDJsonExtractor for each path.
+///
+/// Supports only definite paths, i.e. paths without the wildcard and recursive
+/// operators, where the array indices are not negative.
+class SIMDJsonMultiPathExtractor {
+ public:
+  /// Maximum number of children of a node of the trie.
+  static constexpr int32_t kMaxChildren = 64;
+
+  /// Adds 'path' and returns its index. Returns std::nullopt and leaves 'this'
+  /// unchanged if 'path' is invalid or not supported.
+  std::optional<int32_t> addPath(std::string_view path);
+
+  int32_t numPaths() const {
+    return numPaths_;
+  }
+
+  /// Calls 'consumer(paths, value)' for the value of each node of the trie
+  /// where paths end, with the indices of these paths. 'value' is a
+  /// simdjson::ondemand::document for a scalar document and a
+  /// simdjson::ondemand::value otherwise. The consumer must not iterate over
+  /// an object or array 'value'.
+  ///
+  /// Returns the first error encountered while parsing 'json' or from
+  /// 'consumer'. The consumer may have been called for some of the paths
+  /// before the error.
+  template <typename TConsumer>
+  simdjson::error_code extract(
+      const simdjson::padded_string& json,
+      TConsumer& consumer) const;
+
+ private:
+  struct Node {
+    // The key of an object field the node stands for.
+    std::string key;
+    // The index of an array element the node stands for. std::nullopt if the
+    // node does not match array elements.
+    std::optional<int32_t> index;
+    // The paths ending at the node.
+    std::vector<int32_t> paths;
+    // Indices of the child nodes in 'nodes_'.
+    std::vector<int32_t> children;
+    // The largest 'index' of the children. -1 if none.
+    int32_t maxChildIndex{-1};
+  };
+
+  template <typename TConsumer>
+  simdjson::error_code extractNode(
+      const Node& node,
+      simdjson::ondemand::value& value,
+      TConsumer& consumer) const;
+
+  // The root is the first node.
+  std::vector<Node> nodes_ = std::vector<Node>(1);
+  int32_t numPaths_{0};
+};
+
+template <typename TConsumer>
+simdjson::error_code SIMDJsonMultiPathExtractor::extract(
+    const simdjson::padded_string& json,
+    TConsumer& consumer) const {
+  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(json));
+  SIMDJSON_ASSIGN_OR_RAISE(auto isScalar, jsonDoc.is_scalar());
+  const auto& root = nodes_[0];
+  if (isScalar) {
+    // A scalar document cannot be converted to a value. Only the root path
+    // has a value.
+    if (!root.paths.empty()) {
+      return consumer(root.paths, jsonDoc);
+    }
+    return simdjson::SUCCESS;
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractNode(root, value, consumer);
+}
+
+template <typename TConsumer>
+simdjson::error_code SIMDJsonMultiPathExtractor::extractNode(
+    const Node& node,
+    simdjson::ondemand::value& value,
+    TConsumer& consumer) const {
+  SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
+  if (!node.paths.empty()) {
+    SIMDJSON_TRY(consumer(node.paths, value));
+  }
+  if (node.children.empty()) {
+    return simdjson::SUCCESS;
+  }
+
+  if (type == simdjson::ondemand::json_type::object) {
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonObj, value.get_object());
+    // Only the first field with a given key is used.
+    uint64_t visited = 0;
+    auto numLeft = node.children.size();
+    for (auto field : jsonObj) {
+      SIMDJSON_ASSIGN_OR_RAISE(auto key, field.unescaped_key());
+      for (auto i = 0; i < node.children.size(); ++i) {
+        const auto& child = nodes_[node.children[i]];
+        if ((visited & (1ULL << i)) == 0 && child.key == key) {
+          visited |= 1ULL << i;
+          SIMDJSON_ASSIGN_OR_RAISE(auto childValue, field.value());
+          SIMDJSON_TRY(extractNode(child, childValue, consumer));
+          --numLeft;
+          break;
+        }
+      }
+      if (numLeft == 0) {
+        break;
+      }
+    }
+  } else if (
+      type == simdjson::ondemand::json_type::array &&
+      node.maxChildIndex >= 0) {
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonArray, value.get_array());
+    int32_t index = 0;
+    for (auto element : jsonArray) {
+      for (auto childId : node.children) {
+        const auto& child = nodes_[childId];
+        if (child.index == index) {
+          SIMDJSON_ASSIGN_OR_RAISE(auto childValue, element);
+          SIMDJSON_TRY(extractNode(child, childValue, consumer));
+          break;
+        }
+      }
+      if (index++ == node.maxChildIndex) {
+        break;
+      }
+    }
+  }
+  return simdjson::SUCCESS;
+}
+
+} // namespace facebook::velox::functions
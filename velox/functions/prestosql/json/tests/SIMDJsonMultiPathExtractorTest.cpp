@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/SIMDJsonMultiPathExtractor.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+// Returns the value of json_extract_scalar for a JSON value.
+template <typename T>
+simdjson::error_code toScalar(T& value, std::optional<std::string>& result) {
+  SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
+  switch (type) {
+    case simdjson::ondemand::json_type::boolean: {
+      SIMDJSON_ASSIGN_OR_RAISE(bool boolValue, value.get_bool());
+      result = boolValue ? "true" : "false";
+      break;
+    }
+    case simdjson::ondemand::json_type::string: {
+      SIMDJSON_ASSIGN_OR_RAISE(result, value.get_string());
+      break;
+    }
+    case simdjson::ondemand::json_type::object:
+    case simdjson::ondemand::json_type::array:
+    case simdjson::ondemand::json_type::null:
+      break;
+    default: {
+      SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(value));
+    }
+  }
+  return simdjson::SUCCESS;
+}
+
+std::optional<std::string> extractOne(
+    const std::string& json,
+    const std::string& path) {
+  std::optional<std::string> result;
+  auto consumer = [&](auto& value) { return toScalar(value, result); };
+  bool isDefinitePath = true;
+  simdjson::padded_string paddedJson(json.data(), json.size());
+  if (SIMDJsonExtractor::getInstance(path).extract(
+          paddedJson, consumer, isDefinitePath) != simdjson::SUCCESS) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+class SIMDJsonMultiPathExtractorTest : public testing::Test {
+ protected:
+  // Extracts 'paths' together and checks that the values are the same as
+  // when extracted one by one.
+  void testExtract(
+      const std::string& json,
+      const std::vector<std::string>& paths) {
+    SCOPED_TRACE(json);
+    SIMDJsonMultiPathExtractor extractor;
+    for (auto i = 0; i < paths.size(); ++i) {
+      ASSERT_EQ(extractor.addPath(paths[i]), i) << paths[i];
+    }
+    std::vector<std::optional<std::string>> results(paths.size());
+    auto consumer = [&](const std::vector<int32_t>& ids, auto& value) {
+      std::optional<std::string> result;
+      SIMDJSON_TRY(toScalar(value, result));
+      for (auto id : ids) {
+        results[id] = result;
+      }
+      return simdjson::SUCCESS;
+    };
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    ASSERT_EQ(extractor.extract(paddedJson, consumer), simdjson::SUCCESS);
+    for (auto i = 0; i < paths.size(); ++i) {
+      EXPECT_EQ(results[i], extractOne(json, paths[i])) << paths[i];
+    }
+  }
+};
+
+TEST_F(SIMDJsonMultiPathExtractorTest, objects) {
+  const std::vector<std::string> paths = {
+      "$.a",
+      "$.b.c",
+      "b.d",
+      "$.b",
+      "$['b']['c']",
+      "$.e.f.g",
+      "$.h",
+      "$.missing",
+      "$.b.c.x"};
+  testExtract(
+      R"({"a": 1, "b": {"c": "x", "d": true, "z": [1, 2]}, "h": null})", paths);
+  testExtract(
+      R"({"b": {"d": false, "c": 2.5}, "e": {"f": {"g": "deep"}}, "a": "s"})",
+      paths);
+  // Only the first of duplicate keys is used.
+  testExtract(R"({"a": 1, "a": 2, "b": {"c": 3}, "b": {"c": 4}})", paths);
+  testExtract(R"({"aA": 1, "a": "escaped"})", paths);
+  testExtract(R"({})", paths);
+}
+
+TEST_F(SIMDJsonMultiPathExtractorTest, arrays) {
+  const std::vector<std::string> paths = {
+      "$[0]", "$[2].a", "$[2]['a']", "[1]", "$[2].b[1]", "$[5]", "$.0"};
+  testExtract(R"([10, "x", {"a": true, "b": [1, {"c": 2}]}])", paths);
+  testExtract(R"([[1], {"a": 2}])", paths);
+  testExtract(R"({"0": "key", "2": {"a": 1}})", paths);
+  testExtract(R"([])", paths);
+}
+
+TEST_F(SIMDJsonMultiPathExtractorTest, scalars) {
+  const std::vector<std::string> paths = {"$", "$.a", "$[0]"};
+  testExtract("123", paths);
+  testExtract(R"("string")", paths);
+  testExtract("true", paths);
+  testExtract("null", paths);
+  testExtract(R"({"a": 1})", paths);
+}
+
+TEST_F(SIMDJsonMultiPathExtractorTest, unsupportedPaths) {
+  SIMDJsonMultiPathExtractor extractor;
+  ASSERT_EQ(extractor.addPath("$[0]"), 0);
+  ASSERT_EQ(extractor.addPath("$.a.b"), 1);
+  for (const auto& path :
+       {"", "$.a[*]", "$..a", "$.*", "$[-1]", "$[01]", "$['0']", "$.a["}) {
+    SCOPED_TRACE(path);
+    ASSERT_FALSE(extractor.addPath(path).has_value());
+  }
+  ASSERT_EQ(extractor.addPath("  $.a.c  "), 2);
+  ASSERT_EQ(extractor.numPaths(), 3);
+
+  SIMDJsonMultiPathExtractor wide;
+  for (auto i = 0; i < SIMDJsonMultiPathExtractor::kMaxChildren; ++i) {
+    ASSERT_EQ(wide.addPath(fmt::format("$.k{}", i)), i);
+  }
+  ASSERT_FALSE(wide.addPath("$.more").has_value());
+  ASSERT_EQ(
+      wide.addPath("$.k0.more"), SIMDJsonMultiPathExtractor::kMaxChildren);
+}
+
+TEST_F(SIMDJsonMultiPathExtractorTest, invalidJson) {
+  SIMDJsonMultiPathExtractor extractor;
+  extractor.addPath("$.a");
+  extractor.addPath("$.b.c");
+  auto consumer = [](const std::vector<int32_t>&, auto&) {
+    return simdjson::SUCCESS;
+  };
+  for (const std::string json : {R"({"a": 1, "b": {"c": )", R"({"a" 1})"}) {
+    SCOPED_TRACE(json);
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    ASSERT_NE(extractor.extract(paddedJson, consumer), simdjson::SUCCESS);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions
@@ -31,6 +31,14 @@ void registerSimpleBingTileFunctions(const std::string& prefix) {
   registerFunction<BingTileFunction, BingTile, int32_t, int32_t, int8_t>(
       {prefix + "bing_tile"});
   registerFunction<BingTileFunction, BingTile, Varchar>({prefix + "bing_tile"});
+  registerFunction<BingTileAtFunction, BingTile, double, double, int8_t>(
+      {prefix + "bing_tile_at"});
+  registerFunction<
+      BingTilesAroundFunction,
+      Array<BingTile>,
+      double,
+      double,
+      int8_t>({prefix + "bing_tiles_around"});
 
   // BingTile accessors
   registerFunction<BingTileZoomLevelFunction, int8_t, BingTile>(
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/Comparisons.h"
 #include "velox/functions/prestosql/types/IPAddressRegistration.h"
@@ -73,6 +74,13 @@ void registerComparisonFunctions(const std::string& prefix) {
   registerFunction<GteFunction, bool, Orderable<T1>, Orderable<T1>>(
       {prefix + "gte"});
 
+  exec::registerFusedFunction(prefix + "eq", exec::FusedOp::kEq);
+  exec::registerFusedFunction(prefix + "neq", exec::FusedOp::kNeq);
+  exec::registerFusedFunction(prefix + "lt", exec::FusedOp::kLt);
+  exec::registerFusedFunction(prefix + "gt", exec::FusedOp::kGt);
+  exec::registerFusedFunction(prefix + "lte", exec::FusedOp::kLte);
+  exec::registerFusedFunction(prefix + "gte", exec::FusedOp::kGte);
+
   registerFunction<DistinctFromFunction, bool, Generic<T1>, Generic<T1>>(
       {prefix + "distinct_from"});
 
@@ -20,6 +20,7 @@
 #include "velox/functions/prestosql/Fail.h"
 #include "velox/functions/prestosql/GreatestLeast.h"
 #include "velox/functions/prestosql/InPredicate.h"
+#include "velox/functions/prestosql/MapSubscripts.h"
 #include "velox/functions/prestosql/Reduce.h"
 #include "velox/functions/prestosql/types/IPAddressType.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
@@ -85,6 +86,12 @@ void registerAllSpecialFormGeneralFunctions() {
 void registerGeneralFunctions(const std::string& prefix) {
   registerSubscriptFunction(prefix + "subscript", true);
   registerElementAtFunction(prefix + "element_at", true);
+  exec::registerStatefulVectorFunction(
+      "$internal$map_subscripts", mapSubscriptsSignatures(), makeMapSubscripts);
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteMapSubscriptCalls(
+        {prefix + "subscript", prefix + "element_at"}, exprs);
+  });
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_transform, prefix + "transform");
   VELOX_REGISTER_VECTOR_FUNCTION(udf_reduce, prefix + "reduce");
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -125,6 +126,7 @@ void registerMathFunctions(const std::string& prefix) {
 void registerMathematicalFunctions(const std::string& prefix = "") {
   registerMathFunctions(prefix);
   VELOX_REGISTER_VECTOR_FUNCTION(udf_not, prefix + "not");
+  exec::registerFusedFunction(prefix + "not", exec::FusedOp::kNot);
 
   registerDecimalFloor(prefix);
   registerDecimalRound(prefix);
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -97,6 +98,9 @@ void registerMathOperators(const std::string& prefix = "") {
 
 void registerMathematicalOperators(const std::string& prefix = "") {
   registerMathOperators(prefix);
+  exec::registerFusedFunction(prefix + "plus", exec::FusedOp::kPlus);
+  exec::registerFusedFunction(prefix + "minus", exec::FusedOp::kMinus);
+  exec::registerFusedFunction(prefix + "multiply", exec::FusedOp::kMultiply);
 
   registerDecimalPlus(prefix);
   registerDecimalMinus(prefix);
@@ -100,6 +100,11 @@ void registerSimpleFunctions(const std::string& prefix) {
 
   exec::registerStatefulVectorFunction(
       prefix + "like", likeSignatures(), makeLike);
+  exec::registerStatefulVectorFunction(
+      "$internal$like_any", likeAnySignatures(), makeLikeAny);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteLikeAnyCall(prefix, expr);
+  });
 
   registerFunction<Re2RegexpReplacePresto, Varchar, Varchar, Varchar>(
       {prefix + "regexp_replace"});
@@ -219,7 +224,18 @@ void registerStringFunctions(const std::string& prefix) {
       re2ExtractAllSignatures(),
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
-      prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+      prefix + "regexp_like",
+      re2SearchSignatures(),
+      makeRe2Search,
+      exec::VectorFunctionMetadataBuilder().cacheResultsByValue(true).build());
+  exec::registerStatefulVectorFunction(
+      "$internal$regexp_like_any",
+      re2SearchAnySignatures(),
+      makeRe2SearchAny,
+      exec::VectorFunctionMetadataBuilder().cacheResultsByValue(true).build());
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteRegexpLikeAnyCall(prefix, expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
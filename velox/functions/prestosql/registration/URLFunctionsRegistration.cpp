@@ -17,6 +17,7 @@
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/StringFunctions.h"
 #include "velox/functions/prestosql/URLFunctions.h"
+#include "velox/functions/prestosql/UrlExtractComponents.h"
 
 namespace facebook::velox::functions {
 
@@ -35,6 +36,13 @@ void registerURLFunctions(const std::string& prefix) {
       {prefix + "url_extract_port"});
   registerFunction<UrlExtractQueryFunction, Varchar, Varchar>(
       {prefix + "url_extract_query"});
+  exec::registerStatefulVectorFunction(
+      "$internal$url_extract_components",
+      urlExtractComponentsSignatures(),
+      makeUrlExtractComponents);
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteUrlExtractCalls(prefix, exprs);
+  });
   registerFunction<UrlEncodeFunction, Varchar, Varchar>(
       {prefix + "url_encode"});
   registerFunction<UrlDecodeFunction, Varchar, Varchar>(
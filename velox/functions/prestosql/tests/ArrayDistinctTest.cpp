@@ -472,3 +472,55 @@ TEST_F(ArrayDistinctTest, overlappingRanges) {
       makeArrayVector<int64_t>({{0, 1, 2}, {1, 2}, {2, 1}, {1, 2, 3}}),
       evaluate("array_distinct(c0)", makeRowVector({array})));
 }
+
+// Arrays below and above the size up to which distinct values are found by a
+// linear search.
+TEST_F(ArrayDistinctTest, smallAndLargeArrays) {
+  std::vector<std::vector<std::optional<int64_t>>> input;
+  std::vector<std::vector<std::optional<int64_t>>> expected;
+  for (auto size = 0; size < 40; ++size) {
+    std::vector<std::optional<int64_t>> values;
+    std::vector<std::optional<int64_t>> distinct;
+    bool hasNull = false;
+    for (auto i = 0; i < size; ++i) {
+      std::optional<int64_t> value;
+      if (i % 7 != 3) {
+        value = (i * 5) % (size / 2 + 1);
+      }
+      values.push_back(value);
+      if (!value.has_value()) {
+        if (!hasNull) {
+          hasNull = true;
+          distinct.push_back(value);
+        }
+      } else if (
+          std::find(distinct.begin(), distinct.end(), value) ==
+          distinct.end()) {
+        distinct.push_back(value);
+      }
+    }
+    input.push_back(std::move(values));
+    expected.push_back(std::move(distinct));
+  }
+
+  testExpr(
+      makeNullableArrayVector(expected),
+      "array_distinct(C0)",
+      {makeNullableArrayVector(input)});
+
+  // Dictionary encoded elements.
+  auto arrays = makeNullableArrayVector(input);
+  auto elements = arrays->elements();
+  arrays->setElements(BaseVector::wrapInDictionary(
+      nullptr,
+      makeIndices(elements->size(), [](auto row) { return row; }),
+      elements->size(),
+      elements));
+  testExpr(makeNullableArrayVector(expected), "array_distinct(C0)", {arrays});
+
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  testExpr(
+      makeArrayVector<double>({{1.0, nan, 2.0, 0.0}}),
+      "array_distinct(C0)",
+      {makeArrayVector<double>({{1.0, nan, 2.0, nan, 1.0, 0.0, 2.0}})});
+}
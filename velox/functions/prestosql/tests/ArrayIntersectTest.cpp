@@ -736,3 +736,40 @@ TEST_F(ArrayIntersectTest, nullInDictionary) {
       makeNullableArrayVector<int64_t>({{{1}}, std::nullopt, {{7}}});
   testExpr(expected, "array_intersect(c0)", {arrays});
 }
+
+// Right arrays below and above the size up to which the set of their values
+// is searched linearly.
+TEST_F(ArrayIntersectTest, smallAndLargeArrays) {
+  std::vector<std::vector<std::optional<int32_t>>> left;
+  std::vector<std::vector<std::optional<int32_t>>> right;
+  std::vector<std::vector<std::optional<int32_t>>> expected;
+  for (auto size = 0; size < 40; ++size) {
+    std::vector<std::optional<int32_t>> leftValues;
+    std::vector<std::optional<int32_t>> rightValues;
+    for (auto i = 0; i < 30; ++i) {
+      leftValues.push_back(i % 11 == 10 ? std::nullopt : std::optional(i % 23));
+    }
+    for (auto i = 0; i < size; ++i) {
+      rightValues.push_back(
+          i == 20 ? std::nullopt : std::optional((i * 3) % 29));
+    }
+
+    std::vector<std::optional<int32_t>> intersection;
+    for (const auto& value : leftValues) {
+      if (std::find(rightValues.begin(), rightValues.end(), value) !=
+              rightValues.end() &&
+          std::find(intersection.begin(), intersection.end(), value) ==
+              intersection.end()) {
+        intersection.push_back(value);
+      }
+    }
+    left.push_back(std::move(leftValues));
+    right.push_back(std::move(rightValues));
+    expected.push_back(std::move(intersection));
+  }
+
+  testExpr(
+      makeNullableArrayVector(expected),
+      "array_intersect(C0, C1)",
+      {makeNullableArrayVector(left), makeNullableArrayVector(right)});
+}
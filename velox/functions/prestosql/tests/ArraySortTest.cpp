@@ -18,6 +18,7 @@
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
+#include "velox/type/FloatingPointUtil.h"
 
 #include <fmt/format.h>
 #include <cstdint>
@@ -902,6 +903,47 @@ TEST_F(ArraySortTest, constant_desc_boolean) {
   assertEqualVectors(expected, makeRowVector({result}));
 }
 
+// Arrays below and above the size up to which a sorting network is used.
+TEST_F(ArraySortTest, smallAndLargeArrays) {
+  std::vector<std::vector<std::optional<double>>> input;
+  std::vector<std::vector<std::optional<double>>> ascending;
+  std::vector<std::vector<std::optional<double>>> descending;
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  for (auto size = 0; size < 40; ++size) {
+    std::vector<std::optional<double>> values;
+    std::vector<double> nonNulls;
+    for (auto i = 0; i < size; ++i) {
+      if (i % 9 == 4) {
+        values.push_back(std::nullopt);
+        continue;
+      }
+      const double value = i % 13 == 12 ? nan : (i * 17) % 31 - 15;
+      values.push_back(value);
+      nonNulls.push_back(value);
+    }
+    std::sort(
+        nonNulls.begin(),
+        nonNulls.end(),
+        util::floating_point::NaNAwareLessThan<double>());
+    std::vector<std::optional<double>> sorted(nonNulls.begin(), nonNulls.end());
+    sorted.resize(values.size());
+    std::vector<std::optional<double>> reversed(
+        nonNulls.rbegin(), nonNulls.rend());
+    reversed.resize(values.size());
+
+    input.push_back(std::move(values));
+    ascending.push_back(std::move(sorted));
+    descending.push_back(std::move(reversed));
+  }
+
+  auto data = makeRowVector({makeNullableArrayVector(input)});
+  assertEqualVectors(
+      makeNullableArrayVector(ascending), evaluate("array_sort(c0)", data));
+  assertEqualVectors(
+      makeNullableArrayVector(descending),
+      evaluate("array_sort_desc(c0)", data));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     ArraySortTest,
     ArraySortTest,
@@ -444,3 +444,80 @@ TEST_F(BingTileFunctionsTest, bingTileChildrenZoom) {
   VELOX_ASSERT_USER_THROW(
       testBingTileChildren(0, 0, 2, 1), "Child zoom 1 must be >= tile zoom 2");
 }
+
+TEST_F(BingTileFunctionsTest, bingTileAt) {
+  const auto bingTileAt = [&](std::optional<double> latitude,
+                              std::optional<double> longitude,
+                              std::optional<int8_t> zoom) {
+    return evaluateOnce<std::string>(
+        "bing_tile_quadkey(bing_tile_at(c0, c1, c2))",
+        latitude,
+        longitude,
+        zoom);
+  };
+
+  ASSERT_EQ(bingTileAt(30.12, 60, 15), "123030123010121");
+  ASSERT_EQ(bingTileAt(0, -0.002, 1), "2");
+  ASSERT_EQ(bingTileAt(1.0 / 512, 0, 1), "1");
+  ASSERT_EQ(bingTileAt(1.0 / 512, 0, 9), "122222222");
+  ASSERT_EQ(bingTileAt(-85.05112878, -180, 1), "2");
+  ASSERT_EQ(bingTileAt(85.05112878, 180, 3), "111");
+  ASSERT_EQ(bingTileAt(std::nullopt, 0, 1), std::nullopt);
+  ASSERT_EQ(bingTileAt(0, 0, std::nullopt), std::nullopt);
+
+  VELOX_ASSERT_USER_THROW(
+      bingTileAt(86, 0, 1),
+      "Latitude must be between -85.05112878 and 85.05112878");
+  VELOX_ASSERT_USER_THROW(
+      bingTileAt(std::nan(""), 0, 1),
+      "Latitude must be between -85.05112878 and 85.05112878");
+  VELOX_ASSERT_USER_THROW(
+      bingTileAt(0, 180.5, 1), "Longitude must be between -180.0 and 180.0");
+  VELOX_ASSERT_USER_THROW(bingTileAt(0, 0, 0), "Zoom level must be > 0");
+  VELOX_ASSERT_USER_THROW(bingTileAt(0, 0, 24), "Zoom level must be <= 23");
+}
+
+TEST_F(BingTileFunctionsTest, bingTilesAround) {
+  const auto bingTilesAround = [&](double latitude,
+                                   double longitude,
+                                   int8_t zoom) {
+    auto result = evaluate(
+        "array_sort(transform(bing_tiles_around(c0, c1, c2), "
+        "x -> bing_tile_quadkey(x)))",
+        makeRowVector({
+            makeFlatVector<double>({latitude}),
+            makeFlatVector<double>({longitude}),
+            makeFlatVector<int8_t>({zoom}),
+        }));
+    auto* array = result->asChecked<ArrayVector>();
+    auto* elements = array->elements()->asFlatVector<StringView>();
+    std::vector<std::string> quadKeys;
+    for (auto i = 0; i < array->sizeAt(0); ++i) {
+      quadKeys.push_back(elements->valueAt(array->offsetAt(0) + i).str());
+    }
+    return quadKeys;
+  };
+
+  ASSERT_EQ(
+      bingTilesAround(30.12, 60, 1),
+      (std::vector<std::string>{"0", "1", "2", "3"}));
+  ASSERT_EQ(
+      bingTilesAround(30.12, 60, 15),
+      (std::vector<std::string>{
+          "123030123010102",
+          "123030123010103",
+          "123030123010112",
+          "123030123010120",
+          "123030123010121",
+          "123030123010122",
+          "123030123010123",
+          "123030123010130",
+          "123030123010132"}));
+  // A corner tile has 3 neighbors.
+  ASSERT_EQ(
+      bingTilesAround(85.05112878, -180, 3),
+      (std::vector<std::string>{"000", "001", "002", "003"}));
+
+  VELOX_ASSERT_USER_THROW(
+      bingTilesAround(0, 200, 1), "Longitude must be between -180.0 and 180.0");
+}
@@ -697,6 +697,39 @@ TEST_F(DateTimeFunctionsTest, hour) {
   EXPECT_EQ(8, hour(Timestamp(998423705, 321000000)));
 }
 
+TEST_F(DateTimeFunctionsTest, batchInTimeZone) {
+  // Flat timestamps without nulls are converted to the session time zone as a
+  // batch. Compares with the row by row conversion of the same timestamps
+  // under a dictionary that skips every other row of its base. The timestamps
+  // cross the DST transitions of 2024.
+  auto timestamps = makeFlatVector<Timestamp>(
+      10'000, [](auto row) { return Timestamp(1704067200 + row * 3'163, 0); });
+  // A timestamp after 2100 is converted row by row.
+  auto withLate = makeFlatVector<Timestamp>(
+      100, [](auto row) { return Timestamp(1704067200 + row * 86'400, 0); });
+  withLate->set(50, Timestamp(4000000000, 0));
+
+  setQueryTimeZone("America/Los_Angeles");
+  for (const auto& data : {timestamps, withLate}) {
+    auto flat = makeRowVector({data});
+    auto base = makeFlatVector<Timestamp>(
+        data->size() * 2, [&](auto row) { return data->valueAt(row / 2); });
+    auto dictionary = makeRowVector({wrapInDictionary(
+        makeIndices(data->size(), [](auto row) { return row * 2; }), base)});
+    for (const auto& expression :
+         {"year(c0)",
+          "quarter(c0)",
+          "month(c0)",
+          "day(c0)",
+          "hour(c0)",
+          "minute(c0)"}) {
+      SCOPED_TRACE(expression);
+      assertEqualVectors(
+          evaluate(expression, dictionary), evaluate(expression, flat));
+    }
+  }
+}
+
 TEST_F(DateTimeFunctionsTest, hourTimestampWithTimezone) {
   const auto hourTimestampWithTimezone =
       [&](std::optional<TimestampWithTimezone> timestampWithTimezone) {
@@ -301,6 +301,46 @@ TEST_F(DecimalArithmeticTest, multiply) {
       "");
 }
 
+TEST_F(DecimalArithmeticTest, flatBatch) {
+  // Flat inputs without nulls are computed as a batch. The results and errors
+  // match computing the rows one by one as for dictionary inputs.
+  constexpr vector_size_t kSize = 1'000;
+  auto longFlat = makeFlatVector<int128_t>(
+      kSize,
+      [](auto row) {
+        return HugeInt::build(row % 7, row) * (row % 2 == 0 ? 1 : -1);
+      },
+      nullptr,
+      DECIMAL(38, 2));
+  auto shortFlat = makeFlatVector<int64_t>(
+      kSize,
+      [](auto row) { return row * 12'345 - 7; },
+      nullptr,
+      DECIMAL(18, 4));
+  auto identity = makeIndices(kSize, [](auto row) { return row; });
+  auto wrapInDictionaries = [&]() {
+    return makeRowVector({
+        wrapInDictionary(identity, longFlat),
+        wrapInDictionary(identity, shortFlat),
+    });
+  };
+  for (const auto& expression :
+       {"c0 + c1", "c1 - c0", "c0 * c1", "c1 * c1", "c1 + c1"}) {
+    SCOPED_TRACE(expression);
+    assertEqualVectors(
+        evaluate(expression, wrapInDictionaries()),
+        evaluate(expression, makeRowVector({longFlat, shortFlat})));
+  }
+
+  // One row overflows.
+  longFlat->set(kSize / 2, DecimalUtil::kLongDecimalMax);
+  auto data = makeRowVector({longFlat, shortFlat});
+  VELOX_ASSERT_USER_THROW(evaluate("c0 + c1", data), "Decimal overflow");
+  auto expected = evaluate("try(c0 + c1)", wrapInDictionaries());
+  ASSERT_TRUE(expected->isNullAt(kSize / 2));
+  assertEqualVectors(expected, evaluate("try(c0 + c1)", data));
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivTest) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Divide short and short, returning long.
@@ -1475,3 +1475,61 @@ TEST_F(ElementAtTest, highlySelective) {
     EXPECT_EQ(result->encoding(), VectorEncoding::Simple::DICTIONARY);
   }
 }
+
+TEST_F(ElementAtTest, sharedMapScan) {
+  auto data = makeRowVector({
+      makeMapVectorFromJson<std::string, int64_t>({
+          R"({"a": 1, "b": 2, "a long key over 12 bytes": 3})",
+          R"({"b": 4, "c": null})",
+          "null",
+          "{}",
+          R"({"a": 5, "a long key over 12 bytes": 6, "d": 7})",
+      }),
+      makeMapVectorFromJson<int32_t, int64_t>({
+          "{1: 10, 2: 20}",
+          "{3: 30}",
+          "{}",
+          "{2: 40, 1: 50}",
+          "null",
+      }),
+  });
+
+  auto rowType = asRowType(data->type());
+  auto test = [&](const std::vector<std::string>& expressions) {
+    auto exprSet = compileExpressions(expressions, rowType);
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet->eval(rows, context, results);
+    for (auto i = 0; i < expressions.size(); ++i) {
+      SCOPED_TRACE(expressions[i]);
+      auto expected =
+          evaluate(*compileExpression(expressions[i], rowType), data);
+      test::assertEqualVectors(expected, results[i]);
+    }
+    return exprSet;
+  };
+
+  auto exprSet = test({
+      "c0['a']",
+      "element_at(c0, 'b')",
+      "c0['c']",
+      "coalesce(c0['a long key over 12 bytes'], c0['missing'])",
+      "element_at(c1, 1) + element_at(c1, 2)",
+      "element_at(c1, 3)",
+      "c0['a']",
+  });
+
+  // The calls with constant keys on one map read the fields of one shared
+  // expression.
+  const auto& shared = exprSet->expr(0)->inputs().at(0);
+  ASSERT_EQ(shared->name(), "$internal$map_subscripts");
+  ASSERT_EQ(exprSet->expr(1)->inputs().at(0), shared);
+  ASSERT_EQ(exprSet->expr(6)->inputs().at(0), shared);
+  ASSERT_EQ(
+      exprSet->expr(5)->inputs().at(0)->name(), "$internal$map_subscripts");
+
+  // A single key per map is not rewritten.
+  exprSet = test({"c0['a']", "element_at(c0, 'a')", "element_at(c1, 1)"});
+  ASSERT_EQ(exprSet->expr(0)->name(), "subscript");
+}
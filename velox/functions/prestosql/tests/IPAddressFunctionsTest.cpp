@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <folly/String.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/IPPrefixType.h"
@@ -78,6 +80,31 @@ class IPAddressFunctionsTest : public functions::test::FunctionBaseTest {
         prefix2);
   }
 
+  // Returns ip_prefix_lookup of 'ip' in constant 'prefixes'. Checks that the
+  // lookup in the same prefixes that are not constant agrees.
+  std::optional<std::string> ipPrefixLookup(
+      const std::vector<std::string>& prefixes,
+      const std::optional<std::string>& ip) {
+    std::vector<std::string> elements;
+    for (const auto& prefix : prefixes) {
+      elements.push_back(fmt::format("cast('{}' as ipprefix)", prefix));
+    }
+    const auto result = evaluateOnce<std::string>(
+        fmt::format(
+            "cast(ip_prefix_lookup(array[{}], cast(c0 as ipaddress)) "
+            "as varchar)",
+            folly::join(", ", elements)),
+        ip);
+    const auto notConstant = evaluateOnce<std::string>(
+        fmt::format(
+            "cast(ip_prefix_lookup(if(length(c0) > 0, array[{0}], "
+            "array[{0}]), cast(c0 as ipaddress)) as varchar)",
+            folly::join(", ", elements)),
+        ip);
+    EXPECT_EQ(result, notConstant);
+    return result;
+  }
+
   std::optional<bool> isPrivateIP(const std::optional<std::string>& input) {
     return evaluateOnce<bool>("is_private_ip(cast(c0 as ipaddress))", input);
   }
@@ -553,6 +580,44 @@ TEST_F(IPAddressFunctionsTest, IPPrefixCollapseTest) {
   }
 }
 
+TEST_F(IPAddressFunctionsTest, ipPrefixLookup) {
+  const std::vector<std::string> prefixes = {
+      "10.0.0.0/8",
+      "10.1.0.0/16",
+      "10.1.2.0/24",
+      "10.1.2.128/25",
+      "10.2.0.0/16",
+      "192.168.0.0/16",
+      "0.0.0.0/0",
+      "2001:db8::/32",
+      "2001:db8:1::/48",
+      "fc00::/7",
+  };
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.1.2.129"), "10.1.2.128/25");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.1.2.127"), "10.1.2.0/24");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.1.3.1"), "10.1.0.0/16");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.1.255.255"), "10.1.0.0/16");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.2.0.0"), "10.2.0.0/16");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.3.0.0"), "10.0.0.0/8");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "10.255.255.255"), "10.0.0.0/8");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "11.0.0.0"), "0.0.0.0/0");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "0.0.0.0"), "0.0.0.0/0");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "255.255.255.255"), "0.0.0.0/0");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "2001:db8:1::1"), "2001:db8:1::/48");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "2001:db8:2::1"), "2001:db8::/32");
+  // Compared as unsigned, fc00::/7 is after the other prefixes.
+  EXPECT_EQ(ipPrefixLookup(prefixes, "fd12::1"), "fc00::/7");
+  EXPECT_EQ(ipPrefixLookup(prefixes, "2001:db9::1"), std::nullopt);
+  EXPECT_EQ(ipPrefixLookup(prefixes, "fe80::1"), std::nullopt);
+  EXPECT_EQ(ipPrefixLookup(prefixes, std::nullopt), std::nullopt);
+
+  EXPECT_EQ(ipPrefixLookup({"::/0", "1.2.3.0/24"}, "1.2.3.4"), "1.2.3.0/24");
+  EXPECT_EQ(ipPrefixLookup({"::/0", "1.2.3.0/24"}, "1.2.4.4"), "::/0");
+  EXPECT_EQ(ipPrefixLookup({"::/0"}, "ffff::1"), "::/0");
+  EXPECT_EQ(ipPrefixLookup({"1.2.3.4/32"}, "1.2.3.4"), "1.2.3.4/32");
+  EXPECT_EQ(ipPrefixLookup({"1.2.3.4/32"}, "1.2.3.5"), std::nullopt);
+}
+
 TEST_F(IPAddressFunctionsTest, IPPrefixSubnetsTest) {
   auto ipprefix = [](const std::string& ipprefixString) {
     auto tryIpPrefix = ipaddress::tryParseIpPrefixString(ipprefixString);
@@ -70,6 +70,26 @@ class JsonExtractScalarTest : public functions::test::FunctionBaseTest {
             "json_extract_scalar(c0, c1)",
             makeRowVector({varcharVector, pathVector})));
   }
+
+  // Evaluates 'expressions' in one ExprSet and compares the results with the
+  // results of evaluating each expression alone.
+  std::unique_ptr<exec::ExprSet> testExprSet(
+      const std::vector<std::string>& expressions,
+      const RowVectorPtr& data) {
+    auto rowType = asRowType(data->type());
+    auto exprSet = compileExpressions(expressions, rowType);
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet->eval(rows, context, results);
+    for (auto i = 0; i < expressions.size(); ++i) {
+      SCOPED_TRACE(expressions[i]);
+      auto expected =
+          evaluate(*compileExpression(expressions[i], rowType), data);
+      velox::test::assertEqualVectors(expected, results[i]);
+    }
+    return exprSet;
+  }
 };
 
 TEST_F(JsonExtractScalarTest, simple) {
@@ -206,6 +226,45 @@ TEST_F(JsonExtractScalarTest, escapedString) {
       jsonExtractScalar(R"({"x": {"a" : 1, "b" : "b\/c"} })", "$.x.b"), "b/c");
 }
 
+TEST_F(JsonExtractScalarTest, sharedParse) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<StringView>(
+          {R"({"a": 1, "b": {"c": "x", "d": [true, null, 2.5]}})",
+           R"({"b": {"d": [false]}, "a": "y", "a": "z"})",
+           std::nullopt,
+           R"([1, 2, 3])",
+           R"("scalar")",
+           R"({"a": [], "b": {"c": {"e": 1}}})",
+           // Malformed after the values of "a" and "b".
+           R"({"a": 7, "b": {"c": "w"}, "e": })",
+           R"({"a": 8, "b": 1)"},
+          JSON()),
+      makeFlatVector<bool>(8, [](auto row) { return row % 2 == 0; }),
+  });
+
+  auto exprSet = testExprSet(
+      {"json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c0, '$.b.c')",
+       "if(c1, json_extract_scalar(c0, '$.b.d[2]'), 'none')",
+       "concat(json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, '$'))",
+       "json_extract_scalar(c0, '$.b.*')"},
+      data);
+
+  // The calls with supported paths read the fields of one shared expression.
+  const auto& shared = exprSet->expr(0)->inputs().at(0);
+  ASSERT_EQ(shared->name(), "$internal$json_extract_scalars");
+  ASSERT_EQ(exprSet->expr(1)->inputs().at(0), shared);
+  ASSERT_EQ(exprSet->expr(4)->name(), "json_extract_scalar");
+
+  // A single path per input is not rewritten.
+  exprSet = testExprSet(
+      {"json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c0, '$..a')"},
+      data);
+  ASSERT_EQ(exprSet->expr(0)->name(), "json_extract_scalar");
+}
+
 // simdjson, like Presto java, returns the large number as-is as a string,
 // without trying to convert it to an integer.
 TEST_F(JsonExtractScalarTest, overflow) {
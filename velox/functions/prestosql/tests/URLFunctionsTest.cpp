@@ -46,6 +46,26 @@ class URLFunctionsTest : public functions::test::FunctionBaseTest {
     EXPECT_EQ(extractFn("query", url), expectedQuery);
     EXPECT_EQ(extractPort(url), expectedPort);
   }
+
+  // Evaluates 'expressions' in one ExprSet and compares the results with the
+  // results of evaluating each expression alone.
+  std::unique_ptr<exec::ExprSet> testExprSet(
+      const std::vector<std::string>& expressions,
+      const RowVectorPtr& data) {
+    auto rowType = asRowType(data->type());
+    auto exprSet = compileExpressions(expressions, rowType);
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet->eval(rows, context, results);
+    for (auto i = 0; i < expressions.size(); ++i) {
+      SCOPED_TRACE(expressions[i]);
+      auto expected =
+          evaluate(*compileExpression(expressions[i], rowType), data);
+      velox::test::assertEqualVectors(expected, results[i]);
+    }
+    return exprSet;
+  }
 };
 
 TEST_F(URLFunctionsTest, validateURL) {
@@ -555,6 +575,48 @@ TEST_F(URLFunctionsTest, extractParameter) {
           "k3"));
 }
 
+TEST_F(URLFunctionsTest, sharedParse) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"http://example.com:8080/path1/p.php?k1=v1&k2=v2&k3#Ref1",
+           "https://ex%61mple.com/p%61th?k1=a%3Db&k2=%26#fr%61g",
+           std::nullopt,
+           "foo",
+           "http://example.com:99999999999999999999/path?k2=long",
+           "http://[2001:db8::1]/?k1=&k1=second",
+           // Not a valid URL.
+           "http://example.com/%ZZ?k1=v1",
+           "mailto:someone@example.com?k2=v2"}),
+      makeFlatVector<bool>(8, [](auto row) { return row % 2 == 0; }),
+  });
+
+  auto exprSet = testExprSet(
+      {"url_extract_host(c0)",
+       "url_extract_path(c0)",
+       "url_extract_port(c0)",
+       "if(c1, url_extract_parameter(c0, 'k1'), 'none')",
+       "concat(url_extract_protocol(c0), url_extract_parameter(c0, 'k2'))",
+       "url_extract_query(c0)",
+       "url_extract_fragment(c0)",
+       "url_extract_parameter(c0, url_extract_host(c0))"},
+      data);
+
+  // The calls read the fields of one shared expression.
+  const auto& shared = exprSet->expr(0)->inputs().at(0);
+  ASSERT_EQ(shared->name(), "$internal$url_extract_components");
+  ASSERT_EQ(exprSet->expr(2)->inputs().at(0), shared);
+  // A parameter that is not constant is not rewritten.
+  ASSERT_EQ(exprSet->expr(7)->name(), "url_extract_parameter");
+
+  // A single component per input is not rewritten.
+  exprSet = testExprSet(
+      {"url_extract_host(c0)",
+       "url_extract_host(c0)",
+       "url_extract_parameter(c0, c0)"},
+      data);
+  ASSERT_EQ(exprSet->expr(0)->name(), "url_extract_host");
+}
+
 TEST_F(URLFunctionsTest, urlEncode) {
   const auto urlEncode = [&](std::optional<std::string> value) {
     return evaluateOnce<std::string>("url_encode(c0)", value);
@@ -16,6 +16,8 @@
 
 #include "velox/functions/prestosql/types/BingTileType.h"
 #include <folly/Expected.h>
+#include <algorithm>
+#include <cmath>
 #include <optional>
 #include <string>
 
@@ -111,6 +113,70 @@ BingTileType::bingTileChildren(uint64_t tile, uint8_t childZoom) {
   return children;
 }
 
+namespace {
+// The size in pixels of a tile.
+constexpr int64_t kTilePixels = 256;
+
+// Returns the tile coordinate at 'axis' in [0, 1] for a map of 'mapSize'
+// pixels.
+uint32_t axisToCoordinate(double axis, int64_t mapSize) {
+  const auto pixel = std::clamp<int64_t>(
+      static_cast<int64_t>(axis * mapSize), 0, mapSize - 1);
+  return pixel / kTilePixels;
+}
+} // namespace
+
+folly::Expected<uint64_t, std::string>
+BingTileType::bingTileAt(double latitude, double longitude, int8_t zoom) {
+  if (FOLLY_UNLIKELY(
+          !(latitude >= kMinLatitude && latitude <= kMaxLatitude))) {
+    return folly::makeUnexpected(
+        std::string("Latitude must be between -85.05112878 and 85.05112878"));
+  }
+  if (FOLLY_UNLIKELY(
+          !(longitude >= kMinLongitude && longitude <= kMaxLongitude))) {
+    return folly::makeUnexpected(
+        std::string("Longitude must be between -180.0 and 180.0"));
+  }
+  if (FOLLY_UNLIKELY(zoom <= 0)) {
+    return folly::makeUnexpected(std::string("Zoom level must be > 0"));
+  }
+  if (FOLLY_UNLIKELY(zoom > kBingTileMaxZoomLevel)) {
+    return folly::makeUnexpected(
+        fmt::format("Zoom level must be <= {}", kBingTileMaxZoomLevel));
+  }
+
+  // The Mercator projection of the point to [0, 1] x [0, 1].
+  const double sinLatitude = std::sin(latitude * M_PI / 180);
+  const double x = (longitude + 180) / 360;
+  const double y = 0.5 -
+      std::log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+  const int64_t mapSize = kTilePixels << zoom;
+  return bingTileCoordsToInt(
+      axisToCoordinate(x, mapSize), axisToCoordinate(y, mapSize), zoom);
+}
+
+folly::Expected<std::vector<uint64_t>, std::string>
+BingTileType::bingTilesAround(double latitude, double longitude, int8_t zoom) {
+  const auto tile = bingTileAt(latitude, longitude, zoom);
+  if (FOLLY_UNLIKELY(tile.hasError())) {
+    return folly::makeUnexpected(tile.error());
+  }
+  const int64_t x = bingTileX(tile.value());
+  const int64_t y = bingTileY(tile.value());
+  const int64_t maxCoordinate = (1 << zoom) - 1;
+  std::vector<uint64_t> tiles;
+  tiles.reserve(9);
+  for (auto i = x - 1; i <= x + 1; ++i) {
+    for (auto j = y - 1; j <= y + 1; ++j) {
+      if (i >= 0 && i <= maxCoordinate && j >= 0 && j <= maxCoordinate) {
+        tiles.push_back(bingTileCoordsToInt(i, j, zoom));
+      }
+    }
+  }
+  return tiles;
+}
+
 folly::Expected<uint64_t, std::string> BingTileType::bingTileFromQuadKey(
     const std::string_view& quadKey) {
   size_t zoomLevelInt32 = quadKey.size();
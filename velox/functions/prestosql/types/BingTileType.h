@@ -89,6 +89,12 @@ class BingTileType : public BigintType {
   static constexpr uint8_t kBingTileZoomOffset = 31 - kBingTileZoomBitWidth;
   static constexpr uint64_t kBits23Mask = (1 << 24) - 1;
   static constexpr uint64_t kBits5Mask = (1 << 6) - 1;
+  // The latitudes and longitudes covered by the Mercator projection of the
+  // tiles.
+  static constexpr double kMinLatitude = -85.05112878;
+  static constexpr double kMaxLatitude = 85.05112878;
+  static constexpr double kMinLongitude = -180;
+  static constexpr double kMaxLongitude = 180;
 
   static inline uint64_t
   bingTileCoordsToInt(uint32_t x, uint32_t y, uint8_t zoom) {
@@ -140,6 +146,17 @@ class BingTileType : public BigintType {
       uint64_t tile,
       uint8_t childZoom);
 
+  /// Returns the tile at 'zoom' that contains the point at 'latitude' and
+  /// 'longitude'. The zoom is in [1, 23].
+  static folly::Expected<uint64_t, std::string>
+  bingTileAt(double latitude, double longitude, int8_t zoom);
+
+  /// Returns the tile at 'zoom' that contains the point at 'latitude' and
+  /// 'longitude' and its neighbors, i.e. the tiles within one tile of it in
+  /// each direction that exist.
+  static folly::Expected<std::vector<uint64_t>, std::string>
+  bingTilesAround(double latitude, double longitude, int8_t zoom);
+
   static folly::Expected<uint64_t, std::string> bingTileFromQuadKey(
       const std::string_view& quadKey);
 
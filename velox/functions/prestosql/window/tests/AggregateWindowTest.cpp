@@ -443,5 +443,39 @@ TEST_F(AggregateWindowTest, singlePartitionColumnForPrefixSort) {
       {"rows between unbounded preceding and unbounded following"});
 }
 
+// Tests sliding frames over a large partition. These remove the rows that
+// leave the frame for sum, count, avg and var_samp, and use a segment tree for
+// min and max.
+TEST_F(AggregateWindowTest, slidingFrames) {
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 2; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      // A long run of nulls checks the results of frames without input.
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return row % 97; },
+          [](auto row) { return row % 7 == 0 || (row >= 300 && row < 600); }),
+  });
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 50 preceding and 50 following",
+      "rows between current row and 100 following",
+      "rows between 20 following and 60 following",
+  };
+  for (const auto& function :
+       {"sum(c2)",
+        "count(c2)",
+        "avg(c2)",
+        "var_samp(c2)",
+        "min(c2)",
+        "max(c2)"}) {
+    SCOPED_TRACE(function);
+    WindowTestBase::testWindowFunction(
+        {input}, function, {"partition by c0 order by c1"}, frameClauses);
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
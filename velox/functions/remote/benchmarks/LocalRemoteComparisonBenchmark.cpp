@@ -30,6 +30,14 @@ using namespace facebook::velox;
 using namespace facebook::velox::functions;
 
 DEFINE_int32(batch_size, 1000, "Batch size for benchmarks");
+DEFINE_uint64(
+    request_payload_bytes,
+    2'000,
+    "Target request payload size of the pipelined remote functions");
+DEFINE_uint32(
+    requests_in_flight,
+    4,
+    "Maximum number of requests in flight of the pipelined remote functions");
 
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
@@ -46,10 +54,18 @@ int main(int argc, char** argv) {
                              .argumentType("bigint")
                              .build()};
   registerRemoteFunction("remote_plus", plusSignatures, metadata);
+  // Same function, but each batch is split into several pipelined requests.
+  RemoteVectorFunctionMetadata pipelinedMetadata = metadata;
+  pipelinedMetadata.targetRequestPayloadBytes = FLAGS_request_payload_bytes;
+  pipelinedMetadata.maxRequestsInFlight = FLAGS_requests_in_flight;
+  registerRemoteFunction(
+      "remote_plus_pipelined", plusSignatures, pipelinedMetadata);
   // Registers the actual function under a different prefix. This is only
   // needed when thrift service runs in the same process.
   registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
       {param.functionPrefix + ".remote_plus"});
+  registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+      {param.functionPrefix + ".remote_plus_pipelined"});
   // register this function again, because the benchmark builder somehow doesn't
   // recognize the function registered above (remote.xxx).
   registerFunction<PlusFunction, int64_t, int64_t, int64_t>({"plus"});
@@ -94,6 +110,7 @@ int main(int argc, char** argv) {
               {fuzzer.fuzzFlat(BIGINT()), fuzzer.fuzzFlat(BIGINT())}))
       .addExpression("local_plus", "plus(c0, c1) ")
       .addExpression("remote_plus", "remote_plus(c0, c1) ")
+      .addExpression("remote_plus_pipelined", "remote_plus_pipelined(c0, c1) ")
       .withIterations(1000);
 
   // benchmark comparaing SubstrFunction running locally (same thread)
@@ -17,6 +17,7 @@
 #include "velox/functions/remote/client/Remote.h"
 
 #include <folly/io/async/EventBase.h>
+#include <deque>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/remote/client/ThriftClient.h"
@@ -43,7 +44,10 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        targetRequestPayloadBytes_(metadata.targetRequestPayloadBytes),
+        maxRequestsInFlight_(
+            std::max<uint32_t>(1, metadata.maxRequestsInFlight)) {
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +89,69 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    const auto numRows = rows.end();
+    const auto rowsPerRequest = rowsPerRequestFor(*remoteRowVector);
+    if (rowsPerRequest >= numRows) {
+      auto response = waitForResponse(
+          sendRequest(remoteRowVector, numRows, outputType, context));
+      result = processResponse(response, 0, outputType, context);
+      return;
+    }
+
+    // Split the input into several requests and keep up to
+    // 'maxRequestsInFlight_' of them outstanding on the channel, so that the
+    // server processes one request while the next ones are serialized and
+    // sent.
+    result = BaseVector::create(outputType, numRows, context.pool());
+    std::deque<std::pair<
+        vector_size_t,
+        folly::SemiFuture<remote::RemoteFunctionResponse>>>
+        inFlight;
+    auto receiveOldest = [&]() {
+      auto [offset, future] = std::move(inFlight.front());
+      inFlight.pop_front();
+      auto response = waitForResponse(std::move(future));
+      auto output = processResponse(response, offset, outputType, context);
+      result->copy(output.get(), offset, 0, output->size());
+    };
+
+    for (vector_size_t offset = 0; offset < numRows; offset += rowsPerRequest) {
+      if (inFlight.size() >= maxRequestsInFlight_) {
+        receiveOldest();
+      }
+      const auto size = std::min(rowsPerRequest, numRows - offset);
+      auto slice = std::static_pointer_cast<RowVector>(
+          remoteRowVector->slice(offset, size));
+      inFlight.emplace_back(
+          offset, sendRequest(slice, size, outputType, context));
+    }
+    while (!inFlight.empty()) {
+      receiveOldest();
+    }
+  }
+
+  // Returns the number of rows to send in each request so that its payload
+  // stays around 'targetRequestPayloadBytes_'.
+  vector_size_t rowsPerRequestFor(const RowVector& input) const {
+    const auto numRows = input.size();
+    if (targetRequestPayloadBytes_ == 0 || numRows == 0) {
+      return numRows;
+    }
+    const auto bytesPerRow =
+        std::max<uint64_t>(1, input.estimateFlatSize() / numRows);
+    return std::max<vector_size_t>(
+        1,
+        static_cast<vector_size_t>(std::min<uint64_t>(
+            numRows, targetRequestPayloadBytes_ / bytesPerRow)));
+  }
+
+  // Serializes the first 'numRows' rows of 'input' and sends them to the
+  // server without waiting for the response.
+  folly::SemiFuture<remote::RemoteFunctionResponse> sendRequest(
+      const RowVectorPtr& input,
+      vector_size_t numRows,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,15 +161,22 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = numRows;
     requestInputs->pageFormat_ref() = serdeFormat_;
 
     // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(input, numRows, *context.pool(), serde_.get());
 
+    return thriftClient_->semifuture_invokeFunction(request);
+  }
+
+  // Waits for 'future' while driving the event loop, which also makes
+  // progress on the other requests in flight.
+  remote::RemoteFunctionResponse waitForResponse(
+      folly::SemiFuture<remote::RemoteFunctionResponse> future) const {
     try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
+      return std::move(future).via(&eventBase_).getVia(&eventBase_);
     } catch (const std::exception& e) {
       VELOX_FAIL(
           "Error while executing remote function '{}' at '{}': {}",
@@ -112,13 +184,20 @@ class RemoteFunction : public exec::VectorFunction {
           location_.describe(),
           e.what());
     }
+  }
 
+  // Deserializes the result of a request whose first row is row 'offset' of
+  // the input, and reports its errors at the corresponding input rows.
+  VectorPtr processResponse(
+      remote::RemoteFunctionResponse& remoteResponse,
+      vector_size_t offset,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     auto outputRowVector = IOBufToRowVector(
         remoteResponse.result().value().payload().value(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
 
     if (auto errorPayload = remoteResponse.result().value().errorPayload()) {
       auto errorsRowVector = IOBufToRowVector(
@@ -135,19 +214,24 @@ class RemoteFunction : public exec::VectorFunction {
         try {
           throw std::runtime_error(errorsVector->valueAt(i));
         } catch (const std::exception&) {
-          context.setError(i, std::current_exception());
+          context.setError(offset + i, std::current_exception());
         }
       });
     }
+    return outputRowVector->childAt(0);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Drives the requests issued by 'thriftClient_'. All requests of an
+  // apply() call share the client's channel.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const uint64_t targetRequestPayloadBytes_;
+  const uint32_t maxRequestsInFlight_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
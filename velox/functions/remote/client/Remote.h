@@ -30,6 +30,15 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Approximate payload size of a single request. Larger input batches are
+  /// split into several requests which are pipelined on the connection, so
+  /// that the remote processing of one request overlaps with serializing and
+  /// sending the next ones. 0 sends each input batch as a single request.
+  uint64_t targetRequestPayloadBytes{0};
+
+  /// Maximum number of requests of one input batch outstanding at a time.
+  uint32_t maxRequestsInFlight{4};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
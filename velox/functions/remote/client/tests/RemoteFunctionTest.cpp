@@ -114,6 +114,16 @@ class RemoteFunctionTest
                               .build()};
     registerRemoteFunction("remote_divide", divSignatures, metadata);
 
+    // Splits each batch into requests of about two rows, pipelined three at a
+    // time.
+    RemoteVectorFunctionMetadata pipelinedMetadata = metadata;
+    pipelinedMetadata.targetRequestPayloadBytes = 2 * 2 * sizeof(int64_t);
+    pipelinedMetadata.maxRequestsInFlight = 3;
+    registerRemoteFunction(
+        "remote_plus_pipelined", plusSignatures, pipelinedMetadata);
+    registerRemoteFunction(
+        "remote_divide_pipelined", divSignatures, pipelinedMetadata);
+
     auto substrSignatures = {exec::FunctionSignatureBuilder()
                                  .returnType("varchar")
                                  .argumentType("varchar")
@@ -135,6 +145,10 @@ class RemoteFunctionTest
         {params.functionPrefix + ".remote_fail"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {params.functionPrefix + ".remote_divide"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {params.functionPrefix + ".remote_plus_pipelined"});
+    registerFunction<CheckedDivideFunction, double, double, double>(
+        {params.functionPrefix + ".remote_divide_pipelined"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {params.functionPrefix + ".remote_substr"});
     registerFunction<OpaqueTypeFunction, int64_t, std::shared_ptr<Foo>>(
@@ -181,6 +195,32 @@ TEST_P(RemoteFunctionTest, tryException) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, pipelinedRequests) {
+  auto inputVector =
+      makeFlatVector<int64_t>(101, [](auto row) { return row; }, nullEvery(7));
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_pipelined(c0, c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>(
+      101, [](auto row) { return 2 * row; }, nullEvery(7));
+  assertEqualVectors(expected, results);
+}
+
+TEST_P(RemoteFunctionTest, pipelinedRequestsTryException) {
+  // Errors of later requests are reported at their rows in the input batch.
+  auto numeratorVector =
+      makeFlatVector<double>(20, [](auto row) { return row * 2; });
+  auto denominatorVector =
+      makeFlatVector<double>(20, [](auto row) { return row % 5 == 3 ? 0 : 2; });
+  auto data = makeRowVector({numeratorVector, denominatorVector});
+  auto results = evaluate<SimpleVector<double>>(
+      "TRY(remote_divide_pipelined(c0, c1))", data);
+
+  auto expected = makeFlatVector<double>(
+      20, [](auto row) { return row; }, [](auto row) { return row % 5 == 3; });
+  assertEqualVectors(expected, results);
+}
+
 TEST_P(RemoteFunctionTest, conditionalConjunction) {
   // conditional conjunction disables throwing on error.
   auto inputVector0 = makeFlatVector<bool>({true, true});
@@ -292,33 +292,61 @@ class RowVectorHasher : public SparkVectorHasher<HashClass> {
   std::vector<std::shared_ptr<SparkVectorHasher<HashClass>>> hashers_;
 };
 
-template <typename HashClass, typename ReturnType, typename ArgType>
-void hashSimdTyped(
-    const SelectivityVector* rows,
-    std::vector<VectorPtr>& args,
-    FlatVector<ReturnType>& result,
-    const int32_t hashIdx) {
-  const ArgType* __restrict rawA =
-      args[hashIdx]->asUnchecked<FlatVector<ArgType>>()->rawValues();
-  auto* __restrict rawResult = result.template mutableRawValues<ReturnType>();
-  rows->applyToSelected([&](auto row) {
-    rawResult[row] = hashOne<HashClass>(rawA[row], rawResult[row]);
-  });
+// Hashes the values of a primitive column in 'rows' into 'rawResult', which
+// holds the seed of each row on input. 'rows' must not contain nulls. Flat and
+// constant columns are hashed in tight loops over the values.
+template <typename HashClass, typename ReturnType, typename T>
+void hashPrimitive(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    ReturnType* __restrict rawResult) {
+  if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int128_t>) {
+    // Booleans are bit-packed and long decimals may be unaligned.
+    rows.applyToSelected([&](auto row) {
+      rawResult[row] =
+          hashOne<HashClass>(decoded.valueAt<T>(row), rawResult[row]);
+    });
+  } else if (decoded.isConstantMapping()) {
+    if (!rows.hasSelections()) {
+      return;
+    }
+    const T value = decoded.valueAt<T>(rows.begin());
+    rows.applyToSelected([&](auto row) {
+      rawResult[row] = hashOne<HashClass>(value, rawResult[row]);
+    });
+  } else if (decoded.isIdentityMapping()) {
+    const T* __restrict rawValues = decoded.data<T>();
+    rows.applyToSelected([&](auto row) {
+      rawResult[row] = hashOne<HashClass>(rawValues[row], rawResult[row]);
+    });
+  } else {
+    const T* rawValues = decoded.data<T>();
+    const vector_size_t* indices = decoded.indices();
+    rows.applyToSelected([&](auto row) {
+      rawResult[row] =
+          hashOne<HashClass>(rawValues[indices[row]], rawResult[row]);
+    });
+  }
 }
 
+// Hashes the values of 'decoded' in 'rows' into 'rawResult', which holds the
+// seed of each row on input. 'rows' must not contain nulls. Primitive columns
+// and the fields of flat struct columns are hashed a column at a time. Other
+// complex columns are hashed row by row with a SparkVectorHasher.
 template <typename HashClass, typename ReturnType>
-void hashSimd(
-    const SelectivityVector* rows,
-    std::vector<VectorPtr>& args,
-    FlatVector<ReturnType>& result,
-    const int32_t hashIdx) {
-  switch (args[hashIdx]->typeKind()) {
+void hashColumn(
+    const SelectivityVector& rows,
+    DecodedVector& decoded,
+    ReturnType* rawResult,
+    exec::EvalCtx& context) {
+  switch (decoded.base()->typeKind()) {
 #define SCALAR_CASE(kind) \
   case TypeKind::kind:    \
-    return hashSimdTyped< \
+    return hashPrimitive< \
         HashClass,        \
         ReturnType,       \
-        TypeTraits<TypeKind::kind>::NativeType>(rows, args, result, hashIdx);
+        TypeTraits<TypeKind::kind>::NativeType>(rows, decoded, rawResult);
+    SCALAR_CASE(BOOLEAN)
     SCALAR_CASE(TINYINT)
     SCALAR_CASE(SMALLINT)
     SCALAR_CASE(INTEGER)
@@ -329,11 +357,38 @@ void hashSimd(
     SCALAR_CASE(VARCHAR)
     SCALAR_CASE(VARBINARY)
     SCALAR_CASE(TIMESTAMP)
-    SCALAR_CASE(UNKNOWN)
 #undef SCALAR_CASE
+    case TypeKind::UNKNOWN:
+      // All values are null and hash to the seed.
+      return;
+    case TypeKind::ROW:
+      if (decoded.isIdentityMapping()) {
+        // Hashes the fields one after the other. A null field keeps the hash
+        // of the previous fields, as in RowVectorHasher.
+        const auto* row = decoded.base()->asUnchecked<RowVector>();
+        exec::LocalSelectivityVector selectedMinusNulls(context);
+        for (const auto& child : row->children()) {
+          exec::LocalDecodedVector decodedChild(context, *child, rows);
+          const SelectivityVector* selected = &rows;
+          if (decodedChild->mayHaveNulls()) {
+            *selectedMinusNulls.get(rows.end()) = rows;
+            selectedMinusNulls->deselectNulls(
+                decodedChild->nulls(&rows), rows.begin(), rows.end());
+            selected = selectedMinusNulls.get();
+          }
+          hashColumn<HashClass>(*selected, *decodedChild, rawResult, context);
+        }
+        return;
+      }
+      break;
     default:
-      VELOX_UNREACHABLE();
+      break;
   }
+
+  auto hasher = createVectorHasher<HashClass>(decoded);
+  rows.applyToSelected([&](auto row) {
+    rawResult[row] = hasher->hashNotNullAt(row, rawResult[row]);
+  });
 }
 
 // ReturnType can be either int32_t or int64_t
@@ -353,6 +408,7 @@ void applyWithType(
 
   auto& result = *resultRef->as<FlatVector<ReturnType>>();
   rows.applyToSelected([&](auto row) { result.set(row, hashSeed); });
+  auto* rawResult = result.mutableRawValues();
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
@@ -366,23 +422,7 @@ void applyWithType(
           decoded->nulls(&rows), rows.begin(), rows.end());
       selected = selectedMinusNulls.get();
     }
-
-    auto kind = args[i]->typeKind();
-    if ((kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
-         kind == TypeKind::INTEGER || kind == TypeKind::BIGINT ||
-         kind == TypeKind::REAL || kind == TypeKind::DOUBLE ||
-         kind == TypeKind::TIMESTAMP || kind == TypeKind::VARCHAR ||
-         kind == TypeKind::VARBINARY || kind == TypeKind::HUGEINT ||
-         kind == TypeKind::UNKNOWN) &&
-        args[i]->isFlatEncoding()) {
-      hashSimd<HashClass, ReturnType>(selected, args, result, i);
-      continue;
-    }
-
-    auto hasher = createVectorHasher<HashClass>(*decoded);
-    selected->applyToSelected([&](auto row) {
-      result.set(row, hasher->hashNotNullAt(row, result.valueAt(row)));
-    });
+    hashColumn<HashClass>(*selected, *decoded, rawResult, context);
   }
 }
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction final : public exec::VectorFunction {
+ public:
+  // 'serialized' is nullptr if the Bloom filter argument is null. The function
+  // is then only called for no rows.
+  explicit BloomFilterMightContainFunction(const StringView* serialized) {
+    if (serialized != nullptr) {
+      bloomFilter_.merge(serialized->str().c_str());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    context.ensureWritable(rows, BOOLEAN(), resultRef);
+    auto* result = resultRef->asUnchecked<FlatVector<bool>>();
+    result->clearNulls(rows);
+    auto* rawResult = result->mutableRawValues<uint64_t>();
+    if (!bloomFilter_.isSet()) {
+      bits::andWithNegatedBits(
+          rawResult, rows.asRange().bits(), rows.begin(), rows.end());
+      return;
+    }
+
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    const auto* values = decodedArgs.at(1);
+    std::vector<uint64_t> hashes(rows.end());
+    rows.applyToSelected([&](auto row) {
+      hashes[row] = folly::hasher<int64_t>()(values->valueAt<int64_t>(row));
+    });
+    std::vector<uint64_t> hits(bits::nwords(rows.end()));
+    bloomFilter_.mayContain(hashes.data(), rows.end(), hits.data());
+
+    // Copies the results of the selected rows.
+    const auto* selected = rows.asRange().bits();
+    for (auto i = 0; i < hits.size(); ++i) {
+      rawResult[i] = (rawResult[i] & ~selected[i]) | (hits[i] & selected[i]);
+    }
+  }
+
+ private:
+  BloomFilter<std::allocator<uint64_t>> bloomFilter_;
+};
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2);
+  const auto& serialized = inputArgs[0].constantValue;
+  VELOX_USER_CHECK_NOT_NULL(
+      serialized, "{} requires a constant Bloom filter argument", name);
+  if (serialized->isNullAt(0)) {
+    return std::make_shared<BloomFilterMightContainFunction>(nullptr);
+  }
+  const auto value = serialized->as<ConstantVector<StringView>>()->valueAt(0);
+  return std::make_shared<BloomFilterMightContainFunction>(&value);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  // varbinary, bigint -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .constantArgumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+} // namespace facebook::velox::functions::sparksql
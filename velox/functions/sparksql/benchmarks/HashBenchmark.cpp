@@ -44,6 +44,7 @@ int main(int argc, char** argv) {
       UNKNOWN(),
       ARRAY(MAP(INTEGER(), VARCHAR())),
       ROW({"f_map", "f_array"}, {MAP(INTEGER(), VARCHAR()), ARRAY(INTEGER())}),
+      ROW({"f_bigint", "f_varchar"}, {BIGINT(), VARCHAR()}),
   };
   for (auto nullRatio : {0.0, 0.25}) {
     for (auto& inputType : inputTypes) {
@@ -59,6 +60,18 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Several columns, as hashed for bucketing.
+  for (auto nullRatio : {0.0, 0.25}) {
+    benchmarkBuilder
+        .addBenchmarkSet(
+            fmt::format("hash#multiple_columns#{}\%nulls", nullRatio * 100),
+            ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()}))
+        .withFuzzerOptions({.vectorSize = 4096, .nullRatio = nullRatio})
+        .addExpression("hash", "hash(c0, c1, c2)")
+        .addExpression("xxhash64", "xxhash64(c0, c1, c2)")
+        .withIterations(100);
+  }
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
@@ -38,8 +38,8 @@ void registerBinaryFunctions(const std::string& prefix) {
       makeXxHash64WithSeed,
       hashMetadata());
   registerFunction<Md5Function, Varchar, Varbinary>({prefix + "md5"});
-  registerFunction<BloomFilterMightContainFunction, bool, Varbinary, int64_t>(
-      {prefix + "might_contain"});
+  exec::registerStatefulVectorFunction(
+      prefix + "might_contain", mightContainSignatures(), makeMightContain);
   registerFunction<Sha1HexStringFunction, Varchar, Varbinary>(
       {prefix + "sha1"});
   registerFunction<Sha2HexStringFunction, Varchar, Varbinary, int32_t>(
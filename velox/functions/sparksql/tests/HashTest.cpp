@@ -18,6 +18,7 @@
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 
 #include <stdint.h>
+#include <numeric>
 
 using facebook::velox::test::assertEqualVectors;
 
@@ -262,6 +263,40 @@ TEST_F(HashTest, row) {
   assertEqualVectors(makeFlatVector<int32_t>({42, 42}), hash(row));
 }
 
+TEST_F(HashTest, encodings) {
+  // Compares the column at a time hashing of 'vector' with the row by row
+  // hashing of single element arrays of its values, which is the same.
+  auto test = [&](const VectorPtr& vector) {
+    std::vector<vector_size_t> offsets(vector->size());
+    std::iota(offsets.begin(), offsets.end(), 0);
+    SCOPED_TRACE(vector->toString());
+    assertEqualVectors(hash(makeArrayVector(offsets, vector)), hash(vector));
+  };
+
+  const vector_size_t size = 5;
+  auto ints = makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4, 5});
+  auto strings = makeNullableFlatVector<std::string>(
+      {"a", "longer than inline", std::nullopt, "", "Spark"});
+  auto bools = makeNullableFlatVector<bool>({true, false, std::nullopt, true});
+  test(wrapInDictionary(makeIndicesInReverse(size), ints));
+  test(wrapInDictionary(makeIndicesInReverse(size), strings));
+  test(wrapInDictionary(makeIndicesInReverse(4), bools));
+  test(makeConstant<int64_t>(7, size));
+  test(BaseVector::wrapInConstant(size, 1, strings));
+  test(makeNullConstant(TypeKind::DOUBLE, size));
+
+  auto row = makeRowVector({
+      wrapInDictionary(makeIndicesInReverse(size), ints),
+      strings,
+      makeRowVector({ints, makeConstant<int32_t>(11, size)}),
+  });
+  test(row);
+  row->childAt(2)->setNull(3, true);
+  row->setNull(1, true);
+  test(row);
+  test(wrapInDictionary(makeIndicesInReverse(size), row));
+}
+
 TEST_F(HashTest, unknown) {
   assertEqualVectors(
       makeFlatVector<int32_t>({42, 42, 42}),
@@ -84,6 +84,43 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, batches) {
+  constexpr int32_t kSize = 1'000;
+  auto serialized = getSerializedBloomFilter(kSize);
+  BloomFilter bloomFilter;
+  bloomFilter.merge(serialized.data());
+
+  // Values in and not in the Bloom filter, with nulls, also behind a
+  // dictionary.
+  auto values = makeFlatVector<int64_t>(
+      2 * kSize,
+      [](auto row) { return row % 3 == 0 ? row / 3 : row * 7; },
+      [](auto row) { return row % 11 == 0; });
+  auto expected = makeFlatVector<bool>(
+      2 * kSize,
+      [&](auto row) {
+        return bloomFilter.mayContain(
+            folly::hasher<int64_t>()(values->valueAt(row)));
+      },
+      [](auto row) { return row % 11 == 0; });
+  testMightContain(serialized, values, expected);
+
+  auto indices = makeIndicesInReverse(2 * kSize);
+  testMightContain(
+      serialized,
+      wrapInDictionary(indices, values),
+      wrapInDictionary(indices, expected));
+}
+
+TEST_F(MightContainTest, emptyBloomFilter) {
+  BloomFilter bloomFilter;
+  std::string serialized(bloomFilter.serializedSize(), '\0');
+  bloomFilter.serialize(serialized.data());
+  auto value = makeNullableFlatVector<int64_t>({1, std::nullopt, 3});
+  auto expected = makeNullableFlatVector<bool>({false, std::nullopt, false});
+  testMightContain(serialized, value, expected);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
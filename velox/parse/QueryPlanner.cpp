@@ -348,20 +348,307 @@ TypedExprPtr toVeloxExpression(
   }
 }
 
+namespace {
+// The number of rows assumed for a table scan, which has no statistics.
+constexpr double kUnknownCardinality = 1'000'000;
+
+// Returns a rough estimate of the number of rows produced by 'node'. Values are
+// counted, a filter keeps half of its input and a join produces as many rows
+// as its larger input.
+double estimateCardinality(const PlanNode& node) {
+  if (auto* values = dynamic_cast<const ValuesNode*>(&node)) {
+    double numRows = 0;
+    for (const auto& vector : values->values()) {
+      numRows += vector->size();
+    }
+    return numRows;
+  }
+  if (dynamic_cast<const TableScanNode*>(&node)) {
+    return kUnknownCardinality;
+  }
+  if (dynamic_cast<const FilterNode*>(&node)) {
+    return estimateCardinality(*node.sources()[0]) / 2;
+  }
+  if (auto* aggregation = dynamic_cast<const AggregationNode*>(&node)) {
+    if (aggregation->groupingKeys().empty()) {
+      return 1;
+    }
+  }
+  double numRows = 0;
+  for (const auto& source : node.sources()) {
+    numRows = std::max(numRows, estimateCardinality(*source));
+  }
+  return numRows;
+}
+
+// Adds the inputs of the cross products under 'node' to 'inputs'.
+void collectCrossProductInputs(
+    const PlanNodePtr& node,
+    std::vector<PlanNodePtr>& inputs) {
+  auto* join = dynamic_cast<const NestedLoopJoinNode*>(node.get());
+  if (join && join->joinType() == JoinType::kInner &&
+      !join->joinCondition()) {
+    collectCrossProductInputs(join->sources()[0], inputs);
+    collectCrossProductInputs(join->sources()[1], inputs);
+    return;
+  }
+  inputs.push_back(node);
+}
+
+void splitConjuncts(
+    const TypedExprPtr& expr,
+    std::vector<TypedExprPtr>& conjuncts) {
+  auto* call = dynamic_cast<const CallTypedExpr*>(expr.get());
+  if (call && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      splitConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+TypedExprPtr makeConjunction(const std::vector<TypedExprPtr>& conjuncts) {
+  TypedExprPtr conjunction;
+  for (const auto& conjunct : conjuncts) {
+    if (!conjunction) {
+      conjunction = conjunct;
+    } else {
+      conjunction = std::make_shared<CallTypedExpr>(
+          BOOLEAN(), std::vector<TypedExprPtr>{conjunction, conjunct}, "and");
+    }
+  }
+  return conjunction;
+}
+
+// Adds the names of the input columns referenced by 'expr' to 'names'.
+void collectInputColumns(
+    const TypedExprPtr& expr,
+    std::unordered_set<std::string>& names) {
+  if (auto* field = dynamic_cast<const FieldAccessTypedExpr*>(expr.get())) {
+    if (field->isInputColumn()) {
+      names.insert(field->name());
+      return;
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectInputColumns(input, names);
+  }
+}
+
+RowTypePtr concatRowTypes(const RowType& left, const RowType& right) {
+  auto names = left.names();
+  auto types = left.children();
+  for (auto i = 0; i < right.size(); ++i) {
+    names.push_back(right.nameOf(i));
+    types.push_back(right.childAt(i));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+// Plans a filter over cross products of 'inputs' as a tree of hash joins. The
+// conjuncts of 'filter' that reference a single input are pushed down to that
+// input. Equalities between the columns of two inputs become join keys and the
+// rest of the conjuncts are evaluated by the first join that has all of their
+// columns. The joins are ordered greedily: the largest input is the probe side
+// and the smallest input that has a join key with the inputs joined so far is
+// added as the build side of the next join. Inputs with no join keys are added
+// last with cross joins. Returns a plan with the columns of 'outputType'.
+PlanNodePtr planCrossProductJoins(
+    std::vector<PlanNodePtr> inputs,
+    const TypedExprPtr& filter,
+    const RowTypePtr& outputType,
+    QueryContext& queryContext) {
+  std::unordered_map<std::string, int32_t> columnInputs;
+  for (auto i = 0; i < inputs.size(); ++i) {
+    for (const auto& name : inputs[i]->outputType()->names()) {
+      columnInputs[name] = i;
+    }
+  }
+
+  std::vector<TypedExprPtr> conjuncts;
+  splitConjuncts(filter, conjuncts);
+
+  struct Conjunct {
+    TypedExprPtr expr;
+    std::unordered_set<int32_t> inputs;
+  };
+  struct JoinEdge {
+    int32_t leftInput;
+    FieldAccessTypedExprPtr leftKey;
+    int32_t rightInput;
+    FieldAccessTypedExprPtr rightKey;
+  };
+  std::vector<std::vector<TypedExprPtr>> pushedDown(inputs.size());
+  std::vector<Conjunct> remaining;
+  std::vector<JoinEdge> edges;
+  for (const auto& conjunct : conjuncts) {
+    std::unordered_set<std::string> names;
+    collectInputColumns(conjunct, names);
+    std::unordered_set<int32_t> conjunctInputs;
+    for (const auto& name : names) {
+      conjunctInputs.insert(columnInputs.at(name));
+    }
+    if (conjunctInputs.size() == 1) {
+      pushedDown[*conjunctInputs.begin()].push_back(conjunct);
+      continue;
+    }
+    auto* call = dynamic_cast<const CallTypedExpr*>(conjunct.get());
+    if (call && call->name() == "eq" && conjunctInputs.size() == 2) {
+      auto left = std::dynamic_pointer_cast<const FieldAccessTypedExpr>(
+          call->inputs()[0]);
+      auto right = std::dynamic_pointer_cast<const FieldAccessTypedExpr>(
+          call->inputs()[1]);
+      if (left && right && left->isInputColumn() && right->isInputColumn() &&
+          left->type()->equivalent(*right->type())) {
+        edges.push_back(
+            {columnInputs.at(left->name()),
+             left,
+             columnInputs.at(right->name()),
+             right});
+        continue;
+      }
+    }
+    remaining.push_back({conjunct, std::move(conjunctInputs)});
+  }
+
+  std::vector<double> cardinalities;
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (!pushedDown[i].empty()) {
+      inputs[i] = std::make_shared<FilterNode>(
+          queryContext.nextNodeId(),
+          makeConjunction(pushedDown[i]),
+          std::move(inputs[i]));
+    }
+    cardinalities.push_back(estimateCardinality(*inputs[i]));
+  }
+
+  int32_t probe = 0;
+  for (auto i = 1; i < inputs.size(); ++i) {
+    if (cardinalities[i] > cardinalities[probe]) {
+      probe = i;
+    }
+  }
+  std::vector<bool> joined(inputs.size(), false);
+  joined[probe] = true;
+  auto result = inputs[probe];
+  auto resultCardinality = cardinalities[probe];
+
+  for (auto numJoined = 1; numJoined < inputs.size(); ++numJoined) {
+    int32_t build = -1;
+    for (const auto& edge : edges) {
+      for (auto candidate : {edge.leftInput, edge.rightInput}) {
+        const auto other =
+            candidate == edge.leftInput ? edge.rightInput : edge.leftInput;
+        if (!joined[candidate] && joined[other] &&
+            (build == -1 || cardinalities[candidate] < cardinalities[build])) {
+          build = candidate;
+        }
+      }
+    }
+
+    std::vector<FieldAccessTypedExprPtr> leftKeys;
+    std::vector<FieldAccessTypedExprPtr> rightKeys;
+    if (build == -1) {
+      for (auto i = 0; i < inputs.size(); ++i) {
+        if (!joined[i] &&
+            (build == -1 || cardinalities[i] < cardinalities[build])) {
+          build = i;
+        }
+      }
+    } else {
+      for (const auto& edge : edges) {
+        if (edge.rightInput == build && joined[edge.leftInput]) {
+          leftKeys.push_back(edge.leftKey);
+          rightKeys.push_back(edge.rightKey);
+        } else if (edge.leftInput == build && joined[edge.rightInput]) {
+          leftKeys.push_back(edge.rightKey);
+          rightKeys.push_back(edge.leftKey);
+        }
+      }
+    }
+    joined[build] = true;
+
+    std::vector<TypedExprPtr> joinFilters;
+    for (auto it = remaining.begin(); it != remaining.end();) {
+      if (std::all_of(it->inputs.begin(), it->inputs.end(), [&](auto input) {
+            return joined[input];
+          })) {
+        joinFilters.push_back(it->expr);
+        it = remaining.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    auto joinOutputType = concatRowTypes(
+        result->outputType()->asRow(), inputs[build]->outputType()->asRow());
+    if (leftKeys.empty()) {
+      result = std::make_shared<NestedLoopJoinNode>(
+          queryContext.nextNodeId(),
+          JoinType::kInner,
+          makeConjunction(joinFilters),
+          std::move(result),
+          inputs[build],
+          std::move(joinOutputType));
+      resultCardinality *= cardinalities[build];
+    } else {
+      result = std::make_shared<HashJoinNode>(
+          queryContext.nextNodeId(),
+          JoinType::kInner,
+          false,
+          std::move(leftKeys),
+          std::move(rightKeys),
+          makeConjunction(joinFilters),
+          std::move(result),
+          inputs[build],
+          std::move(joinOutputType));
+      resultCardinality = std::max(resultCardinality, cardinalities[build]);
+    }
+  }
+
+  VELOX_CHECK(remaining.empty());
+
+  // The parent refers to the columns by position.
+  if (*result->outputType() == *outputType) {
+    return result;
+  }
+  std::vector<TypedExprPtr> projections;
+  for (auto i = 0; i < outputType->size(); ++i) {
+    projections.push_back(std::make_shared<FieldAccessTypedExpr>(
+        outputType->childAt(i), outputType->nameOf(i)));
+  }
+  return std::make_shared<ProjectNode>(
+      queryContext.nextNodeId(),
+      outputType->names(),
+      std::move(projections),
+      std::move(result));
+}
+} // namespace
+
 PlanNodePtr toVeloxPlan(
     ::duckdb::LogicalFilter& logicalFilter,
     memory::MemoryPool* pool,
     std::vector<PlanNodePtr> sources,
     QueryContext& queryContext) {
-  TypedExprPtr veloxFilter;
+  std::vector<TypedExprPtr> conjuncts;
   for (auto& expr : logicalFilter.expressions) {
-    auto conjunct = toVeloxExpression(*expr, sources[0]->outputType());
-    if (!veloxFilter) {
-      veloxFilter = conjunct;
-    } else {
-      veloxFilter = std::make_shared<CallTypedExpr>(
-          BOOLEAN(), std::vector<TypedExprPtr>{veloxFilter, conjunct}, "and");
-    }
+    conjuncts.push_back(toVeloxExpression(*expr, sources[0]->outputType()));
+  }
+  auto veloxFilter = makeConjunction(conjuncts);
+
+  // DuckDB plans the joins in a FROM clause with a list of tables as cross
+  // products with a filter on top, because the optimizer is disabled.
+  std::vector<PlanNodePtr> inputs;
+  if (!queryContext.isInDelimJoin) {
+    collectCrossProductInputs(sources[0], inputs);
+  }
+  if (inputs.size() > 1) {
+    return planCrossProductJoins(
+        std::move(inputs),
+        veloxFilter,
+        asRowType(sources[0]->outputType()),
+        queryContext);
   }
   return std::make_shared<FilterNode>(
       queryContext.nextNodeId(), std::move(veloxFilter), std::move(sources[0]));
@@ -58,6 +58,15 @@ class QueryPlannerTest : public testing::Test {
         std::vector<VectorPtr>{});
   }
 
+  RowVectorPtr makeRowVector(const RowTypePtr& rowType, vector_size_t size) {
+    std::vector<VectorPtr> children;
+    for (const auto& type : rowType->children()) {
+      children.push_back(BaseVector::create(type, size, pool_.get()));
+    }
+    return std::make_shared<RowVector>(
+        pool_.get(), rowType, nullptr, size, std::move(children));
+  }
+
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
 };
@@ -117,10 +126,45 @@ TEST_F(QueryPlannerTest, tableScan) {
       "SELECT t.a, t.b, t.c, u.b FROM t, u WHERE t.a = u.a",
       inMemoryTables,
       "-- Project[4]\n"
-      "  -- Filter[3]\n"
-      "    -- NestedLoopJoin[2]\n"
-      "      -- Values[0]\n"
-      "      -- Values[1]\n");
+      "  -- HashJoin[3]\n"
+      "    -- Values[0]\n"
+      "    -- Values[1]\n");
+}
+
+TEST_F(QueryPlannerTest, joinOrder) {
+  std::unordered_map<std::string, std::vector<RowVectorPtr>> inMemoryTables = {
+      {"t", {makeRowVector(ROW({"a", "b"}, {BIGINT(), INTEGER()}), 1'000)}},
+      {"u", {makeRowVector(ROW({"a", "c"}, {BIGINT(), BIGINT()}), 100)}},
+      {"v", {makeRowVector(ROW({"c", "d"}, {BIGINT(), DOUBLE()}), 10)}},
+  };
+
+  // The largest table is the probe side. The other tables are the build sides
+  // in the order of the join keys. The filter on 'v' is pushed down and the
+  // columns are projected in the order of the FROM clause.
+  assertPlan(
+      "SELECT t.b, v.d FROM u, t, v "
+      "WHERE t.a = u.a AND u.c = v.c AND v.d > 0.5",
+      inMemoryTables,
+      "-- Project[9]\n"
+      "  -- Project[8]\n"
+      "    -- HashJoin[7]\n"
+      "      -- HashJoin[6]\n"
+      "        -- Values[1]\n"
+      "        -- Values[0]\n"
+      "      -- Filter[5]\n"
+      "        -- Values[3]\n");
+
+  // A table with no join keys is cross joined last.
+  assertPlan(
+      "SELECT t.b, v.d FROM v, t, u WHERE t.a = u.a",
+      inMemoryTables,
+      "-- Project[8]\n"
+      "  -- Project[7]\n"
+      "    -- NestedLoopJoin[6]\n"
+      "      -- HashJoin[5]\n"
+      "        -- Values[1]\n"
+      "        -- Values[3]\n"
+      "      -- Values[0]\n");
 }
 
 TEST_F(QueryPlannerTest, customScalarFunctions) {
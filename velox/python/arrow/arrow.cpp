@@ -23,8 +23,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "velox/python/type/PyType.h"
+
 #include "velox/python/init/PyInit.h"
 #include "velox/python/vector/PyVector.h"
+#include "velox/vector/arrow/Abi.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace py = pybind11;
@@ -33,9 +36,12 @@ namespace py = pybind11;
 /// conversion between Velox Vectors and Arrow Arrays from a Python program. It
 /// works by extracting the Arrow C structures from the Arrow C++ Array, then
 /// using Velox's Arrow bridge to convert it to a Velox Vector (and vice-versa).
+/// `to_arrow_stream()` exposes a sequence of Velox Vectors, e.g. the output of
+/// a LocalRunner, as a pyarrow.RecordBatchReader.
 PYBIND11_MODULE(arrow, m) {
   using namespace facebook;
 
+  py::module::import("pyvelox.type");
   py::module::import("pyvelox.vector");
 
   arrow::py::import_pyarrow();
@@ -121,5 +127,88 @@ Converts a velox vector to an arrow object.
     >>> vec = pv.from_list([1, 2, 3, 4, 5])
     >>> arrow = to_arrow(vec)
 
+)pbdoc");
+
+  /// Exports an iterable of pyvelox.vector.Vector (of ROW type) as a
+  /// pyarrow.RecordBatchReader using Velox's Arrow stream export. Batches are
+  /// only pulled from the iterable as the reader consumes them.
+  m.def(
+      "to_arrow_stream",
+      [](py::iterable& vectors, std::optional<velox::py::PyType> type) {
+        auto toRowVector = [](py::handle item) {
+          auto rowVector = std::dynamic_pointer_cast<velox::RowVector>(
+              item.cast<velox::py::PyVector&>().vector());
+          if (rowVector == nullptr) {
+            throw std::runtime_error("Arrow streams require ROW vectors.");
+          }
+          return rowVector;
+        };
+
+        // Arrow consumers such as RecordBatchReader.read_all() release the
+        // GIL, so it has to be re-acquired to advance and destroy the
+        // iterator.
+        auto iterator = std::shared_ptr<py::iterator>(
+            new py::iterator(py::iter(vectors)), [](py::iterator* it) {
+              py::gil_scoped_acquire acquire;
+              delete it;
+            });
+
+        // Without an explicit type, the first vector defines the schema.
+        velox::RowVectorPtr first;
+        velox::RowTypePtr rowType;
+        if (type.has_value()) {
+          rowType = velox::asRowType(type->type());
+          if (rowType == nullptr) {
+            throw std::runtime_error("Arrow streams require a ROW type.");
+          }
+        } else if (*iterator != py::iterator::sentinel()) {
+          first = toRowVector(**iterator);
+          ++*iterator;
+          rowType = velox::asRowType(first->type());
+        } else {
+          throw std::runtime_error(
+              "The type is required to export an empty stream.");
+        }
+
+        auto nextBatch = [iterator, first, toRowVector]() mutable {
+          if (first != nullptr) {
+            return std::move(first);
+          }
+          py::gil_scoped_acquire acquire;
+          if (*iterator == py::iterator::sentinel()) {
+            return velox::RowVectorPtr{};
+          }
+          auto batch = toRowVector(**iterator);
+          ++*iterator;
+          return batch;
+        };
+
+        ArrowArrayStream stream;
+        velox::exportToArrowStream(
+            rowType, std::move(nextBatch), stream, leafPool);
+
+        // RecordBatchReader._import_from_c() moves the stream out, so it can
+        // be released from Python once the reader is done.
+        return py::module::import("pyarrow")
+            .attr("RecordBatchReader")
+            .attr("_import_from_c")(reinterpret_cast<uintptr_t>(&stream));
+      },
+      py::arg("vectors"),
+      py::arg("type") = std::nullopt,
+      R"pbdoc(
+Exports an iterable of velox vectors as an arrow record batch reader.
+
+:param vectors: Iterable of ROW vectors, e.g. LocalRunner.execute().
+:param type: Optional ROW type of the vectors. Required if the iterable
+             may be empty; otherwise defaults to the first vector's type.
+
+:examples:
+
+.. doctest::
+
+    >>> runner = LocalRunner(plan_builder.get_plan_node())
+    >>> table = to_arrow_stream(runner.execute()).read_all()
+    >>> df = table.to_pandas()
+
 )pbdoc");
 }
@@ -16,10 +16,14 @@
 
 # pyre-unsafe
 
-from typing import List
+from typing import Iterable, List, Optional
 
+from pyvelox.type import Type
 from pyvelox.vector import Vector
-from pyarrow import Array
+from pyarrow import Array, RecordBatchReader
 
 def to_velox(array: Array) -> Vector: ...
 def to_arrow(vector: Vector) -> Array: ...
+def to_arrow_stream(
+    vectors: Iterable[Vector], type: Optional[Type] = None
+) -> RecordBatchReader: ...
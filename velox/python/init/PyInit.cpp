@@ -28,6 +28,10 @@
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
 
+#ifdef VELOX_ENABLE_PARQUET
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#endif
+
 namespace facebook::velox::py {
 
 folly::once_flag registerOnceFlag;
@@ -38,6 +42,10 @@ void registerAllResourcesOnce() {
   // Register file readers and writers.
   velox::dwrf::registerDwrfWriterFactory();
   velox::dwrf::registerDwrfReaderFactory();
+#ifdef VELOX_ENABLE_PARQUET
+  // pyarrow datasets are usually parquet.
+  velox::parquet::registerParquetReaderFactory();
+#endif
 
   velox::dwio::common::LocalFileSink::registerFactory();
 
@@ -47,11 +47,14 @@ PyVector PyTaskIterator::Iterator::operator*() const {
 }
 
 void PyTaskIterator::Iterator::advance() {
-  if (cursor_ && cursor_->moveNext()) {
-    vector_ = cursor_->current();
-  } else {
-    vector_ = nullptr;
+  bool hasNext = false;
+  if (cursor_) {
+    // The drivers do not call into Python, so the GIL is not needed until the
+    // next vector is produced.
+    py::gil_scoped_release release;
+    hasNext = cursor_->moveNext();
   }
+  vector_ = hasNext ? cursor_->current() : nullptr;
 }
 
 PyLocalRunner::PyLocalRunner(
@@ -74,6 +77,21 @@ void PyLocalRunner::addFileSplit(
           connectorId, pyFile.filePath(), pyFile.fileFormat()));
 }
 
+void PyLocalRunner::addDatasetSplits(
+    const py::object& dataset,
+    const std::string& planId,
+    const std::string& connectorId) {
+  if (!py::hasattr(dataset, "files") || !py::hasattr(dataset, "format")) {
+    throw std::runtime_error(
+        "Only pyarrow FileSystemDatasets can be added as splits.");
+  }
+  const auto format =
+      dataset.attr("format").attr("default_extname").cast<std::string>();
+  for (const auto& file : dataset.attr("files")) {
+    addFileSplit(PyFile(file.cast<std::string>(), format), planId, connectorId);
+  }
+}
+
 void PyLocalRunner::addQueryConfig(
     const std::string& configName,
     const std::string& configValue) {
@@ -51,6 +51,18 @@ class PyLocalRunner {
       const std::string& planId,
       const std::string& connectorId);
 
+  /// Add a split for each file of a pyarrow.dataset.FileSystemDataset. The
+  /// drivers of the scan read the splits in parallel.
+  ///
+  /// @param dataset The pyarrow dataset. Its file paths must be readable by
+  /// the connector, e.g. local files.
+  /// @param planId The plan node ID of the scan.
+  /// @param connectorId The connector used by the scan.
+  void addDatasetSplits(
+      const pybind11::object& dataset,
+      const std::string& planId,
+      const std::string& connectorId);
+
   /// Add a query configuration parameter. These values are passed to the Velox
   /// Task through a query context object.
   ///
@@ -60,7 +72,9 @@ class PyLocalRunner {
       const std::string& configName,
       const std::string& configValue);
 
-  /// Execute the task and returns an iterable to the output vectors.
+  /// Execute the task and returns an iterable to the output vectors. The
+  /// iterator releases the GIL while it waits for the next output vector, so
+  /// that other Python threads run while the drivers execute.
   ///
   /// @param maxDrivers Maximum number of drivers to use when executing the
   /// plan.
@@ -48,7 +48,9 @@ PYBIND11_MODULE(runner, m) {
           py::arg("max_drivers") = 1,
           py::doc(R"(
         Executes a given plan returning an iterator to the output produced
-        by the root plan node.
+        by the root plan node. The iterator releases the GIL while the plan
+        runs. Wrap it in pyvelox.arrow.to_arrow_stream() to consume the
+        output as arrow record batches without copies.
 
         Args:
           max_drivers: Maximum number of drivers (threads) to use when
@@ -78,6 +80,24 @@ PYBIND11_MODULE(runner, m) {
                    file/split with.
           connector_id: The id of the connector used by the scan.
           )"))
+      .def(
+          "add_dataset_splits",
+          &velox::py::PyLocalRunner::addDatasetSplits,
+          py::arg("dataset"),
+          py::arg("plan_id"),
+          py::arg("connector_id") = "prism",
+          py::doc(R"(
+        Add a split for each file of a pyarrow dataset, and associate them to
+        the plan node described by plan_id. The splits are read in parallel
+        by up to max_drivers drivers.
+
+        Args:
+          dataset: A pyarrow.dataset.FileSystemDataset over files that the
+                   connector can read, e.g. local parquet files.
+          plan_id: The plan node id of the scan to associate the splits
+                   with.
+          connector_id: The id of the connector used by the scan.
+          )"))
       .def(
           "add_query_config",
           &velox::py::PyLocalRunner::addQueryConfig,
@@ -15,6 +15,9 @@
  */
 #include "velox/row/UnsafeRowFast.h"
 
+#include "velox/common/memory/RawVector.h"
+#include "velox/row/UnsafeRowDeserializers.h"
+
 namespace facebook::velox::row {
 
 namespace {
@@ -32,6 +35,104 @@ int32_t alignBytes(int32_t numBytes) {
 bool isFixedWidth(const TypePtr& type) {
   return type->isFixedWidth() && !type->isLongDecimal();
 }
+
+// Writes the fixed-width values of the field at 'childIdx' of the structs at
+// 'rows' into the field slot of each serialized row. 'rowBuffers[i]' is the
+// start of the i-th serialized row and 'nullBytes' the size of its null flags.
+template <TypeKind kind>
+void serializeTyped(
+    const raw_vector<vector_size_t>& rows,
+    uint32_t childIdx,
+    const DecodedVector& decoded,
+    size_t valueBytes,
+    size_t nullBytes,
+    const raw_vector<char*>& rowBuffers) {
+  const auto fieldOffset = nullBytes + childIdx * kFieldWidth;
+  const auto writeValue = [&](auto i) {
+    char* field = rowBuffers[i] + fieldOffset;
+    if constexpr (kind == TypeKind::BOOLEAN) {
+      *reinterpret_cast<bool*>(field) = decoded.valueAt<bool>(rows[i]);
+    } else if constexpr (kind == TypeKind::TIMESTAMP) {
+      *reinterpret_cast<int64_t*>(field) =
+          decoded.valueAt<Timestamp>(rows[i]).toMicros();
+    } else {
+      ::memcpy(
+          field,
+          decoded.data<char>() + decoded.index(rows[i]) * valueBytes,
+          valueBytes);
+    }
+  };
+
+  if (!decoded.mayHaveNulls()) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      writeValue(i);
+    }
+    return;
+  }
+  for (auto i = 0; i < rows.size(); ++i) {
+    if (decoded.isNullAt(rows[i])) {
+      bits::setBit(rowBuffers[i], childIdx, true);
+    } else {
+      writeValue(i);
+    }
+  }
+}
+
+template <>
+void serializeTyped<TypeKind::UNKNOWN>(
+    const raw_vector<vector_size_t>& rows,
+    uint32_t childIdx,
+    const DecodedVector& /* unused */,
+    size_t /* unused */,
+    size_t /* unused */,
+    const raw_vector<char*>& rowBuffers) {
+  for (auto i = 0; i < rows.size(); ++i) {
+    bits::setBit(rowBuffers[i], childIdx, true);
+  }
+}
+
+// Reads the fixed-width field at 'field' of each row in 'data' into a flat
+// vector. 'nullBytes' is the size of the null flags of the rows.
+template <TypeKind kind>
+VectorPtr deserializeFixedWidth(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    uint32_t field,
+    size_t nullBytes,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const auto numRows = data.size();
+  auto vector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
+  auto* rawNulls = vector->mutableRawNulls();
+  const auto fieldOffset = nullBytes + field * kFieldWidth;
+  vector_size_t nullCount = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    const char* serialized = data[row].data();
+    if (bits::isBitSet(serialized, field)) {
+      bits::setNull(rawNulls, row, true);
+      ++nullCount;
+      continue;
+    }
+    const char* value = serialized + fieldOffset;
+    if constexpr (kind == TypeKind::BOOLEAN) {
+      vector->set(row, *reinterpret_cast<const bool*>(value));
+    } else if constexpr (kind == TypeKind::TIMESTAMP) {
+      vector->set(
+          row,
+          Timestamp::fromMicros(*reinterpret_cast<const int64_t*>(value)));
+    } else if constexpr (TypeTraits<kind>::isFixedWidth) {
+      T fixedWidthValue;
+      ::memcpy(&fixedWidthValue, value, sizeof(T));
+      vector->set(row, fixedWidthValue);
+    } else {
+      VELOX_UNREACHABLE("Unexpected type: {}", type->toString());
+    }
+  }
+  if (nullCount == 0) {
+    vector->resetNulls();
+  }
+  return vector;
+}
 } // namespace
 
 // static
@@ -133,8 +234,29 @@ void UnsafeRowFast::serializedRowSizes(
     return;
   }
 
-  for (const auto& row : rows) {
-    *sizes[row] = rowSize(row) + sizeof(TRowSize);
+  const int32_t fixedSize =
+      rowNullBytes_ + children_.size() * kFieldWidth + sizeof(TRowSize);
+  for (const auto row : rows) {
+    *sizes[row] = fixedSize;
+  }
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    const auto& child = children_[i];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (const auto row : rows) {
+      const auto childIndex = decoded_.index(row);
+      if (mayHaveNulls && child.isNullAt(childIndex)) {
+        continue;
+      }
+      *sizes[row] += isString
+          ? alignBytes(child.decoded_.valueAt<StringView>(childIndex).size())
+          : alignBytes(child.variableWidthRowSize(childIndex));
+    }
   }
 }
 
@@ -172,6 +294,14 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) const {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  serializeRow(offset, size, buffer, bufferOffsets);
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer)
     const {
   VELOX_DCHECK(fixedWidthTypeKind_);
@@ -425,4 +555,115 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) const {
 
   return variableWidthOffset;
 }
+
+void UnsafeRowFast::serializeRow(
+    vector_size_t offset,
+    vector_size_t size,
+    char* buffer,
+    const size_t* bufferOffsets) const {
+  raw_vector<vector_size_t> rows(size);
+  if (decoded_.isIdentityMapping()) {
+    std::iota(rows.begin(), rows.end(), offset);
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      rows[i] = decoded_.index(offset + i);
+    }
+  }
+
+  // Start of each row and the offset of its variable-width data from there.
+  // The offsets advance as the variable-width columns are written.
+  raw_vector<char*> rowBuffers(size);
+  raw_vector<int64_t> variableWidthOffsets(size);
+  for (auto i = 0; i < size; ++i) {
+    rowBuffers[i] = buffer + bufferOffsets[i];
+    variableWidthOffsets[i] = rowNullBytes_ + kFieldWidth * children_.size();
+  }
+
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    auto& child = children_[childIdx];
+    if (childIsFixedWidth_[childIdx]) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          serializeTyped,
+          child.typeKind_,
+          rows,
+          childIdx,
+          child.decoded_,
+          child.valueBytes_,
+          rowNullBytes_,
+          rowBuffers);
+      continue;
+    }
+
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (auto i = 0; i < size; ++i) {
+      char* row = rowBuffers[i];
+      if (mayHaveNulls && child.isNullAt(rows[i])) {
+        bits::setBit(row, childIdx, true);
+        continue;
+      }
+
+      auto& variableWidthOffset = variableWidthOffsets[i];
+      int32_t valueSize;
+      if (isString) {
+        const auto value = child.decoded_.valueAt<StringView>(rows[i]);
+        ::memcpy(row + variableWidthOffset, value.data(), value.size());
+        valueSize = value.size();
+      } else {
+        valueSize =
+            child.serializeVariableWidth(rows[i], row + variableWidthOffset);
+      }
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | valueSize;
+      reinterpret_cast<uint64_t*>(row + rowNullBytes_)[childIdx] =
+          sizeAndOffset;
+
+      variableWidthOffset += alignBytes(valueSize);
+    }
+  }
+}
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  const size_t numFields = rowType->size();
+  const size_t nullBytes = alignBits(numFields);
+
+  std::vector<VectorPtr> fields;
+  fields.reserve(numFields);
+  // Values of a variable-width or UNKNOWN field, formatted for
+  // UnsafeRowDeserializer.
+  std::vector<std::optional<std::string_view>> fieldData;
+  for (auto i = 0; i < numFields; ++i) {
+    const auto& type = rowType->childAt(i);
+    if (isFixedWidth(type) && !type->isUnKnown()) {
+      fields.emplace_back(VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          deserializeFixedWidth, type->kind(), type, data, i, nullBytes, pool));
+      continue;
+    }
+
+    fieldData.resize(numRows);
+    for (auto row = 0; row < numRows; ++row) {
+      const char* serialized = data[row].data();
+      if (bits::isBitSet(serialized, i)) {
+        fieldData[row] = std::nullopt;
+        continue;
+      }
+      const auto sizeAndOffset = *reinterpret_cast<const uint64_t*>(
+          serialized + nullBytes + i * kFieldWidth);
+      fieldData[row] = std::string_view(
+          serialized + (sizeAndOffset >> 32),
+          static_cast<uint32_t>(sizeAndOffset));
+    }
+    fields.emplace_back(
+        UnsafeRowDeserializer::deserialize(fieldData, type, pool));
+  }
+
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, numRows, std::move(fields));
+}
 } // namespace facebook::velox::row
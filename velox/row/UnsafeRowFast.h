@@ -24,9 +24,8 @@ class UnsafeRowFast {
  public:
   explicit UnsafeRowFast(const RowVectorPtr& vector);
 
-  /// Returns the serialized sizes of the rows at specified row indexes.
-  ///
-  /// TODO: optimizes using columnar serialization size calculation.
+  /// Returns the serialized sizes of the rows at specified row indexes. Adds up
+  /// the variable-width parts one column at a time.
   void serializedRowSizes(
       const folly::Range<const vector_size_t*>& rows,
       vector_size_t** sizes) const;
@@ -43,6 +42,27 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
 
+  /// Serializes rows in the range [offset, offset + size) into 'buffer' at
+  /// given 'bufferOffsets'. 'buffer' must have sufficient capacity and set to
+  /// all zeros for null-bits handling. 'bufferOffsets' must be pre-filled with
+  /// the write offsets for each row and must be accessible for 'size' elements.
+  /// The caller must ensure that the space between each offset in
+  /// 'bufferOffsets' is no less than the 'fixedRowSize' or 'rowSize'. Writes
+  /// one column of all rows at a time.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
+  /// Deserializes multiple rows into a RowVector of specified type. The type
+  /// must match the contents of the serialized rows. Fixed-width top-level
+  /// columns are read straight out of the rows into flat vectors.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -110,6 +130,14 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer) const;
 
+  /// Serializes struct values in range [offset, offset + size) to buffer.
+  /// Value must not be null.
+  void serializeRow(
+      vector_size_t offset,
+      vector_size_t size,
+      char* buffer,
+      const size_t* bufferOffsets) const;
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -97,8 +97,8 @@ class UnsafeRowFuzzTests : public ::testing::Test {
       memory::memoryManager()->addLeafPool();
 };
 
-TEST_F(UnsafeRowFuzzTests, fast) {
-  auto rowType = ROW({
+RowTypePtr fuzzRowType() {
+  return ROW({
       BOOLEAN(),
       TINYINT(),
       SMALLINT(),
@@ -161,6 +161,10 @@ TEST_F(UnsafeRowFuzzTests, fast) {
       ARRAY({ROW({BIGINT(), VARCHAR()})}),
       MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
   });
+}
+
+TEST_F(UnsafeRowFuzzTests, fast) {
+  auto rowType = fuzzRowType();
 
   doTest(rowType, [&](const RowVectorPtr& data) {
     const auto numRows = data->size();
@@ -195,5 +199,41 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, batch) {
+  auto rowType = fuzzRowType();
+
+  std::vector<char> batchBuffer;
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    const auto numRows = data->size();
+    UnsafeRowFast fast(data);
+
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += fast.rowSize(i);
+    }
+    batchBuffer.assign(totalSize, 0);
+    fast.serialize(0, numRows, offsets.data(), batchBuffer.data());
+
+    std::vector<std::optional<std::string_view>> serialized;
+    std::vector<std::string_view> serializedRows;
+    for (auto i = 0; i < numRows; ++i) {
+      const auto rowSize = fast.serialize(i, buffers_[i]);
+      EXPECT_EQ(rowSize, fast.rowSize(i));
+      EXPECT_EQ(
+          std::string_view(buffers_[i], rowSize),
+          std::string_view(batchBuffer.data() + offsets[i], rowSize))
+          << i << ", " << data->toString(i);
+      serialized.push_back(std::string_view(buffers_[i], rowSize));
+      serializedRows.push_back(serialized.back().value());
+    }
+
+    assertEqualVectors(
+        data, UnsafeRowFast::deserialize(serializedRows, rowType, pool_.get()));
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -34,6 +34,11 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
   for (int i = 0; i < numTypes; ++i) {
     streams_.emplace_back(
         types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
+    if (opts.dictionaryEncodeStrings &&
+        (types[i]->kind() == TypeKind::VARCHAR ||
+         types[i]->kind() == TypeKind::VARBINARY)) {
+      streams_.back().enableStringDictionary();
+    }
   }
 }
 
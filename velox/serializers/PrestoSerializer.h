@@ -80,6 +80,13 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true, the IterativeVectorSerializer writes each top level VARCHAR or
+    /// VARBINARY column as a dictionary of its distinct values in the page, or
+    /// as a constant if there is a single distinct value. Falls back to flat
+    /// when the values are mostly distinct. Used for shuffles where the same
+    /// strings repeat across the input batches of a destination.
+    bool dictionaryEncodeStrings{false};
   };
 
   PrestoVectorSerde() : VectorSerde(Kind::kPresto) {}
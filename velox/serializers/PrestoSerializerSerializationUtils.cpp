@@ -484,6 +484,19 @@ void appendStrings(
     const StringView* views,
     VectorStream* stream,
     Scratch& scratch) {
+  if (stream->isStringDictionaryStream()) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      if (nulls != nullptr && !bits::isBitSet(nulls, i)) {
+        stream->appendNull();
+        continue;
+      }
+      const auto& view = views[rows[i]];
+      stream->appendNonNull();
+      stream->appendDictionaryString(
+          std::string_view(view.data(), view.size()));
+    }
+    return;
+  }
   if (nulls == nullptr) {
     stream->appendLengths(nullptr, rows, rows.size(), [&](auto row) {
       return views[row].size();
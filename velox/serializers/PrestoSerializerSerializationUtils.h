@@ -200,8 +200,13 @@ inline void flushSerialization(
   if (listener) {
     listener->resume();
   }
-  for (auto range : *iobuf) {
-    output->write(reinterpret_cast<const char*>(range.data()), range.size());
+  if (auto* iobufOutput = dynamic_cast<IOBufOutputStream*>(output)) {
+    // 'iobuf' owns its memory or keeps its arena alive.
+    iobufOutput->append(iobuf->clone());
+  } else {
+    for (auto range : *iobuf) {
+      output->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
   }
   // Pause CRC computation
   if (listener) {
@@ -296,7 +301,15 @@ inline FlushSizes flushCompressed(
 
   writeInt32(output, numRows);
 
-  IOBufOutputStream out(*(arena.pool()), nullptr, arena.size());
+  // The uncompressed streams are referenced if 'output' may reference them.
+  std::shared_ptr<StreamArena> sourceArena;
+  if (auto* iobufOutput = dynamic_cast<IOBufOutputStream*>(output)) {
+    if (iobufOutput->sourceArena().get() == &arena) {
+      sourceArena = iobufOutput->sourceArena();
+    }
+  }
+  IOBufOutputStream out(
+      *(arena.pool()), nullptr, arena.size(), std::move(sourceArena));
   writeInt32(&out, streams.size());
 
   for (auto& stream : streams) {
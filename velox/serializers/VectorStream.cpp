@@ -55,8 +55,29 @@ raw_vector<uint64_t>& threadTempNulls() {
   thread_local raw_vector<uint64_t> temp;
   return temp;
 }
+
+// Stops collecting distinct strings when they take more than this many bytes.
+constexpr int64_t kMaxStringDictionaryBytes = 1 << 20;
+
+// Stops collecting distinct strings when more than half of the rows are
+// distinct after this many rows.
+constexpr size_t kMinRowsForDistinctCheck = 1'000;
+
+void writeEncodingName(OutputStream* out, std::string_view name) {
+  writeInt32(out, name.size());
+  out->write(name.data(), name.size());
+}
 } // namespace
 
+StringDictionary::StringDictionary(
+    const TypePtr& type,
+    StreamArena* streamArena,
+    const PrestoVectorSerde::PrestoOptions& opts)
+    : allocationPool(streamArena->pool()),
+      values(type, std::nullopt, std::nullopt, streamArena, 1, opts),
+      indices(memory::StlAllocator<int32_t>(*streamArena->pool())),
+      views(memory::StlAllocator<std::string_view>(*streamArena->pool())) {}
+
 VectorStream::VectorStream(
     const TypePtr& type,
     std::optional<VectorEncoding::Simple> encoding,
@@ -186,6 +207,129 @@ void VectorStream::appendNulls(
   nulls_.appendBitsFresh(invertedNulls, firstBit, firstBit + numRows);
 }
 
+void VectorStream::enableStringDictionary() {
+  VELOX_CHECK(
+      type_->kind() == TypeKind::VARCHAR ||
+          type_->kind() == TypeKind::VARBINARY,
+      "String dictionary is not supported for {}",
+      type_->toString());
+  VELOX_CHECK_EQ(nullCount_ + nonNullCount_, 0);
+  stringDictionaryEnabled_ = true;
+  stringDictionary_ =
+      std::make_unique<StringDictionary>(type_, streamArena_, opts_);
+}
+
+void VectorStream::appendDictionaryString(std::string_view value) {
+  if (!stringDictionary_) {
+    // Flattened by an earlier value.
+    appendLength(value.size());
+    values_.appendStringView(value);
+    return;
+  }
+  auto& dictionary = *stringDictionary_;
+  dictionary.flatBytes += value.size();
+  auto it = dictionary.ids.find(value);
+  if (it != dictionary.ids.end()) {
+    dictionary.indices.push_back(it->second);
+    return;
+  }
+
+  std::string_view copy;
+  if (!value.empty()) {
+    char* data = dictionary.allocationPool.allocateFixed(value.size());
+    ::memcpy(data, value.data(), value.size());
+    copy = std::string_view(data, value.size());
+  }
+  const int32_t index = dictionary.views.size();
+  dictionary.ids.emplace(copy, index);
+  dictionary.views.push_back(copy);
+  dictionary.values.appendNonNull();
+  dictionary.values.appendOne(StringView(copy.data(), copy.size()));
+  dictionary.distinctBytes += copy.size();
+  dictionary.indices.push_back(index);
+
+  if (dictionary.distinctBytes > kMaxStringDictionaryBytes ||
+      (dictionary.indices.size() >= kMinRowsForDistinctCheck &&
+       dictionary.views.size() * 2 > dictionary.indices.size())) {
+    flattenStringDictionary();
+  }
+}
+
+void VectorStream::appendDictionaryNull() {
+  auto& dictionary = *stringDictionary_;
+  if (dictionary.nullIndex < 0) {
+    dictionary.nullIndex = dictionary.views.size();
+    dictionary.views.emplace_back();
+    dictionary.values.appendNull();
+  }
+  dictionary.indices.push_back(dictionary.nullIndex);
+}
+
+void VectorStream::flattenStringDictionary() {
+  auto dictionary = std::move(stringDictionary_);
+  for (auto index : dictionary->indices) {
+    const auto& view = dictionary->views[index];
+    appendLength(view.size());
+    if (!view.empty()) {
+      values_.appendStringView(view);
+    }
+  }
+}
+
+void VectorStream::flushStringDictionary(OutputStream* out) {
+  auto& dictionary = *stringDictionary_;
+  const int32_t numRows = dictionary.indices.size();
+  const int32_t numDistinct = dictionary.views.size();
+  if (numDistinct == 1 && nullCount_ == 0) {
+    writeEncodingName(out, kRLE);
+    writeInt32(out, numRows);
+    dictionary.values.flush(out);
+    return;
+  }
+
+  // The indices take the place of the lengths, so the dictionary is smaller
+  // if the distinct values and their lengths are smaller than all values.
+  if (numRows > 0 &&
+      dictionary.distinctBytes + numDistinct * sizeof(int32_t) <
+          dictionary.flatBytes) {
+    writeEncodingName(out, kDictionary);
+    writeInt32(out, numRows);
+    dictionary.values.flush(out);
+    out->write(
+        reinterpret_cast<const char*>(dictionary.indices.data()),
+        numRows * sizeof(int32_t));
+    // Write 24 bytes of 'instance id'.
+    int64_t unused{0};
+    writeInt64(out, unused);
+    writeInt64(out, unused);
+    writeInt64(out, unused);
+    return;
+  }
+
+  out->write(reinterpret_cast<char*>(header_.buffer), header_.size);
+  writeInt32(out, numRows);
+  constexpr int32_t kBatchSize = 256;
+  int32_t lengths[kBatchSize];
+  int32_t totalLength = 0;
+  for (int32_t i = 0; i < numRows; i += kBatchSize) {
+    const auto numLengths = std::min(kBatchSize, numRows - i);
+    for (auto j = 0; j < numLengths; ++j) {
+      totalLength += dictionary.views[dictionary.indices[i + j]].size();
+      lengths[j] = totalLength;
+    }
+    out->write(
+        reinterpret_cast<const char*>(lengths), numLengths * sizeof(int32_t));
+  }
+  flushNulls(out);
+  writeInt32(out, totalLength);
+  for (auto index : dictionary.indices) {
+    const auto& view = dictionary.views[index];
+    if (!view.empty()) {
+      out->write(view.data(), view.size());
+    }
+  }
+}
+
 void VectorStream::flattenStream(
     const VectorPtr& vector,
     int32_t initialNumRows) {
@@ -206,6 +350,10 @@ void VectorStream::flattenStream(
 }
 
 void VectorStream::flush(OutputStream* out) {
+  if (stringDictionary_) {
+    flushStringDictionary(out);
+    return;
+  }
   out->write(reinterpret_cast<char*>(header_.buffer), header_.size);
 
   if (encoding_.has_value()) {
@@ -327,6 +475,10 @@ void VectorStream::clear() {
   for (auto& child : children_) {
     child.clear();
   }
+  if (stringDictionaryEnabled_) {
+    stringDictionary_ =
+        std::make_unique<StringDictionary>(type_, streamArena_, opts_);
+  }
 }
 
 size_t VectorStream::serializedSize() {
@@ -15,11 +15,16 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/AllocationPool.h"
 #include "velox/common/memory/StreamArena.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/BaseVector.h"
 
 namespace facebook::velox::serializer::presto::detail {
+struct StringDictionary;
+
 // Appendable container for serialized values. To append a value at a
 // time, call appendNull or appendNonNull first. Then call appendLength if the
 // type has a length. A null value has a length of 0. Then call appendValue if
@@ -90,7 +95,9 @@ class VectorStream {
     }
     nulls_.appendBool(true, 1);
     ++nullCount_;
-    if (hasLengths_) {
+    if (stringDictionary_) {
+      appendDictionaryNull();
+    } else if (hasLengths_) {
       appendLength(0);
     }
   }
@@ -161,6 +168,20 @@ class VectorStream {
     return opts_.preserveEncodings;
   }
 
+  /// Makes a VARCHAR or VARBINARY stream collect the distinct values and
+  /// write them once per flush with the rows as indices into them. See
+  /// PrestoOptions::dictionaryEncodeStrings. Stays in effect after clear().
+  void enableStringDictionary();
+
+  /// True if the string values are appended with appendDictionaryString().
+  bool isStringDictionaryStream() const {
+    return stringDictionary_ != nullptr;
+  }
+
+  /// Appends a non-null string to a stream with enableStringDictionary(), also
+  /// after it has fallen back to flat. appendNonNull() must be called first.
+  void appendDictionaryString(std::string_view value);
+
   VectorStream* childAt(int32_t index) {
     return &children_[index];
   }
@@ -204,6 +225,16 @@ class VectorStream {
       std::optional<VectorPtr> vector,
       vector_size_t initialNumRows);
 
+  void appendDictionaryNull();
+
+  // Writes the rows of a string dictionary stream as RLE, DICTIONARY or flat,
+  // whichever is the smallest.
+  void flushStringDictionary(OutputStream* out);
+
+  // Appends the rows collected in 'stringDictionary_' as flat and stops
+  // collecting distinct values until clear().
+  void flattenStringDictionary();
+
   const TypePtr type_;
   StreamArena* const streamArena_;
   const bool isLongDecimal_;
@@ -223,10 +254,42 @@ class VectorStream {
   std::vector<VectorStream, memory::StlAllocator<VectorStream>> children_;
   bool isDictionaryStream_{false};
   bool isConstantStream_{false};
+  bool stringDictionaryEnabled_{false};
+  // Set while the string values are collected as distinct values.
+  std::unique_ptr<StringDictionary> stringDictionary_;
+};
+
+// Distinct values of a string stream and the indices of its rows into them.
+struct StringDictionary {
+  StringDictionary(
+      const TypePtr& type,
+      StreamArena* streamArena,
+      const PrestoVectorSerde::PrestoOptions& opts);
+
+  // Holds the bytes of the distinct values.
+  memory::AllocationPool allocationPool;
+  folly::F14FastMap<std::string_view, int32_t> ids;
+  // Distinct values in the order of their indices, flat. Contains a null if
+  // 'nullIndex' is set.
+  VectorStream values;
+  int32_t nullIndex{-1};
+  // Index into 'values' for each row.
+  std::vector<int32_t, memory::StlAllocator<int32_t>> indices;
+  // Views of the distinct values in the order of their indices.
+  std::vector<std::string_view, memory::StlAllocator<std::string_view>> views;
+  // Total bytes of the distinct and of all values.
+  int64_t distinctBytes{0};
+  int64_t flatBytes{0};
 };
 
 template <>
 inline void VectorStream::append(folly::Range<const StringView*> values) {
+  if (stringDictionary_) {
+    for (auto& value : values) {
+      appendDictionaryString(std::string_view(value.data(), value.size()));
+    }
+    return;
+  }
   for (auto& value : values) {
     auto size = value.size();
     appendLength(size);
@@ -125,6 +125,8 @@ class PrestoSerializerTest
         serdeOptions == nullptr ? false : serdeOptions->preserveEncodings;
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind, 0.8, nullsFirst, preserveEncodings};
+    paramOptions.dictionaryEncodeStrings =
+        serdeOptions != nullptr && serdeOptions->dictionaryEncodeStrings;
 
     return paramOptions;
   }
@@ -1379,6 +1381,59 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   }
 }
 
+TEST_P(PrestoSerializerTest, dictionaryEncodeStrings) {
+  constexpr vector_size_t kSize = 2'000;
+  auto data = makeRowVector({
+      // Few distinct values and nulls.
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) { return fmt::format("repeated string {}", row % 7); },
+          nullEvery(11)),
+      // A single distinct value.
+      makeFlatVector<std::string>(
+          kSize, [](auto /*row*/) { return "the same string in all rows"; }),
+      // All distinct.
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("distinct {}", row); }),
+      // Repeated values of a dictionary input.
+      wrapInDictionary(
+          makeIndices(kSize, [](auto row) { return row % 3; }),
+          makeFlatVector<std::string>({"", "abcdefghijklmnopqrstuvwxyz", "x"})),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+  });
+  const auto rowType = asRowType(data->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions;
+  serdeOptions.dictionaryEncodeStrings = true;
+  std::vector<vector_size_t> rows(kSize);
+  std::iota(rows.begin(), rows.end(), 0);
+  for (const bool byRows : {false, true}) {
+    SCOPED_TRACE(fmt::format("byRows: {}", byRows));
+    std::ostringstream out;
+    if (byRows) {
+      serialize(data, &out, &serdeOptions, std::nullopt, rows);
+    } else {
+      serialize(data, &out, &serdeOptions);
+    }
+    auto deserialized = deserialize(rowType, out.str(), &serdeOptions);
+    assertEqualVectors(data, deserialized);
+    EXPECT_EQ(
+        deserialized->childAt(0)->encoding(),
+        VectorEncoding::Simple::DICTIONARY);
+    EXPECT_EQ(
+        deserialized->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+    EXPECT_EQ(
+        deserialized->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+    EXPECT_EQ(
+        deserialized->childAt(3)->encoding(),
+        VectorEncoding::Simple::DICTIONARY);
+
+    std::ostringstream flatOut;
+    serialize(data, &flatOut, nullptr);
+    EXPECT_LT(out.str().size(), flatOut.str().size());
+  }
+}
+
 TEST_P(PrestoSerializerTest, emptyVectorBatchVectorSerializer) {
   // Serialize an empty RowVector.
   auto rowVector = makeEmptyTestVector();
@@ -23,6 +23,27 @@
 namespace facebook::velox::substrait {
 
 TypePtr SubstraitParser::parseType(const ::substrait::Type& substraitType) {
+  switch (substraitType.kind_case()) {
+    case ::substrait::Type::KindCase::kStruct:
+    case ::substrait::Type::KindCase::kList:
+    case ::substrait::Type::KindCase::kMap: {
+      auto key = substraitType.SerializeAsString();
+      auto it = complexTypes_.find(key);
+      if (it != complexTypes_.end()) {
+        return it->second;
+      }
+      auto type = parseTypeUncached(substraitType);
+      complexTypes_.emplace(std::move(key), type);
+      return type;
+    }
+    default:
+      // The other types are singletons.
+      return parseTypeUncached(substraitType);
+  }
+}
+
+TypePtr SubstraitParser::parseTypeUncached(
+    const ::substrait::Type& substraitType) {
   switch (substraitType.kind_case()) {
     case ::substrait::Type::KindCase::kBool:
       return BOOLEAN();
@@ -144,18 +165,17 @@ int SubstraitParser::getIdxFromNodeName(const std::string& nodeName) {
 const std::string& SubstraitParser::findFunctionSpec(
     const std::unordered_map<uint64_t, std::string>& functionMap,
     uint64_t id) const {
-  if (functionMap.find(id) == functionMap.end()) {
+  auto it = functionMap.find(id);
+  if (it == functionMap.end()) {
     VELOX_FAIL("Could not find function id {} in function map.", id);
   }
-  std::unordered_map<uint64_t, std::string>& map =
-      const_cast<std::unordered_map<uint64_t, std::string>&>(functionMap);
-  return map[id];
+  return it->second;
 }
 
 std::string SubstraitParser::findVeloxFunction(
     const std::unordered_map<uint64_t, std::string>& functionMap,
     uint64_t id) const {
-  std::string funcSpec = findFunctionSpec(functionMap, id);
+  const auto& funcSpec = findFunctionSpec(functionMap, id);
   std::string_view funcName = getNameBeforeDelimiter(funcSpec, ":");
   return mapToVeloxFunction({funcName.begin(), funcName.end()});
 }
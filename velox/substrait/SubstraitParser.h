@@ -25,6 +25,8 @@
 #include "velox/substrait/proto/substrait/type.pb.h"
 #include "velox/substrait/proto/substrait/type_expressions.pb.h"
 
+#include <folly/container/F14Map.h>
+
 #include "velox/type/Type.h"
 
 namespace facebook::velox::substrait {
@@ -37,7 +39,9 @@ class SubstraitParser {
   std::vector<TypePtr> parseNamedStruct(
       const ::substrait::NamedStruct& namedStruct);
 
-  /// Parse Substrait Type.
+  /// Parse Substrait Type. Struct, list and map types are parsed once per
+  /// parser and then returned from a cache, so that converting many plans
+  /// with the same parser does not build the same types again.
   TypePtr parseType(const ::substrait::Type& substraitType);
 
   /// Parse Substrait ReferenceSegment.
@@ -82,6 +86,13 @@ class SubstraitParser {
   static std::vector<TypePtr> getInputTypes(const std::string& signature);
 
  private:
+  /// Parses a Substrait type that is not in 'complexTypes_'.
+  TypePtr parseTypeUncached(const ::substrait::Type& substraitType);
+
+  /// The parsed struct, list and map types keyed by their serialized Substrait
+  /// type.
+  folly::F14FastMap<std::string, TypePtr> complexTypes_;
+
   /// A map used for mapping Substrait function keywords into Velox functions'
   /// keywords. Key: the Substrait function keyword, Value: the Velox function
   /// keyword. For those functions with different names in Substrait and Velox,
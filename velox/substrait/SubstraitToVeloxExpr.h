@@ -17,6 +17,7 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <folly/container/F14Map.h>
 #include "velox/core/Expressions.h"
 #include "velox/substrait/SubstraitParser.h"
 #include "velox/vector/ComplexVector.h"
@@ -27,13 +28,19 @@ namespace facebook::velox::substrait {
 /// expressions.
 class SubstraitVeloxExprConverter {
  public:
-  /// subParser: A Substrait parser used to convert Substrait representations
-  /// into recognizable representations. functionMap: A pre-constructed map
-  /// storing the relations between the function id and the function name.
+  /// functionMap: A pre-constructed map storing the relations between the
+  /// function id and the function name. substraitParser: A Substrait parser
+  /// used to convert Substrait representations into recognizable
+  /// representations. Passing the parser of the plan converter shares its
+  /// cache of parsed types across the plans of a session.
   explicit SubstraitVeloxExprConverter(
       memory::MemoryPool* pool,
-      const std::unordered_map<uint64_t, std::string>& functionMap)
-      : pool_(pool), functionMap_(functionMap) {}
+      const std::unordered_map<uint64_t, std::string>& functionMap,
+      std::shared_ptr<SubstraitParser> substraitParser =
+          std::make_shared<SubstraitParser>())
+      : pool_(pool),
+        substraitParser_(std::move(substraitParser)),
+        functionMap_(functionMap) {}
 
   /// Convert Substrait Field into Velox Field Expression.
   std::shared_ptr<const core::FieldAccessTypedExpr> toVeloxExpr(
@@ -65,20 +72,52 @@ class SubstraitVeloxExprConverter {
       const RowTypePtr& inputType);
 
  private:
+  struct TypedExprHasher {
+    size_t operator()(const core::ITypedExpr* expr) const {
+      return expr->hash();
+    }
+  };
+
+  struct TypedExprComparer {
+    bool operator()(const core::ITypedExpr* lhs, const core::ITypedExpr* rhs)
+        const {
+      return *lhs == *rhs;
+    }
+  };
+
   /// Convert list literal to ArrayVector.
   ArrayVectorPtr literalsToArrayVector(
       const ::substrait::Expression::Literal& listLiteral);
 
+  /// Returns the Velox name of the function with id 'functionId'.
+  const std::string& findVeloxFunction(uint64_t functionId);
+
+  /// Returns an expression equal to 'expr' that was converted before, or
+  /// 'expr' if there is none, so that repeated subexpressions of the plan
+  /// share one tree.
+  core::TypedExprPtr dedup(core::TypedExprPtr expr);
+
   /// Memory pool.
   memory::MemoryPool* pool_;
 
   /// The Substrait parser used to convert Substrait representations into
   /// recognizable representations.
-  SubstraitParser substraitParser_;
+  std::shared_ptr<SubstraitParser> substraitParser_;
 
   /// The map storing the relations between the function id and the function
   /// name.
   std::unordered_map<uint64_t, std::string> functionMap_;
+
+  /// The Velox names of the functions in 'functionMap_' that were looked up.
+  folly::F14FastMap<uint64_t, std::string> veloxFunctionNames_;
+
+  /// The calls converted so far, keyed by the call itself.
+  folly::F14FastMap<
+      const core::ITypedExpr*,
+      core::TypedExprPtr,
+      TypedExprHasher,
+      TypedExprComparer>
+      calls_;
 };
 
 } // namespace facebook::velox::substrait
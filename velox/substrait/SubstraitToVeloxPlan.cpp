@@ -132,7 +132,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   for (const auto& measure : aggRel.measures()) {
     core::FieldAccessTypedExprPtr mask;
-    ::substrait::Expression substraitAggMask = measure.filter();
+    const auto& substraitAggMask = measure.filter();
     // Get Aggregation Masks.
     if (measure.has_filter()) {
       if (substraitAggMask.ByteSizeLong() > 0) {
@@ -561,8 +561,8 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   constructFunctionMap(substraitPlan);
 
   // Construct the expression converter.
-  exprConverter_ =
-      std::make_shared<SubstraitVeloxExprConverter>(pool_, functionMap_);
+  exprConverter_ = std::make_shared<SubstraitVeloxExprConverter>(
+      pool_, functionMap_, substraitParser_);
 
   // In fact, only one RelRoot or Rel is expected here.
   VELOX_CHECK_EQ(substraitPlan.relations_size(), 1);
@@ -648,25 +648,25 @@ common::SubfieldFilters SubstraitVeloxPlanConverter::toVeloxFilter(
   flattenConditions(substraitFilter, scalarFunctions);
   // Construct the FilterInfo for the related column.
   for (const auto& scalarFunction : scalarFunctions) {
-    auto filterNameSpec = substraitParser_->findFunctionSpec(
+    const auto& filterNameSpec = substraitParser_->findFunctionSpec(
         functionMap_, scalarFunction.function_reference());
     auto filterName = getNameBeforeDelimiter(filterNameSpec, ":");
     int32_t colIdx;
     // TODO: Add different types' support here.
     double val;
     for (auto& arg : scalarFunction.arguments()) {
-      auto argExpr = arg.value();
+      const auto& argExpr = arg.value();
       auto typeCase = argExpr.rex_type_case();
       switch (typeCase) {
         case ::substrait::Expression::RexTypeCase::kSelection: {
-          auto sel = argExpr.selection();
+          const auto& sel = argExpr.selection();
           // TODO: Only direct reference is considered here.
-          auto dRef = sel.direct_reference();
+          const auto& dRef = sel.direct_reference();
           colIdx = substraitParser_->parseReferenceSegment(dRef);
           break;
         }
         case ::substrait::Expression::RexTypeCase::kLiteral: {
-          auto sLit = argExpr.literal();
+          const auto& sLit = argExpr.literal();
           // TODO: Only double is considered here.
           val = sLit.fp64();
           break;
@@ -734,8 +734,8 @@ void SubstraitVeloxPlanConverter::flattenConditions(
   auto typeCase = substraitFilter.rex_type_case();
   switch (typeCase) {
     case ::substrait::Expression::RexTypeCase::kScalarFunction: {
-      auto sFunc = substraitFilter.scalar_function();
-      auto filterNameSpec = substraitParser_->findFunctionSpec(
+      const auto& sFunc = substraitFilter.scalar_function();
+      const auto& filterNameSpec = substraitParser_->findFunctionSpec(
           functionMap_, sFunc.function_reference());
       // TODO: Only and relation is supported here.
       if (getNameBeforeDelimiter(filterNameSpec, ":") == "and") {
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/dwio/common/tests/utils/DataFiles.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+#include "velox/substrait/tests/JsonToProtoConverter.h"
+
+// Measures the latency of converting Substrait plans to Velox plans, once with
+// a new converter per plan and once with a converter that is reused for all
+// the plans of a session, as engines that submit a plan per stage do.
+
+namespace facebook::velox::substrait {
+namespace {
+
+constexpr int32_t kNumPlans = 100;
+
+class PlanConversionBenchmark {
+ public:
+  PlanConversionBenchmark() : pool_(memory::memoryManager()->addLeafPool()) {
+    for (const auto* name : {"q1_first_stage.json", "q6_first_stage.json"}) {
+      ::substrait::Plan plan;
+      JsonToProtoConverter::readFromFile(
+          test::getDataFilePath(
+              "velox/substrait/tests", fmt::format("data/{}", name)),
+          plan);
+      plans_.push_back(std::move(plan));
+    }
+  }
+
+  void convert(int32_t planIndex, bool reuseConverter) {
+    std::optional<SubstraitVeloxPlanConverter> session;
+    for (auto i = 0; i < kNumPlans; ++i) {
+      if (!session.has_value() || !reuseConverter) {
+        session.emplace(pool_.get());
+      }
+      auto plan = session->toVeloxPlan(plans_[planIndex]);
+      folly::doNotOptimizeAway(plan);
+    }
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::vector<::substrait::Plan> plans_;
+};
+
+std::unique_ptr<PlanConversionBenchmark> benchmark;
+
+BENCHMARK(q1NewConverter) {
+  benchmark->convert(0, false);
+}
+
+BENCHMARK_RELATIVE(q1SessionConverter) {
+  benchmark->convert(0, true);
+}
+
+BENCHMARK(q6NewConverter) {
+  benchmark->convert(1, false);
+}
+
+BENCHMARK_RELATIVE(q6SessionConverter) {
+  benchmark->convert(1, true);
+}
+
+} // namespace
+} // namespace facebook::velox::substrait
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize({});
+  facebook::velox::substrait::benchmark =
+      std::make_unique<facebook::velox::substrait::PlanConversionBenchmark>();
+  folly::runBenchmarks();
+  facebook::velox::substrait::benchmark.reset();
+  return 0;
+}
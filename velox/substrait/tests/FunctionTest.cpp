@@ -240,3 +240,55 @@ TEST_F(FunctionTest, getInputTypes) {
   ASSERT_EQ(types[3]->kind(), TypeKind::INTEGER);
   ASSERT_EQ(types[4]->kind(), TypeKind::DOUBLE);
 }
+
+TEST_F(FunctionTest, parseTypeCache) {
+  ::substrait::Type rowType;
+  auto* structType = rowType.mutable_struct_();
+  structType->add_types()->mutable_i64();
+  structType->add_types()->mutable_list()->mutable_type()->mutable_string();
+
+  auto type = substraitParser_->parseType(rowType);
+  ASSERT_EQ(type->toString(), "ROW<col_0:BIGINT,col_1:ARRAY<VARCHAR>>");
+  // The same struct type is parsed once.
+  ASSERT_EQ(substraitParser_->parseType(rowType).get(), type.get());
+
+  structType->add_types()->mutable_fp64();
+  auto otherType = substraitParser_->parseType(rowType);
+  ASSERT_NE(otherType.get(), type.get());
+  ASSERT_EQ(
+      otherType->toString(),
+      "ROW<col_0:BIGINT,col_1:ARRAY<VARCHAR>,col_2:DOUBLE>");
+  // The nested list type is shared.
+  ASSERT_EQ(otherType->childAt(1).get(), type->childAt(1).get());
+}
+
+TEST_F(FunctionTest, dedupRepeatedCalls) {
+  SubstraitVeloxExprConverter converter(
+      pool_.get(), {{0, "add:i64_i64"}}, substraitParser_);
+  auto inputType = ROW({"a", "b"}, {BIGINT(), BIGINT()});
+
+  ::substrait::Expression::ScalarFunction add;
+  add.set_function_reference(0);
+  add.mutable_output_type()->mutable_i64();
+  for (auto i = 0; i < 2; ++i) {
+    add.add_arguments()
+        ->mutable_value()
+        ->mutable_selection()
+        ->mutable_direct_reference()
+        ->mutable_struct_field()
+        ->set_field(i);
+  }
+
+  auto expr = converter.toVeloxExpr(add, inputType);
+  ASSERT_EQ(expr->toString(), "plus(ROW[\"a\"],ROW[\"b\"])");
+  // Equal calls are converted to the same tree.
+  ASSERT_EQ(converter.toVeloxExpr(add, inputType).get(), expr.get());
+
+  add.mutable_arguments(1)
+      ->mutable_value()
+      ->mutable_selection()
+      ->mutable_direct_reference()
+      ->mutable_struct_field()
+      ->set_field(0);
+  ASSERT_NE(converter.toVeloxExpr(add, inputType).get(), expr.get());
+}
@@ -18,6 +18,7 @@
 
 #include <utility>
 
+#include "velox/common/time/Timer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/TaskTraceReader.h"
@@ -78,6 +79,47 @@ OperatorReplayerBase::OperatorReplayerBase(
 }
 
 RowVectorPtr OperatorReplayerBase::run(bool copyResults) {
+  auto [task, result] = replay(copyResults);
+  printStats(task);
+  return result;
+}
+
+ReplayBenchmarkResult OperatorReplayerBase::benchmark(int32_t iterations) {
+  VELOX_USER_CHECK_GT(iterations, 0);
+  ReplayBenchmarkResult result;
+  result.operatorType = operatorType_;
+  {
+    // The warmup replay copies the results for the checksum, which is left
+    // out of the measured replays.
+    auto [task, output] = replay(deterministicResults());
+    if (deterministicResults()) {
+      result.outputChecksum = ReplayBenchmarkResult::checksum(output);
+    }
+  }
+  for (auto i = 0; i < iterations; ++i) {
+    uint64_t wallNanos{0};
+    std::shared_ptr<exec::Task> task;
+    {
+      NanosecondTimer timer(&wallNanos);
+      task = replay(false).first;
+    }
+    result.runs.push_back(
+        ReplayStats::fromTask(*task, replayPlanNodeId_, wallNanos));
+    LOG(INFO) << "Replay " << i << " of " << operatorType_ << ": "
+              << result.runs.back().toString();
+  }
+  return result;
+}
+
+void OperatorReplayerBase::overrideQueryConfigs(
+    const std::unordered_map<std::string, std::string>& configs) {
+  for (const auto& [name, value] : configs) {
+    queryConfigs_[name] = value;
+  }
+}
+
+std::pair<std::shared_ptr<exec::Task>, RowVectorPtr>
+OperatorReplayerBase::replay(bool copyResults) {
   auto queryCtx = createQueryCtx();
   std::shared_ptr<exec::test::TempDirectoryPath> spillDirectory;
   if (queryCtx->queryConfig().spillEnabled()) {
@@ -85,12 +127,9 @@ RowVectorPtr OperatorReplayerBase::run(bool copyResults) {
   }
 
   TraceReplayTaskRunner traceTaskRunner(createPlan(), std::move(queryCtx));
-  auto [task, result] =
-      traceTaskRunner.maxDrivers(driverIds_.size())
-          .spillDirectory(spillDirectory ? spillDirectory->getPath() : "")
-          .run(copyResults);
-  printStats(task);
-  return result;
+  return traceTaskRunner.maxDrivers(driverIds_.size())
+      .spillDirectory(spillDirectory ? spillDirectory->getPath() : "")
+      .run(copyResults);
 }
 
 core::PlanNodePtr OperatorReplayerBase::createPlan() {
@@ -20,6 +20,7 @@
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/parse/PlanNodeIdGenerator.h"
+#include "velox/tool/trace/TraceReplayBenchmark.h"
 
 namespace facebook::velox::exec {
 class Task;
@@ -45,9 +46,32 @@ class OperatorReplayerBase {
   OperatorReplayerBase& operator=(OperatorReplayerBase&& other) noexcept =
       delete;
 
-  virtual RowVectorPtr run(bool copyResults = true);
+  /// Replays the traced operator, logs its stats and returns the results if
+  /// 'copyResults' is true.
+  RowVectorPtr run(bool copyResults = true);
+
+  /// Replays the traced operator 'iterations' times after a warmup replay
+  /// that computes the checksum of the results, and returns the stats of the
+  /// measured replays.
+  ReplayBenchmarkResult benchmark(int32_t iterations);
+
+  /// Sets query configs of the replays over the traced ones, e.g. to replay
+  /// with different spill settings.
+  void overrideQueryConfigs(
+      const std::unordered_map<std::string, std::string>& configs);
 
  protected:
+  /// Runs a replay task. Returns the task and the results if 'copyResults' is
+  /// true.
+  virtual std::pair<std::shared_ptr<exec::Task>, RowVectorPtr> replay(
+      bool copyResults);
+
+  /// Returns true if the results of the replay are the same for the same
+  /// trace, so that their checksums can be compared between builds.
+  virtual bool deterministicResults() const {
+    return true;
+  }
+
   virtual core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
       const core::PlanNodeId& nodeId,
@@ -138,7 +138,8 @@ PartitionedOutputReplayer::PartitionedOutputReplayer(
       std::make_shared<folly::NamedThreadFactory>("Consumer"));
 }
 
-RowVectorPtr PartitionedOutputReplayer::run(bool /*unused*/) {
+std::pair<std::shared_ptr<exec::Task>, RowVectorPtr>
+PartitionedOutputReplayer::replay(bool /*unused*/) {
   const auto task = Task::create(
       "local://partitioned-output-replayer",
       core::PlanFragment{createPlan()},
@@ -154,8 +155,9 @@ RowVectorPtr PartitionedOutputReplayer::run(bool /*unused*/) {
       executor_.get(),
       consumerExecutor_.get(),
       consumerCb_);
-  printStats(task);
-  return nullptr;
+  // Waits for the stats of the drivers.
+  task->taskCompletionFuture().wait();
+  return {task, nullptr};
 }
 
 core::PlanNodePtr PartitionedOutputReplayer::createPlanNode(
@@ -173,7 +175,8 @@ core::PlanNodePtr PartitionedOutputReplayer::createPlanNode(
       originalNode->partitionFunctionSpecPtr(),
       originalNode->outputType(),
       serdeKind_,
-      source);
+      source,
+      originalNode->rebalanceSkewedPartitions());
 }
 
 } // namespace facebook::velox::tool::trace
@@ -52,9 +52,15 @@ class PartitionedOutputReplayer final : public OperatorReplayerBase {
       folly::Executor* executor,
       const ConsumerCallBack& consumerCb = [](auto partition, auto page) {});
 
-  RowVectorPtr run(bool /*unused*/) override;
-
  private:
+  std::pair<std::shared_ptr<exec::Task>, RowVectorPtr> replay(
+      bool /*unused*/) override;
+
+  // The replay has no results.
+  bool deterministicResults() const override {
+    return false;
+  }
+
   core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
       const core::PlanNodeId& nodeId,
@@ -29,13 +29,12 @@ using namespace facebook::velox::exec::test;
 
 namespace facebook::velox::tool::trace {
 
-RowVectorPtr TableScanReplayer::run(bool copyResults) {
+std::pair<std::shared_ptr<exec::Task>, RowVectorPtr> TableScanReplayer::replay(
+    bool copyResults) {
   TraceReplayTaskRunner traceTaskRunner(createPlan(), createQueryCtx());
-  auto [task, result] = traceTaskRunner.maxDrivers(driverIds_.size())
-                            .splits(replayPlanNodeId_, getSplits())
-                            .run(copyResults);
-  printStats(task);
-  return result;
+  return traceTaskRunner.maxDrivers(driverIds_.size())
+      .splits(replayPlanNodeId_, getSplits())
+      .run(copyResults);
 }
 
 core::PlanNodePtr TableScanReplayer::createPlanNode(
@@ -46,9 +46,10 @@ class TableScanReplayer final : public OperatorReplayerBase {
             queryCapacity,
             executor) {}
 
-  RowVectorPtr run(bool copyResults = true) override;
-
  private:
+  std::pair<std::shared_ptr<exec::Task>, RowVectorPtr> replay(
+      bool copyResults) override;
+
   core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
       const core::PlanNodeId& nodeId,
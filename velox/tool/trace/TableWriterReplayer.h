@@ -50,6 +50,11 @@ class TableWriterReplayer final : public OperatorReplayerBase {
   }
 
  private:
+  // The results have the names of the written files.
+  bool deterministicResults() const override {
+    return false;
+  }
+
   core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
       const core::PlanNodeId& nodeId,
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tool/trace/TraceReplayBenchmark.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::tool::trace {
+
+namespace {
+
+using StatsMember = uint64_t ReplayStats::*;
+
+const std::vector<std::pair<const char*, StatsMember>>& statsMembers() {
+  static const std::vector<std::pair<const char*, StatsMember>> kMembers{
+      {"wallNanos", &ReplayStats::wallNanos},
+      {"cpuNanos", &ReplayStats::cpuNanos},
+      {"inputRows", &ReplayStats::inputRows},
+      {"outputRows", &ReplayStats::outputRows},
+      {"spilledBytes", &ReplayStats::spilledBytes},
+      {"peakMemoryBytes", &ReplayStats::peakMemoryBytes},
+  };
+  return kMembers;
+}
+
+uint64_t medianOf(const std::vector<ReplayStats>& runs, StatsMember member) {
+  std::vector<uint64_t> values;
+  values.reserve(runs.size());
+  for (const auto& run : runs) {
+    values.push_back(run.*member);
+  }
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+uint64_t minOf(const std::vector<ReplayStats>& runs, StatsMember member) {
+  uint64_t min = std::numeric_limits<uint64_t>::max();
+  for (const auto& run : runs) {
+    min = std::min(min, run.*member);
+  }
+  return min;
+}
+
+double percentChange(uint64_t baseline, uint64_t value) {
+  return baseline == 0 ? 0 : (value - static_cast<double>(baseline)) * 100 /
+          static_cast<double>(baseline);
+}
+
+} // namespace
+
+// static
+ReplayStats ReplayStats::fromTask(
+    const exec::Task& task,
+    const std::string& replayNodeId,
+    uint64_t wallNanos) {
+  ReplayStats stats;
+  stats.wallNanos = wallNanos;
+  const auto planStats = exec::toPlanStats(task.taskStats());
+  for (const auto& [nodeId, nodeStats] : planStats) {
+    stats.cpuNanos +=
+        nodeStats.cpuWallTiming.cpuNanos + nodeStats.backgroundTiming.cpuNanos;
+    stats.spilledBytes += nodeStats.spilledBytes;
+  }
+  const auto& replayNodeStats = planStats.at(replayNodeId);
+  stats.inputRows = replayNodeStats.inputRows;
+  stats.outputRows = replayNodeStats.outputRows;
+  stats.peakMemoryBytes = task.pool()->peakBytes();
+  return stats;
+}
+
+double ReplayStats::throughput() const {
+  return wallNanos == 0 ? 0 : inputRows * 1'000'000'000.0 / wallNanos;
+}
+
+folly::dynamic ReplayStats::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  for (const auto& [name, member] : statsMembers()) {
+    obj[name] = static_cast<int64_t>(this->*member);
+  }
+  return obj;
+}
+
+// static
+ReplayStats ReplayStats::create(const folly::dynamic& obj) {
+  ReplayStats stats;
+  for (const auto& [name, member] : statsMembers()) {
+    stats.*member = obj[name].asInt();
+  }
+  return stats;
+}
+
+std::string ReplayStats::toString() const {
+  return fmt::format(
+      "wall: {}, cpu: {}, input rows: {}, output rows: {}, "
+      "throughput: {:.0f} rows/s, spilled: {}, peak memory: {}",
+      succinctNanos(wallNanos),
+      succinctNanos(cpuNanos),
+      inputRows,
+      outputRows,
+      throughput(),
+      succinctBytes(spilledBytes),
+      succinctBytes(peakMemoryBytes));
+}
+
+ReplayStats ReplayBenchmarkResult::median() const {
+  VELOX_CHECK(!runs.empty());
+  ReplayStats stats;
+  for (const auto& [_, member] : statsMembers()) {
+    stats.*member = medianOf(runs, member);
+  }
+  return stats;
+}
+
+folly::dynamic ReplayBenchmarkResult::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["operatorType"] = operatorType;
+  folly::dynamic runsObj = folly::dynamic::array;
+  for (const auto& run : runs) {
+    runsObj.push_back(run.serialize());
+  }
+  obj["runs"] = std::move(runsObj);
+  if (outputChecksum.has_value()) {
+    // Stored as a string since JSON integers are signed.
+    obj["outputChecksum"] = std::to_string(outputChecksum.value());
+  }
+  return obj;
+}
+
+// static
+ReplayBenchmarkResult ReplayBenchmarkResult::create(const folly::dynamic& obj) {
+  ReplayBenchmarkResult result;
+  result.operatorType = obj["operatorType"].asString();
+  for (const auto& run : obj["runs"]) {
+    result.runs.push_back(ReplayStats::create(run));
+  }
+  if (obj.count("outputChecksum") != 0) {
+    result.outputChecksum = std::stoull(obj["outputChecksum"].asString());
+  }
+  return result;
+}
+
+std::string ReplayBenchmarkResult::toString() const {
+  VELOX_CHECK(!runs.empty());
+  ReplayStats min;
+  for (const auto& [_, member] : statsMembers()) {
+    min.*member = minOf(runs, member);
+  }
+  return fmt::format(
+      "{} replayed {} times\nmedian: {}\nmin: {}{}",
+      operatorType,
+      runs.size(),
+      median().toString(),
+      min.toString(),
+      outputChecksum.has_value()
+          ? fmt::format("\noutput checksum: {}", outputChecksum.value())
+          : "");
+}
+
+// static
+uint64_t ReplayBenchmarkResult::checksum(const RowVectorPtr& output) {
+  if (output == nullptr) {
+    return 0;
+  }
+  uint64_t sum{0};
+  for (vector_size_t row = 0; row < output->size(); ++row) {
+    sum += output->hashValueAt(row);
+  }
+  return sum;
+}
+
+std::vector<std::string> ReplayBenchmarkResult::regressions(
+    const ReplayBenchmarkResult& baseline,
+    double maxRegressionPct) const {
+  std::vector<std::string> regressions;
+  if (operatorType != baseline.operatorType) {
+    regressions.push_back(fmt::format(
+        "Operator type {} differs from the baseline {}",
+        operatorType,
+        baseline.operatorType));
+    return regressions;
+  }
+  if (outputChecksum.has_value() && baseline.outputChecksum.has_value() &&
+      outputChecksum != baseline.outputChecksum) {
+    regressions.push_back(fmt::format(
+        "Output checksum {} differs from the baseline {}",
+        outputChecksum.value(),
+        baseline.outputChecksum.value()));
+  }
+  const auto stats = median();
+  const auto baselineStats = baseline.median();
+  if (stats.inputRows != baselineStats.inputRows) {
+    regressions.push_back(fmt::format(
+        "Input rows {} differ from the baseline {}",
+        stats.inputRows,
+        baselineStats.inputRows));
+  }
+  for (const auto& [name, member] :
+       std::vector<std::pair<const char*, StatsMember>>{
+           {"cpuNanos", &ReplayStats::cpuNanos},
+           {"wallNanos", &ReplayStats::wallNanos},
+           {"peakMemoryBytes", &ReplayStats::peakMemoryBytes}}) {
+    const auto change = percentChange(baselineStats.*member, stats.*member);
+    if (change > maxRegressionPct) {
+      regressions.push_back(fmt::format(
+          "Median {} {} is {:.1f}% above the baseline {}",
+          name,
+          stats.*member,
+          change,
+          baselineStats.*member));
+    }
+  }
+  return regressions;
+}
+
+} // namespace facebook::velox::tool::trace
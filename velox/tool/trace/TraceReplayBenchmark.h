@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/dynamic.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+class Task;
+}
+
+namespace facebook::velox::tool::trace {
+
+/// The cost of a replay of a traced operator.
+struct ReplayStats {
+  uint64_t wallNanos{0};
+  /// CPU time of all the operators of the replay, including the trace scan
+  /// that feeds the replayed operator.
+  uint64_t cpuNanos{0};
+  /// Input and output rows of the replayed operator.
+  uint64_t inputRows{0};
+  uint64_t outputRows{0};
+  uint64_t spilledBytes{0};
+  /// Peak memory of the replay task.
+  uint64_t peakMemoryBytes{0};
+
+  /// Returns the stats of the replay node of 'task'.
+  static ReplayStats fromTask(
+      const exec::Task& task,
+      const std::string& replayNodeId,
+      uint64_t wallNanos);
+
+  /// Returns the input rows per second of wall time.
+  double throughput() const;
+
+  folly::dynamic serialize() const;
+
+  static ReplayStats create(const folly::dynamic& obj);
+
+  std::string toString() const;
+};
+
+/// The replays of a traced operator by the benchmark mode of the replayer.
+/// The result can be saved as JSON and compared with the result of another
+/// build on the same trace.
+struct ReplayBenchmarkResult {
+  std::string operatorType;
+  /// The stats of each measured replay.
+  std::vector<ReplayStats> runs;
+  /// Order independent checksum of the output of the replayed operator, see
+  /// checksum(). std::nullopt if the output is not deterministic, e.g. file
+  /// names of a TableWriter.
+  std::optional<uint64_t> outputChecksum;
+
+  /// Returns the per metric median of 'runs'.
+  ReplayStats median() const;
+
+  folly::dynamic serialize() const;
+
+  static ReplayBenchmarkResult create(const folly::dynamic& obj);
+
+  /// Returns the median and min of each metric over the runs.
+  std::string toString() const;
+
+  /// Returns the sum of the hashes of the rows of 'output', which does not
+  /// depend on the order of the rows, e.g. with multiple drivers.
+  static uint64_t checksum(const RowVectorPtr& output);
+
+  /// Returns the differences of 'this' from 'baseline' that fail the
+  /// comparison: a different output checksum, or a median CPU or wall time
+  /// or peak memory more than 'maxRegressionPct' percent above the baseline.
+  /// Returns an empty list if 'this' is not worse than 'baseline'.
+  std::vector<std::string> regressions(
+      const ReplayBenchmarkResult& baseline,
+      double maxRegressionPct) const;
+};
+
+} // namespace facebook::velox::tool::trace
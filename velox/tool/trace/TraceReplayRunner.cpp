@@ -16,6 +16,7 @@
 
 #include "velox/tool/trace/TraceReplayRunner.h"
 
+#include <folly/json.h>
 #include <gflags/gflags.h>
 
 #include "velox/common/file/FileSystems.h"
@@ -103,6 +104,32 @@ DEFINE_string(
     function_prefix,
     "",
     "Prefix for the scalar and aggregate functions.");
+DEFINE_string(
+    query_config_overrides,
+    "",
+    "Comma-separated list of name=value query configs that override the "
+    "traced ones, e.g. spill_enabled=true,aggregation_spill_enabled=true.");
+DEFINE_int32(
+    benchmark_iterations,
+    0,
+    "If positive, replays the operator this many times after a warmup replay "
+    "and reports the wall and CPU time, throughput, spilled bytes and peak "
+    "memory of the replays.");
+DEFINE_string(
+    benchmark_output_file,
+    "",
+    "File to save the benchmark results to as JSON.");
+DEFINE_string(
+    benchmark_baseline_file,
+    "",
+    "Benchmark results saved by --benchmark_output_file with another build on "
+    "the same trace. The replay fails if the results differ or the median CPU "
+    "time, wall time or peak memory regress more than "
+    "--benchmark_max_regression_pct.");
+DEFINE_double(
+    benchmark_max_regression_pct,
+    10,
+    "Percentage the benchmark metrics may exceed the baseline by.");
 
 namespace facebook::velox::tool::trace {
 namespace {
@@ -227,6 +254,40 @@ void printSummary(
   }
   LOG(INFO) << summary.str();
 }
+
+std::unordered_map<std::string, std::string> parseQueryConfigOverrides(
+    const std::string& overrides) {
+  std::unordered_map<std::string, std::string> configs;
+  std::vector<std::string> entries;
+  folly::split(',', overrides, entries, true);
+  for (const auto& entry : entries) {
+    std::string name;
+    std::string value;
+    VELOX_USER_CHECK(
+        folly::split('=', entry, name, value),
+        "Invalid query config override, expected name=value: {}",
+        entry);
+    configs[name] = value;
+  }
+  return configs;
+}
+
+std::string readFile(filesystems::FileSystem& fs, const std::string& path) {
+  const auto file = fs.openFileForRead(path);
+  return file->pread(0, file->size());
+}
+
+void writeFile(
+    filesystems::FileSystem& fs,
+    const std::string& path,
+    const std::string& content) {
+  if (fs.exists(path)) {
+    fs.remove(path);
+  }
+  auto file = fs.openFileForWrite(path);
+  file->append(content);
+  file->close();
+}
 } // namespace
 
 TraceReplayRunner::TraceReplayRunner()
@@ -397,9 +458,37 @@ TraceReplayRunner::createReplayer() const {
     VELOX_UNSUPPORTED("Unsupported operator type: {}", traceNodeName);
   }
   VELOX_USER_CHECK_NOT_NULL(replayer);
+  replayer->overrideQueryConfigs(
+      parseQueryConfigOverrides(FLAGS_query_config_overrides));
   return replayer;
 }
 
+void TraceReplayRunner::runBenchmark(OperatorReplayerBase& replayer) const {
+  const auto result = replayer.benchmark(FLAGS_benchmark_iterations);
+  LOG(INFO) << "Benchmark results of " << result.toString();
+  if (!FLAGS_benchmark_output_file.empty()) {
+    writeFile(
+        *filesystems::getFileSystem(FLAGS_benchmark_output_file, nullptr),
+        FLAGS_benchmark_output_file,
+        folly::toPrettyJson(result.serialize()));
+  }
+  if (FLAGS_benchmark_baseline_file.empty()) {
+    return;
+  }
+  const auto baseline = ReplayBenchmarkResult::create(folly::parseJson(
+      readFile(
+          *filesystems::getFileSystem(FLAGS_benchmark_baseline_file, nullptr),
+          FLAGS_benchmark_baseline_file)));
+  LOG(INFO) << "Baseline benchmark results of " << baseline.toString();
+  const auto regressions =
+      result.regressions(baseline, FLAGS_benchmark_max_regression_pct);
+  VELOX_USER_CHECK(
+      regressions.empty(),
+      "The replay regressed from the baseline {}:\n{}",
+      FLAGS_benchmark_baseline_file,
+      folly::join("\n", regressions));
+}
+
 void TraceReplayRunner::run() {
   if (FLAGS_summary || FLAGS_short_summary) {
     auto pool = memory::memoryManager()->addLeafPool("replayer");
@@ -412,6 +501,11 @@ void TraceReplayRunner::run() {
     return;
   }
   VELOX_USER_CHECK(!FLAGS_task_id.empty(), "--task_id must be provided");
-  createReplayer()->run(FLAGS_copy_results);
+  auto replayer = createReplayer();
+  if (FLAGS_benchmark_iterations > 0) {
+    runBenchmark(*replayer);
+    return;
+  }
+  replayer->run(FLAGS_copy_results);
 }
 } // namespace facebook::velox::tool::trace
@@ -39,6 +39,11 @@ DECLARE_double(driver_cpu_executor_hw_multiplier);
 DECLARE_string(memory_arbitrator_type);
 DECLARE_bool(copy_results);
 DECLARE_string(function_prefix);
+DECLARE_string(query_config_overrides);
+DECLARE_int32(benchmark_iterations);
+DECLARE_string(benchmark_output_file);
+DECLARE_string(benchmark_baseline_file);
+DECLARE_double(benchmark_max_regression_pct);
 
 namespace facebook::velox::tool::trace {
 
@@ -59,6 +64,11 @@ class TraceReplayRunner {
  protected:
   std::unique_ptr<tool::trace::OperatorReplayerBase> createReplayer() const;
 
+  /// Replays --benchmark_iterations times, saves the results to
+  /// --benchmark_output_file and compares them with
+  /// --benchmark_baseline_file if set.
+  void runBenchmark(OperatorReplayerBase& replayer) const;
+
   const std::unique_ptr<folly::CPUThreadPoolExecutor> cpuExecutor_;
   const std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::shared_ptr<filesystems::FileSystem> fs_;
@@ -247,4 +247,100 @@ TEST_F(AggregationReplayerTest, test) {
     }
   }
 }
+
+TEST_F(AggregationReplayerTest, benchmark) {
+  const auto data = generateInput(groupingKeys_, keyTypes_);
+  const auto planWithNames = aggregatePlans(asRowType(data[0]->type()));
+  const auto sourceFilePath = TempFilePath::create();
+  writeToFile(sourceFilePath->getPath(), data);
+  const auto& plan = planWithNames[0].plan;
+  const auto testDir = TempDirectoryPath::create();
+  const auto traceRoot = fmt::format("{}/{}", testDir->getPath(), "traceRoot");
+  std::shared_ptr<Task> task;
+  auto results =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kQueryTraceEnabled, true)
+          .config(core::QueryConfig::kQueryTraceDir, traceRoot)
+          .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+          .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+          .config(core::QueryConfig::kQueryTraceNodeIds, traceNodeId_)
+          .split(makeHiveConnectorSplit(sourceFilePath->getPath()))
+          .copyResults(pool(), task);
+
+  AggregationReplayer replayer(
+      traceRoot,
+      task->queryCtx()->queryId(),
+      task->taskId(),
+      traceNodeId_,
+      "Aggregation",
+      "",
+      0,
+      executor_.get());
+  replayer.overrideQueryConfigs(
+      {{core::QueryConfig::kSpillEnabled, "true"},
+       {core::QueryConfig::kAggregationSpillEnabled, "true"}});
+  const auto result = replayer.benchmark(2);
+  ASSERT_EQ(result.operatorType, "Aggregation");
+  ASSERT_EQ(result.runs.size(), 2);
+  for (const auto& run : result.runs) {
+    ASSERT_EQ(run.inputRows, 10'000);
+    ASSERT_EQ(run.outputRows, results->size());
+    ASSERT_GT(run.wallNanos, 0);
+    ASSERT_GT(run.peakMemoryBytes, 0);
+  }
+  // The checksum does not depend on the order of the results.
+  ASSERT_EQ(
+      result.outputChecksum.value(),
+      ReplayBenchmarkResult::checksum(results));
+
+  const auto copy = ReplayBenchmarkResult::create(result.serialize());
+  ASSERT_EQ(copy.runs.size(), 2);
+  ASSERT_EQ(copy.outputChecksum, result.outputChecksum);
+  ASSERT_EQ(copy.median().cpuNanos, result.median().cpuNanos);
+  ASSERT_TRUE(copy.regressions(result, 0).empty());
+
+  auto baseline = result;
+  baseline.outputChecksum = result.outputChecksum.value() + 1;
+  for (auto& run : baseline.runs) {
+    run.peakMemoryBytes /= 4;
+  }
+  const auto regressions = result.regressions(baseline, 10);
+  ASSERT_EQ(regressions.size(), 2);
+  ASSERT_EQ(regressions[0].find("Output checksum"), 0);
+  ASSERT_EQ(regressions[1].find("Median peakMemoryBytes"), 0);
+
+  // Saves the results of a benchmark run and compares a second run with
+  // them.
+  const auto outputFile = fmt::format("{}/benchmark.json", testDir->getPath());
+  FLAGS_root_dir = traceRoot;
+  FLAGS_query_id = task->queryCtx()->queryId();
+  FLAGS_task_id = task->taskId();
+  FLAGS_node_id = traceNodeId_;
+  FLAGS_driver_ids = "";
+  FLAGS_summary = false;
+  FLAGS_benchmark_iterations = 1;
+  FLAGS_benchmark_output_file = outputFile;
+  SCOPE_EXIT {
+    FLAGS_benchmark_iterations = 0;
+    FLAGS_benchmark_output_file = "";
+    FLAGS_benchmark_baseline_file = "";
+  };
+  {
+    TraceReplayRunner runner;
+    runner.init();
+    runner.run();
+  }
+  FLAGS_benchmark_output_file = "";
+  FLAGS_benchmark_baseline_file = outputFile;
+  // Only fails on different results.
+  FLAGS_benchmark_max_regression_pct = 1'000'000;
+  SCOPE_EXIT {
+    FLAGS_benchmark_max_regression_pct = 10;
+  };
+  {
+    TraceReplayRunner runner;
+    runner.init();
+    runner.run();
+  }
+}
 } // namespace facebook::velox::tool::trace::test
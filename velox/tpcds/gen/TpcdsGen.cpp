@@ -0,0 +1,972 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <ctime>
+#include <unordered_map>
+
+#include "velox/type/Timestamp.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::tpcds {
+namespace {
+
+// Surrogate key and days since the epoch of the first date_dim row,
+// 1900-01-02.
+constexpr int64_t kFirstDateSk = 2'415'022;
+constexpr int32_t kFirstDate = -25'566;
+
+// The store sales are sold between 1998-01-02 and 2003-01-02.
+constexpr int64_t kFirstSalesDateSk = 2'450'816;
+constexpr int64_t kNumSalesDays = 1'827;
+
+// Number of line items of a store_sales ticket. The line items of a ticket
+// have the same date, customer and store.
+constexpr size_t kItemsPerTicket = 10;
+
+const std::vector<std::string_view> kDayNames{
+    "Sunday",
+    "Monday",
+    "Tuesday",
+    "Wednesday",
+    "Thursday",
+    "Friday",
+    "Saturday"};
+
+const std::vector<std::string_view> kCategories{
+    "Women",
+    "Men",
+    "Children",
+    "Shoes",
+    "Music",
+    "Jewelry",
+    "Home",
+    "Sports",
+    "Books",
+    "Electronics"};
+
+const std::vector<std::string_view> kClasses{
+    "accessories",
+    "athletic",
+    "classical",
+    "country",
+    "dresses",
+    "fiction",
+    "football",
+    "history",
+    "kids",
+    "mystery",
+    "pants",
+    "pop",
+    "romance",
+    "shirts",
+    "sports",
+    "televisions"};
+
+const std::vector<std::string_view> kWords{
+    "able",
+    "actual",
+    "basic",
+    "careful",
+    "common",
+    "early",
+    "final",
+    "general",
+    "good",
+    "great",
+    "large",
+    "little",
+    "national",
+    "new",
+    "old",
+    "particular",
+    "political",
+    "public",
+    "small",
+    "social",
+    "special",
+    "strong",
+    "whole",
+    "young"};
+
+const std::vector<std::string_view> kCities{
+    "Midway",
+    "Fairview",
+    "Oak Grove",
+    "Five Points",
+    "Pleasant Hill",
+    "Riverside",
+    "Centerville",
+    "Mount Pleasant",
+    "Greenwood",
+    "Union"};
+
+const std::vector<std::string_view> kCounties{
+    "Williamson County",
+    "Ziebach County",
+    "Walker County",
+    "Franklin Parish",
+    "Bronx County",
+    "Richland County",
+    "Barrow County",
+    "Luce County",
+    "Daviess County",
+    "Fairfield County"};
+
+// Most stores are in TN as at the small scale factors of dsdgen.
+const std::vector<std::string_view> kStoreStates{
+    "TN", "TN", "TN", "TN", "TN", "TN", "GA", "AL", "SD", "OH"};
+
+const std::vector<std::string_view> kStates{
+    "AL", "CA", "GA", "IA", "IL", "IN", "KS", "KY", "MI", "MN",
+    "MO", "MS", "NC", "NE", "OH", "SD", "TN", "TX", "VA", "WI"};
+
+const std::vector<std::string_view> kCompanyNames{
+    "Unknown", "ought", "able", "pri", "ese", "anti"};
+
+const std::vector<std::string_view> kFirstNames{
+    "James",
+    "Mary",
+    "John",
+    "Patricia",
+    "Robert",
+    "Jennifer",
+    "Michael",
+    "Linda",
+    "William",
+    "Elizabeth"};
+
+const std::vector<std::string_view> kLastNames{
+    "Smith",
+    "Johnson",
+    "Williams",
+    "Brown",
+    "Jones",
+    "Garcia",
+    "Miller",
+    "Davis",
+    "Rodriguez",
+    "Martinez"};
+
+const std::vector<std::string_view> kCountries{
+    "UNITED STATES", "CANADA", "MEXICO", "GERMANY", "JAPAN", "BRAZIL"};
+
+// The customer_demographics table is the cross product of these domains, the
+// first one varying fastest.
+const std::vector<std::string_view> kGenders{"M", "F"};
+const std::vector<std::string_view> kMaritalStatuses{"M", "S", "D", "W", "U"};
+const std::vector<std::string_view> kEducationStatuses{
+    "Primary",
+    "Secondary",
+    "College",
+    "2 yr Degree",
+    "4 yr Degree",
+    "Advanced Degree",
+    "Unknown"};
+constexpr int32_t kNumPurchaseEstimates = 20;
+const std::vector<std::string_view> kCreditRatings{
+    "Good", "High Risk", "Low Risk", "Unknown"};
+constexpr int32_t kNumDependentCounts = 7;
+
+constexpr size_t kNumCustomerDemographics = 2 * 5 * 7 * kNumPurchaseEstimates *
+    4 * kNumDependentCounts * kNumDependentCounts * kNumDependentCounts;
+
+// Pseudo random values of a row of a table. Each value is a function of the
+// table, row and 'stream', which is unique per column of the table.
+class RowRandom {
+ public:
+  RowRandom(Table table, uint64_t row)
+      : seed_((static_cast<uint64_t>(table) << 56) ^ row) {}
+
+  // Returns a value in [lo, hi].
+  int64_t uniform(uint8_t stream, int64_t lo, int64_t hi) const {
+    VELOX_DCHECK_LE(lo, hi);
+    const auto range = static_cast<uint64_t>(hi - lo) + 1;
+    return lo + static_cast<int64_t>(next(stream) % range);
+  }
+
+  // Returns a value in [loCents / 100, hiCents / 100] with 2 decimals.
+  double cents(uint8_t stream, int64_t loCents, int64_t hiCents) const {
+    return uniform(stream, loCents, hiCents) / 100.0;
+  }
+
+  std::string_view pick(
+      uint8_t stream,
+      const std::vector<std::string_view>& values) const {
+    return values[uniform(stream, 0, values.size() - 1)];
+  }
+
+ private:
+  // The splitmix64 finalizer.
+  uint64_t next(uint8_t stream) const {
+    uint64_t z = seed_ ^ (static_cast<uint64_t>(stream) << 48);
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  const uint64_t seed_;
+};
+
+// Rounds to cents the way decimal(7, 2) columns are.
+double roundCents(double value) {
+  return std::round(value * 100) / 100;
+}
+
+// Returns the 16 character business key of surrogate key 'key' as produced by
+// dsdgen, e.g. AAAAAAAABAAAAAAA for 1.
+std::string businessKey(uint64_t key) {
+  std::string id(16, 'A');
+  for (auto i = 8; i < 16 && key > 0; ++i) {
+    id[i] = 'A' + (key & 0xF);
+    key >>= 4;
+  }
+  return id;
+}
+
+// Returns a word with a syllable per decimal digit of 'number', the way
+// dsdgen names brands, manufacturers and stores, e.g. 'ableought' for 10.
+std::string syllables(int64_t number) {
+  static const std::vector<std::string_view> kSyllables{
+      "ought",
+      "able",
+      "pri",
+      "ese",
+      "anti",
+      "cally",
+      "ation",
+      "eing",
+      "bar",
+      "n st"};
+  std::string word;
+  for (auto digit : std::to_string(number)) {
+    word.append(kSyllables[digit - '0']);
+  }
+  return word;
+}
+
+std::string zip(const RowRandom& random, uint8_t stream) {
+  return fmt::format("{:05d}", random.uniform(stream, 10'000, 99'999));
+}
+
+size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
+  if (offset >= rowCount) {
+    return 0;
+  }
+  return std::min(rowCount - offset, maxRows);
+}
+
+std::vector<VectorPtr> allocateVectors(
+    const RowTypePtr& type,
+    size_t vectorSize,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> vectors;
+  vectors.reserve(type->size());
+
+  for (const auto& childType : type->children()) {
+    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  }
+  return vectors;
+}
+
+template <typename T>
+FlatVector<T>* flat(std::vector<VectorPtr>& children, column_index_t column) {
+  return children[column]->asFlatVector<T>();
+}
+
+void genDateDim(std::vector<VectorPtr>& children, size_t size, size_t offset) {
+  auto* dateSk = flat<int64_t>(children, 0);
+  auto* dateId = flat<StringView>(children, 1);
+  auto* date = flat<int32_t>(children, 2);
+  auto* monthSeq = flat<int32_t>(children, 3);
+  auto* weekSeq = flat<int32_t>(children, 4);
+  auto* year = flat<int32_t>(children, 5);
+  auto* dow = flat<int32_t>(children, 6);
+  auto* moy = flat<int32_t>(children, 7);
+  auto* dom = flat<int32_t>(children, 8);
+  auto* qoy = flat<int32_t>(children, 9);
+  auto* dayName = flat<StringView>(children, 10);
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const int32_t days = kFirstDate + static_cast<int32_t>(row);
+    std::tm tm;
+    VELOX_CHECK(Timestamp::epochToCalendarUtc(days * 86'400LL, tm));
+    const auto sk = kFirstDateSk + row;
+    dateSk->set(i, sk);
+    dateId->set(i, StringView(businessKey(sk)));
+    date->set(i, days);
+    monthSeq->set(i, tm.tm_year * 12 + tm.tm_mon);
+    // The first row is a Tuesday and weeks start on Sunday.
+    weekSeq->set(i, (row + 2) / 7 + 1);
+    year->set(i, tm.tm_year + 1900);
+    dow->set(i, tm.tm_wday);
+    moy->set(i, tm.tm_mon + 1);
+    dom->set(i, tm.tm_mday);
+    qoy->set(i, tm.tm_mon / 3 + 1);
+    dayName->set(i, StringView(kDayNames[tm.tm_wday]));
+  }
+}
+
+void genItem(std::vector<VectorPtr>& children, size_t size, size_t offset) {
+  enum : uint8_t { kPrice, kCategory, kClass, kBrand, kManufact, kManager };
+  enum : uint8_t { kWord0 = 10 };
+  auto* itemSk = flat<int64_t>(children, 0);
+  auto* itemId = flat<StringView>(children, 1);
+  auto* itemDesc = flat<StringView>(children, 2);
+  auto* currentPrice = flat<double>(children, 3);
+  auto* brandId = flat<int32_t>(children, 4);
+  auto* brand = flat<StringView>(children, 5);
+  auto* classId = flat<int32_t>(children, 6);
+  auto* className = flat<StringView>(children, 7);
+  auto* categoryId = flat<int32_t>(children, 8);
+  auto* category = flat<StringView>(children, 9);
+  auto* manufactId = flat<int32_t>(children, 10);
+  auto* manufact = flat<StringView>(children, 11);
+  auto* managerId = flat<int32_t>(children, 12);
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const RowRandom random(Table::TBL_ITEM, row);
+    itemSk->set(i, row + 1);
+    itemId->set(i, StringView(businessKey(row + 1)));
+    itemDesc->set(
+        i,
+        StringView(fmt::format(
+            "{} {} {} {}",
+            random.pick(kWord0, kWords),
+            random.pick(kWord0 + 1, kWords),
+            random.pick(kWord0 + 2, kWords),
+            random.pick(kWord0 + 3, kWords))));
+    currentPrice->set(i, random.cents(kPrice, 9, 9'999));
+    const int32_t categoryIndex = random.uniform(kCategory, 0, 9);
+    const int32_t classIndex = random.uniform(kClass, 0, 15);
+    const int32_t brandNumber = random.uniform(kBrand, 1, 10);
+    const int32_t brandPrefix = (categoryIndex + 1) * 1'000 + classIndex + 1;
+    brandId->set(i, brandPrefix * 1'000 + brandNumber);
+    brand->set(
+        i,
+        StringView(fmt::format("{} #{}", syllables(brandPrefix), brandNumber)));
+    classId->set(i, classIndex + 1);
+    className->set(i, StringView(kClasses[classIndex]));
+    categoryId->set(i, categoryIndex + 1);
+    category->set(i, StringView(kCategories[categoryIndex]));
+    const int32_t manufactNumber = random.uniform(kManufact, 1, 1'000);
+    manufactId->set(i, manufactNumber);
+    manufact->set(i, StringView(syllables(manufactNumber)));
+    managerId->set(i, random.uniform(kManager, 1, 100));
+  }
+}
+
+void genStore(std::vector<VectorPtr>& children, size_t size, size_t offset) {
+  enum : uint8_t { kCompany, kCity, kCounty, kState, kZip, kGmtOffset };
+  auto* storeSk = flat<int64_t>(children, 0);
+  auto* storeId = flat<StringView>(children, 1);
+  auto* storeName = flat<StringView>(children, 2);
+  auto* companyName = flat<StringView>(children, 3);
+  auto* city = flat<StringView>(children, 4);
+  auto* county = flat<StringView>(children, 5);
+  auto* state = flat<StringView>(children, 6);
+  auto* zipCode = flat<StringView>(children, 7);
+  auto* gmtOffset = flat<double>(children, 8);
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const RowRandom random(Table::TBL_STORE, row);
+    storeSk->set(i, row + 1);
+    storeId->set(i, StringView(businessKey(row + 1)));
+    storeName->set(i, StringView(syllables(row + 1)));
+    companyName->set(i, StringView(random.pick(kCompany, kCompanyNames)));
+    city->set(i, StringView(random.pick(kCity, kCities)));
+    county->set(i, StringView(random.pick(kCounty, kCounties)));
+    state->set(i, StringView(random.pick(kState, kStoreStates)));
+    zipCode->set(i, StringView(zip(random, kZip)));
+    gmtOffset->set(i, -random.uniform(kGmtOffset, 5, 6));
+  }
+}
+
+void genCustomer(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset,
+    double scaleFactor) {
+  enum : uint8_t {
+    kCdemo,
+    kAddr,
+    kFirstName,
+    kLastName,
+    kBirthYear,
+    kBirthCountry
+  };
+  const auto numAddresses =
+      getRowCount(Table::TBL_CUSTOMER_ADDRESS, scaleFactor);
+  auto* customerSk = flat<int64_t>(children, 0);
+  auto* customerId = flat<StringView>(children, 1);
+  auto* cdemoSk = flat<int64_t>(children, 2);
+  auto* addrSk = flat<int64_t>(children, 3);
+  auto* firstName = flat<StringView>(children, 4);
+  auto* lastName = flat<StringView>(children, 5);
+  auto* birthYear = flat<int32_t>(children, 6);
+  auto* birthCountry = flat<StringView>(children, 7);
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const RowRandom random(Table::TBL_CUSTOMER, row);
+    customerSk->set(i, row + 1);
+    customerId->set(i, StringView(businessKey(row + 1)));
+    cdemoSk->set(i, random.uniform(kCdemo, 1, kNumCustomerDemographics));
+    addrSk->set(i, random.uniform(kAddr, 1, numAddresses));
+    firstName->set(i, StringView(random.pick(kFirstName, kFirstNames)));
+    lastName->set(i, StringView(random.pick(kLastName, kLastNames)));
+    birthYear->set(i, random.uniform(kBirthYear, 1924, 1992));
+    birthCountry->set(i, StringView(random.pick(kBirthCountry, kCountries)));
+  }
+}
+
+void genCustomerAddress(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset) {
+  enum : uint8_t { kCity, kCounty, kState, kZip, kGmtOffset };
+  auto* addressSk = flat<int64_t>(children, 0);
+  auto* addressId = flat<StringView>(children, 1);
+  auto* city = flat<StringView>(children, 2);
+  auto* county = flat<StringView>(children, 3);
+  auto* state = flat<StringView>(children, 4);
+  auto* zipCode = flat<StringView>(children, 5);
+  auto* country = flat<StringView>(children, 6);
+  auto* gmtOffset = flat<double>(children, 7);
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const RowRandom random(Table::TBL_CUSTOMER_ADDRESS, row);
+    addressSk->set(i, row + 1);
+    addressId->set(i, StringView(businessKey(row + 1)));
+    city->set(i, StringView(random.pick(kCity, kCities)));
+    county->set(i, StringView(random.pick(kCounty, kCounties)));
+    state->set(i, StringView(random.pick(kState, kStates)));
+    zipCode->set(i, StringView(zip(random, kZip)));
+    country->set(i, StringView("United States"));
+    gmtOffset->set(i, -random.uniform(kGmtOffset, 5, 8));
+  }
+}
+
+void genCustomerDemographics(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset) {
+  auto* demoSk = flat<int64_t>(children, 0);
+  auto* gender = flat<StringView>(children, 1);
+  auto* maritalStatus = flat<StringView>(children, 2);
+  auto* educationStatus = flat<StringView>(children, 3);
+  auto* purchaseEstimate = flat<int32_t>(children, 4);
+  auto* creditRating = flat<StringView>(children, 5);
+  auto* depCount = flat<int32_t>(children, 6);
+  auto* depEmployedCount = flat<int32_t>(children, 7);
+  auto* depCollegeCount = flat<int32_t>(children, 8);
+
+  for (size_t i = 0; i < size; ++i) {
+    auto row = offset + i;
+    demoSk->set(i, row + 1);
+    gender->set(i, StringView(kGenders[row % kGenders.size()]));
+    row /= kGenders.size();
+    maritalStatus->set(
+        i, StringView(kMaritalStatuses[row % kMaritalStatuses.size()]));
+    row /= kMaritalStatuses.size();
+    educationStatus->set(
+        i, StringView(kEducationStatuses[row % kEducationStatuses.size()]));
+    row /= kEducationStatuses.size();
+    purchaseEstimate->set(i, (row % kNumPurchaseEstimates + 1) * 500);
+    row /= kNumPurchaseEstimates;
+    creditRating->set(
+        i, StringView(kCreditRatings[row % kCreditRatings.size()]));
+    row /= kCreditRatings.size();
+    depCount->set(i, row % kNumDependentCounts);
+    row /= kNumDependentCounts;
+    depEmployedCount->set(i, row % kNumDependentCounts);
+    row /= kNumDependentCounts;
+    depCollegeCount->set(i, row % kNumDependentCounts);
+  }
+}
+
+void genPromotion(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset) {
+  enum : uint8_t { kEmail, kEvent, kTv };
+  auto* promoSk = flat<int64_t>(children, 0);
+  auto* promoId = flat<StringView>(children, 1);
+  auto* promoName = flat<StringView>(children, 2);
+  auto* channelEmail = flat<StringView>(children, 3);
+  auto* channelEvent = flat<StringView>(children, 4);
+  auto* channelTv = flat<StringView>(children, 5);
+
+  const std::vector<std::string_view> kFlags{"Y", "N"};
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const RowRandom random(Table::TBL_PROMOTION, row);
+    promoSk->set(i, row + 1);
+    promoId->set(i, StringView(businessKey(row + 1)));
+    promoName->set(i, StringView(syllables(row + 1)));
+    channelEmail->set(i, StringView(random.pick(kEmail, kFlags)));
+    channelEvent->set(i, StringView(random.pick(kEvent, kFlags)));
+    channelTv->set(i, StringView(random.pick(kTv, kFlags)));
+  }
+}
+
+void genStoreSales(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset,
+    double scaleFactor) {
+  // Streams of the ticket of a line item.
+  enum : uint8_t { kDate, kCustomer, kStore, kCdemo, kAddr };
+  // Streams of a line item.
+  enum : uint8_t {
+    kItem = 10,
+    kPromo,
+    kQuantity,
+    kWholesaleCost,
+    kMarkup,
+    kDiscount,
+    kHasCoupon,
+    kCoupon
+  };
+  const auto numItems = getRowCount(Table::TBL_ITEM, scaleFactor);
+  const auto numCustomers = getRowCount(Table::TBL_CUSTOMER, scaleFactor);
+  const auto numStores = getRowCount(Table::TBL_STORE, scaleFactor);
+  const auto numAddresses =
+      getRowCount(Table::TBL_CUSTOMER_ADDRESS, scaleFactor);
+  const auto numPromotions = getRowCount(Table::TBL_PROMOTION, scaleFactor);
+
+  auto* soldDateSk = flat<int64_t>(children, 0);
+  auto* itemSk = flat<int64_t>(children, 1);
+  auto* customerSk = flat<int64_t>(children, 2);
+  auto* cdemoSk = flat<int64_t>(children, 3);
+  auto* addrSk = flat<int64_t>(children, 4);
+  auto* storeSk = flat<int64_t>(children, 5);
+  auto* promoSk = flat<int64_t>(children, 6);
+  auto* ticketNumber = flat<int64_t>(children, 7);
+  auto* quantity = flat<int32_t>(children, 8);
+  auto* wholesaleCost = flat<double>(children, 9);
+  auto* listPrice = flat<double>(children, 10);
+  auto* salesPrice = flat<double>(children, 11);
+  auto* extSalesPrice = flat<double>(children, 12);
+  auto* couponAmt = flat<double>(children, 13);
+  auto* netPaid = flat<double>(children, 14);
+  auto* netProfit = flat<double>(children, 15);
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = offset + i;
+    const auto ticket = row / kItemsPerTicket;
+    const RowRandom ticketRandom(Table::TBL_STORE_SALES, ticket);
+    const RowRandom random(Table::TBL_STORE_SALES, row);
+
+    soldDateSk->set(
+        i,
+        kFirstSalesDateSk + ticketRandom.uniform(kDate, 0, kNumSalesDays - 1));
+    customerSk->set(i, ticketRandom.uniform(kCustomer, 1, numCustomers));
+    storeSk->set(i, ticketRandom.uniform(kStore, 1, numStores));
+    cdemoSk->set(i, ticketRandom.uniform(kCdemo, 1, kNumCustomerDemographics));
+    addrSk->set(i, ticketRandom.uniform(kAddr, 1, numAddresses));
+    ticketNumber->set(i, ticket + 1);
+
+    itemSk->set(i, random.uniform(kItem, 1, numItems));
+    promoSk->set(i, random.uniform(kPromo, 1, numPromotions));
+    const int32_t count = random.uniform(kQuantity, 1, 100);
+    const auto wholesale = random.cents(kWholesaleCost, 100, 10'000);
+    const auto list =
+        roundCents(wholesale * (1 + random.cents(kMarkup, 0, 200)));
+    const auto sales =
+        roundCents(list * (1 - random.cents(kDiscount, 0, 100)));
+    const auto extSales = roundCents(sales * count);
+    const auto coupon = random.uniform(kHasCoupon, 0, 4) == 0
+        ? roundCents(extSales * random.cents(kCoupon, 0, 100))
+        : 0;
+    quantity->set(i, count);
+    wholesaleCost->set(i, wholesale);
+    listPrice->set(i, list);
+    salesPrice->set(i, sales);
+    extSalesPrice->set(i, extSales);
+    couponAmt->set(i, coupon);
+    netPaid->set(i, roundCents(extSales - coupon));
+    netProfit->set(i, roundCents(extSales - coupon - wholesale * count));
+  }
+}
+
+} // namespace
+
+std::string_view toTableName(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return "date_dim";
+    case Table::TBL_ITEM:
+      return "item";
+    case Table::TBL_STORE:
+      return "store";
+    case Table::TBL_CUSTOMER:
+      return "customer";
+    case Table::TBL_CUSTOMER_ADDRESS:
+      return "customer_address";
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return "customer_demographics";
+    case Table::TBL_PROMOTION:
+      return "promotion";
+    case Table::TBL_STORE_SALES:
+      return "store_sales";
+  }
+  return ""; // make gcc happy.
+}
+
+Table fromTableName(std::string_view tableName) {
+  static std::unordered_map<std::string_view, Table> map{
+      {"date_dim", Table::TBL_DATE_DIM},
+      {"item", Table::TBL_ITEM},
+      {"store", Table::TBL_STORE},
+      {"customer", Table::TBL_CUSTOMER},
+      {"customer_address", Table::TBL_CUSTOMER_ADDRESS},
+      {"customer_demographics", Table::TBL_CUSTOMER_DEMOGRAPHICS},
+      {"promotion", Table::TBL_PROMOTION},
+      {"store_sales", Table::TBL_STORE_SALES},
+  };
+
+  auto it = map.find(tableName);
+  if (it != map.end()) {
+    return it->second;
+  }
+  throw std::invalid_argument(
+      fmt::format("Invalid TPC-DS table name: '{}'", tableName));
+}
+
+size_t getRowCount(Table table, double scaleFactor) {
+  VELOX_CHECK_GE(scaleFactor, 0, "Tpcds scale factor must be non-negative");
+  // Dimensions have at least one row so that the foreign keys of the facts
+  // are valid at small scale factors.
+  const auto dimension = [&](size_t rowsAtScaleFactor1) -> size_t {
+    if (scaleFactor == 0) {
+      return 0;
+    }
+    return std::max<size_t>(1, rowsAtScaleFactor1 * scaleFactor);
+  };
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return 73'049;
+    case Table::TBL_ITEM:
+      return dimension(18'000);
+    case Table::TBL_STORE:
+      return dimension(12);
+    case Table::TBL_CUSTOMER:
+      return dimension(100'000);
+    case Table::TBL_CUSTOMER_ADDRESS:
+      return dimension(50'000);
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return kNumCustomerDemographics;
+    case Table::TBL_PROMOTION:
+      return dimension(300);
+    case Table::TBL_STORE_SALES:
+      return 2'880'404 * scaleFactor;
+  }
+  return 0; // make gcc happy.
+}
+
+RowTypePtr getTableSchema(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM: {
+      static RowTypePtr type = ROW(
+          {
+              "d_date_sk",
+              "d_date_id",
+              "d_date",
+              "d_month_seq",
+              "d_week_seq",
+              "d_year",
+              "d_dow",
+              "d_moy",
+              "d_dom",
+              "d_qoy",
+              "d_day_name",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              DATE(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_ITEM: {
+      static RowTypePtr type = ROW(
+          {
+              "i_item_sk",
+              "i_item_id",
+              "i_item_desc",
+              "i_current_price",
+              "i_brand_id",
+              "i_brand",
+              "i_class_id",
+              "i_class",
+              "i_category_id",
+              "i_category",
+              "i_manufact_id",
+              "i_manufact",
+              "i_manager_id",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE: {
+      static RowTypePtr type = ROW(
+          {
+              "s_store_sk",
+              "s_store_id",
+              "s_store_name",
+              "s_company_name",
+              "s_city",
+              "s_county",
+              "s_state",
+              "s_zip",
+              "s_gmt_offset",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+          });
+      return type;
+    }
+
+    case Table::TBL_CUSTOMER: {
+      static RowTypePtr type = ROW(
+          {
+              "c_customer_sk",
+              "c_customer_id",
+              "c_current_cdemo_sk",
+              "c_current_addr_sk",
+              "c_first_name",
+              "c_last_name",
+              "c_birth_year",
+              "c_birth_country",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              BIGINT(),
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_CUSTOMER_ADDRESS: {
+      static RowTypePtr type = ROW(
+          {
+              "ca_address_sk",
+              "ca_address_id",
+              "ca_city",
+              "ca_county",
+              "ca_state",
+              "ca_zip",
+              "ca_country",
+              "ca_gmt_offset",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+          });
+      return type;
+    }
+
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS: {
+      static RowTypePtr type = ROW(
+          {
+              "cd_demo_sk",
+              "cd_gender",
+              "cd_marital_status",
+              "cd_education_status",
+              "cd_purchase_estimate",
+              "cd_credit_rating",
+              "cd_dep_count",
+              "cd_dep_employed_count",
+              "cd_dep_college_count",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_PROMOTION: {
+      static RowTypePtr type = ROW(
+          {
+              "p_promo_sk",
+              "p_promo_id",
+              "p_promo_name",
+              "p_channel_email",
+              "p_channel_event",
+              "p_channel_tv",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE_SALES: {
+      static RowTypePtr type = ROW(
+          {
+              "ss_sold_date_sk",
+              "ss_item_sk",
+              "ss_customer_sk",
+              "ss_cdemo_sk",
+              "ss_addr_sk",
+              "ss_store_sk",
+              "ss_promo_sk",
+              "ss_ticket_number",
+              "ss_quantity",
+              "ss_wholesale_cost",
+              "ss_list_price",
+              "ss_sales_price",
+              "ss_ext_sales_price",
+              "ss_coupon_amt",
+              "ss_net_paid",
+              "ss_net_profit",
+          },
+          {
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              INTEGER(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+          });
+      return type;
+    }
+  }
+  return nullptr; // make gcc happy.
+}
+
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName) {
+  return getTableSchema(table)->findChild(columnName);
+}
+
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  const auto type = getTableSchema(table);
+  const auto vectorSize =
+      getVectorSize(getRowCount(table, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(type, vectorSize, pool);
+
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      genDateDim(children, vectorSize, offset);
+      break;
+    case Table::TBL_ITEM:
+      genItem(children, vectorSize, offset);
+      break;
+    case Table::TBL_STORE:
+      genStore(children, vectorSize, offset);
+      break;
+    case Table::TBL_CUSTOMER:
+      genCustomer(children, vectorSize, offset, scaleFactor);
+      break;
+    case Table::TBL_CUSTOMER_ADDRESS:
+      genCustomerAddress(children, vectorSize, offset);
+      break;
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      genCustomerDemographics(children, vectorSize, offset);
+      break;
+    case Table::TBL_PROMOTION:
+      genPromotion(children, vectorSize, offset);
+      break;
+    case Table::TBL_STORE_SALES:
+      genStoreSales(children, vectorSize, offset, scaleFactor);
+      break;
+  }
+  return std::make_shared<RowVector>(
+      pool, type, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+} // namespace facebook::velox::tpcds
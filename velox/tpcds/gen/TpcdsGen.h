@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::tpcds {
+
+/// This file generates TPC-DS data encoded using Velox Vectors.
+///
+/// It covers the store sales star schema: the store_sales fact table and the
+/// dimensions used by the store channel queries. The tables have the TPC-DS
+/// column names, types and value domains for the columns they include, and the
+/// row counts of the spec at scale factor 1. The data is not produced by
+/// dsdgen though, so query results differ from the official answer sets.
+///
+/// Every value is a function of the table, column and row number only, so
+/// like TpchGen, any range of rows can be generated independently, e.g. by
+/// different threads, and the data is the same across runs and platforms.
+/// Foreign keys reference rows of the dimension tables of the same scale
+/// factor.
+///
+/// Decimal columns are returned as DOUBLE and no column has nulls.
+
+enum class Table : uint8_t {
+  TBL_DATE_DIM,
+  TBL_ITEM,
+  TBL_STORE,
+  TBL_CUSTOMER,
+  TBL_CUSTOMER_ADDRESS,
+  TBL_CUSTOMER_DEMOGRAPHICS,
+  TBL_PROMOTION,
+  TBL_STORE_SALES,
+};
+
+static constexpr auto tables = {
+    tpcds::Table::TBL_DATE_DIM,
+    tpcds::Table::TBL_ITEM,
+    tpcds::Table::TBL_STORE,
+    tpcds::Table::TBL_CUSTOMER,
+    tpcds::Table::TBL_CUSTOMER_ADDRESS,
+    tpcds::Table::TBL_CUSTOMER_DEMOGRAPHICS,
+    tpcds::Table::TBL_PROMOTION,
+    tpcds::Table::TBL_STORE_SALES};
+
+/// Returns table name as a string.
+std::string_view toTableName(Table table);
+
+/// Returns the table enum value given a table name.
+Table fromTableName(std::string_view tableName);
+
+/// Returns the row count for a particular TPC-DS table given a scale factor.
+/// date_dim and customer_demographics have a fixed size. The other tables
+/// scale linearly from their size at scale factor 1, with at least one row
+/// for the dimensions.
+size_t getRowCount(Table table, double scaleFactor);
+
+/// Returns the schema (RowType) for a particular TPC-DS table.
+RowTypePtr getTableSchema(Table table);
+
+/// Returns the type of a particular table:column pair. Throws if `columnName`
+/// does not exist in `table`.
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName);
+
+/// Returns a row vector with the schema of getTableSchema(table) containing
+/// at most `maxRows` rows of `table`, starting at `offset`, and given the
+/// scale factor. Returns fewer rows if the table has less than `offset` +
+/// `maxRows` rows.
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+} // namespace facebook::velox::tpcds
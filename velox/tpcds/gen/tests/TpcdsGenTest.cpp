@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include "velox/vector/FlatVector.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::tpcds;
+
+class TpcdsGenTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool("TpcdsGenTest");
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(TpcdsGenTest, tableNames) {
+  for (auto table : tables) {
+    EXPECT_EQ(table, fromTableName(toTableName(table)));
+  }
+  EXPECT_THROW(fromTableName("lineitem"), std::invalid_argument);
+}
+
+TEST_F(TpcdsGenTest, rowCount) {
+  EXPECT_EQ(73'049, getRowCount(Table::TBL_DATE_DIM, 100));
+  EXPECT_EQ(1'920'800, getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, 0.01));
+  EXPECT_EQ(18'000, getRowCount(Table::TBL_ITEM, 1));
+  EXPECT_EQ(2'880'404, getRowCount(Table::TBL_STORE_SALES, 1));
+  // Dimensions have at least one row.
+  EXPECT_EQ(1, getRowCount(Table::TBL_STORE, 0.01));
+  EXPECT_EQ(0, getRowCount(Table::TBL_STORE, 0));
+}
+
+TEST_F(TpcdsGenTest, dateDim) {
+  auto rowVector = genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 10, 35'794);
+  ASSERT_EQ(10, rowVector->size());
+  ASSERT_EQ(*getTableSchema(Table::TBL_DATE_DIM), *rowVector->type());
+
+  // The first day of the store sales.
+  EXPECT_EQ(
+      2'450'816, rowVector->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
+  EXPECT_EQ(
+      "AAAAAAAAAIFGFCAA"_sv,
+      rowVector->childAt(1)->asFlatVector<StringView>()->valueAt(0));
+  EXPECT_EQ(
+      DATE()->toDays("1998-01-02"),
+      rowVector->childAt(2)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(1998, rowVector->childAt(5)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(1, rowVector->childAt(7)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(2, rowVector->childAt(8)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(
+      "Friday"_sv,
+      rowVector->childAt(10)->asFlatVector<StringView>()->valueAt(0));
+
+  // Not enough rows past the end of the table.
+  rowVector = genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 10, 73'045);
+  EXPECT_EQ(4, rowVector->size());
+  rowVector = genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 10, 100'000);
+  EXPECT_EQ(0, rowVector->size());
+}
+
+TEST_F(TpcdsGenTest, customerDemographics) {
+  auto rowVector =
+      genTpcdsData(Table::TBL_CUSTOMER_DEMOGRAPHICS, pool_.get(), 25);
+  auto gender = rowVector->childAt(1)->asFlatVector<StringView>();
+  auto maritalStatus = rowVector->childAt(2)->asFlatVector<StringView>();
+  auto educationStatus = rowVector->childAt(3)->asFlatVector<StringView>();
+  EXPECT_EQ("M"_sv, gender->valueAt(0));
+  EXPECT_EQ("F"_sv, gender->valueAt(1));
+  EXPECT_EQ("M"_sv, maritalStatus->valueAt(0));
+  EXPECT_EQ("S"_sv, maritalStatus->valueAt(2));
+  EXPECT_EQ("Primary"_sv, educationStatus->valueAt(0));
+  EXPECT_EQ("Secondary"_sv, educationStatus->valueAt(10));
+  EXPECT_EQ("College"_sv, educationStatus->valueAt(20));
+}
+
+// The foreign keys of store_sales reference rows of the dimensions.
+TEST_F(TpcdsGenTest, storeSales) {
+  const double scaleFactor = 0.01;
+  auto rowVector = genTpcdsData(
+      Table::TBL_STORE_SALES, pool_.get(), 1'000, 5'000, scaleFactor);
+  ASSERT_EQ(1'000, rowVector->size());
+
+  auto checkRange = [&](column_index_t column, int64_t min, int64_t max) {
+    auto values = rowVector->childAt(column)->asFlatVector<int64_t>();
+    for (auto i = 0; i < rowVector->size(); ++i) {
+      ASSERT_GE(values->valueAt(i), min);
+      ASSERT_LE(values->valueAt(i), max);
+    }
+  };
+  checkRange(0, 2'450'816, 2'452'642);
+  checkRange(1, 1, getRowCount(Table::TBL_ITEM, scaleFactor));
+  checkRange(2, 1, getRowCount(Table::TBL_CUSTOMER, scaleFactor));
+  checkRange(3, 1, getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor));
+  checkRange(4, 1, getRowCount(Table::TBL_CUSTOMER_ADDRESS, scaleFactor));
+  checkRange(5, 1, getRowCount(Table::TBL_STORE, scaleFactor));
+  checkRange(6, 1, getRowCount(Table::TBL_PROMOTION, scaleFactor));
+
+  // The line items of a ticket have the same date and customer.
+  auto ticket = rowVector->childAt(7)->asFlatVector<int64_t>();
+  auto date = rowVector->childAt(0)->asFlatVector<int64_t>();
+  auto customer = rowVector->childAt(2)->asFlatVector<int64_t>();
+  EXPECT_EQ(501, ticket->valueAt(0));
+  EXPECT_EQ(ticket->valueAt(0), ticket->valueAt(9));
+  EXPECT_EQ(date->valueAt(0), date->valueAt(9));
+  EXPECT_EQ(customer->valueAt(0), customer->valueAt(9));
+  EXPECT_EQ(502, ticket->valueAt(10));
+}
+
+// Each range of rows is generated independently.
+TEST_F(TpcdsGenTest, deterministic) {
+  for (auto table : tables) {
+    auto all = genTpcdsData(table, pool_.get(), 100, 0, 10);
+    auto part = genTpcdsData(table, pool_.get(), 50, 50, 10);
+    ASSERT_EQ(all->size(), 100) << toTableName(table);
+    ASSERT_EQ(part->size(), 50) << toTableName(table);
+    for (auto i = 0; i < part->size(); ++i) {
+      ASSERT_TRUE(all->equalValueAt(part.get(), 50 + i, i))
+          << toTableName(table) << " row " << 50 + i;
+    }
+  }
+}
+
+} // namespace
@@ -17,6 +17,7 @@
 #include "velox/tpch/gen/TpchGen.h"
 #include <velox/tpch/gen/dbgen/include/tpch_constants.hpp>
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -77,12 +78,53 @@ std::vector<VectorPtr> allocateVectors(
   return vectors;
 }
 
+// Allocates the vectors of 'columns' and null constants for the other columns
+// of 'type'. Allocates all vectors if 'columns' is empty.
+std::vector<VectorPtr> allocateVectors(
+    const RowTypePtr& type,
+    size_t vectorSize,
+    const std::vector<column_index_t>& columns,
+    memory::MemoryPool* pool) {
+  if (columns.empty()) {
+    return allocateVectors(type, vectorSize, pool);
+  }
+  std::vector<bool> projected(type->size());
+  for (auto column : columns) {
+    VELOX_CHECK_LT(column, type->size());
+    projected[column] = true;
+  }
+  std::vector<VectorPtr> vectors;
+  vectors.reserve(type->size());
+  for (auto i = 0; i < type->size(); ++i) {
+    vectors.emplace_back(
+        projected[i]
+            ? BaseVector::create(type->childAt(i), vectorSize, pool)
+            : BaseVector::createNullConstant(
+                  type->childAt(i), vectorSize, pool));
+  }
+  return vectors;
+}
+
 double decimalToDouble(int64_t value) {
   return static_cast<double>(value) * 0.01;
 }
 
+// Dbgen formats all dates as 'YYYY-MM-DD', so this skips the generic date
+// parsing.
 int32_t toDate(std::string_view stringDate) {
-  return DATE()->toDays(stringDate);
+  if (stringDate.size() != 10 || stringDate[4] != '-' ||
+      stringDate[7] != '-') {
+    return DATE()->toDays(stringDate);
+  }
+  const auto digits = [&](int32_t begin, int32_t size) {
+    int32_t value = 0;
+    for (auto i = begin; i < begin + size; ++i) {
+      value = value * 10 + (stringDate[i] - '0');
+    }
+    return value;
+  };
+  return util::daysSinceEpochFromDate(digits(0, 4), digits(5, 2), digits(8, 2))
+      .value();
 }
 
 } // namespace
@@ -358,13 +400,15 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // Create schema and allocate vectors.
   auto ordersRowType = getTableSchema(Table::TBL_ORDERS);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_ORDERS, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(ordersRowType, vectorSize, pool);
+  auto children = allocateVectors(ordersRowType, vectorSize, columns, pool);
 
+  // The vectors of the columns that are not filled are null.
   auto orderKeyVector = children[0]->asFlatVector<int64_t>();
   auto custKeyVector = children[1]->asFlatVector<int64_t>();
   auto orderStatusVector = children[2]->asFlatVector<StringView>();
@@ -384,16 +428,34 @@ RowVectorPtr genTpchOrders(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genOrder(i + offset + 1, order);
 
-    orderKeyVector->set(i, order.okey);
-    custKeyVector->set(i, order.custkey);
-    orderStatusVector->set(i, StringView(&order.orderstatus, 1));
-    totalPriceVector->set(i, decimalToDouble(order.totalprice));
-    orderDateVector->set(i, toDate(order.odate));
-    orderPriorityVector->set(
-        i, StringView(order.opriority, strlen(order.opriority)));
-    clerkVector->set(i, StringView(order.clerk, strlen(order.clerk)));
-    shipPriorityVector->set(i, order.spriority);
-    commentVector->set(i, StringView(order.comment, order.clen));
+    if (orderKeyVector) {
+      orderKeyVector->set(i, order.okey);
+    }
+    if (custKeyVector) {
+      custKeyVector->set(i, order.custkey);
+    }
+    if (orderStatusVector) {
+      orderStatusVector->set(i, StringView(&order.orderstatus, 1));
+    }
+    if (totalPriceVector) {
+      totalPriceVector->set(i, decimalToDouble(order.totalprice));
+    }
+    if (orderDateVector) {
+      orderDateVector->set(i, toDate(order.odate));
+    }
+    if (orderPriorityVector) {
+      orderPriorityVector->set(
+          i, StringView(order.opriority, strlen(order.opriority)));
+    }
+    if (clerkVector) {
+      clerkVector->set(i, StringView(order.clerk, strlen(order.clerk)));
+    }
+    if (shipPriorityVector) {
+      shipPriorityVector->set(i, order.spriority);
+    }
+    if (commentVector) {
+      commentVector->set(i, StringView(order.comment, order.clen));
+    }
   }
   return std::make_shared<RowVector>(
       pool, ordersRowType, BufferPtr(nullptr), vectorSize, std::move(children));
@@ -403,7 +465,8 @@ RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrderRows,
     size_t ordersOffset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::vector<column_index_t>& columns) {
   // We control the buffer size based on the orders table, then allocate the
   // underlying buffer using the worst case (orderVectorSize * 7).
   size_t orderVectorSize = getVectorSize(
@@ -412,8 +475,10 @@ RowVectorPtr genTpchLineItem(
 
   // Create schema and allocate vectors.
   auto lineItemRowType = getTableSchema(Table::TBL_LINEITEM);
-  auto children = allocateVectors(lineItemRowType, lineItemUpperBound, pool);
+  auto children =
+      allocateVectors(lineItemRowType, lineItemUpperBound, columns, pool);
 
+  // The vectors of the columns that are not filled are null.
   auto orderKeyVector = children[0]->asFlatVector<int64_t>();
   auto partKeyVector = children[1]->asFlatVector<int64_t>();
   auto suppKeyVector = children[2]->asFlatVector<int64_t>();
@@ -448,31 +513,62 @@ RowVectorPtr genTpchLineItem(
 
     for (size_t l = 0; l < order.lines; ++l) {
       const auto& line = order.l[l];
-      orderKeyVector->set(lineItemCount + l, line.okey);
-      partKeyVector->set(lineItemCount + l, line.partkey);
-      suppKeyVector->set(lineItemCount + l, line.suppkey);
-
-      lineNumberVector->set(lineItemCount + l, line.lcnt);
-
-      quantityVector->set(lineItemCount + l, line.quantity);
-      extendedPriceVector->set(lineItemCount + l, decimalToDouble(line.eprice));
-      discountVector->set(lineItemCount + l, decimalToDouble(line.discount));
-      taxVector->set(lineItemCount + l, decimalToDouble(line.tax));
-
-      returnFlagVector->set(lineItemCount + l, StringView(line.rflag, 1));
-      lineStatusVector->set(lineItemCount + l, StringView(line.lstatus, 1));
-
-      shipDateVector->set(lineItemCount + l, toDate(line.sdate));
-      commitDateVector->set(lineItemCount + l, toDate(line.cdate));
-      receiptDateVector->set(lineItemCount + l, toDate(line.rdate));
-
-      shipInstructVector->set(
-          lineItemCount + l,
-          StringView(line.shipinstruct, strlen(line.shipinstruct)));
-      shipModeVector->set(
-          lineItemCount + l, StringView(line.shipmode, strlen(line.shipmode)));
-      commentVector->set(
-          lineItemCount + l, StringView(line.comment, strlen(line.comment)));
+      const auto row = lineItemCount + l;
+      if (orderKeyVector) {
+        orderKeyVector->set(row, line.okey);
+      }
+      if (partKeyVector) {
+        partKeyVector->set(row, line.partkey);
+      }
+      if (suppKeyVector) {
+        suppKeyVector->set(row, line.suppkey);
+      }
+      if (lineNumberVector) {
+        lineNumberVector->set(row, line.lcnt);
+      }
+
+      if (quantityVector) {
+        quantityVector->set(row, line.quantity);
+      }
+      if (extendedPriceVector) {
+        extendedPriceVector->set(row, decimalToDouble(line.eprice));
+      }
+      if (discountVector) {
+        discountVector->set(row, decimalToDouble(line.discount));
+      }
+      if (taxVector) {
+        taxVector->set(row, decimalToDouble(line.tax));
+      }
+
+      if (returnFlagVector) {
+        returnFlagVector->set(row, StringView(line.rflag, 1));
+      }
+      if (lineStatusVector) {
+        lineStatusVector->set(row, StringView(line.lstatus, 1));
+      }
+
+      if (shipDateVector) {
+        shipDateVector->set(row, toDate(line.sdate));
+      }
+      if (commitDateVector) {
+        commitDateVector->set(row, toDate(line.cdate));
+      }
+      if (receiptDateVector) {
+        receiptDateVector->set(row, toDate(line.rdate));
+      }
+
+      if (shipInstructVector) {
+        shipInstructVector->set(
+            row, StringView(line.shipinstruct, strlen(line.shipinstruct)));
+      }
+      if (shipModeVector) {
+        shipModeVector->set(
+            row, StringView(line.shipmode, strlen(line.shipmode)));
+      }
+      if (commentVector) {
+        commentVector->set(
+            row, StringView(line.comment, strlen(line.comment)));
+      }
     }
     lineItemCount += order.lines;
   }
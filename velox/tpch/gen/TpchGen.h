@@ -33,7 +33,10 @@ namespace facebook::velox::tpch {
 /// If not enough records are available given a particular scale factor and
 /// offset, less than maxRows records might be returned.
 ///
-/// Data is always returned in a RowVector.
+/// Data is always returned in a RowVector. The generators of the large tables
+/// (orders and lineitem) take the indices of the columns to fill. The other
+/// columns are returned as null constants, which saves copying and allocating
+/// them. All columns are filled by default.
 
 enum class Table : uint8_t {
   TBL_PART,
@@ -93,7 +96,8 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows = 10000,
     size_t offset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// NOTE: This function's parameters have different semantic from the function
 /// above. Dbgen does not provide deterministic random access to lineitem
@@ -131,7 +135,8 @@ RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrdersRows = 10000,
     size_t ordersOffset = 0,
-    double scaleFactor = 1);
+    double scaleFactor = 1,
+    const std::vector<column_index_t>& columns = {});
 
 /// Returns a row vector containing at most `maxRows` rows of the "part"
 /// table, starting at `offset`, and given the scale factor. The row vector
@@ -309,6 +309,25 @@ TEST_F(TpchGenTestOrdersTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestOrdersTest, columns) {
+  auto all = genTpchOrders(pool_.get(), 1000, 2000);
+  auto projected = genTpchOrders(pool_.get(), 1000, 2000, 1, {4, 8});
+  ASSERT_EQ(all->size(), projected->size());
+  ASSERT_EQ(*all->type(), *projected->type());
+  for (auto column = 0; column < all->childrenSize(); ++column) {
+    const auto& child = projected->childAt(column);
+    if (column == 4 || column == 8) {
+      ASSERT_EQ(child->encoding(), VectorEncoding::Simple::FLAT);
+      for (auto i = 0; i < all->size(); ++i) {
+        ASSERT_TRUE(child->equalValueAt(all->childAt(column).get(), i, i));
+      }
+    } else {
+      ASSERT_TRUE(child->isConstantEncoding());
+      ASSERT_TRUE(child->isNullAt(0));
+    }
+  }
+}
+
 // Lineitem.
 class TpchGenTestLineItemTest : public testing::Test {
  protected:
@@ -427,6 +446,24 @@ TEST_F(TpchGenTestLineItemTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestLineItemTest, columns) {
+  auto all = genTpchLineItem(pool_.get(), 1000, 2000);
+  auto projected = genTpchLineItem(pool_.get(), 1000, 2000, 1, {0, 10, 15});
+  ASSERT_EQ(all->size(), projected->size());
+  for (auto column = 0; column < all->childrenSize(); ++column) {
+    const auto& child = projected->childAt(column);
+    if (column == 0 || column == 10 || column == 15) {
+      ASSERT_EQ(child->size(), all->size());
+      for (auto i = 0; i < all->size(); ++i) {
+        ASSERT_TRUE(child->equalValueAt(all->childAt(column).get(), i, i));
+      }
+    } else {
+      ASSERT_TRUE(child->isConstantEncoding());
+      ASSERT_EQ(child->size(), all->size());
+    }
+  }
+}
+
 // Supplier.
 class TpchGenTestSupplierTest : public testing::Test {
  protected:
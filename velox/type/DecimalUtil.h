@@ -460,6 +460,136 @@ class DecimalUtil {
     return sum;
   }
 
+  /// Adds 'size' values to 'sum' and 'overflow', which hold a sum as
+  /// maintained by addWithOverflow. Accumulates the low and high 64 bits of
+  /// the values separately, so that the loop has no branches, and splits the
+  /// total into sum and overflow once for the batch. The resulting sum and
+  /// overflow may differ from adding the values one by one with
+  /// addWithOverflow but adjustSumForOverflow returns the same result for
+  /// both.
+  template <typename T>
+  static void addBatchWithOverflow(
+      int128_t& sum,
+      int64_t& overflow,
+      const T* values,
+      int32_t size) {
+    static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, int128_t>);
+    int128_t batchSum;
+    int64_t batchOverflow = 0;
+    if constexpr (std::is_same_v<T, int64_t>) {
+      // Fewer than 2^63 values of 64 bits cannot overflow 128 bits.
+      batchSum = 0;
+      for (auto i = 0; i < size; ++i) {
+        batchSum += values[i];
+      }
+    } else {
+      uint128_t low = 0;
+      int128_t high = 0;
+      for (auto i = 0; i < size; ++i) {
+        low += static_cast<uint64_t>(values[i]);
+        high += static_cast<int64_t>(values[i] >> 64);
+      }
+      // The total is high * 2^64 + low. Moves the carry of 'low' to 'high',
+      // then splits the total into (high >> 63) * 2^127 and a non-negative
+      // remainder below 2^127.
+      high += static_cast<int128_t>(low >> 64);
+      batchOverflow = static_cast<int64_t>(high >> 63);
+      constexpr auto kLow63Bits = (static_cast<uint128_t>(1) << 63) - 1;
+      const auto remainder = static_cast<uint128_t>(high) & kLow63Bits;
+      batchSum = static_cast<int128_t>(
+          (remainder << 64) | static_cast<uint64_t>(low));
+    }
+    overflow += batchOverflow + addWithOverflow(sum, batchSum, sum);
+  }
+
+  /// Computes 'result[i] = a[i] * 10^aRescale +/- b[i] * 10^bRescale' for
+  /// 'size' values in one pass with precomputed rescale factors. Accumulates
+  /// the overflow checks over the batch instead of branching per value.
+  /// Returns false if any of the operations overflows or a result is out of
+  /// the range of 'R' or of long decimals. 'result' is then unspecified and
+  /// the caller processes the values one by one to report the error.
+  template <bool kSubtract, typename R, typename A, typename B>
+  static bool addBatch(
+      R* result,
+      const A* a,
+      const B* b,
+      int32_t size,
+      uint8_t aRescale,
+      uint8_t bRescale) {
+    const auto aFactor = kPowersOfTen[aRescale];
+    const auto bFactor = kPowersOfTen[bRescale];
+    // |x * factor| fits in int128_t if |x| <= limit.
+    const auto aLimit = std::numeric_limits<int128_t>::max() / aFactor;
+    const auto bLimit = std::numeric_limits<int128_t>::max() / bFactor;
+    bool overflow = false;
+    for (auto i = 0; i < size; ++i) {
+      const int128_t aValue = a[i];
+      const int128_t bValue = b[i];
+      overflow |= (aValue > aLimit) | (aValue < -aLimit);
+      overflow |= (bValue > bLimit) | (bValue < -bLimit);
+      // Multiplies as unsigned to avoid undefined behavior on the values
+      // flagged above.
+      const auto aRescaled = static_cast<int128_t>(
+          static_cast<uint128_t>(aValue) * static_cast<uint128_t>(aFactor));
+      const auto bRescaled = static_cast<int128_t>(
+          static_cast<uint128_t>(bValue) * static_cast<uint128_t>(bFactor));
+      int128_t value;
+      if constexpr (kSubtract) {
+        overflow |= __builtin_sub_overflow(aRescaled, bRescaled, &value);
+      } else {
+        overflow |= __builtin_add_overflow(aRescaled, bRescaled, &value);
+      }
+      overflow |= (value < kLongDecimalMin) | (value > kLongDecimalMax);
+      if constexpr (!std::is_same_v<R, int128_t>) {
+        overflow |= value != static_cast<R>(value);
+      }
+      result[i] = static_cast<R>(value);
+    }
+    return !overflow;
+  }
+
+  /// Computes 'result[i] = a[i] * b[i]' for 'size' values. Multiplies 64-bit
+  /// values without overflow checks if all the inputs fit in 64 bits, which
+  /// holds for short decimals and most long decimals, and checks the range of
+  /// the results for the batch. Returns false on overflow as addBatch().
+  template <typename R, typename A, typename B>
+  static bool multiplyBatch(R* result, const A* a, const B* b, int32_t size) {
+    bool overflow = false;
+    bool all64Bit = true;
+    if constexpr (sizeof(A) > sizeof(int64_t) || sizeof(B) > sizeof(int64_t)) {
+      const auto fits64Bit = [](int128_t value) {
+        return value == static_cast<int64_t>(value);
+      };
+      for (auto i = 0; i < size; ++i) {
+        all64Bit &= fits64Bit(a[i]) & fits64Bit(b[i]);
+      }
+    }
+    if (all64Bit) {
+      // The product of two 64-bit values fits in 128 bits.
+      for (auto i = 0; i < size; ++i) {
+        const auto value = static_cast<int128_t>(static_cast<int64_t>(a[i])) *
+            static_cast<int64_t>(b[i]);
+        overflow |= (value < kLongDecimalMin) | (value > kLongDecimalMax);
+        if constexpr (!std::is_same_v<R, int128_t>) {
+          overflow |= value != static_cast<R>(value);
+        }
+        result[i] = static_cast<R>(value);
+      }
+    } else {
+      for (auto i = 0; i < size; ++i) {
+        int128_t value;
+        overflow |= __builtin_mul_overflow(
+            static_cast<int128_t>(a[i]), static_cast<int128_t>(b[i]), &value);
+        overflow |= (value < kLongDecimalMin) | (value > kLongDecimalMax);
+        if constexpr (!std::is_same_v<R, int128_t>) {
+          overflow |= value != static_cast<R>(value);
+        }
+        result[i] = static_cast<R>(value);
+      }
+    }
+    return !overflow;
+  }
+
   /// avg = (sum + overflow * kOverflowMultiplier) / count
   static void
   computeAverage(int128_t& avg, int128_t sum, int64_t count, int64_t overflow);
@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/hash/Hash.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +197,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -645,6 +654,63 @@ bool BytesValues::testingEquals(const Filter& other) const {
   return true;
 }
 
+void BytesValues::makeHashTable() {
+  minLength_ = std::numeric_limits<int32_t>::max();
+  maxLength_ = 0;
+  views_.reserve(values_.size());
+  for (const auto& value : values_) {
+    views_.emplace_back(value.data(), value.size());
+    minLength_ = std::min<int32_t>(minLength_, value.size());
+    maxLength_ = std::max<int32_t>(maxLength_, value.size());
+  }
+  const auto capacity = bits::nextPowerOfTwo(
+      std::max<uint64_t>(2 * views_.size(), xsimd::batch<int32_t>::size));
+  hashMask_ = capacity - 1;
+  fingerprints_.assign(capacity, kEmptySlot);
+  slotValues_.assign(capacity, 0);
+  for (auto i = 0; i < views_.size(); ++i) {
+    const auto hash = hashValue(views_[i]);
+    auto slot = hash & hashMask_;
+    while (fingerprints_[slot] != kEmptySlot) {
+      slot = (slot + 1) & hashMask_;
+    }
+    fingerprints_[slot] = fingerprint(hash);
+    slotValues_[slot] = i;
+  }
+}
+
+void BytesValues::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  constexpr int32_t kBatchSize = xsimd::batch<int32_t>::size;
+  uint64_t hashes[kBatchSize];
+  int32_t slots[kBatchSize];
+  int32_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    for (auto j = 0; j < kBatchSize; ++j) {
+      hashes[j] = hashValue(values[i + j]);
+      slots[j] = hashes[j] & hashMask_;
+    }
+    // Values whose home slot is empty are not in the set.
+    const auto occupied = ~simd::toBitMask(
+        simd::gather(fingerprints_.data(), slots) ==
+        xsimd::batch<int32_t>::broadcast(kEmptySlot));
+    for (auto j = 0; j < kBatchSize; ++j) {
+      const auto& value = values[i + j];
+      const int32_t size = value.size();
+      bits::setBit(
+          passed,
+          i + j,
+          (occupied & (1 << j)) && size >= minLength_ && size <= maxLength_ &&
+              contains(value, hashes[j]));
+    }
+  }
+  for (; i < numValues; ++i) {
+    bits::setBit(passed, i, testBytes(values[i].data(), values[i].size()));
+  }
+}
+
 folly::dynamic BigintMultiRange::serialize() const {
   auto obj = Filter::serializeBase("BigintMultiRange");
   folly::dynamic arr = folly::dynamic::array;
@@ -1028,6 +1094,7 @@ bool HugeintValuesUsingHashTable::testingEquals(const Filter& other) const {
   return true;
 }
 
+
 NegatedBigintValuesUsingBitmask::NegatedBigintValuesUsingBitmask(
     int64_t min,
     int64_t max,
@@ -1864,6 +1931,8 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
           std::make_unique<common::BigintRange>(lower_, upper_, false));
       return combineRangesAndNegatedValues(rangeList, vals, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1983,6 +2052,8 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
           negatedValuesToRanges(rejectedValues),
           bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2041,6 +2112,8 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2134,6 +2207,8 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2188,6 +2263,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
       return other->mergeWith(this);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2232,6 +2309,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
       return combineNegatedBigintLists(
           values(), otherBitmask->values(), bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2305,6 +2384,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return combineRangesAndNegatedValues(ranges_, rejects, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2630,4 +2711,153 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed,
+    std::shared_ptr<const Filter> baseFilter)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)),
+      baseFilter_(std::move(baseFilter)) {
+  VELOX_CHECK_LE(min_, max_, "min must not be greater than max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+// static
+uint64_t BigintValuesUsingBloomFilter::hash(int64_t value) {
+  return folly::hash::twang_mix64(value);
+}
+
+bool BigintValuesUsingBloomFilter::testInt64(int64_t value) const {
+  if (baseFilter_ && !baseFilter_->testInt64(value)) {
+    return false;
+  }
+  if (value < min_ || value > max_) {
+    return false;
+  }
+  if (disabled_) {
+    return true;
+  }
+  const bool passed = bloomFilter_->mayContain(hash(value));
+  if (!passed) {
+    ++numRejected_;
+  }
+  if (++numTested_ == kSelectivityCheckInterval) {
+    disabled_ = numRejected_ * 100 < numTested_ * kMinRejectedPct;
+  }
+  return passed;
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min > max_ || max < min_) {
+    return false;
+  }
+  return !baseFilter_ || baseFilter_->testInt64Range(min, max, hasNull);
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+      return clone();
+    case FilterKind::kAlwaysFalse:
+      return other->clone();
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return clone(false);
+    default: {
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::shared_ptr<const Filter> baseFilter =
+          baseFilter_ ? baseFilter_->mergeWith(other) : other->clone();
+      if (baseFilter->kind() == FilterKind::kAlwaysFalse ||
+          baseFilter->kind() == FilterKind::kIsNull) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min_, max_, bloomFilter_, bothNullAllowed, std::move(baseFilter));
+    }
+  }
+}
+
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+
+  // The serialized Bloom filter is a version byte, a 32 bit word count and
+  // the 64 bit words.
+  std::string serialized(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(serialized.data());
+  constexpr int32_t kHeaderSize = sizeof(int8_t) + sizeof(int32_t);
+  folly::dynamic words = folly::dynamic::array;
+  for (auto offset = kHeaderSize; offset < serialized.size();
+       offset += sizeof(int64_t)) {
+    int64_t word;
+    memcpy(&word, serialized.data() + offset, sizeof(word));
+    words.push_back(word);
+  }
+  obj["bloomFilterVersion"] = static_cast<int64_t>(serialized[0]);
+  obj["bloomFilter"] = words;
+  if (baseFilter_) {
+    obj["baseFilter"] = baseFilter_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+
+  const auto& words = obj["bloomFilter"];
+  const int32_t numWords = words.size();
+  std::string serialized;
+  serialized.push_back(static_cast<char>(obj["bloomFilterVersion"].asInt()));
+  serialized.append(reinterpret_cast<const char*>(&numWords), sizeof(int32_t));
+  for (const auto& word : words) {
+    const int64_t value = word.asInt();
+    serialized.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+
+  std::shared_ptr<const Filter> baseFilter;
+  if (obj.count("baseFilter")) {
+    baseFilter = ISerializable::deserialize<Filter>(obj["baseFilter"]);
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed, std::move(baseFilter));
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_ ||
+      (baseFilter_ == nullptr) != (otherBloomFilter->baseFilter_ == nullptr)) {
+    return false;
+  }
+  if (baseFilter_ &&
+      !baseFilter_->testingEquals(*otherBloomFilter->baseFilter_)) {
+    return false;
+  }
+  std::string serialized(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(serialized.data());
+  std::string otherSerialized(
+      otherBloomFilter->bloomFilter_->serializedSize(), '\0');
+  otherBloomFilter->bloomFilter_->serialize(otherSerialized.data());
+  return serialized == otherSerialized;
+}
+
 } // namespace facebook::velox::common
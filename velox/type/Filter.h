@@ -25,6 +25,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -57,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -196,6 +198,18 @@ class Filter : public velox::ISerializable {
     VELOX_UNSUPPORTED("{}: testBytes() is not supported.", toString());
   }
 
+  /// Tests 'numValues' strings starting at 'values'. Sets bit i of 'passed'
+  /// if values[i] passes the filter and clears it otherwise. Filters on
+  /// strings may override this to test several values at a time.
+  virtual void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const {
+    for (auto i = 0; i < numValues; ++i) {
+      bits::setBit(passed, i, testBytes(values[i].data(), values[i].size()));
+    }
+  }
+
   virtual bool testTimestamp(const Timestamp& /* unused */) const {
     VELOX_UNSUPPORTED("{}: testTimestamp() is not supported.", toString());
   }
@@ -1134,6 +1148,99 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types with too many values for a hash
+/// table or bitmask, e.g. the join keys of a large hash join build side.
+/// Implemented as a Bloom filter, so some values not in the list pass. The
+/// filter is only worth evaluating if it rejects rows. It counts the values it
+/// tests and turns the Bloom filter off, i.e. passes all values within [min,
+/// max], if fewer than kMinRejectedPct percent of the first
+/// kSelectivityCheckInterval values are rejected. Values must also pass the
+/// optional 'baseFilter', which is used to merge with other integer filters.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  static constexpr int32_t kSelectivityCheckInterval = 10'000;
+  static constexpr int32_t kMinRejectedPct = 10;
+
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter of the hashes of the values, as returned
+  /// by hash().
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param baseFilter Optional filter that values must also pass.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> baseFilter = nullptr);
+
+  /// Copies 'other' except for the selectivity tracking state.
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, other.kind()),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_),
+        baseFilter_(other.baseFilter_) {}
+
+  /// Returns the hash of 'value' to insert into the Bloom filter.
+  static uint64_t hash(int64_t value);
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  bool testInt64(int64_t value) const final;
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  /// True if the Bloom filter has been turned off for not rejecting enough
+  /// values.
+  bool isBloomFilterDisabled() const {
+    return disabled_;
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}]{} {}",
+        min_,
+        max_,
+        baseFilter_ ? " and " + baseFilter_->toString() : "",
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+  const std::shared_ptr<const Filter> baseFilter_;
+
+  // Selectivity tracking. A filter is used by one reader at a time, like the
+  // other state kept in ScanSpec, so these are not atomic.
+  mutable int32_t numTested_{0};
+  mutable int32_t numRejected_{0};
+  mutable bool disabled_{false};
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1924,6 +2031,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    makeHashTable();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1931,7 +2039,12 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_) {
+    makeHashTable();
+  }
+
+  BytesValues(const BytesValues& other)
+      : BytesValues(other, other.nullAllowed_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1951,10 +2064,20 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    if (length < minLength_ || length > maxLength_) {
+      return false;
+    }
+    const StringView view(value, length);
+    return contains(view, hashValue(view));
   }
 
+  /// Hashes 'xsimd::batch<int32_t>::size' values at a time and rejects the
+  /// values whose home slot in the hash table is empty with one gather.
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1969,10 +2092,60 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Marks an empty slot in 'fingerprints_'.
+  static constexpr int32_t kEmptySlot = 0;
+
+  // Hashes strings of up to StringView::kInlineSize bytes from the two words
+  // of their StringView and longer strings from their bytes.
+  static uint64_t hashValue(StringView value) {
+    if (value.isInline()) {
+      uint64_t words[2];
+      memcpy(words, &value, sizeof(words));
+      // The second word is not initialized for empty strings.
+      return bits::hashMix(
+          words[0], value.size() <= StringView::kPrefixSize ? 0 : words[1]);
+    }
+    return bits::hashBytes(value.size(), value.data(), value.size());
+  }
+
+  // Returns the high half of 'hash', never equal to kEmptySlot.
+  static int32_t fingerprint(uint64_t hash) {
+    return static_cast<int32_t>(hash >> 32) | 1;
+  }
+
+  bool contains(StringView value, uint64_t hash) const {
+    const auto expected = fingerprint(hash);
+    for (auto slot = hash & hashMask_;; slot = (slot + 1) & hashMask_) {
+      const auto actual = fingerprints_[slot];
+      if (actual == expected && views_[slotValues_[slot]] == value) {
+        return true;
+      }
+      if (actual == kEmptySlot) {
+        return false;
+      }
+    }
+  }
+
+  // Fills the hash table from 'values_'.
+  void makeHashTable();
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  int32_t minLength_;
+  int32_t maxLength_;
+
+  // Open addressing hash table of 'views_' with linear probing and a load
+  // factor of at most 0.5. Each slot has the fingerprint of the hash of a
+  // value, so that most mismatches are decided without comparing strings.
+  std::vector<int32_t> fingerprints_;
+  // Index into 'views_' for the values in 'fingerprints_'.
+  std::vector<int32_t> slotValues_;
+  uint64_t hashMask_;
+  // Views of 'values_'. Values of up to StringView::kInlineSize bytes are
+  // inlined and compare equal with two word compares.
+  std::vector<StringView> views_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -2059,6 +2232,14 @@ class NegatedBytesValues final : public Filter {
     return !nonNegated_->testBytes(value, length);
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final {
+    nonNegated_->testStringViews(values, numValues, passed);
+    bits::negate(passed, numValues);
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
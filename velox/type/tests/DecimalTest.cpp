@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/type/DecimalUtil.h"
 
@@ -364,6 +366,130 @@ TEST(DecimalAggregateTest, adjustSumForOverflow) {
   EXPECT_FALSE(accumulator.adjustedSum().has_value());
 }
 
+TEST(DecimalAggregateTest, addBatchWithOverflow) {
+  auto testSum = [](const std::vector<int128_t>& values) {
+    int128_t expectedSum = 0;
+    int64_t expectedOverflow = 0;
+    for (auto value : values) {
+      expectedOverflow +=
+          DecimalUtil::addWithOverflow(expectedSum, expectedSum, value);
+    }
+    // Starts from a non-zero state as when merging into an accumulator.
+    int128_t sum = DecimalUtil::kLongDecimalMax;
+    int64_t overflow = 0;
+    DecimalUtil::addBatchWithOverflow(
+        sum, overflow, values.data(), values.size());
+    overflow += DecimalUtil::addWithOverflow(
+        sum, sum, -DecimalUtil::kLongDecimalMax);
+    EXPECT_EQ(
+        DecimalUtil::adjustSumForOverflow(sum, overflow),
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow));
+  };
+
+  testSum({});
+  testSum({1, -2, 3});
+  testSum({DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax});
+  testSum({DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin});
+  testSum(
+      {DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMin});
+  testSum(
+      {DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMax});
+
+  std::vector<int128_t> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(
+        (i % 3 == 0 ? -1 : 1) * DecimalUtil::kPowersOfTen[i % 39] + i);
+  }
+  testSum(values);
+
+  std::vector<int64_t> shortValues;
+  for (auto i = 0; i < 1'000; ++i) {
+    shortValues.push_back(
+        (i % 2 == 0 ? -1 : 3) * DecimalUtil::kShortDecimalMax + i);
+  }
+  int128_t sum = 0;
+  int64_t overflow = 0;
+  DecimalUtil::addBatchWithOverflow(
+      sum, overflow, shortValues.data(), shortValues.size());
+  EXPECT_EQ(overflow, 0);
+  EXPECT_EQ(
+      sum,
+      std::accumulate(shortValues.begin(), shortValues.end(), int128_t(0)));
+}
+
+TEST(DecimalTest, addBatch) {
+  const std::vector<int128_t> a = {
+      1, -25, DecimalUtil::kPowersOfTen[30], -DecimalUtil::kPowersOfTen[30]};
+  const std::vector<int64_t> b = {7, 3, -4, 11};
+  std::vector<int128_t> result(a.size());
+  ASSERT_TRUE(DecimalUtil::addBatch<false>(
+      result.data(), a.data(), b.data(), a.size(), 2, 0));
+  for (auto i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(result[i], a[i] * 100 + b[i]);
+  }
+  ASSERT_TRUE(DecimalUtil::addBatch<true>(
+      result.data(), a.data(), b.data(), a.size(), 0, 3));
+  for (auto i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(result[i], a[i] - b[i] * 1'000);
+  }
+
+  // The rescaled value overflows int128_t.
+  ASSERT_FALSE(DecimalUtil::addBatch<false>(
+      result.data(), a.data(), b.data(), a.size(), 9, 0));
+  // The result is out of the range of long decimals.
+  const std::vector<int128_t> max = {0, DecimalUtil::kLongDecimalMax};
+  const std::vector<int128_t> one = {1, 1};
+  ASSERT_FALSE(DecimalUtil::addBatch<false>(
+      result.data(), max.data(), one.data(), max.size(), 0, 0));
+  ASSERT_TRUE(DecimalUtil::addBatch<true>(
+      result.data(), max.data(), one.data(), max.size(), 0, 0));
+
+  // The result does not fit in a short decimal.
+  const std::vector<int64_t> shortValues = {
+      std::numeric_limits<int64_t>::max()};
+  std::vector<int64_t> shortResult(1);
+  ASSERT_FALSE(DecimalUtil::addBatch<false>(
+      shortResult.data(), shortValues.data(), shortValues.data(), 1, 0, 0));
+}
+
+TEST(DecimalTest, multiplyBatch) {
+  const auto large = DecimalUtil::kPowersOfTen[20];
+  std::vector<int128_t> a = {3, -7, 1'000'000'007, 5};
+  std::vector<int128_t> b = {-2, -9, 1'000'000'009, large};
+  std::vector<int128_t> result(a.size());
+  // With and without a value above 64 bits.
+  for (auto size : {3, 4}) {
+    ASSERT_TRUE(
+        DecimalUtil::multiplyBatch(result.data(), a.data(), b.data(), size));
+    for (auto i = 0; i < size; ++i) {
+      EXPECT_EQ(result[i], a[i] * b[i]);
+    }
+  }
+
+  b[0] = large;
+  a[0] = large;
+  ASSERT_FALSE(
+      DecimalUtil::multiplyBatch(result.data(), a.data(), b.data(), a.size()));
+
+  const std::vector<int64_t> shortA = {DecimalUtil::kShortDecimalMax, 2};
+  const std::vector<int64_t> shortB = {1, DecimalUtil::kShortDecimalMax};
+  std::vector<int128_t> longResult(2);
+  ASSERT_TRUE(DecimalUtil::multiplyBatch(
+      longResult.data(), shortA.data(), shortB.data(), 2));
+  EXPECT_EQ(longResult[1], int128_t(2) * DecimalUtil::kShortDecimalMax);
+  // The result does not fit in a short decimal.
+  std::vector<int64_t> shortResult(2);
+  ASSERT_TRUE(DecimalUtil::multiplyBatch(
+      shortResult.data(), shortA.data(), shortB.data(), 2));
+  const std::vector<int64_t> ten = {10, 10};
+  ASSERT_FALSE(DecimalUtil::multiplyBatch(
+      shortResult.data(), shortA.data(), ten.data(), 2));
+}
+
 TEST(DecimalTest, rescaleDouble) {
   assertRescaleDouble(-3333.03, DECIMAL(10, 4), -33'330'300);
   assertRescaleDouble(-3333.03, DECIMAL(20, 1), -33'330);
@@ -32,6 +32,11 @@ std::vector<int64_t> sparseValues;
 std::vector<int64_t> denseValues;
 std::unique_ptr<BigintValuesUsingHashTable> filter;
 
+std::vector<std::string> strings;
+std::vector<StringView> stringViews;
+folly::F14FastSet<std::string> stringSet;
+std::unique_ptr<BytesValues> bytesFilter;
+
 int32_t run1x64(const std::vector<int64_t>& data) {
   int32_t count = 0;
   for (auto i = 0; i < data.size(); ++i) {
@@ -51,6 +56,35 @@ int32_t run4x64(const std::vector<int64_t>& data) {
   return count;
 }
 
+// Lookup of a std::string copy of each value in a set, as BytesValues did
+// before it had its own hash table.
+int32_t runStringSet() {
+  int32_t count = 0;
+  for (const auto& view : stringViews) {
+    count += stringSet.contains(std::string(view.data(), view.size()));
+  }
+  return count;
+}
+
+int32_t runBytes() {
+  int32_t count = 0;
+  for (const auto& view : stringViews) {
+    count += bytesFilter->testBytes(view.data(), view.size());
+  }
+  return count;
+}
+
+int32_t runStringViews() {
+  constexpr int32_t kBatch = 64;
+  int32_t count = 0;
+  uint64_t passed;
+  for (auto i = 0; i < stringViews.size(); i += kBatch) {
+    bytesFilter->testStringViews(stringViews.data() + i, kBatch, &passed);
+    count += __builtin_popcountll(passed);
+  }
+  return count;
+}
+
 BENCHMARK(scalarDense) {
   folly::doNotOptimizeAway(run1x64(denseValues));
 }
@@ -67,6 +101,18 @@ BENCHMARK_RELATIVE(simdSparse) {
   folly::doNotOptimizeAway(run4x64(sparseValues));
 }
 
+BENCHMARK(stringSet) {
+  folly::doNotOptimizeAway(runStringSet());
+}
+
+BENCHMARK_RELATIVE(bytesValues) {
+  folly::doNotOptimizeAway(runBytes());
+}
+
+BENCHMARK_RELATIVE(bytesValuesBatch) {
+  folly::doNotOptimizeAway(runStringViews());
+}
+
 int32_t main(int32_t argc, char* argv[]) {
   constexpr int32_t kNumValues = 1000000;
   constexpr int32_t kFilterValues = 1000;
@@ -86,8 +132,30 @@ int32_t main(int32_t argc, char* argv[]) {
     sparseValues[i] = (folly::Random::rand32() % 100000) * 1000;
   }
 
+  // 10K strings in the IN-list, half inlined in StringView. A third of the
+  // tested values pass.
+  std::vector<std::string> stringValues;
+  constexpr int32_t kStringFilterValues = 10000;
+  for (auto i = 0; i < kStringFilterValues; ++i) {
+    stringValues.push_back(
+        i % 2 ? fmt::format("{}", i * 1000)
+              : fmt::format("out of line string {}", i * 1000));
+  }
+  stringSet.insert(stringValues.begin(), stringValues.end());
+  bytesFilter = std::make_unique<BytesValues>(stringValues, false);
+  strings.resize(kNumValues);
+  for (auto i = 0; i < kNumValues; ++i) {
+    strings[i] = stringValues[folly::Random::rand32() % kStringFilterValues];
+    if (folly::Random::rand32() % 3) {
+      strings[i] += "-";
+    }
+  }
+  stringViews.assign(strings.begin(), strings.end());
+
   VELOX_CHECK_EQ(run1x64(denseValues), run4x64(denseValues));
   VELOX_CHECK_EQ(run1x64(sparseValues), run4x64(sparseValues));
+  VELOX_CHECK_EQ(runStringSet(), runBytes());
+  VELOX_CHECK_EQ(runStringSet(), runStringViews());
   folly::runBenchmarks();
   return 0;
 }
@@ -463,6 +463,81 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto makeFilter = [](const std::vector<int64_t>& values) {
+    auto bloomFilter = std::make_shared<BloomFilter<>>();
+    bloomFilter->reset(values.size());
+    for (auto value : values) {
+      bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+    }
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *std::min_element(values.begin(), values.end()),
+        *std::max_element(values.begin(), values.end()),
+        std::move(bloomFilter),
+        false);
+  };
+
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i * 1'000);
+  }
+  auto filter = makeFilter(values);
+  EXPECT_FALSE(filter->testNull());
+  for (auto value : values) {
+    EXPECT_TRUE(filter->testInt64(value));
+  }
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(1'000'000));
+  EXPECT_TRUE(filter->testInt64Range(0, 10, false));
+  EXPECT_FALSE(filter->testInt64Range(1'000'000, 2'000'000, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -1, false));
+
+  // Most values between the build side values are rejected.
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numPassed += filter->testInt64(i * 1'000 + 1);
+  }
+  EXPECT_LT(numPassed, 100);
+
+  // Merging with a range restricts the values.
+  auto merged = filter->mergeWith(between(0, 10'000).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(5'000));
+  EXPECT_FALSE(merged->testInt64(20'000));
+  EXPECT_FALSE(merged->testInt64(5'001));
+  EXPECT_FALSE(merged->testNull());
+  auto reverseMerged = between(0, 10'000)->mergeWith(filter.get());
+  ASSERT_TRUE(merged->testingEquals(*reverseMerged));
+
+  ASSERT_EQ(
+      filter->mergeWith(between(2'000'000, 3'000'000).get())->kind(),
+      FilterKind::kAlwaysFalse);
+  ASSERT_EQ(
+      filter->mergeWith(std::make_unique<AlwaysTrue>().get())->kind(),
+      FilterKind::kBigintValuesUsingBloomFilter);
+
+  // The Bloom filter turns itself off when it rejects too few values.
+  filter = makeFilter(values);
+  for (auto i = 0;
+       i < BigintValuesUsingBloomFilter::kSelectivityCheckInterval;
+       ++i) {
+    EXPECT_TRUE(filter->testInt64(values[i % values.size()]));
+  }
+  EXPECT_TRUE(filter->isBloomFilterDisabled());
+  EXPECT_TRUE(filter->testInt64(1));
+  EXPECT_FALSE(filter->testInt64(-1));
+
+  // A selective Bloom filter stays on.
+  filter = makeFilter(values);
+  for (auto i = 0;
+       i < BigintValuesUsingBloomFilter::kSelectivityCheckInterval;
+       ++i) {
+    filter->testInt64(i % 1'000 * 1'000 + 1);
+  }
+  EXPECT_FALSE(filter->isBloomFilterDisabled());
+  EXPECT_FALSE(filter->testInt64(1));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -974,6 +1049,37 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesBatch) {
+  // Inlined and out of line values, including the empty string.
+  std::vector<std::string> values{""};
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i % 2 ? fmt::format("v{}", i)
+                           : fmt::format("an out of line value {}", i));
+  }
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 3'003; ++i) {
+    strings.push_back(values[(i * 7) % values.size()]);
+    if (i % 3 == 0) {
+      strings.back() += "x";
+    }
+  }
+  std::vector<StringView> views(strings.begin(), strings.end());
+  auto filter = in(values);
+  auto negated = notIn(values);
+  std::vector<uint64_t> passed(bits::nwords(views.size()));
+  std::vector<uint64_t> negatedPassed(bits::nwords(views.size()));
+  filter->testStringViews(views.data(), views.size(), passed.data());
+  negated->testStringViews(views.data(), views.size(), negatedPassed.data());
+  for (auto i = 0; i < views.size(); ++i) {
+    const bool expected = i % 3 != 0;
+    ASSERT_EQ(expected, filter->testBytes(views[i].data(), views[i].size()))
+        << strings[i];
+    ASSERT_EQ(expected, bits::isBitSet(passed.data(), i)) << strings[i];
+    ASSERT_EQ(!expected, bits::isBitSet(negatedPassed.data(), i))
+        << strings[i];
+  }
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
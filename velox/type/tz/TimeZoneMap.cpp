@@ -16,6 +16,8 @@
 
 #include "velox/type/tz/TimeZoneMap.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <fmt/core.h>
 #include <folly/container/F14Map.h>
@@ -39,6 +41,11 @@ extern const std::vector<std::pair<int16_t, std::string>>& getTimeZoneEntries();
 
 namespace {
 
+// The range of system times in seconds whose transitions are cached for the
+// batch conversions: [1900-01-01, 2100-01-01) UTC.
+constexpr int64_t kCachedTransitionsBegin = -2'208'988'800;
+constexpr int64_t kCachedTransitionsEnd = 4'102'444'800;
+
 // Returns the offset in minutes for a specific time zone offset in the
 // database. Do not call for tzID 0 (UTC / "+00:00").
 inline std::chrono::minutes getTimeZoneOffset(int16_t tzID) {
@@ -473,6 +480,64 @@ TimeZone::milliseconds TimeZone::to_local(
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
+bool TimeZone::to_local(
+    const int64_t* timestamps,
+    int32_t size,
+    int64_t* result) const {
+  const auto& transitions = this->transitions();
+  // The interval [begin, end) of the last lookup. Initially empty.
+  int64_t begin = 0;
+  int64_t end = 0;
+  int64_t offset = 0;
+  for (auto i = 0; i < size; ++i) {
+    const auto timestamp = timestamps[i];
+    if (UNLIKELY(timestamp < begin || timestamp >= end)) {
+      if (timestamp < kCachedTransitionsBegin ||
+          timestamp >= kCachedTransitionsEnd) {
+        return false;
+      }
+      // The first transition is at kCachedTransitionsBegin, so 'next' is
+      // never the first one.
+      const auto next = std::upper_bound(
+          transitions.begin(),
+          transitions.end(),
+          timestamp,
+          [](int64_t time, const Transition& transition) {
+            return time < transition.begin;
+          });
+      begin = (next - 1)->begin;
+      end = next == transitions.end() ? kCachedTransitionsEnd : next->begin;
+      offset = (next - 1)->offset;
+    }
+    result[i] = timestamp + offset;
+  }
+  return true;
+}
+
+const std::vector<TimeZone::Transition>& TimeZone::transitions() const {
+  folly::call_once(transitionsOnce_, [&]() {
+    if (tz_ == nullptr) {
+      transitions_.push_back(
+          {kCachedTransitionsBegin,
+           std::chrono::duration_cast<seconds>(offset_).count()});
+      return;
+    }
+    // Walks the intervals of 'tz_'. Consecutive intervals may differ only in
+    // the abbreviation. Only the changes of the offset are kept.
+    date::sys_seconds time{seconds{kCachedTransitionsBegin}};
+    const date::sys_seconds end{seconds{kCachedTransitionsEnd}};
+    while (time < end) {
+      const auto info = tz_->get_info(time);
+      const auto offset = info.offset.count();
+      if (transitions_.empty() || transitions_.back().offset != offset) {
+        transitions_.push_back({time.time_since_epoch().count(), offset});
+      }
+      time = info.end;
+    }
+  });
+  return transitions_;
+}
+
 TimeZone::seconds TimeZone::correct_nonexistent_time(
     TimeZone::seconds timestamp) const {
   // If this is an offset time zone.
@@ -20,6 +20,8 @@
 #include <string>
 #include <vector>
 
+#include <folly/synchronization/CallOnce.h>
+
 namespace facebook::velox::tzdb {
 class time_zone;
 }
@@ -147,6 +149,16 @@ class TimeZone {
   seconds to_local(seconds timestamp) const;
   milliseconds to_local(milliseconds timestamp) const;
 
+  /// Converts 'size' system times in seconds to local times like to_local()
+  /// and writes them to 'result', which may be 'timestamps'. Looks up the DST
+  /// transition interval of a timestamp only when it is outside of the
+  /// interval of the previous one, so that a run of timestamps in the same
+  /// interval gets a constant offset. The transitions between 1900 and 2100
+  /// are cached on first use. Returns false if a timestamp is outside of these
+  /// years. The timestamps must then be converted one by one.
+  bool to_local(const int64_t* timestamps, int32_t size, int64_t* result)
+      const;
+
   /// If a local time is nonexistent, i.e. refers to a time that exists in the
   /// gap during a time zone conversion, this returns the time adjusted by
   /// the difference between the two time zones, so that it lies in the later
@@ -184,10 +196,23 @@ class TimeZone {
       TChoose choose = TChoose::kFail) const;
 
  private:
+  // The offset of local time from system time in seconds from 'begin' to the
+  // 'begin' of the next transition.
+  struct Transition {
+    int64_t begin;
+    int64_t offset;
+  };
+
+  // Returns the cached transitions, sorted by 'begin'.
+  const std::vector<Transition>& transitions() const;
+
   const tzdb::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  mutable folly::once_flag transitionsOnce_;
+  mutable std::vector<Transition> transitions_;
 };
 
 } // namespace facebook::velox::tz
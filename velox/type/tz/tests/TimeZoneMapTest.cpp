@@ -116,6 +116,46 @@ TEST(TimeZoneMapTest, offsetToSys) {
   EXPECT_NE(toSysTime("-07:00", ts), toSysTime("America/Los_Angeles", ts));
 }
 
+TEST(TimeZoneMapTest, toLocalBatch) {
+  // Hourly timestamps from 2024-03-01 to 2024-12-01, which cross both DST
+  // transitions of America/Los_Angeles, and a few from other years.
+  std::vector<int64_t> timestamps;
+  for (int64_t ts = 1709251200; ts < 1733011200; ts += 3'600) {
+    timestamps.push_back(ts);
+  }
+  timestamps.push_back(-2'208'988'800);
+  timestamps.push_back(0);
+  timestamps.push_back(4'102'444'799);
+  timestamps.push_back(1709251200);
+
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Australia/Lord_Howe",
+        "Asia/Kolkata",
+        "UTC",
+        "+05:30",
+        "-01:01"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    std::vector<int64_t> result(timestamps.size());
+    ASSERT_TRUE(
+        tz->to_local(timestamps.data(), timestamps.size(), result.data()));
+    for (auto i = 0; i < timestamps.size(); ++i) {
+      ASSERT_EQ(result[i], tz->to_local(seconds{timestamps[i]}).count())
+          << timestamps[i];
+    }
+  }
+
+  // Timestamps outside of the cached years are not converted.
+  const auto* tz = locateZone("America/Los_Angeles");
+  for (const int64_t ts : {-2'208'988'801, 4'102'444'800}) {
+    std::vector<int64_t> input{0, ts};
+    std::vector<int64_t> result(input.size());
+    EXPECT_FALSE(tz->to_local(input.data(), input.size(), result.data()));
+  }
+}
+
 TEST(TimeZoneMapTest, timePointBoundary) {
   using namespace date;
 
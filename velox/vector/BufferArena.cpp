@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/vector/BufferArena.h"
+
+#include <cstring>
+
+namespace facebook::velox {
+
+BufferPtr BufferArena::allocateNulls(vector_size_t size, bool initValue) {
+  const auto bytes = bits::nbytes(size);
+  auto buffer = allocate(bytes);
+  std::memset(
+      buffer->asMutable<char>(),
+      initValue ? bits::kNullByte : bits::kNotNullByte,
+      bytes);
+  return buffer;
+}
+
+BufferPtr BufferArena::allocateIndices(vector_size_t size) {
+  const auto bytes = size * sizeof(vector_size_t);
+  auto buffer = allocate(bytes);
+  std::memset(buffer->asMutable<char>(), 0, bytes);
+  return buffer;
+}
+
+BufferPtr BufferArena::allocate(size_t bytes) {
+  if (bytes > kMaxBufferSize) {
+    return AlignedBuffer::allocate<char>(bytes, pool_);
+  }
+  if (next_ < buffers_.size()) {
+    auto& buffer = buffers_[next_++];
+    if (buffer->capacity() < bytes) {
+      buffer = AlignedBuffer::allocate<char>(bytes, pool_);
+    } else {
+      buffer->setSize(bytes);
+    }
+    return buffer;
+  }
+  if (buffers_.size() >= kMaxBuffers) {
+    return AlignedBuffer::allocate<char>(bytes, pool_);
+  }
+  buffers_.push_back(AlignedBuffer::allocate<char>(bytes, pool_));
+  ++next_;
+  return buffers_.back();
+}
+
+void BufferArena::reset() {
+  size_t numKept{0};
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i]->refCount() > 1) {
+      continue;
+    }
+    if (i != numKept) {
+      buffers_[numKept] = std::move(buffers_[i]);
+    }
+    ++numKept;
+  }
+  buffers_.resize(numKept);
+  next_ = 0;
+}
+
+void BufferArena::clear() {
+  buffers_.clear();
+  next_ = 0;
+}
+
+} // namespace facebook::velox
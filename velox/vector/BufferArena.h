@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/vector/TypeAliases.h"
+
+namespace facebook::velox {
+
+/// A thread-level arena of temporary buffers for the nulls and indices
+/// allocated during one batch of expression evaluation. The buffers are handed
+/// out in order like from a bump allocator and the arena is rewound by reset()
+/// at the end of the batch, so that the next batch gets the same buffers back
+/// without going to the memory pool.
+///
+/// A buffer which is still referenced outside of the arena on reset() has
+/// escaped, e.g. into a result vector. It is handed over to its holders and
+/// the arena doesn't reuse it. Buffers larger than 'kMaxBufferSize' and the
+/// buffers beyond the first 'kMaxBuffers' of a batch are allocated from the
+/// pool directly.
+class BufferArena {
+ public:
+  explicit BufferArena(memory::MemoryPool* pool) : pool_{pool} {}
+
+  /// Returns a buffer with null bits for 'size' rows set to 'initValue'.
+  BufferPtr allocateNulls(vector_size_t size, bool initValue = bits::kNotNull);
+
+  /// Returns a buffer with zero indices for 'size' rows.
+  BufferPtr allocateIndices(vector_size_t size);
+
+  /// Rewinds the arena for the next batch. Drops the escaped buffers.
+  void reset();
+
+  /// Frees all the buffers held by the arena.
+  void clear();
+
+  /// Returns the number of buffers held by the arena.
+  size_t numBuffers() const {
+    return buffers_.size();
+  }
+
+  static constexpr size_t kMaxBufferSize = 1 << 20;
+  static constexpr size_t kMaxBuffers = 64;
+
+ private:
+  // Returns an uninitialized buffer of 'bytes'.
+  BufferPtr allocate(size_t bytes);
+
+  memory::MemoryPool* const pool_;
+  std::vector<BufferPtr> buffers_;
+  // Index in 'buffers_' of the next buffer to hand out.
+  size_t next_{0};
+};
+
+} // namespace facebook::velox
@@ -313,6 +313,7 @@ void FlatVector<T>::copyRanges(
 
     // We copy referencing the storage of 'source'.
     acquireSharedStringBuffers(source);
+    SimpleVector<StringView>::invalidateCachedHashes();
   }
 
   const uint64_t* sourceRawNulls = source->rawNulls();
@@ -454,6 +455,7 @@ void FlatVector<T>::resize(vector_size_t newSize, bool setNotNull) {
       // If we downsize, just invalidate ascii, because we might have become
       // 'all ascii' from 'not all ascii'.
       SimpleVector<StringView>::invalidateIsAscii();
+      SimpleVector<StringView>::invalidateCachedHashes();
     } else {
       // Properly init stringView objects. This is useful when vectors are
       // re-used where the size changes but not the capacity.
@@ -238,6 +238,7 @@ void FlatVector<StringView>::copy(
   if (!rows.hasSelections()) {
     return;
   }
+  invalidateCachedHashes(&rows);
 
   // Source can be of Unknown type, in that case it should have null values.
   if (source->typeKind() == TypeKind::UNKNOWN) {
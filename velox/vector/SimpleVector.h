@@ -93,6 +93,41 @@ struct AsciiInfo {
   folly::Synchronized<SelectivityVector> asciiComputedRows_;
 };
 
+/// Hashes of the string values of a vector, computed by a consumer like
+/// VectorHasher and reused by the other consumers of the same vector, e.g. the
+/// hash based operators of a pipeline. Thread-safe for the same reason as
+/// AsciiInfo.
+struct StringHashCache {
+  struct Hashes {
+    /// Rows with a cached hash.
+    SelectivityVector rows;
+
+    /// Cached hashes, indexed by row.
+    std::vector<uint64_t> hashes;
+  };
+
+  bool empty() const {
+    return empty_;
+  }
+
+  void setEmpty(bool value) {
+    empty_ = value;
+  }
+
+  auto readLockedHashes() const {
+    return hashes_.rlock();
+  }
+
+  auto writeLockedHashes() {
+    return hashes_.wlock();
+  }
+
+ private:
+  std::atomic_bool empty_{true};
+
+  folly::Synchronized<Hashes> hashes_;
+};
+
 /// This class abstracts over various Columnar Storage Formats such that Velox
 /// can select the most appropriate one on a per field / per block basis.
 /// The goal is to use the most appropriate type to optimize for:
@@ -328,13 +363,17 @@ class SimpleVector : public BaseVector {
     }
     ensureIsAsciiCapacity();
     bool isAllAscii = true;
-    rows.applyToSelected([&](auto row) {
-      if (!isNullAt(row)) {
-        auto string = valueAt(row);
-        isAllAscii &=
-            functions::stringCore::isAscii(string.data(), string.size());
-      }
-    });
+    if (this->isFlatEncoding()) {
+      isAllAscii = isFlatAscii(rows);
+    } else {
+      rows.applyToSelected([&](auto row) {
+        if (!isNullAt(row)) {
+          auto string = valueAt(row);
+          isAllAscii &=
+              functions::stringCore::isAscii(string.data(), string.size());
+        }
+      });
+    }
 
     // Set isAllAscii flag, it will unset if we encounter any utf.
     auto wlockedAsciiComputedRows = asciiInfo.writeLockedAsciiComputedRows();
@@ -398,6 +437,56 @@ class SimpleVector : public BaseVector {
     return asciiInfo.isAllAscii();
   }
 
+  /// Copies the hashes cached by setCachedHashes() for 'rows' into 'hashes',
+  /// indexed by row. Returns false if some of 'rows' have no cached hash.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, bool>
+  getCachedHashes(const SelectivityVector& rows, uint64_t* hashes) const {
+    if (hashCache_.empty()) {
+      return false;
+    }
+    auto rlockedHashes = hashCache_.readLockedHashes();
+    if (!rows.isSubset(rlockedHashes->rows)) {
+      return false;
+    }
+    rows.applyToSelected(
+        [&](auto row) { hashes[row] = rlockedHashes->hashes[row]; });
+    return true;
+  }
+
+  /// Caches 'hashes', indexed by row, for 'rows'. The cache is cleared for
+  /// the rows that are written after this, like the asciiness.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, void>
+  setCachedHashes(const SelectivityVector& rows, const uint64_t* hashes)
+      const {
+    VELOX_CHECK_LE(rows.end(), BaseVector::length_);
+    auto wlockedHashes = hashCache_.writeLockedHashes();
+    if (wlockedHashes->hashes.size() < rows.end()) {
+      wlockedHashes->hashes.resize(rows.end());
+    }
+    rows.applyToSelected(
+        [&](auto row) { wlockedHashes->hashes[row] = hashes[row]; });
+    wlockedHashes->rows.select(rows);
+    hashCache_.setEmpty(!wlockedHashes->rows.hasSelections());
+  }
+
+  /// Clears the cached hashes of 'rows' or of all rows if 'rows' is null.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, void>
+  invalidateCachedHashes(const SelectivityVector* rows = nullptr) const {
+    if (hashCache_.empty()) {
+      return;
+    }
+    auto wlockedHashes = hashCache_.writeLockedHashes();
+    if (rows) {
+      wlockedHashes->rows.deselect(*rows);
+    } else {
+      wlockedHashes->rows.clearAll();
+    }
+    hashCache_.setEmpty(!wlockedHashes->rows.hasSelections());
+  }
+
   /// Provides const access to asciiInfo. Used for tests only.
   template <typename U = T>
   typename std::enable_if_t<std::is_same_v<U, StringView>, const AsciiInfo&>
@@ -450,6 +539,32 @@ class SimpleVector : public BaseVector {
   }
 
  protected:
+  // Returns true if the strings of a flat vector at 'rows' are ascii. Checks
+  // an inline string with two word operations on the StringView, which holds
+  // zeros after the end of the string, and stops at the first string that is
+  // not ascii.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, bool> isFlatAscii(
+      const SelectivityVector& rows) const {
+    constexpr uint64_t kPrefixHighBits = 0x8080808000000000ULL;
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+    const auto* values = static_cast<const StringView*>(this->valuesAsVoid());
+    const auto* rawNulls = this->rawNulls();
+    return rows.testSelected([&](auto row) {
+      if (rawNulls && bits::isBitNull(rawNulls, row)) {
+        return true;
+      }
+      const auto& value = values[row];
+      if (value.isInline()) {
+        // The first word holds the size and the prefix.
+        uint64_t words[2];
+        std::memcpy(words, &value, sizeof(words));
+        return ((words[0] & kPrefixHighBits) | (words[1] & kHighBits)) == 0;
+      }
+      return functions::stringCore::isAscii(value.data(), value.size());
+    });
+  }
+
   template <typename U = T>
   typename std::enable_if_t<std::is_same_v<U, StringView>, void>
   ensureIsAsciiCapacity() {
@@ -528,6 +643,7 @@ class SimpleVector : public BaseVector {
       } else {
         invalidateIsAscii();
       }
+      invalidateCachedHashes(rows);
     }
   }
 
@@ -539,6 +655,9 @@ class SimpleVector : public BaseVector {
   const uint8_t elementSize_;
 
   std::conditional_t<std::is_same_v<T, StringView>, AsciiInfo, int> asciiInfo;
+  mutable std::
+      conditional_t<std::is_same_v<T, StringView>, StringHashCache, int>
+          hashCache_;
   SimpleVectorStats<T> stats_;
 };
 
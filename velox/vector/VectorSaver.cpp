@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorSaver.h"
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
 
@@ -160,18 +162,43 @@ VectorPtr createFlat(
       std::move(stringBuffers));
 }
 
-int32_t computeStringOffset(
-    StringView value,
+// A string buffer and its offset in the string buffers arranged one after
+// the other.
+struct StringBufferRange {
+  const char* start;
+  int64_t size;
+  int64_t offset;
+};
+
+// Returns the ranges of 'stringBuffers' sorted by address.
+std::vector<StringBufferRange> sortedStringBufferRanges(
     const std::vector<BufferPtr>& stringBuffers) {
-  int32_t offset = 0;
+  std::vector<StringBufferRange> ranges;
+  ranges.reserve(stringBuffers.size());
+  int64_t offset = 0;
   for (const auto& buffer : stringBuffers) {
-    auto start = buffer->as<char>();
+    ranges.push_back({buffer->as<char>(), (int64_t)buffer->size(), offset});
+    offset += buffer->size();
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+    return a.start < b.start;
+  });
+  return ranges;
+}
 
-    if (value.data() >= start && value.data() < start + buffer->size()) {
-      return (value.data() - start) + offset;
+int64_t computeStringOffset(
+    StringView value,
+    const std::vector<StringBufferRange>& ranges) {
+  auto it = std::upper_bound(
+      ranges.begin(),
+      ranges.end(),
+      value.data(),
+      [](const char* data, const auto& range) { return data < range.start; });
+  if (it != ranges.begin()) {
+    --it;
+    if (value.data() < it->start + it->size) {
+      return (value.data() - it->start) + it->offset;
     }
-
-    offset += buffer->size();
   }
 
   VELOX_FAIL("String view points outside of the string buffers");
@@ -200,6 +227,7 @@ void writeStringViews(
     std::ostream& out) {
   write<int32_t>(strings->size(), out);
 
+  const auto ranges = sortedStringBufferRanges(stringBuffers);
   auto rawBytes = strings->as<char>();
   auto rawValues = strings->as<StringView>();
   for (auto i = 0; i < size; ++i) {
@@ -215,7 +243,7 @@ void writeStringViews(
       write<int32_t>(0, out);
 
       // Offset.
-      auto offset = computeStringOffset(stringView, stringBuffers);
+      auto offset = computeStringOffset(stringView, ranges);
       write<int64_t>(offset, out);
     }
   }
@@ -227,6 +255,25 @@ void restoreVectorStringViews(
     const std::vector<BufferPtr>& stringBuffers) {
   auto rawBytes = strings->as<char>();
   auto rawValues = strings->asMutable<StringView>();
+  if (stringBuffers.size() == 1) {
+    // The strings are in one buffer when written by this version.
+    const auto* start = stringBuffers[0]->as<char>();
+    const auto bufferSize = stringBuffers[0]->size();
+    for (auto i = 0; i < size; ++i) {
+      auto value = rawValues[i];
+      if (!value.isInline()) {
+        auto offset = *reinterpret_cast<const int64_t*>(
+            rawBytes + i * sizeof(StringView) + 8);
+        VELOX_CHECK_LE(
+            offset + value.size(),
+            bufferSize,
+            "String offset is outside of the string buffers: {}",
+            offset);
+        rawValues[i] = StringView(start + offset, value.size());
+      }
+    }
+    return;
+  }
   for (auto i = 0; i < size; ++i) {
     auto value = rawValues[i];
     if (!value.isInline()) {
@@ -267,10 +314,24 @@ void writeFlatVector(const BaseVector& vector, std::ostream& out) {
   if (isVarcharOrVarbinary(vector)) {
     const auto& stringBuffers =
         vector.asFlatVector<StringView>()->stringBuffers();
-    write<int32_t>(stringBuffers.size(), out);
-
+    int64_t totalSize = 0;
     for (const auto& buffer : stringBuffers) {
-      writeBuffer(buffer, out);
+      totalSize += buffer->size();
+    }
+    if (stringBuffers.size() > 1 &&
+        totalSize <= std::numeric_limits<int32_t>::max()) {
+      // Writes the buffers as one, so that restoring a string is an addition
+      // to the start of the buffer.
+      write<int32_t>(1, out);
+      write<int32_t>(totalSize, out);
+      for (const auto& buffer : stringBuffers) {
+        out.write(buffer->as<char>(), buffer->size());
+      }
+    } else {
+      write<int32_t>(stringBuffers.size(), out);
+      for (const auto& buffer : stringBuffers) {
+        writeBuffer(buffer, out);
+      }
     }
   }
 }
@@ -16,6 +16,9 @@
 
 #include "velox/vector/arrow/Bridge.h"
 
+#include <cerrno>
+#include <numeric>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CheckedArithmetic.h"
@@ -621,8 +624,17 @@ VectorPtr createStringFlatVector(
   bool shouldAcquireStringBuffer = false;
 
   for (size_t i = 0; i < length; ++i) {
+    const auto size = offsets[i + 1] - offsets[i];
+    if constexpr (sizeof(TOffset) > sizeof(uint32_t)) {
+      // Large strings use 64-bit offsets but a single StringView still holds
+      // at most 4GB.
+      VELOX_USER_CHECK_LE(
+          size,
+          std::numeric_limits<uint32_t>::max(),
+          "String size exceeds the maximum supported StringView size.");
+    }
     rawStringViews[i] =
-        StringView(values + offsets[i], offsets[i + 1] - offsets[i]);
+        StringView(values + offsets[i], static_cast<uint32_t>(size));
     shouldAcquireStringBuffer |= !rawStringViews[i].isInline();
   }
 
@@ -1526,6 +1538,194 @@ void exportToArrow(
   arrowSchema.private_data = bridgeHolder.release();
 }
 
+namespace {
+
+// Producer side of the ArrowArrayStream created by exportToArrowStream(). The
+// encoding of each top-level column is decided on the first batch so that all
+// exported arrays match the stream schema.
+class ArrowStreamExporter {
+ public:
+  ArrowStreamExporter(
+      RowTypePtr rowType,
+      std::function<RowVectorPtr()> nextBatch,
+      std::shared_ptr<memory::MemoryPool> pool,
+      const ArrowOptions& options)
+      : rowType_(std::move(rowType)),
+        nextBatch_(std::move(nextBatch)),
+        pool_(std::move(pool)),
+        options_(options) {}
+
+  void getSchema(ArrowSchema& out) {
+    ensureInitialized();
+    std::vector<VectorPtr> children(rowType_->size());
+    for (auto i = 0; i < children.size(); ++i) {
+      children[i] = BaseVector::create(rowType_->childAt(i), 0, pool_.get());
+      if (dictionaryColumns_[i]) {
+        children[i] = BaseVector::wrapInDictionary(
+            nullptr, allocateIndices(0, pool_.get()), 0, children[i]);
+      }
+    }
+    exportToArrow(
+        std::make_shared<RowVector>(
+            pool_.get(), rowType_, nullptr, 0, std::move(children)),
+        out,
+        options_);
+  }
+
+  // Exports the next batch into 'out', or marks 'out' as released at the end
+  // of the stream.
+  void getNext(ArrowArray& out) {
+    ensureInitialized();
+    RowVectorPtr batch = std::move(firstBatch_);
+    if (batch == nullptr && !atEnd_) {
+      batch = nextBatch();
+    }
+    if (batch == nullptr) {
+      atEnd_ = true;
+      out.release = nullptr;
+      return;
+    }
+    exportToArrow(normalize(batch), out, pool_.get(), options_);
+  }
+
+  void setLastError(const char* error) {
+    lastError_ = error;
+  }
+
+  const char* lastError() const {
+    return lastError_.empty() ? nullptr : lastError_.c_str();
+  }
+
+ private:
+  RowVectorPtr nextBatch() {
+    auto batch = nextBatch_();
+    if (batch == nullptr) {
+      atEnd_ = true;
+      return nullptr;
+    }
+    VELOX_USER_CHECK(
+        batch->type()->equivalent(*rowType_),
+        "Batch type does not match the stream type: {} vs. {}",
+        batch->type()->toString(),
+        rowType_->toString());
+    return batch;
+  }
+
+  // Pulls the first batch to decide the encoding of each column.
+  void ensureInitialized() {
+    if (initialized_) {
+      return;
+    }
+    firstBatch_ = nextBatch();
+    dictionaryColumns_.resize(rowType_->size(), false);
+    if (firstBatch_ != nullptr && !options_.flattenDictionary) {
+      for (auto i = 0; i < rowType_->size(); ++i) {
+        dictionaryColumns_[i] = firstBatch_->childAt(i)->encoding() ==
+            VectorEncoding::Simple::DICTIONARY;
+      }
+    }
+    initialized_ = true;
+  }
+
+  // Returns 'batch' with the top-level column encodings of the stream. Columns
+  // that already have the expected encoding over flat data are not copied.
+  RowVectorPtr normalize(const RowVectorPtr& batch) {
+    const auto size = batch->size();
+    std::vector<VectorPtr> children(rowType_->size());
+    for (auto i = 0; i < children.size(); ++i) {
+      auto child = BaseVector::loadedVectorShared(batch->childAt(i));
+      if (!dictionaryColumns_[i]) {
+        BaseVector::flattenVector(child);
+      } else if (child->encoding() == VectorEncoding::Simple::DICTIONARY) {
+        auto values = child->valueVector();
+        BaseVector::flattenVector(values);
+        if (values != child->valueVector()) {
+          child = BaseVector::wrapInDictionary(
+              child->nulls(), child->wrapInfo(), size, values);
+        }
+      } else {
+        BaseVector::flattenVector(child);
+        auto indices = allocateIndices(size, pool_.get());
+        auto* rawIndices = indices->asMutable<vector_size_t>();
+        std::iota(rawIndices, rawIndices + size, 0);
+        child = BaseVector::wrapInDictionary(nullptr, indices, size, child);
+      }
+      children[i] = std::move(child);
+    }
+    return std::make_shared<RowVector>(
+        pool_.get(), rowType_, batch->nulls(), size, std::move(children));
+  }
+
+  const RowTypePtr rowType_;
+  const std::function<RowVectorPtr()> nextBatch_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const ArrowOptions options_;
+
+  bool initialized_{false};
+  bool atEnd_{false};
+  // The first batch, pulled before the consumer asks for it to decide the
+  // column encodings.
+  RowVectorPtr firstBatch_;
+  // True for the top-level columns exported as Arrow dictionaries.
+  std::vector<bool> dictionaryColumns_;
+  std::string lastError_;
+};
+
+ArrowStreamExporter* streamExporter(ArrowArrayStream* stream) {
+  return static_cast<ArrowStreamExporter*>(stream->private_data);
+}
+
+int getArrowStreamSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto* exporter = streamExporter(stream);
+  try {
+    exporter->getSchema(*out);
+  } catch (const std::exception& e) {
+    exporter->setLastError(e.what());
+    return EINVAL;
+  }
+  return 0;
+}
+
+int getArrowStreamNext(ArrowArrayStream* stream, ArrowArray* out) {
+  auto* exporter = streamExporter(stream);
+  try {
+    exporter->getNext(*out);
+  } catch (const std::exception& e) {
+    exporter->setLastError(e.what());
+    return EINVAL;
+  }
+  return 0;
+}
+
+const char* getArrowStreamLastError(ArrowArrayStream* stream) {
+  return streamExporter(stream)->lastError();
+}
+
+void releaseArrowStream(ArrowArrayStream* stream) {
+  delete streamExporter(stream);
+  stream->release = nullptr;
+  stream->private_data = nullptr;
+}
+
+} // namespace
+
+void exportToArrowStream(
+    const RowTypePtr& rowType,
+    std::function<RowVectorPtr()> nextBatch,
+    ArrowArrayStream& arrowStream,
+    std::shared_ptr<memory::MemoryPool> pool,
+    const ArrowOptions& options) {
+  VELOX_CHECK_NOT_NULL(rowType);
+  VELOX_CHECK_NOT_NULL(nextBatch);
+  VELOX_CHECK_NOT_NULL(pool);
+  arrowStream.get_schema = getArrowStreamSchema;
+  arrowStream.get_next = getArrowStreamNext;
+  arrowStream.get_last_error = getArrowStreamLastError;
+  arrowStream.release = releaseArrowStream;
+  arrowStream.private_data = new ArrowStreamExporter(
+      rowType, std::move(nextBatch), std::move(pool), options);
+}
+
 TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
   // For dictionaries, format encodes the index type, while the dictionary value
   // is encoded in the dictionary member, as per
@@ -1968,11 +2168,23 @@ VectorPtr importFromArrowImpl(
           pool, type, nulls, arrowArray, wrapInBufferView);
     }
 
-    // Import StringView from Utf8/Binary
+    // Import StringView from Utf8/Binary or LargeUtf8/LargeBinary (Zero-copy
+    // for non-inline strings; the views point into the values buffer).
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
         "Expecting three buffers as input for string types.");
+    if (arrowSchema.format[0] == 'U' || arrowSchema.format[0] == 'Z') {
+      return createStringFlatVector(
+          pool,
+          type,
+          nulls,
+          arrowArray.length,
+          static_cast<const int64_t*>(arrowArray.buffers[1]), // offsets
+          static_cast<const char*>(arrowArray.buffers[2]), // values
+          arrowArray.null_count,
+          wrapInBufferView);
+    }
     return createStringFlatVector(
         pool,
         type,
@@ -16,14 +16,18 @@
 
 #pragma once
 
+#include <functional>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/ComplexVector.h"
 
-/// These 2 definitions should be included by user from either
+/// These 3 definitions should be included by user from either
 ///   1. <arrow/c/abi.h> or
 ///   2. "velox/vector/arrow/Abi.h"
 struct ArrowArray;
 struct ArrowSchema;
+struct ArrowArrayStream;
 
 enum class TimestampUnit : uint8_t {
   kSecond = 0 /*10^0 second is equal to 1 second*/,
@@ -100,6 +104,49 @@ void exportToArrow(
     ArrowSchema&,
     const ArrowOptions& = ArrowOptions{});
 
+/// Export a sequence of RowVectors as an ArrowArrayStream, as defined by
+/// Arrow's C stream interface:
+///
+///   https://arrow.apache.org/docs/format/CStreamInterface.html
+///
+/// 'nextBatch' is called every time the consumer asks for the next array and
+/// returns nullptr once the sequence is exhausted. Each batch is exported with
+/// the same zero-copy rules as the RowVector->ArrowArray export function, so
+/// flat primitive buffers, validity bitmaps and dictionary indices and values
+/// are shared with the Arrow consumer rather than copied.
+///
+/// An ArrowArrayStream has a single schema for all its arrays, while the
+/// encodings of a Velox column may change from one batch to the next. The
+/// stream fixes the encoding of each top-level column based on the first
+/// batch: a column that arrives dictionary encoded is exported as an Arrow
+/// dictionary (flat columns in later batches are wrapped in identity
+/// dictionaries), while any other column is exported flat (later dictionary
+/// or constant columns are flattened). Dictionaries are not used if
+/// 'options.flattenDictionary' is set.
+///
+/// 'rowType' is the type of all batches; it defines the schema of an empty
+/// stream. The stream holds on to 'nextBatch' and 'pool' until it is
+/// released. Errors thrown by 'nextBatch' or by the conversion are reported
+/// to the consumer through get_last_error().
+///
+/// Example usage:
+///
+///   ArrowArrayStream arrowStream;
+///   auto nextBatch = [&]() {
+///     return cursor->moveNext() ? cursor->current() : nullptr;
+///   };
+///   exportToArrowStream(rowType, nextBatch, arrowStream, pool);
+///
+///   (use arrowStream, e.g. arrow::ImportRecordBatchReader(&arrowStream))
+///
+///   arrowStream.release(&arrowStream);
+void exportToArrowStream(
+    const RowTypePtr& rowType,
+    std::function<RowVectorPtr()> nextBatch,
+    ArrowArrayStream& arrowStream,
+    std::shared_ptr<memory::MemoryPool> pool,
+    const ArrowOptions& options = ArrowOptions{});
+
 /// Import an ArrowSchema into a Velox Type object.
 ///
 /// This function does the exact opposite of the function above. TypePtr carries
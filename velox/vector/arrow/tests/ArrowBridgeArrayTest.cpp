@@ -1062,6 +1062,121 @@ TEST_F(ArrowBridgeArrayExportTest, constantCrossValidate) {
   EXPECT_EQ(runEndsArray.Value(0), 100);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, stream) {
+  auto rowType = ROW({"a", "b"}, {BIGINT(), BIGINT()});
+  auto dictionaryValues = vectorMaker_.flatVector<int64_t>({10, 20, 30});
+  std::vector<RowVectorPtr> batches = {
+      vectorMaker_.rowVector(
+          {"a", "b"},
+          {vectorMaker_.flatVector<int64_t>({1, 2, 3}),
+           BaseVector::wrapInDictionary(
+               nullptr,
+               makeBuffer<vector_size_t>({2, 1, 0}),
+               3,
+               dictionaryValues)}),
+      // The encodings of both columns differ from the first batch.
+      vectorMaker_.rowVector(
+          {"a", "b"},
+          {BaseVector::createConstant(BIGINT(), int64_t{7}, 2, pool_.get()),
+           vectorMaker_.flatVector<int64_t>({40, 50})}),
+  };
+  const auto* rawValues = batches[0]->childAt(0)->values()->as<int64_t>();
+
+  size_t next = 0;
+  ArrowArrayStream arrowStream;
+  exportToArrowStream(
+      rowType,
+      [&]() { return next < batches.size() ? batches[next++] : nullptr; },
+      arrowStream,
+      pool_,
+      options_);
+  auto reader = *arrow::ImportRecordBatchReader(&arrowStream);
+
+  auto dictionaryType = arrow::dictionary(arrow::int32(), arrow::int64());
+  ASSERT_EQ(
+      *reader->schema(),
+      *arrow::schema(
+          {arrow::field("a", arrow::int64()),
+           arrow::field("b", dictionaryType)}));
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_OK(reader->ReadNext(&batch));
+  ASSERT_NE(batch, nullptr);
+  ASSERT_OK(batch->ValidateFull());
+  ASSERT_EQ(batch->num_rows(), 3);
+  auto& a = static_cast<const arrow::Int64Array&>(*batch->column(0));
+  // Flat values are exported without copying.
+  EXPECT_EQ(a.raw_values(), rawValues);
+  auto& b = static_cast<const arrow::DictionaryArray&>(*batch->column(1));
+  ASSERT_EQ(*b.type(), *dictionaryType);
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_EQ(a.Value(i), i + 1);
+    EXPECT_EQ(b.GetValueIndex(i), 2 - i);
+  }
+
+  ASSERT_OK(reader->ReadNext(&batch));
+  ASSERT_NE(batch, nullptr);
+  ASSERT_OK(batch->ValidateFull());
+  ASSERT_EQ(batch->num_rows(), 2);
+  auto& constantA = static_cast<const arrow::Int64Array&>(*batch->column(0));
+  auto& flatB = static_cast<const arrow::DictionaryArray&>(*batch->column(1));
+  auto& flatBValues =
+      static_cast<const arrow::Int64Array&>(*flatB.dictionary());
+  for (auto i = 0; i < 2; ++i) {
+    EXPECT_EQ(constantA.Value(i), 7);
+    EXPECT_EQ(flatBValues.Value(flatB.GetValueIndex(i)), 40 + 10 * i);
+  }
+
+  ASSERT_OK(reader->ReadNext(&batch));
+  EXPECT_EQ(batch, nullptr);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, streamEmpty) {
+  ArrowArrayStream arrowStream;
+  exportToArrowStream(
+      ROW({"a", "b"}, {INTEGER(), VARCHAR()}),
+      []() { return nullptr; },
+      arrowStream,
+      pool_,
+      options_);
+  auto reader = *arrow::ImportRecordBatchReader(&arrowStream);
+  ASSERT_EQ(
+      *reader->schema(),
+      *arrow::schema(
+          {arrow::field("a", arrow::int32()),
+           arrow::field("b", arrow::utf8())}));
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_OK(reader->ReadNext(&batch));
+  EXPECT_EQ(batch, nullptr);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, streamError) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  size_t next = 0;
+  ArrowArrayStream arrowStream;
+  exportToArrowStream(
+      rowType,
+      [&]() -> RowVectorPtr {
+        if (next++ == 0) {
+          return vectorMaker_.rowVector(
+              {"a"}, {vectorMaker_.flatVector<int64_t>({1})});
+        }
+        VELOX_FAIL("Producer failed");
+      },
+      arrowStream,
+      pool_,
+      options_);
+  auto reader = *arrow::ImportRecordBatchReader(&arrowStream);
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_OK(reader->ReadNext(&batch));
+  ASSERT_NE(batch, nullptr);
+  auto status = reader->ReadNext(&batch);
+  ASSERT_FALSE(status.ok());
+  EXPECT_NE(status.message().find("Producer failed"), std::string::npos);
+}
+
 class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
  protected:
   // Used by this base test class to import Arrow data and create Velox Vector.
@@ -1117,7 +1232,20 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     return makeArrowArray(holder.buffers, 2, length, nullCount);
   }
 
+  // Fills a Utf8/Binary array, or a LargeUtf8/LargeBinary array with 64-bit
+  // offsets if 'largeOffsets' is true.
   ArrowArray fillArrowArray(
+      const std::vector<std::optional<std::string>>& inputValues,
+      ArrowContextHolder& holder,
+      bool largeOffsets = false) {
+    if (largeOffsets) {
+      return fillStringArrowArray<int64_t>(inputValues, holder);
+    }
+    return fillStringArrowArray<int32_t>(inputValues, holder);
+  }
+
+  template <typename TOffset>
+  ArrowArray fillStringArrowArray(
       const std::vector<std::optional<std::string>>& inputValues,
       ArrowContextHolder& holder) {
     int64_t length = inputValues.size();
@@ -1132,11 +1260,11 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     }
 
     holder.nulls = AlignedBuffer::allocate<uint64_t>(length, pool_.get());
-    holder.offsets = AlignedBuffer::allocate<int32_t>(length + 1, pool_.get());
+    holder.offsets = AlignedBuffer::allocate<TOffset>(length + 1, pool_.get());
     holder.values = AlignedBuffer::allocate<char>(bufferSize, pool_.get());
 
     auto rawNulls = holder.nulls->asMutable<uint64_t>();
-    auto rawOffsets = holder.offsets->asMutable<int32_t>();
+    auto rawOffsets = holder.offsets->asMutable<TOffset>();
     auto rawValues = holder.values->asMutable<char>();
     *rawOffsets = 0;
 
@@ -1172,7 +1300,13 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
       const char* format,
       const std::vector<std::optional<TInput>>& inputValues) {
     ArrowContextHolder holder;
-    auto arrowArray = fillArrowArray(inputValues, holder);
+    ArrowArray arrowArray;
+    if constexpr (std::is_same_v<TInput, std::string>) {
+      arrowArray = fillArrowArray(
+          inputValues, holder, format[0] == 'U' || format[0] == 'Z');
+    } else {
+      arrowArray = fillArrowArray(inputValues, holder);
+    }
 
     auto arrowSchema = makeArrowSchema(format);
     auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
@@ -1355,6 +1489,25 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
             "vector",
             std::nullopt,
         });
+
+    // Large strings and binaries use 64-bit offsets.
+    testArrowImport<std::string>("U", {});
+    testArrowImport<std::string>(
+        "U",
+        {
+            "hello world",
+            std::nullopt,
+            "larger string which should not be inlined...",
+            "short",
+            std::nullopt,
+        });
+    testArrowImport<std::string>(
+        "Z",
+        {
+            std::nullopt,
+            "large binary value that is not inlined",
+            "a",
+        });
   }
 
  private:
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/vector/BufferArena.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::test {
+
+class BufferArenaTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+
+TEST_F(BufferArenaTest, reuse) {
+  BufferArena arena(pool_.get());
+
+  auto* nulls = arena.allocateNulls(1'000).get();
+  auto* indices = arena.allocateIndices(1'000).get();
+  ASSERT_EQ(2, arena.numBuffers());
+
+  // The buffers are handed out again in the same order after reset.
+  arena.reset();
+  ASSERT_EQ(2, arena.numBuffers());
+  auto otherNulls = arena.allocateNulls(500, bits::kNull);
+  auto otherIndices = arena.allocateIndices(500);
+  ASSERT_EQ(nulls, otherNulls.get());
+  ASSERT_EQ(indices, otherIndices.get());
+  ASSERT_EQ(bits::nbytes(500), otherNulls->size());
+  ASSERT_EQ(500 * sizeof(vector_size_t), otherIndices->size());
+  for (auto i = 0; i < 500; ++i) {
+    ASSERT_TRUE(bits::isBitNull(otherNulls->as<uint64_t>(), i));
+    ASSERT_EQ(0, otherIndices->as<vector_size_t>()[i]);
+  }
+
+  // A larger buffer replaces the one at its position.
+  otherNulls.reset();
+  otherIndices.reset();
+  arena.reset();
+  auto largeNulls = arena.allocateNulls(100'000);
+  ASSERT_EQ(2, arena.numBuffers());
+  ASSERT_GE(largeNulls->capacity(), bits::nbytes(100'000));
+  for (auto i = 0; i < 100'000; ++i) {
+    ASSERT_FALSE(bits::isBitNull(largeNulls->as<uint64_t>(), i));
+  }
+
+  arena.clear();
+  ASSERT_EQ(0, arena.numBuffers());
+}
+
+TEST_F(BufferArenaTest, escape) {
+  BufferArena arena(pool_.get());
+
+  auto escaped = arena.allocateIndices(100);
+  auto* temporary = arena.allocateIndices(100).get();
+  escaped->asMutable<vector_size_t>()[0] = 10;
+
+  // The buffer that is still referenced is dropped from the arena and keeps its
+  // contents.
+  arena.reset();
+  ASSERT_EQ(1, arena.numBuffers());
+  ASSERT_EQ(1, escaped->refCount());
+  auto indices = arena.allocateIndices(100);
+  ASSERT_EQ(temporary, indices.get());
+  ASSERT_NE(escaped.get(), indices.get());
+  ASSERT_EQ(10, escaped->as<vector_size_t>()[0]);
+}
+
+TEST_F(BufferArenaTest, directAllocation) {
+  BufferArena arena(pool_.get());
+
+  // Buffers larger than the max buffer size are not kept in the arena.
+  arena.allocateIndices(BufferArena::kMaxBufferSize);
+  ASSERT_EQ(0, arena.numBuffers());
+
+  // Buffers beyond the max number of buffers are not kept in the arena.
+  std::vector<BufferPtr> buffers;
+  for (auto i = 0; i < BufferArena::kMaxBuffers + 10; ++i) {
+    buffers.push_back(arena.allocateNulls(100));
+  }
+  ASSERT_EQ(BufferArena::kMaxBuffers, arena.numBuffers());
+  buffers.clear();
+  arena.reset();
+  ASSERT_EQ(BufferArena::kMaxBuffers, arena.numBuffers());
+}
+
+} // namespace facebook::velox::test
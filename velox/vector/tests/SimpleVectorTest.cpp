@@ -273,6 +273,31 @@ TEST_F(SimpleVectorNonParameterizedTest, computeAscii) {
   }
 }
 
+TEST_F(SimpleVectorNonParameterizedTest, computeAsciiFlat) {
+  // Puts a non-ascii byte at each position of inline and non-inline strings.
+  for (auto length : {1, 4, 5, 12, 13, 40}) {
+    for (auto position = 0; position < length; ++position) {
+      std::vector<std::string> strings(10, std::string(length, 'a'));
+      strings[7][position] = '\xc3';
+      auto vector = maker_.flatVector(strings);
+      SelectivityVector all(strings.size());
+      ASSERT_FALSE(vector->computeAndSetIsAscii(all))
+          << length << " " << position;
+
+      SelectivityVector asciiRows(strings.size());
+      asciiRows.setValid(7, false);
+      asciiRows.updateBounds();
+      vector->invalidateIsAscii();
+      ASSERT_TRUE(vector->computeAndSetIsAscii(asciiRows));
+
+      // Null rows are skipped.
+      vector->invalidateIsAscii();
+      vector->setNull(7, true);
+      ASSERT_TRUE(vector->computeAndSetIsAscii(all));
+    }
+  }
+}
+
 TEST_F(SimpleVectorNonParameterizedTest, isAscii) {
   for (auto encoding : kAsciiEncodings) {
     LOG(INFO) << "Running:" << encoding;
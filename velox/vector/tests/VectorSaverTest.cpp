@@ -382,6 +382,30 @@ TEST_F(VectorSaverTest, flatVarchar) {
   testRoundTrip(opts, VARCHAR());
 }
 
+TEST_F(VectorSaverTest, flatVarcharMultipleStringBuffers) {
+  // Strings in 3 buffers in an order that differs from the address order.
+  std::vector<VectorPtr> sources;
+  for (auto i = 0; i < 3; ++i) {
+    sources.push_back(makeFlatVector<std::string>(100, [&](auto row) {
+      return fmt::format("{} long string {}", i, row);
+    }));
+  }
+  auto flat =
+      BaseVector::create<FlatVector<StringView>>(VARCHAR(), 300, pool());
+  for (auto i = 2; i >= 0; --i) {
+    flat->acquireSharedStringBuffers(sources[i].get());
+  }
+  for (auto row = 0; row < 300; ++row) {
+    flat->setNoCopy(
+        row, sources[row % 3]->asFlatVector<StringView>()->valueAt(row / 3));
+  }
+  ASSERT_EQ(flat->stringBuffers().size(), 3);
+
+  auto copy = takeRoundTrip(flat);
+  assertEqualEncodings(flat, copy);
+  ASSERT_EQ(copy->asFlatVector<StringView>()->stringBuffers().size(), 1);
+}
+
 TEST_F(VectorSaverTest, flatIntervalDayTime) {
   VectorFuzzer::Options opts = fuzzerOptions();
   testRoundTrip(opts, INTERVAL_DAY_TIME());